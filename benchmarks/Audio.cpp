@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Audio.hpp>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate   = 44100;
+    const unsigned int channelCount = 2;
+
+    ////////////////////////////////////////////////////////////
+    /// Write ten seconds of generated music in the given format
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeSound(const std::string& filename)
+    {
+        std::vector<sf::Int16> samples(sampleRate * channelCount * 10);
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            double time = static_cast<double>(i / channelCount) / sampleRate;
+            samples[i] = static_cast<sf::Int16>(8000 * std::sin(time * 440 * 6.2832) + 4000 * std::sin(time * 660 * 6.2832 + (i % 2)));
+        }
+
+        sf::OutputSoundFile file;
+        if (!file.openFromFile(filename, sampleRate, channelCount))
+            return false;
+
+        file.write(&samples[0], samples.size());
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Decoding of a whole file of the given format
+    ///
+    ////////////////////////////////////////////////////////////
+    void decode(Benchmark& benchmark, const char* extension)
+    {
+        std::string filename = std::string("sfml-benchmark.") + extension;
+        if (!writeSound(filename))
+        {
+            benchmark.skip("cannot write the sound file");
+            return;
+        }
+
+        std::vector<sf::Int16> buffer(4096);
+        benchmark.setItemsPerIteration(sampleRate * channelCount * 10);
+        benchmark.setBytesPerIteration(sampleRate * channelCount * 10 * sizeof(sf::Int16));
+
+        while (benchmark.keepRunning())
+        {
+            sf::InputSoundFile file;
+            if (!file.openFromFile(filename))
+            {
+                benchmark.skip("cannot read the sound file");
+                break;
+            }
+
+            while (file.read(&buffer[0], buffer.size()) > 0)
+            {
+            }
+        }
+
+        std::remove(filename.c_str());
+    }
+
+    void decodeWav(Benchmark& benchmark)
+    {
+        decode(benchmark, "wav");
+    }
+
+    void decodeOgg(Benchmark& benchmark)
+    {
+        decode(benchmark, "ogg");
+    }
+
+    void decodeFlac(Benchmark& benchmark)
+    {
+        decode(benchmark, "flac");
+    }
+
+    SFML_BENCHMARK("audio", "decode_wav", decodeWav);
+    SFML_BENCHMARK("audio", "decode_ogg", decodeOgg);
+    SFML_BENCHMARK("audio", "decode_flac", decodeFlac);
+}
@@ -0,0 +1,337 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+    struct Entry
+    {
+        std::string         module;
+        std::string         name;
+        Benchmark::Function function;
+    };
+
+    // Benchmarks of all the modules, filled by the registrations
+    std::vector<Entry>& getEntries()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    std::string resourceDirectory = SFML_BENCHMARK_RESOURCES;
+
+    // Escape a string for JSON and CSV output
+    std::string quote(const std::string& value)
+    {
+        std::string result = "\"";
+        for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+        {
+            if ((*it == '"') || (*it == '\\'))
+                result += '\\';
+            result += *it;
+        }
+
+        return result + "\"";
+    }
+
+    // Print a rate in readable units
+    std::string formatRate(double value, const char* unit)
+    {
+        static const char* prefixes[] = {"", "K", "M", "G", "T"};
+
+        std::size_t prefix = 0;
+        while ((value >= 1000.0) && (prefix < 4))
+        {
+            value /= 1000.0;
+            ++prefix;
+        }
+
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(2) << value << ' ' << prefixes[prefix] << unit;
+        return stream.str();
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: sfml-benchmarks [options]\n"
+                     "  --filter=<text>     only run the benchmarks whose \"module/name\" contains <text>\n"
+                     "  --format=<format>   output format: table (default), json or csv\n"
+                     "  --min-time=<sec>    minimum measuring time of each benchmark (default 0.5)\n"
+                     "  --resources=<dir>   directory of the resource files\n"
+                     "  --list              list the benchmarks without running them\n";
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Benchmark::Benchmark(const std::string& module, const std::string& name, sf::Time minTime) :
+m_module    (module),
+m_name      (name),
+m_minTime   (minTime),
+m_clock     (),
+m_elapsed   (),
+m_iterations(0),
+m_bytes     (0),
+m_items     (0),
+m_skipReason(),
+m_failReason(),
+m_started   (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Benchmark::keepRunning()
+{
+    if (!m_started)
+    {
+        m_started = true;
+        m_clock.restart();
+        return true;
+    }
+
+    ++m_iterations;
+    m_elapsed = m_clock.getElapsedTime();
+
+    return m_elapsed < m_minTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void Benchmark::setBytesPerIteration(sf::Uint64 bytes)
+{
+    m_bytes = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void Benchmark::setItemsPerIteration(sf::Uint64 items)
+{
+    m_items = items;
+}
+
+
+////////////////////////////////////////////////////////////
+void Benchmark::skip(const std::string& reason)
+{
+    m_skipReason = reason;
+}
+
+
+////////////////////////////////////////////////////////////
+void Benchmark::fail(const std::string& reason)
+{
+    m_failReason = reason;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Benchmark::getModule() const
+{
+    return m_module;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Benchmark::getName() const
+{
+    return m_name;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Benchmark::getSkipReason() const
+{
+    return m_skipReason;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Benchmark::getFailReason() const
+{
+    return m_failReason;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Uint64 Benchmark::getIterations() const
+{
+    return m_iterations;
+}
+
+
+////////////////////////////////////////////////////////////
+sf::Time Benchmark::getElapsedTime() const
+{
+    return m_elapsed;
+}
+
+
+////////////////////////////////////////////////////////////
+double Benchmark::getBytesPerSecond() const
+{
+    double seconds = m_elapsed.asSeconds();
+    return seconds > 0 ? static_cast<double>(m_bytes) * static_cast<double>(m_iterations) / seconds : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+double Benchmark::getItemsPerSecond() const
+{
+    double seconds = m_elapsed.asSeconds();
+    return seconds > 0 ? static_cast<double>(m_items) * static_cast<double>(m_iterations) / seconds : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+BenchmarkRegistration::BenchmarkRegistration(const char* module, const char* name, Benchmark::Function function)
+{
+    Entry entry;
+    entry.module = module;
+    entry.name = name;
+    entry.function = function;
+    getEntries().push_back(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string getResourcePath(const std::string& filename)
+{
+    return resourceDirectory + "/" + filename;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Parse the command line
+    std::string filter;
+    std::string format = "table";
+    sf::Time minTime = sf::seconds(0.5f);
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+
+        if (argument.compare(0, 9, "--filter=") == 0)
+            filter = argument.substr(9);
+        else if (argument.compare(0, 9, "--format=") == 0)
+            format = argument.substr(9);
+        else if (argument.compare(0, 11, "--min-time=") == 0)
+            minTime = sf::seconds(static_cast<float>(std::atof(argument.substr(11).c_str())));
+        else if (argument.compare(0, 12, "--resources=") == 0)
+            resourceDirectory = argument.substr(12);
+        else if (argument == "--list")
+            list = true;
+        else
+        {
+            printUsage();
+            return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if ((format != "table") && (format != "json") && (format != "csv"))
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    if (format == "json")
+        std::cout << "[";
+    else if (format == "csv")
+        std::cout << "module,name,iterations,seconds,ns_per_iteration,bytes_per_second,items_per_second,skipped,failed" << std::endl;
+
+    bool first = true;
+    bool failures = false;
+    const std::vector<Entry>& entries = getEntries();
+    for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        std::string fullName = it->module + "/" + it->name;
+        if (fullName.find(filter) == std::string::npos)
+            continue;
+
+        if (list)
+        {
+            std::cout << fullName << std::endl;
+            continue;
+        }
+
+        // Run the benchmark
+        Benchmark benchmark(it->module, it->name, minTime);
+        it->function(benchmark);
+
+        double seconds = benchmark.getElapsedTime().asSeconds();
+        double nanoseconds = benchmark.getIterations() ? seconds * 1e9 / static_cast<double>(benchmark.getIterations()) : 0;
+        bool skipped = !benchmark.getSkipReason().empty();
+        bool failed = !benchmark.getFailReason().empty();
+        failures = failures || failed;
+
+        // Print the result
+        if (format == "json")
+        {
+            std::cout << (first ? "\n" : ",\n")
+                      << "  {\"module\": " << quote(it->module)
+                      << ", \"name\": " << quote(it->name)
+                      << ", \"iterations\": " << benchmark.getIterations()
+                      << ", \"seconds\": " << seconds
+                      << ", \"ns_per_iteration\": " << nanoseconds
+                      << ", \"bytes_per_second\": " << benchmark.getBytesPerSecond()
+                      << ", \"items_per_second\": " << benchmark.getItemsPerSecond();
+            if (skipped)
+                std::cout << ", \"skipped\": " << quote(benchmark.getSkipReason());
+            if (failed)
+                std::cout << ", \"failed\": " << quote(benchmark.getFailReason());
+            std::cout << "}" << std::flush;
+        }
+        else if (format == "csv")
+        {
+            std::cout << quote(it->module) << ',' << quote(it->name) << ',' << benchmark.getIterations() << ','
+                      << seconds << ',' << nanoseconds << ',' << benchmark.getBytesPerSecond() << ','
+                      << benchmark.getItemsPerSecond() << ',' << quote(benchmark.getSkipReason()) << ','
+                      << quote(benchmark.getFailReason()) << std::endl;
+        }
+        else
+        {
+            std::cout << std::left << std::setw(40) << fullName << std::right;
+            if (skipped)
+            {
+                std::cout << "skipped (" << benchmark.getSkipReason() << ")" << std::endl;
+                continue;
+            }
+
+            if (failed)
+            {
+                std::cout << "FAILED (" << benchmark.getFailReason() << ")" << std::endl;
+                continue;
+            }
+
+            std::cout << std::setw(14) << std::fixed << std::setprecision(0) << nanoseconds << " ns/iter";
+            if (benchmark.getBytesPerSecond() > 0)
+                std::cout << "  " << std::setw(12) << formatRate(benchmark.getBytesPerSecond(), "B/s");
+            if (benchmark.getItemsPerSecond() > 0)
+                std::cout << "  " << std::setw(14) << formatRate(benchmark.getItemsPerSecond(), "items/s");
+            std::cout << std::endl;
+        }
+
+        first = false;
+    }
+
+    if (format == "json")
+        std::cout << "\n]" << std::endl;
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
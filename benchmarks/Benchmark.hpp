@@ -0,0 +1,92 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Clock.hpp>
+#include <string>
+
+
+////////////////////////////////////////////////////////////
+/// State of a running benchmark
+///
+/// A benchmark function repeats its work while keepRunning()
+/// returns true; only the time spent inside the loop is
+/// measured, so setup can be done before it:
+///
+/// void drawSprites(Benchmark& benchmark)
+/// {
+///     ... setup ...
+///     benchmark.setItemsPerIteration(1000);
+///     while (benchmark.keepRunning())
+///         ... draw 1000 sprites ...
+/// }
+///
+////////////////////////////////////////////////////////////
+class Benchmark
+{
+public:
+
+    typedef void (*Function)(Benchmark& benchmark);
+
+    Benchmark(const std::string& module, const std::string& name, sf::Time minTime);
+
+    // Return true while the work must be repeated
+    bool keepRunning();
+
+    // Processing rate reported along with the time (bytes or items handled by one iteration)
+    void setBytesPerIteration(sf::Uint64 bytes);
+    void setItemsPerIteration(sf::Uint64 items);
+
+    // Report that the benchmark can't run on this machine
+    void skip(const std::string& reason);
+
+    // Report that the work gave a wrong result, the suite then exits with an error
+    void fail(const std::string& reason);
+
+    const std::string& getModule() const;
+    const std::string& getName() const;
+    const std::string& getSkipReason() const;
+    const std::string& getFailReason() const;
+    sf::Uint64 getIterations() const;
+    sf::Time getElapsedTime() const;
+    double getBytesPerSecond() const;
+    double getItemsPerSecond() const;
+
+private:
+
+    std::string m_module;
+    std::string m_name;
+    sf::Time    m_minTime;
+    sf::Clock   m_clock;
+    sf::Time    m_elapsed;
+    sf::Uint64  m_iterations;
+    sf::Uint64  m_bytes;
+    sf::Uint64  m_items;
+    std::string m_skipReason;
+    std::string m_failReason;
+    bool        m_started;
+};
+
+
+////////////////////////////////////////////////////////////
+/// Add a benchmark to the suite, at static initialization
+///
+////////////////////////////////////////////////////////////
+struct BenchmarkRegistration
+{
+    BenchmarkRegistration(const char* module, const char* name, Benchmark::Function function);
+};
+
+#define SFML_BENCHMARK(module, name, function) \
+    static BenchmarkRegistration function##Registration(module, name, function)
+
+
+////////////////////////////////////////////////////////////
+/// Get the path of a file of the resources directory
+///
+////////////////////////////////////////////////////////////
+std::string getResourcePath(const std::string& filename);
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int targetWidth  = 1024;
+    const unsigned int targetHeight = 768;
+
+    ////////////////////////////////////////////////////////////
+    /// Create the render texture the drawing benchmarks draw to
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createTarget(Benchmark& benchmark, sf::RenderTexture& target)
+    {
+        if (!target.create(targetWidth, targetHeight))
+        {
+            benchmark.skip("cannot create a render texture");
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Drawing of many sprites sharing a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawSprites(Benchmark& benchmark)
+    {
+        sf::RenderTexture target;
+        sf::Texture texture;
+        if (!createTarget(benchmark, target) || !texture.create(64, 64))
+            return;
+
+        const std::size_t count = 10000;
+        std::vector<sf::Sprite> sprites(count, sf::Sprite(texture));
+        for (std::size_t i = 0; i < count; ++i)
+            sprites[i].setPosition(static_cast<float>(i % targetWidth), static_cast<float>((i * 7) % targetHeight));
+
+        benchmark.setItemsPerIteration(count);
+        while (benchmark.keepRunning())
+        {
+            target.clear();
+            for (std::size_t i = 0; i < count; ++i)
+                target.draw(sprites[i]);
+            target.display();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Drawing of many texts with a cached layout
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawTexts(Benchmark& benchmark)
+    {
+        sf::RenderTexture target;
+        sf::Font font;
+        if (!createTarget(benchmark, target))
+            return;
+
+        if (!font.loadFromFile(getResourcePath("sansation.ttf")))
+        {
+            benchmark.skip("cannot load sansation.ttf");
+            return;
+        }
+
+        const std::size_t count = 1000;
+        std::vector<sf::Text> texts(count, sf::Text("The quick brown fox jumps over the lazy dog", font, 16));
+        for (std::size_t i = 0; i < count; ++i)
+            texts[i].setPosition(static_cast<float>((i * 13) % targetWidth), static_cast<float>((i * 7) % targetHeight));
+
+        benchmark.setItemsPerIteration(count);
+        while (benchmark.keepRunning())
+        {
+            target.clear();
+            for (std::size_t i = 0; i < count; ++i)
+                target.draw(texts[i]);
+            target.display();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Drawing of many outlined shapes
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawShapes(Benchmark& benchmark)
+    {
+        sf::RenderTexture target;
+        if (!createTarget(benchmark, target))
+            return;
+
+        const std::size_t count = 5000;
+        sf::CircleShape circle(10.f, 30);
+        circle.setOutlineThickness(2.f);
+        circle.setOutlineColor(sf::Color::Red);
+        std::vector<sf::CircleShape> shapes(count, circle);
+        for (std::size_t i = 0; i < count; ++i)
+            shapes[i].setPosition(static_cast<float>((i * 13) % targetWidth), static_cast<float>((i * 7) % targetHeight));
+
+        benchmark.setItemsPerIteration(count);
+        while (benchmark.keepRunning())
+        {
+            target.clear();
+            for (std::size_t i = 0; i < count; ++i)
+                target.draw(shapes[i]);
+            target.display();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Rasterization of glyphs by a freshly loaded font
+    ///
+    ////////////////////////////////////////////////////////////
+    void loadGlyphs(Benchmark& benchmark)
+    {
+        std::ifstream file(getResourcePath("sansation.ttf").c_str(), std::ios_base::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (data.empty())
+        {
+            benchmark.skip("cannot load sansation.ttf");
+            return;
+        }
+
+        benchmark.setItemsPerIteration(95);
+        while (benchmark.keepRunning())
+        {
+            sf::Font font;
+            font.loadFromMemory(&data[0], data.size());
+            for (sf::Uint32 character = 32; character < 127; ++character)
+                font.getGlyph(character, 24, false);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Pixel operations of sf::Image
+    ///
+    ////////////////////////////////////////////////////////////
+    void processImage(Benchmark& benchmark)
+    {
+        sf::Image image;
+        image.create(1024, 1024, sf::Color(10, 20, 30));
+        sf::Image stamp;
+        stamp.create(256, 256, sf::Color(0, 0, 0, 128));
+
+        benchmark.setBytesPerIteration(1024 * 1024 * 4);
+        while (benchmark.keepRunning())
+        {
+            image.flipHorizontally();
+            image.flipVertically();
+            image.createMaskFromColor(sf::Color::Black);
+            image.copy(stamp, 100, 100, sf::IntRect(0, 0, 0, 0), true);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Bandwidth of texture uploads
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTexture(Benchmark& benchmark)
+    {
+        sf::Texture texture;
+        if (!texture.create(1024, 1024))
+        {
+            benchmark.skip("cannot create a texture");
+            return;
+        }
+
+        std::vector<sf::Uint8> pixels(1024 * 1024 * 4, 128);
+
+        benchmark.setBytesPerIteration(pixels.size());
+        while (benchmark.keepRunning())
+            texture.update(&pixels[0]);
+    }
+
+    SFML_BENCHMARK("graphics", "draw_sprites", drawSprites);
+    SFML_BENCHMARK("graphics", "draw_texts", drawTexts);
+    SFML_BENCHMARK("graphics", "draw_shapes", drawShapes);
+    SFML_BENCHMARK("graphics", "font_glyph_loading", loadGlyphs);
+    SFML_BENCHMARK("graphics", "image_operations", processImage);
+    SFML_BENCHMARK("graphics", "texture_update", updateTexture);
+}
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Network.hpp>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    /// Writing and reading back a packet of mixed values
+    ///
+    ////////////////////////////////////////////////////////////
+    void serializePacket(Benchmark& benchmark)
+    {
+        const std::string name = "player name";
+        sf::Packet packet;
+
+        benchmark.setItemsPerIteration(100);
+        while (benchmark.keepRunning())
+        {
+            packet.clear();
+            for (sf::Int32 i = 0; i < 100; ++i)
+                packet << i << static_cast<float>(i) * 0.5f << name << static_cast<sf::Uint8>(i);
+
+            sf::Int32 integer;
+            float real;
+            std::string string;
+            sf::Uint8 byte;
+            for (int i = 0; i < 100; ++i)
+                packet >> integer >> real >> string >> byte;
+        }
+
+        benchmark.setBytesPerIteration(packet.getDataSize());
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Thread receiving and discarding all the data of a connection
+    ///
+    ////////////////////////////////////////////////////////////
+    void receiveAll(sf::TcpSocket* socket)
+    {
+        std::vector<char> buffer(65536);
+        std::size_t received;
+        while (socket->receive(&buffer[0], buffer.size(), received) == sf::Socket::Done)
+        {
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Throughput of a TCP connection over the loopback interface
+    ///
+    ////////////////////////////////////////////////////////////
+    void tcpLoopback(Benchmark& benchmark)
+    {
+        sf::TcpListener listener;
+        if (listener.listen(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done)
+        {
+            benchmark.skip("cannot listen on the loopback interface");
+            return;
+        }
+
+        sf::TcpSocket client;
+        sf::TcpSocket server;
+        if ((client.connect(sf::IpAddress::LocalHost, listener.getLocalPort()) != sf::Socket::Done) ||
+            (listener.accept(server) != sf::Socket::Done))
+        {
+            benchmark.skip("cannot connect on the loopback interface");
+            return;
+        }
+
+        sf::Thread receiver(&receiveAll, &server);
+        receiver.launch();
+
+        std::vector<char> data(65536, 'x');
+        benchmark.setBytesPerIteration(data.size());
+        while (benchmark.keepRunning())
+        {
+            if (client.send(&data[0], data.size()) != sf::Socket::Done)
+                benchmark.skip("connection lost");
+        }
+
+        client.disconnect();
+        receiver.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Bursts of reliable messages between two connections over the
+    /// loopback interface, which must get through without any resend
+    ///
+    ////////////////////////////////////////////////////////////
+    void udpConnectionBurst(Benchmark& benchmark)
+    {
+        sf::UdpSocket senderSocket;
+        sf::UdpSocket receiverSocket;
+        if ((senderSocket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done) ||
+            (receiverSocket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost) != sf::Socket::Done))
+        {
+            benchmark.skip("cannot bind on the loopback interface");
+            return;
+        }
+
+        sf::UdpConnection sender(senderSocket, sf::IpAddress::LocalHost, receiverSocket.getLocalPort());
+        sf::UdpConnection receiver(receiverSocket, sf::IpAddress::LocalHost, senderSocket.getLocalPort());
+
+        const int messageCount = 2000;
+        const std::string payload(250, 'x');
+
+        benchmark.setItemsPerIteration(messageCount);
+        while (benchmark.keepRunning())
+        {
+            for (int i = 0; i < messageCount; ++i)
+            {
+                sf::Packet packet;
+                packet << payload;
+                sender.send(packet);
+            }
+
+            // Exchange until everything is delivered, the messages that don't fit a single update wait for the acknowledgements
+            int received = 0;
+            sf::Clock clock;
+            while (received < messageCount)
+            {
+                if (clock.getElapsedTime() > sf::seconds(5.f))
+                {
+                    benchmark.skip("the messages didn't get through");
+                    return;
+                }
+
+                sender.update();
+                receiver.poll();
+                receiver.update();
+                sender.poll();
+
+                sf::Packet packet;
+                while (receiver.receive(packet))
+                    ++received;
+            }
+        }
+
+        if (sender.getStatistics().messagesResent > 0)
+        {
+            std::ostringstream reason;
+            reason << sender.getStatistics().messagesResent << " messages were resent over the loopback interface";
+            benchmark.fail(reason.str());
+        }
+    }
+
+    SFML_BENCHMARK("network", "packet_serialization", serializePacket);
+    SFML_BENCHMARK("network", "tcp_loopback", tcpLoopback);
+    SFML_BENCHMARK("network", "udp_connection_burst", udpConnectionBurst);
+}
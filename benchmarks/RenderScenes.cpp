@@ -0,0 +1,593 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    /// Deterministic random numbers, so that every run draws the same frames
+    ///
+    ////////////////////////////////////////////////////////////
+    class Random
+    {
+    public:
+
+        Random() : m_state(12345) {}
+
+        float next(float min, float max)
+        {
+            m_state = m_state * 1664525u + 1013904223u;
+            return min + (max - min) * static_cast<float>(m_state >> 8) / 16777216.f;
+        }
+
+    private:
+
+        sf::Uint32 m_state;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Base class of the standardized scenes
+    ///
+    ////////////////////////////////////////////////////////////
+    class Scene
+    {
+    public:
+
+        explicit Scene(const std::string& name) : m_name(name) {}
+        virtual ~Scene() {}
+
+        const std::string& getName() const {return m_name;}
+
+        // Create the resources of the scene, return an error message on failure
+        virtual std::string setup(const sf::Vector2u& size) = 0;
+
+        // Draw one frame of the scene
+        virtual void draw(sf::RenderTarget& target) = 0;
+
+    private:
+
+        std::string m_name;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Create a texture made of 4x4 tiles of different colors
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createAtlas(sf::Texture& texture)
+    {
+        sf::Image image;
+        image.create(256, 256);
+        for (unsigned int y = 0; y < 256; ++y)
+        {
+            for (unsigned int x = 0; x < 256; ++x)
+            {
+                unsigned int tile = (y / 64) * 4 + x / 64;
+                sf::Uint8 shade = ((x / 8 + y / 8) % 2) ? 255 : 160;
+                image.setPixel(x, y, sf::Color((tile * 53) % 256 * shade / 255, (tile * 97) % 256 * shade / 255, (tile * 31 + 64) % 256 * shade / 255));
+            }
+        }
+
+        return texture.loadFromImage(image);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// 100000 sprites taken from a texture atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    class SpriteScene : public Scene
+    {
+    public:
+
+        SpriteScene() : Scene("sprites") {}
+
+        virtual std::string setup(const sf::Vector2u& size)
+        {
+            if (!createAtlas(m_atlas))
+                return "cannot create the atlas texture";
+
+            Random random;
+            m_sprites.resize(100000);
+            for (std::size_t i = 0; i < m_sprites.size(); ++i)
+            {
+                int tile = static_cast<int>(i % 16);
+                m_sprites[i].setTexture(m_atlas);
+                m_sprites[i].setTextureRect(sf::IntRect((tile % 4) * 64, (tile / 4) * 64, 64, 64));
+                m_sprites[i].setOrigin(32.f, 32.f);
+                m_sprites[i].setPosition(random.next(0.f, static_cast<float>(size.x)), random.next(0.f, static_cast<float>(size.y)));
+                m_sprites[i].setRotation(random.next(0.f, 360.f));
+                m_sprites[i].setScale(0.25f, 0.25f);
+            }
+
+            return "";
+        }
+
+        virtual void draw(sf::RenderTarget& target)
+        {
+            for (std::size_t i = 0; i < m_sprites.size(); ++i)
+                target.draw(m_sprites[i]);
+        }
+
+    private:
+
+        sf::Texture             m_atlas;
+        std::vector<sf::Sprite> m_sprites;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Screen filled with lines of text of several sizes and styles
+    ///
+    ////////////////////////////////////////////////////////////
+    class TextScene : public Scene
+    {
+    public:
+
+        TextScene() : Scene("text_wall") {}
+
+        virtual std::string setup(const sf::Vector2u& size)
+        {
+            if (!m_font.loadFromFile(SFML_BENCHMARK_RESOURCES "/sansation.ttf"))
+                return "cannot load sansation.ttf";
+
+            const std::string line = "The quick brown fox jumps over the lazy dog. 0123456789 !?@#$%&*()[]{}<>/\\|";
+            float y = 0.f;
+            for (unsigned int i = 0; y < static_cast<float>(size.y); ++i)
+            {
+                sf::Text text(line, m_font, 12 + (i % 5) * 2);
+                text.setPosition(0.f, y);
+                text.setFillColor(sf::Color(255, static_cast<sf::Uint8>(128 + (i * 37) % 128), static_cast<sf::Uint8>((i * 71) % 256)));
+                text.setStyle((i % 3 == 0) ? sf::Text::Bold : (i % 3 == 1) ? sf::Text::Italic : sf::Text::Underlined);
+                if (i % 4 == 0)
+                {
+                    text.setOutlineThickness(1.f);
+                    text.setOutlineColor(sf::Color::Black);
+                }
+                m_texts.push_back(text);
+
+                y += m_font.getLineSpacing(text.getCharacterSize());
+            }
+
+            return "";
+        }
+
+        virtual void draw(sf::RenderTarget& target)
+        {
+            for (std::size_t i = 0; i < m_texts.size(); ++i)
+                target.draw(m_texts[i]);
+        }
+
+    private:
+
+        sf::Font              m_font;
+        std::vector<sf::Text> m_texts;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Untextured shapes drawn as triangle fans, with outlines
+    ///
+    ////////////////////////////////////////////////////////////
+    class ShapeScene : public Scene
+    {
+    public:
+
+        ShapeScene() : Scene("shape_fans") {}
+
+        virtual std::string setup(const sf::Vector2u& size)
+        {
+            Random random;
+            for (int i = 0; i < 2000; ++i)
+            {
+                sf::CircleShape circle(random.next(5.f, 40.f), 8 + i % 57);
+                circle.setOrigin(circle.getRadius(), circle.getRadius());
+                circle.setPosition(random.next(0.f, static_cast<float>(size.x)), random.next(0.f, static_cast<float>(size.y)));
+                circle.setFillColor(sf::Color(static_cast<sf::Uint8>(i * 13), static_cast<sf::Uint8>(i * 29), static_cast<sf::Uint8>(i * 7), 200));
+                circle.setOutlineThickness(i % 2 ? 2.f : 0.f);
+                circle.setOutlineColor(sf::Color::White);
+                m_circles.push_back(circle);
+            }
+
+            for (int i = 0; i < 500; ++i)
+            {
+                sf::ConvexShape star(10);
+                float radius = random.next(10.f, 30.f);
+                for (std::size_t j = 0; j < 10; ++j)
+                {
+                    float angle = static_cast<float>(j) * 3.14159265f / 5.f;
+                    float distance = (j % 2) ? radius / 2.f : radius;
+                    star.setPoint(j, sf::Vector2f(std::cos(angle) * distance, std::sin(angle) * distance));
+                }
+                star.setPosition(random.next(0.f, static_cast<float>(size.x)), random.next(0.f, static_cast<float>(size.y)));
+                star.setFillColor(sf::Color(255, 220, 0, 220));
+                m_stars.push_back(star);
+            }
+
+            return "";
+        }
+
+        virtual void draw(sf::RenderTarget& target)
+        {
+            for (std::size_t i = 0; i < m_circles.size(); ++i)
+                target.draw(m_circles[i]);
+            for (std::size_t i = 0; i < m_stars.size(); ++i)
+                target.draw(m_stars[i]);
+        }
+
+    private:
+
+        std::vector<sf::CircleShape> m_circles;
+        std::vector<sf::ConvexShape> m_stars;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Sprites rendered offscreen, then blurred by several full-screen shader passes
+    ///
+    ////////////////////////////////////////////////////////////
+    class ShaderScene : public Scene
+    {
+    public:
+
+        ShaderScene() : Scene("shader_passes") {}
+
+        virtual std::string setup(const sf::Vector2u& size)
+        {
+            if (!sf::Shader::isAvailable())
+                return "shaders are not supported";
+
+            // Separable gaussian blur, applied along the given direction
+            const std::string blur =
+                "uniform sampler2D source;"
+                "uniform vec2 direction;"
+                "void main()"
+                "{"
+                "    vec2 uv = gl_TexCoord[0].xy;"
+                "    vec4 color = texture2D(source, uv) * 0.2270270270;"
+                "    color += (texture2D(source, uv + direction * 1.3846153846) + texture2D(source, uv - direction * 1.3846153846)) * 0.3162162162;"
+                "    color += (texture2D(source, uv + direction * 3.2307692308) + texture2D(source, uv - direction * 3.2307692308)) * 0.0702702703;"
+                "    gl_FragColor = gl_Color * color;"
+                "}";
+
+            if (!m_blur.loadFromMemory(blur, sf::Shader::Fragment))
+                return "cannot compile the blur shader";
+
+            if (!m_passes[0].create(size.x, size.y) || !m_passes[1].create(size.x, size.y) || !m_scene.setup(size).empty())
+                return "cannot create the offscreen targets";
+
+            m_blur.setUniform("source", sf::Shader::CurrentTexture);
+            m_size = sf::Vector2f(static_cast<float>(size.x), static_cast<float>(size.y));
+
+            return "";
+        }
+
+        virtual void draw(sf::RenderTarget& target)
+        {
+            m_passes[0].clear();
+            m_scene.draw(m_passes[0]);
+            m_passes[0].display();
+
+            // Blur horizontally then vertically, three times
+            for (int i = 0; i < 6; ++i)
+            {
+                sf::RenderTexture& source      = m_passes[i % 2];
+                sf::RenderTexture& destination = m_passes[(i + 1) % 2];
+
+                m_blur.setUniform("direction", (i % 2) ? sf::Glsl::Vec2(0.f, 1.f / m_size.y) : sf::Glsl::Vec2(1.f / m_size.x, 0.f));
+                destination.clear();
+                destination.draw(sf::Sprite(source.getTexture()), &m_blur);
+                destination.display();
+            }
+
+            target.draw(sf::Sprite(m_passes[0].getTexture()));
+        }
+
+    private:
+
+        SpriteScene       m_scene;
+        sf::Shader        m_blur;
+        sf::RenderTexture m_passes[2];
+        sf::Vector2f      m_size;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Measurements of a scene
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        std::string                     name;
+        std::string                     error;
+        std::vector<sf::Time>           cpuTimes;
+        std::vector<sf::Time>           gpuTimes;
+        sf::RenderTarget::Statistics    statistics;
+        std::string                     comparison;
+        bool                            failed;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Compare a frame with its golden reference
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string compare(const sf::Image& frame, const std::string& referencePath, unsigned int threshold, double tolerance, bool& failed)
+    {
+        sf::Image reference;
+        if (!reference.loadFromFile(referencePath))
+            return "no reference";
+
+        if (reference.getSize() != frame.getSize())
+        {
+            failed = true;
+            return "size mismatch";
+        }
+
+        // Count the pixels that differ by more than the threshold on any channel
+        const sf::Uint8* a = frame.getPixelsPtr();
+        const sf::Uint8* b = reference.getPixelsPtr();
+        std::size_t pixelCount = frame.getSize().x * frame.getSize().y;
+        std::size_t different = 0;
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                int difference = static_cast<int>(a[i * 4 + c]) - static_cast<int>(b[i * 4 + c]);
+                if (static_cast<unsigned int>(std::abs(difference)) > threshold)
+                {
+                    ++different;
+                    break;
+                }
+            }
+        }
+
+        double ratio = static_cast<double>(different) / static_cast<double>(pixelCount);
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(4) << (ratio * 100.0) << "% pixels differ";
+
+        if (ratio > tolerance)
+        {
+            failed = true;
+            return "mismatch, " + stream.str();
+        }
+
+        return "match, " + stream.str();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Mean of a set of times, in milliseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    double mean(const std::vector<sf::Time>& times)
+    {
+        if (times.empty())
+            return 0.0;
+
+        double total = 0.0;
+        for (std::size_t i = 0; i < times.size(); ++i)
+            total += times[i].asMicroseconds();
+
+        return total / static_cast<double>(times.size()) / 1000.0;
+    }
+
+    double percentile(std::vector<sf::Time> times, double fraction)
+    {
+        if (times.empty())
+            return 0.0;
+
+        std::sort(times.begin(), times.end());
+        std::size_t index = std::min(times.size() - 1, static_cast<std::size_t>(fraction * static_cast<double>(times.size())));
+        return times[index].asMicroseconds() / 1000.0;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: sfml-render-scenes [options]\n"
+                     "  --scene=<name>        only run the scenes whose name contains <name>\n"
+                     "  --frames=<count>      number of measured frames (default 100)\n"
+                     "  --warmup=<count>      number of frames rendered before measuring (default 10)\n"
+                     "  --size=<w>x<h>        size of the render texture (default 1280x720)\n"
+                     "  --golden=<dir>        existing directory of the reference images (default: benchmarks/golden)\n"
+                     "  --update-golden       write the last frame of each scene as its reference\n"
+                     "  --output=<dir>        write the last frame of each scene to this directory\n"
+                     "  --threshold=<value>   channel difference above which a pixel differs (default 16)\n"
+                     "  --tolerance=<ratio>   ratio of differing pixels accepted (default 0.001)\n"
+                     "  --headless            render without a display server (EGL backend)\n"
+                     "  --format=<format>     output format: table (default) or json\n";
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code: failure if a scene can't run or doesn't match its reference
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Parse the command line
+    std::string filter;
+    std::string goldenDirectory = SFML_BENCHMARK_GOLDEN;
+    std::string outputDirectory;
+    std::string format = "table";
+    unsigned int frameCount = 100;
+    unsigned int warmupCount = 10;
+    unsigned int threshold = 16;
+    double tolerance = 0.001;
+    sf::Vector2u size(1280, 720);
+    bool updateGolden = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        std::string value = argument.substr(argument.find('=') + 1);
+
+        if (argument.compare(0, 8, "--scene=") == 0)
+            filter = value;
+        else if (argument.compare(0, 9, "--frames=") == 0)
+            frameCount = static_cast<unsigned int>(std::max(1, std::atoi(value.c_str())));
+        else if (argument.compare(0, 9, "--warmup=") == 0)
+            warmupCount = static_cast<unsigned int>(std::max(0, std::atoi(value.c_str())));
+        else if (argument.compare(0, 7, "--size=") == 0)
+            std::sscanf(value.c_str(), "%ux%u", &size.x, &size.y);
+        else if (argument.compare(0, 9, "--golden=") == 0)
+            goldenDirectory = value;
+        else if (argument == "--update-golden")
+            updateGolden = true;
+        else if (argument.compare(0, 9, "--output=") == 0)
+            outputDirectory = value;
+        else if (argument.compare(0, 12, "--threshold=") == 0)
+            threshold = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else if (argument.compare(0, 12, "--tolerance=") == 0)
+            tolerance = std::atof(value.c_str());
+        else if (argument == "--headless")
+            sf::Context::setHeadless(true);
+        else if ((argument.compare(0, 9, "--format=") == 0) && ((value == "table") || (value == "json")))
+            format = value;
+        else
+        {
+            printUsage();
+            return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    // The standardized scenes
+    std::vector<Scene*> scenes;
+    scenes.push_back(new SpriteScene);
+    scenes.push_back(new TextScene);
+    scenes.push_back(new ShapeScene);
+    scenes.push_back(new ShaderScene);
+
+    sf::RenderTexture target;
+    if (!target.create(size.x, size.y))
+    {
+        std::cerr << "Failed to create the render texture" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Render each scene and measure its frames
+    std::vector<Result> results;
+    for (std::vector<Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+    {
+        Scene& scene = **it;
+        if (scene.getName().find(filter) == std::string::npos)
+            continue;
+
+        Result result;
+        result.name = scene.getName();
+        result.failed = false;
+        result.error = scene.setup(size);
+
+        if (result.error.empty())
+        {
+            sf::Clock clock;
+            for (unsigned int frame = 0; frame < warmupCount + frameCount; ++frame)
+            {
+                clock.restart();
+
+                target.clear(sf::Color(30, 30, 60));
+                scene.draw(target);
+                target.flush();
+
+                // Statistics are reset by display, read them once everything is submitted
+                sf::RenderTarget::Statistics statistics = target.getStatistics();
+                target.display();
+
+                sf::Time cpuTime = clock.getElapsedTime();
+                if (frame < warmupCount)
+                    continue;
+
+                result.cpuTimes.push_back(cpuTime);
+                result.statistics = statistics;
+                if (statistics.gpuTime != sf::Time::Zero)
+                    result.gpuTimes.push_back(statistics.gpuTime);
+            }
+
+            // Check the last frame against its reference
+            sf::Image image = target.getTexture().copyToImage();
+            std::string filename = scene.getName() + ".png";
+
+            if (!outputDirectory.empty())
+                image.saveToFile(outputDirectory + "/" + filename);
+
+            if (updateGolden)
+                result.comparison = image.saveToFile(goldenDirectory + "/" + filename) ? "updated" : "cannot write reference";
+            else
+                result.comparison = compare(image, goldenDirectory + "/" + filename, threshold, tolerance, result.failed);
+        }
+        else
+        {
+            result.failed = true;
+        }
+
+        results.push_back(result);
+    }
+
+    for (std::vector<Scene*>::iterator it = scenes.begin(); it != scenes.end(); ++it)
+        delete *it;
+
+    // Print the results
+    bool failed = false;
+    if (format == "json")
+        std::cout << "[";
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& result = results[i];
+        const sf::RenderTarget::Statistics& statistics = result.statistics;
+        failed = failed || result.failed;
+
+        if (format == "json")
+        {
+            std::cout << (i ? ",\n" : "\n") << "  {\"scene\": \"" << result.name << "\"";
+            if (!result.error.empty())
+            {
+                std::cout << ", \"error\": \"" << result.error << "\"}";
+                continue;
+            }
+
+            std::cout << ", \"frames\": " << result.cpuTimes.size()
+                      << ", \"cpu_ms_mean\": " << mean(result.cpuTimes)
+                      << ", \"cpu_ms_p95\": " << percentile(result.cpuTimes, 0.95)
+                      << ", \"gpu_ms_mean\": " << mean(result.gpuTimes)
+                      << ", \"draw_calls\": " << statistics.drawCalls
+                      << ", \"vertices\": " << statistics.vertices
+                      << ", \"texture_binds\": " << statistics.textureBinds
+                      << ", \"shader_binds\": " << statistics.shaderBinds
+                      << ", \"blend_mode_changes\": " << statistics.blendModeChanges
+                      << ", \"buffer_uploads\": " << statistics.bufferUploads
+                      << ", \"culled_drawables\": " << statistics.culledDrawables
+                      << ", \"comparison\": \"" << result.comparison << "\"}";
+        }
+        else
+        {
+            std::cout << std::left << std::setw(16) << result.name << std::right;
+            if (!result.error.empty())
+            {
+                std::cout << "failed (" << result.error << ")" << std::endl;
+                continue;
+            }
+
+            std::cout << std::fixed << std::setprecision(2)
+                      << "cpu " << std::setw(8) << mean(result.cpuTimes) << " ms (p95 " << percentile(result.cpuTimes, 0.95) << ")"
+                      << "  gpu " << std::setw(8) << mean(result.gpuTimes) << " ms"
+                      << "  draws " << statistics.drawCalls
+                      << "  vertices " << statistics.vertices
+                      << "  textures " << statistics.textureBinds
+                      << "  shaders " << statistics.shaderBinds
+                      << "  uploads " << statistics.bufferUploads
+                      << "  [" << result.comparison << "]" << std::endl;
+        }
+    }
+
+    if (format == "json")
+        std::cout << "\n]" << std::endl;
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/System.hpp>
+#include <string>
+
+
+namespace
+{
+    ////////////////////////////////////////////////////////////
+    /// Conversion of mostly ASCII text from and to UTF-8
+    ///
+    ////////////////////////////////////////////////////////////
+    void convertUtf8(Benchmark& benchmark)
+    {
+        std::string text;
+        for (int i = 0; i < 1000; ++i)
+            text += "The quick brown fox jumps over the lazy dog, \xC3\xA9t\xC3\xA9 \xE2\x82\xAC ";
+
+        benchmark.setBytesPerIteration(text.size() * 2);
+        while (benchmark.keepRunning())
+        {
+            sf::String string = sf::String::fromUtf8(text.begin(), text.end());
+            std::basic_string<sf::Uint8> utf8 = string.toUtf8();
+            if (utf8.size() != text.size())
+                benchmark.skip("conversion error");
+        }
+    }
+
+    SFML_BENCHMARK("system", "string_utf8_conversion", convertUtf8);
+}
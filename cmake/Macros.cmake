@@ -29,16 +29,43 @@ endfunction()
 macro(sfml_add_library target)
 
     # parse the arguments
-    cmake_parse_arguments(THIS "STATIC" "" "SOURCES" ${ARGN})
+    cmake_parse_arguments(THIS "STATIC" "" "SOURCES;UNITY_EXCLUDE" ${ARGN})
     if (NOT "${THIS_UNPARSED_ARGUMENTS}" STREQUAL "")
         message(FATAL_ERROR "Extra unparsed arguments when calling sfml_add_library: ${THIS_UNPARSED_ARGUMENTS}")
     endif()
 
+    # in unity builds, compile the C++ sources of the module as a single translation unit
+    # (Objective-C sources and the ones listed in UNITY_EXCLUDE are still compiled separately)
+    set(THIS_TARGET_SOURCES ${THIS_SOURCES})
+    if(SFML_UNITY_BUILD)
+        set(THIS_UNITY_CONTENT "// Generated by sfml_add_library, do not edit\n")
+        foreach(THIS_SOURCE ${THIS_SOURCES})
+            list(FIND THIS_UNITY_EXCLUDE "${THIS_SOURCE}" THIS_EXCLUDED)
+            if("${THIS_SOURCE}" MATCHES "\\.cpp$" AND THIS_EXCLUDED EQUAL -1)
+                get_filename_component(THIS_SOURCE_PATH "${THIS_SOURCE}" ABSOLUTE)
+                set(THIS_UNITY_CONTENT "${THIS_UNITY_CONTENT}#include \"${THIS_SOURCE_PATH}\"\n")
+                set_source_files_properties(${THIS_SOURCE} PROPERTIES HEADER_FILE_ONLY TRUE)
+            endif()
+        endforeach()
+
+        # only replace the file when its contents change, to avoid rebuilding the module at every configuration
+        set(THIS_UNITY_FILE "${CMAKE_CURRENT_BINARY_DIR}/${target}-unity.cpp")
+        file(WRITE "${THIS_UNITY_FILE}.in" "${THIS_UNITY_CONTENT}")
+        configure_file("${THIS_UNITY_FILE}.in" "${THIS_UNITY_FILE}" COPYONLY)
+        list(APPEND THIS_TARGET_SOURCES "${THIS_UNITY_FILE}")
+        source_group("" FILES "${THIS_UNITY_FILE}")
+    endif()
+
     # create the target
     if (THIS_STATIC)
-        add_library(${target} STATIC ${THIS_SOURCES})
+        add_library(${target} STATIC ${THIS_TARGET_SOURCES})
     else()
-        add_library(${target} ${THIS_SOURCES})
+        add_library(${target} ${THIS_TARGET_SOURCES})
+    endif()
+
+    # enable link-time optimization across the translation units of the module, if requested and supported
+    if(SFML_ENABLE_LTO AND SFML_LTO_SUPPORTED)
+        set_target_properties(${target} PROPERTIES INTERPROCEDURAL_OPTIMIZATION TRUE)
     endif()
 
     # define the export symbol of the module
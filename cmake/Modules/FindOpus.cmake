@@ -0,0 +1,23 @@
+#
+# Try to find the Opus and opusfile libraries and include paths.
+# Once done this will define
+#
+# OPUS_FOUND
+# OPUS_INCLUDE_DIRS
+# OPUS_LIBRARIES
+#
+
+find_path(OPUS_INCLUDE_DIR opus.h PATH_SUFFIXES opus)
+find_path(OPUSFILE_INCLUDE_DIR opusfile.h PATH_SUFFIXES opus)
+
+find_library(OPUS_LIBRARY NAMES opus)
+find_library(OPUSFILE_LIBRARY NAMES opusfile)
+set(OPUS_LIBRARIES ${OPUSFILE_LIBRARY} ${OPUS_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+
+find_package_handle_standard_args(OPUS DEFAULT_MSG OPUS_LIBRARY OPUSFILE_LIBRARY OPUS_INCLUDE_DIR OPUSFILE_INCLUDE_DIR)
+
+set(OPUS_INCLUDE_DIRS ${OPUS_INCLUDE_DIR} ${OPUSFILE_INCLUDE_DIR})
+
+mark_as_advanced(OPUS_INCLUDE_DIR OPUSFILE_INCLUDE_DIR OPUS_LIBRARY OPUSFILE_LIBRARY)
@@ -0,0 +1,17 @@
+#
+# Try to find the spng library and include path.
+# Once done this will define
+#
+# SPNG_FOUND
+# SPNG_INCLUDE_DIR
+# SPNG_LIBRARY
+#
+
+find_path(SPNG_INCLUDE_DIR spng.h)
+
+find_library(SPNG_LIBRARY NAMES spng spng_static)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(SPNG DEFAULT_MSG SPNG_LIBRARY SPNG_INCLUDE_DIR)
+
+mark_as_advanced(SPNG_INCLUDE_DIR SPNG_LIBRARY)
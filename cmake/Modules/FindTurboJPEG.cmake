@@ -0,0 +1,17 @@
+#
+# Try to find the TurboJPEG library (libjpeg-turbo) and include path.
+# Once done this will define
+#
+# TURBOJPEG_FOUND
+# TURBOJPEG_INCLUDE_DIR
+# TURBOJPEG_LIBRARY
+#
+
+find_path(TURBOJPEG_INCLUDE_DIR turbojpeg.h)
+
+find_library(TURBOJPEG_LIBRARY NAMES turbojpeg turbojpeg-static)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(TurboJPEG DEFAULT_MSG TURBOJPEG_LIBRARY TURBOJPEG_INCLUDE_DIR)
+
+mark_as_advanced(TURBOJPEG_INCLUDE_DIR TURBOJPEG_LIBRARY)
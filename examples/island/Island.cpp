@@ -6,10 +6,8 @@
 #include "stb_perlin.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <deque>
 #include <sstream>
 #include <algorithm>
-#include <cstring>
 #include <cmath>
 
 
@@ -31,14 +29,12 @@ namespace
     {
         sf::Vertex* targetBuffer;
         unsigned int index;
+
+        void operator()() const;
     };
 
-    std::deque<WorkItem> workQueue;
-    std::vector<sf::Thread*> threads;
-    int pendingWorkCount = 0;
-    bool workPending = true;
+    std::vector<sf::ThreadPool::Task> workTasks;
     bool bufferUploadPending = false;
-    sf::Mutex workQueueMutex;
 
     struct Setting
     {
@@ -67,8 +63,8 @@ namespace
 
 
 // Forward declarations of the functions we define further down
-void threadFunction();
-void generateTerrain(sf::Vertex* vertexBuffer);
+bool isTerrainGenerated();
+void generateTerrain(sf::ThreadPool& threadPool, sf::Vertex* vertexBuffer);
 
 
 ////////////////////////////////////////////////////////////
@@ -112,6 +108,9 @@ int main()
     // Staging buffer for our terrain data that we will upload to our VertexBuffer
     std::vector<sf::Vertex> terrainStagingBuffer;
 
+    // Worker threads generating the terrain
+    sf::ThreadPool threadPool(threadCount);
+
     // Check whether the prerequisites are suppprted
     bool prerequisitesSupported = sf::VertexBuffer::isAvailable() && sf::Shader::isAvailable();
 
@@ -128,13 +127,6 @@ int main()
     }
     else
     {
-        // Start up our thread pool
-        for (unsigned int i = 0; i < threadCount; i++)
-        {
-            threads.push_back(new sf::Thread(threadFunction));
-            threads.back()->launch();
-        }
-
         // Create our VertexBuffer with enough space to hold all the terrain geometry
         terrain.create(resolutionX * resolutionY * 6);
 
@@ -142,7 +134,7 @@ int main()
         terrainStagingBuffer.resize(resolutionX * resolutionY * 6);
 
         // Generate the initial terrain
-        generateTerrain(&terrainStagingBuffer[0]);
+        generateTerrain(threadPool, &terrainStagingBuffer[0]);
 
         statusText.setString("Generating Terrain...");
     }
@@ -189,7 +181,7 @@ int main()
             {
                 switch (event.key.code)
                 {
-                    case sf::Keyboard::Return: generateTerrain(&terrainStagingBuffer[0]); break;
+                    case sf::Keyboard::Return: generateTerrain(threadPool, &terrainStagingBuffer[0]); break;
                     case sf::Keyboard::Down:   currentSetting = (currentSetting + 1) % settingCount; break;
                     case sf::Keyboard::Up:     currentSetting = (currentSetting + settingCount - 1) % settingCount; break;
                     case sf::Keyboard::Left:   *(settings[currentSetting].value) -= 0.1f; break;
@@ -206,22 +198,18 @@ int main()
 
         if (prerequisitesSupported)
         {
+            // Don't bother updating/drawing the VertexBuffer while terrain is being regenerated
+            if (isTerrainGenerated())
             {
-                sf::Lock lock(workQueueMutex);
-
-                // Don't bother updating/drawing the VertexBuffer while terrain is being regenerated
-                if (!pendingWorkCount)
+                // If there is new data pending to be uploaded to the VertexBuffer, do it now
+                if (bufferUploadPending)
                 {
-                    // If there is new data pending to be uploaded to the VertexBuffer, do it now
-                    if (bufferUploadPending)
-                    {
-                        terrain.update(&terrainStagingBuffer[0]);
-                        bufferUploadPending = false;
-                    }
-
-                    terrainShader.setUniform("lightFactor", lightFactor);
-                    window.draw(terrain, terrainStates);
+                    terrain.update(&terrainStagingBuffer[0]);
+                    bufferUploadPending = false;
                 }
+
+                terrainShader.setUniform("lightFactor", lightFactor);
+                window.draw(terrain, terrainStates);
             }
 
             // Update and draw the HUD text
@@ -242,18 +230,9 @@ int main()
         window.display();
     }
 
-    // Shut down our thread pool
-    {
-        sf::Lock lock(workQueueMutex);
-        workPending = false;
-    }
-
-    while (!threads.empty())
-    {
-        threads.back()->wait();
-        delete threads.back();
-        threads.pop_back();
-    }
+    // Release the tasks before the thread pool is shut down
+    threadPool.wait();
+    workTasks.clear();
 
     return EXIT_SUCCESS;
 }
@@ -417,21 +396,22 @@ sf::Vector2f computeNormal(int x, int y, float left, float right, float bottom,
 
 
 ////////////////////////////////////////////////////////////
-/// Process a terrain generation work item. Use the vector
-/// of vertices as scratch memory and upload the data to
-/// the vertex buffer when done.
+/// Process a terrain generation work item. Each work item
+/// writes its own rows of the target buffer, so the items
+/// can run in parallel without locking.
 ///
 ////////////////////////////////////////////////////////////
-void processWorkItem(std::vector<sf::Vertex>& vertices, const WorkItem& workItem)
+void WorkItem::operator()() const
 {
     unsigned int rowBlockSize = (resolutionY / blockCount) + 1;
-    unsigned int rowStart = rowBlockSize * workItem.index;
+    unsigned int rowStart = rowBlockSize * index;
 
     if (rowStart >= resolutionY)
         return;
 
     unsigned int rowEnd = std::min(rowStart + rowBlockSize, resolutionY);
-    unsigned int rowCount = rowEnd - rowStart;
+
+    sf::Vertex* vertices = targetBuffer + (resolutionX * rowStart * 6);
 
     const float scalingFactorX = static_cast<float>(windowWidth) / static_cast<float>(resolutionX);
     const float scalingFactorY = static_cast<float>(windowHeight) / static_cast<float>(resolutionY);
@@ -494,97 +474,46 @@ void processWorkItem(std::vector<sf::Vertex>& vertices, const WorkItem& workItem
             }
         }
     }
-
-    // Copy the resulting geometry from our thread-local buffer into the target buffer
-    std::memcpy(workItem.targetBuffer + (resolutionX * rowStart * 6), &vertices[0], sizeof(sf::Vertex) * resolutionX * rowCount * 6);
 }
 
 
 ////////////////////////////////////////////////////////////
-/// Worker thread entry point. We use a thread pool to avoid
-/// the heavy cost of constantly recreating and starting
-/// new threads whenever we need to regenerate the terrain.
+/// Tell whether all the work items of the last terrain
+/// generation are finished.
 ///
 ////////////////////////////////////////////////////////////
-void threadFunction()
+bool isTerrainGenerated()
 {
-    unsigned int rowBlockSize = (resolutionY / blockCount) + 1;
-
-    std::vector<sf::Vertex> vertices(resolutionX * rowBlockSize * 6);
-
-    WorkItem workItem = {0, 0};
-
-    // Loop until the application exits
-    for (;;)
+    for (std::vector<sf::ThreadPool::Task>::const_iterator it = workTasks.begin(); it != workTasks.end(); ++it)
     {
-        workItem.targetBuffer = 0;
-
-        // Check if there are new work items in the queue
-        {
-            sf::Lock lock(workQueueMutex);
-
-            if (!workPending)
-                return;
-
-            if (!workQueue.empty())
-            {
-                workItem = workQueue.front();
-                workQueue.pop_front();
-            }
-        }
-
-        // If we didn't receive a new work item, keep looping
-        if (!workItem.targetBuffer)
-        {
-            sf::sleep(sf::milliseconds(10));
-
-            continue;
-        }
-
-        processWorkItem(vertices, workItem);
-
-        {
-            sf::Lock lock(workQueueMutex);
-
-            --pendingWorkCount;
-        }
+        if (!it->isDone())
+            return false;
     }
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-/// Terrain generation entry point. This queues up the
-/// generation work items which the worker threads dequeue
-/// and process.
+/// Terrain generation entry point. This pushes the
+/// generation work items to the thread pool, which
+/// processes them in the background.
 ///
 ////////////////////////////////////////////////////////////
-void generateTerrain(sf::Vertex* buffer)
+void generateTerrain(sf::ThreadPool& threadPool, sf::Vertex* buffer)
 {
-    bufferUploadPending = true;
-
-    // Make sure the work queue is empty before queuing new work
-    for (;;)
-    {
-        {
-            sf::Lock lock(workQueueMutex);
-
-            if (workQueue.empty())
-                break;
-        }
+    // Make sure the previous generation is finished before writing to the buffer again
+    for (std::vector<sf::ThreadPool::Task>::const_iterator it = workTasks.begin(); it != workTasks.end(); ++it)
+        threadPool.wait(*it);
 
-        sf::sleep(sf::milliseconds(10));
-    }
+    bufferUploadPending = true;
 
     // Queue all the new work items
-    {
-        sf::Lock lock(workQueueMutex);
-
-        for (unsigned int i = 0; i < blockCount; i++)
-        {
-            WorkItem workItem = {buffer, i};
-            workQueue.push_back(workItem);
-        }
+    workTasks.clear();
 
-        pendingWorkCount = blockCount;
+    for (unsigned int i = 0; i < blockCount; i++)
+    {
+        WorkItem workItem = {buffer, i};
+        workTasks.push_back(threadPool.push(workItem));
     }
 }
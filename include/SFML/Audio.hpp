@@ -30,16 +30,26 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Audio/AsyncOutputSoundFile.hpp>
+#include <SFML/Audio/GainEffect.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/Music.hpp>
+#include <SFML/Audio/OpusFrameDecoder.hpp>
+#include <SFML/Audio/OpusFrameEncoder.hpp>
 #include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/Audio/PlaybackDevice.hpp>
+#include <SFML/Audio/RingBufferStream.hpp>
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundBufferCache.hpp>
 #include <SFML/Audio/SoundBufferRecorder.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <SFML/Audio/SoundFileWriter.hpp>
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/SoundPool.hpp>
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/SoundSource.hpp>
 #include <SFML/Audio/SoundStream.hpp>
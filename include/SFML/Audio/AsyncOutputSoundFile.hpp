@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ASYNCOUTPUTSOUNDFILE_HPP
+#define SFML_ASYNCOUTPUTSOUNDFILE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class OutputSoundFile;
+
+////////////////////////////////////////////////////////////
+/// \brief Write sound files from a background encoder thread
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API AsyncOutputSoundFile : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncOutputSoundFile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the file if it was still open, after encoding
+    /// the samples still queued.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AsyncOutputSoundFile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the sound file from the disk for writing
+    ///
+    /// The supported formats are the same as sf::OutputSoundFile.
+    /// The queue capacity is rounded up to the next power of
+    /// two; 0 selects one second of audio.
+    ///
+    /// \param filename     Path of the sound file to write
+    /// \param sampleRate   Sample rate of the sound
+    /// \param channelCount Number of channels in the sound
+    /// \param capacity     Maximum number of samples waiting to be encoded
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename, unsigned int sampleRate, unsigned int channelCount, std::size_t capacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue audio samples to be written to the file
+    ///
+    /// This function never blocks: if the queue is full, only
+    /// the whole frames that fit are queued, and the others
+    /// are counted as dropped. It must always be called from
+    /// the same thread.
+    ///
+    /// \param samples Pointer to the sample array to write
+    /// \param count   Number of samples to write
+    ///
+    /// \return Number of samples actually queued
+    ///
+    /// \see getFreeCount, getDroppedCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t write(const Int16* samples, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the queued samples are encoded
+    ///
+    /// It must be called from the thread that calls write().
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the queued samples and close the file
+    ///
+    /// This function blocks until the encoder thread is done.
+    /// It does nothing if no file is open.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples that can be queued without loss
+    ///
+    /// \return Number of free samples in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFreeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples waiting to be encoded
+    ///
+    /// \return Number of queued samples not yet given to the encoder
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getQueuedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples dropped because the queue was full
+    ///
+    /// The count is reset when a file is opened.
+    ///
+    /// \return Number of samples not written since the file was opened
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the encoder thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void encode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give all the queued samples to the encoder
+    ///
+    ////////////////////////////////////////////////////////////
+    void drain();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    OutputSoundFile*   m_file;         ///< File being written, NULL when closed
+    Thread             m_thread;       ///< Encoder thread
+    Semaphore          m_pending;      ///< Posted when there is work for the encoder thread
+    Semaphore          m_flushed;      ///< Posted by the encoder thread once a flush is done
+    std::vector<Int16> m_ring;         ///< Storage of the queue, its size is a power of two
+    std::vector<Int16> m_block;        ///< Contiguous copy of the samples given to the encoder
+    unsigned int       m_channelCount; ///< Number of channels of the file
+    Atomic<Uint32>     m_write;        ///< Total number of samples queued, written by the producer only
+    Atomic<Uint32>     m_read;         ///< Total number of samples encoded, written by the encoder thread only
+    Atomic<Uint64>     m_dropped;      ///< Number of samples that didn't fit in the queue
+    Atomic<bool>       m_flushing;     ///< Is a flush waiting for the encoder thread?
+    Atomic<bool>       m_closing;      ///< Must the encoder thread exit once the queue is empty?
+};
+
+} // namespace sf
+
+
+#endif // SFML_ASYNCOUTPUTSOUNDFILE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AsyncOutputSoundFile
+/// \ingroup audio
+///
+/// sf::OutputSoundFile encodes and writes the samples on the
+/// calling thread, which can take much longer than the audio
+/// lasts with formats like OGG/Vorbis. When the samples come
+/// from a real-time source, such as a recorder or the mix of
+/// a game, that thread must not be held up.
+///
+/// sf::AsyncOutputSoundFile queues the samples instead and
+/// encodes them on its own thread. The queue has a fixed
+/// capacity, so the memory it uses is bounded: when the
+/// encoder can't keep up, write() accepts fewer samples than
+/// given and the rest are counted in getDroppedCount().
+/// getFreeCount() tells how much can be queued ahead of time.
+///
+/// Usage example:
+/// \code
+/// // Record to an ogg/vorbis file without blocking the capture
+/// sf::AsyncOutputSoundFile file;
+/// if (!file.openFromFile("capture.ogg", 44100, 1))
+///     /* error */;
+///
+/// // In the capture callback
+/// file.write(samples, sampleCount);
+///
+/// // When done
+/// file.close();
+/// if (file.getDroppedCount() > 0)
+///     /* the disk or the encoder was too slow */;
+/// \endcode
+///
+/// \see sf::OutputSoundFile, sf::SoundRecorder
+///
+////////////////////////////////////////////////////////////
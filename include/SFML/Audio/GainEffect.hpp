@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GAINEFFECT_HPP
+#define SFML_GAINEFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound effect changing the gain of a stream smoothly
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API GainEffect : public SoundEffect
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// \param gain Initial gain, 1 leaves the samples unchanged
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GainEffect(float gain = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the gain
+    ///
+    /// The gain moves linearly from its current value to the
+    /// new one over \a rampDuration, which avoids the clicks
+    /// of an abrupt change. This function can be called from
+    /// any thread.
+    ///
+    /// \param gain         New gain, 1 leaves the samples unchanged
+    /// \param rampDuration Duration of the transition
+    ///
+    /// \see getGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGain(float gain, Time rampDuration = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain
+    ///
+    /// \return Gain reached at the end of the current ramp
+    ///
+    /// \see setGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the gain to a block of samples
+    ///
+    /// \param samples      Interleaved samples, normalized in the range [-1, 1]
+    /// \param frameCount   Number of frames in the block
+    /// \param channelCount Number of channels of the stream
+    /// \param sampleRate   Sample rate of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump to the end of the current ramp
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable FastMutex m_mutex;        ///< Protects the parameters set by the application
+    float             m_target;       ///< Gain at the end of the ramp
+    Time              m_rampDuration; ///< Duration of the ramp requested by the last setGain call
+    bool              m_changed;      ///< Has setGain been called since the last block?
+    float             m_current;      ///< Gain applied to the next frame, used by the streaming thread only
+    float             m_step;         ///< Change of the gain per frame during the ramp
+    Uint64            m_rampFrames;   ///< Number of frames left in the ramp
+};
+
+} // namespace sf
+
+
+#endif // SFML_GAINEFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GainEffect
+/// \ingroup audio
+///
+/// sf::GainEffect scales the samples of a stream, like
+/// SoundSource::setVolume, but inside the chain of effects
+/// and with smooth transitions. It is typically used for
+/// fades, or to balance the streams mixed by a sf::SoundMixer
+/// before the effects that follow.
+///
+/// Constant gains are applied with SIMD instructions when the
+/// target architecture provides them.
+///
+/// Usage example:
+/// \code
+/// sf::GainEffect fade(0.f);
+/// music.addEffect(fade);
+/// music.play();
+///
+/// // Fade in over two seconds
+/// fade.setGain(1.f, sf::seconds(2));
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
@@ -194,6 +194,32 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start batching the changes of the audio scene
+    ///
+    /// Until processUpdates() is called, the changes made to
+    /// the listener and to the sound sources (position, volume,
+    /// pitch, ...) are recorded but not heard, and they all
+    /// take effect at once when the batch is processed. This
+    /// saves the mixer from being locked by each change, and
+    /// guarantees that all the sources of a frame move together.
+    ///
+    /// Batches can be nested: only the outermost call to
+    /// processUpdates() applies the changes.
+    ///
+    /// \see processUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deferUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the changes batched since deferUpdates()
+    ///
+    /// \see deferUpdates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void processUpdates();
 };
 
 } // namespace sf
@@ -229,6 +255,13 @@ public:
 ///
 /// // Reduce the global volume
 /// sf::Listener::setGlobalVolume(50);
+///
+/// // Move the listener and all the sources of the frame at once
+/// sf::Listener::deferUpdates();
+/// sf::Listener::setPosition(player.x, 0, player.y);
+/// for (std::size_t i = 0; i < sounds.size(); ++i)
+///     sounds[i].setPosition(emitters[i].x, 0, emitters[i].y);
+/// sf::Listener::processUpdates();
 /// \endcode
 ///
 ////////////////////////////////////////////////////////////
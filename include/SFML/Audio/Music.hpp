@@ -31,8 +31,11 @@
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -210,6 +213,36 @@ public:
     ////////////////////////////////////////////////////////////
     void setLoopPoints(TimeSpan timePoints);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of audio decoded ahead of playback
+    ///
+    /// The music is decoded by a background thread, which keeps
+    /// this much audio ready for the streaming thread so that a
+    /// slow read or a decoding spike doesn't starve playback.
+    /// Loop points are pre-rolled by the same thread. The read-ahead
+    /// never holds less than one buffer of the stream.
+    ///
+    /// The new duration applies the next time the music is
+    /// played from a stopped state or seeked. The default
+    /// read-ahead is 2 seconds.
+    ///
+    /// \param duration Duration of audio to decode ahead
+    ///
+    /// \see getReadAheadDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReadAheadDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio decoded ahead of playback
+    ///
+    /// \return Duration of audio to decode ahead
+    ///
+    /// \see setReadAheadDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getReadAheadDuration() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -253,6 +286,36 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the decoding thread if it is not running
+    ///
+    /// Must be called with m_mutex locked.
+    ///
+    ////////////////////////////////////////////////////////////
+    void startReadAhead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the decoding thread and drop the decoded samples
+    ///
+    /// The file is left at the position the thread decoded up to.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopReadAhead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by the decoding thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void decode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples that fill one buffer
+    ///
+    /// \return Number of samples matching the buffer duration of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBufferSampleCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Helper to convert an sf::Time to a sample position
     ///
@@ -273,13 +336,32 @@ private:
     ////////////////////////////////////////////////////////////
     Time samplesToTime(Uint64 samples) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump of the file decoded by the read-ahead thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LoopMarker
+    {
+        Uint64 position; ///< Number of samples decoded before the jump
+        Int64  offset;   ///< Offset of the file after the jump
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputSoundFile     m_file;     ///< The streamed music file
-    std::vector<Int16> m_samples;  ///< Temporary buffer of samples
-    Mutex              m_mutex;    ///< Mutex protecting the data
-    Span<Uint64>       m_loopSpan; ///< Loop Range Specifier
+    InputSoundFile         m_file;              ///< The streamed music file
+    std::vector<Int16>     m_samples;           ///< Temporary buffer of samples
+    mutable Mutex          m_mutex;             ///< Mutex protecting the data
+    Span<Uint64>           m_loopSpan;          ///< Loop Range Specifier
+    Thread                 m_decoder;           ///< Thread decoding the file ahead of playback
+    bool                   m_decoding;          ///< Is the decoding thread running?
+    bool                   m_decodedEnd;        ///< Has the decoding thread reached the end of the file?
+    ConditionVariable      m_decodeCondition;   ///< Signaled when samples are decoded or consumed, or when decoding stops
+    Time                   m_readAheadDuration; ///< Requested duration of audio decoded ahead
+    std::vector<Int16>     m_readAhead;         ///< Ring of decoded samples
+    Uint64                 m_readCount;         ///< Number of decoded samples given to the stream
+    Uint64                 m_writeCount;        ///< Number of samples decoded
+    std::deque<LoopMarker> m_loopMarkers;       ///< Jumps decoded but not played yet
 };
 
 } // namespace sf
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_OPUSFRAMEDECODER_HPP
+#define SFML_OPUSFRAMEDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+// Forward declarations
+////////////////////////////////////////////////////////////
+struct OpusDecoder;
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Decoder of raw Opus frames, for real-time streaming
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API OpusFrameDecoder : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether Opus is supported by this build of SFML
+    ///
+    /// \return True if SFML was built with SFML_AUDIO_OPUS
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusFrameDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~OpusFrameDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the decoder
+    ///
+    /// The decoder can output any of the sample rates supported
+    /// by Opus (8000, 12000, 16000, 24000 and 48000 Hz) and any
+    /// channel count up to 2, whatever the encoder used.
+    ///
+    /// \param sampleRate   Sample rate of the decoded samples
+    /// \param channelCount Number of channels of the decoded samples
+    ///
+    /// \return True if the decoder was successfully created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int sampleRate, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a single frame
+    ///
+    /// If a frame was lost, pass a null \a data instead: the
+    /// decoder conceals the gap with a frame extrapolated from
+    /// the previous ones.
+    ///
+    /// \param data    Pointer to the encoded frame, or NULL for a lost frame
+    /// \param size    Size of the encoded frame, in bytes
+    /// \param samples Filled with the decoded interleaved samples
+    ///
+    /// \return True if the frame was successfully decoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(const void* data, std::size_t size, std::vector<Int16>& samples);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the decoder state
+    ///
+    /// Call this when starting a new, unrelated stream so that
+    /// it is not predicted from the frames of the previous one.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the decoded samples
+    ///
+    /// \return Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the decoded samples
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ::OpusDecoder* m_decoder;      ///< libopus decoder state
+    unsigned int   m_sampleRate;   ///< Sample rate of the decoded samples
+    unsigned int   m_channelCount; ///< Number of channels of the decoded samples
+};
+
+} // namespace sf
+
+
+#endif // SFML_OPUSFRAMEDECODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OpusFrameDecoder
+/// \ingroup audio
+///
+/// sf::OpusFrameDecoder decompresses the raw Opus frames
+/// produced by sf::OpusFrameEncoder. Frames must be decoded
+/// in order; when one is lost on the way, decoding a null
+/// frame in its place hides the gap.
+///
+/// Opus support is optional: isAvailable() tells whether SFML
+/// was built with it.
+///
+/// Usage example:
+/// \code
+/// sf::OpusFrameDecoder decoder;
+/// decoder.create(48000, 1);
+///
+/// sf::Packet packet;
+/// socket.receive(packet);
+///
+/// sf::Uint16 size;
+/// packet >> size;
+/// const char* frame = static_cast<const char*>(packet.getData()) + sizeof(sf::Uint16);
+///
+/// std::vector<sf::Int16> samples;
+/// if (decoder.decode(frame, size, samples))
+///     stream.push(&samples[0], samples.size());
+/// \endcode
+///
+/// \see sf::OpusFrameEncoder, sf::RingBufferStream
+///
+////////////////////////////////////////////////////////////
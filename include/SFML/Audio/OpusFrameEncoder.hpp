@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_OPUSFRAMEENCODER_HPP
+#define SFML_OPUSFRAMEENCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+// Forward declarations
+////////////////////////////////////////////////////////////
+struct OpusEncoder;
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Encoder of raw Opus frames, for real-time streaming
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API OpusFrameEncoder : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of signal the encoder is tuned for
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Application
+    {
+        Voip,    ///< Speech, favors intelligibility
+        Audio,   ///< Music and other non-voice signals, favors fidelity
+        LowDelay ///< Lowest achievable latency, disables the speech modes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether Opus is supported by this build of SFML
+    ///
+    /// \return True if SFML was built with SFML_AUDIO_OPUS
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    OpusFrameEncoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~OpusFrameEncoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the encoder
+    ///
+    /// Opus only supports sample rates of 8000, 12000, 16000,
+    /// 24000 and 48000 Hz, with 1 or 2 channels.
+    ///
+    /// \param sampleRate   Sample rate of the samples to encode
+    /// \param channelCount Number of channels of the samples to encode
+    /// \param application  Kind of signal to tune the encoder for
+    ///
+    /// \return True if the encoder was successfully created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int sampleRate, unsigned int channelCount, Application application = Voip);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the target bitrate
+    ///
+    /// By default, the encoder picks a bitrate from the sample
+    /// rate and the channel count.
+    ///
+    /// \param bitrate Target bitrate, in bits per second
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBitrate(unsigned int bitrate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples per channel of a frame
+    ///
+    /// Frames always last 20 ms.
+    ///
+    /// \return Number of samples per channel that encode() takes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFrameSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the encoded samples
+    ///
+    /// \return Sample rate, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels of the encoded samples
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a single frame
+    ///
+    /// \a samples must contain getFrameSize() * getChannelCount()
+    /// interleaved samples.
+    ///
+    /// \param samples Pointer to the samples of the frame
+    /// \param frame   Filled with the encoded frame
+    ///
+    /// \return True if the frame was successfully encoded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool encode(const Int16* samples, std::vector<Uint8>& frame);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ::OpusEncoder* m_encoder;      ///< libopus encoder state
+    unsigned int   m_sampleRate;   ///< Sample rate of the encoded samples
+    unsigned int   m_channelCount; ///< Number of channels of the encoded samples
+};
+
+} // namespace sf
+
+
+#endif // SFML_OPUSFRAMEENCODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::OpusFrameEncoder
+/// \ingroup audio
+///
+/// sf::OpusFrameEncoder compresses audio samples into raw
+/// Opus frames, without any container around them. Each
+/// frame lasts 20 ms and is decoded on its own by
+/// sf::OpusFrameDecoder, which makes it suited to sending
+/// audio over the network: a speech frame takes a few dozen
+/// bytes instead of the 1920 bytes of uncompressed samples.
+///
+/// To read and write Opus files (.opus), use sf::InputSoundFile,
+/// sf::OutputSoundFile and sf::Music instead.
+///
+/// Opus support is optional: isAvailable() tells whether SFML
+/// was built with it.
+///
+/// Usage example:
+/// \code
+/// sf::OpusFrameEncoder encoder;
+/// encoder.create(48000, 1);
+///
+/// // In sf::SoundRecorder::onProcessSamples, once enough samples are buffered
+/// std::vector<sf::Uint8> frame;
+/// if (encoder.encode(&samples[0], frame))
+/// {
+///     sf::Packet packet;
+///     packet << static_cast<sf::Uint16>(frame.size());
+///     packet.append(&frame[0], frame.size());
+///     socket.send(packet);
+/// }
+/// \endcode
+///
+/// \see sf::OpusFrameDecoder
+///
+////////////////////////////////////////////////////////////
@@ -62,7 +62,9 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open the sound file from the disk for writing
     ///
-    /// The supported audio formats are: WAV, OGG/Vorbis, FLAC.
+    /// The supported audio formats are: WAV, OGG/Vorbis, FLAC,
+    /// and OGG/Opus (48, 24, 16, 12 or 8 kHz, mono or stereo)
+    /// if SFML was built with SFML_AUDIO_OPUS.
     ///
     /// \param filename     Path of the sound file to write
     /// \param sampleRate   Sample rate of the sound
@@ -128,6 +130,6 @@ private:
 /// }
 /// \endcode
 ///
-/// \see sf::SoundFileWriter, sf::InputSoundFile
+/// \see sf::SoundFileWriter, sf::InputSoundFile, sf::AsyncOutputSoundFile
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PLAYBACKDEVICE_HPP
+#define SFML_PLAYBACKDEVICE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Selection and configuration of the device that
+///        plays the sounds and musics
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API PlaybackDevice
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Settings of the audio device
+    ///
+    /// A value of 0 (or Default) leaves the choice to the driver.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Settings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Head-related transfer function modes
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Hrtf
+        {
+            Default, ///< Let the driver decide, usually enabled for headphones only
+            Enabled, ///< Request HRTF spatialization
+            Disabled ///< Disable HRTF spatialization
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// \param mixingFrequency Mixing frequency, in Hz
+        /// \param refresh         Number of mixing updates per second
+        /// \param mono            Number of mono sources to reserve
+        /// \param stereo          Number of stereo sources to reserve
+        /// \param hrtfMode        Head-related transfer function mode
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Settings(unsigned int mixingFrequency = 0, unsigned int refresh = 0, unsigned int mono = 0, unsigned int stereo = 0, Hrtf hrtfMode = Default) :
+        frequency    (mixingFrequency),
+        refreshRate  (refresh),
+        monoSources  (mono),
+        stereoSources(stereo),
+        hrtf         (hrtfMode)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int frequency;     ///< Mixing frequency, in Hz (ALC_FREQUENCY)
+        unsigned int refreshRate;   ///< Mixing updates per second (ALC_REFRESH)
+        unsigned int monoSources;   ///< Number of mono sources (ALC_MONO_SOURCES)
+        unsigned int stereoSources; ///< Number of stereo sources (ALC_STEREO_SOURCES)
+        Hrtf         hrtf;          ///< Head-related transfer function mode (ALC_HRTF_SOFT)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of all the sounds and streams
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are initialized to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics() :
+        sourceCount      (0),
+        activeSourceCount(0),
+        underruns        (0),
+        decodeTime       ()
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int sourceCount;       ///< Number of OpenAL sources owned by sounds and streams
+        unsigned int activeSourceCount; ///< Number of sources currently playing
+        Uint64       underruns;         ///< Number of underruns of all the streams (see sf::SoundStream::Statistics)
+        Time         decodeTime;        ///< Time spent by all the streams producing their samples
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a list of the names of all available audio playback devices
+    ///
+    /// \return A vector of strings containing the names
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<std::string> getAvailableDevices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the default audio playback device
+    ///
+    /// \return The name of the default audio playback device
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::string getDefaultDevice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the audio playback device
+    ///
+    /// An empty name selects the default device, which is
+    /// also the initial selection. If the device is already
+    /// open, the sounds are moved to the new one when the
+    /// driver supports it (ALC_SOFT_reopen_device); otherwise
+    /// the selection takes effect the next time the device is
+    /// opened, after all the audio resources were destroyed.
+    ///
+    /// \param name Name of the device to use
+    ///
+    /// \return False if the open device failed to switch
+    ///
+    /// \see getDevice, getAvailableDevices
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setDevice(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the selected audio playback device
+    ///
+    /// \return Name of the selected device, empty for the default one
+    ///
+    /// \see setDevice
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::string& getDevice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the settings of the audio playback device
+    ///
+    /// If the device is already open, the settings are applied
+    /// immediately when the driver supports it (ALC_SOFT_HRTF);
+    /// otherwise they take effect the next time the device is
+    /// opened, after all the audio resources were destroyed.
+    ///
+    /// \param settings New settings of the device
+    ///
+    /// \return False if the open device failed to apply the settings
+    ///
+    /// \see getSettings
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setSettings(const Settings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the settings of the audio playback device
+    ///
+    /// If the device is open, the values actually chosen by
+    /// the driver are returned, which may differ from the
+    /// requested ones. Otherwise, the requested settings are
+    /// returned.
+    ///
+    /// \return Settings of the device
+    ///
+    /// \see setSettings
+    ///
+    ////////////////////////////////////////////////////////////
+    static Settings getSettings();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the output latency of the audio playback device
+    ///
+    /// This is the delay between the mixing of a sample and its
+    /// playback by the hardware, as reported by the driver
+    /// (ALC_SOFT_device_clock). Without driver support, it is
+    /// estimated as the duration of a mixing update.
+    ///
+    /// \return Output latency of the device
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getLatency();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the audio clock
+    ///
+    /// The audio clock advances with the samples mixed by the
+    /// device (ALC_SOFT_device_clock), so it doesn't drift from
+    /// the audio output like a system clock would. Without
+    /// driver support, a system clock is used instead. Its
+    /// origin is unspecified: only differences are meaningful.
+    ///
+    /// \return Current time of the audio clock
+    ///
+    /// \see sf::Sound::playAt
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getTime();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the conversion of sounds to the device sample rate
+    ///
+    /// When enabled, sf::SoundBuffer converts its samples once,
+    /// when they are loaded, and sf::SoundStream (and sf::Music)
+    /// convert theirs while streaming, with a high quality
+    /// windowed-sinc filter. The device then plays everything
+    /// at its own rate, without resampling in the mixer.
+    ///
+    /// The conversion applies to the buffers loaded and the
+    /// streams initialized after this call. It is disabled by
+    /// default.
+    ///
+    /// \param enabled True to convert the sample rates, false to let the mixer do it
+    ///
+    /// \see isSampleRateConversionEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSampleRateConversion(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether sounds are converted to the device sample rate
+    ///
+    /// \return True if the conversion is enabled
+    ///
+    /// \see setSampleRateConversion
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isSampleRateConversionEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of all the sounds and streams
+    ///
+    /// The underruns and the decode time accumulate from the
+    /// start of the program, or the last call to resetStatistics().
+    /// The source counts are those at the time of the call.
+    ///
+    /// \return Statistics of the audio engine
+    ///
+    /// \see resetStatistics, sf::SoundStream::getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the accumulated statistics
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetStatistics();
+};
+
+} // namespace sf
+
+
+#endif // SFML_PLAYBACKDEVICE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PlaybackDevice
+/// \ingroup audio
+///
+/// sf::PlaybackDevice selects which device plays the sounds
+/// and musics, and how it mixes them. The device is opened
+/// when the first audio resource (sound, music or buffer) is
+/// created, so calling these functions beforehand is the
+/// most reliable way to configure it.
+///
+/// The refresh rate has the largest impact on latency: with
+/// the default of most drivers (50 updates per second), a
+/// sound starts up to 20 ms after it was played. Rhythm games
+/// and other latency sensitive applications can request a
+/// higher refresh rate, at the cost of more CPU wake-ups.
+///
+/// Sounds whose sample rate differs from the mixing frequency
+/// are resampled by the mixer every time they play, with a
+/// quality chosen by the driver. setSampleRateConversion()
+/// converts them beforehand instead, so that the mixer cost
+/// doesn't depend on the content.
+///
+/// getStatistics() gives the health of the whole audio engine,
+/// for telemetry: the number of sources in use and playing,
+/// and the underruns and decode time summed over all the
+/// streams. The details of a single stream are given by
+/// sf::SoundStream::getStatistics().
+///
+/// Because the device is unique, sf::PlaybackDevice only
+/// contains static functions and doesn't have to be
+/// instantiated.
+///
+/// Usage example:
+/// \code
+/// // Use the first device, mixed at 48 kHz with 200 updates per second (5 ms)
+/// std::vector<std::string> devices = sf::PlaybackDevice::getAvailableDevices();
+/// if (!devices.empty())
+///     sf::PlaybackDevice::setDevice(devices[0]);
+///
+/// sf::PlaybackDevice::setSettings(sf::PlaybackDevice::Settings(48000, 200));
+///
+/// sf::Music music;
+/// music.openFromFile("song.ogg");
+/// music.play();
+///
+/// std::cout << "Latency: " << sf::PlaybackDevice::getLatency().asMilliseconds() << " ms" << std::endl;
+/// \endcode
+///
+/// \see sf::Listener, sf::SoundRecorder
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RINGBUFFERSTREAM_HPP
+#define SFML_RINGBUFFERSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound stream playing samples pushed from another thread
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API RingBufferStream : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// The capacity is rounded up to the next power of two.
+    ///
+    /// \param channelCount Number of channels of the pushed samples
+    /// \param sampleRate   Sample rate of the pushed samples, in samples per second
+    /// \param capacity     Maximum number of samples waiting to be played
+    ///
+    ////////////////////////////////////////////////////////////
+    RingBufferStream(unsigned int channelCount, unsigned int sampleRate, std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RingBufferStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append samples to the end of the stream
+    ///
+    /// This function never blocks: if the ring is full, only
+    /// the samples that fit are written. It must always be
+    /// called from the same thread, the producer.
+    ///
+    /// \param samples     Pointer to the array of samples to push
+    /// \param sampleCount Number of samples in the array
+    ///
+    /// \return Number of samples actually written
+    ///
+    /// \see getFreeCount, close
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t push(const Int16* samples, std::size_t sampleCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell that no more samples will be pushed
+    ///
+    /// The stream stops once the samples already pushed have
+    /// been played, instead of playing silence while waiting
+    /// for more. Restarting the stream with play() after
+    /// stop() reopens it.
+    ///
+    /// \see push
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples that can be pushed without loss
+    ///
+    /// \return Number of free samples in the ring
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFreeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples waiting to be played
+    ///
+    /// \return Number of pushed samples not yet given to the audio device
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getQueuedCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// All the samples available in the ring are returned; if
+    /// there are none and the stream is not closed, a short
+    /// chunk of silence keeps the stream alive.
+    ///
+    /// \param data Chunk of audio data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// Live samples can't be seeked: the samples waiting in
+    /// the ring are discarded instead, and the stream is
+    /// reopened if it was closed.
+    ///
+    /// \param timeOffset Ignored
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Int16> m_ring;    ///< Storage of the ring, its size is a power of two
+    std::vector<Int16> m_chunk;   ///< Samples handed to the stream by the last onGetData
+    std::size_t        m_silence; ///< Number of samples of silence played on underrun
+    Atomic<Uint32>     m_write;   ///< Total number of samples pushed, written by the producer only
+    Atomic<Uint32>     m_read;    ///< Total number of samples pulled, written by the consumer only
+    Atomic<bool>       m_closed;  ///< Has close() been called?
+};
+
+} // namespace sf
+
+
+#endif // SFML_RINGBUFFERSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RingBufferStream
+/// \ingroup audio
+///
+/// Custom streams must provide their samples synchronously
+/// from onGetData, which runs on the streaming thread, and
+/// any state shared with the rest of the application has to
+/// be protected by a mutex. When the producer holds that mutex
+/// for too long, the stream starves and the sound glitches.
+///
+/// sf::RingBufferStream decouples both sides with a single
+/// producer, single consumer ring of samples. One thread
+/// pushes samples with push(), the streaming thread pulls
+/// them, and neither ever blocks the other: no lock is taken
+/// on either side. When the producer is late, the stream plays
+/// short chunks of silence until more samples arrive.
+///
+/// push() must always be called from the same thread; the
+/// other functions can be called from any thread.
+///
+/// Usage example:
+/// \code
+/// sf::RingBufferStream stream(1, 44100, 44100);
+/// stream.play();
+///
+/// // In the network or synthesis thread
+/// while (receiving)
+/// {
+///     std::size_t count = receive(samples);
+///     stream.push(samples, count);
+/// }
+/// stream.close();
+/// \endcode
+///
+/// \see sf::SoundStream, sf::Music
+///
+////////////////////////////////////////////////////////////
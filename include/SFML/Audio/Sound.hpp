@@ -88,6 +88,28 @@ public:
     ////////////////////////////////////////////////////////////
     void play();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing the sound at a given time of the audio clock
+    ///
+    /// The sound starts exactly when the audio clock (see
+    /// sf::PlaybackDevice::getTime) reaches \a time, whatever
+    /// the frame rate of the program: if the driver provides
+    /// AL_SOFT_source_start_delay, the mixer starts it on the
+    /// exact sample. Otherwise the audio thread shared with the
+    /// streams starts it, within about a millisecond. A time
+    /// that has already passed starts the sound immediately.
+    ///
+    /// The status of the sound may already be Playing while it
+    /// waits for its start. Calling play(), pause() or stop()
+    /// cancels a scheduled start.
+    ///
+    /// \param time Time of the audio clock at which the sound starts
+    ///
+    /// \see play, sf::PlaybackDevice::getTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void playAt(Time time);
+
     ////////////////////////////////////////////////////////////
     /// \brief Pause the sound
     ///
@@ -214,6 +236,8 @@ public:
 
 private:
 
+    friend class SoundBuffer;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -249,6 +273,9 @@ private:
 /// as long as the sound uses it. Note that multiple sounds
 /// can use the same sound buffer at the same time.
 ///
+/// Sounds that must start on a beat, independently of the frame
+/// rate, can be scheduled on the audio clock with playAt().
+///
 /// Usage example:
 /// \code
 /// sf::SoundBuffer buffer;
@@ -257,6 +284,10 @@ private:
 /// sf::Sound sound;
 /// sound.setBuffer(buffer);
 /// sound.play();
+///
+/// // Play it again exactly half a second later
+/// sf::Sound echo(buffer);
+/// echo.playAt(sf::PlaybackDevice::getTime() + sf::milliseconds(500));
 /// \endcode
 ///
 /// \see sf::SoundBuffer, sf::Music
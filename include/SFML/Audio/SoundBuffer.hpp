@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
 #include <vector>
@@ -64,6 +65,22 @@ public:
     ////////////////////////////////////////////////////////////
     SoundBuffer(const SoundBuffer& copy);
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The sound buffer takes over the OpenAL buffer and the
+    /// samples of \a right, which is left empty. The sounds
+    /// using \a right keep playing and now use this buffer.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBuffer(SoundBuffer&& right) : SoundBuffer() {swap(right);}
+
+#endif
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -134,6 +151,129 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the sound buffer from an array of float audio samples
+    ///
+    /// The samples are normalized in the range [-1, 1]. They are
+    /// kept and uploaded as floats if the audio device supports
+    /// it, so that they are never quantized to 16 bits; they are
+    /// converted for playback only otherwise.
+    ///
+    /// \param samples      Pointer to the array of samples in memory
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels (1 = mono, 2 = stereo, ...)
+    /// \param sampleRate   Sample rate (number of samples to play per second)
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see getFloatSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromSamples(const float* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the sound buffer from a file, in the background
+    ///
+    /// Only the first chunk of the sound is decoded before this
+    /// function returns, so that it can be played right away.
+    /// The rest is decoded by a worker thread and appended chunk
+    /// by chunk to the sounds that use the buffer, even while
+    /// they play. Decoding is much faster than playback, but a
+    /// sound that reaches the end of the loaded part before the
+    /// next chunk is appended stops there.
+    ///
+    /// The sample count and duration are those of the whole
+    /// sound from the start. Loading anything else into the
+    /// buffer, or destroying it, cancels the load.
+    ///
+    /// \param filename      Path of the sound file to load
+    /// \param chunkDuration Duration of the chunks decoded at once
+    ///
+    /// \return True if the first chunk was loaded, false if it failed
+    ///
+    /// \see isLoading, waitForLoading, loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadProgressivelyFromFile(const std::string& filename, Time chunkDuration = seconds(1));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a progressive load is still in progress
+    ///
+    /// \return True if the worker thread is still decoding the sound
+    ///
+    /// \see loadProgressivelyFromFile, waitForLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a progressive load is complete
+    ///
+    /// This function returns immediately if no progressive
+    /// load is in progress.
+    ///
+    /// \see loadProgressivelyFromFile, isLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitForLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether the samples are kept in memory after upload
+    ///
+    /// Once the samples are uploaded to the audio device, the
+    /// copy kept by the buffer is only needed by getSamples(),
+    /// getFloatSamples(), saveToFile() and copies of the buffer.
+    /// Not keeping it halves the memory used by the sound. The
+    /// setting applies to the next loads, it is enabled by default.
+    ///
+    /// \param keep True to keep the samples, false to release them
+    ///
+    /// \see getKeepSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepSamples(bool keep);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the samples are kept in memory after upload
+    ///
+    /// \return True if the samples are kept, false if they are released
+    ///
+    /// \see setKeepSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getKeepSamples() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether the sound is stored compressed by the audio device
+    ///
+    /// When enabled, mono and stereo sounds are encoded to IMA
+    /// ADPCM when they are uploaded, and the audio device decodes
+    /// them while they play. This takes a quarter of the memory
+    /// of 16-bit samples, at the cost of some quality. It requires
+    /// the AL_EXT_IMA4 extension; the samples are uploaded
+    /// uncompressed otherwise. Combined with setKeepSamples(false),
+    /// the buffer itself doesn't take any memory either.
+    ///
+    /// The setting applies to the next loads, except progressive
+    /// ones; it is disabled by default.
+    ///
+    /// \param compressed True to compress the sound, false to store it uncompressed
+    ///
+    /// \see isCompressed, setKeepSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCompressed(bool compressed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the sound is stored compressed by the audio device
+    ///
+    /// \return True if compression is requested, false otherwise
+    ///
+    /// \see setCompressed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCompressed() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the sound buffer to an audio file
     ///
@@ -156,18 +296,40 @@ public:
     /// (sf::Int16). The total number of samples in this array
     /// is given by the getSampleCount() function.
     ///
-    /// \return Read-only pointer to the array of sound samples
+    /// During a progressive load, the part of the array that is
+    /// not loaded yet is silent.
     ///
-    /// \see getSampleCount
+    /// \return Read-only pointer to the array of sound samples,
+    ///         or NULL if the buffer holds float samples or
+    ///         doesn't keep its samples
+    ///
+    /// \see getSampleCount, getFloatSamples
     ///
     ////////////////////////////////////////////////////////////
     const Int16* getSamples() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the array of float audio samples stored in the buffer
+    ///
+    /// Only buffers loaded from float samples hold them. The
+    /// total number of samples in this array is given by the
+    /// getSampleCount() function.
+    ///
+    /// \return Read-only pointer to the array of sound samples,
+    ///         or NULL if the buffer holds 16-bit samples or
+    ///         doesn't keep its samples
+    ///
+    /// \see getSampleCount, getSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    const float* getFloatSamples() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the number of samples stored in the buffer
     ///
     /// The array of samples can be accessed with the getSamples()
-    /// function.
+    /// or getFloatSamples() function. The count remains valid
+    /// when the buffer doesn't keep its samples.
     ///
     /// \return Number of samples
     ///
@@ -223,6 +385,36 @@ public:
     ////////////////////////////////////////////////////////////
     SoundBuffer& operator =(const SoundBuffer& right);
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// The sounds using this buffer are stopped and detached,
+    /// those using \a right now use this buffer.
+    ///
+    /// \param right Instance to move, left empty
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBuffer& operator =(SoundBuffer&& right) {SoundBuffer temp; temp.swap(right); swap(temp); return *this;}
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this sound buffer with those of another
+    ///
+    /// The sounds follow the samples that they are playing: after
+    /// the swap, the sounds that were using \a right use this
+    /// buffer and vice versa. A progressive load in either
+    /// buffer is completed first.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(SoundBuffer& right);
+
 private:
 
     friend class Sound;
@@ -248,9 +440,39 @@ private:
     ////////////////////////////////////////////////////////////
     bool update(unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker thread of a progressive load
+    ///
+    ////////////////////////////////////////////////////////////
+    void loadRemaining();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a chunk of a progressive load and append it to the sounds
+    ///
+    /// \param samples Converted samples of the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendChunk(const std::vector<Int16>& samples);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the progressive load in progress, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopLoading();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the buffers appended by a progressive load
+    ///
+    /// The buffer must not be used by any sound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteSegments();
+
     ////////////////////////////////////////////////////////////
     /// \brief Add a sound to the list of sounds that use this buffer
     ///
+    /// The OpenAL buffers are bound to the source of the sound.
+    ///
     /// \param sound Sound instance to attach
     ///
     ////////////////////////////////////////////////////////////
@@ -268,14 +490,22 @@ private:
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::set<Sound*> SoundList; ///< Set of unique sound instances
+    struct Loader;                      ///< State of a progressive load, defined in the source file
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   ///< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  ///< Samples buffer
-    Time               m_duration; ///< Sound duration
-    mutable SoundList  m_sounds;   ///< List of sounds that are using this buffer
+    unsigned int              m_buffer;       ///< OpenAL buffer identifier
+    std::vector<unsigned int> m_segments;     ///< OpenAL buffers queued after m_buffer by a progressive load
+    std::vector<Int16>        m_samples;      ///< Samples buffer
+    std::vector<float>        m_floatSamples; ///< Float samples buffer, used instead of m_samples when not empty
+    Uint64                    m_sampleCount;  ///< Number of samples, even if they are not kept
+    bool                      m_keepSamples;  ///< Are the samples kept after upload?
+    bool                      m_compressed;   ///< Are the samples encoded to ADPCM when uploaded?
+    Time                      m_duration;     ///< Sound duration
+    Loader*                   m_loader;       ///< Progressive load, NULL if there was none
+    mutable Mutex             m_mutex;        ///< Protects the segments and the sounds from the worker thread
+    mutable SoundList         m_sounds;       ///< List of sounds that are using this buffer
 };
 
 } // namespace sf
@@ -302,6 +532,21 @@ private:
 /// a custom stream (see sf::InputStream) or directly from an array
 /// of samples. It can also be saved back to a file.
 ///
+/// Long sounds, such as ambiences, can be loaded progressively
+/// with loadProgressivelyFromFile(): they can be played as soon
+/// as their first chunk is decoded, while a worker thread decodes
+/// the rest. Buffers that are only played can also release their
+/// copy of the samples once it is uploaded (see setKeepSamples()),
+/// and large sound libraries can be stored compressed by the
+/// audio device (see setCompressed()).
+///
+/// Sounds with more channels than the device can play are mixed
+/// down to stereo when they are loaded. If the sample rate
+/// conversion is enabled (see sf::PlaybackDevice), they are also
+/// converted to the sample rate of the device; the samples, sample
+/// rate and channel count of the buffer then describe the
+/// converted sound.
+///
 /// Sound buffers alone are not very useful: they hold the audio data
 /// but cannot be played. To do so, you need to use the sf::Sound class,
 /// which provides functions to play/pause/stop the sound as well as
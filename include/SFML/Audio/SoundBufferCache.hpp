@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDBUFFERCACHE_HPP
+#define SFML_SOUNDBUFFERCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+
+
+namespace sf
+{
+class SoundBuffer;
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Reference-counted cache of decoded sound buffers
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundBufferCache : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty cache with no memory budget.
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBufferCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the sound buffers of the cache are destroyed,
+    /// including the ones that were not released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundBufferCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sound buffer of a file
+    ///
+    /// If the file was already loaded by the cache, its buffer
+    /// is shared instead of being decoded again. Files are
+    /// identified by their path, exactly as it is given.
+    ///
+    /// Each successful call must be matched by a call to
+    /// release().
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return Pointer to the sound buffer, or NULL if the file couldn't be loaded
+    ///
+    /// \see acquireFromMemory, acquireFromStream, release
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer* acquireFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sound buffer of a file in memory
+    ///
+    /// The file is identified by a hash of its contents, so
+    /// that the same data loaded from different locations
+    /// shares a single buffer.
+    ///
+    /// Each successful call must be matched by a call to
+    /// release().
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return Pointer to the sound buffer, or NULL if the data couldn't be loaded
+    ///
+    /// \see acquireFromFile, acquireFromStream, release
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer* acquireFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sound buffer of a file read from a stream
+    ///
+    /// The whole stream is read to compute the hash of its
+    /// contents, which identifies it like acquireFromMemory().
+    ///
+    /// Each successful call must be matched by a call to
+    /// release().
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return Pointer to the sound buffer, or NULL if the stream couldn't be loaded
+    ///
+    /// \see acquireFromFile, acquireFromMemory, release
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer* acquireFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a sound buffer back to the cache
+    ///
+    /// When its last user releases it, the buffer stays in the
+    /// cache so that it can be acquired again without decoding,
+    /// until it is evicted to honor the memory budget or
+    /// destroyed by clear().
+    ///
+    /// \param buffer Sound buffer obtained from one of the acquire functions
+    ///
+    /// \see acquireFromFile, setMemoryBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(const SoundBuffer* buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum memory used by the cached samples
+    ///
+    /// When the samples of the cached buffers exceed the budget,
+    /// the released buffers are destroyed, least recently used
+    /// first. Acquired buffers are never evicted, so the budget
+    /// can be exceeded if they alone are larger.
+    ///
+    /// A budget of 0 disables the eviction (this is the default).
+    ///
+    /// \param sizeInBytes Maximum size of the cached samples, in bytes
+    ///
+    /// \see getMemoryBudget, getMemoryUsage
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMemoryBudget(std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum memory used by the cached samples
+    ///
+    /// \return Memory budget in bytes, or 0 if there is none
+    ///
+    /// \see setMemoryBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMemoryBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory used by the samples of the cached buffers
+    ///
+    /// \return Size of the cached samples, in bytes
+    ///
+    /// \see setMemoryBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMemoryUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the sound buffers that are not in use
+    ///
+    /// Sound buffers currently acquired are not affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sound buffers owned by the cache
+    ///
+    /// \return Number of sound buffers, acquired or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cached sound buffer with its usage information
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        SoundBuffer* buffer;   ///< The sound buffer
+        std::size_t  size;     ///< Size of its samples, in bytes
+        unsigned int useCount; ///< Number of unreleased acquisitions
+        Uint64       lastUse;  ///< Stamp of the last acquisition or release
+    };
+
+    typedef std::map<std::string, Entry> EntryMap;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a cached buffer, or load and cache it
+    ///
+    /// \param key          Identifier of the source
+    /// \param data         Pointer to the file data, or NULL to load \a key as a file
+    /// \param sizeInBytes  Size of the file data, in bytes
+    ///
+    /// \return Pointer to the sound buffer, or NULL if it couldn't be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    const SoundBuffer* acquire(const std::string& key, const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy released buffers until the budget is met
+    ///
+    ////////////////////////////////////////////////////////////
+    void evict();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable Mutex m_mutex;   ///< Mutex protecting the entries
+    EntryMap      m_entries; ///< Cached buffers, by source identifier
+    std::size_t   m_budget;  ///< Maximum size of the cached samples, 0 for none
+    std::size_t   m_usage;   ///< Current size of the cached samples
+    Uint64        m_clock;   ///< Stamp given to the next use, for LRU ordering
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDBUFFERCACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundBufferCache
+/// \ingroup audio
+///
+/// Loading a sf::SoundBuffer decodes the whole file and uploads
+/// the samples to the audio device. When the same effect is used
+/// by many entities, loading it for each of them wastes both time
+/// and memory.
+///
+/// sf::SoundBufferCache loads each source once and hands out the
+/// same buffer to every request for it. Files are identified by
+/// their path, files in memory or streams by a hash of their
+/// contents. Buffers are reference-counted: they remain valid
+/// until every acquisition has been matched by a release(), and
+/// are then kept for later requests. An optional memory budget
+/// makes the cache destroy the released buffers that were used
+/// least recently when their samples take too much memory.
+///
+/// The functions of the cache can be called from several threads.
+///
+/// Usage example:
+/// \code
+/// sf::SoundBufferCache cache;
+/// cache.setMemoryBudget(64 * 1024 * 1024);
+///
+/// // Each entity playing the same effect shares a single buffer
+/// const sf::SoundBuffer* buffer = cache.acquireFromFile("explosion.wav");
+/// if (buffer)
+///     sound.setBuffer(*buffer);
+///
+/// // When the entity is destroyed
+/// sound.resetBuffer();
+/// cache.release(buffer);
+/// \endcode
+///
+/// \see sf::SoundBuffer, sf::Sound
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDEFFECT_HPP
+#define SFML_SOUNDEFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for effects processing the samples of a sound stream
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundEffect
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoundEffect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a block of samples in place
+    ///
+    /// This function is called by the streaming thread, for
+    /// each chunk of the streams the effect is added to.
+    ///
+    /// \param samples      Interleaved samples, normalized in the range [-1, 1]
+    /// \param frameCount   Number of frames (samples of every channel) in the block
+    /// \param channelCount Number of channels of the stream
+    /// \param sampleRate   Sample rate of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the internal state of the effect
+    ///
+    /// This function is called by the streaming thread when
+    /// the stream starts, or restarts after a seek, so that
+    /// effects with a memory, such as filters or delays, don't
+    /// carry the previous samples over. The default
+    /// implementation does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset();
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDEFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundEffect
+/// \ingroup audio
+///
+/// sf::SoundEffect is the interface of the effects which can
+/// be chained on a sf::SoundStream (see SoundStream::addEffect).
+/// The effects of a stream process its samples in the order
+/// they were added, on the streaming thread, before they are
+/// given to the audio device.
+///
+/// Since process() runs on another thread, the parameters an
+/// effect exposes to the application must be protected, for
+/// example with a sf::FastMutex held only while they are read.
+///
+/// Usage example:
+/// \code
+/// class Distortion : public sf::SoundEffect
+/// {
+/// public:
+///
+///     virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int)
+///     {
+///         for (std::size_t i = 0; i < frameCount * channelCount; ++i)
+///             samples[i] = std::max(-0.5f, std::min(samples[i], 0.5f)) * 2.f;
+///     }
+/// };
+///
+/// Distortion distortion;
+/// music.addEffect(distortion);
+/// \endcode
+///
+/// \see sf::SoundStream, sf::GainEffect
+///
+////////////////////////////////////////////////////////////
@@ -101,6 +101,22 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file as floats
+    ///
+    /// The samples are normalized in the range [-1, 1]. The
+    /// default implementation converts the 16-bit samples
+    /// returned by read(); formats that store more precise
+    /// samples should override it to decode them directly.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
 };
 
 } // namespace sf
@@ -119,7 +135,9 @@ public:
 ///
 /// A valid sound file reader must override the open, seek and write functions,
 /// as well as providing a static check function; the latter is used by
-/// SFML to find a suitable writer for a given input file.
+/// SFML to find a suitable writer for a given input file. Readers
+/// of formats more precise than 16-bit samples can also override
+/// readFloat, which otherwise converts the result of read.
 ///
 /// To register a new reader, use the sf::SoundFileFactory::registerReader
 /// template function.
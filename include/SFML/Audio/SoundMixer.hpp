@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDMIXER_HPP
+#define SFML_SOUNDMIXER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound stream mixing other streams into a single source
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundMixer : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// \param channelCount Number of channels of the mix
+    /// \param sampleRate   Sample rate of the mix, and of the streams it mixes
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundMixer(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundMixer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a stream to the mix
+    ///
+    /// The stream must have the sample rate of the mixer, and
+    /// either its channel count or a single channel, which is
+    /// then played on all the channels of the mix. It must not
+    /// be played on its own while it is mixed, nor be destroyed
+    /// before it is removed. Its volume scales its samples in
+    /// the mix and its effects are applied; its other source
+    /// properties are ignored, those of the mixer apply to the
+    /// whole mix.
+    ///
+    /// A stream that reaches its end is removed automatically,
+    /// unless it loops.
+    ///
+    /// \param stream Stream to mix
+    ///
+    /// \return True if the stream was added, false if its format doesn't match
+    ///
+    /// \see removeStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addStream(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a stream from the mix
+    ///
+    /// Once this function returns, the streaming thread no
+    /// longer uses the stream.
+    ///
+    /// \param stream Stream to remove
+    ///
+    /// \see addStream, clearStreams
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeStream(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the streams from the mix
+    ///
+    /// \see removeStream
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearStreams();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of streams in the mix
+    ///
+    /// \return Number of streams still being mixed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStreamCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// A fixed-size block of each stream is mixed; the mixer
+    /// plays silence when there is no stream to mix.
+    ///
+    /// \param data Chunk of audio data to fill
+    ///
+    /// \return Always true, the mix never ends by itself
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// A mix has no position: the samples pulled from the
+    /// streams but not mixed yet are discarded instead.
+    ///
+    /// \param timeOffset Ignored
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stream being mixed, with the samples it gave in advance
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Input
+    {
+        SoundStream*       stream;   ///< Mixed stream
+        std::vector<float> pending;  ///< Samples pulled from the stream, converted to the channels of the mix
+        std::size_t        offset;   ///< Index of the first pending sample not mixed yet
+        bool               finished; ///< Has the stream reached its end?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pull chunks from a stream until a block of the mix is available
+    ///
+    /// \param input Stream to pull from
+    ///
+    ////////////////////////////////////////////////////////////
+    void pull(Input& input);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable Mutex      m_mutex;     ///< Protects the inputs from the streaming thread
+    std::vector<Input> m_inputs;    ///< Streams being mixed
+    std::vector<float> m_mix;       ///< Block of mixed samples handed to the stream
+    std::vector<float> m_chunk;     ///< Chunk of a stream after its effects
+    std::size_t        m_blockSize; ///< Number of samples mixed per onGetData call
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDMIXER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundMixer
+/// \ingroup audio
+///
+/// Every sf::SoundStream plays through its own OpenAL source,
+/// and each playing source has a fixed cost in the audio
+/// mixer of the device. Many streams that don't need their
+/// own spatialization, such as distant ambiences or crowd
+/// voices, can be mixed in software instead, in a single
+/// stream played by a single source.
+///
+/// sf::SoundMixer pulls the samples of the streams added to
+/// it, runs their effects, scales them by their volume and
+/// sums them with SIMD instructions when the target
+/// architecture provides them. Being a sf::SoundStream itself,
+/// the mixer can have effects applied to the whole mix, which
+/// makes it a submix bus.
+///
+/// Usage example:
+/// \code
+/// // The streams must outlive the mixer, or be removed before they are destroyed
+/// sf::Music voices[20];
+/// sf::SoundMixer crowd(2, 44100);
+///
+/// for (int i = 0; i < 20; ++i)
+/// {
+///     voices[i].openFromFile(...);
+///     voices[i].setVolume(50);
+///     crowd.addStream(voices[i]);
+/// }
+///
+/// crowd.setPosition(10, 0, 0);
+/// crowd.play();
+/// \endcode
+///
+/// \see sf::SoundStream, sf::SoundEffect
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDPOOL_HPP
+#define SFML_SOUNDPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector3.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class SoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of voices for fire-and-forget sound playback
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a sound played by the pool
+    ///
+    /// The value 0 never identifies a sound.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Handle;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// All the audio sources of the pool are created here, so
+    /// that playing a sound never creates one.
+    ///
+    /// \param voiceCount   Number of sounds that can be heard at the same time
+    /// \param virtualCount Number of inaudible sounds whose playback is tracked
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundPool(std::size_t voiceCount = 32, std::size_t virtualCount = 128);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the sounds of the pool are stopped.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Play a sound at a position in the scene
+    ///
+    /// If all the voices are busy, the least important one is
+    /// stolen: the sounds of lower priority go first, then the
+    /// quietest ones for the listener. If the new sound is the
+    /// least important, or too far to be heard, it becomes
+    /// virtual: its playback is tracked without using a voice,
+    /// and it is heard from its current offset once it gets a
+    /// voice back.
+    ///
+    /// The buffer must stay alive until the sound is over.
+    ///
+    /// \param buffer   Sound buffer to play
+    /// \param position Position of the sound in the scene
+    /// \param priority Importance of the sound, higher values are stolen last
+    /// \param volume   Volume of the sound, in the range [0, 100]
+    ///
+    /// \return Identifier of the sound, or 0 if it was dropped
+    ///
+    /// \see stop, update
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle play(const SoundBuffer& buffer, const Vector3f& position, int priority = 0, float volume = 100.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Play a non-spatialized sound
+    ///
+    /// The sound is played at the position of the listener,
+    /// voice stealing only depends on its priority and volume.
+    ///
+    /// \param buffer   Sound buffer to play
+    /// \param priority Importance of the sound, higher values are stolen last
+    /// \param volume   Volume of the sound, in the range [0, 100]
+    ///
+    /// \return Identifier of the sound, or 0 if it was dropped
+    ///
+    /// \see stop, update
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle play(const SoundBuffer& buffer, int priority = 0, float volume = 100.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a sound before its end
+    ///
+    /// Nothing happens if the sound is already over.
+    ///
+    /// \param handle Identifier of the sound returned by play()
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop(Handle handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop all the sounds of the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move a spatialized sound
+    ///
+    /// Nothing happens if the sound is already over or
+    /// is not spatialized.
+    ///
+    /// \param handle   Identifier of the sound returned by play()
+    /// \param position New position of the sound in the scene
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(Handle handle, const Vector3f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a sound is still playing
+    ///
+    /// A virtual sound is playing too, even though it
+    /// can't be heard.
+    ///
+    /// \param handle Identifier of the sound returned by play()
+    ///
+    /// \return True if the sound is not over yet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPlaying(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the assignment of the voices
+    ///
+    /// This function must be called regularly, every frame for
+    /// example. It recycles the voices of the sounds that are
+    /// over, moves the sounds that can't be heard anymore to
+    /// virtual voices, and gives real voices back to the most
+    /// important virtual sounds.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the gain under which a sound is considered inaudible
+    ///
+    /// The gain of a sound combines its volume and its distance
+    /// attenuation; sounds below this threshold never occupy
+    /// a voice. The default threshold is 0.001.
+    ///
+    /// \param gain Minimum audible gain, in the range [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAudibilityThreshold(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain under which a sound is considered inaudible
+    ///
+    /// \return Minimum audible gain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getAudibilityThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sounds currently using a voice
+    ///
+    /// \return Number of audible sounds
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getActiveCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sounds currently virtual
+    ///
+    /// \return Number of tracked but inaudible sounds
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVirtualCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sound played by the pool, real or virtual
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Voice
+    {
+        Handle             handle;   ///< Identifier of the sound
+        const SoundBuffer* buffer;   ///< Sound buffer played
+        Vector3f           position; ///< Position of the sound
+        bool               relative; ///< Is the position relative to the listener?
+        int                priority; ///< Importance of the sound
+        float              volume;   ///< Volume of the sound
+        Time               start;    ///< Time of the pool clock at which the sound started
+        Sound*             sound;    ///< Real voice playing the sound, NULL if virtual
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a new sound
+    ///
+    /// \param voice Description of the sound to play
+    ///
+    /// \return Identifier of the sound, or 0 if it was dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle start(Voice voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the gain at which a sound is heard by the listener
+    ///
+    /// \param voice Sound to evaluate
+    ///
+    /// \return Gain of the sound, volume and attenuation included
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGain(const Voice& voice) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a sound is less important than another one
+    ///
+    /// \param left  First sound
+    /// \param right Second sound
+    ///
+    /// \return True if \a left should lose its voice before \a right
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLessImportant(const Voice& left, const Voice& right) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Try to give a real voice to a sound
+    ///
+    /// A free voice is used if there is one, otherwise the voice
+    /// of a less important sound is stolen and that sound
+    /// becomes virtual.
+    ///
+    /// \param index Index of the sound in m_voices
+    ///
+    /// \return True if the sound got a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    bool makeReal(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the real voice of a sound
+    ///
+    /// \param index Index of the sound in m_voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void makeVirtual(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drop the least important virtual sounds over the limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void trimVirtual();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sound from the pool
+    ///
+    /// \param index Index of the sound in m_voices
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Sound>  m_sounds;       ///< Real voices, created once
+    std::vector<Sound*> m_freeSounds;   ///< Real voices not playing anything
+    std::vector<Voice>  m_voices;       ///< Sounds currently playing, real or virtual
+    std::size_t         m_virtualCount; ///< Maximum number of virtual sounds
+    float               m_threshold;    ///< Gain under which sounds are inaudible
+    Clock               m_clock;        ///< Clock measuring the playback of the sounds
+    Handle              m_nextHandle;   ///< Identifier of the next sound played
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundPool
+/// \ingroup audio
+///
+/// Each sf::Sound owns an audio source, which is costly to
+/// create and limited in number (often 256 in total). Creating
+/// a sound for every shot of an effect is therefore slow, and
+/// may fail when many of them overlap.
+///
+/// sf::SoundPool creates a fixed number of voices up front and
+/// plays buffers on them. When more sounds are requested than
+/// there are voices, the least important ones are stolen: lower
+/// priorities first, then the sounds that are the quietest for
+/// the listener. Stolen and inaudible sounds become virtual:
+/// the pool keeps track of their playing offset, and they are
+/// heard again from the right position when they get a voice
+/// back, for example because the listener came closer.
+///
+/// The spatialized sounds of the pool use the default minimum
+/// distance and attenuation of sf::SoundSource.
+///
+/// Usage example:
+/// \code
+/// sf::SoundPool pool(32);
+///
+/// // Fire and forget
+/// pool.play(explosionBuffer, explosionPosition, 1);
+/// pool.play(clickBuffer);
+///
+/// // Every frame
+/// sf::Listener::setPosition(playerPosition);
+/// pool.update();
+/// \endcode
+///
+/// \see sf::Sound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
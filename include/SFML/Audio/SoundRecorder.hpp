@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <vector>
@@ -213,6 +215,28 @@ protected:
     ////////////////////////////////////////////////////////////
     void setProcessingInterval(Time interval);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of the frames given to onProcessSamples
+    ///
+    /// With a non-zero frame duration, the recorder works in
+    /// low-latency mode: the processing interval is ignored,
+    /// the recording thread wakes up when a frame is due and
+    /// onProcessSamples is called once per frame, always with
+    /// the same number of samples (only the last call, when
+    /// the capture stops, may receive fewer). This is what voice
+    /// chat codecs usually expect, with frames of 10 to 20 ms.
+    ///
+    /// The frame duration applies the next time the capture
+    /// is started. The default duration is zero, which delivers
+    /// all the available samples every processing interval.
+    ///
+    /// \param duration Duration of a frame, or Time::Zero to disable frames
+    ///
+    /// \see setProcessingInterval
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameDuration(Time duration);
+
     ////////////////////////////////////////////////////////////
     /// \brief Start capturing audio data
     ///
@@ -274,6 +298,26 @@ private:
     ////////////////////////////////////////////////////////////
     void processCapturedSamples();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the new available frames and process them
+    ///
+    /// This function is called continuously during the capture
+    /// loop in low-latency mode. It forwards each complete frame
+    /// to the derived class.
+    ///
+    /// \param flush True to also forward the last incomplete frame
+    ///
+    /// \return Time to wait until the next frame is complete
+    ///
+    ////////////////////////////////////////////////////////////
+    Time processCapturedFrames(bool flush);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the recording thread and wait for it to finish
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopThread();
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up the recorder's internal resources
     ///
@@ -286,9 +330,13 @@ private:
     // Member data
     ////////////////////////////////////////////////////////////
     Thread             m_thread;             ///< Thread running the background recording task
+    Mutex              m_stopMutex;          ///< Mutex protecting the capturing state against the waiting thread
+    ConditionVariable  m_stopCondition;      ///< Signaled when the capture is stopped, to interrupt the wait of the thread
     std::vector<Int16> m_samples;            ///< Buffer to store captured samples
     unsigned int       m_sampleRate;         ///< Sample rate
     Time               m_processingInterval; ///< Time period between calls to onProcessSamples
+    Time               m_frameDuration;      ///< Duration of the frames given to onProcessSamples, zero for none
+    std::size_t        m_frameSize;          ///< Number of frames captured at once in low-latency mode, zero for none
     bool               m_isCapturing;        ///< Capturing state
     std::string        m_deviceName;         ///< Name of the audio capture device
     unsigned int       m_channelCount;       ///< Number of recording channels
@@ -324,7 +372,10 @@ private:
 /// calls, with the setProcessingInterval protected function. The default
 /// interval is chosen so that recording thread doesn't consume too much
 /// CPU, but it can be changed to a smaller value if you need to process
-/// the recorded data in real time, for example.
+/// the recorded data in real time, for example. For the lowest
+/// latency, setFrameDuration makes the recorder wait for each
+/// fixed-size frame of samples instead, and deliver it as soon
+/// as it is captured.
 ///
 /// The audio capture feature may not be supported or activated
 /// on every platform, thus it is recommended to check its
@@ -30,14 +30,23 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
-#include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
+class SoundEffect;
+class SoundMixer;
+
+namespace priv
+{
+    class Resampler;
+    class StreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -49,11 +58,54 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a chunk of audio data to stream
     ///
+    /// A chunk provides either 16-bit samples or float samples
+    /// normalized in the range [-1, 1]. Float samples are played
+    /// as they are if the audio device supports it, and are
+    /// converted to 16 bits otherwise.
+    ///
     ////////////////////////////////////////////////////////////
     struct Chunk
     {
-        const Int16* samples;     ///< Pointer to the audio samples
-        std::size_t  sampleCount; ///< Number of samples pointed by Samples
+        const Int16* samples;      ///< Pointer to the audio samples
+        std::size_t  sampleCount;  ///< Number of samples pointed by Samples
+        const float* floatSamples; ///< Pointer to float audio samples, used instead of Samples when not NULL
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Health of the streaming of a stream
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are initialized to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics() :
+        buffersFilled  (0),
+        underruns      (0),
+        decodeTime     (),
+        maxDecodeTime  (),
+        averageFillTime(),
+        maxFillTime    (),
+        queuedBuffers  (0)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint64       buffersFilled;   ///< Number of buffers filled and queued
+        Uint64       underruns;       ///< Number of times the source played all its buffers before they were refilled
+        Time         decodeTime;      ///< Total time spent in onGetData
+        Time         maxDecodeTime;   ///< Longest time spent in onGetData for a buffer
+        Time         averageFillTime; ///< Average time to fill a buffer: onGetData, effects, conversion and upload
+        Time         maxFillTime;     ///< Longest time to fill a buffer
+        unsigned int queuedBuffers;   ///< Number of buffers in the queue of the source at the last update
     };
 
     ////////////////////////////////////////////////////////////
@@ -178,6 +230,149 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of buffers queued for playback
+    ///
+    /// More buffers make the stream more tolerant to late
+    /// updates, at the cost of memory and of a longer delay
+    /// before new data is heard. The new count is used the
+    /// next time the stream starts playing.
+    /// The default number of buffers is 3, the minimum is 2.
+    ///
+    /// \param count Number of buffers
+    ///
+    /// \see getBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of buffers queued for playback
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the preferred duration of each buffer
+    ///
+    /// The size of the chunks is decided by onGetData, this
+    /// is a hint for derived classes: sf::Music reads chunks
+    /// of this duration, custom streams can get it with
+    /// getBufferDuration(). Short buffers reduce the latency
+    /// of the stream, long buffers reduce the number of
+    /// updates it needs.
+    /// The default buffer duration is 1 second.
+    ///
+    /// \param duration Duration of a buffer
+    ///
+    /// \see getBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the preferred duration of each buffer
+    ///
+    /// \return Duration of a buffer
+    ///
+    /// \see setBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getBufferDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum time between two updates of the stream
+    ///
+    /// The stream is updated when its playing buffer has been
+    /// consumed. A processing interval makes it update more
+    /// often, for example when onGetData produces data as it
+    /// arrives.
+    /// The default interval is Time::Zero (no maximum).
+    ///
+    /// \param interval Maximum time between two updates, Time::Zero for no maximum
+    ///
+    /// \see getProcessingInterval
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProcessingInterval(Time interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum time between two updates of the stream
+    ///
+    /// \return Maximum time between two updates, Time::Zero for no maximum
+    ///
+    /// \see setProcessingInterval
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getProcessingInterval() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an effect to the chain processing the stream
+    ///
+    /// The effects process the samples in the order they were
+    /// added, on the streaming thread, before they are given
+    /// to the audio device. The stream only keeps a pointer to
+    /// the effect, which must outlive it or be removed first.
+    /// Adding the same effect twice applies it twice.
+    ///
+    /// \param effect Effect to append
+    ///
+    /// \see removeEffect, clearEffects
+    ///
+    ////////////////////////////////////////////////////////////
+    void addEffect(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an effect from the chain processing the stream
+    ///
+    /// Once this function returns, the streaming thread no
+    /// longer uses the effect.
+    ///
+    /// \param effect Effect to remove
+    ///
+    /// \see addEffect, clearEffects
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeEffect(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the effects processing the stream
+    ///
+    /// \see addEffect, removeEffect
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearEffects();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the streaming
+    ///
+    /// An underrun is a glitch: the stream was silent until its
+    /// queue was refilled. They happen when onGetData is slower
+    /// than playback, or when the streaming thread is held up;
+    /// a longer buffer duration or more buffers (see
+    /// setBufferDuration and setBufferCount) make them less
+    /// likely. The counters accumulate until resetStatistics()
+    /// is called, for all the times the stream was played.
+    ///
+    /// \return Statistics of the stream
+    ///
+    /// \see resetStatistics, sf::PlaybackDevice::getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the statistics of the streaming
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
 protected:
 
     enum
@@ -253,14 +448,51 @@ protected:
 
 private:
 
+    friend class priv::StreamScheduler;
+    friend class SoundMixer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the buffers, fill them and start playing
+    ///
+    /// This function is called by the streaming thread when
+    /// it first updates the stream.
+    ///
+    /// \param delay Receives the time until the stream must be updated again
+    ///
+    /// \return True if the stream is streaming, false if it was stopped before starting
+    ///
+    ////////////////////////////////////////////////////////////
+    bool startStreaming(Time& delay);
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Refill the buffers that have been played
+    ///
+    /// This function is called by the streaming thread
+    /// whenever the playing buffer is about to be consumed.
+    ///
+    /// \param delay Receives the time until the stream must be updated again
+    ///
+    /// \return True to continue streaming, false if the stream has ended
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    ////////////////////////////////////////////////////////////
+    bool updateStreaming(Time& delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop playing and delete the buffers
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    void stopStreaming();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time until the stream must be updated again
+    ///
+    /// This is the time left before the playing buffer is
+    /// consumed, limited by the processing interval.
+    ///
+    /// \return Time until the next update, Time::Zero if the queue doesn't play
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getUpdateDelay() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -270,7 +502,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, buffer count])
     /// \param immediateLoop Treat empty buffers as spent, and act on loops immediately
     ///
     /// \return True if the stream source has requested to stop, false otherwise
@@ -278,6 +510,17 @@ private:
     ////////////////////////////////////////////////////////////
     bool fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the effects and convert a chunk to the format of the device
+    ///
+    /// \param data Chunk returned by onGetData
+    /// \param last True if no chunk will follow, to flush the resampler
+    ///
+    /// \return Converted float samples, valid until the next call
+    ///
+    ////////////////////////////////////////////////////////////
+    Chunk convertChunk(const Chunk& data, bool last);
+
     ////////////////////////////////////////////////////////////
     /// \brief Fill the audio buffers and put them all into the playing queue
     ///
@@ -299,24 +542,39 @@ private:
 
     enum
     {
-        BufferCount = 3,    ///< Number of audio buffers used by the streaming loop
         BufferRetries = 2   ///< Number of retries (excluding initial try) for onGetData()
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                   ///< Thread running the background tasks
-    mutable Mutex m_threadMutex;              ///< Thread mutex
-    Status        m_threadStartState;         ///< State the thread starts in (Playing, Paused, Stopped)
-    bool          m_isStreaming;              ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];     ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;             ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;               ///< Frequency (samples / second)
-    Uint32        m_format;                   ///< Format of the internal sound buffers
-    bool          m_loop;                     ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;         ///< Number of buffers processed since beginning of the stream
-    Int64         m_bufferSeeks[BufferCount]; ///< If buffer is an "end buffer", holds next seek position, else NoLoop. For play offset calculation.
+    mutable Mutex             m_threadMutex;        ///< Mutex protecting the state shared with the streaming thread
+    Status                    m_threadStartState;   ///< State the stream starts in (Playing, Paused, Stopped)
+    bool                      m_isStreaming;        ///< Streaming state (true = playing, false = stopped)
+    bool                      m_requestStop;        ///< Has the stream source requested to stop?
+    std::vector<unsigned int> m_buffers;            ///< Sound buffers used to store temporary audio data
+    unsigned int              m_bufferCount;        ///< Number of buffers to use the next time the stream starts
+    Time                      m_bufferDuration;     ///< Preferred duration of a buffer
+    Time                      m_processingInterval; ///< Maximum time between two updates (Time::Zero for none)
+    unsigned int              m_channelCount;       ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int              m_sampleRate;         ///< Frequency (samples / second)
+    Uint32                    m_format;             ///< Format of the internal sound buffers
+    Uint32                    m_floatFormat;        ///< Format of the internal sound buffers for float samples, 0 if not supported
+    std::vector<Int16>        m_convertedSamples;   ///< Float samples converted to 16 bits, when the float format is not supported
+    bool                      m_mixToStereo;        ///< Are the channels mixed down to stereo, because the device can't play them?
+    unsigned int              m_outputSampleRate;   ///< Sample rate of the samples given to the device
+    priv::Resampler*          m_resampler;          ///< Converter to the output sample rate, NULL if it is the stream's rate
+    std::vector<float>        m_floatInput;         ///< 16-bit samples converted to floats before the conversion
+    std::vector<float>        m_mixedSamples;       ///< Samples mixed down to stereo
+    std::vector<float>        m_resampledSamples;   ///< Samples converted to the output sample rate
+    Mutex                     m_effectMutex;        ///< Protects the chain of effects used by the streaming thread
+    std::vector<SoundEffect*> m_effects;            ///< Effects processing the samples, in order
+    Statistics                m_statistics;         ///< Statistics of the streaming, protected by m_threadMutex
+    Time                      m_totalFillTime;      ///< Time spent filling buffers, for the average fill time
+    bool                      m_loop;               ///< Loop flag (true to loop, false to play once)
+    Uint64                    m_samplesProcessed;   ///< Number of buffers processed since beginning of the stream
+    std::vector<Int64>        m_bufferSeeks;        ///< If buffer is an "end buffer", holds next seek position, else NoLoop. For play offset calculation.
+    std::vector<Uint64>       m_bufferSampleCounts; ///< Number of stream samples held by each buffer, before any conversion
 };
 
 } // namespace sf
@@ -350,13 +608,19 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// It is important to note that SoundStreams are updated by a
+/// separate thread, shared by all the playing streams, so that
+/// streaming doesn't block the rest of the program. In particular,
+/// the OnGetData and OnSeek virtual functions may sometimes be
+/// called from this separate thread.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
+/// The samples of a stream can be processed by a chain of effects
+/// (see sf::SoundEffect and addEffect()), without changing how the
+/// derived class produces them. Streams that don't need their own
+/// source can also be mixed together by a sf::SoundMixer.
+///
 /// Usage example:
 /// \code
 /// class CustomStream : public sf::SoundStream
@@ -116,6 +116,22 @@
 #endif
 
 
+////////////////////////////////////////////////////////////
+// Detect the support of rvalue references, the resource classes
+// then get move constructors and move assignment operators
+// (define SFML_NO_MOVE_SEMANTICS to disable them)
+////////////////////////////////////////////////////////////
+#if !defined(SFML_NO_MOVE_SEMANTICS)
+
+    #if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1900))
+
+        #define SFML_HAS_MOVE_SEMANTICS
+
+    #endif
+
+#endif
+
+
 ////////////////////////////////////////////////////////////
 // Define helpers to create portable import / export macros for each module
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_CACHEDLAYER_HPP
+#define SFML_CACHEDLAYER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Drawable that caches the rendering of other
+///        drawables in a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CachedLayer : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty layer, with no child and no texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    CachedLayer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture of the layer
+    ///
+    /// The children are drawn in the local coordinates of the
+    /// layer, which cover the rectangle (0, 0, width, height);
+    /// what they draw outside of it is not visible. The whole
+    /// layer is rendered again at the next draw.
+    ///
+    /// \param width    Width of the layer, in pixels
+    /// \param height   Height of the layer, in pixels
+    /// \param settings Settings of the render texture (antialiasing, ...)
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable at the end of the children of the layer
+    ///
+    /// Children are drawn in the order they were added. The
+    /// layer doesn't own them: they must exist as long as the
+    /// layer uses them. The area covered by the child is
+    /// invalidated.
+    ///
+    /// \param drawable Drawable to add
+    /// \param states   Render states to draw it with, in the local coordinates of the layer
+    ///
+    /// \see removeChild, invalidate
+    ///
+    ////////////////////////////////////////////////////////////
+    void addChild(const Drawable& drawable, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a drawable from the children of the layer
+    ///
+    /// The area where the child was drawn is invalidated. This
+    /// function does nothing if \a drawable is not a child of
+    /// the layer.
+    ///
+    /// \param drawable Drawable to remove
+    ///
+    /// \see addChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeChild(const Drawable& drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the children of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearChildren();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the layer
+    ///
+    /// \return Number of children
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the color that the layer is cleared with
+    ///
+    /// The default color is transparent, so that the parts of
+    /// the layer where no child is drawn show what is behind.
+    /// The whole layer is invalidated.
+    ///
+    /// \param color New clear color
+    ///
+    ////////////////////////////////////////////////////////////
+    void setClearColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color that the layer is cleared with
+    ///
+    /// \return Clear color
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getClearColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the whole layer again at the next draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render an area of the layer again at the next draw
+    ///
+    /// Only the invalidated areas are cleared and rendered
+    /// again, and only the children that overlap them are
+    /// drawn (the children that can't tell their bounds are
+    /// always drawn).
+    ///
+    /// \param area Area to render again, in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(const FloatRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the area of a child again at the next draw
+    ///
+    /// Call this function after changing a child: both the
+    /// area where it was drawn last and the area it covers now
+    /// are invalidated. The whole layer is invalidated for
+    /// children that can't tell their bounds.
+    ///
+    /// \param drawable Child that changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(const Drawable& drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a part of the layer must be rendered again
+    ///
+    /// \return True if an area was invalidated since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDirty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the invalidated areas of the layer to its texture
+    ///
+    /// This function is called by draw(), calling it before
+    /// gives a chance to do the rendering at another time.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture that the layer is rendered to
+    ///
+    /// The texture is not updated by this function.
+    ///
+    /// \return Texture of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the layer
+    ///
+    /// \return Local bounding rectangle of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the layer
+    ///
+    /// \return Global bounding rectangle of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the layer to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the layer, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the layer
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Child of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Child
+    {
+        const Drawable* drawable;  ///< Drawable of the child
+        RenderStates    states;    ///< States to draw it with
+        FloatRect       bounds;    ///< Area covered by the child when it was last invalidated
+        bool            hasBounds; ///< Can the child tell its bounds?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the area covered by a child
+    ///
+    /// \param child Child to update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateBounds(Child& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invalidate the area covered by a child, or the whole layer
+    ///
+    /// \param child Child whose area is invalidated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateChild(const Child& child);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable RenderTexture        m_renderTexture; ///< Texture that the children are rendered to
+    std::vector<Child>           m_children;      ///< Children of the layer, in drawing order
+    Color                        m_clearColor;    ///< Color of the background of the layer
+    mutable std::vector<IntRect> m_dirtyAreas;    ///< Disjoint areas to render again, in pixels
+    Vertex                       m_vertices[4];   ///< Quad that displays the texture
+};
+
+} // namespace sf
+
+
+#endif // SFML_CACHEDLAYER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CachedLayer
+/// \ingroup graphics
+///
+/// sf::CachedLayer renders a group of drawables to a texture
+/// once, and then draws that texture as a single quad. It is
+/// meant for content that rarely changes, such as the panels of
+/// a user interface: drawing a layer costs one draw call no
+/// matter how many texts and shapes it contains.
+///
+/// When a child changes, invalidate the area that it covers
+/// (invalidate(const Drawable&) finds it for you): only the
+/// invalidated areas are cleared and rendered again, with the
+/// children that overlap them, at the next draw. Overlapping
+/// invalidated areas are merged, and the layer is rendered as
+/// a whole when too many of them accumulate.
+///
+/// The layer is also a sf::Transformable, the transform applies
+/// to the quad; the children are positioned in its local
+/// coordinates, from (0, 0) to the size given to create().
+///
+/// Usage example:
+/// \code
+/// sf::CachedLayer hud;
+/// hud.create(400, 100);
+/// hud.setPosition(10, 10);
+///
+/// sf::RectangleShape background(sf::Vector2f(400, 100));
+/// sf::Text score("Score: 0", font);
+/// hud.addChild(background);
+/// hud.addChild(score);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///
+///     if (scoreChanged)
+///     {
+///         score.setString("Score: " + toString(points));
+///         hud.invalidate(score);
+///     }
+///
+///     window.clear();
+///     window.draw(hud); // only the score is rendered again, and only when it changed
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderTexture, sf::Drawable
+///
+////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <vector>
 
 
 namespace sf
@@ -99,6 +100,10 @@ public:
     /// not taken into account.
     /// The result is undefined if \a index is out of the valid range.
     ///
+    /// The points are scaled from a table of unit directions
+    /// which is computed once per point count and shared by
+    /// all the circles, so no trigonometry is involved.
+    ///
     /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
     ///
     /// \return index-th point of the shape
@@ -111,8 +116,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     ///< Radius of the circle
-    std::size_t m_pointCount; ///< Number of points composing the circle
+    float                        m_radius;     ///< Radius of the circle
+    std::size_t                  m_pointCount; ///< Number of points composing the circle
+    const std::vector<Vector2f>* m_unitPoints; ///< Points of the unit circle with the same point count, shared between circles
 };
 
 } // namespace sf
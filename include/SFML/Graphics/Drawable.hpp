@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Rect.hpp>
 
 
 namespace sf
@@ -54,6 +55,7 @@ public:
 protected:
 
     friend class RenderTarget;
+    friend class CachedLayer;
 
     ////////////////////////////////////////////////////////////
     /// \brief Draw the object to a render target
@@ -67,6 +69,31 @@ protected:
     ///
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the object, for culling
+    ///
+    /// Render targets with culling enabled call this function
+    /// to skip the objects that are entirely outside of their
+    /// view. The rectangle must contain everything that draw()
+    /// renders, in the coordinate system that the transform of
+    /// the render states passed to draw() applies to.
+    ///
+    /// The default implementation returns false, so that
+    /// objects which don't override it are always drawn.
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the object
+    ///
+    /// \return True if \a bounds was filled, false if the object can't be culled
+    ///
+    /// \see RenderTarget::setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const
+    {
+        (void)bounds;
+        return false;
+    }
 };
 
 } // namespace sf
@@ -83,7 +110,8 @@ protected:
 /// of derived classes to be drawn to a sf::RenderTarget.
 ///
 /// All you have to do in your derived class is to override the
-/// draw virtual function.
+/// draw virtual function. Overriding getCullingBounds as well
+/// lets render targets skip the object when it is not visible.
 ///
 /// Note that inheriting from sf::Drawable is not mandatory,
 /// but it allows this nice syntax "window.draw(object)" rather
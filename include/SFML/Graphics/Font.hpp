@@ -32,8 +32,13 @@
 #include <SFML/Graphics/Glyph.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/SharedMutex.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <deque>
+#include <list>
 #include <map>
 #include <string>
 #include <vector>
@@ -41,6 +46,7 @@
 
 namespace sf
 {
+class ArchiveInputStream;
 class InputStream;
 
 ////////////////////////////////////////////////////////////
@@ -60,6 +66,20 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Position of a character in a shaped run
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ShapedGlyph
+    {
+        Uint32      codePoint; ///< Unicode code point of the character
+        std::size_t cluster;   ///< Index of the character in the shaped string
+        float       offset;    ///< Horizontal position of the glyph origin, relative to the start of the run
+        float       advance;   ///< Offset to move horizontally to the next glyph
+    };
+
+    typedef std::vector<ShapedGlyph> ShapedRun; ///< Glyphs of a shaped string, in display order
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -78,6 +98,22 @@ public:
     ////////////////////////////////////////////////////////////
     Font(const Font& copy);
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The font takes over the face and the glyph textures of
+    /// \a right, which is left empty. Glyphs that \a right was
+    /// preloading in the background are loaded on demand instead.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Font(Font&& right) : Font() {swap(right);}
+
+#endif
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -169,6 +205,12 @@ public:
     /// Be aware that using a negative value for the outline
     /// thickness will cause distorted rendering.
     ///
+    /// This function can be called from several threads at
+    /// once: glyphs already loaded are found without locking,
+    /// and new ones are rendered in the calling thread. Their
+    /// pixels are written to the textures by the next call to
+    /// getTexture.
+    ///
     /// \param codePoint        Unicode code point of the character to get
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
@@ -188,6 +230,9 @@ public:
     /// closer than other characters. Most of the glyphs pairs have a
     /// kerning offset of zero, though.
     ///
+    /// Like getGlyph, this function can be called from several
+    /// threads at once.
+    ///
     /// \param first         Unicode code point of the first character
     /// \param second        Unicode code point of the second character
     /// \param characterSize Reference character size
@@ -197,6 +242,33 @@ public:
     ////////////////////////////////////////////////////////////
     float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Shape a run of text
+    ///
+    /// This function places all the glyphs of a string at once,
+    /// applying the advance of every glyph and the kerning of
+    /// every pair, which is much cheaper than calling getGlyph
+    /// and getKerning for each character when laying out long
+    /// strings. The run is a single line: line breaks and other
+    /// special characters are placed like any other glyph.
+    ///
+    /// The most recently shaped runs are cached, shaping the
+    /// same string again only costs a lookup. The returned run
+    /// remains valid until the next call to shape, or until
+    /// the font is loaded again.
+    ///
+    /// Unlike getGlyph and getKerning, this function must not be
+    /// called from several threads at once.
+    ///
+    /// \param string        String to shape
+    /// \param characterSize Reference character size
+    /// \param bold          Shape the bold version or the regular one?
+    ///
+    /// \return Glyphs of \a string with their positions, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const ShapedRun& shape(const String& string, unsigned int characterSize, bool bold = false) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the line spacing
     ///
@@ -240,18 +312,136 @@ public:
     float getUnderlineThickness(unsigned int characterSize) const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Retrieve the texture containing the loaded glyphs of a certain size
+    /// \brief Retrieve a texture containing the loaded glyphs of a certain size
+    ///
+    /// The glyphs of a character size are packed into one or
+    /// more textures; a new texture is added when the previous
+    /// ones are full. The index of the texture holding a glyph
+    /// is given by its Glyph::textureIndex member.
     ///
     /// The contents of the returned texture changes as more glyphs
     /// are requested, thus it is not very relevant. It is mainly
     /// used internally by sf::Text.
     ///
+    /// The glyphs loaded since the previous call are written to
+    /// the textures here, so this function must be called from
+    /// the thread that draws with them.
+    ///
+    /// \param characterSize Reference character size
+    /// \param index         Index of the texture, the first one is returned if it is out of range
+    ///
+    /// \return Texture containing glyphs of the requested size
+    ///
+    /// \see getTextureCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int characterSize, unsigned int index = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures holding the glyphs of a certain size
+    ///
     /// \param characterSize Reference character size
     ///
-    /// \return Texture containing the glyphs of the requested size
+    /// \return Number of textures, at least 1
+    ///
+    /// \see getTexture
     ///
     ////////////////////////////////////////////////////////////
-    const Texture& getTexture(unsigned int characterSize) const;
+    unsigned int getTextureCount(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable distance field glyphs
+    ///
+    /// By default, glyphs are rasterized separately for every
+    /// character size and outline thickness, each character
+    /// size having its own textures.
+    ///
+    /// When distance field glyphs are enabled, every glyph is
+    /// rasterized once at a fixed reference size, and the
+    /// textures store the distance of each texel to the edge
+    /// of the glyph instead of its coverage. A single set of
+    /// textures then serves all the character sizes and
+    /// outline thicknesses, and sf::Text renders them with a
+    /// shader that reconstructs sharp edges at any scale.
+    /// The outline thickness is limited to a fraction of the
+    /// character size (about an eighth of it).
+    ///
+    /// Distance field glyphs require shaders (see
+    /// sf::Shader::isAvailable); they are unhinted, so small
+    /// character sizes look slightly softer than regular glyphs.
+    ///
+    /// Changing this setting discards all the loaded glyphs.
+    /// This setting is disabled by default.
+    ///
+    /// \param enabled True to use distance field glyphs, false to rasterize glyphs per size
+    ///
+    /// \see isDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDistanceFieldEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether distance field glyphs are enabled
+    ///
+    /// \return True if distance field glyphs are enabled
+    ///
+    /// \see setDistanceFieldEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceFieldEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded the first time they are
+    /// requested, which can stall the first frame that displays
+    /// a text made of new characters. This function loads them
+    /// at a more convenient time, while loading a level or a
+    /// menu for example.
+    ///
+    /// The characters that are already loaded are skipped.
+    ///
+    /// \param characters       Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline
+    ///
+    /// \see preloadGlyphsAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, unsigned int characterSize, bool bold = false, float outlineThickness = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance, in a background thread
+    ///
+    /// This function returns immediately: the glyphs are rendered
+    /// by FreeType in a separate thread, and only added to the
+    /// glyphs of the font when a glyph that is not loaded yet
+    /// is requested (typically while laying out a sf::Text).
+    /// A glyph requested before the background thread renders
+    /// it is loaded immediately, as usual.
+    ///
+    /// Successive calls queue up their characters.
+    ///
+    /// \param characters       Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline
+    ///
+    /// \see preloadGlyphs, isPreloadingGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphsAsync(const String& characters, unsigned int characterSize, bool bold = false, float outlineThickness = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are still being rendered in the background
+    ///
+    /// \return True if the thread started by preloadGlyphsAsync is still working
+    ///
+    /// \see preloadGlyphsAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPreloadingGlyphs() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
@@ -263,40 +453,248 @@ public:
     ////////////////////////////////////////////////////////////
     Font& operator =(const Font& right);
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move, left empty
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Font& operator =(Font&& right) {Font temp; temp.swap(right); swap(temp); return *this;}
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this font with those of another
+    ///
+    /// Glyphs that either font was preloading in the background
+    /// are loaded on demand instead.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Font& right);
+
 private:
 
+    friend class Text;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Structure defining a row of glyphs
+    /// \brief Horizontal segment of the skyline of an atlas
     ///
     ////////////////////////////////////////////////////////////
-    struct Row
+    struct Segment
     {
-        Row(unsigned int rowTop, unsigned int rowHeight) : width(0), top(rowTop), height(rowHeight) {}
+        Segment(unsigned int segmentX, unsigned int segmentY, unsigned int segmentWidth) : x(segmentX), y(segmentY), width(segmentWidth) {}
 
-        unsigned int width;  ///< Current width of the row
-        unsigned int top;    ///< Y position of the row into the texture
-        unsigned int height; ///< Height of the row
+        unsigned int x;     ///< X position of the segment into the texture
+        unsigned int y;     ///< Y position of the first free pixel under the segment
+        unsigned int width; ///< Width of the segment
     };
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Layout of a texture into which glyphs are packed
+    ///
+    /// The free space of the texture is tracked by its skyline:
+    /// the top edge of the packed glyphs, made of horizontal
+    /// segments sorted from left to right. The texture itself
+    /// is created and resized to match by getTexture.
+    ///
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    struct Atlas
+    {
+        Vector2u             size;    ///< Size of the texture
+        std::vector<Segment> skyline; ///< Segments covering the whole width of the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pixels of a glyph waiting to be written to a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphUpload
+    {
+        unsigned int       textureIndex; ///< Index of the texture to write to
+        IntRect            rect;         ///< Rectangle of the pixels within the texture
+        std::vector<Uint8> pixels;       ///< RGBA pixels of the rectangle
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Hash table mapping glyph keys to their glyph
+    ///
+    /// The keys are looked up with open addressing and linear
+    /// probing. Regular (not bold, not outlined) and bold Latin-1
+    /// glyphs without outline skip the hashing and are directly
+    /// indexed by their code point. Glyphs are stored in a deque
+    /// so that references to them stay valid when the table grows.
+    ///
+    /// Lookups don't lock anything and can run while a glyph is
+    /// inserted: a slot publishes its glyph only once its key is
+    /// written, and the slots replaced by a bigger table are kept
+    /// until the table is destroyed, for the readers still
+    /// probing them. Insertions must be serialized by the caller.
+    ///
+    ////////////////////////////////////////////////////////////
+    class GlyphTable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        GlyphTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// \param copy Instance to copy
+        ///
+        ////////////////////////////////////////////////////////////
+        GlyphTable(const GlyphTable& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        ~GlyphTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Find the glyph corresponding to a key
+        ///
+        /// This function can be called from any thread.
+        ///
+        /// \param key Key built from the code point, bold flag and outline thickness
+        ///
+        /// \return Pointer to the glyph, NULL if it is not in the table
+        ///
+        ////////////////////////////////////////////////////////////
+        const Glyph* find(Uint64 key) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Insert a glyph which is not in the table yet
+        ///
+        /// \param key   Key built from the code point, bold flag and outline thickness
+        /// \param glyph Glyph to insert
+        ///
+        /// \return Reference to the stored glyph
+        ///
+        ////////////////////////////////////////////////////////////
+        const Glyph& insert(Uint64 key, const Glyph& glyph);
+
+    private:
+
+        struct Slots;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Disabled assignment operator
+        ///
+        ////////////////////////////////////////////////////////////
+        GlyphTable& operator =(const GlyphTable&);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Publish a table with twice as many slots
+        ///
+        /// \return The new slots
+        ///
+        ////////////////////////////////////////////////////////////
+        Slots* grow();
+
+        ////////////////////////////////////////////////////////////
+        // Types
+        ////////////////////////////////////////////////////////////
+        typedef std::pair<Uint64, Glyph> Entry; ///< Glyph stored with its key
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Atomic<const Glyph*> m_latin1[512]; ///< Regular and bold Latin-1 glyphs, NULL if not loaded
+        Atomic<Slots*>       m_slots;       ///< Current slots of the hashed keys (NULL until the first one)
+        std::vector<Slots*>  m_retired;     ///< Slots replaced by a bigger table
+        std::size_t          m_count;       ///< Number of used slots
+        std::deque<Entry>    m_entries;     ///< Storage of all the glyphs of the table, with their key
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
     ///
+    /// The glyphs and the layout of the atlases are shared by
+    /// all the threads (insertions are serialized by the cache
+    /// mutex), while the textures are only touched by the thread
+    /// calling getTexture.
+    ///
     ////////////////////////////////////////////////////////////
     struct Page
     {
         Page();
+        Page(const Page& copy);
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        GlyphTable               glyphs;     ///< Table mapping code points to their corresponding glyph
+        std::vector<Atlas>       atlases;    ///< Layout of the textures containing the glyphs
+        std::vector<GlyphUpload> uploads;    ///< Pixels of the glyphs packed since the textures were last updated
+        std::deque<Texture>      textures;   ///< Textures containing the glyphs, one per atlas once updated
+        Atomic<unsigned int>     atlasCount; ///< Number of atlases, readable without locking
+        Atomic<bool>             dirty;      ///< Do the textures lag behind the atlases?
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Kerning values already retrieved for a character size
+    ///
+    ////////////////////////////////////////////////////////////
+    struct KerningCache
+    {
+        KerningCache();
+        KerningCache(const KerningCache& copy);
+
+        Atomic<Uint32>          ascii[95 * 95]; ///< Bits of the kerning of the pairs of printable ASCII characters, dense
+        std::map<Uint64, float> pairs;          ///< Kerning of the other pairs, keyed by both code points
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shaped run kept in the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CachedRun
+    {
+        Uint64       hash;          ///< Hash of the string and attributes
+        unsigned int characterSize; ///< Character size the run was shaped with
+        bool         bold;          ///< Was the run shaped with the bold glyphs?
+        String       string;        ///< Shaped string
+        ShapedRun    glyphs;        ///< Result of the shaping
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pixels of a rendered glyph, ready to be written to a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphBitmap
+    {
+        GlyphBitmap();
+
+        Glyph              glyph;   ///< Metrics of the glyph, its texture rectangle is not known yet
+        unsigned int       width;   ///< Width of the bitmap, padding included
+        unsigned int       height;  ///< Height of the bitmap, padding included
+        unsigned int       padding; ///< Size of the border surrounding the glyph's pixels
+        std::vector<Uint8> pixels;  ///< RGBA pixels of the bitmap
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph requested by preloadGlyphsAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphRequest
+    {
+        Uint32       codePoint;        ///< Unicode code point of the character
+        unsigned int characterSize;    ///< Reference character size
+        bool         bold;             ///< Bold version or regular one?
+        float        outlineThickness; ///< Thickness of outline
+    };
+
+    struct GlyphLoader;
+    friend struct GlyphLoader;
+
     ////////////////////////////////////////////////////////////
     /// \brief Free all the internal resources
     ///
@@ -306,6 +704,12 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Load a new glyph and store it in the cache
     ///
+    /// The glyph is rendered without holding the cache mutex;
+    /// if another thread stored it in the meantime, its glyph
+    /// is returned instead.
+    ///
+    /// \param page             Page of glyphs to add the glyph to
+    /// \param key              Key of the glyph within the page
     /// \param codePoint        Unicode code point of the character to load
     /// \param characterSize    Reference character size
     /// \param bold             Retrieve the bold version or the regular one?
@@ -314,19 +718,151 @@ private:
     /// \return The glyph corresponding to \a codePoint and \a characterSize
     ///
     ////////////////////////////////////////////////////////////
-    Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+    const Glyph& loadGlyph(Page& page, Uint64 key, Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render a glyph with FreeType
+    ///
+    /// This function doesn't touch the textures, it can be
+    /// called from any thread.
+    ///
+    /// \param codePoint        Unicode code point of the character to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param result           Receives the glyph and its pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness, GlyphBitmap& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack a rendered glyph into the atlases of a page
+    ///
+    /// The pixels of the bitmap are moved to the uploads of the
+    /// page, they are written to its textures by getTexture.
+    /// The cache mutex must be locked by the caller.
+    ///
+    /// \param page   Page of glyphs to add the glyph to
+    /// \param bitmap Rendered glyph, its pixels are taken
+    ///
+    /// \return The glyph, with its texture rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph packGlyph(Page& page, GlyphBitmap& bitmap) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bring the textures of a page up to date with its atlases
+    ///
+    /// Missing textures are created, the textures are resized
+    /// to the size of their atlas and the pending uploads are
+    /// written to them. This must be done in the thread that
+    /// draws with the textures.
+    ///
+    /// \param page Page of glyphs to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTextures(Page& page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scale a distance field glyph to a character size
+    ///
+    /// The glyph is rasterized into the distance field
+    /// page if it is not loaded yet.
+    ///
+    /// \param codePoint        Unicode code point of the character to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Retrieve the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline
+    ///
+    /// \return The glyph corresponding to \a codePoint and \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph loadDistanceFieldGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph at the reference size and compute its distance field
+    ///
+    /// Like rasterizeGlyph, this function can be called from any thread.
+    ///
+    /// \param codePoint Unicode code point of the character to load
+    /// \param bold      Retrieve the bold version or the regular one?
+    /// \param result    Receives the glyph, with metrics in reference size pixels, and its distance field
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeDistanceField(Uint32 codePoint, bool bold, GlyphBitmap& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the distance field value of the edge of an outline
+    ///
+    /// \param characterSize    Reference character size
+    /// \param outlineThickness Thickness of outline, 0 for the edge of the glyph
+    ///
+    /// \return Value of the distance field along the edge, in [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getDistanceFieldEdge(unsigned int characterSize, float outlineThickness) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the glyphs rendered by the background thread
+    ///
+    /// The thread is released once it has nothing left to do.
+    /// The cache mutex must be locked by the caller.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushPreloadedGlyphs() const;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Find a suitable rectangle within the texture for a glyph
+    /// \brief Get the character size of the page holding a preloaded glyph
+    ///
+    /// \param request Requested glyph
+    ///
+    /// \return Character size of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPreloadedPage(const GlyphRequest& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the key of a preloaded glyph within its page
+    ///
+    /// \param request Requested glyph
+    ///
+    /// \return Key of the glyph
     ///
-    /// \param page   Page of glyphs to search in
+    ////////////////////////////////////////////////////////////
+    Uint64 getPreloadedKey(const GlyphRequest& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a suitable rectangle within the textures of a page for a glyph
+    ///
+    /// The textures grow up to a fixed size, after which a new
+    /// texture is added to the page. Only the atlases are
+    /// changed, the textures follow in updateTextures.
+    ///
+    /// \param page         Page of glyphs to search in
+    /// \param width        Width of the rectangle
+    /// \param height       Height of the rectangle
+    /// \param textureIndex Receives the index of the texture containing the rectangle
+    ///
+    /// \return Found rectangle within the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height, unsigned int& textureIndex) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the lowest free position of a rectangle in an atlas
+    ///
+    /// The rectangle is placed with the bottom-left heuristic
+    /// of priv::packSkyline, and the skyline is updated on success.
+    ///
+    /// \param atlas  Atlas to search in
     /// \param width  Width of the rectangle
     /// \param height Height of the rectangle
+    /// \param rect   Receives the rectangle within the texture
     ///
-    /// \return Found rectangle within the texture
+    /// \return True if the rectangle fits in the texture
     ///
     ////////////////////////////////////////////////////////////
-    IntRect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
+    bool packGlyphRect(Atlas& atlas, unsigned int width, unsigned int height, IntRect& rect) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Make sure that the given size is the current one
@@ -338,10 +874,62 @@ private:
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of glyphs of a character size
+    ///
+    /// The page is created if it doesn't exist yet. The pages
+    /// of the usual character sizes are found without locking.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page corresponding to \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the kerning cache of a character size
+    ///
+    /// The cache is created if it doesn't exist yet.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Kerning cache corresponding to \a characterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    KerningCache& getKerningCache(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the kerning of a pair of characters from FreeType
+    ///
+    /// \param first         Unicode code point of the first character
+    /// \param second        Unicode code point of the second character
+    /// \param characterSize Reference character size
+    ///
+    /// \return Kerning value for \a first and \a second, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    float loadKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of the glyph of a character in the font face
+    ///
+    /// The FreeType mutex must be locked by the caller.
+    ///
+    /// \param codePoint Unicode code point of the character
+    ///
+    /// \return Glyph index, 0 if the face has no glyph for this character
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getGlyphIndex(Uint32 codePoint) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, Page> PageTable;            ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, KerningCache> KerningTable; ///< Table mapping a character size to its kerning cache
+    typedef std::list<CachedRun> RunList;                      ///< Cached shaped runs, most recently used first
+    typedef std::multimap<Uint64, RunList::iterator> RunTable; ///< Cached shaped runs indexed by hash
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -350,10 +938,22 @@ private:
     void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
     void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
     void*                      m_stroker;     ///< Pointer to the stroker (it is typeless to avoid exposing implementation details)
+    ArchiveInputStream*        m_archiveEntry; ///< File of a mounted archive the face is read from (NULL if not loaded from an archive)
     int*                       m_refCount;    ///< Reference counter used by implicit sharing
     Info                       m_info;        ///< Information about the font
     mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    Atomic<Page*>*             m_pageIndex;   ///< Pages of the usual character sizes, directly indexed by size (NULL if not created yet)
+    mutable KerningTable       m_kernings;    ///< Kerning caches by character size
+    Atomic<KerningCache*>*     m_kerningIndex; ///< Kerning caches of the usual character sizes, directly indexed by size (NULL if not created yet)
+    mutable Mutex              m_cacheMutex;  ///< Mutex serializing the insertions into the pages, their tables and the glyph loader
+    mutable SharedMutex        m_kerningMutex; ///< Mutex protecting the kerning tables and the pairs of the kerning caches
+    mutable std::map<Uint32, unsigned int> m_glyphIndices; ///< Glyph indices of the characters already looked up
+    mutable RunList            m_runs;        ///< Shaped runs cache, most recently used first
+    mutable RunTable           m_runTable;    ///< Shaped runs cache indexed by hash
+    mutable std::size_t        m_runGlyphCount; ///< Total number of glyphs in the shaped runs cache
+    bool                       m_distanceField; ///< Are glyphs stored as distance fields?
+    mutable GlyphLoader*       m_glyphLoader;  ///< Thread rendering the preloaded glyphs (NULL when not used)
+    Uint64                     m_cacheId;      ///< Unique number that identifies the loaded glyphs, changes when they are discarded
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
     #endif
@@ -434,6 +1034,14 @@ private:
 /// If you need to display text of a certain size, make sure the
 /// corresponding bitmap font that supports that size is used.
 ///
+/// Texts can be laid out from several threads sharing the same
+/// font: getGlyph, getKerning and the metrics functions can be
+/// called concurrently. The glyphs are written to the textures
+/// later, by getTexture, which must be called from the thread
+/// that draws (sf::Text does it when it is drawn). Loading,
+/// copying, swapping the font or changing its distance field
+/// setting must still not overlap with any other use of it.
+///
 /// \see sf::Text
 ///
 ////////////////////////////////////////////////////////////
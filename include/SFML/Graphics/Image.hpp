@@ -37,6 +37,7 @@
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 
 ////////////////////////////////////////////////////////////
@@ -61,6 +62,49 @@ public:
     ////////////////////////////////////////////////////////////
     ~Image();
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The image takes over the pixels of \a right, which
+    /// is left empty.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(Image&& right) : Image() {swap(right);}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move, left empty
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(Image&& right) {Image temp; temp.swap(right); swap(temp); return *this;}
+
+#endif
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the image and fill it with a unique color
     ///
@@ -90,8 +134,8 @@ public:
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like progressive jpeg (unless SFML is built with libjpeg-turbo).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -107,8 +151,8 @@ public:
     /// \brief Load the image from a file in memory
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like progressive jpeg (unless SFML is built with libjpeg-turbo).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -125,8 +169,8 @@ public:
     /// \brief Load the image from a custom stream
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like progressive jpeg (unless SFML is built with libjpeg-turbo).
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -143,7 +187,7 @@ public:
     ///
     /// The format of the image is automatically deduced from
     /// the extension. The supported image formats are bmp, png,
-    /// tga and jpg. The destination file is overwritten
+    /// tga, jpg and qoi. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
     ///
     /// \param filename Path of the file to save
@@ -155,6 +199,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveToFile(const std::string& filename) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a file in memory
+    ///
+    /// The supported image formats are the same as for
+    /// saveToFile, \a format is given as a file extension
+    /// ("png", "jpg", ...). This function fails if the image
+    /// is empty.
+    ///
+    /// \param output Array receiving the encoded file
+    /// \param format Format of the file, as an extension
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
     ///
@@ -198,6 +260,71 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the pixels of a view onto this image
+    ///
+    /// The view can refer to another image or to pixels stored
+    /// elsewhere. It must not overlap the destination area.
+    /// See the other overload for the meaning of \a applyAlpha.
+    ///
+    /// \param source     View of the pixels to copy
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param applyAlpha Should the copy take into account the source transparency?
+    ///
+    ////////////////////////////////////////////////////////////
+    void copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of every pixel by its alpha
+    ///
+    /// Images with premultiplied alpha are blended with
+    /// sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha),
+    /// which avoids the dark fringes that appear around
+    /// transparent areas when smooth textures are scaled.
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply every pixel by a color
+    ///
+    /// The components are multiplied the same way as with
+    /// sf::Color's operator *, alpha included.
+    ///
+    /// \param color Color to multiply the pixels with
+    ///
+    ////////////////////////////////////////////////////////////
+    void tint(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blur the image with a box filter
+    ///
+    /// Each pixel is replaced by the average of the pixels in
+    /// the square of side 2 * \a radius + 1 centered on it,
+    /// the pixels on the edges being extended outside of the
+    /// image. The cost doesn't depend on the radius.
+    ///
+    /// \param radius Radius of the blur, in pixels
+    ///
+    /// \see gaussianBlur
+    ///
+    ////////////////////////////////////////////////////////////
+    void boxBlur(unsigned int radius);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blur the image with a gaussian filter
+    ///
+    /// The gaussian filter is approximated by three successive
+    /// box blurs, so the cost doesn't depend on \a sigma.
+    ///
+    /// \param sigma Standard deviation of the blur, in pixels
+    ///
+    /// \see boxBlur
+    ///
+    ////////////////////////////////////////////////////////////
+    void gaussianBlur(float sigma);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
@@ -258,8 +385,18 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this image with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Image& right);
+
 private:
 
+    friend class ImageWriter;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
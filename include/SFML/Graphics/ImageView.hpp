@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEVIEW_HPP
+#define SFML_IMAGEVIEW_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Non-owning view of a rectangle of RGBA pixels
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageView
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty view.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a whole image
+    ///
+    /// \param image Image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of an area of an image
+    ///
+    /// If \a area is empty, the whole image is viewed. If it
+    /// crosses the bounds of the image, it is adjusted to fit
+    /// the image size.
+    ///
+    /// \param image Image to view
+    /// \param area  Area of the image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of an array of pixels
+    ///
+    /// The pixels must be 32-bit RGBA, like the ones of
+    /// sf::Image. \a stride is the number of bytes from a row
+    /// to the next one, it must be a multiple of 4.
+    ///
+    /// \param pixels Pointer to the top-left pixel
+    /// \param size   Size of the viewed area, in pixels
+    /// \param stride Number of bytes between two rows, 0 for size.x * 4
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Uint8* pixels, const Vector2u& size, std::size_t stride = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a view of an area of this view
+    ///
+    /// The pixels are not copied. If \a area crosses the bounds
+    /// of the view, it is adjusted to fit the view size.
+    ///
+    /// \param area Area to view, relative to the top-left corner of this view
+    ///
+    /// \return View of the area
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView getSubView(const IntRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the view
+    ///
+    /// \return Size of the viewed area, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of bytes between two rows
+    ///
+    /// \return Stride of the view, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the rows of the view follow each other in memory
+    ///
+    /// \return True if the stride is the size of a row
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isContiguous() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only pointer to the top-left pixel of the view
+    ///
+    /// The next rows start getStride() bytes apart.
+    ///
+    /// \return Read-only pointer to the pixels, NULL if the view is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixelsPtr() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of a pixel
+    ///
+    /// This function doesn't check the validity of the pixel
+    /// coordinates, using out-of-range values will result in
+    /// an undefined behavior.
+    ///
+    /// \param x X coordinate of pixel to get, relative to the view
+    /// \param y Y coordinate of pixel to get, relative to the view
+    ///
+    /// \return Color of the pixel at coordinates (x, y)
+    ///
+    ////////////////////////////////////////////////////////////
+    Color getPixel(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the viewed pixels to a file on disk
+    ///
+    /// See Image::saveToFile for the supported formats. PNG
+    /// (without spng) and JPEG (with libjpeg-turbo) files are
+    /// encoded straight from the view, other formats need the
+    /// rows of a strided view to be gathered first.
+    ///
+    /// \param filename Path of the file to save
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the viewed pixels to a file in memory
+    ///
+    /// \param output Array receiving the encoded file
+    /// \param format Format of the file, as an extension
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToMemory(std::vector<Uint8>& output, const std::string& format) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Adjust an area to the size of the view and view it
+    ///
+    /// \param area Area to view, an empty one views everything
+    ///
+    ////////////////////////////////////////////////////////////
+    void clip(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint8* m_pixels; ///< Top-left pixel of the view
+    Vector2u     m_size;   ///< Size of the viewed area
+    std::size_t  m_stride; ///< Number of bytes between two rows
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEVIEW_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageView
+/// \ingroup graphics
+///
+/// sf::ImageView refers to a rectangle of pixels owned by
+/// something else, usually an sf::Image, without copying
+/// them: a pointer to the top-left pixel, a size and the
+/// number of bytes between two rows. The viewed pixels must
+/// outlive the view.
+///
+/// Views can be uploaded to textures (strided uploads use
+/// GL_UNPACK_ROW_LENGTH), copied onto images and saved,
+/// which makes slicing a sprite sheet free of temporary
+/// images.
+///
+/// Usage example:
+/// \code
+/// sf::Image sheet;
+/// if (!sheet.loadFromFile("sheet.png"))
+///     return -1;
+///
+/// // Upload the frames of the first row of the sheet, one after the other
+/// sf::ImageView row(sheet, sf::IntRect(0, 0, 256, 64));
+/// for (int i = 0; i < 4; ++i)
+///     frames[i].loadFromImage(row.getSubView(sf::IntRect(i * 64, 0, 64, 64)));
+///
+/// // Save the second frame alone
+/// row.getSubView(sf::IntRect(64, 0, 64, 64)).saveToFile("frame.png");
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
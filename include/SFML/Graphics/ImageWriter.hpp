@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEWRITER_HPP
+#define SFML_IMAGEWRITER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/Config.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Encode and save images on the threads of a pool
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageWriter : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a requested save
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Handle;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Progress of a requested save
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Encoding, ///< The image is waiting to be encoded, or being encoded
+        Done,     ///< The image was saved
+        Failed    ///< The image couldn't be saved, or the handle is unknown
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the writer
+    ///
+    /// The pool must exist as long as the writer.
+    ///
+    /// \param pool Thread pool encoding the images
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageWriter(ThreadPool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the images being encoded, so that every
+    /// requested file is written, and discards the results
+    /// that were not taken.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageWriter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request an image saved to a file
+    ///
+    /// The pixels are taken from \a image without being copied,
+    /// \a image is left empty. This function returns
+    /// immediately, the image is encoded and written by a
+    /// thread of the pool. See Image::saveToFile for the
+    /// supported formats.
+    ///
+    /// \param image    Image to save, emptied by the call
+    /// \param filename Path of the file to save
+    ///
+    /// \return Handle identifying the requested save
+    ///
+    /// \see saveToMemory, getStatus, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle saveToFile(Image& image, const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request an image encoded to a file in memory
+    ///
+    /// The pixels are taken from \a image without being copied,
+    /// \a image is left empty. This function returns
+    /// immediately, the image is encoded by a thread of the
+    /// pool; the encoded data is then retrieved with takeData.
+    ///
+    /// \param image  Image to encode, emptied by the call
+    /// \param format Format of the file, as an extension ("png", "jpg", ...)
+    ///
+    /// \return Handle identifying the requested save
+    ///
+    /// \see saveToFile, getStatus, takeData
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle saveToMemory(Image& image, const std::string& format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress of a requested save
+    ///
+    /// This function doesn't wait for the encoding.
+    ///
+    /// \param handle Handle of the save
+    ///
+    /// \return Status of the save
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a requested save is finished
+    ///
+    /// The calling thread runs queued jobs of the pool while
+    /// it waits.
+    ///
+    /// \param handle Handle of the save
+    ///
+    /// \return Status of the save, Done or Failed
+    ///
+    ////////////////////////////////////////////////////////////
+    Status wait(Handle handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the encoded data of a save to memory
+    ///
+    /// The encoded file is swapped into \a data, and the writer
+    /// forgets the handle. Nothing happens if the save is not
+    /// done yet. Saves to files don't need to be taken, but
+    /// they can be released.
+    ///
+    /// \param handle Handle of the save
+    /// \param data   Array receiving the encoded file
+    ///
+    /// \return True if the data was taken
+    ///
+    ////////////////////////////////////////////////////////////
+    bool takeData(Handle handle, std::vector<Uint8>& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget a requested save
+    ///
+    /// A save that is still encoding completes in the pool,
+    /// its result is discarded.
+    ///
+    /// \param handle Handle of the save
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Handle handle);
+
+private:
+
+    struct Job;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the pixels of an image and queue their encoding
+    ///
+    /// \param image    Image to encode, emptied by the call
+    /// \param filename File to write, empty to keep the data in memory
+    /// \param format   Format of the file, as an extension
+    ///
+    /// \return Handle of the save
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle push(Image& image, const std::string& filename, const std::string& format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the finished jobs that were released
+    ///
+    ////////////////////////////////////////////////////////////
+    void collectReleased();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Handle, Job*> JobTable; ///< Requested saves, indexed by handle
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ThreadPool&       m_pool;       ///< Pool encoding the images
+    JobTable          m_jobs;       ///< Requested saves
+    std::vector<Job*> m_released;   ///< Released saves that were still encoding
+    Handle            m_nextHandle; ///< Handle of the next save
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEWRITER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageWriter
+/// \ingroup graphics
+///
+/// sf::ImageWriter saves images without blocking the thread
+/// that requests it: the pixels are moved out of the image
+/// (not copied) and encoded by a thread of a sf::ThreadPool,
+/// then either written to a file or kept in memory until they
+/// are taken.
+///
+/// Combined with sf::TextureReader, it takes screenshots
+/// without stalling the rendering at any point.
+///
+/// Usage example:
+/// \code
+/// sf::ThreadPool pool;
+/// sf::ImageWriter writer(pool);
+///
+/// // Save a screenshot, the frame is not delayed by the encoding
+/// sf::Image screenshot = texture.copyToImage();
+/// writer.saveToFile(screenshot, "screenshot.png");
+///
+/// // Encode a crash report to send it over the network
+/// sf::Image frame = texture.copyToImage();
+/// sf::ImageWriter::Handle report = writer.saveToMemory(frame, "jpg");
+/// ...
+/// std::vector<sf::Uint8> data;
+/// if (writer.wait(report) == sf::ImageWriter::Done)
+///     writer.takeData(report, data);
+/// \endcode
+///
+/// \see sf::Image, sf::TextureReader
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_NODE_HPP
+#define SFML_NODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Transformable object that can be part of a hierarchy
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Node : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a node without parent nor children.
+    ///
+    ////////////////////////////////////////////////////////////
+    Node();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent, and its children
+    /// become roots of their own hierarchies.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~Node();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a child at the end of the children of the node
+    ///
+    /// The child is detached from its previous parent first.
+    /// The node doesn't own its children: they must be kept
+    /// alive by the caller, and are detached when destroyed.
+    /// A node cannot be attached to itself or to one of its
+    /// descendants.
+    ///
+    /// \param child Node to attach
+    ///
+    /// \see detachChild, getParent
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachChild(Node& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a child of the node
+    ///
+    /// This function does nothing if \a child is not a child
+    /// of the node.
+    ///
+    /// \param child Node to detach
+    ///
+    /// \see attachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(Node& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Parent of the node, or NULL if it is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    Node* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the node
+    ///
+    /// \return Number of children
+    ///
+    /// \see getChild
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node
+    ///
+    /// Children are ordered by attachment, and drawn in
+    /// that order.
+    ///
+    /// \param index Index of the child, in [0, getChildCount() - 1]
+    ///
+    /// \return Reference to the child
+    ///
+    /// \see getChildCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Node& getChild(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of the node relative to the root of its hierarchy
+    ///
+    /// The world transform combines the transforms of all the
+    /// ancestors of the node with its own one. Only the nodes
+    /// whose transform (or an ancestor's one) changed since
+    /// the last call are recomputed.
+    ///
+    /// \return World transform of the node
+    ///
+    /// \see updateWorldTransforms
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bring the world transforms of the whole subtree up to date
+    ///
+    /// The subtree is walked in a flattened order (a node is
+    /// always followed by its descendants), and only the nodes
+    /// whose transform changed, or that have a changed ancestor,
+    /// are recomputed. This function is called by draw(), calling
+    /// it before gives a chance to run it at another time.
+    ///
+    /// \see setThreadPool, getWorldTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateWorldTransforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the subtrees of the children on the threads of a pool
+    ///
+    /// When a thread pool is set, updateWorldTransforms() runs
+    /// the subtrees of the children of the node in parallel,
+    /// since they don't depend on each other. The pool must
+    /// exist as long as the node uses it. Pass NULL to update
+    /// on the calling thread only, which is the default.
+    ///
+    /// \param pool Thread pool to use, or NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadPool(ThreadPool* pool);
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node itself, without its children
+    ///
+    /// Derived classes override this function to draw their
+    /// contents; \a states already contains the world transform
+    /// of the node. The default implementation draws nothing,
+    /// which is what group nodes need.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawSelf(RenderTarget& target, const RenderStates& states) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node and its descendants to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the world transform of the node if it is outdated
+    ///
+    /// The world transform of the parent must be up to date.
+    ///
+    ////////////////////////////////////////////////////////////
+    void refreshWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the world transforms of a range of the flattened order
+    ///
+    /// \param begin Index of the first node of the range
+    /// \param end   Index past the last node of the range
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateRange(std::size_t begin, std::size_t end) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the flattened order of the subtree if the hierarchy changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOrder() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the flattened orders of the node and its ancestors as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateOrder();
+
+    struct RangeUpdater;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the flattened order of a subtree
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        const Node* node; ///< Node of the entry
+        std::size_t end;  ///< Index past the last descendant of the node
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Node*                            m_parent;          ///< Parent of the node, or NULL for roots
+    std::vector<Node*>               m_children;        ///< Children of the node, in drawing order
+    ThreadPool*                      m_threadPool;      ///< Pool used to update the subtrees of the children in parallel
+    mutable Transform                m_worldTransform;  ///< Cached transform relative to the root of the hierarchy
+    mutable Uint32                   m_worldVersion;    ///< Incremented every time m_worldTransform is recomputed
+    mutable Uint32                   m_localVersion;    ///< Version of the local transform used by m_worldTransform
+    mutable Uint32                   m_parentVersion;   ///< World version of the parent used by m_worldTransform
+    mutable bool                     m_worldNeedUpdate; ///< Must m_worldTransform be recomputed regardless of the versions?
+    mutable std::vector<Entry>       m_order;           ///< Flattened order of the subtree, starting with the node itself
+    mutable std::vector<std::size_t> m_childOffsets;    ///< Indices of the children in m_order
+    mutable bool                     m_orderNeedUpdate; ///< Has the hierarchy below the node changed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_NODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Node
+/// \ingroup graphics
+///
+/// sf::Node builds scene graphs out of transformable objects:
+/// each node is positioned, rotated and scaled relative to its
+/// parent, so that moving a node moves its whole subtree.
+///
+/// The world transform of every node (relative to the root of
+/// its hierarchy) is cached. Changing the position, rotation,
+/// scale or origin of a node marks it as changed, and the next
+/// update only recomputes the changed nodes and their
+/// descendants, leaving the rest of the tree untouched.
+///
+/// Updates and drawing walk a flattened copy of the hierarchy,
+/// rebuilt only when nodes are attached or detached, instead of
+/// recursing through the children: a node comes first, followed
+/// by all its descendants, and parents are always processed
+/// before their children. The subtrees of the children of the
+/// drawn node are independent, and can be updated in parallel
+/// with setThreadPool().
+///
+/// Nodes don't own their children, and draw nothing by default.
+/// To display something, derive from sf::Node and override
+/// drawSelf(), which receives the world transform of the node
+/// in its render states.
+///
+/// Usage example:
+/// \code
+/// class SpriteNode : public sf::Node
+/// {
+/// public:
+///
+///     sf::Sprite sprite;
+///
+/// private:
+///
+///     virtual void drawSelf(sf::RenderTarget& target, const sf::RenderStates& states) const
+///     {
+///         target.draw(sprite, states);
+///     }
+/// };
+///
+/// sf::Node scene;
+/// SpriteNode ship, turret;
+/// scene.attachChild(ship);
+/// ship.attachChild(turret);
+/// turret.setPosition(10, 0);
+///
+/// // Moving the ship moves the turret too
+/// ship.move(5, 0);
+/// turret.rotate(90);
+///
+/// window.draw(scene);
+/// \endcode
+///
+/// \see sf::Transformable, sf::Drawable
+///
+////////////////////////////////////////////////////////////
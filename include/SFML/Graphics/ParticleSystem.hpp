@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of short-lived textured quads, updated
+///        and drawn in bulk
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty particle system with no capacity:
+    /// call setCapacity() before emitting particles.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of live particles
+    ///
+    /// Storage for all the particles is allocated up front,
+    /// so that emitting never allocates memory. If the new
+    /// capacity is lower than the current number of particles,
+    /// the extra particles are removed.
+    ///
+    /// \param capacity Maximum number of particles
+    ///
+    /// \see getCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCapacity(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of live particles
+    ///
+    /// \return Maximum number of particles
+    ///
+    /// \see setCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of live particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a new particle
+    ///
+    /// The particle only becomes visible after the next call
+    /// to update().
+    ///
+    /// \param position Initial position, in local coordinates
+    /// \param velocity Initial velocity, in units per second
+    /// \param color    Color of the particle
+    /// \param lifetime Duration after which the particle is removed
+    ///
+    /// \return True if the particle was added, false if the system is
+    ///         full or \a lifetime is not positive
+    ///
+    ////////////////////////////////////////////////////////////
+    bool emit(const Vector2f& position, const Vector2f& velocity, const Color& color, Time lifetime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Advance the simulation
+    ///
+    /// Moves the particles, applies the acceleration, removes
+    /// the particles that reached the end of their lifetime and
+    /// rebuilds the geometry that will be drawn.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the acceleration applied to every particle
+    ///
+    /// The default acceleration is (0, 0).
+    ///
+    /// \param acceleration New acceleration, in units per second squared
+    ///
+    /// \see getAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAcceleration(const Vector2f& acceleration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to every particle
+    ///
+    /// \return Acceleration, in units per second squared
+    ///
+    /// \see setAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getAcceleration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the quad drawn for each particle
+    ///
+    /// The quad is centered on the position of the particle.
+    /// The default size is (1, 1).
+    ///
+    /// \param size New size of the particles, in local units
+    ///
+    /// \see getParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the quad drawn for each particle
+    ///
+    /// \return Size of the particles, in local units
+    ///
+    /// \see setParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getParticleSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture of the particles
+    ///
+    /// All the particles share the same texture and texture
+    /// rectangle. If \a resetRect is true, the texture rect is
+    /// adjusted to the size of the new texture. Pass NULL to
+    /// draw untextured quads. The texture must exist as long
+    /// as the particle system uses it.
+    ///
+    /// \param texture   New texture, or NULL
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Pointer to the texture, NULL if none was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the part of the texture mapped on each particle
+    ///
+    /// \param rectangle Rectangle defining the region of the texture
+    ///
+    /// \see getTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the part of the texture mapped on each particle
+    ///
+    /// \return Texture rectangle of the particles
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable fading out of the particles
+    ///
+    /// When enabled, the alpha of each particle decreases
+    /// linearly from its initial value to 0 over its lifetime.
+    /// It is disabled by default.
+    ///
+    /// \param fading True to fade the particles out
+    ///
+    /// \see isFading
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFading(bool fading);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the particles fade out
+    ///
+    /// \return True if the particles fade out
+    ///
+    /// \see setFading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run update() on the threads of a pool
+    ///
+    /// When a thread pool is set, large particle counts are
+    /// split in blocks that are simulated and turned into
+    /// geometry in parallel. The pool must exist as long as
+    /// the particle system uses it. Pass NULL to update on
+    /// the calling thread only, which is the default.
+    ///
+    /// \param pool Thread pool to use, or NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadPool(ThreadPool* pool);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the particles whose lifetime is over
+    ///
+    /// The last particle is moved into each freed slot, so
+    /// the order of the particles is not preserved.
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeDeadParticles();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>    m_positionsX;    ///< Horizontal positions of the particles
+    std::vector<float>    m_positionsY;    ///< Vertical positions of the particles
+    std::vector<float>    m_velocitiesX;   ///< Horizontal velocities of the particles
+    std::vector<float>    m_velocitiesY;   ///< Vertical velocities of the particles
+    std::vector<float>    m_lifetimes;     ///< Remaining lifetimes of the particles, in seconds
+    std::vector<float>    m_durations;     ///< Total lifetimes of the particles, in seconds
+    std::vector<Color>    m_colors;        ///< Initial colors of the particles
+    std::size_t           m_count;         ///< Number of live particles
+    Vector2f              m_acceleration;  ///< Acceleration applied to every particle
+    Vector2f              m_particleSize;  ///< Size of the quad of a particle
+    const Texture*        m_texture;       ///< Texture of the particles
+    IntRect               m_textureRect;   ///< Part of the texture mapped on each particle
+    bool                  m_fading;        ///< Do the particles fade out over their lifetime?
+    ThreadPool*           m_threadPool;    ///< Pool used to run the updates in parallel
+    std::vector<Vertex>   m_vertices;      ///< Geometry built by the last update, 6 vertices per particle
+    std::size_t           m_vertexCount;   ///< Number of vertices built by the last update
+    mutable VertexBuffer  m_buffer;        ///< Streaming copy of the geometry on the graphics card
+    mutable bool          m_needsUpload;   ///< Has the geometry changed since it was last uploaded?
+    mutable bool          m_uploaded;      ///< Is the geometry in m_buffer usable?
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem handles effects made of many small
+/// moving quads (sparks, smoke, rain, ...) far more cheaply
+/// than a sprite per particle or a hand-written sf::VertexArray.
+///
+/// The state of the particles is stored as a structure of
+/// arrays: positions, velocities and lifetimes each live in
+/// their own contiguous array, so that update() streams
+/// through memory and advances four particles per instruction
+/// where SSE2 or NEON is available. The quads are then written
+/// in one pass and uploaded to a streaming sf::VertexBuffer
+/// the next time the system is drawn; if vertex buffers are not
+/// supported, they are drawn from memory instead. With a
+/// thread pool set (see setThreadPool()), both passes are
+/// split across its threads for large particle counts.
+///
+/// All the particles share a size, a texture rect and an
+/// acceleration. sf::ParticleSystem inherits the functions of
+/// sf::Transformable, so that the whole effect can be moved,
+/// rotated or scaled.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem sparks;
+/// sparks.setCapacity(100000);
+/// sparks.setParticleSize(sf::Vector2f(2, 2));
+/// sparks.setAcceleration(sf::Vector2f(0, 200));
+/// sparks.setFading(true);
+///
+/// // each frame
+/// for (int i = 0; i < 500; ++i)
+///     sparks.emit(origin, randomVelocity(), sf::Color::Yellow, sf::seconds(2));
+///
+/// sparks.update(clock.restart());
+/// window.draw(sparks);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::ThreadPool
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,539 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PATH_HPP
+#define SFML_PATH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Anti-aliased stroked vector path made of lines,
+///        Bezier curves and arcs
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API Path : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shapes of the corners between two segments
+    ///
+    ////////////////////////////////////////////////////////////
+    enum LineJoin
+    {
+        MiterJoin, ///< Sharp corner, replaced by a bevel beyond the miter limit
+        BevelJoin, ///< Corner cut straight
+        RoundJoin  ///< Rounded corner
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shapes of the ends of open sub-paths
+    ///
+    ////////////////////////////////////////////////////////////
+    enum LineCap
+    {
+        ButtCap,   ///< The stroke stops at the end point
+        SquareCap, ///< The stroke extends beyond the end point by half its width
+        RoundCap   ///< The stroke ends with a half disc
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty path, stroked 1 unit wide in opaque
+    /// white with miter joins, butt caps and anti-aliasing.
+    ///
+    ////////////////////////////////////////////////////////////
+    Path();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sub-paths
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new sub-path
+    ///
+    /// \param point Starting point of the sub-path
+    ///
+    ////////////////////////////////////////////////////////////
+    void moveTo(const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a straight line from the current point
+    ///
+    /// If there is no current sub-path, \a point starts a new one.
+    ///
+    /// \param point End of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    void lineTo(const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a quadratic Bezier curve from the current point
+    ///
+    /// \param control Control point of the curve
+    /// \param point   End of the curve
+    ///
+    ////////////////////////////////////////////////////////////
+    void quadraticTo(const Vector2f& control, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a cubic Bezier curve from the current point
+    ///
+    /// \param control1 First control point of the curve
+    /// \param control2 Second control point of the curve
+    /// \param point    End of the curve
+    ///
+    ////////////////////////////////////////////////////////////
+    void cubicTo(const Vector2f& control1, const Vector2f& control2, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a circular arc
+    ///
+    /// A straight line connects the current point to the start
+    /// of the arc, if there is a current sub-path. Angles are
+    /// in degrees, clockwise on screen like sf::Transformable
+    /// rotations; the arc goes from \a startAngle to \a endAngle
+    /// in the direction of their difference.
+    ///
+    /// \param center     Center of the circle
+    /// \param radius     Radius of the circle
+    /// \param startAngle Angle of the start of the arc, in degrees
+    /// \param endAngle   Angle of the end of the arc, in degrees
+    ///
+    ////////////////////////////////////////////////////////////
+    void arc(const Vector2f& center, float radius, float startAngle, float endAngle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the current sub-path
+    ///
+    /// A straight line connects the current point to the start
+    /// of the sub-path, and the two ends are joined instead of
+    /// being capped. The next segment starts a new sub-path.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the width of the stroke
+    ///
+    /// \param width New width of the stroke, in local units
+    ///
+    /// \see getStrokeWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStrokeWidth(float width);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the width of the stroke
+    ///
+    /// \return Width of the stroke, in local units
+    ///
+    /// \see setStrokeWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    float getStrokeWidth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the color of the stroke
+    ///
+    /// \param color New color of the stroke
+    ///
+    /// \see getStrokeColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStrokeColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of the stroke
+    ///
+    /// \return Color of the stroke
+    ///
+    /// \see setStrokeColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getStrokeColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shape of the corners between segments
+    ///
+    /// \param join New line join
+    ///
+    /// \see getLineJoin, setMiterLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLineJoin(LineJoin join);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shape of the corners between segments
+    ///
+    /// \return Current line join
+    ///
+    /// \see setLineJoin
+    ///
+    ////////////////////////////////////////////////////////////
+    LineJoin getLineJoin() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the shape of the ends of open sub-paths
+    ///
+    /// \param cap New line cap
+    ///
+    /// \see getLineCap
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLineCap(LineCap cap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shape of the ends of open sub-paths
+    ///
+    /// \return Current line cap
+    ///
+    /// \see setLineCap
+    ///
+    ////////////////////////////////////////////////////////////
+    LineCap getLineCap() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the miter limit
+    ///
+    /// Miter joins longer than \a limit times half the stroke
+    /// width are drawn as bevel joins, so that sharp angles
+    /// don't produce long spikes. The default limit is 4.
+    ///
+    /// \param limit New miter limit
+    ///
+    /// \see getMiterLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMiterLimit(float limit);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the miter limit
+    ///
+    /// \return Current miter limit
+    ///
+    /// \see setMiterLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMiterLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable anti-aliasing of the edges
+    ///
+    /// When enabled, the stroke is surrounded by a one pixel
+    /// wide fringe whose opacity fades out, which smooths the
+    /// edges without multisampling. It is enabled by default.
+    ///
+    /// \param antialiasing True to enable anti-aliasing
+    ///
+    /// \see isAntialiasingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAntialiasingEnabled(bool antialiasing);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether anti-aliasing of the edges is enabled
+    ///
+    /// \return True if anti-aliasing is enabled
+    ///
+    /// \see setAntialiasingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAntialiasingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the flattening tolerance of curves
+    ///
+    /// Curves, arcs and round joins are approximated by straight
+    /// segments which deviate from the exact shape by at most
+    /// \a tolerance pixels. The default tolerance is 0.25.
+    ///
+    /// \param tolerance New tolerance, in pixels
+    ///
+    /// \see getTolerance
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTolerance(float tolerance);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the flattening tolerance of curves
+    ///
+    /// \return Current tolerance, in pixels
+    ///
+    /// \see setTolerance
+    ///
+    ////////////////////////////////////////////////////////////
+    float getTolerance() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the path
+    ///
+    /// The returned rectangle is in local coordinates and
+    /// includes the width of the stroke.
+    ///
+    /// \return Local bounding rectangle of the path
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the path
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the path
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of path elements
+    ///
+    ////////////////////////////////////////////////////////////
+    enum CommandType
+    {
+        MoveTo,
+        LineTo,
+        QuadraticTo,
+        CubicTo,
+        Arc,
+        Close
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Element of the path, as given by the user
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        CommandType type;      ///< Type of the element
+        Vector2f    points[3]; ///< Points of the element (control points, end point, or center for arcs)
+        float       values[3]; ///< Radius, start and end angles of arcs
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the path to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the path, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the path
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an element to the path
+    ///
+    /// \param command Element to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void addCommand(const Command& command);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cross-section of a stroke
+    ///
+    /// Each edge of the stroke has an inner point, where the
+    /// color is opaque, and an outer point, where the fringe
+    /// fades to transparent (both are equal without the fringe).
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Section
+    {
+        Vector2f outerLeft;  ///< Outer point of the left edge
+        Vector2f innerLeft;  ///< Inner point of the left edge
+        Vector2f innerRight; ///< Inner point of the right edge
+        Vector2f outerRight; ///< Outer point of the right edge
+        bool     edge;       ///< Is the whole cross-section transparent (end of a butt or square cap)?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tessellate the stroke if it is outdated
+    ///
+    /// \param pixelSize Size of a pixel of the target, in local units
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate(float pixelSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stroke a flattened sub-path
+    ///
+    /// \param points    Points of the sub-path, duplicates removed
+    /// \param closed    Is the sub-path closed?
+    /// \param pixelSize Size of a pixel of the target, in local units
+    ///
+    ////////////////////////////////////////////////////////////
+    void strokePolyline(const std::vector<Vector2f>& points, bool closed, float pixelSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the cross-sections of a cap
+    ///
+    /// The end point itself is covered by the cap.
+    ///
+    /// \param point     End point of the sub-path
+    /// \param direction Unit direction of the segment at this end, in the order of the path
+    /// \param halfWidth Half the width of the stroke
+    /// \param tolerance Flattening tolerance, in local units
+    /// \param start     Is it the first point of the sub-path, or the last one?
+    ///
+    ////////////////////////////////////////////////////////////
+    void addCap(const Vector2f& point, const Vector2f& direction, float halfWidth, float tolerance, bool start) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the cross-sections of a join
+    ///
+    /// \param point     Point joining the two segments
+    /// \param incoming  Segment ending at \a point
+    /// \param outgoing  Segment starting at \a point
+    /// \param halfWidth Half the width of the stroke
+    /// \param tolerance Flattening tolerance, in local units
+    ///
+    ////////////////////////////////////////////////////////////
+    void addJoin(const Vector2f& point, const Vector2f& incoming, const Vector2f& outgoing, float halfWidth, float tolerance) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a cross-section of the stroke
+    ///
+    /// \param center    Point on the center line of the stroke
+    /// \param left      Offset of the left edge at half the width, usually a unit vector
+    /// \param right     Offset of the right edge at half the width, usually a unit vector
+    /// \param halfWidth Half the width of the stroke
+    /// \param edge      Is the cross-section the outer side of the fringe of an end?
+    ///
+    ////////////////////////////////////////////////////////////
+    void addSection(const Vector2f& center, const Vector2f& left, const Vector2f& right, float halfWidth, bool edge) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the strip joining the cross-sections of a sub-path
+    ///
+    /// \param closed Must the last cross-section be joined to the first one?
+    /// \param color  Color of the stroke
+    ///
+    ////////////////////////////////////////////////////////////
+    void addStrip(bool closed, const Color& color) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Command>          m_commands;     ///< Elements of the path
+    float                         m_strokeWidth;  ///< Width of the stroke
+    Color                         m_strokeColor;  ///< Color of the stroke
+    LineJoin                      m_lineJoin;     ///< Shape of the corners
+    LineCap                       m_lineCap;      ///< Shape of the ends
+    float                         m_miterLimit;   ///< Maximum length of miter joins, relative to half the width
+    bool                          m_antialiasing; ///< Is the anti-aliasing fringe generated?
+    float                         m_tolerance;    ///< Flattening tolerance, in pixels
+    mutable VertexArray           m_vertices;     ///< Tessellated stroke
+    mutable FloatRect             m_bounds;       ///< Bounding rectangle of the stroke
+    mutable float                 m_pixelSize;    ///< Pixel size the stroke was tessellated for
+    mutable float                 m_fringe;       ///< Width of the anti-aliasing fringe, in local units
+    mutable bool                  m_needsUpdate;  ///< Must the stroke be tessellated again?
+    mutable std::vector<Section>  m_sections;     ///< Cross-sections of the sub-path being stroked
+};
+
+} // namespace sf
+
+
+#endif // SFML_PATH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Path
+/// \ingroup graphics
+///
+/// sf::Path strokes vector paths: sequences of lines,
+/// quadratic and cubic Bezier curves and circular arcs,
+/// with configurable joins and caps. It is meant for charts,
+/// map overlays, GUI decorations and anything else that
+/// needs thick smooth lines.
+///
+/// The path is tessellated once into a single array of
+/// triangles, and only tessellated again when it changes or
+/// when it is drawn at a very different scale. Curves are
+/// flattened adaptively for the current scale, so they stay
+/// smooth when zoomed in without wasting triangles when
+/// zoomed out. Edges are anti-aliased with a thin fringe of
+/// vertices whose alpha fades to zero over one pixel, which
+/// gives smooth lines on any render target without enabling
+/// multisampling, and works on every OpenGL version since no
+/// shader is involved.
+///
+/// Each sub-path is tessellated as a single strip following
+/// both edges of the stroke, joins and caps included, and
+/// only its outer boundary is faded. Translucent strokes
+/// therefore have a uniform color, except where a stroke
+/// wider than a tight curve folds onto itself. To draw such
+/// a path translucent, draw it opaque to an sf::RenderTexture
+/// and draw that texture translucent.
+///
+/// Like other drawables, a path inherits the functions of
+/// sf::Transformable (position, rotation, scale, ...).
+///
+/// Usage example:
+/// \code
+/// sf::Path path;
+/// path.moveTo(sf::Vector2f(10, 10));
+/// path.lineTo(sf::Vector2f(200, 10));
+/// path.cubicTo(sf::Vector2f(300, 10), sf::Vector2f(300, 200), sf::Vector2f(200, 200));
+/// path.arc(sf::Vector2f(150, 200), 50, 0, 180);
+/// path.close();
+///
+/// path.setStrokeWidth(4);
+/// path.setStrokeColor(sf::Color::Red);
+/// path.setLineJoin(sf::Path::RoundJoin);
+///
+/// window.draw(path);
+/// \endcode
+///
+/// \see sf::PolygonShape, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
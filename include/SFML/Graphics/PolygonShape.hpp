@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_POLYGONSHAPE_HPP
+#define SFML_POLYGONSHAPE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Shape representing a simple polygon, convex or concave
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PolygonShape : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param pointCount Number of points of the polygon
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PolygonShape(std::size_t pointCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of points of the polygon
+    ///
+    /// \a count must be greater than 2 to define a valid shape.
+    ///
+    /// \param count New number of points of the polygon
+    ///
+    /// \see getPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPointCount(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of the polygon
+    ///
+    /// \return Number of points of the polygon
+    ///
+    /// \see setPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPointCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of a point
+    ///
+    /// The points must be given in order along the contour, in
+    /// either direction, and the contour must not cross itself.
+    /// setPointCount must be called first in order to set the total
+    /// number of points. The result is undefined if \a index is out
+    /// of the valid range.
+    ///
+    /// \param index Index of the point to change, in range [0 .. getPointCount() - 1]
+    /// \param point New position of the point
+    ///
+    /// \see getPoint, setPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoint(std::size_t index, const Vector2f& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace all the points of the polygon
+    ///
+    /// This is equivalent to calling setPointCount and then
+    /// setPoint for every point.
+    ///
+    /// \param points Pointer to the points of the contour
+    /// \param count  Number of points in the array
+    ///
+    /// \see setPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoints(const Vector2f* points, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a point
+    ///
+    /// The returned point is in local coordinates, that is,
+    /// the shape's transforms (position, rotation, scale) are
+    /// not taken into account.
+    /// The result is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
+    ///
+    /// \return Position of the index-th point of the polygon
+    ///
+    /// \see setPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getPoint(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the polygon
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the polygon uses it. Indeed, the polygon
+    /// doesn't store its own copy of the texture, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    /// \a texture can be NULL to disable texturing.
+    /// If \a resetRect is true, the TextureRect property of
+    /// the polygon is automatically adjusted to the size of the new
+    /// texture. If it is false, the texture rect is left unchanged.
+    ///
+    /// \param texture   New texture
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that the polygon will display
+    ///
+    /// The texture rect is stretched over the bounding rectangle
+    /// of the polygon.
+    ///
+    /// \param rect Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of the polygon
+    ///
+    /// By default, the polygon's fill color is opaque white.
+    ///
+    /// \param color New color of the polygon
+    ///
+    /// \see getFillColor, setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the outline color of the polygon
+    ///
+    /// By default, the polygon's outline color is opaque white.
+    ///
+    /// \param color New outline color of the polygon
+    ///
+    /// \see getOutlineColor, setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the polygon's outline
+    ///
+    /// Like with sf::Shape, negative values make the outline
+    /// expand towards the inside of the polygon, and zero
+    /// disables the outline.
+    /// By default, the outline thickness is 0.
+    ///
+    /// \param thickness New outline thickness
+    ///
+    /// \see getOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineThickness(float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the polygon
+    ///
+    /// \return Pointer to the polygon's texture, NULL if none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by the polygon
+    ///
+    /// \return Texture rectangle of the polygon
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of the polygon
+    ///
+    /// \return Fill color of the polygon
+    ///
+    /// \see setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline color of the polygon
+    ///
+    /// \return Outline color of the polygon
+    ///
+    /// \see setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getOutlineColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline thickness of the polygon
+    ///
+    /// \return Outline thickness of the polygon
+    ///
+    /// \see setOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getOutlineThickness() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the triangles of the tessellated polygon
+    ///
+    /// Each group of 3 consecutive values holds the indices of
+    /// the points forming a triangle. The triangulation is
+    /// recomputed only after the points have changed.
+    ///
+    /// \return Indices of the points of the triangles
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Uint32>& getTriangles() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the polygon
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity. The outline is
+    /// included.
+    ///
+    /// \return Local bounding rectangle of the polygon
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global (non-minimal) bounding rectangle of the polygon
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the polygon
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the polygon to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the polygon, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the polygon
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the outdated parts of the geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Split the polygon into triangles with ear clipping
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTriangles() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the fill vertices from the triangles
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateFill() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the outline vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutline() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f>       m_points;              ///< Points composing the contour of the polygon
+    const Texture*              m_texture;             ///< Texture of the polygon
+    IntRect                     m_textureRect;         ///< Rectangle defining the area of the source texture to display
+    Color                       m_fillColor;           ///< Fill color
+    Color                       m_outlineColor;        ///< Outline color
+    float                       m_outlineThickness;    ///< Thickness of the polygon's outline
+    mutable std::vector<Uint32> m_triangles;           ///< Cached triangulation, 3 point indices per triangle
+    mutable VertexArray         m_vertices;            ///< Vertex array containing the fill geometry
+    mutable VertexArray         m_outlineVertices;     ///< Vertex array containing the outline geometry
+    mutable FloatRect           m_insideBounds;        ///< Bounding rectangle of the inside (fill)
+    mutable FloatRect           m_bounds;              ///< Bounding rectangle of the whole polygon (outline + fill)
+    mutable bool                m_trianglesNeedUpdate; ///< Must the polygon be triangulated again?
+    mutable bool                m_fillNeedsUpdate;     ///< Must the fill vertices be rebuilt?
+    mutable bool                m_outlineNeedsUpdate;  ///< Must the outline vertices be rebuilt?
+};
+
+} // namespace sf
+
+
+#endif // SFML_POLYGONSHAPE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PolygonShape
+/// \ingroup graphics
+///
+/// sf::PolygonShape draws any simple polygon, convex or not,
+/// which sf::ConvexShape cannot do since it renders its points
+/// as a triangle fan. The contour is split into triangles with
+/// ear clipping; the triangulation is cached and only computed
+/// again after the points have changed, so changing colors,
+/// texture or the transform of the polygon costs nothing
+/// extra. The outline is cached the same way.
+///
+/// The points must be defined in order along the contour,
+/// clockwise or counter-clockwise, and the contour must not
+/// intersect itself. Holes can be made by connecting them
+/// to the outer contour with a zero-width bridge.
+///
+/// Like sf::Shape, the polygon inherits the functions of
+/// sf::Transformable (position, rotation, scale, ...).
+///
+/// Usage example:
+/// \code
+/// sf::PolygonShape polygon;
+/// polygon.setPointCount(5);
+/// polygon.setPoint(0, sf::Vector2f(0, 0));
+/// polygon.setPoint(1, sf::Vector2f(100, 0));
+/// polygon.setPoint(2, sf::Vector2f(50, 40));
+/// polygon.setPoint(3, sf::Vector2f(100, 100));
+/// polygon.setPoint(4, sf::Vector2f(0, 100));
+/// polygon.setFillColor(sf::Color::Green);
+/// polygon.setOutlineThickness(2);
+/// polygon.setOutlineColor(sf::Color::Black);
+/// polygon.setPosition(10, 20);
+/// ...
+/// window.draw(polygon);
+/// \endcode
+///
+/// \see sf::ConvexShape, sf::Shape, sf::Transformable
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,301 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_POSTPROCESSCHAIN_HPP
+#define SFML_POSTPROCESSCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class RenderTexture;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Sequence of full-screen shader passes applied
+///        to a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcessChain : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty chain, which allocates its intermediate
+    /// render-textures from its own pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a chain sharing a pool of render-textures
+    ///
+    /// Chains which are applied one after the other can share
+    /// the same pool, so that they reuse the same intermediate
+    /// render-textures. The pool must exist as long as the
+    /// chain uses it.
+    ///
+    /// \param pool Pool to allocate the intermediate render-textures from
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PostProcessChain(RenderTexturePool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a pass to the chain
+    ///
+    /// The pass draws its input texture, which is the output of
+    /// the previous pass or the source for the first one, with
+    /// \a shader over the whole output. The shader finds the input
+    /// like with any other drawable, for example through a uniform
+    /// set to sf::Shader::CurrentTexture.
+    ///
+    /// \a scale sets the resolution of the output relative to the
+    /// source: passes such as blurs or bloom thresholds can run at
+    /// half or quarter resolution, which divides their cost by 4
+    /// or 16. The shader must exist as long as the chain uses it.
+    ///
+    /// \param shader Shader applied by the pass
+    /// \param scale  Size of the output relative to the size of the source
+    ///
+    /// \return Index of the new pass
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addPass(const Shader& shader, float scale = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the passes
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of passes
+    ///
+    /// \return Number of passes, enabled or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPassCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable a pass
+    ///
+    /// Disabled passes are skipped without any copy.
+    ///
+    /// \param index   Index of the pass
+    /// \param enabled True to enable the pass, false to disable it
+    ///
+    /// \see isPassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPassEnabled(std::size_t index, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a pass is enabled
+    ///
+    /// \param index Index of the pass
+    ///
+    /// \return True if the pass is enabled
+    ///
+    /// \see setPassEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPassEnabled(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the resolution of the output of a pass
+    ///
+    /// \param index Index of the pass
+    /// \param scale Size of the output relative to the size of the source
+    ///
+    /// \see getPassScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPassScale(std::size_t index, float scale);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the resolution of the output of a pass
+    ///
+    /// \param index Index of the pass
+    ///
+    /// \return Size of the output relative to the size of the source
+    ///
+    /// \see setPassScale
+    ///
+    ////////////////////////////////////////////////////////////
+    float getPassScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the chain and keep the result in a texture
+    ///
+    /// The returned texture belongs to the chain and stays valid
+    /// until the next call to apply(). If no pass is enabled,
+    /// \a source itself is returned.
+    ///
+    /// \param source Texture to process
+    ///
+    /// \return Texture containing the output of the last pass
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& apply(const Texture& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the chain and draw the result to a render target
+    ///
+    /// The last pass renders directly into \a target instead of
+    /// an intermediate render-texture, as a quad of the size of
+    /// the source positioned by \a states.transform, and blended
+    /// with \a states.blendMode. The shader and texture of
+    /// \a states are ignored.
+    ///
+    /// \param source Texture to process
+    /// \param target Render target to draw the result to
+    /// \param states Render states used to draw the result
+    ///
+    ////////////////////////////////////////////////////////////
+    void apply(const Texture& source, RenderTarget& target, const RenderStates& states = RenderStates::Default);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Shader pass of the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pass
+    {
+        const Shader* shader;  ///< Shader applied by the pass
+        float         scale;   ///< Size of the output relative to the source
+        bool          enabled; ///< Is the pass run?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run all the enabled passes but the last one
+    ///
+    /// The render-texture holding the returned texture is
+    /// acquired from the pool and must be released by the caller.
+    ///
+    /// \param source Texture to process
+    /// \param last   Receives the index of the last enabled pass, or the pass count if there is none
+    /// \param held   Receives the render-texture holding the returned texture, NULL if it is \a source
+    ///
+    /// \return Texture containing the input of the last pass, NULL if a render-texture couldn't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* runPasses(const Texture& source, std::size_t& last, RenderTexture*& held);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a texture through a pass into a target
+    ///
+    /// \param pass   Pass to run
+    /// \param input  Texture to draw
+    /// \param target Render target to draw to
+    /// \param size   Size of the quad to draw
+    /// \param states Render states to draw with
+    ///
+    ////////////////////////////////////////////////////////////
+    static void drawPass(const Pass& pass, const Texture& input, RenderTarget& target, const Vector2f& size, RenderStates states);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Pass>  m_passes;   ///< Passes of the chain
+    RenderTexturePool  m_ownPool;  ///< Pool used when none is shared
+    RenderTexturePool* m_pool;     ///< Pool the intermediate render-textures are allocated from
+    RenderTexture*     m_result;   ///< Render-texture holding the last result of apply(), kept until the next call
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESSCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcessChain
+/// \ingroup graphics
+///
+/// Post-processing effects (blur, bloom, color grading,
+/// distortions...) are made of several full-screen shader
+/// passes, each one reading the result of the previous one.
+/// sf::PostProcessChain runs such sequences without the
+/// bookkeeping and the extra copies usually involved:
+///
+/// \li the intermediate render-textures come from a
+///     sf::RenderTexturePool, so they are created once and
+///     then ping-ponged between the passes, and shared
+///     between passes of the same resolution
+/// \li the first pass reads the source texture directly, and
+///     the last one can render straight into the final target
+/// \li each pass can run at a fraction of the resolution
+///     of the source, with bilinear filtering between passes;
+///     blur and bloom passes rarely need the full resolution
+/// \li disabled passes are skipped without any copy
+///
+/// Usage example:
+/// \code
+/// // A bloom: threshold and blur at a quarter of the resolution, then combine
+/// threshold.setUniform("texture", sf::Shader::CurrentTexture);
+/// blurX.setUniform("texture", sf::Shader::CurrentTexture);
+/// blurY.setUniform("texture", sf::Shader::CurrentTexture);
+/// combine.setUniform("texture", sf::Shader::CurrentTexture);
+/// combine.setUniform("scene", scene.getTexture());
+///
+/// sf::PostProcessChain bloom;
+/// bloom.addPass(threshold, 0.5f);
+/// bloom.addPass(blurX, 0.25f);
+/// bloom.addPass(blurY, 0.25f);
+/// bloom.addPass(combine);
+///
+/// // Each frame...
+/// scene.clear();
+/// scene.draw(world);
+/// scene.display();
+///
+/// window.clear();
+/// bloom.apply(scene.getTexture(), window);
+/// window.display();
+/// \endcode
+///
+/// \see sf::Shader, sf::RenderTexturePool
+///
+////////////////////////////////////////////////////////////
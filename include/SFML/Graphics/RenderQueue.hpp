@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERQUEUE_HPP
+#define SFML_RENDERQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Config.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class IndexBuffer;
+class RenderTarget;
+class VertexBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Record draw calls and submit them sorted by render states
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderQueue : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the primitives of a drawable object
+    ///
+    /// The object is drawn into the queue instead of a render
+    /// target, the primitives it issues are recorded with the
+    /// render states it uses. No OpenGL call is made.
+    ///
+    /// \param drawable Object to record
+    /// \param states   Render states to use for drawing
+    /// \param layer    Layer of the primitives, lower layers are drawn first
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, const RenderStates& states = RenderStates::Default, int layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied into the queue.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param layer       Layer of the primitives, lower layers are drawn first
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+             const RenderStates& states = RenderStates::Default, int layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append the draw calls recorded by another queue
+    ///
+    /// The appended draw calls are considered recorded after
+    /// the ones already in this queue, in the same order as
+    /// in \a queue. This is typically used to gather queues
+    /// recorded by several threads in a deterministic order.
+    ///
+    /// \param queue Queue to append
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const RenderQueue& queue);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded primitives
+    ///
+    /// The memory used by the queue is kept for the next frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of recorded draw calls
+    ///
+    /// \return Number of draw calls that will be submitted
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the sorting of the draw calls by render states
+    ///
+    /// When sorting is disabled, the draw calls of each layer
+    /// are submitted in the order they were recorded, like a
+    /// command list. Sorting is enabled by default.
+    ///
+    /// \param enabled True to enable sorting, false to disable it
+    ///
+    /// \see isSortingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSortingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the draw calls are sorted by render states
+    ///
+    /// \return True if sorting is enabled, false otherwise
+    ///
+    /// \see setSortingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSortingEnabled() const;
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw call
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        int                 layer;        ///< Layer of the primitives
+        Uint32              shaderId;     ///< Identifier of the shader, in order of first use
+        Uint32              textureId;    ///< Identifier of the texture, in order of first use
+        Uint32              blendModeId;  ///< Identifier of the blend mode, in order of first use
+        std::size_t         sequence;     ///< Index of the command in recording order
+        RenderStates        states;       ///< Render states of the primitives
+        const VertexBuffer* vertexBuffer; ///< Vertex buffer holding the vertices, NULL if they are in the queue
+        const IndexBuffer*  indexBuffer;  ///< Index buffer selecting the vertices of vertexBuffer, NULL if not indexed
+        std::size_t         firstVertex;  ///< Index of the first vertex, or of the first index
+        std::size_t         vertexCount;  ///< Number of vertices, or of indices
+        PrimitiveType       type;         ///< Type of the primitives
+
+        bool operator <(const Command& right) const;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives issued to a render target
+    ///
+    /// \param layer        Layer of the primitives
+    /// \param vertexBuffer Vertex buffer holding the vertices, NULL to copy \a vertices
+    /// \param indexBuffer  Index buffer selecting the vertices of \a vertexBuffer, can be NULL
+    /// \param vertices     Pointer to the vertices, if \a vertexBuffer is NULL
+    /// \param firstVertex  Index of the first vertex (or index) in \a vertexBuffer (or \a indexBuffer)
+    /// \param vertexCount  Number of vertices (or indices)
+    /// \param type         Type of primitives to draw
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(int layer, const VertexBuffer* vertexBuffer, const IndexBuffer* indexBuffer, const Vertex* vertices,
+                std::size_t firstVertex, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identify the render states of a command and add it to the queue
+    ///
+    /// The mutex must be locked.
+    ///
+    /// \param command Command to add, its layer, states and vertex range must be set
+    ///
+    ////////////////////////////////////////////////////////////
+    void addCommand(Command command);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of a blend mode, in order of first use
+    ///
+    /// \param blendMode Blend mode
+    ///
+    /// \return Identifier of the blend mode
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getBlendModeId(const BlendMode& blendMode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the recorded primitives to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states, their transform is
+    ///               combined with the recorded ones
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Command>             m_commands;       ///< Recorded draw calls
+    std::vector<Vertex>              m_vertices;       ///< Vertices of the recorded draw calls
+    std::map<const Shader*, Uint32>  m_shaderIds;      ///< Identifiers of the recorded shaders
+    std::map<const void*, Uint32>    m_textureIds;     ///< Identifiers of the recorded textures and texture arrays
+    std::vector<BlendMode>           m_blendModes;     ///< Recorded blend modes, indexed by identifier
+    bool                             m_sortingEnabled; ///< Are the draw calls sorted by render states?
+    mutable std::vector<std::size_t> m_sorted;         ///< Indices of the recorded draw calls in submission order
+    mutable bool                     m_sortNeeded;     ///< Must m_sorted be updated?
+    mutable Mutex                    m_mutex;          ///< Mutex protecting the recorded data
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderQueue
+/// \ingroup graphics
+///
+/// When a scene is drawn in the order dictated by the game
+/// logic, consecutive draw calls often alternate between
+/// different textures, shaders or blend modes, and every
+/// such change is expensive. sf::RenderQueue records the
+/// draw calls instead, and submits them grouped by shader,
+/// texture and blend mode when it is drawn to a render target.
+///
+/// Draw calls are only reordered within a layer: all the
+/// primitives of a layer are drawn before the primitives of
+/// the next layer, and the draw calls that share the same
+/// render states keep their recording order. Put overlapping
+/// objects whose stacking order matters in different layers.
+///
+/// Recording doesn't make any OpenGL call, so draw calls can
+/// be recorded by any thread without an active context, and
+/// several threads can record into the same queue at the same
+/// time. To get a deterministic order, let every thread record
+/// its own queue and append() them on the rendering thread.
+/// With sorting disabled, a queue can also be used as a plain
+/// command list that is replayed in recording order.
+///
+/// The textures, shaders and vertex buffers used by the
+/// recorded primitives must stay alive until the queue is
+/// drawn or cleared. Drawables that update their own
+/// resources when drawn, such as sf::Text loading glyphs into
+/// the texture of its font, still perform these updates
+/// while being recorded.
+/// Sorting is most effective when the render target has
+/// batching enabled, so that the consecutive draw calls that
+/// end up sharing the same states are merged together.
+///
+/// Example:
+/// \code
+/// sf::RenderQueue queue;
+/// window.setBatchingEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     queue.clear();
+///
+///     queue.add(background, sf::RenderStates::Default, 0);
+///     for (std::size_t i = 0; i < entities.size(); ++i)
+///         queue.add(entities[i], sf::RenderStates::Default, 1);
+///     queue.add(hud, sf::RenderStates::Default, 2);
+///
+///     window.clear();
+///     window.draw(queue);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
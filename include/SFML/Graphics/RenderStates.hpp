@@ -37,6 +37,7 @@ namespace sf
 {
 class Shader;
 class Texture;
+class TextureArray;
 
 ////////////////////////////////////////////////////////////
 /// \brief Define the states used for drawing to a RenderTarget
@@ -55,6 +56,7 @@ public:
     /// \li the BlendAlpha blend mode
     /// \li the identity transform
     /// \li a null texture
+    /// \li a null texture array
     /// \li a null shader
     ///
     ////////////////////////////////////////////////////////////
@@ -84,6 +86,14 @@ public:
     ////////////////////////////////////////////////////////////
     RenderStates(const Texture* theTexture);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a default set of render states with a custom texture array
+    ///
+    /// \param theTextureArray Texture array to use
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const TextureArray* theTextureArray);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a default set of render states with a custom shader
     ///
@@ -112,10 +122,11 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; ///< Blending mode
-    Transform      transform; ///< Transform
-    const Texture* texture;   ///< Texture
-    const Shader*  shader;    ///< Shader
+    BlendMode           blendMode;    ///< Blending mode
+    Transform           transform;    ///< Transform
+    const Texture*      texture;      ///< Texture
+    const TextureArray* textureArray; ///< Texture array, sampled instead of the texture when set
+    const Shader*       shader;       ///< Shader
 };
 
 } // namespace sf
@@ -133,6 +144,7 @@ public:
 /// \li the blend mode: how pixels of the object are blended with the background
 /// \li the transform: how the object is positioned/rotated/scaled
 /// \li the texture: what image is mapped to the object
+///     (or a texture array, whose layer is chosen per vertex)
 /// \li the shader: what custom effect is applied to the object
 ///
 /// High-level objects such as sprites or text force some of
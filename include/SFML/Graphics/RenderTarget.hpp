@@ -38,13 +38,22 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class IndexBuffer;
+class RenderQueue;
 class VertexBuffer;
 
+namespace priv
+{
+    class RenderDevice;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
 ///
@@ -53,6 +62,30 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering work submitted during a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are initialized to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Uint64 drawCalls;        ///< Number of OpenGL draw calls
+        Uint64 vertices;         ///< Number of vertices submitted, instanced vertices are counted once per instance
+        Uint64 textureBinds;     ///< Number of times a texture was bound
+        Uint64 shaderBinds;      ///< Number of times a shader or an internal program was bound
+        Uint64 blendModeChanges; ///< Number of times the blend mode was applied
+        Uint64 bufferUploads;    ///< Number of times vertex or instance data was copied into a buffer object
+        Uint64 culledDrawables;  ///< Number of drawables skipped because they were outside of the view
+        Time   gpuTime;          ///< Time spent by the GPU on the latest measured frame, zero if unknown
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -268,6 +301,301 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer and an index buffer
+    ///
+    /// The primitives are built from the vertices of
+    /// \a vertexBuffer referenced by the indices of
+    /// \a indexBuffer, in order.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer and a range of an index buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer
+    /// \param firstIndex   Position of the first index to use
+    /// \param indexCount   Number of indices to use
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex,
+              std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several instances of a drawable object
+    ///
+    /// The result is the same as drawing the object once per
+    /// instance, with the transform of the instance combined
+    /// with \a states.transform and the color of the instance
+    /// modulating the color of the vertices.
+    ///
+    /// On contexts that use the programmable pipeline and
+    /// support instanced arrays, the per-instance data is
+    /// uploaded to a buffer and every primitive issued by the
+    /// object is drawn for all the instances in a single call.
+    /// Otherwise, the instances are transformed on the CPU and
+    /// submitted together. The instance colors are ignored
+    /// in this case when the object is a vertex buffer.
+    ///
+    /// \param drawable      Object to draw
+    /// \param transforms    Pointer to the transform of each instance
+    /// \param colors        Pointer to the color of each instance, can be NULL
+    /// \param instanceCount Number of instances to draw
+    /// \param states        Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const Drawable& drawable, const Transform* transforms, const Color* colors,
+                       std::size_t instanceCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several instances of a vertex buffer
+    ///
+    /// \param vertexBuffer  Vertex buffer
+    /// \param transforms    Pointer to the transform of each instance
+    /// \param colors        Pointer to the color of each instance, can be NULL
+    /// \param instanceCount Number of instances to draw
+    /// \param states        Render states to use for drawing
+    ///
+    /// \see drawInstanced(const Drawable&, const Transform*, const Color*, std::size_t, const RenderStates&)
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstanced(const VertexBuffer& vertexBuffer, const Transform* transforms, const Color* colors,
+                       std::size_t instanceCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive calls to draw()
+    /// that use the same texture and blend mode (and no shader)
+    /// are not sent to the graphics card immediately. Their
+    /// vertices are transformed on the CPU and accumulated
+    /// until the render states change, and are then submitted
+    /// all at once in a single draw call. This greatly reduces
+    /// the overhead of drawing many small objects such as
+    /// sprites or shapes.
+    ///
+    /// Pending geometry is automatically flushed when the view
+    /// changes, when the target is cleared, when a vertex buffer
+    /// is drawn, when OpenGL states are saved, restored or reset
+    /// and when display() is called on the target.
+    ///
+    /// Since the submission is deferred, the textures used by
+    /// the batched geometry must stay alive and unmodified until
+    /// the batch is flushed. Call flush() explicitly before
+    /// updating or destroying such a texture, or before issuing
+    /// your own OpenGL calls.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching of draw calls is enabled
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit all the geometry pending in the current batch
+    ///
+    /// This function does nothing if batching is disabled or
+    /// if there is nothing to submit.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the culling of drawables outside of the view
+    ///
+    /// When culling is enabled, draw(const Drawable&, const RenderStates&)
+    /// first asks the drawable for its bounds (see
+    /// Drawable::getCullingBounds), transforms them with the
+    /// render states and skips the drawable entirely if they
+    /// don't overlap the area of the world covered by the
+    /// current view. Sprites, shapes, texts and vertex arrays
+    /// provide their bounds; other drawables are always drawn.
+    ///
+    /// This avoids transforming and submitting the geometry of
+    /// large worlds (tile maps split in many sprites or vertex
+    /// array chunks) when only a small part of them is visible.
+    /// Don't enable it if a shader moves vertices outside of the
+    /// bounds of the objects, and see sf::VertexArray::invalidateBounds
+    /// for vertex arrays modified through kept pointers.
+    ///
+    /// Culling is disabled by default.
+    ///
+    /// \param enabled True to enable culling, false to disable it
+    ///
+    /// \see isCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCullingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the drawables outside of the view are culled
+    ///
+    /// \return True if culling is enabled, false otherwise
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCullingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict drawing to a rectangle of the target
+    ///
+    /// When a scissor rectangle is set, clear() and all the
+    /// draw calls only modify the pixels inside of it: the
+    /// rest of the target keeps its contents. This is how a
+    /// frame is partially redrawn, see RenderWindow::getRepaintArea.
+    /// An empty rectangle, which is the default, removes the
+    /// restriction.
+    ///
+    /// \param area Scissor rectangle, in pixels from the top-left corner of the target
+    ///
+    /// \see getScissor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScissor(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rectangle that drawing is restricted to
+    ///
+    /// \return Scissor rectangle, empty if drawing is not restricted
+    ///
+    /// \see setScissor
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getScissor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the tracking of the changed areas
+    ///
+    /// When damage tracking is enabled, the target accumulates
+    /// the areas that each clear and draw call modifies, until
+    /// clearDamage() is called (render windows call it when the
+    /// frame is displayed, after passing the areas to the window
+    /// system so that it only updates those parts of the screen).
+    ///
+    /// The bounds of vertex arrays are computed from their
+    /// vertices, which has a cost; draws of vertex buffers and
+    /// instanced draws damage the whole viewport, and clear()
+    /// the whole target. Nothing outside of the scissor
+    /// rectangle is damaged.
+    ///
+    /// Damage tracking is disabled by default.
+    ///
+    /// \param enabled True to enable damage tracking, false to disable it
+    ///
+    /// \see getDamage, addDamage
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDamageTrackingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the changed areas are tracked
+    ///
+    /// \return True if damage tracking is enabled, false otherwise
+    ///
+    /// \see setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDamageTrackingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark an area of the target as changed
+    ///
+    /// Use this function for changes that the target can't
+    /// see, such as direct OpenGL rendering. Overlapping areas
+    /// are merged. The area is clipped to the target.
+    ///
+    /// \param area Changed area, in pixels from the top-left corner of the target
+    ///
+    /// \see getDamage
+    ///
+    ////////////////////////////////////////////////////////////
+    void addDamage(const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the areas changed since the damage was last cleared
+    ///
+    /// The areas don't overlap each other.
+    ///
+    /// \return Changed areas, in pixels from the top-left corner of the target
+    ///
+    /// \see addDamage, clearDamage
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<IntRect>& getDamage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the areas changed so far
+    ///
+    /// \see getDamage
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearDamage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of OpenGL calls avoided by the states cache
+    ///
+    /// The render target remembers the OpenGL states that it
+    /// sets (blend mode, texture, shader and its textures,
+    /// vertex pointers...) and doesn't set them again when
+    /// consecutive draws use the same values. This function
+    /// returns an estimation of the number of OpenGL calls
+    /// that were skipped this way since the target was created.
+    /// It is mostly useful as a debugging aid, to check that
+    /// drawing is ordered in a way that minimizes state changes.
+    ///
+    /// \return Approximate number of OpenGL calls avoided
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getSkippedGlCallCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the frame being rendered
+    ///
+    /// The counters accumulate the work submitted since the
+    /// last call to display() (of the window or render texture),
+    /// so this function is typically called right before display().
+    /// Geometry that is still held by the batch is not counted
+    /// until it is flushed.
+    ///
+    /// If the system supports timer queries, the GPU time of the
+    /// frames is measured as well. The measurement is read back
+    /// asynchronously to avoid stalling the pipeline, therefore
+    /// \a gpuTime usually refers to a frame that was displayed
+    /// one or two frames earlier. It stays zero when the GPU
+    /// time can't be measured.
+    ///
+    /// Comparing the GPU time with the time your application
+    /// spends on the CPU tells whether a frame is limited by
+    /// the submission of the draw calls or by the GPU itself.
+    ///
+    /// \return Statistics of the current frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -383,14 +711,116 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the statistics of the current frame
+    ///
+    /// The derived classes must call this function when
+    /// their contents are displayed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
 private:
 
+    friend class RenderQueue;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices, bypassing the batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Try to append primitives to the current batch
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return True if the primitives were batched, false if they must be drawn immediately
+    ///
+    ////////////////////////////////////////////////////////////
+    bool batchVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices for every instance of drawInstanced
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstancedVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer, optionally indexed
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer, NULL to draw the vertices in order
+    /// \param first        Index of the first vertex, or of the first index, to render
+    /// \param count        Number of vertices, or of indices, to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertexBuffer(const VertexBuffer& vertexBuffer, const IndexBuffer* indexBuffer, std::size_t first,
+                          std::size_t count, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the active context can draw instances on the GPU
+    ///
+    /// \return True if instanced draw calls can be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isInstancingSupported();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take over the states cache of the target previously active in a context
+    ///
+    /// The states of a context don't change when another target
+    /// starts using it, so the cache of the previous target remains
+    /// valid for everything but the states that depend on the target.
+    /// If the previous target is gone, or its cache doesn't describe
+    /// this context anymore, the cache is disabled instead.
+    ///
+    /// \param targetId  Identifier of the target previously active in the context
+    /// \param contextId Identifier of the context
+    ///
+    ////////////////////////////////////////////////////////////
+    void takeOverCache(Uint64 targetId, Uint64 contextId);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
     ////////////////////////////////////////////////////////////
     void applyCurrentView();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the scissor rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyScissor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the pixels covered by an area of the world as changed
+    ///
+    /// \param bounds Area of the world, before the view is applied
+    ///
+    ////////////////////////////////////////////////////////////
+    void damageWorldArea(const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the whole current viewport as changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void damageViewport();
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new blending mode
     ///
@@ -415,6 +845,14 @@ private:
     ////////////////////////////////////////////////////////////
     void applyTexture(const Texture* texture);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new texture array
+    ///
+    /// \param textureArray Texture array to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyTextureArray(const TextureArray* textureArray);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new shader
     ///
@@ -423,14 +861,35 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a shader and its textures are still bound
+    ///
+    /// \param shader Shader to check
+    ///
+    /// \return True if the shader doesn't need to be applied again
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isShaderCurrent(const Shader& shader) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the program used by the programmable pipeline
+    ///
+    /// \param states Render states of the upcoming draw
+    ///
+    /// \return True if the uniforms of the program must be set again
+    ///
+    ////////////////////////////////////////////////////////////
+    bool applyProgram(const RenderStates& states, bool instanced);
+
     ////////////////////////////////////////////////////////////
     /// \brief Setup environment for drawing
     ///
     /// \param useVertexCache Are we going to use the vertex cache?
     /// \param states         Render states to use for drawing
+    /// \param instanced      Are we going to draw instances?
     ///
     ////////////////////////////////////////////////////////////
-    void setupDraw(bool useVertexCache, const RenderStates& states);
+    void setupDraw(bool useVertexCache, const RenderStates& states, bool instanced);
 
     ////////////////////////////////////////////////////////////
     /// \brief Draw the primitives
@@ -442,6 +901,29 @@ private:
     ////////////////////////////////////////////////////////////
     void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives for every instance of drawInstanced
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to use when drawing
+    /// \param vertexCount Number of vertices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstancedPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives using an index buffer
+    ///
+    /// The vertex buffer must be bound and its attributes set up.
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param indexBuffer Index buffer selecting the vertices
+    /// \param firstIndex  Position of the first index to use when drawing
+    /// \param indexCount  Number of indices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawIndexedPrimitives(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up environment after drawing
     ///
@@ -466,15 +948,80 @@ private:
         bool      texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
         bool      useVertexCache; ///< Did we previously use the vertex cache?
         Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool      corePipeline;   ///< Do we draw with the programmable pipeline (core profile contexts)?
+        unsigned int lastProgram; ///< Program bound by the programmable pipeline
+        int       uniformLocations[4]; ///< Locations of the pipeline uniforms in the bound program
+        Uint64    lastShaderId;   ///< Cached shader
+        Uint64    lastTextureArrayId; ///< Cached texture array
+        std::vector<Uint64> shaderTextureIds; ///< Cached textures of the shader, in the order of its texture table
+        unsigned int lastVertexBuffer; ///< Stream buffer the vertex pointers point into, 0 for client-side arrays
+        Uint64    skippedGlCalls; ///< Number of OpenGL calls avoided thanks to the cache
+        Uint64    contextId;      ///< Context whose states are cached
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry accumulated while batching is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        bool                enable;   ///< Is batching enabled?
+        PrimitiveType       type;     ///< Type of the primitives stored in the batch
+        RenderStates        states;   ///< Render states shared by all the batched primitives
+        std::vector<Vertex> vertices; ///< Pre-transformed vertices of the batch
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Instances of the object being drawn by drawInstanced
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Instances
+    {
+        const Transform* transforms; ///< Transform of each instance
+        const Color*     colors;     ///< Color of each instance, can be NULL
+        std::size_t      count;      ///< Number of instances
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Timestamps bracketing the GPU work of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FrameQueries
+    {
+        Uint64       contextId; ///< Context that owns the queries
+        unsigned int begin;     ///< Timestamp recorded before the first draw of the frame
+        unsigned int end;       ///< Timestamp recorded when the frame was displayed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief GPU timing state
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FrameTimer
+    {
+        bool                      available; ///< Are timer queries supported?
+        FrameQueries              current;   ///< Queries of the frame being rendered, begin is 0 if it has no draw yet
+        std::vector<FrameQueries> pending;   ///< Frames whose results are not available yet, oldest first
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
-    Uint64      m_id;          ///< Unique number that identifies the RenderTarget
+    View             m_defaultView; ///< Default view
+    View             m_view;        ///< Current view
+    StatesCache      m_cache;       ///< Render states cache
+    Statistics       m_statistics;  ///< Statistics of the current frame
+    FrameTimer       m_frameTimer;  ///< Measurement of the GPU time of the frames
+    Batch            m_batch;       ///< Pending batched geometry
+    bool             m_culling;     ///< Are the drawables outside of the view skipped?
+    const Instances* m_instances;   ///< Instances to draw, NULL outside of drawInstanced
+    RenderQueue*     m_queue;       ///< Queue recording the draw calls instead of rendering them, if any
+    int              m_queueLayer;  ///< Layer of the draw calls recorded into m_queue
+    Uint64           m_id;          ///< Unique number that identifies the RenderTarget
+    IntRect          m_scissor;     ///< Rectangle that drawing is restricted to, empty if none
+    bool             m_damageTracking; ///< Are the changed areas tracked?
+    std::vector<IntRect> m_damage;  ///< Disjoint areas changed since the damage was last cleared
+    priv::RenderDevice* m_device;   ///< Graphics API that the state changes and draw commands are submitted to
 };
 
 } // namespace sf
@@ -32,6 +32,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/ContextSettings.hpp>
+#include <vector>
 
 
 namespace sf
@@ -49,6 +50,18 @@ class SFML_GRAPHICS_API RenderTexture : public RenderTarget
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Formats of the color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Rgba8,       ///< 8 bits per component, the format of regular textures
+        Rgba16f,     ///< 16 bits floating point per component, for HDR colors
+        Rgba32f,     ///< 32 bits floating point per component, for precise data such as positions
+        R11fG11fB10f ///< Packed floating point RGB without alpha, compact HDR colors
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -108,6 +121,34 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with several color attachments
+    ///
+    /// This function creates one texture per element of
+    /// \a formats, in the given format, which are all drawn to
+    /// at once: a fragment shader writes to each of them through
+    /// \p gl_FragData[i] (or the i-th output on core profiles),
+    /// while \p gl_FragColor is written to all of them. A whole
+    /// G-buffer can then be filled in a single geometry pass.
+    ///
+    /// The textures are retrieved with getTexture(std::size_t).
+    /// Floating point formats keep values outside of [0, 1],
+    /// which is what HDR effects such as bloom need.
+    ///
+    /// Multiple attachments and floating point formats require
+    /// frame buffer objects; check isFormatAvailable() and
+    /// getMaximumAttachmentCount() before using them.
+    ///
+    /// \param width    Width of the render-texture
+    /// \param height   Height of the render-texture
+    /// \param formats  Format of each color attachment, at least one
+    /// \param settings Additional settings for the underlying OpenGL texture and context
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const std::vector<Format>& formats, const ContextSettings& settings = ContextSettings());
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the maximum anti-aliasing level supported by the system
     ///
@@ -116,6 +157,24 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumAntialiasingLevel();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system can render to a format
+    ///
+    /// \param format Format of the color attachment
+    ///
+    /// \return True if render-textures can be created with this format
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatAvailable(Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments supported by the system
+    ///
+    /// \return The maximum number of color attachments, 1 if multiple render targets are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
@@ -203,9 +262,29 @@ public:
     /// function is mandatory at the end of rendering. Not calling
     /// it may leave the texture in an undefined state.
     ///
+    /// The content of the depth and stencil buffers is discarded
+    /// by this function: clear them before drawing the next frame.
+    ///
+    /// With antialiasing, the multisampled content is not copied
+    /// to the texture right away, but only when the texture is
+    /// first used (drawn, copied or read back) or resolve() is
+    /// called, so that frames which are never used cost nothing.
+    ///
     ////////////////////////////////////////////////////////////
     void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the antialiased content to the texture now
+    ///
+    /// This is done automatically whenever the texture is used
+    /// by SFML after display(). You only need to call it when the
+    /// texture is accessed directly with OpenGL through its
+    /// native handle. It does nothing if there is no pending
+    /// multisampled content.
+    ///
+    ////////////////////////////////////////////////////////////
+    void resolve();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the texture
     ///
@@ -233,13 +312,43 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to the texture of a color attachment
+    ///
+    /// The texture of the first attachment is the one
+    /// returned by getTexture().
+    ///
+    /// \param index Index of the color attachment
+    ///
+    /// \return Const reference to the texture
+    ///
+    /// \see getAttachmentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of color attachments
+    ///
+    /// \return Number of color attachments, 1 unless several formats were passed to create
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAttachmentCount() const;
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the textures of the additional color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroyAttachments();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::RenderTextureImpl* m_impl;    ///< Platform/hardware specific implementation
-    Texture                  m_texture; ///< Target texture to draw on
+    priv::RenderTextureImpl* m_impl;        ///< Platform/hardware specific implementation
+    Texture                  m_texture;     ///< Target texture to draw on
+    std::vector<Texture*>    m_attachments; ///< Textures of the additional color attachments
 };
 
 } // namespace sf
@@ -309,6 +418,17 @@ private:
 /// and regular SFML drawing commands. If you need a depth buffer for
 /// 3D rendering, don't forget to request it when calling RenderTexture::create.
 ///
+/// A render-texture can also have several color attachments, possibly in
+/// floating point formats, that a fragment shader writes to at once:
+/// \code
+/// std::vector<sf::RenderTexture::Format> formats;
+/// formats.push_back(sf::RenderTexture::Rgba8);   // albedo
+/// formats.push_back(sf::RenderTexture::Rgba16f); // normals
+/// gbuffer.create(800, 600, formats);
+/// ...
+/// sf::Sprite normals(gbuffer.getTexture(1));
+/// \endcode
+///
 /// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycler of render-textures used as temporary targets
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the render-textures of the pool are destroyed,
+    /// including the ones that were not released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render-texture of the given size and settings
+    ///
+    /// A released render-texture created with the same size and
+    /// settings is reused if there is one, a new one is created
+    /// otherwise. A reused render-texture is reset to the state
+    /// of a newly created one (default view, smoothing and
+    /// repeating disabled), except for its contents, which are
+    /// undefined: it should be cleared before drawing.
+    ///
+    /// The render-texture belongs to the pool, it must be given
+    /// back with release() rather than destroyed.
+    ///
+    /// \param width    Width of the render-texture
+    /// \param height   Height of the render-texture
+    /// \param settings Additional settings for the underlying OpenGL texture and context
+    ///
+    /// \return Pointer to the render-texture, or NULL if it couldn't be created
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a render-texture back to the pool
+    ///
+    /// The render-texture must not be used anymore after this
+    /// call, since it may be handed out again by acquire().
+    ///
+    /// \param renderTexture Render-texture obtained from acquire()
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the render-textures that are not in use
+    ///
+    /// This frees the memory of the released render-textures,
+    /// after a change of resolution for example. Render-textures
+    /// currently acquired are not affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render-textures owned by the pool
+    ///
+    /// \return Number of render-textures, acquired or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render-texture of the pool with the parameters it was created with
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        RenderTexture*  renderTexture; ///< The render-texture
+        unsigned int    width;         ///< Requested width
+        unsigned int    height;        ///< Requested height
+        ContextSettings settings;      ///< Requested settings
+        bool            used;          ///< Is the render-texture currently acquired?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_entries; ///< Render-textures of the pool
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a sf::RenderTexture allocates a texture, a frame
+/// buffer and possibly depth, stencil and multisample buffers,
+/// which is too costly to be done every frame. Yet effect chains
+/// often need intermediate targets only for the duration of
+/// a few draws.
+///
+/// sf::RenderTexturePool keeps the render-textures it creates:
+/// once released, they are handed out again to the next request
+/// with the same size and settings, so that a chain creating
+/// the same temporary targets every frame allocates them only
+/// once.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// // Each frame...
+/// sf::RenderTexture* blurred = pool.acquire(width / 2, height / 2);
+/// blurred->clear();
+/// blurred->draw(sceneSprite, &blurShader);
+/// blurred->display();
+///
+/// window.draw(sf::Sprite(blurred->getTexture()), &bloomShader);
+///
+/// pool.release(blurred);
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -33,10 +33,18 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/Window.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class RenderTextureImplFBO;
+}
+
+class Texture;
+
 ////////////////////////////////////////////////////////////
 /// \brief Window that can serve as a target for 2D drawing
 ///
@@ -130,6 +138,77 @@ public:
     ////////////////////////////////////////////////////////////
     bool setActive(bool active = true);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the back buffer that must be drawn again
+    ///
+    /// The back buffer still holds the frame displayed
+    /// getBackBufferAge() frames ago. To bring it up to date,
+    /// the areas changed by the frames displayed since then
+    /// must be drawn again, as well as the damage already added
+    /// for the current frame. Restricting drawing to this area
+    /// with setScissor() leaves the rest of the window as it is.
+    ///
+    /// The whole window is returned when damage tracking is
+    /// disabled, when the age of the back buffer is unknown,
+    /// or when it is older than the frames the window remembers.
+    ///
+    /// \return Area to draw again, in pixels (empty if nothing changed)
+    ///
+    /// \see RenderTarget::setDamageTrackingEnabled, RenderTarget::addDamage
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getRepaintArea() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the capture of the frames
+    ///
+    /// When capture is enabled, the window draws into an
+    /// offscreen frame buffer instead of its back buffer, and
+    /// display() presents it with a blit. The last displayed
+    /// frame is then available as a texture (see
+    /// getCaptureTexture()) which can be read back without
+    /// stalling with sf::TextureReader, encoded, or drawn, with
+    /// no need to copy the back buffer with
+    /// sf::Texture::update(const Window&).
+    ///
+    /// Capture requires support for frame buffer objects and
+    /// blits, and a window created without antialiasing. The
+    /// capture buffer follows the size of the window. It is
+    /// disabled by default.
+    ///
+    /// \param enabled True to enable capture, false to disable it
+    ///
+    /// \return True if the capture state was changed as requested
+    ///
+    /// \see isCaptureEnabled, getCaptureTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setCaptureEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the capture of the frames is enabled
+    ///
+    /// \return True if the frames are captured
+    ///
+    /// \see setCaptureEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCaptureEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture holding the captured frame
+    ///
+    /// The texture holds the last frame passed to display(),
+    /// until the frame being drawn is displayed. It must not
+    /// be drawn to the window itself during that time.
+    ///
+    /// \return Pointer to the capture texture, NULL if capture is disabled
+    ///
+    /// \see setCaptureEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getCaptureTexture() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
@@ -177,6 +256,47 @@ protected:
     ///
     ////////////////////////////////////////////////////////////
     virtual void onResize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by display() to present the frame
+    ///
+    /// Geometry still pending in the current batch is submitted
+    /// before the buffers are swapped, whether display() is
+    /// called through the sf::RenderWindow or its sf::Window base.
+    ///
+    /// When damage tracking is enabled, the areas changed during
+    /// the frame are passed to the window system, which can then
+    /// update only those parts of the screen
+    /// (EGL_KHR_swap_buffers_with_damage), and the damage is
+    /// cleared for the next frame.
+    ///
+    /// \see RenderTarget::setBatchingEnabled, RenderTarget::setDamageTrackingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the capture buffer with the size of the window
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createCaptureBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the capture buffer and texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void destroyCaptureBuffer();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<IntRect>        m_damageHistory;  ///< Bounds of the damage of the last displayed frames, most recent first
+    Texture*                    m_captureTexture; ///< Texture receiving the frames when capture is enabled
+    priv::RenderTextureImplFBO* m_captureBuffer;  ///< Frame buffer drawn to when capture is enabled
 };
 
 } // namespace sf
@@ -279,6 +399,34 @@ protected:
 /// }
 /// \endcode
 ///
+/// Applications that only change small parts of the window,
+/// such as a blinking cursor, don't need to draw and present the
+/// whole window every frame. With damage tracking enabled, they
+/// can draw only what is out of date in the back buffer, and let
+/// the window system update only what changed on screen:
+///
+/// \code
+/// window.setDamageTrackingEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///
+///     // Tell what changed since the last frame
+///     window.addDamage(cursorArea);
+///
+///     // Draw what is out of date, and only that
+///     sf::IntRect area = window.getRepaintArea();
+///     if ((area.width > 0) && (area.height > 0))
+///     {
+///         window.setScissor(area);
+///         window.clear();
+///         window.draw(scene);
+///         window.display();
+///     }
+/// }
+/// \endcode
+///
 /// \see sf::Window, sf::RenderTarget, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -44,6 +45,7 @@ class Color;
 class InputStream;
 class Texture;
 class Transform;
+class VertexBuffer;
 
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex, geometry and fragment)
@@ -61,7 +63,8 @@ public:
     {
         Vertex,   ///< %Vertex shader
         Geometry, ///< Geometry shader
-        Fragment  ///< Fragment (pixel) shader
+        Fragment, ///< Fragment (pixel) shader
+        Compute   ///< Compute shader
     };
 
     ////////////////////////////////////////////////////////////
@@ -81,6 +84,56 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Special type that can be passed to setUniform(),
+    ///        and that holds a bindless texture handle
+    ///
+    /// \see setUniform(const std::string&, const BindlessHandle&)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct BindlessHandle
+    {
+        explicit BindlessHandle(Uint64 theHandle = 0) : handle(theHandle) {}
+
+        Uint64 handle; ///< Resident bindless handle, as returned by TextureArray::getBindlessHandle
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pre-resolved location of a uniform
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    class UniformHandle
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an invalid handle, setting it does nothing.
+        ///
+        ////////////////////////////////////////////////////////////
+        UniformHandle() : m_location(-1), m_programId(0) {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the handle refers to a uniform
+        ///
+        /// \return True if the uniform was found in the shader
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isValid() const {return m_location != -1;}
+
+    private:
+
+        friend class Shader;
+
+        UniformHandle(int location, Uint64 programId) : m_location(location), m_programId(programId) {}
+
+        int    m_location;  ///< Location of the uniform in the program
+        Uint64 m_programId; ///< Identifier of the program the location belongs to
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -485,6 +538,30 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniform(const std::string& name, CurrentTextureType);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a bindless texture handle as sampler uniform
+    ///
+    /// This overload requires the ARB_bindless_texture extension,
+    /// which the shader must enable. The texture doesn't need to
+    /// be bound: the handle is sampled directly, so a shader can
+    /// use many textures without breaking batches. It does nothing
+    /// if bindless textures are not supported.
+    ///
+    /// Example:
+    /// \code
+    /// #extension GL_ARB_bindless_texture : require
+    /// layout(bindless_sampler) uniform sampler2DArray tiles; // this is the variable in the shader
+    /// \endcode
+    /// \code
+    /// shader.setUniform("tiles", sf::Shader::BindlessHandle(tiles.getBindlessHandle()));
+    /// \endcode
+    ///
+    /// \param name           Name of the sampler in the shader
+    /// \param bindlessHandle Bindless handle of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const std::string& name, const BindlessHandle& bindlessHandle);
+
     ////////////////////////////////////////////////////////////
     /// \brief Specify values for \p float[] array uniform
     ///
@@ -545,6 +622,495 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a uniform
+    ///
+    /// Setting a uniform by name looks its location up in a
+    /// table of strings. Code that sets the same uniforms every
+    /// frame can resolve them once with this function, and pass
+    /// the handles to the setUniform and setUniformArray
+    /// overloads taking a UniformHandle instead of a name:
+    /// \code
+    /// sf::Shader::UniformHandle time = shader.getUniformHandle("time");
+    /// ...
+    /// shader.setUniform(time, clock.getElapsedTime().asSeconds());
+    /// \endcode
+    ///
+    /// Handles of sampler uniforms map to texture slots, they
+    /// can be used with the Texture and CurrentTextureType
+    /// overloads as well. Handles become invalid when the shader
+    /// is loaded again, and can't be used with another shader.
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the uniform, invalid if the uniform doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param x      Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param x      Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param x      Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param vector Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param matrix Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    /// \param matrix Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture as \p sampler2D uniform
+    ///
+    /// \param handle  Handle of the uniform, as returned by getUniformHandle
+    /// \param texture Texture to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify current texture as \p sampler2D uniform
+    ///
+    /// \param handle Handle of the uniform, as returned by getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, CurrentTextureType);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a bindless texture handle as sampler uniform
+    ///
+    /// \param handle         Handle of the uniform, as returned by getUniformHandle
+    /// \param bindlessHandle Bindless handle of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(const UniformHandle& handle, const BindlessHandle& bindlessHandle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p float[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, as returned by getUniformHandle
+    /// \param scalarArray pointer to array of \p float values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const UniformHandle& handle, const float* scalarArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec2[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, as returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec2 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const UniformHandle& handle, const Glsl::Vec2* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec3[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, as returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const UniformHandle& handle, const Glsl::Vec3* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p vec4[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, as returned by getUniformHandle
+    /// \param vectorArray pointer to array of \p vec4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const UniformHandle& handle, const Glsl::Vec4* vectorArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat3[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, as returned by getUniformHandle
+    /// \param matrixArray pointer to array of \p mat3 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const UniformHandle& handle, const Glsl::Mat3* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify values for \p mat4[] array uniform
+    ///
+    /// \param handle      Handle of the uniform, as returned by getUniformHandle
+    /// \param matrixArray pointer to array of \p mat4 values
+    /// \param length      Number of elements in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformArray(const UniformHandle& handle, const Glsl::Mat4* matrixArray, std::size_t length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify the contents of a uniform block
+    ///
+    /// The data is copied to a uniform buffer object owned by
+    /// the shader, which is attached to the block every time
+    /// the shader is bound. Since the buffer is updated without
+    /// binding the program, a whole set of uniforms can be
+    /// changed at the cost of a single upload.
+    ///
+    /// The data must follow the memory layout of the block,
+    /// declaring it with the \p std140 layout makes it portable:
+    /// \code
+    /// layout(std140) uniform Material
+    /// {
+    ///     vec4 tint;
+    ///     float shininess;
+    /// };
+    /// \endcode
+    /// \code
+    /// struct Material { float tint[4]; float shininess; float padding[3]; };
+    /// shader.setUniformBlock("Material", &material, sizeof(material));
+    /// \endcode
+    ///
+    /// This function does nothing if uniform blocks are not
+    /// supported (see isUniformBlockAvailable), or if \a size
+    /// is smaller than the size of the block.
+    ///
+    /// \param name Name of the uniform block in GLSL
+    /// \param data Pointer to the contents of the block
+    /// \param size Size of the contents, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformBlock(const std::string& name, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify the contents of a shader storage block
+    ///
+    /// The data is copied to a storage buffer owned by the
+    /// shader, which is attached to the block every time the
+    /// shader is bound. Unlike uniform blocks, storage blocks
+    /// can be written by the shader, and their size can be
+    /// chosen freely: \a data can be NULL to allocate \a size
+    /// bytes without initializing them, for a buffer that the
+    /// shader fills. The results can be read back with
+    /// getStorageBufferData().
+    ///
+    /// The data must follow the memory layout of the block,
+    /// declaring it with the \p std430 layout makes it portable.
+    ///
+    /// This function does nothing if storage buffers are not
+    /// supported (see isComputeAvailable).
+    ///
+    /// \param name Name of the storage block in GLSL
+    /// \param data Pointer to the initial contents of the buffer, can be NULL
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \see getStorageBufferData
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStorageBuffer(const std::string& name, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the vertices of a vertex buffer as a shader storage block
+    ///
+    /// The vertex buffer is attached to the block directly, so
+    /// that a compute shader can update vertices which are then
+    /// drawn without ever going through the CPU, for example to
+    /// animate particles. sf::Vertex is tightly packed, and its
+    /// texture coordinates don't meet the alignment of a \p vec2
+    /// member in \p std430, so the vertices are best accessed
+    /// as 6 consecutive floats: x, y, the color (its 4 bytes,
+    /// see floatBitsToUint), u, v and the layer.
+    /// \code
+    /// layout(std430) buffer Particles { float vertices[]; };
+    /// \endcode
+    ///
+    /// Only a reference to the vertex buffer is kept: it must
+    /// live as long as the shader uses it, and this function
+    /// must be called again if the vertex buffer is recreated.
+    ///
+    /// \param name         Name of the storage block in GLSL
+    /// \param vertexBuffer Vertex buffer to attach to the block
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStorageBuffer(const std::string& name, const VertexBuffer& vertexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read back the contents of a shader storage block
+    ///
+    /// This function stalls until the GPU is done writing to
+    /// the buffer, it is meant to retrieve results rather than
+    /// to be called every frame.
+    ///
+    /// \param name Name of the storage block in GLSL
+    /// \param data Destination of the contents
+    /// \param size Number of bytes to read, from the beginning of the buffer
+    ///
+    /// \return True on success, false if no buffer is attached to the block or \a size is too large
+    ///
+    /// \see setStorageBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getStorageBufferData(const std::string& name, void* data, std::size_t size) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture for an \p image2D uniform
+    ///
+    /// Contrary to samplers, images can be written by the
+    /// shader, which is how a compute shader outputs pixels.
+    /// The image must be declared with the \p rgba8 format,
+    /// and is bound with read and write access:
+    /// \code
+    /// layout(rgba8) uniform image2D result;
+    /// \endcode
+    /// \code
+    /// shader.setImage("result", texture);
+    /// \endcode
+    ///
+    /// Only a reference to the texture is kept, it must live
+    /// as long as the shader uses it. A texture should not be
+    /// used as an image and as a sampler in the same dispatch.
+    ///
+    /// \param name    Name of the image in the shader
+    /// \param texture Texture to attach to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void setImage(const std::string& name, Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the compute shader
+    ///
+    /// The shader must have been loaded from a compute shader.
+    /// It is executed for \a groupsX * \a groupsY * \a groupsZ
+    /// work groups, the size of a work group being declared in
+    /// the shader itself:
+    /// \code
+    /// layout(local_size_x = 64) in;
+    /// \endcode
+    ///
+    /// All the state of the shader (uniforms, textures, images,
+    /// uniform blocks and storage buffers) is bound for the
+    /// dispatch. When the function returns, the results are
+    /// visible to everything that is executed afterwards, be it
+    /// a draw reading the updated vertices, a shader sampling
+    /// the updated textures or getStorageBufferData().
+    ///
+    /// \param groupsX Number of work groups along X
+    /// \param groupsY Number of work groups along Y
+    /// \param groupsZ Number of work groups along Z
+    ///
+    /// \see isComputeAvailable
+    ///
+    ////////////////////////////////////////////////////////////
+    void dispatch(unsigned int groupsX, unsigned int groupsY = 1, unsigned int groupsZ = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable deferred uniforms
+    ///
+    /// Setting a uniform normally binds the program, uploads the
+    /// value and restores the previous program, which is costly
+    /// when many uniforms change every frame. In deferred mode,
+    /// the setUniform and setUniformArray overloads taking
+    /// values (scalars, vectors and matrices) only store them,
+    /// and the ones that changed are uploaded the next time the
+    /// shader is bound, typically when it is used to draw.
+    /// Setting a uniform to the value it already has is free.
+    ///
+    /// Textures, uniform blocks and bindless handles are not
+    /// affected. Values that are still pending when deferred
+    /// mode is disabled are uploaded immediately.
+    ///
+    /// Deferred mode is disabled by default.
+    ///
+    /// \param deferred True to defer uniform updates, false to apply them immediately
+    ///
+    /// \see areUniformsDeferred
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniformsDeferred(bool deferred);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether uniform updates are deferred or not
+    ///
+    /// \return True if uniform updates are deferred, false otherwise
+    ///
+    /// \see setUniformsDeferred
+    ///
+    ////////////////////////////////////////////////////////////
+    bool areUniformsDeferred() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable asynchronous compilation
+    ///
+    /// By default, the load functions wait until the program is
+    /// linked. When asynchronous compilation is enabled and the
+    /// driver supports KHR_parallel_shader_compile, they return
+    /// as soon as the sources are submitted, and the driver
+    /// compiles them in the background. Several shaders can
+    /// then be compiled concurrently, while a loading screen
+    /// keeps being displayed for example:
+    /// \code
+    /// shader.setAsyncCompilation(true);
+    /// shader.loadFromFile("blur.vert", "blur.frag");
+    /// ...
+    /// while (!shader.isReady())
+    ///     drawLoadingScreen();
+    /// \endcode
+    ///
+    /// In this mode, the load functions only report errors that
+    /// can be detected immediately. Compile and link errors are
+    /// reported when the compilation is found to be finished,
+    /// after which the shader is empty as if loading had failed.
+    /// Using the shader before it is ready (setting uniforms,
+    /// drawing with it, ...) waits for the compilation.
+    ///
+    /// Without KHR_parallel_shader_compile, the shaders are
+    /// compiled immediately and isReady() always returns true.
+    /// Asynchronous compilation is disabled by default.
+    ///
+    /// \param enabled True to compile asynchronously, false to wait for the compilation
+    ///
+    /// \see isAsyncCompilationEnabled, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsyncCompilation(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether asynchronous compilation is enabled or not
+    ///
+    /// \return True if asynchronous compilation is enabled, false otherwise
+    ///
+    /// \see setAsyncCompilation
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsyncCompilationEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the compilation of the shader is finished
+    ///
+    /// This function never waits for the driver. It returns
+    /// false only while an asynchronous compilation is still
+    /// in progress; once it returns true, errors have been
+    /// reported and the shader can be used without waiting.
+    ///
+    /// \return True if the shader is not being compiled anymore
+    ///
+    /// \see setAsyncCompilation
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -691,8 +1257,64 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isGeometryAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform blocks
+    ///
+    /// Uniform blocks are backed by uniform buffer objects,
+    /// which require OpenGL 3.1 or the ARB_uniform_buffer_object
+    /// extension.
+    ///
+    /// \return True if uniform blocks are supported, false otherwise
+    ///
+    /// \see setUniformBlock
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isUniformBlockAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports compute shaders
+    ///
+    /// Compute shaders, storage buffers and images require
+    /// OpenGL 4.3, or the ARB_compute_shader,
+    /// ARB_shader_storage_buffer_object, ARB_program_interface_query
+    /// and ARB_shader_image_load_store extensions.
+    ///
+    /// \return True if compute shaders are supported, false otherwise
+    ///
+    /// \see dispatch
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isComputeAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the program binary cache
+    ///
+    /// Compiling and linking shaders from source can take a
+    /// noticeable time when an application has many of them.
+    /// When the cache is enabled, the binaries of the linked
+    /// programs are saved to files in \a directory, and loaded
+    /// back instead of compiling the same sources again.
+    ///
+    /// Binaries only work with the driver that produced them:
+    /// cache files are keyed by the shader sources and by the
+    /// vendor, renderer and version strings of the driver. If a
+    /// binary is missing or rejected, the shader is compiled
+    /// from source and the cache file is replaced.
+    ///
+    /// The directory must exist and be writable. The cache is
+    /// disabled by default, passing an empty string disables it
+    /// again. It requires OpenGL 4.1 or the ARB_get_program_binary
+    /// extension, shaders are always compiled from source otherwise.
+    ///
+    /// \param directory Directory to store the cache files in, empty to disable the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -702,11 +1324,12 @@ private:
     /// \param vertexShaderCode   Source code of the vertex shader
     /// \param geometryShaderCode Source code of the geometry shader
     /// \param fragmentShaderCode Source code of the fragment shader
+    /// \param computeShaderCode  Source code of the compute shader
     ///
     /// \return True on success, false if any error happened
     ///
     ////////////////////////////////////////////////////////////
-    bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode);
+    bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, const char* computeShaderCode);
 
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
@@ -727,6 +1350,127 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location a uniform handle refers to
+    ///
+    /// \param handle Handle of the uniform
+    ///
+    /// \return Location of the uniform, or -1 if the handle is invalid or not from this shader
+    ///
+    ////////////////////////////////////////////////////////////
+    int getLocation(const UniformHandle& handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Value of a deferred uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformValue
+    {
+        enum Type
+        {
+            Float,  ///< Float scalars or vectors
+            Int,    ///< Int scalars or vectors
+            Matrix  ///< Float matrices
+        };
+
+        UniformValue();
+
+        Type               type;   ///< Type of the components
+        int                size;   ///< Number of components of an element (1 to 4, or 9 and 16 for matrices)
+        std::size_t        count;  ///< Number of elements of the array
+        std::vector<float> floats; ///< Components of float and matrix uniforms
+        std::vector<int>   ints;   ///< Components of int uniforms
+        bool               dirty;  ///< Has the value changed since it was last uploaded?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Uniform buffer backing a uniform block
+    ///
+    ////////////////////////////////////////////////////////////
+    struct UniformBlock
+    {
+        unsigned int buffer;  ///< OpenGL identifier of the uniform buffer
+        unsigned int binding; ///< Binding point the buffer is attached to
+        std::size_t  size;    ///< Size of the block, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Buffer attached to a shader storage block
+    ///
+    ////////////////////////////////////////////////////////////
+    struct StorageBuffer
+    {
+        unsigned int buffer;  ///< OpenGL identifier of the storage buffer
+        int          binding; ///< Binding point the buffer is attached to, -1 if the block doesn't exist
+        std::size_t  size;    ///< Size of the buffer, in bytes
+        bool         owned;   ///< Was the buffer created by the shader?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the value of a uniform if uniforms are deferred
+    ///
+    /// \param handle Handle of the uniform
+    /// \param type   Type of the components
+    /// \param size   Number of components of an element
+    /// \param count  Number of elements of the array
+    /// \param floats Components of float and matrix uniforms, NULL for int uniforms
+    /// \param ints   Components of int uniforms, NULL for float and matrix uniforms
+    ///
+    /// \return True if the value was deferred, false if it must be uploaded now
+    ///
+    ////////////////////////////////////////////////////////////
+    bool deferUniform(const UniformHandle& handle, UniformValue::Type type, int size, std::size_t count, const float* floats, const int* ints);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the deferred uniforms that changed
+    ///
+    /// The program must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach the uniform buffers to their binding points
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindUniformBlocks() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the storage buffer of a block, assigning it a binding point if needed
+    ///
+    /// \param name Name of the storage block in GLSL
+    ///
+    /// \return Storage buffer of the block, or NULL if the block can't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    StorageBuffer* getStorageBuffer(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach the storage buffers to their binding points
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindStorageBuffers() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind all the images used by the shader to image units
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindImages() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an asynchronous compilation and check its result
+    ///
+    /// This function does nothing if no compilation is pending.
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishCompilation() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the shaders kept while a compilation is pending
+    ///
+    ////////////////////////////////////////////////////////////
+    void discardPendingShaders() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -741,14 +1485,30 @@ private:
     ////////////////////////////////////////////////////////////
     typedef std::map<int, const Texture*> TextureTable;
     typedef std::map<std::string, int> UniformTable;
+    typedef std::map<int, UniformValue> UniformValueTable;
+    typedef std::map<std::string, UniformBlock> UniformBlockTable;
+    typedef std::map<std::string, StorageBuffer> StorageBufferTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       ///< Parameters location cache
+    mutable unsigned int              m_shaderProgram;      ///< OpenGL identifier for the program (reset if an asynchronous compilation fails)
+    int                               m_currentTexture;     ///< Location of the current texture in the shader
+    TextureTable                      m_textures;           ///< Texture variables in the shader, mapped to their location
+    UniformTable                      m_uniforms;           ///< Parameters location cache
+    Uint64                            m_cacheId;            ///< Unique number that identifies the program and its texture bindings to the render target's cache
+    Uint64                            m_programId;          ///< Unique number that identifies the program to the uniform handles
+    bool                              m_uniformsDeferred;   ///< Are uniform updates deferred until the shader is bound?
+    mutable UniformValueTable         m_uniformValues;      ///< Deferred uniform values, mapped to their location
+    mutable std::vector<int>          m_dirtyUniforms;      ///< Locations of the deferred uniforms to upload
+    UniformBlockTable                 m_uniformBlocks;      ///< Uniform buffers of the uniform blocks, mapped to the block name
+    StorageBufferTable                m_storageBuffers;     ///< Buffers of the storage blocks, mapped to the block name
+    TextureTable                      m_images;             ///< Image variables in the shader, mapped to their location
+    bool                              m_computeProgram;     ///< Is the program made of a compute shader?
+    bool                              m_asyncCompilation;   ///< Do the load functions return without waiting for the compilation?
+    mutable bool                      m_compilationPending; ///< Is an asynchronous compilation in progress?
+    mutable std::vector<unsigned int> m_pendingShaders;     ///< Shaders of the pending compilation, kept for their compile log
+    mutable std::string               m_pendingCachePath;   ///< Binary cache file to write once the pending compilation succeeds
 };
 
 } // namespace sf
@@ -770,6 +1530,11 @@ private:
 /// \li Geometry shaders, that process primitives
 /// \li Fragment (pixel) shaders, that process pixels
 ///
+/// A fourth kind, compute shaders, is not part of the rendering
+/// pipeline: it runs general purpose computations on the GPU
+/// with dispatch(), reading and writing storage buffers and
+/// images (see setStorageBuffer and setImage).
+///
 /// A sf::Shader can be composed of either a vertex shader
 /// alone, a geometry shader alone, a fragment shader alone,
 /// or any combination of them. (see the variants of the
@@ -817,6 +1582,15 @@ private:
 /// The old setParameter() overloads are deprecated and will be removed in a
 /// future version. You should use their setUniform() equivalents instead.
 ///
+/// Setting a uniform binds the program for the duration of the
+/// call. When many uniforms change every frame, they can instead
+/// be grouped in a uniform block and uploaded at once with
+/// setUniformBlock(), or the shader can be switched to deferred
+/// mode with setUniformsDeferred(): values are then kept on the
+/// CPU side, and only the ones that changed are uploaded when
+/// the shader is bound to draw. Looking uniforms up by name can
+/// be avoided too, by resolving them once with getUniformHandle().
+///
 /// The special Shader::CurrentTexture argument maps the
 /// given \p sampler2D uniform to the current texture of the
 /// object being drawn (which cannot be known in advance).
@@ -870,6 +1644,19 @@ private:
 /// sf::Shader::bind(NULL);
 /// \endcode
 ///
+/// Core profile OpenGL contexts don't provide the fixed-function
+/// built-ins such as gl_Vertex or gl_ModelViewProjectionMatrix.
+/// When drawing to such a context, sf::RenderTarget feeds the
+/// vertices through the \p sf_position (vec2), \p sf_color (vec4)
+/// and \p sf_texCoords (vec2) attributes, and sets the
+/// \p sf_projectionMatrix, \p sf_modelViewMatrix and
+/// \p sf_textureMatrix (mat4) uniforms if the shader declares them.
+/// The current texture is bound to texture unit 0.
+/// Geometry drawn with sf::RenderTarget::drawInstanced additionally
+/// provides the per-instance \p sf_instanceTransform (mat4) and
+/// \p sf_instanceColor (vec4) attributes, which the shader is
+/// responsible for applying.
+///
 /// \see sf::Glsl
 ///
 ////////////////////////////////////////////////////////////
@@ -262,6 +262,11 @@ protected:
     /// the shape's points change (i.e. the result of either
     /// getPointCount or getPoint is different).
     ///
+    /// The geometry is not rebuilt immediately: it is only marked
+    /// as outdated, and recomputed the next time the shape is
+    /// drawn or its bounds are requested. Changing the points
+    /// several times in a row therefore costs a single update.
+    ///
     ////////////////////////////////////////////////////////////
     void update();
 
@@ -276,44 +281,71 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the shape, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the shape
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the outdated parts of the geometry are rebuilt
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the fill vertices' position and the bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePositions() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateFillColors();
+    void updateFillColors() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' texture coordinates
     ///
     ////////////////////////////////////////////////////////////
-    void updateTexCoords();
+    void updateTexCoords() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' position
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutline();
+    void updateOutline() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutlineColors();
+    void updateOutlineColors() const;
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*      m_texture;                 ///< Texture of the shape
+    IntRect             m_textureRect;             ///< Rectangle defining the area of the source texture to display
+    Color               m_fillColor;               ///< Fill color
+    Color               m_outlineColor;            ///< Outline color
+    float               m_outlineThickness;        ///< Thickness of the shape's outline
+    mutable VertexArray m_vertices;                ///< Vertex array containing the fill geometry
+    mutable VertexArray m_outlineVertices;         ///< Vertex array containing the outline geometry
+    mutable FloatRect   m_insideBounds;            ///< Bounding rectangle of the inside (fill)
+    mutable FloatRect   m_bounds;                  ///< Bounding rectangle of the whole shape (outline + fill)
+    mutable bool        m_positionsNeedUpdate;     ///< Do the points of the shape need to be fetched again?
+    mutable bool        m_fillColorsNeedUpdate;    ///< Does the fill color need to be applied to the vertices?
+    mutable bool        m_texCoordsNeedUpdate;     ///< Do the texture coordinates need to be recomputed?
+    mutable bool        m_outlineNeedsUpdate;      ///< Does the outline geometry need to be recomputed?
+    mutable bool        m_outlineColorsNeedUpdate; ///< Does the outline color need to be applied to the vertices?
 };
 
 } // namespace sf
@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPATIALINDEX_HPP
+#define SFML_SPATIALINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Dynamic bounding box tree to find objects by their area
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpatialIndex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an object stored in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t Id;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The stored boxes are enlarged by \a margin on every
+    /// side, so that objects moving by less than that don't
+    /// need the tree to be restructured.
+    ///
+    /// \param margin Distance to enlarge the stored boxes by
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpatialIndex(float margin = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object to the index
+    ///
+    /// \param bounds Bounding rectangle of the object
+    /// \param value  Value to associate with the object
+    ///
+    /// \return Identifier of the object, valid until it is removed
+    ///
+    /// \see remove, update
+    ///
+    ////////////////////////////////////////////////////////////
+    Id insert(const FloatRect& bounds, const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object from the index
+    ///
+    /// The identifier of the object can be reused by the
+    /// next insertions.
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \see insert
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounding rectangle of an object
+    ///
+    /// Call this function when an object moves or changes
+    /// size, for example with the global bounds of a sprite
+    /// after setting its position. As long as the new bounds
+    /// stay inside the enlarged box stored for the object,
+    /// the tree is left untouched.
+    ///
+    /// \param id     Identifier of the object
+    /// \param bounds New bounding rectangle of the object
+    ///
+    /// \return True if the object had to be moved in the tree
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(Id id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the objects from the index
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects in the index
+    ///
+    /// \return Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value associated with an object
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Value of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    const T& getValue(Id id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of an object
+    ///
+    /// \param id Identifier of the object
+    ///
+    /// \return Bounds given to the last insert() or update()
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getBounds(Id id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Call a function for every object overlapping an area
+    ///
+    /// The function is called with the identifier of each
+    /// object whose bounds overlap \a area (edges included),
+    /// and must return a bool: false stops the query. The
+    /// objects come in no particular order.
+    ///
+    /// \param area     Area to look for objects in
+    /// \param function Function, or function object, to call
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void query(const FloatRect& area, F function) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the values of the objects overlapping an area
+    ///
+    /// This is the query to use for culling, with the area
+    /// covered by a view (see View::getBounds).
+    ///
+    /// \param area    Area to look for objects in
+    /// \param results Vector to append the values of the objects to
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const FloatRect& area, std::vector<T>& results) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the values of the objects containing a point
+    ///
+    /// This is the query to use for picking, with the result
+    /// of RenderTarget::mapPixelToCoords. A point is inside an
+    /// object under the same rules as FloatRect::contains.
+    ///
+    /// \param point   Point to look for objects at
+    /// \param results Vector to append the values of the objects to
+    ///
+    ////////////////////////////////////////////////////////////
+    void query(const Vector2f& point, std::vector<T>& results) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Axis-aligned box stored by its extremities
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Box
+    {
+        float minX; ///< Left edge of the box
+        float minY; ///< Top edge of the box
+        float maxX; ///< Right edge of the box
+        float maxY; ///< Bottom edge of the box
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Node of the tree, either a leaf storing an object or a branch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Node
+    {
+        Box       box;    ///< Box enclosing the whole subtree (enlarged for leaves)
+        FloatRect bounds; ///< Exact bounds of the object, for leaves
+        T         value;  ///< Value of the object, for leaves
+        Id        parent; ///< Parent node, or next free node for unused nodes
+        Id        left;   ///< First child, or nullId for leaves
+        Id        right;  ///< Second child, or nullId for leaves
+        int       height; ///< Height of the subtree (0 for leaves, -1 for unused nodes)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take an unused node, or create a new one
+    ///
+    /// \return Index of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    Id allocateNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a node back to the list of unused nodes
+    ///
+    /// \param id Index of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    void freeNode(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a leaf into the tree, next to the sibling that grows the least
+    ///
+    /// \param leaf Index of the leaf
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertLeaf(Id leaf);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a leaf from the tree, without freeing it
+    ///
+    /// \param leaf Index of the leaf
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeLeaf(Id leaf);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Refit and rebalance the branches from a node up to the root
+    ///
+    /// \param id Index of the first branch to fix
+    ///
+    ////////////////////////////////////////////////////////////
+    void fixUpwards(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rotate a branch if its children are unbalanced
+    ///
+    /// \param id Index of the branch
+    ///
+    /// \return Index of the node which replaced the branch in the tree
+    ///
+    ////////////////////////////////////////////////////////////
+    Id balance(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace a child of a node after a rotation
+    ///
+    /// \param parent   Index of the parent, or nullId if the child is the root
+    /// \param oldChild Index of the replaced child
+    /// \param newChild Index of the new child
+    ///
+    ////////////////////////////////////////////////////////////
+    void replaceChild(Id parent, Id oldChild, Id newChild);
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const Id nullId = static_cast<Id>(-1); ///< Index representing no node
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Node> m_nodes;    ///< Pool of nodes, leaves and branches
+    Id                m_root;     ///< Root of the tree, or nullId when empty
+    Id                m_freeList; ///< First unused node, or nullId
+    std::size_t       m_size;     ///< Number of objects stored
+    float             m_margin;   ///< Distance the stored boxes are enlarged by
+};
+
+#include <SFML/Graphics/SpatialIndex.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPATIALINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpatialIndex
+/// \ingroup graphics
+///
+/// sf::SpatialIndex stores objects by their bounding rectangle,
+/// and finds the ones overlapping an area or containing a point
+/// without testing every object. It replaces linear loops over
+/// getGlobalBounds().contains() for mouse picking, and lets the
+/// drawing code only visit the objects in view instead of relying
+/// on the per-drawable culling of sf::RenderTarget.
+///
+/// The index is a dynamic bounding volume hierarchy: a binary
+/// tree whose leaves hold the objects, and whose branches hold
+/// the box enclosing their children. Insertions pick the place
+/// in the tree that increases the total size of the boxes the
+/// least, and the tree is kept balanced by rotations, so that
+/// queries only visit a logarithmic number of branches.
+///
+/// The value type T is usually a pointer to the object, or
+/// an index in the container of the application. It must
+/// be copyable and default-constructible.
+///
+/// The index doesn't know when the objects move: call update()
+/// with their new bounds. Leaves are stored with a margin, so
+/// small movements usually don't modify the tree at all.
+///
+/// Usage example:
+/// \code
+/// sf::SpatialIndex<sf::Sprite*> index(8.f);
+/// std::vector<sf::SpatialIndex<sf::Sprite*>::Id> ids;
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     ids.push_back(index.insert(sprites[i].getGlobalBounds(), &sprites[i]));
+///
+/// // After moving a sprite
+/// sprites[5].move(1.f, 0.f);
+/// index.update(ids[5], sprites[5].getGlobalBounds());
+///
+/// // Picking
+/// std::vector<sf::Sprite*> hits;
+/// index.query(window.mapPixelToCoords(sf::Mouse::getPosition(window)), hits);
+///
+/// // Culling
+/// std::vector<sf::Sprite*> visible;
+/// index.query(window.getView().getBounds(), visible);
+/// for (std::size_t i = 0; i < visible.size(); ++i)
+///     window.draw(*visible[i]);
+/// \endcode
+///
+/// \see sf::Rect, sf::View
+///
+////////////////////////////////////////////////////////////
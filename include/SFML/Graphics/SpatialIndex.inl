@@ -0,0 +1,470 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+namespace priv
+{
+// Smallest box enclosing two boxes
+template <typename B>
+B combineBoxes(const B& a, const B& b)
+{
+    B box;
+    box.minX = (a.minX < b.minX) ? a.minX : b.minX;
+    box.minY = (a.minY < b.minY) ? a.minY : b.minY;
+    box.maxX = (a.maxX > b.maxX) ? a.maxX : b.maxX;
+    box.maxY = (a.maxY > b.maxY) ? a.maxY : b.maxY;
+    return box;
+}
+
+// Perimeter of a box, the cost that the tree construction minimizes
+template <typename B>
+float getBoxPerimeter(const B& box)
+{
+    return 2.f * ((box.maxX - box.minX) + (box.maxY - box.minY));
+}
+
+// Check whether a box entirely contains another one
+template <typename B>
+bool boxContains(const B& outer, const B& inner)
+{
+    return (outer.minX <= inner.minX) && (outer.minY <= inner.minY) &&
+           (outer.maxX >= inner.maxX) && (outer.maxY >= inner.maxY);
+}
+
+// Check whether two boxes overlap, edges included
+template <typename B>
+bool boxesOverlap(const B& a, const B& b)
+{
+    return (a.minX <= b.maxX) && (b.minX <= a.maxX) &&
+           (a.minY <= b.maxY) && (b.minY <= a.maxY);
+}
+
+// Convert a rectangle, possibly with negative dimensions, to a box enlarged by a margin
+template <typename B>
+B rectToBox(const FloatRect& rectangle, float margin)
+{
+    float right  = rectangle.left + rectangle.width;
+    float bottom = rectangle.top + rectangle.height;
+
+    B box;
+    box.minX = ((rectangle.left < right) ? rectangle.left : right) - margin;
+    box.minY = ((rectangle.top < bottom) ? rectangle.top : bottom) - margin;
+    box.maxX = ((rectangle.left < right) ? right : rectangle.left) + margin;
+    box.maxY = ((rectangle.top < bottom) ? bottom : rectangle.top) + margin;
+    return box;
+}
+
+// Query function appending the values of the objects to a vector
+template <typename T>
+struct SpatialIndexCollector
+{
+    SpatialIndexCollector(const SpatialIndex<T>& index, std::vector<T>& results) : m_index(index), m_results(results) {}
+    bool operator()(std::size_t id) const {m_results.push_back(m_index.getValue(id)); return true;}
+    const SpatialIndex<T>& m_index;
+    std::vector<T>&        m_results;
+};
+
+// Query function appending the values of the objects containing a point to a vector
+template <typename T>
+struct SpatialIndexPointCollector
+{
+    SpatialIndexPointCollector(const SpatialIndex<T>& index, const Vector2f& point, std::vector<T>& results) : m_index(index), m_point(point), m_results(results) {}
+    bool operator()(std::size_t id) const {if (m_index.getBounds(id).contains(m_point)) m_results.push_back(m_index.getValue(id)); return true;}
+    const SpatialIndex<T>& m_index;
+    Vector2f               m_point;
+    std::vector<T>&        m_results;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const typename SpatialIndex<T>::Id SpatialIndex<T>::nullId;
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+SpatialIndex<T>::SpatialIndex(float margin) :
+m_nodes   (),
+m_root    (nullId),
+m_freeList(nullId),
+m_size    (0),
+m_margin  (margin)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename SpatialIndex<T>::Id SpatialIndex<T>::insert(const FloatRect& bounds, const T& value)
+{
+    Id id = allocateNode();
+
+    Node& node = m_nodes[id];
+    node.box    = priv::rectToBox<Box>(bounds, m_margin);
+    node.bounds = bounds;
+    node.value  = value;
+    node.left   = nullId;
+    node.right  = nullId;
+    node.height = 0;
+
+    insertLeaf(id);
+    ++m_size;
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::remove(Id id)
+{
+    removeLeaf(id);
+    freeNode(id);
+    --m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpatialIndex<T>::update(Id id, const FloatRect& bounds)
+{
+    m_nodes[id].bounds = bounds;
+
+    // Nothing to do while the object stays inside its enlarged box
+    if (priv::boxContains(m_nodes[id].box, priv::rectToBox<Box>(bounds, 0.f)))
+        return false;
+
+    removeLeaf(id);
+    m_nodes[id].box = priv::rectToBox<Box>(bounds, m_margin);
+    insertLeaf(id);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::clear()
+{
+    m_nodes.clear();
+    m_root = nullId;
+    m_freeList = nullId;
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpatialIndex<T>::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const T& SpatialIndex<T>::getValue(Id id) const
+{
+    return m_nodes[id].value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const FloatRect& SpatialIndex<T>::getBounds(Id id) const
+{
+    return m_nodes[id].bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+template <typename F>
+void SpatialIndex<T>::query(const FloatRect& area, F function) const
+{
+    if (m_root == nullId)
+        return;
+
+    Box areaBox = priv::rectToBox<Box>(area, 0.f);
+
+    // The tree is balanced, so its height rarely exceeds the fixed stack; deeper nodes go to the vector
+    Id              stack[64];
+    std::size_t     stackSize = 0;
+    std::vector<Id> overflow;
+
+    stack[stackSize++] = m_root;
+    while ((stackSize > 0) || !overflow.empty())
+    {
+        Id id;
+        if (!overflow.empty())
+        {
+            id = overflow.back();
+            overflow.pop_back();
+        }
+        else
+        {
+            id = stack[--stackSize];
+        }
+
+        const Node& node = m_nodes[id];
+        if (!priv::boxesOverlap(node.box, areaBox))
+            continue;
+
+        if (node.height == 0)
+        {
+            // Test the exact bounds, the stored box is enlarged
+            if (priv::boxesOverlap(priv::rectToBox<Box>(node.bounds, 0.f), areaBox) && !function(id))
+                return;
+        }
+        else
+        {
+            const Id children[] = {node.left, node.right};
+            for (int i = 0; i < 2; ++i)
+            {
+                if (stackSize < sizeof(stack) / sizeof(stack[0]))
+                    stack[stackSize++] = children[i];
+                else
+                    overflow.push_back(children[i]);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::query(const FloatRect& area, std::vector<T>& results) const
+{
+    query(area, priv::SpatialIndexCollector<T>(*this, results));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::query(const Vector2f& point, std::vector<T>& results) const
+{
+    query(FloatRect(point.x, point.y, 0.f, 0.f), priv::SpatialIndexPointCollector<T>(*this, point, results));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename SpatialIndex<T>::Id SpatialIndex<T>::allocateNode()
+{
+    if (m_freeList == nullId)
+    {
+        m_nodes.push_back(Node());
+        return m_nodes.size() - 1;
+    }
+
+    Id id = m_freeList;
+    m_freeList = m_nodes[id].parent;
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::freeNode(Id id)
+{
+    Node& node = m_nodes[id];
+    node.value  = T();
+    node.height = -1;
+    node.parent = m_freeList;
+    m_freeList = id;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::insertLeaf(Id leaf)
+{
+    m_nodes[leaf].parent = nullId;
+
+    if (m_root == nullId)
+    {
+        m_root = leaf;
+        return;
+    }
+
+    // Walk down to the sibling whose pairing with the leaf costs the least,
+    // the cost being the growth of the perimeters of the boxes of the tree
+    const Box leafBox = m_nodes[leaf].box;
+    Id id = m_root;
+    while (m_nodes[id].height > 0)
+    {
+        const Node& node = m_nodes[id];
+
+        float perimeter = priv::getBoxPerimeter(node.box);
+        float combinedPerimeter = priv::getBoxPerimeter(priv::combineBoxes(node.box, leafBox));
+
+        // Cost of creating a new parent for this node and the leaf
+        float cost = 2.f * combinedPerimeter;
+
+        // Minimum cost of pushing the leaf further down, which grows this node anyway
+        float inheritedCost = 2.f * (combinedPerimeter - perimeter);
+
+        float childCosts[2];
+        const Id children[] = {node.left, node.right};
+        for (int i = 0; i < 2; ++i)
+        {
+            const Node& child = m_nodes[children[i]];
+            float childPerimeter = priv::getBoxPerimeter(priv::combineBoxes(child.box, leafBox));
+            if (child.height > 0)
+                childPerimeter -= priv::getBoxPerimeter(child.box);
+            childCosts[i] = childPerimeter + inheritedCost;
+        }
+
+        if ((cost < childCosts[0]) && (cost < childCosts[1]))
+            break;
+
+        id = (childCosts[0] < childCosts[1]) ? children[0] : children[1];
+    }
+
+    // Create a new parent for the sibling and the leaf
+    Id sibling = id;
+    Id oldParent = m_nodes[sibling].parent;
+    Id newParent = allocateNode();
+
+    Node& parent = m_nodes[newParent];
+    parent.box    = priv::combineBoxes(leafBox, m_nodes[sibling].box);
+    parent.value  = T();
+    parent.parent = oldParent;
+    parent.left   = sibling;
+    parent.right  = leaf;
+    parent.height = m_nodes[sibling].height + 1;
+
+    replaceChild(oldParent, sibling, newParent);
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    fixUpwards(newParent);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::removeLeaf(Id leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = nullId;
+        return;
+    }
+
+    // The sibling of the leaf takes the place of their parent
+    Id parent = m_nodes[leaf].parent;
+    Id grandParent = m_nodes[parent].parent;
+    Id sibling = (m_nodes[parent].left == leaf) ? m_nodes[parent].right : m_nodes[parent].left;
+
+    replaceChild(grandParent, parent, sibling);
+    m_nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    if (grandParent != nullId)
+        fixUpwards(grandParent);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::fixUpwards(Id id)
+{
+    while (id != nullId)
+    {
+        id = balance(id);
+
+        Node& node = m_nodes[id];
+        const Node& left = m_nodes[node.left];
+        const Node& right = m_nodes[node.right];
+
+        node.height = 1 + ((left.height > right.height) ? left.height : right.height);
+        node.box = priv::combineBoxes(left.box, right.box);
+
+        id = node.parent;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename SpatialIndex<T>::Id SpatialIndex<T>::balance(Id a)
+{
+    if (m_nodes[a].height < 2)
+        return a;
+
+    Id b = m_nodes[a].left;
+    Id c = m_nodes[a].right;
+    int difference = m_nodes[c].height - m_nodes[b].height;
+
+    if ((difference > 1) || (difference < -1))
+    {
+        // Promote the higher child (up) in place of a; a keeps the lower child (low),
+        // and takes the lower grandchild under up, while up keeps the higher one
+        bool rightIsHigher = difference > 1;
+        Id up  = rightIsHigher ? c : b;
+        Id low = rightIsHigher ? b : c;
+        Id f     = m_nodes[up].left;
+        Id g     = m_nodes[up].right;
+        Id kept  = (m_nodes[f].height > m_nodes[g].height) ? f : g;
+        Id moved = (kept == f) ? g : f;
+
+        m_nodes[up].parent = m_nodes[a].parent;
+        replaceChild(m_nodes[up].parent, a, up);
+
+        m_nodes[up].left  = a;
+        m_nodes[up].right = kept;
+        m_nodes[a].parent = up;
+
+        m_nodes[a].left  = rightIsHigher ? low : moved;
+        m_nodes[a].right = rightIsHigher ? moved : low;
+        m_nodes[moved].parent = a;
+
+        Node& nodeA = m_nodes[a];
+        Node& nodeUp = m_nodes[up];
+        nodeA.box = priv::combineBoxes(m_nodes[low].box, m_nodes[moved].box);
+        nodeA.height = 1 + ((m_nodes[low].height > m_nodes[moved].height) ? m_nodes[low].height : m_nodes[moved].height);
+        nodeUp.box = priv::combineBoxes(nodeA.box, m_nodes[kept].box);
+        nodeUp.height = 1 + ((nodeA.height > m_nodes[kept].height) ? nodeA.height : m_nodes[kept].height);
+
+        return up;
+    }
+
+    return a;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SpatialIndex<T>::replaceChild(Id parent, Id oldChild, Id newChild)
+{
+    if (parent == nullId)
+        m_root = newChild;
+    else if (m_nodes[parent].left == oldChild)
+        m_nodes[parent].left = newChild;
+    else
+        m_nodes[parent].right = newChild;
+}
@@ -38,6 +38,7 @@
 namespace sf
 {
 class Texture;
+class TextureArray;
 
 ////////////////////////////////////////////////////////////
 /// \brief Drawable representation of a texture, with its
@@ -98,6 +99,26 @@ public:
     ////////////////////////////////////////////////////////////
     void setTexture(const Texture& texture, bool resetRect = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the sprite to a layer of a texture array
+    ///
+    /// Sprites displaying any layer of the same texture array
+    /// share their render states, so they can be batched
+    /// together. Like textures, the texture array must exist
+    /// as long as the sprite uses it.
+    /// If \a resetRect is true, the TextureRect property of
+    /// the sprite is automatically adjusted to the size of the
+    /// layers. If it is false, the texture rect is left unchanged.
+    ///
+    /// \param textureArray New texture array
+    /// \param layer        Index of the layer to display
+    /// \param resetRect    Should the texture rect be reset to the size of the layers?
+    ///
+    /// \see getTextureArray, getLayer, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const TextureArray& textureArray, unsigned int layer, bool resetRect = false);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the sub-rectangle of the texture that the sprite will display
     ///
@@ -141,6 +162,29 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture* getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture array of the sprite
+    ///
+    /// If the sprite doesn't display a texture array, a NULL
+    /// pointer is returned.
+    ///
+    /// \return Pointer to the sprite's texture array
+    ///
+    /// \see setTexture, getLayer
+    ///
+    ////////////////////////////////////////////////////////////
+    const TextureArray* getTextureArray() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layer of the texture array displayed by the sprite
+    ///
+    /// \return Index of the layer, 0 if the sprite doesn't display a texture array
+    ///
+    /// \see setTexture, getTextureArray
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayer() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the sub-rectangle of the texture displayed by the sprite
     ///
@@ -200,6 +244,16 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the sprite, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the sprite
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the vertices' positions
     ///
@@ -212,12 +266,21 @@ private:
     ////////////////////////////////////////////////////////////
     void updateTexCoords();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the vertices' texture array layer
+    ///
+    /// \param layer Index of the layer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayer(unsigned int layer);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vertex         m_vertices[4]; ///< Vertices defining the sprite's geometry
-    const Texture* m_texture;     ///< Texture of the sprite
-    IntRect        m_textureRect; ///< Rectangle defining the area of the source texture to display
+    Vertex              m_vertices[4];  ///< Vertices defining the sprite's geometry
+    const Texture*      m_texture;      ///< Texture of the sprite
+    const TextureArray* m_textureArray; ///< Texture array of the sprite, replaces the texture when set
+    IntRect             m_textureRect;  ///< Rectangle defining the area of the source texture to display
 };
 
 } // namespace sf
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Sprite;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Set of textured quads sharing one texture,
+///        drawn with a single draw call
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch, with no sprite and no texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture shared by all the sprites of the batch
+    ///
+    /// The texture must exist as long as the batch uses it.
+    /// Pass NULL to draw untextured quads.
+    ///
+    /// \param texture New texture, or NULL
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture shared by all the sprites of the batch
+    ///
+    /// \return Pointer to the texture, NULL if none was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The sprite is a quad of the size of \a textureRect, with
+    /// its top-left corner at the origin of \a transform.
+    /// Sprites are drawn in the order they were added.
+    ///
+    /// \param textureRect Part of the texture to display
+    /// \param transform   Transform of the sprite
+    /// \param color       Global color of the sprite
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const IntRect& textureRect, const Transform& transform, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a copy of an existing sprite to the batch
+    ///
+    /// The texture rect, transform and color of \a sprite are
+    /// used; its texture is ignored, the texture of the batch
+    /// applies to all the sprites.
+    ///
+    /// \param sprite Sprite to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Sprite& sprite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sprites of the batch
+    ///
+    /// The memory used by the sprites is kept, so that
+    /// refilling the batch doesn't allocate.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pre-allocate memory for a number of sprites
+    ///
+    /// \param spriteCount Number of sprites to allocate memory for
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t spriteCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sprites in the batch
+    ///
+    /// \return Number of sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSpriteCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the bounding rectangle of the batch
+    ///
+    /// \return Smallest rectangle containing all the sprites
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the batch, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the batch
+    ///
+    /// \return True if the batch is not empty
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the quads and their indices to the vertex buffer
+    ///
+    /// \return True if the quads can be drawn from the vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;      ///< Texture shared by the sprites
+    std::vector<Vertex>         m_vertices;     ///< Corners of the sprites, 4 per sprite
+    Vector2f                    m_boundsMin;    ///< Top-left corner of the bounds of the sprites
+    Vector2f                    m_boundsMax;    ///< Bottom-right corner of the bounds of the sprites
+    mutable VertexBuffer        m_buffer;       ///< Copy of the quads on the graphics card
+    mutable IndexBuffer         m_indices;      ///< Indices of the two triangles of each quad
+    mutable std::size_t         m_indexedQuads; ///< Number of quads covered by m_indices
+    mutable std::vector<Vertex> m_triangles;    ///< Triangles drawn from memory when m_buffer can't be used
+    mutable bool                m_needsUpload;  ///< Have the sprites changed since they were last uploaded?
+    mutable bool                m_uploaded;     ///< Can the sprites be drawn from m_buffer?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// Every sf::Sprite is its own draw call. When a scene shows
+/// thousands of sprites taken from the same texture (an atlas
+/// or a sprite sheet), sf::SpriteBatch draws them all at once.
+///
+/// Each sprite of the batch is defined by a texture rect, a
+/// transform and a color. The batch keeps 4 vertices per
+/// sprite, uploads them to a streaming sf::VertexBuffer the
+/// next time it is drawn, and draws them as indexed triangles
+/// with a single draw call. The indices never change for a
+/// given number of sprites, so they are only uploaded when the
+/// batch grows; they are 16-bit up to 16384 sprites. When index
+/// buffers are unavailable, or the batch needs 32-bit indices
+/// on OpenGL ES, it is drawn from memory as a list of triangles
+/// instead.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch batch;
+/// batch.setTexture(&atlas);
+///
+/// // each frame
+/// batch.clear();
+/// for (std::size_t i = 0; i < entities.size(); ++i)
+///     batch.add(entities[i].frame, entities[i].getTransform());
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexBuffer, sf::IndexBuffer
+///
+////////////////////////////////////////////////////////////
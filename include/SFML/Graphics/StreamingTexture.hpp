@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STREAMINGTEXTURE_HPP
+#define SFML_STREAMINGTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+
+
+namespace sf
+{
+class ThreadPool;
+
+////////////////////////////////////////////////////////////
+/// \brief Texture whose finest mipmap levels are loaded on demand
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API StreamingTexture : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Residency statistics of a streaming texture
+    ///
+    /// Mipmap levels are numbered from 0 (full size) to
+    /// levelCount - 1 (1 pixel along the largest dimension).
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Residency
+    {
+        unsigned int levelCount;     ///< Total number of mipmap levels
+        unsigned int residentLevel;  ///< Finest level currently on the graphics card
+        unsigned int pinnedLevel;    ///< Finest level that is never evicted
+        unsigned int requestedLevel; ///< Finest level requested by the last call to requestLevel or requestSize
+        bool         loading;        ///< Are finer levels being decoded?
+        Uint64       memory;         ///< Video memory used by the resident levels, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the levels being decoded, if any.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a file
+    ///
+    /// The image is decoded once, and only the mipmap levels
+    /// that are not larger than \a residentSize along their
+    /// largest dimension are uploaded; they stay resident until
+    /// the texture is destroyed. The finer levels are decoded
+    /// again from the file when they are requested.
+    ///
+    /// If the graphics card can't restrict the levels sampled
+    /// from a texture, or doesn't support non power-of-two
+    /// textures, the full texture and its mipmap are loaded
+    /// instead and nothing is streamed.
+    ///
+    /// \param filename     Path of the image file to load
+    /// \param residentSize Largest size of the levels that always stay resident
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename, unsigned int residentSize = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the requested levels on the threads of a pool
+    ///
+    /// Without a pool, the levels are decoded by update(), which
+    /// then blocks until they are ready. The pool must exist as
+    /// long as the texture uses it.
+    ///
+    /// \param pool Thread pool to use, or NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadPool(ThreadPool* pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request the finest mipmap level that will be sampled
+    ///
+    /// This marks the texture as used in the current frame, so
+    /// it must be called every frame while the texture is
+    /// drawn, and the next call to update() loads the missing
+    /// levels. Levels finer than the requested one become the
+    /// first candidates for eviction.
+    ///
+    /// \param level Finest level needed, 0 for the full size
+    ///
+    /// \see requestSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void requestLevel(unsigned int level);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request the levels needed to draw the texture at a given size
+    ///
+    /// This is a shortcut for requestLevel with the coarsest
+    /// level that is at least \a size pixels along the largest
+    /// dimension of the texture.
+    ///
+    /// \param size Size on screen of the largest dimension of the texture, in pixels
+    ///
+    /// \see requestLevel
+    ///
+    ////////////////////////////////////////////////////////////
+    void requestSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture to draw
+    ///
+    /// The texture has the full size of the image, whatever the
+    /// levels resident; texture coordinates don't change when
+    /// levels are loaded or evicted. Its content can't be read
+    /// back or updated.
+    ///
+    /// \return Texture holding the resident levels
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& getTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture to draw
+    ///
+    /// \return Texture holding the resident levels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the residency statistics of the texture
+    ///
+    /// \return Residency of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Residency getResidency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the decoded levels and schedule the requested ones
+    ///
+    /// This function must be called once per frame, by the
+    /// thread that draws the textures. It uploads the levels
+    /// whose decoding is finished, starts decoding the levels
+    /// requested since the last call, and evicts the finest
+    /// levels of the least recently used textures to stay
+    /// within the memory budget.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the video memory budget shared by all the streaming textures
+    ///
+    /// The pinned levels are not subject to the budget: they are
+    /// counted in the resident memory, but never evicted. The
+    /// default budget is 256 MiB.
+    ///
+    /// \param bytes Budget, in bytes
+    ///
+    /// \see getMemoryBudget, getResidentMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setMemoryBudget(Uint64 bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory budget shared by all the streaming textures
+    ///
+    /// \return Budget, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getMemoryBudget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory used by all the streaming textures
+    ///
+    /// \return Memory used by the resident levels, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getResidentMemory();
+
+private:
+
+    struct Load;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a mipmap level
+    ///
+    /// \param level Index of the level
+    ///
+    /// \return Size of the level, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getLevelSize(unsigned int level) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the video memory used by a range of mipmap levels
+    ///
+    /// \param first Finest level of the range
+    /// \param last  Level following the coarsest level of the range
+    ///
+    /// \return Memory used by the levels, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getLevelMemory(unsigned int first, unsigned int last) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload decoded levels and make them the finest sampled ones
+    ///
+    /// \param first  Index of the first uploaded level
+    /// \param levels Decoded images of the levels, from the finest
+    /// \param count  Number of levels to upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadLevels(unsigned int first, const Image* levels, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the finest resident level
+    ///
+    ////////////////////////////////////////////////////////////
+    void evictLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the levels of the finished load, if any
+    ///
+    /// \param block Wait for the load to finish?
+    ///
+    ////////////////////////////////////////////////////////////
+    void finishLoad(bool block);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the finest levels of other textures until enough memory is available
+    ///
+    /// Only the levels that were not requested, or that were
+    /// requested in a previous frame, are evicted.
+    ///
+    /// \param bytes Memory needed, in bytes
+    /// \param keep  Texture whose levels must not be evicted, or NULL
+    ///
+    /// \return True if the memory is available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool reserveMemory(Uint64 bytes, const StreamingTexture* keep);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture      m_texture;        ///< Texture holding the resident levels
+    std::string  m_filename;       ///< File the levels are decoded from
+    Vector2u     m_size;           ///< Size of the full image, in pixels
+    bool         m_streaming;      ///< Are the levels streamed, or is the full texture loaded?
+    unsigned int m_levelCount;     ///< Total number of mipmap levels
+    unsigned int m_residentLevel;  ///< Finest level currently uploaded
+    unsigned int m_pinnedLevel;    ///< Finest level that is never evicted
+    unsigned int m_requestedLevel; ///< Finest level requested by the user
+    Uint64       m_memory;         ///< Video memory used by the resident levels
+    Uint64       m_lastUse;        ///< Frame in which the texture was last requested
+    ThreadPool*  m_threadPool;     ///< Pool that decodes the levels, or NULL
+    Load*        m_load;           ///< Levels being decoded, or NULL
+};
+
+} // namespace sf
+
+
+#endif // SFML_STREAMINGTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StreamingTexture
+/// \ingroup graphics
+///
+/// sf::StreamingTexture keeps large textures, such as the
+/// tiles of a huge map, in video memory only as far as they
+/// are needed. The coarse mipmap levels stay resident, so
+/// that something can always be drawn; the finer levels are
+/// decoded in the background when the texture is requested
+/// at a larger size, and evicted again when the shared memory
+/// budget is exceeded, starting with the textures that were
+/// not requested for the longest time.
+///
+/// Drawing the texture samples the finest level available,
+/// so a texture whose finest levels are not loaded yet (or
+/// were evicted) is displayed blurry instead of stalling the
+/// frame.
+///
+/// Usage example:
+/// \code
+/// sf::ThreadPool pool;
+/// sf::StreamingTexture::setMemoryBudget(128 * 1024 * 1024);
+///
+/// sf::StreamingTexture texture;
+/// if (!texture.loadFromFile("landscape.png"))
+///     return -1;
+/// texture.getTexture().setSmooth(true);
+/// texture.setThreadPool(&pool);
+///
+/// sf::Sprite sprite(texture.getTexture());
+///
+/// while (window.isOpen())
+/// {
+///     // Request the levels needed at the current zoom
+///     texture.requestSize(static_cast<unsigned int>(zoom * texture.getTexture().getSize().x));
+///     sf::StreamingTexture::update();
+///
+///     window.clear();
+///     window.draw(sprite);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::TextureLoader
+///
+////////////////////////////////////////////////////////////
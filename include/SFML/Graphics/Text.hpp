@@ -34,7 +34,9 @@
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Utf8String.hpp>
 #include <string>
 #include <vector>
 
@@ -108,6 +110,22 @@ public:
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string from UTF-8 characters
+    ///
+    /// The characters are decoded while being compared with the
+    /// current string, and only the ones that changed are
+    /// converted to UTF-32: updating a label from the same
+    /// sf::Utf8String every frame costs little when it rarely
+    /// changes.
+    ///
+    /// \param string New string
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const Utf8String& string);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -250,6 +268,28 @@ public:
     ////////////////////////////////////////////////////////////
     void setOutlineThickness(float thickness);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable storing the geometry in a vertex buffer
+    ///
+    /// By default, the vertices of the text are sent to the
+    /// graphics card every time it is drawn. When this setting
+    /// is enabled, they are stored in a static sf::VertexBuffer
+    /// instead, and only uploaded again when the text changes.
+    /// This is faster for texts that rarely change, such as
+    /// labels, but slower for texts that change every frame.
+    ///
+    /// If vertex buffers are not available on the system (see
+    /// sf::VertexBuffer::isAvailable), the text is drawn as if
+    /// this setting was disabled.
+    /// This setting is disabled by default.
+    ///
+    /// \param enabled True to store the geometry in a vertex buffer
+    ///
+    /// \see isVertexBufferEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexBufferEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -367,6 +407,16 @@ public:
     ////////////////////////////////////////////////////////////
     float getOutlineThickness() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the geometry is stored in a vertex buffer
+    ///
+    /// \return True if the geometry is stored in a vertex buffer
+    ///
+    /// \see setVertexBufferEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVertexBufferEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -414,6 +464,24 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the layout before a character
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CharacterLayout
+    {
+        CharacterLayout();
+
+        Vector2f    position;           ///< Pen position, before the kerning with the previous character
+        Vector2f    boundsMin;          ///< Minimum coordinates of the bounds of the previous characters
+        Vector2f    boundsMax;          ///< Maximum coordinates of the bounds of the previous characters
+        std::size_t vertexCount;        ///< Number of fill vertices of the previous characters
+        std::size_t outlineVertexCount; ///< Number of outline vertices of the previous characters
+    };
+
+    struct LayoutCache;
+    friend struct LayoutCache;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -423,15 +491,52 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the text, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the text
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Merge a change of the string with the pending ones
+    ///
+    /// \param begin First character that changed
+    /// \param end   End of the replaced characters (String::InvalidPos if
+    ///              characters were added or removed)
+    ///
+    ////////////////////////////////////////////////////////////
+    void addStringChange(std::size_t begin, std::size_t end);
+
     ////////////////////////////////////////////////////////////
     /// \brief Make sure the text's geometry is updated
     ///
     /// All the attributes related to rendering are cached, such
-    /// that the geometry is only updated when necessary.
+    /// that the geometry is only updated when necessary. When
+    /// only the string changed, the characters before the first
+    /// changed one keep their geometry, and so do the characters
+    /// following replaced ones if their layout isn't affected.
+    /// Layouts rebuilt from scratch are shared with the other
+    /// texts displaying the same string with the same attributes.
     ///
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Lay out the characters starting from a given one
+    ///
+    /// The layout state before \a begin must be valid.
+    ///
+    /// \param begin First character to lay out
+    /// \param end   End of the replaced characters, after which the
+    ///              previous layout can be reused (String::InvalidPos if none)
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateLayout(std::size_t begin, std::size_t end) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -446,9 +551,21 @@ private:
     float               m_outlineThickness;    ///< Thickness of the text's outline
     mutable VertexArray m_vertices;            ///< Vertex array containing the fill geometry
     mutable VertexArray m_outlineVertices;     ///< Vertex array containing the outline geometry
+    mutable std::vector<std::size_t> m_vertexOffsets;        ///< Offset of the fill vertices of each font texture, plus the total count
+    mutable std::vector<std::size_t> m_outlineVertexOffsets; ///< Offset of the outline vertices of each font texture, plus the total count
+    mutable VertexArray m_groupedVertices;     ///< Fill geometry reordered by font texture (empty if m_vertices is already ordered)
+    mutable VertexArray m_groupedOutlineVertices; ///< Outline geometry reordered by font texture (empty if m_outlineVertices is already ordered)
+    mutable std::vector<unsigned int> m_quadTextures;        ///< Font texture of each quad of the fill geometry
+    mutable std::vector<unsigned int> m_outlineQuadTextures; ///< Font texture of each quad of the outline geometry
+    mutable std::vector<CharacterLayout> m_layout; ///< Layout state before each character, plus the final state
+    bool                m_vertexBufferEnabled; ///< Is the geometry stored in a vertex buffer?
+    mutable VertexBuffer m_vertexBuffer;       ///< Vertex buffer containing the outline geometry followed by the fill geometry
+    mutable bool        m_vertexBufferNeedUpdate; ///< Does the vertex buffer need to be uploaded again?
     mutable FloatRect   m_bounds;              ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate;  ///< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       ///< The font texture id
+    mutable bool        m_geometryNeedUpdate;  ///< Does the whole geometry need to be recomputed?
+    mutable std::size_t m_changeBegin;         ///< First character changed since the last geometry update (String::InvalidPos if none)
+    mutable std::size_t m_changeEnd;           ///< End of the replaced characters (String::InvalidPos if characters were added or removed)
+    mutable Uint64      m_fontCacheId;         ///< Id of the font's glyphs the geometry was built with
 };
 
 } // namespace sf
@@ -31,16 +31,23 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <vector>
 
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 class RenderTarget;
 class RenderTexture;
 class Text;
 class Window;
 
+namespace priv
+{
+    struct CompressedImage;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
 ///
@@ -77,6 +84,21 @@ public:
     ////////////////////////////////////////////////////////////
     Texture(const Texture& copy);
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The texture takes over the OpenGL texture of \a right,
+    /// which is left empty; no pixel is copied.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture(Texture&& right) : Texture() {swap(right);}
+
+#endif
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -96,6 +118,30 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture with a given number of mipmap levels
+    ///
+    /// All the levels are allocated up front, as immutable
+    /// storage when the OpenGL implementation supports it
+    /// (ARB_texture_storage): the driver doesn't have to
+    /// validate the texture when it is used, and generateMipmap
+    /// only fills the levels that already exist. Creating the
+    /// texture again gives it a new OpenGL handle.
+    ///
+    /// With a single level, this is the same as create(width, height).
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param width      Width of the texture
+    /// \param height     Height of the texture
+    /// \param levelCount Number of levels, 0 for the complete mipmap chain
+    ///
+    /// \return True if creation was successful
+    ///
+    /// \see generateMipmap
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int levelCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
     ///
@@ -112,6 +158,13 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// Pre-compressed DDS (BC1, BC2, BC3 and BC7) and KTX (BC, ETC2
+    /// and ASTC) files are not decoded: their blocks and mipmap
+    /// levels are uploaded as they are, provided that the graphics
+    /// driver supports the format. The \a area must then cover
+    /// the whole image, and the texture can't be updated with
+    /// pixels afterwards.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -143,6 +196,13 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// Pre-compressed DDS (BC1, BC2, BC3 and BC7) and KTX (BC, ETC2
+    /// and ASTC) files are not decoded: their blocks and mipmap
+    /// levels are uploaded as they are, provided that the graphics
+    /// driver supports the format. The \a area must then cover
+    /// the whole image, and the texture can't be updated with
+    /// pixels afterwards.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -175,6 +235,13 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// Pre-compressed DDS (BC1, BC2, BC3 and BC7) and KTX (BC, ETC2
+    /// and ASTC) files are not decoded: their blocks and mipmap
+    /// levels are uploaded as they are, provided that the graphics
+    /// driver supports the format. The \a area must then cover
+    /// the whole image, and the texture can't be updated with
+    /// pixels afterwards.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -214,6 +281,24 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a view of pixels
+    ///
+    /// The viewed pixels are uploaded as they are, without
+    /// being copied to a temporary array first, even when the
+    /// view is a sub-area of a larger image.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param image View of the pixels to load into the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const ImageView& image);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -277,6 +362,70 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start streaming an update of the whole texture
+    ///
+    /// This function is equivalent to calling
+    /// beginUpdate(getSize().x, getSize().y, 0, 0).
+    ///
+    /// \return Pointer to the memory to fill, or null on failure
+    ///
+    /// \see endUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* beginUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start streaming an update of a part of the texture
+    ///
+    /// This function returns a pointer to a block of
+    /// \a width * \a height 32-bits RGBA pixels that the caller
+    /// fills, for example by decoding an image directly into it.
+    /// The pixels are transferred to the texture when endUpdate
+    /// is called; the pointer is invalid after that.
+    ///
+    /// When pixel buffer objects are supported, the returned
+    /// memory is mapped from a small ring of buffers owned by the
+    /// driver, so the transfer to the texture can happen
+    /// asynchronously and the pixels are never copied on the
+    /// client side. Once a texture has started streaming, regular
+    /// calls to update with an array of pixels go through the
+    /// same buffers. When they are not supported, the memory is a
+    /// client-side staging buffer and endUpdate behaves like
+    /// update.
+    ///
+    /// Only one update can be pending at a time, and the texture
+    /// must not be used for drawing between beginUpdate and
+    /// endUpdate. No additional check is performed on the bounds
+    /// of the area to update, passing invalid arguments will lead
+    /// to an undefined behavior.
+    ///
+    /// This function returns null if the texture was not
+    /// previously created, if the area is empty or if another
+    /// update is already pending.
+    ///
+    /// \param width  Width of the region to update
+    /// \param height Height of the region to update
+    /// \param x      X offset in the texture of the region to update
+    /// \param y      Y offset in the texture of the region to update
+    ///
+    /// \return Pointer to the memory to fill, or null on failure
+    ///
+    /// \see endUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* beginUpdate(unsigned int width, unsigned int height, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish a streamed update and transfer its pixels to the texture
+    ///
+    /// This function does nothing if no update is pending.
+    ///
+    /// \see beginUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    void endUpdate();
+
     ////////////////////////////////////////////////////////////
     /// \brief Update a part of this texture from another texture
     ///
@@ -314,6 +463,30 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Texture& texture, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a part of another texture into this texture on the graphics card
+    ///
+    /// Unlike update(const Texture&), this function never
+    /// downloads the pixels to system memory: the copy is done
+    /// with glCopyImageSubData where available, and with a
+    /// framebuffer blit otherwise. If neither is supported, or
+    /// if either texture was not previously created, nothing
+    /// is copied and false is returned.
+    ///
+    /// No additional check is performed on the rectangles,
+    /// passing a source area outside \a texture or a destination
+    /// that doesn't fit in this texture will lead to an
+    /// undefined behavior.
+    ///
+    /// \param texture     Source texture to copy from
+    /// \param sourceRect  Area of the source texture to copy
+    /// \param destination Position in this texture where to copy the area
+    ///
+    /// \return True if the area was copied
+    ///
+    ////////////////////////////////////////////////////////////
+    bool copyFrom(const Texture& texture, const IntRect& sourceRect, const Vector2u& destination);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from an image
     ///
@@ -351,6 +524,39 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the texture from a view of pixels
+    ///
+    /// Strided views are uploaded directly, the driver skips
+    /// the gaps between their rows. No additional check is
+    /// performed on the size of the view, passing a view
+    /// bigger than the texture will lead to an undefined behavior.
+    ///
+    /// This function does nothing if the texture was not
+    /// previously created.
+    ///
+    /// \param image View of the pixels to copy to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from a view of pixels
+    ///
+    /// No additional check is performed on the size of the view,
+    /// passing an invalid combination of view size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// This function does nothing if the texture was not
+    /// previously created.
+    ///
+    /// \param image View of the pixels to copy to the texture
+    /// \param x     X offset in the texture where to copy the pixels
+    /// \param y     Y offset in the texture where to copy the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& image, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from the contents of a window
     ///
@@ -503,6 +709,11 @@ public:
     /// modified, at which point this function will have to be called again to
     /// regenerate it.
     ///
+    /// Generating the mipmap of a large texture takes time: to
+    /// keep it out of the frames, create the texture with all
+    /// its levels up front and generate them at load time, for
+    /// example through sf::TextureLoader.
+    ///
     /// \return True if mipmap generation was successful, false if unsuccessful
     ///
     ////////////////////////////////////////////////////////////
@@ -518,6 +729,23 @@ public:
     ////////////////////////////////////////////////////////////
     Texture& operator =(const Texture& right);
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// The previous OpenGL texture is destroyed and \a right
+    /// is left empty.
+    ///
+    /// \param right Instance to move
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& operator =(Texture&& right) {Texture temp; temp.swap(right); swap(temp); return *this;}
+
+#endif
+
     ////////////////////////////////////////////////////////////
     /// \brief Swap the contents of this texture with those of another
     ///
@@ -588,6 +816,27 @@ private:
     friend class Text;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class RenderWindow;
+    friend class TextureReader;
+    friend class StreamingTexture;
+    friend class VideoTexture;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture with a specific internal format
+    ///
+    /// sf::RenderTexture uses this for its floating point
+    /// attachments. The format is not preserved when the
+    /// texture is copied.
+    ///
+    /// \param width          Width of the texture
+    /// \param height         Height of the texture
+    /// \param internalFormat OpenGL internal format, 0 for the default RGBA (or sRGB) format
+    /// \param levelCount     Number of levels to allocate, immutable storage is used when greater than 1
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int internalFormat, unsigned int levelCount);
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -613,6 +862,26 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a pre-compressed image
+    ///
+    /// \param image Compressed image to upload
+    /// \param area  Area of the image to load, must be empty or cover the whole image
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedImage(const priv::CompressedImage& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve the pending antialiased content of the render-texture this texture belongs to
+    ///
+    /// This function must be called before the pixels of the
+    /// texture are used in any way.
+    ///
+    ////////////////////////////////////////////////////////////
+    void resolveRenderTexture() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -625,7 +894,16 @@ private:
     mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     ///< Has the mipmap been generated?
+    bool         m_immutable;     ///< Is the texture allocated as immutable storage?
+    unsigned int m_internalFormat; ///< OpenGL internal format the texture was created with, 0 for the default one
     Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    RenderTexture*            m_resolveSource;    ///< Render-texture that still has to resolve its antialiased content into this texture
+    std::vector<unsigned int> m_pixelBuffers;     ///< Ring of pixel buffer objects used to stream updates
+    std::size_t               m_pixelBufferIndex; ///< Index of the pixel buffer used by the last update
+    std::vector<Uint8>        m_updatePixels;     ///< Staging memory used when pixel buffers are not available
+    IntRect                   m_updateArea;       ///< Area of the texture covered by the pending update
+    bool                      m_updating;         ///< Is an update pending?
+    bool                      m_updateMapped;     ///< Is the pending update written to a mapped pixel buffer?
 };
 
 } // namespace sf
@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Stack of images of the same size living on the
+///        graphics card, that can be drawn in a single batch
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// If this function fails, the texture array is left unchanged.
+    ///
+    /// \param width      Width of the layers
+    /// \param height     Height of the layers
+    /// \param layerCount Number of layers
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layerCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the layers of the texture array
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers of the texture array
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer of the texture array from an array of pixels
+    ///
+    /// The \a pixel array is assumed to have the same size as
+    /// the layers, and to contain 32-bits RGBA pixels.
+    ///
+    /// This function does nothing if \a pixels is null, if the
+    /// layer doesn't exist or if the texture array was not
+    /// previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param layer  Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer of the texture array from an array of pixels
+    ///
+    /// The size of the \a pixel array must match the \a width and
+    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    ///
+    /// No additional check is performed on the size of the pixel
+    /// array or the bounds of the area to update, passing invalid
+    /// arguments will lead to an undefined behavior.
+    ///
+    /// This function does nothing if \a pixels is null, if the
+    /// layer doesn't exist or if the texture array was not
+    /// previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the layer where to copy the source pixels
+    /// \param y      Y offset in the layer where to copy the source pixels
+    /// \param layer  Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a layer of the texture array from an image
+    ///
+    /// No additional check is performed on the size of the image,
+    /// passing an image bigger than the layers will lead to an
+    /// undefined behavior.
+    ///
+    /// \param image Image to copy to the layer
+    /// \param layer Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Image& image, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// The smooth filter is disabled by default. It can't be
+    /// changed anymore once a bindless handle has been created.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable repeating
+    ///
+    /// Repeating is disabled by default. It can't be changed
+    /// anymore once a bindless handle has been created.
+    ///
+    /// \param repeated True to repeat the layers, false to disable repeating
+    ///
+    /// \see isRepeated
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRepeated(bool repeated);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the layers are repeated or not
+    ///
+    /// \return True if repeat mode is enabled, false if it is disabled
+    ///
+    /// \see setRepeated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRepeated() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate a mipmap for every layer using the current contents
+    ///
+    /// Like Texture::generateMipmap, the mipmap is invalidated
+    /// when the texture array is updated.
+    ///
+    /// \return True if mipmap generation was successful, false if unsuccessful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool generateMipmap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the texture array
+    ///
+    /// \return OpenGL handle of the texture array or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a bindless handle of the texture array
+    ///
+    /// When ARB_bindless_texture is supported, this function
+    /// creates a handle that shaders can sample from without
+    /// the texture array being bound, and makes it resident.
+    /// The handle can be passed to a shader with
+    /// Shader::setUniform(name, Shader::BindlessHandle(...)).
+    ///
+    /// Once the handle exists, the sampling parameters (smooth
+    /// filter, repeat mode and mipmap) are frozen.
+    ///
+    /// \return Bindless handle, or 0 if bindless textures are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getBindlessHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether texture arrays are supported
+    ///
+    /// \return True if texture arrays can be used, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of layers of a texture array
+    ///
+    /// \return Maximum number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumLayerCount();
+
+private:
+
+    friend class RenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the filter and repeat parameters to the bound texture array
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyParameters();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u       m_size;           ///< Size of the layers
+    unsigned int   m_layerCount;     ///< Number of layers
+    unsigned int   m_texture;        ///< Internal texture identifier
+    bool           m_isSmooth;       ///< Status of the smooth filter
+    bool           m_isRepeated;     ///< Is the texture array in repeat mode?
+    bool           m_hasMipmap;      ///< Has the mipmap been generated?
+    mutable Uint64 m_bindlessHandle; ///< Resident bindless handle, 0 if none was created
+    Uint64         m_cacheId;        ///< Unique number that identifies the texture array to the render target's cache
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// sf::TextureArray holds several images of the same size,
+/// its layers, in a single texture object. Since drawing with
+/// different layers doesn't require binding another texture,
+/// geometry mapping different images can be batched together:
+/// each vertex selects its layer with its sf::Vertex::layer
+/// attribute, and texture coordinates are given in pixels as
+/// with sf::Texture.
+///
+/// A texture array is drawn by setting it in the render states
+/// instead of a texture. Without a custom shader, SFML uses a
+/// built-in shader that samples the array. Custom shaders must
+/// declare a sampler2DArray bound to texture unit 0, and read
+/// the layer from the third texture coordinate. As with
+/// sf::Texture, the texture matrix converts the first two
+/// coordinates from pixels to normalized coordinates.
+///
+/// Texture arrays require OpenGL 3.0 class hardware, check
+/// isAvailable before using them. Sprites can use a layer of
+/// a texture array with sf::Sprite::setTexture.
+///
+/// Usage example:
+/// \code
+/// sf::TextureArray tiles;
+/// if (!tiles.create(64, 64, 3))
+///     return -1;
+/// tiles.update(grassImage, 0);
+/// tiles.update(waterImage, 1);
+/// tiles.update(sandImage, 2);
+///
+/// // Sprites using any layer of the array are batched together
+/// sf::Sprite grass, water;
+/// grass.setTexture(tiles, 0, true);
+/// water.setTexture(tiles, 1, true);
+///
+/// window.setBatchingEnabled(true);
+/// window.draw(grass);
+/// window.draw(water);
+/// \endcode
+///
+/// \see sf::Texture, sf::Vertex, sf::Sprite
+///
+////////////////////////////////////////////////////////////
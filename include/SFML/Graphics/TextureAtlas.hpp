@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Texture into which many small images are packed
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty atlas, its texture is created on
+    /// the first insertion.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture of the atlas
+    ///
+    /// Any image previously added to the atlas is discarded.
+    /// The texture grows when it gets full, so \a width and
+    /// \a height only need to be a reasonable first guess.
+    ///
+    /// \param width  Initial width of the texture
+    /// \param height Initial height of the texture
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The image is packed into the free space of the texture
+    /// and uploaded to it. When there's no room left, the size
+    /// of the texture is doubled; previously returned rectangles
+    /// stay valid, and so do the sprites using the texture.
+    ///
+    /// \param image Image to add
+    /// \param rect  Receives the rectangle of the image within the texture
+    ///
+    /// \return True if the image was added, false if the texture
+    ///         has reached its maximum size
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(const Image& image, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add several images to the atlas
+    ///
+    /// The images are packed from the tallest to the shortest,
+    /// which fills the texture more tightly than adding them
+    /// one by one in an arbitrary order. Prefer this function
+    /// when all the images are known at load time.
+    ///
+    /// \param images Pointer to the array of images to add
+    /// \param count  Number of images in the array
+    /// \param rects  Pointer to an array of \a count rectangles,
+    ///               receiving the rectangle of each image
+    ///
+    /// \return True if all the images were added, false if the
+    ///         texture has reached its maximum size; the rectangles
+    ///         of the images that didn't fit are left empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(const Image* images, std::size_t count, IntRect* rects);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the space left between the packed images
+    ///
+    /// With smooth filtering, sprites sample the pixels next
+    /// to their texture rectangle; the padding keeps them
+    /// transparent. It only applies to the images added after
+    /// calling this function.
+    ///
+    /// The default padding is 1 pixel.
+    ///
+    /// \param padding Space between the images, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPadding(unsigned int padding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the space left between the packed images
+    ///
+    /// \return Space between the images, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPadding() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the texture
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see Texture::setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture containing the packed images
+    ///
+    /// The texture object stays the same when it grows, so
+    /// it can be passed once to the sprites.
+    ///
+    /// \return Texture of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        Segment(unsigned int segmentX, unsigned int segmentY, unsigned int segmentWidth) : x(segmentX), y(segmentY), width(segmentWidth) {}
+
+        unsigned int x;     ///< X position of the segment into the texture
+        unsigned int y;     ///< Y position of the first free pixel under the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find room for a rectangle, growing the texture if needed
+    ///
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the rectangle within the texture
+    ///
+    /// \return True if the rectangle fits in the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    bool findRect(unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Double the size of the texture, keeping its contents
+    ///
+    /// \return True if the texture grew, false if it has reached its maximum size
+    ///
+    ////////////////////////////////////////////////////////////
+    bool grow();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture              m_texture; ///< Texture containing the packed images
+    std::vector<Segment> m_skyline; ///< Top edge of the packed images, segments covering the whole width of the texture
+    unsigned int         m_padding; ///< Space left between the images
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Drawing sprites that use different textures breaks the
+/// batching of sf::RenderTarget, since each texture change
+/// requires a separate draw call. sf::TextureAtlas packs many
+/// small images into a single texture, so that the sprites
+/// using them can be drawn together.
+///
+/// Each added image gets a rectangle within the texture of
+/// the atlas, to pass to sf::Sprite::setTextureRect. Images
+/// can be added at any time: the texture is updated in
+/// place, and its size is doubled when it gets full, which
+/// doesn't invalidate the existing rectangles.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Image> images(3);
+/// images[0].loadFromFile("player.png");
+/// images[1].loadFromFile("enemy.png");
+/// images[2].loadFromFile("bullet.png");
+///
+/// sf::TextureAtlas atlas;
+/// std::vector<sf::IntRect> rects(images.size());
+/// if (!atlas.add(&images[0], images.size(), &rects[0]))
+///     return -1;
+///
+/// sf::Sprite player(atlas.getTexture(), rects[0]);
+/// sf::Sprite enemy(atlas.getTexture(), rects[1]);
+///
+/// // Later, add another image
+/// sf::Image bonus;
+/// bonus.loadFromFile("bonus.png");
+/// sf::IntRect bonusRect;
+/// atlas.add(bonus, bonusRect);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTURELOADER_HPP
+#define SFML_TEXTURELOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Config.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Load textures from image files in background threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a requested texture
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Handle;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Progress of a requested texture
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Decoding,  ///< The image is waiting to be decoded, or being decoded
+        Uploading, ///< The image is decoded and waits for update() to create the texture
+        Ready,     ///< The texture is ready to be taken
+        Failed     ///< The image couldn't be loaded, or the handle is unknown
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the loader
+    ///
+    /// When \a uploadInThreads is false, the textures are
+    /// created by update() in the thread that calls it (usually
+    /// the rendering thread). When it is true, each worker
+    /// thread activates its own OpenGL context, shared with the
+    /// others, and creates the textures itself; update() is not
+    /// needed then.
+    ///
+    /// \param threadCount     Maximum number of worker threads decoding images
+    /// \param uploadInThreads Create the textures in the worker threads?
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureLoader(unsigned int threadCount = 2, bool uploadInThreads = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the images being decoded, and discards all
+    /// the requests and textures that were not taken.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a texture loaded from a file
+    ///
+    /// This function returns immediately, the image is decoded
+    /// by a worker thread. See Texture::loadFromFile for the
+    /// supported formats and the meaning of \a area.
+    ///
+    /// When \a mipmap is true, the texture is created with its
+    /// complete mipmap chain (see Texture::create), which is
+    /// generated when the texture is created: by update(), within
+    /// its budget, or by the worker threads. The cost is paid at
+    /// load time instead of in the frame that first needs it.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param area     Area of the image to load
+    /// \param mipmap   Generate the mipmap of the texture?
+    ///
+    /// \return Handle identifying the requested texture
+    ///
+    /// \see loadFromMemory, getStatus, takeTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle loadFromFile(const std::string& filename, const IntRect& area = IntRect(), bool mipmap = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a texture loaded from a file in memory
+    ///
+    /// This function returns immediately, the image is decoded
+    /// by a worker thread. The data is copied, it doesn't need
+    /// to remain valid after the call.
+    ///
+    /// \param data   Pointer to the file data in memory
+    /// \param size   Size of the data to load, in bytes
+    /// \param area   Area of the image to load
+    /// \param mipmap Generate the mipmap of the texture?
+    ///
+    /// \return Handle identifying the requested texture
+    ///
+    /// \see loadFromFile, getStatus, takeTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle loadFromMemory(const void* data, std::size_t size, const IntRect& area = IntRect(), bool mipmap = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the textures of the decoded images
+    ///
+    /// This function must be called regularly (every frame for
+    /// example) by a thread with an active OpenGL context, unless
+    /// the textures are created in the worker threads. To avoid
+    /// stalling a frame, at most \a maxTextures textures are
+    /// created per call.
+    ///
+    /// \param maxTextures Maximum number of textures to create
+    ///
+    /// \return Number of textures created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int update(unsigned int maxTextures = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress of a requested texture
+    ///
+    /// \param handle Handle of the texture
+    ///
+    /// \return Status of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the requested textures are ready or failed
+    ///
+    /// \return True if no texture is being decoded or uploaded
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isIdle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a texture once it is ready
+    ///
+    /// The loaded texture is swapped into \a texture, and the
+    /// loader forgets the handle. Nothing happens if the
+    /// texture is not ready.
+    ///
+    /// \param handle  Handle of the texture
+    /// \param texture Texture receiving the loaded one
+    ///
+    /// \return True if the texture was ready
+    ///
+    ////////////////////////////////////////////////////////////
+    bool takeTexture(Handle handle, Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard a requested texture
+    ///
+    /// The request is cancelled if the image is not decoded
+    /// yet. Failed requests must be released too.
+    ///
+    /// \param handle Handle of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Handle handle);
+
+private:
+
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image to decode
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Request
+    {
+        Handle            handle;   ///< Handle of the requested texture
+        std::string       filename; ///< File to load, empty if loading from memory
+        std::vector<char> data;     ///< Copy of the file data, when loading from memory
+        IntRect           area;     ///< Area of the image to load
+        bool              mipmap;   ///< Generate the mipmap of the texture?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Requested texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Status   status;  ///< Progress of the texture
+        Image*   image;   ///< Decoded image, NULL until it is decoded or once the texture is created
+        IntRect  area;    ///< Area of the image to load
+        bool     mipmap;  ///< Generate the mipmap of the texture?
+        Texture* texture; ///< Created texture, NULL until it is ready
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a request and start a worker if needed
+    ///
+    /// \param request Request to queue, its handle is assigned
+    ///
+    /// \return Handle of the requested texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle push(Request& request);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the worker threads
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture of a decoded image
+    ///
+    /// \param image  Decoded image, already cropped when \a mipmap is true
+    /// \param area   Area of the image to load
+    /// \param mipmap Generate the mipmap of the texture?
+    ///
+    /// \return New texture, or NULL if it couldn't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    static Texture* createTexture(const Image& image, const IntRect& area, bool mipmap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the queued images until there are none left
+    ///
+    /// \param worker Worker running the function
+    ///
+    ////////////////////////////////////////////////////////////
+    void decode(Worker& worker);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Handle, Entry> EntryTable; ///< Requested textures, indexed by handle
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable Mutex        m_mutex;           ///< Mutex protecting the requests and the entries
+    std::vector<Worker*> m_workers;         ///< Worker threads decoding images
+    std::deque<Request>  m_requests;        ///< Images waiting to be decoded
+    EntryTable           m_entries;         ///< Requested textures
+    Handle               m_nextHandle;      ///< Handle of the next requested texture
+    bool                 m_uploadInThreads; ///< Are the textures created by the worker threads?
+    bool                 m_cancelled;       ///< Must the worker threads stop as soon as possible?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURELOADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureLoader
+/// \ingroup graphics
+///
+/// sf::TextureLoader loads textures without blocking the
+/// thread that requests them: the image files are decoded
+/// by a pool of worker threads, and the decoded pixels are
+/// then uploaded to textures, either by the update function
+/// (called by the rendering thread) or directly by the worker
+/// threads through their own shared OpenGL contexts.
+///
+/// Every request returns a handle, that is used to query the
+/// progress of the texture and to take it once it is ready.
+///
+/// Usage example:
+/// \code
+/// sf::TextureLoader loader;
+/// sf::TextureLoader::Handle background = loader.loadFromFile("background.png");
+/// sf::TextureLoader::Handle tiles = loader.loadFromFile("tiles.png");
+///
+/// // Keep displaying the loading screen until the textures are ready
+/// while (!loader.isIdle())
+/// {
+///     loader.update();
+///
+///     window.clear();
+///     window.draw(loadingScreen);
+///     window.display();
+/// }
+///
+/// sf::Texture backgroundTexture;
+/// if (!loader.takeTexture(background, backgroundTexture))
+/// {
+///     // error...
+///     loader.release(background);
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::Image
+///
+////////////////////////////////////////////////////////////
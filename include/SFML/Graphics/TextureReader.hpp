@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREREADER_HPP
+#define SFML_TEXTUREREADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/Config.hpp>
+#include <map>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Read back the pixels of textures and render targets
+///        without stalling the rendering
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureReader : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a requested readback
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Handle;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Progress of a requested readback
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Pending, ///< The GPU hasn't finished copying the pixels yet
+        Ready,   ///< The pixels are available and the image can be taken
+        Failed   ///< The pixels couldn't be read, or the handle is unknown
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureReader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the readbacks that were not taken are released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureReader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a readback of the contents of a texture
+    ///
+    /// The pixels are copied by the GPU into a pixel buffer
+    /// object, this function returns without waiting for the
+    /// copy to complete.
+    ///
+    /// \param texture Texture to read
+    ///
+    /// \return Handle of the readback
+    ///
+    /// \see takeImage
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle read(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a readback of the contents of a render target
+    ///
+    /// This function reads what has been drawn to the target
+    /// so far, it must be called before the target is displayed.
+    /// It can be used to take screenshots of a render window
+    /// without stalling the rendering. The target is activated
+    /// and its pending batched geometry is flushed.
+    ///
+    /// \param target Render target to read
+    ///
+    /// \return Handle of the readback
+    ///
+    /// \see takeImage
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle read(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress of a readback
+    ///
+    /// This function doesn't wait for the GPU.
+    ///
+    /// \param handle Handle of the readback
+    ///
+    /// \return Current status of the readback
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(Handle handle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the image of a completed readback
+    ///
+    /// If the readback is ready, the pixels are copied to
+    /// \a image and the readback is released. Otherwise, this
+    /// function returns false and leaves \a image unchanged: call
+    /// it again a few frames later.
+    ///
+    /// \param handle Handle of the readback
+    /// \param image  Image to fill with the pixels
+    ///
+    /// \return True if the image was taken
+    ///
+    ////////////////////////////////////////////////////////////
+    bool takeImage(Handle handle, Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release a readback, whatever its status
+    ///
+    /// \param handle Handle of the readback to release
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Handle handle);
+
+private:
+
+    struct Readback;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a readback and get its handle
+    ///
+    /// \param readback Readback to register, or NULL if it failed
+    ///
+    /// \return Handle of the readback
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle push(Readback* readback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the pixels of the bound framebuffer
+    ///        or texture into a new pixel buffer
+    ///
+    /// \param width   Width of the pixels to copy
+    /// \param height  Height of the pixels to copy
+    /// \param texture True to read the bound texture, false to read the bound framebuffer
+    ///
+    /// \return New readback, or NULL if pixel buffers are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    static Readback* startTransfer(unsigned int width, unsigned int height, bool texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy a readback and its OpenGL objects
+    ///
+    /// \param readback Readback to destroy
+    ///
+    ////////////////////////////////////////////////////////////
+    static void destroy(Readback* readback);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Handle, Readback*> ReadbackTable; ///< Requested readbacks, indexed by handle
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ReadbackTable m_readbacks;  ///< Requested readbacks
+    Handle        m_nextHandle; ///< Handle of the next readback
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREREADER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureReader
+/// \ingroup graphics
+///
+/// Texture::copyToImage waits until the GPU has rendered
+/// everything that the texture depends on, and then until the
+/// pixels are transferred back to the client. sf::TextureReader
+/// splits this into two steps: read() queues the copy into a
+/// pixel buffer object and guards it with a fence, and
+/// takeImage() picks up the pixels once the fence is signaled,
+/// typically a frame or two later. This makes it suitable for
+/// thumbnails, screenshots and video recording.
+///
+/// When pixel buffer objects are not supported (for example
+/// on OpenGL ES), read() falls back to a synchronous readback
+/// and the image is ready immediately. When fences are not
+/// supported, readbacks are reported as ready right away and
+/// takeImage() may have to wait for the transfer.
+///
+/// sf::TextureReader is not thread-safe, it is meant to be
+/// used in the rendering thread.
+///
+/// Usage example:
+/// \code
+/// sf::TextureReader reader;
+/// std::deque<sf::TextureReader::Handle> frames;
+///
+/// while (window.isOpen())
+/// {
+///     window.clear();
+///     window.draw(scene);
+///
+///     // Capture this frame, and encode the frames that are ready
+///     frames.push_back(reader.read(window));
+///     while (!frames.empty() && (reader.getStatus(frames.front()) != sf::TextureReader::Pending))
+///     {
+///         sf::Image image;
+///         if (reader.takeImage(frames.front(), image))
+///             recorder.encode(image);
+///         else
+///             reader.release(frames.front());
+///         frames.pop_front();
+///     }
+///
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::Image, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles taken from a tileset texture,
+///        stored and drawn in chunks
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tile map, with no tile and no tileset.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the tile map
+    ///
+    /// All the tiles are initially empty. The map is divided in
+    /// square chunks of \a chunkSize x \a chunkSize tiles, which
+    /// are stored on the graphics card and updated independently:
+    /// changing a tile only rebuilds the chunk that contains it,
+    /// and only the chunks that overlap the view are drawn.
+    ///
+    /// \param mapSize   Size of the map, in tiles
+    /// \param tileSize  Size of a tile, in pixels of the tileset
+    /// \param chunkSize Size of the side of a chunk, in tiles
+    ///
+    /// \return True if the map was created, false if a size is zero
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const Vector2u& mapSize, const Vector2u& tileSize, unsigned int chunkSize = 32);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset texture of the map
+    ///
+    /// The tileset is a texture where the tiles are laid out
+    /// from left to right and top to bottom, tile 0 being at
+    /// the top-left corner. The texture argument refers to a
+    /// texture that must exist as long as the map uses it.
+    ///
+    /// \param texture New tileset texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture of the map
+    ///
+    /// \return Pointer to the tileset texture, NULL if none was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile of the map
+    ///
+    /// Setting a negative index leaves the cell empty.
+    ///
+    /// \param x    Column of the tile
+    /// \param y    Row of the tile
+    /// \param tile Index of the tile in the tileset, or -1 for no tile
+    ///
+    /// \see getTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, int tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles of the map at once
+    ///
+    /// \a tiles must point to mapSize.x * mapSize.y indices,
+    /// stored row by row.
+    ///
+    /// \param tiles Indices of the tiles in the tileset, negative for no tile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const int* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile of the map
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Index of the tile in the tileset, -1 if the cell is empty
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    int getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the map
+    ///
+    /// \return Size of the map, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getMapSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the tiles
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2u& getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// \return Local bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// \return Global bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a square block of tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        Chunk();
+
+        VertexBuffer        buffer;      ///< Vertices of the chunk, on the graphics card
+        std::vector<Vertex> vertices;    ///< Vertices of the chunk, used when vertex buffers are not available
+        std::size_t         vertexCount; ///< Number of vertices of the chunk
+        bool                dirty;       ///< Must the geometry of the chunk be rebuilt?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the tile map to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the tile map, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the tile map
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the geometry of a chunk
+    ///
+    /// \param chunkX Column of the chunk
+    /// \param chunkY Row of the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunk(unsigned int chunkX, unsigned int chunkY) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark all the chunks as needing to be rebuilt
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateChunks();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                    m_mapSize;    ///< Size of the map, in tiles
+    Vector2u                    m_tileSize;   ///< Size of a tile, in pixels
+    unsigned int                m_chunkSize;  ///< Size of the side of a chunk, in tiles
+    Vector2u                    m_chunkCount; ///< Number of chunks in each direction
+    const Texture*              m_texture;    ///< Tileset texture
+    std::vector<int>            m_tiles;      ///< Indices of the tiles, row by row
+    mutable std::vector<Chunk>  m_chunks;     ///< Geometry of the chunks, row by row
+    mutable std::vector<Vertex> m_scratch;    ///< Temporary storage used to rebuild the chunks stored in vertex buffers
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap displays a large grid of tiles, all taken from
+/// a single tileset texture. It is the efficient replacement
+/// for drawing a sprite per tile or rebuilding a big
+/// sf::VertexArray every frame.
+///
+/// The map is split in chunks. The geometry of each chunk is
+/// built once and stored in a static sf::VertexBuffer, so that
+/// it stays on the graphics card from one frame to the next.
+/// Changing a tile only rebuilds its chunk, the next time the
+/// map is drawn. When drawing, only the chunks which overlap
+/// the view of the render target are submitted, so the cost
+/// of a frame depends on what is visible, not on the size of
+/// the map. If vertex buffers are not supported, the chunks
+/// are kept in memory and drawn as vertex arrays.
+///
+/// sf::TileMap inherits the functions of sf::Transformable,
+/// so that the whole map can be moved, rotated or scaled.
+///
+/// Like sf::Sprite, a tile map only keeps a pointer to its
+/// tileset: the texture must stay alive as long as the map
+/// uses it.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(1024, 1024), sf::Vector2u(16, 16));
+/// map.setTexture(tileset);
+///
+/// for (unsigned int y = 0; y < 1024; ++y)
+///     for (unsigned int x = 0; x < 1024; ++x)
+///         map.setTile(x, y, level[y][x]);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::Sprite
+///
+////////////////////////////////////////////////////////////
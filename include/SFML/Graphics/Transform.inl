@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+inline Transform::Transform()
+{
+    // Identity matrix
+    m_matrix[0] = 1.f; m_matrix[4] = 0.f; m_matrix[8]  = 0.f; m_matrix[12] = 0.f;
+    m_matrix[1] = 0.f; m_matrix[5] = 1.f; m_matrix[9]  = 0.f; m_matrix[13] = 0.f;
+    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
+    m_matrix[3] = 0.f; m_matrix[7] = 0.f; m_matrix[11] = 0.f; m_matrix[15] = 1.f;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Transform::Transform(float a00, float a01, float a02,
+                     float a10, float a11, float a12,
+                     float a20, float a21, float a22)
+{
+    m_matrix[0] = a00; m_matrix[4] = a01; m_matrix[8]  = 0.f; m_matrix[12] = a02;
+    m_matrix[1] = a10; m_matrix[5] = a11; m_matrix[9]  = 0.f; m_matrix[13] = a12;
+    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
+    m_matrix[3] = a20; m_matrix[7] = a21; m_matrix[11] = 0.f; m_matrix[15] = a22;
+}
+
+
+////////////////////////////////////////////////////////////
+inline const float* Transform::getMatrix() const
+{
+    return m_matrix;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Vector2f Transform::transformPoint(float x, float y) const
+{
+    return Vector2f(m_matrix[0] * x + m_matrix[4] * y + m_matrix[12],
+                    m_matrix[1] * x + m_matrix[5] * y + m_matrix[13]);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Vector2f Transform::transformPoint(const Vector2f& point) const
+{
+    return transformPoint(point.x, point.y);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Transform& Transform::combine(const Transform& transform)
+{
+    float* a = m_matrix;
+    const float* b = transform.m_matrix;
+
+    // Affine transforms (the common case in 2D) only need their 2x3 part to be combined
+    if ((a[3] == 0.f) && (a[7] == 0.f) && (a[15] == 1.f) &&
+        (b[3] == 0.f) && (b[7] == 0.f) && (b[15] == 1.f))
+    {
+        float a00 = a[0] * b[0]  + a[4] * b[1];
+        float a01 = a[0] * b[4]  + a[4] * b[5];
+        float a02 = a[0] * b[12] + a[4] * b[13] + a[12];
+        float a10 = a[1] * b[0]  + a[5] * b[1];
+        float a11 = a[1] * b[4]  + a[5] * b[5];
+        float a12 = a[1] * b[12] + a[5] * b[13] + a[13];
+
+        a[0] = a00; a[4] = a01; a[12] = a02;
+        a[1] = a10; a[5] = a11; a[13] = a12;
+
+        return *this;
+    }
+
+    *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
+                      a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
+                      a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
+                      a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
+                      a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
+                      a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
+                      a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
+                      a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
+                      a[3] * b[12] + a[7] * b[13] + a[15] * b[15]);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Transform operator *(const Transform& left, const Transform& right)
+{
+    return Transform(left).combine(right);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Transform& operator *=(Transform& left, const Transform& right)
+{
+    return left.combine(right);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Vector2f operator *(const Transform& left, const Vector2f& right)
+{
+    return left.transformPoint(right);
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool operator ==(const Transform& left, const Transform& right)
+{
+    const float* a = left.getMatrix();
+    const float* b = right.getMatrix();
+
+    return ((a[0]  == b[0])  && (a[1]  == b[1])  && (a[3]  == b[3]) &&
+            (a[4]  == b[4])  && (a[5]  == b[5])  && (a[7]  == b[7]) &&
+            (a[12] == b[12]) && (a[13] == b[13]) && (a[15] == b[15]));
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool operator !=(const Transform& left, const Transform& right)
+{
+    return !(left == right);
+}
@@ -313,6 +313,8 @@ public:
 
 private:
 
+    friend class Node;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -324,6 +326,7 @@ private:
     mutable bool      m_transformNeedUpdate;        ///< Does the transform need to be recomputed?
     mutable Transform m_inverseTransform;           ///< Combined transformation of the object
     mutable bool      m_inverseTransformNeedUpdate; ///< Does the transform need to be recomputed?
+    Uint32            m_transformVersion;           ///< Incremented every time the transform changes, for sf::Node
 };
 
 } // namespace sf
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_UPLOADQUEUE_HPP
+#define SFML_UPLOADQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Config.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Context;
+
+////////////////////////////////////////////////////////////
+/// \brief Run OpenGL resource uploads in background threads
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UploadQueue : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a submitted job
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 Handle;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Progress of a submitted job
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Queued,    ///< The job is waiting for a worker thread, or running
+        Submitted, ///< The job has run, the GPU is still executing its commands
+        Complete   ///< The resources created or updated by the job can be used
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue and launch its worker threads
+    ///
+    /// Each job runs with one of the loader contexts of the
+    /// queue active. They share their resources with every
+    /// other context, and are created when they are first
+    /// needed, so there are never more of them than worker
+    /// threads.
+    ///
+    /// \param threadCount Number of worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit UploadQueue(unsigned int threadCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits until every queued job has run, then destroys the
+    /// loader contexts.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UploadQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a functor (or free function) with no argument
+    ///
+    /// The functor is copied into the queue and run by the
+    /// first worker thread that becomes available.
+    ///
+    /// \param functor Functor or free function to run
+    ///
+    /// \return Handle identifying the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Handle push(F functor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a functor (or free function) with one argument
+    ///
+    /// \param function Functor or free function to run
+    /// \param argument Argument to forward to the function
+    ///
+    /// \return Handle identifying the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F, typename A>
+    Handle push(F function, A argument);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a member function to be called on an object
+    ///
+    /// \param function Member function to run
+    /// \param object   Pointer to the object to use
+    ///
+    /// \return Handle identifying the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename C>
+    Handle push(void(C::*function)(), C* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the progress of a submitted job
+    ///
+    /// This function never blocks. Once it has reported a job
+    /// as complete, the queue forgets its handle: jobs that are
+    /// unknown to the queue are always reported as complete.
+    ///
+    /// \param handle Handle of the job
+    ///
+    /// \return Status of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getStatus(Handle handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a submitted job is complete
+    ///
+    /// \param handle  Handle of the job
+    /// \param timeout Maximum time to wait, Time::Zero to wait without limit
+    ///
+    /// \return True if the job is complete, false if the timeout elapsed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Handle handle, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether all the submitted jobs are complete
+    ///
+    /// \return True if no job is queued or waiting for the GPU
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isIdle();
+
+private:
+
+    struct Runner;
+    struct Upload;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a job and hand it to the worker threads
+    ///
+    /// \param job Job to queue, the queue takes ownership of it
+    ///
+    /// \return Handle of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    Handle enqueue(priv::ThreadFunc* job);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a job with a loader context and fence it
+    ///
+    /// \param job    Job to run
+    /// \param handle Handle of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    void execute(priv::ThreadFunc* job, Handle handle);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<Handle, Upload*> UploadTable; ///< Jobs that are not known to be complete, indexed by handle
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                 m_mutex;        ///< Mutex protecting the jobs and the contexts
+    UploadTable           m_uploads;      ///< Jobs that are not known to be complete
+    std::vector<Context*> m_contexts;     ///< All the loader contexts
+    std::vector<Context*> m_freeContexts; ///< Loader contexts not used by a job at the moment
+    Handle                m_nextHandle;   ///< Handle of the next submitted job
+    unsigned int          m_queuedCount;  ///< Number of jobs that have not run yet
+    ThreadPool            m_pool;         ///< Worker threads running the jobs
+};
+
+#include <SFML/Graphics/UploadQueue.inl>
+
+} // namespace sf
+
+
+#endif // SFML_UPLOADQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UploadQueue
+/// \ingroup graphics
+///
+/// sf::UploadQueue runs functions that create or update
+/// OpenGL resources (textures, vertex buffers, shaders...)
+/// in worker threads, so that the rendering thread doesn't
+/// stall while the data is sent to the GPU.
+///
+/// The queue owns a small pool of loader contexts, which
+/// share their resources with all the other contexts. A
+/// worker thread activates one of them before running a
+/// job, and inserts a fence once the job is done. The
+/// handle returned when the job is pushed reports when
+/// the GPU has executed every command of the job, at which
+/// point the resources can safely be used in any context.
+///
+/// The resources must not be used by another thread while
+/// their job is not complete, and the objects that the job
+/// works on must outlive it.
+///
+/// Usage example:
+/// \code
+/// sf::UploadQueue uploads;
+///
+/// sf::Texture terrain;
+/// sf::Image terrainImage = ...;
+///
+/// // Upload the texture in a worker thread
+/// sf::UploadQueue::Handle handle = uploads.push(&loadTerrain, &terrain);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     // Only draw the terrain once it is ready
+///     if (uploads.getStatus(handle) == sf::UploadQueue::Complete)
+///         window.draw(sf::Sprite(terrain));
+///     ...
+/// }
+/// \endcode
+///
+/// When fences are not supported, the worker threads wait
+/// until the GPU has executed the commands of each job
+/// (glFinish) before reporting it as complete.
+///
+/// \see sf::ThreadPool, sf::TextureLoader
+///
+////////////////////////////////////////////////////////////
@@ -91,12 +91,24 @@ public:
     ////////////////////////////////////////////////////////////
     Vertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color, texture coordinates and texture array layer
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates
+    /// \param theLayer     Layer of the texture array to map to the vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    Vertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords, float theLayer);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     Vector2f  position;  ///< 2D position of the vertex
     Color     color;     ///< Color of the vertex
     Vector2f  texCoords; ///< Coordinates of the texture's pixel to map to the vertex
+    float     layer;     ///< Layer of the texture array to map to the vertex (ignored by regular textures)
 };
 
 } // namespace sf
@@ -112,6 +124,9 @@ public:
 /// A vertex is an improved point. It has a position and other
 /// extra attributes that will be used for drawing: in SFML,
 /// vertices also have a color and a pair of texture coordinates.
+/// When drawing with a sf::TextureArray, the layer attribute
+/// selects the layer of the array that the vertex maps to, so
+/// that geometry using several layers can be drawn at once.
 ///
 /// The vertex is the building block of drawing. Everything which
 /// is visible on screen is made of vertices. They are grouped
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/System/ThreadPool.hpp>
 #include <vector>
 
 
@@ -78,11 +79,19 @@ public:
     /// [0, getVertexCount() - 1]. The behavior is undefined
     /// otherwise.
     ///
+    /// Calling this function drops the cached bounds, since the
+    /// vertex may be modified through the returned reference. A
+    /// reference or pointer kept for later must not be written
+    /// through after getBounds() was called (directly, or when
+    /// drawing with culling enabled) unless invalidateBounds()
+    /// is called afterwards: the bounds would be outdated, and
+    /// the array could be culled while it is visible.
+    ///
     /// \param index Index of the vertex to get
     ///
     /// \return Reference to the index-th vertex
     ///
-    /// \see getVertexCount
+    /// \see getVertexCount, invalidateBounds
     ///
     ////////////////////////////////////////////////////////////
     Vertex& operator [](std::size_t index);
@@ -136,6 +145,80 @@ public:
     ////////////////////////////////////////////////////////////
     void append(const Vertex& vertex);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add several vertices to the array
+    ///
+    /// The vertices are copied at the end of the array in a single
+    /// operation, which grows the memory at most once.
+    ///
+    /// \param vertices    Pointer to the vertices to add
+    /// \param vertexCount Number of vertices in the \a vertices array
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate memory for a given number of vertices
+    ///
+    /// This function doesn't change the number of vertices, it
+    /// only ensures that the array can grow up to \a vertexCount
+    /// vertices without reallocating its memory. It is useful
+    /// before appending a known number of vertices.
+    ///
+    /// \param vertexCount Number of vertices to allocate memory for
+    ///
+    /// \see getCapacity, shrinkToFit
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of vertices the array can hold without reallocating
+    ///
+    /// \return Number of vertices allocated
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the memory that is not used by the vertices
+    ///
+    /// Since clear() and resize() keep the memory allocated, this
+    /// function can be called once an array is not going to grow
+    /// again.
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    void shrinkToFit();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the array and generate its vertices in parallel
+    ///
+    /// The array is resized to \a vertexCount vertices, then the
+    /// index range is split into disjoint blocks that are handed
+    /// to the threads of \a pool. For each block, \a generator is
+    /// called as generator(vertices, first, count), where \a vertices
+    /// points to the first vertex of the block, \a first is its
+    /// index in the array and \a count the number of vertices to
+    /// write. Each call only ever sees its own block, so the
+    /// generator needs no locking as long as it doesn't share
+    /// other mutable state.
+    /// This function returns once every vertex has been generated.
+    ///
+    /// \param vertexCount New size of the array (number of vertices)
+    /// \param generator   Functor or free function filling a block of vertices
+    /// \param pool        Thread pool to run the generator on
+    /// \param blockSize   Number of vertices per block, 0 to let the pool decide
+    ///
+    /// \see sf::ThreadPool::parallelFor
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void generate(std::size_t vertexCount, F generator, ThreadPool& pool, std::size_t blockSize = 0);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the type of primitives to draw
     ///
@@ -166,11 +249,39 @@ public:
     /// This function returns the minimal axis-aligned rectangle
     /// that contains all the vertices of the array.
     ///
+    /// The result is cached: appending vertices extends it, and
+    /// it is only computed again after the vertices may have been
+    /// modified (through the non-const operator [], resize,
+    /// generate or invalidateBounds).
+    ///
     /// \return Bounding rectangle of the vertex array
     ///
+    /// \see invalidateBounds
+    ///
     ////////////////////////////////////////////////////////////
     FloatRect getBounds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the vertex array that its vertices were modified
+    ///
+    /// Call this function after writing vertices through
+    /// references or pointers obtained before the last call to
+    /// getBounds(), so that the next call computes the bounds
+    /// again.
+    ///
+    /// \see getBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateBounds();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this vertex array with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(VertexArray& right);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -182,15 +293,37 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the vertex array, for culling
+    ///
+    /// \param bounds Rectangle to fill with the bounds of the vertex array
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getCullingBounds(FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the cached bounding rectangle
+    ///
+    /// \param first Index of the first vertex not accounted for in the cached bounds, 0 to compute them from scratch
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateBounds(std::size_t first) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<Vertex> m_vertices;      ///< Vertices contained in the array
-    PrimitiveType       m_primitiveType; ///< Type of primitives to draw
+    std::vector<Vertex> m_vertices;         ///< Vertices contained in the array
+    PrimitiveType       m_primitiveType;    ///< Type of primitives to draw
+    mutable FloatRect   m_bounds;           ///< Cached bounding rectangle of the vertices
+    mutable bool        m_boundsNeedUpdate; ///< Do the cached bounds need to be computed again?
 };
 
+#include <SFML/Graphics/VertexArray.inl>
+
 } // namespace sf
 
 
@@ -218,6 +351,31 @@ private:
 /// window.draw(lines);
 /// \endcode
 ///
-/// \see sf::Vertex
+/// The bounds of the vertices are cached. Code that keeps
+/// pointers to vertices and modifies them after the array was
+/// drawn or its bounds queried must call invalidateBounds():
+/// \code
+/// sf::Vertex* quad = &tiles[index * 4];
+/// ...
+/// quad[0].position = sf::Vector2f(x, y);
+/// tiles.invalidateBounds();
+/// \endcode
+///
+/// Large arrays can be filled on several threads at once with
+/// generate(), which gives each thread of an sf::ThreadPool its
+/// own range of vertices:
+/// \code
+/// void makeGrid(sf::Vertex* vertices, std::size_t first, std::size_t count)
+/// {
+///     for (std::size_t i = 0; i < count; ++i)
+///         vertices[i].position = sf::Vector2f((first + i) % 800, (first + i) / 800);
+/// }
+///
+/// sf::ThreadPool pool;
+/// sf::VertexArray grid(sf::Points);
+/// grid.generate(800 * 600, &makeGrid, pool);
+/// \endcode
+///
+/// \see sf::Vertex, sf::ThreadPool
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+namespace priv
+{
+// Adapts a vertex generator to the (begin, end) blocks of ThreadPool::parallelFor()
+template <typename F>
+struct VertexGeneratorBlock
+{
+    VertexGeneratorBlock(F generator, Vertex* vertices) : m_generator(generator), m_vertices(vertices) {}
+    void operator()(std::size_t begin, std::size_t end) {m_generator(m_vertices + begin, begin, end - begin);}
+    F       m_generator;
+    Vertex* m_vertices;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void VertexArray::generate(std::size_t vertexCount, F generator, ThreadPool& pool, std::size_t blockSize)
+{
+    resize(vertexCount);
+
+    if (vertexCount > 0)
+    {
+        pool.parallelFor(vertexCount, priv::VertexGeneratorBlock<F>(generator, &m_vertices[0]), blockSize);
+        m_boundsNeedUpdate = true;
+    }
+}
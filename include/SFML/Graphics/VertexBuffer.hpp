@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
 #include <SFML/Window/GlResource.hpp>
 
 
@@ -64,6 +65,19 @@ public:
         Static   ///< Rarely changing data
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Options of map
+    ///
+    /// The flags can be combined with the bitwise OR operator.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum MapFlags
+    {
+        MapInvalidateRange  = 1 << 0, ///< The previous contents of the mapped range are discarded
+        MapInvalidateBuffer = 1 << 1, ///< The previous contents of the whole buffer are discarded
+        MapUnsynchronized   = 1 << 2  ///< Don't wait for the draws still sourcing the buffer, the caller must not overwrite their vertices
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -136,6 +150,25 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the vertex buffer with a specific vertex layout
+    ///
+    /// Same as create(std::size_t), but the vertices are stored
+    /// with \a layout instead of the layout of sf::Vertex. The
+    /// layout is kept for subsequent calls to create(std::size_t)
+    /// and can't be changed without recreating the buffer.
+    ///
+    /// Buffers with a custom layout must be updated with
+    /// update(const void*, std::size_t, unsigned int).
+    ///
+    /// \param vertexCount Number of vertices worth of memory to allocate
+    /// \param layout      Memory layout of the vertices
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t vertexCount, const VertexLayout& layout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the vertex count
     ///
@@ -197,9 +230,28 @@ public:
     ////////////////////////////////////////////////////////////
     bool update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from raw vertex data
+    ///
+    /// \a vertices must point to vertices stored with the layout
+    /// of the buffer, see getLayout. \p vertexCount and \p offset
+    /// are expressed in vertices and follow the same rules as
+    /// update(const Vertex*, std::size_t, unsigned int).
+    ///
+    /// \param vertices    Pointer to the vertex data to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const void* vertices, std::size_t vertexCount, unsigned int offset);
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the contents of another buffer into this buffer
     ///
+    /// Both buffers must have the same layout.
+    ///
     /// \param vertexBuffer Vertex buffer whose contents to copy into this vertex buffer
     ///
     /// \return True if the copy was successful
@@ -207,6 +259,67 @@ public:
     ////////////////////////////////////////////////////////////
     bool update(const VertexBuffer& vertexBuffer);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a range of the buffer for writing
+    ///
+    /// Producers can write vertices directly into the returned
+    /// memory instead of building them in client memory and
+    /// copying them with update. The memory is laid out
+    /// according to getLayout; with the default layout it can
+    /// be cast to sf::Vertex*.
+    ///
+    /// The returned memory must only be written to, and stays
+    /// valid until unmap is called. A mapped buffer can't be
+    /// drawn or updated.
+    ///
+    /// With MapInvalidateRange or MapInvalidateBuffer, the
+    /// driver doesn't have to preserve the previous contents
+    /// and can hand out fresh memory instead of waiting for
+    /// pending draws. MapUnsynchronized never waits, which is
+    /// only safe when writing to vertices that no pending draw
+    /// reads, e.g. when filling a ring buffer. These hints are
+    /// ignored when the system doesn't support mapping ranges.
+    ///
+    /// \param offset      Index of the first vertex to map
+    /// \param vertexCount Number of vertices to map
+    /// \param flags       Combination of MapFlags
+    ///
+    /// \return Pointer to the mapped vertices, or NULL on failure
+    ///
+    /// \see unmap
+    ///
+    ////////////////////////////////////////////////////////////
+    void* map(std::size_t offset, std::size_t vertexCount, Uint32 flags = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unmap the buffer after writing to it
+    ///
+    /// The pointer returned by map must not be used anymore.
+    ///
+    /// \return False if the contents of the buffer were lost while
+    ///         mapped and must be written again, true otherwise
+    ///
+    /// \see map
+    ///
+    ////////////////////////////////////////////////////////////
+    bool unmap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the buffer is currently mapped
+    ///
+    /// \return True if map was called without a matching unmap
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isMapped() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory layout of the vertices
+    ///
+    /// \return Layout of the vertices stored in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    const VertexLayout& getLayout() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -338,6 +451,8 @@ private:
     std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
     PrimitiveType m_primitiveType; ///< Type of primitives to draw
     Usage         m_usage;         ///< How this vertex buffer is to be used
+    VertexLayout  m_layout;        ///< Memory layout of the vertices
+    bool          m_mapped;        ///< Is the buffer currently mapped?
 };
 
 } // namespace sf
@@ -403,6 +518,23 @@ private:
 /// window.draw(triangles);
 /// \endcode
 ///
-/// \see sf::Vertex, sf::VertexArray
+/// Vertices can also be written directly into graphics
+/// memory with map and unmap, which saves the intermediate
+/// copy in client memory:
+/// \code
+/// sf::Vertex* vertices = static_cast<sf::Vertex*>(buffer.map(0, 100, sf::VertexBuffer::MapInvalidateRange));
+/// if (vertices)
+/// {
+///     for (std::size_t i = 0; i < 100; ++i)
+///         vertices[i] = ...;
+///     buffer.unmap();
+/// }
+/// \endcode
+///
+/// Large static meshes can be stored more compactly by
+/// creating the buffer with a sf::VertexLayout, for example
+/// with half-float or 16-bit integer coordinates.
+///
+/// \see sf::Vertex, sf::VertexArray, sf::VertexLayout
 ///
 ////////////////////////////////////////////////////////////
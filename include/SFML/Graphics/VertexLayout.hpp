@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VERTEXLAYOUT_HPP
+#define SFML_VERTEXLAYOUT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Description of the memory layout of the vertices
+///        stored in a sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexLayout
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Meaning of an attribute
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Semantic
+    {
+        Position,  ///< Position of the vertex, 2 components
+        Color,     ///< Color of the vertex, 4 components
+        TexCoords, ///< Texture coordinates of the vertex, 2 components (3 with the texture array layer)
+        Custom     ///< Extra attribute only read by shaders, 1 to 4 components
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Type of the components of an attribute
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        Float,        ///< 32-bit floating point
+        HalfFloat,    ///< 16-bit floating point, see toHalfFloat
+        Short,        ///< 16-bit signed integer
+        UnsignedByte  ///< 8-bit unsigned integer
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a single attribute
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Attribute
+    {
+        Semantic     semantic;       ///< Meaning of the attribute
+        unsigned int index;          ///< Index of the attribute for the Custom semantic, 0 otherwise
+        unsigned int componentCount; ///< Number of components
+        Type         type;           ///< Type of the components
+        bool         normalized;     ///< Whether integer components are mapped to [0, 1] or [-1, 1]
+        std::size_t  offset;         ///< Offset of the attribute within a vertex, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Maximum number of custom attributes
+    ///
+    ////////////////////////////////////////////////////////////
+    static const unsigned int MaxCustomAttributes = 8;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates the layout of sf::Vertex: float position,
+    /// 8-bit normalized color and float texture coordinates
+    /// with the texture array layer, 24 bytes per vertex.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexLayout();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the attributes
+    ///
+    /// Use this function before describing a custom layout
+    /// with add and addCustom.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a standard attribute to the layout
+    ///
+    /// The attribute is placed after the previous ones,
+    /// aligned to 4 bytes. Each semantic may only appear once.
+    /// Normalized integer positions and texture coordinates
+    /// are only supported on core profile contexts, SFML
+    /// coordinates being expressed in pixels.
+    ///
+    /// \param semantic       Position, Color or TexCoords
+    /// \param componentCount Number of components
+    /// \param type           Type of the components
+    /// \param normalized     Whether integer components are normalized
+    ///
+    /// \return True if the attribute was added, false if it is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(Semantic semantic, unsigned int componentCount, Type type, bool normalized = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a custom attribute to the layout
+    ///
+    /// Custom attributes are read by shaders through the
+    /// sf_attribute0 to sf_attribute7 vertex inputs, matching
+    /// \a index. They are ignored when drawing without a shader.
+    ///
+    /// \param index          Index of the attribute, in [0, MaxCustomAttributes)
+    /// \param componentCount Number of components, in [1, 4]
+    /// \param type           Type of the components
+    /// \param normalized     Whether integer components are normalized
+    ///
+    /// \return True if the attribute was added, false if it is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addCustom(unsigned int index, unsigned int componentCount, Type type, bool normalized = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a vertex
+    ///
+    /// \return Distance between two consecutive vertices, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of attributes
+    ///
+    /// \return Number of attributes of the layout
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAttributeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an attribute
+    ///
+    /// \param index Index of the attribute, in [0, getAttributeCount())
+    ///
+    /// \return Description of the attribute
+    ///
+    ////////////////////////////////////////////////////////////
+    const Attribute& getAttribute(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the standard attribute with a given semantic
+    ///
+    /// \param semantic Position, Color or TexCoords
+    ///
+    /// \return Pointer to the attribute, or NULL if the layout doesn't have it
+    ///
+    ////////////////////////////////////////////////////////////
+    const Attribute* find(Semantic semantic) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether this is the layout of sf::Vertex
+    ///
+    /// \return True if vertices of this layout are sf::Vertex instances
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDefault() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a float to a half float
+    ///
+    /// The value is rounded to the nearest half float,
+    /// values too large are clamped to infinity.
+    ///
+    /// \param value Value to convert
+    ///
+    /// \return Bits of the 16-bit floating point value
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint16 toHalfFloat(float value);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an attribute after the previous ones
+    ///
+    /// \param attribute Attribute to append, its offset is overwritten
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(Attribute attribute);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Attribute> m_attributes; ///< Attributes, in memory order
+    std::size_t            m_stride;     ///< Size of a vertex, in bytes
+};
+
+////////////////////////////////////////////////////////////
+/// \relates VertexLayout
+/// \brief Overload of the == operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if both layouts describe the same memory layout
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator ==(const VertexLayout& left, const VertexLayout& right);
+
+////////////////////////////////////////////////////////////
+/// \relates VertexLayout
+/// \brief Overload of the != operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if the layouts differ
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator !=(const VertexLayout& left, const VertexLayout& right);
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXLAYOUT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexLayout
+/// \ingroup graphics
+///
+/// sf::VertexLayout describes how the vertices of a
+/// sf::VertexBuffer are stored in memory. By default it
+/// matches sf::Vertex, but large static meshes can use a
+/// more compact layout: half-float or 16-bit integer
+/// positions and texture coordinates halve the size of those
+/// attributes, and dropping unused ones saves even more.
+///
+/// A layout can also carry custom attributes, which vertex
+/// shaders read through the sf_attribute0 to sf_attribute7
+/// inputs. The locations of these inputs are bound by
+/// sf::Shader when it is loaded.
+///
+/// Attributes missing from a layout take a constant value:
+/// white for the color and (0, 0) for the texture coordinates.
+/// The position is mandatory.
+///
+/// Example:
+/// \code
+/// // 12 bytes per vertex instead of 24
+/// sf::VertexLayout layout;
+/// layout.clear();
+/// layout.add(sf::VertexLayout::Position, 2, sf::VertexLayout::Short);
+/// layout.add(sf::VertexLayout::Color, 4, sf::VertexLayout::UnsignedByte, true);
+/// layout.add(sf::VertexLayout::TexCoords, 2, sf::VertexLayout::Short);
+///
+/// sf::VertexBuffer mesh(sf::Triangles, sf::VertexBuffer::Static);
+/// mesh.create(vertexCount, layout);
+/// mesh.update(packedVertices, vertexCount, 0);
+/// ...
+/// window.draw(mesh);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::Vertex
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VIDEOTEXTURE_HPP
+#define SFML_VIDEOTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Texture receiving decoded video frames in their
+///        native YUV format
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VideoTexture : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layouts of the planes of the frames
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PixelFormat
+    {
+        I420, ///< Y plane, then U and V planes at half the resolution in both directions
+        NV12  ///< Y plane, then a single interleaved UV plane at half the resolution
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Conversions from YUV to RGB
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ColorSpace
+    {
+        Rec601, ///< ITU-R BT.601 with limited range, used by standard definition video
+        Rec709  ///< ITU-R BT.709 with limited range, used by high definition video
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty video texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    VideoTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the video texture
+    ///
+    /// \param width      Width of the frames
+    /// \param height     Height of the frames
+    /// \param format     Layout of the planes of the frames
+    /// \param colorSpace Conversion from YUV to RGB
+    ///
+    /// \return True if creation was successful, false if shaders
+    ///         or render textures are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, PixelFormat format = I420, ColorSpace colorSpace = Rec709);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a decoded frame
+    ///
+    /// The planes are uploaded as they come out of the decoder,
+    /// 1.5 bytes per pixel instead of 4, and converted to RGB by
+    /// the graphics card. For NV12 frames, \a u points to the
+    /// interleaved UV plane and \a v is ignored.
+    ///
+    /// \param y       Pixels of the Y plane
+    /// \param yStride Number of bytes between two rows of the Y plane
+    /// \param u       Pixels of the U plane, or of the UV plane
+    /// \param uStride Number of bytes between two rows of the U (or UV) plane
+    /// \param v       Pixels of the V plane, NULL for NV12 frames
+    /// \param vStride Number of bytes between two rows of the V plane
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* y, std::size_t yStride, const Uint8* u, std::size_t uStride, const Uint8* v = NULL, std::size_t vStride = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the RGB texture
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the frames
+    ///
+    /// \return Size of the frames, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the RGB texture holding the last frame
+    ///
+    /// \return Texture to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a plane to its texture
+    ///
+    /// \param texture  Texture of the plane
+    /// \param pixels   Pixels of the plane
+    /// \param stride   Number of bytes between two rows
+    /// \param channels Number of bytes per pixel
+    ///
+    ////////////////////////////////////////////////////////////
+    static void uploadPlane(Texture& texture, const Uint8* pixels, std::size_t stride, unsigned int channels);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture       m_planes[3]; ///< Textures of the Y, U and V (or UV) planes
+    RenderTexture m_output;    ///< RGB version of the last frame
+    Shader        m_shader;    ///< Shader converting the planes to RGB
+    PixelFormat   m_format;    ///< Layout of the planes
+};
+
+} // namespace sf
+
+
+#endif // SFML_VIDEOTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VideoTexture
+/// \ingroup graphics
+///
+/// Video decoders output frames in planar YUV formats.
+/// Converting them to RGBA on the CPU and uploading them with
+/// sf::Texture::update costs a lot of CPU time and more than
+/// twice the upload bandwidth. sf::VideoTexture uploads the
+/// planes directly to single-channel textures, and lets the
+/// graphics card convert them into an RGB texture with a
+/// shader. The result is a regular sf::Texture, which can be
+/// drawn with sprites or used by shaders like any other.
+///
+/// sf::VideoTexture requires shaders and render textures.
+///
+/// Usage example:
+/// \code
+/// sf::VideoTexture video;
+/// video.create(1920, 1080, sf::VideoTexture::I420);
+///
+/// sf::Sprite sprite(video.getTexture());
+///
+/// // When the decoder has a new frame...
+/// video.update(frame.y, frame.yStride, frame.u, frame.uStride, frame.v, frame.vStride);
+///
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::Texture, sf::StreamingTexture
+///
+////////////////////////////////////////////////////////////
@@ -192,6 +192,20 @@ public:
     ////////////////////////////////////////////////////////////
     const FloatRect& getViewport() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the area of the scene covered by the view
+    ///
+    /// When the view is rotated, the returned rectangle is the
+    /// axis-aligned rectangle enclosing it. This is the area to
+    /// query when culling objects against the view.
+    ///
+    /// \return Bounding rectangle of the view, in scene coordinates
+    ///
+    /// \see getCenter, getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Move the view relatively to its current position
     ///
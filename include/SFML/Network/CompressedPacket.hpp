@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COMPRESSEDPACKET_HPP
+#define SFML_COMPRESSEDPACKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet which is compressed before being sent
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API CompressedPacket : public Packet
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty packet, with a compression threshold
+    /// of 128 bytes and no dictionary.
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedPacket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size below which packets are sent uncompressed
+    ///
+    /// Compressing a few bytes costs time and rarely makes them
+    /// smaller, so packets smaller than the threshold are sent
+    /// as they are. Packets that don't get smaller when they
+    /// are compressed are sent uncompressed as well.
+    ///
+    /// \param threshold Minimum size of the data to compress, in bytes
+    ///
+    /// \see getCompressionThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCompressionThreshold(std::size_t threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size below which packets are sent uncompressed
+    ///
+    /// \return Minimum size of the data to compress, in bytes
+    ///
+    /// \see setCompressionThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCompressionThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the dictionary used to compress the packets
+    ///
+    /// A dictionary is a sample of typical packet data, which
+    /// the compressor can reference as if it preceded every
+    /// packet. It greatly improves the compression of small
+    /// packets whose content is similar from one to the next.
+    /// Only the last 64 KB of the dictionary are used.
+    ///
+    /// The sender and the receiver must use the same dictionary,
+    /// otherwise the packets cannot be decompressed.
+    /// The data is copied, it can be destroyed after this call.
+    ///
+    /// \param data Pointer to the dictionary data (NULL to remove the dictionary)
+    /// \param size Size of the dictionary data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDictionary(const void* data, std::size_t size);
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress the data before it is sent
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* onSend(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decompress the data after it is received
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(const void* data, std::size_t size);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t       m_threshold;  ///< Minimum size of the data to compress
+    std::vector<char> m_dictionary; ///< Data that the compressor can reference before each packet
+    std::vector<char> m_buffer;     ///< Temporary buffer holding the compressed or decompressed data
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDPACKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedPacket
+/// \ingroup network
+///
+/// sf::CompressedPacket is a drop-in replacement for sf::Packet
+/// which compresses its data when it is sent, and decompresses
+/// it when it is received. Both ends of the connection must
+/// use a sf::CompressedPacket (with the same dictionary, if any).
+///
+/// The data is compressed in the LZ4 block format, which is
+/// fast enough to be used on every packet and works best on
+/// the repetitive data (world state, tile maps, ...) typically
+/// exchanged by games.
+///
+/// Usage example:
+/// \code
+/// // Sender
+/// sf::CompressedPacket packet;
+/// for (std::size_t i = 0; i < tiles.size(); ++i)
+///     packet << tiles[i];
+/// socket.send(packet);
+///
+/// // Receiver
+/// sf::CompressedPacket packet;
+/// socket.receive(packet);
+/// for (std::size_t i = 0; i < tiles.size(); ++i)
+///     packet >> tiles[i];
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
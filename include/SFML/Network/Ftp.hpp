@@ -248,6 +248,12 @@ public:
     };
 
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Ftp();
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -508,6 +514,22 @@ public:
     ////////////////////////////////////////////////////////////
     Response sendCommand(const std::string& command, const std::string& parameter = "");
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the buffer used for data transfers
+    ///
+    /// Bigger buffers need fewer system calls, which matters
+    /// on fast links. The default size is 64 KB.
+    ///
+    /// Where the system supports it (sendfile and splice on
+    /// Linux, TransmitFile on Windows), upload and download
+    /// transfer the file directly between the file and the
+    /// socket, without going through this buffer.
+    ///
+    /// \param size Size of the transfer buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransferBufferSize(std::size_t size);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -533,8 +555,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket   m_commandSocket; ///< Socket holding the control connection with the server
-    std::string m_receiveBuffer; ///< Received command data that is yet to be processed
+    TcpSocket   m_commandSocket;      ///< Socket holding the control connection with the server
+    std::string m_receiveBuffer;      ///< Received command data that is yet to be processed
+    std::size_t m_transferBufferSize; ///< Size of the buffer used for data transfers
 };
 
 } // namespace sf
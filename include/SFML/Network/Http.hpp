@@ -30,11 +30,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/SocketPoller.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
+#include <iosfwd>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -345,6 +349,130 @@ public:
         std::string  m_body;         ///< Body of the response
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Abstract class receiving the response of a request as it arrives
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API ResponseSink
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~ResponseSink() {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when the header of the response is received
+        ///
+        /// The response contains the status and the header fields,
+        /// its body is empty. The default implementation does nothing.
+        ///
+        /// \param response Response, without its body
+        ///
+        /// \return True to receive the body, false to abort the request
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onResponse(const Response& response);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a part of the response body is received
+        ///
+        /// The parts are delivered in order, already decoded if
+        /// the body is chunked.
+        ///
+        /// \param data Pointer to the received bytes
+        /// \param size Number of bytes
+        ///
+        /// \return True to continue, false to abort the request
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onBodyData(const char* data, std::size_t size) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a request sent asynchronously
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API AsyncRequest : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an empty handle, not tracking any request.
+        ///
+        ////////////////////////////////////////////////////////////
+        AsyncRequest();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        /// Cancels the request if it is still in progress.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~AsyncRequest();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the request is finished
+        ///
+        /// A request is finished once the whole response has been
+        /// received, or when it failed. In both cases, its result
+        /// is available with getResponse().
+        ///
+        /// \return True if the request is finished
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isDone() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the request is still in progress
+        ///
+        /// \return True if the request was sent and is not finished yet
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isPending() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the response of a finished request
+        ///
+        /// If the request failed, the status of the response
+        /// tells what went wrong (sf::Http::Response::ConnectionFailed
+        /// if no valid response could be received). The body is
+        /// empty if the request was sent with a response sink.
+        ///
+        /// \return Server's response
+        ///
+        ////////////////////////////////////////////////////////////
+        const Response& getResponse() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Abort the request
+        ///
+        /// The connection used by the request is closed, and the
+        /// handle becomes empty again. Calling this function on a
+        /// handle that is not in progress has no effect.
+        ///
+        ////////////////////////////////////////////////////////////
+        void cancel();
+
+    private:
+
+        friend class Http;
+
+        struct State;
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Http*    m_http;     ///< HTTP client processing the request, NULL when none is in progress
+        State*   m_state;    ///< State of the request in progress (connection, parser, ...)
+        Response m_response; ///< Response received
+        bool     m_done;     ///< Is the request finished?
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -367,6 +495,15 @@ public:
     ////////////////////////////////////////////////////////////
     Http(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Closes the connections kept alive, and cancels the
+    /// asynchronous requests still in progress.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Http();
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the target host
     ///
@@ -374,9 +511,19 @@ public:
     /// doesn't actually connect to it until you send a request.
     /// The port has a default value of 0, which means that the
     /// HTTP client will use the right port according to the
-    /// protocol used (80 for HTTP). You should leave it like
-    /// this unless you really need a port other than the
-    /// standard one, or use an unknown protocol.
+    /// protocol used (80 for HTTP, 443 for HTTPS). You should
+    /// leave it like this unless you really need a port other
+    /// than the standard one, or use an unknown protocol.
+    ///
+    /// HTTPS connections are encrypted with sf::TlsSocket, and
+    /// are only available if SFML was built with TLS support.
+    /// GET and HEAD requests on a new connection to a known
+    /// host are sent as TLS 1.3 early data when the server
+    /// allows it, saving a round-trip.
+    ///
+    /// The host name is resolved by the first request that
+    /// needs it; asynchronous requests resolve it with
+    /// IpAddress::resolveAsync so that they never block.
     ///
     /// \param host Web server to connect to
     /// \param port Port to use for connection
@@ -384,6 +531,41 @@ public:
     ////////////////////////////////////////////////////////////
     void setHost(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable persistent connections
+    ///
+    /// By default, a new connection is opened for every request
+    /// and closed once the response is received. With keep-alive
+    /// enabled, requests ask the server to keep the connection
+    /// open ("Connection: keep-alive", unless the request already
+    /// has a "Connection" field), and connections that the server
+    /// agrees to keep are reused by the next requests, which saves
+    /// a TCP handshake per request.
+    ///
+    /// Up to \a maxConnections idle connections are kept, so that
+    /// requests sent concurrently from several threads can each
+    /// reuse one. If a kept connection turns out to have been
+    /// closed by the server, the request is sent again on a new
+    /// connection.
+    ///
+    /// \param enabled        True to keep connections alive, false to close them after each request
+    /// \param maxConnections Maximum number of idle connections kept open
+    ///
+    ////////////////////////////////////////////////////////////
+    void setKeepAlive(bool enabled, std::size_t maxConnections = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the buffer used to receive responses
+    ///
+    /// Bigger buffers need fewer system calls for large
+    /// downloads, and are delivered in bigger parts to
+    /// response sinks. The default size is 16 KB.
+    ///
+    /// \param size Size of the receive buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReadBufferSize(std::size_t size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Send a HTTP request and return the server's response.
     ///
@@ -395,6 +577,7 @@ public:
     /// application, or use a timeout to limit the time to wait. A value
     /// of Time::Zero means that the client will use the system default timeout
     /// (which is usually pretty long).
+    /// This function can be called from several threads at the same time.
     ///
     /// \param request Request to send
     /// \param timeout Maximum time to wait
@@ -404,15 +587,233 @@ public:
     ////////////////////////////////////////////////////////////
     Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and stream the response to a sink
+    ///
+    /// Unlike sendRequest(const Request&, Time), the body of the
+    /// response is not stored in memory: it is passed to the
+    /// sink part by part as it is received, which makes it
+    /// possible to download files of any size. The returned
+    /// response has the status and header fields, and an
+    /// empty body.
+    ///
+    /// \param request Request to send
+    /// \param sink    Sink receiving the response header and body
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, without its body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, ResponseSink& sink, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and write the response body to a stream
+    ///
+    /// This is equivalent to sendRequest(const Request&, ResponseSink&, Time)
+    /// with a sink writing the body to \a body. The request is
+    /// aborted if writing to the stream fails.
+    ///
+    /// \param request Request to send
+    /// \param body    Stream receiving the response body
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return Server's response, without its body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, std::ostream& body, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request without waiting for the response
+    ///
+    /// This function returns immediately: the request is then
+    /// processed, with non-blocking sockets, by the calls to
+    /// update(), and \a handle tells when it is finished. This
+    /// makes it possible to send requests from the main loop of
+    /// an application without ever blocking it. If \a handle was
+    /// already tracking a request in progress, that request is
+    /// cancelled.
+    ///
+    /// The timeout applies to the whole request (resolution,
+    /// connection and response); Time::Zero means no timeout.
+    ///
+    /// Asynchronous requests must be sent and updated from a
+    /// single thread. Destroying the handle or this HTTP client
+    /// cancels the request.
+    ///
+    /// \param request Request to send
+    /// \param handle  Handle tracking the request
+    /// \param timeout Maximum time to wait
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendRequestAsync(const Request& request, AsyncRequest& handle, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request asynchronously and stream the response to a sink
+    ///
+    /// This is the asynchronous equivalent of
+    /// sendRequest(const Request&, ResponseSink&, Time): the sink
+    /// is called from update() as parts of the response arrive,
+    /// and must stay alive until the request is finished.
+    ///
+    /// \param request Request to send
+    /// \param handle  Handle tracking the request
+    /// \param sink    Sink receiving the response header and body
+    /// \param timeout Maximum time to wait
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendRequestAsync(const Request& request, AsyncRequest& handle, ResponseSink& sink, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the asynchronous requests in progress
+    ///
+    /// This function performs all the network operations that
+    /// can be done without blocking for the requests sent with
+    /// sendRequestAsync, and updates their handles. It is meant
+    /// to be called regularly, typically once per frame.
+    ///
+    /// With the default timeout of Time::Zero, the function
+    /// returns immediately. Otherwise it first waits up to
+    /// \a timeout for network activity, which is convenient
+    /// for dedicated network loops.
+    ///
+    /// \param timeout Maximum time to wait for network activity
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time timeout = Time::Zero);
+
 private:
 
+    class ResponseReader;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request and convert it to a string
+    ///
+    /// \param request   Request to prepare
+    /// \param keepAlive Ask the server to keep the connection open?
+    ///
+    /// \return Request to send, as a string
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string prepareRequest(const Request& request, bool keepAlive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the host, resolving it if needed
+    ///
+    /// \return Address of the host
+    ///
+    ////////////////////////////////////////////////////////////
+    IpAddress resolveHost();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start an asynchronous request
+    ///
+    /// \param request Request to send
+    /// \param handle  Handle tracking the request
+    /// \param sink    Sink receiving the response, NULL to store the body in the response
+    /// \param timeout Maximum time to wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void startRequest(const Request& request, AsyncRequest& handle, ResponseSink* sink, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open or reuse a connection for an asynchronous request
+    ///
+    /// \param handle Request to connect
+    ///
+    /// \return True if the connection is established or in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    bool connectRequest(AsyncRequest& handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Perform the non-blocking operations of an asynchronous request
+    ///
+    /// \param handle Request to process
+    ///
+    /// \return True if the request is still in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    bool processRequest(AsyncRequest& handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Try an asynchronous request again on a new connection, or make it fail
+    ///
+    /// \param handle Request whose kept connection was closed by the server
+    ///
+    /// \return True if the request is still in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    bool retryRequest(AsyncRequest& handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish an asynchronous request and release its state
+    ///
+    /// \param handle   Request to finish
+    /// \param complete Was the whole response received?
+    ///
+    /// \return Always false, for convenience
+    ///
+    ////////////////////////////////////////////////////////////
+    bool finishRequest(AsyncRequest& handle, bool complete);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the state of an asynchronous request
+    ///
+    /// \param handle Request to release
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseRequest(AsyncRequest& handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel an asynchronous request in progress
+    ///
+    /// \param handle Request to cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelRequest(AsyncRequest& handle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a response and pass its body to a sink
+    ///
+    /// \param connection Connection to read the response from
+    /// \param head       Was the request a HEAD one (with no body in the response)?
+    /// \param response   Response to fill with the status and header fields
+    /// \param sink       Sink receiving the response body
+    /// \param received   Filled with true if any byte was received
+    /// \param reusable   Filled with true if the connection can be used for another request
+    ///
+    /// \return True if the whole response was received
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveResponse(TcpSocket& connection, bool head, Response& response, ResponseSink& sink, bool& received, bool& reusable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close all the idle connections
+    ///
+    ////////////////////////////////////////////////////////////
+    void closeConnections();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket      m_connection; ///< Connection to the host
-    IpAddress      m_host;       ///< Web host address
-    std::string    m_hostName;   ///< Web host name
-    unsigned short m_port;       ///< Port used for connection with host
+    std::vector<TcpSocket*>     m_connections;    ///< Idle connections to the host, kept alive for the next requests
+    IpAddress                   m_host;           ///< Web host address
+    std::string                 m_hostName;       ///< Web host name
+    unsigned short              m_port;           ///< Port used for connection with host
+    bool                        m_secure;         ///< Use HTTPS?
+    bool                        m_hostResolved;   ///< Was the host name resolved already?
+    bool                        m_keepAlive;      ///< Keep connections open between requests?
+    std::size_t                 m_maxConnections; ///< Maximum number of idle connections
+    std::size_t                 m_readBufferSize; ///< Size of the buffer used to receive responses
+    Mutex                       m_mutex;          ///< Mutex protecting the connections and the host
+    std::vector<AsyncRequest*>  m_requests;       ///< Asynchronous requests in progress
+    SocketPoller                m_poller;         ///< Poller waiting for the connections of the asynchronous requests
+    IpAddress::AsyncResolution  m_resolution;     ///< Resolution of the host name for asynchronous requests
+    std::vector<char>           m_receiveBuffer;  ///< Buffer receiving the responses of asynchronous requests
 };
 
 } // namespace sf
@@ -451,15 +852,17 @@ private:
 ///
 /// sf::Http provides a simple function, SendRequest, to send a
 /// sf::Http::Request and return the corresponding sf::Http::Response
-/// from the server.
+/// from the server. Requests can also be sent with sendRequestAsync,
+/// which never blocks: they progress with each call to update()
+/// and are tracked by a sf::Http::AsyncRequest handle.
 ///
 /// Usage example:
 /// \code
 /// // Create a new HTTP client
 /// sf::Http http;
 ///
-/// // We'll work on http://www.sfml-dev.org
-/// http.setHost("http://www.sfml-dev.org");
+/// // We'll work on https://www.sfml-dev.org
+/// http.setHost("https://www.sfml-dev.org");
 ///
 /// // Prepare a request to get the 'features.php' page
 /// sf::Http::Request request("features.php");
@@ -477,6 +880,15 @@ private:
 /// {
 ///     std::cout << "Error " << status << std::endl;
 /// }
+///
+/// // Or send it without blocking, from the main loop
+/// sf::Http::AsyncRequest handle;
+/// http.sendRequestAsync(request, handle);
+/// while (!handle.isDone())
+/// {
+///     http.update();
+///     // ... draw the next frame ...
+/// }
 /// \endcode
 ///
 ////////////////////////////////////////////////////////////
@@ -29,22 +29,41 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    struct ResolveJob;
+}
+
 ////////////////////////////////////////////////////////////
-/// \brief Encapsulate an IPv4 network address
+/// \brief Encapsulate an IPv4 or IPv6 network address
 ///
 ////////////////////////////////////////////////////////////
 class SFML_NETWORK_API IpAddress
 {
 public:
 
+    class AsyncResolution;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Address families
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Family
+    {
+        IPv4, ///< 32 bits address (like 192.168.1.56)
+        IPv6  ///< 128 bits address (like 2001:db8::1)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -57,7 +76,10 @@ public:
     /// \brief Construct the address from a string
     ///
     /// Here \a address can be either a decimal address
-    /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// (ex: "192.168.1.56"), an IPv6 address (ex: "2001:db8::1")
+    /// or a network name (ex: "localhost"). Network names
+    /// resolve to an IPv4 address when the host has one, and
+    /// to an IPv6 address otherwise.
     ///
     /// \param address IP address or network name
     ///
@@ -108,12 +130,35 @@ public:
     ////////////////////////////////////////////////////////////
     explicit IpAddress(Uint32 address);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IPv6 address from its 16 bytes
+    ///
+    /// The bytes are in network order. IPv4-mapped addresses
+    /// (::ffff:a.b.c.d) are converted to the corresponding
+    /// IPv4 address.
+    ///
+    /// \param bytes Bytes of the address
+    ///
+    /// \see toBytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IpAddress(const Uint8 (&bytes)[16]);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the family of the address
+    ///
+    /// \return sf::IpAddress::IPv4 or sf::IpAddress::IPv6
+    ///
+    ////////////////////////////////////////////////////////////
+    Family getFamily() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a string representation of the address
     ///
     /// The returned string is the decimal representation of the
-    /// IP address (like "192.168.1.56"), even if it was constructed
-    /// from a host name.
+    /// IP address (like "192.168.1.56"), or the standard text
+    /// representation of IPv6 addresses (like "2001:db8::1"),
+    /// even if it was constructed from a host name.
     ///
     /// \return String representation of the address
     ///
@@ -138,6 +183,17 @@ public:
     ////////////////////////////////////////////////////////////
     Uint32 toInteger() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 16 bytes of the address
+    ///
+    /// IPv4 addresses are returned as IPv4-mapped IPv6
+    /// addresses (::ffff:a.b.c.d).
+    ///
+    /// \param bytes Array to fill with the bytes of the address, in network order
+    ///
+    ////////////////////////////////////////////////////////////
+    void toBytes(Uint8 (&bytes)[16]) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the computer's local address
     ///
@@ -178,13 +234,78 @@ public:
     ////////////////////////////////////////////////////////////
     static IpAddress getPublicAddress(Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve an address without blocking
+    ///
+    /// Building an address from a host name, with the
+    /// constructors taking a string, waits for the name to be
+    /// resolved, which may take seconds. This function returns
+    /// immediately instead: the host name is resolved by a worker
+    /// thread, and \a resolution tells when the address is ready.
+    /// Decimal addresses and cached host names are available
+    /// right away.
+    ///
+    /// If \a resolution was already tracking a resolution in
+    /// progress, that resolution is cancelled.
+    ///
+    /// \param address    Decimal address or network name to resolve
+    /// \param resolution Handle tracking the resolution
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resolveAsync(const std::string& address, AsyncResolution& resolution);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the addresses of a network name
+    ///
+    /// A host usually has several addresses, with IPv4 and IPv6
+    /// ones. They are returned in the order they should be tried,
+    /// alternating between the two families, starting with the
+    /// one preferred by the system. This function blocks until
+    /// the name is resolved (unless it's cached).
+    ///
+    /// \param address Decimal address or network name to resolve
+    ///
+    /// \return Addresses of the host, empty if it couldn't be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<IpAddress> resolveAll(const std::string& address);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how long resolved host names are cached
+    ///
+    /// Host names are resolved once and then cached, so that
+    /// building the same address repeatedly (in a reconnection
+    /// loop for example) doesn't query the DNS every time. The
+    /// system resolver doesn't tell the lifetime of the DNS
+    /// records, so cached names are kept for \a lifetime, and
+    /// names that failed to resolve for at most 5 seconds. The
+    /// default lifetime is 60 seconds; Time::Zero disables the
+    /// cache.
+    ///
+    /// \param lifetime Time during which a resolved host name is reused
+    ///
+    /// \see clearResolverCache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setResolverCacheLifetime(Time lifetime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the cached host names
+    ///
+    /// \see setResolverCacheLifetime
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearResolverCache();
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
-    static const IpAddress None;      ///< Value representing an empty/invalid address
-    static const IpAddress Any;       ///< Value representing any address (0.0.0.0)
-    static const IpAddress LocalHost; ///< The "localhost" address (for connecting a computer to itself locally)
-    static const IpAddress Broadcast; ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress None;        ///< Value representing an empty/invalid address
+    static const IpAddress Any;         ///< Value representing any address (0.0.0.0)
+    static const IpAddress LocalHost;   ///< The "localhost" address (for connecting a computer to itself locally)
+    static const IpAddress Broadcast;   ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress AnyV6;       ///< Value representing any IPv6 address (::); sockets bound to it accept both IPv4 and IPv6
+    static const IpAddress LocalHostV6; ///< The IPv6 "localhost" address (::1)
 
 private:
 
@@ -201,8 +322,78 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Uint32 m_address; ///< Address stored as an unsigned 32 bits integer
-    bool   m_valid;   ///< Is the address valid?
+    Uint32 m_address;   ///< IPv4 address stored as an unsigned 32 bits integer
+    Uint8  m_bytes[16]; ///< Bytes of the IPv6 address
+    Family m_family;    ///< Family of the address
+    bool   m_valid;     ///< Is the address valid?
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Handle to an address being resolved asynchronously
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API IpAddress::AsyncResolution : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty handle, not tracking any resolution.
+    ///
+    ////////////////////////////////////////////////////////////
+    AsyncResolution();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Cancels the resolution if it is still in progress.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~AsyncResolution();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the resolution is finished
+    ///
+    /// \return True if the address is available with getAddress()
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDone() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the resolution is still in progress
+    ///
+    /// \return True if a resolution was started and is not finished yet
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the resolved address
+    ///
+    /// \return Resolved address, or sf::IpAddress::None if the
+    ///         resolution failed or is not finished
+    ///
+    ////////////////////////////////////////////////////////////
+    IpAddress getAddress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Abort the resolution
+    ///
+    /// The handle becomes empty again. Calling this function
+    /// on an empty handle has no effect.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel();
+
+private:
+
+    friend class IpAddress;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ResolveJob* m_job; ///< Resolution tracked by the handle, shared with the worker thread
 };
 
 ////////////////////////////////////////////////////////////
@@ -322,7 +513,22 @@ SFML_NETWORK_API std::ostream& operator <<(std::ostream& stream, const IpAddress
 /// sf::IpAddress a9 = sf::IpAddress::getPublicAddress(); // my address on the internet
 /// \endcode
 ///
-/// Note that sf::IpAddress currently doesn't support IPv6
-/// nor other types of network addresses.
+/// Resolving a network name may take a while; resolveAsync
+/// does it without blocking:
+/// \code
+/// sf::IpAddress::AsyncResolution resolution;
+/// sf::IpAddress::resolveAsync("www.google.com", resolution);
+/// while (!resolution.isDone())
+/// {
+///     // ... do something else ...
+/// }
+/// sf::IpAddress address = resolution.getAddress();
+/// \endcode
+///
+/// IPv6 addresses are supported as well:
+/// \code
+/// sf::IpAddress b0("2001:db8::1");                     // an IPv6 address
+/// sf::IpAddress b1 = sf::IpAddress::LocalHostV6;        // the IPv6 local host address (::1)
+/// \endcode
 ///
 ////////////////////////////////////////////////////////////
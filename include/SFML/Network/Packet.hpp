@@ -51,6 +51,27 @@ class SFML_NETWORK_API Packet
 
 public:
 
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        InlineCapacity = 256 ///< Number of bytes that a packet can hold without allocating memory
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read-only view of a string stored in the packet
+    ///
+    /// The characters are not null-terminated. The view remains
+    /// valid as long as the packet is not modified or destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct StringView
+    {
+        const char* data;   ///< First byte of the string, NULL if it is empty
+        std::size_t length; ///< Number of bytes of the string
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -65,6 +86,50 @@ public:
     ////////////////////////////////////////////////////////////
     virtual ~Packet();
 
+#ifdef SFML_HAS_MOVE_SEMANTICS
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(const Packet& copy) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    ///
+    /// The packet takes over the storage of \a right, which is
+    /// left empty. Only the data of small packets, stored inside
+    /// the instance, is copied.
+    ///
+    /// \param right Instance to move
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(Packet&& right) : Packet() {swap(right);}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& operator =(const Packet& right) = default;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of move assignment operator
+    ///
+    /// \param right Instance to move, left empty
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& operator =(Packet&& right) {Packet temp; temp.swap(right); swap(temp); return *this;}
+
+#endif
+
     ////////////////////////////////////////////////////////////
     /// \brief Append data to the end of the packet
     ///
@@ -86,6 +151,23 @@ public:
     ////////////////////////////////////////////////////////////
     void clear();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve storage for a given amount of data
+    ///
+    /// Packets store up to InlineCapacity bytes inside the
+    /// packet instance itself; beyond that, memory is allocated
+    /// as data is appended. If the final size of the packet is
+    /// known in advance, reserving it avoids the intermediate
+    /// reallocations. The reserved storage is kept by clear,
+    /// so a packet reused for similar messages only allocates once.
+    ///
+    /// \param sizeInBytes Number of bytes to reserve
+    ///
+    /// \see append, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t sizeInBytes);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a pointer to the data contained in the packet
     ///
@@ -121,6 +203,11 @@ public:
     /// This function is useful to know if there is some data
     /// left to be read, without actually reading it.
     ///
+    /// After bit-level reads (see readBits), the end is reached
+    /// as soon as the last byte has started to be read: its
+    /// remaining bits can't be told apart from the padding
+    /// left by appendBits.
+    ///
     /// \return True if all data was read, false otherwise
     ///
     /// \see operator bool
@@ -128,6 +215,17 @@ public:
     ////////////////////////////////////////////////////////////
     bool endOfPacket() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this packet with those of another
+    ///
+    /// The data, the reading position and the sending position
+    /// are exchanged; no allocated storage is copied.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Packet& right);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -332,10 +430,361 @@ public:
     ////////////////////////////////////////////////////////////
     Packet& operator <<(const String&       data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an array of values to the end of the packet
+    ///
+    /// The values are written exactly as if operator << had been
+    /// called for each of them, so that the receiver can read
+    /// them either with readArray or element by element. The
+    /// storage is grown once for the whole array and the byte
+    /// order conversion is done in a single pass (or skipped
+    /// entirely when the host already uses the network byte
+    /// order), which is much faster for large arrays.
+    ///
+    /// The number of elements is not written; send it first
+    /// if the receiver doesn't know it.
+    ///
+    /// \param data  Pointer to the first element of the array
+    /// \param count Number of elements in the array
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Int8*   data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Uint8*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Int16*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Uint16* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Int32*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Uint32* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Int64*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const Uint64* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const float*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& appendArray(const double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of values from the packet
+    ///
+    /// This is the bulk equivalent of calling operator >> for
+    /// each element. If the packet doesn't contain \a count
+    /// elements, nothing is read and the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of elements to read
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Int8*   data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Uint8*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Int16*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Uint16* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Int32*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Uint32* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Int64*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(Uint64* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(float*  data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a string to the packet, encoded in UTF-8
+    ///
+    /// operator << writes every character of a wide string as a
+    /// 32-bit value. This function writes the byte length of the
+    /// string followed by its UTF-8 encoding instead, which is up
+    /// to 4 times smaller for latin text. The receiver must read
+    /// the string with readUtf8.
+    ///
+    /// \param data String to append
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readUtf8
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendUtf8(const String& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a string written by appendUtf8
+    ///
+    /// \param data String to fill
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendUtf8
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readUtf8(String& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \overload
+    ////////////////////////////////////////////////////////////
+    Packet& readUtf8(std::wstring& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a string without copying it out of the packet
+    ///
+    /// Strings written with operator << (std::string or
+    /// const char*) and with appendUtf8 share the same layout:
+    /// this function reads either of them and returns a view of
+    /// its bytes in the packet buffer, without allocating. For
+    /// strings written by appendUtf8, the bytes are UTF-8 and can
+    /// be decoded in place with sf::Utf8.
+    ///
+    /// \param data View to fill, empty if the string is empty or can't be read
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readUtf8
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readStringView(StringView& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a value using only a given number of bits
+    ///
+    /// Consecutive bit-level writes are packed together without
+    /// any padding, least significant bits first. Byte-level
+    /// writes (operator <<, append, ...) always start on a new
+    /// byte, leaving the unused bits of the last one at zero;
+    /// reads follow the same rule, so both sides stay in sync
+    /// as long as they perform the same sequence of operations.
+    ///
+    /// The packet doesn't store how many bits of its last byte
+    /// are used, so endOfPacket() can't tell the last values
+    /// from the padding when several of them share the last
+    /// byte. Write their count first rather than reading until
+    /// endOfPacket() if that can happen.
+    ///
+    /// \param value    Value to write (only the low \a bitCount bits are kept)
+    /// \param bitCount Number of bits to write, between 1 and 32
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readBits
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendBits(Uint32 value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a value written by appendBits
+    ///
+    /// Once the last byte has started to be read, endOfPacket()
+    /// returns true even if some of its bits are left.
+    ///
+    /// \param value    Variable to fill
+    /// \param bitCount Number of bits to read, between 1 and 32
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendBits
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readBits(Uint32& value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a float quantized to a given number of bits
+    ///
+    /// The value is clamped to [\a min, \a max] and mapped to
+    /// an integer of \a bitCount bits, so the precision is
+    /// (max - min) / (2^bitCount - 1).
+    ///
+    /// \param value    Value to write
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits to write, between 1 and 32
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readQuantized, appendBits
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendQuantized(float value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a float written by appendQuantized
+    ///
+    /// \param value    Variable to fill
+    /// \param min      Minimum value of the range, same as when writing
+    /// \param max      Maximum value of the range, same as when writing
+    /// \param bitCount Number of bits to read, same as when writing
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendQuantized
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readQuantized(float& value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an unsigned integer with a variable-length encoding
+    ///
+    /// The value is written 7 bits at a time, so small values
+    /// take a single byte instead of 8.
+    ///
+    /// \param value Value to write
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readVarint, appendSignedVarint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendVarint(Uint64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer written by appendVarint
+    ///
+    /// \param value Variable to fill
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendVarint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarint(Uint64& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a signed integer with a variable-length encoding
+    ///
+    /// The value is zigzag-encoded before being written like
+    /// appendVarint, so that small negative values are as
+    /// compact as small positive ones.
+    ///
+    /// \param value Value to write
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readSignedVarint, appendVarint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendSignedVarint(Int64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a signed integer written by appendSignedVarint
+    ///
+    /// \param value Variable to fill
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendSignedVarint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readSignedVarint(Int64& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an array of fields as a delta against a baseline
+    ///
+    /// Each field takes a single bit if it is equal to its
+    /// baseline, otherwise a bit followed by the difference
+    /// encoded like appendSignedVarint. This is typically used
+    /// to replicate a state that the receiver already knows
+    /// (the baseline), of which only a few fields change.
+    ///
+    /// \param values   Pointer to the current fields
+    /// \param baseline Pointer to the baseline fields
+    /// \param count    Number of fields
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see readDelta
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& appendDelta(const Uint32* values, const Uint32* baseline, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of fields written by appendDelta
+    ///
+    /// \param values   Pointer to the fields to fill
+    /// \param baseline Pointer to the baseline fields, same as when writing
+    /// \param count    Number of fields
+    ///
+    /// \return Reference to the packet
+    ///
+    /// \see appendDelta
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readDelta(Uint32* values, const Uint32* baseline, std::size_t count);
+
 protected:
 
     friend class TcpSocket;
     friend class UdpSocket;
+    friend class UdpConnection;
 
     ////////////////////////////////////////////////////////////
     /// \brief Called before the packet is sent over the network
@@ -397,13 +846,56 @@ private:
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an array of elements, in network byte order
+    ///
+    /// \param data        Pointer to the first element
+    /// \param count       Number of elements
+    /// \param elementSize Size of an element, in bytes
+    /// \param swap        Convert the elements to network byte order?
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendElements(const void* data, std::size_t count, std::size_t elementSize, bool swap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of elements, from network byte order
+    ///
+    /// \param data        Pointer to the array to fill
+    /// \param count       Number of elements
+    /// \param elementSize Size of an element, in bytes
+    /// \param swap        Convert the elements from network byte order?
+    ///
+    ////////////////////////////////////////////////////////////
+    void readElements(void* data, std::size_t count, std::size_t elementSize, bool swap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the storage of the packet data
+    ///
+    /// \return Pointer to the inline buffer or to the allocated storage
+    ///
+    ////////////////////////////////////////////////////////////
+    char* getBuffer();
+    const char* getBuffer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes that the storage can hold
+    ///
+    /// \return Capacity of the storage, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    std::size_t       m_sendPos; ///< Current send position in the packet (for handling partial sends)
-    bool              m_isValid; ///< Reading state of the packet
+    char              m_inlineData[InlineCapacity]; ///< Storage of small packets, used until the data no longer fits
+    std::vector<char> m_heapData;                   ///< Storage of large packets (its size is the capacity)
+    std::size_t       m_size;                       ///< Number of bytes stored in the packet
+    std::size_t       m_readPos;                    ///< Current reading position in the packet
+    std::size_t       m_sendPos;                    ///< Current send position in the packet (for handling partial sends)
+    unsigned int      m_writeBitPos;                ///< Number of bits already used in the last byte (0 if byte-aligned)
+    unsigned int      m_readBitPos;                 ///< Number of bits already read in the current byte (0 if byte-aligned)
+    bool              m_isValid;                    ///< Reading state of the packet
 };
 
 } // namespace sf
@@ -434,6 +926,12 @@ private:
 /// Indeed, the native C++ types may have different sizes on two platforms
 /// and your data may be corrupted if that happens.
 ///
+/// Up to sf::Packet::InlineCapacity bytes are stored inside
+/// the packet itself, so small messages never allocate memory.
+/// Bigger packets allocate their storage once and keep it when
+/// they are cleared; reserve can be used to allocate it upfront,
+/// and sf::PacketPool to recycle packets between messages.
+///
 /// Usage example:
 /// \code
 /// sf::Uint32 x = 24;
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PACKETPOOL_HPP
+#define SFML_PACKETPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Thread-safe pool of reusable packets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param maxCount Maximum number of released packets kept for reuse
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketPool(std::size_t maxCount = 256);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys the packets waiting in the pool. Packets that
+    /// are still acquired are not owned by the pool anymore
+    /// and must be deleted by their user.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an empty packet from the pool
+    ///
+    /// A previously released packet is reused if there is one,
+    /// along with the storage that it had allocated; otherwise
+    /// a new packet is created.
+    ///
+    /// \return Pointer to an empty packet, to give back with release
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet* acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a packet back to the pool
+    ///
+    /// The packet is cleared and kept for a later call to
+    /// acquire, unless the pool already holds its maximum
+    /// number of packets, in which case it is destroyed.
+    /// The packet must not be used after this call.
+    ///
+    /// \param packet Packet previously returned by acquire
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Packet* packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create packets in advance
+    ///
+    /// This function fills the pool so that the next \a count
+    /// calls to acquire don't allocate. Each packet can also
+    /// reserve some storage (see Packet::reserve).
+    ///
+    /// \param count       Number of packets that the pool must contain
+    /// \param sizeInBytes Storage to reserve in each new packet
+    ///
+    ////////////////////////////////////////////////////////////
+    void preallocate(std::size_t count, std::size_t sizeInBytes = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the packets waiting in the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of packets waiting in the pool
+    ///
+    /// \return Number of packets available for reuse
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Packet*> m_packets;  ///< Packets available for reuse
+    std::size_t          m_maxCount; ///< Maximum number of packets kept in the pool
+    mutable Mutex        m_mutex;    ///< Mutex protecting the pool
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// Creating a new sf::Packet for each message of a chatty
+/// protocol means allocating memory for every message that
+/// doesn't fit in the packet's inline buffer. sf::PacketPool
+/// keeps released packets, along with the storage they have
+/// allocated, and hands them out again, so that a steady
+/// stream of messages stops hitting the heap.
+///
+/// The pool can be shared by several threads, for example
+/// a network thread filling packets and a game thread
+/// consuming them.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool;
+///
+/// // Network thread
+/// sf::Packet* packet = pool.acquire();
+/// if (socket.receive(*packet) == sf::Socket::Done)
+///     queue.push(packet);
+/// else
+///     pool.release(packet);
+///
+/// // Game thread
+/// sf::Packet* packet = queue.pop();
+/// *packet >> x >> y;
+/// pool.release(packet);
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -29,8 +29,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 #include <vector>
 
 
@@ -68,6 +70,52 @@ public:
         AnyPort = 0 ///< Special value that tells the system to pick any available port
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Options tuning the behavior of the socket
+    ///
+    /// Boolean options are enabled by any non-zero value.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Option
+    {
+        SendBufferSize,    ///< Size of the system send buffer, in bytes (SO_SNDBUF)
+        ReceiveBufferSize, ///< Size of the system receive buffer, in bytes (SO_RCVBUF)
+        ReusePort,         ///< Let several sockets bind the same port, the system spreading the traffic among them (SO_REUSEPORT)
+        NoDelay,           ///< TCP only: send small segments immediately instead of merging them (TCP_NODELAY), enabled by default
+        QuickAck,          ///< TCP only: acknowledge received segments immediately instead of delaying the acknowledgments (TCP_QUICKACK)
+        Cork,              ///< TCP only: hold partial segments until the option is disabled or the segments are full (TCP_CORK, TCP_NOPUSH)
+        BusyPoll,          ///< Time to busy-poll the network device when waiting for data, in microseconds (SO_BUSY_POLL)
+        TypeOfService,     ///< DSCP and ECN bits of the outgoing packets, the DSCP code point being value >> 2 (IP_TOS, IPV6_TCLASS)
+        MulticastTtl,      ///< UDP only: number of hops outgoing multicast datagrams may cross, 1 by default (IP_MULTICAST_TTL, IPV6_MULTICAST_HOPS)
+        MulticastLoopback, ///< UDP only: deliver the multicast datagrams sent by this host to its own sockets, enabled by default (IP_MULTICAST_LOOP, IPV6_MULTICAST_LOOP)
+
+        OptionCount        ///< Keep last -- the total number of socket options
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the system calls made by sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// All the counters are initialized to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Uint64 sendCalls;      ///< Number of system calls that sent data
+        Uint64 receiveCalls;   ///< Number of system calls that received data
+        Uint64 bytesSent;      ///< Number of bytes handed to the system
+        Uint64 bytesReceived;  ///< Number of bytes read from the system
+        Uint64 partialSends;   ///< Number of sends that returned Partial, and had to be resumed
+        Uint64 notReady;       ///< Number of system calls that returned without data because the socket would block
+        Uint64 selectorWaits;  ///< Global only: number of waits of the socket selectors and pollers
+        Time   selectorTime;   ///< Global only: time spent blocked in the waits of the socket selectors and pollers
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -105,6 +153,94 @@ public:
     ////////////////////////////////////////////////////////////
     bool isBlocking() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set an option of the socket
+    ///
+    /// Options can be set at any time: if the socket is not
+    /// created yet, they are applied as soon as it is (before
+    /// it is bound or connected, which is required by ReusePort).
+    ///
+    /// Options that the operating system doesn't provide, or
+    /// that don't apply to the type of the socket (TCP options
+    /// on a UDP socket), are ignored and this function returns
+    /// false. Note that Linux disables QuickAck again after some
+    /// operations, so it may have to be set after every receive.
+    ///
+    /// \param option Option to set
+    /// \param value  New value of the option
+    ///
+    /// \return True if the option is supported and was applied
+    ///
+    /// \see getOption
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setOption(Option option, int value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of an option of the socket
+    ///
+    /// If the socket is created, the value is read back from the
+    /// system, and may differ from the one that was set (Linux
+    /// doubles the size of the buffers for example). Otherwise
+    /// the value set with setOption is returned.
+    ///
+    /// \param option Option to get
+    ///
+    /// \return Value of the option, or -1 if it is unsupported
+    ///         or was never set on a socket not created yet
+    ///
+    /// \see setOption
+    ///
+    ////////////////////////////////////////////////////////////
+    int getOption(Option option) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the socket
+    ///
+    /// The counters accumulate from the construction of the
+    /// socket, or the latest call to resetStatistics, across
+    /// its successive connections. They are updated without
+    /// synchronization: read them from the thread that uses
+    /// the socket.
+    ///
+    /// \return Statistics of the socket
+    ///
+    /// \see resetStatistics, getGlobalStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the statistics of the socket to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of all the sockets of the program
+    ///
+    /// The global counters sum the ones of every socket, including
+    /// the sockets already destroyed, and measure the time spent in
+    /// sf::SocketSelector::wait and sf::SocketPoller::wait. They
+    /// are updated atomically and can be read from any thread.
+    ///
+    /// \return Statistics of all the sockets
+    ///
+    /// \see resetGlobalStatistics, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getGlobalStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the global statistics to zero
+    ///
+    /// \see getGlobalStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetGlobalStatistics();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -139,13 +275,28 @@ protected:
     ////////////////////////////////////////////////////////////
     SocketHandle getHandle() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the address family of the socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \return Family of the addresses used by the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    IpAddress::Family getFamily() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
     ///
+    /// IPv6 sockets are dual-stack: they can also communicate
+    /// with IPv4 addresses. If the system doesn't support IPv6,
+    /// an IPv4 socket is created instead.
     /// This function can only be accessed by derived classes.
     ///
+    /// \param family Family of the addresses used by the socket
+    ///
     ////////////////////////////////////////////////////////////
-    void create();
+    void create(IpAddress::Family family = IpAddress::IPv4);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
@@ -166,16 +317,59 @@ protected:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a system call that sent data
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param status Status returned by the call
+    /// \param size   Number of bytes sent
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordSend(Status status, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a system call that received data
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param status Status returned by the call
+    /// \param size   Number of bytes received
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordReceive(Status status, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a send that returned Partial
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordPartialSend();
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a wait of a socket selector or poller
+    ///
+    /// \param duration Time spent blocked in the wait
+    ///
+    ////////////////////////////////////////////////////////////
+    static void recordWait(Time duration);
+
     friend class SocketSelector;
+    friend class SocketPoller;
+    friend class Ftp;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;       ///< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;     ///< Socket descriptor
-    bool         m_isBlocking; ///< Current blocking mode of the socket
+    Type              m_type;                 ///< Type of the socket (TCP or UDP)
+    SocketHandle      m_socket;               ///< Socket descriptor
+    bool              m_isBlocking;           ///< Current blocking mode of the socket
+    IpAddress::Family m_family;               ///< Family of the addresses used by the socket
+    int               m_options[OptionCount]; ///< Values of the options to apply to the socket, -1 for the system default
+    Statistics        m_statistics;           ///< Counters of the system calls made by the socket
 };
 
 } // namespace sf
@@ -192,9 +386,9 @@ private:
 /// derived classes.
 ///
 /// The only public features that it defines, and which
-/// is therefore common to all the socket classes, is the
-/// blocking state. All sockets can be set as blocking or
-/// non-blocking.
+/// are therefore common to all the socket classes, are the
+/// blocking state and the options. All sockets can be set
+/// as blocking or non-blocking.
 ///
 /// In blocking mode, socket functions will hang until
 /// the operation completes, which means that the entire
@@ -214,6 +408,32 @@ private:
 /// the socket often enough, and cannot afford blocking
 /// this loop.
 ///
+/// The options (setOption) tune the system behavior of the
+/// socket for throughput or latency: system buffer sizes,
+/// port sharing between the listeners of several threads,
+/// acknowledgment and segment policies of TCP, busy polling
+/// and marking of the packets for QoS. They are platform
+/// specific, and simply ignored where unavailable.
+/// \code
+/// sf::TcpListener listener;
+/// listener.setOption(sf::Socket::ReusePort, 1);
+/// listener.setOption(sf::Socket::TypeOfService, 46 << 2); // DSCP "expedited forwarding"
+/// listener.listen(53000);
+/// \endcode
+///
+/// Every socket counts the system calls it makes and the
+/// bytes it transfers (getStatistics), and the same counters
+/// are summed for the whole program, along with the time
+/// spent waiting in the selectors (getGlobalStatistics).
+/// Counting costs a few additions per system call, so the
+/// statistics are always available. The waits and the packet
+/// transfers also show up as zones in sf::Profiler captures.
+/// \code
+/// const sf::Socket::Statistics& stats = socket.getStatistics();
+/// std::cout << stats.bytesSent << " bytes in " << stats.sendCalls << " calls, "
+///           << stats.partialSends << " partial sends" << std::endl;
+/// \endcode
+///
 /// \see sf::TcpListener, sf::TcpSocket, sf::UdpSocket
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOCKETPOLLER_HPP
+#define SFML_SOCKETPOLLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Socket;
+
+////////////////////////////////////////////////////////////
+/// \brief Scalable multiplexer that waits on many sockets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SocketPoller : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Events that a socket can be waited for
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Event
+    {
+        Receive = 1 << 0, ///< The socket has data to receive, or a connection to accept
+        Send    = 1 << 1  ///< The socket can send data without blocking
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SocketPoller();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SocketPoller();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a socket to the poller, or change its events
+    ///
+    /// This function keeps a weak reference to the socket,
+    /// so you have to make sure that the socket is not destroyed
+    /// or closed while it is stored in the poller: its handle
+    /// would change when it is reconnected.
+    /// Adding a socket that is already in the poller replaces
+    /// the events it is waited for.
+    ///
+    /// \param socket Reference to the socket to add
+    /// \param events Combination of sf::SocketPoller::Event flags to wait for
+    ///
+    /// \return True if the socket was added, false if it is not valid or an error occurred
+    ///
+    /// \see remove, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(Socket& socket, unsigned int events = Receive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a socket from the poller
+    ///
+    /// This function doesn't destroy the socket, it simply
+    /// removes the reference that the poller has to it. The
+    /// socket is also removed from the list of ready sockets.
+    ///
+    /// \param socket Reference to the socket to remove
+    ///
+    /// \see add, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Socket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the sockets stored in the poller
+    ///
+    /// \see add, remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets stored in the poller
+    ///
+    /// \return Number of sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSocketCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until one or more sockets are ready
+    ///
+    /// This function returns as soon as at least one socket is
+    /// ready for one of the events it was added with. The ready
+    /// sockets are then listed by getReadySocket(), so that the
+    /// cost of handling them depends on their number and not on
+    /// the total number of sockets.
+    /// Sockets in error or disconnected are reported ready for
+    /// all their events, the next operation on them returns
+    /// the error.
+    /// If you use a timeout and no socket is ready before the
+    /// timeout is over, the function returns 0.
+    ///
+    /// \param timeout Maximum time to wait, (use Time::Zero for infinity)
+    ///
+    /// \return Number of sockets ready
+    ///
+    /// \see getReadyCount, getReadySocket, getReadyEvents
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t wait(Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets found ready by the last wait
+    ///
+    /// \return Number of sockets ready
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadyCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a socket found ready by the last wait
+    ///
+    /// \param index Index of the ready socket, in the range [0, getReadyCount())
+    ///
+    /// \return Reference to the ready socket
+    ///
+    /// \see getReadyEvents, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket& getReadySocket(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the events for which a socket is ready
+    ///
+    /// \param index Index of the ready socket, in the range [0, getReadyCount())
+    ///
+    /// \return Combination of sf::SocketPoller::Event flags
+    ///
+    /// \see getReadySocket, wait
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getReadyEvents(std::size_t index) const;
+
+private:
+
+    struct SocketPollerImpl;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Socket found ready by the last wait
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ReadySocket
+    {
+        Socket*      socket; ///< The ready socket
+        unsigned int events; ///< Events it is ready for
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SocketPollerImpl*        m_impl;  ///< Opaque pointer to the implementation (which requires OS-specific types)
+    std::vector<ReadySocket> m_ready; ///< Sockets found ready by the last wait
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOCKETPOLLER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SocketPoller
+/// \ingroup network
+///
+/// sf::SocketSelector is built on select(), which limits the
+/// number of sockets it can handle and scans all of them on
+/// every call. Servers holding thousands of connections need
+/// a multiplexer whose cost grows with the number of sockets
+/// that are actually ready.
+///
+/// sf::SocketPoller uses the scalable mechanism of the system:
+/// epoll on Linux and Android, kqueue on macOS, iOS and BSD,
+/// and poll() elsewhere (WSAPoll on Windows). Sockets are
+/// registered once with the events to wait for (receive, send
+/// or both); wait() then returns the list of ready sockets
+/// directly, there is no need to test every socket.
+///
+/// Like sf::SocketSelector, the poller keeps weak references
+/// to the sockets, which must stay alive and connected while
+/// they are in the poller.
+///
+/// Usage example:
+/// \code
+/// sf::TcpListener listener;
+/// listener.listen(55001);
+///
+/// sf::SocketPoller poller;
+/// poller.add(listener);
+///
+/// while (running)
+/// {
+///     std::size_t count = poller.wait();
+///     for (std::size_t i = 0; i < count; ++i)
+///     {
+///         sf::Socket& socket = poller.getReadySocket(i);
+///         if (&socket == &listener)
+///         {
+///             // The listener is ready: there is a pending connection
+///             sf::TcpSocket* client = new sf::TcpSocket;
+///             if (listener.accept(*client) == sf::Socket::Done)
+///                 poller.add(*client);
+///             else
+///                 delete client;
+///         }
+///         else
+///         {
+///             // A client has sent some data, we can receive it
+///             sf::TcpSocket& client = static_cast<sf::TcpSocket&>(socket);
+///             sf::Packet packet;
+///             if (client.receive(packet) == sf::Socket::Disconnected)
+///             {
+///                 poller.remove(client);
+///                 ...
+///             }
+///         }
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::SocketSelector
+///
+////////////////////////////////////////////////////////////
@@ -111,17 +111,37 @@ public:
     /// some data available to be received. To know which sockets are
     /// ready, use the isReady function.
     /// If you use a timeout and no socket is ready before the timeout
-    /// is over, the function returns false.
+    /// is over, the function returns false. It also returns false
+    /// when another thread interrupts the wait before any socket
+    /// is ready.
     ///
     /// \param timeout Maximum time to wait, (use Time::Zero for infinity)
     ///
     /// \return True if there are sockets ready, false otherwise
     ///
-    /// \see isReady
+    /// \see isReady, interrupt
     ///
     ////////////////////////////////////////////////////////////
     bool wait(Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the current or next wait return immediately
+    ///
+    /// This function can be called from any thread, typically
+    /// to wake up a network thread blocked in wait so that it
+    /// sends data that was just queued. If no wait is running,
+    /// the next one returns immediately: an interruption is
+    /// never lost between two waits. Several interruptions
+    /// before a wait returns are merged into one.
+    ///
+    /// The selector must not be destroyed or assigned while
+    /// another thread interrupts it.
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void interrupt();
+
     ////////////////////////////////////////////////////////////
     /// \brief Test a socket to know if it is ready to receive data
     ///
@@ -153,6 +173,12 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the channel that interrupt signals
+    ///
+    ////////////////////////////////////////////////////////////
+    void createWakeUp();
+
     struct SocketSelectorImpl;
 
     ////////////////////////////////////////////////////////////
@@ -258,6 +284,29 @@ private:
 /// }
 /// \endcode
 ///
+/// A thread blocked in wait can be woken up by another one
+/// with interrupt, for example when the game thread queues a
+/// message for the network thread. This avoids polling the
+/// queue with a short timeout:
+/// \code
+/// // Game thread
+/// queue.push(message);
+/// selector.interrupt();
+///
+/// // Network thread
+/// while (running)
+/// {
+///     selector.wait();
+///
+///     // Send the queued messages, whether the wait was interrupted or not
+///     while (queue.pop(message))
+///         socket.send(message);
+///
+///     // Receive from the ready sockets
+///     ...
+/// }
+/// \endcode
+///
 /// \see sf::Socket
 ///
 ////////////////////////////////////////////////////////////
@@ -74,6 +74,11 @@ public:
     /// function is called, it will stop listening on the old
     /// port before starting to listen on the new port.
     ///
+    /// The family of \a address decides the one of the socket:
+    /// listening on IpAddress::AnyV6 accepts both IPv6 and IPv4
+    /// connections (the latter are reported with their IPv4
+    /// address), whereas IpAddress::Any only accepts IPv4.
+    ///
     /// \param port    Port to listen on for incoming connection attempts
     /// \param address Address of the interface to listen on
     ///
@@ -109,6 +114,41 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     Status accept(TcpSocket& socket);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept all the pending connections at once
+    ///
+    /// This function fills the given sockets with as many
+    /// pending connections as possible, up to \a count, which
+    /// absorbs bursts of incoming connections much faster than
+    /// accepting them one per wake-up. If the listener is in
+    /// blocking mode, it waits for the first connection only.
+    ///
+    /// Each socket keeps its own blocking mode; on Linux the
+    /// connections are created directly in that mode.
+    ///
+    /// \param sockets  Array of pointers to the sockets that will hold the new connections
+    /// \param count    Number of sockets in the array
+    /// \param accepted This variable is filled with the number of connections accepted
+    ///
+    /// \return Status code (sf::Socket::Done if at least one connection was accepted)
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    Status accept(TcpSocket* const* sockets, std::size_t count, std::size_t& accepted);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept a pending connection into a socket
+    ///
+    /// \param socket Socket that will hold the new connection
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status acceptOne(TcpSocket& socket);
 };
 
 
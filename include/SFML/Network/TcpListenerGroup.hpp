@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TCPLISTENERGROUP_HPP
+#define SFML_TCPLISTENERGROUP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class TcpListener;
+class TcpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Group of listeners accepting the connections
+///        of a port from several threads
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API TcpListenerGroup : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Abstract class receiving the accepted connections
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Handler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Handler() {}
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a new connection is accepted
+        ///
+        /// This function is called from the thread that accepted
+        /// the connection, so it can be called concurrently from
+        /// several threads and must be thread-safe; it should
+        /// also return quickly, since no connection is accepted
+        /// by its thread meanwhile. The socket is blocking, and
+        /// belongs to the handler, which must delete it.
+        ///
+        /// \param socket Newly connected socket
+        /// \param thread Index of the thread that accepted the connection
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onConnection(TcpSocket* socket, std::size_t thread) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TcpListenerGroup();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops listening, see close().
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TcpListenerGroup();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start listening to a port from several threads
+    ///
+    /// This function opens \a threadCount listeners on the same
+    /// port with the ReusePort option, and starts a thread
+    /// accepting the connections of each listener: the system
+    /// then spreads the incoming connections among them. If the
+    /// system doesn't support ReusePort, all the threads accept
+    /// the connections of a single listener instead.
+    ///
+    /// If the group was already listening, it is closed first.
+    /// If \a port is sf::Socket::AnyPort, the system picks one
+    /// for the whole group (see getLocalPort).
+    ///
+    /// \param port        Port to listen on for incoming connection attempts
+    /// \param threadCount Number of accepting threads (at least 1)
+    /// \param handler     Handler receiving the accepted connections
+    /// \param address     Address of the interface to listen on
+    ///
+    /// \return Status code
+    ///
+    /// \see close
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status listen(unsigned short port, std::size_t threadCount, Handler& handler, const IpAddress& address = IpAddress::Any);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop listening
+    ///
+    /// This function waits until the threads are finished, so it
+    /// can take a fraction of a second, and the handler is not
+    /// called anymore once it returns. Connections still pending
+    /// in the queues of the listeners are refused.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port to which the group is listening
+    ///
+    /// \return Port to which the group is listening, or 0 if it doesn't listen
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getLocalPort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of accepting threads
+    ///
+    /// \return Number of threads, 0 if the group doesn't listen
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether each thread has its own listener
+    ///
+    /// \return True if the port is shared by several listeners,
+    ///         false if the threads share a single listener
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSharded() const;
+
+private:
+
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the threads must keep running
+    ///
+    /// \return True until the group is closed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRunning();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<TcpListener*> m_listeners; ///< Listeners sharing the port
+    std::vector<Worker*>      m_workers;   ///< Accepting threads
+    Handler*                  m_handler;   ///< Handler receiving the accepted connections
+    bool                      m_running;   ///< Must the threads keep running?
+    Mutex                     m_mutex;     ///< Mutex protecting the running flag
+};
+
+} // namespace sf
+
+
+#endif // SFML_TCPLISTENERGROUP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TcpListenerGroup
+/// \ingroup network
+///
+/// A single sf::TcpListener accepting the connections from
+/// one thread limits the rate at which a server can accept
+/// new clients. sf::TcpListenerGroup removes this bottleneck:
+/// it opens several listeners on the same port, thanks to the
+/// ReusePort socket option, and each of them is serviced by
+/// its own thread. The system balances the incoming
+/// connections among the listeners, and each thread accepts
+/// them in batches.
+///
+/// The accepted connections are given to a handler, from the
+/// thread that accepted them. A typical handler dispatches
+/// them to the threads or the pollers of the server.
+///
+/// Where ReusePort is not available (Windows for example),
+/// the threads share a single listener, which still spreads
+/// the work of accepting the connections but without the
+/// load balancing of the system.
+///
+/// Usage example:
+/// \code
+/// class Server : public sf::TcpListenerGroup::Handler
+/// {
+/// public:
+///
+///     virtual void onConnection(sf::TcpSocket* socket, std::size_t thread)
+///     {
+///         sf::Lock lock(m_mutex);
+///         m_newClients.push_back(socket);
+///     }
+///
+///     ...
+/// };
+///
+/// Server server;
+/// sf::TcpListenerGroup listeners;
+/// if (listeners.listen(55001, 4, server) != sf::Socket::Done)
+/// {
+///     // error...
+/// }
+/// \endcode
+///
+/// \see sf::TcpListener, sf::TcpSocket
+///
+////////////////////////////////////////////////////////////
@@ -100,17 +100,81 @@ public:
     /// If the socket is already connected, the connection is
     /// forcibly disconnected before attempting to connect again.
     ///
+    /// In non-blocking mode, this function only starts connecting:
+    /// it usually returns sf::Socket::NotReady, and the socket
+    /// becomes ready for sending (see sf::SocketPoller or
+    /// sf::SocketSelector) once the attempt is over. Then call
+    /// finishConnect to know whether it succeeded.
+    ///
     /// \param remoteAddress Address of the remote peer
     /// \param remotePort    Port of the remote peer
-    /// \param timeout       Optional maximum time to wait
+    /// \param timeout       Optional maximum time to wait (ignored in non-blocking mode)
     ///
     /// \return Status code
     ///
-    /// \see disconnect
+    /// \see disconnect, finishConnect
     ///
     ////////////////////////////////////////////////////////////
     Status connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to a remote host, given by its name
+    ///
+    /// The host name is resolved to all its addresses (IPv4 and
+    /// IPv6), which are raced as described by "happy eyeballs"
+    /// (RFC 8305): a connection attempt is started to each
+    /// address in turn, without waiting more than 250 ms for the
+    /// previous ones to succeed, and the first one established
+    /// is kept. This way, a broken IPv6 route or an unreachable
+    /// address cost a short delay rather than a long timeout.
+    ///
+    /// In non-blocking mode, or if the host has a single address,
+    /// this is equivalent to connect(const IpAddress&, unsigned short, Time)
+    /// with the preferred address of the host.
+    ///
+    /// \param remoteHost Name or address of the remote host
+    /// \param remotePort Port of the remote peer
+    /// \param timeout    Optional maximum time to wait
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect, finishConnect
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const std::string& remoteHost, unsigned short remotePort, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to a remote host, given by its name
+    ///
+    /// This is equivalent to connect(const std::string&, unsigned short, Time),
+    /// it is defined so that calls with literal strings are not
+    /// ambiguous.
+    ///
+    /// \param remoteHost Name or address of the remote host
+    /// \param remotePort Port of the remote peer
+    /// \param timeout    Optional maximum time to wait
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const char* remoteHost, unsigned short remotePort, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the result of a non-blocking connection attempt
+    ///
+    /// This function never blocks: it returns sf::Socket::NotReady
+    /// while the connection is still in progress, sf::Socket::Done
+    /// once the socket is connected, or an error status if the
+    /// attempt failed (in which case connect must be called
+    /// again to retry).
+    ///
+    /// \return Status code
+    ///
+    /// \see connect
+    ///
+    ////////////////////////////////////////////////////////////
+    Status finishConnect();
+
     ////////////////////////////////////////////////////////////
     /// \brief Disconnect the socket from its remote peer
     ///
@@ -203,15 +267,149 @@ public:
     ///
     /// \return Status code
     ///
-    /// \see send
+    /// \see send, setPacketBufferSize
     ///
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the buffer used to batch packet receives
+    ///
+    /// By default (size of 0), receive(Packet&) only asks the
+    /// system for the bytes of the packet being received, which
+    /// costs at least two system calls per packet. With a non-zero
+    /// size, the socket reads up to \a size bytes at once and
+    /// extracts the following packets from this buffer, which
+    /// greatly reduces the number of system calls when many small
+    /// packets are exchanged.
+    ///
+    /// Because buffered data is no longer visible to the operating
+    /// system, a sf::SocketSelector or sf::SocketPoller will not
+    /// report the socket as ready while packets remain in the
+    /// buffer: keep calling receive until it stops returning
+    /// sf::Socket::Done, or check hasBufferedPacket.
+    ///
+    /// Bytes still buffered when the size is changed are kept
+    /// and delivered first.
+    ///
+    /// \param size Size of the receive buffer, in bytes (0 to disable batching)
+    ///
+    /// \see getPacketBufferSize, hasBufferedPacket
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPacketBufferSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the buffer used to batch packet receives
+    ///
+    /// \return Size of the receive buffer, in bytes (0 if batching is disabled)
+    ///
+    /// \see setPacketBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPacketBufferSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a complete packet is already buffered
+    ///
+    /// If this function returns true, the next call to
+    /// receive(Packet&) returns a packet without waiting
+    /// for the network.
+    ///
+    /// \return True if a complete packet is waiting in the receive buffer
+    ///
+    /// \see setPacketBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasBufferedPacket() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write bytes to the connection
+    ///
+    /// This function is the single point where the socket
+    /// writes its outgoing bytes, with one attempt that may
+    /// send only a part of them. It can be redefined by derived
+    /// classes to transform the stream, for example to encrypt
+    /// it (see sf::TlsSocket). The default implementation sends
+    /// the bytes directly to the system.
+    ///
+    /// \param data    Pointer to the bytes to write
+    /// \param size    Number of bytes to write
+    /// \param written Variable to fill with the number of bytes written
+    ///
+    /// \return Status code
+    ///
+    /// \see readData
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Status writeData(const char* data, std::size_t size, std::size_t& written);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write two sequences of bytes to the connection
+    ///
+    /// This overload is used to send the size of a packet
+    /// along with its data. The default implementation gives
+    /// both buffers to the system in a single call.
+    ///
+    /// \param first      Pointer to the first bytes to write
+    /// \param firstSize  Number of bytes in \a first
+    /// \param second     Pointer to the bytes to write after \a first
+    /// \param secondSize Number of bytes in \a second
+    /// \param written    Variable to fill with the number of bytes written
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Status writeData(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize, std::size_t& written);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read bytes from the connection
+    ///
+    /// This function is the single point where the socket
+    /// reads its incoming bytes. It can be redefined by derived
+    /// classes to transform the stream, for example to decrypt
+    /// it. The default implementation receives the bytes
+    /// directly from the system.
+    ///
+    /// \param data     Pointer to the array to fill with the bytes read
+    /// \param size     Maximum number of bytes that can be read
+    /// \param received Variable to fill with the number of bytes read
+    ///
+    /// \return Status code
+    ///
+    /// \see writeData
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Status readData(char* data, std::size_t size, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Called before the connection is closed
+    ///
+    /// This function can be redefined by derived classes to
+    /// end what they layered on top of the connection. The
+    /// default implementation does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisconnect();
+
 private:
 
     friend class TcpListener;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data, going through the packet buffer
+    ///
+    /// \param data     Pointer to the array to fill with the received bytes
+    /// \param size     Maximum number of bytes that can be received
+    /// \param received This variable is filled with the actual number of bytes received
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveBuffered(char* data, std::size_t size, std::size_t& received);
+
     ////////////////////////////////////////////////////////////
     /// \brief Structure holding the data of a pending packet
     ///
@@ -223,12 +421,16 @@ private:
         Uint32            Size;         ///< Data of packet size
         std::size_t       SizeReceived; ///< Number of size bytes received so far
         std::vector<char> Data;         ///< Data of the packet
+        std::size_t       DataReceived; ///< Number of data bytes received so far
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    PendingPacket     m_pendingPacket;     ///< Temporary data of the packet currently being received
+    std::vector<char> m_receiveBuffer;     ///< Buffer holding batched received bytes
+    std::size_t       m_receiveBufferSize; ///< Maximum number of bytes read from the system at once
+    std::size_t       m_receiveBufferPos;  ///< Read position in the receive buffer
 };
 
 } // namespace sf
@@ -0,0 +1,325 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TLSSOCKET_HPP
+#define SFML_TLSSOCKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+    class TlsImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief TCP socket encrypted with TLS (client side)
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API TlsSocket : public TcpSocket
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsSocket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TlsSocket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to a remote host and secure the connection
+    ///
+    /// This function connects the socket (see TcpSocket::connect),
+    /// then performs the TLS handshake with the host, whose
+    /// certificate must be valid for \a hostName.
+    ///
+    /// In non-blocking mode, this function returns
+    /// sf::Socket::NotReady while the connection is in progress:
+    /// call finishConnect until it succeeds, and then handshake.
+    ///
+    /// \param hostName   Name or address of the remote host
+    /// \param remotePort Port of the remote host
+    /// \param timeout    Optional maximum time to wait for the TCP connection
+    ///
+    /// \return Status code
+    ///
+    /// \see handshake, disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const std::string& hostName, unsigned short remotePort, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to a remote host and secure the connection
+    ///
+    /// This is equivalent to connect(const std::string&, unsigned short, Time),
+    /// it is defined so that calls with literal strings are not
+    /// ambiguous.
+    ///
+    /// \param hostName   Name or address of the remote host
+    /// \param remotePort Port of the remote host
+    /// \param timeout    Optional maximum time to wait for the TCP connection
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const char* hostName, unsigned short remotePort, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Secure the connection established with the remote host
+    ///
+    /// This function performs the TLS handshake on a socket
+    /// which is already connected, for example by the
+    /// non-blocking version of connect. If a session with the
+    /// same host and port was established before, it is resumed,
+    /// which saves a round-trip and most of the cryptography.
+    ///
+    /// In non-blocking mode, call this function again as long as
+    /// it returns sf::Socket::NotReady.
+    ///
+    /// \param hostName Name or address of the remote host, to check its certificate
+    ///
+    /// \return Status code
+    ///
+    /// \see connect, setEarlyData
+    ///
+    ////////////////////////////////////////////////////////////
+    Status handshake(const std::string& hostName);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set data to send as part of the next handshake
+    ///
+    /// With TLS 1.3, when resuming a session that allows it, the
+    /// data is sent along with the first handshake message
+    /// ("0-RTT" early data), so that the server can answer it
+    /// one round-trip sooner. Otherwise, it is sent just after
+    /// the handshake. In both cases, the data is sent when the
+    /// handshake succeeds.
+    ///
+    /// Early data can be replayed by an attacker: only use it
+    /// for requests that can be safely processed more than once.
+    ///
+    /// \param data Pointer to the bytes to send
+    /// \param size Number of bytes to send
+    ///
+    /// \see handshake, isEarlyDataAccepted
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEarlyData(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the verification of the remote host
+    ///
+    /// By default, the handshake fails if the certificate of the
+    /// host is not trusted or not valid for its name. Disabling
+    /// the verification makes the connection vulnerable to
+    /// man-in-the-middle attacks, it should only be done for
+    /// testing purposes.
+    ///
+    /// \param enabled True to verify the remote host, false to accept any certificate
+    ///
+    /// \see addCertificateAuthorities
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVerification(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last handshake resumed a previous session
+    ///
+    /// \return True if the session was resumed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSessionResumed() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the early data was sent as 0-RTT data
+    ///
+    /// \return True if the server accepted the early data of the last handshake
+    ///
+    /// \see setEarlyData
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEarlyDataAccepted() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether decrypted data is waiting to be received
+    ///
+    /// TLS data arrives in records which are decrypted as a
+    /// whole: if a receive call asks for less than a record,
+    /// the rest stays in the socket, and a sf::SocketSelector
+    /// or sf::SocketPoller will not report it. Keep receiving
+    /// until the socket returns sf::Socket::NotReady, or check
+    /// this function.
+    ///
+    /// \return True if some data can be received without waiting for the network
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasPendingData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether SFML was built with TLS support
+    ///
+    /// If it wasn't, handshakes always fail.
+    ///
+    /// \return True if TLS is available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Trust additional certificate authorities
+    ///
+    /// By default, the certificate authorities of the system are
+    /// trusted. This function adds the certificates of a PEM
+    /// file, for example to connect to a server using a
+    /// self-signed certificate.
+    ///
+    /// \param filename Path of the PEM file containing the certificates
+    ///
+    /// \return True if the certificates were loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool addCertificateAuthorities(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the sessions kept for resumption
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearSessionCache();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encrypt and write bytes to the connection
+    ///
+    /// \param data    Pointer to the bytes to write
+    /// \param size    Number of bytes to write
+    /// \param written Variable to fill with the number of bytes written
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Status writeData(const char* data, std::size_t size, std::size_t& written);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encrypt and write two sequences of bytes to the connection
+    ///
+    /// \param first      Pointer to the first bytes to write
+    /// \param firstSize  Number of bytes in \a first
+    /// \param second     Pointer to the bytes to write after \a first
+    /// \param secondSize Number of bytes in \a second
+    /// \param written    Variable to fill with the number of bytes written
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Status writeData(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize, std::size_t& written);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read and decrypt bytes from the connection
+    ///
+    /// \param data     Pointer to the array to fill with the bytes read
+    /// \param size     Maximum number of bytes that can be read
+    /// \param received Variable to fill with the number of bytes read
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Status readData(char* data, std::size_t size, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the TLS session before the connection is closed
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisconnect();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::TlsImpl* m_impl; ///< Implementation of the TLS session
+};
+
+} // namespace sf
+
+
+#endif // SFML_TLSSOCKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TlsSocket
+/// \ingroup network
+///
+/// sf::TlsSocket is a sf::TcpSocket whose data is encrypted
+/// and authenticated with TLS, to talk to HTTPS servers
+/// and other secure services. Once the connection is
+/// secured, it is used exactly like a sf::TcpSocket, with
+/// raw bytes or packets.
+///
+/// The certificate of the server is checked against the
+/// certificate authorities of the system (and those added
+/// with addCertificateAuthorities), and against the host
+/// name given to connect or handshake.
+///
+/// The sessions established with each host are kept, so
+/// that the next connections to the same host can resume
+/// them with a shorter handshake. With TLS 1.3, a resumed
+/// handshake can also carry the first bytes of the
+/// application (see setEarlyData).
+///
+/// TLS support relies on OpenSSL, and is only available if
+/// SFML was built with SFML_NETWORK_TLS enabled (see
+/// isAvailable). Only the client side is supported.
+///
+/// Usage example:
+/// \code
+/// sf::TlsSocket socket;
+/// if (socket.connect("www.example.com", 443) == sf::Socket::Done)
+/// {
+///     std::string request = "GET / HTTP/1.1\r\nHost: www.example.com\r\nConnection: close\r\n\r\n";
+///     socket.send(request.c_str(), request.size());
+///
+///     char buffer[1024];
+///     std::size_t received = 0;
+///     while (socket.receive(buffer, sizeof(buffer), received) == sf::Socket::Done)
+///         std::cout.write(buffer, received);
+/// }
+/// \endcode
+///
+/// \see sf::TcpSocket, sf::Http
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,432 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UDPCONNECTION_HPP
+#define SFML_UDPCONNECTION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Message-oriented connection with optional reliability,
+///        built on top of a UDP socket
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API UdpConnection : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delivery guarantees of a message
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Channel
+    {
+        Unreliable,        ///< The message may be lost or arrive out of order, but is never delayed by other messages
+        ReliableUnordered, ///< The message is resent until it is received, and delivered as soon as it arrives
+        ReliableOrdered    ///< The message is resent until it is received, and delivered in the order it was sent
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxMessageSize = 65491 ///< The maximum number of bytes that can be sent in a single message
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the traffic of a connection
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Time   roundTripTime;     ///< Smoothed round-trip time to the remote peer
+        float  packetLoss;        ///< Smoothed ratio of datagrams that the remote peer didn't acknowledge, in range [0, 1]
+        Uint64 datagramsSent;     ///< Number of datagrams sent to the remote peer
+        Uint64 datagramsReceived; ///< Number of valid datagrams received from the remote peer
+        Uint64 bytesSent;         ///< Number of bytes sent to the remote peer, headers included
+        Uint64 bytesReceived;     ///< Number of bytes received from the remote peer, headers included
+        Uint64 messagesResent;    ///< Number of reliable messages that had to be sent again
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a connection to a remote peer
+    ///
+    /// The socket is used to send datagrams to the remote peer;
+    /// it must stay alive as long as the connection uses it.
+    /// It can be shared by several connections, for example
+    /// by a server talking to many clients through a single
+    /// bound socket.
+    ///
+    /// \param socket        Socket to send datagrams with
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    UdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the remote peer
+    ///
+    /// \return Address of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    const IpAddress& getRemoteAddress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of the remote peer
+    ///
+    /// \return Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getRemotePort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum size of the datagrams sent
+    ///
+    /// Messages are grouped into datagrams of at most this
+    /// size, to stay below the MTU of the network path and
+    /// avoid IP fragmentation. A message that doesn't fit
+    /// alone is sent in its own, bigger, datagram.
+    ///
+    /// The default size of 1200 bytes is safe on the internet.
+    ///
+    /// \param size Maximum size of a datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaximumDatagramSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a message for the remote peer
+    ///
+    /// The content of the packet is copied (after the packet's
+    /// onSend transformation), so it can be reused as soon as
+    /// this function returns. The message is actually sent by
+    /// the next call to update.
+    ///
+    /// A reliable channel accepts up to 32767 messages that
+    /// are not acknowledged yet by the remote peer; beyond
+    /// that, this function returns Socket::NotReady.
+    ///
+    /// \param packet  Packet containing the message to send
+    /// \param channel Delivery guarantees of the message
+    ///
+    /// \return Status code
+    ///
+    /// \see update, receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(Packet& packet, Channel channel = ReliableOrdered);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next message delivered by the remote peer
+    ///
+    /// This function doesn't read the socket: the messages are
+    /// extracted from the datagrams given to poll or
+    /// handleDatagram.
+    ///
+    /// \param packet Packet to fill with the message
+    ///
+    /// \return True if a message was extracted, false if there was none
+    ///
+    /// \see send, poll, handleDatagram
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receive(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the queued messages and acknowledgements
+    ///
+    /// This function sends the messages queued by send, resends
+    /// the reliable messages that were not acknowledged in time,
+    /// and acknowledges the datagrams received since the last
+    /// call. It must be called regularly, typically once per
+    /// frame or network tick.
+    ///
+    /// No more than 32 datagrams carrying messages are waiting
+    /// for their acknowledgement at any time, which is what a
+    /// single acknowledgement of the remote peer can cover.
+    /// Reliable messages that don't fit are sent by the next
+    /// calls, once the previous datagrams are acknowledged.
+    ///
+    /// If the socket can't send a datagram, reliable messages
+    /// will be sent again by a later call, and unreliable ones
+    /// are dropped.
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read all the datagrams waiting on the socket
+    ///
+    /// This function reads the socket without blocking, and
+    /// gives the datagrams sent by the remote peer to
+    /// handleDatagram. Datagrams from other peers are
+    /// discarded: if several connections share the socket,
+    /// read it yourself and give each datagram to the right
+    /// connection with handleDatagram instead.
+    ///
+    /// \return Status code
+    ///
+    /// \see handleDatagram, receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status poll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a datagram received from the remote peer
+    ///
+    /// The messages of the datagram are made available to
+    /// receive, in the order required by their channel, and
+    /// the acknowledgements that it carries are processed.
+    ///
+    /// A bare acknowledgement is sent right away when the
+    /// datagrams received since the last one would no longer
+    /// fit in a single acknowledgement, so that bursts sent
+    /// between two calls to update are not mistaken for losses.
+    ///
+    /// \param data Pointer to the content of the datagram
+    /// \param size Size of the datagram, in bytes
+    ///
+    /// \return True if the datagram was valid, false if it was rejected
+    ///
+    /// \see poll, receive
+    ///
+    ////////////////////////////////////////////////////////////
+    bool handleDatagram(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the connection
+    ///
+    /// \return Statistics about the traffic with the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reliable message waiting for its acknowledgement
+    ///
+    ////////////////////////////////////////////////////////////
+    struct OutgoingMessage
+    {
+        Uint8             channel;  ///< Channel of the message
+        Uint16            id;       ///< Identifier of the message in its channel
+        std::vector<char> data;     ///< Content of the message
+        Time              lastSent; ///< Time of the last transmission
+        bool              sent;     ///< Was the message transmitted at least once?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram waiting for its acknowledgement
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SentDatagram
+    {
+        Uint16              sequence; ///< Sequence number of the datagram
+        Time                time;     ///< Time when the datagram was sent
+        std::vector<Uint32> messages; ///< Keys of the reliable messages that it carries
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reception state of a reliable channel
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ReceiveChannel
+    {
+        Uint16                                nextId;  ///< Identifier of the first message not received yet
+        std::map<Uint16, std::vector<char> > pending; ///< Messages received after nextId (empty for the unordered channel)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a message to the datagram being built
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status appendMessage(Uint8 channel, Uint16 id, const std::vector<char>& data, Time now);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the datagram being built
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status flushDatagram(Time now);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the acknowledgements carried by a datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    void processAcks(Uint16 ack, Uint32 ackBits, Time now);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deliver a reliable message received in a channel
+    ///
+    ////////////////////////////////////////////////////////////
+    void deliverReliable(Uint8 channel, Uint16 id, const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the delay after which unacknowledged messages are resent
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getResendTimeout() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UdpSocket&                        m_socket;              ///< Socket used to send the datagrams
+    IpAddress                         m_remoteAddress;       ///< Address of the remote peer
+    unsigned short                    m_remotePort;          ///< Port of the remote peer
+    std::size_t                       m_maxDatagramSize;     ///< Size above which messages are split into several datagrams
+    Clock                             m_clock;               ///< Clock giving the time of transmissions
+    Statistics                        m_statistics;          ///< Statistics of the connection
+    Time                              m_roundTripVariation;  ///< Smoothed variation of the round-trip time
+    bool                              m_hasRoundTripTime;    ///< Was the round-trip time measured already?
+    Uint16                            m_localSequence;       ///< Sequence number of the next datagram to send
+    Uint16                            m_remoteSequence;      ///< Most recent sequence number received
+    Uint32                            m_receivedBits;        ///< Reception of the 32 datagrams before m_remoteSequence
+    bool                              m_hasReceived;         ///< Was any datagram received yet?
+    bool                              m_ackPending;          ///< Must the received datagrams be acknowledged?
+    Uint16                            m_ackedSequence;       ///< Value of m_remoteSequence in the last acknowledgement sent
+    Uint16                            m_nextId[2];           ///< Identifier of the next message of each reliable channel
+    std::size_t                       m_unackedCount[2];     ///< Number of unacknowledged messages of each reliable channel
+    std::map<Uint32, OutgoingMessage> m_outgoing;            ///< Reliable messages waiting for their acknowledgement
+    std::deque<std::vector<char> >    m_unreliable;          ///< Unreliable messages waiting to be sent
+    std::deque<SentDatagram>          m_sentDatagrams;       ///< Datagrams waiting for their acknowledgement
+    ReceiveChannel                    m_receiveChannels[2];  ///< Reception state of each reliable channel
+    std::deque<std::vector<char> >    m_received;            ///< Messages ready to be extracted by receive
+    std::vector<char>                 m_datagram;            ///< Datagram being built
+    std::vector<Uint32>               m_datagramMessages;    ///< Keys of the reliable messages of the datagram being built
+    std::vector<char>                 m_receiveBuffer;       ///< Buffer used by poll to read the socket
+};
+
+} // namespace sf
+
+
+#endif // SFML_UDPCONNECTION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UdpConnection
+/// \ingroup network
+///
+/// sf::TcpSocket delivers everything reliably and in order,
+/// but a single lost segment holds back all the data behind
+/// it until it is retransmitted, which shows up as latency
+/// spikes in real-time applications. sf::UdpSocket has no
+/// such stalls, but gives no guarantee at all.
+///
+/// sf::UdpConnection sits in between: it exchanges messages
+/// (stored in sf::Packet) with a single remote peer over
+/// UDP, and lets each message choose its guarantees:
+/// \li UdpConnection::Unreliable messages are sent once, and
+///     are fine for data that is quickly outdated, such as
+///     positions;
+/// \li UdpConnection::ReliableUnordered messages are resent
+///     until they are acknowledged, and are delivered as soon
+///     as they arrive;
+/// \li UdpConnection::ReliableOrdered messages are resent too,
+///     but are held back until all the messages sent before
+///     them on the same channel are delivered.
+///
+/// Each datagram carries a sequence number, and acknowledges
+/// the last 33 datagrams received from the peer; only the
+/// reliable messages whose datagrams were lost are resent.
+/// These acknowledgements also give the round-trip time and
+/// the packet loss of the connection (see getStatistics).
+///
+/// Small messages are grouped in datagrams, up to
+/// the size given to setMaximumDatagramSize. Both
+/// sides must use sf::UdpConnection, the datagrams are not
+/// compatible with plain sf::UdpSocket packets.
+///
+/// The connection doesn't read nor block on the socket by
+/// itself: call poll (or handleDatagram) to process the
+/// incoming datagrams, and update to send the outgoing ones,
+/// typically once per frame. There is no handshake nor
+/// timeout: the application decides when the peer is gone.
+///
+/// Usage example:
+/// \code
+/// sf::UdpSocket socket;
+/// socket.bind(sf::Socket::AnyPort);
+///
+/// sf::UdpConnection connection(socket, "192.168.1.50", 55002);
+///
+/// while (running)
+/// {
+///     // Handle the messages of the server
+///     connection.poll();
+///     sf::Packet packet;
+///     while (connection.receive(packet))
+///         handleMessage(packet);
+///
+///     // Send our position (unreliable) and our actions (reliable)
+///     sf::Packet position;
+///     position << x << y;
+///     connection.send(position, sf::UdpConnection::Unreliable);
+///
+///     if (fired)
+///     {
+///         sf::Packet action;
+///         action << "fire";
+///         connection.send(action, sf::UdpConnection::ReliableOrdered);
+///     }
+///
+///     connection.update();
+///
+///     std::cout << "ping: " << connection.getStatistics().roundTripTime.asMilliseconds() << " ms" << std::endl;
+/// }
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
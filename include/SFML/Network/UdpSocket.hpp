@@ -31,13 +31,12 @@
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
 #include <vector>
 
 
 namespace sf
 {
-class Packet;
-
 ////////////////////////////////////////////////////////////
 /// \brief Specialized socket using the UDP protocol
 ///
@@ -54,6 +53,25 @@ public:
         MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram exchanged by the batched functions
+    ///
+    /// \see sendBatch, receiveBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Datagram
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Datagram();
+
+        Packet         packet;        ///< Data of the datagram
+        IpAddress      remoteAddress; ///< Address of the receiver (send) or of the sender (receive)
+        unsigned short remotePort;    ///< Port of the receiver (send) or of the sender (receive)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -87,6 +105,12 @@ public:
     /// function is called, it will be unbound from the previous
     /// port before being bound to the new one.
     ///
+    /// The family of \a address decides the one of the socket:
+    /// binding to IpAddress::AnyV6 allows to exchange datagrams
+    /// with both IPv6 and IPv4 peers, whereas IpAddress::Any
+    /// only allows IPv4. Note that broadcasting is only
+    /// possible with an IPv4 socket.
+    ///
     /// \param port    Port to bind the socket to
     /// \param address Address of the interface to bind to
     ///
@@ -118,6 +142,10 @@ public:
     /// UdpSocket::MaxDatagramSize, otherwise this function will
     /// fail and no data will be sent.
     ///
+    /// If the socket is not bound yet, it is created with the
+    /// family of \a remoteAddress. An IPv4 socket can't send
+    /// data to an IPv6 address.
+    ///
     /// \param data          Pointer to the sequence of bytes to send
     /// \param size          Number of bytes to send
     /// \param remoteAddress Address of the receiver
@@ -188,12 +216,145 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams at once
+    ///
+    /// Each datagram is sent to its own destination. Where the
+    /// system supports it (sendmmsg on Linux), many datagrams
+    /// are handed to the kernel with a single system call,
+    /// otherwise they are sent one after the other.
+    ///
+    /// Like send(Packet&, const IpAddress&, unsigned short), no
+    /// datagram may be bigger than UdpSocket::MaxDatagramSize;
+    /// if one is, nothing is sent and an error is returned.
+    ///
+    /// If this function returns sf::Socket::Partial, \a sent
+    /// tells how many datagrams (from the beginning of the
+    /// array) were actually sent.
+    ///
+    /// \param datagrams Array of datagrams to send
+    /// \param count     Number of datagrams in the array
+    /// \param sent      This variable is filled with the number of datagrams sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receiveBatch, setSegmentationOffloadEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendBatch(Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several datagrams at once
+    ///
+    /// In blocking mode, this function waits until at least one
+    /// datagram is available; it then fills as many entries of
+    /// the array as there are datagrams already waiting, without
+    /// blocking any further. Where the system supports it
+    /// (recvmmsg on Linux), they are retrieved with a single
+    /// system call.
+    ///
+    /// \param datagrams Array of datagrams to fill
+    /// \param count     Maximum number of datagrams to receive
+    /// \param received  This variable is filled with the number of datagrams received
+    ///
+    /// \return Status code (sf::Socket::Done if at least one datagram was received)
+    ///
+    /// \see sendBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveBatch(Datagram* datagrams, std::size_t count, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable UDP segmentation offload in sendBatch
+    ///
+    /// When enabled on systems that support it (Linux 4.18 and
+    /// later), consecutive datagrams of sendBatch which have the
+    /// same destination and the same size are passed to the
+    /// kernel as a single large buffer, which is split into
+    /// datagrams by the network stack or the network card.
+    /// The receivers still get regular datagrams.
+    /// If the system rejects it, segmentation offload is
+    /// automatically disabled again.
+    /// On other systems this setting has no effect.
+    ///
+    /// Segmentation offload is disabled by default.
+    ///
+    /// \param enabled True to enable segmentation offload, false to disable it
+    ///
+    /// \see isSegmentationOffloadEnabled, sendBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSegmentationOffloadEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether UDP segmentation offload is enabled
+    ///
+    /// \return True if segmentation offload is enabled
+    ///
+    /// \see setSegmentationOffloadEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSegmentationOffloadEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Subscribe to the datagrams sent to a multicast group
+    ///
+    /// Once the socket joins the group, it receives the
+    /// datagrams sent to \a group on its local port, in addition
+    /// to those sent to its own address. A single send to the
+    /// group reaches every socket that joined it, whatever
+    /// their number. The socket should be bound before joining,
+    /// usually to IpAddress::Any or IpAddress::AnyV6.
+    ///
+    /// IPv4 groups range from 224.0.0.0 to 239.255.255.255,
+    /// IPv6 groups start with ff. On some systems, IPv4 groups
+    /// can only be joined by sockets bound to an IPv4 address.
+    ///
+    /// \param group          Address of the multicast group
+    /// \param interfaceIndex Index of the network interface to join the group on, 0 to let the system choose
+    ///
+    /// \return Status code
+    ///
+    /// \see leaveMulticastGroup
+    ///
+    ////////////////////////////////////////////////////////////
+    Status joinMulticastGroup(const IpAddress& group, unsigned int interfaceIndex = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unsubscribe from the datagrams sent to a multicast group
+    ///
+    /// Closing the socket leaves all the groups it joined.
+    ///
+    /// \param group          Address of the multicast group
+    /// \param interfaceIndex Index of the network interface the group was joined on
+    ///
+    /// \return Status code
+    ///
+    /// \see joinMulticastGroup
+    ///
+    ////////////////////////////////////////////////////////////
+    Status leaveMulticastGroup(const IpAddress& group, unsigned int interfaceIndex = 0);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Join or leave a multicast group
+    ///
+    /// \param group          Address of the multicast group
+    /// \param interfaceIndex Index of the network interface, 0 to let the system choose
+    /// \param join           True to join the group, false to leave it
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status setMulticastMembership(const IpAddress& group, unsigned int interfaceIndex, bool join);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_buffer; ///< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_buffer;              ///< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_batchBuffer;         ///< Temporary buffer holding the received data in receiveBatch
+    bool              m_segmentationOffload; ///< Use UDP segmentation offload in sendBatch?
 };
 
 } // namespace sf
@@ -286,6 +447,24 @@ private:
 /// socket.send(message.c_str(), message.size() + 1, sender, port);
 /// \endcode
 ///
+/// To send the same data to many receivers, such as LAN game
+/// discovery or spectators of a match, the receivers can join
+/// a multicast group: one datagram sent to the group reaches
+/// all of them.
+/// \code
+/// // ----- The receivers -----
+///
+/// sf::UdpSocket socket;
+/// socket.bind(54000);
+/// socket.joinMulticastGroup("239.255.0.1");
+///
+/// // ----- The sender -----
+///
+/// sf::UdpSocket socket;
+/// socket.setOption(sf::Socket::MulticastTtl, 1); // stay on the local network
+/// socket.send(packet, "239.255.0.1", 54000);
+/// \endcode
+///
 /// \see sf::Socket, sf::TcpSocket, sf::Packet
 ///
 ////////////////////////////////////////////////////////////
@@ -30,21 +30,42 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/Config.hpp>
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/ArchiveInputStream.hpp>
+#include <SFML/System/ArchiveWriter.hpp>
+#include <SFML/System/Arena.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/BufferedInputStream.hpp>
 #include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/ExclusiveLock.hpp>
+#include <SFML/System/FastClock.hpp>
+#include <SFML/System/FastLock.hpp>
+#include <SFML/System/FastMutex.hpp>
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Log.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/MpmcQueue.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/SharedLock.hpp>
+#include <SFML/System/SharedMutex.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/SpscQueue.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/ThreadLocal.hpp>
 #include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/ThreadPool.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Utf.hpp>
+#include <SFML/System/Utf8String.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Vector3.hpp>
 
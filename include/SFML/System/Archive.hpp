@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ARCHIVE_HPP
+#define SFML_ARCHIVE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class FileMappingImpl;
+}
+
+class ArchiveInputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Read-only pack of files, mapped in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Archive : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Archive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The archive is unmounted if it was mounted.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Archive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an archive file
+    ///
+    /// The archive is mapped in memory and only its index is
+    /// read: opening it costs a single file access, whatever
+    /// the number of files it contains.
+    ///
+    /// \param filename Path of the archive, created by sf::ArchiveWriter
+    ///
+    /// \return True if the archive was opened successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the archive
+    ///
+    /// The archive is unmounted if it was mounted.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the archive contains a file
+    ///
+    /// \param path Path of the file inside the archive
+    ///
+    /// \return True if the file exists in the archive
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(const std::string& path) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of files in the archive
+    ///
+    /// \return Number of files
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getFileCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the files of the archive visible to SFML's loaders
+    ///
+    /// Once mounted, the files of the archive are used instead
+    /// of the files of the disk by sf::FileInputStream,
+    /// sf::MappedFileInputStream and all the loadFromFile
+    /// functions of SFML, for the paths that start with the mount
+    /// point. The archives mounted last are searched first, so
+    /// that a patch archive can override the files of a previous
+    /// one. The archive must stay open while it is mounted.
+    ///
+    /// \param mountPoint Directory the paths of the archive are relative to, empty for the working directory
+    ///
+    /// \see unmount
+    ///
+    ////////////////////////////////////////////////////////////
+    void mount(const std::string& mountPoint = "");
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Hide the files of the archive from SFML's loaders
+    ///
+    /// \see mount
+    ///
+    ////////////////////////////////////////////////////////////
+    void unmount();
+
+private:
+
+    friend class ArchiveInputStream;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the index of an archive
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint64      hash;        ///< Hash of the path
+        Uint64      offset;      ///< Position of the contents in the archive
+        Uint64      storedSize;  ///< Size of the contents in the archive
+        Uint64      size;        ///< Size of the file
+        Uint32      compression; ///< Compression of the contents
+        std::string path;        ///< Normalized path of the file
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a file in the index
+    ///
+    /// \param path Normalized path of the file
+    ///
+    /// \return Entry of the file, NULL if the archive doesn't contain it
+    ///
+    ////////////////////////////////////////////////////////////
+    const Entry* find(const std::string& path) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::FileMappingImpl* m_mapping; ///< Mapping of the archive file, NULL if not open
+    const char*            m_data;    ///< Contents of the archive file
+    std::vector<Entry>     m_entries; ///< Index of the archive, sorted by hash
+    bool                   m_mounted; ///< Is the archive mounted?
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Archive
+/// \ingroup system
+///
+/// sf::Archive gives access to the files of a pack created by
+/// sf::ArchiveWriter. Packing the assets of an application in a
+/// few archives replaces thousands of file openings by a single
+/// mapping of each archive, and a lookup in a hashed index that
+/// is read once.
+///
+/// Files are read with sf::ArchiveInputStream, or, once the
+/// archive is mounted, through all the loadFromFile functions
+/// of SFML, which then find them in the archive before looking
+/// on the disk:
+/// \code
+/// sf::Archive archive;
+/// if (!archive.openFromFile("assets.pak"))
+///     return -1;
+///
+/// archive.mount();
+///
+/// sf::Texture texture;
+/// texture.loadFromFile("images/player.png"); // read from assets.pak
+/// \endcode
+///
+/// The files are stored as they are, and read directly from the
+/// mapped archive, or compressed with LZ4 and decompressed when
+/// opened. Paths are case-sensitive, and use '/' or '\\' as
+/// separator.
+///
+/// \see sf::ArchiveWriter, sf::ArchiveInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ARCHIVEINPUTSTREAM_HPP
+#define SFML_ARCHIVEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Archive;
+
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on a file of an archive
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ArchiveInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ArchiveInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~ArchiveInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a file of the mounted archives
+    ///
+    /// \param filename Path of the file, including the mount point of its archive
+    ///
+    /// \return True if a mounted archive contains the file
+    ///
+    /// \see Archive::mount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a file of an archive
+    ///
+    /// The archive must stay open while the stream is used.
+    ///
+    /// \param archive Archive containing the file
+    /// \param path    Path of the file inside the archive
+    ///
+    /// \return True if the archive contains the file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const Archive& archive, const std::string& path);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the contents of the file
+    ///
+    /// Stored files are read directly from the mapped archive,
+    /// compressed ones from a buffer owned by the stream. The
+    /// pointer stays valid until the stream is reopened or
+    /// destroyed.
+    ///
+    /// \return Pointer to the contents, NULL if no file is open
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a file of an archive given its normalized path
+    ///
+    /// \param archive Archive containing the file
+    /// \param path    Normalized path of the file inside the archive
+    ///
+    /// \return True if the archive contains the file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openEntry(const Archive& archive, const std::string& path);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const char*       m_data;   ///< Contents of the file, NULL if not open
+    Int64             m_size;   ///< Size of the file
+    Int64             m_offset; ///< Current reading position
+    std::vector<char> m_buffer; ///< Decompressed contents of compressed files
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ArchiveInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that reads
+/// a file of a sf::Archive. There's usually no need to use it
+/// directly: once an archive is mounted, sf::FileInputStream
+/// and the loadFromFile functions of SFML find its files.
+///
+/// Usage example:
+/// \code
+/// sf::Archive archive;
+/// archive.openFromFile("levels.pak");
+///
+/// sf::ArchiveInputStream stream;
+/// if (stream.open(archive, "level1.json"))
+///     parseLevel(static_cast<const char*>(stream.getData()), stream.getSize());
+/// \endcode
+///
+/// \see sf::Archive, sf::InputStream
+///
+////////////////////////////////////////////////////////////
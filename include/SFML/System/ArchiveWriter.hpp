@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ARCHIVEWRITER_HPP
+#define SFML_ARCHIVEWRITER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Creator of archives readable by sf::Archive
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ArchiveWriter : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ArchiveWriter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// An archive still open is finished, as if close() was called.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ArchiveWriter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start writing an archive
+    ///
+    /// \param filename Path of the archive to create
+    ///
+    /// \return True if the file was created successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a file to the archive
+    ///
+    /// When \a compress is true, the file is compressed with LZ4,
+    /// unless compression doesn't make it smaller (which is the
+    /// case of files already compressed, like PNG images or Ogg
+    /// musics).
+    ///
+    /// \param path     Path of the file inside the archive
+    /// \param data     Contents of the file
+    /// \param size     Size of the contents, in bytes
+    /// \param compress Try to compress the file?
+    ///
+    /// \return True if the file was added, false if the path is already used or on write error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(const std::string& path, const void* data, std::size_t size, bool compress = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a file of the disk to the archive
+    ///
+    /// \param path     Path of the file inside the archive
+    /// \param filename Path of the file to read
+    /// \param compress Try to compress the file?
+    ///
+    /// \return True if the file was added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFile(const std::string& path, const std::string& filename, bool compress = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the archive by writing its index
+    ///
+    /// \return True if the archive was written successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool close();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the index being written
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint64      hash;        ///< Hash of the path
+        Uint64      offset;      ///< Position of the contents in the archive
+        Uint64      storedSize;  ///< Size of the contents in the archive
+        Uint64      size;        ///< Size of the file
+        Uint32      compression; ///< Compression of the contents
+        std::string path;        ///< Normalized path of the file
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::ofstream      m_file;     ///< Archive being written
+    std::string        m_filename; ///< Path of the archive, for error messages
+    Uint64             m_offset;   ///< Current size of the archive
+    std::vector<Entry> m_entries;  ///< Index of the files added so far
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVEWRITER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ArchiveWriter
+/// \ingroup system
+///
+/// sf::ArchiveWriter packs files in an archive that sf::Archive
+/// can read; it is typically used by a build step or a tool
+/// that prepares the assets of an application for shipping.
+///
+/// An archive starts with a header, followed by the contents of
+/// the files, followed by an index of the files sorted by the
+/// hash of their path. All the values are little endian.
+///
+/// Usage example:
+/// \code
+/// sf::ArchiveWriter writer;
+/// if (!writer.open("assets.pak"))
+///     return -1;
+///
+/// writer.addFile("images/player.png", "assets/images/player.png");
+/// writer.addFile("shaders/blur.frag", "assets/shaders/blur.frag");
+/// writer.close();
+/// \endcode
+///
+/// \see sf::Archive
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,355 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ARENA_HPP
+#define SFML_ARENA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Fast allocator for short-lived memory, released all at once
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Arena : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the allocations made in a scope when it ends
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Scope : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Start a scope
+        ///
+        /// \param arena Arena whose allocations are released at the end of the scope
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Scope(Arena& arena);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief End the scope
+        ///
+        /// All the memory allocated from the arena since the
+        /// scope was started is released.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Scope();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Arena&      m_arena;  ///< Arena used in the scope
+        std::size_t m_block;  ///< Block of the arena when the scope started
+        std::size_t m_offset; ///< Position in the block when the scope started
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// No memory is allocated until the first allocation.
+    ///
+    /// \param blockSize Size of the blocks taken from the heap, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Arena(std::size_t blockSize = 65536);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Arena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate memory
+    ///
+    /// The memory stays valid until the arena is reset, or until
+    /// the end of the innermost scope that was active when it was
+    /// allocated. It can't be freed individually.
+    ///
+    /// \param size      Number of bytes to allocate
+    /// \param alignment Alignment of the memory, must be a power of two
+    ///
+    /// \return Pointer to the allocated memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void* allocate(std::size_t size, std::size_t alignment = 16);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release all the memory allocated from the arena
+    ///
+    /// The heap blocks are kept for the next allocations. If the
+    /// arena had to grow, its blocks are merged in a single one
+    /// large enough for the same amount of memory, so that the
+    /// next frame doing the same work doesn't touch the heap.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of memory currently allocated
+    ///
+    /// \return Number of bytes allocated, including alignment padding
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUsedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of blocks allocated from the heap
+    ///
+    /// In the steady state of an application, the count stops
+    /// increasing: this is the way to check that code using the
+    /// arena doesn't allocate anymore.
+    ///
+    /// \return Number of heap allocations made by the arena since its creation
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getHeapAllocationCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena of the calling thread
+    ///
+    /// This arena is used by SFML for the temporary memory of its
+    /// hot paths, in scopes that release everything they allocate:
+    /// it can be used the same way by applications, or reset at
+    /// the end of each frame.
+    ///
+    /// \return Arena of the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static Arena& getThreadArena();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the memory allocated after a position
+    ///
+    /// \param block  Block of the position
+    /// \param offset Offset of the position in the block
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(std::size_t block, std::size_t offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block of memory taken from the heap
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        char*       data; ///< Memory of the block
+        std::size_t size; ///< Size of the block, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Block> m_blocks;          ///< Heap blocks, in the order they are used
+    std::size_t        m_block;           ///< Index of the block allocations are taken from
+    std::size_t        m_offset;          ///< Position of the next allocation in the current block
+    std::size_t        m_blockSize;       ///< Minimum size of new blocks
+    Uint64             m_heapAllocations; ///< Number of blocks allocated from the heap so far
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Standard allocator taking its memory from an arena
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class ArenaAllocator
+{
+public:
+
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The allocator uses the arena of the calling thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    ArenaAllocator();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the allocator from an arena
+    ///
+    /// \param arena Arena to allocate from
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ArenaAllocator(Arena& arena);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the allocator from an allocator of another type
+    ///
+    /// \param copy Allocator to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate memory for elements
+    ///
+    /// \param count Number of elements
+    ///
+    /// \return Pointer to uninitialized memory for \a count elements
+    ///
+    ////////////////////////////////////////////////////////////
+    pointer allocate(size_type count, const void* = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release memory
+    ///
+    /// Does nothing: the memory is released with the arena.
+    ///
+    ////////////////////////////////////////////////////////////
+    void deallocate(pointer, size_type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overloads required by standard containers
+    ///
+    ////////////////////////////////////////////////////////////
+    pointer address(reference value) const;
+    const_pointer address(const_reference value) const;
+    size_type max_size() const;
+    void construct(pointer element, const T& value);
+    void destroy(pointer element);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena the allocator takes its memory from
+    ///
+    /// \return Arena of the allocator
+    ///
+    ////////////////////////////////////////////////////////////
+    Arena& getArena() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Arena* m_arena; ///< Arena to allocate from
+};
+
+////////////////////////////////////////////////////////////
+/// \relates ArenaAllocator
+/// \brief Overload of binary operator == (same arena)
+///
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator ==(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right);
+
+////////////////////////////////////////////////////////////
+/// \relates ArenaAllocator
+/// \brief Overload of binary operator != (different arenas)
+///
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator !=(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right);
+
+} // namespace sf
+
+#include <SFML/System/Arena.inl>
+
+
+#endif // SFML_ARENA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Arena
+/// \ingroup system
+///
+/// sf::Arena hands out memory by advancing a position in large
+/// blocks taken from the heap, and releases it all at once. It
+/// is meant for temporary data whose lifetime is a function
+/// call or a frame, which would otherwise cost a malloc and a
+/// free every time.
+///
+/// sf::Arena::Scope releases what was allocated while it was
+/// alive, and sf::ArenaAllocator lets standard containers use
+/// an arena:
+/// \code
+/// void update()
+/// {
+///     sf::Arena& arena = sf::Arena::getThreadArena();
+///     sf::Arena::Scope scope(arena);
+///
+///     std::vector<int, sf::ArenaAllocator<int> > visible((sf::ArenaAllocator<int>(arena)));
+///     collectVisibleEntities(visible);
+///     ...
+/// } // the memory of visible is released here
+/// \endcode
+///
+/// Since the blocks are kept and merged when the arena is
+/// released, code doing the same work every frame stops
+/// allocating from the heap after the first frames, which
+/// getHeapAllocationCount() allows to check.
+///
+/// An arena must only be used by one thread at a time.
+///
+/// \see sf::ArenaAllocator
+///
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ArenaAllocator
+/// \ingroup system
+///
+/// sf::ArenaAllocator is an allocator for the standard
+/// containers that takes its memory from a sf::Arena. Freeing
+/// does nothing, the memory is released with the arena or its
+/// scope: containers using it must not outlive them.
+///
+/// \see sf::Arena
+///
+////////////////////////////////////////////////////////////
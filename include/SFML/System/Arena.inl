@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include <limits>
+#include <new>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator() :
+m_arena(&Arena::getThreadArena())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(Arena& arena) :
+m_arena(&arena)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& copy) :
+m_arena(&copy.getArena())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename ArenaAllocator<T>::pointer ArenaAllocator<T>::allocate(size_type count, const void*)
+{
+    if (count > max_size())
+        throw std::bad_alloc();
+
+    // Alignment of T, computed the C++03 way
+    struct Aligned {char c; T value;};
+    return static_cast<pointer>(m_arena->allocate(count * sizeof(T), sizeof(Aligned) - sizeof(T)));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void ArenaAllocator<T>::deallocate(pointer, size_type)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename ArenaAllocator<T>::pointer ArenaAllocator<T>::address(reference value) const
+{
+    return &value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename ArenaAllocator<T>::const_pointer ArenaAllocator<T>::address(const_reference value) const
+{
+    return &value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename ArenaAllocator<T>::size_type ArenaAllocator<T>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void ArenaAllocator<T>::construct(pointer element, const T& value)
+{
+    new (element) T(value);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void ArenaAllocator<T>::destroy(pointer element)
+{
+    element->~T();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Arena& ArenaAllocator<T>::getArena() const
+{
+    return *m_arena;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator ==(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right)
+{
+    return &left.getArena() == &right.getArena();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator !=(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right)
+{
+    return !(left == right);
+}
+
+} // namespace sf
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ATOMIC_HPP
+#define SFML_ATOMIC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace Memory
+{
+    ////////////////////////////////////////////////////////////
+    /// \ingroup system
+    /// \brief Ordering constraints of an atomic operation
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Order
+    {
+        Relaxed,               ///< Only the operation itself is atomic, nothing is ordered around it
+        Acquire,               ///< Reads and writes after a load can't move before it
+        Release,               ///< Reads and writes before a store can't move after it
+        AcquireRelease,        ///< Both Acquire and Release, for read-modify-write operations
+        SequentiallyConsistent ///< Acquire and Release, plus a single total order of all such operations
+    };
+}
+
+namespace priv
+{
+// Integer type of the same size as the value of an atomic variable
+template <std::size_t Size> struct AtomicStorage;
+template <> struct AtomicStorage<1> {typedef Int8  Type;};
+template <> struct AtomicStorage<2> {typedef Int16 Type;};
+template <> struct AtomicStorage<4> {typedef Int32 Type;};
+template <> struct AtomicStorage<8> {typedef Int64 Type;};
+
+} // namespace priv
+
+////////////////////////////////////////////////////////////
+/// \brief Variable that can be read and written by several
+///        threads without a mutex
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class Atomic : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The construction itself is not atomic: the variable must
+    /// not be accessed by other threads before it is complete.
+    ///
+    /// \param value Initial value of the variable
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Atomic(T value = T());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the value of the variable
+    ///
+    /// \param order Ordering constraint; Release and
+    ///              AcquireRelease are not valid for a load
+    ///
+    /// \return Current value
+    ///
+    ////////////////////////////////////////////////////////////
+    T load(Memory::Order order = Memory::SequentiallyConsistent) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value of the variable
+    ///
+    /// \param value New value
+    /// \param order Ordering constraint; Acquire and
+    ///              AcquireRelease are not valid for a store
+    ///
+    ////////////////////////////////////////////////////////////
+    void store(T value, Memory::Order order = Memory::SequentiallyConsistent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value of the variable and return the previous one
+    ///
+    /// \param value New value
+    /// \param order Ordering constraint
+    ///
+    /// \return Value before the exchange
+    ///
+    ////////////////////////////////////////////////////////////
+    T exchange(T value, Memory::Order order = Memory::SequentiallyConsistent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value of the variable if it has the expected value
+    ///
+    /// When the comparison fails, \a expected receives the
+    /// current value, so that a retry loop doesn't need to
+    /// load it again.
+    ///
+    /// \param expected Value the variable must have; receives the current value on failure
+    /// \param desired  Value to write if the comparison succeeds
+    /// \param order    Ordering constraint of a successful exchange
+    ///
+    /// \return True if the value was changed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool compareExchange(T& expected, T desired, Memory::Order order = Memory::SequentiallyConsistent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add to the value of the variable
+    ///
+    /// Only valid for integer types.
+    ///
+    /// \param value Value to add
+    /// \param order Ordering constraint
+    ///
+    /// \return Value before the addition
+    ///
+    ////////////////////////////////////////////////////////////
+    T fetchAdd(T value, Memory::Order order = Memory::SequentiallyConsistent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Subtract from the value of the variable
+    ///
+    /// Only valid for integer types.
+    ///
+    /// \param value Value to subtract
+    /// \param order Ordering constraint
+    ///
+    /// \return Value before the subtraction
+    ///
+    ////////////////////////////////////////////////////////////
+    T fetchSub(T value, Memory::Order order = Memory::SequentiallyConsistent);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef typename priv::AtomicStorage<sizeof(T)>::Type Storage;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    volatile Storage m_value; ///< Value of the variable, stored as an integer of the same size
+};
+
+} // namespace sf
+
+#include <SFML/System/Atomic.inl>
+
+
+#endif // SFML_ATOMIC_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Atomic
+/// \ingroup system
+///
+/// sf::Atomic wraps an integer, enum, bool or pointer variable
+/// so that several threads can read and modify it at the same
+/// time without a mutex. Each operation is a single indivisible
+/// step; a compareExchange loop builds any other update out of
+/// them.
+///
+/// Every operation takes an optional memory order, which tells
+/// what other reads and writes the operation orders. The
+/// default, sf::Memory::SequentiallyConsistent, is always
+/// correct. A lighter order is enough for the classic patterns:
+/// a store with sf::Memory::Release publishes everything the
+/// thread wrote before it to the thread that reads the stored
+/// value with a load using sf::Memory::Acquire, and a plain
+/// counter only needs sf::Memory::Relaxed.
+///
+/// The type must be 1, 2, 4 or 8 bytes large. The operations
+/// map to the compiler intrinsics of GCC, Clang and Visual C++,
+/// which don't take any lock on the platforms SFML supports.
+///
+/// Usage example:
+/// \code
+/// sf::Atomic<int> counter(0);
+/// sf::Atomic<bool> ready(false);
+/// Data data;
+///
+/// void producer()
+/// {
+///     data = computeData();
+///     ready.store(true, sf::Memory::Release); // publishes data
+/// }
+///
+/// void consumer()
+/// {
+///     if (ready.load(sf::Memory::Acquire))
+///         use(data); // sees everything written before the store
+///
+///     counter.fetchAdd(1, sf::Memory::Relaxed);
+/// }
+/// \endcode
+///
+/// \see sf::SpscQueue, sf::MpmcQueue, sf::Mutex
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+#if defined(__GNUC__)
+
+// GCC and Clang provide generic atomic builtins for all the integer sizes
+
+////////////////////////////////////////////////////////////
+inline int toNativeOrder(Memory::Order order)
+{
+    switch (order)
+    {
+        case Memory::Relaxed:        return __ATOMIC_RELAXED;
+        case Memory::Acquire:        return __ATOMIC_ACQUIRE;
+        case Memory::Release:        return __ATOMIC_RELEASE;
+        case Memory::AcquireRelease: return __ATOMIC_ACQ_REL;
+        default:                     return __ATOMIC_SEQ_CST;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+inline int toNativeFailureOrder(Memory::Order order)
+{
+    // A failed compare-exchange is a load, it can't have release semantics
+    switch (order)
+    {
+        case Memory::Relaxed:
+        case Memory::Release:        return __ATOMIC_RELAXED;
+        case Memory::Acquire:
+        case Memory::AcquireRelease: return __ATOMIC_ACQUIRE;
+        default:                     return __ATOMIC_SEQ_CST;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline S atomicLoad(const volatile S* value, Memory::Order order)
+{
+    return __atomic_load_n(value, toNativeOrder(order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline void atomicStore(volatile S* value, S newValue, Memory::Order order)
+{
+    __atomic_store_n(value, newValue, toNativeOrder(order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline S atomicExchange(volatile S* value, S newValue, Memory::Order order)
+{
+    return __atomic_exchange_n(value, newValue, toNativeOrder(order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline bool atomicCompareExchange(volatile S* value, S& expected, S desired, Memory::Order order)
+{
+    return __atomic_compare_exchange_n(value, &expected, desired, false, toNativeOrder(order), toNativeFailureOrder(order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline S atomicFetchAdd(volatile S* value, S operand, Memory::Order order)
+{
+    return __atomic_fetch_add(value, operand, toNativeOrder(order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline S atomicFetchSub(volatile S* value, S operand, Memory::Order order)
+{
+    return __atomic_fetch_sub(value, operand, toNativeOrder(order));
+}
+
+#elif defined(_MSC_VER)
+
+// Visual C++ only has the Interlocked intrinsics, which are full
+// barriers; each size needs its own overloads. Except on x86, where
+// aligned loads and stores are atomic with acquire and release
+// semantics, everything goes through them.
+
+#if defined(_M_IX86) || defined(_M_X64)
+    #define SFML_ATOMIC_ORDERED_MOVES
+#endif
+
+////////////////////////////////////////////////////////////
+inline Int8 atomicExchange(volatile Int8* value, Int8 newValue, Memory::Order)
+{
+    return _InterlockedExchange8(reinterpret_cast<volatile char*>(value), newValue);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int16 atomicExchange(volatile Int16* value, Int16 newValue, Memory::Order)
+{
+    return _InterlockedExchange16(value, newValue);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int32 atomicExchange(volatile Int32* value, Int32 newValue, Memory::Order)
+{
+    return _InterlockedExchange(reinterpret_cast<volatile long*>(value), newValue);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int8 atomicCompareExchangeValue(volatile Int8* value, Int8 desired, Int8 expected)
+{
+    return _InterlockedCompareExchange8(reinterpret_cast<volatile char*>(value), desired, expected);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int16 atomicCompareExchangeValue(volatile Int16* value, Int16 desired, Int16 expected)
+{
+    return _InterlockedCompareExchange16(value, desired, expected);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int32 atomicCompareExchangeValue(volatile Int32* value, Int32 desired, Int32 expected)
+{
+    return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(value), desired, expected);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int64 atomicCompareExchangeValue(volatile Int64* value, Int64 desired, Int64 expected)
+{
+    return _InterlockedCompareExchange64(value, desired, expected);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int8 atomicFetchAdd(volatile Int8* value, Int8 operand, Memory::Order)
+{
+    return _InterlockedExchangeAdd8(reinterpret_cast<volatile char*>(value), operand);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int16 atomicFetchAdd(volatile Int16* value, Int16 operand, Memory::Order)
+{
+    return _InterlockedExchangeAdd16(value, operand);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int32 atomicFetchAdd(volatile Int32* value, Int32 operand, Memory::Order)
+{
+    return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(value), operand);
+}
+
+
+#if defined(_M_IX86)
+
+// 32-bit x86 has no 64-bit exchange or add instruction, only cmpxchg8b
+
+////////////////////////////////////////////////////////////
+inline Int64 atomicExchange(volatile Int64* value, Int64 newValue, Memory::Order)
+{
+    Int64 expected = *value;
+    Int64 previous;
+    while ((previous = _InterlockedCompareExchange64(value, newValue, expected)) != expected)
+        expected = previous;
+
+    return previous;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int64 atomicFetchAdd(volatile Int64* value, Int64 operand, Memory::Order)
+{
+    Int64 expected = *value;
+    Int64 previous;
+    while ((previous = _InterlockedCompareExchange64(value, expected + operand, expected)) != expected)
+        expected = previous;
+
+    return previous;
+}
+
+#else
+
+////////////////////////////////////////////////////////////
+inline Int64 atomicExchange(volatile Int64* value, Int64 newValue, Memory::Order)
+{
+    return _InterlockedExchange64(value, newValue);
+}
+
+
+////////////////////////////////////////////////////////////
+inline Int64 atomicFetchAdd(volatile Int64* value, Int64 operand, Memory::Order)
+{
+    return _InterlockedExchangeAdd64(value, operand);
+}
+
+#endif
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline S atomicLoad(const volatile S* value, Memory::Order)
+{
+    volatile S* target = const_cast<volatile S*>(value);
+
+    #if defined(SFML_ATOMIC_ORDERED_MOVES)
+        // 64-bit moves are not atomic on 32-bit x86
+        if (sizeof(S) <= sizeof(void*))
+        {
+            S result = *target;
+            _ReadWriteBarrier();
+            return result;
+        }
+    #endif
+
+    return atomicCompareExchangeValue(target, S(0), S(0));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline void atomicStore(volatile S* value, S newValue, Memory::Order order)
+{
+    #if defined(SFML_ATOMIC_ORDERED_MOVES)
+        // A sequentially consistent store needs the full barrier of the exchange
+        if ((sizeof(S) <= sizeof(void*)) && (order != Memory::SequentiallyConsistent))
+        {
+            _ReadWriteBarrier();
+            *value = newValue;
+            return;
+        }
+    #endif
+
+    atomicExchange(value, newValue, order);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline bool atomicCompareExchange(volatile S* value, S& expected, S desired, Memory::Order)
+{
+    S previous = atomicCompareExchangeValue(value, desired, expected);
+    if (previous == expected)
+        return true;
+
+    expected = previous;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename S>
+inline S atomicFetchSub(volatile S* value, S operand, Memory::Order order)
+{
+    return atomicFetchAdd(value, static_cast<S>(-operand), order);
+}
+
+#undef SFML_ATOMIC_ORDERED_MOVES
+
+#else
+
+    #error No atomic operations are available for this compiler
+
+#endif
+
+} // namespace priv
+
+
+// The value is converted with C-style casts, which handle integers,
+// enums and pointers alike
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Atomic<T>::Atomic(T value) :
+m_value((Storage)(value))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T Atomic<T>::load(Memory::Order order) const
+{
+    return (T)(priv::atomicLoad(&m_value, order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void Atomic<T>::store(T value, Memory::Order order)
+{
+    priv::atomicStore(&m_value, (Storage)(value), order);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T Atomic<T>::exchange(T value, Memory::Order order)
+{
+    return (T)(priv::atomicExchange(&m_value, (Storage)(value), order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool Atomic<T>::compareExchange(T& expected, T desired, Memory::Order order)
+{
+    Storage previous = (Storage)(expected);
+    bool exchanged = priv::atomicCompareExchange(&m_value, previous, (Storage)(desired), order);
+    expected = (T)(previous);
+
+    return exchanged;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T Atomic<T>::fetchAdd(T value, Memory::Order order)
+{
+    return (T)(priv::atomicFetchAdd(&m_value, (Storage)(value), order));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T Atomic<T>::fetchSub(T value, Memory::Order order)
+{
+    return (T)(priv::atomicFetchSub(&m_value, (Storage)(value), order));
+}
+
+} // namespace sf
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_BUFFEREDINPUTSTREAM_HPP
+#define SFML_BUFFEREDINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Input stream reading another stream in large blocks
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API BufferedInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// When \a readAhead is true, a thread reads the block that
+    /// follows the one being consumed, so that sequential reads
+    /// rarely wait for the source.
+    ///
+    /// \param bufferSize Size of the blocks read from the source, in bytes
+    /// \param readAhead  Read the next block in the background?
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit BufferedInputStream(std::size_t bufferSize = 65536, bool readAhead = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~BufferedInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the stream from a file path
+    ///
+    /// The file is read through a sf::FileInputStream owned by
+    /// the buffered stream.
+    ///
+    /// \param filename Name of the file to open
+    ///
+    /// \return True on success, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the stream on top of another stream
+    ///
+    /// The source must stay alive, and must not be used
+    /// directly, as long as the buffered stream reads it.
+    /// Reading starts at the current position of the source.
+    ///
+    /// \param source Stream to read from
+    ///
+    /// \return True on success, false if the size of the source is unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(InputStream& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// Seeking inside the buffered blocks doesn't access the
+    /// source.
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief A block of data read from the source
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        std::vector<char> data;  ///< Bytes of the block
+        Int64             start; ///< Position of the first byte in the source
+        Int64             size;  ///< Number of valid bytes in data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop reading ahead and forget the buffered blocks
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a block from the source
+    ///
+    /// \param block    Block to fill
+    /// \param position Position of the block in the source
+    ///
+    ////////////////////////////////////////////////////////////
+    void fill(Block& block, Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the block following the current one current
+    ///
+    /// The next block is taken from the read-ahead thread if it
+    /// prepared it, read from the source otherwise.
+    ///
+    ////////////////////////////////////////////////////////////
+    void advance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the read-ahead thread is idle
+    ///
+    /// \return True if the next block was read ahead
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitReadAhead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ask the read-ahead thread for the block following the current one
+    ///
+    ////////////////////////////////////////////////////////////
+    void requestReadAhead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the read-ahead thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void readAhead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the read-ahead thread
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ReadAheadState
+    {
+        Idle,      ///< Nothing to do
+        Requested, ///< Reading the next block
+        Ready,     ///< The next block is available
+        Stopping   ///< The thread must exit
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t       m_bufferSize;       ///< Size of the blocks
+    bool              m_readAheadEnabled; ///< Read the next block in the background?
+    FileInputStream   m_file;             ///< File opened by open(filename)
+    InputStream*      m_source;           ///< Stream being buffered, NULL if not open
+    Int64             m_size;             ///< Size of the source
+    Block             m_current;          ///< Block being consumed
+    Int64             m_offset;           ///< Reading position in the current block
+    Block             m_next;             ///< Block read ahead, owned by the thread while a block is requested
+    Thread            m_thread;           ///< Thread reading ahead
+    Mutex             m_mutex;            ///< Protects the read-ahead state
+    ConditionVariable m_condition;        ///< Signals changes of the read-ahead state
+    ReadAheadState    m_state;            ///< State of the read-ahead thread
+};
+
+} // namespace sf
+
+
+#endif // SFML_BUFFEREDINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BufferedInputStream
+/// \ingroup system
+///
+/// Decoders often read their input in small pieces: a few
+/// bytes of header, a chunk of compressed samples... Each of
+/// these reads is a virtual call, and with sf::FileInputStream
+/// a call into the C library. sf::BufferedInputStream reads the
+/// source in large blocks instead, and serves the small reads
+/// and the seeks within these blocks from memory.
+///
+/// With read-ahead enabled, a thread of the stream reads the
+/// next block while the current one is consumed, so that
+/// decoding overlaps with the disk accesses.
+///
+/// SFML uses it when it can't map a file in memory, in the
+/// loadFromFile functions and in sf::Music::openFromFile.
+///
+/// Usage example:
+/// \code
+/// sf::BufferedInputStream stream(1024 * 1024, true);
+/// if (stream.open("music.ogg"))
+///     music.openFromStream(stream);
+/// \endcode
+///
+/// \see sf::InputStream, sf::FileInputStream, sf::MappedFileInputStream
+///
+////////////////////////////////////////////////////////////
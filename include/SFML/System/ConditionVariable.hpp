@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_CONDITIONVARIABLE_HPP
+#define SFML_CONDITIONVARIABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class ConditionVariableImpl;
+}
+
+class Mutex;
+class FastMutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Lets threads sleep until another thread notifies
+///        them that some shared state changed
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ConditionVariable : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// No thread may still be waiting on the condition variable.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for a notification
+    ///
+    /// The mutex, which the calling thread must have locked
+    /// exactly once, is released while the thread sleeps and
+    /// locked again before the function returns. The thread
+    /// may also wake up without any notification, so the
+    /// waited-for condition must always be checked in a loop.
+    ///
+    /// \param mutex Mutex protecting the shared state
+    ///
+    /// \see notifyOne, notifyAll
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(Mutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for a notification
+    ///
+    /// This overload takes a non-recursive sf::FastMutex.
+    ///
+    /// \param mutex Mutex protecting the shared state
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(FastMutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for a notification, for a limited time
+    ///
+    /// Like wait(Mutex&), the thread may also wake up without
+    /// any notification before the timeout.
+    ///
+    /// \param mutex   Mutex protecting the shared state
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Mutex& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for a notification, for a limited time
+    ///
+    /// This overload takes a non-recursive sf::FastMutex.
+    ///
+    /// \param mutex   Mutex protecting the shared state
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return False if the timeout expired, true otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(FastMutex& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one of the waiting threads
+    ///
+    /// Does nothing if there is no waiting thread. The mutex
+    /// doesn't need to be locked when notifying, but the shared
+    /// state must have been changed under it, otherwise a thread
+    /// about to wait can miss the notification.
+    ///
+    /// \see notifyAll
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the waiting threads
+    ///
+    /// \see notifyOne
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::ConditionVariableImpl* m_conditionImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ConditionVariable
+/// \ingroup system
+///
+/// A condition variable lets a thread wait until some state
+/// shared with other threads, protected by a mutex, reaches the
+/// value it needs, without polling it in a sleep() loop. The
+/// waiting thread checks the state with the mutex locked, and
+/// calls wait() while it isn't right: wait() releases the mutex
+/// and puts the thread to sleep in a single step, so that a
+/// change made by another thread can't slip in between. The
+/// thread that changes the state then calls notifyOne() or
+/// notifyAll().
+///
+/// Both sf::Mutex and sf::FastMutex can be used (the latter
+/// being locked with sf::FastLock instead of sf::Lock); a
+/// recursive sf::Mutex must be locked only once by the
+/// waiting thread.
+///
+/// Usage example:
+/// \code
+/// sf::Mutex mutex;
+/// sf::ConditionVariable condition;
+/// std::deque<Job> jobs;
+///
+/// void producer()
+/// {
+///     sf::Lock lock(mutex);
+///     jobs.push_back(makeJob());
+///     condition.notifyOne();
+/// }
+///
+/// void consumer()
+/// {
+///     sf::Lock lock(mutex);
+///     while (jobs.empty())
+///         condition.wait(mutex);
+///
+///     Job job = jobs.front();
+///     jobs.pop_front();
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::FastMutex, sf::Semaphore
+///
+////////////////////////////////////////////////////////////
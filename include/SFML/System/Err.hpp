@@ -52,15 +52,19 @@ SFML_SYSTEM_API std::ostream& err();
 ///
 /// By default, sf::err() outputs to the same location as std::cerr,
 /// (-> the stderr descriptor) which is the console if there's
-/// one available.
+/// one available. Every line flushed to sf::err() (usually with
+/// std::endl) is handed over to sf::Log as a single message: it is
+/// written by a background thread, identical messages repeated in
+/// a loop are rate limited, and sf::Log::setSink can forward them
+/// to the application.
 ///
 /// It is a standard std::ostream instance, so it supports all the
 /// insertion operations defined by the STL
 /// (operator <<, manipulators, etc.).
 ///
 /// sf::err() can be redirected to write to another output, independently
-/// of std::cerr, by using the rdbuf() function provided by the
-/// std::ostream class.
+/// of std::cerr and bypassing sf::Log, by using the rdbuf() function
+/// provided by the std::ostream class.
 ///
 /// Example:
 /// \code
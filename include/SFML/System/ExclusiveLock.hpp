@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_EXCLUSIVELOCK_HPP
+#define SFML_EXCLUSIVELOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class SharedMutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Automatic wrapper for the exclusive locking of
+///        shared mutexes
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ExclusiveLock : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the lock with a target mutex
+    ///
+    /// The mutex passed to sf::ExclusiveLock is automatically
+    /// locked for exclusive access.
+    ///
+    /// \param mutex Mutex to lock
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ExclusiveLock(SharedMutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor of sf::ExclusiveLock automatically unlocks its mutex.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ExclusiveLock();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SharedMutex& m_mutex; ///< Mutex to lock / unlock
+};
+
+} // namespace sf
+
+
+#endif // SFML_EXCLUSIVELOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ExclusiveLock
+/// \ingroup system
+///
+/// sf::ExclusiveLock is the equivalent of sf::Lock for the
+/// writers of a sf::SharedMutex: it locks the mutex for
+/// exclusive access in its constructor, and unlocks it in
+/// its destructor. The readers use sf::SharedLock.
+///
+/// \see sf::SharedMutex, sf::SharedLock
+///
+////////////////////////////////////////////////////////////
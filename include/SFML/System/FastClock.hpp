@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FASTCLOCK_HPP
+#define SFML_FASTCLOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Clock reading the processor's cycle counter,
+///        for time measurements in hot code
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FastClock
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The clock starts automatically after being constructed.
+    ///
+    ////////////////////////////////////////////////////////////
+    FastClock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the elapsed time
+    ///
+    /// This function returns the time elapsed since the last call
+    /// to restart() (or the construction of the instance if restart()
+    /// has not been called).
+    ///
+    /// \return Time elapsed
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getElapsedTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the clock
+    ///
+    /// This function puts the time counter back to zero.
+    /// It also returns the time elapsed since the clock was started.
+    ///
+    /// \return Time elapsed
+    ///
+    ////////////////////////////////////////////////////////////
+    Time restart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the elapsed time in raw ticks
+    ///
+    /// This is the cheapest way to measure time: no conversion
+    /// is done. Accumulate ticks, and convert the total with
+    /// ticksToTime() only when it is needed.
+    ///
+    /// \return Number of ticks elapsed since the last restart
+    ///
+    /// \see ticksToTime
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getElapsedTicks() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current value of the tick counter
+    ///
+    /// Only differences between two values are meaningful.
+    ///
+    /// \return Current tick count
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTicks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of ticks per second
+    ///
+    /// \return Frequency of the tick counter
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTickFrequency();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a number of ticks to a time
+    ///
+    /// \param ticks Number of ticks
+    ///
+    /// \return Duration of the ticks
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time ticksToTime(Uint64 ticks);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the ticks come from the processor's cycle counter
+    ///
+    /// When the processor has no reliable cycle counter, the
+    /// clock falls back to the counter of the system clock,
+    /// which is slower to read.
+    ///
+    /// \return True if the cycle counter is used
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCycleCounter();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64 m_startTicks; ///< Tick count at the last restart
+};
+
+} // namespace sf
+
+
+#endif // SFML_FASTCLOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FastClock
+/// \ingroup system
+///
+/// sf::FastClock is used exactly like sf::Clock, but reads the
+/// cycle counter of the processor instead of asking the OS for
+/// the time: rdtsc or rdtscp on x86, cntvct_el0 on 64-bit ARM.
+/// Reading it takes a few nanoseconds, which makes it suitable
+/// for profiling code that takes time measurements millions of
+/// times per frame.
+///
+/// On x86 the counter is only used if it runs at a constant
+/// rate regardless of power states (the "invariant TSC"), and on
+/// Linux only if the kernel itself trusts it as a clock source.
+/// Its frequency is calibrated against the system clock once,
+/// which makes the first FastClock of the program take about
+/// 10 milliseconds to construct. When no reliable cycle counter
+/// is available, the raw counter of the system clock is used
+/// instead; isCycleCounter() tells which one was chosen.
+///
+/// Elapsed times can be read as raw ticks, and converted to
+/// sf::Time only when needed:
+/// \code
+/// sf::Uint64 total = 0;
+///
+/// for (...)
+/// {
+///     sf::Uint64 start = sf::FastClock::getTicks();
+///     doWork();
+///     total += sf::FastClock::getTicks() - start;
+/// }
+///
+/// std::cout << sf::FastClock::ticksToTime(total).asMicroseconds() << " us" << std::endl;
+/// \endcode
+///
+/// Like sf::Clock, sf::FastClock is monotonic. A calibrated
+/// cycle counter may drift from the system clock by a few
+/// parts per million: use sf::Clock to measure long durations
+/// that must match the wall clock.
+///
+/// \see sf::Clock, sf::Time
+///
+////////////////////////////////////////////////////////////
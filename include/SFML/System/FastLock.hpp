@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FASTLOCK_HPP
+#define SFML_FASTLOCK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class FastMutex;
+
+////////////////////////////////////////////////////////////
+/// \brief Automatic wrapper for locking and unlocking
+///        fast mutexes
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FastLock : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the lock with a target mutex
+    ///
+    /// The mutex passed to sf::FastLock is automatically locked.
+    ///
+    /// \param mutex Mutex to lock
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FastLock(FastMutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor of sf::FastLock automatically unlocks its mutex.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FastLock();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FastMutex& m_mutex; ///< Mutex to lock / unlock
+};
+
+} // namespace sf
+
+
+#endif // SFML_FASTLOCK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FastLock
+/// \ingroup system
+///
+/// sf::FastLock is the equivalent of sf::Lock for
+/// sf::FastMutex: it locks the mutex in its constructor, and
+/// unlocks it in its destructor.
+///
+/// \code
+/// sf::FastMutex mutex;
+///
+/// void function()
+/// {
+///     sf::FastLock lock(mutex); // mutex is now locked
+///     ...
+/// } // mutex is unlocked
+/// \endcode
+///
+/// \see sf::FastMutex, sf::Lock
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FASTMUTEX_HPP
+#define SFML_FASTMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class FastMutexImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Non-recursive mutex, optimized for short
+///        critical sections
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FastMutex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FastMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FastMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex
+    ///
+    /// If the mutex is already locked in another thread,
+    /// this call will block the execution until the mutex
+    /// is released. Locking the mutex again from the thread
+    /// that already holds it is a deadlock.
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    void lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+private:
+
+    friend class ConditionVariable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::FastMutexImpl* m_mutexImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_FASTMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FastMutex
+/// \ingroup system
+///
+/// sf::FastMutex is used exactly like sf::Mutex, but it is
+/// not recursive: a thread must not lock it again while it
+/// already holds it. In exchange it is cheaper to lock and
+/// unlock, and a thread that finds it locked first spins
+/// for a short while before going to sleep, which is much
+/// faster when the mutex only protects a few instructions.
+///
+/// It is based on non-recursive pthread mutexes on Unix
+/// (futexes on Linux), and on slim reader/writer locks on
+/// Windows, which spin on their own. There is no spinning
+/// on single-processor systems.
+///
+/// It should be locked with the sf::FastLock helper, the
+/// equivalent of sf::Lock for sf::Mutex:
+/// \code
+/// sf::FastMutex mutex;
+/// unsigned int counter = 0;
+///
+/// unsigned int next()
+/// {
+///     sf::FastLock lock(mutex);
+///     return counter++;
+/// }
+/// \endcode
+///
+/// \see sf::FastLock, sf::Mutex, sf::SharedMutex
+///
+////////////////////////////////////////////////////////////
@@ -48,6 +48,8 @@ class SFML_SYSTEM_API ResourceStream;
 
 namespace sf
 {
+class ArchiveInputStream;
+
 ////////////////////////////////////////////////////////////
 /// \brief Implementation of input stream based on a file
 ///
@@ -127,6 +129,7 @@ private:
 #else
     std::FILE* m_file; ///< stdio file stream
 #endif
+    ArchiveInputStream* m_entry; ///< File of a mounted archive, used instead of m_file if not NULL
 };
 
 } // namespace sf
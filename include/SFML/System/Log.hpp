@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_LOG_HPP
+#define SFML_LOG_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous output of the messages of SFML and of the application
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Log
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Severity of a message
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Level
+    {
+        Debug,   ///< Detailed information to diagnose problems
+        Info,    ///< Normal events worth reporting
+        Warning, ///< Unexpected events that SFML can recover from
+        Error    ///< Operations that failed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destination of the log messages
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Sink
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Sink();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Write a message
+        ///
+        /// This function is called from the log's writer thread,
+        /// one message at a time.
+        ///
+        /// \param level   Severity of the message
+        /// \param message Text of the message, without trailing newline
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void write(Level level, const std::string& message) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a message for writing
+    ///
+    /// The message is written by a background thread, this
+    /// function never waits for the output. If the queue is
+    /// full, the message is dropped and the number of dropped
+    /// messages is reported later.
+    ///
+    /// \param level   Severity of the message
+    /// \param message Text of the message
+    ///
+    ////////////////////////////////////////////////////////////
+    static void write(Level level, const std::string& message);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the queued messages are written
+    ///
+    ////////////////////////////////////////////////////////////
+    static void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the destination of the messages
+    ///
+    /// The sink must stay alive until another one replaces it.
+    /// Passing NULL restores the default sink, which writes to
+    /// the standard error output.
+    ///
+    /// \param sink New destination of the messages
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSink(Sink* sink);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum severity of the messages to write
+    ///
+    /// Messages of lower severity are discarded before being
+    /// queued. The default level is Info.
+    ///
+    /// \param level Minimum severity
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setLevel(Level level);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the repetitions of identical messages
+    ///
+    /// Once a message has been written \a count times within
+    /// \a period, its next occurrences are suppressed until the
+    /// period ends, and then reported as a single line. The
+    /// default is 10 times per second; a count of 0 disables
+    /// the limit.
+    ///
+    /// \param count  Number of identical messages written per period
+    /// \param period Duration of a period
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setRateLimit(unsigned int count, Time period);
+};
+
+} // namespace sf
+
+
+#endif // SFML_LOG_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Log
+/// \ingroup system
+///
+/// sf::Log hands messages over to a background thread through
+/// a lock-free queue, so that threads reporting errors in a
+/// loop don't wait for the console or a log file. Everything
+/// written to sf::err() ends up there too: each flushed line
+/// (usually terminated by std::endl) becomes one message, of
+/// Warning level if it starts with "Warning", of Error level
+/// otherwise.
+///
+/// Identical messages are rate limited, which keeps a driver
+/// error reported every frame from flooding the output.
+///
+/// By default, messages are written to the standard error
+/// output; a custom sf::Log::Sink can forward them anywhere:
+/// \code
+/// class ConsoleSink : public sf::Log::Sink
+/// {
+///     virtual void write(sf::Log::Level level, const std::string& message)
+///     {
+///         console.addLine(message, level >= sf::Log::Warning ? sf::Color::Red : sf::Color::White);
+///     }
+/// };
+///
+/// ConsoleSink sink;
+/// sf::Log::setSink(&sink);
+/// sf::Log::write(sf::Log::Info, "Level loaded");
+/// ...
+/// sf::Log::setSink(NULL);
+/// \endcode
+///
+/// Queued messages are written before the program exits.
+///
+/// \see sf::err
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_MAPPEDFILEINPUTSTREAM_HPP
+#define SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+namespace priv
+{
+    class FileMappingImpl;
+}
+
+class ArchiveInputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on a file
+///        mapped in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MappedFileInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the stream from a file path
+    ///
+    /// \param filename Name of the file to open
+    ///
+    /// \return True on success, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the contents of the file
+    ///
+    /// The pointer stays valid until the stream is closed,
+    /// reopened or destroyed.
+    ///
+    /// \return Pointer to the mapped data, NULL if no file is open or if it is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::FileMappingImpl* m_mapping; ///< OS-specific implementation, NULL if no file is open
+    ArchiveInputStream*    m_entry;   ///< File of a mounted archive, used instead of m_mapping if not NULL
+    const char*            m_data;    ///< Pointer to the mapped data
+    Int64                  m_size;    ///< Total size of the data
+    Int64                  m_offset;  ///< Current reading position
+};
+
+} // namespace sf
+
+
+#endif // SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MappedFileInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that
+/// maps a file in memory instead of reading it through
+/// the C standard library. Reads are plain copies from the
+/// mapped pages, and getData() gives direct access to the
+/// whole file, so that it can be passed to the loadFromMemory
+/// functions of the SFML resource classes without any copy.
+///
+/// SFML resource classes like sf::Image and sf::SoundBuffer
+/// use it internally when loading files.
+///
+/// Files can't be mapped everywhere (e.g. Android assets), so
+/// code using this class should fall back to sf::FileInputStream
+/// when open() fails.
+///
+/// Usage example:
+/// \code
+/// sf::MappedFileInputStream stream;
+/// if (!stream.open("some_file.dat"))
+/// {
+///     // Handle error...
+/// }
+///
+/// // The file's contents are available directly
+/// const void* data = stream.getData();
+/// sf::Int64 size = stream.getSize();
+/// \endcode
+///
+/// \see InputStream, FileInputStream, MemoryInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_MPMCQUEUE_HPP
+#define SFML_MPMCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/QueueSize.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue for any number of producer
+///        and consumer threads
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class MpmcQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// The capacity is rounded up to the next power of two.
+    ///
+    /// \param capacity Maximum number of elements in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit MpmcQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~MpmcQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an element to the end of the queue
+    ///
+    /// This function can be called from any thread. It never
+    /// blocks.
+    ///
+    /// \param value Element to append
+    ///
+    /// \return True if the element was appended, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the element at the front of the queue
+    ///
+    /// This function can be called from any thread. It never
+    /// blocks.
+    ///
+    /// \param value Variable receiving the removed element
+    ///
+    /// \return True if an element was removed, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of elements in the queue
+    ///
+    /// \return Capacity of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Slot of the ring
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Cell
+    {
+        Atomic<std::size_t> sequence; ///< Position of the push (when empty) or pop (when full) that may use the cell next
+        T                   value;    ///< Element stored in the cell
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Cell*               m_cells;        ///< Storage of the ring
+    std::size_t         m_mask;         ///< Number of cells minus one, the number of cells is a power of two
+    char                m_padding1[64]; ///< Keeps the consumers' counter on its own cache line
+    Atomic<std::size_t> m_head;         ///< Position of the next pop
+    char                m_padding2[64]; ///< Keeps the producers' counter on its own cache line
+    Atomic<std::size_t> m_tail;         ///< Position of the next push
+    char                m_padding3[64]; ///< Keeps the producers' counter away from what follows the queue
+};
+
+} // namespace sf
+
+#include <SFML/System/MpmcQueue.inl>
+
+
+#endif // SFML_MPMCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MpmcQueue
+/// \ingroup system
+///
+/// sf::MpmcQueue is a fixed-size ring that any number of
+/// threads can push to and pop from at the same time, without
+/// a lock. Each cell carries a sequence number telling whether
+/// it is ready to be written or read; a thread claims a
+/// position with a single compare-exchange on the shared
+/// counter, then copies its element in or out without any
+/// other thread touching the cell. A thread preempted between
+/// the two steps only delays the threads waiting for that very
+/// cell.
+///
+/// The queue is bounded: its storage is allocated once, by the
+/// constructor, and push() fails when it is full. The element
+/// type must be default-constructible and copyable; a removed
+/// element stays in its cell until a later push() overwrites it.
+///
+/// With exactly one producer and one consumer, sf::SpscQueue
+/// is cheaper.
+///
+/// Usage example:
+/// \code
+/// sf::MpmcQueue<Request> requests(1024);
+///
+/// // In any of the client threads
+/// if (!requests.push(request))
+///     reject(request);
+///
+/// // In each of the worker threads
+/// Request request;
+/// while (running)
+/// {
+///     if (requests.pop(request))
+///         handle(request);
+///     else
+///         sf::sleep(sf::milliseconds(1));
+/// }
+/// \endcode
+///
+/// \see sf::SpscQueue, sf::Atomic
+///
+////////////////////////////////////////////////////////////
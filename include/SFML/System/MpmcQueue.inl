@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+template <typename T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity) :
+m_cells(NULL),
+m_mask (0),
+m_head (0),
+m_tail (0)
+{
+    std::size_t size = priv::queueSize(capacity);
+
+    m_cells = new Cell[size];
+    m_mask = size - 1;
+
+    // Each cell is first written by the push at its own position
+    for (std::size_t i = 0; i < size; ++i)
+        m_cells[i].sequence.store(i, Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+MpmcQueue<T>::~MpmcQueue()
+{
+    delete[] m_cells;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool MpmcQueue<T>::push(const T& value)
+{
+    std::size_t position = m_tail.load(Memory::Relaxed);
+    Cell* cell;
+
+    for (;;)
+    {
+        cell = &m_cells[position & m_mask];
+        std::size_t sequence = cell->sequence.load(Memory::Acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0)
+        {
+            // The cell is free: claim the position, or retry with the one another producer left
+            if (m_tail.compareExchange(position, position + 1, Memory::Relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            // The cell still holds the element of the previous lap: the queue is full
+            return false;
+        }
+        else
+        {
+            // Another producer claimed the position already
+            position = m_tail.load(Memory::Relaxed);
+        }
+    }
+
+    cell->value = value;
+    cell->sequence.store(position + 1, Memory::Release);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool MpmcQueue<T>::pop(T& value)
+{
+    std::size_t position = m_head.load(Memory::Relaxed);
+    Cell* cell;
+
+    for (;;)
+    {
+        cell = &m_cells[position & m_mask];
+        std::size_t sequence = cell->sequence.load(Memory::Acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+        if (difference == 0)
+        {
+            // The cell is filled: claim the position, or retry with the one another consumer left
+            if (m_head.compareExchange(position, position + 1, Memory::Relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            // The cell has not been written for this lap yet: the queue is empty
+            return false;
+        }
+        else
+        {
+            // Another consumer claimed the position already
+            position = m_head.load(Memory::Relaxed);
+        }
+    }
+
+    value = cell->value;
+
+    // Free the cell for the push one lap later
+    cell->sequence.store(position + m_mask + 1, Memory::Release);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::getCapacity() const
+{
+    return m_mask + 1;
+}
+
+} // namespace sf
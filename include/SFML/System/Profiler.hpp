@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PROFILER_HPP
+#define SFML_PROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <string>
+
+
+////////////////////////////////////////////////////////////
+/// \brief Profile the enclosing scope under the given name
+///
+/// The name must be a string literal, or any other string that
+/// outlives the profiler's recording. This macro expands to
+/// nothing unless SFML_ENABLE_PROFILER is defined.
+///
+////////////////////////////////////////////////////////////
+#if defined(SFML_ENABLE_PROFILER)
+
+    #define SFML_PROFILE_CONCATENATE_IMPL(a, b) a##b
+    #define SFML_PROFILE_CONCATENATE(a, b) SFML_PROFILE_CONCATENATE_IMPL(a, b)
+    #define SFML_PROFILE_SCOPE(name) sf::priv::ProfileScope SFML_PROFILE_CONCATENATE(sfmlProfileScope, __LINE__)(name)
+
+#else
+
+    #define SFML_PROFILE_SCOPE(name) ((void)0)
+
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Global recorder of the zones profiled by SFML_PROFILE_SCOPE
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Profiler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording zones
+    ///
+    /// Zones are recorded from all threads until stop() is called.
+    /// Nothing is recorded before the first call to start().
+    ///
+    ////////////////////////////////////////////////////////////
+    static void start();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop recording zones
+    ///
+    /// The zones recorded so far are kept until clear() is called.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether zones are being recorded
+    ///
+    /// \return True between start() and stop()
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isRunning();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the zones recorded so far
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the recorded zones to a Chrome trace file
+    ///
+    /// The file uses the JSON trace event format, which can be
+    /// opened in chrome://tracing, Perfetto or Speedscope, and
+    /// imported in Tracy with its import-chrome tool. Recording
+    /// may continue while the file is written.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the file was written successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool saveToFile(const std::string& filename);
+};
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Measure the lifetime of a scope as a profiler zone
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ProfileScope
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the zone
+    ///
+    /// \param name Name of the zone
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ProfileScope(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the zone and record it
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ProfileScope();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const char* m_name;  ///< Name of the zone, NULL if the profiler is not running
+    Uint64      m_start; ///< Tick count at the opening of the zone
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Profiler
+/// \ingroup system
+///
+/// sf::Profiler records how long the zones marked with
+/// SFML_PROFILE_SCOPE take to execute, in every thread of the
+/// program, and writes them to a trace file that can be
+/// explored in chrome://tracing, Perfetto or Tracy. Zones
+/// nested in time are displayed as a hierarchy.
+///
+/// SFML_PROFILE_SCOPE compiles to nothing unless the macro
+/// SFML_ENABLE_PROFILER is defined, so zones can be left in
+/// production code. SFML marks its own hot paths (drawing,
+/// glyph rendering, texture uploads, audio streaming) when it
+/// is built with the SFML_ENABLE_PROFILER CMake option.
+///
+/// Recording a zone reads sf::FastClock twice and appends the
+/// zone to a lock-free buffer owned by the calling thread; a
+/// lock is only taken when that buffer is full, to move its
+/// contents to the recording.
+///
+/// Usage example:
+/// \code
+/// void update()
+/// {
+///     SFML_PROFILE_SCOPE("update");
+///     ...
+/// }
+///
+/// sf::Profiler::start();
+///
+/// while (window.isOpen())
+/// {
+///     SFML_PROFILE_SCOPE("frame");
+///     update();
+///     draw();
+/// }
+///
+/// sf::Profiler::stop();
+/// sf::Profiler::saveToFile("trace.json");
+/// \endcode
+///
+/// \see sf::FastClock
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_QUEUESIZE_HPP
+#define SFML_QUEUESIZE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the number of slots of a lock-free queue
+///
+/// The queues index their slots with a mask, so their size
+/// is a power of two.
+///
+/// \param capacity Capacity requested for the queue
+///
+/// \return Smallest power of two not less than \a capacity
+///
+////////////////////////////////////////////////////////////
+inline std::size_t queueSize(std::size_t capacity)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+
+    return size;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_QUEUESIZE_HPP
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SEMAPHORE_HPP
+#define SFML_SEMAPHORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counter that threads can wait on until it is positive
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Semaphore : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial value of the count
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Semaphore(unsigned int count = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// No thread may still be waiting on the semaphore.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the count
+    ///
+    /// If threads are waiting, one of them wakes up and
+    /// takes the new unit.
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the count is positive, then decrement it
+    ///
+    /// \see post, tryWait
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the count is positive, for a limited time
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the count was decremented, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the count if it is positive, without waiting
+    ///
+    /// \return True if the count was decremented
+    ///
+    ////////////////////////////////////////////////////////////
+    bool tryWait();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SemaphoreImpl* m_semaphoreImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Semaphore
+/// \ingroup system
+///
+/// A semaphore is a counter of available units of something:
+/// post() adds one, and wait() takes one, sleeping as long as
+/// there is none. It is the simplest way to hand a wake-up from
+/// one thread to another: unlike sf::ConditionVariable, no
+/// mutex is involved and a post() is never lost, even if it
+/// happens before the other thread starts waiting.
+///
+/// With an initial count of zero and a single waiter, it works
+/// as an event: the waiting thread sleeps until another thread
+/// signals it with post().
+///
+/// Usage example:
+/// \code
+/// sf::Semaphore ready;
+///
+/// void loader()
+/// {
+///     loadResources();
+///     ready.post();
+/// }
+///
+/// int main()
+/// {
+///     sf::Thread thread(&loader);
+///     thread.launch();
+///
+///     // Show a splash screen until loading is done
+///     while (!ready.wait(sf::milliseconds(16)))
+///         drawSplashScreen();
+/// }
+/// \endcode
+///
+/// \see sf::ConditionVariable, sf::Thread
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHAREDMUTEX_HPP
+#define SFML_SHAREDMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SharedMutexImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Mutex that can be shared by several readers,
+///        or owned by a single writer
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API SharedMutex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SharedMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for exclusive access
+    ///
+    /// This call blocks the execution until no other thread
+    /// holds the mutex, either exclusively or shared.
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    void lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex after an exclusive access
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for shared access
+    ///
+    /// This call blocks the execution while another thread
+    /// holds the mutex exclusively; any number of threads can
+    /// hold it shared at the same time.
+    ///
+    /// \see unlockShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockShared();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex after a shared access
+    ///
+    /// \see lockShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockShared();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SharedMutexImpl* m_mutexImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAREDMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SharedMutex
+/// \ingroup system
+///
+/// sf::SharedMutex protects data that is read much more often
+/// than it is written: the readers lock it shared, and don't
+/// block each other, while a writer locks it exclusively.
+/// Like sf::FastMutex, it is not recursive.
+///
+/// Writers are given priority on Linux, so that a continuous
+/// flow of readers can't starve them.
+///
+/// Usage example:
+/// \code
+/// sf::SharedMutex mutex;
+/// std::map<std::string, int> table;
+///
+/// int find(const std::string& name)
+/// {
+///     sf::SharedLock lock(mutex); // other readers can run meanwhile
+///     std::map<std::string, int>::const_iterator it = table.find(name);
+///     return (it != table.end()) ? it->second : -1;
+/// }
+///
+/// void insert(const std::string& name, int value)
+/// {
+///     sf::ExclusiveLock lock(mutex); // exclusive access
+///     table[name] = value;
+/// }
+/// \endcode
+///
+/// \see sf::SharedLock, sf::ExclusiveLock, sf::FastMutex
+///
+////////////////////////////////////////////////////////////
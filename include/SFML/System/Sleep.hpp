@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Export.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Time.hpp>
 
 
@@ -39,13 +40,44 @@ namespace sf
 /// \brief Make the current thread sleep for a given duration
 ///
 /// sf::sleep is the best way to block a program or one of its
-/// threads, as it doesn't consume any CPU power.
+/// threads, as it doesn't consume any CPU power. Sleeps are
+/// sub-millisecond precise on Unix, and on Windows 10 1803
+/// and later.
 ///
 /// \param duration Time to sleep
 ///
 ////////////////////////////////////////////////////////////
 void SFML_SYSTEM_API sleep(Time duration);
 
+////////////////////////////////////////////////////////////
+/// \ingroup system
+/// \brief Make the current thread sleep until a clock reaches a given time
+///
+/// Unlike sleep(), the wake-up time doesn't depend on when
+/// the function is called, so a loop that moves its deadline
+/// forward on each iteration keeps a steady rate even if the
+/// work in between takes a variable time, and a sleep that is
+/// interrupted doesn't accumulate any delay. If the deadline
+/// has already passed, the function returns immediately.
+///
+/// \code
+/// sf::Clock clock;
+/// sf::Time deadline = sf::Time::Zero;
+///
+/// for (;;)
+/// {
+///     update();
+///     deadline += sf::milliseconds(5);
+///     sf::sleepUntil(clock, deadline);
+/// }
+/// \endcode
+///
+/// \param clock    Clock measuring the deadline
+/// \param deadline Elapsed time of the clock at which to wake up
+///
+////////////////////////////////////////////////////////////
+void SFML_SYSTEM_API sleepUntil(const Clock& clock, Time deadline);
+
 } // namespace sf
 
 
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SPSCQUEUE_HPP
+#define SFML_SPSCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/QueueSize.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue for one producer and one consumer thread
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpscQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// The capacity is rounded up to the next power of two.
+    ///
+    /// \param capacity Maximum number of elements in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpscQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an element to the end of the queue
+    ///
+    /// This function must always be called from the same
+    /// thread, the producer. It never blocks.
+    ///
+    /// \param value Element to append
+    ///
+    /// \return True if the element was appended, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the element at the front of the queue
+    ///
+    /// This function must always be called from the same
+    /// thread, the consumer. It never blocks.
+    ///
+    /// \param value Variable receiving the removed element
+    ///
+    /// \return True if an element was removed, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of elements in the queue
+    ///
+    /// The result is only a snapshot if the other thread is
+    /// using the queue at the same time.
+    ///
+    /// \return Number of elements waiting to be removed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of elements in the queue
+    ///
+    /// \return Capacity of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T>      m_slots;          ///< Storage of the ring, its size is a power of two
+    char                m_padding1[64];   ///< Keeps the consumer data on its own cache line
+    Atomic<std::size_t> m_head;           ///< Total number of elements removed, written by the consumer only
+    std::size_t         m_cachedTail;     ///< Last value of m_tail seen by the consumer
+    char                m_padding2[64];   ///< Keeps the producer data on its own cache line
+    Atomic<std::size_t> m_tail;           ///< Total number of elements appended, written by the producer only
+    std::size_t         m_cachedHead;     ///< Last value of m_head seen by the producer
+    char                m_padding3[64];   ///< Keeps the producer data away from what follows the queue
+};
+
+} // namespace sf
+
+#include <SFML/System/SpscQueue.inl>
+
+
+#endif // SFML_SPSCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpscQueue
+/// \ingroup system
+///
+/// sf::SpscQueue hands elements over from one thread to another
+/// without any lock: the producer thread appends elements with
+/// push(), the consumer thread removes them with pop(), and
+/// neither ever waits for the other. Each side only writes its
+/// own counter, and rereads the counter of the other side only
+/// when the queue looks full or empty, so that they don't keep
+/// stealing each other's cache lines.
+///
+/// The queue is bounded: its storage is allocated once, by the
+/// constructor, and push() fails when it is full. The element
+/// type must be default-constructible and copyable; a removed
+/// element stays in its slot until a later push() overwrites it.
+///
+/// When several threads produce or consume, use sf::MpmcQueue
+/// instead.
+///
+/// Usage example:
+/// \code
+/// sf::SpscQueue<Packet*> queue(256);
+///
+/// // In the network thread
+/// while (!queue.push(packet))
+///     sf::sleep(sf::milliseconds(1));
+///
+/// // In the main thread
+/// Packet* packet;
+/// while (queue.pop(packet))
+///     process(packet);
+/// \endcode
+///
+/// \see sf::MpmcQueue, sf::Atomic
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+template <typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity) :
+m_slots     (priv::queueSize(capacity)),
+m_head      (0),
+m_cachedTail(0),
+m_tail      (0),
+m_cachedHead(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscQueue<T>::push(const T& value)
+{
+    // Only the producer writes m_tail, a relaxed read is enough
+    std::size_t tail = m_tail.load(Memory::Relaxed);
+    std::size_t capacity = m_slots.size();
+
+    if (tail - m_cachedHead == capacity)
+    {
+        m_cachedHead = m_head.load(Memory::Acquire);
+        if (tail - m_cachedHead == capacity)
+            return false;
+    }
+
+    m_slots[tail & (capacity - 1)] = value;
+    m_tail.store(tail + 1, Memory::Release);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+    // Only the consumer writes m_head, a relaxed read is enough
+    std::size_t head = m_head.load(Memory::Relaxed);
+
+    if (head == m_cachedTail)
+    {
+        m_cachedTail = m_tail.load(Memory::Acquire);
+        if (head == m_cachedTail)
+            return false;
+    }
+
+    value = m_slots[head & (m_slots.size() - 1)];
+    m_head.store(head + 1, Memory::Release);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::getSize() const
+{
+    std::size_t head = m_head.load(Memory::Acquire);
+    std::size_t tail = m_tail.load(Memory::Acquire);
+
+    return tail - head;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::getCapacity() const
+{
+    return m_slots.size();
+}
+
+} // namespace sf
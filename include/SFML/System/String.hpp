@@ -521,6 +521,25 @@ private:
     friend SFML_SYSTEM_API bool operator ==(const String& left, const String& right);
     friend SFML_SYSTEM_API bool operator <(const String& left, const String& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append UTF-8 characters converted to UTF-32 to a string
+    ///
+    /// Contiguous ranges are converted with a vectorized
+    /// fast path, other iterators one character at a time.
+    ///
+    /// \param begin  Forward iterator to the beginning of the UTF-8 sequence
+    /// \param end    Forward iterator to the end of the UTF-8 sequence
+    /// \param output String to append the UTF-32 characters to
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    static void decodeUtf8(T begin, T end, std::basic_string<Uint32>& output);
+    static void decodeUtf8(const Uint8* begin, const Uint8* end, std::basic_string<Uint32>& output);
+    static void decodeUtf8(const char* begin, const char* end, std::basic_string<Uint32>& output);
+    static void decodeUtf8(std::string::const_iterator begin, std::string::const_iterator end, std::basic_string<Uint32>& output);
+    static void decodeUtf8(std::string::iterator begin, std::string::iterator end, std::basic_string<Uint32>& output);
+    static void decodeUtf8(std::basic_string<Uint8>::const_iterator begin, std::basic_string<Uint8>::const_iterator end, std::basic_string<Uint32>& output);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
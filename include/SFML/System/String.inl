@@ -28,7 +28,7 @@ template <typename T>
 String String::fromUtf8(T begin, T end)
 {
     String string;
-    Utf8::toUtf32(begin, end, std::back_inserter(string.m_string));
+    decodeUtf8(begin, end, string.m_string);
     return string;
 }
 
@@ -51,3 +51,51 @@ String String::fromUtf32(T begin, T end)
     string.m_string.assign(begin, end);
     return string;
 }
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void String::decodeUtf8(T begin, T end, std::basic_string<Uint32>& output)
+{
+    Utf8::toUtf32(begin, end, std::back_inserter(output));
+}
+
+
+////////////////////////////////////////////////////////////
+inline void String::decodeUtf8(const char* begin, const char* end, std::basic_string<Uint32>& output)
+{
+    decodeUtf8(reinterpret_cast<const Uint8*>(begin), reinterpret_cast<const Uint8*>(end), output);
+}
+
+
+////////////////////////////////////////////////////////////
+inline void String::decodeUtf8(std::string::const_iterator begin, std::string::const_iterator end, std::basic_string<Uint32>& output)
+{
+    if (begin != end)
+    {
+        const char* data = &*begin;
+        decodeUtf8(data, data + (end - begin), output);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+inline void String::decodeUtf8(std::string::iterator begin, std::string::iterator end, std::basic_string<Uint32>& output)
+{
+    if (begin != end)
+    {
+        const char* data = &*begin;
+        decodeUtf8(data, data + (end - begin), output);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+inline void String::decodeUtf8(std::basic_string<Uint8>::const_iterator begin, std::basic_string<Uint8>::const_iterator end, std::basic_string<Uint32>& output)
+{
+    if (begin != end)
+    {
+        const Uint8* data = &*begin;
+        decodeUtf8(data, data + (end - begin), output);
+    }
+}
@@ -31,6 +31,7 @@
 #include <SFML/System/Export.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <cstdlib>
+#include <string>
 
 
 namespace sf
@@ -49,6 +50,20 @@ class SFML_SYSTEM_API Thread : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scheduling priorities of a thread
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Priority
+    {
+        Lowest,  ///< Only runs when nothing else wants the processor
+        Low,     ///< Background work that can wait
+        Normal,  ///< Priority the thread is created with (default)
+        High,    ///< Work that should preempt normal threads
+        Highest, ///< Highest priority within the normal scheduling class
+        RealTime ///< Real-time scheduling, for latency-critical work such as audio
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct the thread from a functor with no argument
     ///
@@ -171,6 +186,89 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the scheduling priority of the thread
+    ///
+    /// The priority is applied by the thread itself when it
+    /// starts, so it only takes effect at the next call to
+    /// launch(). It is a request: raising the priority above
+    /// Normal often requires privileges, and the thread keeps
+    /// the highest priority it is allowed to have otherwise.
+    /// RealTime falls back to Highest when real-time scheduling
+    /// is not allowed.
+    ///
+    /// Real-time threads preempt everything else: they must
+    /// only run short bursts of work and block the rest of the
+    /// time, or they starve the whole system.
+    ///
+    /// \param priority New priority of the thread
+    ///
+    /// \see getPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(Priority priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scheduling priority requested for the thread
+    ///
+    /// \return Requested priority
+    ///
+    /// \see setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    Priority getPriority() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the processors the thread can run on
+    ///
+    /// Bit i of the mask allows the thread to run on processor i;
+    /// a mask of zero, the default, allows all the processors.
+    /// Like the priority, the affinity only takes effect at the
+    /// next call to launch(). It is not supported on macOS and
+    /// iOS, where it is ignored.
+    ///
+    /// \param processorMask Mask of the allowed processors
+    ///
+    /// \see getAffinity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAffinity(Uint64 processorMask);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the processors the thread is allowed to run on
+    ///
+    /// \return Mask of the allowed processors, zero for all
+    ///
+    /// \see setAffinity
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getAffinity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the name of the thread
+    ///
+    /// The name is shown by debuggers, profilers and system
+    /// monitors. Like the priority, it only takes effect at
+    /// the next call to launch(). Linux truncates it to 15
+    /// characters.
+    ///
+    /// \param name New name of the thread
+    ///
+    /// \see getName
+    ///
+    ////////////////////////////////////////////////////////////
+    void setName(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the thread
+    ///
+    /// \return Name of the thread, empty if none was set
+    ///
+    /// \see setName
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getName() const;
+
 private:
 
     friend class priv::ThreadImpl;
@@ -188,6 +286,9 @@ private:
     ////////////////////////////////////////////////////////////
     priv::ThreadImpl* m_impl;       ///< OS-specific implementation of the thread
     priv::ThreadFunc* m_entryPoint; ///< Abstraction of the function to run
+    Priority          m_priority;   ///< Scheduling priority applied when the thread starts
+    Uint64            m_affinity;   ///< Mask of the allowed processors, zero for all
+    std::string       m_name;       ///< Name given to the thread when it starts
 };
 
 #include <SFML/System/Thread.inl>
@@ -277,6 +378,17 @@ private:
 /// from multiple threads at the same time. To prevent this
 /// kind of situations, you can use mutexes (see sf::Mutex).
 ///
+/// The priority, processor affinity and name of a thread can
+/// be set before launching it. The thread applies them itself
+/// when it starts:
+/// \code
+/// sf::Thread thread(&mixAudio);
+/// thread.setName("mixer");
+/// thread.setPriority(sf::Thread::RealTime);
+/// thread.setAffinity(1 << 2); // only run on the third processor
+/// thread.launch();
+/// \endcode
+///
 /// \see sf::Mutex
 ///
 ////////////////////////////////////////////////////////////
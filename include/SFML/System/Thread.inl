@@ -67,7 +67,10 @@ struct ThreadMemberFunc : ThreadFunc
 template <typename F>
 Thread::Thread(F functor) :
 m_impl      (NULL),
-m_entryPoint(new priv::ThreadFunctor<F>(functor))
+m_entryPoint(new priv::ThreadFunctor<F>(functor)),
+m_priority  (Normal),
+m_affinity  (0),
+m_name      ()
 {
 }
 
@@ -76,7 +79,10 @@ m_entryPoint(new priv::ThreadFunctor<F>(functor))
 template <typename F, typename A>
 Thread::Thread(F function, A argument) :
 m_impl      (NULL),
-m_entryPoint(new priv::ThreadFunctorWithArg<F, A>(function, argument))
+m_entryPoint(new priv::ThreadFunctorWithArg<F, A>(function, argument)),
+m_priority  (Normal),
+m_affinity  (0),
+m_name      ()
 {
 }
 
@@ -85,6 +91,9 @@ m_entryPoint(new priv::ThreadFunctorWithArg<F, A>(function, argument))
 template <typename C>
 Thread::Thread(void(C::*function)(), C* object) :
 m_impl      (NULL),
-m_entryPoint(new priv::ThreadMemberFunc<C>(function, object))
+m_entryPoint(new priv::ThreadMemberFunc<C>(function, object)),
+m_priority  (Normal),
+m_affinity  (0),
+m_name      ()
 {
 }
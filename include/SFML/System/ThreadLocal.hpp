@@ -83,7 +83,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::ThreadLocalImpl* m_impl; ///< Pointer to the OS specific implementation
+    priv::ThreadLocalImpl* m_impl; ///< Pointer to the OS specific implementation, NULL when a compiler-provided slot is used
+    int                    m_slot; ///< Index of the compiler-provided thread-local slot, -1 if there is none
 };
 
 } // namespace sf
@@ -0,0 +1,413 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_THREADPOOL_HPP
+#define SFML_THREADPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/ThreadLocal.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+    struct TaskState;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of worker threads sharing jobs by work stealing
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ThreadPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a job pushed to a thread pool
+    ///
+    /// Tasks are returned by push() and pushAfter(), and are
+    /// used to wait for a particular job or to make other jobs
+    /// depend on it. A default-constructed task is empty, and
+    /// behaves as if it were done. Tasks must not outlive the
+    /// pool that created them.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Task
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor, creates an empty task
+        ///
+        ////////////////////////////////////////////////////////////
+        Task();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// \param copy Task to copy, both refer to the same job
+        ///
+        ////////////////////////////////////////////////////////////
+        Task(const Task& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Destructor
+        ///
+        /// Destroying a task doesn't cancel its job.
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Task();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Overload of assignment operator
+        ///
+        /// \param right Task to assign
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        Task& operator =(const Task& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the job of the task has run
+        ///
+        /// \return True if the job is finished, or if the task is empty
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isDone() const;
+
+    private:
+
+        friend class ThreadPool;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the task from its state, taking one of its references
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Task(priv::TaskState* state);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        priv::TaskState* m_state; ///< Shared state of the job, NULL for an empty task
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the pool and launch its worker threads
+    ///
+    /// \param threadCount Number of worker threads to launch,
+    ///                    0 to use one per processor
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ThreadPool(unsigned int threadCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The destructor calls wait(), so that every queued job
+    /// is run before the worker threads are shut down.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ThreadPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a functor (or free function) with no argument
+    ///
+    /// The functor is copied into the pool and run by the first
+    /// worker thread that becomes available. Jobs pushed from a
+    /// worker thread go to the queue of this worker, the others
+    /// are spread among the workers.
+    ///
+    /// \param functor Functor or free function to run
+    ///
+    /// \return Task of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Task push(F functor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a functor (or free function) with one argument
+    ///
+    /// \param function Functor or free function to run
+    /// \param argument Argument to forward to the function
+    ///
+    /// \return Task of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F, typename A>
+    Task push(F function, A argument);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a member function to be called on an object
+    ///
+    /// \param function Member function to run
+    /// \param object   Pointer to the object to use
+    ///
+    /// \return Task of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename C>
+    Task push(void(C::*function)(), C* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a functor to run once another job is finished
+    ///
+    /// The job is queued when \a dependency is done, right away
+    /// if it already is. The dependency must come from the same
+    /// pool.
+    ///
+    /// \param dependency Task that must finish first
+    /// \param functor    Functor or free function to run
+    ///
+    /// \return Task of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Task pushAfter(const Task& dependency, F functor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a functor to run once other jobs are finished
+    ///
+    /// The job is queued when all the \a dependencies are done.
+    /// The dependencies must come from the same pool.
+    ///
+    /// \param dependencies Tasks that must finish first
+    /// \param functor      Functor or free function to run
+    ///
+    /// \return Task of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    Task pushAfter(const std::vector<Task>& dependencies, F functor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Split a range of indices across the worker threads
+    ///
+    /// The range [0, count) is cut into contiguous, disjoint
+    /// blocks and \a function is called once per block as
+    /// function(begin, end), with both arguments of type
+    /// std::size_t. This function returns once every block
+    /// has been processed; the calling thread takes part in
+    /// the work while it waits. It can be called from a job of
+    /// the same pool (nested loops).
+    ///
+    /// \param count     Number of indices to process
+    /// \param function  Functor or free function processing a block
+    /// \param blockSize Number of indices per block, 0 to pick
+    ///                  a size from the number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void parallelFor(std::size_t count, F function, std::size_t blockSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a job is finished
+    ///
+    /// The calling thread runs other queued jobs while the job
+    /// of \a task is not finished. Unlike wait(), this function
+    /// can be called from a job of the same pool.
+    ///
+    /// \param task Task to wait for
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(const Task& task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until every queued job has been run
+    ///
+    /// The calling thread runs queued jobs itself until the
+    /// queues are empty, then blocks until the jobs still in
+    /// progress (or waiting for their dependencies) are finished.
+    /// Warning: calling this function from inside a job of
+    /// the same pool blocks forever.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of worker threads of the pool
+    ///
+    /// \return Number of worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of processors of the system
+    ///
+    /// \return Number of logical processors, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getProcessorCount();
+
+private:
+
+    struct Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the task of a job, and queue it if it has no pending dependency
+    ///
+    /// \param job          Job to run, the pool takes ownership of it
+    /// \param dependencies Tasks that must finish first
+    /// \param count        Number of dependencies
+    ///
+    /// \return Task of the job
+    ///
+    ////////////////////////////////////////////////////////////
+    Task enqueue(priv::ThreadFunc* job, const Task* dependencies, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a ready task to a queue
+    ///
+    /// The mutex must be locked, and the caller must post the
+    /// job semaphore once the mutex is unlocked.
+    ///
+    /// \param state Task to queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void schedule(priv::TaskState* state);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the next task to run
+    ///
+    /// The newest task of the queue of \a self is taken first,
+    /// then the oldest task of the other queues.
+    ///
+    /// \param self Worker of the calling thread, NULL if it isn't one
+    ///
+    /// \return The task, or NULL if all the queues are empty
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::TaskState* takeTask(Worker* self);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a task, then queue its dependents and wake up its waiters
+    ///
+    /// \param state Task to run
+    ///
+    ////////////////////////////////////////////////////////////
+    void execute(priv::TaskState* state);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the worker threads
+    ///
+    /// \param self Worker run by the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run(Worker& self);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Worker*>              m_workers;       ///< Worker threads and their queues
+    ThreadLocal                       m_currentWorker; ///< Worker run by the current thread, NULL for the other threads
+    FastMutex                         m_mutex;         ///< Mutex protecting the tasks and the counters
+    priv::SemaphoreImpl*              m_jobSemaphore;  ///< Posted once per queued job, and once per worker on shutdown
+    priv::SemaphoreImpl*              m_idleSemaphore; ///< Posted once per waiting thread when the pool becomes idle
+    std::vector<priv::SemaphoreImpl*> m_helpers;       ///< Semaphores of the threads blocked in wait(const Task&), woken up to run new jobs
+    std::size_t                       m_pendingCount;  ///< Number of jobs queued, waiting for their dependencies or running
+    unsigned long                     m_scheduleCount; ///< Number of jobs queued since the creation of the pool
+    unsigned int                      m_waiterCount;   ///< Number of threads blocked in wait()
+    bool                              m_stopping;      ///< Tells the worker threads to exit
+};
+
+#include <SFML/System/ThreadPool.inl>
+
+} // namespace sf
+
+
+#endif // SFML_THREADPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ThreadPool
+/// \ingroup system
+///
+/// A thread pool owns a fixed set of worker threads that are
+/// launched once and reused for many small jobs, which avoids
+/// the cost of creating a new sf::Thread for each of them.
+///
+/// Jobs are pushed with the same kinds of entry points as
+/// sf::Thread accepts (free functions, functors, member
+/// functions). Each worker has its own queue: it runs the
+/// jobs that it pushed itself first, newest first so that
+/// their data is still in its cache, and steals the oldest
+/// jobs of the other workers when its queue is empty. wait()
+/// blocks until every job is finished; the calling thread
+/// helps running jobs in the meantime.
+///
+/// push() returns a task, which can be waited for on its own
+/// or used as a dependency of other jobs with pushAfter(), so
+/// that a small graph of jobs runs without blocking any thread:
+/// \code
+/// sf::ThreadPool::Task heights = pool.push(&generateHeights);
+/// sf::ThreadPool::Task normals = pool.pushAfter(heights, &computeNormals);
+/// sf::ThreadPool::Task colors  = pool.pushAfter(heights, &computeColors);
+///
+/// std::vector<sf::ThreadPool::Task> both;
+/// both.push_back(normals);
+/// both.push_back(colors);
+/// pool.wait(pool.pushAfter(both, &buildVertices));
+/// \endcode
+///
+/// parallelFor() is the usual way to spread a loop over the
+/// workers: each block is handed a disjoint range of indices,
+/// so blocks can write to their own part of a shared buffer
+/// without any locking.
+///
+/// Usage example:
+/// \code
+/// struct Generate
+/// {
+///     std::vector<float>* data;
+///
+///     void operator()(std::size_t begin, std::size_t end) const
+///     {
+///         for (std::size_t i = begin; i < end; ++i)
+///             (*data)[i] = std::sqrt(static_cast<float>(i));
+///     }
+/// };
+///
+/// sf::ThreadPool pool;
+/// std::vector<float> data(100000);
+/// Generate generate = {&data};
+///
+/// pool.parallelFor(data.size(), generate);
+/// \endcode
+///
+/// \see sf::Thread, sf::VertexArray::generate
+///
+////////////////////////////////////////////////////////////
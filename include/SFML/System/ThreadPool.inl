@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+namespace priv
+{
+// Job processing one block of a parallelFor() range
+template <typename F>
+struct ParallelForBlock
+{
+    ParallelForBlock(F function, std::size_t begin, std::size_t end) : m_function(function), m_begin(begin), m_end(end) {}
+    void operator()() {m_function(m_begin, m_end);}
+    F           m_function;
+    std::size_t m_begin;
+    std::size_t m_end;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+ThreadPool::Task ThreadPool::push(F functor)
+{
+    return enqueue(new priv::ThreadFunctor<F>(functor), NULL, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F, typename A>
+ThreadPool::Task ThreadPool::push(F function, A argument)
+{
+    return enqueue(new priv::ThreadFunctorWithArg<F, A>(function, argument), NULL, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C>
+ThreadPool::Task ThreadPool::push(void(C::*function)(), C* object)
+{
+    return enqueue(new priv::ThreadMemberFunc<C>(function, object), NULL, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+ThreadPool::Task ThreadPool::pushAfter(const Task& dependency, F functor)
+{
+    return enqueue(new priv::ThreadFunctor<F>(functor), &dependency, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+ThreadPool::Task ThreadPool::pushAfter(const std::vector<Task>& dependencies, F functor)
+{
+    return enqueue(new priv::ThreadFunctor<F>(functor), dependencies.empty() ? NULL : &dependencies[0], dependencies.size());
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void ThreadPool::parallelFor(std::size_t count, F function, std::size_t blockSize)
+{
+    if (count == 0)
+        return;
+
+    // Aim for a few blocks per thread (including the caller) so that uneven blocks balance out
+    if (blockSize == 0)
+    {
+        std::size_t blockCount = (m_workers.size() + 1) * 4;
+        blockSize = (count + blockCount - 1) / blockCount;
+    }
+
+    std::vector<Task> blocks;
+    blocks.reserve((count + blockSize - 1) / blockSize);
+    for (std::size_t begin = 0; begin < count; begin += blockSize)
+    {
+        std::size_t end = (count - begin > blockSize) ? begin + blockSize : count;
+        blocks.push_back(push(priv::ParallelForBlock<F>(function, begin, end)));
+    }
+
+    // Only wait for our own blocks, so that loops can be nested in jobs
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+        wait(blocks[i]);
+}
@@ -0,0 +1,401 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_UTF8STRING_HPP
+#define SFML_UTF8STRING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Utf.hpp>
+#include <cstddef>
+#include <string>
+
+
+namespace sf
+{
+class String;
+
+////////////////////////////////////////////////////////////
+/// \brief Compact string storing UTF-8 characters
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Utf8String
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Iterator over the characters of a UTF-8 string
+    ///
+    /// Dereferencing the iterator decodes the UTF-32 code point
+    /// at its position.
+    ///
+    ////////////////////////////////////////////////////////////
+    class ConstIterator
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an iterator that doesn't refer to any string.
+        ///
+        ////////////////////////////////////////////////////////////
+        ConstIterator();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Decode the character at the iterator's position
+        ///
+        /// \return UTF-32 code point of the character
+        ///
+        ////////////////////////////////////////////////////////////
+        Uint32 operator *() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Move to the next character
+        ///
+        /// \return Reference to self
+        ///
+        ////////////////////////////////////////////////////////////
+        ConstIterator& operator ++();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Move to the next character
+        ///
+        /// \return Iterator to the previous position
+        ///
+        ////////////////////////////////////////////////////////////
+        ConstIterator operator ++(int);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Compare the positions of two iterators
+        ///
+        /// \param right Iterator to compare with
+        ///
+        /// \return True if both iterators point to the same character
+        ///
+        ////////////////////////////////////////////////////////////
+        bool operator ==(const ConstIterator& right) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Compare the positions of two iterators
+        ///
+        /// \param right Iterator to compare with
+        ///
+        /// \return True if the iterators point to different characters
+        ///
+        ////////////////////////////////////////////////////////////
+        bool operator !=(const ConstIterator& right) const;
+
+    private:
+
+        friend class Utf8String;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the iterator from a position in a string
+        ///
+        /// \param position First byte of the character
+        /// \param end      End of the string
+        ///
+        ////////////////////////////////////////////////////////////
+        ConstIterator(const Uint8* position, const Uint8* end);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        const Uint8* m_position; ///< First byte of the current character
+        const Uint8* m_end;      ///< End of the string
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// This constructor creates an empty string.
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a null-terminated UTF-8 string
+    ///
+    /// \param utf8 UTF-8 string to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8String(const char* utf8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a sequence of UTF-8 bytes
+    ///
+    /// \param utf8 UTF-8 bytes to copy
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String(const char* utf8, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a standard string holding UTF-8
+    ///
+    /// \param utf8 UTF-8 string to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8String(const std::string& utf8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from a sf::String
+    ///
+    /// \param string String to encode to UTF-8
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8String(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String(const Utf8String& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Utf8String();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String& operator =(const Utf8String& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of += operator to append a UTF-8 string
+    ///
+    /// \param right String to append
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8String& operator +=(const Utf8String& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a sequence of UTF-8 bytes
+    ///
+    /// \param utf8 UTF-8 bytes to append
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const char* utf8, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the string
+    ///
+    /// The memory allocated for long strings is kept.
+    ///
+    /// \see isEmpty
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the string, in bytes
+    ///
+    /// \return Number of UTF-8 bytes in the string
+    ///
+    /// \see getLength
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the length of the string, in characters
+    ///
+    /// This function counts the characters of the string, its
+    /// complexity is linear.
+    ///
+    /// \return Number of characters in the string
+    ///
+    /// \see getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLength() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the string is empty or not
+    ///
+    /// \return True if the string is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEmpty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the UTF-8 bytes
+    ///
+    /// The returned pointer is valid until the string is modified
+    /// or destroyed, and points to a null-terminated array.
+    ///
+    /// \return Read-only pointer to the bytes of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the string to a sf::String
+    ///
+    /// \return UTF-32 copy of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    String toString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the UTF-8 bytes to a standard string
+    ///
+    /// \return Standard string holding the UTF-8 bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string toStdString() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return an iterator to the first character
+    ///
+    /// \return Iterator to the beginning of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    ConstIterator begin() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return an iterator past the last character
+    ///
+    /// \return Iterator to the end of the string
+    ///
+    ////////////////////////////////////////////////////////////
+    ConstIterator end() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the string can hold a given number of bytes
+    ///
+    /// \param capacity Minimum number of bytes, null terminator excluded
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    enum {LocalCapacity = 23}; ///< Number of bytes stored without allocating
+
+    Uint8*      m_data;                     ///< Bytes of the string, m_local or a heap allocation
+    std::size_t m_size;                     ///< Number of bytes, null terminator excluded
+    std::size_t m_capacity;                 ///< Number of bytes that fit in m_data, null terminator excluded
+    Uint8       m_local[LocalCapacity + 1]; ///< Storage of short strings
+};
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of == operator to compare two UTF-8 strings
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return True if both strings are equal
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API bool operator ==(const Utf8String& left, const Utf8String& right);
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of != operator to compare two UTF-8 strings
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return True if both strings are different
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API bool operator !=(const Utf8String& left, const Utf8String& right);
+
+////////////////////////////////////////////////////////////
+/// \relates Utf8String
+/// \brief Overload of < operator to compare two UTF-8 strings
+///
+/// UTF-8 bytes sort in code point order, so this is the same
+/// order as the one of sf::String.
+///
+/// \param left  Left operand (a string)
+/// \param right Right operand (a string)
+///
+/// \return True if \a left is lexicographically before \a right
+///
+////////////////////////////////////////////////////////////
+SFML_SYSTEM_API bool operator <(const Utf8String& left, const Utf8String& right);
+
+#include <SFML/System/Utf8String.inl>
+
+} // namespace sf
+
+
+#endif // SFML_UTF8STRING_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Utf8String
+/// \ingroup system
+///
+/// sf::Utf8String stores its characters in UTF-8, which takes a
+/// single byte per ASCII character instead of the four bytes of
+/// sf::String, and keeps strings of up to 23 bytes inside the
+/// object itself, without allocating any memory. It is meant
+/// for the many short labels of a user interface, and for text
+/// that comes from UTF-8 sources such as files and network
+/// protocols.
+///
+/// Characters are read with iterators, which decode the UTF-8
+/// sequences on the fly:
+/// \code
+/// sf::Utf8String label("Score: 100");
+///
+/// for (sf::Utf8String::ConstIterator it = label.begin(); it != label.end(); ++it)
+///     sf::Uint32 codepoint = *it;
+/// \endcode
+///
+/// Unlike sf::String, sf::Utf8String has no random access to
+/// characters: use sf::String to edit text character by
+/// character. sf::Text displays a sf::Utf8String directly,
+/// without converting it to a sf::String first.
+///
+/// The constructors taking standard strings are explicit
+/// because, unlike those of sf::String, they interpret the
+/// bytes as UTF-8 rather than in the current locale.
+///
+/// \see sf::String, sf::Utf
+///
+////////////////////////////////////////////////////////////
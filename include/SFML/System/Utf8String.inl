@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+inline Utf8String::ConstIterator::ConstIterator() :
+m_position(NULL),
+m_end     (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+inline Utf8String::ConstIterator::ConstIterator(const Uint8* position, const Uint8* end) :
+m_position(position),
+m_end     (end)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+inline Uint32 Utf8String::ConstIterator::operator *() const
+{
+    Uint32 codepoint;
+    Utf8::decode(m_position, m_end, codepoint);
+    return codepoint;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Utf8String::ConstIterator& Utf8String::ConstIterator::operator ++()
+{
+    m_position = Utf8::next(m_position, m_end);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+inline Utf8String::ConstIterator Utf8String::ConstIterator::operator ++(int)
+{
+    ConstIterator previous(*this);
+    m_position = Utf8::next(m_position, m_end);
+    return previous;
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool Utf8String::ConstIterator::operator ==(const ConstIterator& right) const
+{
+    return m_position == right.m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+inline bool Utf8String::ConstIterator::operator !=(const ConstIterator& right) const
+{
+    return m_position != right.m_position;
+}
@@ -132,6 +132,31 @@ public:
     ////////////////////////////////////////////////////////////
     static Uint64 getActiveContextId();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the headless context backend
+    ///
+    /// Headless contexts are created through EGL on an offscreen
+    /// (surfaceless or device) display, so that sf::Context and
+    /// sf::RenderTexture can be used without a display server.
+    /// Windows cannot be created while the headless backend is
+    /// in use.
+    ///
+    /// The backend is chosen when the first OpenGL resource is
+    /// created, so this function must be called before that.
+    /// By default, the headless backend is used when the DISPLAY
+    /// environment variable is not set.
+    ///
+    /// The headless backend is only available on Linux with
+    /// desktop OpenGL, and when SFML was built with the
+    /// SFML_HEADLESS_EGL option.
+    ///
+    /// \param headless True to use the headless backend, false to use the default one
+    ///
+    /// \return True if the backend was selected, false if it is unavailable or already chosen
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setHeadless(bool headless);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
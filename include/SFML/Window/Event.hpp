@@ -33,6 +33,7 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Sensor.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -87,6 +88,21 @@ public:
         int y; ///< Y position of the mouse pointer, relative to the top of the owner window
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Raw mouse move event parameters (MouseMovedRaw)
+    ///
+    /// Raw mouse input data comes unprocessed from the
+    /// operating system, without acceleration or clamping to
+    /// the borders of the window or screen. The deltas are
+    /// expressed in device units (counts), not in pixels.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MouseMoveRawEvent
+    {
+        int deltaX; ///< Horizontal motion of the mouse since the previous event
+        int deltaY; ///< Vertical motion of the mouse since the previous event
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Mouse buttons events parameters
     ///        (MouseButtonPressed, MouseButtonReleased)
@@ -209,6 +225,7 @@ public:
         TouchMoved,             ///< A touch moved (data in event.touch)
         TouchEnded,             ///< A touch event ended (data in event.touch)
         SensorChanged,          ///< A sensor value changed (data in event.sensor)
+        MouseMovedRaw,          ///< The mouse moved, unaccelerated data (data in event.mouseMoveRaw)
 
         Count                   ///< Keep last -- the total number of event types
     };
@@ -216,7 +233,8 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    EventType type; ///< Type of the event
+    EventType type;      ///< Type of the event
+    Time      timestamp; ///< Time at which the event was received or sampled, on a monotonic clock shared by all the events
 
     union
     {
@@ -224,6 +242,7 @@ public:
         KeyEvent              key;               ///< Key event parameters (Event::KeyPressed, Event::KeyReleased)
         TextEvent             text;              ///< Text event parameters (Event::TextEntered)
         MouseMoveEvent        mouseMove;         ///< Mouse move event parameters (Event::MouseMoved)
+        MouseMoveRawEvent     mouseMoveRaw;      ///< Raw mouse move event parameters (Event::MouseMovedRaw)
         MouseButtonEvent      mouseButton;       ///< Mouse button event parameters (Event::MouseButtonPressed, Event::MouseButtonReleased)
         MouseWheelEvent       mouseWheel;        ///< Mouse wheel event parameters (Event::MouseWheelMoved) (deprecated)
         MouseWheelScrollEvent mouseWheelScroll;  ///< Mouse wheel event parameters (Event::MouseWheelScrolled)
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_INPUTSNAPSHOT_HPP
+#define SFML_INPUTSNAPSHOT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Export.hpp>
+#include <SFML/Window/Joystick.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <SFML/Window/Mouse.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Event;
+
+////////////////////////////////////////////////////////////
+/// \brief Per-frame copy of the state of the keyboard, mouse and joysticks
+///
+////////////////////////////////////////////////////////////
+class SFML_WINDOW_API InputSnapshot
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a snapshot where no key or button is pressed.
+    ///
+    ////////////////////////////////////////////////////////////
+    InputSnapshot();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the input changes carried by an event
+    ///
+    /// Call this function for every event polled from the
+    /// window. The changes only become visible to the queries
+    /// at the next call to update().
+    ///
+    /// \param event Event received from the window
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    void handleEvent(const Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Publish the state recorded since the last update
+    ///
+    /// Call this function once per frame, after the event loop.
+    /// The state of the joysticks is copied at this point; the
+    /// transitions (keys pressed or released, wheel motion)
+    /// accumulated since the previous update become visible.
+    ///
+    /// \see handleEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release all the keys and buttons
+    ///
+    /// The snapshot doesn't see the keys released while the
+    /// window doesn't have the focus; this is done automatically
+    /// when a LostFocus event is handled.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a key is held down
+    ///
+    /// \param key Key to check
+    ///
+    /// \return True if the key is pressed, false otherwise
+    ///
+    /// \see wasKeyPressed, wasKeyReleased
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isKeyPressed(Keyboard::Key key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a key went down during the last frame
+    ///
+    /// A key pressed and released within the same frame is
+    /// reported by both wasKeyPressed and wasKeyReleased.
+    /// Key repeats don't count as new presses.
+    ///
+    /// \param key Key to check
+    ///
+    /// \return True if the key was pressed since the previous update
+    ///
+    /// \see isKeyPressed, wasKeyReleased
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wasKeyPressed(Keyboard::Key key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a key went up during the last frame
+    ///
+    /// \param key Key to check
+    ///
+    /// \return True if the key was released since the previous update
+    ///
+    /// \see isKeyPressed, wasKeyPressed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wasKeyReleased(Keyboard::Key key) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a mouse button is held down
+    ///
+    /// \param button Button to check
+    ///
+    /// \return True if the button is pressed, false otherwise
+    ///
+    /// \see wasMouseButtonPressed, wasMouseButtonReleased
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isMouseButtonPressed(Mouse::Button button) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a mouse button went down during the last frame
+    ///
+    /// \param button Button to check
+    ///
+    /// \return True if the button was pressed since the previous update
+    ///
+    /// \see isMouseButtonPressed, wasMouseButtonReleased
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wasMouseButtonPressed(Mouse::Button button) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a mouse button went up during the last frame
+    ///
+    /// \param button Button to check
+    ///
+    /// \return True if the button was released since the previous update
+    ///
+    /// \see isMouseButtonPressed, wasMouseButtonPressed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wasMouseButtonReleased(Mouse::Button button) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of the mouse cursor
+    ///
+    /// The position is the last one reported by the events,
+    /// relative to the window.
+    ///
+    /// \return Position of the mouse cursor, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2i getMousePosition() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the motion of the mouse cursor during the last frame
+    ///
+    /// \return Difference between the current mouse position and
+    ///         the one of the previous update, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2i getMouseDelta() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the mouse cursor is inside the window
+    ///
+    /// \return True if the cursor is inside the window
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isMouseInside() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the motion of a mouse wheel during the last frame
+    ///
+    /// \param wheel Wheel to check
+    ///
+    /// \return Sum of the wheel offsets since the previous update
+    ///         (positive is up/left, negative is down/right)
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMouseWheelDelta(Mouse::Wheel wheel = Mouse::VerticalWheel) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a joystick is connected
+    ///
+    /// \param joystick Index of the joystick to check
+    ///
+    /// \return True if the joystick was connected at the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isJoystickConnected(unsigned int joystick) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a joystick button is held down
+    ///
+    /// \param joystick Index of the joystick
+    /// \param button   Button to check
+    ///
+    /// \return True if the button is pressed, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isJoystickButtonPressed(unsigned int joystick, unsigned int button) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if a joystick button went down since the previous update
+    ///
+    /// Joystick buttons are sampled at every update, so a
+    /// button pressed and released in between is missed.
+    ///
+    /// \param joystick Index of the joystick
+    /// \param button   Button to check
+    ///
+    /// \return True if the button was pressed during the last frame
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wasJoystickButtonPressed(unsigned int joystick, unsigned int button) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a joystick axis
+    ///
+    /// \param joystick Index of the joystick
+    /// \param axis     Axis to check
+    ///
+    /// \return Position of the axis, in range [-100 .. 100]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getJoystickAxisPosition(unsigned int joystick, Joystick::Axis axis) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the devices, as seen by one frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct State
+    {
+        bool     keys[Keyboard::KeyCount];                                ///< Keys held down
+        bool     keysPressed[Keyboard::KeyCount];                         ///< Keys which went down during the frame
+        bool     keysReleased[Keyboard::KeyCount];                        ///< Keys which went up during the frame
+        bool     buttons[Mouse::ButtonCount];                             ///< Mouse buttons held down
+        bool     buttonsPressed[Mouse::ButtonCount];                      ///< Mouse buttons which went down during the frame
+        bool     buttonsReleased[Mouse::ButtonCount];                     ///< Mouse buttons which went up during the frame
+        Vector2i mousePosition;                                           ///< Last position of the mouse cursor
+        bool     mouseInside;                                             ///< Is the mouse cursor inside the window?
+        float    wheelDeltas[2];                                          ///< Accumulated offsets of the vertical and horizontal wheels
+        bool     joysticks[Joystick::Count];                              ///< Connected joysticks
+        bool     joystickButtons[Joystick::Count][Joystick::ButtonCount]; ///< Joystick buttons held down
+        float    joystickAxes[Joystick::Count][Joystick::AxisCount];      ///< Positions of the joystick axes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the per-frame transitions of the pending state
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearTransitions();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    State    m_pending;                                                         ///< State being recorded from the events
+    State    m_current;                                                         ///< State published by the last update
+    Vector2i m_previousMousePosition;                                           ///< Mouse position published by the update before the last one
+    bool     m_previousJoystickButtons[Joystick::Count][Joystick::ButtonCount]; ///< Joystick buttons published by the update before the last one
+};
+
+} // namespace sf
+
+
+#endif // SFML_INPUTSNAPSHOT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::InputSnapshot
+/// \ingroup window
+///
+/// sf::Keyboard, sf::Mouse and sf::Joystick query the operating
+/// system every time they are called, which is expensive on
+/// some platforms: on X11 every key check is a round trip to
+/// the display server. Games which check many keys per frame
+/// should rather use sf::InputSnapshot.
+///
+/// The snapshot is fed with the events of the window, which
+/// the operating system sends anyway, and answers all the
+/// queries from memory. Once per frame, update() publishes
+/// what was recorded, so that the whole frame sees the same
+/// state no matter when the queries are made. On top of the
+/// held keys and buttons, the snapshot tells which ones went
+/// down or up during the frame, how far the mouse moved and
+/// how much the wheels were scrolled.
+///
+/// Since it relies on events, a snapshot only knows about the
+/// input received by its window: keys pressed before the window
+/// got the focus are not seen as pressed until they are pressed
+/// again. Joysticks are the exception, their state being copied
+/// from sf::Joystick at every update.
+///
+/// Usage example:
+/// \code
+/// sf::InputSnapshot input;
+///
+/// while (window.isOpen())
+/// {
+///     sf::Event event;
+///     while (window.pollEvent(event))
+///         input.handleEvent(event);
+///
+///     input.update();
+///
+///     if (input.isKeyPressed(sf::Keyboard::Left))
+///         player.move(-speed, 0);
+///     if (input.wasKeyPressed(sf::Keyboard::Space))
+///         player.jump();
+///     if (input.wasMouseButtonPressed(sf::Mouse::Left))
+///         shoot(input.getMousePosition());
+/// }
+/// \endcode
+///
+/// \see sf::Keyboard, sf::Mouse, sf::Joystick, sf::Event
+///
+////////////////////////////////////////////////////////////
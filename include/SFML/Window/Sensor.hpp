@@ -31,6 +31,7 @@
 #include <SFML/Window/Export.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -59,6 +60,16 @@ public:
         Count             ///< Keep last -- the total number of sensor types
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Single timestamped reading of a sensor
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Sample
+    {
+        Vector3f value;     ///< Value of the sensor
+        Time     timestamp; ///< Time at which the value was measured
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a sensor is available on the underlying platform
     ///
@@ -93,6 +104,51 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getValue(Type sensor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the rate at which a sensor is sampled
+    ///
+    /// \a period is the requested time between two readings, the
+    /// system may clamp it to what the hardware supports. A period
+    /// of zero uses the fastest rate available.
+    ///
+    /// \a maxReportLatency allows the hardware to batch readings in
+    /// its FIFO and deliver them together, at most this long after
+    /// they were measured. Batching keeps high sampling rates cheap
+    /// in battery power; the readings keep their own timestamps and
+    /// can be retrieved with getSamples.
+    ///
+    /// Platforms that don't support these settings ignore them.
+    ///
+    /// \param sensor           Sensor to configure
+    /// \param period           Requested time between two readings
+    /// \param maxReportLatency Maximum time readings may be batched
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSamplingPeriod(Type sensor, Time period, Time maxReportLatency = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the readings of a sensor received since the last call
+    ///
+    /// Readings are gathered whenever the events of a window are
+    /// processed, every one of them is kept even though at most
+    /// one SensorChanged event is generated per sensor and per
+    /// update. They are returned oldest first and removed from
+    /// the buffer; if more than \a maxCount are pending, the
+    /// remaining ones are returned by the next call. A limited
+    /// number of readings is buffered, the oldest are dropped
+    /// when they are not retrieved in time.
+    ///
+    /// Timestamps are only meaningful relative to each other.
+    ///
+    /// \param sensor   Sensor to read
+    /// \param samples  Array to fill with the readings
+    /// \param maxCount Size of the \a samples array
+    ///
+    /// \return Number of readings written to \a samples
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getSamples(Type sensor, Sample* samples, std::size_t maxCount);
 };
 
 } // namespace sf
@@ -147,4 +203,15 @@ public:
 /// sf::Vector3f gravity = sf::Sensor::getValue(sf::Sensor::Gravity);
 /// \endcode
 ///
+/// Applications that need every reading of a fast sensor can
+/// raise its sampling rate and read the buffered samples in bulk:
+/// \code
+/// // sample the gyroscope at 200 Hz, letting the hardware batch up to 50 ms
+/// sf::Sensor::setSamplingPeriod(sf::Sensor::Gyroscope, sf::milliseconds(5), sf::milliseconds(50));
+///
+/// // ... after processing the window events
+/// sf::Sensor::Sample samples[64];
+/// std::size_t count = sf::Sensor::getSamples(sf::Sensor::Gyroscope, samples, 64);
+/// \endcode
+///
 ////////////////////////////////////////////////////////////
@@ -39,12 +39,14 @@
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
 {
 namespace priv
 {
+    class FramePacer;
     class GlContext;
     class WindowImpl;
 }
@@ -211,6 +213,38 @@ public:
     ////////////////////////////////////////////////////////////
     bool pollEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop several events from the event queue at once
+    ///
+    /// This function is not blocking: it returns the events that
+    /// are pending, up to \a maxCount, and 0 if there's none.
+    /// Retrieving events in batches is cheaper than calling
+    /// pollEvent for each of them when the window receives a
+    /// lot of input, such as touches, sensors or raw mouse
+    /// motions. If the function returns \a maxCount, more events
+    /// may be pending.
+    /// \code
+    /// sf::Event events[64];
+    /// std::size_t count;
+    /// while ((count = window.pollEvents(events, 64)) > 0)
+    /// {
+    ///    for (std::size_t i = 0; i < count; ++i)
+    ///    {
+    ///        // process events[i]...
+    ///    }
+    /// }
+    /// \endcode
+    ///
+    /// \param events   Array to fill with the events, must have room for \a maxCount events
+    /// \param maxCount Maximum number of events to return
+    ///
+    /// \return Number of events written to \a events
+    ///
+    /// \see pollEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pollEvents(Event* events, std::size_t maxCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Wait for an event and return it
     ///
@@ -238,6 +272,39 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an event for a limited time and return it
+    ///
+    /// This function is blocking: if there's no pending event then
+    /// it will wait until an event is received or \a timeout has
+    /// elapsed. It is typically used by applications that only
+    /// need to redraw on user input, but still have periodic work
+    /// to do, like blinking a cursor.
+    /// \code
+    /// sf::Event event;
+    /// if (window.waitEvent(event, sf::milliseconds(500)))
+    /// {
+    ///    // process event...
+    /// }
+    /// else
+    /// {
+    ///    // timeout elapsed, blink the cursor...
+    /// }
+    /// \endcode
+    ///
+    /// A zero or negative \a timeout makes this function behave
+    /// like pollEvent.
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait for an event
+    ///
+    /// \return True if an event was returned, false if the timeout elapsed
+    ///
+    /// \see pollEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -336,9 +403,36 @@ public:
     ///
     /// \param enabled True to enable v-sync, false to deactivate it
     ///
+    /// \see setSwapInterval
+    ///
     ////////////////////////////////////////////////////////////
     void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between frames
+    ///
+    /// An interval of 1 is equivalent to setVerticalSyncEnabled(true),
+    /// 0 disables vertical synchronization and larger values
+    /// divide the framerate (2 gives 30 FPS on a 60 Hz monitor).
+    ///
+    /// A negative interval enables adaptive vertical sync: frames
+    /// that are ready in time wait for the vertical blank, but a
+    /// late frame is displayed immediately. This produces a bit of
+    /// tearing instead of dropping to half the refresh rate when
+    /// a frame occasionally takes too long. If the driver doesn't
+    /// support adaptive vertical sync, the absolute value of the
+    /// interval is used instead.
+    ///
+    /// Intervals other than 0 and 1 are only supported with GLX
+    /// and WGL, other platforms treat any non-zero value as 1.
+    ///
+    /// \param interval Swap interval
+    ///
+    /// \see setVerticalSyncEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSwapInterval(int interval);
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the mouse cursor
     ///
@@ -381,6 +475,29 @@ public:
     ////////////////////////////////////////////////////////////
     void setMouseCursor(const Cursor& cursor);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable raw mouse input
+    ///
+    /// When enabled, the window generates Event::MouseMovedRaw
+    /// events containing the relative motion reported by the
+    /// mouse, before the operating system applies its pointer
+    /// acceleration. Unlike Event::MouseMoved, these events are not
+    /// limited by the borders of the window or screen, which makes
+    /// them suitable to control a camera. Consecutive raw motions
+    /// that haven't been polled yet are merged into a single event.
+    ///
+    /// Raw mouse input is implemented with XInput2 on X11
+    /// platforms and WM_INPUT on Windows, it is not supported
+    /// elsewhere. Events are only generated while the window
+    /// has focus.
+    ///
+    /// Raw mouse input is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRawMouseInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -401,17 +518,33 @@ public:
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// Frames are scheduled against absolute deadlines, and the
+    /// end of each delay is spent actively waiting rather than
+    /// sleeping, so that the imprecision of the OS scheduler
+    /// doesn't accumulate from one frame to the next. This keeps
+    /// a CPU core busy for a fraction of a millisecond per frame.
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
+    /// \see getFrameTimeJitter
+    ///
     ////////////////////////////////////////////////////////////
     void setFramerateLimit(unsigned int limit);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the measured frame time jitter
+    ///
+    /// The jitter is a smoothed average of how much the duration
+    /// of each frame differs from the one requested with
+    /// setFramerateLimit. It is zero if no limit is set.
+    ///
+    /// \return Average deviation of the frame durations
+    ///
+    /// \see setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTimeJitter() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the joystick threshold
     ///
@@ -425,6 +558,30 @@ public:
     ////////////////////////////////////////////////////////////
     void setJoystickThreshold(float threshold);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Sample the joysticks and sensors in a dedicated thread
+    ///
+    /// Joysticks and sensors are normally read when events are
+    /// polled, so their events are only as precise as the frame
+    /// rate. While the input thread runs, they are sampled \a rate
+    /// times per second and their events are queued, with the
+    /// time of the sample as timestamp, until pollEvent or
+    /// waitEvent returns them.
+    ///
+    /// The events of the operating system are still processed
+    /// by pollEvent and waitEvent, in the thread of the window.
+    ///
+    /// The input thread also updates the state returned by
+    /// sf::Joystick and sf::Sensor, which is not synchronized
+    /// with other threads: rely on the events while it runs.
+    ///
+    /// The input thread is stopped by default.
+    ///
+    /// \param rate Number of samples per second, 0 to stop the thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInputThreadRate(unsigned int rate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the window as the current target
     ///        for OpenGL rendering
@@ -479,9 +636,56 @@ public:
     /// has been done for the current frame, in order to show
     /// it on screen.
     ///
+    /// The frame is presented by onDisplay(), so derived classes
+    /// such as sf::RenderWindow finish their frame even when it
+    /// is displayed through a reference to sf::Window.
+    ///
     ////////////////////////////////////////////////////////////
     void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// The age is the number of frames displayed since the
+    /// contents of the buffer being rendered to were displayed:
+    /// with an age of 1 it still holds the previous frame, with
+    /// an age of 2 the frame before, and so on. Only the areas
+    /// that changed since then have to be drawn again.
+    ///
+    /// 0 means that the contents are undefined and the whole
+    /// frame must be drawn. This is always the case when the
+    /// driver doesn't support GLX_EXT_buffer_age or
+    /// EGL_EXT_buffer_age.
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBackBufferAge() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the display starts showing a new frame
+    ///
+    /// Calling this function right after display() wakes the
+    /// program at the vertical blank, at the start of the time
+    /// budget of the next frame. The events polled and the
+    /// frame rendered afterwards are then as recent as possible,
+    /// and the driver can't queue several frames ahead of the
+    /// display, which removes one or two frames of input lag.
+    ///
+    /// The vertical blanks are reported by GLX_OML_sync_control
+    /// on Linux, the desktop compositor on Windows, CVDisplayLink
+    /// on macOS and AChoreographer on Android. If none of them
+    /// is available, the function returns false immediately:
+    /// use it together with setVerticalSyncEnabled or
+    /// setFramerateLimit, not instead of them.
+    ///
+    /// \return True if the function waited for a vertical blank
+    ///
+    /// \see display
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitForVerticalBlank();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -517,6 +721,32 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onResize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by display() to present the frame
+    ///
+    /// This function is called so that derived classes can
+    /// complete the frame before it is shown. The default
+    /// implementation displays the whole back buffer and
+    /// limits the framerate; overrides call it, or present
+    /// the frame with displayDamage() instead.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onDisplay();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display the window, telling which areas of it changed
+    ///
+    /// This function does the same as Window::onDisplay(), and passes
+    /// the changed areas to EGL_KHR_swap_buffers_with_damage
+    /// when it is available, so that the compositor only
+    /// updates those parts of the screen.
+    ///
+    /// \param rects Changed areas, as (x, y, width, height) quadruples in pixels from the bottom-left corner
+    /// \param count Number of areas
+    ///
+    ////////////////////////////////////////////////////////////
+    void displayDamage(const int* rects, std::size_t count);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -544,8 +774,7 @@ private:
     ////////////////////////////////////////////////////////////
     priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
     priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
+    priv::FramePacer* m_framePacer;     ///< Frame pacer, created when a framerate limit is set
     Vector2u          m_size;           ///< Current size of the window
 };
 
@@ -43,6 +43,8 @@ namespace Style
         Close      = 1 << 2, ///< Title bar + close button
         Fullscreen = 1 << 3, ///< Fullscreen mode (this flag and all others are mutually exclusive)
 
+        EventThread = 1 << 4, ///< Pump the system events in a dedicated thread, so that the window keeps rendering while it is moved or resized (Windows only, can be combined with any other flag)
+
         Default = Titlebar | Resize | Close ///< Default window style
     };
 }
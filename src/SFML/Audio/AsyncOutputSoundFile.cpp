@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/AsyncOutputSoundFile.hpp>
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Smallest power of two not less than the requested capacity, within the range of the counters
+    std::size_t queueSize(std::size_t capacity)
+    {
+        std::size_t size = 1;
+        while ((size < capacity) && (size < (1u << 31)))
+            size <<= 1;
+
+        return size;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AsyncOutputSoundFile::AsyncOutputSoundFile() :
+m_file        (NULL),
+m_thread      (&AsyncOutputSoundFile::encode, this),
+m_pending     (),
+m_flushed     (),
+m_ring        (),
+m_block       (),
+m_channelCount(0),
+m_write       (0),
+m_read        (0),
+m_dropped     (0),
+m_flushing    (false),
+m_closing     (false)
+{
+    m_thread.setName("sfml-sound-encoder");
+    m_thread.setPriority(Thread::Low);
+}
+
+
+////////////////////////////////////////////////////////////
+AsyncOutputSoundFile::~AsyncOutputSoundFile()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool AsyncOutputSoundFile::openFromFile(const std::string& filename, unsigned int sampleRate, unsigned int channelCount, std::size_t capacity)
+{
+    // If the file is already open, first close it
+    close();
+
+    m_file = new OutputSoundFile;
+    if (!m_file->openFromFile(filename, sampleRate, channelCount))
+    {
+        delete m_file;
+        m_file = NULL;
+        return false;
+    }
+
+    if (capacity == 0)
+        capacity = static_cast<std::size_t>(sampleRate) * channelCount;
+
+    m_ring.assign(queueSize(std::max<std::size_t>(capacity, channelCount)), 0);
+    m_channelCount = channelCount;
+    m_write.store(0);
+    m_read.store(0);
+    m_dropped.store(0);
+    m_flushing.store(false);
+    m_closing.store(false);
+
+    m_thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AsyncOutputSoundFile::write(const Int16* samples, std::size_t count)
+{
+    if (!m_file || !samples || !count)
+        return 0;
+
+    // Only the producer writes m_write, a relaxed read is enough
+    Uint32 write = m_write.load(Memory::Relaxed);
+    Uint32 read = m_read.load(Memory::Acquire);
+
+    // Queue whole frames only, so that the channels stay in order after a drop
+    std::size_t size = m_ring.size();
+    std::size_t queued = std::min(count, size - static_cast<std::size_t>(write - read));
+    queued -= queued % m_channelCount;
+
+    if (queued < count)
+        m_dropped.fetchAdd(count - queued);
+
+    if (queued == 0)
+        return 0;
+
+    // Copy in at most two parts, around the end of the ring
+    std::size_t start = write & (size - 1);
+    std::size_t first = std::min(queued, size - start);
+    std::memcpy(&m_ring[start], samples, first * sizeof(Int16));
+    if (queued > first)
+        std::memcpy(&m_ring[0], samples + first, (queued - first) * sizeof(Int16));
+
+    m_write.store(write + static_cast<Uint32>(queued), Memory::Release);
+    m_pending.post();
+
+    return queued;
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::flush()
+{
+    if (!m_file)
+        return;
+
+    m_flushing.store(true, Memory::Release);
+    m_pending.post();
+    m_flushed.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::close()
+{
+    if (!m_file)
+        return;
+
+    // Let the encoder thread write what's left, then finalize the file
+    m_closing.store(true, Memory::Release);
+    m_pending.post();
+    m_thread.wait();
+
+    delete m_file;
+    m_file = NULL;
+
+    // Free the memory of the queue
+    std::vector<Int16>().swap(m_ring);
+    std::vector<Int16>().swap(m_block);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AsyncOutputSoundFile::getFreeCount() const
+{
+    return m_ring.size() - getQueuedCount();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t AsyncOutputSoundFile::getQueuedCount() const
+{
+    Uint32 read = m_read.load(Memory::Acquire);
+    Uint32 write = m_write.load(Memory::Acquire);
+
+    return static_cast<std::size_t>(write - read);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 AsyncOutputSoundFile::getDroppedCount() const
+{
+    return m_dropped.load(Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::encode()
+{
+    for (;;)
+    {
+        m_pending.wait();
+
+        // Read the requests before draining: the samples queued before them are then all visible
+        bool closing = m_closing.load(Memory::Acquire);
+        bool flushing = m_flushing.exchange(false);
+
+        drain();
+
+        if (flushing)
+            m_flushed.post();
+
+        if (closing)
+            return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AsyncOutputSoundFile::drain()
+{
+    SFML_PROFILE_SCOPE("AsyncOutputSoundFile::drain");
+
+    Uint32 read = m_read.load(Memory::Relaxed);
+    Uint32 write = m_write.load(Memory::Acquire);
+
+    std::size_t count = static_cast<std::size_t>(write - read);
+    if (count == 0)
+        return;
+
+    // Copy out in one contiguous block, writers expect whole frames
+    std::size_t size = m_ring.size();
+    std::size_t start = read & (size - 1);
+    std::size_t first = std::min(count, size - start);
+    m_block.resize(count);
+    std::memcpy(&m_block[0], &m_ring[start], first * sizeof(Int16));
+    if (count > first)
+        std::memcpy(&m_block[first], &m_ring[0], (count - first) * sizeof(Int16));
+
+    // Release the space before the slow part, so that the producer can reuse it
+    m_read.store(read + static_cast<Uint32>(count), Memory::Release);
+
+    m_file->write(&m_block[0], count);
+}
+
+} // namespace sf
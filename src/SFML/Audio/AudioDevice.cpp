@@ -28,19 +28,127 @@
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/Audio/Listener.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <cstring>
 #include <memory>
 
+// ALC_SOFT_HRTF, ALC_SOFT_device_clock and ALC_SOFT_reopen_device are more recent than our OpenAL headers
+#ifndef ALC_HRTF_SOFT
+    #define ALC_HRTF_SOFT 0x1992
+#endif
+
+#ifndef ALC_DEVICE_CLOCK_SOFT
+    #define ALC_DEVICE_CLOCK_SOFT 0x1600
+#endif
+
+#ifndef ALC_DEVICE_LATENCY_SOFT
+    #define ALC_DEVICE_LATENCY_SOFT 0x1601
+#endif
+
 
 namespace
 {
+    typedef ALCboolean (ALC_APIENTRY *ResetDeviceFunction)(ALCdevice*, const ALCint*);
+    typedef ALCboolean (ALC_APIENTRY *ReopenDeviceFunction)(ALCdevice*, const ALCchar*, const ALCint*);
+    typedef void (ALC_APIENTRY *GetInteger64Function)(ALCdevice*, ALCenum, ALCsizei, sf::Int64*);
+    typedef void (AL_APIENTRY *UpdatesFunction)();
+    typedef void (AL_APIENTRY *PlayAtTimeFunction)(ALuint, sf::Int64);
+
     ALCdevice*  audioDevice  = NULL;
     ALCcontext* audioContext = NULL;
 
+    std::string                  deviceName;
+    sf::PlaybackDevice::Settings deviceSettings;
+
+    // AL_SOFT_deferred_updates entry points, null if the extension is not supported
+    UpdatesFunction deferUpdatesFunction   = NULL;
+    UpdatesFunction processUpdatesFunction = NULL;
+    unsigned int    deferredUpdatesDepth   = 0;
+
+    bool sampleRateConversion = false;
+
+    // Audio clock used when the device has none
+    sf::Clock systemClock;
+
+    // Statistics, sources are created and streams are updated on several threads
+    sf::Mutex               sourceMutex;
+    std::set<unsigned int>  registeredSources;
+    sf::Atomic<sf::Uint64>  streamUnderruns(0);
+    sf::Atomic<sf::Int64>   streamDecodeTime(0);
+
     float        listenerVolume = 100.f;
     sf::Vector3f listenerPosition (0.f, 0.f, 0.f);
     sf::Vector3f listenerDirection(0.f, 0.f, -1.f);
     sf::Vector3f listenerUpVector (0.f, 1.f, 0.f);
+
+    // Build the zero-terminated ALC attribute list of the requested settings
+    std::vector<ALCint> getDeviceAttributes()
+    {
+        std::vector<ALCint> attributes;
+
+        if (deviceSettings.frequency > 0)
+        {
+            attributes.push_back(ALC_FREQUENCY);
+            attributes.push_back(static_cast<ALCint>(deviceSettings.frequency));
+        }
+
+        if (deviceSettings.refreshRate > 0)
+        {
+            attributes.push_back(ALC_REFRESH);
+            attributes.push_back(static_cast<ALCint>(deviceSettings.refreshRate));
+        }
+
+        if (deviceSettings.monoSources > 0)
+        {
+            attributes.push_back(ALC_MONO_SOURCES);
+            attributes.push_back(static_cast<ALCint>(deviceSettings.monoSources));
+        }
+
+        if (deviceSettings.stereoSources > 0)
+        {
+            attributes.push_back(ALC_STEREO_SOURCES);
+            attributes.push_back(static_cast<ALCint>(deviceSettings.stereoSources));
+        }
+
+        if ((deviceSettings.hrtf != sf::PlaybackDevice::Settings::Default) && audioDevice && alcIsExtensionPresent(audioDevice, "ALC_SOFT_HRTF"))
+        {
+            attributes.push_back(ALC_HRTF_SOFT);
+            attributes.push_back(deviceSettings.hrtf == sf::PlaybackDevice::Settings::Enabled ? ALC_TRUE : ALC_FALSE);
+        }
+
+        attributes.push_back(0);
+        return attributes;
+    }
+
+    // Stop applying the changes made to the current context
+    void suspendContext()
+    {
+        if (deferUpdatesFunction)
+            deferUpdatesFunction();
+        else
+            alcSuspendContext(audioContext);
+    }
+
+    // Apply the changes made to the current context since it was suspended
+    void resumeContext()
+    {
+        if (processUpdatesFunction)
+            processUpdatesFunction();
+        else
+            alcProcessContext(audioContext);
+    }
+
+    // Query a single ALC integer of the open device
+    ALCint getDeviceInteger(ALCenum parameter)
+    {
+        ALCint value = 0;
+        alcGetIntegerv(audioDevice, parameter, 1, &value);
+        return value;
+    }
 }
 
 namespace sf
@@ -51,12 +159,13 @@ namespace priv
 AudioDevice::AudioDevice()
 {
     // Create the device
-    audioDevice = alcOpenDevice(NULL);
+    audioDevice = alcOpenDevice(deviceName.empty() ? NULL : deviceName.c_str());
 
     if (audioDevice)
     {
-        // Create the context
-        audioContext = alcCreateContext(audioDevice, NULL);
+        // Create the context, with the requested settings
+        std::vector<ALCint> attributes = getDeviceAttributes();
+        audioContext = alcCreateContext(audioDevice, &attributes[0]);
 
         if (audioContext)
         {
@@ -73,6 +182,17 @@ AudioDevice::AudioDevice()
             alCheck(alListenerf(AL_GAIN, listenerVolume * 0.01f));
             alCheck(alListener3f(AL_POSITION, listenerPosition.x, listenerPosition.y, listenerPosition.z));
             alCheck(alListenerfv(AL_ORIENTATION, orientation));
+
+            // Batching changes without the extension suspends the whole context instead
+            if (alIsExtensionPresent("AL_SOFT_deferred_updates"))
+            {
+                deferUpdatesFunction = reinterpret_cast<UpdatesFunction>(alGetProcAddress("alDeferUpdatesSOFT"));
+                processUpdatesFunction = reinterpret_cast<UpdatesFunction>(alGetProcAddress("alProcessUpdatesSOFT"));
+            }
+
+            // Keep batching if the device was recreated in the middle of a batch
+            if (deferredUpdatesDepth > 0)
+                suspendContext();
         }
         else
         {
@@ -97,6 +217,11 @@ AudioDevice::~AudioDevice()
     // Destroy the device
     if (audioDevice)
         alcCloseDevice(audioDevice);
+
+    audioContext = NULL;
+    audioDevice = NULL;
+    deferUpdatesFunction = NULL;
+    processUpdatesFunction = NULL;
 }
 
 
@@ -150,6 +275,292 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
 }
 
 
+////////////////////////////////////////////////////////////
+int AudioDevice::getFloatFormatFromChannelCount(unsigned int channelCount)
+{
+    // Create a temporary audio device in case none exists yet.
+    // This device will not be used in this function and merely
+    // makes sure there is a valid OpenAL device for format
+    // queries if none has been created yet.
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!isExtensionSupported("AL_EXT_FLOAT32"))
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1:  format = alGetEnumValue("AL_FORMAT_MONO_FLOAT32");   break;
+        case 2:  format = alGetEnumValue("AL_FORMAT_STEREO_FLOAT32"); break;
+        case 4:  format = alGetEnumValue("AL_FORMAT_QUAD32");         break;
+        case 6:  format = alGetEnumValue("AL_FORMAT_51CHN32");        break;
+        case 7:  format = alGetEnumValue("AL_FORMAT_61CHN32");        break;
+        case 8:  format = alGetEnumValue("AL_FORMAT_71CHN32");        break;
+        default: format = 0;                                          break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
+////////////////////////////////////////////////////////////
+int AudioDevice::getIma4FormatFromChannelCount(unsigned int channelCount)
+{
+    // Create a temporary audio device in case none exists yet.
+    // This device will not be used in this function and merely
+    // makes sure there is a valid OpenAL device for format
+    // queries if none has been created yet.
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!isExtensionSupported("AL_EXT_IMA4"))
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1:  format = alGetEnumValue("AL_FORMAT_MONO_IMA4");   break;
+        case 2:  format = alGetEnumValue("AL_FORMAT_STEREO_IMA4"); break;
+        default: format = 0;                                       break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<std::string> AudioDevice::getAvailableDevices()
+{
+    std::vector<std::string> deviceNameList;
+
+    // ALC_ENUMERATE_ALL_EXT lists every output, not just one per driver
+    bool enumerateAll = alcIsExtensionPresent(NULL, "ALC_ENUMERATE_ALL_EXT") != AL_FALSE;
+    const ALCchar* deviceList = alcGetString(NULL, enumerateAll ? ALC_ALL_DEVICES_SPECIFIER : ALC_DEVICE_SPECIFIER);
+    if (deviceList)
+    {
+        while (*deviceList)
+        {
+            deviceNameList.push_back(deviceList);
+            deviceList += std::strlen(deviceList) + 1;
+        }
+    }
+
+    return deviceNameList;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string AudioDevice::getDefaultDevice()
+{
+    bool enumerateAll = alcIsExtensionPresent(NULL, "ALC_ENUMERATE_ALL_EXT") != AL_FALSE;
+    const ALCchar* name = alcGetString(NULL, enumerateAll ? ALC_DEFAULT_ALL_DEVICES_SPECIFIER : ALC_DEFAULT_DEVICE_SPECIFIER);
+
+    return name ? name : "";
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::setDevice(const std::string& name)
+{
+    deviceName = name;
+
+    if (!audioDevice)
+        return true;
+
+    // Move the open device to the new output without losing the sources and buffers
+    ReopenDeviceFunction reopenDevice = NULL;
+    if (alcIsExtensionPresent(audioDevice, "ALC_SOFT_reopen_device"))
+        reopenDevice = reinterpret_cast<ReopenDeviceFunction>(alcGetProcAddress(audioDevice, "alcReopenDeviceSOFT"));
+
+    if (!reopenDevice)
+    {
+        err() << "The audio device will only change once it is reopened (ALC_SOFT_reopen_device is not supported)" << std::endl;
+        return true;
+    }
+
+    std::vector<ALCint> attributes = getDeviceAttributes();
+    if (!reopenDevice(audioDevice, name.empty() ? NULL : name.c_str(), &attributes[0]))
+    {
+        err() << "Failed to switch to the audio device \"" << name << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& AudioDevice::getDevice()
+{
+    return deviceName;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::setSettings(const PlaybackDevice::Settings& settings)
+{
+    deviceSettings = settings;
+
+    if (!audioDevice)
+        return true;
+
+    // Reset the open device with the new attributes
+    ResetDeviceFunction resetDevice = NULL;
+    if (alcIsExtensionPresent(audioDevice, "ALC_SOFT_HRTF"))
+        resetDevice = reinterpret_cast<ResetDeviceFunction>(alcGetProcAddress(audioDevice, "alcResetDeviceSOFT"));
+
+    if (!resetDevice)
+    {
+        err() << "The audio device settings will only change once it is reopened (ALC_SOFT_HRTF is not supported)" << std::endl;
+        return true;
+    }
+
+    std::vector<ALCint> attributes = getDeviceAttributes();
+    if (!resetDevice(audioDevice, &attributes[0]))
+    {
+        err() << "Failed to apply the audio device settings" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+PlaybackDevice::Settings AudioDevice::getSettings()
+{
+    if (!audioDevice)
+        return deviceSettings;
+
+    PlaybackDevice::Settings settings;
+    settings.frequency     = static_cast<unsigned int>(getDeviceInteger(ALC_FREQUENCY));
+    settings.refreshRate   = static_cast<unsigned int>(getDeviceInteger(ALC_REFRESH));
+    settings.monoSources   = static_cast<unsigned int>(getDeviceInteger(ALC_MONO_SOURCES));
+    settings.stereoSources = static_cast<unsigned int>(getDeviceInteger(ALC_STEREO_SOURCES));
+
+    if (alcIsExtensionPresent(audioDevice, "ALC_SOFT_HRTF"))
+        settings.hrtf = getDeviceInteger(ALC_HRTF_SOFT) ? PlaybackDevice::Settings::Enabled : PlaybackDevice::Settings::Disabled;
+    else
+        settings.hrtf = deviceSettings.hrtf;
+
+    return settings;
+}
+
+
+////////////////////////////////////////////////////////////
+Time AudioDevice::getLatency()
+{
+    // Create a temporary audio device in case none exists yet.
+    // This device will not be used in this function and merely
+    // makes sure there is a valid OpenAL device for latency
+    // queries if none has been created yet.
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!audioDevice)
+        return Time::Zero;
+
+    // The driver knows the latency of the whole output chain
+    GetInteger64Function getInteger64 = NULL;
+    if (alcIsExtensionPresent(audioDevice, "ALC_SOFT_device_clock"))
+        getInteger64 = reinterpret_cast<GetInteger64Function>(alcGetProcAddress(audioDevice, "alcGetInteger64vSOFT"));
+
+    if (getInteger64)
+    {
+        Int64 nanoseconds = 0;
+        getInteger64(audioDevice, ALC_DEVICE_LATENCY_SOFT, 1, &nanoseconds);
+        return microseconds(nanoseconds / 1000);
+    }
+
+    // Otherwise, a sample waits at most one mixing update before being mixed
+    ALCint refreshRate = getDeviceInteger(ALC_REFRESH);
+    return refreshRate > 0 ? microseconds(1000000 / refreshRate) : Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+Time AudioDevice::getClockTime()
+{
+    // The device clock counts the samples mixed, it is the reference for scheduled starts
+    if (audioDevice && alcIsExtensionPresent(audioDevice, "ALC_SOFT_device_clock"))
+    {
+        GetInteger64Function getInteger64 = reinterpret_cast<GetInteger64Function>(alcGetProcAddress(audioDevice, "alcGetInteger64vSOFT"));
+        if (getInteger64)
+        {
+            Int64 nanoseconds = 0;
+            getInteger64(audioDevice, ALC_DEVICE_CLOCK_SOFT, 1, &nanoseconds);
+            return microseconds(nanoseconds / 1000);
+        }
+    }
+
+    return systemClock.getElapsedTime();
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::playSourceAt(unsigned int source, Time time)
+{
+    // The delayed start needs the device clock, to which its time refers
+    if (!audioDevice || !audioContext || !alcIsExtensionPresent(audioDevice, "ALC_SOFT_device_clock") || !alIsExtensionPresent("AL_SOFT_source_start_delay"))
+        return false;
+
+    PlayAtTimeFunction playAtTime = reinterpret_cast<PlayAtTimeFunction>(alGetProcAddress("alSourcePlayAtTimeSOFT"));
+    if (!playAtTime)
+        return false;
+
+    alCheck(playAtTime(source, time.asMicroseconds() * 1000));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::setSampleRateConversion(bool enabled)
+{
+    sampleRateConversion = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool AudioDevice::isSampleRateConversionEnabled()
+{
+    return sampleRateConversion;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AudioDevice::getOutputSampleRate(unsigned int sampleRate)
+{
+    if (!sampleRateConversion)
+        return sampleRate;
+
+    // Create a temporary audio device in case none exists yet.
+    // This device will not be used in this function and merely
+    // makes sure there is a valid OpenAL device for frequency
+    // queries if none has been created yet.
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    ALCint frequency = audioDevice ? getDeviceInteger(ALC_FREQUENCY) : 0;
+
+    return frequency > 0 ? static_cast<unsigned int>(frequency) : sampleRate;
+}
+
+
 ////////////////////////////////////////////////////////////
 void AudioDevice::setGlobalVolume(float volume)
 {
@@ -223,6 +634,85 @@ Vector3f AudioDevice::getUpVector()
     return listenerUpVector;
 }
 
+
+////////////////////////////////////////////////////////////
+void AudioDevice::deferUpdates()
+{
+    if ((deferredUpdatesDepth++ == 0) && audioContext)
+        suspendContext();
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::processUpdates()
+{
+    if (deferredUpdatesDepth == 0)
+        return;
+
+    if ((--deferredUpdatesDepth == 0) && audioContext)
+        resumeContext();
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::registerSource(unsigned int source)
+{
+    Lock lock(sourceMutex);
+    registeredSources.insert(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::unregisterSource(unsigned int source)
+{
+    Lock lock(sourceMutex);
+    registeredSources.erase(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::reportUnderrun()
+{
+    streamUnderruns.fetchAdd(1, Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::reportDecodeTime(Time duration)
+{
+    streamDecodeTime.fetchAdd(duration.asMicroseconds(), Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+PlaybackDevice::Statistics AudioDevice::getStatistics()
+{
+    PlaybackDevice::Statistics statistics;
+    statistics.underruns = streamUnderruns.load(Memory::Relaxed);
+    statistics.decodeTime = microseconds(streamDecodeTime.load(Memory::Relaxed));
+
+    Lock lock(sourceMutex);
+
+    statistics.sourceCount = static_cast<unsigned int>(registeredSources.size());
+    for (std::set<unsigned int>::const_iterator it = registeredSources.begin(); it != registeredSources.end(); ++it)
+    {
+        ALint state = AL_INITIAL;
+        alCheck(alGetSourcei(*it, AL_SOURCE_STATE, &state));
+        if (state == AL_PLAYING)
+            ++statistics.activeSourceCount;
+    }
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::resetStatistics()
+{
+    streamUnderruns.store(0, Memory::Relaxed);
+    streamDecodeTime.store(0, Memory::Relaxed);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -28,9 +28,12 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Audio/PlaybackDevice.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <set>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -83,6 +86,146 @@ public:
     ////////////////////////////////////////////////////////////
     static int getFormatFromChannelCount(unsigned int channelCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL float format that matches the given number of channels
+    ///
+    /// Float formats are provided by the AL_EXT_FLOAT32 extension,
+    /// and by AL_EXT_MCFORMATS for more than two channels.
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \return Corresponding format, or 0 if it is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFloatFormatFromChannelCount(unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL IMA ADPCM format that matches the given number of channels
+    ///
+    /// IMA ADPCM formats are provided by the AL_EXT_IMA4
+    /// extension, for mono and stereo sounds only.
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \return Corresponding format, or 0 if it is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getIma4FormatFromChannelCount(unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a list of the names of all available playback devices
+    ///
+    /// \return A vector of strings containing the names
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<std::string> getAvailableDevices();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the default playback device
+    ///
+    /// \return The name of the default playback device
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::string getDefaultDevice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the playback device
+    ///
+    /// The open device is switched if the driver supports
+    /// ALC_SOFT_reopen_device, otherwise the selection is
+    /// used the next time the device is opened.
+    ///
+    /// \param name Name of the device, empty for the default one
+    ///
+    /// \return False if the open device failed to switch
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setDevice(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the selected playback device
+    ///
+    /// \return Name of the device, empty for the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    static const std::string& getDevice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the settings of the playback device
+    ///
+    /// The open device is reset if the driver supports
+    /// ALC_SOFT_HRTF, otherwise the settings are used the next
+    /// time the device is opened.
+    ///
+    /// \param settings New settings of the device
+    ///
+    /// \return False if the open device failed to apply the settings
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setSettings(const PlaybackDevice::Settings& settings);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the settings of the playback device
+    ///
+    /// \return Actual settings of the open device, or the requested ones
+    ///
+    ////////////////////////////////////////////////////////////
+    static PlaybackDevice::Settings getSettings();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the output latency of the playback device
+    ///
+    /// \return Latency reported by the driver, or the duration of a mixing update
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getLatency();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the audio clock
+    ///
+    /// \return Clock of the device (ALC_SOFT_device_clock), or a system clock
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getClockTime();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Let the mixer start a source at a time of the audio clock
+    ///
+    /// \param source Identifier of the source to play
+    /// \param time   Time of the audio clock at which the source starts
+    ///
+    /// \return True if the mixer will start the source (AL_SOFT_source_start_delay),
+    ///         false if the caller must start it itself
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool playSourceAt(unsigned int source, Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the conversion of sounds to the device sample rate
+    ///
+    /// \param enabled True to convert the sample rates, false to let the mixer do it
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSampleRateConversion(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether sounds are converted to the device sample rate
+    ///
+    /// \return True if the conversion is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isSampleRateConversionEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate that sounds must be converted to
+    ///
+    /// \param sampleRate Sample rate of the sound
+    ///
+    /// \return Mixing frequency of the device if the conversion is enabled, \a sampleRate otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getOutputSampleRate(unsigned int sampleRate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the global volume of all the sounds and musics
     ///
@@ -182,6 +325,65 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start batching the changes made to the context
+    ///
+    /// Uses AL_SOFT_deferred_updates if available, and
+    /// alcSuspendContext otherwise. Calls can be nested.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deferUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the changes batched since the outermost deferUpdates()
+    ///
+    ////////////////////////////////////////////////////////////
+    static void processUpdates();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a new OpenAL source in the statistics
+    ///
+    /// \param source Identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    static void registerSource(unsigned int source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a destroyed OpenAL source from the statistics
+    ///
+    /// \param source Identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unregisterSource(unsigned int source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count an underrun of a stream
+    ///
+    ////////////////////////////////////////////////////////////
+    static void reportUnderrun();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the time a stream spent producing samples
+    ///
+    /// \param duration Duration of an onGetData call
+    ///
+    ////////////////////////////////////////////////////////////
+    static void reportDecodeTime(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of all the sounds and streams
+    ///
+    /// \return Statistics of the audio engine
+    ///
+    ////////////////////////////////////////////////////////////
+    static PlaybackDevice::Statistics getStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the accumulated statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetStatistics();
 };
 
 } // namespace priv
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/GainEffect.hpp>
+#include <SFML/Audio/SampleKernels.hpp>
+#include <SFML/System/FastLock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GainEffect::GainEffect(float gain) :
+m_mutex       (),
+m_target      (gain),
+m_rampDuration(Time::Zero),
+m_changed     (false),
+m_current     (gain),
+m_step        (0.f),
+m_rampFrames  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void GainEffect::setGain(float gain, Time rampDuration)
+{
+    FastLock lock(m_mutex);
+
+    m_target = gain;
+    m_rampDuration = rampDuration;
+    m_changed = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float GainEffect::getGain() const
+{
+    FastLock lock(m_mutex);
+
+    return m_target;
+}
+
+
+////////////////////////////////////////////////////////////
+void GainEffect::process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    // Start a new ramp if the gain was changed, from the gain reached so far
+    float target;
+    {
+        FastLock lock(m_mutex);
+
+        target = m_target;
+        if (m_changed)
+        {
+            m_rampFrames = static_cast<Uint64>(std::max(m_rampDuration.asSeconds(), 0.f) * sampleRate);
+            m_step = m_rampFrames ? (target - m_current) / m_rampFrames : 0.f;
+            m_changed = false;
+        }
+    }
+
+    std::size_t frame = 0;
+    for (; (frame < frameCount) && (m_rampFrames > 0); ++frame, --m_rampFrames)
+    {
+        m_current += m_step;
+        for (unsigned int i = 0; i < channelCount; ++i)
+            samples[frame * channelCount + i] *= m_current;
+    }
+
+    // After the ramp, snap to the target so that rounding errors don't accumulate
+    if (m_rampFrames == 0)
+        m_current = target;
+
+    if ((frame < frameCount) && (m_current != 1.f))
+        priv::scaleSamples(samples + frame * channelCount, (frameCount - frame) * channelCount, m_current);
+}
+
+
+////////////////////////////////////////////////////////////
+void GainEffect::reset()
+{
+    FastLock lock(m_mutex);
+
+    m_current = m_target;
+    m_rampFrames = 0;
+    m_changed = false;
+}
+
+} // namespace sf
@@ -29,7 +29,8 @@
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/System/InputStream.hpp>
-#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/BufferedInputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 
@@ -68,21 +69,30 @@ bool InputSoundFile::openFromFile(const std::string& filename)
     if (!m_reader)
         return false;
 
-    // Wrap the file into a stream
-    FileInputStream* file = new FileInputStream;
-    m_stream = file;
+    // Wrap the file into a stream, mapping it in memory when possible
     m_streamOwned = true;
 
-    // Open it
-    if (!file->open(filename))
+    MappedFileInputStream* mapped = new MappedFileInputStream;
+    m_stream = mapped;
+
+    if (!mapped->open(filename))
     {
-        close();
-        return false;
+        delete mapped;
+
+        // Decoders read in small pieces: read the file in large blocks, in the background
+        BufferedInputStream* file = new BufferedInputStream(65536, true);
+        m_stream = file;
+
+        if (!file->open(filename))
+        {
+            close();
+            return false;
+        }
     }
 
     // Pass the stream to the reader
     SoundFileReader::Info info;
-    if (!m_reader->open(*file, info))
+    if (!m_reader->open(*m_stream, info))
     {
         close();
         return false;
@@ -253,6 +263,17 @@ Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::read(float* samples, Uint64 maxCount)
+{
+    Uint64 readSamples = 0;
+    if (m_reader && samples && maxCount)
+        readSamples = m_reader->readFloat(samples, maxCount);
+    m_sampleOffset += readSamples;
+    return readSamples;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputSoundFile::close()
 {
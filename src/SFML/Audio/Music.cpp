@@ -29,17 +29,57 @@
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 
+namespace
+{
+    // Number of frames decoded at once by the read-ahead thread
+    const std::size_t decodeFrameCount = 4096;
+
+    // Copy samples into a ring, wrapping around its end
+    void writeRing(std::vector<sf::Int16>& ring, sf::Uint64 position, const sf::Int16* samples, std::size_t count)
+    {
+        std::size_t start = static_cast<std::size_t>(position % ring.size());
+        std::size_t first = std::min(count, ring.size() - start);
+        std::memcpy(&ring[start], samples, first * sizeof(sf::Int16));
+        if (count > first)
+            std::memcpy(&ring[0], samples + first, (count - first) * sizeof(sf::Int16));
+    }
+
+    // Copy samples out of a ring, wrapping around its end
+    void readRing(const std::vector<sf::Int16>& ring, sf::Uint64 position, sf::Int16* samples, std::size_t count)
+    {
+        std::size_t start = static_cast<std::size_t>(position % ring.size());
+        std::size_t first = std::min(count, ring.size() - start);
+        std::memcpy(samples, &ring[start], first * sizeof(sf::Int16));
+        if (count > first)
+            std::memcpy(samples + first, &ring[0], (count - first) * sizeof(sf::Int16));
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Music::Music() :
-m_file      (),
-m_loopSpan  (0, 0)
+m_file             (),
+m_loopSpan         (0, 0),
+m_decoder          (&Music::decode, this),
+m_decoding         (false),
+m_decodedEnd       (false),
+m_decodeCondition  (),
+m_readAheadDuration(seconds(2)),
+m_readAhead        (),
+m_readCount        (0),
+m_writeCount       (0),
+m_loopMarkers      ()
 {
-
+    // The decoding thread feeds the streaming thread, it must not starve behind normal work
+    m_decoder.setName("sfml-decoder");
+    m_decoder.setPriority(Thread::High);
 }
 
 
@@ -48,6 +88,7 @@ Music::~Music()
 {
     // We must stop before destroying the file
     stop();
+    stopReadAhead();
 }
 
 
@@ -176,33 +217,72 @@ void Music::setLoopPoints(TimeSpan timePoints)
 
 
 ////////////////////////////////////////////////////////////
-bool Music::onGetData(SoundStream::Chunk& data)
+void Music::setReadAheadDuration(Time duration)
 {
     Lock lock(m_mutex);
+    m_readAheadDuration = duration;
+}
 
-    std::size_t toFill = m_samples.size();
-    Uint64 currentOffset = m_file.getSampleOffset();
-    Uint64 loopEnd = m_loopSpan.offset + m_loopSpan.length;
 
-    // If the loop end is enabled and imminent, request less data.
-    // This will trip an "onLoop()" call from the underlying SoundStream,
-    // and we can then take action.
-    if (getLoop() && (m_loopSpan.length != 0) && (currentOffset <= loopEnd) && (currentOffset + toFill > loopEnd))
-        toFill = static_cast<std::size_t>(loopEnd - currentOffset);
+////////////////////////////////////////////////////////////
+Time Music::getReadAheadDuration() const
+{
+    Lock lock(m_mutex);
+    return m_readAheadDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::onGetData(SoundStream::Chunk& data)
+{
+    // The lock is released while waiting for the decoding thread
+    m_mutex.lock();
+
+    startReadAhead();
+
+    // Follow changes of the buffer duration between two chunks
+    std::size_t bufferSize = getBufferSampleCount();
+
+    if (m_samples.size() != bufferSize)
+        m_samples.resize(bufferSize);
+
+    // Stop at the next jump of the file: this will trip an "onLoop()"
+    // call from the underlying SoundStream, and we can then take action.
+    Uint64 toFill = std::min(m_samples.size(), m_readAhead.size());
+    if (!m_loopMarkers.empty())
+        toFill = std::min(toFill, m_loopMarkers.front().position - m_readCount);
+
+    // Wait for a whole buffer, unless the decoding thread reached the end of the file;
+    // when it keeps up, samples are always ready and this doesn't wait
+    while (m_decoding && !m_decodedEnd && (m_writeCount - m_readCount < toFill))
+        m_decodeCondition.wait(m_mutex);
 
     // Fill the chunk parameters
+    std::size_t count = static_cast<std::size_t>(std::min(toFill, m_writeCount - m_readCount));
+    readRing(m_readAhead, m_readCount, &m_samples[0], count);
+    m_readCount += count;
+
+    // Let the decoding thread refill the room
+    m_decodeCondition.notifyAll();
+
     data.samples = &m_samples[0];
-    data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], toFill));
-    currentOffset += data.sampleCount;
+    data.sampleCount = count;
+
+    // Check if we have stopped obtaining samples or reached either the EOF or a jump of the file
+    bool atJump = !m_loopMarkers.empty() && (m_loopMarkers.front().position == m_readCount);
+    bool atEnd = m_decodedEnd && (m_readCount == m_writeCount);
 
-    // Check if we have stopped obtaining samples or reached either the EOF or the loop end point
-    return (data.sampleCount != 0) && (currentOffset < m_file.getSampleCount()) && !(currentOffset == loopEnd && m_loopSpan.length != 0);
+    m_mutex.unlock();
+
+    return (count != 0) && !atJump && !atEnd;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Music::onSeek(Time timeOffset)
 {
+    stopReadAhead();
+
     Lock lock(m_mutex);
     m_file.seek(timeOffset);
 }
@@ -212,6 +292,25 @@ void Music::onSeek(Time timeOffset)
 Int64 Music::onLoop()
 {
     // Called by underlying SoundStream so we can determine where to loop.
+    {
+        Lock lock(m_mutex);
+
+        // The decoding thread has already jumped to the loop start: nothing to seek
+        if (!m_loopMarkers.empty() && (m_loopMarkers.front().position == m_readCount))
+        {
+            Int64 offset = m_loopMarkers.front().offset;
+            m_loopMarkers.pop_front();
+            return offset;
+        }
+
+        if (!getLoop())
+            return NoLoop;
+    }
+
+    // Looping was enabled after the end was decoded: seek directly,
+    // the decoding thread will restart from the new position
+    stopReadAhead();
+
     Lock lock(m_mutex);
     Uint64 currentOffset = m_file.getSampleOffset();
     if (getLoop() && (m_loopSpan.length != 0) && (currentOffset == m_loopSpan.offset + m_loopSpan.length))
@@ -231,6 +330,131 @@ Int64 Music::onLoop()
 }
 
 
+////////////////////////////////////////////////////////////
+void Music::startReadAhead()
+{
+    if (m_decoding)
+        return;
+
+    // Hold the requested duration, but at least one buffer, plus the block being decoded
+    Time duration = std::max(m_readAheadDuration, getBufferDuration());
+    std::size_t frames = static_cast<std::size_t>(duration.asMicroseconds() * m_file.getSampleRate() / 1000000);
+
+    m_readAhead.resize((frames + decodeFrameCount) * m_file.getChannelCount());
+    m_readCount = 0;
+    m_writeCount = 0;
+    m_decodedEnd = false;
+    m_loopMarkers.clear();
+
+    m_decoding = true;
+    m_decoder.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::stopReadAhead()
+{
+    {
+        Lock lock(m_mutex);
+        m_decoding = false;
+        m_decodeCondition.notifyAll();
+    }
+
+    m_decoder.wait();
+
+    Lock lock(m_mutex);
+    m_readCount = 0;
+    m_writeCount = 0;
+    m_decodedEnd = false;
+    m_loopMarkers.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::decode()
+{
+    // Only this thread accesses the file while it is running
+    unsigned int channelCount = m_file.getChannelCount();
+    std::vector<Int16> block(decodeFrameCount * channelCount);
+
+    for (;;)
+    {
+        // Decode as much as the ring can take
+        std::size_t toRead;
+        {
+            Lock lock(m_mutex);
+
+            for (;;)
+            {
+                if (!m_decoding)
+                    return;
+
+                toRead = 0;
+                if (!m_decodedEnd)
+                    toRead = std::min(block.size(), static_cast<std::size_t>(m_readAhead.size() - (m_writeCount - m_readCount)));
+                toRead -= toRead % channelCount;
+
+                if (toRead > 0)
+                    break;
+
+                // Wait until the stream consumes samples, or stops the decoding
+                m_decodeCondition.wait(m_mutex);
+            }
+        }
+
+        // Stop at the loop end, if the loop end is enabled and imminent
+        bool loop = getLoop();
+        Uint64 currentOffset = m_file.getSampleOffset();
+        Uint64 loopEnd = m_loopSpan.offset + m_loopSpan.length;
+        if (loop && (m_loopSpan.length != 0) && (currentOffset <= loopEnd) && (currentOffset + toRead > loopEnd))
+            toRead = static_cast<std::size_t>(loopEnd - currentOffset);
+
+        std::size_t count = toRead ? static_cast<std::size_t>(m_file.read(&block[0], toRead)) : 0;
+        currentOffset += count;
+
+        // Pre-roll the loop: jump now, so that the stream doesn't wait for the seek
+        bool jump = false;
+        bool end = false;
+        if (loop && (m_loopSpan.length != 0) && (currentOffset == loopEnd))
+        {
+            m_file.seek(m_loopSpan.offset);
+            jump = true;
+        }
+        else if (currentOffset >= m_file.getSampleCount())
+        {
+            if (loop)
+                m_file.seek(0);
+
+            jump = loop;
+            end = !loop;
+        }
+        else if (count == 0)
+        {
+            // Decoding error
+            end = true;
+        }
+
+        Lock lock(m_mutex);
+
+        writeRing(m_readAhead, m_writeCount, &block[0], count);
+        m_writeCount += count;
+
+        if (jump)
+        {
+            LoopMarker marker;
+            marker.position = m_writeCount;
+            marker.offset = static_cast<Int64>(m_file.getSampleOffset());
+            m_loopMarkers.push_back(marker);
+        }
+
+        m_decodedEnd = end;
+
+        // Wake up the stream if it is waiting for these samples
+        m_decodeCondition.notifyAll();
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Music::initialize()
 {
@@ -238,13 +462,25 @@ void Music::initialize()
     m_loopSpan.offset = 0;
     m_loopSpan.length = m_file.getSampleCount();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
+    // Resize the internal buffer so that it can contain one buffer of audio samples
+    m_samples.resize(getBufferSampleCount());
 
     // Initialize the stream
     SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
 }
 
+////////////////////////////////////////////////////////////
+std::size_t Music::getBufferSampleCount() const
+{
+    // Always read at least one frame
+    std::size_t frames = static_cast<std::size_t>(getBufferDuration().asMicroseconds() * m_file.getSampleRate() / 1000000);
+
+    if (frames == 0)
+        frames = 1;
+
+    return frames * m_file.getChannelCount();
+}
+
 ////////////////////////////////////////////////////////////
 Uint64 Music::timeToSamples(Time position) const
 {
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/OpusFrameDecoder.hpp>
+#include <SFML/System/Err.hpp>
+#ifdef SFML_AUDIO_OPUS
+    #include <opus.h>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+bool OpusFrameDecoder::isAvailable()
+{
+#ifdef SFML_AUDIO_OPUS
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+OpusFrameDecoder::OpusFrameDecoder() :
+m_decoder     (NULL),
+m_sampleRate  (0),
+m_channelCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+OpusFrameDecoder::~OpusFrameDecoder()
+{
+#ifdef SFML_AUDIO_OPUS
+    if (m_decoder)
+        opus_decoder_destroy(m_decoder);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool OpusFrameDecoder::create(unsigned int sampleRate, unsigned int channelCount)
+{
+#ifdef SFML_AUDIO_OPUS
+    if (m_decoder)
+    {
+        opus_decoder_destroy(m_decoder);
+        m_decoder = NULL;
+    }
+
+    int error = OPUS_OK;
+    m_decoder = opus_decoder_create(static_cast<opus_int32>(sampleRate), static_cast<int>(channelCount), &error);
+    if (error != OPUS_OK)
+    {
+        err() << "Failed to create Opus decoder (" << opus_strerror(error) << ")" << std::endl;
+        m_decoder = NULL;
+        return false;
+    }
+
+    m_sampleRate = sampleRate;
+    m_channelCount = channelCount;
+
+    return true;
+#else
+    (void)sampleRate;
+    (void)channelCount;
+
+    err() << "Failed to create Opus decoder (SFML was built without SFML_AUDIO_OPUS)" << std::endl;
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool OpusFrameDecoder::decode(const void* data, std::size_t size, std::vector<Int16>& samples)
+{
+#ifdef SFML_AUDIO_OPUS
+    if (!m_decoder)
+    {
+        err() << "Failed to decode Opus frame (the decoder was not created)" << std::endl;
+        return false;
+    }
+
+    // A packet holds at most 120 ms of audio, a lost one is concealed
+    // with a single 20 ms frame like those of sf::OpusFrameEncoder
+    const unsigned char* packet = static_cast<const unsigned char*>(data);
+    int frameSize = static_cast<int>(packet ? m_sampleRate / 1000 * 120 : m_sampleRate / 50);
+    samples.resize(static_cast<std::size_t>(frameSize) * m_channelCount);
+
+    int count = opus_decode(m_decoder, packet, packet ? static_cast<opus_int32>(size) : 0, &samples[0], frameSize, 0);
+    if (count < 0)
+    {
+        err() << "Failed to decode Opus frame (" << opus_strerror(count) << ")" << std::endl;
+        samples.clear();
+        return false;
+    }
+
+    samples.resize(static_cast<std::size_t>(count) * m_channelCount);
+    return true;
+#else
+    (void)data;
+    (void)size;
+
+    samples.clear();
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void OpusFrameDecoder::reset()
+{
+#ifdef SFML_AUDIO_OPUS
+    if (m_decoder)
+        opus_decoder_ctl(m_decoder, OPUS_RESET_STATE);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusFrameDecoder::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusFrameDecoder::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+} // namespace sf
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/OpusFrameEncoder.hpp>
+#include <SFML/System/Err.hpp>
+#ifdef SFML_AUDIO_OPUS
+    #include <opus.h>
+#endif
+
+
+#ifdef SFML_AUDIO_OPUS
+namespace
+{
+    // Largest packet libopus can produce for a single frame
+    const int maxOpusPacketSize = 1275 * 3 + 7;
+}
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+bool OpusFrameEncoder::isAvailable()
+{
+#ifdef SFML_AUDIO_OPUS
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+OpusFrameEncoder::OpusFrameEncoder() :
+m_encoder     (NULL),
+m_sampleRate  (0),
+m_channelCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+OpusFrameEncoder::~OpusFrameEncoder()
+{
+#ifdef SFML_AUDIO_OPUS
+    if (m_encoder)
+        opus_encoder_destroy(m_encoder);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool OpusFrameEncoder::create(unsigned int sampleRate, unsigned int channelCount, Application application)
+{
+#ifdef SFML_AUDIO_OPUS
+    if (m_encoder)
+    {
+        opus_encoder_destroy(m_encoder);
+        m_encoder = NULL;
+    }
+
+    int mode = OPUS_APPLICATION_VOIP;
+    switch (application)
+    {
+        case Voip:     mode = OPUS_APPLICATION_VOIP;                break;
+        case Audio:    mode = OPUS_APPLICATION_AUDIO;               break;
+        case LowDelay: mode = OPUS_APPLICATION_RESTRICTED_LOWDELAY; break;
+    }
+
+    int error = OPUS_OK;
+    m_encoder = opus_encoder_create(static_cast<opus_int32>(sampleRate), static_cast<int>(channelCount), mode, &error);
+    if (error != OPUS_OK)
+    {
+        err() << "Failed to create Opus encoder (" << opus_strerror(error) << ")" << std::endl;
+        m_encoder = NULL;
+        return false;
+    }
+
+    m_sampleRate = sampleRate;
+    m_channelCount = channelCount;
+
+    return true;
+#else
+    (void)sampleRate;
+    (void)channelCount;
+    (void)application;
+
+    err() << "Failed to create Opus encoder (SFML was built without SFML_AUDIO_OPUS)" << std::endl;
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void OpusFrameEncoder::setBitrate(unsigned int bitrate)
+{
+#ifdef SFML_AUDIO_OPUS
+    if (m_encoder)
+        opus_encoder_ctl(m_encoder, OPUS_SET_BITRATE(static_cast<opus_int32>(bitrate)));
+#else
+    (void)bitrate;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t OpusFrameEncoder::getFrameSize() const
+{
+    return m_sampleRate / 50;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusFrameEncoder::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int OpusFrameEncoder::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool OpusFrameEncoder::encode(const Int16* samples, std::vector<Uint8>& frame)
+{
+#ifdef SFML_AUDIO_OPUS
+    if (!m_encoder)
+    {
+        err() << "Failed to encode Opus frame (the encoder was not created)" << std::endl;
+        return false;
+    }
+
+    frame.resize(maxOpusPacketSize);
+    opus_int32 size = opus_encode(m_encoder, samples, static_cast<int>(getFrameSize()), &frame[0], maxOpusPacketSize);
+    if (size < 0)
+    {
+        err() << "Failed to encode Opus frame (" << opus_strerror(size) << ")" << std::endl;
+        frame.clear();
+        return false;
+    }
+
+    frame.resize(static_cast<std::size_t>(size));
+    return true;
+#else
+    (void)samples;
+
+    frame.clear();
+    return false;
+#endif
+}
+
+} // namespace sf
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/PlaybackDevice.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+std::vector<std::string> PlaybackDevice::getAvailableDevices()
+{
+    return priv::AudioDevice::getAvailableDevices();
+}
+
+
+////////////////////////////////////////////////////////////
+std::string PlaybackDevice::getDefaultDevice()
+{
+    return priv::AudioDevice::getDefaultDevice();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PlaybackDevice::setDevice(const std::string& name)
+{
+    return priv::AudioDevice::setDevice(name);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& PlaybackDevice::getDevice()
+{
+    return priv::AudioDevice::getDevice();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PlaybackDevice::setSettings(const Settings& settings)
+{
+    return priv::AudioDevice::setSettings(settings);
+}
+
+
+////////////////////////////////////////////////////////////
+PlaybackDevice::Settings PlaybackDevice::getSettings()
+{
+    return priv::AudioDevice::getSettings();
+}
+
+
+////////////////////////////////////////////////////////////
+Time PlaybackDevice::getLatency()
+{
+    return priv::AudioDevice::getLatency();
+}
+
+
+////////////////////////////////////////////////////////////
+void PlaybackDevice::setSampleRateConversion(bool enabled)
+{
+    priv::AudioDevice::setSampleRateConversion(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+bool PlaybackDevice::isSampleRateConversionEnabled()
+{
+    return priv::AudioDevice::isSampleRateConversionEnabled();
+}
+
+
+////////////////////////////////////////////////////////////
+Time PlaybackDevice::getTime()
+{
+    return priv::AudioDevice::getClockTime();
+}
+
+
+////////////////////////////////////////////////////////////
+PlaybackDevice::Statistics PlaybackDevice::getStatistics()
+{
+    return priv::AudioDevice::getStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void PlaybackDevice::resetStatistics()
+{
+    priv::AudioDevice::resetStatistics();
+}
+
+} // namespace sf
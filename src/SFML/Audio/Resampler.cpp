@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Resampler.hpp>
+#include <SFML/System/Cpu.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // More phases than this are approximated, with a pitch error below 0.1%
+    const unsigned int maxPhaseCount = 1024;
+
+    // Zero crossings of the sinc on each side, at the cutoff frequency
+    const double zeroCrossingCount = 16.0;
+
+    // Cutoff below the Nyquist frequency, leaves room for the transition band
+    const double cutoffRatio = 0.95;
+
+    const double pi = 3.14159265358979323846;
+
+    unsigned int greatestCommonDivisor(unsigned int a, unsigned int b)
+    {
+        while (b != 0)
+        {
+            unsigned int remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+
+        return a;
+    }
+
+    // Inner product of the filter coefficients and the history of a channel
+    float dotProduct(const float* coefficients, const float* samples, std::size_t count)
+    {
+        std::size_t i = 0;
+        float sum = 0.f;
+
+#if defined(SFML_CPU_SSE2)
+
+        __m128 sums = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+            sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(coefficients + i), _mm_loadu_ps(samples + i)));
+
+        sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+        sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, 1));
+        sum = _mm_cvtss_f32(sums);
+
+#elif defined(SFML_CPU_NEON)
+
+        float32x4_t sums = vdupq_n_f32(0.f);
+        for (; i + 4 <= count; i += 4)
+            sums = vmlaq_f32(sums, vld1q_f32(coefficients + i), vld1q_f32(samples + i));
+
+        float32x2_t pairs = vadd_f32(vget_low_f32(sums), vget_high_f32(sums));
+        sum = vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+
+#endif
+
+        for (; i < count; ++i)
+            sum += coefficients[i] * samples[i];
+
+        return sum;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Resampler::Resampler(unsigned int inputRate, unsigned int outputRate, unsigned int channelCount) :
+m_channelCount(channelCount),
+m_upFactor    (1),
+m_downFactor  (1),
+m_tapCount    (0),
+m_filter      (),
+m_history     (channelCount),
+m_position    (0),
+m_phase       (0)
+{
+    // Output frame n is at input position n * down / up: each of the up phases has its own filter
+    unsigned int divisor = greatestCommonDivisor(inputRate, outputRate);
+    m_upFactor = outputRate / divisor;
+    m_downFactor = inputRate / divisor;
+
+    if (m_upFactor > maxPhaseCount)
+    {
+        m_downFactor = static_cast<unsigned int>(static_cast<double>(m_downFactor) * maxPhaseCount / m_upFactor + 0.5);
+        m_upFactor = maxPhaseCount;
+    }
+
+    // When downsampling, the cutoff follows the output Nyquist frequency and the filter gets wider
+    double cutoff = cutoffRatio * std::min(1.0, static_cast<double>(m_upFactor) / m_downFactor);
+    std::size_t halfTapCount = static_cast<std::size_t>(std::ceil(zeroCrossingCount / cutoff));
+    halfTapCount = (halfTapCount + 1) / 2 * 2;
+    m_tapCount = halfTapCount * 2;
+
+    // Blackman-windowed sinc, each phase normalized to unity gain
+    m_filter.resize(m_upFactor * m_tapCount);
+    for (unsigned int phase = 0; phase < m_upFactor; ++phase)
+    {
+        float* coefficients = &m_filter[phase * m_tapCount];
+        double fraction = static_cast<double>(phase) / m_upFactor;
+        double sum = 0.0;
+
+        for (std::size_t k = 0; k < m_tapCount; ++k)
+        {
+            double x = static_cast<double>(k) - static_cast<double>(halfTapCount) + 1.0 - fraction;
+            double t = x / static_cast<double>(halfTapCount);
+            double window = (std::fabs(t) < 1.0) ? 0.42 + 0.5 * std::cos(pi * t) + 0.08 * std::cos(2.0 * pi * t) : 0.0;
+            double sinc = (x == 0.0) ? 1.0 : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+            double value = cutoff * sinc * window;
+
+            coefficients[k] = static_cast<float>(value);
+            sum += value;
+        }
+
+        for (std::size_t k = 0; k < m_tapCount; ++k)
+            coefficients[k] = static_cast<float>(coefficients[k] / sum);
+    }
+
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::reset()
+{
+    // The first output is centered on the first input frame, preceded by silence
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+        m_history[i].assign(m_tapCount / 2 - 1, 0.f);
+
+    m_position = 0;
+    m_phase = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::process(const float* input, std::size_t frameCount, std::vector<float>& output)
+{
+    // Store the channels in separate histories so that the filter reads contiguous samples
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+    {
+        std::vector<float>& history = m_history[i];
+        std::size_t offset = history.size();
+        history.resize(offset + frameCount);
+
+        for (std::size_t j = 0; j < frameCount; ++j)
+            history[offset + j] = input[j * m_channelCount + i];
+    }
+
+    convert(output);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::flush(std::vector<float>& output)
+{
+    // Enough silence for the last input frames to be at the center of the filter
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+        m_history[i].resize(m_history[i].size() + m_tapCount / 2, 0.f);
+
+    convert(output);
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Resampler::getOutputFrameCount(Uint64 frameCount) const
+{
+    return static_cast<std::size_t>((frameCount * m_upFactor + m_downFactor - 1) / m_downFactor);
+}
+
+
+////////////////////////////////////////////////////////////
+void Resampler::convert(std::vector<float>& output)
+{
+    if (m_channelCount == 0)
+        return;
+
+    std::size_t available = m_history[0].size();
+    if (available >= m_position + m_tapCount)
+        output.reserve(output.size() + getOutputFrameCount(available - m_position - m_tapCount + 1) * m_channelCount);
+
+    while (m_position + m_tapCount <= available)
+    {
+        const float* coefficients = &m_filter[m_phase * m_tapCount];
+        for (unsigned int i = 0; i < m_channelCount; ++i)
+            output.push_back(dotProduct(coefficients, &m_history[i][m_position], m_tapCount));
+
+        m_phase += m_downFactor;
+        m_position += m_phase / m_upFactor;
+        m_phase %= m_upFactor;
+    }
+
+    // Drop the frames that no future output will read
+    std::size_t consumed = std::min(m_position, available);
+    for (unsigned int i = 0; i < m_channelCount; ++i)
+        m_history[i].erase(m_history[i].begin(), m_history[i].begin() + consumed);
+
+    m_position -= consumed;
+}
+
+
+////////////////////////////////////////////////////////////
+void mixToStereo(const float* input, unsigned int channelCount, std::size_t frameCount, std::vector<float>& output)
+{
+    output.resize(frameCount * 2);
+
+    if (channelCount == 1)
+    {
+        for (std::size_t i = 0; i < frameCount; ++i)
+            output[i * 2] = output[i * 2 + 1] = input[i];
+
+        return;
+    }
+
+    // Normalize so that the mix of all channels at full scale doesn't clip
+    const float sideGain = 0.70710678f;
+    const float scale = 1.f / (1.f + sideGain * static_cast<float>(channelCount - 2));
+
+    for (std::size_t i = 0; i < frameCount; ++i)
+    {
+        const float* frame = input + i * channelCount;
+
+        float others = 0.f;
+        for (unsigned int j = 2; j < channelCount; ++j)
+            others += frame[j];
+
+        output[i * 2]     = (frame[0] + others * sideGain) * scale;
+        output[i * 2 + 1] = (frame[1] + others * sideGain) * scale;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
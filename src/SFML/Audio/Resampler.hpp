@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RESAMPLER_HPP
+#define SFML_RESAMPLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Windowed-sinc sample rate converter
+///
+/// The conversion runs on interleaved float samples, and
+/// can be fed in chunks: the filter history is kept from
+/// one call to the next. The inner products use SSE2 or
+/// NEON when the target architecture provides them.
+///
+////////////////////////////////////////////////////////////
+class Resampler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the resampler
+    ///
+    /// \param inputRate    Sample rate of the input samples
+    /// \param outputRate   Sample rate of the output samples
+    /// \param channelCount Number of interleaved channels
+    ///
+    ////////////////////////////////////////////////////////////
+    Resampler(unsigned int inputRate, unsigned int outputRate, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the previous input, to start an unrelated signal
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a chunk of samples
+    ///
+    /// The last few input frames are only converted by the
+    /// next call (or by flush()), once the frames that follow
+    /// them are known.
+    ///
+    /// \param input      Pointer to the interleaved input samples
+    /// \param frameCount Number of input frames
+    /// \param output     Vector to append the converted samples to
+    ///
+    ////////////////////////////////////////////////////////////
+    void process(const float* input, std::size_t frameCount, std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the input frames still waiting, followed by silence
+    ///
+    /// \param output Vector to append the converted samples to
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush(std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of output frames produced for a number of input frames
+    ///
+    /// \param frameCount Number of input frames
+    ///
+    /// \return Number of output frames, rounded up
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getOutputFrameCount(Uint64 frameCount) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Produce all the output frames whose input is available
+    ///
+    /// \param output Vector to append the converted samples to
+    ///
+    ////////////////////////////////////////////////////////////
+    void convert(std::vector<float>& output);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int                     m_channelCount; ///< Number of interleaved channels
+    unsigned int                     m_upFactor;     ///< Number of filter phases, output rate / gcd
+    unsigned int                     m_downFactor;   ///< Input step between output frames, input rate / gcd
+    std::size_t                      m_tapCount;     ///< Number of filter coefficients of each phase
+    std::vector<float>               m_filter;       ///< Coefficients of all the phases, one after the other
+    std::vector<std::vector<float> > m_history;      ///< Input frames of each channel not consumed yet
+    std::size_t                      m_position;     ///< Index of the first history frame of the next output
+    unsigned int                     m_phase;        ///< Filter phase of the next output
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Mix any number of channels down to stereo
+///
+/// Used for the channel counts OpenAL can't play: the first
+/// two channels are the front left and right ones, the
+/// others are mixed into both sides at -3 dB.
+///
+/// \param input        Pointer to the interleaved input samples
+/// \param channelCount Number of channels of the input
+/// \param frameCount   Number of frames to mix
+/// \param output       Filled with the interleaved stereo samples
+///
+////////////////////////////////////////////////////////////
+void mixToStereo(const float* input, unsigned int channelCount, std::size_t frameCount, std::vector<float>& output);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RESAMPLER_HPP
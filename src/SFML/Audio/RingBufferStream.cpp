@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/RingBufferStream.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Smallest power of two not less than the requested capacity, within the range of the counters
+    std::size_t ringSize(std::size_t capacity)
+    {
+        std::size_t size = 1;
+        while ((size < capacity) && (size < (1u << 31)))
+            size <<= 1;
+
+        return size;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RingBufferStream::RingBufferStream(unsigned int channelCount, unsigned int sampleRate, std::size_t capacity) :
+m_ring   (ringSize(std::max<std::size_t>(capacity, channelCount)), 0),
+m_chunk  (),
+m_silence(std::max<std::size_t>(sampleRate / 100, 1) * channelCount),
+m_write  (0),
+m_read   (0),
+m_closed (false)
+{
+    initialize(channelCount, sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+RingBufferStream::~RingBufferStream()
+{
+    // We must stop before destroying the ring, to avoid
+    // the streaming thread reading it while it is destroyed
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBufferStream::push(const Int16* samples, std::size_t sampleCount)
+{
+    // Only the producer writes m_write, a relaxed read is enough
+    Uint32 write = m_write.load(Memory::Relaxed);
+    Uint32 read = m_read.load(Memory::Acquire);
+
+    std::size_t size = m_ring.size();
+    std::size_t count = std::min(sampleCount, size - static_cast<std::size_t>(write - read));
+    if (count == 0)
+        return 0;
+
+    // Copy in at most two parts, around the end of the ring
+    std::size_t start = write & (size - 1);
+    std::size_t first = std::min(count, size - start);
+    std::memcpy(&m_ring[start], samples, first * sizeof(Int16));
+    if (count > first)
+        std::memcpy(&m_ring[0], samples + first, (count - first) * sizeof(Int16));
+
+    m_write.store(write + static_cast<Uint32>(count), Memory::Release);
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void RingBufferStream::close()
+{
+    m_closed.store(true, Memory::Release);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBufferStream::getFreeCount() const
+{
+    return m_ring.size() - getQueuedCount();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RingBufferStream::getQueuedCount() const
+{
+    Uint32 read = m_read.load(Memory::Acquire);
+    Uint32 write = m_write.load(Memory::Acquire);
+
+    return static_cast<std::size_t>(write - read);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RingBufferStream::onGetData(SoundStream::Chunk& data)
+{
+    // Check the closed flag first, so that samples pushed before close() are not missed
+    bool closed = m_closed.load(Memory::Acquire);
+    Uint32 read = m_read.load(Memory::Relaxed);
+    Uint32 write = m_write.load(Memory::Acquire);
+
+    // Only hand out whole frames
+    std::size_t count = static_cast<std::size_t>(write - read);
+    count -= count % getChannelCount();
+
+    if (count == 0)
+    {
+        if (closed)
+            return false;
+
+        // The producer is late: keep the stream alive with a short silence
+        m_chunk.assign(m_silence, 0);
+        data.samples = &m_chunk[0];
+        data.sampleCount = m_chunk.size();
+        return true;
+    }
+
+    // Copy out at most two parts, around the end of the ring
+    std::size_t size = m_ring.size();
+    std::size_t start = read & (size - 1);
+    std::size_t first = std::min(count, size - start);
+    m_chunk.resize(count);
+    std::memcpy(&m_chunk[0], &m_ring[start], first * sizeof(Int16));
+    if (count > first)
+        std::memcpy(&m_chunk[first], &m_ring[0], (count - first) * sizeof(Int16));
+
+    m_read.store(read + static_cast<Uint32>(count), Memory::Release);
+
+    data.samples = &m_chunk[0];
+    data.sampleCount = m_chunk.size();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RingBufferStream::onSeek(Time)
+{
+    // Drop the pending samples and reopen the stream
+    m_read.store(m_write.load(Memory::Acquire), Memory::Release);
+    m_closed.store(false, Memory::Release);
+}
+
+} // namespace sf
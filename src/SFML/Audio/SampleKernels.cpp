@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleKernels.hpp>
+#include <SFML/System/Cpu.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Narrow a sample to 16 bits, shift > 0 drops low bits, shift < 0 widens
+    inline sf::Int16 narrowSample(sf::Int32 sample, int shift)
+    {
+        return static_cast<sf::Int16>(shift >= 0 ? (sample >> shift) : (sample * (1 << -shift)));
+    }
+
+    // Quantizer steps and step index updates of IMA ADPCM
+    const int imaStepTable[89] =
+    {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+        253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+        1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+        12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    const int imaIndexTable[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+    // Frames per IMA4 block: the one stored in the header plus 64 nibbles
+    const std::size_t imaBlockFrames = 65;
+
+    // Get a sample to encode, the frames past the end are encoded as silence
+    inline int getImaSample(const sf::Int16* samples, std::size_t frame, std::size_t frameCount, unsigned int channelCount, unsigned int channel)
+    {
+        return (frame < frameCount) ? samples[frame * channelCount + channel] : 0;
+    }
+
+    // Encode a sample to a nibble, and update the decoder state that the nibble produces
+    sf::Uint8 encodeImaSample(int sample, int& predictor, int& index)
+    {
+        int step = imaStepTable[index];
+        int difference = sample - predictor;
+
+        sf::Uint8 nibble = 0;
+        if (difference < 0)
+        {
+            nibble = 8;
+            difference = -difference;
+        }
+
+        // Same rounding as the decoder: delta = (2 * magnitude + 1) * step / 8
+        int delta = step >> 3;
+        if (difference >= step)
+        {
+            nibble |= 4;
+            difference -= step;
+            delta += step;
+        }
+        if (difference >= (step >> 1))
+        {
+            nibble |= 2;
+            difference -= step >> 1;
+            delta += step >> 1;
+        }
+        if (difference >= (step >> 2))
+        {
+            nibble |= 1;
+            delta += step >> 2;
+        }
+
+        predictor += (nibble & 8) ? -delta : delta;
+        predictor = std::max(-32768, std::min(predictor, 32767));
+
+        index += imaIndexTable[nibble];
+        index = std::max(0, std::min(index, 88));
+
+        return nibble;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void interleaveSamples(Int16* output, const Int32* const* channels, unsigned int channelCount, std::size_t first, std::size_t count, unsigned int bitsPerSample)
+{
+    const int shift = static_cast<int>(bitsPerSample) - 16;
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_SSE2)
+
+    // Shifting left by a negative count is not possible, widening uses a separate count
+    const __m128i rightShift = _mm_cvtsi32_si128(shift > 0 ? shift : 0);
+    const __m128i leftShift  = _mm_cvtsi32_si128(shift < 0 ? -shift : 0);
+
+    if (channelCount == 1)
+    {
+        const Int32* mono = channels[0] + first;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mono + i));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mono + i + 4));
+            low  = _mm_sll_epi32(_mm_sra_epi32(low, rightShift), leftShift);
+            high = _mm_sll_epi32(_mm_sra_epi32(high, rightShift), leftShift);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(low, high));
+        }
+    }
+    else if (channelCount == 2)
+    {
+        const Int32* left  = channels[0] + first;
+        const Int32* right = channels[1] + first;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+            __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+            l = _mm_sll_epi32(_mm_sra_epi32(l, rightShift), leftShift);
+            r = _mm_sll_epi32(_mm_sra_epi32(r, rightShift), leftShift);
+
+            // l0 r0 l1 r1 | l2 r2 l3 r3, then narrowed to 16 bits
+            __m128i interleaved = _mm_packs_epi32(_mm_unpacklo_epi32(l, r), _mm_unpackhi_epi32(l, r));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2), interleaved);
+        }
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    // A negative shift count shifts right, arithmetically for signed lanes
+    const int32x4_t shiftCount = vdupq_n_s32(-shift);
+
+    if (channelCount == 1)
+    {
+        const Int32* mono = channels[0] + first;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x4_t low  = vmovn_s32(vshlq_s32(vld1q_s32(mono + i), shiftCount));
+            int16x4_t high = vmovn_s32(vshlq_s32(vld1q_s32(mono + i + 4), shiftCount));
+
+            vst1q_s16(output + i, vcombine_s16(low, high));
+        }
+    }
+    else if (channelCount == 2)
+    {
+        const Int32* left  = channels[0] + first;
+        const Int32* right = channels[1] + first;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            int16x4x2_t interleaved;
+            interleaved.val[0] = vmovn_s32(vshlq_s32(vld1q_s32(left + i), shiftCount));
+            interleaved.val[1] = vmovn_s32(vshlq_s32(vld1q_s32(right + i), shiftCount));
+
+            vst2_s16(output + i * 2, interleaved);
+        }
+    }
+
+#endif
+
+    // Remaining frames, and the channel counts without a vector path
+    for (; i < count; ++i)
+    {
+        for (unsigned int j = 0; j < channelCount; ++j)
+            *(output + i * channelCount + j) = narrowSample(channels[j][first + i], shift);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void mixSamples(float* output, const float* input, std::size_t count, float gain)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_SSE2)
+
+    const __m128 factor = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 mixed = _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(_mm_loadu_ps(input + i), factor));
+        _mm_storeu_ps(output + i, mixed);
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(output + i, vmlaq_n_f32(vld1q_f32(output + i), vld1q_f32(input + i), gain));
+
+#endif
+
+    for (; i < count; ++i)
+        output[i] += input[i] * gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void scaleSamples(float* samples, std::size_t count, float gain)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_SSE2)
+
+    const __m128 factor = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), factor));
+
+#elif defined(SFML_CPU_NEON)
+
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(samples + i, vmulq_n_f32(vld1q_f32(samples + i), gain));
+
+#endif
+
+    for (; i < count; ++i)
+        samples[i] *= gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void encodeIma4(std::vector<Uint8>& output, const Int16* samples, std::size_t frameCount, unsigned int channelCount)
+{
+    std::size_t blockCount = (frameCount + imaBlockFrames - 1) / imaBlockFrames;
+    output.assign(blockCount * 36 * channelCount, 0);
+
+    // The step index carries over from one block to the next, the predictor restarts from the header sample
+    std::vector<int> indices(channelCount, 0);
+    std::vector<int> predictors(channelCount, 0);
+
+    Uint8* block = output.empty() ? NULL : &output[0];
+    for (std::size_t b = 0; b < blockCount; ++b, block += 36 * channelCount)
+    {
+        std::size_t first = b * imaBlockFrames;
+
+        for (unsigned int c = 0; c < channelCount; ++c)
+        {
+            int header = getImaSample(samples, first, frameCount, channelCount, c);
+            predictors[c] = header;
+
+            block[c * 4 + 0] = static_cast<Uint8>(header & 0xFF);
+            block[c * 4 + 1] = static_cast<Uint8>((header >> 8) & 0xFF);
+            block[c * 4 + 2] = static_cast<Uint8>(indices[c]);
+            block[c * 4 + 3] = 0;
+        }
+
+        // Groups of 8 samples per channel, interleaved 4 bytes at a time, low nibble first
+        Uint8* data = block + 4 * channelCount;
+        for (std::size_t group = 0; group < 8; ++group)
+        {
+            for (unsigned int c = 0; c < channelCount; ++c)
+            {
+                for (std::size_t i = 0; i < 8; i += 2)
+                {
+                    std::size_t frame = 1 + group * 8 + i;
+                    Uint8 low  = encodeImaSample(getImaSample(samples, first + frame, frameCount, channelCount, c), predictors[c], indices[c]);
+                    Uint8 high = encodeImaSample(getImaSample(samples, first + frame + 1, frameCount, channelCount, c), predictors[c], indices[c]);
+                    *data++ = static_cast<Uint8>(low | (high << 4));
+                }
+            }
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
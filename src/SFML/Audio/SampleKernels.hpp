@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SAMPLEKERNELS_HPP
+#define SFML_SAMPLEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Interleave planar integer samples into 16-bit samples
+///
+/// Each input sample is narrowed to 16 bits by keeping its
+/// most significant bits (8-bit samples are widened). Mono
+/// and stereo blocks use SSE2 or NEON when the target
+/// architecture provides them, with identical results to
+/// the scalar code.
+///
+/// \param output        Interleaved samples to write, channelCount * count of them
+/// \param channels      Planar samples of each channel
+/// \param channelCount  Number of channels
+/// \param first         Index of the first frame to convert in each channel
+/// \param count         Number of frames to convert
+/// \param bitsPerSample Significant bits of the input samples, from 4 to 32
+///
+////////////////////////////////////////////////////////////
+void interleaveSamples(Int16* output, const Int32* const* channels, unsigned int channelCount, std::size_t first, std::size_t count, unsigned int bitsPerSample);
+
+////////////////////////////////////////////////////////////
+/// \brief Add scaled float samples to a mix
+///
+/// Uses SSE2 or NEON when the target architecture provides them.
+///
+/// \param output Samples of the mix, input * gain is added to them
+/// \param input  Samples to add
+/// \param count  Number of samples
+/// \param gain   Factor applied to the input samples
+///
+////////////////////////////////////////////////////////////
+void mixSamples(float* output, const float* input, std::size_t count, float gain);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply float samples by a constant gain
+///
+/// Uses SSE2 or NEON when the target architecture provides them.
+///
+/// \param samples Samples to scale in place
+/// \param count   Number of samples
+/// \param gain    Factor applied to the samples
+///
+////////////////////////////////////////////////////////////
+void scaleSamples(float* samples, std::size_t count, float gain);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode 16-bit samples to IMA ADPCM
+///
+/// The layout is the one of WAV files and AL_EXT_IMA4: blocks
+/// of 65 frames, made of a 4-byte header per channel followed
+/// by the nibbles of 8 samples of each channel in turn, for
+/// 36 bytes per channel. The last block is padded with silence.
+///
+/// \param output       Encoded blocks, replaced by the result
+/// \param samples      Interleaved samples to encode
+/// \param frameCount   Number of frames to encode
+/// \param channelCount Number of channels
+///
+////////////////////////////////////////////////////////////
+void encodeIma4(std::vector<Uint8>& output, const Int16* samples, std::size_t frameCount, unsigned int channelCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLEKERNELS_HPP
@@ -27,6 +27,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/StreamScheduler.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 
 
@@ -70,13 +72,26 @@ Sound::~Sound()
 ////////////////////////////////////////////////////////////
 void Sound::play()
 {
+    priv::StreamScheduler::cancelPlay(m_source);
     alCheck(alSourcePlay(m_source));
 }
 
 
+////////////////////////////////////////////////////////////
+void Sound::playAt(Time time)
+{
+    priv::StreamScheduler::cancelPlay(m_source);
+
+    // Without support from the mixer, the audio thread starts the sound when the time comes
+    if (!priv::AudioDevice::playSourceAt(m_source, time))
+        priv::StreamScheduler::schedulePlay(m_source, time - priv::AudioDevice::getClockTime());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Sound::pause()
 {
+    priv::StreamScheduler::cancelPlay(m_source);
     alCheck(alSourcePause(m_source));
 }
 
@@ -84,6 +99,7 @@ void Sound::pause()
 ////////////////////////////////////////////////////////////
 void Sound::stop()
 {
+    priv::StreamScheduler::cancelPlay(m_source);
     alCheck(alSourceStop(m_source));
 }
 
@@ -98,10 +114,9 @@ void Sound::setBuffer(const SoundBuffer& buffer)
         m_buffer->detachSound(this);
     }
 
-    // Assign and use the new buffer
+    // Assign and use the new buffer, it binds itself to the source
     m_buffer = &buffer;
     m_buffer->attachSound(this);
-    alCheck(alSourcei(m_source, AL_BUFFER, m_buffer->m_buffer));
 }
 
 
@@ -186,11 +201,11 @@ void Sound::resetBuffer()
     // First stop the sound in case it is playing
     stop();
 
-    // Detach the buffer
+    // Detach the buffer, first so that a progressive load stops appending to the source
     if (m_buffer)
     {
-        alCheck(alSourcei(m_source, AL_BUFFER, 0));
         m_buffer->detachSound(this);
+        alCheck(alSourcei(m_source, AL_BUFFER, 0));
         m_buffer = NULL;
     }
 }
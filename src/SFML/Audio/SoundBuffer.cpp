@@ -31,16 +31,136 @@
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/Resampler.hpp>
+#include <SFML/Audio/SampleKernels.hpp>
+#include <SFML/System/Atomic.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 
+namespace
+{
+    // Convert normalized float samples to 16-bit samples
+    void convertSamples(const float* samples, sf::Int16* converted, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            converted[i] = static_cast<sf::Int16>(std::max(-1.f, std::min(samples[i], 1.f)) * 32767.f);
+    }
+
+    // Mix down the channels OpenAL can't play and convert to the output sample rate
+    void matchDeviceFormat(std::vector<float>& samples, unsigned int& channelCount, unsigned int& sampleRate, bool mixToStereo, unsigned int outputRate)
+    {
+        if (mixToStereo)
+        {
+            std::vector<float> mixed;
+            sf::priv::mixToStereo(&samples[0], channelCount, samples.size() / channelCount, mixed);
+            samples.swap(mixed);
+            channelCount = 2;
+        }
+
+        if (outputRate != sampleRate)
+        {
+            // The filter tail left by flush() is cut to keep the duration
+            std::size_t frameCount = samples.size() / channelCount;
+            sf::priv::Resampler resampler(sampleRate, outputRate, channelCount);
+
+            std::vector<float> resampled;
+            resampled.reserve((resampler.getOutputFrameCount(frameCount) + 64) * channelCount);
+            resampler.process(&samples[0], frameCount, resampled);
+            resampler.flush(resampled);
+            resampled.resize(resampler.getOutputFrameCount(frameCount) * channelCount, 0.f);
+
+            samples.swap(resampled);
+            sampleRate = outputRate;
+        }
+    }
+
+    // Convert a chunk of a progressive load, the resampler keeps its state from one chunk to the next
+    void convertChunk(std::vector<sf::Int16>& samples, unsigned int channelCount, bool mixToStereo, sf::priv::Resampler* resampler, bool last)
+    {
+        std::vector<float> converted(samples.size());
+        for (std::size_t i = 0; i < samples.size(); ++i)
+            converted[i] = samples[i] / 32768.f;
+
+        if (mixToStereo)
+        {
+            std::vector<float> mixed;
+            sf::priv::mixToStereo(converted.empty() ? NULL : &converted[0], channelCount, converted.size() / channelCount, mixed);
+            converted.swap(mixed);
+            channelCount = 2;
+        }
+
+        if (resampler)
+        {
+            std::vector<float> resampled;
+            resampler->process(converted.empty() ? NULL : &converted[0], converted.size() / channelCount, resampled);
+            if (last)
+                resampler->flush(resampled);
+            converted.swap(resampled);
+        }
+
+        samples.resize(converted.size());
+        if (!converted.empty())
+            convertSamples(&converted[0], &samples[0], converted.size());
+    }
+}
+
+
 namespace sf
 {
+////////////////////////////////////////////////////////////
+struct SoundBuffer::Loader
+{
+    Loader(SoundBuffer& buffer) :
+    thread      (&SoundBuffer::loadRemaining, &buffer),
+    file        (),
+    chunk       (),
+    resampler   (NULL),
+    mixToStereo (false),
+    channelCount(0),
+    sampleRate  (0),
+    format      (0),
+    loaded      (0),
+    cancelled   (false),
+    done        (false)
+    {
+        thread.setName("sfml-sound-loader");
+        thread.setPriority(Thread::Low);
+    }
+
+    ~Loader()
+    {
+        delete resampler;
+    }
+
+    Thread              thread;       ///< Worker thread decoding the rest of the sound
+    InputSoundFile      file;         ///< File being decoded
+    std::vector<Int16>  chunk;        ///< Samples of the chunk being decoded
+    priv::Resampler*    resampler;    ///< Converter to the device sample rate, NULL if not needed
+    bool                mixToStereo;  ///< Are the channels mixed down to stereo?
+    unsigned int        channelCount; ///< Number of channels of the file
+    unsigned int        sampleRate;   ///< Sample rate of the uploaded samples
+    int                 format;       ///< OpenAL format of the uploaded samples
+    Uint64              loaded;       ///< Number of samples uploaded so far
+    Atomic<bool>        cancelled;    ///< Must the worker thread stop?
+    Atomic<bool>        done;         ///< Has the worker thread finished?
+};
+
+
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer() :
-m_buffer  (0),
-m_duration()
+m_buffer     (0),
+m_segments   (),
+m_sampleCount(0),
+m_keepSamples(true),
+m_compressed (false),
+m_duration   (),
+m_loader     (NULL),
+m_mutex      ()
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
@@ -49,15 +169,27 @@ m_duration()
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
-m_buffer  (0),
-m_samples (copy.m_samples),
-m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_buffer      (0),
+m_segments    (),
+m_samples     (),
+m_floatSamples(),
+m_sampleCount (0),
+m_keepSamples (copy.m_keepSamples),
+m_compressed  (copy.m_compressed),
+m_duration    (),
+m_loader      (NULL),
+m_mutex       (),
+m_sounds      () // don't copy the attached sounds
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
 
-    // Update the internal buffer with the new samples
+    // Copy the samples once the worker thread of a progressive load is done with them
+    copy.waitForLoading();
+    m_samples = copy.m_samples;
+    m_floatSamples = copy.m_floatSamples;
+
+    // Update the internal buffer with the new samples, a buffer that didn't keep them gives an empty copy
     update(copy.getChannelCount(), copy.getSampleRate());
 }
 
@@ -65,6 +197,9 @@ m_sounds  () // don't copy the attached sounds
 ////////////////////////////////////////////////////////////
 SoundBuffer::~SoundBuffer()
 {
+    // The worker thread must not append to the sounds anymore
+    stopLoading();
+
     // To prevent the iterator from becoming invalid, move the entire buffer to another
     // container. Otherwise calling resetBuffer would result in detachSound being
     // called which removes the sound from the internal list.
@@ -75,7 +210,8 @@ SoundBuffer::~SoundBuffer()
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
         (*it)->resetBuffer();
 
-    // Destroy the buffer
+    // Destroy the buffers
+    deleteSegments();
     if (m_buffer)
         alCheck(alDeleteBuffers(1, &m_buffer));
 }
@@ -119,8 +255,12 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 {
     if (samples && sampleCount && channelCount && sampleRate)
     {
+        // The worker thread of a progressive load must be done with the previous samples
+        stopLoading();
+
         // Copy the new audio samples
         m_samples.assign(samples, samples + sampleCount);
+        m_floatSamples.clear();
 
         // Update the internal buffer with the new samples
         return update(channelCount, sampleRate);
@@ -140,6 +280,176 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromSamples(const float* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if (samples && sampleCount && channelCount && sampleRate)
+    {
+        // The worker thread of a progressive load must be done with the previous samples
+        stopLoading();
+
+        // Copy the new audio samples
+        m_floatSamples.assign(samples, samples + sampleCount);
+        m_samples.clear();
+
+        // Update the internal buffer with the new samples
+        return update(channelCount, sampleRate);
+    }
+    else
+    {
+        // Error...
+        err() << "Failed to load sound buffer from float samples ("
+              << "array: "      << samples      << ", "
+              << "count: "      << sampleCount  << ", "
+              << "channels: "   << channelCount << ", "
+              << "samplerate: " << sampleRate   << ")"
+              << std::endl;
+
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadProgressivelyFromFile(const std::string& filename, Time chunkDuration)
+{
+    stopLoading();
+
+    std::auto_ptr<Loader> loader(new Loader(*this));
+    if (!loader->file.openFromFile(filename))
+        return false;
+
+    Uint64       sampleCount  = loader->file.getSampleCount();
+    unsigned int channelCount = loader->file.getChannelCount();
+    unsigned int sampleRate   = loader->file.getSampleRate();
+    if (!sampleCount || !channelCount || !sampleRate)
+        return false;
+
+    // Convert the chunks like update() converts whole sounds
+    unsigned int outputChannels = channelCount;
+    loader->mixToStereo = (channelCount > 2) && (priv::AudioDevice::getFormatFromChannelCount(channelCount) == 0);
+    if (loader->mixToStereo)
+        outputChannels = 2;
+
+    loader->channelCount = channelCount;
+    loader->sampleRate = priv::AudioDevice::getOutputSampleRate(sampleRate);
+    if (loader->sampleRate != sampleRate)
+        loader->resampler = new priv::Resampler(sampleRate, loader->sampleRate, outputChannels);
+
+    loader->format = priv::AudioDevice::getFormatFromChannelCount(outputChannels);
+    if (loader->format == 0)
+    {
+        err() << "Failed to load sound buffer (unsupported number of channels: " << channelCount << ")" << std::endl;
+        return false;
+    }
+
+    // Decode the first chunk, whole frames only
+    Uint64 frameCount = sampleCount / channelCount;
+    Uint64 chunkFrames = std::max<Uint64>(static_cast<Uint64>(chunkDuration.asSeconds() * sampleRate), 1);
+    loader->chunk.resize(static_cast<std::size_t>(std::min(chunkFrames, frameCount) * channelCount));
+
+    std::vector<Int16> samples(loader->chunk.size());
+    Uint64 count = loader->file.read(&samples[0], samples.size());
+    samples.resize(static_cast<std::size_t>(count));
+    if (samples.empty())
+        return false;
+
+    bool last = loader->file.getSampleOffset() >= sampleCount;
+    convertChunk(samples, channelCount, loader->mixToStereo, loader->resampler, last);
+
+    // A chunk shorter than the resampling filter may not produce any frame yet, but the buffer can't be empty
+    if (samples.empty())
+        samples.assign(outputChannels, 0);
+
+    // The sizes are those of the whole sound, the resampler may give a few samples more or less
+    Uint64 outputFrames = loader->resampler ? loader->resampler->getOutputFrameCount(frameCount) : frameCount;
+    Uint64 outputCount = outputFrames * outputChannels;
+    if (last || (samples.size() > outputCount))
+        samples.resize(static_cast<std::size_t>(outputCount), 0);
+
+    // Detach the buffer from the sounds that use it, the new buffers are bound when they are reattached
+    SoundList sounds(m_sounds);
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->resetBuffer();
+
+    deleteSegments();
+
+    m_floatSamples.clear();
+    m_samples.clear();
+    if (m_keepSamples)
+    {
+        m_samples.assign(static_cast<std::size_t>(outputCount), 0);
+        std::memcpy(&m_samples[0], &samples[0], samples.size() * sizeof(Int16));
+    }
+    else
+    {
+        std::vector<Int16>().swap(m_samples);
+        std::vector<float>().swap(m_floatSamples);
+    }
+
+    m_sampleCount = outputCount;
+    m_duration = seconds(static_cast<float>(frameCount) / sampleRate);
+
+    alCheck(alBufferData(m_buffer, loader->format, &samples[0], static_cast<ALsizei>(samples.size() * sizeof(Int16)), loader->sampleRate));
+    loader->loaded = samples.size();
+
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->setBuffer(*this);
+
+    // Let the worker thread decode the rest
+    m_loader = loader.release();
+    if (last)
+        m_loader->done.store(true);
+    else
+        m_loader->thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isLoading() const
+{
+    return m_loader && !m_loader->done.load(Memory::Acquire);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::waitForLoading() const
+{
+    if (m_loader)
+        m_loader->thread.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setKeepSamples(bool keep)
+{
+    m_keepSamples = keep;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::getKeepSamples() const
+{
+    return m_keepSamples;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setCompressed(bool compressed)
+{
+    m_compressed = compressed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isCompressed() const
+{
+    return m_compressed;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::saveToFile(const std::string& filename) const
 {
@@ -147,8 +457,17 @@ bool SoundBuffer::saveToFile(const std::string& filename) const
     OutputSoundFile file;
     if (file.openFromFile(filename, getSampleRate(), getChannelCount()))
     {
-        // Write the samples to the opened file
-        file.write(&m_samples[0], m_samples.size());
+        // Write the samples to the opened file, writers only take 16-bit samples
+        if (!m_floatSamples.empty())
+        {
+            std::vector<Int16> samples(m_floatSamples.size());
+            convertSamples(&m_floatSamples[0], &samples[0], samples.size());
+            file.write(&samples[0], samples.size());
+        }
+        else if (!m_samples.empty())
+        {
+            file.write(&m_samples[0], m_samples.size());
+        }
 
         return true;
     }
@@ -166,10 +485,17 @@ const Int16* SoundBuffer::getSamples() const
 }
 
 
+////////////////////////////////////////////////////////////
+const float* SoundBuffer::getFloatSamples() const
+{
+    return m_floatSamples.empty() ? NULL : &m_floatSamples[0];
+}
+
+
 ////////////////////////////////////////////////////////////
 Uint64 SoundBuffer::getSampleCount() const
 {
-    return m_samples.size();
+    return m_sampleCount;
 }
 
 
@@ -205,15 +531,42 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
     SoundBuffer temp(right);
 
-    std::swap(m_samples,  temp.m_samples);
-    std::swap(m_buffer,   temp.m_buffer);
-    std::swap(m_duration, temp.m_duration);
-    std::swap(m_sounds,   temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    // The worker thread of a progressive load writes to this instance, not the swapped one
+    stopLoading();
+
+    swap(temp); // swap sounds too, so that they are detached when temp is destroyed
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::swap(SoundBuffer& right)
+{
+    // The worker threads of progressive loads write to their own instance, let them finish
+    waitForLoading();
+    right.waitForLoading();
+    stopLoading();
+    right.stopLoading();
+
+    std::swap(m_samples,      right.m_samples);
+    std::swap(m_floatSamples, right.m_floatSamples);
+    std::swap(m_buffer,       right.m_buffer);
+    std::swap(m_segments,     right.m_segments);
+    std::swap(m_sampleCount,  right.m_sampleCount);
+    std::swap(m_keepSamples,  right.m_keepSamples);
+    std::swap(m_compressed,   right.m_compressed);
+    std::swap(m_duration,     right.m_duration);
+    std::swap(m_sounds,       right.m_sounds);
+
+    // The sounds follow the OpenAL buffers that they are playing
+    for (SoundList::const_iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+        (*it)->m_buffer = this;
+    for (SoundList::const_iterator it = right.m_sounds.begin(); it != right.m_sounds.end(); ++it)
+        (*it)->m_buffer = &right;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::initialize(InputSoundFile& file)
 {
@@ -222,7 +575,11 @@ bool SoundBuffer::initialize(InputSoundFile& file)
     unsigned int channelCount = file.getChannelCount();
     unsigned int sampleRate   = file.getSampleRate();
 
+    // The worker thread of a progressive load must be done with the previous samples
+    stopLoading();
+
     // Read the samples from the provided file
+    m_floatSamples.clear();
     m_samples.resize(static_cast<std::size_t>(sampleCount));
     if (file.read(&m_samples[0], sampleCount) == sampleCount)
     {
@@ -240,11 +597,51 @@ bool SoundBuffer::initialize(InputSoundFile& file)
 bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
 {
     // Check parameters
-    if (!channelCount || !sampleRate || m_samples.empty())
+    if (!channelCount || !sampleRate || (m_samples.empty() && m_floatSamples.empty()))
         return false;
 
-    // Find the good format according to the number of channels
-    ALenum format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    // Float samples are uploaded as they are if the device supports it
+    bool floatSamples = !m_floatSamples.empty();
+
+    // Convert the samples once if the device can't play them as they are,
+    // or if they must match its sample rate; they keep their sample type
+    bool mixToStereo = (channelCount > 2) && (priv::AudioDevice::getFormatFromChannelCount(channelCount) == 0);
+    unsigned int outputRate = priv::AudioDevice::getOutputSampleRate(sampleRate);
+    if (mixToStereo || (outputRate != sampleRate))
+    {
+        std::vector<float> samples;
+        if (floatSamples)
+        {
+            samples.swap(m_floatSamples);
+        }
+        else
+        {
+            samples.resize(m_samples.size());
+            for (std::size_t i = 0; i < m_samples.size(); ++i)
+                samples[i] = m_samples[i] / 32768.f;
+        }
+
+        matchDeviceFormat(samples, channelCount, sampleRate, mixToStereo, outputRate);
+
+        if (floatSamples)
+        {
+            m_floatSamples.swap(samples);
+        }
+        else
+        {
+            m_samples.resize(samples.size());
+            if (!samples.empty())
+                convertSamples(&samples[0], &m_samples[0], samples.size());
+        }
+    }
+    ALenum format = 0;
+    if (floatSamples)
+        format = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
+
+    // Otherwise find the good 16-bit format according to the number of channels
+    bool convert = floatSamples && (format == 0);
+    if (format == 0)
+        format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
 
     // Check if the format is valid
     if (format == 0)
@@ -253,6 +650,9 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
         return false;
     }
 
+    // Encode the samples to ADPCM if requested, when the device can decode them
+    int compressedFormat = m_compressed ? priv::AudioDevice::getIma4FormatFromChannelCount(channelCount) : 0;
+
     // First make a copy of the list of sounds so we can reattach later
     SoundList sounds(m_sounds);
 
@@ -260,12 +660,48 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
         (*it)->resetBuffer();
 
+    deleteSegments();
+
     // Fill the buffer
-    ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
-    alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
+    std::size_t sampleCount = floatSamples ? m_floatSamples.size() : m_samples.size();
+    m_sampleCount = sampleCount;
+    if (compressedFormat != 0)
+    {
+        std::vector<Int16> converted;
+        if (floatSamples)
+        {
+            converted.resize(sampleCount);
+            convertSamples(&m_floatSamples[0], &converted[0], sampleCount);
+        }
+
+        std::vector<Uint8> encoded;
+        priv::encodeIma4(encoded, floatSamples ? &converted[0] : &m_samples[0], sampleCount / channelCount, channelCount);
+        alCheck(alBufferData(m_buffer, compressedFormat, &encoded[0], static_cast<ALsizei>(encoded.size()), sampleRate));
+    }
+    else if (convert)
+    {
+        std::vector<Int16> converted(sampleCount);
+        convertSamples(&m_floatSamples[0], &converted[0], sampleCount);
+        alCheck(alBufferData(m_buffer, format, &converted[0], static_cast<ALsizei>(sampleCount * sizeof(Int16)), sampleRate));
+    }
+    else if (floatSamples)
+    {
+        alCheck(alBufferData(m_buffer, format, &m_floatSamples[0], static_cast<ALsizei>(sampleCount * sizeof(float)), sampleRate));
+    }
+    else
+    {
+        alCheck(alBufferData(m_buffer, format, &m_samples[0], static_cast<ALsizei>(sampleCount * sizeof(Int16)), sampleRate));
+    }
 
     // Compute the duration
-    m_duration = seconds(static_cast<float>(m_samples.size()) / sampleRate / channelCount);
+    m_duration = seconds(static_cast<float>(sampleCount) / sampleRate / channelCount);
+
+    // Release the samples once the device has its copy
+    if (!m_keepSamples)
+    {
+        std::vector<Int16>().swap(m_samples);
+        std::vector<float>().swap(m_floatSamples);
+    }
 
     // Now reattach the buffer to the sounds that use it
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
@@ -275,16 +711,112 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::loadRemaining()
+{
+    Loader& loader = *m_loader;
+    Uint64 sampleCount = loader.file.getSampleCount();
+
+    while (!loader.cancelled.load(Memory::Acquire) && (loader.loaded < m_sampleCount))
+    {
+        Uint64 count = loader.file.read(&loader.chunk[0], loader.chunk.size());
+        bool last = (count < loader.chunk.size()) || (loader.file.getSampleOffset() >= sampleCount);
+
+        std::vector<Int16> samples(loader.chunk.begin(), loader.chunk.begin() + static_cast<std::size_t>(count));
+        convertChunk(samples, loader.channelCount, loader.mixToStereo, loader.resampler, last);
+
+        // Keep the sample count announced when the load started
+        Uint64 remaining = m_sampleCount - loader.loaded;
+        if (last || (samples.size() > remaining))
+            samples.resize(static_cast<std::size_t>(remaining), 0);
+
+        if (!samples.empty())
+            appendChunk(samples);
+
+        if (last)
+            break;
+    }
+
+    // The file stays open until the next load, only the chunk is freed
+    std::vector<Int16>().swap(loader.chunk);
+
+    loader.done.store(true, Memory::Release);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::appendChunk(const std::vector<Int16>& samples)
+{
+    unsigned int buffer = 0;
+    alCheck(alGenBuffers(1, &buffer));
+    alCheck(alBufferData(buffer, m_loader->format, &samples[0], static_cast<ALsizei>(samples.size() * sizeof(Int16)), m_loader->sampleRate));
+
+    // The array was allocated for the whole sound, it never moves
+    if (!m_samples.empty())
+        std::memcpy(&m_samples[static_cast<std::size_t>(m_loader->loaded)], &samples[0], samples.size() * sizeof(Int16));
+    m_loader->loaded += samples.size();
+
+    // Sounds attached from now on queue the new buffer themselves
+    Lock lock(m_mutex);
+
+    m_segments.push_back(buffer);
+    for (SoundList::const_iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+        alCheck(alSourceQueueBuffers((*it)->m_source, 1, &buffer));
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::stopLoading()
+{
+    if (!m_loader)
+        return;
+
+    m_loader->cancelled.store(true, Memory::Release);
+    m_loader->thread.wait();
+
+    delete m_loader;
+    m_loader = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::deleteSegments()
+{
+    if (!m_segments.empty())
+        alCheck(alDeleteBuffers(static_cast<ALsizei>(m_segments.size()), &m_segments[0]));
+
+    m_segments.clear();
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundBuffer::attachSound(Sound* sound) const
 {
+    Lock lock(m_mutex);
+
     m_sounds.insert(sound);
+
+    // A progressively loaded sound is a queue of buffers, the others are static
+    if (m_segments.empty())
+    {
+        alCheck(alSourcei(sound->m_source, AL_BUFFER, m_buffer));
+    }
+    else
+    {
+        std::vector<ALuint> buffers(1, m_buffer);
+        buffers.insert(buffers.end(), m_segments.begin(), m_segments.end());
+
+        alCheck(alSourcei(sound->m_source, AL_BUFFER, 0));
+        alCheck(alSourceQueueBuffers(sound->m_source, static_cast<ALsizei>(buffers.size()), &buffers[0]));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundBuffer::detachSound(Sound* sound) const
 {
+    Lock lock(m_mutex);
+
     m_sounds.erase(sound);
 }
 
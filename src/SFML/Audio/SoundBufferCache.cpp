@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundBufferCache.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+    // Build the identifier of a file in memory from a 64-bit FNV-1a hash of its contents
+    std::string memoryKey(const void* data, std::size_t sizeInBytes)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < sizeInBytes; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+
+        // File paths are prefixed differently, so that they can't collide with hashes
+        std::ostringstream key;
+        key << "memory:" << std::hex << hash << ':' << sizeInBytes;
+        return key.str();
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundBufferCache::SoundBufferCache() :
+m_mutex  (),
+m_entries(),
+m_budget (0),
+m_usage  (0),
+m_clock  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferCache::~SoundBufferCache()
+{
+    for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->second.buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer* SoundBufferCache::acquireFromFile(const std::string& filename)
+{
+    return acquire("file:" + filename, NULL, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer* SoundBufferCache::acquireFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    if (!data || (sizeInBytes == 0))
+    {
+        err() << "Failed to load sound buffer from memory: no data" << std::endl;
+        return NULL;
+    }
+
+    return acquire(memoryKey(data, sizeInBytes), data, sizeInBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer* SoundBufferCache::acquireFromStream(InputStream& stream)
+{
+    // The whole contents are needed to identify the stream
+    if (stream.seek(0) == -1)
+    {
+        err() << "Failed to load sound buffer from stream: cannot seek to the beginning" << std::endl;
+        return NULL;
+    }
+
+    std::vector<char> contents;
+    char chunk[4096];
+    Int64 count;
+    while ((count = stream.read(chunk, sizeof(chunk))) > 0)
+        contents.insert(contents.end(), chunk, chunk + count);
+
+    if (contents.empty())
+    {
+        err() << "Failed to load sound buffer from stream: no data" << std::endl;
+        return NULL;
+    }
+
+    return acquire(memoryKey(&contents[0], contents.size()), &contents[0], contents.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferCache::release(const SoundBuffer* buffer)
+{
+    if (!buffer)
+        return;
+
+    Lock lock(m_mutex);
+
+    for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->second.buffer == buffer)
+        {
+            if (it->second.useCount == 0)
+            {
+                err() << "Failed to release sound buffer: it was already released" << std::endl;
+                return;
+            }
+
+            it->second.useCount--;
+            it->second.lastUse = m_clock++;
+
+            // The buffer may now be evicted
+            evict();
+            return;
+        }
+    }
+
+    err() << "Failed to release sound buffer: it doesn't belong to the cache" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferCache::setMemoryBudget(std::size_t sizeInBytes)
+{
+    Lock lock(m_mutex);
+
+    m_budget = sizeInBytes;
+    evict();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferCache::getMemoryBudget() const
+{
+    Lock lock(m_mutex);
+
+    return m_budget;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferCache::getMemoryUsage() const
+{
+    Lock lock(m_mutex);
+
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferCache::clear()
+{
+    Lock lock(m_mutex);
+
+    EntryMap::iterator it = m_entries.begin();
+    while (it != m_entries.end())
+    {
+        if (it->second.useCount == 0)
+        {
+            m_usage -= it->second.size;
+            delete it->second.buffer;
+            m_entries.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundBufferCache::getCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundBuffer* SoundBufferCache::acquire(const std::string& key, const void* data, std::size_t sizeInBytes)
+{
+    Lock lock(m_mutex);
+
+    // Share the buffer if the source is already cached
+    EntryMap::iterator it = m_entries.find(key);
+    if (it != m_entries.end())
+    {
+        it->second.useCount++;
+        it->second.lastUse = m_clock++;
+        return it->second.buffer;
+    }
+
+    // Otherwise decode it
+    SoundBuffer* buffer = new SoundBuffer;
+    bool loaded = data ? buffer->loadFromMemory(data, sizeInBytes) : buffer->loadFromFile(key.substr(5));
+    if (!loaded)
+    {
+        delete buffer;
+        return NULL;
+    }
+
+    Entry entry;
+    entry.buffer = buffer;
+    entry.size = static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(Int16);
+    entry.useCount = 1;
+    entry.lastUse = m_clock++;
+    m_entries.insert(std::make_pair(key, entry));
+    m_usage += entry.size;
+
+    // Make room for the new buffer
+    evict();
+
+    return buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferCache::evict()
+{
+    if (m_budget == 0)
+        return;
+
+    while (m_usage > m_budget)
+    {
+        // Find the released buffer that was used least recently
+        EntryMap::iterator oldest = m_entries.end();
+        for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if ((it->second.useCount == 0) && ((oldest == m_entries.end()) || (it->second.lastUse < oldest->second.lastUse)))
+                oldest = it;
+        }
+
+        // Buffers in use are never evicted
+        if (oldest == m_entries.end())
+            return;
+
+        m_usage -= oldest->second.size;
+        delete oldest->second.buffer;
+        m_entries.erase(oldest);
+    }
+}
+
+} // namespace sf
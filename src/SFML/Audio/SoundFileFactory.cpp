@@ -30,9 +30,13 @@
 #include <SFML/Audio/SoundFileWriterFlac.hpp>
 #include <SFML/Audio/SoundFileReaderOgg.hpp>
 #include <SFML/Audio/SoundFileWriterOgg.hpp>
+#ifdef SFML_AUDIO_OPUS
+    #include <SFML/Audio/SoundFileReaderOpus.hpp>
+    #include <SFML/Audio/SoundFileWriterOpus.hpp>
+#endif
 #include <SFML/Audio/SoundFileReaderWav.hpp>
 #include <SFML/Audio/SoundFileWriterWav.hpp>
-#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/BufferedInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 
@@ -49,6 +53,10 @@ namespace
             sf::SoundFileFactory::registerWriter<sf::priv::SoundFileWriterFlac>();
             sf::SoundFileFactory::registerReader<sf::priv::SoundFileReaderOgg>();
             sf::SoundFileFactory::registerWriter<sf::priv::SoundFileWriterOgg>();
+#ifdef SFML_AUDIO_OPUS
+            sf::SoundFileFactory::registerReader<sf::priv::SoundFileReaderOpus>();
+            sf::SoundFileFactory::registerWriter<sf::priv::SoundFileWriterOpus>();
+#endif
             sf::SoundFileFactory::registerReader<sf::priv::SoundFileReaderWav>();
             sf::SoundFileFactory::registerWriter<sf::priv::SoundFileWriterWav>();
             registered = true;
@@ -68,8 +76,9 @@ SoundFileReader* SoundFileFactory::createReaderFromFilename(const std::string& f
     // Register the built-in readers/writers on first call
     ensureDefaultReadersWritersRegistered();
 
-    // Wrap the input file into a file stream
-    FileInputStream stream;
+    // Wrap the input file into a file stream; the readers check its
+    // first bytes, which the buffer keeps around for all of them
+    BufferedInputStream stream(4096);
     if (!stream.open(filename)) {
         err() << "Failed to open sound file \"" << filename << "\" (couldn't open stream)" << std::endl;
         return NULL;
@@ -26,8 +26,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
+#include <SFML/Audio/SampleKernels.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -107,49 +109,41 @@ namespace
     {
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
 
-        // Reserve memory if we're going to use the leftovers buffer
-        unsigned int frameSamples = frame->header.blocksize * frame->header.channels;
-        if (data->remaining < frameSamples)
-            data->leftovers.reserve(static_cast<std::size_t>(frameSamples - data->remaining));
+        const unsigned int channelCount = frame->header.channels;
+        const unsigned int bitsPerSample = frame->header.bits_per_sample;
+        const std::size_t frameCount = frame->header.blocksize;
+        std::size_t first = 0;
 
-        // Decode the samples
-        for (unsigned i = 0; i < frame->header.blocksize; ++i)
+        // Convert as many whole frames as fit straight into the output buffer
+        if (data->buffer && data->remaining > 0)
         {
-            for (unsigned int j = 0; j < frame->header.channels; ++j)
+            first = std::min(static_cast<std::size_t>(data->remaining / channelCount), frameCount);
+            sf::priv::interleaveSamples(data->buffer, buffer, channelCount, 0, first, bitsPerSample);
+            data->buffer += first * channelCount;
+            data->remaining -= first * channelCount;
+        }
+
+        if (first < frameCount)
+        {
+            // We are either seeking (null buffer) or have filled all the requested samples during a
+            // normal read, so the rest of the frame goes to the leftovers buffer until next call
+            std::size_t end = data->leftoverOffset + data->leftoverCount;
+            std::size_t count = (frameCount - first) * channelCount;
+            if (data->leftovers.size() < end + count)
+                data->leftovers.resize(end + count);
+
+            sf::priv::interleaveSamples(&data->leftovers[end], buffer, channelCount, first, frameCount - first, bitsPerSample);
+            data->leftoverCount += count;
+
+            // Fill what is left of the output buffer, it's smaller than a single frame
+            if (data->buffer && data->remaining > 0)
             {
-                // Decode the current sample
-                sf::Int16 sample = 0;
-                switch (frame->header.bits_per_sample)
-                {
-                    case 8:
-                        sample = buffer[j][i] << 8;
-                        break;
-                    case 16:
-                        sample = buffer[j][i];
-                        break;
-                    case 24:
-                        sample = buffer[j][i] >> 8;
-                        break;
-                    case 32:
-                        sample = buffer[j][i] >> 16;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                }
-
-                if (data->buffer && data->remaining > 0)
-                {
-                    // If there's room in the output buffer, copy the sample there
-                    *data->buffer++ = sample;
-                    data->remaining--;
-                }
-                else
-                {
-                    // We are either seeking (null buffer) or have decoded all the requested samples during a
-                    // normal read (0 remaining), so we put the sample in a temporary buffer until next call
-                    data->leftovers.push_back(sample);
-                }
+                std::size_t partial = std::min(static_cast<std::size_t>(data->remaining), data->leftoverCount);
+                std::copy(&data->leftovers[data->leftoverOffset], &data->leftovers[data->leftoverOffset] + partial, data->buffer);
+                data->buffer += partial;
+                data->remaining -= partial;
+                data->leftoverOffset += partial;
+                data->leftoverCount -= partial;
             }
         }
 
@@ -165,6 +159,11 @@ namespace
             data->info.sampleCount = meta->data.stream_info.total_samples * meta->data.stream_info.channels;
             data->info.sampleRate = meta->data.stream_info.sample_rate;
             data->info.channelCount = meta->data.stream_info.channels;
+
+            // Leftovers never hold more than one frame, so the buffer is allocated once here
+            data->leftovers.resize(meta->data.stream_info.max_blocksize * meta->data.stream_info.channels);
+            data->leftoverOffset = 0;
+            data->leftoverCount = 0;
         }
     }
 
@@ -257,7 +256,8 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
     // Reset the callback data (the "write" callback will be called)
     m_clientData.buffer = NULL;
     m_clientData.remaining = 0;
-    m_clientData.leftovers.clear();
+    m_clientData.leftoverOffset = 0;
+    m_clientData.leftoverCount = 0;
 
     // FLAC decoder expects absolute sample offset, so we take the channel count out
     if (sampleOffset < m_clientData.info.sampleCount)
@@ -273,7 +273,8 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
         FLAC__stream_decoder_skip_single_frame(m_decoder);
 
         // This was re-populated during the seek, but we're skipping everything in this, so we need it emptied
-        m_clientData.leftovers.clear();
+        m_clientData.leftoverOffset = 0;
+        m_clientData.leftoverCount = 0;
     }
 }
 
@@ -283,29 +284,25 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
 {
     assert(m_decoder);
 
-    // If there are leftovers from previous call, use it first
-    std::size_t left = m_clientData.leftovers.size();
+    // If there are leftovers from previous call, use them first
+    std::size_t left = std::min(m_clientData.leftoverCount, static_cast<std::size_t>(maxCount));
     if (left > 0)
     {
-        if (left > maxCount)
-        {
-            // There are more leftovers than needed
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::size_t>(maxCount), samples);
-            std::vector<Int16> leftovers(m_clientData.leftovers.begin() + static_cast<std::size_t>(maxCount), m_clientData.leftovers.end());
-            m_clientData.leftovers.swap(leftovers);
-            return maxCount;
-        }
-        else
-        {
-            // We can use all the leftovers and decode new frames
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
-        }
+        const Int16* leftovers = &m_clientData.leftovers[m_clientData.leftoverOffset];
+        std::copy(leftovers, leftovers + left, samples);
+        m_clientData.leftoverOffset += left;
+        m_clientData.leftoverCount -= left;
     }
 
+    // There were more leftovers than needed
+    if (m_clientData.leftoverCount > 0)
+        return maxCount;
+
     // Reset the data that will be used in the callback
     m_clientData.buffer = samples + left;
     m_clientData.remaining = maxCount - left;
-    m_clientData.leftovers.clear();
+    m_clientData.leftoverOffset = 0;
+    m_clientData.leftoverCount = 0;
 
     // Decode frames one by one until we reach the requested sample count, the end of file or an error
     while (m_clientData.remaining > 0)
@@ -118,6 +118,8 @@ public:
         Int16*                buffer;
         Uint64                remaining;
         std::vector<Int16>    leftovers;
+        std::size_t           leftoverOffset;
+        std::size_t           leftoverCount;
         bool                  error;
     };
 
@@ -89,7 +89,9 @@ bool SoundFileReaderOgg::check(InputStream& stream)
 ////////////////////////////////////////////////////////////
 SoundFileReaderOgg::SoundFileReaderOgg() :
 m_vorbis      (),
-m_channelCount(0)
+m_channelCount(0),
+m_seekIndex   (),
+m_seekInterval(0)
 {
     m_vorbis.datasource = NULL;
 }
@@ -122,6 +124,10 @@ bool SoundFileReaderOgg::open(InputStream& stream, Info& info)
     // We must keep the channel count for the seek function
     m_channelCount = info.channelCount;
 
+    // Index a position every quarter of a second, so that an indexed seek never decodes much in vain
+    m_seekInterval = std::max(info.sampleRate / 4, 1u);
+    recordSeekPoint();
+
     return true;
 }
 
@@ -131,7 +137,11 @@ void SoundFileReaderOgg::seek(Uint64 sampleOffset)
 {
     assert(m_vorbis.datasource);
 
-    ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
+    Uint64 frame = sampleOffset / m_channelCount;
+
+    // Jump directly to a position that was already decoded, bisect the file otherwise
+    if (!seekIndexed(frame))
+        ov_pcm_seek(&m_vorbis, frame);
 }
 
 
@@ -151,6 +161,7 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
             long samplesRead = bytesRead / sizeof(Int16);
             count += samplesRead;
             samples += samplesRead;
+            recordSeekPoint();
         }
         else
         {
@@ -163,6 +174,38 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOgg::readFloat(float* samples, Uint64 maxCount)
+{
+    assert(m_vorbis.datasource);
+
+    // Vorbis decodes to floats natively, we just have to interleave the channels
+    Uint64 frameCount = maxCount / m_channelCount;
+    Uint64 count = 0;
+    while (count < frameCount)
+    {
+        float** channels;
+        long framesRead = ov_read_float(&m_vorbis, &channels, static_cast<int>(std::min<Uint64>(frameCount - count, 4096)), NULL);
+        if (framesRead > 0)
+        {
+            for (long i = 0; i < framesRead; ++i)
+                for (unsigned int j = 0; j < m_channelCount; ++j)
+                    *samples++ = channels[j][i];
+
+            count += framesRead;
+            recordSeekPoint();
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count * m_channelCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
@@ -171,7 +214,80 @@ void SoundFileReaderOgg::close()
         ov_clear(&m_vorbis);
         m_vorbis.datasource = NULL;
         m_channelCount = 0;
+        m_seekIndex.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::recordSeekPoint()
+{
+    ogg_int64_t frame = ov_pcm_tell(&m_vorbis);
+    ogg_int64_t offset = ov_raw_tell(&m_vorbis);
+    if ((frame < 0) || (offset < 0))
+        return;
+
+    // Points are only appended past the last one, which keeps the index sorted
+    if (m_seekIndex.empty() || (static_cast<Uint64>(frame) >= m_seekIndex.back().frame + m_seekInterval))
+    {
+        SeekPoint point;
+        point.frame = static_cast<Uint64>(frame);
+        point.offset = offset;
+        m_seekIndex.push_back(point);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::seekIndexed(Uint64 frame)
+{
+    // Find the last point recorded before the frame
+    std::size_t first = 0;
+    std::size_t last = m_seekIndex.size();
+    while (first < last)
+    {
+        std::size_t middle = first + (last - first) / 2;
+        if (m_seekIndex[middle].frame <= frame)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    if (first == 0)
+        return false;
+
+    // A raw seek lands on the page that follows the recorded offset, which may start
+    // a little after the recorded frame; the previous point is then used instead
+    for (std::size_t i = first; (i > 0) && (i + 1 >= first); --i)
+    {
+        const SeekPoint& point = m_seekIndex[i - 1];
+
+        // Points are not recorded across the ranges skipped by seeks, don't decode through a gap
+        if (frame - point.frame > 2 * m_seekInterval)
+            return false;
+
+        if (ov_raw_seek(&m_vorbis, point.offset) != 0)
+            return false;
+
+        ogg_int64_t position = ov_pcm_tell(&m_vorbis);
+        if ((position < 0) || (static_cast<Uint64>(position) > frame))
+            continue;
+
+        // Decode and drop the frames that precede the requested one
+        while (static_cast<Uint64>(position) < frame)
+        {
+            float** channels;
+            long framesRead = ov_read_float(&m_vorbis, &channels, static_cast<int>(std::min<Uint64>(frame - position, 4096)), NULL);
+            if (framesRead <= 0)
+                return false;
+
+            position += framesRead;
+        }
+
+        return true;
     }
+
+    return false;
 }
 
 } // namespace priv
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <vorbis/vorbisfile.h>
+#include <vector>
 
 
 namespace sf
@@ -105,6 +106,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file as floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 readFloat(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -113,11 +125,39 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the current position to the seek index if it is far enough from the last one
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordSeekPoint();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump to a frame using the seek index
+    ///
+    /// \param frame Index of the frame to jump to
+    ///
+    /// \return True on success, false if the index doesn't cover the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekIndexed(Uint64 frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Position of a page in the file, recorded while decoding
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SeekPoint
+    {
+        Uint64 frame;  ///< Frame being decoded when the point was recorded
+        Int64  offset; ///< Byte offset of the next page at that time
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    OggVorbis_File m_vorbis;       // ogg/vorbis file handle
-    unsigned int   m_channelCount; // number of channels of the open sound file
+    OggVorbis_File         m_vorbis;       // ogg/vorbis file handle
+    unsigned int           m_channelCount; // number of channels of the open sound file
+    std::vector<SeekPoint> m_seekIndex;    // positions already decoded, sorted by frame
+    Uint64                 m_seekInterval; // minimum number of frames between two seek points
 };
 
 } // namespace priv
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileReaderOpus.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cassert>
+#include <vector>
+
+
+namespace
+{
+    int opusRead(void* data, unsigned char* ptr, int bytes)
+    {
+        sf::InputStream* stream = static_cast<sf::InputStream*>(data);
+        sf::Int64 count = stream->read(ptr, bytes);
+        return count >= 0 ? static_cast<int>(count) : -1;
+    }
+
+    int opusSeek(void* data, opus_int64 offset, int whence)
+    {
+        sf::InputStream* stream = static_cast<sf::InputStream*>(data);
+        switch (whence)
+        {
+            case SEEK_SET:
+                break;
+            case SEEK_CUR:
+                offset += stream->tell();
+                break;
+            case SEEK_END:
+                offset += stream->getSize();
+                break;
+        }
+        return stream->seek(offset) == offset ? 0 : -1;
+    }
+
+    opus_int64 opusTell(void* data)
+    {
+        sf::InputStream* stream = static_cast<sf::InputStream*>(data);
+        return stream->tell();
+    }
+
+    const OpusFileCallbacks opusCallbacks = {&opusRead, &opusSeek, &opusTell, NULL};
+}
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOpus::check(InputStream& stream)
+{
+    // Only the headers are parsed, the stream is not scanned for its length
+    OggOpusFile* file = op_test_callbacks(&stream, &opusCallbacks, NULL, 0, NULL);
+    if (file)
+    {
+        op_free(file);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileReaderOpus::SoundFileReaderOpus() :
+m_opus        (NULL),
+m_channelCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileReaderOpus::~SoundFileReaderOpus()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOpus::open(InputStream& stream, Info& info)
+{
+    // Open the Opus stream
+    int error = 0;
+    m_opus = op_open_callbacks(&stream, &opusCallbacks, NULL, 0, &error);
+    if (!m_opus)
+    {
+        err() << "Failed to open Opus file for reading" << std::endl;
+        return false;
+    }
+
+    // Retrieve the music attributes
+    info.channelCount = static_cast<unsigned int>(op_channel_count(m_opus, -1));
+    info.sampleRate = 48000;
+    info.sampleCount = static_cast<Uint64>(std::max<ogg_int64_t>(op_pcm_total(m_opus, -1), 0)) * info.channelCount;
+
+    // We must keep the channel count for the seek function
+    m_channelCount = info.channelCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOpus::seek(Uint64 sampleOffset)
+{
+    assert(m_opus);
+
+    ogg_int64_t offset = static_cast<ogg_int64_t>(sampleOffset / m_channelCount);
+    ogg_int64_t total = op_pcm_total(m_opus, -1);
+    if (offset < total)
+    {
+        op_pcm_seek(m_opus, offset);
+    }
+    else if (total > 0)
+    {
+        // Opus can't seek straight to the end, so we seek to the last sample and skip it
+        op_pcm_seek(m_opus, total - 1);
+        std::vector<float> last(m_channelCount);
+        op_read_float(m_opus, &last[0], static_cast<int>(m_channelCount), NULL);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOpus::read(Int16* samples, Uint64 maxCount)
+{
+    assert(m_opus);
+
+    // Try to read the requested number of samples, stop only on error or end of file
+    Uint64 count = 0;
+    while (count < maxCount)
+    {
+        int samplesToRead = static_cast<int>(std::min<Uint64>(maxCount - count, 65536));
+        int framesRead = op_read(m_opus, samples, samplesToRead, NULL);
+        if (framesRead > 0)
+        {
+            Uint64 samplesRead = static_cast<Uint64>(framesRead) * m_channelCount;
+            count += samplesRead;
+            samples += samplesRead;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOpus::readFloat(float* samples, Uint64 maxCount)
+{
+    assert(m_opus);
+
+    // Opus decodes to floats natively, it skips the conversion to 16 bits
+    Uint64 count = 0;
+    while (count < maxCount)
+    {
+        int samplesToRead = static_cast<int>(std::min<Uint64>(maxCount - count, 65536));
+        int framesRead = op_read_float(m_opus, samples, samplesToRead, NULL);
+        if (framesRead > 0)
+        {
+            Uint64 samplesRead = static_cast<Uint64>(framesRead) * m_channelCount;
+            count += samplesRead;
+            samples += samplesRead;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOpus::close()
+{
+    if (m_opus)
+    {
+        op_free(m_opus);
+        m_opus = NULL;
+        m_channelCount = 0;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
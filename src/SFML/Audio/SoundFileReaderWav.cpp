@@ -88,6 +88,81 @@ namespace
         return true;
     }
 
+    // The following functions convert blocks of little endian samples
+    // to 16-bit samples in the host byte order
+
+    bool isLittleEndianHost()
+    {
+        const sf::Uint16 probe = 1;
+        return *reinterpret_cast<const sf::Uint8*>(&probe) == 1;
+    }
+
+    void swapBytes(sf::Int16* samples, sf::Uint64 count)
+    {
+        sf::Uint8* bytes = reinterpret_cast<sf::Uint8*>(samples);
+
+        for (sf::Uint64 i = 0; i < count; ++i)
+            std::swap(bytes[i * 2], bytes[i * 2 + 1]);
+    }
+
+    void convert8bit(const sf::Uint8* bytes, sf::Int16* samples, sf::Uint64 count)
+    {
+        // 8-bit samples are unsigned
+        for (sf::Uint64 i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>((static_cast<int>(bytes[i]) - 128) * 256);
+    }
+
+    void convert24bit(const sf::Uint8* bytes, sf::Int16* samples, sf::Uint64 count)
+    {
+        // Keep the two most significant bytes
+        for (sf::Uint64 i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>(bytes[i * 3 + 1] | (bytes[i * 3 + 2] << 8));
+    }
+
+    void convert32bit(const sf::Uint8* bytes, sf::Int16* samples, sf::Uint64 count)
+    {
+        // Keep the two most significant bytes
+        for (sf::Uint64 i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>(bytes[i * 4 + 2] | (bytes[i * 4 + 3] << 8));
+    }
+
+    // The following functions convert blocks of little endian samples
+    // to normalized floats, keeping all their precision
+
+    void convertFloat8bit(const sf::Uint8* bytes, float* samples, sf::Uint64 count)
+    {
+        for (sf::Uint64 i = 0; i < count; ++i)
+            samples[i] = (static_cast<int>(bytes[i]) - 128) / 128.f;
+    }
+
+    void convertFloat16bit(const sf::Uint8* bytes, float* samples, sf::Uint64 count)
+    {
+        for (sf::Uint64 i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>(bytes[i * 2] | (bytes[i * 2 + 1] << 8)) / 32768.f;
+    }
+
+    void convertFloat24bit(const sf::Uint8* bytes, float* samples, sf::Uint64 count)
+    {
+        // Place the sample in the high bytes of a 32-bit integer to keep its sign
+        for (sf::Uint64 i = 0; i < count; ++i)
+        {
+            sf::Uint32 value = (bytes[i * 3] << 8) | (bytes[i * 3 + 1] << 16) | (static_cast<sf::Uint32>(bytes[i * 3 + 2]) << 24);
+            samples[i] = static_cast<float>(static_cast<sf::Int32>(value) / 2147483648.0);
+        }
+    }
+
+    void convertFloat32bit(const sf::Uint8* bytes, float* samples, sf::Uint64 count)
+    {
+        for (sf::Uint64 i = 0; i < count; ++i)
+        {
+            sf::Uint32 value = bytes[i * 4] | (bytes[i * 4 + 1] << 8) | (bytes[i * 4 + 2] << 16) | (static_cast<sf::Uint32>(bytes[i * 4 + 3]) << 24);
+            samples[i] = static_cast<float>(static_cast<sf::Int32>(value) / 2147483648.0);
+        }
+    }
+
+    // Number of samples converted at once by read()
+    const std::size_t decodeBlockSampleCount = 1024;
+
     const sf::Uint64 mainChunkSize = 12;
 
     const sf::Uint16 waveFormatPcm = 1;
@@ -154,50 +229,98 @@ Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
 {
     assert(m_stream);
 
-    Uint64 count = 0;
-    while ((count < maxCount) && (static_cast<Uint64>(m_stream->tell()) < m_dataEnd))
+    Int64 position = m_stream->tell();
+    if ((position < 0) || (static_cast<Uint64>(position) >= m_dataEnd))
+        return 0;
+
+    Uint64 count = std::min(maxCount, (m_dataEnd - static_cast<Uint64>(position)) / m_bytesPerSample);
+
+    // 16-bit samples already have the right layout on little-endian
+    // hosts: read them straight into the destination
+    if (m_bytesPerSample == 2)
+    {
+        Int64 bytesRead = m_stream->read(samples, count * sizeof(Int16));
+        if (bytesRead <= 0)
+            return 0;
+
+        Uint64 samplesRead = static_cast<Uint64>(bytesRead) / sizeof(Int16);
+
+        if (!isLittleEndianHost())
+            swapBytes(samples, samplesRead);
+
+        return samplesRead;
+    }
+
+    // Other formats are read by blocks and converted to 16-bit samples
+    Uint8 block[decodeBlockSampleCount * 4];
+    Uint64 total = 0;
+
+    while (total < count)
     {
+        Uint64 blockCount = std::min(count - total, static_cast<Uint64>(decodeBlockSampleCount));
+
+        Int64 bytesRead = m_stream->read(block, blockCount * m_bytesPerSample);
+        if (bytesRead <= 0)
+            break;
+
+        Uint64 samplesRead = static_cast<Uint64>(bytesRead) / m_bytesPerSample;
+
         switch (m_bytesPerSample)
         {
-            case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = (static_cast<Int16>(sample) - 128) << 8;
-                else
-                    return count;
-                break;
-            }
+            case 1:  convert8bit(block, samples, samplesRead);  break;
+            case 3:  convert24bit(block, samples, samplesRead); break;
+            case 4:  convert32bit(block, samples, samplesRead); break;
 
-            case 2:
+            default:
             {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
-                break;
+                assert(false);
+                return 0;
             }
+        }
 
-            case 3:
-            {
-                Uint32 sample = 0;
-                if (decode24bit(*m_stream, sample))
-                    *samples++ = sample >> 8;
-                else
-                    return count;
-                break;
-            }
+        samples += samplesRead;
+        total += samplesRead;
 
-            case 4:
-            {
-                Uint32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample >> 16;
-                else
-                    return count;
-                break;
-            }
+        // A short read means that the stream has no more data
+        if (samplesRead < blockCount)
+            break;
+    }
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::readFloat(float* samples, Uint64 maxCount)
+{
+    assert(m_stream);
+
+    Int64 position = m_stream->tell();
+    if ((position < 0) || (static_cast<Uint64>(position) >= m_dataEnd))
+        return 0;
+
+    Uint64 count = std::min(maxCount, (m_dataEnd - static_cast<Uint64>(position)) / m_bytesPerSample);
+
+    // Samples are read by blocks and converted without going through 16 bits
+    Uint8 block[decodeBlockSampleCount * 4];
+    Uint64 total = 0;
+
+    while (total < count)
+    {
+        Uint64 blockCount = std::min(count - total, static_cast<Uint64>(decodeBlockSampleCount));
+
+        Int64 bytesRead = m_stream->read(block, blockCount * m_bytesPerSample);
+        if (bytesRead <= 0)
+            break;
+
+        Uint64 samplesRead = static_cast<Uint64>(bytesRead) / m_bytesPerSample;
+
+        switch (m_bytesPerSample)
+        {
+            case 1:  convertFloat8bit(block, samples, samplesRead);  break;
+            case 2:  convertFloat16bit(block, samples, samplesRead); break;
+            case 3:  convertFloat24bit(block, samples, samplesRead); break;
+            case 4:  convertFloat32bit(block, samples, samplesRead); break;
 
             default:
             {
@@ -206,10 +329,15 @@ Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
             }
         }
 
-        ++count;
+        samples += samplesRead;
+        total += samplesRead;
+
+        // A short read means that the stream has no more data
+        if (samplesRead < blockCount)
+            break;
     }
 
-    return count;
+    return total;
 }
 
 
@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileWriterOpus.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+    // Append little-endian integers to the header packets
+    void appendUint16(std::vector<unsigned char>& header, sf::Uint16 value)
+    {
+        header.push_back(static_cast<unsigned char>(value & 0xFF));
+        header.push_back(static_cast<unsigned char>(value >> 8));
+    }
+
+    void appendUint32(std::vector<unsigned char>& header, sf::Uint32 value)
+    {
+        appendUint16(header, static_cast<sf::Uint16>(value & 0xFFFF));
+        appendUint16(header, static_cast<sf::Uint16>(value >> 16));
+    }
+
+    void appendString(std::vector<unsigned char>& header, const char* value)
+    {
+        header.insert(header.end(), value, value + std::strlen(value));
+    }
+
+    // Largest packet libopus can produce for a single frame
+    const std::size_t maxOpusFileFrameSize = 1275 * 3 + 7;
+}
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool SoundFileWriterOpus::check(const std::string& filename)
+{
+    std::string extension = filename.substr(filename.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return extension == "opus";
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileWriterOpus::SoundFileWriterOpus() :
+m_channelCount(0),
+m_frameSize   (0),
+m_granuleScale(0),
+m_preSkip     (0),
+m_file        (),
+m_ogg         (),
+m_encoder     (NULL),
+m_pending     (),
+m_packet      (),
+m_written     (0),
+m_packetNumber(0),
+m_granule     (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileWriterOpus::~SoundFileWriterOpus()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileWriterOpus::open(const std::string& filename, unsigned int sampleRate, unsigned int channelCount)
+{
+    // Opus only encodes a few sample rates, and our files only use the mono/stereo mapping
+    if ((sampleRate != 8000) && (sampleRate != 12000) && (sampleRate != 16000) && (sampleRate != 24000) && (sampleRate != 48000))
+    {
+        err() << "Failed to write ogg/opus file \"" << filename << "\" (unsupported sample rate " << sampleRate << ")" << std::endl;
+        return false;
+    }
+
+    if ((channelCount < 1) || (channelCount > 2))
+    {
+        err() << "Failed to write ogg/opus file \"" << filename << "\" (unsupported channel count " << channelCount << ")" << std::endl;
+        return false;
+    }
+
+    // Save the format, frames last 20 ms
+    m_channelCount = channelCount;
+    m_frameSize = sampleRate / 50;
+    m_granuleScale = 48000 / sampleRate;
+
+    // Initialize the ogg/opus stream
+    ogg_stream_init(&m_ogg, std::rand());
+
+    int error = OPUS_OK;
+    m_encoder = opus_encoder_create(static_cast<opus_int32>(sampleRate), static_cast<int>(channelCount), OPUS_APPLICATION_AUDIO, &error);
+    if (error != OPUS_OK)
+    {
+        err() << "Failed to write ogg/opus file \"" << filename << "\" (" << opus_strerror(error) << ")" << std::endl;
+        m_encoder = NULL;
+        close();
+        return false;
+    }
+
+    // The decoder must skip the samples produced by the encoder delay
+    opus_int32 lookahead = 0;
+    opus_encoder_ctl(m_encoder, OPUS_GET_LOOKAHEAD(&lookahead));
+    m_preSkip = static_cast<unsigned int>(lookahead) * m_granuleScale;
+
+    // Open the file after the opus setup is ok
+    m_file.open(filename.c_str(), std::ios::binary);
+    if (!m_file)
+    {
+        err() << "Failed to write ogg/opus file \"" << filename << "\" (cannot open file)" << std::endl;
+        close();
+        return false;
+    }
+
+    // Identification header: version, channels, pre-skip, input rate, gain, mono/stereo mapping
+    std::vector<unsigned char> header;
+    appendString(header, "OpusHead");
+    header.push_back(1);
+    header.push_back(static_cast<unsigned char>(channelCount));
+    appendUint16(header, static_cast<Uint16>(m_preSkip));
+    appendUint32(header, sampleRate);
+    appendUint16(header, 0);
+    header.push_back(0);
+
+    // Comment header: vendor string and no comment
+    std::vector<unsigned char> comment;
+    appendString(comment, "OpusTags");
+    appendUint32(comment, 4);
+    appendString(comment, "SFML");
+    appendUint32(comment, 0);
+
+    // Write the header packets to the ogg stream, each on its own page as per spec
+    ogg_packet packet;
+    packet.packet = &header[0];
+    packet.bytes = static_cast<long>(header.size());
+    packet.b_o_s = 1;
+    packet.e_o_s = 0;
+    packet.granulepos = 0;
+    packet.packetno = 0;
+    ogg_stream_packetin(&m_ogg, &packet);
+    writePages(true);
+
+    packet.packet = &comment[0];
+    packet.bytes = static_cast<long>(comment.size());
+    packet.b_o_s = 0;
+    packet.packetno = 1;
+    ogg_stream_packetin(&m_ogg, &packet);
+    writePages(true);
+
+    m_packet.resize(maxOpusFileFrameSize);
+    m_packetNumber = 2;
+    m_granule = 0;
+    m_written = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::write(const Int16* samples, Uint64 count)
+{
+    m_pending.insert(m_pending.end(), samples, samples + count);
+    m_written += count / m_channelCount;
+
+    // Encode all the complete frames, and keep the rest for the next call
+    std::size_t frameSamples = m_frameSize * m_channelCount;
+    std::size_t offset = 0;
+    while (m_pending.size() - offset >= frameSamples)
+    {
+        encodeFrame(&m_pending[offset], false);
+        offset += frameSamples;
+    }
+
+    m_pending.erase(m_pending.begin(), m_pending.begin() + offset);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::encodeFrame(const Int16* samples, bool last)
+{
+    opus_int32 size = opus_encode(m_encoder, samples, static_cast<int>(m_frameSize), &m_packet[0], static_cast<opus_int32>(m_packet.size()));
+    if (size < 0)
+    {
+        err() << "Failed to encode ogg/opus frame (" << opus_strerror(size) << ")" << std::endl;
+        return;
+    }
+
+    // The granule position of the last packet trims the padding of the last frame
+    m_granule += m_frameSize * m_granuleScale;
+
+    ogg_packet packet;
+    packet.packet = &m_packet[0];
+    packet.bytes = size;
+    packet.b_o_s = 0;
+    packet.e_o_s = last ? 1 : 0;
+    packet.granulepos = last ? std::min<Int64>(m_granule, m_preSkip + m_written * m_granuleScale) : m_granule;
+    packet.packetno = m_packetNumber++;
+    ogg_stream_packetin(&m_ogg, &packet);
+
+    writePages(last);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::writePages(bool flush)
+{
+    ogg_page page;
+    while ((flush ? ogg_stream_flush(&m_ogg, &page) : ogg_stream_pageout(&m_ogg, &page)) > 0)
+    {
+        m_file.write(reinterpret_cast<const char*>(page.header), page.header_len);
+        m_file.write(reinterpret_cast<const char*>(page.body), page.body_len);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterOpus::close()
+{
+    if (m_file.is_open())
+    {
+        // Feed the encoder delay with silence so that the last samples get out,
+        // and pad the last frame
+        std::size_t frameSamples = m_frameSize * m_channelCount;
+        std::size_t padded = m_pending.size() + m_preSkip / m_granuleScale * m_channelCount;
+        padded = std::max<std::size_t>((padded + frameSamples - 1) / frameSamples, 1) * frameSamples;
+        m_pending.resize(padded, 0);
+
+        for (std::size_t offset = 0; offset < padded; offset += frameSamples)
+            encodeFrame(&m_pending[offset], offset + frameSamples == padded);
+
+        // Close the file
+        m_file.close();
+    }
+
+    // Clear all the ogg/opus structures
+    ogg_stream_clear(&m_ogg);
+    if (m_encoder)
+    {
+        opus_encoder_destroy(m_encoder);
+        m_encoder = NULL;
+    }
+
+    m_pending.clear();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDFILEWRITEROPUS_HPP
+#define SFML_SOUNDFILEWRITEROPUS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileWriter.hpp>
+#include <opus.h>
+#include <ogg/ogg.h>
+#include <fstream>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Implementation of sound file writer that handles Ogg/Opus files
+///
+////////////////////////////////////////////////////////////
+class SoundFileWriterOpus : public SoundFileWriter
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if this writer can handle a file on disk
+    ///
+    /// \param filename Path of the sound file to check
+    ///
+    /// \return True if the file can be written by this writer
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool check(const std::string& filename);
+
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundFileWriterOpus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundFileWriterOpus();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a sound file for writing
+    ///
+    /// \param filename     Path of the file to open
+    /// \param sampleRate   Sample rate of the sound
+    /// \param channelCount Number of channels of the sound
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool open(const std::string& filename, unsigned int sampleRate, unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write audio samples to the open file
+    ///
+    /// \param samples Pointer to the sample array to write
+    /// \param count   Number of samples to write
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void write(const Int16* samples, Uint64 count);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a frame and write it to the ogg stream
+    ///
+    /// \param samples Pointer to the samples of the frame
+    /// \param last    True if this is the last frame of the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    void encodeFrame(const Int16* samples, bool last);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the pages produced by the ogg stream, if any
+    ///
+    /// \param flush True to write the pending page even if not full
+    ///
+    ////////////////////////////////////////////////////////////
+    void writePages(bool flush);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int               m_channelCount; // channel count of the sound being written
+    unsigned int               m_frameSize;    // number of samples per channel of an encoded frame
+    unsigned int               m_granuleScale; // ratio of 48 kHz (the granule position rate) to the sample rate
+    unsigned int               m_preSkip;      // samples at 48 kHz to discard at the beginning, the encoder delay
+    std::ofstream              m_file;         // output file
+    ogg_stream_state           m_ogg;          // ogg stream
+    OpusEncoder*               m_encoder;      // opus encoder
+    std::vector<Int16>         m_pending;      // samples waiting for a full frame to be encoded
+    std::vector<unsigned char> m_packet;       // encoded frame
+    Uint64                     m_written;      // number of samples per channel written so far
+    Int64                      m_packetNumber; // index of the next ogg packet
+    Int64                      m_granule;      // granule position of the next ogg packet
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDFILEWRITEROPUS_HPP
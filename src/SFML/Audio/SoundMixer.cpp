@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/SampleKernels.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundMixer::SoundMixer(unsigned int channelCount, unsigned int sampleRate) :
+m_mutex    (),
+m_inputs   (),
+m_mix      (),
+m_chunk    (),
+m_blockSize(std::max(sampleRate / 50, 1u) * channelCount)
+{
+    initialize(channelCount, sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::~SoundMixer()
+{
+    // We must stop before destroying the inputs, to avoid
+    // the streaming thread pulling from them while they are destroyed
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::addStream(SoundStream& stream)
+{
+    if ((stream.getSampleRate() != getSampleRate()) || ((stream.getChannelCount() != getChannelCount()) && (stream.getChannelCount() != 1)))
+    {
+        err() << "Failed to add stream to sound mixer (stream: "
+              << stream.getChannelCount() << " channels, " << stream.getSampleRate() << " Hz, "
+              << "mixer: "
+              << getChannelCount() << " channels, " << getSampleRate() << " Hz)"
+              << std::endl;
+
+        return false;
+    }
+
+    Lock lock(m_mutex);
+
+    for (std::vector<Input>::const_iterator it = m_inputs.begin(); it != m_inputs.end(); ++it)
+    {
+        if (it->stream == &stream)
+            return true;
+    }
+
+    Input input;
+    input.stream = &stream;
+    input.offset = 0;
+    input.finished = false;
+    m_inputs.push_back(input);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::removeStream(SoundStream& stream)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Input>::iterator it = m_inputs.begin(); it != m_inputs.end(); ++it)
+    {
+        if (it->stream == &stream)
+        {
+            m_inputs.erase(it);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::clearStreams()
+{
+    Lock lock(m_mutex);
+
+    m_inputs.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundMixer::getStreamCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_inputs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::onGetData(SoundStream::Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    m_mix.assign(m_blockSize, 0.f);
+
+    std::vector<Input>::iterator it = m_inputs.begin();
+    while (it != m_inputs.end())
+    {
+        pull(*it);
+
+        // A stream that ends in the middle of the block leaves silence after it
+        std::size_t count = std::min(m_blockSize, it->pending.size());
+        if (count > 0)
+            priv::mixSamples(&m_mix[0], &it->pending[0], count, it->stream->getVolume() / 100.f);
+        it->offset = count;
+
+        // Streams that reached their end leave the mix
+        if (it->finished && (it->offset == it->pending.size()))
+            it = m_inputs.erase(it);
+        else
+            ++it;
+    }
+
+    data.samples = NULL;
+    data.floatSamples = &m_mix[0];
+    data.sampleCount = m_mix.size();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::onSeek(Time)
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Input>::iterator it = m_inputs.begin(); it != m_inputs.end(); ++it)
+    {
+        it->pending.clear();
+        it->offset = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::pull(Input& input)
+{
+    // Drop the samples mixed by the previous block
+    input.pending.erase(input.pending.begin(), input.pending.begin() + static_cast<std::ptrdiff_t>(input.offset));
+    input.offset = 0;
+
+    SoundStream& stream = *input.stream;
+    unsigned int channelCount = getChannelCount();
+    unsigned int emptyLoops = 0;
+
+    while ((input.pending.size() < m_blockSize) && !input.finished)
+    {
+        Chunk data = {NULL, 0, NULL};
+        bool more = stream.onGetData(data);
+
+        std::size_t count = (data.samples || data.floatSamples) ? data.sampleCount : 0;
+        if (count > 0)
+        {
+            // Effects run on a copy they can modify, as when the stream plays on its own
+            m_chunk.resize(count);
+            if (data.floatSamples)
+            {
+                std::copy(data.floatSamples, data.floatSamples + count, m_chunk.begin());
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    m_chunk[i] = data.samples[i] / 32768.f;
+            }
+
+            {
+                Lock effectLock(stream.m_effectMutex);
+
+                for (std::vector<SoundEffect*>::iterator it = stream.m_effects.begin(); it != stream.m_effects.end(); ++it)
+                    (*it)->process(&m_chunk[0], count / stream.m_channelCount, stream.m_channelCount, stream.m_sampleRate);
+            }
+
+            // Mono streams are played on all the channels of the mix
+            if (stream.m_channelCount == channelCount)
+            {
+                input.pending.insert(input.pending.end(), m_chunk.begin(), m_chunk.end());
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    input.pending.insert(input.pending.end(), channelCount, m_chunk[i]);
+            }
+
+            emptyLoops = 0;
+        }
+
+        if (!more)
+        {
+            // Don't loop forever on a looping stream that gives no data
+            if (stream.getLoop() && (emptyLoops++ < SoundStream::BufferRetries))
+                stream.onLoop();
+            else
+                input.finished = true;
+        }
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundPool.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/Listener.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Default attenuation parameters of the audio sources
+    const float minDistance = 1.f;
+    const float attenuation = 1.f;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundPool::SoundPool(std::size_t voiceCount, std::size_t virtualCount) :
+m_sounds      (voiceCount),
+m_freeSounds  (),
+m_voices      (),
+m_virtualCount(virtualCount),
+m_threshold   (0.001f),
+m_clock       (),
+m_nextHandle  (1)
+{
+    m_freeSounds.reserve(voiceCount);
+    for (std::vector<Sound>::reverse_iterator it = m_sounds.rbegin(); it != m_sounds.rend(); ++it)
+        m_freeSounds.push_back(&*it);
+
+    m_voices.reserve(voiceCount + virtualCount + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundPool::~SoundPool()
+{
+    stopAll();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundPool::Handle SoundPool::play(const SoundBuffer& buffer, const Vector3f& position, int priority, float volume)
+{
+    Voice voice;
+    voice.buffer = &buffer;
+    voice.position = position;
+    voice.relative = false;
+    voice.priority = priority;
+    voice.volume = volume;
+
+    return start(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundPool::Handle SoundPool::play(const SoundBuffer& buffer, int priority, float volume)
+{
+    Voice voice;
+    voice.buffer = &buffer;
+    voice.position = Vector3f(0.f, 0.f, 0.f);
+    voice.relative = true;
+    voice.priority = priority;
+    voice.volume = volume;
+
+    return start(voice);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::stop(Handle handle)
+{
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i].handle == handle)
+        {
+            remove(i);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::stopAll()
+{
+    while (!m_voices.empty())
+        remove(m_voices.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::setPosition(Handle handle, const Vector3f& position)
+{
+    for (std::vector<Voice>::iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->handle == handle)
+        {
+            if (!it->relative)
+            {
+                it->position = position;
+                if (it->sound)
+                    it->sound->setPosition(position);
+            }
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundPool::isPlaying(Handle handle) const
+{
+    for (std::vector<Voice>::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->handle == handle)
+        {
+            // The sound may have ended since the last update
+            if (it->sound)
+                return it->sound->getStatus() != Sound::Stopped;
+            else
+                return m_clock.getElapsedTime() - it->start < it->buffer->getDuration();
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::update()
+{
+    Time now = m_clock.getElapsedTime();
+
+    // Recycle the voices of the sounds that are over
+    for (std::size_t i = m_voices.size(); i > 0; --i)
+    {
+        const Voice& voice = m_voices[i - 1];
+        bool over = voice.sound ? (voice.sound->getStatus() == Sound::Stopped) : (now - voice.start >= voice.buffer->getDuration());
+        if (over)
+            remove(i - 1);
+    }
+
+    // Free the voices of the sounds that can't be heard anymore
+    for (std::size_t i = 0; i < m_voices.size(); ++i)
+    {
+        if (m_voices[i].sound && (getGain(m_voices[i]) < m_threshold))
+            makeVirtual(i);
+    }
+
+    // Give the voices to the most important virtual sounds; each iteration either
+    // fills a free voice or replaces a less important sound, so it can't cycle
+    for (std::size_t attempts = m_voices.size(); attempts > 0; --attempts)
+    {
+        std::size_t best = m_voices.size();
+        for (std::size_t i = 0; i < m_voices.size(); ++i)
+        {
+            if (!m_voices[i].sound && (getGain(m_voices[i]) >= m_threshold) &&
+                ((best == m_voices.size()) || isLessImportant(m_voices[best], m_voices[i])))
+                best = i;
+        }
+
+        if ((best == m_voices.size()) || !makeReal(best))
+            break;
+    }
+
+    trimVirtual();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::setAudibilityThreshold(float gain)
+{
+    m_threshold = gain;
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundPool::getAudibilityThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundPool::getActiveCount() const
+{
+    return m_sounds.size() - m_freeSounds.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundPool::getVirtualCount() const
+{
+    return m_voices.size() - getActiveCount();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundPool::Handle SoundPool::start(Voice voice)
+{
+    voice.handle = m_nextHandle++;
+    voice.start = m_clock.getElapsedTime();
+    voice.sound = NULL;
+    m_voices.push_back(voice);
+
+    if (getGain(voice) >= m_threshold)
+        makeReal(m_voices.size() - 1);
+
+    // The new sound may be the one dropped if there are too many virtual sounds
+    trimVirtual();
+
+    for (std::vector<Voice>::const_iterator it = m_voices.begin(); it != m_voices.end(); ++it)
+    {
+        if (it->handle == voice.handle)
+            return voice.handle;
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+float SoundPool::getGain(const Voice& voice) const
+{
+    Vector3f offset = voice.relative ? voice.position : voice.position - Listener::getPosition();
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+
+    // Same model as the audio sources (inverse distance, clamped)
+    distance = std::max(distance, minDistance);
+    float factor = minDistance / (minDistance + attenuation * (distance - minDistance));
+
+    return voice.volume * 0.01f * factor;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundPool::isLessImportant(const Voice& left, const Voice& right) const
+{
+    if (left.priority != right.priority)
+        return left.priority < right.priority;
+
+    return getGain(left) < getGain(right);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundPool::makeReal(std::size_t index)
+{
+    if (m_freeSounds.empty())
+    {
+        // Steal the voice of the least important sound, if it is less important than this one
+        std::size_t weakest = m_voices.size();
+        for (std::size_t i = 0; i < m_voices.size(); ++i)
+        {
+            if (m_voices[i].sound && ((weakest == m_voices.size()) || isLessImportant(m_voices[i], m_voices[weakest])))
+                weakest = i;
+        }
+
+        if ((weakest == m_voices.size()) || !isLessImportant(m_voices[weakest], m_voices[index]))
+            return false;
+
+        makeVirtual(weakest);
+    }
+
+    Voice& voice = m_voices[index];
+    voice.sound = m_freeSounds.back();
+    m_freeSounds.pop_back();
+
+    // Resume the sound where it would be if it had been playing all along
+    voice.sound->setBuffer(*voice.buffer);
+    voice.sound->setRelativeToListener(voice.relative);
+    voice.sound->setPosition(voice.position);
+    voice.sound->setVolume(voice.volume);
+    voice.sound->play();
+    voice.sound->setPlayingOffset(m_clock.getElapsedTime() - voice.start);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::makeVirtual(std::size_t index)
+{
+    Voice& voice = m_voices[index];
+    voice.sound->stop();
+    m_freeSounds.push_back(voice.sound);
+    voice.sound = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::trimVirtual()
+{
+    while (getVirtualCount() > m_virtualCount)
+    {
+        std::size_t weakest = m_voices.size();
+        for (std::size_t i = 0; i < m_voices.size(); ++i)
+        {
+            if (!m_voices[i].sound && ((weakest == m_voices.size()) || isLessImportant(m_voices[i], m_voices[weakest])))
+                weakest = i;
+        }
+
+        remove(weakest);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundPool::remove(std::size_t index)
+{
+    if (m_voices[index].sound)
+        makeVirtual(index);
+
+    m_voices.erase(m_voices.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+} // namespace sf
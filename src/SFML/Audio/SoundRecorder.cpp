@@ -28,8 +28,9 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -48,12 +49,19 @@ namespace sf
 ////////////////////////////////////////////////////////////
 SoundRecorder::SoundRecorder() :
 m_thread            (&SoundRecorder::record, this),
+m_stopMutex         (),
+m_stopCondition     (),
 m_sampleRate        (0),
 m_processingInterval(milliseconds(100)),
+m_frameDuration     (Time::Zero),
+m_frameSize         (0),
 m_isCapturing       (false),
 m_deviceName        (getDefaultDevice()),
 m_channelCount      (1)
 {
+    // The capture device only holds a short history: don't let other threads delay the capture
+    m_thread.setName("sfml-recorder");
+    m_thread.setPriority(Thread::RealTime);
 
 }
 
@@ -98,12 +106,18 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Clear the array of samples
-    m_samples.clear();
-
     // Store the sample rate
     m_sampleRate = sampleRate;
 
+    // Preallocate the array of samples, so that the capture never reallocates it:
+    // the capture device holds one second of audio at most
+    m_frameSize = static_cast<std::size_t>(m_frameDuration.asMicroseconds() * sampleRate / 1000000);
+    if ((m_frameDuration != Time::Zero) && (m_frameSize == 0))
+        m_frameSize = 1;
+
+    m_samples.clear();
+    m_samples.reserve(std::max<std::size_t>(sampleRate, m_frameSize) * m_channelCount);
+
     // Notify derived class
     if (onStart())
     {
@@ -127,8 +141,7 @@ void SoundRecorder::stop()
     // Stop the capturing thread if there is one
     if (m_isCapturing)
     {
-        m_isCapturing = false;
-        m_thread.wait();
+        stopThread();
 
         // Notify derived class
         onStop();
@@ -181,8 +194,7 @@ bool SoundRecorder::setDevice(const std::string& name)
     if (m_isCapturing)
     {
         // Stop the capturing thread
-        m_isCapturing = false;
-        m_thread.wait();
+        stopThread();
 
         // Determine the recording format
         ALCenum format = (m_channelCount == 1) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
@@ -258,6 +270,13 @@ void SoundRecorder::setProcessingInterval(Time interval)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setFrameDuration(Time duration)
+{
+    m_frameDuration = duration;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::onStart()
 {
@@ -278,11 +297,26 @@ void SoundRecorder::record()
 {
     while (m_isCapturing)
     {
-        // Process available samples
-        processCapturedSamples();
+        Time delay;
 
-        // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        if (m_frameSize)
+        {
+            // Process the complete frames, and wait until the next one is
+            delay = processCapturedFrames(false);
+        }
+        else
+        {
+            // Process available samples
+            processCapturedSamples();
+
+            // Don't bother the CPU while waiting for more captured data
+            delay = m_processingInterval;
+        }
+
+        // Wait, unless the capture is stopped in the meantime
+        Lock lock(m_stopMutex);
+        if (m_isCapturing)
+            m_stopCondition.wait(m_stopMutex, delay);
     }
 
     // Capture is finished: clean up everything
@@ -313,6 +347,57 @@ void SoundRecorder::processCapturedSamples()
 }
 
 
+////////////////////////////////////////////////////////////
+Time SoundRecorder::processCapturedFrames(bool flush)
+{
+    // Get the number of samples available
+    ALCint samplesAvailable;
+    alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
+
+    // Forward every complete frame, without reallocating the buffer
+    std::size_t available = samplesAvailable > 0 ? static_cast<std::size_t>(samplesAvailable) : 0;
+    m_samples.resize(m_frameSize * getChannelCount());
+
+    while (available >= m_frameSize)
+    {
+        alcCaptureSamples(captureDevice, &m_samples[0], static_cast<ALCsizei>(m_frameSize));
+        available -= m_frameSize;
+
+        if (!onProcessSamples(&m_samples[0], m_samples.size()))
+        {
+            // The user wants to stop the capture
+            m_isCapturing = false;
+            return Time::Zero;
+        }
+    }
+
+    // When the capture stops, the last frame can't be completed
+    if (flush && (available > 0))
+    {
+        alcCaptureSamples(captureDevice, &m_samples[0], static_cast<ALCsizei>(available));
+        onProcessSamples(&m_samples[0], available * getChannelCount());
+        return Time::Zero;
+    }
+
+    // Wait until the missing samples of the next frame are captured, but at least 1 ms
+    Int64 missing = static_cast<Int64>(m_frameSize - available);
+    return microseconds(std::max<Int64>(missing * 1000000 / m_sampleRate, 1000));
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRecorder::stopThread()
+{
+    {
+        Lock lock(m_stopMutex);
+        m_isCapturing = false;
+        m_stopCondition.notifyOne();
+    }
+
+    m_thread.wait();
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::cleanup()
 {
@@ -320,7 +405,10 @@ void SoundRecorder::cleanup()
     alcCaptureStop(captureDevice);
 
     // Get the samples left in the buffer
-    processCapturedSamples();
+    if (m_frameSize)
+        processCapturedFrames(true);
+    else
+        processCapturedSamples();
 
     // Close the device
     alcCaptureCloseDevice(captureDevice);
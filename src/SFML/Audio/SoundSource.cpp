@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundSource.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
 
 
 namespace sf
@@ -36,6 +37,8 @@ SoundSource::SoundSource()
 {
     alCheck(alGenSources(1, &m_source));
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
+
+    priv::AudioDevice::registerSource(m_source);
 }
 
 
@@ -45,6 +48,8 @@ SoundSource::SoundSource(const SoundSource& copy)
     alCheck(alGenSources(1, &m_source));
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
 
+    priv::AudioDevice::registerSource(m_source);
+
     setPitch(copy.getPitch());
     setVolume(copy.getVolume());
     setPosition(copy.getPosition());
@@ -57,6 +62,8 @@ SoundSource::SoundSource(const SoundSource& copy)
 ////////////////////////////////////////////////////////////
 SoundSource::~SoundSource()
 {
+    priv::AudioDevice::unregisterSource(m_source);
+
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
     alCheck(alDeleteSources(1, &m_source));
 }
@@ -27,31 +27,48 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/Resampler.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/Audio/StreamScheduler.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Lock.hpp>
-
-#ifdef _MSC_VER
-    #pragma warning(disable: 4355) // 'this' used in base member initializer list
-#endif
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
-m_threadMutex     (),
-m_threadStartState(Stopped),
-m_isStreaming     (false),
-m_buffers         (),
-m_channelCount    (0),
-m_sampleRate      (0),
-m_format          (0),
-m_loop            (false),
-m_samplesProcessed(0),
-m_bufferSeeks     ()
+m_threadMutex       (),
+m_threadStartState  (Stopped),
+m_isStreaming       (false),
+m_requestStop       (false),
+m_buffers           (),
+m_bufferCount       (3),
+m_bufferDuration    (seconds(1)),
+m_processingInterval(Time::Zero),
+m_channelCount      (0),
+m_sampleRate        (0),
+m_format            (0),
+m_floatFormat       (0),
+m_convertedSamples  (),
+m_mixToStereo       (false),
+m_outputSampleRate  (0),
+m_resampler         (NULL),
+m_floatInput        (),
+m_mixedSamples      (),
+m_resampledSamples  (),
+m_effectMutex       (),
+m_effects           (),
+m_statistics        (),
+m_totalFillTime     (),
+m_loop              (false),
+m_samplesProcessed  (0),
+m_bufferSeeks       (),
+m_bufferSampleCounts()
 {
 
 }
@@ -62,14 +79,16 @@ SoundStream::~SoundStream()
 {
     // Stop the sound if it was playing
 
-    // Request the thread to terminate
+    // Request the streaming thread to stop updating the stream
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait until the streaming thread is done with the stream
+    priv::StreamScheduler::remove(*this);
+
+    delete m_resampler;
 }
 
 
@@ -81,8 +100,25 @@ void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
     m_samplesProcessed = 0;
     m_isStreaming = false;
 
-    // Deduce the format from the number of channels
+    // Deduce the format from the number of channels, those the device
+    // can't play are mixed down to stereo
     m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    m_floatFormat = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
+    m_mixToStereo = (m_format == 0) && (channelCount > 2);
+
+    if (m_mixToStereo)
+    {
+        m_format = priv::AudioDevice::getFormatFromChannelCount(2);
+        m_floatFormat = priv::AudioDevice::getFloatFormatFromChannelCount(2);
+    }
+
+    // Convert the sample rate while streaming if it must match the device
+    delete m_resampler;
+    m_resampler = NULL;
+    m_outputSampleRate = priv::AudioDevice::getOutputSampleRate(sampleRate);
+
+    if ((m_format != 0) && (m_outputSampleRate != sampleRate))
+        m_resampler = new priv::Resampler(sampleRate, m_outputSampleRate, m_mixToStereo ? 2 : channelCount);
 
     // Check if the format is valid
     if (m_format == 0)
@@ -129,10 +165,10 @@ void SoundStream::play()
         stop();
     }
 
-    // Start updating the stream in a separate thread to avoid blocking the application
+    // Start updating the stream in the streaming thread to avoid blocking the application
     m_isStreaming = true;
     m_threadStartState = Playing;
-    m_thread.launch();
+    priv::StreamScheduler::add(*this);
 }
 
 
@@ -156,14 +192,14 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Request the thread to terminate
+    // Request the streaming thread to stop updating the stream
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait until the streaming thread is done with the stream
+    priv::StreamScheduler::remove(*this);
 
     // Move to the beginning
     onSeek(Time::Zero);
@@ -222,7 +258,7 @@ void SoundStream::setPlayingOffset(Time timeOffset)
 
     m_isStreaming = true;
     m_threadStartState = oldStatus;
-    m_thread.launch();
+    priv::StreamScheduler::add(*this);
 }
 
 
@@ -257,6 +293,102 @@ bool SoundStream::getLoop() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferCount(unsigned int count)
+{
+    Lock lock(m_threadMutex);
+
+    // With a single buffer there would be nothing to play while it is refilled
+    m_bufferCount = (count < 2) ? 2 : count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    Lock lock(m_threadMutex);
+
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferDuration(Time duration)
+{
+    Lock lock(m_threadMutex);
+
+    m_bufferDuration = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getBufferDuration() const
+{
+    Lock lock(m_threadMutex);
+
+    return m_bufferDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setProcessingInterval(Time interval)
+{
+    Lock lock(m_threadMutex);
+
+    m_processingInterval = interval;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getProcessingInterval() const
+{
+    Lock lock(m_threadMutex);
+
+    return m_processingInterval;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::addEffect(SoundEffect& effect)
+{
+    Lock lock(m_effectMutex);
+    m_effects.push_back(&effect);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::removeEffect(SoundEffect& effect)
+{
+    Lock lock(m_effectMutex);
+    m_effects.erase(std::remove(m_effects.begin(), m_effects.end(), &effect), m_effects.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::clearEffects()
+{
+    Lock lock(m_effectMutex);
+    m_effects.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStream::Statistics SoundStream::getStatistics() const
+{
+    Lock lock(m_threadMutex);
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::resetStatistics()
+{
+    Lock lock(m_threadMutex);
+    m_statistics = Statistics();
+    m_totalFillTime = Time::Zero;
+}
+
+
 ////////////////////////////////////////////////////////////
 Int64 SoundStream::onLoop()
 {
@@ -266,28 +398,39 @@ Int64 SoundStream::onLoop()
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+bool SoundStream::startStreaming(Time& delay)
 {
-    bool requestStop = false;
-
     {
         Lock lock(m_threadMutex);
 
-        // Check if the thread was launched Stopped
+        // Check if the stream was started Stopped
         if (m_threadStartState == Stopped)
         {
             m_isStreaming = false;
-            return;
+            return false;
         }
+
+        m_buffers.resize(m_bufferCount);
+        m_bufferSeeks.assign(m_bufferCount, NoLoop);
+        m_bufferSampleCounts.assign(m_bufferCount, 0);
+    }
+
+    // The stream may not continue where the resampler and the effects stopped
+    if (m_resampler)
+        m_resampler->reset();
+
+    {
+        Lock lock(m_effectMutex);
+
+        for (std::vector<SoundEffect*>::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+            (*it)->reset();
     }
 
     // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_bufferSeeks[i] = NoLoop;
+    alCheck(alGenBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
 
     // Fill the queue
-    requestStop = fillQueue();
+    m_requestStop = fillQueue();
 
     // Play the sound
     alCheck(alSourcePlay(m_source));
@@ -295,98 +438,126 @@ void SoundStream::streamData()
     {
         Lock lock(m_threadMutex);
 
-        // Check if the thread was launched Paused
+        // Check if the stream was started Paused
         if (m_threadStartState == Paused)
             alCheck(alSourcePause(m_source));
     }
 
-    for (;;)
+    delay = getUpdateDelay();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::updateStreaming(Time& delay)
+{
     {
-        {
-            Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
-        }
+        Lock lock(m_threadMutex);
+        if (!m_isStreaming)
+            return false;
+    }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (!m_requestStop)
         {
-            if (!requestStop)
+            // The queue ran dry before it was refilled: count the underrun and just continue
             {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
-            }
-            else
-            {
-                // End streaming
                 Lock lock(m_threadMutex);
-                m_isStreaming = false;
+                ++m_statistics.underruns;
             }
+            priv::AudioDevice::reportUnderrun();
+
+            alCheck(alSourcePlay(m_source));
         }
+        else
+        {
+            // End streaming
+            Lock lock(m_threadMutex);
+            m_isStreaming = false;
+            return false;
+        }
+    }
+
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (unsigned int i = 0; i < m_buffers.size(); ++i)
+            if (m_buffers[i] == buffer)
+            {
+                bufferNum = i;
+                break;
+            }
 
-        while (nbProcessed--)
+        // Retrieve its size and add it to the samples count
+        if (m_bufferSeeks[bufferNum] != NoLoop)
+        {
+            // This was the last buffer before EOF or Loop End: reset the sample count
+            m_samplesProcessed = m_bufferSeeks[bufferNum];
+            m_bufferSeeks[bufferNum] = NoLoop;
+        }
+        else
         {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
-
-            // Retrieve its size and add it to the samples count
-            if (m_bufferSeeks[bufferNum] != NoLoop)
+            ALint size, bits;
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+            // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+            if (bits == 0)
             {
-                // This was the last buffer before EOF or Loop End: reset the sample count
-                m_samplesProcessed = m_bufferSeeks[bufferNum];
-                m_bufferSeeks[bufferNum] = NoLoop;
+                err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                      << "and initialize() has been called correctly" << std::endl;
+
+                // Abort streaming
+                Lock lock(m_threadMutex);
+                m_isStreaming = false;
+                m_requestStop = true;
+                return false;
             }
             else
             {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
+                m_samplesProcessed += m_bufferSampleCounts[bufferNum];
             }
+        }
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+    // Record the depth of the queue after the refills
+    ALint queued = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued));
+
+    {
+        Lock lock(m_threadMutex);
+        m_statistics.queuedBuffers = static_cast<unsigned int>(queued);
     }
 
+    // Come back when the playing buffer has been consumed
+    delay = getUpdateDelay();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::stopStreaming()
+{
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -398,24 +569,78 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getUpdateDelay() const
+{
+    // A stopped source must be restarted or ended as soon as possible
+    if (SoundSource::getStatus() == Stopped)
+        return Time::Zero;
+
+    Time interval = getProcessingInterval();
+
+    ALint queued = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued));
+
+    if (queued == 0)
+        return Time::Zero;
+
+    // Most implementations report the playing buffer of a queue,
+    // otherwise assume it has the same size as the first one
+    ALint buffer = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFER, &buffer));
+
+    if (buffer == 0)
+        buffer = static_cast<ALint>(m_buffers[0]);
+
+    // The buffer holds the output format, which differs from the stream's when it is converted
+    ALint size = 0;
+    ALint bits = 0;
+    ALint channels = 0;
+    ALint frequency = 0;
+    alCheck(alGetBufferi(static_cast<ALuint>(buffer), AL_SIZE, &size));
+    alCheck(alGetBufferi(static_cast<ALuint>(buffer), AL_BITS, &bits));
+    alCheck(alGetBufferi(static_cast<ALuint>(buffer), AL_CHANNELS, &channels));
+    alCheck(alGetBufferi(static_cast<ALuint>(buffer), AL_FREQUENCY, &frequency));
+
+    if ((bits == 0) || (channels == 0) || (frequency == 0))
+        return interval;
+
+    // The offset of a queue is counted from its first unprocessed buffer
+    ALint offset = 0;
+    alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+    Int64 remaining = static_cast<Int64>(size / (bits / 8) / channels) - offset;
+
+    if (remaining <= 0)
+        return Time::Zero;
+
+    Time delay = microseconds(remaining * 1000000 / frequency);
+
+    return ((interval != Time::Zero) && (interval < delay)) ? interval : delay;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
 {
+    SFML_PROFILE_SCOPE("SoundStream::fillAndPushBuffer");
+
+    Clock fillClock;
     bool requestStop = false;
 
     // Acquire audio data, also address EOF and error cases if they occur
-    Chunk data = {NULL, 0};
+    Chunk data = {NULL, 0, NULL};
     for (Uint32 retryCount = 0; !onGetData(data) && (retryCount < BufferRetries); ++retryCount)
     {
         // Check if the stream must loop or stop
         if (!m_loop)
         {
             // Not looping: Mark this buffer as ending with 0 and request stop
-            if (data.samples != NULL && data.sampleCount != 0)
+            if ((data.samples != NULL || data.floatSamples != NULL) && data.sampleCount != 0)
                 m_bufferSeeks[bufferNum] = 0;
             requestStop = true;
             break;
@@ -426,7 +651,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         m_bufferSeeks[bufferNum] = onLoop();
 
         // If we got data, break and process it, else try to fill the buffer once again
-        if (data.samples != NULL && data.sampleCount != 0)
+        if ((data.samples != NULL || data.floatSamples != NULL) && data.sampleCount != 0)
             break;
 
         // If immediateLoop is specified, we have to immediately adjust the sample count
@@ -440,14 +665,46 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         // We're a looping sound that got no data, so we retry onGetData()
     }
 
+    Time decodeTime = fillClock.getElapsedTime();
+    priv::AudioDevice::reportDecodeTime(decodeTime);
+
     // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    if ((data.samples || data.floatSamples) && data.sampleCount)
     {
         unsigned int buffer = m_buffers[bufferNum];
 
+        // The playing position counts the samples of the stream, whatever the conversion
+        m_bufferSampleCounts[bufferNum] = data.sampleCount;
+
+        // Run the effects, then mix down and resample the chunk if it doesn't match the device
+        {
+            Lock lock(m_effectMutex);
+
+            if (m_mixToStereo || m_resampler || !m_effects.empty())
+                data = convertChunk(data, requestStop);
+        }
+
         // Fill the buffer
-        ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
-        alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        if (data.floatSamples && m_floatFormat)
+        {
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(float);
+            alCheck(alBufferData(buffer, m_floatFormat, data.floatSamples, size, m_outputSampleRate));
+        }
+        else
+        {
+            // Convert float samples if the device can't play them directly
+            const Int16* samples = data.samples;
+            if (data.floatSamples)
+            {
+                m_convertedSamples.resize(data.sampleCount);
+                for (std::size_t i = 0; i < data.sampleCount; ++i)
+                    m_convertedSamples[i] = static_cast<Int16>(std::max(-1.f, std::min(data.floatSamples[i], 1.f)) * 32767.f);
+                samples = &m_convertedSamples[0];
+            }
+
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
+            alCheck(alBufferData(buffer, m_format, samples, size, m_outputSampleRate));
+        }
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
@@ -458,16 +715,84 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         requestStop = true;
     }
 
+    Time fillTime = fillClock.getElapsedTime();
+
+    {
+        Lock lock(m_threadMutex);
+
+        ++m_statistics.buffersFilled;
+        m_statistics.decodeTime += decodeTime;
+        m_statistics.maxDecodeTime = std::max(m_statistics.maxDecodeTime, decodeTime);
+        m_totalFillTime += fillTime;
+        m_statistics.averageFillTime = m_totalFillTime / static_cast<Int64>(m_statistics.buffersFilled);
+        m_statistics.maxFillTime = std::max(m_statistics.maxFillTime, fillTime);
+    }
+
     return requestStop;
 }
 
 
+////////////////////////////////////////////////////////////
+SoundStream::Chunk SoundStream::convertChunk(const Chunk& data, bool last)
+{
+    std::size_t frameCount = data.sampleCount / m_channelCount;
+    unsigned int channelCount = m_channelCount;
+
+    // The effects and the conversions run on float samples, the effects on a copy they can modify
+    const float* samples = data.floatSamples;
+    if (!samples || !m_effects.empty())
+    {
+        m_floatInput.resize(data.sampleCount);
+        if (data.floatSamples)
+        {
+            std::copy(data.floatSamples, data.floatSamples + data.sampleCount, m_floatInput.begin());
+        }
+        else
+        {
+            for (std::size_t i = 0; i < data.sampleCount; ++i)
+                m_floatInput[i] = data.samples[i] / 32768.f;
+        }
+
+        for (std::vector<SoundEffect*>::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+            (*it)->process(&m_floatInput[0], frameCount, m_channelCount, m_sampleRate);
+
+        samples = &m_floatInput[0];
+    }
+
+    if (m_mixToStereo)
+    {
+        priv::mixToStereo(samples, m_channelCount, frameCount, m_mixedSamples);
+        samples = &m_mixedSamples[0];
+        channelCount = 2;
+    }
+
+    std::size_t sampleCount = frameCount * channelCount;
+    if (m_resampler)
+    {
+        m_resampledSamples.clear();
+        m_resampler->process(samples, frameCount, m_resampledSamples);
+        if (last)
+            m_resampler->flush(m_resampledSamples);
+
+        // A chunk shorter than the filter may not produce any frame yet, but the buffer can't be empty
+        if (m_resampledSamples.empty())
+            m_resampledSamples.assign(channelCount, 0.f);
+
+        samples = &m_resampledSamples[0];
+        sampleCount = m_resampledSamples.size();
+    }
+
+    Chunk converted = {NULL, sampleCount, samples};
+    return converted;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_buffers.size()) && !requestStop; ++i)
     {
         // Since no sound has been loaded yet, we can't schedule loop seeks preemptively,
         // So if we start on EOF or Loop End, we let fillAndPushBuffer() adjust the sample count
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/StreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // A stream managed by the scheduler
+    struct ScheduledStream
+    {
+        sf::SoundStream* stream;   // Stream to update
+        sf::Time         deadline; // Time at which the stream needs to be updated
+        bool             started;  // Has the stream been started by the scheduler?
+    };
+
+    // A source waiting to be played at a given time
+    struct ScheduledStart
+    {
+        unsigned int source;   // Source to play
+        sf::Time     deadline; // Time at which the source must start
+    };
+
+    // Longest wait of the thread between two updates; newly played
+    // streams wake it up immediately, so this is only a safety net
+    const sf::Time maxSleep = sf::milliseconds(100);
+
+    // Minimum delay between two updates of a stream, to avoid
+    // spinning on a stream that can't make progress
+    const sf::Time minDelay = sf::milliseconds(1);
+
+    // The list of streams and the thread state are protected by streamMutex,
+    // updateMutex is held while the scheduler thread updates streams
+    sf::Mutex streamMutex;
+    sf::Mutex updateMutex;
+    sf::Mutex launchMutex;
+    std::vector<ScheduledStream> streams;
+    std::vector<ScheduledStart> starts;
+    bool running = false;
+
+    // Signaled when a stream is added, to interrupt the wait of the thread
+    sf::ConditionVariable streamAdded;
+    bool added = false;
+
+    // Clock used for the deadlines
+    sf::Clock schedulerClock;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void StreamScheduler::add(SoundStream& stream)
+{
+    bool launch = false;
+
+    {
+        Lock lock(streamMutex);
+
+        ScheduledStream scheduled = {&stream, schedulerClock.getElapsedTime(), false};
+        streams.push_back(scheduled);
+
+        added = true;
+        streamAdded.notifyOne();
+
+        // The thread exits when it has no stream left, start it again if needed
+        if (!running)
+        {
+            running = true;
+            launch = true;
+        }
+    }
+
+    if (launch)
+        launchThread();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::remove(SoundStream& stream)
+{
+    // Wait until the scheduler thread is done with the streams
+    Lock updateLock(updateMutex);
+
+    bool started = false;
+
+    {
+        Lock lock(streamMutex);
+
+        for (std::vector<ScheduledStream>::iterator it = streams.begin(); it != streams.end(); ++it)
+        {
+            if (it->stream == &stream)
+            {
+                started = it->started;
+                streams.erase(it);
+                break;
+            }
+        }
+    }
+
+    // The stream may have ended by itself, in which case it was already cleaned up
+    if (started)
+        stream.stopStreaming();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::schedulePlay(unsigned int source, Time delay)
+{
+    bool launch = false;
+
+    {
+        Lock lock(streamMutex);
+
+        for (std::vector<ScheduledStart>::iterator it = starts.begin(); it != starts.end(); ++it)
+        {
+            if (it->source == source)
+            {
+                starts.erase(it);
+                break;
+            }
+        }
+
+        ScheduledStart start = {source, schedulerClock.getElapsedTime() + delay};
+        starts.push_back(start);
+
+        added = true;
+        streamAdded.notifyOne();
+
+        if (!running)
+        {
+            running = true;
+            launch = true;
+        }
+    }
+
+    if (launch)
+        launchThread();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::cancelPlay(unsigned int source)
+{
+    // Sources are started under the mutex, a start can't be in progress once it is taken
+    Lock lock(streamMutex);
+
+    for (std::vector<ScheduledStart>::iterator it = starts.begin(); it != starts.end(); ++it)
+    {
+        if (it->source == source)
+        {
+            starts.erase(it);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::launchThread()
+{
+    static Thread thread(&StreamScheduler::run);
+
+    // Late updates are heard as glitches: run above the other threads
+    Lock lock(launchMutex);
+    thread.setName("sfml-stream");
+    thread.setPriority(Thread::RealTime);
+
+    // launch() waits for the previous run of the thread to finish
+    thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::startSources(Time now, Time& nearest)
+{
+    Lock lock(streamMutex);
+
+    std::vector<ScheduledStart>::iterator it = starts.begin();
+    while (it != starts.end())
+    {
+        if (it->deadline <= now)
+        {
+            alCheck(alSourcePlay(it->source));
+            it = starts.erase(it);
+        }
+        else
+        {
+            nearest = std::min(nearest, it->deadline);
+            ++it;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamScheduler::run()
+{
+    for (;;)
+    {
+        Time now = schedulerClock.getElapsedTime();
+        Time deadline = update(now);
+
+        if (deadline == Time::Zero)
+            return;
+
+        Time delay = std::min(std::max(deadline - now, minDelay), maxSleep);
+
+        Lock lock(streamMutex);
+
+        if (!added)
+            streamAdded.wait(streamMutex, delay);
+
+        added = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Time StreamScheduler::update(Time now)
+{
+    Lock updateLock(updateMutex);
+
+    Time nearest = now + maxSleep;
+
+    // Scheduled starts come first, they are the most sensitive to delays
+    startSources(now, nearest);
+
+    // Streams can be added while others are updated, but only this
+    // function and remove() (both under updateMutex) erase them
+    for (std::size_t i = 0; ; ++i)
+    {
+        ScheduledStream scheduled;
+
+        {
+            Lock lock(streamMutex);
+
+            if (i >= streams.size())
+            {
+                // Let the thread exit if there's nothing left to update or start
+                if (streams.empty() && starts.empty())
+                {
+                    running = false;
+                    return Time::Zero;
+                }
+
+                break;
+            }
+
+            scheduled = streams[i];
+        }
+
+        if (scheduled.deadline > now)
+        {
+            nearest = std::min(nearest, scheduled.deadline);
+            continue;
+        }
+
+        Time delay = Time::Zero;
+        bool streaming = true;
+
+        if (!scheduled.started)
+        {
+            streaming = scheduled.stream->startStreaming(delay);
+        }
+        else if (!scheduled.stream->updateStreaming(delay))
+        {
+            scheduled.stream->stopStreaming();
+            streaming = false;
+        }
+
+        Lock lock(streamMutex);
+
+        if (streaming)
+        {
+            streams[i].started = true;
+            streams[i].deadline = now + std::max(delay, minDelay);
+            nearest = std::min(nearest, streams[i].deadline);
+        }
+        else
+        {
+            streams.erase(streams.begin() + i);
+            --i;
+        }
+    }
+
+    return nearest;
+}
+
+} // namespace priv
+
+} // namespace sf
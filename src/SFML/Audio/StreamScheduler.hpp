@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STREAMSCHEDULER_HPP
+#define SFML_STREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Background thread that feeds all the playing
+///        sound streams
+///
+/// The thread only runs while there are streams to update
+/// or sounds to start. Each stream is updated when its
+/// playing buffer is about to be consumed, each scheduled
+/// sound is started at its time, and the thread sleeps until
+/// the nearest of these deadlines.
+///
+////////////////////////////////////////////////////////////
+class StreamScheduler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start updating a stream
+    ///
+    /// The stream is started by the scheduler thread, so that
+    /// its initial buffers are not filled by the caller.
+    ///
+    /// \param stream Stream to update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void add(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop updating a stream
+    ///
+    /// When this function returns, the scheduler thread is
+    /// guaranteed not to access the stream anymore, and the
+    /// stream's playback has been stopped and cleaned up.
+    ///
+    /// \param stream Stream to stop updating
+    ///
+    ////////////////////////////////////////////////////////////
+    static void remove(SoundStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing a source after a delay
+    ///
+    /// A previous scheduled start of the source is replaced.
+    ///
+    /// \param source Identifier of the source to play
+    /// \param delay  Delay before the source starts
+    ///
+    ////////////////////////////////////////////////////////////
+    static void schedulePlay(unsigned int source, Time delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the scheduled start of a source
+    ///
+    /// When this function returns, the scheduler thread is
+    /// guaranteed not to start the source anymore.
+    ///
+    /// \param source Identifier of the source
+    ///
+    ////////////////////////////////////////////////////////////
+    static void cancelPlay(unsigned int source);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the scheduler thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Launch the scheduler thread
+    ///
+    /// The caller must have found the thread not running,
+    /// and marked it as running, under the stream mutex.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void launchThread();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the sources whose time has come
+    ///
+    /// \param now     Current time of the scheduler clock
+    /// \param nearest Nearest deadline, lowered to the next start
+    ///
+    ////////////////////////////////////////////////////////////
+    static void startSources(Time now, Time& nearest);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the streams whose deadline has passed
+    ///
+    /// \param now Current time of the scheduler clock
+    ///
+    /// \return Time of the nearest deadline, or Time::Zero if no stream or start is left
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time update(Time now);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMSCHEDULER_HPP
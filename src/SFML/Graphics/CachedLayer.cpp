@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CachedLayer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Beyond this number of disjoint areas, rendering the layer as a whole is cheaper
+    const std::size_t maxDirtyAreas = 8;
+
+    // Get the smallest rectangle containing two rectangles
+    sf::IntRect mergeAreas(const sf::IntRect& a, const sf::IntRect& b)
+    {
+        int left   = std::min(a.left, b.left);
+        int top    = std::min(a.top, b.top);
+        int right  = std::max(a.left + a.width, b.left + b.width);
+        int bottom = std::max(a.top + a.height, b.top + b.height);
+
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CachedLayer::CachedLayer() :
+m_renderTexture(),
+m_children     (),
+m_clearColor   (Color::Transparent),
+m_dirtyAreas   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CachedLayer::create(unsigned int width, unsigned int height, const ContextSettings& settings)
+{
+    if (!m_renderTexture.create(width, height, settings))
+        return false;
+
+    // Only the children overlapping the area being rendered are drawn
+    m_renderTexture.setCullingEnabled(true);
+
+    float right  = static_cast<float>(width);
+    float bottom = static_cast<float>(height);
+
+    m_vertices[0] = Vertex(Vector2f(0.f, 0.f), Vector2f(0.f, 0.f));
+    m_vertices[1] = Vertex(Vector2f(0.f, bottom), Vector2f(0.f, bottom));
+    m_vertices[2] = Vertex(Vector2f(right, 0.f), Vector2f(right, 0.f));
+    m_vertices[3] = Vertex(Vector2f(right, bottom), Vector2f(right, bottom));
+
+    invalidate();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::addChild(const Drawable& drawable, const RenderStates& states)
+{
+    Child child;
+    child.drawable = &drawable;
+    child.states = states;
+    updateBounds(child);
+
+    m_children.push_back(child);
+    invalidateChild(child);
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::removeChild(const Drawable& drawable)
+{
+    for (std::vector<Child>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        if (it->drawable == &drawable)
+        {
+            invalidateChild(*it);
+            m_children.erase(it);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::clearChildren()
+{
+    m_children.clear();
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CachedLayer::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::setClearColor(const Color& color)
+{
+    m_clearColor = color;
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& CachedLayer::getClearColor() const
+{
+    return m_clearColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::invalidate()
+{
+    Vector2u size = m_renderTexture.getSize();
+
+    m_dirtyAreas.clear();
+    if (size.x && size.y)
+        m_dirtyAreas.push_back(IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)));
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::invalidate(const FloatRect& area)
+{
+    // Round the area outwards, with a margin for smoothed and antialiased edges
+    int left   = static_cast<int>(std::floor(area.left)) - 1;
+    int top    = static_cast<int>(std::floor(area.top)) - 1;
+    int right  = static_cast<int>(std::ceil(area.left + area.width)) + 1;
+    int bottom = static_cast<int>(std::ceil(area.top + area.height)) + 1;
+
+    Vector2u size = m_renderTexture.getSize();
+    IntRect pixels;
+    if (!IntRect(left, top, right - left, bottom - top).intersects(IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)), pixels))
+        return;
+
+    // Merge the area with the ones it overlaps, so that no pixel is rendered twice
+    for (std::size_t i = 0; i < m_dirtyAreas.size();)
+    {
+        if (m_dirtyAreas[i].intersects(pixels))
+        {
+            pixels = mergeAreas(pixels, m_dirtyAreas[i]);
+            m_dirtyAreas.erase(m_dirtyAreas.begin() + static_cast<std::ptrdiff_t>(i));
+            i = 0;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    m_dirtyAreas.push_back(pixels);
+
+    // Too many areas would draw the children too many times
+    if (m_dirtyAreas.size() > maxDirtyAreas)
+    {
+        for (std::size_t i = 1; i < m_dirtyAreas.size(); ++i)
+            m_dirtyAreas[0] = mergeAreas(m_dirtyAreas[0], m_dirtyAreas[i]);
+
+        m_dirtyAreas.resize(1);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::invalidate(const Drawable& drawable)
+{
+    for (std::vector<Child>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        if (it->drawable == &drawable)
+        {
+            // Where the child was, and where it is now
+            invalidateChild(*it);
+            updateBounds(*it);
+            invalidateChild(*it);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool CachedLayer::isDirty() const
+{
+    return !m_dirtyAreas.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::update() const
+{
+    if (m_dirtyAreas.empty())
+        return;
+
+    Vector2f size(m_renderTexture.getSize());
+
+    for (std::vector<IntRect>::const_iterator area = m_dirtyAreas.begin(); area != m_dirtyAreas.end(); ++area)
+    {
+        // Restrict the rendering to the area: the viewport clips what the children draw outside of it
+        FloatRect rect(*area);
+        View view(rect);
+        view.setViewport(FloatRect(rect.left / size.x, rect.top / size.y, rect.width / size.x, rect.height / size.y));
+        m_renderTexture.setView(view);
+
+        // Clear the area only, by replacing its pixels
+        Vertex background[4] =
+        {
+            Vertex(Vector2f(rect.left, rect.top), m_clearColor),
+            Vertex(Vector2f(rect.left, rect.top + rect.height), m_clearColor),
+            Vertex(Vector2f(rect.left + rect.width, rect.top), m_clearColor),
+            Vertex(Vector2f(rect.left + rect.width, rect.top + rect.height), m_clearColor)
+        };
+        m_renderTexture.draw(background, 4, TriangleStrip, RenderStates(BlendNone));
+
+        for (std::vector<Child>::const_iterator child = m_children.begin(); child != m_children.end(); ++child)
+            m_renderTexture.draw(*child->drawable, child->states);
+    }
+
+    m_renderTexture.display();
+    m_dirtyAreas.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& CachedLayer::getTexture() const
+{
+    return m_renderTexture.getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect CachedLayer::getLocalBounds() const
+{
+    Vector2u size = m_renderTexture.getSize();
+
+    return FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect CachedLayer::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::draw(RenderTarget& target, RenderStates states) const
+{
+    Vector2u size = m_renderTexture.getSize();
+    if (!size.x || !size.y)
+        return;
+
+    update();
+
+    states.transform *= getTransform();
+    states.texture = &m_renderTexture.getTexture();
+    target.draw(m_vertices, 4, TriangleStrip, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CachedLayer::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::updateBounds(Child& child)
+{
+    child.hasBounds = child.drawable->getCullingBounds(child.bounds);
+    if (child.hasBounds)
+        child.bounds = child.states.transform.transformRect(child.bounds);
+}
+
+
+////////////////////////////////////////////////////////////
+void CachedLayer::invalidateChild(const Child& child)
+{
+    if (child.hasBounds)
+        invalidate(child.bounds);
+    else
+        invalidate();
+}
+
+} // namespace sf
@@ -26,7 +26,43 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <cmath>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    typedef std::map<std::size_t, std::vector<sf::Vector2f> > UnitCircleMap;
+
+    sf::Mutex unitCircleMutex;
+
+    // Thread-safe access to the points of a circle of radius 1 centered on the origin,
+    // computed once per point count and shared by all the circles using that count
+    const std::vector<sf::Vector2f>* getUnitCircle(std::size_t pointCount)
+    {
+        sf::Lock lock(unitCircleMutex);
+
+        static UnitCircleMap unitCircles;
+        std::vector<sf::Vector2f>& points = unitCircles[pointCount];
+        if (points.size() != pointCount)
+        {
+            static const double pi = 3.141592653589793;
+
+            points.resize(pointCount);
+            for (std::size_t i = 0; i < pointCount; ++i)
+            {
+                double angle = static_cast<double>(i) * 2 * pi / static_cast<double>(pointCount) - pi / 2;
+                points[i] = sf::Vector2f(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+            }
+        }
+
+        // Elements of a std::map are never moved, the pointer stays valid
+        return &points;
+    }
+}
 
 
 namespace sf
@@ -34,7 +70,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitPoints(getUnitCircle(pointCount))
 {
     update();
 }
@@ -58,7 +95,12 @@ float CircleShape::getRadius() const
 ////////////////////////////////////////////////////////////
 void CircleShape::setPointCount(std::size_t count)
 {
-    m_pointCount = count;
+    if (count != m_pointCount)
+    {
+        m_pointCount = count;
+        m_unitPoints = getUnitCircle(count);
+    }
+
     update();
 }
 
@@ -72,13 +114,9 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
-
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    const Vector2f& unit = (*m_unitPoints)[index];
 
-    return Vector2f(m_radius + x, m_radius + y);
+    return Vector2f(m_radius + unit.x * m_radius, m_radius + unit.y * m_radius);
 }
 
 } // namespace sf
@@ -0,0 +1,888 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CorePipeline.hpp>
+#include <SFML/Graphics/StreamBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+    #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+    #define castFromGlHandle(x) (x)
+
+#endif
+
+#if !defined(GL_CONTEXT_FLAGS)
+    #define GL_CONTEXT_FLAGS 0x821E
+#endif
+
+#if !defined(GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT)
+    #define GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT 0x00000001
+#endif
+
+#if !defined(GL_CONTEXT_PROFILE_MASK)
+    #define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#if !defined(GL_CONTEXT_CORE_PROFILE_BIT)
+    #define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
+namespace
+{
+    // Number of default programs: untextured, textured and layered, each with an instanced variant
+    const int programCount = 6;
+
+    // Per-instance data as laid out in the instance buffer
+    struct InstanceData
+    {
+        GLfloat matrix[16]; // Transform of the instance
+        GLubyte color[4];   // Color of the instance
+    };
+
+    // Objects of the pipeline that live in a given context
+    // Vertex array objects can't be shared between contexts,
+    // so every context gets its own set of objects
+    struct ContextObjects
+    {
+        GLuint vertexArray;    // Vertex array object holding the attribute setup
+        GLuint sourceBuffer;   // Buffer the attributes are currently sourced from
+        GLuint instanceBuffer; // Buffer per-instance data is streamed into
+        GLuint programs[programCount]; // Default programs, indexed by getProgramIndex
+        GLint  locations[programCount][sf::priv::CorePipeline::UniformCount]; // Uniform locations of the default programs
+        std::vector<InstanceData> instanceData; // Staging memory for the per-instance data
+    };
+
+    // Get the index of a default program
+    int getProgramIndex(bool textured, bool instanced, bool layered)
+    {
+        return (layered ? 2 : (textured ? 1 : 0)) + (instanced ? 3 : 0);
+    }
+
+    typedef std::map<sf::Uint64, ContextObjects> ContextObjectsMap;
+    ContextObjectsMap contextObjects;
+
+    // Objects of the context that was last bound on this thread
+    sf::ThreadLocalPtr<ContextObjects> currentObjects(NULL);
+
+    // Mutex to protect the context objects map
+    sf::Mutex mutex;
+
+    // Names of the uniforms set by the pipeline, indexed by CorePipeline::Uniform
+    const char* uniformNames[sf::priv::CorePipeline::UniformCount] =
+    {
+        "sf_projectionMatrix",
+        "sf_modelViewMatrix",
+        "sf_textureMatrix",
+        "sf_texture"
+    };
+
+    // Source code of the default programs, prefixed with a #version directive
+    // and SF_INSTANCED/SF_LAYERED for the instanced/layered variants at runtime
+    const char* vertexShaderSource =
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "#ifdef SF_LAYERED\n"
+        "in vec3 sf_texCoords;\n"
+        "#else\n"
+        "in vec2 sf_texCoords;\n"
+        "#endif\n"
+        "#ifdef SF_INSTANCED\n"
+        "in mat4 sf_instanceTransform;\n"
+        "in vec4 sf_instanceColor;\n"
+        "#endif\n"
+        "uniform mat4 sf_projectionMatrix;\n"
+        "uniform mat4 sf_modelViewMatrix;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "out vec4 sf_fragmentColor;\n"
+        "#ifdef SF_LAYERED\n"
+        "out vec3 sf_fragmentTexCoords;\n"
+        "#else\n"
+        "out vec2 sf_fragmentTexCoords;\n"
+        "#endif\n"
+        "void main()\n"
+        "{\n"
+        "#ifdef SF_INSTANCED\n"
+        "    gl_Position = sf_projectionMatrix * sf_instanceTransform * sf_modelViewMatrix * vec4(sf_position, 0.0, 1.0);\n"
+        "    sf_fragmentColor = sf_color * sf_instanceColor;\n"
+        "#else\n"
+        "    gl_Position = sf_projectionMatrix * sf_modelViewMatrix * vec4(sf_position, 0.0, 1.0);\n"
+        "    sf_fragmentColor = sf_color;\n"
+        "#endif\n"
+        "#ifdef SF_LAYERED\n"
+        "    sf_fragmentTexCoords = vec3((sf_textureMatrix * vec4(sf_texCoords.xy, 0.0, 1.0)).xy, sf_texCoords.z);\n"
+        "#else\n"
+        "    sf_fragmentTexCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "#endif\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "in vec4 sf_fragmentColor;\n"
+        "out vec4 sf_outputColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_outputColor = sf_fragmentColor;\n"
+        "}\n";
+
+    const char* texturedFragmentShaderSource =
+        "in vec4 sf_fragmentColor;\n"
+        "in vec2 sf_fragmentTexCoords;\n"
+        "uniform sampler2D sf_texture;\n"
+        "out vec4 sf_outputColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_outputColor = sf_fragmentColor * texture(sf_texture, sf_fragmentTexCoords);\n"
+        "}\n";
+
+    const char* layeredFragmentShaderSource =
+        "in vec4 sf_fragmentColor;\n"
+        "in vec3 sf_fragmentTexCoords;\n"
+        "uniform sampler2DArray sf_texture;\n"
+        "out vec4 sf_outputColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_outputColor = sf_fragmentColor * texture(sf_texture, sf_fragmentTexCoords);\n"
+        "}\n";
+
+    // Retrieve the version of the current context
+    void getContextVersion(int& major, int& minor)
+    {
+        major = 1;
+        minor = 1;
+
+        // The beginning of the returned string is "major.minor" (this is standard)
+        const GLubyte* version = glGetString(GL_VERSION);
+        if (version)
+        {
+            major = version[0] - '0';
+            minor = version[2] - '0';
+        }
+    }
+
+    // Get the GLSL #version directive matching the current context
+    const char* getVersionDirective()
+    {
+        int major = 0;
+        int minor = 0;
+        getContextVersion(major, minor);
+
+        if ((major == 3) && (minor == 0))
+            return "#version 130\n";
+        else if ((major == 3) && (minor == 1))
+            return "#version 140\n";
+
+        return "#version 150\n";
+    }
+
+    // Compile a single shader object, returns 0 on failure
+    GLEXT_GLhandle compileShader(GLenum type, const char* defines, const char* source)
+    {
+        const char* sources[3] = {getVersionDirective(), defines, source};
+
+        GLEXT_GLhandle shader;
+        glCheck(shader = GLEXT_glCreateShaderObject(type));
+        glCheck(GLEXT_glShaderSource(shader, 3, sources, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile default shader:" << std::endl
+                      << log << std::endl;
+            glCheck(GLEXT_glDeleteObject(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+
+    // Create one of the default programs, returns 0 on failure
+    GLuint createProgram(bool textured, bool instanced, bool layered)
+    {
+        std::string defines;
+        if (instanced)
+            defines += "#define SF_INSTANCED\n";
+        if (layered)
+            defines += "#define SF_LAYERED\n";
+
+        GLEXT_GLhandle vertexShader = compileShader(GLEXT_GL_VERTEX_SHADER, defines.c_str(), vertexShaderSource);
+        if (!vertexShader)
+            return 0;
+
+        const char* fragmentSource = layered ? layeredFragmentShaderSource : (textured ? texturedFragmentShaderSource : fragmentShaderSource);
+        GLEXT_GLhandle fragmentShader = compileShader(GLEXT_GL_FRAGMENT_SHADER, defines.c_str(), fragmentSource);
+        if (!fragmentShader)
+        {
+            glCheck(GLEXT_glDeleteObject(vertexShader));
+            return 0;
+        }
+
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glCreateProgramObject());
+        glCheck(GLEXT_glAttachObject(program, vertexShader));
+        glCheck(GLEXT_glAttachObject(program, fragmentShader));
+        glCheck(GLEXT_glDeleteObject(vertexShader));
+        glCheck(GLEXT_glDeleteObject(fragmentShader));
+
+        sf::priv::CorePipeline::bindAttributeLocations(castFromGlHandle(program));
+
+        glCheck(GLEXT_glLinkProgram(program));
+
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(program, sizeof(log), 0, log));
+            sf::err() << "Failed to link default shader:" << std::endl
+                      << log << std::endl;
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return castFromGlHandle(program);
+    }
+
+    // Query the locations of the pipeline uniforms in a program
+    void queryUniformLocations(GLuint program, GLint* locations)
+    {
+        for (int i = 0; i < sf::priv::CorePipeline::UniformCount; ++i)
+            glCheck(locations[i] = GLEXT_glGetUniformLocation(castToGlHandle(program), uniformNames[i]));
+    }
+
+    // Destroy the objects of a context, the context must be active
+    void destroyObjects(ContextObjects& objects)
+    {
+        if (objects.vertexArray)
+            glCheck(GLEXT_glDeleteVertexArrays(1, &objects.vertexArray));
+
+        if (objects.instanceBuffer)
+            glCheck(GLEXT_glDeleteBuffers(1, &objects.instanceBuffer));
+
+        for (int i = 0; i < programCount; ++i)
+        {
+            if (objects.programs[i])
+                glCheck(GLEXT_glDeleteObject(castToGlHandle(objects.programs[i])));
+        }
+    }
+
+    // Callback that is called every time a context is destroyed
+    void contextDestroyCallback(void* /*arg*/)
+    {
+        sf::Lock lock(mutex);
+
+        ContextObjectsMap::iterator iter = contextObjects.find(sf::Context::getActiveContextId());
+        if (iter == contextObjects.end())
+            return;
+
+        destroyObjects(iter->second);
+
+        if (currentObjects == &iter->second)
+            currentObjects = NULL;
+
+        contextObjects.erase(iter);
+    }
+
+    // Point the generic vertex attributes to the currently bound buffer
+    void setAttributePointers()
+    {
+        using sf::priv::CorePipeline;
+
+        glCheck(GLEXT_glVertexAttribPointer(CorePipeline::PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), reinterpret_cast<const void*>(0)));
+        glCheck(GLEXT_glVertexAttribPointer(CorePipeline::ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(sf::Vertex), reinterpret_cast<const void*>(8)));
+        glCheck(GLEXT_glVertexAttribPointer(CorePipeline::TexCoordsAttribute, 3, GL_FLOAT, GL_FALSE, sizeof(sf::Vertex), reinterpret_cast<const void*>(12)));
+    }
+
+    // Get the OpenGL type of the components of a vertex layout attribute
+    GLenum layoutTypeToGlEnum(sf::VertexLayout::Type type)
+    {
+        switch (type)
+        {
+            case sf::VertexLayout::Float:     return GL_FLOAT;
+            case sf::VertexLayout::HalfFloat: return GLEXT_GL_HALF_FLOAT;
+            case sf::VertexLayout::Short:     return GL_SHORT;
+            default:                          return GL_UNSIGNED_BYTE;
+        }
+    }
+
+    // Get the generic attribute location fed by a vertex layout attribute
+    GLuint getAttributeLocation(const sf::VertexLayout::Attribute& attribute)
+    {
+        using sf::priv::CorePipeline;
+
+        switch (attribute.semantic)
+        {
+            case sf::VertexLayout::Position:  return CorePipeline::PositionAttribute;
+            case sf::VertexLayout::Color:     return CorePipeline::ColorAttribute;
+            case sf::VertexLayout::TexCoords: return CorePipeline::TexCoordsAttribute;
+            default:                          return CorePipeline::CustomAttribute + attribute.index;
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool CorePipeline::isAvailable()
+{
+    Lock lock(mutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_vertex_buffer_object &&
+                    GLEXT_vertex_array_object  &&
+                    GLEXT_shading_language_100 &&
+                    GLEXT_shader_objects       &&
+                    GLEXT_vertex_shader        &&
+                    GLEXT_fragment_shader;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isRequired()
+{
+    int major = 0;
+    int minor = 0;
+    getContextVersion(major, minor);
+
+    // Fixed-function support can only be dropped from 3.0 onwards
+    if (major < 3)
+        return false;
+
+    // Forward compatible contexts removed everything that was deprecated
+    GLint flags = 0;
+    glCheck(glGetIntegerv(GL_CONTEXT_FLAGS, &flags));
+    if (flags & GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT)
+        return true;
+
+    // Profiles were introduced in 3.2
+    if ((major == 3) && (minor < 2))
+        return false;
+
+    GLint profile = 0;
+    glCheck(glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile));
+
+    return (profile & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isInstancingAvailable()
+{
+    Lock lock(mutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_draw_instanced && GLEXT_instanced_arrays;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::bind()
+{
+    ContextObjects* objects = NULL;
+
+    {
+        Lock lock(mutex);
+
+        Uint64 contextId = Context::getActiveContextId();
+
+        ContextObjectsMap::iterator iter = contextObjects.find(contextId);
+
+        if (iter == contextObjects.end())
+        {
+            // Register the context destruction callback
+            static bool registered = false;
+            if (!registered)
+            {
+                registerContextDestroyCallback(contextDestroyCallback, 0);
+                registered = true;
+            }
+
+            bool instancing = isInstancingAvailable();
+
+            ContextObjects newObjects;
+            newObjects.vertexArray = 0;
+            newObjects.sourceBuffer = 0;
+            newObjects.instanceBuffer = 0;
+
+            for (int i = 0; i < programCount; ++i)
+                newObjects.programs[i] = 0;
+
+            // The instanced variants are only needed if they can be used
+            for (int i = 0; i < (instancing ? programCount : programCount / 2); ++i)
+            {
+                newObjects.programs[i] = createProgram((i % 3) == 1, i >= 3, (i % 3) == 2);
+
+                if (!newObjects.programs[i])
+                {
+                    destroyObjects(newObjects);
+                    return false;
+                }
+
+                queryUniformLocations(newObjects.programs[i], newObjects.locations[i]);
+
+                // The texture is always bound to the first unit
+                if (newObjects.locations[i][TextureUniform] != -1)
+                {
+                    glCheck(GLEXT_glUseProgramObject(castToGlHandle(newObjects.programs[i])));
+                    glCheck(GLEXT_glUniform1i(newObjects.locations[i][TextureUniform], 0));
+                }
+            }
+
+            glCheck(GLEXT_glGenVertexArrays(1, &newObjects.vertexArray));
+
+            if (instancing)
+                glCheck(GLEXT_glGenBuffers(1, &newObjects.instanceBuffer));
+
+            if (!newObjects.vertexArray || (instancing && !newObjects.instanceBuffer))
+            {
+                err() << "Failed to create the vertex array of the programmable pipeline" << std::endl;
+                destroyObjects(newObjects);
+                return false;
+            }
+
+            // The enabled attributes are part of the vertex array object state
+            glCheck(GLEXT_glBindVertexArray(newObjects.vertexArray));
+            glCheck(GLEXT_glEnableVertexAttribArray(PositionAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+
+            // So are the divisors, the instance attributes advance once per instance
+            if (instancing)
+            {
+                for (GLuint i = 0; i < 4; ++i)
+                    glCheck(GLEXT_glVertexAttribDivisor(InstanceTransformAttribute + i, 1));
+
+                glCheck(GLEXT_glVertexAttribDivisor(InstanceColorAttribute, 1));
+            }
+
+            iter = contextObjects.insert(std::make_pair(contextId, newObjects)).first;
+        }
+
+        objects = &iter->second;
+    }
+
+    currentObjects = objects;
+
+    glCheck(GLEXT_glBindVertexArray(objects->vertexArray));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::setVertices(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex)
+{
+    ContextObjects* objects = currentObjects;
+    if (!objects)
+        return false;
+
+    // The attributes are always sourced from the start of the
+    // stream buffer, vertices are addressed with the first index
+    GLuint buffer = StreamBuffer::upload(vertices, vertexCount, firstVertex);
+    if (!buffer)
+        return false;
+
+    if (objects->sourceBuffer != buffer)
+    {
+        setAttributePointers();
+        objects->sourceBuffer = buffer;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setVertexBuffer(const VertexLayout& layout)
+{
+    ContextObjects* objects = currentObjects;
+    if (!objects)
+        return;
+
+    if (layout.isDefault())
+    {
+        setAttributePointers();
+    }
+    else
+    {
+        // Standard attributes missing from the layout read a constant value
+        if (!layout.find(VertexLayout::Color))
+        {
+            glCheck(GLEXT_glDisableVertexAttribArray(ColorAttribute));
+            glCheck(GLEXT_glVertexAttrib4f(ColorAttribute, 1.f, 1.f, 1.f, 1.f));
+        }
+
+        if (!layout.find(VertexLayout::TexCoords))
+        {
+            glCheck(GLEXT_glDisableVertexAttribArray(TexCoordsAttribute));
+            glCheck(GLEXT_glVertexAttrib4f(TexCoordsAttribute, 0.f, 0.f, 0.f, 1.f));
+        }
+
+        GLsizei stride = static_cast<GLsizei>(layout.getStride());
+
+        for (std::size_t i = 0; i < layout.getAttributeCount(); ++i)
+        {
+            const VertexLayout::Attribute& attribute = layout.getAttribute(i);
+            GLuint location = getAttributeLocation(attribute);
+
+            glCheck(GLEXT_glVertexAttribPointer(location, static_cast<GLint>(attribute.componentCount), layoutTypeToGlEnum(attribute.type),
+                                                attribute.normalized ? GL_TRUE : GL_FALSE, stride, reinterpret_cast<const void*>(attribute.offset)));
+
+            if (attribute.semantic == VertexLayout::Custom)
+                glCheck(GLEXT_glEnableVertexAttribArray(location));
+        }
+    }
+
+    // User buffers may be deleted and their name recycled at any
+    // time, so don't let the next stream upload skip the setup
+    objects->sourceBuffer = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::unsetVertexBuffer(const VertexLayout& layout)
+{
+    if (!currentObjects || layout.isDefault())
+        return;
+
+    // The vertex array object expects the standard attribute arrays to be enabled
+    if (!layout.find(VertexLayout::Color))
+        glCheck(GLEXT_glEnableVertexAttribArray(ColorAttribute));
+
+    if (!layout.find(VertexLayout::TexCoords))
+        glCheck(GLEXT_glEnableVertexAttribArray(TexCoordsAttribute));
+
+    for (std::size_t i = 0; i < layout.getAttributeCount(); ++i)
+    {
+        const VertexLayout::Attribute& attribute = layout.getAttribute(i);
+
+        if (attribute.semantic == VertexLayout::Custom)
+            glCheck(GLEXT_glDisableVertexAttribArray(getAttributeLocation(attribute)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::setInstances(const Transform* transforms, const Color* colors, std::size_t instanceCount)
+{
+    ContextObjects* objects = currentObjects;
+    if (!objects || !objects->instanceBuffer)
+        return false;
+
+    std::vector<InstanceData>& data = objects->instanceData;
+    data.resize(instanceCount);
+
+    for (std::size_t i = 0; i < instanceCount; ++i)
+    {
+        const float* matrix = transforms[i].getMatrix();
+        for (int j = 0; j < 16; ++j)
+            data[i].matrix[j] = matrix[j];
+
+        Color color = colors ? colors[i] : Color::White;
+        data[i].color[0] = color.r;
+        data[i].color[1] = color.g;
+        data[i].color[2] = color.b;
+        data[i].color[3] = color.a;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, objects->instanceBuffer));
+
+    // Respecifying the whole storage lets the driver orphan the
+    // previous one instead of waiting for pending draws to complete
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(sizeof(InstanceData) * instanceCount), &data[0], GLEXT_GL_STREAM_DRAW));
+
+    // A mat4 attribute is made of 4 consecutive vec4 columns
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        glCheck(GLEXT_glVertexAttribPointer(InstanceTransformAttribute + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), reinterpret_cast<const void*>(i * 4 * sizeof(GLfloat))));
+        glCheck(GLEXT_glEnableVertexAttribArray(InstanceTransformAttribute + i));
+    }
+
+    glCheck(GLEXT_glVertexAttribPointer(InstanceColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(InstanceData), reinterpret_cast<const void*>(16 * sizeof(GLfloat))));
+    glCheck(GLEXT_glEnableVertexAttribArray(InstanceColorAttribute));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::unsetInstances()
+{
+    for (GLuint i = 0; i < 4; ++i)
+        glCheck(GLEXT_glDisableVertexAttribArray(InstanceTransformAttribute + i));
+
+    glCheck(GLEXT_glDisableVertexAttribArray(InstanceColorAttribute));
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::drawInstanced(unsigned int mode, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount)
+{
+    glCheck(GLEXT_glDrawArraysInstanced(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CorePipeline::getDefaultProgram(bool textured, bool instanced, bool layered)
+{
+    ContextObjects* objects = currentObjects;
+
+    return objects ? objects->programs[getProgramIndex(textured, instanced, layered)] : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::getUniformLocations(unsigned int program, int* locations)
+{
+    ContextObjects* objects = currentObjects;
+
+    for (int i = 0; i < programCount; ++i)
+    {
+        if (objects && program && (objects->programs[i] == program))
+        {
+            for (int j = 0; j < UniformCount; ++j)
+                locations[j] = objects->locations[i][j];
+
+            return;
+        }
+    }
+
+    queryUniformLocations(program, locations);
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::useProgram(unsigned int program)
+{
+    glCheck(GLEXT_glUseProgramObject(castToGlHandle(program)));
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setMatrix(int location, const float* matrix)
+{
+    glCheck(GLEXT_glUniformMatrix4fv(location, 1, GL_FALSE, matrix));
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::bindAttributeLocations(unsigned int program)
+{
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), PositionAttribute, "sf_position"));
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), ColorAttribute, "sf_color"));
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), TexCoordsAttribute, "sf_texCoords"));
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), InstanceTransformAttribute, "sf_instanceTransform"));
+    glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), InstanceColorAttribute, "sf_instanceColor"));
+
+    for (unsigned int i = 0; i < VertexLayout::MaxCustomAttributes; ++i)
+    {
+        char name[] = "sf_attribute0";
+        name[sizeof(name) - 2] = static_cast<char>('0' + i);
+        glCheck(GLEXT_glBindAttribLocation(castToGlHandle(program), CustomAttribute + i, name));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const char* CorePipeline::getVersionDirective()
+{
+    return ::getVersionDirective();
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool CorePipeline::isAvailable()
+{
+    // The programmable pipeline is not supported on OpenGL ES
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isRequired()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::isInstancingAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::bind()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::setVertices(const Vertex* /*vertices*/, std::size_t /*vertexCount*/, std::size_t& /*firstVertex*/)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setVertexBuffer(const VertexLayout& /*layout*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::unsetVertexBuffer(const VertexLayout& /*layout*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool CorePipeline::setInstances(const Transform* /*transforms*/, const Color* /*colors*/, std::size_t /*instanceCount*/)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::unsetInstances()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::drawInstanced(unsigned int /*mode*/, std::size_t /*firstVertex*/, std::size_t /*vertexCount*/, std::size_t /*instanceCount*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CorePipeline::getDefaultProgram(bool /*textured*/, bool /*instanced*/, bool /*layered*/)
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::getUniformLocations(unsigned int /*program*/, int* locations)
+{
+    for (int i = 0; i < UniformCount; ++i)
+        locations[i] = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::useProgram(unsigned int /*program*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::setMatrix(int /*location*/, const float* /*matrix*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void CorePipeline::bindAttributeLocations(unsigned int /*program*/)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const char* CorePipeline::getVersionDirective()
+{
+    return "";
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_COREPIPELINE_HPP
+#define SFML_COREPIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Programmable pipeline used by sf::RenderTarget
+///        on core profile OpenGL contexts
+///
+////////////////////////////////////////////////////////////
+class CorePipeline : GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generic vertex attribute locations
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Attribute
+    {
+        PositionAttribute          = 0, ///< sf_position, vec2
+        ColorAttribute             = 1, ///< sf_color, vec4 (normalized)
+        TexCoordsAttribute         = 2, ///< sf_texCoords, vec2 (vec3 with the texture array layer)
+        InstanceTransformAttribute = 3, ///< sf_instanceTransform, mat4 (occupies locations 3 to 6)
+        InstanceColorAttribute     = 7, ///< sf_instanceColor, vec4 (normalized)
+        CustomAttribute            = 8  ///< sf_attribute0 to sf_attribute7, custom vertex layout attributes (occupy locations 8 to 15)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Uniforms set by the pipeline
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Uniform
+    {
+        ProjectionMatrixUniform, ///< sf_projectionMatrix, mat4
+        ModelViewMatrixUniform,  ///< sf_modelViewMatrix, mat4
+        TextureMatrixUniform,    ///< sf_textureMatrix, mat4
+        TextureUniform,          ///< sf_texture, sampler2D (sampler2DArray in the layered program)
+        UniformCount             ///< Keep last -- the total number of uniforms
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports the programmable pipeline
+    ///
+    /// \return True if the programmable pipeline is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the current context requires the programmable pipeline
+    ///
+    /// This is the case of core profile and forward
+    /// compatible contexts, which don't provide the
+    /// fixed-function pipeline and client-side vertex arrays.
+    ///
+    /// \return True if the active context is a core or forward compatible context
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isRequired();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports instanced drawing
+    ///
+    /// \return True if instanced drawing is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isInstancingAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the pipeline objects of the current context
+    ///
+    /// The vertex array object and the default programs
+    /// are created the first time this function is
+    /// called within a context.
+    ///
+    /// \return True on success, false on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool bind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices to the stream buffer and source the attributes from it
+    ///
+    /// bind() must have been called in the current context.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param firstVertex Receives the index of the first vertex to draw
+    ///
+    /// \return True on success, false on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setVertices(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source the attributes from the currently bound vertex buffer
+    ///
+    /// bind() must have been called in the current context.
+    /// Attributes missing from \a layout are given a constant
+    /// value until unsetVertexBuffer() is called.
+    ///
+    /// \param layout Memory layout of the vertices of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setVertexBuffer(const VertexLayout& layout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the attribute arrays changed by setVertexBuffer
+    ///
+    /// \param layout Layout that was passed to setVertexBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unsetVertexBuffer(const VertexLayout& layout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload per-instance data and enable the instance attributes
+    ///
+    /// bind() must have been called in the current context.
+    /// The instance attributes stay enabled until
+    /// unsetInstances() is called.
+    ///
+    /// \param transforms    Pointer to the transform of each instance
+    /// \param colors        Pointer to the color of each instance, can be NULL
+    /// \param instanceCount Number of instances
+    ///
+    /// \return True on success, false on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setInstances(const Transform* transforms, const Color* colors, std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Disable the instance attributes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unsetInstances();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several instances of a range of vertices
+    ///
+    /// \param mode          OpenGL primitive type
+    /// \param firstVertex   Index of the first vertex to draw
+    /// \param vertexCount   Number of vertices to draw
+    /// \param instanceCount Number of instances to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    static void drawInstanced(unsigned int mode, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the default programs of the current context
+    ///
+    /// bind() must have been called in the current context.
+    ///
+    /// \param textured  True to get the program sampling sf_texture
+    /// \param instanced True to get the program applying the instance attributes
+    /// \param layered   True to get the program sampling sf_texture as a texture array,
+    ///                  takes precedence over \a textured
+    ///
+    /// \return OpenGL name of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getDefaultProgram(bool textured, bool instanced, bool layered);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look up the locations of the pipeline uniforms in a program
+    ///
+    /// Locations of the default programs are cached,
+    /// locations of user programs are queried.
+    ///
+    /// \param program   OpenGL name of the program
+    /// \param locations Array of UniformCount locations to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getUniformLocations(unsigned int program, int* locations);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a program current
+    ///
+    /// \param program OpenGL name of the program, 0 for none
+    ///
+    ////////////////////////////////////////////////////////////
+    static void useProgram(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set a 4x4 matrix uniform of the current program
+    ///
+    /// \param location Location of the uniform
+    /// \param matrix   Pointer to the 16 elements of the matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setMatrix(int location, const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the pipeline attribute names to their locations
+    ///
+    /// Must be called before linking a program that
+    /// is meant to be used with the programmable pipeline.
+    ///
+    /// \param program OpenGL name of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bindAttributeLocations(unsigned int program);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the GLSL version directive matching the current context
+    ///
+    /// Shaders written for the programmable pipeline
+    /// must start with this directive.
+    ///
+    /// \return The #version directive, followed by a newline
+    ///
+    ////////////////////////////////////////////////////////////
+    static const char* getVersionDirective();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COREPIPELINE_HPP
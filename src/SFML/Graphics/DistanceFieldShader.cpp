@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DistanceFieldShader.hpp>
+#include <SFML/Graphics/CorePipeline.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <map>
+#include <sstream>
+
+
+namespace
+{
+    // Number of steps the edge values are quantized to
+    const int edgeSteps = 64;
+
+    // Compiled shaders, indexed by quantized edge and pipeline
+    struct ShaderTable
+    {
+        ~ShaderTable()
+        {
+            for (std::map<int, sf::Shader*>::iterator it = shaders.begin(); it != shaders.end(); ++it)
+                delete it->second;
+        }
+
+        std::map<int, sf::Shader*> shaders;
+    };
+
+    // Mutex to protect the shader table
+    sf::Mutex distanceFieldMutex;
+
+    // Shaders for the fixed-function pipeline
+    const char* distanceFieldVertexSource =
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "}\n";
+
+    const char* distanceFieldFragmentSource =
+        "uniform sampler2D distanceField;\n"
+        "void main()\n"
+        "{\n"
+        "    float distance = texture2D(distanceField, gl_TexCoord[0].xy).a;\n"
+        "    float width = max(fwidth(distance) * 0.5, 0.0001);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * smoothstep(EDGE - width, EDGE + width, distance));\n"
+        "}\n";
+
+    // Shaders for the programmable pipeline of core profile contexts
+    const char* coreVertexSource =
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "in vec2 sf_texCoords;\n"
+        "uniform mat4 sf_projectionMatrix;\n"
+        "uniform mat4 sf_modelViewMatrix;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "out vec4 sf_fragmentColor;\n"
+        "out vec2 sf_fragmentTexCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_projectionMatrix * sf_modelViewMatrix * vec4(sf_position, 0.0, 1.0);\n"
+        "    sf_fragmentColor = sf_color;\n"
+        "    sf_fragmentTexCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    const char* coreFragmentSource =
+        "in vec4 sf_fragmentColor;\n"
+        "in vec2 sf_fragmentTexCoords;\n"
+        "uniform sampler2D distanceField;\n"
+        "out vec4 sf_outputColor;\n"
+        "void main()\n"
+        "{\n"
+        "    float distance = texture(distanceField, sf_fragmentTexCoords).a;\n"
+        "    float width = max(fwidth(distance) * 0.5, 0.0001);\n"
+        "    sf_outputColor = vec4(sf_fragmentColor.rgb, sf_fragmentColor.a * smoothstep(EDGE - width, EDGE + width, distance));\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+const Shader* DistanceFieldShader::get(float edge)
+{
+    Lock lock(distanceFieldMutex);
+
+    static ShaderTable table;
+
+    if (edge < 0.f)
+        edge = 0.f;
+    if (edge > 1.f)
+        edge = 1.f;
+
+    // The pipeline depends on the context, it must be active while we query it
+    TransientContextLock contextLock;
+    bool core = CorePipeline::isRequired();
+
+    int step = static_cast<int>(edge * edgeSteps + 0.5f);
+    int key = step * 2 + (core ? 1 : 0);
+
+    std::map<int, Shader*>::iterator it = table.shaders.find(key);
+    if (it != table.shaders.end())
+        return it->second;
+
+    Shader* shader = NULL;
+
+    if (Shader::isAvailable())
+    {
+        std::ostringstream define;
+        define.imbue(std::locale::classic());
+        define << "#define EDGE " << static_cast<float>(step) / edgeSteps << "\n";
+
+        std::string header = core ? std::string(CorePipeline::getVersionDirective()) + define.str() : define.str();
+        std::string vertex = header + (core ? coreVertexSource : distanceFieldVertexSource);
+        std::string fragment = header + (core ? coreFragmentSource : distanceFieldFragmentSource);
+
+        shader = new Shader;
+        if (shader->loadFromMemory(vertex, fragment))
+        {
+            shader->setUniform("distanceField", Shader::CurrentTexture);
+        }
+        else
+        {
+            err() << "Failed to create the distance field text shader" << std::endl;
+            delete shader;
+            shader = NULL;
+        }
+    }
+
+    // Failures are remembered too, so that they are only reported once
+    table.shaders[key] = shader;
+
+    return shader;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_DISTANCEFIELDSHADER_HPP
+#define SFML_DISTANCEFIELDSHADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shaders rendering the distance field glyphs of sf::Text
+///
+////////////////////////////////////////////////////////////
+class DistanceFieldShader : GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader that renders glyphs with a given edge
+    ///
+    /// The edge value is baked into the shader, rather than
+    /// passed as a uniform, so that draws using different
+    /// edges can be deferred (batched, recorded in a render
+    /// queue...) without affecting each other. The values are
+    /// quantized to limit the number of programs.
+    ///
+    /// The shaders are compiled on first use, for the
+    /// pipeline required by the current context.
+    ///
+    /// \param edge Value of the distance field along the edge to render, in [0, 1]
+    ///
+    /// \return Pointer to the shader, NULL if shaders are not available
+    ///
+    ////////////////////////////////////////////////////////////
+    static const Shader* get(float edge);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DISTANCEFIELDSHADER_HPP
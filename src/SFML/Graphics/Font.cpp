@@ -27,19 +27,29 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
+#include <SFML/System/ArchiveInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/SharedLock.hpp>
+#include <SFML/System/Thread.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 
 
 namespace
@@ -62,6 +72,23 @@ namespace
     {
     }
 
+    // FreeType faces are shared between copies of a font and are not thread-safe,
+    // their uses are serialized since glyphs can be rendered in a background thread
+    sf::Mutex freetypeMutex;
+
+    sf::Mutex idMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used to identify the glyphs of a font (see Text)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1;
+
+        return id++;
+    }
+
     // Helper to intepret memory as a specific type
     template <typename T, typename U>
     inline T reinterpret(const U& input)
@@ -76,19 +103,222 @@ namespace
     {
         return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | codePoint;
     }
+
+    // Index of a key in the direct Latin-1 table, or -1 if the glyph is outlined or beyond Latin-1
+    int latin1Index(sf::Uint64 key)
+    {
+        if ((key >> 32) || (key & 0x7FFFFF00))
+            return -1;
+
+        return static_cast<int>(((key >> 31) << 8) | (key & 0xFF));
+    }
+
+    // Scramble the bits of a key, so that close code points don't end up in neighbour slots
+    sf::Uint32 hash(sf::Uint64 key)
+    {
+        sf::Uint32 h = static_cast<sf::Uint32>(key) ^ (static_cast<sf::Uint32>(key >> 32) * 0x9E3779B1u);
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    // Character sizes up to this one have their page directly indexed
+    const unsigned int maxIndexedCharacterSize = 512;
+
+    // Kerning of the pairs of printable ASCII characters is stored in a dense table
+    const sf::Uint32 firstCachedKerning = 32;
+    const sf::Uint32 cachedKerningCount = 95;
+    const float      unknownKerning     = std::numeric_limits<float>::max();
+    const sf::Uint32 unknownKerningBits = reinterpret<sf::Uint32>(unknownKerning);
+
+    // Maximum number of glyphs kept in the shaped runs cache
+    const std::size_t maxCachedRunGlyphs = 65536;
+
+    // Mix a value into the FNV-1a hash of a shaped run
+    void hashRunValue(sf::Uint64& hash, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    // Size of the first texture of a page, and size at which textures stop growing
+    const unsigned int initialAtlasSize = 128;
+    const unsigned int maxAtlasSize = 1024;
+
+    // Distance field glyphs are rasterized once at this size, and stored in the page of this
+    // character size (which is never used to render regular glyphs)
+    const unsigned int distanceFieldSize = 64;
+    const unsigned int distanceFieldPage = 0;
+
+    // Range of the distances stored around the glyphs, in texels -- half
+    // of it is left for the outlines, the other half for the anti-aliasing
+    const int distanceFieldSpread = 16;
+
+    // Squared distance transform of a row or column (Felzenszwalb and Huttenlocher)
+    void distanceTransform(const float* f, float* d, int n, int* v, float* z)
+    {
+        const float infinity = 1e20f;
+
+        int k = 0;
+        v[0] = 0;
+        z[0] = -infinity;
+        z[1] = infinity;
+
+        for (int q = 1; q < n; ++q)
+        {
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            while (s <= z[k])
+            {
+                --k;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+            }
+
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = infinity;
+        }
+
+        k = 0;
+        for (int q = 0; q < n; ++q)
+        {
+            while (z[k + 1] < q)
+                ++k;
+
+            d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+        }
+    }
+
+    // Replace every cell of a grid (0 for the sources, infinity elsewhere) by its squared distance to the nearest source
+    void distanceTransform(std::vector<float>& grid, int width, int height)
+    {
+        int size = std::max(width, height);
+        std::vector<float> f(size);
+        std::vector<float> d(size);
+        std::vector<float> z(size + 1);
+        std::vector<int>   v(size);
+
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+                f[y] = grid[x + y * width];
+
+            distanceTransform(&f[0], &d[0], height, &v[0], &z[0]);
+
+            for (int y = 0; y < height; ++y)
+                grid[x + y * width] = d[y];
+        }
+
+        for (int y = 0; y < height; ++y)
+        {
+            distanceTransform(&grid[y * width], &d[0], width, &v[0], &z[0]);
+            std::copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+        }
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+/// Thread rendering the glyphs requested by preloadGlyphsAsync
+////////////////////////////////////////////////////////////
+struct Font::GlyphLoader
+{
+    struct Result
+    {
+        GlyphRequest request;
+        GlyphBitmap  bitmap;
+    };
+
+    GlyphLoader(const Font& owner) :
+    font     (owner),
+    thread   (&GlyphLoader::run, this),
+    mutex    (),
+    pending  (),
+    results  (),
+    running  (false),
+    cancelled(false)
+    {
+    }
+
+    ~GlyphLoader()
+    {
+        {
+            Lock lock(mutex);
+            cancelled = true;
+        }
+
+        thread.wait();
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            Result result;
+
+            {
+                Lock lock(mutex);
+
+                if (cancelled || pending.empty())
+                {
+                    running = false;
+                    return;
+                }
+
+                result.request = pending.front();
+                pending.pop_front();
+            }
+
+            // Only FreeType is used here, the textures are updated by the thread requesting the glyphs
+            if (font.m_distanceField)
+                font.rasterizeDistanceField(result.request.codePoint, result.request.bold, result.bitmap);
+            else
+                font.rasterizeGlyph(result.request.codePoint, result.request.characterSize, result.request.bold, result.request.outlineThickness, result.bitmap);
+
+            Lock lock(mutex);
+            results.push_back(result);
+        }
+    }
+
+    const Font&               font;      ///< Font which glyphs are rendered
+    Thread                    thread;    ///< Thread running the run function
+    Mutex                     mutex;     ///< Mutex protecting the following members
+    std::deque<GlyphRequest>  pending;   ///< Glyphs waiting to be rendered
+    std::vector<Result>       results;   ///< Rendered glyphs waiting to be written to the textures
+    bool                      running;   ///< Is the thread running?
+    bool                      cancelled; ///< Must the thread stop as soon as possible?
+};
+
+
 ////////////////////////////////////////////////////////////
 Font::Font() :
 m_library  (NULL),
 m_face     (NULL),
 m_streamRec(NULL),
 m_stroker  (NULL),
+m_archiveEntry(NULL),
 m_refCount (NULL),
-m_info     ()
+m_info     (),
+m_pageIndex(new Atomic<Page*>[maxIndexedCharacterSize + 1]),
+m_kernings (),
+m_kerningIndex(new Atomic<KerningCache*>[maxIndexedCharacterSize + 1]),
+m_cacheMutex(),
+m_kerningMutex(),
+m_glyphIndices(),
+m_runs     (),
+m_runTable (),
+m_runGlyphCount(0),
+m_distanceField(false),
+m_glyphLoader(NULL),
+m_cacheId  (getUniqueId())
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -102,10 +332,22 @@ m_library    (copy.m_library),
 m_face       (copy.m_face),
 m_streamRec  (copy.m_streamRec),
 m_stroker    (copy.m_stroker),
+m_archiveEntry(copy.m_archiveEntry),
 m_refCount   (copy.m_refCount),
 m_info       (copy.m_info),
 m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_pageIndex  (new Atomic<Page*>[maxIndexedCharacterSize + 1]),
+m_kernings   (copy.m_kernings),
+m_kerningIndex(new Atomic<KerningCache*>[maxIndexedCharacterSize + 1]),
+m_cacheMutex (),
+m_kerningMutex(),
+m_glyphIndices(copy.m_glyphIndices),
+m_runs       (),
+m_runTable   (),
+m_runGlyphCount(0),
+m_distanceField(copy.m_distanceField),
+m_glyphLoader(NULL),
+m_cacheId    (getUniqueId())
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -124,6 +366,9 @@ Font::~Font()
 {
     cleanup();
 
+    delete[] m_pageIndex;
+    delete[] m_kerningIndex;
+
     #ifdef SFML_SYSTEM_ANDROID
 
     if (m_stream)
@@ -136,6 +381,21 @@ Font::~Font()
 ////////////////////////////////////////////////////////////
 bool Font::loadFromFile(const std::string& filename)
 {
+    // Fonts of mounted archives are read from memory, FreeType keeps reading the file while the face exists
+    ArchiveInputStream* entry = new ArchiveInputStream;
+    if (entry->open(filename))
+    {
+        if (!loadFromMemory(entry->getData(), static_cast<std::size_t>(entry->getSize())))
+        {
+            delete entry;
+            return false;
+        }
+
+        m_archiveEntry = entry;
+        return true;
+    }
+    delete entry;
+
     #ifndef SFML_SYSTEM_ANDROID
 
     // Cleanup the previous resources
@@ -193,8 +453,15 @@ bool Font::loadFromFile(const std::string& filename)
     if (m_stream)
         delete (priv::ResourceStream*)m_stream;
 
-    m_stream = new priv::ResourceStream(filename);
-    return loadFromStream(*(priv::ResourceStream*)m_stream);
+    // The asset stays open while the face exists, FreeType reads its contents in place when possible
+    priv::ResourceStream* stream = new priv::ResourceStream(filename);
+    m_stream = stream;
+
+    const void* data = stream->getData();
+    if (data)
+        return loadFromMemory(data, static_cast<std::size_t>(stream->getSize()));
+
+    return loadFromStream(*stream);
 
     #endif
 }
@@ -344,23 +611,48 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    Page& page = getPage(characterSize);
 
     // Build the key by combining the code point, bold flag, and outline thickness
     Uint64 key = combine(outlineThickness, bold, codePoint);
 
-    // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    // Search the glyph into the cache, without locking
+    const Glyph* glyph = page.glyphs.find(key);
+    if (glyph)
     {
         // Found: just return it
-        return it->second;
+        return *glyph;
     }
     else
     {
-        // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        // Not found: it may have been rendered in the background
+        {
+            Lock lock(m_cacheMutex);
+
+            if (m_glyphLoader)
+            {
+                flushPreloadedGlyphs();
+
+                glyph = page.glyphs.find(key);
+                if (glyph)
+                    return *glyph;
+            }
+        }
+
+        // Still not found: we have to load it
+        if (m_distanceField)
+        {
+            Glyph scaled = loadDistanceFieldGlyph(codePoint, characterSize, bold, outlineThickness);
+
+            Lock lock(m_cacheMutex);
+
+            glyph = page.glyphs.find(key);
+            return glyph ? *glyph : page.glyphs.insert(key, scaled);
+        }
+        else
+        {
+            return loadGlyph(page, key, codePoint, characterSize, bold, outlineThickness);
+        }
     }
 }
 
@@ -374,34 +666,129 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    // Invalid font, or no kerning
+    if (!face || !FT_HAS_KERNING(face))
+        return 0.f;
+
+    KerningCache& cache = getKerningCache(characterSize);
+
+    // Pairs of printable ASCII characters are directly indexed
+    Uint32 firstIndex = first - firstCachedKerning;
+    Uint32 secondIndex = second - firstCachedKerning;
+    if ((firstIndex < cachedKerningCount) && (secondIndex < cachedKerningCount))
     {
-        // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        // Threads racing to load the same pair store the same value
+        Atomic<Uint32>& bits = cache.ascii[firstIndex * cachedKerningCount + secondIndex];
+        Uint32 kerning = bits.load(Memory::Relaxed);
+        if (kerning == unknownKerningBits)
+        {
+            kerning = reinterpret<Uint32>(loadKerning(first, second, characterSize));
+            bits.store(kerning, Memory::Relaxed);
+        }
 
-        // Get the kerning vector
-        FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+        return reinterpret<float>(kerning);
+    }
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+    Uint64 key = (static_cast<Uint64>(first) << 32) | second;
+    {
+        SharedLock lock(m_kerningMutex);
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+        std::map<Uint64, float>::const_iterator it = cache.pairs.find(key);
+        if (it != cache.pairs.end())
+            return it->second;
     }
-    else
+
+    float kerning = loadKerning(first, second, characterSize);
+
+    m_kerningMutex.lock();
+    cache.pairs.insert(std::make_pair(key, kerning));
+    m_kerningMutex.unlock();
+
+    return kerning;
+}
+
+
+////////////////////////////////////////////////////////////
+const Font::ShapedRun& Font::shape(const String& string, unsigned int characterSize, bool bold) const
+{
+    Uint64 runHash = 14695981039346656037ULL;
+    hashRunValue(runHash, characterSize);
+    hashRunValue(runHash, bold);
+    for (std::size_t i = 0; i < string.getSize(); ++i)
+        hashRunValue(runHash, string[i]);
+
+    // Look for the run in the cache
+    std::pair<RunTable::iterator, RunTable::iterator> range = m_runTable.equal_range(runHash);
+    for (RunTable::iterator it = range.first; it != range.second; ++it)
     {
-        // Invalid font, or no kerning
-        return 0.f;
+        RunList::iterator run = it->second;
+        if ((run->characterSize == characterSize) && (run->bold == bold) && (run->string == string))
+        {
+            // Mark the run as the most recently used
+            m_runs.splice(m_runs.begin(), m_runs, run);
+            return run->glyphs;
+        }
     }
+
+    m_runs.push_front(CachedRun());
+
+    CachedRun& run    = m_runs.front();
+    run.hash          = runHash;
+    run.characterSize = characterSize;
+    run.bold          = bold;
+    run.string        = string;
+    run.glyphs.resize(string.getSize());
+
+    // Place the glyphs one after the other
+    float  x        = 0.f;
+    Uint32 prevChar = 0;
+    for (std::size_t i = 0; i < string.getSize(); ++i)
+    {
+        Uint32 curChar = string[i];
+
+        x += getKerning(prevChar, curChar, characterSize);
+        prevChar = curChar;
+
+        ShapedGlyph& glyph = run.glyphs[i];
+        glyph.codePoint = curChar;
+        glyph.cluster   = i;
+        glyph.offset    = x;
+        glyph.advance   = getGlyph(curChar, characterSize, bold).advance;
+
+        x += glyph.advance;
+    }
+
+    m_runTable.insert(std::make_pair(runHash, m_runs.begin()));
+    m_runGlyphCount += run.glyphs.size();
+
+    // Evict the least recently used runs, but always keep the new one
+    while ((m_runGlyphCount > maxCachedRunGlyphs) && (m_runs.size() > 1))
+    {
+        RunList::iterator last = --m_runs.end();
+
+        std::pair<RunTable::iterator, RunTable::iterator> lastRange = m_runTable.equal_range(last->hash);
+        for (RunTable::iterator it = lastRange.first; it != lastRange.second; ++it)
+        {
+            if (it->second == last)
+            {
+                m_runTable.erase(it);
+                break;
+            }
+        }
+
+        m_runGlyphCount -= last->glyphs.size();
+        m_runs.erase(last);
+    }
+
+    return m_runs.front().glyphs;
 }
 
 
 ////////////////////////////////////////////////////////////
 float Font::getLineSpacing(unsigned int characterSize) const
 {
+    Lock lock(freetypeMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -418,6 +805,8 @@ float Font::getLineSpacing(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlinePosition(unsigned int characterSize) const
 {
+    Lock lock(freetypeMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -438,6 +827,8 @@ float Font::getUnderlinePosition(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 float Font::getUnderlineThickness(unsigned int characterSize) const
 {
+    Lock lock(freetypeMutex);
+
     FT_Face face = static_cast<FT_Face>(m_face);
 
     if (face && setCurrentSize(characterSize))
@@ -456,9 +847,113 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-const Texture& Font::getTexture(unsigned int characterSize) const
+const Texture& Font::getTexture(unsigned int characterSize, unsigned int index) const
+{
+    // Distance field glyphs of all sizes share the same textures
+    Page& page = getPage(m_distanceField ? distanceFieldPage : characterSize);
+
+    // Write the glyphs loaded since the last call, possibly by other threads
+    if (page.dirty.load(Memory::Acquire))
+        updateTextures(page);
+
+    return (index < page.textures.size()) ? page.textures[index] : page.textures[0];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getTextureCount(unsigned int characterSize) const
+{
+    return getPage(m_distanceField ? distanceFieldPage : characterSize).atlasCount.load(Memory::Acquire);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setDistanceFieldEnabled(bool enabled)
+{
+    if (enabled != m_distanceField)
+    {
+        // Glyphs being preloaded are rendered for the previous mode
+        delete m_glyphLoader;
+        m_glyphLoader = NULL;
+
+        m_distanceField = enabled;
+
+        // The glyphs of the previous mode are useless now
+        m_pages.clear();
+        for (unsigned int i = 0; i <= maxIndexedCharacterSize; ++i)
+            m_pageIndex[i].store(NULL, Memory::Relaxed);
+        m_cacheId = getUniqueId();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isDistanceFieldEnabled() const
+{
+    return m_distanceField;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
+        getGlyph(*it, characterSize, bold, outlineThickness);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphsAsync(const String& characters, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    if (!m_face)
+        return;
+
+    Lock cacheLock(m_cacheMutex);
+
+    if (!m_glyphLoader)
+        m_glyphLoader = new GlyphLoader(*this);
+
+    {
+        Lock lock(m_glyphLoader->mutex);
+
+        for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
+        {
+            GlyphRequest request;
+            request.codePoint        = *it;
+            request.characterSize    = characterSize;
+            request.bold             = bold;
+            request.outlineThickness = outlineThickness;
+
+            // Skip the glyphs that are already loaded (without creating their page here)
+            PageTable::const_iterator page = m_pages.find(getPreloadedPage(request));
+            if ((page != m_pages.end()) && page->second.glyphs.find(getPreloadedKey(request)))
+                continue;
+
+            m_glyphLoader->pending.push_back(request);
+        }
+
+        if (m_glyphLoader->pending.empty() || m_glyphLoader->running)
+            return;
+
+        m_glyphLoader->running = true;
+    }
+
+    // The previous run of the thread, if any, has already returned
+    m_glyphLoader->thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isPreloadingGlyphs() const
 {
-    return m_pages[characterSize].texture;
+    Lock cacheLock(m_cacheMutex);
+
+    if (!m_glyphLoader)
+        return false;
+
+    Lock lock(m_glyphLoader->mutex);
+
+    return m_glyphLoader->running;
 }
 
 
@@ -467,26 +962,52 @@ Font& Font::operator =(const Font& right)
 {
     Font temp(right);
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_stroker,     temp.m_stroker);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::swap(Font& right)
+{
+    // The threads preloading glyphs write to the font that started them, they can't follow a swap
+    delete m_glyphLoader;
+    m_glyphLoader = NULL;
+    delete right.m_glyphLoader;
+    right.m_glyphLoader = NULL;
+
+    std::swap(m_library,     right.m_library);
+    std::swap(m_face,        right.m_face);
+    std::swap(m_streamRec,   right.m_streamRec);
+    std::swap(m_stroker,     right.m_stroker);
+    std::swap(m_archiveEntry, right.m_archiveEntry);
+    std::swap(m_refCount,    right.m_refCount);
+    std::swap(m_info,        right.m_info);
+    std::swap(m_pages,       right.m_pages);
+    std::swap(m_pageIndex,   right.m_pageIndex);
+    std::swap(m_kernings,    right.m_kernings);
+    std::swap(m_kerningIndex, right.m_kerningIndex);
+    std::swap(m_glyphIndices, right.m_glyphIndices);
+    std::swap(m_runs,        right.m_runs);
+    std::swap(m_runTable,    right.m_runTable);
+    std::swap(m_runGlyphCount, right.m_runGlyphCount);
+    std::swap(m_distanceField, right.m_distanceField);
+    std::swap(m_cacheId,       right.m_cacheId);
 
     #ifdef SFML_SYSTEM_ANDROID
-        std::swap(m_stream, temp.m_stream);
+        std::swap(m_stream, right.m_stream);
     #endif
-
-    return *this;
 }
 
 
 ////////////////////////////////////////////////////////////
 void Font::cleanup()
 {
+    // Stop preloading glyphs before the FreeType objects are destroyed
+    delete m_glyphLoader;
+    m_glyphLoader = NULL;
+
     // Check if we must destroy the FreeType pointers
     if (m_refCount)
     {
@@ -511,6 +1032,9 @@ void Font::cleanup()
             if (m_streamRec)
                 delete static_cast<FT_StreamRec*>(m_streamRec);
 
+            // Release the archive file the face was read from, if any (must be done after FT_Done_Face too)
+            delete m_archiveEntry;
+
             // Close the library
             if (m_library)
                 FT_Done_FreeType(static_cast<FT_Library>(m_library));
@@ -522,38 +1046,75 @@ void Font::cleanup()
     m_face      = NULL;
     m_stroker   = NULL;
     m_streamRec = NULL;
+    m_archiveEntry = NULL;
     m_refCount  = NULL;
     m_pages.clear();
-    std::vector<Uint8>().swap(m_pixelBuffer);
+    m_kernings.clear();
+    for (unsigned int i = 0; i <= maxIndexedCharacterSize; ++i)
+    {
+        m_pageIndex[i].store(NULL, Memory::Relaxed);
+        m_kerningIndex[i].store(NULL, Memory::Relaxed);
+    }
+    m_glyphIndices.clear();
+    m_runs.clear();
+    m_runTable.clear();
+    m_runGlyphCount = 0;
+    m_cacheId = getUniqueId();
 }
 
 
 ////////////////////////////////////////////////////////////
-Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+const Glyph& Font::loadGlyph(Page& page, Uint64 key, Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
-    // The glyph to return
-    Glyph glyph;
+    SFML_PROFILE_SCOPE("Font::loadGlyph");
+
+    // Render outside of the cache mutex, the other threads keep finding and loading their glyphs meanwhile
+    GlyphBitmap bitmap;
+    rasterizeGlyph(codePoint, characterSize, bold, outlineThickness, bitmap);
+
+    Lock lock(m_cacheMutex);
+
+    // Another thread may have loaded the same glyph in the meantime
+    const Glyph* glyph = page.glyphs.find(key);
+    if (glyph)
+        return *glyph;
+
+    return page.glyphs.insert(key, packGlyph(page, bitmap));
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::rasterizeGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness, GlyphBitmap& result) const
+{
+    // Start from an empty glyph
+    result.glyph   = Glyph();
+    result.width   = 0;
+    result.height  = 0;
+    result.padding = 0;
+    Glyph& glyph = result.glyph;
+
+    Lock lock(freetypeMutex);
 
     // First, transform our ugly void* to a FT_Face
     FT_Face face = static_cast<FT_Face>(m_face);
     if (!face)
-        return glyph;
+        return;
 
     // Set the character size
     if (!setCurrentSize(characterSize))
-        return glyph;
+        return;
 
     // Load the glyph corresponding to the code point
     FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
     if (outlineThickness != 0)
         flags |= FT_LOAD_NO_BITMAP;
     if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+        return;
 
     // Retrieve the glyph
     FT_Glyph glyphDesc;
     if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+        return;
 
     // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
     FT_Pos weight = 1 << 6;
@@ -606,18 +1167,9 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         width += 2 * padding;
         height += 2 * padding;
 
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
-
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width, height);
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
+        result.width   = width;
+        result.height  = height;
+        result.padding = padding;
 
         // Compute the glyph's bounding box
         glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
@@ -626,9 +1178,10 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
 
         // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+        std::vector<Uint8>& pixelBuffer = result.pixels;
+        pixelBuffer.resize(width * height * 4);
 
-        Uint8* current = &m_pixelBuffer[0];
+        Uint8* current = &pixelBuffer[0];
         Uint8* end = current + width * height * 4;
 
         while (current != end)
@@ -650,7 +1203,7 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
                 {
                     // The color channels remain white, just fill the alpha channel
                     std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+                    pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
                 }
                 pixels += bitmap.pitch;
             }
@@ -664,93 +1217,439 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
                 {
                     // The color channels remain white, just fill the alpha channel
                     std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
+                    pixelBuffer[index * 4 + 3] = pixels[x - padding];
                 }
                 pixels += bitmap.pitch;
             }
         }
-
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
     }
 
     // Delete the FT glyph
     FT_Done_Glyph(glyphDesc);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::packGlyph(Page& page, GlyphBitmap& bitmap) const
+{
+    Glyph glyph = bitmap.glyph;
+
+    if ((bitmap.width == 0) || (bitmap.height == 0))
+        return glyph;
+
+    // Find a good position for the new glyph into the texture
+    IntRect rect = findGlyphRect(page, bitmap.width, bitmap.height, glyph.textureIndex);
+
+    // Queue the pixels, they are written to the texture by the thread that draws with it
+    page.uploads.push_back(GlyphUpload());
+    GlyphUpload& upload = page.uploads.back();
+    upload.textureIndex = glyph.textureIndex;
+    upload.rect = IntRect(rect.left, rect.top, static_cast<int>(bitmap.width), static_cast<int>(bitmap.height));
+    upload.pixels.swap(bitmap.pixels);
+    page.dirty.store(true, Memory::Release);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    int padding = static_cast<int>(bitmap.padding);
+    glyph.textureRect = IntRect(rect.left + padding, rect.top + padding, rect.width - 2 * padding, rect.height - 2 * padding);
 
-    // Done :)
     return glyph;
 }
 
 
 ////////////////////////////////////////////////////////////
-IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
+void Font::updateTextures(Page& page) const
 {
-    // Find the line that fits well the glyph
-    Row* row = NULL;
-    float bestRatio = 0;
-    for (std::vector<Row>::iterator it = page.rows.begin(); it != page.rows.end() && !row; ++it)
+    Lock lock(m_cacheMutex);
+
+    for (std::size_t i = 0; i < page.atlases.size(); ++i)
     {
-        float ratio = static_cast<float>(height) / it->height;
+        const Atlas& atlas = page.atlases[i];
+
+        if (i == page.textures.size())
+        {
+            page.textures.push_back(Texture());
+            Texture& texture = page.textures.back();
 
-        // Ignore rows that are either too small or too high
-        if ((ratio < 0.7f) || (ratio > 1.f))
-            continue;
+            if (i == 0)
+            {
+                // Make sure that the texture is initialized by default
+                sf::Image image;
+                image.create(atlas.size.x, atlas.size.y, Color(255, 255, 255, 0));
 
-        // Check if there's enough horizontal space left in the row
-        if (width > page.texture.getSize().x - it->width)
-            continue;
+                // Reserve a 2x2 white square for texturing underlines
+                for (int x = 0; x < 2; ++x)
+                    for (int y = 0; y < 2; ++y)
+                        image.setPixel(x, y, Color(255, 255, 255, 255));
 
-        // Make sure that this new row is the best found so far
-        if (ratio < bestRatio)
-            continue;
+                texture.loadFromImage(image);
+            }
+            else
+            {
+                texture.create(atlas.size.x, atlas.size.y);
+            }
 
-        // The current row passed all the tests: we can select it
-        row = &*it;
-        bestRatio = ratio;
+            texture.setSmooth(true);
+        }
+        else if (page.textures[i].getSize() != atlas.size)
+        {
+            Texture& texture = page.textures[i];
+            Vector2u textureSize = texture.getSize();
+
+            // The atlas has grown: make the texture as big as its layout
+            Texture newTexture;
+            if (!newTexture.create(atlas.size.x, atlas.size.y))
+                continue;
+
+            newTexture.setSmooth(texture.isSmooth());
+            // Copy the glyphs on the graphics card, only go through system memory if it can't
+            if (!newTexture.copyFrom(texture, IntRect(0, 0, static_cast<int>(textureSize.x), static_cast<int>(textureSize.y)), Vector2u(0, 0)))
+                newTexture.update(texture.copyToImage());
+            texture.swap(newTexture);
+        }
     }
 
-    // If we didn't find a matching row, create a new one (10% taller than the glyph)
-    if (!row)
+    // Write the pixels of the glyphs packed since the last update
+    for (std::vector<GlyphUpload>::const_iterator it = page.uploads.begin(); it != page.uploads.end(); ++it)
     {
-        int rowHeight = height + height / 10;
-        while ((page.nextRow + rowHeight >= page.texture.getSize().y) || (width >= page.texture.getSize().x))
+        Texture& texture = page.textures[it->textureIndex];
+        if ((static_cast<unsigned int>(it->rect.left + it->rect.width) <= texture.getSize().x) &&
+            (static_cast<unsigned int>(it->rect.top + it->rect.height) <= texture.getSize().y))
         {
-            // Not enough space: resize the texture if possible
-            unsigned int textureWidth  = page.texture.getSize().x;
-            unsigned int textureHeight = page.texture.getSize().y;
-            if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
-            {
-                // Make the texture 2 times bigger
-                Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.update(page.texture);
-                page.texture.swap(newTexture);
-            }
-            else
+            texture.update(&it->pixels[0], static_cast<unsigned int>(it->rect.width), static_cast<unsigned int>(it->rect.height),
+                           static_cast<unsigned int>(it->rect.left), static_cast<unsigned int>(it->rect.top));
+        }
+    }
+
+    page.uploads.clear();
+    page.dirty.store(false, Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::loadDistanceFieldGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
+{
+    // Get the glyph at the reference size, rasterize it if it's the first time it is used
+    Page& fieldPage = getPage(distanceFieldPage);
+    Uint64 key = combine(0.f, bold, codePoint);
+
+    const Glyph* found = fieldPage.glyphs.find(key);
+    if (!found)
+    {
+        GlyphBitmap bitmap;
+        rasterizeDistanceField(codePoint, bold, bitmap);
+
+        Lock lock(m_cacheMutex);
+
+        // Another thread may have loaded the same glyph in the meantime
+        found = fieldPage.glyphs.find(key);
+        if (!found)
+            found = &fieldPage.glyphs.insert(key, packGlyph(fieldPage, bitmap));
+    }
+
+    const Glyph& reference = *found;
+
+    float scale = static_cast<float>(characterSize) / distanceFieldSize;
+
+    Glyph glyph;
+    glyph.advance = reference.advance * scale;
+    glyph.textureIndex = reference.textureIndex;
+
+    if ((reference.textureRect.width == 0) || (reference.textureRect.height == 0))
+        return glyph;
+
+    // Extend the quad around the glyph, far enough to cover the outline and
+    // about one pixel of anti-aliasing, but not beyond the stored distances
+    const int maxMargin = distanceFieldSpread / 2;
+    float outlineTexels = std::max(0.f, std::min(outlineThickness / scale, static_cast<float>(maxMargin)));
+    int antialiasingTexels = std::max(1, std::min(static_cast<int>(std::ceil(1.f / scale)), maxMargin));
+    int margin = static_cast<int>(std::ceil(outlineTexels)) + antialiasingTexels;
+
+    glyph.textureRect.left   = reference.textureRect.left - margin;
+    glyph.textureRect.top    = reference.textureRect.top - margin;
+    glyph.textureRect.width  = reference.textureRect.width + 2 * margin;
+    glyph.textureRect.height = reference.textureRect.height + 2 * margin;
+
+    // sf::Text offsets outlined glyphs by their outline thickness, like the glyphs outlined by FreeType
+    glyph.bounds.left   = (reference.bounds.left - margin) * scale + outlineThickness;
+    glyph.bounds.top    = (reference.bounds.top - margin) * scale + outlineThickness;
+    glyph.bounds.width  = (reference.bounds.width + 2 * margin) * scale;
+    glyph.bounds.height = (reference.bounds.height + 2 * margin) * scale;
+
+    return glyph;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::rasterizeDistanceField(Uint32 codePoint, bool bold, GlyphBitmap& result) const
+{
+    // Start from an empty glyph
+    result.glyph   = Glyph();
+    result.width   = 0;
+    result.height  = 0;
+    result.padding = distanceFieldSpread;
+    Glyph& glyph = result.glyph;
+
+    // Coverage of the glyph's pixels, surrounded by the spread
+    std::vector<float> coverage;
+    int width  = 0;
+    int height = 0;
+
+    {
+        Lock lock(freetypeMutex);
+
+        FT_Face face = static_cast<FT_Face>(m_face);
+        if (!face)
+            return;
+
+        if (!setCurrentSize(distanceFieldSize))
+            return;
+
+        // Hinting is meaningless for glyphs that are scaled afterwards
+        if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING) != 0)
+            return;
+
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return;
+
+        // Apply bold if necessary, like loadGlyph does
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (outline && bold)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+        FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+
+        if (!outline && bold)
+            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+        int bitmapWidth  = bitmap.width;
+        int bitmapHeight = bitmap.rows;
+
+        if ((bitmapWidth > 0) && (bitmapHeight > 0))
+        {
+            // The bitmap of an unhinted glyph can be larger than its metrics, derive the bounds from the bitmap
+            glyph.bounds.left   = static_cast<float>(bitmapGlyph->left);
+            glyph.bounds.top    = -static_cast<float>(bitmapGlyph->top);
+            glyph.bounds.width  = static_cast<float>(bitmapWidth);
+            glyph.bounds.height = static_cast<float>(bitmapHeight);
+
+            // Store the distances up to the spread around the glyph
+            width  = bitmapWidth + 2 * distanceFieldSpread;
+            height = bitmapHeight + 2 * distanceFieldSpread;
+
+            // Extract the coverage of the glyph's pixels
+            coverage.resize(width * height, 0.f);
+            const Uint8* pixels = bitmap.buffer;
+            for (int y = 0; y < bitmapHeight; ++y)
             {
-                // Oops, we've reached the maximum texture size...
-                err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
-                return IntRect(0, 0, 2, 2);
+                for (int x = 0; x < bitmapWidth; ++x)
+                {
+                    float value;
+                    if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                        value = (pixels[x / 8] & (1 << (7 - (x % 8)))) ? 1.f : 0.f;
+                    else
+                        value = pixels[x] / 255.f;
+
+                    coverage[(x + distanceFieldSpread) + (y + distanceFieldSpread) * width] = value;
+                }
+                pixels += bitmap.pitch;
             }
         }
 
-        // We can now create the new row
-        page.rows.push_back(Row(page.nextRow, rowHeight));
-        page.nextRow += rowHeight;
-        row = &page.rows.back();
+        FT_Done_Glyph(glyphDesc);
+    }
+
+    if (coverage.empty())
+        return;
+
+    // Compute the distance of every texel to the inside and to the outside of the glyph
+    const float infinity = 1e20f;
+    std::vector<float> toInside(width * height);
+    std::vector<float> toOutside(width * height);
+    for (std::size_t i = 0; i < coverage.size(); ++i)
+    {
+        toInside[i]  = (coverage[i] >= 0.5f) ? 0.f : infinity;
+        toOutside[i] = (coverage[i] >= 0.5f) ? infinity : 0.f;
+    }
+
+    distanceTransform(toInside, width, height);
+    distanceTransform(toOutside, width, height);
+
+    // Encode the signed distances (positive outside) so that the edge lies at 0.5
+    std::vector<Uint8>& pixelBuffer = result.pixels;
+    pixelBuffer.resize(width * height * 4);
+    for (std::size_t i = 0; i < coverage.size(); ++i)
+    {
+        float distance;
+        if ((coverage[i] > 0.f) && (coverage[i] < 1.f))
+            distance = 0.5f - coverage[i]; // Anti-aliased pixels are right on the edge
+        else if (coverage[i] >= 0.5f)
+            distance = 0.5f - std::sqrt(toOutside[i]);
+        else
+            distance = std::sqrt(toInside[i]) - 0.5f;
+
+        float value = 0.5f - distance / (2 * distanceFieldSpread);
+        value = std::max(0.f, std::min(value, 1.f));
+
+        pixelBuffer[i * 4 + 0] = 255;
+        pixelBuffer[i * 4 + 1] = 255;
+        pixelBuffer[i * 4 + 2] = 255;
+        pixelBuffer[i * 4 + 3] = static_cast<Uint8>(value * 255.f + 0.5f);
+    }
+
+    // The glyph's texture rectangle will exclude the stored surroundings
+    result.width  = width;
+    result.height = height;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::flushPreloadedGlyphs() const
+{
+    // Take the glyphs rendered so far, the thread keeps working meanwhile
+    std::vector<GlyphLoader::Result> results;
+    bool finished;
+    {
+        Lock lock(m_glyphLoader->mutex);
+
+        results.swap(m_glyphLoader->results);
+        finished = !m_glyphLoader->running;
+    }
+
+    // Store them, unless they were loaded on demand in the meantime
+    for (std::vector<GlyphLoader::Result>::iterator it = results.begin(); it != results.end(); ++it)
+    {
+        Page& page = getPage(getPreloadedPage(it->request));
+        Uint64 key = getPreloadedKey(it->request);
+
+        if (!page.glyphs.find(key))
+            page.glyphs.insert(key, packGlyph(page, it->bitmap));
+    }
+
+    // Release the thread once all the requested glyphs are loaded
+    if (finished)
+    {
+        delete m_glyphLoader;
+        m_glyphLoader = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getPreloadedPage(const GlyphRequest& request) const
+{
+    return m_distanceField ? distanceFieldPage : request.characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Font::getPreloadedKey(const GlyphRequest& request) const
+{
+    // Distance field glyphs are stored once, for all the sizes and outline thicknesses
+    if (m_distanceField)
+        return combine(0.f, request.bold, request.codePoint);
+    else
+        return combine(request.outlineThickness, request.bold, request.codePoint);
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::getDistanceFieldEdge(unsigned int characterSize, float outlineThickness) const
+{
+    // Same limit as the margin of the glyphs' quads
+    const float maxOutline = distanceFieldSpread / 2.f;
+
+    float scale = static_cast<float>(characterSize) / distanceFieldSize;
+    float distance = std::max(-maxOutline, std::min(outlineThickness / scale, maxOutline));
+
+    return 0.5f - distance / (2 * distanceFieldSpread);
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height, unsigned int& textureIndex) const
+{
+    IntRect rect;
+
+    // Try the existing textures first, the older ones may still have some room left
+    for (std::size_t i = 0; i < page.atlases.size(); ++i)
+    {
+        if (packGlyphRect(page.atlases[i], width, height, rect))
+        {
+            textureIndex = static_cast<unsigned int>(i);
+            return rect;
+        }
+    }
+
+    // Textures don't grow beyond a fixed size, unless a single glyph needs more
+    unsigned int maximumSize = std::min(maxAtlasSize, Texture::getMaximumSize());
+    if ((width > maximumSize) || (height > maximumSize))
+        maximumSize = Texture::getMaximumSize();
+
+    // Not enough space: resize the last texture if possible
+    Atlas& atlas = page.atlases.back();
+    while ((atlas.size.x * 2 <= maximumSize) && (atlas.size.y * 2 <= maximumSize))
+    {
+        unsigned int textureWidth  = atlas.size.x;
+        unsigned int textureHeight = atlas.size.y;
+
+        // Make the texture 2 times bigger
+        atlas.size = Vector2u(textureWidth * 2, textureHeight * 2);
+        page.dirty.store(true, Memory::Release);
+
+        // The new right half is entirely free, the bottom half is below the existing segments
+        atlas.skyline.push_back(Segment(textureWidth, 0, textureWidth));
+
+        if (packGlyphRect(atlas, width, height, rect))
+        {
+            textureIndex = static_cast<unsigned int>(page.atlases.size() - 1);
+            return rect;
+        }
     }
 
-    // Find the glyph's rectangle on the selected row
-    IntRect rect(row->width, row->top, width, height);
+    // The last texture is full: add a new one to the page
+    if ((width <= maximumSize) && (height <= maximumSize))
+    {
+        page.atlases.push_back(Atlas());
+        Atlas& newAtlas = page.atlases.back();
+
+        newAtlas.size = Vector2u(maximumSize, maximumSize);
+        newAtlas.skyline.push_back(Segment(0, 0, maximumSize));
 
-    // Update the row informations
-    row->width += width;
+        if (packGlyphRect(newAtlas, width, height, rect))
+        {
+            page.atlasCount.store(static_cast<unsigned int>(page.atlases.size()), Memory::Release);
+            page.dirty.store(true, Memory::Release);
 
-    return rect;
+            textureIndex = static_cast<unsigned int>(page.atlases.size() - 1);
+            return rect;
+        }
+
+        page.atlases.pop_back();
+    }
+
+    // Oops, we've reached the maximum texture size...
+    err() << "Failed to add a new character to the font: the maximum texture size has been reached" << std::endl;
+    textureIndex = 0;
+    return IntRect(0, 0, 2, 2);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::packGlyphRect(Atlas& atlas, unsigned int width, unsigned int height, IntRect& rect) const
+{
+    return priv::packSkyline(atlas.skyline, atlas.size.x, atlas.size.y, width, height, rect);
 }
 
 
@@ -790,22 +1689,289 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    // Fast path: the page of this size was already looked up
+    if (characterSize <= maxIndexedCharacterSize)
+    {
+        Page* page = m_pageIndex[characterSize].load(Memory::Acquire);
+        if (page)
+            return *page;
+    }
+
+    Lock lock(m_cacheMutex);
+
+    // Pages are stored in the map so that they never move in memory
+    Page& page = m_pages[characterSize];
+
+    if (characterSize <= maxIndexedCharacterSize)
+        m_pageIndex[characterSize].store(&page, Memory::Release);
+
+    return page;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::KerningCache& Font::getKerningCache(unsigned int characterSize) const
+{
+    if (characterSize <= maxIndexedCharacterSize)
+    {
+        KerningCache* cache = m_kerningIndex[characterSize].load(Memory::Acquire);
+        if (cache)
+            return *cache;
+    }
+
+    m_kerningMutex.lock();
+
+    KerningCache& cache = m_kernings[characterSize];
+
+    if (characterSize <= maxIndexedCharacterSize)
+        m_kerningIndex[characterSize].store(&cache, Memory::Release);
+
+    m_kerningMutex.unlock();
+
+    return cache;
+}
+
+
+////////////////////////////////////////////////////////////
+float Font::loadKerning(Uint32 first, Uint32 second, unsigned int characterSize) const
+{
+    Lock lock(freetypeMutex);
+
+    FT_Face face = static_cast<FT_Face>(m_face);
+
+    if (!setCurrentSize(characterSize))
+        return 0.f;
+
+    // Get the kerning vector
+    FT_Vector kerning;
+    FT_Get_Kerning(face, getGlyphIndex(first), getGlyphIndex(second), FT_KERNING_DEFAULT, &kerning);
+
+    // X advance is already in pixels for bitmap fonts
+    if (!FT_IS_SCALABLE(face))
+        return static_cast<float>(kerning.x);
+
+    // Return the X advance
+    return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Font::getGlyphIndex(Uint32 codePoint) const
+{
+    std::map<Uint32, unsigned int>::const_iterator it = m_glyphIndices.find(codePoint);
+    if (it == m_glyphIndices.end())
+        it = m_glyphIndices.insert(std::make_pair(codePoint, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint))).first;
+
+    return it->second;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+glyphs    (),
+atlases   (1),
+uploads   (),
+textures  (),
+atlasCount(1),
+dirty     (true)
+{
+    // The texture is created by updateTextures, in the thread that draws with it
+    Atlas& atlas = atlases.back();
+    atlas.size = Vector2u(initialAtlasSize, initialAtlasSize);
+
+    // Glyphs are packed below the white square reserved for texturing underlines
+    atlas.skyline.push_back(Segment(0, 3, initialAtlasSize));
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page::Page(const Page& copy) :
+glyphs    (copy.glyphs),
+atlases   (copy.atlases),
+uploads   (copy.uploads),
+textures  (copy.textures),
+atlasCount(copy.atlasCount.load(Memory::Relaxed)),
+dirty     (copy.dirty.load(Memory::Relaxed))
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::KerningCache::KerningCache() :
+pairs()
+{
+    for (Uint32 i = 0; i < cachedKerningCount * cachedKerningCount; ++i)
+        ascii[i].store(unknownKerningBits, Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::KerningCache::KerningCache(const KerningCache& copy) :
+pairs(copy.pairs)
+{
+    for (Uint32 i = 0; i < cachedKerningCount * cachedKerningCount; ++i)
+        ascii[i].store(copy.ascii[i].load(Memory::Relaxed), Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphBitmap::GlyphBitmap() :
+glyph  (),
+width  (0),
+height (0),
+padding(0),
+pixels ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+/// Slots of the hashed keys of a glyph table
+////////////////////////////////////////////////////////////
+struct Font::GlyphTable::Slots : NonCopyable
+{
+    explicit Slots(std::size_t slotCount) :
+    count (slotCount),
+    keys  (new Uint64[slotCount]),
+    glyphs(new Atomic<const Glyph*>[slotCount])
+    {
+    }
+
+    ~Slots()
+    {
+        delete[] keys;
+        delete[] glyphs;
+    }
+
+    std::size_t           count;  ///< Number of slots, a power of two
+    Uint64*               keys;   ///< Key of each slot, written before its glyph
+    Atomic<const Glyph*>* glyphs; ///< Glyph of each slot, NULL for empty slots
+};
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::GlyphTable() :
+m_slots  (NULL),
+m_retired(),
+m_count  (0),
+m_entries()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::GlyphTable(const GlyphTable& copy) :
+m_slots  (NULL),
+m_retired(),
+m_count  (0),
+m_entries()
+{
+    // The glyphs are inserted again, so that the slots point to our own copies
+    for (std::deque<Entry>::const_iterator it = copy.m_entries.begin(); it != copy.m_entries.end(); ++it)
+        insert(it->first, it->second);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::~GlyphTable()
 {
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
+    delete m_slots.load(Memory::Relaxed);
+
+    for (std::vector<Slots*>::iterator it = m_retired.begin(); it != m_retired.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph* Font::GlyphTable::find(Uint64 key) const
+{
+    int index = latin1Index(key);
+    if (index >= 0)
+        return m_latin1[index].load(Memory::Acquire);
+
+    const Slots* slots = m_slots.load(Memory::Acquire);
+    if (!slots)
+        return NULL;
+
+    // Probe the slots until we find the key or an empty slot
+    std::size_t mask = slots->count - 1;
+    for (std::size_t i = hash(key) & mask; ; i = (i + 1) & mask)
+    {
+        // The key of a slot is visible once its glyph is
+        const Glyph* glyph = slots->glyphs[i].load(Memory::Acquire);
+        if (!glyph)
+            return NULL;
+
+        if (slots->keys[i] == key)
+            return glyph;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::GlyphTable::insert(Uint64 key, const Glyph& glyph)
+{
+    m_entries.push_back(Entry(key, glyph));
+    const Glyph* stored = &m_entries.back().second;
+
+    int index = latin1Index(key);
+    if (index >= 0)
+    {
+        m_latin1[index].store(stored, Memory::Release);
+        return *stored;
+    }
+
+    // Keep the load factor below 3/4 so that probing sequences stay short
+    Slots* slots = m_slots.load(Memory::Relaxed);
+    if (!slots || ((m_count + 1) * 4 > slots->count * 3))
+        slots = grow();
+
+    std::size_t mask = slots->count - 1;
+    std::size_t i = hash(key) & mask;
+    while (slots->glyphs[i].load(Memory::Relaxed))
+        i = (i + 1) & mask;
+
+    slots->keys[i] = key;
+    slots->glyphs[i].store(stored, Memory::Release);
+    ++m_count;
+
+    return *stored;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::Slots* Font::GlyphTable::grow()
+{
+    Slots* previous = m_slots.load(Memory::Relaxed);
+    Slots* slots = new Slots(previous ? previous->count * 2 : 64);
+    std::size_t mask = slots->count - 1;
+
+    if (previous)
+    {
+        for (std::size_t j = 0; j < previous->count; ++j)
+        {
+            const Glyph* glyph = previous->glyphs[j].load(Memory::Relaxed);
+            if (!glyph)
+                continue;
+
+            std::size_t i = hash(previous->keys[j]) & mask;
+            while (slots->glyphs[i].load(Memory::Relaxed))
+                i = (i + 1) & mask;
+
+            slots->keys[i] = previous->keys[j];
+            slots->glyphs[i].store(glyph, Memory::Relaxed);
+        }
+
+        // Readers may still be probing the previous slots
+        m_retired.push_back(previous);
+    }
 
-    // Reserve a 2x2 white square for texturing underlines
-    for (int x = 0; x < 2; ++x)
-        for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
+    m_slots.store(slots, Memory::Release);
 
-    // Create the texture
-    texture.loadFromImage(image);
-    texture.setSmooth(true);
+    return slots;
 }
 
 } // namespace sf
@@ -26,10 +26,89 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <set>
 #include <string>
 
 
+namespace
+{
+    // Contexts whose errors are reported by the debug message callback
+    sf::Mutex debugContextsMutex;
+    std::set<sf::Uint64> debugContexts;
+    volatile bool anyDebugContext = false;
+
+    // The callback can be invoked from a driver thread, keep the messages in one piece
+    sf::Mutex debugOutputMutex;
+
+#ifndef SFML_OPENGL_ES
+
+    const char* getDebugSourceName(GLenum source)
+    {
+        switch (source)
+        {
+            case GL_DEBUG_SOURCE_API:             return "API";
+            case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return "window system";
+            case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+            case GL_DEBUG_SOURCE_THIRD_PARTY:     return "third party";
+            case GL_DEBUG_SOURCE_APPLICATION:     return "application";
+            default:                              return "other";
+        }
+    }
+
+    const char* getDebugTypeName(GLenum type)
+    {
+        switch (type)
+        {
+            case GL_DEBUG_TYPE_ERROR:               return "error";
+            case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+            case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return "undefined behavior";
+            case GL_DEBUG_TYPE_PORTABILITY:         return "portability";
+            case GL_DEBUG_TYPE_PERFORMANCE:         return "performance";
+            default:                                return "other";
+        }
+    }
+
+    const char* getDebugSeverityName(GLenum severity)
+    {
+        switch (severity)
+        {
+            case GL_DEBUG_SEVERITY_HIGH:   return "high";
+            case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+            case GL_DEBUG_SEVERITY_LOW:    return "low";
+            default:                       return "notification";
+        }
+    }
+
+    void APIENTRY debugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei, const GLchar* message, const void*)
+    {
+        sf::Lock lock(debugOutputMutex);
+
+        sf::err() << "OpenGL " << getDebugTypeName(type) << " reported by the " << getDebugSourceName(source)
+                  << " (id " << id << ", severity " << getDebugSeverityName(severity) << "):"
+                  << "\n   " << message << "\n"
+                  << std::endl;
+    }
+
+#endif
+
+    // Check whether the errors of the active context are already reported by the callback
+    bool hasDebugOutput()
+    {
+        if (!anyDebugContext)
+            return false;
+
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+
+        sf::Lock lock(debugContextsMutex);
+        return debugContexts.find(contextId) != debugContexts.end();
+    }
+}
+
+
 namespace sf
 {
 namespace priv
@@ -37,6 +116,10 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void glCheckError(const char* file, unsigned int line, const char* expression)
 {
+    // Errors are reported asynchronously by the debug callback, don't stall the pipeline
+    if (hasDebugOutput())
+        return;
+
     // Get the last error
     GLenum errorCode = glGetError();
 
@@ -109,6 +192,54 @@ void glCheckError(const char* file, unsigned int line, const char* expression)
 }
 
 
+////////////////////////////////////////////////////////////
+void glEnableDebugOutput()
+{
+#ifndef SFML_OPENGL_ES
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (!contextId || !GLEXT_debug_output)
+        return;
+
+    {
+        Lock lock(debugContextsMutex);
+
+        if (debugContexts.find(contextId) != debugContexts.end())
+            return;
+    }
+
+    // Only contexts created with the debug attribute are expected to generate messages
+    GLint flags = 0;
+    glGetIntegerv(GLEXT_GL_CONTEXT_FLAGS, &flags);
+
+    if (glGetError() != GL_NO_ERROR || !(flags & GLEXT_GL_CONTEXT_FLAG_DEBUG_BIT))
+        return;
+
+    // Report high and medium severity messages, the shader compiler
+    // output is already part of the compilation errors of sf::Shader
+    GLEXT_glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+    GLEXT_glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GLEXT_GL_DEBUG_SEVERITY_HIGH, 0, NULL, GL_TRUE);
+    GLEXT_glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GLEXT_GL_DEBUG_SEVERITY_MEDIUM, 0, NULL, GL_TRUE);
+    GLEXT_glDebugMessageControl(GL_DEBUG_SOURCE_SHADER_COMPILER, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+
+    // Asynchronous output doesn't serialize the driver, the messages
+    // lose their call site but cost nothing when there are none
+    glDisable(GLEXT_GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glEnable(GLEXT_GL_DEBUG_OUTPUT);
+    GLEXT_glDebugMessageCallback(debugMessageCallback, NULL);
+
+    if (glGetError() != GL_NO_ERROR)
+        return;
+
+    Lock lock(debugContextsMutex);
+    debugContexts.insert(contextId);
+    anyDebugContext = true;
+
+#endif
+}
+
+
 } // namespace priv
 
 } // namespace sf
@@ -62,6 +62,17 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void glCheckError(const char* file, unsigned int line, const char* expression);
 
+////////////////////////////////////////////////////////////
+/// \brief Report OpenGL errors of the active context through KHR_debug
+///
+/// If the active context was created with the debug attribute
+/// and supports KHR_debug, a message callback is installed which
+/// reports errors asynchronously, in release builds as well.
+/// glCheckError then stops polling glGetError for this context.
+///
+////////////////////////////////////////////////////////////
+void glEnableDebugOutput();
+
 } // namespace priv
 
 } // namespace sf
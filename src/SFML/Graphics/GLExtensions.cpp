@@ -84,6 +84,10 @@ void ensureExtensionsInit()
             err() << "sfml-graphics requires support for OpenGL 1.1 or greater" << std::endl;
             err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
         }
+
+        // Texture base and max levels are core since 1.2 even if SGIS_texture_lod is not advertised
+        if ((majorVersion > 1) || ((majorVersion == 1) && (minorVersion >= 2)))
+            sfogl_ext_SGIS_texture_lod = sfogl_LOAD_SUCCEEDED;
     }
 #endif
 }
@@ -57,6 +57,7 @@
     // 1.1 does not support GL_STREAM_DRAW so we just define it to GL_DYNAMIC_DRAW
     #define GLEXT_vertex_buffer_object                true
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
     #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
@@ -102,6 +103,30 @@
     // Core since 2.0 - OES_texture_npot
     #define GLEXT_texture_non_power_of_two            false
 
+    // Core since 2.0 - compressed textures
+    #define GLEXT_texture_compression                 true
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
+
+    // Not core - EXT_texture_compression_s3tc
+    #ifdef GL_EXT_texture_compression_s3tc
+        #define GLEXT_texture_compression_s3tc            GL_EXT_texture_compression_s3tc
+    #else
+        #define GLEXT_texture_compression_s3tc            false
+    #endif
+
+    // Not core - EXT_texture_compression_bptc
+    #define GLEXT_texture_compression_bptc            false
+
+    // Core since 3.0 - ETC2/EAC
+    #define GLEXT_texture_compression_etc2            false
+
+    // Not core - KHR_texture_compression_astc_ldr
+    #ifdef GL_KHR_texture_compression_astc_ldr
+        #define GLEXT_texture_compression_astc            GL_KHR_texture_compression_astc_ldr
+    #else
+        #define GLEXT_texture_compression_astc            false
+    #endif
+
     // Core since 2.0 - OES_framebuffer_object
     #define GLEXT_framebuffer_object                  GL_OES_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferOES
@@ -133,9 +158,82 @@
     // Core since 3.0
     #define GLEXT_framebuffer_multisample             false
 
+    // Core since 3.0 - EXT_discard_framebuffer
+    #define GLEXT_invalidate_framebuffer              false
+
+    // Core since 3.2 - EXT_copy_image
+    #define GLEXT_copy_image                          false
+
+    // Core since 3.2 - KHR_debug
+    #define GLEXT_debug_output                        false
+
+    // Core since 3.0 - EXT_texture_storage
+    #define GLEXT_texture_storage                     false
+
+    // Core since 3.0 - multiple render targets and floating point color buffers
+    #define GLEXT_draw_buffers                        false
+    #define GLEXT_texture_float                       false
+    #define GLEXT_packed_float                        false
+
+    // Core since 3.0 - NV_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+
+    // Core since 3.0 - texture arrays
+    #define GLEXT_texture_array                       false
+
+    // Not core - NV_bindless_texture
+    #define GLEXT_bindless_texture                    false
+
+    // Core since 3.0 - OES_vertex_half_float
+    #define GLEXT_half_float_vertex                   false
+    #define GLEXT_GL_HALF_FLOAT                       0
+
+    // Core since 3.0 - texture base and max level
+    #define GLEXT_texture_lod                         false
+    #define GLEXT_GL_TEXTURE_BASE_LEVEL               0
+    #define GLEXT_GL_TEXTURE_MAX_LEVEL                0
+
+    // Core since 3.0 - OES_vertex_array_object
+    #define GLEXT_vertex_array_object                 false
+
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+
+    // Core since 3.0 - APPLE_sync
+    #define GLEXT_sync                                false
+
+    // Core since 3.0 - EXT_draw_instanced
+    #define GLEXT_draw_instanced                      false
+
+    // Core since 3.0 - EXT_instanced_arrays
+    #define GLEXT_instanced_arrays                    false
+
+    // Core since 3.2 - EXT_buffer_storage
+    #define GLEXT_buffer_storage                      false
+
+    // Core since 3.0 - EXT_occlusion_query_boolean
+    #define GLEXT_occlusion_query                     false
+
+    // Not core - EXT_disjoint_timer_query
+    #define GLEXT_timer_query                         false
+
     // Core since 3.0 - NV_copy_buffer
     #define GLEXT_copy_buffer                         false
 
+    // Core since 3.0 - uniform buffer objects
+    #define GLEXT_uniform_buffer_object               false
+
+    // Core since 3.0 - OES_get_program_binary
+    #define GLEXT_get_program_binary                  false
+
+    // Core since 3.1 - compute shaders, storage buffers and image load/store
+    #define GLEXT_compute_shader                      false
+    #define GLEXT_shader_storage_buffer_object        false
+    #define GLEXT_shader_image_load_store             false
+
+    // Not core - KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             false
+
     // Core since 3.0 - EXT_sRGB
     #ifdef GL_EXT_sRGB
         #define GLEXT_texture_sRGB                        GL_EXT_sRGB
@@ -164,53 +262,68 @@
     // The following extensions are optional.
 
     // Core since 1.2 - SGIS_texture_edge_clamp
-    #define GLEXT_texture_edge_clamp                  sfogl_ext_SGIS_texture_edge_clamp
+    #define GLEXT_texture_edge_clamp                  sfogl_IsExtensionLoaded(sfogl_ext_SGIS_texture_edge_clamp)
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE_SGIS
 
     // Core since 1.2 - EXT_texture_edge_clamp
-    #define GLEXT_EXT_texture_edge_clamp              sfogl_ext_EXT_texture_edge_clamp
+    #define GLEXT_EXT_texture_edge_clamp              sfogl_IsExtensionLoaded(sfogl_ext_EXT_texture_edge_clamp)
 
     // Core since 1.2 - EXT_blend_minmax
-    #define GLEXT_blend_minmax                        sfogl_ext_EXT_blend_minmax
+    #define GLEXT_blend_minmax                        sfogl_IsExtensionLoaded(sfogl_ext_EXT_blend_minmax)
     #define GLEXT_glBlendEquation                     glBlendEquationEXT
     #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD_EXT
 
     // Core since 1.2 - EXT_blend_subtract
-    #define GLEXT_blend_subtract                      sfogl_ext_EXT_blend_subtract
+    #define GLEXT_blend_subtract                      sfogl_IsExtensionLoaded(sfogl_ext_EXT_blend_subtract)
     #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT_EXT
     #define GLEXT_GL_FUNC_REVERSE_SUBTRACT            GL_FUNC_REVERSE_SUBTRACT_EXT
 
     // Core since 1.3 - ARB_multitexture
-    #define GLEXT_multitexture                        sfogl_ext_ARB_multitexture
+    #define GLEXT_multitexture                        sfogl_IsExtensionLoaded(sfogl_ext_ARB_multitexture)
     #define GLEXT_glClientActiveTexture               glClientActiveTextureARB
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
 
+    // Core since 1.3 - ARB_texture_compression
+    #define GLEXT_texture_compression                 sfogl_IsExtensionLoaded(sfogl_ext_ARB_texture_compression)
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2DARB
+
     // Core since 1.4 - EXT_blend_func_separate
-    #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
+    #define GLEXT_blend_func_separate                 sfogl_IsExtensionLoaded(sfogl_ext_EXT_blend_func_separate)
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
 
     // Core since 1.5 - ARB_vertex_buffer_object
-    #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
+    #define GLEXT_vertex_buffer_object                sfogl_IsExtensionLoaded(sfogl_ext_ARB_vertex_buffer_object)
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
     #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
     #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
     #define GLEXT_glBindBuffer                        glBindBufferARB
     #define GLEXT_glBufferData                        glBufferDataARB
     #define GLEXT_glBufferSubData                     glBufferSubDataARB
+    #define GLEXT_glGetBufferSubData                  glGetBufferSubDataARB
     #define GLEXT_glDeleteBuffers                     glDeleteBuffersARB
     #define GLEXT_glGenBuffers                        glGenBuffersARB
     #define GLEXT_glMapBuffer                         glMapBufferARB
     #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
 
+    // Core since 1.5 - ARB_occlusion_query
+    #define GLEXT_occlusion_query                     sfogl_IsExtensionLoaded(sfogl_ext_ARB_occlusion_query)
+    #define GLEXT_glDeleteQueries                     glDeleteQueriesARB
+    #define GLEXT_glGenQueries                        glGenQueriesARB
+    #define GLEXT_glGetQueryObjectuiv                 glGetQueryObjectuivARB
+    #define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE_ARB
+
     // Core since 2.0 - ARB_shading_language_100
-    #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
+    #define GLEXT_shading_language_100                sfogl_IsExtensionLoaded(sfogl_ext_ARB_shading_language_100)
 
     // Core since 2.0 - ARB_shader_objects
-    #define GLEXT_shader_objects                      sfogl_ext_ARB_shader_objects
+    #define GLEXT_shader_objects                      sfogl_IsExtensionLoaded(sfogl_ext_ARB_shader_objects)
     #define GLEXT_glDeleteObject                      glDeleteObjectARB
     #define GLEXT_glGetHandle                         glGetHandleARB
     #define GLEXT_glCreateShaderObject                glCreateShaderObjectARB
@@ -230,7 +343,10 @@
     #define GLEXT_glUniform4i                         glUniform4iARB
     #define GLEXT_glUniform1fv                        glUniform1fvARB
     #define GLEXT_glUniform2fv                        glUniform2fvARB
+    #define GLEXT_glUniform1iv                        glUniform1ivARB
     #define GLEXT_glUniform2iv                        glUniform2ivARB
+    #define GLEXT_glUniform3iv                        glUniform3ivARB
+    #define GLEXT_glUniform4iv                        glUniform4ivARB
     #define GLEXT_glUniform3fv                        glUniform3fvARB
     #define GLEXT_glUniform4fv                        glUniform4fvARB
     #define GLEXT_glUniformMatrix3fv                  glUniformMatrix3fvARB
@@ -244,27 +360,43 @@
     #define GLEXT_GLhandle                            GLhandleARB
 
     // Core since 2.0 - ARB_vertex_shader
-    #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
+    #define GLEXT_vertex_shader                       sfogl_IsExtensionLoaded(sfogl_ext_ARB_vertex_shader)
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glVertexAttrib4f                    glVertexAttrib4fARB
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
     // Core since 2.0 - ARB_fragment_shader
-    #define GLEXT_fragment_shader                     sfogl_ext_ARB_fragment_shader
+    #define GLEXT_fragment_shader                     sfogl_IsExtensionLoaded(sfogl_ext_ARB_fragment_shader)
     #define GLEXT_GL_FRAGMENT_SHADER                  GL_FRAGMENT_SHADER_ARB
 
     // Core since 2.0 - ARB_texture_non_power_of_two
-    #define GLEXT_texture_non_power_of_two            sfogl_ext_ARB_texture_non_power_of_two
+    #define GLEXT_texture_non_power_of_two            sfogl_IsExtensionLoaded(sfogl_ext_ARB_texture_non_power_of_two)
 
     // Core since 2.0 - EXT_blend_equation_separate
-    #define GLEXT_blend_equation_separate             sfogl_ext_EXT_blend_equation_separate
+    #define GLEXT_blend_equation_separate             sfogl_IsExtensionLoaded(sfogl_ext_EXT_blend_equation_separate)
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateEXT
 
+    // Core since 2.0 - ARB_draw_buffers
+    #define GLEXT_draw_buffers                        sfogl_IsExtensionLoaded(sfogl_ext_ARB_draw_buffers)
+    #define GLEXT_glDrawBuffers                       glDrawBuffersARB
+    #define GLEXT_GL_MAX_DRAW_BUFFERS                 GL_MAX_DRAW_BUFFERS_ARB
+
     // Core since 2.1 - EXT_texture_sRGB
-    #define GLEXT_texture_sRGB                        sfogl_ext_EXT_texture_sRGB
+    #define GLEXT_texture_sRGB                        sfogl_IsExtensionLoaded(sfogl_ext_EXT_texture_sRGB)
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
 
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 sfogl_IsExtensionLoaded(sfogl_ext_ARB_pixel_buffer_object)
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER_BINDING      GL_PIXEL_UNPACK_BUFFER_BINDING_ARB
+
     // Core since 3.0 - EXT_framebuffer_object
-    #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
+    #define GLEXT_framebuffer_object                  sfogl_IsExtensionLoaded(sfogl_ext_EXT_framebuffer_object)
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
     #define GLEXT_glDeleteRenderbuffers               glDeleteRenderbuffersEXT
     #define GLEXT_glGenRenderbuffers                  glGenRenderbuffersEXT
@@ -284,13 +416,14 @@
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
     #define GLEXT_GL_STENCIL_ATTACHMENT               GL_STENCIL_ATTACHMENT_EXT
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS            GL_MAX_COLOR_ATTACHMENTS_EXT
 
     // Core since 3.0 - EXT_packed_depth_stencil
-    #define GLEXT_packed_depth_stencil                sfogl_ext_EXT_packed_depth_stencil
+    #define GLEXT_packed_depth_stencil                sfogl_IsExtensionLoaded(sfogl_ext_EXT_packed_depth_stencil)
     #define GLEXT_GL_DEPTH24_STENCIL8                 GL_DEPTH24_STENCIL8_EXT
 
     // Core since 3.0 - EXT_framebuffer_blit
-    #define GLEXT_framebuffer_blit                    sfogl_ext_EXT_framebuffer_blit
+    #define GLEXT_framebuffer_blit                    sfogl_IsExtensionLoaded(sfogl_ext_EXT_framebuffer_blit)
     #define GLEXT_glBlitFramebuffer                   glBlitFramebufferEXT
     #define GLEXT_GL_READ_FRAMEBUFFER                 GL_READ_FRAMEBUFFER_EXT
     #define GLEXT_GL_DRAW_FRAMEBUFFER                 GL_DRAW_FRAMEBUFFER_EXT
@@ -298,20 +431,184 @@
     #define GLEXT_GL_READ_FRAMEBUFFER_BINDING         GL_READ_FRAMEBUFFER_BINDING_EXT
 
     // Core since 3.0 - EXT_framebuffer_multisample
-    #define GLEXT_framebuffer_multisample             sfogl_ext_EXT_framebuffer_multisample
+    #define GLEXT_framebuffer_multisample             sfogl_IsExtensionLoaded(sfogl_ext_EXT_framebuffer_multisample)
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - ARB_texture_float
+    #define GLEXT_texture_float                       sfogl_IsExtensionLoaded(sfogl_ext_ARB_texture_float)
+    #define GLEXT_GL_RGBA16F                          GL_RGBA16F_ARB
+    #define GLEXT_GL_RGBA32F                          GL_RGBA32F_ARB
+
+    // Core since 3.0 - EXT_packed_float
+    #define GLEXT_packed_float                        sfogl_IsExtensionLoaded(sfogl_ext_EXT_packed_float)
+    #define GLEXT_GL_R11F_G11F_B10F                   GL_R11F_G11F_B10F_EXT
+
+    // Core since 3.0 - EXT_texture_array (uploaded with EXT_texture3D, core since 1.2)
+    #define GLEXT_texture_array                       (sfogl_IsExtensionLoaded(sfogl_ext_EXT_texture_array) && sfogl_IsExtensionLoaded(sfogl_ext_EXT_texture3D))
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 GL_TEXTURE_2D_ARRAY_EXT
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         GL_TEXTURE_BINDING_2D_ARRAY_EXT
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         GL_MAX_ARRAY_TEXTURE_LAYERS_EXT
+    #define GLEXT_glTexImage3D                        glTexImage3DEXT
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3DEXT
+
+    // Core since 3.0 - ARB_half_float_vertex
+    #define GLEXT_half_float_vertex                   sfogl_IsExtensionLoaded(sfogl_ext_ARB_half_float_vertex)
+    #define GLEXT_GL_HALF_FLOAT                       GL_HALF_FLOAT_ARB
+
+    // Core since 1.2 - SGIS_texture_lod
+    #define GLEXT_texture_lod                         sfogl_IsExtensionLoaded(sfogl_ext_SGIS_texture_lod)
+    #define GLEXT_GL_TEXTURE_BASE_LEVEL               GL_TEXTURE_BASE_LEVEL_SGIS
+    #define GLEXT_GL_TEXTURE_MAX_LEVEL                GL_TEXTURE_MAX_LEVEL_SGIS
+
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 sfogl_IsExtensionLoaded(sfogl_ext_ARB_vertex_array_object)
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    sfogl_IsExtensionLoaded(sfogl_ext_ARB_map_buffer_range)
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+
     // Core since 3.1 - ARB_copy_buffer
-    #define GLEXT_copy_buffer                         sfogl_ext_ARB_copy_buffer
+    #define GLEXT_copy_buffer                         sfogl_IsExtensionLoaded(sfogl_ext_ARB_copy_buffer)
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
     #define GLEXT_GL_COPY_WRITE_BUFFER                GL_COPY_WRITE_BUFFER
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData
 
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               sfogl_IsExtensionLoaded(sfogl_ext_ARB_uniform_buffer_object)
+    #define GLEXT_GL_UNIFORM_BUFFER                   GL_UNIFORM_BUFFER
+    #define GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS      GL_MAX_UNIFORM_BUFFER_BINDINGS
+    #define GLEXT_GL_UNIFORM_BLOCK_DATA_SIZE          GL_UNIFORM_BLOCK_DATA_SIZE
+    #define GLEXT_GL_INVALID_INDEX                    GL_INVALID_INDEX
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex
+    #define GLEXT_glGetActiveUniformBlockiv           glGetActiveUniformBlockiv
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding
+    #define GLEXT_glBindBufferBase                    glBindBufferBase
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_IsExtensionLoaded(sfogl_ext_ARB_draw_instanced)
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+
     // Core since 3.2 - ARB_geometry_shader4
-    #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
+    #define GLEXT_geometry_shader4                    sfogl_IsExtensionLoaded(sfogl_ext_ARB_geometry_shader4)
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_IsExtensionLoaded(sfogl_ext_ARB_sync)
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_WAIT_FAILED                      GL_WAIT_FAILED
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+    #define GLEXT_glFenceSync                         glFenceSync
+
+    // Core since 3.3 - ARB_instanced_arrays
+    #define GLEXT_instanced_arrays                    sfogl_IsExtensionLoaded(sfogl_ext_ARB_instanced_arrays)
+    #define GLEXT_glVertexAttribDivisor               glVertexAttribDivisorARB
+
+    // Core since 3.3 - ARB_timer_query
+    #define GLEXT_timer_query                         sfogl_IsExtensionLoaded(sfogl_ext_ARB_timer_query)
+    #define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+    #define GLEXT_glQueryCounter                      glQueryCounter
+    #define GLEXT_GL_TIMESTAMP                        GL_TIMESTAMP
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  sfogl_IsExtensionLoaded(sfogl_ext_ARB_get_program_binary)
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+
+    // Core since 4.2 - ARB_shader_image_load_store
+    #define GLEXT_shader_image_load_store             sfogl_IsExtensionLoaded(sfogl_ext_ARB_shader_image_load_store)
+    #define GLEXT_GL_MAX_IMAGE_UNITS                  GL_MAX_IMAGE_UNITS
+    #define GLEXT_GL_ALL_BARRIER_BITS                 GL_ALL_BARRIER_BITS
+    #define GLEXT_GL_READ_WRITE                       GL_READ_WRITE_ARB
+    #define GLEXT_GL_RGBA8                            GL_RGBA8
+    #define GLEXT_glBindImageTexture                  glBindImageTexture
+    #define GLEXT_glMemoryBarrier                     glMemoryBarrier
+
+    // Core since 4.2 - ARB_texture_storage
+    #define GLEXT_texture_storage                     sfogl_IsExtensionLoaded(sfogl_ext_ARB_texture_storage)
+    #define GLEXT_glTexStorage2D                      glTexStorage2D
+
+    // Core since 4.2 - ARB_texture_compression_bptc
+    #define GLEXT_texture_compression_bptc            sfogl_IsExtensionLoaded(sfogl_ext_ARB_texture_compression_bptc)
+
+    // Core since 4.3 - ARB_ES3_compatibility
+    #define GLEXT_texture_compression_etc2            sfogl_IsExtensionLoaded(sfogl_ext_ARB_ES3_compatibility)
+
+    // Core since 4.3 - ARB_compute_shader
+    #define GLEXT_compute_shader                      sfogl_IsExtensionLoaded(sfogl_ext_ARB_compute_shader)
+    #define GLEXT_GL_COMPUTE_SHADER                   GL_COMPUTE_SHADER
+    #define GLEXT_glDispatchCompute                   glDispatchCompute
+
+    // Core since 4.3 - ARB_program_interface_query
+    #define GLEXT_program_interface_query             sfogl_IsExtensionLoaded(sfogl_ext_ARB_program_interface_query)
+    #define GLEXT_GL_SHADER_STORAGE_BLOCK             GL_SHADER_STORAGE_BLOCK
+    #define GLEXT_glGetProgramResourceIndex           glGetProgramResourceIndex
+
+    // Core since 4.3 - ARB_shader_storage_buffer_object
+    #define GLEXT_shader_storage_buffer_object        sfogl_IsExtensionLoaded(sfogl_ext_ARB_shader_storage_buffer_object)
+    #define GLEXT_GL_SHADER_STORAGE_BUFFER            GL_SHADER_STORAGE_BUFFER
+    #define GLEXT_GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS
+    #define GLEXT_glShaderStorageBlockBinding         glShaderStorageBlockBinding
+
+    // Core since 4.3 - ARB_invalidate_subdata
+    #define GLEXT_invalidate_framebuffer              sfogl_IsExtensionLoaded(sfogl_ext_ARB_invalidate_subdata)
+    #define GLEXT_glInvalidateFramebuffer             glInvalidateFramebuffer
+
+    // Core since 4.3 - ARB_copy_image
+    #define GLEXT_copy_image                          sfogl_IsExtensionLoaded(sfogl_ext_ARB_copy_image)
+    #define GLEXT_glCopyImageSubData                  glCopyImageSubData
+
+    // Core since 4.3 - KHR_debug
+    #define GLEXT_debug_output                        sfogl_IsExtensionLoaded(sfogl_ext_KHR_debug)
+    #define GLEXT_glDebugMessageCallback              glDebugMessageCallback
+    #define GLEXT_glDebugMessageControl               glDebugMessageControl
+    #define GLEXT_GL_CONTEXT_FLAGS                    GL_CONTEXT_FLAGS
+    #define GLEXT_GL_CONTEXT_FLAG_DEBUG_BIT           GL_CONTEXT_FLAG_DEBUG_BIT
+    #define GLEXT_GL_DEBUG_OUTPUT                     GL_DEBUG_OUTPUT
+    #define GLEXT_GL_DEBUG_OUTPUT_SYNCHRONOUS         GL_DEBUG_OUTPUT_SYNCHRONOUS
+    #define GLEXT_GL_DEBUG_SEVERITY_HIGH              GL_DEBUG_SEVERITY_HIGH
+    #define GLEXT_GL_DEBUG_SEVERITY_MEDIUM            GL_DEBUG_SEVERITY_MEDIUM
+    #define GLEXT_GL_DEBUG_SEVERITY_LOW               GL_DEBUG_SEVERITY_LOW
+    #define GLEXT_GL_DEBUG_SEVERITY_NOTIFICATION      GL_DEBUG_SEVERITY_NOTIFICATION
+
+    // Core since 4.4 - ARB_buffer_storage
+    #define GLEXT_buffer_storage                      sfogl_IsExtensionLoaded(sfogl_ext_ARB_buffer_storage)
+    #define GLEXT_GL_MAP_COHERENT_BIT                 GL_MAP_COHERENT_BIT
+    #define GLEXT_GL_MAP_PERSISTENT_BIT               GL_MAP_PERSISTENT_BIT
+    #define GLEXT_glBufferStorage                     glBufferStorage
+
+    // Not core - EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            sfogl_IsExtensionLoaded(sfogl_ext_EXT_texture_compression_s3tc)
+
+    // Not core - KHR_texture_compression_astc_ldr
+    #define GLEXT_texture_compression_astc            sfogl_IsExtensionLoaded(sfogl_ext_KHR_texture_compression_astc_ldr)
+
+    // Not core - ARB_bindless_texture
+    #define GLEXT_bindless_texture                    sfogl_IsExtensionLoaded(sfogl_ext_ARB_bindless_texture)
+    #define GLEXT_glGetTextureHandle                  glGetTextureHandleARB
+    #define GLEXT_glMakeTextureHandleResident         glMakeTextureHandleResidentARB
+    #define GLEXT_glMakeTextureHandleNonResident      glMakeTextureHandleNonResidentARB
+    #define GLEXT_glUniformHandleui64                 glUniformHandleui64ARB
+
+    // Not core - KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             sfogl_IsExtensionLoaded(sfogl_ext_KHR_parallel_shader_compile)
+    #define GLEXT_GL_COMPLETION_STATUS                GL_COMPLETION_STATUS_KHR
+
 #endif
 
 namespace sf
@@ -27,6 +27,10 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLLoader.hpp>
 #include <SFML/Window/Context.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+
+static sf::Mutex g_extensionMutex;
 
 static sf::GlFunctionPointer glLoaderGetProcAddress(const char* name)
 {
@@ -53,6 +57,39 @@ int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_buffer_storage = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_instanced = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_compression = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_compression_bptc = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture3D = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_texture_array = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_bindless_texture = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_compute_shader = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_program_interface_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_shader_storage_buffer_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_shader_image_load_store = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_parallel_shader_compile = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_draw_buffers = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_float = sfogl_LOAD_FAILED;
+int sfogl_ext_EXT_packed_float = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_invalidate_subdata = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_half_float_vertex = sfogl_LOAD_FAILED;
+int sfogl_ext_SGIS_texture_lod = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_copy_image = sfogl_LOAD_FAILED;
+int sfogl_ext_KHR_debug = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_storage = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -935,6 +972,417 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glIsVertexArray = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsVertexArray"));
+    if (!sf_ptrc_glIsVertexArray)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr) = NULL;
+void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = NULL;
+
+static int Load_ARB_map_buffer_range()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glFlushMappedBufferRange = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr)>(glLoaderGetProcAddress("glFlushMappedBufferRange"));
+    if (!sf_ptrc_glFlushMappedBufferRange)
+        numFailed++;
+
+    sf_ptrc_glMapBufferRange = reinterpret_cast<void* (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, GLbitfield)>(glLoaderGetProcAddress("glMapBufferRange"));
+    if (!sf_ptrc_glMapBufferRange)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glClientWaitSync = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glClientWaitSync"));
+    if (!sf_ptrc_glClientWaitSync)
+        numFailed++;
+
+    sf_ptrc_glDeleteSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glDeleteSync"));
+    if (!sf_ptrc_glDeleteSync)
+        numFailed++;
+
+    sf_ptrc_glFenceSync = reinterpret_cast<GLsync (GL_FUNCPTR *)(GLenum, GLbitfield)>(glLoaderGetProcAddress("glFenceSync"));
+    if (!sf_ptrc_glFenceSync)
+        numFailed++;
+
+    sf_ptrc_glGetInteger64v = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint64*)>(glLoaderGetProcAddress("glGetInteger64v"));
+    if (!sf_ptrc_glGetInteger64v)
+        numFailed++;
+
+    sf_ptrc_glGetSynciv = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLenum, GLsizei, GLsizei*, GLint*)>(glLoaderGetProcAddress("glGetSynciv"));
+    if (!sf_ptrc_glGetSynciv)
+        numFailed++;
+
+    sf_ptrc_glIsSync = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glIsSync"));
+    if (!sf_ptrc_glIsSync)
+        numFailed++;
+
+    sf_ptrc_glWaitSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glWaitSync"));
+    if (!sf_ptrc_glWaitSync)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield) = NULL;
+
+static int Load_ARB_buffer_storage()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBufferStorage = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptr, const void*, GLbitfield)>(glLoaderGetProcAddress("glBufferStorage"));
+    if (!sf_ptrc_glBufferStorage)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei) = NULL;
+
+static int Load_ARB_draw_instanced()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawArraysInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLsizei, GLsizei)>(glLoaderGetProcAddress("glDrawArraysInstancedARB"));
+    if (!sf_ptrc_glDrawArraysInstancedARB)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsInstancedARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glDrawElementsInstancedARB"));
+    if (!sf_ptrc_glDrawElementsInstancedARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint) = NULL;
+
+static int Load_ARB_instanced_arrays()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glVertexAttribDivisorARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glVertexAttribDivisorARB"));
+    if (!sf_ptrc_glVertexAttribDivisorARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint*) = NULL;
+
+static int Load_ARB_occlusion_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGenQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenQueriesARB"));
+    if (!sf_ptrc_glGenQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteQueriesARB"));
+    if (!sf_ptrc_glDeleteQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectuivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint*)>(glLoaderGetProcAddress("glGetQueryObjectuivARB"));
+    if (!sf_ptrc_glGetQueryObjectuivARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*) = NULL;
+
+static int Load_ARB_timer_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glQueryCounter = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum)>(glLoaderGetProcAddress("glQueryCounter"));
+    if (!sf_ptrc_glQueryCounter)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectui64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint64*)>(glLoaderGetProcAddress("glGetQueryObjectui64v"));
+    if (!sf_ptrc_glGetQueryObjectui64v)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*) = NULL;
+
+static int Load_ARB_texture_compression()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glCompressedTexImage2DARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*)>(glLoaderGetProcAddress("glCompressedTexImage2DARB"));
+    if (!sf_ptrc_glCompressedTexImage2DARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glTexImage3DEXT)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glTexSubImage3DEXT)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*) = NULL;
+
+static int Load_EXT_texture3D()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glTexImage3DEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*)>(glLoaderGetProcAddress("glTexImage3DEXT"));
+    if (!sf_ptrc_glTexImage3DEXT)
+        numFailed++;
+
+    sf_ptrc_glTexSubImage3DEXT = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*)>(glLoaderGetProcAddress("glTexSubImage3DEXT"));
+    if (!sf_ptrc_glTexSubImage3DEXT)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLuint64 (GL_FUNCPTR *sf_ptrc_glGetTextureHandleARB)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glMakeTextureHandleResidentARB)(GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glMakeTextureHandleNonResidentARB)(GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformHandleui64ARB)(GLint, GLuint64) = NULL;
+
+static int Load_ARB_bindless_texture()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetTextureHandleARB = reinterpret_cast<GLuint64 (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glGetTextureHandleARB"));
+    if (!sf_ptrc_glGetTextureHandleARB)
+        numFailed++;
+
+    sf_ptrc_glMakeTextureHandleResidentARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint64)>(glLoaderGetProcAddress("glMakeTextureHandleResidentARB"));
+    if (!sf_ptrc_glMakeTextureHandleResidentARB)
+        numFailed++;
+
+    sf_ptrc_glMakeTextureHandleNonResidentARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint64)>(glLoaderGetProcAddress("glMakeTextureHandleNonResidentARB"));
+    if (!sf_ptrc_glMakeTextureHandleNonResidentARB)
+        numFailed++;
+
+    sf_ptrc_glUniformHandleui64ARB = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLuint64)>(glLoaderGetProcAddress("glUniformHandleui64ARB"));
+    if (!sf_ptrc_glUniformHandleui64ARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLuint (GL_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetActiveUniformBlockiv)(GLuint, GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint) = NULL;
+
+static int Load_ARB_uniform_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetUniformBlockIndex = reinterpret_cast<GLuint (GL_FUNCPTR *)(GLuint, const GLchar*)>(glLoaderGetProcAddress("glGetUniformBlockIndex"));
+    if (!sf_ptrc_glGetUniformBlockIndex)
+        numFailed++;
+
+    sf_ptrc_glGetActiveUniformBlockiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetActiveUniformBlockiv"));
+    if (!sf_ptrc_glGetActiveUniformBlockiv)
+        numFailed++;
+
+    sf_ptrc_glUniformBlockBinding = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLuint)>(glLoaderGetProcAddress("glUniformBlockBinding"));
+    if (!sf_ptrc_glUniformBlockBinding)
+        numFailed++;
+
+    sf_ptrc_glBindBufferBase = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint, GLuint)>(glLoaderGetProcAddress("glBindBufferBase"));
+    if (!sf_ptrc_glBindBufferBase)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint) = NULL;
+
+static int Load_ARB_get_program_binary()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLenum*, void*)>(glLoaderGetProcAddress("glGetProgramBinary"));
+    if (!sf_ptrc_glGetProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glProgramBinary"));
+    if (!sf_ptrc_glProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramParameteri = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint)>(glLoaderGetProcAddress("glProgramParameteri"));
+    if (!sf_ptrc_glProgramParameteri)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDispatchCompute)(GLuint, GLuint, GLuint) = NULL;
+
+static int Load_ARB_compute_shader()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDispatchCompute = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLuint)>(glLoaderGetProcAddress("glDispatchCompute"));
+    if (!sf_ptrc_glDispatchCompute)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLuint (GL_FUNCPTR *sf_ptrc_glGetProgramResourceIndex)(GLuint, GLenum, const GLchar*) = NULL;
+
+static int Load_ARB_program_interface_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetProgramResourceIndex = reinterpret_cast<GLuint (GL_FUNCPTR *)(GLuint, GLenum, const GLchar*)>(glLoaderGetProcAddress("glGetProgramResourceIndex"));
+    if (!sf_ptrc_glGetProgramResourceIndex)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glShaderStorageBlockBinding)(GLuint, GLuint, GLuint) = NULL;
+
+static int Load_ARB_shader_storage_buffer_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glShaderStorageBlockBinding = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLuint)>(glLoaderGetProcAddress("glShaderStorageBlockBinding"));
+    if (!sf_ptrc_glShaderStorageBlockBinding)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindImageTexture)(GLuint, GLuint, GLint, GLboolean, GLint, GLenum, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glMemoryBarrier)(GLbitfield) = NULL;
+
+static int Load_ARB_shader_image_load_store()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindImageTexture = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, GLint, GLboolean, GLint, GLenum, GLenum)>(glLoaderGetProcAddress("glBindImageTexture"));
+    if (!sf_ptrc_glBindImageTexture)
+        numFailed++;
+
+    sf_ptrc_glMemoryBarrier = reinterpret_cast<void (GL_FUNCPTR *)(GLbitfield)>(glLoaderGetProcAddress("glMemoryBarrier"));
+    if (!sf_ptrc_glMemoryBarrier)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDrawBuffersARB)(GLsizei, const GLenum*) = NULL;
+
+static int Load_ARB_draw_buffers()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDrawBuffersARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLenum*)>(glLoaderGetProcAddress("glDrawBuffersARB"));
+    if (!sf_ptrc_glDrawBuffersARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glInvalidateFramebuffer)(GLenum, GLsizei, const GLenum*) = NULL;
+
+static int Load_ARB_invalidate_subdata()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glInvalidateFramebuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, const GLenum*)>(glLoaderGetProcAddress("glInvalidateFramebuffer"));
+    if (!sf_ptrc_glInvalidateFramebuffer)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glCopyImageSubData)(GLuint, GLenum, GLint, GLint, GLint, GLint, GLuint, GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei) = NULL;
+
+static int Load_ARB_copy_image()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glCopyImageSubData = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint, GLint, GLint, GLint, GLuint, GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei)>(glLoaderGetProcAddress("glCopyImageSubData"));
+    if (!sf_ptrc_glCopyImageSubData)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glDebugMessageCallback)(GLDEBUGPROC, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDebugMessageControl)(GLenum, GLenum, GLenum, GLsizei, const GLuint*, GLboolean) = NULL;
+
+static int Load_KHR_debug()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glDebugMessageCallback = reinterpret_cast<void (GL_FUNCPTR *)(GLDEBUGPROC, const void*)>(glLoaderGetProcAddress("glDebugMessageCallback"));
+    if (!sf_ptrc_glDebugMessageCallback)
+        numFailed++;
+
+    sf_ptrc_glDebugMessageControl = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLenum, GLsizei, const GLuint*, GLboolean)>(glLoaderGetProcAddress("glDebugMessageControl"));
+    if (!sf_ptrc_glDebugMessageControl)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glTexStorage2D)(GLenum, GLsizei, GLenum, GLsizei, GLsizei) = NULL;
+
+static int Load_ARB_texture_storage()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glTexStorage2D = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, GLsizei, GLsizei)>(glLoaderGetProcAddress("glTexStorage2D"));
+    if (!sf_ptrc_glTexStorage2D)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -943,7 +1391,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[20] = {
+static sfogl_StrToExtMap ExtensionMap[53] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -963,34 +1411,100 @@ static sfogl_StrToExtMap ExtensionMap[20] = {
     {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
     {"GL_EXT_framebuffer_multisample", &sfogl_ext_EXT_framebuffer_multisample, Load_EXT_framebuffer_multisample},
     {"GL_ARB_copy_buffer", &sfogl_ext_ARB_copy_buffer, Load_ARB_copy_buffer},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object},
+    {"GL_ARB_map_buffer_range", &sfogl_ext_ARB_map_buffer_range, Load_ARB_map_buffer_range},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync},
+    {"GL_ARB_buffer_storage", &sfogl_ext_ARB_buffer_storage, Load_ARB_buffer_storage},
+    {"GL_ARB_draw_instanced", &sfogl_ext_ARB_draw_instanced, Load_ARB_draw_instanced},
+    {"GL_ARB_instanced_arrays", &sfogl_ext_ARB_instanced_arrays, Load_ARB_instanced_arrays},
+    {"GL_ARB_occlusion_query", &sfogl_ext_ARB_occlusion_query, Load_ARB_occlusion_query},
+    {"GL_ARB_timer_query", &sfogl_ext_ARB_timer_query, Load_ARB_timer_query},
+    {"GL_ARB_pixel_buffer_object", &sfogl_ext_ARB_pixel_buffer_object, NULL},
+    {"GL_ARB_texture_compression", &sfogl_ext_ARB_texture_compression, Load_ARB_texture_compression},
+    {"GL_EXT_texture_compression_s3tc", &sfogl_ext_EXT_texture_compression_s3tc, NULL},
+    {"GL_ARB_texture_compression_bptc", &sfogl_ext_ARB_texture_compression_bptc, NULL},
+    {"GL_ARB_ES3_compatibility", &sfogl_ext_ARB_ES3_compatibility, NULL},
+    {"GL_KHR_texture_compression_astc_ldr", &sfogl_ext_KHR_texture_compression_astc_ldr, NULL},
+    {"GL_EXT_texture3D", &sfogl_ext_EXT_texture3D, Load_EXT_texture3D},
+    {"GL_EXT_texture_array", &sfogl_ext_EXT_texture_array, NULL},
+    {"GL_ARB_bindless_texture", &sfogl_ext_ARB_bindless_texture, Load_ARB_bindless_texture},
+    {"GL_ARB_uniform_buffer_object", &sfogl_ext_ARB_uniform_buffer_object, Load_ARB_uniform_buffer_object},
+    {"GL_ARB_get_program_binary", &sfogl_ext_ARB_get_program_binary, Load_ARB_get_program_binary},
+    {"GL_ARB_compute_shader", &sfogl_ext_ARB_compute_shader, Load_ARB_compute_shader},
+    {"GL_ARB_program_interface_query", &sfogl_ext_ARB_program_interface_query, Load_ARB_program_interface_query},
+    {"GL_ARB_shader_storage_buffer_object", &sfogl_ext_ARB_shader_storage_buffer_object, Load_ARB_shader_storage_buffer_object},
+    {"GL_ARB_shader_image_load_store", &sfogl_ext_ARB_shader_image_load_store, Load_ARB_shader_image_load_store},
+    {"GL_KHR_parallel_shader_compile", &sfogl_ext_KHR_parallel_shader_compile, NULL},
+    {"GL_ARB_draw_buffers", &sfogl_ext_ARB_draw_buffers, Load_ARB_draw_buffers},
+    {"GL_ARB_texture_float", &sfogl_ext_ARB_texture_float, NULL},
+    {"GL_EXT_packed_float", &sfogl_ext_EXT_packed_float, NULL},
+    {"GL_ARB_invalidate_subdata", &sfogl_ext_ARB_invalidate_subdata, Load_ARB_invalidate_subdata},
+    {"GL_ARB_half_float_vertex", &sfogl_ext_ARB_half_float_vertex, NULL},
+    {"GL_SGIS_texture_lod", &sfogl_ext_SGIS_texture_lod, NULL},
+    {"GL_ARB_copy_image", &sfogl_ext_ARB_copy_image, Load_ARB_copy_image},
+    {"GL_KHR_debug", &sfogl_ext_KHR_debug, Load_KHR_debug},
+    {"GL_ARB_texture_storage", &sfogl_ext_ARB_texture_storage, Load_ARB_texture_storage}
 };
 
-static int g_extensionMapSize = 20;
+static int g_extensionMapSize = 53;
 
 
 static void ClearExtensionVars()
 {
-    sfogl_ext_SGIS_texture_edge_clamp = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_texture_edge_clamp = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_blend_minmax = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_blend_subtract = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_multitexture = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_blend_func_separate = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_shading_language_100 = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_shader_objects = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_vertex_shader = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_fragment_shader = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_texture_non_power_of_two = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_packed_depth_stencil = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
-    sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
-    sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_SGIS_texture_edge_clamp = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_texture_edge_clamp = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_blend_minmax = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_blend_subtract = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_multitexture = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_blend_func_separate = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_vertex_buffer_object = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_shading_language_100 = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_shader_objects = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_vertex_shader = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_fragment_shader = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_texture_non_power_of_two = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_blend_equation_separate = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_packed_depth_stencil = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_copy_buffer = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_map_buffer_range = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_sync = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_buffer_storage = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_draw_instanced = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_instanced_arrays = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_occlusion_query = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_timer_query = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_pixel_buffer_object = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_texture_compression = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_texture_compression_s3tc = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_texture_compression_bptc = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_ES3_compatibility = sfogl_LOAD_PENDING;
+    sfogl_ext_KHR_texture_compression_astc_ldr = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_texture3D = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_texture_array = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_bindless_texture = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_uniform_buffer_object = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_get_program_binary = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_compute_shader = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_program_interface_query = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_shader_storage_buffer_object = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_shader_image_load_store = sfogl_LOAD_PENDING;
+    sfogl_ext_KHR_parallel_shader_compile = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_draw_buffers = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_texture_float = sfogl_LOAD_PENDING;
+    sfogl_ext_EXT_packed_float = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_invalidate_subdata = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_half_float_vertex = sfogl_LOAD_PENDING;
+    sfogl_ext_SGIS_texture_lod = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_copy_image = sfogl_LOAD_PENDING;
+    sfogl_ext_KHR_debug = sfogl_LOAD_PENDING;
+    sfogl_ext_ARB_texture_storage = sfogl_LOAD_PENDING;
 }
 
 
@@ -1009,11 +1523,34 @@ static void LoadExtension(sfogl_StrToExtMap& extension)
 
 void sfogl_LoadFunctions()
 {
+    // Resolving all the extensions up front is slow (especially through
+    // wglGetProcAddress), they are resolved when they are first checked
     ClearExtensionVars();
+}
+
+
+int sfogl_ResolveExtension(int* extensionVariable)
+{
+    sf::Lock lock(g_extensionMutex);
+
+    // Another thread may have resolved the extension meanwhile
+    if (*extensionVariable != sfogl_LOAD_PENDING)
+        return *extensionVariable;
 
     for (int i = 0; i < g_extensionMapSize; ++i)
     {
-        if (sf::Context::isExtensionAvailable(ExtensionMap[i].extensionName))
-            LoadExtension(ExtensionMap[i]);
+        if (ExtensionMap[i].extensionVariable == extensionVariable)
+        {
+            // The extension variable is written last, once the functions are loaded
+            if (sf::Context::isExtensionAvailable(ExtensionMap[i].extensionName))
+                LoadExtension(ExtensionMap[i]);
+
+            break;
+        }
     }
+
+    if (*extensionVariable == sfogl_LOAD_PENDING)
+        *extensionVariable = sfogl_LOAD_FAILED;
+
+    return *extensionVariable;
 }
@@ -190,6 +190,39 @@ extern int sfogl_ext_EXT_framebuffer_blit;
 extern int sfogl_ext_EXT_framebuffer_multisample;
 extern int sfogl_ext_ARB_copy_buffer;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_vertex_array_object;
+extern int sfogl_ext_ARB_map_buffer_range;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_ext_ARB_buffer_storage;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_instanced_arrays;
+extern int sfogl_ext_ARB_occlusion_query;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_ARB_pixel_buffer_object;
+extern int sfogl_ext_ARB_texture_compression;
+extern int sfogl_ext_EXT_texture_compression_s3tc;
+extern int sfogl_ext_ARB_texture_compression_bptc;
+extern int sfogl_ext_ARB_ES3_compatibility;
+extern int sfogl_ext_KHR_texture_compression_astc_ldr;
+extern int sfogl_ext_EXT_texture3D;
+extern int sfogl_ext_EXT_texture_array;
+extern int sfogl_ext_ARB_bindless_texture;
+extern int sfogl_ext_ARB_uniform_buffer_object;
+extern int sfogl_ext_ARB_get_program_binary;
+extern int sfogl_ext_ARB_compute_shader;
+extern int sfogl_ext_ARB_program_interface_query;
+extern int sfogl_ext_ARB_shader_storage_buffer_object;
+extern int sfogl_ext_ARB_shader_image_load_store;
+extern int sfogl_ext_KHR_parallel_shader_compile;
+extern int sfogl_ext_ARB_draw_buffers;
+extern int sfogl_ext_ARB_texture_float;
+extern int sfogl_ext_EXT_packed_float;
+extern int sfogl_ext_ARB_invalidate_subdata;
+extern int sfogl_ext_ARB_half_float_vertex;
+extern int sfogl_ext_SGIS_texture_lod;
+extern int sfogl_ext_ARB_copy_image;
+extern int sfogl_ext_KHR_debug;
+extern int sfogl_ext_ARB_texture_storage;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -454,6 +487,130 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x0010
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_READ_BIT 0x0001
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_MAP_WRITE_BIT 0x0002
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
+#define GL_OBJECT_TYPE 0x9112
+#define GL_SIGNALED 0x9119
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_UNSIGNALED 0x9118
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
+#define GL_BUFFER_STORAGE_FLAGS 0x8220
+#define GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT 0x00004000
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_MAP_PERSISTENT_BIT 0x0040
+
+#define GL_VERTEX_ATTRIB_ARRAY_DIVISOR_ARB 0x88FE
+
+#define GL_QUERY_RESULT_ARB 0x8866
+#define GL_QUERY_RESULT_AVAILABLE_ARB 0x8867
+
+#define GL_TIMESTAMP 0x8E28
+
+#define GL_PIXEL_PACK_BUFFER_ARB 0x88EB
+#define GL_PIXEL_UNPACK_BUFFER_ARB 0x88EC
+#define GL_PIXEL_PACK_BUFFER_BINDING_ARB 0x88ED
+#define GL_PIXEL_UNPACK_BUFFER_BINDING_ARB 0x88EF
+
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+
+#define GL_COMPRESSED_RGBA_BPTC_UNORM_ARB 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM_ARB 0x8E8D
+
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_SRGB8_ETC2 0x9275
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#define GL_COMPRESSED_RGBA_ASTC_12x12_KHR 0x93BD
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR 0x93DD
+
+#define GL_TEXTURE_2D_ARRAY_EXT 0x8C1A
+#define GL_TEXTURE_BINDING_2D_ARRAY_EXT 0x8C1D
+#define GL_MAX_ARRAY_TEXTURE_LAYERS_EXT 0x88FF
+
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_MAX_UNIFORM_BUFFER_BINDINGS 0x8A2F
+#define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+
+#define GL_COMPUTE_SHADER 0x91B9
+#define GL_MAX_COMPUTE_WORK_GROUP_COUNT 0x91BE
+
+#define GL_SHADER_STORAGE_BLOCK 0x92E6
+
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#define GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS 0x90DD
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+
+#define GL_MAX_IMAGE_UNITS 0x8F38
+#define GL_ALL_BARRIER_BITS 0xFFFFFFFF
+
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+#define GL_MAX_DRAW_BUFFERS_ARB 0x8824
+
+#define GL_RGBA32F_ARB 0x8814
+#define GL_RGBA16F_ARB 0x881A
+
+#define GL_R11F_G11F_B10F_EXT 0x8C3A
+
+#define GL_HALF_FLOAT_ARB 0x140B
+
+#define GL_TEXTURE_BASE_LEVEL_SGIS 0x813C
+#define GL_TEXTURE_MAX_LEVEL_SGIS 0x813D
+
+#define GL_CONTEXT_FLAGS 0x821E
+#define GL_CONTEXT_FLAG_DEBUG_BIT 0x00000002
+#define GL_DEBUG_OUTPUT 0x92E0
+#define GL_DEBUG_OUTPUT_SYNCHRONOUS 0x8242
+#define GL_DEBUG_SOURCE_API 0x8246
+#define GL_DEBUG_SOURCE_WINDOW_SYSTEM 0x8247
+#define GL_DEBUG_SOURCE_SHADER_COMPILER 0x8248
+#define GL_DEBUG_SOURCE_THIRD_PARTY 0x8249
+#define GL_DEBUG_SOURCE_APPLICATION 0x824A
+#define GL_DEBUG_SOURCE_OTHER 0x824B
+#define GL_DEBUG_TYPE_ERROR 0x824C
+#define GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR 0x824D
+#define GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR 0x824E
+#define GL_DEBUG_TYPE_PORTABILITY 0x824F
+#define GL_DEBUG_TYPE_PERFORMANCE 0x8250
+#define GL_DEBUG_TYPE_OTHER 0x8251
+#define GL_DEBUG_SEVERITY_HIGH 0x9146
+#define GL_DEBUG_SEVERITY_MEDIUM 0x9147
+#define GL_DEBUG_SEVERITY_LOW 0x9148
+#define GL_DEBUG_SEVERITY_NOTIFICATION 0x826B
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1353,6 +1510,188 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint);
+#define glIsVertexArray sf_ptrc_glIsVertexArray
+#endif // GL_ARB_vertex_array_object
+
+#ifndef GL_ARB_map_buffer_range
+#define GL_ARB_map_buffer_range 1
+extern void (GL_FUNCPTR *sf_ptrc_glFlushMappedBufferRange)(GLenum, GLintptr, GLsizeiptr);
+#define glFlushMappedBufferRange sf_ptrc_glFlushMappedBufferRange
+extern void* (GL_FUNCPTR *sf_ptrc_glMapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+#define glMapBufferRange sf_ptrc_glMapBufferRange
+#endif // GL_ARB_map_buffer_range
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+extern GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*);
+#define glGetInteger64v sf_ptrc_glGetInteger64v
+extern void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*);
+#define glGetSynciv sf_ptrc_glGetSynciv
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync);
+#define glIsSync sf_ptrc_glIsSync
+extern void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glWaitSync sf_ptrc_glWaitSync
+#endif // GL_ARB_sync
+
+#ifndef GL_ARB_buffer_storage
+#define GL_ARB_buffer_storage 1
+extern void (GL_FUNCPTR *sf_ptrc_glBufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield);
+#define glBufferStorage sf_ptrc_glBufferStorage
+#endif // GL_ARB_buffer_storage
+
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (GL_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void*, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif // GL_ARB_draw_instanced
+
+#ifndef GL_ARB_instanced_arrays
+#define GL_ARB_instanced_arrays 1
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribDivisorARB)(GLuint, GLuint);
+#define glVertexAttribDivisorARB sf_ptrc_glVertexAttribDivisorARB
+#endif // GL_ARB_instanced_arrays
+
+#ifndef GL_ARB_occlusion_query
+#define GL_ARB_occlusion_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint*);
+#define glGenQueriesARB sf_ptrc_glGenQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint*);
+#define glDeleteQueriesARB sf_ptrc_glDeleteQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint*);
+#define glGetQueryObjectuivARB sf_ptrc_glGetQueryObjectuivARB
+#endif // GL_ARB_occlusion_query
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum);
+#define glQueryCounter sf_ptrc_glQueryCounter
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+#endif // GL_ARB_timer_query
+
+#ifndef GL_ARB_texture_compression
+#define GL_ARB_texture_compression 1
+extern void (GL_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void*);
+#define glCompressedTexImage2DARB sf_ptrc_glCompressedTexImage2DARB
+#endif // GL_ARB_texture_compression
+
+#ifndef GL_EXT_texture3D
+#define GL_EXT_texture3D 1
+extern void (GL_FUNCPTR *sf_ptrc_glTexImage3DEXT)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*);
+#define glTexImage3DEXT sf_ptrc_glTexImage3DEXT
+extern void (GL_FUNCPTR *sf_ptrc_glTexSubImage3DEXT)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*);
+#define glTexSubImage3DEXT sf_ptrc_glTexSubImage3DEXT
+#endif // GL_EXT_texture3D
+
+#ifndef GL_ARB_bindless_texture
+#define GL_ARB_bindless_texture 1
+extern GLuint64 (GL_FUNCPTR *sf_ptrc_glGetTextureHandleARB)(GLuint);
+#define glGetTextureHandleARB sf_ptrc_glGetTextureHandleARB
+extern void (GL_FUNCPTR *sf_ptrc_glMakeTextureHandleResidentARB)(GLuint64);
+#define glMakeTextureHandleResidentARB sf_ptrc_glMakeTextureHandleResidentARB
+extern void (GL_FUNCPTR *sf_ptrc_glMakeTextureHandleNonResidentARB)(GLuint64);
+#define glMakeTextureHandleNonResidentARB sf_ptrc_glMakeTextureHandleNonResidentARB
+extern void (GL_FUNCPTR *sf_ptrc_glUniformHandleui64ARB)(GLint, GLuint64);
+#define glUniformHandleui64ARB sf_ptrc_glUniformHandleui64ARB
+#endif // GL_ARB_bindless_texture
+
+#ifndef GL_ARB_uniform_buffer_object
+#define GL_ARB_uniform_buffer_object 1
+extern GLuint (GL_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar*);
+#define glGetUniformBlockIndex sf_ptrc_glGetUniformBlockIndex
+extern void (GL_FUNCPTR *sf_ptrc_glGetActiveUniformBlockiv)(GLuint, GLuint, GLenum, GLint*);
+#define glGetActiveUniformBlockiv sf_ptrc_glGetActiveUniformBlockiv
+extern void (GL_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint);
+#define glUniformBlockBinding sf_ptrc_glUniformBlockBinding
+extern void (GL_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint);
+#define glBindBufferBase sf_ptrc_glBindBufferBase
+#endif // GL_ARB_uniform_buffer_object
+
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+#define glGetProgramBinary sf_ptrc_glGetProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei);
+#define glProgramBinary sf_ptrc_glProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint);
+#define glProgramParameteri sf_ptrc_glProgramParameteri
+#endif // GL_ARB_get_program_binary
+
+#ifndef GL_ARB_compute_shader
+#define GL_ARB_compute_shader 1
+extern void (GL_FUNCPTR *sf_ptrc_glDispatchCompute)(GLuint, GLuint, GLuint);
+#define glDispatchCompute sf_ptrc_glDispatchCompute
+#endif // GL_ARB_compute_shader
+
+#ifndef GL_ARB_program_interface_query
+#define GL_ARB_program_interface_query 1
+extern GLuint (GL_FUNCPTR *sf_ptrc_glGetProgramResourceIndex)(GLuint, GLenum, const GLchar*);
+#define glGetProgramResourceIndex sf_ptrc_glGetProgramResourceIndex
+#endif // GL_ARB_program_interface_query
+
+#ifndef GL_ARB_shader_storage_buffer_object
+#define GL_ARB_shader_storage_buffer_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glShaderStorageBlockBinding)(GLuint, GLuint, GLuint);
+#define glShaderStorageBlockBinding sf_ptrc_glShaderStorageBlockBinding
+#endif // GL_ARB_shader_storage_buffer_object
+
+#ifndef GL_ARB_shader_image_load_store
+#define GL_ARB_shader_image_load_store 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindImageTexture)(GLuint, GLuint, GLint, GLboolean, GLint, GLenum, GLenum);
+#define glBindImageTexture sf_ptrc_glBindImageTexture
+extern void (GL_FUNCPTR *sf_ptrc_glMemoryBarrier)(GLbitfield);
+#define glMemoryBarrier sf_ptrc_glMemoryBarrier
+#endif // GL_ARB_shader_image_load_store
+
+#ifndef GL_ARB_draw_buffers
+#define GL_ARB_draw_buffers 1
+extern void (GL_FUNCPTR *sf_ptrc_glDrawBuffersARB)(GLsizei, const GLenum*);
+#define glDrawBuffersARB sf_ptrc_glDrawBuffersARB
+#endif // GL_ARB_draw_buffers
+
+#ifndef GL_ARB_invalidate_subdata
+#define GL_ARB_invalidate_subdata 1
+extern void (GL_FUNCPTR *sf_ptrc_glInvalidateFramebuffer)(GLenum, GLsizei, const GLenum*);
+#define glInvalidateFramebuffer sf_ptrc_glInvalidateFramebuffer
+#endif // GL_ARB_invalidate_subdata
+
+#ifndef GL_ARB_copy_image
+#define GL_ARB_copy_image 1
+extern void (GL_FUNCPTR *sf_ptrc_glCopyImageSubData)(GLuint, GLenum, GLint, GLint, GLint, GLint, GLuint, GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei);
+#define glCopyImageSubData sf_ptrc_glCopyImageSubData
+#endif // GL_ARB_copy_image
+
+#ifndef GL_KHR_debug
+#define GL_KHR_debug 1
+extern void (GL_FUNCPTR *sf_ptrc_glDebugMessageCallback)(GLDEBUGPROC, const void*);
+#define glDebugMessageCallback sf_ptrc_glDebugMessageCallback
+extern void (GL_FUNCPTR *sf_ptrc_glDebugMessageControl)(GLenum, GLenum, GLenum, GLsizei, const GLuint*, GLboolean);
+#define glDebugMessageControl sf_ptrc_glDebugMessageControl
+#endif // GL_KHR_debug
+
+#ifndef GL_ARB_texture_storage
+#define GL_ARB_texture_storage 1
+extern void (GL_FUNCPTR *sf_ptrc_glTexStorage2D)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+#define glTexStorage2D sf_ptrc_glTexStorage2D
+#endif // GL_ARB_texture_storage
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
@@ -1693,12 +2032,18 @@ GLAPI void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const void*);
 
 enum sfogl_LoadStatus
 {
+    sfogl_LOAD_PENDING = -1,
     sfogl_LOAD_FAILED = 0,
     sfogl_LOAD_SUCCEEDED = 1
 };
 
 void sfogl_LoadFunctions();
 
+int sfogl_ResolveExtension(int* extensionVariable);
+
+/* Extensions are looked up and their functions loaded on their first check */
+#define sfogl_IsExtensionLoaded(variable) (((variable) != sfogl_LOAD_PENDING) ? (variable) : sfogl_ResolveExtension(&(variable)))
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
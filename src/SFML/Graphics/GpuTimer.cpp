@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuTimer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    // Query objects of a given context
+    struct QueryPool
+    {
+        std::vector<GLuint> queries; // All the queries created in the context
+        std::vector<GLuint> unused;  // Queries that can be recorded again
+    };
+
+    typedef std::map<sf::Uint64, QueryPool> QueryPoolMap;
+    QueryPoolMap pools;
+
+    // Mutex to protect the pools map
+    sf::Mutex timerPoolMutex;
+
+    // Check if a query belongs to a pool and is being recorded
+    bool isPending(const QueryPool& pool, GLuint query)
+    {
+        return (std::find(pool.queries.begin(), pool.queries.end(), query) != pool.queries.end()) &&
+               (std::find(pool.unused.begin(), pool.unused.end(), query) == pool.unused.end());
+    }
+
+    // Callback that is called every time a context is destroyed
+    void timerContextDestroyCallback(void* /*arg*/)
+    {
+        sf::Lock lock(timerPoolMutex);
+
+        QueryPoolMap::iterator iter = pools.find(sf::Context::getActiveContextId());
+        if (iter == pools.end())
+            return;
+
+#ifndef SFML_OPENGL_ES
+        std::vector<GLuint>& queries = iter->second.queries;
+        if (!queries.empty())
+            glCheck(GLEXT_glDeleteQueries(static_cast<GLsizei>(queries.size()), &queries[0]));
+#endif
+
+        pools.erase(iter);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool GpuTimer::isAvailable()
+{
+    Lock lock(timerPoolMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_occlusion_query && GLEXT_timer_query;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GpuTimer::insertTimestamp()
+{
+#ifndef SFML_OPENGL_ES
+
+    Lock lock(timerPoolMutex);
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    QueryPoolMap::iterator iter = pools.find(contextId);
+
+    if (iter == pools.end())
+    {
+        // Register the context destruction callback
+        static bool registered = false;
+        if (!registered)
+        {
+            registerContextDestroyCallback(timerContextDestroyCallback, 0);
+            registered = true;
+        }
+
+        iter = pools.insert(std::make_pair(contextId, QueryPool())).first;
+    }
+
+    QueryPool& pool = iter->second;
+
+    GLuint query = 0;
+
+    if (pool.unused.empty())
+    {
+        glCheck(GLEXT_glGenQueries(1, &query));
+
+        if (!query)
+            return 0;
+
+        pool.queries.push_back(query);
+    }
+    else
+    {
+        query = pool.unused.back();
+        pool.unused.pop_back();
+    }
+
+    glCheck(GLEXT_glQueryCounter(query, GLEXT_GL_TIMESTAMP));
+
+    return query;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuTimer::getTimestamp(unsigned int query, Uint64& time)
+{
+#ifndef SFML_OPENGL_ES
+
+    Lock lock(timerPoolMutex);
+
+    QueryPoolMap::iterator iter = pools.find(Context::getActiveContextId());
+
+    if ((iter == pools.end()) || !isPending(iter->second, query))
+        return false;
+
+    GLuint available = GL_FALSE;
+    glCheck(GLEXT_glGetQueryObjectuiv(query, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+
+    if (!available)
+        return false;
+
+    GLuint64 result = 0;
+    glCheck(GLEXT_glGetQueryObjectui64v(query, GLEXT_GL_QUERY_RESULT, &result));
+
+    time = static_cast<Uint64>(result);
+    iter->second.unused.push_back(query);
+
+    return true;
+
+#else
+
+    (void)query;
+    (void)time;
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuTimer::release(unsigned int query)
+{
+    Lock lock(timerPoolMutex);
+
+    QueryPoolMap::iterator iter = pools.find(Context::getActiveContextId());
+
+    if ((iter != pools.end()) && isPending(iter->second, query))
+        iter->second.unused.push_back(query);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GPUTIMER_HPP
+#define SFML_GPUTIMER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous GPU timestamps, used to measure
+///        the time the GPU spends on a frame
+///
+////////////////////////////////////////////////////////////
+class GpuTimer : GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports timer queries
+    ///
+    /// \return True if GPU timestamps can be recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a timestamp in the current context
+    ///
+    /// The timestamp is taken by the GPU once all the
+    /// previously submitted commands have completed.
+    /// Query objects are not shared between contexts, so
+    /// the query can only be read or released while
+    /// the same context is active.
+    ///
+    /// \return OpenGL name of the query, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int insertTimestamp();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a timestamp without waiting for the GPU
+    ///
+    /// When the result is available, the query is released
+    /// and can't be used anymore.
+    ///
+    /// \param query OpenGL name of the query
+    /// \param time  Receives the timestamp, in nanoseconds
+    ///
+    /// \return True if the result was available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getTimestamp(unsigned int query, Uint64& time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release a query without reading it
+    ///
+    /// Queries that don't belong to the current context
+    /// are ignored, their context releases them when
+    /// it is destroyed.
+    ///
+    /// \param query OpenGL name of the query
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release(unsigned int query);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GPUTIMER_HPP
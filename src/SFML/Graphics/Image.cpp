@@ -26,12 +26,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/System/Err.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 
@@ -126,7 +129,12 @@ bool Image::loadFromFile(const std::string& filename)
 
     #else
 
+        // Assets are decoded from memory when the APK lets us access them without a copy
         priv::ResourceStream stream(filename);
+        const void* data = stream.getData();
+        if (data)
+            return loadFromMemory(data, static_cast<std::size_t>(stream.getSize()));
+
         return loadFromStream(stream);
 
     #endif
@@ -150,7 +158,14 @@ bool Image::loadFromStream(InputStream& stream)
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, ImageView(*this));
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToMemory(std::vector<Uint8>& output, const std::string& format) const
+{
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, ImageView(*this), output);
 }
 
 
@@ -168,45 +183,28 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
     if (!m_pixels.empty())
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        priv::maskPixels(&m_pixels[0], m_pixels.size() / 4, color, alpha);
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Image::copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
+{
+    copy(ImageView(source, sourceRect), destX, destY, applyAlpha);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha)
 {
     // Make sure that both images are valid
-    if ((source.m_size.x == 0) || (source.m_size.y == 0) || (m_size.x == 0) || (m_size.y == 0))
+    if ((source.getSize().x == 0) || (source.getSize().y == 0) || (m_size.x == 0) || (m_size.y == 0))
         return;
 
-    // Adjust the source rectangle
-    IntRect srcRect = sourceRect;
-    if (srcRect.width == 0 || (srcRect.height == 0))
-    {
-        srcRect.left   = 0;
-        srcRect.top    = 0;
-        srcRect.width  = source.m_size.x;
-        srcRect.height = source.m_size.y;
-    }
-    else
-    {
-        if (srcRect.left   < 0) srcRect.left = 0;
-        if (srcRect.top    < 0) srcRect.top  = 0;
-        if (srcRect.width  > static_cast<int>(source.m_size.x)) srcRect.width  = source.m_size.x;
-        if (srcRect.height > static_cast<int>(source.m_size.y)) srcRect.height = source.m_size.y;
-    }
-
-    // Then find the valid bounds of the destination rectangle
-    int width  = srcRect.width;
-    int height = srcRect.height;
+    // Find the valid bounds of the destination rectangle
+    int width  = static_cast<int>(source.getSize().x);
+    int height = static_cast<int>(source.getSize().y);
     if (destX + width  > m_size.x) width  = m_size.x - destX;
     if (destY + height > m_size.y) height = m_size.y - destY;
 
@@ -217,31 +215,18 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
     // Precompute as much as possible
     int          pitch     = width * 4;
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
+    std::size_t  srcStride = source.getStride();
     int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
+    const Uint8* srcPixels = source.getPixelsPtr();
     Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Interpolation using alpha values, row by row
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
+            priv::blendPixels(dstPixels, srcPixels, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
@@ -259,6 +244,55 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 }
 
 
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_pixels.empty())
+        priv::premultiplyPixels(&m_pixels[0], m_pixels.size() / 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::tint(const Color& color)
+{
+    if (!m_pixels.empty())
+        priv::modulatePixels(&m_pixels[0], m_pixels.size() / 4, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::boxBlur(unsigned int radius)
+{
+    if (!m_pixels.empty())
+        priv::boxBlurPixels(&m_pixels[0], m_size.x, m_size.y, radius);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::gaussianBlur(float sigma)
+{
+    if (m_pixels.empty() || (sigma <= 0.f))
+        return;
+
+    // Find the widths of 3 box filters whose combination has the requested
+    // standard deviation: smaller ones first, then larger ones (by 2 pixels)
+    const int passes = 3;
+    float idealWidth = std::sqrt(12.f * sigma * sigma / passes + 1.f);
+    int smallWidth = static_cast<int>(idealWidth);
+    if (smallWidth % 2 == 0)
+        --smallWidth;
+
+    float idealCount = (12.f * sigma * sigma - passes * smallWidth * smallWidth - 4.f * passes * smallWidth - 3.f * passes) / (-4.f * smallWidth - 4.f);
+    int smallCount = static_cast<int>(std::floor(idealCount + 0.5f));
+
+    for (int i = 0; i < passes; ++i)
+    {
+        int width = (i < smallCount) ? smallWidth : smallWidth + 2;
+        priv::boxBlurPixels(&m_pixels[0], m_size.x, m_size.y, static_cast<unsigned int>(width / 2));
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
@@ -301,18 +335,7 @@ void Image::flipHorizontally()
         std::size_t rowSize = m_size.x * 4;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
-        {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
-        }
+            priv::reversePixels(&m_pixels[y * rowSize], m_size.x);
     }
 }
 
@@ -324,12 +347,16 @@ void Image::flipVertically()
     {
         std::size_t rowSize = m_size.x * 4;
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        // Swap whole rows through a temporary one, memcpy being much faster than byte swaps
+        std::vector<Uint8> row(rowSize);
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            std::memcpy(&row[0], top, rowSize);
+            std::memcpy(top, bottom, rowSize);
+            std::memcpy(bottom, &row[0], rowSize);
 
             top += rowSize;
             bottom -= rowSize;
@@ -337,4 +364,12 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::swap(Image& right)
+{
+    std::swap(m_size, right.m_size);
+    m_pixels.swap(right.m_pixels);
+}
+
 } // namespace sf
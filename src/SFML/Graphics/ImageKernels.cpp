@@ -0,0 +1,599 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/System/Cpu.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Exact x / 255, rounded down, for x in [0, 255 * 255]
+    inline sf::Uint32 divide255(sf::Uint32 x)
+    {
+        return (x + 1 + (x >> 8)) >> 8;
+    }
+
+    // Exact x / 255, rounded to the nearest, for x in [0, 255 * 255]
+    inline sf::Uint32 divide255Rounded(sf::Uint32 x)
+    {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+#if defined(SFML_CPU_SSE2) || defined(SFML_CPU_NEON) || defined(SFML_CPU_DISPATCH_X86)
+
+    // Pack the components of a pixel the way they are laid out in memory
+    sf::Uint32 packPixel(sf::Uint8 r, sf::Uint8 g, sf::Uint8 b, sf::Uint8 a)
+    {
+        sf::Uint8 components[4] = {r, g, b, a};
+        sf::Uint32 pixel;
+        std::memcpy(&pixel, components, sizeof(pixel));
+        return pixel;
+    }
+
+#endif
+
+#if defined(SFML_CPU_SSE2)
+
+    // Same as divide255, on 8 components
+    inline __m128i divide255(__m128i x)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Same as divide255Rounded, on 8 components
+    inline __m128i divide255Rounded(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Copy the alpha of each of the 2 pixels to its 4 components
+    inline __m128i broadcastAlpha(__m128i pixels)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Select the alpha components of 2 pixels from a, the color components from b
+    inline __m128i selectAlpha(__m128i a, __m128i b)
+    {
+        const __m128i mask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    // Same as divide255, on 8 components
+    inline uint8x8_t divide255(uint16x8_t x)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+    }
+
+    // Same as divide255Rounded, on 8 components
+    inline uint8x8_t divide255Rounded(uint16x8_t x)
+    {
+        x = vaddq_u16(x, vdupq_n_u16(128));
+        return vshrn_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+
+#endif
+
+#if defined(SFML_CPU_DISPATCH_X86)
+
+    // The AVX2 kernels are the SSE2 ones on twice as many pixels, since the
+    // unpack and pack instructions work on each 128-bit half separately.
+    // They process whole groups of 8 pixels and return how many they did
+
+    // Same as divide255, on 16 components
+    SFML_CPU_TARGET("avx2") inline __m256i divide255(__m256i x)
+    {
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    // Same as divide255Rounded, on 16 components
+    SFML_CPU_TARGET("avx2") inline __m256i divide255Rounded(__m256i x)
+    {
+        x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    // Copy the alpha of each of the 4 pixels to its 4 components
+    SFML_CPU_TARGET("avx2") inline __m256i broadcastAlpha(__m256i pixels)
+    {
+        return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Select the alpha components of 4 pixels from a, the color components from b
+    SFML_CPU_TARGET("avx2") inline __m256i selectAlpha(__m256i a, __m256i b)
+    {
+        const __m256i mask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+        return _mm256_or_si256(_mm256_and_si256(mask, a), _mm256_andnot_si256(mask, b));
+    }
+
+    SFML_CPU_TARGET("avx2") std::size_t blendPixelsAvx2(sf::Uint8* destination, const sf::Uint8* source, std::size_t count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i full = _mm256_set1_epi16(255);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i src = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+            __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(destination + i * 4));
+
+            __m256i result[2];
+            for (int half = 0; half < 2; ++half)
+            {
+                __m256i s = half ? _mm256_unpackhi_epi8(src, zero) : _mm256_unpacklo_epi8(src, zero);
+                __m256i d = half ? _mm256_unpackhi_epi8(dst, zero) : _mm256_unpacklo_epi8(dst, zero);
+
+                __m256i alpha  = broadcastAlpha(s);
+                __m256i factor = selectAlpha(full, alpha);
+                __m256i sum    = _mm256_add_epi16(_mm256_mullo_epi16(s, factor), _mm256_mullo_epi16(d, _mm256_sub_epi16(full, alpha)));
+
+                result[half] = divide255(sum);
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_packus_epi16(result[0], result[1]));
+        }
+
+        return i;
+    }
+
+    SFML_CPU_TARGET("avx2") std::size_t maskPixelsAvx2(sf::Uint8* pixels, std::size_t count, const sf::Color& color, sf::Uint8 alpha)
+    {
+        const __m256i keys      = _mm256_set1_epi32(static_cast<int>(packPixel(color.r, color.g, color.b, color.a)));
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(packPixel(0, 0, 0, 255)));
+        const __m256i alphas    = _mm256_set1_epi32(static_cast<int>(packPixel(0, 0, 0, alpha)));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* ptr = reinterpret_cast<__m256i*>(pixels + i * 4);
+            __m256i  p   = _mm256_loadu_si256(ptr);
+
+            __m256i selected = _mm256_and_si256(_mm256_cmpeq_epi32(p, keys), alphaMask);
+            _mm256_storeu_si256(ptr, _mm256_or_si256(_mm256_andnot_si256(selected, p), _mm256_and_si256(selected, alphas)));
+        }
+
+        return i;
+    }
+
+    SFML_CPU_TARGET("avx2") std::size_t premultiplyPixelsAvx2(sf::Uint8* pixels, std::size_t count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i full = _mm256_set1_epi16(255);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* ptr = reinterpret_cast<__m256i*>(pixels + i * 4);
+            __m256i  p   = _mm256_loadu_si256(ptr);
+
+            __m256i low  = _mm256_unpacklo_epi8(p, zero);
+            __m256i high = _mm256_unpackhi_epi8(p, zero);
+            low  = divide255Rounded(_mm256_mullo_epi16(low, selectAlpha(full, broadcastAlpha(low))));
+            high = divide255Rounded(_mm256_mullo_epi16(high, selectAlpha(full, broadcastAlpha(high))));
+
+            _mm256_storeu_si256(ptr, _mm256_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+    SFML_CPU_TARGET("avx2") std::size_t modulatePixelsAvx2(sf::Uint8* pixels, std::size_t count, const sf::Color& color)
+    {
+        const __m256i zero   = _mm256_setzero_si256();
+        const __m256i factor = _mm256_set_epi16(color.a, color.b, color.g, color.r, color.a, color.b, color.g, color.r,
+                                                color.a, color.b, color.g, color.r, color.a, color.b, color.g, color.r);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i* ptr = reinterpret_cast<__m256i*>(pixels + i * 4);
+            __m256i  p   = _mm256_loadu_si256(ptr);
+
+            __m256i low  = divide255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(p, zero), factor));
+            __m256i high = divide255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(p, zero), factor));
+
+            _mm256_storeu_si256(ptr, _mm256_packus_epi16(low, high));
+        }
+
+        return i;
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_DISPATCH_X86)
+
+    // The build may not enable AVX2, the processor running it is checked instead
+    if (Cpu::hasFeatures(Cpu::Avx2))
+        i = blendPixelsAvx2(destination, source, count);
+
+#endif
+
+#if defined(SFML_CPU_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+
+        __m128i result[2];
+        for (int half = 0; half < 2; ++half)
+        {
+            __m128i s = half ? _mm_unpackhi_epi8(src, zero) : _mm_unpacklo_epi8(src, zero);
+            __m128i d = half ? _mm_unpackhi_epi8(dst, zero) : _mm_unpacklo_epi8(dst, zero);
+
+            // Colors are weighted by the source alpha, the alpha itself by 255
+            __m128i alpha  = broadcastAlpha(s);
+            __m128i factor = selectAlpha(full, alpha);
+            __m128i sum    = _mm_add_epi16(_mm_mullo_epi16(s, factor), _mm_mullo_epi16(d, _mm_sub_epi16(full, alpha)));
+
+            result[half] = divide255(sum);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(result[0], result[1]));
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t src = vld4_u8(source + i * 4);
+        uint8x8x4_t dst = vld4_u8(destination + i * 4);
+
+        uint8x8_t alpha   = src.val[3];
+        uint8x8_t inverse = vmvn_u8(alpha);
+
+        for (int c = 0; c < 3; ++c)
+            dst.val[c] = divide255(vmlal_u8(vmull_u8(src.val[c], alpha), dst.val[c], inverse));
+        dst.val[3] = divide255(vmlal_u8(vmull_u8(alpha, vdup_n_u8(255)), dst.val[3], inverse));
+
+        vst4_u8(destination + i * 4, dst);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        const Uint8* src = source + i * 4;
+        Uint8*       dst = destination + i * 4;
+
+        // Interpolate RGBA components using the alpha value of the source pixel
+        Uint32 alpha = src[3];
+        dst[0] = static_cast<Uint8>(divide255(src[0] * alpha + dst[0] * (255 - alpha)));
+        dst[1] = static_cast<Uint8>(divide255(src[1] * alpha + dst[1] * (255 - alpha)));
+        dst[2] = static_cast<Uint8>(divide255(src[2] * alpha + dst[2] * (255 - alpha)));
+        dst[3] = static_cast<Uint8>(alpha + divide255(dst[3] * (255 - alpha)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_DISPATCH_X86)
+
+    // The build may not enable AVX2, the processor running it is checked instead
+    if (Cpu::hasFeatures(Cpu::Avx2))
+        i = maskPixelsAvx2(pixels, count, color, alpha);
+
+#endif
+
+#if defined(SFML_CPU_SSE2)
+
+    const __m128i keys      = _mm_set1_epi32(static_cast<int>(packPixel(color.r, color.g, color.b, color.a)));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(packPixel(0, 0, 0, 255)));
+    const __m128i alphas    = _mm_set1_epi32(static_cast<int>(packPixel(0, 0, 0, alpha)));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  p   = _mm_loadu_si128(ptr);
+
+        // Replace the alpha byte of the pixels equal to the key
+        __m128i selected = _mm_and_si128(_mm_cmpeq_epi32(p, keys), alphaMask);
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(selected, p), _mm_and_si128(selected, alphas)));
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    const uint32x4_t keys      = vdupq_n_u32(packPixel(color.r, color.g, color.b, color.a));
+    const uint32x4_t alphaMask = vdupq_n_u32(packPixel(0, 0, 0, 255));
+    const uint32x4_t alphas    = vdupq_n_u32(packPixel(0, 0, 0, alpha));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t p = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+
+        // Replace the alpha byte of the pixels equal to the key
+        uint32x4_t selected = vandq_u32(vceqq_u32(p, keys), alphaMask);
+        vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(selected, alphas, p)));
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
+            ptr[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    // [left, right) is the range of pixels not swapped yet
+    std::size_t left  = 0;
+    std::size_t right = count;
+
+#if defined(SFML_CPU_SSE2)
+
+    for (; right - left >= 8; left += 4, right -= 4)
+    {
+        __m128i* first = reinterpret_cast<__m128i*>(pixels + left * 4);
+        __m128i* last  = reinterpret_cast<__m128i*>(pixels + (right - 4) * 4);
+
+        __m128i a = _mm_shuffle_epi32(_mm_loadu_si128(first), _MM_SHUFFLE(0, 1, 2, 3));
+        __m128i b = _mm_shuffle_epi32(_mm_loadu_si128(last), _MM_SHUFFLE(0, 1, 2, 3));
+
+        _mm_storeu_si128(first, b);
+        _mm_storeu_si128(last, a);
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    for (; right - left >= 8; left += 4, right -= 4)
+    {
+        Uint8* first = pixels + left * 4;
+        Uint8* last  = pixels + (right - 4) * 4;
+
+        uint32x4_t a = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(first)));
+        uint32x4_t b = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(last)));
+
+        vst1q_u8(first, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(b), vget_low_u32(b))));
+        vst1q_u8(last, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(a), vget_low_u32(a))));
+    }
+
+#endif
+
+    for (; right - left >= 2; ++left, --right)
+        std::swap_ranges(pixels + left * 4, pixels + left * 4 + 4, pixels + (right - 1) * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_DISPATCH_X86)
+
+    // The build may not enable AVX2, the processor running it is checked instead
+    if (Cpu::hasFeatures(Cpu::Avx2))
+        i = premultiplyPixelsAvx2(pixels, count);
+
+#endif
+
+#if defined(SFML_CPU_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  p   = _mm_loadu_si128(ptr);
+
+        // The alpha component is multiplied by 255, which leaves it unchanged
+        __m128i low  = _mm_unpacklo_epi8(p, zero);
+        __m128i high = _mm_unpackhi_epi8(p, zero);
+        low  = divide255Rounded(_mm_mullo_epi16(low, selectAlpha(full, broadcastAlpha(low))));
+        high = divide255Rounded(_mm_mullo_epi16(high, selectAlpha(full, broadcastAlpha(high))));
+
+        _mm_storeu_si128(ptr, _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t p = vld4_u8(pixels + i * 4);
+
+        for (int c = 0; c < 3; ++c)
+            p.val[c] = divide255Rounded(vmull_u8(p.val[c], p.val[3]));
+
+        vst4_u8(pixels + i * 4, p);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr   = pixels + i * 4;
+        Uint32 alpha = ptr[3];
+
+        ptr[0] = static_cast<Uint8>(divide255Rounded(ptr[0] * alpha));
+        ptr[1] = static_cast<Uint8>(divide255Rounded(ptr[1] * alpha));
+        ptr[2] = static_cast<Uint8>(divide255Rounded(ptr[2] * alpha));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void modulatePixels(Uint8* pixels, std::size_t count, const Color& color)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_CPU_DISPATCH_X86)
+
+    // The build may not enable AVX2, the processor running it is checked instead
+    if (Cpu::hasFeatures(Cpu::Avx2))
+        i = modulatePixelsAvx2(pixels, count, color);
+
+#endif
+
+#if defined(SFML_CPU_SSE2)
+
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i factor = _mm_set_epi16(color.a, color.b, color.g, color.r, color.a, color.b, color.g, color.r);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  p   = _mm_loadu_si128(ptr);
+
+        __m128i low  = divide255(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), factor));
+        __m128i high = divide255(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), factor));
+
+        _mm_storeu_si128(ptr, _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_CPU_NEON)
+
+    const uint8x8_t factors[4] = {vdup_n_u8(color.r), vdup_n_u8(color.g), vdup_n_u8(color.b), vdup_n_u8(color.a)};
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t p = vld4_u8(pixels + i * 4);
+
+        for (int c = 0; c < 4; ++c)
+            p.val[c] = divide255(vmull_u8(p.val[c], factors[c]));
+
+        vst4_u8(pixels + i * 4, p);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+
+        ptr[0] = static_cast<Uint8>(divide255(ptr[0] * static_cast<Uint32>(color.r)));
+        ptr[1] = static_cast<Uint8>(divide255(ptr[1] * static_cast<Uint32>(color.g)));
+        ptr[2] = static_cast<Uint8>(divide255(ptr[2] * static_cast<Uint32>(color.b)));
+        ptr[3] = static_cast<Uint8>(divide255(ptr[3] * static_cast<Uint32>(color.a)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void boxBlurPixels(Uint8* pixels, unsigned int width, unsigned int height, unsigned int radius)
+{
+    if (!radius || !width || !height)
+        return;
+
+    // Both passes slide a window over the pixels, adding the pixel that
+    // enters it and removing the one that leaves it, the image edges
+    // being repeated as needed
+    Uint32 window = 2 * radius + 1;
+    Uint32 half   = window / 2;
+
+    std::size_t rowSize = static_cast<std::size_t>(width) * 4;
+
+    // Horizontal pass, row by row
+    std::vector<Uint8> row(rowSize);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        Uint8* line = pixels + y * rowSize;
+
+        Uint32 sums[4];
+        for (int c = 0; c < 4; ++c)
+            sums[c] = (radius + 1) * line[c];
+        for (unsigned int x = 1; x <= radius; ++x)
+        {
+            const Uint8* pixel = line + std::min(x, width - 1) * 4;
+            for (int c = 0; c < 4; ++c)
+                sums[c] += pixel[c];
+        }
+
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            for (int c = 0; c < 4; ++c)
+                row[x * 4 + c] = static_cast<Uint8>((sums[c] + half) / window);
+
+            const Uint8* entering = line + std::min(x + radius + 1, width - 1) * 4;
+            const Uint8* leaving  = line + (x >= radius ? x - radius : 0) * 4;
+            for (int c = 0; c < 4; ++c)
+                sums[c] += entering[c] - leaving[c];
+        }
+
+        std::memcpy(line, &row[0], rowSize);
+    }
+
+    // Vertical pass, processing whole rows to stay cache friendly
+    std::vector<Uint8>  source(pixels, pixels + rowSize * height);
+    std::vector<Uint32> sums(rowSize);
+
+    for (std::size_t i = 0; i < rowSize; ++i)
+        sums[i] = (radius + 1) * source[i];
+    for (unsigned int y = 1; y <= radius; ++y)
+    {
+        const Uint8* line = &source[std::min(y, height - 1) * rowSize];
+        for (std::size_t i = 0; i < rowSize; ++i)
+            sums[i] += line[i];
+    }
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        Uint8* line = pixels + y * rowSize;
+        for (std::size_t i = 0; i < rowSize; ++i)
+            line[i] = static_cast<Uint8>((sums[i] + half) / window);
+
+        const Uint8* entering = &source[std::min(y + radius + 1, height - 1) * rowSize];
+        const Uint8* leaving  = &source[(y >= radius ? y - radius : 0) * rowSize];
+        for (std::size_t i = 0; i < rowSize; ++i)
+            sums[i] += entering[i] - leaving[i];
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
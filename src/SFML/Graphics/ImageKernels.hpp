@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Color.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend source pixels over destination pixels, using the source alpha
+///
+/// The kernels of this file work on packed RGBA pixels and
+/// use SSE2 or NEON when the target architecture provides
+/// them, with identical results to the scalar code.
+///
+/// \param destination Pixels to blend into
+/// \param source      Pixels to blend
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Change the alpha of the pixels that match a color
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+/// \param color  Color to look for
+/// \param alpha  Alpha to give to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Color& color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of pixels
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply the color components of pixels by their alpha
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply pixels by a color, component-wise
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+/// \param color  Color to multiply with
+///
+////////////////////////////////////////////////////////////
+void modulatePixels(Uint8* pixels, std::size_t count, const Color& color);
+
+////////////////////////////////////////////////////////////
+/// \brief Apply a box blur to an image
+///
+/// Each pixel is replaced by the average of the square of
+/// (2 * radius + 1)^2 pixels around it, the edges being
+/// extended. The cost doesn't depend on the radius.
+///
+/// \param pixels Pixels of the image
+/// \param width  Width of the image
+/// \param height Height of the image
+/// \param radius Radius of the blur, in pixels
+///
+////////////////////////////////////////////////////////////
+void boxBlurPixels(Uint8* pixels, unsigned int width, unsigned int height, unsigned int radius);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
@@ -26,13 +26,26 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
+#ifdef SFML_IMAGE_TURBOJPEG
+    #include <turbojpeg.h>
+#endif
+#ifdef SFML_IMAGE_SPNG
+    #include <spng.h>
+#endif
+#include <algorithm>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
 
 
 namespace
@@ -61,6 +74,812 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Signatures of the pre-compressed image containers
+    const sf::Uint8 ddsSignature[] = {'D', 'D', 'S', ' '};
+    const sf::Uint8 ktxSignature[] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    // OpenGL internal formats of the compressed data found in DDS files
+    const unsigned int formatRgbaDxt1      = 0x83F1; // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    const unsigned int formatRgbaDxt3      = 0x83F2; // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+    const unsigned int formatRgbaDxt5      = 0x83F3; // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    const unsigned int formatSrgbAlphaDxt1 = 0x8C4D; // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+    const unsigned int formatSrgbAlphaDxt3 = 0x8C4E; // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT
+    const unsigned int formatSrgbAlphaDxt5 = 0x8C4F; // GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+    const unsigned int formatRgbaBptc      = 0x8E8C; // GL_COMPRESSED_RGBA_BPTC_UNORM
+    const unsigned int formatSrgbAlphaBptc = 0x8E8D; // GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+
+    // Check whether data starts with a given signature
+    bool hasSignature(const sf::Uint8* data, std::size_t dataSize, const sf::Uint8* signature, std::size_t signatureSize)
+    {
+        return (dataSize >= signatureSize) && (std::memcmp(data, signature, signatureSize) == 0);
+    }
+
+    // Read a little-endian 32-bits value
+    sf::Uint32 readUint32(const sf::Uint8* data)
+    {
+        return static_cast<sf::Uint32>(data[0])         | (static_cast<sf::Uint32>(data[1]) << 8) |
+              (static_cast<sf::Uint32>(data[2]) << 16) | (static_cast<sf::Uint32>(data[3]) << 24);
+    }
+
+    // Read a 32-bits value stored with the endianness of a KTX file
+    sf::Uint32 readUint32(const sf::Uint8* data, bool swapped)
+    {
+        sf::Uint32 value = readUint32(data);
+
+        if (swapped)
+            value = (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+
+        return value;
+    }
+
+    // Build a DDS four-character code
+    sf::Uint32 fourCC(char a, char b, char c, char d)
+    {
+        return static_cast<sf::Uint32>(a) | (static_cast<sf::Uint32>(b) << 8) | (static_cast<sf::Uint32>(c) << 16) | (static_cast<sf::Uint32>(d) << 24);
+    }
+
+    // Layout of the blocks of a compressed format
+    struct BlockLayout
+    {
+        sf::priv::CompressedImage::Family family;
+        unsigned int                      width;
+        unsigned int                      height;
+        unsigned int                      size;
+    };
+
+    // Get the block layout of a compressed format, return false if the format is not supported
+    bool getBlockLayout(unsigned int format, BlockLayout& layout)
+    {
+        layout.width = 4;
+        layout.height = 4;
+
+        switch (format)
+        {
+            case 0x83F0: // GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            case 0x8C4C: // GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+            case formatRgbaDxt1:
+            case formatSrgbAlphaDxt1:
+                layout.family = sf::priv::CompressedImage::S3tc;
+                layout.size = 8;
+                return true;
+
+            case formatRgbaDxt3:
+            case formatRgbaDxt5:
+            case formatSrgbAlphaDxt3:
+            case formatSrgbAlphaDxt5:
+                layout.family = sf::priv::CompressedImage::S3tc;
+                layout.size = 16;
+                return true;
+
+            case formatRgbaBptc:
+            case formatSrgbAlphaBptc:
+                layout.family = sf::priv::CompressedImage::Bptc;
+                layout.size = 16;
+                return true;
+
+            case 0x9274: // GL_COMPRESSED_RGB8_ETC2
+            case 0x9275: // GL_COMPRESSED_SRGB8_ETC2
+            case 0x9276: // GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2
+            case 0x9277: // GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2
+                layout.family = sf::priv::CompressedImage::Etc2;
+                layout.size = 8;
+                return true;
+
+            case 0x9278: // GL_COMPRESSED_RGBA8_ETC2_EAC
+            case 0x9279: // GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+                layout.family = sf::priv::CompressedImage::Etc2;
+                layout.size = 16;
+                return true;
+
+            default:
+                break;
+        }
+
+        // ASTC formats are numbered in the same order for linear (from GL_COMPRESSED_RGBA_ASTC_4x4_KHR)
+        // and sRGB (from GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR) colors, all their blocks are 16 bytes
+        static const unsigned int astcBlocks[][2] =
+        {
+            {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6},
+            {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}
+        };
+        const unsigned int astcCount = sizeof(astcBlocks) / sizeof(astcBlocks[0]);
+
+        unsigned int index = astcCount;
+        if ((format >= 0x93B0) && (format < 0x93B0 + astcCount))
+            index = format - 0x93B0;
+        else if ((format >= 0x93D0) && (format < 0x93D0 + astcCount))
+            index = format - 0x93D0;
+
+        if (index == astcCount)
+            return false;
+
+        layout.family = sf::priv::CompressedImage::Astc;
+        layout.width = astcBlocks[index][0];
+        layout.height = astcBlocks[index][1];
+        layout.size = 16;
+        return true;
+    }
+
+    // Get the size in bytes of a compressed mipmap level
+    std::size_t getLevelSize(const BlockLayout& layout, unsigned int width, unsigned int height)
+    {
+        std::size_t blocksX = (width + layout.width - 1) / layout.width;
+        std::size_t blocksY = (height + layout.height - 1) / layout.height;
+        return blocksX * blocksY * layout.size;
+    }
+
+    // Parse a DDS file, return the reason of the failure or NULL on success
+    const char* parseDds(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+    {
+        // Magic number (4 bytes) followed by the DDS_HEADER structure (124 bytes)
+        if ((dataSize < 128) || (readUint32(data + 4) != 124))
+            return "invalid DDS header";
+
+        sf::Uint32 flags       = readUint32(data + 8);
+        sf::Uint32 height      = readUint32(data + 12);
+        sf::Uint32 width       = readUint32(data + 16);
+        sf::Uint32 levelCount  = (flags & 0x20000) ? readUint32(data + 28) : 1; // DDSD_MIPMAPCOUNT
+        sf::Uint32 formatFlags = readUint32(data + 80);
+        sf::Uint32 code        = readUint32(data + 84);
+        sf::Uint32 caps2       = readUint32(data + 112);
+        std::size_t offset     = 128;
+
+        if (!(formatFlags & 0x4)) // DDPF_FOURCC
+            return "uncompressed DDS files are not supported";
+
+        if (caps2 & (0x200 | 0x200000)) // DDSCAPS2_CUBEMAP, DDSCAPS2_VOLUME
+            return "cube map and volume DDS files are not supported";
+
+        if (code == fourCC('D', 'X', 'T', '1'))
+        {
+            image.format = formatRgbaDxt1;
+        }
+        else if (code == fourCC('D', 'X', 'T', '3'))
+        {
+            image.format = formatRgbaDxt3;
+        }
+        else if (code == fourCC('D', 'X', 'T', '5'))
+        {
+            image.format = formatRgbaDxt5;
+        }
+        else if (code == fourCC('D', 'X', '1', '0'))
+        {
+            // Extended DDS_HEADER_DXT10 structure (20 bytes)
+            if (dataSize < 148)
+                return "invalid DDS header";
+
+            sf::Uint32 dxgiFormat = readUint32(data + 128);
+            sf::Uint32 dimension  = readUint32(data + 132);
+            sf::Uint32 arraySize  = readUint32(data + 140);
+            offset = 148;
+
+            if ((dimension != 3) || (arraySize > 1)) // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+                return "only single 2D textures are supported in DDS files";
+
+            switch (dxgiFormat)
+            {
+                case 71: image.format = formatRgbaDxt1;      break; // DXGI_FORMAT_BC1_UNORM
+                case 72: image.format = formatSrgbAlphaDxt1; break; // DXGI_FORMAT_BC1_UNORM_SRGB
+                case 74: image.format = formatRgbaDxt3;      break; // DXGI_FORMAT_BC2_UNORM
+                case 75: image.format = formatSrgbAlphaDxt3; break; // DXGI_FORMAT_BC2_UNORM_SRGB
+                case 77: image.format = formatRgbaDxt5;      break; // DXGI_FORMAT_BC3_UNORM
+                case 78: image.format = formatSrgbAlphaDxt5; break; // DXGI_FORMAT_BC3_UNORM_SRGB
+                case 98: image.format = formatRgbaBptc;      break; // DXGI_FORMAT_BC7_UNORM
+                case 99: image.format = formatSrgbAlphaBptc; break; // DXGI_FORMAT_BC7_UNORM_SRGB
+                default: return "unsupported DXGI format in DDS file";
+            }
+        }
+        else
+        {
+            return "unsupported compression in DDS file";
+        }
+
+        BlockLayout layout;
+        getBlockLayout(image.format, layout);
+
+        if (!width || !height)
+            return "empty DDS file";
+
+        image.family = layout.family;
+        image.size = sf::Vector2u(width, height);
+
+        // The mipmap levels are stored one after the other, without any padding
+        for (sf::Uint32 i = 0; i < std::max(levelCount, static_cast<sf::Uint32>(1)); ++i)
+        {
+            std::size_t levelSize = getLevelSize(layout, width, height);
+
+            if (offset + levelSize > dataSize)
+                return "truncated DDS file";
+
+            image.levels.push_back(std::vector<sf::Uint8>(data + offset, data + offset + levelSize));
+            offset += levelSize;
+
+            width = std::max(width / 2, static_cast<sf::Uint32>(1));
+            height = std::max(height / 2, static_cast<sf::Uint32>(1));
+        }
+
+        return NULL;
+    }
+
+    // Parse a KTX file, return the reason of the failure or NULL on success
+    const char* parseKtx(const sf::Uint8* data, std::size_t dataSize, sf::priv::CompressedImage& image)
+    {
+        // Identifier (12 bytes) followed by 13 32-bits values
+        if (dataSize < 64)
+            return "invalid KTX header";
+
+        // Files written on big-endian machines store their values byte-swapped
+        bool swapped = false;
+        sf::Uint32 endianness = readUint32(data + 12);
+        if (endianness == 0x01020304)
+            swapped = true;
+        else if (endianness != 0x04030201)
+            return "invalid KTX header";
+
+        sf::Uint32 type          = readUint32(data + 16, swapped);
+        sf::Uint32 format        = readUint32(data + 28, swapped);
+        sf::Uint32 width         = readUint32(data + 36, swapped);
+        sf::Uint32 height        = readUint32(data + 40, swapped);
+        sf::Uint32 depth         = readUint32(data + 44, swapped);
+        sf::Uint32 arraySize     = readUint32(data + 48, swapped);
+        sf::Uint32 faceCount     = readUint32(data + 52, swapped);
+        sf::Uint32 levelCount    = readUint32(data + 56, swapped);
+        sf::Uint32 keyValueBytes = readUint32(data + 60, swapped);
+
+        BlockLayout layout;
+        if ((type != 0) || !getBlockLayout(format, layout))
+            return "unsupported format in KTX file, only compressed formats are supported";
+
+        if ((depth != 0) || (arraySize != 0) || (faceCount != 1))
+            return "only single 2D textures are supported in KTX files";
+
+        if (!width || !height)
+            return "empty KTX file";
+
+        image.format = format;
+        image.family = layout.family;
+        image.size = sf::Vector2u(width, height);
+
+        std::size_t offset = 64 + static_cast<std::size_t>(keyValueBytes);
+
+        // Each mipmap level is preceded by its size, and padded to 4 bytes
+        for (sf::Uint32 i = 0; i < std::max(levelCount, static_cast<sf::Uint32>(1)); ++i)
+        {
+            if (offset + 4 > dataSize)
+                return "truncated KTX file";
+
+            std::size_t levelSize = readUint32(data + offset, swapped);
+            offset += 4;
+
+            if (levelSize != getLevelSize(layout, width, height))
+                return "invalid mipmap level size in KTX file";
+
+            if (offset + levelSize > dataSize)
+                return "truncated KTX file";
+
+            image.levels.push_back(std::vector<sf::Uint8>(data + offset, data + offset + levelSize));
+            offset += (levelSize + 3) & ~static_cast<std::size_t>(3);
+
+            width = std::max(width / 2, static_cast<sf::Uint32>(1));
+            height = std::max(height / 2, static_cast<sf::Uint32>(1));
+        }
+
+        return NULL;
+    }
+
+    // Signatures of the formats that have a dedicated decoder
+    const sf::Uint8 qoiSignature[]  = {'q', 'o', 'i', 'f'};
+#ifdef SFML_IMAGE_TURBOJPEG
+    const sf::Uint8 jpegSignature[] = {0xFF, 0xD8, 0xFF};
+#endif
+#ifdef SFML_IMAGE_SPNG
+    const sf::Uint8 pngSignature[]  = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+#endif
+
+    // QOI chunk tags
+    const sf::Uint8 qoiOpIndex = 0x00;
+    const sf::Uint8 qoiOpDiff  = 0x40;
+    const sf::Uint8 qoiOpLuma  = 0x80;
+    const sf::Uint8 qoiOpRun   = 0xC0;
+    const sf::Uint8 qoiOpRgb   = 0xFE;
+    const sf::Uint8 qoiOpRgba  = 0xFF;
+    const sf::Uint8 qoiMask    = 0xC0;
+
+    // QOI header and end marker sizes, and the largest image accepted by the decoder
+    const std::size_t qoiHeaderSize  = 14;
+    const std::size_t qoiPaddingSize = 8;
+    const sf::Uint64  qoiMaximumPixels = 400000000;
+
+    // Position of a color in the QOI index of recently seen pixels
+    unsigned int qoiHash(const sf::Uint8* pixel)
+    {
+        return (pixel[0] * 3u + pixel[1] * 5u + pixel[2] * 7u + pixel[3] * 11u) % 64u;
+    }
+
+    // Read a big-endian 32-bits value
+    sf::Uint32 readUint32BigEndian(const sf::Uint8* data)
+    {
+        return (static_cast<sf::Uint32>(data[0]) << 24) | (static_cast<sf::Uint32>(data[1]) << 16) |
+               (static_cast<sf::Uint32>(data[2]) << 8)  |  static_cast<sf::Uint32>(data[3]);
+    }
+
+    // Decode a QOI image, return the reason of the failure or NULL
+    const char* decodeQoi(const sf::Uint8* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        if (dataSize < qoiHeaderSize + qoiPaddingSize)
+            return "truncated QOI header";
+
+        sf::Uint32 width    = readUint32BigEndian(data + 4);
+        sf::Uint32 height   = readUint32BigEndian(data + 8);
+        sf::Uint8  channels = data[12];
+
+        if (!width || !height || ((channels != 3) && (channels != 4)) || (data[13] > 1))
+            return "invalid QOI header";
+
+        if (static_cast<sf::Uint64>(width) * height > qoiMaximumPixels)
+            return "QOI image too large";
+
+        pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+        sf::Uint8 index[64 * 4] = {0};
+        sf::Uint8 pixel[4] = {0, 0, 0, 255};
+        unsigned int run = 0;
+
+        const sf::Uint8* chunk = data + qoiHeaderSize;
+        const sf::Uint8* end   = data + dataSize - qoiPaddingSize;
+
+        for (std::size_t offset = 0; offset < pixels.size(); offset += 4)
+        {
+            if (run > 0)
+            {
+                --run;
+            }
+            else if (chunk < end)
+            {
+                sf::Uint8 tag = *chunk++;
+
+                if (tag == qoiOpRgb)
+                {
+                    if (end - chunk < 3)
+                        return "truncated QOI data";
+
+                    pixel[0] = chunk[0];
+                    pixel[1] = chunk[1];
+                    pixel[2] = chunk[2];
+                    chunk += 3;
+                }
+                else if (tag == qoiOpRgba)
+                {
+                    if (end - chunk < 4)
+                        return "truncated QOI data";
+
+                    std::memcpy(pixel, chunk, 4);
+                    chunk += 4;
+                }
+                else if ((tag & qoiMask) == qoiOpIndex)
+                {
+                    std::memcpy(pixel, &index[tag * 4], 4);
+                }
+                else if ((tag & qoiMask) == qoiOpDiff)
+                {
+                    pixel[0] = static_cast<sf::Uint8>(pixel[0] + ((tag >> 4) & 0x03) - 2);
+                    pixel[1] = static_cast<sf::Uint8>(pixel[1] + ((tag >> 2) & 0x03) - 2);
+                    pixel[2] = static_cast<sf::Uint8>(pixel[2] + (tag & 0x03) - 2);
+                }
+                else if ((tag & qoiMask) == qoiOpLuma)
+                {
+                    if (chunk == end)
+                        return "truncated QOI data";
+
+                    sf::Uint8 next = *chunk++;
+                    int greenDiff = (tag & 0x3F) - 32;
+                    pixel[0] = static_cast<sf::Uint8>(pixel[0] + greenDiff - 8 + ((next >> 4) & 0x0F));
+                    pixel[1] = static_cast<sf::Uint8>(pixel[1] + greenDiff);
+                    pixel[2] = static_cast<sf::Uint8>(pixel[2] + greenDiff - 8 + (next & 0x0F));
+                }
+                else
+                {
+                    run = tag & 0x3F;
+                }
+
+                std::memcpy(&index[qoiHash(pixel) * 4], pixel, 4);
+            }
+            else
+            {
+                return "truncated QOI data";
+            }
+
+            std::memcpy(&pixels[offset], pixel, 4);
+        }
+
+        size.x = width;
+        size.y = height;
+
+        return NULL;
+    }
+
+    // Encode RGBA pixels as a QOI image
+    void encodeQoi(const sf::ImageView& pixels, std::vector<sf::Uint8>& output)
+    {
+        const sf::Vector2u size = pixels.getSize();
+        const std::size_t rowSize = size.x * 4;
+        const std::size_t pixelsSize = rowSize * size.y;
+
+        output.clear();
+        output.reserve(qoiHeaderSize + pixelsSize / 2 + qoiPaddingSize);
+
+        // Header: signature, big-endian size, 4 channels, sRGB with linear alpha
+        output.insert(output.end(), qoiSignature, qoiSignature + sizeof(qoiSignature));
+        for (int shift = 24; shift >= 0; shift -= 8)
+            output.push_back(static_cast<sf::Uint8>(size.x >> shift));
+        for (int shift = 24; shift >= 0; shift -= 8)
+            output.push_back(static_cast<sf::Uint8>(size.y >> shift));
+        output.push_back(4);
+        output.push_back(0);
+
+        sf::Uint8 index[64 * 4] = {0};
+        sf::Uint8 previous[4] = {0, 0, 0, 255};
+        unsigned int run = 0;
+
+        // The rows of the view may be apart in memory
+        const sf::Uint8* row = pixels.getPixelsPtr();
+        std::size_t rowOffset = 0;
+
+        for (std::size_t offset = 0; offset < pixelsSize; offset += 4)
+        {
+            if (rowOffset == rowSize)
+            {
+                row += pixels.getStride();
+                rowOffset = 0;
+            }
+
+            const sf::Uint8* pixel = row + rowOffset;
+            rowOffset += 4;
+
+            if (std::memcmp(pixel, previous, 4) == 0)
+            {
+                // Runs are limited to 62 pixels, 63 and 64 would collide with the RGB and RGBA tags
+                if ((++run == 62) || (offset + 4 == pixelsSize))
+                {
+                    output.push_back(static_cast<sf::Uint8>(qoiOpRun | (run - 1)));
+                    run = 0;
+                }
+
+                continue;
+            }
+
+            if (run > 0)
+            {
+                output.push_back(static_cast<sf::Uint8>(qoiOpRun | (run - 1)));
+                run = 0;
+            }
+
+            unsigned int hash = qoiHash(pixel);
+
+            if (std::memcmp(&index[hash * 4], pixel, 4) == 0)
+            {
+                output.push_back(static_cast<sf::Uint8>(qoiOpIndex | hash));
+            }
+            else
+            {
+                std::memcpy(&index[hash * 4], pixel, 4);
+
+                if (pixel[3] == previous[3])
+                {
+                    int redDiff   = static_cast<signed char>(pixel[0] - previous[0]);
+                    int greenDiff = static_cast<signed char>(pixel[1] - previous[1]);
+                    int blueDiff  = static_cast<signed char>(pixel[2] - previous[2]);
+                    int redGreen  = redDiff - greenDiff;
+                    int blueGreen = blueDiff - greenDiff;
+
+                    if ((redDiff >= -2) && (redDiff <= 1) && (greenDiff >= -2) && (greenDiff <= 1) && (blueDiff >= -2) && (blueDiff <= 1))
+                    {
+                        output.push_back(static_cast<sf::Uint8>(qoiOpDiff | ((redDiff + 2) << 4) | ((greenDiff + 2) << 2) | (blueDiff + 2)));
+                    }
+                    else if ((redGreen >= -8) && (redGreen <= 7) && (greenDiff >= -32) && (greenDiff <= 31) && (blueGreen >= -8) && (blueGreen <= 7))
+                    {
+                        output.push_back(static_cast<sf::Uint8>(qoiOpLuma | (greenDiff + 32)));
+                        output.push_back(static_cast<sf::Uint8>(((redGreen + 8) << 4) | (blueGreen + 8)));
+                    }
+                    else
+                    {
+                        output.push_back(qoiOpRgb);
+                        output.insert(output.end(), pixel, pixel + 3);
+                    }
+                }
+                else
+                {
+                    output.push_back(qoiOpRgba);
+                    output.insert(output.end(), pixel, pixel + 4);
+                }
+            }
+
+            std::memcpy(previous, pixel, 4);
+        }
+
+        // End marker
+        output.insert(output.end(), qoiPaddingSize - 1, 0);
+        output.push_back(1);
+    }
+
+#ifdef SFML_IMAGE_TURBOJPEG
+
+    // Decode a JPEG image with libjpeg-turbo, return the reason of the failure or NULL
+    const char* decodeJpeg(const sf::Uint8* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        tjhandle decompressor = tjInitDecompress();
+        if (!decompressor)
+            return "failed to initialize libjpeg-turbo";
+
+        unsigned char* buffer = const_cast<unsigned char*>(data);
+        unsigned long bufferSize = static_cast<unsigned long>(dataSize);
+        int width = 0;
+        int height = 0;
+        int subsampling = 0;
+        int colorspace = 0;
+
+        const char* reason = NULL;
+
+        if (tjDecompressHeader3(decompressor, buffer, bufferSize, &width, &height, &subsampling, &colorspace) == 0)
+        {
+            pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+            if (tjDecompress2(decompressor, buffer, bufferSize, &pixels[0], width, 0, height, TJPF_RGBA, 0) == 0)
+            {
+                size.x = static_cast<unsigned int>(width);
+                size.y = static_cast<unsigned int>(height);
+            }
+            else
+            {
+                reason = "corrupt JPEG data";
+                pixels.clear();
+            }
+        }
+        else
+        {
+            reason = "invalid JPEG header";
+        }
+
+        tjDestroy(decompressor);
+
+        return reason;
+    }
+
+    // Encode RGBA pixels as a JPEG image with libjpeg-turbo
+    bool encodeJpeg(const sf::ImageView& pixels, std::vector<sf::Uint8>& output)
+    {
+        const sf::Vector2u size = pixels.getSize();
+
+        tjhandle compressor = tjInitCompress();
+        if (!compressor)
+            return false;
+
+        unsigned char* buffer = NULL;
+        unsigned long bufferSize = 0;
+
+        bool succeeded = tjCompress2(compressor, const_cast<unsigned char*>(pixels.getPixelsPtr()), static_cast<int>(size.x), static_cast<int>(pixels.getStride()), static_cast<int>(size.y),
+                                     TJPF_RGBA, &buffer, &bufferSize, TJSAMP_420, 90, 0) == 0;
+
+        if (succeeded)
+            output.assign(buffer, buffer + bufferSize);
+
+        tjFree(buffer);
+        tjDestroy(compressor);
+
+        return succeeded;
+    }
+
+#endif // SFML_IMAGE_TURBOJPEG
+
+#ifdef SFML_IMAGE_SPNG
+
+    // Decode a PNG image with spng, return the reason of the failure or NULL
+    const char* decodePng(const sf::Uint8* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        spng_ctx* context = spng_ctx_new(0);
+        if (!context)
+            return "failed to initialize spng";
+
+        spng_ihdr header;
+        std::size_t decodedSize = 0;
+
+        int error = spng_set_png_buffer(context, data, dataSize);
+
+        if (!error)
+            error = spng_get_ihdr(context, &header);
+
+        if (!error)
+            error = spng_decoded_image_size(context, SPNG_FMT_RGBA8, &decodedSize);
+
+        if (!error)
+        {
+            pixels.resize(decodedSize);
+            error = spng_decode_image(context, &pixels[0], decodedSize, SPNG_FMT_RGBA8, SPNG_DECODE_TRNS);
+        }
+
+        spng_ctx_free(context);
+
+        if (error)
+        {
+            pixels.clear();
+            return spng_strerror(error);
+        }
+
+        size.x = header.width;
+        size.y = header.height;
+
+        return NULL;
+    }
+
+    // Encode RGBA pixels as a PNG image with spng
+    bool encodePng(const sf::Uint8* pixels, const sf::Vector2u& size, std::vector<sf::Uint8>& output)
+    {
+        spng_ctx* context = spng_ctx_new(SPNG_CTX_ENCODER);
+        if (!context)
+            return false;
+
+        spng_ihdr header;
+        std::memset(&header, 0, sizeof(header));
+        header.width      = size.x;
+        header.height     = size.y;
+        header.bit_depth  = 8;
+        header.color_type = SPNG_COLOR_TYPE_TRUECOLOR_ALPHA;
+
+        int error = spng_set_option(context, SPNG_ENCODE_TO_BUFFER, 1);
+
+        if (!error)
+            error = spng_set_ihdr(context, &header);
+
+        if (!error)
+            error = spng_encode_image(context, pixels, static_cast<std::size_t>(size.x) * size.y * 4, SPNG_FMT_PNG, SPNG_ENCODE_FINALIZE);
+
+        if (!error)
+        {
+            std::size_t bufferSize = 0;
+            void* buffer = spng_get_png_buffer(context, &bufferSize, &error);
+
+            if (buffer)
+            {
+                const sf::Uint8* bytes = static_cast<const sf::Uint8*>(buffer);
+                output.assign(bytes, bytes + bufferSize);
+                std::free(buffer);
+            }
+        }
+
+        spng_ctx_free(context);
+
+        return !error;
+    }
+
+#endif // SFML_IMAGE_SPNG
+
+    // Tell whether an image has a dedicated decoder, rather than stb_image
+    bool hasDedicatedDecoder(const sf::Uint8* data, std::size_t dataSize)
+    {
+        if (hasSignature(data, dataSize, qoiSignature, sizeof(qoiSignature)))
+            return true;
+
+#ifdef SFML_IMAGE_TURBOJPEG
+        if (hasSignature(data, dataSize, jpegSignature, sizeof(jpegSignature)))
+            return true;
+#endif
+
+#ifdef SFML_IMAGE_SPNG
+        if (hasSignature(data, dataSize, pngSignature, sizeof(pngSignature)))
+            return true;
+#endif
+
+        return false;
+    }
+
+    // Decode an image with its dedicated decoder, return the reason of the failure or NULL
+    const char* decodeDedicated(const sf::Uint8* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        if (hasSignature(data, dataSize, qoiSignature, sizeof(qoiSignature)))
+            return decodeQoi(data, dataSize, pixels, size);
+
+#ifdef SFML_IMAGE_TURBOJPEG
+        if (hasSignature(data, dataSize, jpegSignature, sizeof(jpegSignature)))
+            return decodeJpeg(data, dataSize, pixels, size);
+#endif
+
+#ifdef SFML_IMAGE_SPNG
+        if (hasSignature(data, dataSize, pngSignature, sizeof(pngSignature)))
+            return decodePng(data, dataSize, pixels, size);
+#endif
+
+        return "unknown image format";
+    }
+
+    // Write an encoded image to a file
+    bool writeFile(const std::string& filename, const std::vector<sf::Uint8>& data)
+    {
+        std::ofstream file(filename.c_str(), std::ios_base::binary);
+
+        if (!file || data.empty())
+            return false;
+
+        file.write(reinterpret_cast<const char*>(&data[0]), static_cast<std::streamsize>(data.size()));
+
+        return static_cast<bool>(file);
+    }
+
+    // stb_image_write callback that appends the encoded data to an array
+    void appendToArray(void* context, void* data, int size)
+    {
+        std::vector<sf::Uint8>* output = static_cast<std::vector<sf::Uint8>*>(context);
+        const sf::Uint8* bytes = static_cast<const sf::Uint8*>(data);
+        output->insert(output->end(), bytes, bytes + size);
+    }
+
+    // Gather the rows of a view in a single array, for the encoders that can't skip padding
+    const sf::Uint8* getContiguousPixels(const sf::ImageView& pixels, std::vector<sf::Uint8>& buffer)
+    {
+        if (pixels.isContiguous())
+            return pixels.getPixelsPtr();
+
+        const std::size_t rowSize = pixels.getSize().x * 4;
+        buffer.resize(rowSize * pixels.getSize().y);
+
+        for (unsigned int y = 0; y < pixels.getSize().y; ++y)
+            std::memcpy(&buffer[y * rowSize], pixels.getPixelsPtr() + y * pixels.getStride(), rowSize);
+
+        return &buffer[0];
+    }
+
+    // Encode RGBA pixels in the format matching a file extension
+    bool encodeImage(const std::string& format, const sf::ImageView& pixels, std::vector<sf::Uint8>& output)
+    {
+        const sf::Vector2u size = pixels.getSize();
+
+        // Make sure the image is not empty
+        if (!pixels.getPixelsPtr() || (size.x == 0) || (size.y == 0))
+            return false;
+
+        const std::string extension = toLower(format);
+        const int width = static_cast<int>(size.x);
+        const int height = static_cast<int>(size.y);
+
+        std::vector<sf::Uint8> buffer;
+
+        if (extension == "qoi")
+        {
+            // QOI format
+            encodeQoi(pixels, output);
+            return true;
+        }
+        else if (extension == "bmp")
+        {
+            // BMP format
+            return stbi_write_bmp_to_func(&appendToArray, &output, width, height, 4, getContiguousPixels(pixels, buffer)) != 0;
+        }
+        else if (extension == "tga")
+        {
+            // TGA format
+            return stbi_write_tga_to_func(&appendToArray, &output, width, height, 4, getContiguousPixels(pixels, buffer)) != 0;
+        }
+        else if (extension == "png")
+        {
+            // PNG format
+#ifdef SFML_IMAGE_SPNG
+            return encodePng(getContiguousPixels(pixels, buffer), size, output);
+#else
+            return stbi_write_png_to_func(&appendToArray, &output, width, height, 4, pixels.getPixelsPtr(), static_cast<int>(pixels.getStride())) != 0;
+#endif
+        }
+        else if (extension == "jpg" || extension == "jpeg")
+        {
+            // JPG format
+#ifdef SFML_IMAGE_TURBOJPEG
+            return encodeJpeg(pixels, output);
+#else
+            return stbi_write_jpg_to_func(&appendToArray, &output, width, height, 4, getContiguousPixels(pixels, buffer), 90) != 0;
+#endif
+        }
+
+        return false;
+    }
 }
 
 
@@ -97,11 +916,34 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
+    // Load the image and get a pointer to the pixels in memory,
+    // decoding straight from the mapped file when it can be mapped
     int width = 0;
     int height = 0;
     int channels = 0;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    unsigned char* ptr = NULL;
+
+    MappedFileInputStream file;
+    if (file.open(filename) && file.getData() && (file.getSize() <= std::numeric_limits<int>::max()))
+    {
+        const unsigned char* buffer = static_cast<const unsigned char*>(file.getData());
+        std::size_t bufferSize = static_cast<std::size_t>(file.getSize());
+
+        if (hasDedicatedDecoder(buffer, bufferSize))
+        {
+            const char* reason = decodeDedicated(buffer, bufferSize, pixels, size);
+            if (reason)
+                err() << "Failed to load image \"" << filename << "\". Reason: " << reason << std::endl;
+
+            return !reason;
+        }
+
+        ptr = stbi_load_from_memory(buffer, static_cast<int>(bufferSize), &width, &height, &channels, STBI_rgb_alpha);
+    }
+    else
+    {
+        ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    }
 
     if (ptr)
     {
@@ -140,11 +982,21 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
         // Clear the array (just in case)
         pixels.clear();
 
+        const unsigned char* buffer = static_cast<const unsigned char*>(data);
+
+        if (hasDedicatedDecoder(buffer, dataSize))
+        {
+            const char* reason = decodeDedicated(buffer, dataSize, pixels, size);
+            if (reason)
+                err() << "Failed to load image from memory. Reason: " << reason << std::endl;
+
+            return !reason;
+        }
+
         // Load the image and get a pointer to the pixels in memory
         int width = 0;
         int height = 0;
         int channels = 0;
-        const unsigned char* buffer = static_cast<const unsigned char*>(data);
         unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
 
         if (ptr)
@@ -187,6 +1039,31 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     // Clear the array (just in case)
     pixels.clear();
 
+    // Formats with a dedicated decoder are decoded from memory, read the whole stream for them
+    // (8 bytes are enough for the longest signature, the one of PNG)
+    Uint8 signature[8];
+
+    stream.seek(0);
+    Int64 signatureSize = stream.read(signature, sizeof(signature));
+
+    if ((signatureSize > 0) && hasDedicatedDecoder(signature, static_cast<std::size_t>(signatureSize)))
+    {
+        std::vector<Uint8> data(static_cast<std::size_t>(std::max(stream.getSize(), static_cast<Int64>(0))));
+
+        stream.seek(0);
+        if (data.empty() || (stream.read(&data[0], static_cast<Int64>(data.size())) != static_cast<Int64>(data.size())))
+        {
+            err() << "Failed to load image from stream, reading failed" << std::endl;
+            return false;
+        }
+
+        const char* reason = decodeDedicated(&data[0], data.size(), pixels, size);
+        if (reason)
+            err() << "Failed to load image from stream. Reason: " << reason << std::endl;
+
+        return !reason;
+    }
+
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
 
@@ -231,47 +1108,115 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::isCompressedImage(const void* data, std::size_t dataSize)
 {
-    // Make sure the image is not empty
-    if (!pixels.empty() && (size.x > 0) && (size.y > 0))
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    return bytes && (hasSignature(bytes, dataSize, ddsSignature, sizeof(ddsSignature)) ||
+                     hasSignature(bytes, dataSize, ktxSignature, sizeof(ktxSignature)));
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::isCompressedImage(InputStream& stream)
+{
+    Uint8 signature[sizeof(ktxSignature)];
+
+    // Read the beginning of the stream, and rewind it for the actual loader
+    stream.seek(0);
+    Int64 read = stream.read(signature, sizeof(signature));
+    stream.seek(0);
+
+    return (read > 0) && isCompressedImage(signature, static_cast<std::size_t>(read));
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadCompressedImageFromMemory(const void* data, std::size_t dataSize, CompressedImage& image)
+{
+    // Clear the levels (just in case)
+    image.levels.clear();
+
+    if (!data || !dataSize)
     {
-        // Deduce the image type from its extension
+        err() << "Failed to load compressed image from memory, no data provided" << std::endl;
+        return false;
+    }
 
-        // Extract the extension
-        const std::size_t dot = filename.find_last_of('.');
-        const std::string extension = dot != std::string::npos ? toLower(filename.substr(dot + 1)) : "";
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    const char* reason = "unknown container";
 
-        if (extension == "bmp")
-        {
-            // BMP format
-            if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
-                return true;
-        }
-        else if (extension == "tga")
-        {
-            // TGA format
-            if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
-                return true;
-        }
-        else if (extension == "png")
-        {
-            // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
-                return true;
-        }
-        else if (extension == "jpg" || extension == "jpeg")
-        {
-            // JPG format
-            if (stbi_write_jpg(filename.c_str(), size.x, size.y, 4, &pixels[0], 90))
-                return true;
-        }
+    if (hasSignature(bytes, dataSize, ddsSignature, sizeof(ddsSignature)))
+        reason = parseDds(bytes, dataSize, image);
+    else if (hasSignature(bytes, dataSize, ktxSignature, sizeof(ktxSignature)))
+        reason = parseKtx(bytes, dataSize, image);
+
+    if (reason)
+    {
+        err() << "Failed to load compressed image. Reason: " << reason << std::endl;
+        image.levels.clear();
+
+        return false;
     }
 
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadCompressedImageFromStream(InputStream& stream, CompressedImage& image)
+{
+    // Containers are parsed from memory, read the whole stream at once
+    Int64 size = stream.getSize();
+
+    if (size <= 0)
+    {
+        err() << "Failed to load compressed image from stream, the stream is empty" << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> data(static_cast<std::size_t>(size));
+
+    stream.seek(0);
+    if (stream.read(&data[0], size) != size)
+    {
+        err() << "Failed to load compressed image from stream, reading failed" << std::endl;
+        return false;
+    }
+
+    return loadCompressedImageFromMemory(&data[0], data.size(), image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToFile(const std::string& filename, const ImageView& pixels)
+{
+    // Deduce the image type from its extension
+    const std::size_t dot = filename.find_last_of('.');
+    const std::string extension = dot != std::string::npos ? filename.substr(dot + 1) : "";
+
+    std::vector<Uint8> encoded;
+    if (encodeImage(extension, pixels, encoded) && writeFile(filename, encoded))
+        return true;
+
     err() << "Failed to save image \"" << filename << "\"" << std::endl;
     return false;
 }
 
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::saveImageToMemory(const std::string& format, const ImageView& pixels, std::vector<Uint8>& output)
+{
+    output.clear();
+
+    if (encodeImage(format, pixels, output))
+        return true;
+
+    err() << "Failed to save image to memory with format \"" << format << "\"" << std::endl;
+    output.clear();
+    return false;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -36,10 +36,37 @@
 
 namespace sf
 {
+class ImageView;
 class InputStream;
 
 namespace priv
 {
+////////////////////////////////////////////////////////////
+/// \brief Pre-compressed image, as stored in a DDS or KTX file
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Families of compressed formats
+    ///
+    /// Each family is exposed by a different OpenGL extension.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Family
+    {
+        S3tc, ///< BC1, BC2 and BC3 (DXT1, DXT3 and DXT5)
+        Bptc, ///< BC7
+        Etc2, ///< ETC2 and EAC
+        Astc  ///< ASTC, low dynamic range profile
+    };
+
+    unsigned int                     format; ///< OpenGL internal format of the compressed data
+    Family                           family; ///< Family of the format
+    Vector2u                         size;   ///< Size of the base level, in pixels
+    std::vector<std::vector<Uint8> > levels; ///< Compressed data of each mipmap level, starting with the base level
+};
+
 ////////////////////////////////////////////////////////////
 /// \brief Load/save image files
 ///
@@ -94,16 +121,79 @@ public:
     bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Save an array of pixels as an image file
+    /// \brief Tell whether a file in memory is a pre-compressed image container
+    ///
+    /// Only the signature of the file is checked.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data, in bytes
+    ///
+    /// \return True if the data starts like a DDS or KTX file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCompressedImage(const void* data, std::size_t dataSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a stream contains a pre-compressed image container
+    ///
+    /// Only the signature of the file is checked, the stream is
+    /// rewound afterwards.
+    ///
+    /// \param stream Source stream to check
+    ///
+    /// \return True if the stream starts like a DDS or KTX file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCompressedImage(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a pre-compressed image from a DDS or KTX file in memory
+    ///
+    /// The compressed data is kept as it is, including its
+    /// mipmap chain, so that it can be uploaded directly.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param image    Compressed image to fill
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressedImageFromMemory(const void* data, std::size_t dataSize, CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a pre-compressed image from a DDS or KTX custom stream
+    ///
+    /// \param stream Source stream to read from
+    /// \param image  Compressed image to fill
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadCompressedImageFromStream(InputStream& stream, CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save a view of pixels as an image file
     ///
     /// \param filename Path of image file to save
-    /// \param pixels   Array of pixels to save to image
-    /// \param size     Size of image to save, in pixels
+    /// \param pixels   View of the pixels to save to image
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveImageToFile(const std::string& filename, const ImageView& pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a view of pixels as an image file in memory
+    ///
+    /// \param format Format of the image, given as a file extension (png, jpg, ...)
+    /// \param pixels View of the pixels to save to image
+    /// \param output Array receiving the encoded file
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToMemory(const std::string& format, const ImageView& pixels, std::vector<Uint8>& output);
 
 private:
 
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageView::ImageView() :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image) :
+m_pixels(image.getPixelsPtr()),
+m_size  (image.getSize()),
+m_stride(image.getSize().x * 4)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image, const IntRect& area) :
+m_pixels(image.getPixelsPtr()),
+m_size  (image.getSize()),
+m_stride(image.getSize().x * 4)
+{
+    clip(area);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Uint8* pixels, const Vector2u& size, std::size_t stride) :
+m_pixels(pixels),
+m_size  (size),
+m_stride(stride ? stride : size.x * 4)
+{
+    if (!m_pixels)
+        m_size = Vector2u(0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView ImageView::getSubView(const IntRect& area) const
+{
+    ImageView view(*this);
+
+    // An empty area would view everything, which is not what is asked here
+    if ((area.width <= 0) || (area.height <= 0))
+        return ImageView();
+
+    view.clip(area);
+
+    return view;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ImageView::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageView::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::isContiguous() const
+{
+    return (m_stride == m_size.x * 4) || (m_size.y <= 1);
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getPixelsPtr() const
+{
+    return m_pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+Color ImageView::getPixel(unsigned int x, unsigned int y) const
+{
+    const Uint8* pixel = m_pixels + y * m_stride + x * 4;
+
+    return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::saveToFile(const std::string& filename) const
+{
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, *this);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageView::saveToMemory(std::vector<Uint8>& output, const std::string& format) const
+{
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, *this, output);
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageView::clip(const IntRect& area)
+{
+    int width  = static_cast<int>(m_size.x);
+    int height = static_cast<int>(m_size.y);
+
+    // View everything if the area is empty or contains the whole view
+    if ((area.width == 0) || (area.height == 0) ||
+       ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
+        return;
+
+    // Adjust the rectangle to the size of the view
+    IntRect rectangle = area;
+    if (rectangle.left < 0) rectangle.left = 0;
+    if (rectangle.top  < 0) rectangle.top  = 0;
+    if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
+    if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
+
+    if ((rectangle.width <= 0) || (rectangle.height <= 0))
+    {
+        m_pixels = NULL;
+        m_size = Vector2u(0, 0);
+        return;
+    }
+
+    m_pixels += rectangle.top * m_stride + rectangle.left * 4;
+    m_size = Vector2u(static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height));
+}
+
+} // namespace sf
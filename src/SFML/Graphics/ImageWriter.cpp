@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageWriter.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct ImageWriter::Job
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the pixels, and write them if a file is requested
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        priv::ImageLoader& loader = priv::ImageLoader::getInstance();
+        ImageView view(pixels.empty() ? NULL : &pixels[0], size);
+
+        if (filename.empty())
+            succeeded = loader.saveImageToMemory(format, view, output);
+        else
+            succeeded = loader.saveImageToFile(filename, view);
+
+        // The pixels are not needed anymore, release them as soon as possible
+        std::vector<Uint8>().swap(pixels);
+    }
+
+    std::vector<Uint8> pixels;    ///< Pixels taken from the image
+    Vector2u           size;      ///< Size of the image
+    std::string        filename;  ///< File to write, empty to keep the data in memory
+    std::string        format;    ///< Format of the data kept in memory
+    std::vector<Uint8> output;    ///< Encoded data, for saves to memory
+    bool               succeeded; ///< Was the image saved?
+    ThreadPool::Task   task;      ///< Task of the pool encoding the image
+};
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::ImageWriter(ThreadPool& pool) :
+m_pool      (pool),
+m_jobs      (),
+m_released  (),
+m_nextHandle(1)
+{
+    // Construct the loader here rather than concurrently in the pool
+    priv::ImageLoader::getInstance();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::~ImageWriter()
+{
+    for (JobTable::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it)
+    {
+        m_pool.wait(it->second->task);
+        delete it->second;
+    }
+
+    for (std::vector<Job*>::iterator it = m_released.begin(); it != m_released.end(); ++it)
+    {
+        m_pool.wait((*it)->task);
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::Handle ImageWriter::saveToFile(Image& image, const std::string& filename)
+{
+    return push(image, filename, "");
+}
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::Handle ImageWriter::saveToMemory(Image& image, const std::string& format)
+{
+    return push(image, "", format);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::Status ImageWriter::getStatus(Handle handle) const
+{
+    JobTable::const_iterator it = m_jobs.find(handle);
+    if (it == m_jobs.end())
+        return Failed;
+
+    const Job& job = *it->second;
+    if (!job.task.isDone())
+        return Encoding;
+
+    return job.succeeded ? Done : Failed;
+}
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::Status ImageWriter::wait(Handle handle)
+{
+    JobTable::iterator it = m_jobs.find(handle);
+    if (it == m_jobs.end())
+        return Failed;
+
+    m_pool.wait(it->second->task);
+
+    return it->second->succeeded ? Done : Failed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageWriter::takeData(Handle handle, std::vector<Uint8>& data)
+{
+    if (getStatus(handle) != Done)
+        return false;
+
+    JobTable::iterator it = m_jobs.find(handle);
+    data.swap(it->second->output);
+
+    delete it->second;
+    m_jobs.erase(it);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageWriter::release(Handle handle)
+{
+    JobTable::iterator it = m_jobs.find(handle);
+    if (it == m_jobs.end())
+        return;
+
+    // A job still running in the pool is deleted once it is done
+    if (it->second->task.isDone())
+        delete it->second;
+    else
+        m_released.push_back(it->second);
+
+    m_jobs.erase(it);
+
+    collectReleased();
+}
+
+
+////////////////////////////////////////////////////////////
+ImageWriter::Handle ImageWriter::push(Image& image, const std::string& filename, const std::string& format)
+{
+    collectReleased();
+
+    Job* job = new Job;
+    job->pixels.swap(image.m_pixels);
+    job->size      = image.m_size;
+    job->filename  = filename;
+    job->format    = format;
+    job->succeeded = false;
+
+    image.m_size = Vector2u(0, 0);
+
+    job->task = m_pool.push(&Job::run, job);
+
+    Handle handle = m_nextHandle++;
+    m_jobs.insert(std::make_pair(handle, job));
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageWriter::collectReleased()
+{
+    std::vector<Job*>::iterator it = m_released.begin();
+    while (it != m_released.end())
+    {
+        if ((*it)->task.isDone())
+        {
+            delete *it;
+            it = m_released.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Node.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <utility>
+
+
+namespace
+{
+    // Below this number of nodes, updating in parallel costs more than it saves
+    const std::size_t parallelThreshold = 4096;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+// Job updating the subtrees of a range of children of a node
+struct Node::RangeUpdater
+{
+    explicit RangeUpdater(const Node* root) : m_root(root) {}
+
+    void operator()(std::size_t begin, std::size_t end) const
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::size_t offset = m_root->m_childOffsets[i];
+            m_root->updateRange(offset, m_root->m_order[offset].end);
+        }
+    }
+
+    const Node* m_root;
+};
+
+
+////////////////////////////////////////////////////////////
+Node::Node() :
+m_parent         (NULL),
+m_children       (),
+m_threadPool     (NULL),
+m_worldTransform (),
+m_worldVersion   (0),
+m_localVersion   (0),
+m_parentVersion  (0),
+m_worldNeedUpdate(true),
+m_order          (),
+m_childOffsets   (),
+m_orderNeedUpdate(true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Node::~Node()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    for (std::vector<Node*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+    {
+        (*it)->m_parent = NULL;
+        (*it)->m_worldNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::attachChild(Node& child)
+{
+    // Refuse to create cycles
+    for (const Node* node = this; node; node = node->m_parent)
+    {
+        if (node == &child)
+        {
+            err() << "Failed to attach a node to itself or to one of its descendants" << std::endl;
+            return;
+        }
+    }
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    m_children.push_back(&child);
+    child.m_parent = this;
+    child.m_worldNeedUpdate = true;
+    invalidateOrder();
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::detachChild(Node& child)
+{
+    std::vector<Node*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+    child.m_worldNeedUpdate = true;
+    invalidateOrder();
+}
+
+
+////////////////////////////////////////////////////////////
+Node* Node::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Node::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Node& Node::getChild(std::size_t index) const
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& Node::getWorldTransform() const
+{
+    if (m_parent)
+        m_parent->getWorldTransform();
+
+    refreshWorldTransform();
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::updateWorldTransforms() const
+{
+    updateOrder();
+
+    // The ancestors are outside of the flattened order, bring them up to date first
+    getWorldTransform();
+
+    if (m_threadPool && (m_order.size() >= parallelThreshold) && (m_childOffsets.size() > 1))
+        m_threadPool->parallelFor(m_childOffsets.size(), RangeUpdater(this), 1);
+    else
+        updateRange(1, m_order.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::setThreadPool(ThreadPool* pool)
+{
+    m_threadPool = pool;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::drawSelf(RenderTarget&, const RenderStates&) const
+{
+    // Nothing to draw by default
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::draw(RenderTarget& target, RenderStates states) const
+{
+    updateWorldTransforms();
+
+    RenderStates nodeStates(states);
+    for (std::vector<Entry>::const_iterator it = m_order.begin(); it != m_order.end(); ++it)
+    {
+        nodeStates.transform = states.transform * it->node->m_worldTransform;
+        it->node->drawSelf(target, nodeStates);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::refreshWorldTransform() const
+{
+    Uint32 parentVersion = m_parent ? m_parent->m_worldVersion : 0;
+
+    if (m_worldNeedUpdate || (m_localVersion != m_transformVersion) || (m_parentVersion != parentVersion))
+    {
+        if (m_parent)
+            m_worldTransform = m_parent->m_worldTransform * getTransform();
+        else
+            m_worldTransform = getTransform();
+
+        m_localVersion = m_transformVersion;
+        m_parentVersion = parentVersion;
+        m_worldNeedUpdate = false;
+        ++m_worldVersion;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::updateRange(std::size_t begin, std::size_t end) const
+{
+    // Parents come before their children, so their world transforms are always up to date
+    for (std::size_t i = begin; i < end; ++i)
+        m_order[i].node->refreshWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::updateOrder() const
+{
+    if (!m_orderNeedUpdate)
+        return;
+
+    m_order.clear();
+    m_childOffsets.clear();
+
+    // Depth-first walk, the stack holding the index in m_order of the open nodes and of their next child
+    Entry root = {this, 0};
+    m_order.push_back(root);
+    std::vector<std::pair<std::size_t, std::size_t> > stack(1, std::make_pair(0, 0));
+    while (!stack.empty())
+    {
+        std::size_t index = stack.back().first;
+        std::size_t childIndex = stack.back().second;
+        const Node* node = m_order[index].node;
+
+        if (childIndex < node->m_children.size())
+        {
+            ++stack.back().second;
+
+            if (stack.size() == 1)
+                m_childOffsets.push_back(m_order.size());
+
+            Entry entry = {node->m_children[childIndex], 0};
+            m_order.push_back(entry);
+            stack.push_back(std::make_pair(m_order.size() - 1, 0));
+        }
+        else
+        {
+            m_order[index].end = m_order.size();
+            stack.pop_back();
+        }
+    }
+
+    m_orderNeedUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Node::invalidateOrder()
+{
+    for (Node* node = this; node; node = node->m_parent)
+        node->m_orderNeedUpdate = true;
+}
+
+} // namespace sf
@@ -0,0 +1,411 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/Cpu.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Below this number of particles, splitting the work costs more than it saves
+    const std::size_t parallelThreshold = 16384;
+    const std::size_t parallelBlockSize = 8192;
+
+    // Advances the particles [begin, end) by one time step
+    struct Integrator
+    {
+        float* positionsX;
+        float* positionsY;
+        float* velocitiesX;
+        float* velocitiesY;
+        float* lifetimes;
+        float  delta;
+        float  accelerationX;
+        float  accelerationY;
+
+        void operator()(std::size_t begin, std::size_t end) const
+        {
+            // Semi-implicit Euler: velocities first, then positions with the new velocities
+            const float deltaX = accelerationX * delta;
+            const float deltaY = accelerationY * delta;
+            std::size_t i = begin;
+
+#if defined(SFML_CPU_SSE2)
+
+            const __m128 dt = _mm_set1_ps(delta);
+            const __m128 dvx = _mm_set1_ps(deltaX);
+            const __m128 dvy = _mm_set1_ps(deltaY);
+
+            for (; i + 4 <= end; i += 4)
+            {
+                __m128 vx = _mm_add_ps(_mm_loadu_ps(velocitiesX + i), dvx);
+                __m128 vy = _mm_add_ps(_mm_loadu_ps(velocitiesY + i), dvy);
+
+                _mm_storeu_ps(velocitiesX + i, vx);
+                _mm_storeu_ps(velocitiesY + i, vy);
+                _mm_storeu_ps(positionsX + i, _mm_add_ps(_mm_loadu_ps(positionsX + i), _mm_mul_ps(vx, dt)));
+                _mm_storeu_ps(positionsY + i, _mm_add_ps(_mm_loadu_ps(positionsY + i), _mm_mul_ps(vy, dt)));
+                _mm_storeu_ps(lifetimes + i, _mm_sub_ps(_mm_loadu_ps(lifetimes + i), dt));
+            }
+
+#elif defined(SFML_CPU_NEON)
+
+            const float32x4_t dt = vdupq_n_f32(delta);
+            const float32x4_t dvx = vdupq_n_f32(deltaX);
+            const float32x4_t dvy = vdupq_n_f32(deltaY);
+
+            for (; i + 4 <= end; i += 4)
+            {
+                float32x4_t vx = vaddq_f32(vld1q_f32(velocitiesX + i), dvx);
+                float32x4_t vy = vaddq_f32(vld1q_f32(velocitiesY + i), dvy);
+
+                vst1q_f32(velocitiesX + i, vx);
+                vst1q_f32(velocitiesY + i, vy);
+                vst1q_f32(positionsX + i, vaddq_f32(vld1q_f32(positionsX + i), vmulq_f32(vx, dt)));
+                vst1q_f32(positionsY + i, vaddq_f32(vld1q_f32(positionsY + i), vmulq_f32(vy, dt)));
+                vst1q_f32(lifetimes + i, vsubq_f32(vld1q_f32(lifetimes + i), dt));
+            }
+
+#endif
+
+            for (; i < end; ++i)
+            {
+                velocitiesX[i] += deltaX;
+                velocitiesY[i] += deltaY;
+                positionsX[i] += velocitiesX[i] * delta;
+                positionsY[i] += velocitiesY[i] * delta;
+                lifetimes[i] -= delta;
+            }
+        }
+    };
+
+    // Writes the two triangles of the particles [begin, end)
+    struct QuadBuilder
+    {
+        const float*     positionsX;
+        const float*     positionsY;
+        const float*     lifetimes;
+        const float*     durations;
+        const sf::Color* colors;
+        sf::Vertex*      vertices;
+        sf::Vector2f     halfSize;
+        sf::FloatRect    texCoords;
+        bool             fading;
+
+        void operator()(std::size_t begin, std::size_t end) const
+        {
+            const float u0 = texCoords.left;
+            const float v0 = texCoords.top;
+            const float u1 = texCoords.left + texCoords.width;
+            const float v1 = texCoords.top + texCoords.height;
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                float left   = positionsX[i] - halfSize.x;
+                float right  = positionsX[i] + halfSize.x;
+                float top    = positionsY[i] - halfSize.y;
+                float bottom = positionsY[i] + halfSize.y;
+
+                sf::Color color = colors[i];
+                if (fading)
+                    color.a = static_cast<sf::Uint8>(color.a * std::min(std::max(lifetimes[i] / durations[i], 0.f), 1.f));
+
+                sf::Vertex* quad = vertices + i * 6;
+                quad[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u0, v0));
+                quad[1] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u1, v0));
+                quad[2] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u0, v1));
+                quad[3] = quad[2];
+                quad[4] = quad[1];
+                quad[5] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u1, v1));
+            }
+        }
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_positionsX  (),
+m_positionsY  (),
+m_velocitiesX (),
+m_velocitiesY (),
+m_lifetimes   (),
+m_durations   (),
+m_colors      (),
+m_count       (0),
+m_acceleration(0, 0),
+m_particleSize(1, 1),
+m_texture     (NULL),
+m_textureRect (),
+m_fading      (false),
+m_threadPool  (NULL),
+m_vertices    (),
+m_vertexCount (0),
+m_buffer      (Triangles, VertexBuffer::Stream),
+m_needsUpload (false),
+m_uploaded    (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setCapacity(std::size_t capacity)
+{
+    m_positionsX.resize(capacity);
+    m_positionsY.resize(capacity);
+    m_velocitiesX.resize(capacity);
+    m_velocitiesY.resize(capacity);
+    m_lifetimes.resize(capacity);
+    m_durations.resize(capacity);
+    m_colors.resize(capacity);
+    m_vertices.resize(capacity * 6);
+
+    // Dropped particles are the last ones, so the geometry of the others stays valid
+    m_count = std::min(m_count, capacity);
+    m_vertexCount = std::min(m_vertexCount, capacity * 6);
+    m_needsUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getCapacity() const
+{
+    return m_positionsX.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::emit(const Vector2f& position, const Vector2f& velocity, const Color& color, Time lifetime)
+{
+    if ((m_count >= m_positionsX.size()) || (lifetime <= Time::Zero))
+        return false;
+
+    m_positionsX[m_count]  = position.x;
+    m_positionsY[m_count]  = position.y;
+    m_velocitiesX[m_count] = velocity.x;
+    m_velocitiesY[m_count] = velocity.y;
+    m_lifetimes[m_count]   = lifetime.asSeconds();
+    m_durations[m_count]   = lifetime.asSeconds();
+    m_colors[m_count]      = color;
+    ++m_count;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_count = 0;
+    m_vertexCount = 0;
+    m_needsUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    if (m_count > 0)
+    {
+        Integrator integrator = {&m_positionsX[0], &m_positionsY[0], &m_velocitiesX[0], &m_velocitiesY[0], &m_lifetimes[0],
+                                 elapsed.asSeconds(), m_acceleration.x, m_acceleration.y};
+
+        if (m_threadPool && (m_count >= parallelThreshold))
+            m_threadPool->parallelFor(m_count, integrator, parallelBlockSize);
+        else
+            integrator(0, m_count);
+
+        removeDeadParticles();
+    }
+
+    m_vertexCount = m_count * 6;
+    m_needsUpload = true;
+
+    if (m_count == 0)
+        return;
+
+    // Texture coordinates are in pixels, like the ones of sprites
+    FloatRect texCoords(static_cast<float>(m_textureRect.left), static_cast<float>(m_textureRect.top),
+                        static_cast<float>(m_textureRect.width), static_cast<float>(m_textureRect.height));
+
+    QuadBuilder builder = {&m_positionsX[0], &m_positionsY[0], &m_lifetimes[0], &m_durations[0], &m_colors[0], &m_vertices[0],
+                           m_particleSize / 2.f, texCoords, m_fading};
+
+    if (m_threadPool && (m_count >= parallelThreshold))
+        m_threadPool->parallelFor(m_count, builder, parallelBlockSize);
+    else
+        builder(0, m_count);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setAcceleration(const Vector2f& acceleration)
+{
+    m_acceleration = acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getAcceleration() const
+{
+    return m_acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleSize(const Vector2f& size)
+{
+    m_particleSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getParticleSize() const
+{
+    return m_particleSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (texture && (resetRect || (!m_texture && (m_textureRect == IntRect()))))
+        m_textureRect = IntRect(0, 0, texture->getSize().x, texture->getSize().y);
+
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTextureRect(const IntRect& rectangle)
+{
+    m_textureRect = rectangle;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& ParticleSystem::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setFading(bool fading)
+{
+    m_fading = fading;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::isFading() const
+{
+    return m_fading;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setThreadPool(ThreadPool* pool)
+{
+    m_threadPool = pool;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_vertexCount)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // VertexBuffer::update() orphans the storage whenever the geometry grows
+    if (m_needsUpload)
+    {
+        m_uploaded = VertexBuffer::isAvailable() &&
+                     (m_buffer.getNativeHandle() || m_buffer.create(m_vertexCount)) &&
+                     m_buffer.update(&m_vertices[0], m_vertexCount, 0);
+
+        m_needsUpload = false;
+    }
+
+    // Fall back to drawing from memory if the geometry couldn't be uploaded
+    if (m_uploaded)
+        target.draw(m_buffer, 0, m_vertexCount, states);
+    else
+        target.draw(&m_vertices[0], m_vertexCount, Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeDeadParticles()
+{
+    std::size_t i = 0;
+    while (i < m_count)
+    {
+        if (m_lifetimes[i] > 0.f)
+        {
+            ++i;
+            continue;
+        }
+
+        // Move the last particle into the free slot, and check it in turn
+        --m_count;
+        m_positionsX[i]  = m_positionsX[m_count];
+        m_positionsY[i]  = m_positionsY[m_count];
+        m_velocitiesX[i] = m_velocitiesX[m_count];
+        m_velocitiesY[i] = m_velocitiesY[m_count];
+        m_lifetimes[i]   = m_lifetimes[m_count];
+        m_durations[i]   = m_durations[m_count];
+        m_colors[i]      = m_colors[m_count];
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,723 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Path.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    const float pi = 3.141592654f;
+
+    // Maximum number of segments a single curve, arc or disc is split into
+    const unsigned int maxSubdivisions = 512;
+
+    // Compute the length of a vector
+    float length(const sf::Vector2f& vector)
+    {
+        return std::sqrt(vector.x * vector.x + vector.y * vector.y);
+    }
+
+    // Compute a unit vector with the same direction, or a null vector
+    sf::Vector2f normalize(const sf::Vector2f& vector)
+    {
+        float len = length(vector);
+        return (len != 0.f) ? vector / len : sf::Vector2f();
+    }
+
+    // Compute the cross product of two vectors
+    float crossProduct(const sf::Vector2f& v1, const sf::Vector2f& v2)
+    {
+        return v1.x * v2.y - v1.y * v2.x;
+    }
+
+    // Compute the dot product of two vectors
+    float dotProduct(const sf::Vector2f& v1, const sf::Vector2f& v2)
+    {
+        return v1.x * v2.x + v1.y * v2.y;
+    }
+
+    // Compute the number of segments needed to flatten a Bezier curve (Wang's formula)
+    unsigned int getSubdivisions(float factor, float maxSecondDifference, float tolerance)
+    {
+        float count = std::ceil(std::sqrt(factor * maxSecondDifference / tolerance));
+        return static_cast<unsigned int>(std::max(1.f, std::min(count, static_cast<float>(maxSubdivisions))));
+    }
+
+    // Compute the number of segments needed to flatten a circular arc
+    unsigned int getSubdivisions(float radius, float angle, float tolerance, unsigned int minimum)
+    {
+        float step = (tolerance < radius) ? 2.f * std::acos(1.f - tolerance / radius) : pi / 2.f;
+        float count = std::ceil(std::fabs(angle) / step);
+        return static_cast<unsigned int>(std::max(static_cast<float>(minimum), std::min(count, static_cast<float>(maxSubdivisions))));
+    }
+
+    // Rotate a vector by an angle, in radians
+    sf::Vector2f rotateVector(const sf::Vector2f& vector, float angle)
+    {
+        float cosine = std::cos(angle);
+        float sine = std::sin(angle);
+        return sf::Vector2f(vector.x * cosine - vector.y * sine, vector.x * sine + vector.y * cosine);
+    }
+
+    // Append a point to a polyline, unless it repeats the last one
+    void appendPoint(std::vector<sf::Vector2f>& points, const sf::Vector2f& point)
+    {
+        if (points.empty() || (points.back() != point))
+            points.push_back(point);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Path::Path() :
+m_commands    (),
+m_strokeWidth (1),
+m_strokeColor (255, 255, 255),
+m_lineJoin    (MiterJoin),
+m_lineCap     (ButtCap),
+m_miterLimit  (4),
+m_antialiasing(true),
+m_tolerance   (0.25f),
+m_vertices    (Triangles),
+m_bounds      (),
+m_pixelSize   (1),
+m_fringe      (0),
+m_needsUpdate (true),
+m_sections    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::clear()
+{
+    m_commands.clear();
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::moveTo(const Vector2f& point)
+{
+    Command command;
+    command.type = MoveTo;
+    command.points[0] = point;
+    addCommand(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::lineTo(const Vector2f& point)
+{
+    Command command;
+    command.type = LineTo;
+    command.points[0] = point;
+    addCommand(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::quadraticTo(const Vector2f& control, const Vector2f& point)
+{
+    Command command;
+    command.type = QuadraticTo;
+    command.points[0] = control;
+    command.points[1] = point;
+    addCommand(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::cubicTo(const Vector2f& control1, const Vector2f& control2, const Vector2f& point)
+{
+    Command command;
+    command.type = CubicTo;
+    command.points[0] = control1;
+    command.points[1] = control2;
+    command.points[2] = point;
+    addCommand(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::arc(const Vector2f& center, float radius, float startAngle, float endAngle)
+{
+    Command command;
+    command.type = Arc;
+    command.points[0] = center;
+    command.values[0] = radius;
+    command.values[1] = startAngle * pi / 180.f;
+    command.values[2] = endAngle * pi / 180.f;
+    addCommand(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::close()
+{
+    if (!m_commands.empty() && (m_commands.back().type != Close))
+    {
+        Command command;
+        command.type = Close;
+        addCommand(command);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setStrokeWidth(float width)
+{
+    m_strokeWidth = width;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float Path::getStrokeWidth() const
+{
+    return m_strokeWidth;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setStrokeColor(const Color& color)
+{
+    m_strokeColor = color;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& Path::getStrokeColor() const
+{
+    return m_strokeColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setLineJoin(LineJoin join)
+{
+    m_lineJoin = join;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Path::LineJoin Path::getLineJoin() const
+{
+    return m_lineJoin;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setLineCap(LineCap cap)
+{
+    m_lineCap = cap;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Path::LineCap Path::getLineCap() const
+{
+    return m_lineCap;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setMiterLimit(float limit)
+{
+    m_miterLimit = limit;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float Path::getMiterLimit() const
+{
+    return m_miterLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setAntialiasingEnabled(bool antialiasing)
+{
+    m_antialiasing = antialiasing;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Path::isAntialiasingEnabled() const
+{
+    return m_antialiasing;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::setTolerance(float tolerance)
+{
+    m_tolerance = tolerance;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float Path::getTolerance() const
+{
+    return m_tolerance;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Path::getLocalBounds() const
+{
+    ensureGeometryUpdate(m_pixelSize);
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Path::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::draw(RenderTarget& target, RenderStates states) const
+{
+    states.transform *= getTransform();
+    states.texture = NULL;
+
+    // Find out how large a pixel of the target is in local units, to
+    // flatten the curves and size the anti-aliasing fringe accordingly
+    const float* matrix = states.transform.getMatrix();
+    const View& view = target.getView();
+    Vector2u size = target.getSize();
+
+    float scaleX = view.getViewport().width * size.x / view.getSize().x;
+    float scaleY = view.getViewport().height * size.y / view.getSize().y;
+    float pixelsPerUnit = std::sqrt(std::fabs(scaleX * scaleY * (matrix[0] * matrix[5] - matrix[1] * matrix[4])));
+
+    bool validScale = (pixelsPerUnit > 0.f) && (pixelsPerUnit < 1e30f);
+    ensureGeometryUpdate(validScale ? 1.f / pixelsPerUnit : m_pixelSize);
+
+    target.draw(m_vertices, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Path::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::addCommand(const Command& command)
+{
+    // Like in most vector APIs, a path without a current point starts
+    // where its first element starts
+    if (m_commands.empty() && (command.type != MoveTo) && (command.type != Arc))
+    {
+        Command start;
+        start.type = MoveTo;
+        start.points[0] = command.points[0];
+        m_commands.push_back(start);
+    }
+
+    m_commands.push_back(command);
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::ensureGeometryUpdate(float pixelSize) const
+{
+    // The tessellation only depends on the scale through the tolerance and the
+    // fringe, small zoom changes can keep the current one
+    float ratio = pixelSize / m_pixelSize;
+    if (!m_needsUpdate && (ratio > 0.8f) && (ratio < 1.25f))
+        return;
+
+    m_pixelSize   = pixelSize;
+    m_fringe      = m_antialiasing ? pixelSize : 0.f;
+    m_needsUpdate = false;
+
+    m_vertices.clear();
+
+    float tolerance = m_tolerance * pixelSize;
+    std::vector<Vector2f> points;
+    Vector2f start;
+
+    for (std::size_t i = 0; i < m_commands.size(); ++i)
+    {
+        const Command& command = m_commands[i];
+        switch (command.type)
+        {
+            case MoveTo:
+            {
+                strokePolyline(points, false, pixelSize);
+                points.clear();
+                start = command.points[0];
+                points.push_back(start);
+                break;
+            }
+
+            case LineTo:
+            {
+                appendPoint(points, command.points[0]);
+                break;
+            }
+
+            case QuadraticTo:
+            {
+                Vector2f p0 = points.back();
+                const Vector2f& p1 = command.points[0];
+                const Vector2f& p2 = command.points[1];
+
+                unsigned int count = getSubdivisions(0.25f, length(p0 - p1 * 2.f + p2), tolerance);
+                for (unsigned int j = 1; j <= count; ++j)
+                {
+                    float t = static_cast<float>(j) / count;
+                    float u = 1.f - t;
+                    appendPoint(points, p0 * (u * u) + p1 * (2.f * u * t) + p2 * (t * t));
+                }
+                break;
+            }
+
+            case CubicTo:
+            {
+                Vector2f p0 = points.back();
+                const Vector2f& p1 = command.points[0];
+                const Vector2f& p2 = command.points[1];
+                const Vector2f& p3 = command.points[2];
+
+                float difference = std::max(length(p0 - p1 * 2.f + p2), length(p1 - p2 * 2.f + p3));
+                unsigned int count = getSubdivisions(0.75f, difference, tolerance);
+                for (unsigned int j = 1; j <= count; ++j)
+                {
+                    float t = static_cast<float>(j) / count;
+                    float u = 1.f - t;
+                    appendPoint(points, p0 * (u * u * u) + p1 * (3.f * u * u * t) + p2 * (3.f * u * t * t) + p3 * (t * t * t));
+                }
+                break;
+            }
+
+            case Arc:
+            {
+                const Vector2f& center = command.points[0];
+                float radius = std::fabs(command.values[0]);
+                float angle  = command.values[2] - command.values[1];
+
+                Vector2f first = center + Vector2f(std::cos(command.values[1]), std::sin(command.values[1])) * radius;
+                if (points.empty())
+                    start = first;
+                appendPoint(points, first);
+
+                unsigned int count = getSubdivisions(radius, angle, tolerance, 1);
+                for (unsigned int j = 1; j <= count; ++j)
+                {
+                    float a = command.values[1] + angle * j / count;
+                    appendPoint(points, center + Vector2f(std::cos(a), std::sin(a)) * radius);
+                }
+                break;
+            }
+
+            case Close:
+            {
+                // The closing point is implied by the closed flag (arcs may
+                // not land exactly on it, hence the small distance)
+                if ((points.size() > 1) && (length(points.back() - start) <= pixelSize * 1e-3f))
+                    points.pop_back();
+
+                strokePolyline(points, true, pixelSize);
+                points.clear();
+                points.push_back(start);
+                break;
+            }
+        }
+    }
+
+    strokePolyline(points, false, pixelSize);
+
+    m_bounds = m_vertices.getBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::strokePolyline(const std::vector<Vector2f>& points, bool closed, float pixelSize) const
+{
+    std::size_t count = points.size();
+    if ((count < 2) || (m_strokeWidth <= 0.f))
+        return;
+
+    // Strokes thinner than a pixel are drawn one pixel wide and faded
+    // instead, which keeps hairlines visible and smooth
+    Color color = m_strokeColor;
+    float halfWidth = m_strokeWidth / 2.f;
+    if ((m_fringe > 0.f) && (m_strokeWidth < pixelSize))
+    {
+        color.a = static_cast<Uint8>(color.a * m_strokeWidth / pixelSize);
+        halfWidth = pixelSize / 2.f;
+    }
+
+    float tolerance = m_tolerance * pixelSize;
+
+    // The whole sub-path is a single strip of cross-sections, so that
+    // no part of the stroke is covered twice and only its boundary fades
+    m_sections.clear();
+
+    if (!closed)
+        addCap(points[0], normalize(points[1] - points[0]), halfWidth, tolerance, true);
+
+    std::size_t first = closed ? 0 : 1;
+    std::size_t last = closed ? count : count - 1;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const Vector2f& point = points[i];
+        addJoin(point, point - points[(i + count - 1) % count], points[(i + 1) % count] - point, halfWidth, tolerance);
+    }
+
+    if (!closed)
+        addCap(points[count - 1], normalize(points[count - 1] - points[count - 2]), halfWidth, tolerance, false);
+
+    addStrip(closed, color);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::addCap(const Vector2f& point, const Vector2f& direction, float halfWidth, float tolerance, bool start) const
+{
+    Vector2f normal(-direction.y, direction.x);
+    Vector2f outward = start ? -direction : direction;
+
+    if (m_lineCap == RoundCap)
+    {
+        // Cross-sections of a half disc, from its tip to the end point (or back)
+        unsigned int steps = getSubdivisions(halfWidth, pi / 2.f, tolerance, 2);
+        if (!start)
+            addSection(point, normal, -normal, halfWidth, false);
+
+        for (unsigned int k = 0; k < steps; ++k)
+        {
+            float angle = (pi / 2.f) * (start ? k : steps - 1 - k) / steps;
+            Vector2f along = outward * std::cos(angle);
+            Vector2f across = normal * std::sin(angle);
+            addSection(point, along + across, along - across, halfWidth, false);
+        }
+
+        if (start)
+            addSection(point, normal, -normal, halfWidth, false);
+
+        return;
+    }
+
+    // Square caps extend the stroke by half its width
+    Vector2f end = point + outward * ((m_lineCap == SquareCap) ? halfWidth : 0.f);
+
+    if (m_fringe <= 0.f)
+    {
+        addSection(end, normal, -normal, halfWidth, false);
+        return;
+    }
+
+    // The end of the stroke fades over the fringe too, centered on the end
+    float offset = m_fringe / 2.f;
+    if (start)
+    {
+        addSection(end + outward * offset, normal, -normal, halfWidth, true);
+        addSection(end - outward * offset, normal, -normal, halfWidth, false);
+    }
+    else
+    {
+        addSection(end - outward * offset, normal, -normal, halfWidth, false);
+        addSection(end + outward * offset, normal, -normal, halfWidth, true);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::addJoin(const Vector2f& point, const Vector2f& incoming, const Vector2f& outgoing, float halfWidth, float tolerance) const
+{
+    float length0 = length(incoming);
+    float length1 = length(outgoing);
+    if ((length0 <= 0.f) || (length1 <= 0.f))
+        return;
+
+    Vector2f direction0 = incoming / length0;
+    Vector2f direction1 = outgoing / length1;
+    Vector2f normal0(-direction0.y, direction0.x);
+    Vector2f normal1(-direction1.y, direction1.x);
+
+    // Straight continuations only need a single cross-section
+    float cross = crossProduct(direction0, direction1);
+    if ((std::fabs(cross) < 1e-4f) && (dotProduct(direction0, direction1) > 0.f))
+    {
+        addSection(point, normal0, -normal0, halfWidth, false);
+        return;
+    }
+
+    // The inner side of the corner is the one the path turns to
+    float innerSide = (cross > 0.f) ? 1.f : -1.f;
+
+    // The inner edges meet on the bisector, unless it's beyond the end of the segments,
+    // in which case the stroke folds onto itself there anyway
+    Vector2f bisector = normal0 + normal1;
+    float bisectorLength = length(bisector);
+    float reach = std::min(length0, length1);
+    Vector2f miter;
+    float cosine = 0.f;
+    float innerFactor;
+    if (bisectorLength > 1e-4f)
+    {
+        miter = bisector / bisectorLength;
+        cosine = dotProduct(miter, normal0);
+
+        float miterLength = halfWidth / cosine;
+        if (miterLength * miterLength - halfWidth * halfWidth <= reach * reach)
+            innerFactor = 1.f / cosine;
+        else
+            innerFactor = std::sqrt(reach * reach + halfWidth * halfWidth) / halfWidth;
+    }
+    else
+    {
+        // The path goes back on itself
+        miter = -direction0 * innerSide;
+        innerFactor = reach / halfWidth;
+    }
+
+    Vector2f inner = miter * (innerSide * innerFactor);
+    Vector2f outer0 = normal0 * -innerSide;
+    Vector2f outer1 = normal1 * -innerSide;
+
+    if ((m_lineJoin == MiterJoin) && (cosine > 0.f) && (1.f / cosine <= m_miterLimit))
+    {
+        // The outer edges meet on the bisector too
+        Vector2f outer = miter * (-innerSide / cosine);
+        addSection(point, innerSide > 0.f ? inner : outer, innerSide > 0.f ? outer : inner, halfWidth, false);
+    }
+    else if (m_lineJoin == RoundJoin)
+    {
+        // The outer edge follows an arc from one segment to the other, around the front of the corner
+        float angle = std::atan2(crossProduct(outer0, outer1), dotProduct(outer0, outer1));
+        if (dotProduct(rotateVector(outer0, angle / 2.f), direction0) < 0.f)
+            angle -= (angle > 0.f) ? 2.f * pi : -2.f * pi;
+
+        unsigned int steps = getSubdivisions(halfWidth, angle, tolerance, 1);
+        for (unsigned int k = 0; k <= steps; ++k)
+        {
+            Vector2f outer = rotateVector(outer0, angle * k / steps);
+            addSection(point, innerSide > 0.f ? inner : outer, innerSide > 0.f ? outer : inner, halfWidth, false);
+        }
+    }
+    else
+    {
+        // Bevel: the outer edge cuts straight from one segment to the other
+        addSection(point, innerSide > 0.f ? inner : outer0, innerSide > 0.f ? outer0 : inner, halfWidth, false);
+        addSection(point, innerSide > 0.f ? inner : outer1, innerSide > 0.f ? outer1 : inner, halfWidth, false);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::addSection(const Vector2f& center, const Vector2f& left, const Vector2f& right, float halfWidth, bool edge) const
+{
+    // The coverage fades from opaque half a fringe inside the edges to
+    // transparent half a fringe outside, which is what a box filter gives
+    float offset = m_fringe / 2.f;
+
+    Section section;
+    section.outerLeft  = center + left * (halfWidth + offset);
+    section.innerLeft  = center + left * (halfWidth - offset);
+    section.innerRight = center + right * (halfWidth - offset);
+    section.outerRight = center + right * (halfWidth + offset);
+    section.edge       = edge;
+
+    m_sections.push_back(section);
+}
+
+
+////////////////////////////////////////////////////////////
+void Path::addStrip(bool closed, const Color& color) const
+{
+    std::size_t count = m_sections.size();
+    if (count < 2)
+        return;
+
+    Color transparent = color;
+    transparent.a = 0;
+
+    std::size_t quads = closed ? count : count - 1;
+    std::size_t index = m_vertices.getVertexCount();
+    m_vertices.resize(index + quads * ((m_fringe > 0.f) ? 18 : 6));
+
+    for (std::size_t i = 0; i < quads; ++i)
+    {
+        const Section& s0 = m_sections[i];
+        const Section& s1 = m_sections[(i + 1) % count];
+        const Color& c0 = s0.edge ? transparent : color;
+        const Color& c1 = s1.edge ? transparent : color;
+
+        // Body of the stroke
+        m_vertices[index++] = Vertex(s0.innerLeft, c0);
+        m_vertices[index++] = Vertex(s0.innerRight, c0);
+        m_vertices[index++] = Vertex(s1.innerRight, c1);
+        m_vertices[index++] = Vertex(s0.innerLeft, c0);
+        m_vertices[index++] = Vertex(s1.innerRight, c1);
+        m_vertices[index++] = Vertex(s1.innerLeft, c1);
+
+        if (m_fringe <= 0.f)
+            continue;
+
+        // Fringes along both edges
+        m_vertices[index++] = Vertex(s0.outerLeft, transparent);
+        m_vertices[index++] = Vertex(s0.innerLeft, c0);
+        m_vertices[index++] = Vertex(s1.innerLeft, c1);
+        m_vertices[index++] = Vertex(s0.outerLeft, transparent);
+        m_vertices[index++] = Vertex(s1.innerLeft, c1);
+        m_vertices[index++] = Vertex(s1.outerLeft, transparent);
+
+        m_vertices[index++] = Vertex(s0.innerRight, c0);
+        m_vertices[index++] = Vertex(s0.outerRight, transparent);
+        m_vertices[index++] = Vertex(s1.outerRight, transparent);
+        m_vertices[index++] = Vertex(s0.innerRight, c0);
+        m_vertices[index++] = Vertex(s1.outerRight, transparent);
+        m_vertices[index++] = Vertex(s1.innerRight, c1);
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,455 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PolygonShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+
+namespace
+{
+    // Compute the cross product of (b - a) and (c - a), positive when a, b, c turn counter-clockwise
+    double crossProduct(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c)
+    {
+        return (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+               (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+    }
+
+    // Compute twice the signed area of a contour, positive for counter-clockwise contours
+    double signedArea(const std::vector<sf::Vector2f>& points)
+    {
+        double area = 0;
+        for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+            area += static_cast<double>(points[j].x) * points[i].y - static_cast<double>(points[i].x) * points[j].y;
+        return area;
+    }
+
+    // Check whether a point lies inside or on the edges of a counter-clockwise triangle
+    bool isInsideTriangle(const sf::Vector2f& p, const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c)
+    {
+        return (crossProduct(a, b, p) >= 0) && (crossProduct(b, c, p) >= 0) && (crossProduct(c, a, p) >= 0);
+    }
+
+    // Compute the normal of a segment
+    sf::Vector2f computeNormal(const sf::Vector2f& p1, const sf::Vector2f& p2)
+    {
+        sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0.f)
+            normal /= length;
+        return normal;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PolygonShape::PolygonShape(std::size_t pointCount) :
+m_points             (pointCount),
+m_texture            (NULL),
+m_textureRect        (),
+m_fillColor          (255, 255, 255),
+m_outlineColor       (255, 255, 255),
+m_outlineThickness   (0),
+m_triangles          (),
+m_vertices           (Triangles),
+m_outlineVertices    (TriangleStrip),
+m_insideBounds       (),
+m_bounds             (),
+m_trianglesNeedUpdate(true),
+m_fillNeedsUpdate    (true),
+m_outlineNeedsUpdate (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPointCount(std::size_t count)
+{
+    m_points.resize(count);
+    m_trianglesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PolygonShape::getPointCount() const
+{
+    return m_points.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPoint(std::size_t index, const Vector2f& point)
+{
+    m_points[index] = point;
+    m_trianglesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setPoints(const Vector2f* points, std::size_t count)
+{
+    m_points.assign(points, points + count);
+    m_trianglesNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f PolygonShape::getPoint(std::size_t index) const
+{
+    return m_points[index];
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setTexture(const Texture* texture, bool resetRect)
+{
+    if (texture)
+    {
+        // Recompute the texture area if requested, or if there was no texture & rect before
+        if (resetRect || (!m_texture && (m_textureRect == IntRect())))
+            setTextureRect(IntRect(0, 0, texture->getSize().x, texture->getSize().y));
+    }
+
+    // Assign the new texture
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setTextureRect(const IntRect& rect)
+{
+    m_textureRect = rect;
+    m_fillNeedsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setFillColor(const Color& color)
+{
+    m_fillColor = color;
+    m_fillNeedsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setOutlineColor(const Color& color)
+{
+    m_outlineColor = color;
+    m_outlineNeedsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::setOutlineThickness(float thickness)
+{
+    m_outlineThickness = thickness;
+    m_outlineNeedsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* PolygonShape::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& PolygonShape::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& PolygonShape::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& PolygonShape::getOutlineColor() const
+{
+    return m_outlineColor;
+}
+
+
+////////////////////////////////////////////////////////////
+float PolygonShape::getOutlineThickness() const
+{
+    return m_outlineThickness;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<Uint32>& PolygonShape::getTriangles() const
+{
+    ensureGeometryUpdate();
+
+    return m_triangles;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect PolygonShape::getLocalBounds() const
+{
+    ensureGeometryUpdate();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect PolygonShape::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+
+    // Render the inside
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+
+    // Render the outline
+    if (m_outlineThickness != 0)
+    {
+        states.texture = NULL;
+        target.draw(m_outlineVertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool PolygonShape::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::ensureGeometryUpdate() const
+{
+    // New points invalidate everything, the other properties only touch their own vertices
+    if (m_trianglesNeedUpdate)
+    {
+        updateTriangles();
+
+        m_trianglesNeedUpdate = false;
+        m_fillNeedsUpdate     = true;
+        m_outlineNeedsUpdate  = true;
+    }
+
+    if (m_fillNeedsUpdate)
+    {
+        updateFill();
+        m_fillNeedsUpdate = false;
+    }
+
+    if (m_outlineNeedsUpdate)
+    {
+        updateOutline();
+        m_outlineNeedsUpdate = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::updateTriangles() const
+{
+    m_triangles.clear();
+
+    // Compute the bounds of the polygon
+    m_insideBounds = FloatRect();
+    if (!m_points.empty())
+    {
+        Vector2f min = m_points[0];
+        Vector2f max = m_points[0];
+        for (std::size_t i = 1; i < m_points.size(); ++i)
+        {
+            min.x = std::min(min.x, m_points[i].x);
+            min.y = std::min(min.y, m_points[i].y);
+            max.x = std::max(max.x, m_points[i].x);
+            max.y = std::max(max.y, m_points[i].y);
+        }
+        m_insideBounds = FloatRect(min, max - min);
+    }
+
+    if (m_points.size() < 3)
+        return;
+
+    // Degenerate contours have nothing to fill
+    double area = signedArea(m_points);
+    if (area == 0)
+        return;
+
+    // Walk the contour counter-clockwise, whatever the order the points were given in
+    std::vector<Uint32> contour(m_points.size());
+    for (std::size_t i = 0; i < contour.size(); ++i)
+        contour[i] = static_cast<Uint32>(area > 0 ? i : contour.size() - 1 - i);
+
+    m_triangles.reserve((m_points.size() - 2) * 3);
+
+    // Clip ears until a single triangle remains; the search resumes where
+    // the previous ear was found, which keeps the cost close to O(n^2)
+    std::size_t current = 0;
+    std::size_t attempts = 0;
+    while (contour.size() > 3)
+    {
+        std::size_t count = contour.size();
+        std::size_t prev  = (current + count - 1) % count;
+        std::size_t next  = (current + 1) % count;
+
+        const Vector2f& a = m_points[contour[prev]];
+        const Vector2f& b = m_points[contour[current]];
+        const Vector2f& c = m_points[contour[next]];
+
+        double turn = crossProduct(a, b, c);
+        bool   ear  = turn > 0;
+
+        // A convex vertex is an ear only if no other vertex of the contour lies inside its triangle
+        for (std::size_t i = (next + 1) % count; ear && (i != prev); i = (i + 1) % count)
+        {
+            const Vector2f& p = m_points[contour[i]];
+            if ((p != a) && (p != b) && (p != c) && isInsideTriangle(p, a, b, c))
+                ear = false;
+        }
+
+        // Clip the ear; flat vertices are dropped without emitting a triangle, and if
+        // no ear can be found (self-intersecting contour) the vertex is clipped anyway
+        // so that the loop always ends
+        if (ear || (turn == 0) || (attempts >= count))
+        {
+            if (turn != 0)
+            {
+                m_triangles.push_back(contour[prev]);
+                m_triangles.push_back(contour[current]);
+                m_triangles.push_back(contour[next]);
+            }
+
+            contour.erase(contour.begin() + static_cast<std::ptrdiff_t>(current));
+            if (current == contour.size())
+                current = 0;
+            attempts = 0;
+        }
+        else
+        {
+            current = next;
+            ++attempts;
+        }
+    }
+
+    if (crossProduct(m_points[contour[0]], m_points[contour[1]], m_points[contour[2]]) != 0)
+        m_triangles.insert(m_triangles.end(), contour.begin(), contour.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::updateFill() const
+{
+    m_vertices.resize(m_triangles.size());
+
+    for (std::size_t i = 0; i < m_triangles.size(); ++i)
+    {
+        const Vector2f& position = m_points[m_triangles[i]];
+
+        float xratio = m_insideBounds.width > 0 ? (position.x - m_insideBounds.left) / m_insideBounds.width : 0;
+        float yratio = m_insideBounds.height > 0 ? (position.y - m_insideBounds.top) / m_insideBounds.height : 0;
+
+        m_vertices[i].position    = position;
+        m_vertices[i].color       = m_fillColor;
+        m_vertices[i].texCoords.x = m_textureRect.left + m_textureRect.width * xratio;
+        m_vertices[i].texCoords.y = m_textureRect.top + m_textureRect.height * yratio;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void PolygonShape::updateOutline() const
+{
+    // Return if there is no outline
+    std::size_t count = m_points.size();
+    if ((m_outlineThickness == 0.f) || (count < 3))
+    {
+        m_outlineVertices.clear();
+        m_bounds = m_insideBounds;
+        return;
+    }
+
+    // The center can't tell the outside from the inside of a concave polygon,
+    // the winding of the contour does: the left normals point inside when it
+    // is counter-clockwise
+    float side = signedArea(m_points) > 0 ? -1.f : 1.f;
+
+    m_outlineVertices.resize((count + 1) * 2);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Get the two segments shared by the current point
+        const Vector2f& p0 = m_points[(i + count - 1) % count];
+        const Vector2f& p1 = m_points[i];
+        const Vector2f& p2 = m_points[(i + 1) % count];
+
+        // Compute their outward normal
+        Vector2f n1 = computeNormal(p0, p1) * side;
+        Vector2f n2 = computeNormal(p1, p2) * side;
+
+        // Combine them to get the extrusion direction
+        float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+        Vector2f normal = (factor != 0.f) ? (n1 + n2) / factor : n1;
+
+        // Update the outline points
+        m_outlineVertices[i * 2 + 0].position = p1;
+        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
+    }
+
+    // Duplicate the first point at the end, to close the outline
+    m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
+    m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
+
+    for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
+        m_outlineVertices[i].color = m_outlineColor;
+
+    // Update the polygon's bounds
+    m_bounds = m_outlineVertices.getBounds();
+}
+
+} // namespace sf
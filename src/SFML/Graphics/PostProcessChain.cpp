@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcessChain.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Compute the size of the output of a pass
+    sf::Vector2u getPassSize(const sf::Vector2u& sourceSize, float scale)
+    {
+        unsigned int width  = static_cast<unsigned int>(std::floor(sourceSize.x * scale + 0.5f));
+        unsigned int height = static_cast<unsigned int>(std::floor(sourceSize.y * scale + 0.5f));
+        return sf::Vector2u(std::max(width, 1u), std::max(height, 1u));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain() :
+m_passes (),
+m_ownPool(),
+m_pool   (&m_ownPool),
+m_result (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain(RenderTexturePool& pool) :
+m_passes (),
+m_ownPool(),
+m_pool   (&pool),
+m_result (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::~PostProcessChain()
+{
+    m_pool->release(m_result);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::addPass(const Shader& shader, float scale)
+{
+    Pass pass;
+    pass.shader  = &shader;
+    pass.scale   = scale;
+    pass.enabled = true;
+    m_passes.push_back(pass);
+
+    return m_passes.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::clear()
+{
+    m_passes.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::getPassCount() const
+{
+    return m_passes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::setPassEnabled(std::size_t index, bool enabled)
+{
+    m_passes[index].enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::isPassEnabled(std::size_t index) const
+{
+    return m_passes[index].enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::setPassScale(std::size_t index, float scale)
+{
+    m_passes[index].scale = scale;
+}
+
+
+////////////////////////////////////////////////////////////
+float PostProcessChain::getPassScale(std::size_t index) const
+{
+    return m_passes[index].scale;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& PostProcessChain::apply(const Texture& source)
+{
+    // Keep the previous result until the end, the source may be its texture
+    RenderTexture* previousResult = m_result;
+    m_result = NULL;
+
+    std::size_t last;
+    RenderTexture* held;
+    const Texture* input = runPasses(source, last, held);
+    const Texture* output = &source;
+
+    if (input && (last < m_passes.size()))
+    {
+        Vector2u size = getPassSize(source.getSize(), m_passes[last].scale);
+        m_result = m_pool->acquire(size.x, size.y);
+
+        if (m_result)
+        {
+            m_result->setSmooth(true);
+            drawPass(m_passes[last], *input, *m_result, Vector2f(size), RenderStates(BlendNone));
+            m_result->display();
+            output = &m_result->getTexture();
+        }
+        else
+        {
+            err() << "Failed to apply post-processing chain (cannot create render-texture)" << std::endl;
+        }
+    }
+
+    m_pool->release(held);
+    m_pool->release(previousResult);
+
+    return *output;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::apply(const Texture& source, RenderTarget& target, const RenderStates& states)
+{
+    std::size_t last;
+    RenderTexture* held;
+    const Texture* input = runPasses(source, last, held);
+
+    if (input)
+    {
+        // The last pass renders straight into the target, no copy needed
+        if (last < m_passes.size())
+        {
+            drawPass(m_passes[last], *input, target, Vector2f(source.getSize()), states);
+        }
+        else
+        {
+            Pass copy;
+            copy.shader  = NULL;
+            copy.scale   = 1.f;
+            copy.enabled = true;
+            drawPass(copy, source, target, Vector2f(source.getSize()), states);
+        }
+    }
+
+    m_pool->release(held);
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* PostProcessChain::runPasses(const Texture& source, std::size_t& last, RenderTexture*& held)
+{
+    held = NULL;
+
+    // Find the last enabled pass, it is rendered by the caller
+    last = m_passes.size();
+    for (std::size_t i = m_passes.size(); i > 0; --i)
+    {
+        if (m_passes[i - 1].enabled)
+        {
+            last = i - 1;
+            break;
+        }
+    }
+
+    // Ping-pong between render-textures: the output of a pass is acquired while its
+    // input is still held, and the input is released as soon as the pass is done,
+    // so that the next pass of the same size gets it back from the pool
+    const Texture* input = &source;
+    for (std::size_t i = 0; i < last; ++i)
+    {
+        const Pass& pass = m_passes[i];
+        if (!pass.enabled)
+            continue;
+
+        Vector2u size = getPassSize(source.getSize(), pass.scale);
+        RenderTexture* output = m_pool->acquire(size.x, size.y);
+        if (!output)
+        {
+            err() << "Failed to apply post-processing chain (cannot create render-texture)" << std::endl;
+            m_pool->release(held);
+            held = NULL;
+            return NULL;
+        }
+
+        // Bilinear filtering makes downsampled passes read an average of the pixels
+        output->setSmooth(true);
+        drawPass(pass, *input, *output, Vector2f(size), RenderStates(BlendNone));
+        output->display();
+
+        m_pool->release(held);
+        held = output;
+        input = &output->getTexture();
+    }
+
+    return input;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::drawPass(const Pass& pass, const Texture& input, RenderTarget& target, const Vector2f& size, RenderStates states)
+{
+    Vector2f textureSize(input.getSize());
+
+    Vertex vertices[4] =
+    {
+        Vertex(Vector2f(0, 0),           Vector2f(0, 0)),
+        Vertex(Vector2f(0, size.y),      Vector2f(0, textureSize.y)),
+        Vertex(Vector2f(size.x, 0),      Vector2f(textureSize.x, 0)),
+        Vertex(Vector2f(size.x, size.y), textureSize)
+    };
+
+    states.texture = &input;
+    states.shader  = pass.shader;
+    target.draw(vertices, 4, TriangleStrip, states);
+}
+
+} // namespace sf
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERDEVICE_HPP
+#define SFML_RENDERDEVICE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class IndexBuffer;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract interface to the graphics API used to
+///        submit the work of a render target
+///
+/// sf::RenderTarget talks to the graphics API through
+/// this interface for the state changes and commands that
+/// do not depend on how the API represents its resources.
+/// An implementation is expected to work on the render
+/// target that is currently active, and to leave the
+/// binding of the vertex data, textures and shaders to
+/// the caller.
+///
+////////////////////////////////////////////////////////////
+class RenderDevice
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~RenderDevice() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the device that render targets use by default
+    ///
+    /// \return Reference to the default device
+    ///
+    ////////////////////////////////////////////////////////////
+    static RenderDevice& getDefault();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the active target with a single color
+    ///
+    /// Only the pixels inside the scissor rectangle are cleared.
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void clear(const Color& color) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the rendering to a rectangle of the target
+    ///
+    /// \param rectangle  Rectangle in pixels, counted from the
+    ///                   top-left corner, empty to disable it
+    /// \param targetSize Size of the active target, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setScissor(const IntRect& rectangle, const Vector2u& targetSize) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the blending mode
+    ///
+    /// \param mode Blending mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setBlendMode(const BlendMode& mode) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives from the bound vertices
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to use when drawing
+    /// \param vertexCount Number of vertices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives once for every bound instance
+    ///
+    /// \param type          Type of primitives to draw
+    /// \param firstVertex   Index of the first vertex to use when drawing
+    /// \param vertexCount   Number of vertices to use when drawing
+    /// \param instanceCount Number of instances to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawInstanced(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives from the bound vertices, selected
+    ///        by an index buffer
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param indexBuffer Index buffer selecting the vertices
+    /// \param firstIndex  Position of the first index to use when drawing
+    /// \param indexCount  Number of indices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawIndexed(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount) = 0;
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERDEVICE_HPP
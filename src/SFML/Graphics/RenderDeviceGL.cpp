@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderDeviceGL.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/CorePipeline.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cassert>
+#include <ostream>
+
+
+namespace
+{
+    // The device is stateless, a single instance serves all the render targets
+    sf::priv::RenderDeviceGL defaultDevice;
+
+
+    // Convert an sf::PrimitiveType constant to the corresponding OpenGL constant.
+    GLenum primitiveToGlConstant(sf::PrimitiveType type)
+    {
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+
+        return modes[type];
+    }
+
+
+    // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
+    sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
+    {
+        switch (blendFactor)
+        {
+            case sf::BlendMode::Zero:             return GL_ZERO;
+            case sf::BlendMode::One:              return GL_ONE;
+            case sf::BlendMode::SrcColor:         return GL_SRC_COLOR;
+            case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
+            case sf::BlendMode::DstColor:         return GL_DST_COLOR;
+            case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
+            case sf::BlendMode::SrcAlpha:         return GL_SRC_ALPHA;
+            case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
+            case sf::BlendMode::DstAlpha:         return GL_DST_ALPHA;
+            case sf::BlendMode::OneMinusDstAlpha: return GL_ONE_MINUS_DST_ALPHA;
+        }
+
+        sf::err() << "Invalid value for sf::BlendMode::Factor! Fallback to sf::BlendMode::Zero." << std::endl;
+        assert(false);
+        return GL_ZERO;
+    }
+
+
+    // Convert an sf::BlendMode::BlendEquation constant to the corresponding OpenGL constant.
+    sf::Uint32 equationToGlConstant(sf::BlendMode::Equation blendEquation)
+    {
+        switch (blendEquation)
+        {
+            case sf::BlendMode::Add:             return GLEXT_GL_FUNC_ADD;
+            case sf::BlendMode::Subtract:        return GLEXT_GL_FUNC_SUBTRACT;
+            case sf::BlendMode::ReverseSubtract: return GLEXT_GL_FUNC_REVERSE_SUBTRACT;
+        }
+
+        sf::err() << "Invalid value for sf::BlendMode::Equation! Fallback to sf::BlendMode::Add." << std::endl;
+        assert(false);
+        return GLEXT_GL_FUNC_ADD;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RenderDevice& RenderDevice::getDefault()
+{
+    return defaultDevice;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderDeviceGL::clear(const Color& color)
+{
+    glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
+    glCheck(glClear(GL_COLOR_BUFFER_BIT));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderDeviceGL::setScissor(const IntRect& rectangle, const Vector2u& targetSize)
+{
+    if ((rectangle.width > 0) && (rectangle.height > 0))
+    {
+        // OpenGL counts rows from the bottom
+        int bottom = static_cast<int>(targetSize.y) - (rectangle.top + rectangle.height);
+        glCheck(glEnable(GL_SCISSOR_TEST));
+        glCheck(glScissor(rectangle.left, bottom, rectangle.width, rectangle.height));
+    }
+    else
+    {
+        glCheck(glDisable(GL_SCISSOR_TEST));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderDeviceGL::setBlendMode(const BlendMode& mode)
+{
+    // Apply the blend mode, falling back to the non-separate versions if necessary
+    if (GLEXT_blend_func_separate)
+    {
+        glCheck(GLEXT_glBlendFuncSeparate(
+            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
+            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+    }
+    else
+    {
+        glCheck(glBlendFunc(
+            factorToGlConstant(mode.colorSrcFactor),
+            factorToGlConstant(mode.colorDstFactor)));
+    }
+
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    {
+        if (GLEXT_blend_equation_separate)
+        {
+            glCheck(GLEXT_glBlendEquationSeparate(
+                equationToGlConstant(mode.colorEquation),
+                equationToGlConstant(mode.alphaEquation)));
+        }
+        else
+        {
+            glCheck(GLEXT_glBlendEquation(equationToGlConstant(mode.colorEquation)));
+        }
+    }
+    else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "OpenGL extension EXT_blend_minmax and/or EXT_blend_subtract unavailable" << std::endl;
+            err() << "Selecting a blend equation not possible" << std::endl;
+            err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
+
+            warned = true;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderDeviceGL::draw(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    glCheck(glDrawArrays(primitiveToGlConstant(type), static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderDeviceGL::drawInstanced(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount)
+{
+    // The instance attributes must have been set by the caller
+    CorePipeline::drawInstanced(primitiveToGlConstant(type), firstVertex, vertexCount, instanceCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderDeviceGL::drawIndexed(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount)
+{
+    GLenum indexType = (indexBuffer.getType() == IndexBuffer::Index32) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    std::size_t indexSize = (indexBuffer.getType() == IndexBuffer::Index32) ? sizeof(Uint32) : sizeof(Uint16);
+
+    // The element array binding is part of the vertex array object state, don't leave it behind
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, indexBuffer.getNativeHandle()));
+    glCheck(glDrawElements(primitiveToGlConstant(type), static_cast<GLsizei>(indexCount), indexType, reinterpret_cast<const void*>(firstIndex * indexSize)));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ELEMENT_ARRAY_BUFFER, 0));
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERDEVICEGL_HPP
+#define SFML_RENDERDEVICEGL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderDevice.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Implementation of the render device on top of
+///        OpenGL and OpenGL ES
+///
+////////////////////////////////////////////////////////////
+class RenderDeviceGL : public RenderDevice
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fill the active target with a single color
+    ///
+    /// \param color Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void clear(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restrict the rendering to a rectangle of the target
+    ///
+    /// \param rectangle  Rectangle in pixels, empty to disable it
+    /// \param targetSize Size of the active target, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setScissor(const IntRect& rectangle, const Vector2u& targetSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the blending mode
+    ///
+    /// \param mode Blending mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setBlendMode(const BlendMode& mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives from the bound vertices
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param firstVertex Index of the first vertex to use when drawing
+    /// \param vertexCount Number of vertices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives once for every bound instance
+    ///
+    /// \param type          Type of primitives to draw
+    /// \param firstVertex   Index of the first vertex to use when drawing
+    /// \param vertexCount   Number of vertices to use when drawing
+    /// \param instanceCount Number of instances to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawInstanced(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives selected by an index buffer
+    ///
+    /// \param type        Type of primitives to draw
+    /// \param indexBuffer Index buffer selecting the vertices
+    /// \param firstIndex  Position of the first index to use when drawing
+    /// \param indexCount  Number of indices to use when drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawIndexed(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERDEVICEGL_HPP
@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Render target that records the draw calls issued by drawables
+    // It is never activated, the draw calls are redirected to a queue
+    class Recorder : public sf::RenderTarget
+    {
+    public:
+
+        virtual sf::Vector2u getSize() const
+        {
+            return sf::Vector2u(0, 0);
+        }
+    };
+
+    // Compare the commands referenced by two indices
+    template <typename T>
+    struct IndexLess
+    {
+        IndexLess(const T& commands, bool sortStates) : m_commands(commands), m_sortStates(sortStates) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            // Without sorting, only the layers change the recording order
+            if (!m_sortStates && (m_commands[left].layer == m_commands[right].layer))
+                return left < right;
+
+            return m_commands[left] < m_commands[right];
+        }
+
+        const T& m_commands;
+        bool     m_sortStates;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue() :
+m_commands      (),
+m_vertices      (),
+m_shaderIds     (),
+m_textureIds    (),
+m_blendModes    (),
+m_sortingEnabled(true),
+m_sorted        (),
+m_sortNeeded    (false),
+m_mutex         ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const Drawable& drawable, const RenderStates& states, int layer)
+{
+    Recorder recorder;
+
+    // The draw calls issued by the drawable end up in record()
+    RenderTarget& target = recorder;
+    target.m_queue = this;
+    target.m_queueLayer = layer;
+
+    target.draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                      const RenderStates& states, int layer)
+{
+    // Nothing to record?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    record(layer, NULL, NULL, vertices, 0, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::append(const RenderQueue& queue)
+{
+    // Copy the other queue first, so that the two mutexes are
+    // never locked together and a queue can append itself
+    std::vector<Command> commands;
+    std::vector<Vertex> vertices;
+    {
+        Lock lock(queue.m_mutex);
+        commands = queue.m_commands;
+        vertices = queue.m_vertices;
+    }
+
+    Lock lock(m_mutex);
+
+    std::size_t vertexOffset = m_vertices.size();
+    m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+
+    for (std::size_t i = 0; i < commands.size(); ++i)
+    {
+        if (!commands[i].vertexBuffer)
+            commands[i].firstVertex += vertexOffset;
+
+        addCommand(commands[i]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::clear()
+{
+    Lock lock(m_mutex);
+
+    m_commands.clear();
+    m_vertices.clear();
+    m_shaderIds.clear();
+    m_textureIds.clear();
+    m_blendModes.clear();
+    m_sorted.clear();
+    m_sortNeeded = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getCommandCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::setSortingEnabled(bool enabled)
+{
+    Lock lock(m_mutex);
+
+    if (enabled != m_sortingEnabled)
+    {
+        m_sortingEnabled = enabled;
+        m_sortNeeded = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderQueue::isSortingEnabled() const
+{
+    Lock lock(m_mutex);
+
+    return m_sortingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::record(int layer, const VertexBuffer* vertexBuffer, const IndexBuffer* indexBuffer, const Vertex* vertices,
+                         std::size_t firstVertex, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    Lock lock(m_mutex);
+
+    Command command;
+    command.layer = layer;
+    command.states = states;
+    command.vertexBuffer = vertexBuffer;
+    command.indexBuffer = indexBuffer;
+    command.vertexCount = vertexCount;
+    command.type = type;
+
+    if (vertexBuffer)
+    {
+        command.firstVertex = firstVertex;
+    }
+    else
+    {
+        command.firstVertex = m_vertices.size();
+        m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+    }
+
+    addCommand(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::addCommand(Command command)
+{
+    // Identifiers are given in order of first use, so that the
+    // submission order doesn't depend on where objects live in memory
+    command.shaderId = m_shaderIds.insert(std::make_pair(command.states.shader, static_cast<Uint32>(m_shaderIds.size()))).first->second;
+    const void* texture = command.states.textureArray ? static_cast<const void*>(command.states.textureArray) : static_cast<const void*>(command.states.texture);
+    command.textureId = m_textureIds.insert(std::make_pair(texture, static_cast<Uint32>(m_textureIds.size()))).first->second;
+    command.blendModeId = getBlendModeId(command.states.blendMode);
+    command.sequence = m_commands.size();
+
+    m_commands.push_back(command);
+    m_sortNeeded = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 RenderQueue::getBlendModeId(const BlendMode& blendMode)
+{
+    // There are usually very few different blend modes
+    for (std::size_t i = 0; i < m_blendModes.size(); ++i)
+    {
+        if (m_blendModes[i] == blendMode)
+            return static_cast<Uint32>(i);
+    }
+
+    m_blendModes.push_back(blendMode);
+
+    return static_cast<Uint32>(m_blendModes.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(RenderTarget& target, RenderStates states) const
+{
+    Lock lock(m_mutex);
+
+    if (m_sortNeeded)
+    {
+        m_sorted.resize(m_commands.size());
+        for (std::size_t i = 0; i < m_sorted.size(); ++i)
+            m_sorted[i] = i;
+
+        std::sort(m_sorted.begin(), m_sorted.end(), IndexLess<std::vector<Command> >(m_commands, m_sortingEnabled));
+
+        m_sortNeeded = false;
+    }
+
+    for (std::size_t i = 0; i < m_sorted.size(); ++i)
+    {
+        const Command& command = m_commands[m_sorted[i]];
+
+        RenderStates commandStates(command.states);
+        commandStates.transform = states.transform * command.states.transform;
+
+        if (command.vertexBuffer)
+            target.drawVertexBuffer(*command.vertexBuffer, command.indexBuffer, command.firstVertex, command.vertexCount, commandStates);
+        else
+            target.draw(&m_vertices[command.firstVertex], command.vertexCount, command.type, commandStates);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderQueue::Command::operator <(const Command& right) const
+{
+    if (layer != right.layer)
+        return layer < right.layer;
+
+    if (shaderId != right.shaderId)
+        return shaderId < right.shaderId;
+
+    if (textureId != right.textureId)
+        return textureId < right.textureId;
+
+    if (blendModeId != right.blendModeId)
+        return blendModeId < right.blendModeId;
+
+    // Keep the recording order of the commands that share the same states
+    return sequence < right.sequence;
+}
+
+} // namespace sf
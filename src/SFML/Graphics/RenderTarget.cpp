@@ -27,18 +27,29 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/CorePipeline.hpp>
+#include <SFML/Graphics/RenderDevice.hpp>
+#include <SFML/Graphics/TextureArrayShader.hpp>
+#include <SFML/Graphics/StreamBuffer.hpp>
+#include <SFML/Graphics/GpuTimer.hpp>
 #include <SFML/Window/Context.hpp>
-#include <SFML/System/Mutex.hpp>
-#include <SFML/System/Lock.hpp>
+#include <SFML/System/FastLock.hpp>
+#include <SFML/System/FastMutex.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
 #include <SFML/System/Err.hpp>
 #include <cassert>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <map>
 
 
@@ -52,105 +63,350 @@
 
 namespace
 {
-    // Mutex to protect ID generation and our context-RenderTarget-map
-    sf::Mutex mutex;
+    // Beyond this number of disjoint changed areas, they are merged into one
+    const std::size_t maxDamageAreas = 16;
+
+    // Get the smallest rectangle containing two rectangles
+    sf::IntRect boundingRect(const sf::IntRect& a, const sf::IntRect& b)
+    {
+        int left   = std::min(a.left, b.left);
+        int top    = std::min(a.top, b.top);
+        int right  = std::max(a.left + a.width, b.left + b.width);
+        int bottom = std::max(a.top + a.height, b.top + b.height);
+
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+
+    // Mutex to protect ID generation
+    sf::FastMutex targetIdMutex;
 
     // Unique identifier, used for identifying RenderTargets when
     // tracking the currently active RenderTarget within a given context
-    sf::Uint64 getUniqueId()
+    sf::Uint64 getUniqueTargetId()
     {
-        sf::Lock lock(mutex);
+        sf::FastLock lock(targetIdMutex);
 
         static sf::Uint64 id = 1; // start at 1, zero is "no RenderTarget"
 
         return id++;
     }
 
+    // Live RenderTargets by ID, so that a target can take over the
+    // states cache of the one previously active in the same context
+    typedef std::map<sf::Uint64, const sf::RenderTarget*> TargetRegistry;
+    sf::FastMutex targetRegistryMutex;
+    TargetRegistry targetRegistry;
+
     // Map to help us detect whether a different RenderTarget
     // has been activated within a single context
+    // A context is only active in one thread at a time, so each thread
+    // tracks the contexts it uses on its own and no locking is required
     typedef std::map<sf::Uint64, sf::Uint64> ContextRenderTargetMap;
-    ContextRenderTargetMap contextRenderTargetMap;
+    sf::ThreadLocalPtr<ContextRenderTargetMap> contextRenderTargetMap(NULL);
 
     // Check if a RenderTarget with the given ID is active in the current context
     bool isActive(sf::Uint64 id)
     {
-        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(sf::Context::getActiveContextId());
+        const ContextRenderTargetMap* map = contextRenderTargetMap;
+
+        if (!map)
+            return false;
 
-        if ((iter == contextRenderTargetMap.end()) || (iter->second != id))
+        ContextRenderTargetMap::const_iterator iter = map->find(sf::Context::getActiveContextId());
+
+        if ((iter == map->end()) || (iter->second != id))
             return false;
 
         return true;
     }
 
-    // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
-    sf::Uint32 factorToGlConstant(sf::BlendMode::Factor blendFactor)
+    // Get the type of independent primitives that appendPrimitives produces from a given type
+    sf::PrimitiveType getIndependentType(sf::PrimitiveType type)
+    {
+        if (type == sf::Points)
+            return sf::Points;
+        else if ((type == sf::Lines) || (type == sf::LineStrip))
+            return sf::Lines;
+
+        return sf::Triangles;
+    }
+
+    // Append primitives to an array, converting strips, fans and quads to independent primitives and transforming them
+    void appendPrimitives(std::vector<sf::Vertex>& batch, const sf::Vertex* vertices, std::size_t vertexCount,
+                          sf::PrimitiveType type, const sf::Transform& transform)
+    {
+        std::size_t first = batch.size();
+
+        switch (type)
+        {
+            case sf::Points:
+            {
+                batch.insert(batch.end(), vertices, vertices + vertexCount);
+                break;
+            }
+
+            case sf::Lines:
+            case sf::Triangles:
+            {
+                // Drop incomplete primitives, they would otherwise be joined with the next draw
+                std::size_t primitiveSize = (type == sf::Lines) ? 2 : 3;
+                std::size_t count = vertexCount - vertexCount % primitiveSize;
+                batch.insert(batch.end(), vertices, vertices + count);
+                break;
+            }
+
+            case sf::LineStrip:
+            {
+                for (std::size_t i = 1; i < vertexCount; ++i)
+                {
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::TriangleStrip:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    batch.push_back(vertices[i - 2]);
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::TriangleFan:
+            {
+                for (std::size_t i = 2; i < vertexCount; ++i)
+                {
+                    batch.push_back(vertices[0]);
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+
+            case sf::Quads:
+            {
+                for (std::size_t i = 3; i < vertexCount; i += 4)
+                {
+                    batch.push_back(vertices[i - 3]);
+                    batch.push_back(vertices[i - 2]);
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i - 3]);
+                    batch.push_back(vertices[i - 1]);
+                    batch.push_back(vertices[i]);
+                }
+                break;
+            }
+        }
+
+        // Transform all the appended vertices at once
+        if (batch.size() > first)
+            transform.transformPoints(&batch[first], &batch[first], batch.size() - first);
+    }
+
+    // Get the OpenGL type of the components of a vertex layout attribute
+    GLenum layoutTypeToGlType(sf::VertexLayout::Type type)
+    {
+        switch (type)
+        {
+            case sf::VertexLayout::Float:     return GL_FLOAT;
+            case sf::VertexLayout::HalfFloat: return GLEXT_GL_HALF_FLOAT;
+            case sf::VertexLayout::Short:     return GL_SHORT;
+            default:                          return GL_UNSIGNED_BYTE;
+        }
+    }
+
+
+    // Check whether the fixed-function vertex arrays can source a vertex layout attribute
+    bool isFixedFunctionAttribute(const sf::VertexLayout::Attribute& attribute)
+    {
+        // Custom attributes go through the generic attribute arrays
+        if (attribute.semantic == sf::VertexLayout::Custom)
+            return true;
+
+        switch (attribute.type)
+        {
+            case sf::VertexLayout::Float:     return true;
+            case sf::VertexLayout::HalfFloat: return GLEXT_half_float_vertex;
+        #ifdef SFML_OPENGL_ES
+            case sf::VertexLayout::Short:     return (attribute.semantic != sf::VertexLayout::Color) && !attribute.normalized;
+        #else
+            case sf::VertexLayout::Short:     return (attribute.semantic == sf::VertexLayout::Color) || !attribute.normalized;
+        #endif
+            default:                          return (attribute.semantic == sf::VertexLayout::Color);
+        }
+    }
+
+
+    // Point the fixed-function vertex arrays to the currently bound buffer, following a vertex layout
+    void setLayoutPointers(const sf::VertexLayout& layout, bool customAttributes)
     {
-        switch (blendFactor)
+        GLsizei stride = static_cast<GLsizei>(layout.getStride());
+
+        for (std::size_t i = 0; i < layout.getAttributeCount(); ++i)
+        {
+            const sf::VertexLayout::Attribute& attribute = layout.getAttribute(i);
+
+            GLint count = static_cast<GLint>(attribute.componentCount);
+            GLenum type = layoutTypeToGlType(attribute.type);
+            const void* pointer = reinterpret_cast<const void*>(attribute.offset);
+
+            switch (attribute.semantic)
+            {
+                case sf::VertexLayout::Position:  glCheck(glVertexPointer(count, type, stride, pointer));   break;
+                case sf::VertexLayout::Color:     glCheck(glColorPointer(count, type, stride, pointer));    break;
+                case sf::VertexLayout::TexCoords: glCheck(glTexCoordPointer(count, type, stride, pointer)); break;
+
+                case sf::VertexLayout::Custom:
+                {
+                #ifndef SFML_OPENGL_ES
+                    if (customAttributes)
+                    {
+                        GLuint location = sf::priv::CorePipeline::CustomAttribute + attribute.index;
+                        glCheck(GLEXT_glVertexAttribPointer(location, count, type, attribute.normalized ? GL_TRUE : GL_FALSE, stride, pointer));
+                        glCheck(GLEXT_glEnableVertexAttribArray(location));
+                    }
+                #endif
+                    break;
+                }
+            }
+        }
+
+        // Standard attributes missing from the layout read a constant value
+        if (!layout.find(sf::VertexLayout::Color))
+        {
+            glCheck(glDisableClientState(GL_COLOR_ARRAY));
+            glCheck(glColor4f(1.f, 1.f, 1.f, 1.f));
+        }
+
+        if (!layout.find(sf::VertexLayout::TexCoords))
         {
-            case sf::BlendMode::Zero:             return GL_ZERO;
-            case sf::BlendMode::One:              return GL_ONE;
-            case sf::BlendMode::SrcColor:         return GL_SRC_COLOR;
-            case sf::BlendMode::OneMinusSrcColor: return GL_ONE_MINUS_SRC_COLOR;
-            case sf::BlendMode::DstColor:         return GL_DST_COLOR;
-            case sf::BlendMode::OneMinusDstColor: return GL_ONE_MINUS_DST_COLOR;
-            case sf::BlendMode::SrcAlpha:         return GL_SRC_ALPHA;
-            case sf::BlendMode::OneMinusSrcAlpha: return GL_ONE_MINUS_SRC_ALPHA;
-            case sf::BlendMode::DstAlpha:         return GL_DST_ALPHA;
-            case sf::BlendMode::OneMinusDstAlpha: return GL_ONE_MINUS_DST_ALPHA;
+            glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+
+        #ifdef SFML_OPENGL_ES
+            glCheck(glMultiTexCoord4f(GL_TEXTURE0, 0.f, 0.f, 0.f, 1.f));
+        #else
+            glCheck(glTexCoord2f(0.f, 0.f));
+        #endif
         }
 
-        sf::err() << "Invalid value for sf::BlendMode::Factor! Fallback to sf::BlendMode::Zero." << std::endl;
-        assert(false);
-        return GL_ZERO;
+        (void)customAttributes;
     }
 
 
-    // Convert an sf::BlendMode::BlendEquation constant to the corresponding OpenGL constant.
-    sf::Uint32 equationToGlConstant(sf::BlendMode::Equation blendEquation)
+    // Restore the vertex arrays changed by setLayoutPointers
+    void unsetLayoutPointers(const sf::VertexLayout& layout, bool customAttributes)
     {
-        switch (blendEquation)
+        // The color array is always expected to be enabled, the texture coordinates array is tracked by the cache
+        if (!layout.find(sf::VertexLayout::Color))
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+
+    #ifndef SFML_OPENGL_ES
+        if (customAttributes)
         {
-            case sf::BlendMode::Add:             return GLEXT_GL_FUNC_ADD;
-            case sf::BlendMode::Subtract:        return GLEXT_GL_FUNC_SUBTRACT;
-            case sf::BlendMode::ReverseSubtract: return GLEXT_GL_FUNC_REVERSE_SUBTRACT;
+            for (std::size_t i = 0; i < layout.getAttributeCount(); ++i)
+            {
+                const sf::VertexLayout::Attribute& attribute = layout.getAttribute(i);
+
+                if (attribute.semantic == sf::VertexLayout::Custom)
+                    glCheck(GLEXT_glDisableVertexAttribArray(sf::priv::CorePipeline::CustomAttribute + attribute.index));
+            }
         }
+    #endif
 
-        sf::err() << "Invalid value for sf::BlendMode::Equation! Fallback to sf::BlendMode::Add." << std::endl;
-        assert(false);
-        return GLEXT_GL_FUNC_ADD;
+        (void)customAttributes;
     }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+RenderTarget::Statistics::Statistics() :
+drawCalls       (0),
+vertices        (0),
+textureBinds    (0),
+shaderBinds     (0),
+blendModeChanges(0),
+bufferUploads   (0),
+culledDrawables (0),
+gpuTime         (Time::Zero)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
 m_cache      (),
-m_id         (getUniqueId())
+m_statistics (),
+m_frameTimer (),
+m_batch      (),
+m_culling    (false),
+m_instances  (NULL),
+m_queue      (NULL),
+m_queueLayer (0),
+m_id         (getUniqueTargetId()),
+m_scissor    (),
+m_damageTracking(false),
+m_damage     (),
+m_device     (&priv::RenderDevice::getDefault())
 {
     m_cache.glStatesSet = false;
+    m_cache.corePipeline = false;
+    m_cache.lastProgram = 0;
+    m_cache.lastShaderId = 0;
+    m_cache.lastTextureArrayId = 0;
+    m_cache.lastVertexBuffer = 0;
+    m_cache.skippedGlCalls = 0;
+    m_cache.contextId = 0;
+    m_frameTimer.available = false;
+    m_frameTimer.current.contextId = 0;
+    m_frameTimer.current.begin = 0;
+    m_frameTimer.current.end = 0;
+    m_batch.enable = false;
+    m_batch.type = Points;
+
+    FastLock lock(targetRegistryMutex);
+    targetRegistry[m_id] = this;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    FastLock lock(targetRegistryMutex);
+    targetRegistry.erase(m_id);
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Pending geometry must be drawn before the target is cleared
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
 
-        glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
-        glCheck(glClear(GL_COLOR_BUFFER_BIT));
+        // Only the pixels inside the scissor rectangle are cleared
+        applyScissor();
+
+        // Clearing ignores the viewport
+        if (m_damageTracking)
+        {
+            Vector2u size = getSize();
+            bool scissor = (m_scissor.width > 0) && (m_scissor.height > 0);
+            addDamage(scissor ? m_scissor : IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)));
+        }
+
+        m_device->clear(color);
     }
 }
 
@@ -158,6 +414,9 @@ void RenderTarget::clear(const Color& color)
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending geometry must be drawn with the view it was submitted with
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
 }
@@ -238,6 +497,21 @@ Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view)
 ////////////////////////////////////////////////////////////
 void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
 {
+    FloatRect bounds;
+    if (m_culling && drawable.getCullingBounds(bounds))
+    {
+        FloatRect visible = m_view.getBounds();
+        bounds = states.transform.transformRect(bounds);
+
+        // Edges are inclusive so that flat geometry such as lines or points isn't culled
+        if ((bounds.left > visible.left + visible.width) || (bounds.left + bounds.width < visible.left) ||
+            (bounds.top > visible.top + visible.height) || (bounds.top + bounds.height < visible.top))
+        {
+            ++m_statistics.culledDrawables;
+            return;
+        }
+    }
+
     drawable.draw(*this, states);
 }
 
@@ -246,10 +520,44 @@ void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
 void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                         PrimitiveType type, const RenderStates& states)
 {
+    SFML_PROFILE_SCOPE("RenderTarget::draw");
+
     // Nothing to draw?
     if (!vertices || (vertexCount == 0))
         return;
 
+    // Recording into a queue doesn't involve OpenGL
+    if (m_queue)
+    {
+        m_queue->record(m_queueLayer, NULL, NULL, vertices, 0, vertexCount, type, states);
+        return;
+    }
+
+    if (m_damageTracking)
+    {
+        if (m_instances)
+        {
+            damageViewport();
+        }
+        else
+        {
+            // Bounds of the vertices, as they are transformed by the render states
+            FloatRect bounds(vertices[0].position, Vector2f());
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                const Vector2f& position = vertices[i].position;
+                float right  = std::max(bounds.left + bounds.width, position.x);
+                float bottom = std::max(bounds.top + bounds.height, position.y);
+                bounds.left   = std::min(bounds.left, position.x);
+                bounds.top    = std::min(bounds.top, position.y);
+                bounds.width  = right - bounds.left;
+                bounds.height = bottom - bounds.top;
+            }
+
+            damageWorldArea(states.transform.transformRect(bounds));
+        }
+    }
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
@@ -259,6 +567,31 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
+    // Called by a drawable from drawInstanced
+    if (m_instances)
+    {
+        drawInstancedVertices(vertices, vertexCount, type, states);
+        return;
+    }
+
+    if (m_batch.enable)
+    {
+        // Try to merge the primitives with the pending ones
+        if (batchVertices(vertices, vertexCount, type, states))
+            return;
+
+        // Incompatible primitives: keep the drawing order
+        flush();
+    }
+
+    drawVertices(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states)
+{
     if (isActive(m_id) || setActive(true))
     {
         // Check if the vertex count is low enough so that we can pre-transform them
@@ -267,19 +600,48 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         if (useVertexCache)
         {
             // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
+            states.transform.transformPoints(vertices, m_cache.vertexCache, vertexCount);
+        }
+
+        setupDraw(useVertexCache, states, false);
+
+        // The programmable pipeline streams the vertices into a buffer object
+        if (m_cache.corePipeline)
+        {
+            const Vertex* data = useVertexCache ? m_cache.vertexCache : vertices;
+
+            // GL_QUADS is unavailable in core profile contexts
+            std::vector<Vertex> triangles;
+            if (type == Quads)
+            {
+                appendPrimitives(triangles, data, vertexCount, Quads, Transform::Identity);
+
+                if (triangles.empty())
+                {
+                    cleanupDraw(states);
+                    return;
+                }
+
+                data = &triangles[0];
+                vertexCount = triangles.size();
+                type = Triangles;
+            }
+
+            std::size_t firstVertex = 0;
+            if (priv::CorePipeline::setVertices(data, vertexCount, firstVertex))
             {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
+                ++m_statistics.bufferUploads;
+                drawPrimitives(type, firstVertex, vertexCount);
             }
-        }
 
-        setupDraw(useVertexCache, states);
+            cleanupDraw(states);
+
+            m_cache.useVertexCache = useVertexCache;
+            return;
+        }
 
         // Check if texture coordinates array is needed, and update client state accordingly
-        bool enableTexCoordsArray = (states.texture || states.shader);
+        bool enableTexCoordsArray = (states.texture || states.textureArray || states.shader);
         if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
         {
             if (enableTexCoordsArray)
@@ -288,9 +650,46 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                 glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
         }
 
+        // Stream the vertices that are not pre-transformed into a buffer
+        // object, so that the driver doesn't have to copy them synchronously
+        std::size_t firstVertex = 0;
+
+        unsigned int streamBuffer = 0;
+        if (!useVertexCache && priv::StreamBuffer::isAvailable())
+            streamBuffer = priv::StreamBuffer::upload(vertices, vertexCount, firstVertex);
+
+        if (streamBuffer)
+            ++m_statistics.bufferUploads;
+
+        // Client-side arrays require the buffer to be unbound, and
+        // the pointers set for the stream buffer to be replaced
+        bool streamBufferUnbound = false;
+        if (!streamBuffer && ((!m_cache.enable && GLEXT_vertex_buffer_object) || m_cache.lastVertexBuffer))
+        {
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+            streamBufferUnbound = (m_cache.lastVertexBuffer != 0);
+            m_cache.lastVertexBuffer = 0;
+        }
+
         // If we switch between non-cache and cache mode or enable texture
         // coordinates we need to set up the pointers to the vertices' components
-        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
+        if (streamBuffer)
+        {
+            // The stream buffer is bound, the pointers are offsets into it which
+            // stay valid as long as the same buffer keeps receiving the vertices
+            if (!m_cache.enable || (streamBuffer != m_cache.lastVertexBuffer))
+            {
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+                glCheck(glTexCoordPointer(3, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+                m_cache.lastVertexBuffer = streamBuffer;
+            }
+            else
+            {
+                m_cache.skippedGlCalls += 3;
+            }
+        }
+        else if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache || streamBufferUnbound)
         {
             const char* data = reinterpret_cast<const char*>(vertices);
 
@@ -301,17 +700,18 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
             glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
             glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
             if (enableTexCoordsArray)
-                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+                glCheck(glTexCoordPointer(3, GL_FLOAT, sizeof(Vertex), data + 12));
         }
         else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
         {
             // If we enter this block, we are already using our internal vertex cache
             const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
 
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            glCheck(glTexCoordPointer(3, GL_FLOAT, sizeof(Vertex), data + 12));
         }
 
-        drawPrimitives(type, 0, vertexCount);
+        drawPrimitives(type, firstVertex, vertexCount);
+
         cleanupDraw(states);
 
         // Update the cache
@@ -321,6 +721,77 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstancedVertices(const Vertex* vertices, std::size_t vertexCount,
+                                         PrimitiveType type, const RenderStates& states)
+{
+    if (!isActive(m_id) && !setActive(true))
+        return;
+
+    if (isInstancingSupported())
+    {
+        setupDraw(false, states, true);
+
+        // GL_QUADS is unavailable in core profile contexts
+        std::vector<Vertex> triangles;
+        if (type == Quads)
+        {
+            appendPrimitives(triangles, vertices, vertexCount, Quads, Transform::Identity);
+
+            if (triangles.empty())
+            {
+                cleanupDraw(states);
+                return;
+            }
+
+            vertices = &triangles[0];
+            vertexCount = triangles.size();
+            type = Triangles;
+        }
+
+        std::size_t firstVertex = 0;
+        if (priv::CorePipeline::setVertices(vertices, vertexCount, firstVertex) &&
+            priv::CorePipeline::setInstances(m_instances->transforms, m_instances->colors, m_instances->count))
+        {
+            m_statistics.bufferUploads += 2;
+            drawInstancedPrimitives(type, firstVertex, vertexCount);
+        }
+
+        priv::CorePipeline::unsetInstances();
+        cleanupDraw(states);
+
+        m_cache.useVertexCache = false;
+        return;
+    }
+
+    // Transform the instances on the CPU and submit them all at once
+    std::vector<Vertex> instanceVertices;
+    instanceVertices.reserve(vertexCount * m_instances->count);
+
+    for (std::size_t i = 0; i < m_instances->count; ++i)
+    {
+        std::size_t first = instanceVertices.size();
+
+        appendPrimitives(instanceVertices, vertices, vertexCount, type, m_instances->transforms[i] * states.transform);
+
+        if (m_instances->colors)
+        {
+            for (std::size_t j = first; j < instanceVertices.size(); ++j)
+                instanceVertices[j].color *= m_instances->colors[i];
+        }
+    }
+
+    if (instanceVertices.empty())
+        return;
+
+    // The vertices are already transformed
+    RenderStates instanceStates(states);
+    instanceStates.transform = Transform::Identity;
+
+    drawVertices(&instanceVertices[0], instanceVertices.size(), getIndependentType(type), instanceStates);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
 {
@@ -332,6 +803,42 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& st
 void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
                         std::size_t vertexCount, const RenderStates& states)
 {
+    drawVertexBuffer(vertexBuffer, NULL, firstVertex, vertexCount, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    drawVertexBuffer(vertexBuffer, &indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex,
+                        std::size_t indexCount, const RenderStates& states)
+{
+    drawVertexBuffer(vertexBuffer, &indexBuffer, firstIndex, indexCount, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertexBuffer(const VertexBuffer& vertexBuffer, const IndexBuffer* indexBuffer, std::size_t firstVertex,
+                                    std::size_t vertexCount, const RenderStates& states)
+{
+    SFML_PROFILE_SCOPE("RenderTarget::draw");
+
+    // Recording into a queue doesn't involve OpenGL, the range is checked on submission
+    if (m_queue)
+    {
+        m_queue->record(m_queueLayer, &vertexBuffer, indexBuffer, NULL, firstVertex, vertexCount, vertexBuffer.getPrimitiveType(), states);
+        return;
+    }
+
+    // The vertices are on the graphics card, their bounds are unknown
+    if (m_damageTracking)
+        damageViewport();
+
     // VertexBuffer not supported?
     if (!VertexBuffer::isAvailable())
     {
@@ -339,17 +846,27 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         return;
     }
 
+    // With an index buffer, the range is a range of indices
+    std::size_t elementCount = indexBuffer ? indexBuffer->getIndexCount() : vertexBuffer.getVertexCount();
+
     // Sanity check
-    if (firstVertex > vertexBuffer.getVertexCount())
+    if (firstVertex > elementCount)
         return;
 
     // Clamp vertexCount to something that makes sense
-    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+    vertexCount = std::min(vertexCount, elementCount - firstVertex);
 
     // Nothing to draw?
-    if (!vertexCount || !vertexBuffer.getNativeHandle())
+    if (!vertexCount || !vertexBuffer.getNativeHandle() || (indexBuffer && !indexBuffer->getNativeHandle()))
         return;
 
+    // OpenGL can't source a buffer while it is mapped
+    if (vertexBuffer.isMapped())
+    {
+        err() << "sf::VertexBuffer is mapped, drawing skipped" << std::endl;
+        return;
+    }
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (vertexBuffer.getPrimitiveType() == Quads)
@@ -359,22 +876,123 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         }
     #endif
 
+    // Vertex buffers are never batched, draw the pending geometry first to keep the drawing order
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
-        setupDraw(false, states);
+        bool instanced = false;
+
+        // Called by a drawable from drawInstanced
+        if (m_instances)
+        {
+            // Instanced indexed drawing isn't implemented, such draws take the fallback path
+            instanced = isInstancingSupported() && !indexBuffer;
+
+            // Without GPU support, draw the instances one by one
+            if (!instanced)
+            {
+                const Instances* instances = m_instances;
+                m_instances = NULL;
+
+                for (std::size_t i = 0; i < instances->count; ++i)
+                {
+                    RenderStates instanceStates(states);
+                    instanceStates.transform = instances->transforms[i] * states.transform;
+                    drawVertexBuffer(vertexBuffer, indexBuffer, firstVertex, vertexCount, instanceStates);
+                }
+
+                m_instances = instances;
+                return;
+            }
+        }
+
+        setupDraw(false, states, instanced);
+
+        // GL_QUADS is unavailable in core profile contexts
+        if (m_cache.corePipeline && (vertexBuffer.getPrimitiveType() == Quads))
+        {
+            err() << "sf::Quads primitive type is not supported in core profile contexts, drawing skipped" << std::endl;
+            cleanupDraw(states);
+            return;
+        }
+
+        const VertexLayout& layout = vertexBuffer.getLayout();
+
+        // The fixed-function pipeline only sources a subset of the layout types
+        if (!m_cache.corePipeline && !layout.isDefault())
+        {
+            for (std::size_t i = 0; i < layout.getAttributeCount(); ++i)
+            {
+                if (!isFixedFunctionAttribute(layout.getAttribute(i)))
+                {
+                    err() << "Vertex layout attribute type is not supported by the fixed-function pipeline, drawing skipped" << std::endl;
+                    cleanupDraw(states);
+                    return;
+                }
+            }
+        }
 
         // Bind vertex buffer
         VertexBuffer::bind(&vertexBuffer);
 
-        // Always enable texture coordinates
-        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
+        if (m_cache.corePipeline)
+        {
+            priv::CorePipeline::setVertexBuffer(layout);
+
+            if (indexBuffer)
+            {
+                drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), *indexBuffer, firstVertex, vertexCount);
+            }
+            else if (!instanced)
+            {
+                drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+            }
+            else
+            {
+                if (priv::CorePipeline::setInstances(m_instances->transforms, m_instances->colors, m_instances->count))
+                {
+                    ++m_statistics.bufferUploads;
+                    drawInstancedPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+                }
+
+                priv::CorePipeline::unsetInstances();
+            }
+
+            priv::CorePipeline::unsetVertexBuffer(layout);
+
+            VertexBuffer::bind(NULL);
+            cleanupDraw(states);
+
+            m_cache.useVertexCache = false;
+            return;
+        }
+
+        // Enable texture coordinates unless the layout lacks them
+        bool hasTexCoords = (layout.find(VertexLayout::TexCoords) != NULL);
+        bool customAttributes = (states.shader != NULL);
+
+        if (hasTexCoords && (!m_cache.enable || !m_cache.texCoordsArrayEnabled))
             glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
 
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        if (layout.isDefault())
+        {
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+            glCheck(glTexCoordPointer(3, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        }
+        else
+        {
+            setLayoutPointers(layout, customAttributes);
+        }
+
+        if (indexBuffer)
+            drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), *indexBuffer, firstVertex, vertexCount);
+        else
+            drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
 
-        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+        if (!layout.isDefault())
+            unsetLayoutPointers(layout, customAttributes);
 
         // Unbind vertex buffer
         VertexBuffer::bind(NULL);
@@ -382,54 +1000,158 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         cleanupDraw(states);
 
         // Update the cache
+        m_cache.lastVertexBuffer = 0;
         m_cache.useVertexCache = false;
-        m_cache.texCoordsArrayEnabled = true;
+        m_cache.texCoordsArrayEnabled = hasTexCoords;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTarget::setActive(bool active)
+void RenderTarget::drawInstanced(const Drawable& drawable, const Transform* transforms, const Color* colors,
+                                 std::size_t instanceCount, const RenderStates& states)
 {
-    // Mark this RenderTarget as active or no longer active in the tracking map
-    {
-        sf::Lock lock(mutex);
-
-        Uint64 contextId = Context::getActiveContextId();
+    SFML_PROFILE_SCOPE("RenderTarget::drawInstanced");
 
-        ContextRenderTargetMap::iterator iter = contextRenderTargetMap.find(contextId);
+    // Nothing to draw?
+    if (!transforms || (instanceCount == 0))
+        return;
 
-        if (active)
-        {
-            if (iter == contextRenderTargetMap.end())
-            {
-                contextRenderTargetMap[contextId] = m_id;
+    // Instances are never batched, draw the pending geometry first to keep the drawing order
+    flush();
 
-                m_cache.enable = false;
-            }
-            else if (iter->second != m_id)
-            {
-                iter->second = m_id;
+    // Every primitive issued by the drawable is now drawn for all the instances
+    Instances instances = {transforms, colors, instanceCount};
+    const Instances* previousInstances = m_instances;
+    m_instances = &instances;
 
-                m_cache.enable = false;
-            }
-        }
-        else
+    drawable.draw(*this, states);
+
+    m_instances = previousInstances;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstanced(const VertexBuffer& vertexBuffer, const Transform* transforms, const Color* colors,
+                                 std::size_t instanceCount, const RenderStates& states)
+{
+    drawInstanced(static_cast<const Drawable&>(vertexBuffer), transforms, colors, instanceCount, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    // Don't lose the geometry accumulated so far
+    if (!enabled)
+        flush();
+
+    m_batch.enable = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_batch.enable;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_batch.vertices.empty())
+        return;
+
+    SFML_PROFILE_SCOPE("RenderTarget::flush");
+
+    // The batched vertices are already transformed, m_batch.states uses an identity transform
+    drawVertices(&m_batch.vertices[0], m_batch.vertices.size(), m_batch.type, m_batch.states);
+
+    // Keep the allocated memory around for the next batch
+    m_batch.vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::setActive(bool active)
+{
+    // Mark this RenderTarget as active or no longer active in the tracking map
+    if (active)
+    {
+        if (!contextRenderTargetMap)
+            contextRenderTargetMap = new ContextRenderTargetMap;
+
+        Uint64 contextId = Context::getActiveContextId();
+
+        ContextRenderTargetMap::iterator iter = contextRenderTargetMap->find(contextId);
+
+        if (iter == contextRenderTargetMap->end())
         {
-            if (iter != contextRenderTargetMap.end())
-                contextRenderTargetMap.erase(iter);
+            (*contextRenderTargetMap)[contextId] = m_id;
 
             m_cache.enable = false;
         }
+        else if (iter->second != m_id)
+        {
+            // Another target was using the context, its cached states are still accurate
+            takeOverCache(iter->second, contextId);
+
+            iter->second = m_id;
+        }
+
+        m_cache.contextId = contextId;
+    }
+    else
+    {
+        // The context may be activated in another thread from now on,
+        // forget everything this thread knew about the contexts it used
+        delete contextRenderTargetMap;
+        contextRenderTargetMap = NULL;
+
+        m_cache.enable = false;
     }
 
+    // We don't know which program is bound in a context we weren't active in
+    if (!m_cache.enable)
+        m_cache.lastProgram = 0;
+
     return true;
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::takeOverCache(Uint64 targetId, Uint64 contextId)
+{
+    m_cache.enable = false;
+
+    FastLock lock(targetRegistryMutex);
+
+    TargetRegistry::const_iterator iter = targetRegistry.find(targetId);
+    if (iter == targetRegistry.end())
+        return;
+
+    // The previous target may have been used in another context since
+    const StatesCache& previous = iter->second->m_cache;
+    if (!previous.enable || (previous.contextId != contextId))
+        return;
+
+    Uint64 skippedGlCalls = m_cache.skippedGlCalls;
+
+    m_cache = previous;
+
+    // The view is ours, and the vertex pointers may point into the previous target's vertex cache
+    m_cache.viewChanged    = true;
+    m_cache.useVertexCache = false;
+    m_cache.skippedGlCalls = skippedGlCalls;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    flush();
+
     if (isActive(m_id) || setActive(true))
     {
         #ifdef SFML_DEBUG
@@ -443,16 +1165,20 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        // Core profile contexts have no attribute and matrix stacks
+        if (!priv::CorePipeline::isRequired())
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
     }
 
     resetGLStates();
@@ -462,7 +1188,9 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
-    if (isActive(m_id) || setActive(true))
+    flush();
+
+    if ((isActive(m_id) || setActive(true)) && !priv::CorePipeline::isRequired())
     {
         glCheck(glMatrixMode(GL_PROJECTION));
         glCheck(glPopMatrix());
@@ -474,6 +1202,11 @@ void RenderTarget::popGLStates()
             glCheck(glPopClientAttrib());
             glCheck(glPopAttrib());
         #endif
+
+        // The bound program is not part of the attribute stack,
+        // don't leave the user with the last shader we drew with
+        if (m_cache.lastShaderId)
+            applyShader(NULL);
     }
 }
 
@@ -481,6 +1214,8 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    flush();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable = Shader::isAvailable();
     bool vertexBufferAvailable = VertexBuffer::isAvailable();
@@ -496,25 +1231,59 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
-        // Make sure that the texture unit which is active is the number 0
-        if (GLEXT_multitexture)
+        // Let debug contexts report their errors without polling glGetError
+        priv::glEnableDebugOutput();
+
+        // Core profile contexts don't provide the fixed-function pipeline
+        m_cache.corePipeline = priv::CorePipeline::isRequired();
+        m_cache.lastProgram = 0;
+        m_cache.lastShaderId = 0;
+        m_cache.shaderTextureIds.clear();
+        m_cache.lastTextureArrayId = 0;
+        m_cache.lastVertexBuffer = 0;
+
+        // Measure the GPU time of the frames if possible
+        m_frameTimer.available = priv::GpuTimer::isAvailable();
+
+        if (m_cache.corePipeline)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            if (!priv::CorePipeline::isAvailable() || !priv::CorePipeline::bind())
+            {
+                err() << "Failed to set up the programmable pipeline required by core profile contexts" << std::endl;
+                return;
+            }
+
+            // Make sure that the texture unit which is active is the number 0
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+
+            // Define the default OpenGL states
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glEnable(GL_BLEND));
+        }
+        else
+        {
+            // Make sure that the texture unit which is active is the number 0
+            if (GLEXT_multitexture)
+            {
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+                glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+            }
+
+            // Define the default OpenGL states
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glEnable(GL_BLEND));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glLoadIdentity());
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
         }
 
-        // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glLoadIdentity());
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
@@ -550,6 +1319,104 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::endFrame()
+{
+    Time gpuTime = m_statistics.gpuTime;
+    m_statistics = Statistics();
+    m_statistics.gpuTime = gpuTime;
+
+    if (!m_frameTimer.available)
+        return;
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    // Close the frame, it can only be measured if it was rendered in a single context
+    FrameQueries& current = m_frameTimer.current;
+    if (current.begin)
+    {
+        if (current.contextId == contextId)
+            current.end = priv::GpuTimer::insertTimestamp();
+
+        if (current.end)
+            m_frameTimer.pending.push_back(current);
+        else
+            priv::GpuTimer::release(current.begin);
+
+        current.begin = 0;
+        current.end = 0;
+    }
+
+    // Read the frames that the GPU has finished, without waiting for the others
+    while (!m_frameTimer.pending.empty() && (m_frameTimer.pending.front().contextId == contextId))
+    {
+        const FrameQueries& frame = m_frameTimer.pending.front();
+
+        // The end timestamp is written last, the beginning is then available too
+        Uint64 end = 0;
+        if (!priv::GpuTimer::getTimestamp(frame.end, end))
+            break;
+
+        Uint64 begin = 0;
+        if (priv::GpuTimer::getTimestamp(frame.begin, begin) && (end >= begin))
+            m_statistics.gpuTime = microseconds(static_cast<Int64>((end - begin) / 1000));
+
+        m_frameTimer.pending.erase(m_frameTimer.pending.begin());
+    }
+
+    // Don't accumulate frames that can't be read back, their
+    // queries are released along with their context if it isn't active
+    while (m_frameTimer.pending.size() > 4)
+    {
+        priv::GpuTimer::release(m_frameTimer.pending.front().begin);
+        priv::GpuTimer::release(m_frameTimer.pending.front().end);
+        m_frameTimer.pending.erase(m_frameTimer.pending.begin());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::batchVertices(const Vertex* vertices, std::size_t vertexCount,
+                                 PrimitiveType type, const RenderStates& states)
+{
+    // Shader parameters can change between two draw calls without
+    // us noticing, so geometry drawn with a shader is never batched
+    if (states.shader)
+        return false;
+
+    // Strips, fans and quads are converted to independent primitives so that they can be merged
+    PrimitiveType batchType = getIndependentType(type);
+
+    // Submit the pending geometry if it doesn't share the same states
+    if (!m_batch.vertices.empty() && ((batchType != m_batch.type) ||
+                                      (states.texture != m_batch.states.texture) ||
+                                      (states.textureArray != m_batch.states.textureArray) ||
+                                      (states.blendMode != m_batch.states.blendMode)))
+        flush();
+
+    m_batch.type = batchType;
+    m_batch.states.texture = states.texture;
+    m_batch.states.textureArray = states.textureArray;
+    m_batch.states.blendMode = states.blendMode;
+
+    appendPrimitives(m_batch.vertices, vertices, vertexCount, type, states.transform);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isInstancingSupported()
+{
+    // The programmable pipeline is selected when our states are first set
+    if (!m_cache.glStatesSet)
+        resetGLStates();
+
+    // The fixed-function pipeline has no way to consume per-instance data
+    return m_cache.corePipeline && priv::CorePipeline::isInstancingAvailable();
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
@@ -558,6 +1425,19 @@ void RenderTarget::applyCurrentView()
     int top = getSize().y - (viewport.top + viewport.height);
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
+    applyScissor();
+
+    // The programmable pipeline passes the projection matrix as a uniform
+    if (m_cache.corePipeline)
+    {
+        int location = m_cache.uniformLocations[priv::CorePipeline::ProjectionMatrixUniform];
+        if (m_cache.lastProgram && (location != -1))
+            priv::CorePipeline::setMatrix(location, m_view.getTransform().getMatrix());
+
+        m_cache.viewChanged = false;
+        return;
+    }
+
     // Set the projection matrix
     glCheck(glMatrixMode(GL_PROJECTION));
     glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
@@ -569,94 +1449,394 @@ void RenderTarget::applyCurrentView()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::applyScissor()
+{
+    m_device->setScissor(m_scissor, getSize());
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::damageWorldArea(const FloatRect& bounds)
+{
+    // Project the corners of the area with the view
+    const Transform& view = m_view.getTransform();
+    FloatRect normalized = view.transformRect(bounds);
+
+    IntRect viewport = getViewport(m_view);
+    float left   = ( normalized.left + 1.f) / 2.f * viewport.width + viewport.left;
+    float right  = ( normalized.left + normalized.width + 1.f) / 2.f * viewport.width + viewport.left;
+    float top    = (-normalized.top - normalized.height + 1.f) / 2.f * viewport.height + viewport.top;
+    float bottom = (-normalized.top + 1.f) / 2.f * viewport.height + viewport.top;
+
+    // Round outwards, with a margin for antialiased and smoothed edges
+    IntRect pixels(static_cast<int>(std::floor(left)) - 1, static_cast<int>(std::floor(top)) - 1, 0, 0);
+    pixels.width  = static_cast<int>(std::ceil(right)) + 1 - pixels.left;
+    pixels.height = static_cast<int>(std::ceil(bottom)) + 1 - pixels.top;
+
+    // Nothing is drawn outside of the viewport and the scissor rectangle
+    if (!pixels.intersects(viewport, pixels))
+        return;
+
+    if ((m_scissor.width > 0) && (m_scissor.height > 0) && !pixels.intersects(m_scissor, pixels))
+        return;
+
+    addDamage(pixels);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::damageViewport()
+{
+    IntRect area = getViewport(m_view);
+
+    if ((m_scissor.width > 0) && (m_scissor.height > 0) && !area.intersects(m_scissor, area))
+        return;
+
+    addDamage(area);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyBlendMode(const BlendMode& mode)
 {
-    // Apply the blend mode, falling back to the non-separate versions if necessary
-    if (GLEXT_blend_func_separate)
+    m_device->setBlendMode(mode);
+
+    m_cache.lastBlendMode = mode;
+    ++m_statistics.blendModeChanges;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTransform(const Transform& transform)
+{
+    // The programmable pipeline passes the model-view matrix as a uniform
+    if (m_cache.corePipeline)
     {
-        glCheck(GLEXT_glBlendFuncSeparate(
-            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
-            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        int location = m_cache.uniformLocations[priv::CorePipeline::ModelViewMatrixUniform];
+        if (m_cache.lastProgram && (location != -1))
+            priv::CorePipeline::setMatrix(location, transform.getMatrix());
+
+        return;
     }
+
+    // No need to call glMatrixMode(GL_MODELVIEW), it is always the
+    // current mode (for optimization purpose, since it's the most used)
+    if (transform == Transform::Identity)
+        glCheck(glLoadIdentity());
     else
+        glCheck(glLoadMatrixf(transform.getMatrix()));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTexture(const Texture* texture)
+{
+    // The programmable pipeline passes the texture matrix as a uniform
+    if (m_cache.corePipeline)
     {
-        glCheck(glBlendFunc(
-            factorToGlConstant(mode.colorSrcFactor),
-            factorToGlConstant(mode.colorDstFactor)));
+        if (texture)
+            texture->resolveRenderTexture();
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, (texture && texture->m_texture) ? texture->m_texture : 0));
+
+        int location = m_cache.uniformLocations[priv::CorePipeline::TextureMatrixUniform];
+        if (m_cache.lastProgram && (location != -1))
+        {
+            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
+                                  0.f, 1.f, 0.f, 0.f,
+                                  0.f, 0.f, 1.f, 0.f,
+                                  0.f, 0.f, 0.f, 1.f};
+
+            // Same matrix as the one set by Texture::bind for pixel coordinates
+            if (texture && texture->m_texture)
+            {
+                matrix[0] = 1.f / texture->m_actualSize.x;
+                matrix[5] = 1.f / texture->m_actualSize.y;
+
+                if (texture->m_pixelsFlipped)
+                {
+                    matrix[5] = -matrix[5];
+                    matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
+                }
+            }
+
+            priv::CorePipeline::setMatrix(location, matrix);
+        }
+
+        m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+        ++m_statistics.textureBinds;
+        return;
     }
 
-    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    Texture::bind(texture, Texture::Pixels);
+
+    m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    ++m_statistics.textureBinds;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyTextureArray(const TextureArray* textureArray)
+{
+#ifndef SFML_OPENGL_ES
+
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, (textureArray && textureArray->m_texture) ? textureArray->m_texture : 0));
+
+    // Like for textures, the texture matrix converts pixel coordinates to normalized coordinates
+    if (textureArray && textureArray->m_texture)
     {
-        if (GLEXT_blend_equation_separate)
+        GLfloat matrix[16] = {1.f / textureArray->m_size.x, 0.f, 0.f, 0.f,
+                              0.f, 1.f / textureArray->m_size.y, 0.f, 0.f,
+                              0.f, 0.f, 1.f, 0.f,
+                              0.f, 0.f, 0.f, 1.f};
+
+        if (m_cache.corePipeline)
         {
-            glCheck(GLEXT_glBlendEquationSeparate(
-                equationToGlConstant(mode.colorEquation),
-                equationToGlConstant(mode.alphaEquation)));
+            int location = m_cache.uniformLocations[priv::CorePipeline::TextureMatrixUniform];
+            if (m_cache.lastProgram && (location != -1))
+                priv::CorePipeline::setMatrix(location, matrix);
         }
         else
         {
-            glCheck(GLEXT_glBlendEquation(equationToGlConstant(mode.colorEquation)));
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glLoadMatrixf(matrix));
+            glCheck(glMatrixMode(GL_MODELVIEW));
         }
     }
-    else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
+
+    m_cache.lastTextureArrayId = textureArray ? textureArray->m_cacheId : 0;
+    ++m_statistics.textureBinds;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyShader(const Shader* shader)
+{
+    Shader::bind(shader);
+
+    // Binding a shader overrides the program of the programmable pipeline
+    m_cache.lastProgram = shader ? shader->getNativeHandle() : 0;
+
+    // Remember the textures bound along with the shader,
+    // their units must be bound again if their contents change
+    m_cache.lastShaderId = shader ? shader->m_cacheId : 0;
+    m_cache.shaderTextureIds.clear();
+
+    if (shader)
     {
-        static bool warned = false;
+        ++m_statistics.shaderBinds;
+
+        for (Shader::TextureTable::const_iterator it = shader->m_textures.begin(); it != shader->m_textures.end(); ++it)
+            m_cache.shaderTextureIds.push_back(it->second->m_fboAttachment ? 0 : it->second->m_cacheId);
+    }
+}
 
-        if (!warned)
-        {
-            err() << "OpenGL extension EXT_blend_minmax and/or EXT_blend_subtract unavailable" << std::endl;
-            err() << "Selecting a blend equation not possible" << std::endl;
-            err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
 
-            warned = true;
+////////////////////////////////////////////////////////////
+bool RenderTarget::isShaderCurrent(const Shader& shader) const
+{
+    if (!m_cache.enable || !shader.m_cacheId || (shader.m_cacheId != m_cache.lastShaderId))
+        return false;
+
+    if (shader.m_textures.size() != m_cache.shaderTextureIds.size())
+        return false;
+
+    // FBO attachments are always bound again, like in setupDraw
+    std::vector<Uint64>::const_iterator id = m_cache.shaderTextureIds.begin();
+    for (Shader::TextureTable::const_iterator it = shader.m_textures.begin(); it != shader.m_textures.end(); ++it, ++id)
+    {
+        if (it->second->m_fboAttachment || (it->second->m_cacheId != *id))
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCullingEnabled(bool enabled)
+{
+    m_culling = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCullingEnabled() const
+{
+    return m_culling;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setScissor(const IntRect& area)
+{
+    // Pending geometry must be drawn with the scissor it was submitted with
+    flush();
+
+    m_scissor = area;
+    m_cache.viewChanged = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& RenderTarget::getScissor() const
+{
+    return m_scissor;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setDamageTrackingEnabled(bool enabled)
+{
+    m_damageTracking = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isDamageTrackingEnabled() const
+{
+    return m_damageTracking;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::addDamage(const IntRect& area)
+{
+    Vector2u size = getSize();
+    IntRect pixels;
+    if (!area.intersects(IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)), pixels))
+        return;
+
+    // Merge the area with the ones it overlaps, until it overlaps none
+    for (std::size_t i = 0; i < m_damage.size();)
+    {
+        if (m_damage[i].intersects(pixels))
+        {
+            pixels = boundingRect(pixels, m_damage[i]);
+            m_damage.erase(m_damage.begin() + static_cast<std::ptrdiff_t>(i));
+            i = 0;
+        }
+        else
+        {
+            ++i;
         }
     }
 
-    m_cache.lastBlendMode = mode;
+    m_damage.push_back(pixels);
+
+    // Window systems handle a few rectangles better than many small ones
+    if (m_damage.size() > maxDamageAreas)
+    {
+        for (std::size_t i = 1; i < m_damage.size(); ++i)
+            m_damage[0] = boundingRect(m_damage[0], m_damage[i]);
+
+        m_damage.resize(1);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyTransform(const Transform& transform)
+const std::vector<IntRect>& RenderTarget::getDamage() const
 {
-    // No need to call glMatrixMode(GL_MODELVIEW), it is always the
-    // current mode (for optimization purpose, since it's the most used)
-    if (transform == Transform::Identity)
-        glCheck(glLoadIdentity());
-    else
-        glCheck(glLoadMatrixf(transform.getMatrix()));
+    return m_damage;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyTexture(const Texture* texture)
+void RenderTarget::clearDamage()
 {
-    Texture::bind(texture, Texture::Pixels);
+    m_damage.clear();
+}
 
-    m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+
+////////////////////////////////////////////////////////////
+Uint64 RenderTarget::getSkippedGlCallCount() const
+{
+    return m_cache.skippedGlCalls;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyShader(const Shader* shader)
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
 {
-    Shader::bind(shader);
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::applyProgram(const RenderStates& states, bool instanced)
+{
+    // Our objects may not be bound if another target was drawn in this context
+    if (!m_cache.enable)
+    {
+        priv::CorePipeline::bind();
+        m_cache.lastProgram = 0;
+    }
+
+    unsigned int lastProgram = m_cache.lastProgram;
+
+    if (states.shader)
+    {
+        // Nothing to do if the shader and its textures are still bound,
+        // since only this target draws in the context its uniforms are untouched
+        if (isShaderCurrent(*states.shader) && (lastProgram == states.shader->getNativeHandle()))
+        {
+            m_cache.skippedGlCalls += 2 + 3 * states.shader->m_textures.size() + (states.shader->m_currentTexture != -1) +
+                                      priv::CorePipeline::UniformCount;
+
+            // Deferred uniforms may have changed since the shader was bound
+            states.shader->flushUniforms();
+            return false;
+        }
+
+        applyShader(states.shader);
+
+        // A user shader can be used by several targets, so we
+        // can't assume that it still holds our uniform values
+        priv::CorePipeline::getUniformLocations(m_cache.lastProgram, m_cache.uniformLocations);
+        return true;
+    }
+
+    unsigned int program = priv::CorePipeline::getDefaultProgram(states.texture != NULL, instanced, states.textureArray != NULL);
+    if (program == lastProgram)
+        return false;
+
+    priv::CorePipeline::useProgram(program);
+    priv::CorePipeline::getUniformLocations(program, m_cache.uniformLocations);
+    m_cache.lastProgram = program;
+    ++m_statistics.shaderBinds;
+    m_cache.lastShaderId = 0;
+    m_cache.shaderTextureIds.clear();
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states, bool instanced)
 {
     // First set the persistent OpenGL states if it's the very first call
     if (!m_cache.glStatesSet)
         resetGLStates();
 
+    // Mark the beginning of the GPU work of the frame
+    if (m_frameTimer.available && !m_frameTimer.current.begin)
+    {
+        m_frameTimer.current.begin = priv::GpuTimer::insertTimestamp();
+        m_frameTimer.current.contextId = Context::getActiveContextId();
+    }
+
+    // With the programmable pipeline, the program must be bound before its uniforms are set
+    bool programChanged = m_cache.corePipeline && applyProgram(states, instanced);
+
     if (useVertexCache)
     {
         // Since vertices are transformed, we must use an identity transform to render them
-        if (!m_cache.enable || !m_cache.useVertexCache)
-            glCheck(glLoadIdentity());
+        if (!m_cache.enable || !m_cache.useVertexCache || programChanged)
+            applyTransform(Transform::Identity);
     }
     else
     {
@@ -664,15 +1844,17 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     }
 
     // Apply the view
-    if (!m_cache.enable || m_cache.viewChanged)
+    if (!m_cache.enable || m_cache.viewChanged || programChanged)
         applyCurrentView();
 
     // Apply the blend mode
     if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
         applyBlendMode(states.blendMode);
 
-    // Apply the texture
-    if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
+    // Apply the texture, a texture array replaces it
+    const Texture* texture = states.textureArray ? NULL : states.texture;
+    bool textureApplied = true;
+    if (!m_cache.enable || programChanged || (texture && texture->m_fboAttachment))
     {
         // If the texture is an FBO attachment, always rebind it
         // in order to inform the OpenGL driver that we want changes
@@ -680,40 +1862,89 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
         // This saves us from having to call glFlush() in
         // RenderTextureImplFBO which can be quite costly
         // See: https://www.khronos.org/opengl/wiki/Memory_Model
-        applyTexture(states.texture);
+        applyTexture(texture);
     }
     else
     {
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+        Uint64 textureId = texture ? texture->m_cacheId : 0;
         if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
+            applyTexture(texture);
+        else
+            textureApplied = false;
     }
 
-    // Apply the shader
-    if (states.shader)
-        applyShader(states.shader);
+    // Apply the texture array, again if applying the texture reset the texture matrix
+    Uint64 textureArrayId = states.textureArray ? states.textureArray->m_cacheId : 0;
+    if ((textureArrayId != m_cache.lastTextureArrayId) || (states.textureArray && textureApplied))
+        applyTextureArray(states.textureArray);
+
+    // Apply the shader (already done by the programmable pipeline)
+    if (!m_cache.corePipeline)
+    {
+        // The fixed-function pipeline can't sample texture arrays, a built-in shader does
+        const Shader* shader = states.shader;
+        if (!shader && states.textureArray)
+            shader = priv::TextureArrayShader::get();
+
+        if (shader)
+        {
+            // Binding a shader and its textures is costly, skip it if nothing changed
+            if (isShaderCurrent(*shader))
+            {
+                m_cache.skippedGlCalls += 2 + 3 * shader->m_textures.size() + (shader->m_currentTexture != -1) + 1;
+
+                // Deferred uniforms may have changed since the shader was bound
+                shader->flushUniforms();
+            }
+            else
+            {
+                applyShader(shader);
+            }
+        }
+        else if ((!m_cache.enable && Shader::isAvailable()) || m_cache.lastShaderId)
+        {
+            // The previous draw (maybe from another target) may have left its shader bound
+            applyShader(NULL);
+        }
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
 {
-    // Find the OpenGL primitive type
-    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-    GLenum mode = modes[type];
+    m_device->draw(type, firstVertex, vertexCount);
+
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += vertexCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstancedPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
+{
+    // Draw the primitives once per instance, the instance attributes must have been set
+    m_device->drawInstanced(type, firstVertex, vertexCount, m_instances->count);
 
-    // Draw the primitives
-    glCheck(glDrawArrays(mode, firstVertex, static_cast<GLsizei>(vertexCount)));
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += vertexCount * m_instances->count;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawIndexedPrimitives(PrimitiveType type, const IndexBuffer& indexBuffer, std::size_t firstIndex, std::size_t indexCount)
+{
+    m_device->drawIndexed(type, indexBuffer, firstIndex, indexCount);
+
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += indexCount;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::cleanupDraw(const RenderStates& states)
 {
-    // Unbind the shader, if any
-    if (states.shader)
-        applyShader(NULL);
+    // The shader is left bound, setupDraw unbinds it when a draw doesn't use it
 
     // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
     // This prevents a bug where some drivers do not clear RenderTextures properly.
@@ -758,8 +1989,34 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 // * Shader
 //   Shaders are very hard to optimize, because they have
 //   parameters that can be hard (if not impossible) to track,
-//   like matrices or textures. The only optimization that we
-//   do is that we avoid setting a null shader if there was
-//   already none for the previous draw.
+//   like matrices or textures. Uniform values live in the
+//   program object itself, so the shader is left bound after
+//   a draw and only bound again when its own unique identifier
+//   (regenerated when it is compiled or its texture table
+//   changes) or one of its textures' identifiers changed.
+//
+// * Vertex pointers
+//   The stream buffer stays bound between draws, and the
+//   vertex pointers are only set again when the vertices are
+//   streamed into another buffer or sourced from client memory.
+//
+// * Programmable pipeline
+//   On core profile contexts the fixed-function matrices and
+//   client-side arrays are unavailable. The view, transform
+//   and texture matrices are then uniforms of the bound program,
+//   which are set again whenever the program changes.
+//
+// * Batching
+//   When enabled, consecutive draws sharing the same texture
+//   and blend mode are pre-transformed like the vertex cache
+//   and accumulated into a single array, which is submitted
+//   in one draw call as soon as the states change.
+//
+// * Vertex streaming
+//   Arrays too large for the vertex cache are copied into a
+//   ring buffer object instead of being sourced from client
+//   memory. Its three regions are fenced when persistent
+//   mapping is available, so that the GPU and the CPU never
+//   work on the same region at the same time.
 //
 ////////////////////////////////////////////////////////////
@@ -28,14 +28,38 @@
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/RenderTextureImplDefault.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/System/Err.hpp>
 
 
+namespace
+{
+    // Get the OpenGL internal format of an attachment, 0 for the default format of textures
+    unsigned int getInternalFormat(sf::RenderTexture::Format format)
+    {
+        switch (format)
+        {
+
+#ifndef SFML_OPENGL_ES
+
+            case sf::RenderTexture::Rgba16f:      return GLEXT_GL_RGBA16F;
+            case sf::RenderTexture::Rgba32f:      return GLEXT_GL_RGBA32F;
+            case sf::RenderTexture::R11fG11fB10f: return GLEXT_GL_R11F_G11F_B10F;
+
+#endif
+
+            default:                              return 0;
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 RenderTexture::RenderTexture() :
-m_impl(NULL)
+m_impl       (NULL),
+m_attachments()
 {
 
 }
@@ -45,6 +69,7 @@ m_impl(NULL)
 RenderTexture::~RenderTexture()
 {
     delete m_impl;
+    destroyAttachments();
 }
 
 
@@ -58,25 +83,79 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings)
 {
+    return create(width, height, std::vector<Format>(1, Rgba8), settings);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const std::vector<Format>& formats, const ContextSettings& settings)
+{
+    if (formats.empty())
+    {
+        err() << "Impossible to create render texture (no color attachment requested)" << std::endl;
+        return false;
+    }
+
+    // Check that the attachments are supported
+    bool fboAvailable = priv::RenderTextureImplFBO::isAvailable();
+    for (std::vector<Format>::const_iterator it = formats.begin(); it != formats.end(); ++it)
+    {
+        if ((*it != Rgba8) && (!fboAvailable || !priv::RenderTextureImplFBO::isFormatAvailable(*it)))
+        {
+            err() << "Impossible to create render texture (unsupported color attachment format)" << std::endl;
+            return false;
+        }
+    }
+
+    if ((formats.size() > 1) && !fboAvailable)
+    {
+        err() << "Impossible to create render texture (multiple color attachments require frame buffer objects)" << std::endl;
+        return false;
+    }
+
     // Create the texture
-    if (!m_texture.create(width, height))
+    if (!m_texture.create(width, height, getInternalFormat(formats[0]), 1))
     {
         err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
         return false;
     }
 
+    // Create the textures of the additional attachments
+    destroyAttachments();
+    for (std::size_t i = 1; i < formats.size(); ++i)
+    {
+        Texture* texture = new Texture;
+        m_attachments.push_back(texture);
+
+        if (!texture->create(width, height, getInternalFormat(formats[i]), 1))
+        {
+            err() << "Impossible to create render texture (failed to create the texture of color attachment " << i << ")" << std::endl;
+            return false;
+        }
+    }
+
     // We disable smoothing by default for render textures
     setSmooth(false);
 
+    std::vector<unsigned int> textureIds(1, m_texture.m_texture);
+    std::vector<unsigned int> internalFormats(1, getInternalFormat(formats[0]));
+    for (std::size_t i = 0; i < m_attachments.size(); ++i)
+    {
+        textureIds.push_back(m_attachments[i]->m_texture);
+        internalFormats.push_back(getInternalFormat(formats[i + 1]));
+    }
+
     // Create the implementation
     delete m_impl;
-    if (priv::RenderTextureImplFBO::isAvailable())
+    if (fboAvailable)
     {
         // Use frame-buffer object (FBO)
         m_impl = new priv::RenderTextureImplFBO;
 
-        // Mark the texture as being a framebuffer object attachment
+        // Mark the textures as being framebuffer object attachments
         m_texture.m_fboAttachment = true;
+        for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+            (*it)->m_fboAttachment = true;
     }
     else
     {
@@ -85,7 +164,7 @@ bool RenderTexture::create(unsigned int width, unsigned int height, const Contex
     }
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, settings))
+    if (!m_impl->create(width, height, textureIds, internalFormats, settings))
         return false;
 
     // We can now initialize the render target part
@@ -109,10 +188,36 @@ unsigned int RenderTexture::getMaximumAntialiasingLevel()
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTexture::isFormatAvailable(Format format)
+{
+    if (format == Rgba8)
+        return true;
+
+    return priv::RenderTextureImplFBO::isAvailable() && priv::RenderTextureImplFBO::isFormatAvailable(format);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAttachmentCount()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+    {
+        return priv::RenderTextureImplFBO::getMaximumAttachmentCount();
+    }
+    else
+    {
+        return 1;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setSmooth(smooth);
 }
 
 
@@ -127,6 +232,8 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->setRepeated(repeated);
 }
 
 
@@ -140,7 +247,11 @@ bool RenderTexture::isRepeated() const
 ////////////////////////////////////////////////////////////
 bool RenderTexture::generateMipmap()
 {
-    return m_texture.generateMipmap();
+    bool result = m_texture.generateMipmap();
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        result = (*it)->generateMipmap() && result;
+
+    return result;
 }
 
 
@@ -160,13 +271,42 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    // Submit the pending batched geometry before updating the texture
+    flush();
+
     // Update the target texture
     if (priv::RenderTextureImplFBO::isAvailable() || setActive(true))
     {
-        m_impl->updateTexture(m_texture.m_texture);
+        // Multisampled content is resolved when the textures are first used
+        RenderTexture* resolveSource = m_impl->updateTexture(m_texture.m_texture) ? this : NULL;
+
         m_texture.m_pixelsFlipped = true;
+        m_texture.m_resolveSource = resolveSource;
         m_texture.invalidateMipmap();
+
+        for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        {
+            (*it)->m_pixelsFlipped = true;
+            (*it)->m_resolveSource = resolveSource;
+            (*it)->invalidateMipmap();
+        }
     }
+
+    endFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexture::resolve()
+{
+    if (!m_impl || !m_texture.m_resolveSource)
+        return;
+
+    m_texture.m_resolveSource = NULL;
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        (*it)->m_resolveSource = NULL;
+
+    m_impl->resolveTexture();
 }
 
 
@@ -183,4 +323,31 @@ const Texture& RenderTexture::getTexture() const
     return m_texture;
 }
 
+
+////////////////////////////////////////////////////////////
+const Texture& RenderTexture::getTexture(std::size_t index) const
+{
+    if ((index == 0) || (index > m_attachments.size()))
+        return m_texture;
+
+    return *m_attachments[index - 1];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexture::getAttachmentCount() const
+{
+    return m_attachments.size() + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexture::destroyAttachments()
+{
+    for (std::vector<Texture*>::iterator it = m_attachments.begin(); it != m_attachments.end(); ++it)
+        delete *it;
+
+    m_attachments.clear();
+}
+
 } // namespace sf
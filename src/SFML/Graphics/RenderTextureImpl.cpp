@@ -38,6 +38,13 @@ RenderTextureImpl::~RenderTextureImpl()
     // Nothing to do
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderTextureImpl::resolveTexture()
+{
+    // Nothing to do by default, the textures are up to date after updateTexture
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
@@ -55,15 +56,16 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width      Width of the texture to render to
-    /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
-    /// \param settings   Context settings to create render-texture with
+    /// \param width           Width of the textures to render to
+    /// \param height          Height of the textures to render to
+    /// \param textureIds      OpenGL identifiers of the target textures
+    /// \param internalFormats OpenGL internal formats of the target textures (0 for the default RGBA format)
+    /// \param settings        Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings) = 0;
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const std::vector<unsigned int>& internalFormats, const ContextSettings& settings) = 0;
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -80,8 +82,19 @@ public:
     ///
     /// \param textureId OpenGL identifier of the target texture
     ///
+    /// \return True if the texture still has to be resolved with resolveTexture before it is used
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool updateTexture(unsigned int textureId) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve what was drawn into the target textures
+    ///
+    /// This is only needed by implementations that draw into
+    /// intermediate multisample buffers.
+    ///
     ////////////////////////////////////////////////////////////
-    virtual void updateTexture(unsigned int textureId) = 0;
+    virtual void resolveTexture();
 };
 
 } // namespace priv
@@ -65,7 +65,7 @@ unsigned int RenderTextureImplDefault::getMaximumAntialiasingLevel()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, unsigned int, const ContextSettings& settings)
+bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, const std::vector<unsigned int>&, const std::vector<unsigned int>&, const ContextSettings& settings)
 {
     // Store the dimensions
     m_width = width;
@@ -86,7 +86,7 @@ bool RenderTextureImplDefault::activate(bool active)
 
 
 ////////////////////////////////////////////////////////////
-void RenderTextureImplDefault::updateTexture(unsigned int textureId)
+bool RenderTextureImplDefault::updateTexture(unsigned int textureId)
 {
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
@@ -94,6 +94,8 @@ void RenderTextureImplDefault::updateTexture(unsigned int textureId)
     // Copy the rendered pixels to the texture
     glCheck(glBindTexture(GL_TEXTURE_2D, textureId));
     glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, m_width, m_height));
+
+    return false;
 }
 
 } // namespace priv
@@ -71,15 +71,16 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width      Width of the texture to render to
-    /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
-    /// \param settings   Context settings to create render-texture with
+    /// \param width           Width of the textures to render to
+    /// \param height          Height of the textures to render to
+    /// \param textureIds      OpenGL identifiers of the target textures
+    /// \param internalFormats OpenGL internal formats of the target textures (0 for the default RGBA format)
+    /// \param settings        Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const std::vector<unsigned int>& internalFormats, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -96,8 +97,10 @@ private:
     ///
     /// \param textureId OpenGL identifier of the target texture
     ///
+    /// \return Always false, the texture is up to date
+    ///
     ////////////////////////////////////////////////////////////
-    virtual void updateTexture(unsigned textureId);
+    virtual bool updateTexture(unsigned textureId);
 
     ////////////////////////////////////////////////////////////
     // Member data
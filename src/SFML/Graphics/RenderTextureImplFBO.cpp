@@ -31,6 +31,7 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <utility>
 #include <set>
 
@@ -51,12 +52,12 @@ namespace
     std::set<std::pair<sf::Uint64, unsigned int> > staleFrameBuffers;
 
     // Mutex to protect both active and stale frame buffer sets
-    sf::Mutex mutex;
+    sf::Mutex frameBufferMutex;
 
     // Callback that is called every time a context is destroyed
-    void contextDestroyCallback(void* arg)
+    void frameBufferContextDestroyCallback(void* arg)
     {
-        sf::Lock lock(mutex);
+        sf::Lock lock(frameBufferMutex);
 
         sf::Uint64 contextId = sf::Context::getActiveContextId();
 
@@ -98,18 +99,18 @@ namespace priv
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::RenderTextureImplFBO() :
 m_depthStencilBuffer(0),
-m_colorBuffer       (0),
+m_colorBuffers      (),
 m_width             (0),
 m_height            (0),
 m_context           (NULL),
-m_textureId         (0),
+m_textureIds        (),
 m_multisample       (false),
 m_stencil           (false)
 {
-    Lock lock(mutex);
+    Lock lock(frameBufferMutex);
 
     // Register the context destruction callback
-    registerContextDestroyCallback(contextDestroyCallback, 0);
+    registerContextDestroyCallback(frameBufferContextDestroyCallback, 0);
 
     // Insert the new frame buffer mapping into the set of all active mappings
     frameBuffers.insert(&m_frameBuffers);
@@ -122,16 +123,16 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
 {
     TransientContextLock contextLock;
 
-    Lock lock(mutex);
+    Lock lock(frameBufferMutex);
 
     // Remove the frame buffer mapping from the set of all active mappings
     frameBuffers.erase(&m_frameBuffers);
     frameBuffers.erase(&m_multisampleFrameBuffers);
 
-    // Destroy the color buffer
-    if (m_colorBuffer)
+    // Destroy the color buffers
+    for (std::vector<unsigned int>::const_iterator it = m_colorBuffers.begin(); it != m_colorBuffers.end(); ++it)
     {
-        GLuint colorBuffer = static_cast<GLuint>(m_colorBuffer);
+        GLuint colorBuffer = static_cast<GLuint>(*it);
         glCheck(GLEXT_glDeleteRenderbuffers(1, &colorBuffer));
     }
 
@@ -150,7 +151,7 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
         staleFrameBuffers.insert(std::make_pair(iter->first, iter->second));
 
     // Clean up FBOs
-    contextDestroyCallback(0);
+    frameBufferContextDestroyCallback(0);
 
     // Delete the backup context if we had to create one
     delete m_context;
@@ -186,6 +187,51 @@ unsigned int RenderTextureImplFBO::getMaximumAntialiasingLevel()
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::isFormatAvailable(RenderTexture::Format format)
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    switch (format)
+    {
+        case RenderTexture::Rgba8:        return true;
+        case RenderTexture::Rgba16f:      return GLEXT_texture_float != 0;
+        case RenderTexture::Rgba32f:      return GLEXT_texture_float != 0;
+        case RenderTexture::R11fG11fB10f: return GLEXT_packed_float != 0;
+        default:                          return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getMaximumAttachmentCount()
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    GLint attachments = 1;
+
+#ifndef SFML_OPENGL_ES
+
+    if (GLEXT_draw_buffers)
+    {
+        GLint drawBuffers = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_COLOR_ATTACHMENTS, &attachments));
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_DRAW_BUFFERS, &drawBuffers));
+        attachments = std::min(attachments, drawBuffers);
+    }
+
+#endif
+
+    return static_cast<unsigned int>(attachments);
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::unbind()
 {
@@ -194,7 +240,42 @@ void RenderTextureImplFBO::unbind()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings)
+bool RenderTextureImplFBO::blitToDefaultFrameBuffer()
+{
+
+#ifndef SFML_OPENGL_ES
+
+    if (!GLEXT_framebuffer_blit || m_multisample || !m_width || !m_height)
+        return false;
+
+    // Read from the FBO of the current context, write to its window
+    if (!activate(true))
+        return false;
+
+    // Blits are clipped by the scissor test, which the render target may have left enabled
+    GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+    if (scissor)
+        glCheck(glDisable(GL_SCISSOR_TEST));
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, 0));
+    glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+
+    if (scissor)
+        glCheck(glEnable(GL_SCISSOR_TEST));
+
+    return activate(true);
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
+
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const std::vector<unsigned int>& internalFormats, const ContextSettings& settings)
 {
     // Store the dimensions
     m_width = width;
@@ -212,6 +293,14 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         if (settings.stencilBits && !GLEXT_packed_depth_stencil)
             return false;
 
+        // Check if the requested number of color attachments is supported
+        if (textureIds.size() > getMaximumAttachmentCount())
+        {
+            err() << "Impossible to create render texture (unsupported number of color attachments)";
+            err() << " Requested: " << textureIds.size() << " Maximum supported: " << getMaximumAttachmentCount() << std::endl;
+            return false;
+        }
+
 #ifndef SFML_OPENGL_ES
 
         // Check if the requested anti-aliasing level is supported
@@ -279,17 +368,22 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 
 #ifndef SFML_OPENGL_ES
 
-            // Create the multisample color buffer
-            GLuint color = 0;
-            glCheck(GLEXT_glGenRenderbuffers(1, &color));
-            m_colorBuffer = static_cast<unsigned int>(color);
-            if (!m_colorBuffer)
+            // Create a multisample color buffer for each attachment, in the format of its texture
+            for (std::size_t i = 0; i < textureIds.size(); ++i)
             {
-                err() << "Impossible to create render texture (failed to create the attached multisample color buffer)" << std::endl;
-                return false;
+                GLuint color = 0;
+                glCheck(GLEXT_glGenRenderbuffers(1, &color));
+                if (!color)
+                {
+                    err() << "Impossible to create render texture (failed to create the attached multisample color buffer)" << std::endl;
+                    return false;
+                }
+                m_colorBuffers.push_back(static_cast<unsigned int>(color));
+
+                GLenum internalFormat = internalFormats[i] ? static_cast<GLenum>(internalFormats[i]) : GL_RGBA;
+                glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, color));
+                glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, settings.antialiasingLevel, internalFormat, width, height));
             }
-            glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_colorBuffer));
-            glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, settings.antialiasingLevel, GL_RGBA, width, height));
 
             // Create the multisample depth/stencil buffer if requested
             if (settings.stencilBits)
@@ -333,8 +427,8 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         }
     }
 
-    // Save our texture ID in order to be able to attach it to an FBO at any time
-    m_textureId = textureId;
+    // Save our texture IDs in order to be able to attach them to an FBO at any time
+    m_textureIds = textureIds;
 
     // We can't create an FBO now if there is no active context
     if (!Context::getActiveContextId())
@@ -409,8 +503,11 @@ bool RenderTextureImplFBO::createFrameBuffer()
 
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
+    // Link the textures to the frame buffer
+    for (std::size_t i = 0; i < m_textureIds.size(); ++i)
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i), GL_TEXTURE_2D, m_textureIds[i], 0));
+
+    setDrawBuffers();
 
     // A final check, just to be sure...
     GLenum status;
@@ -424,7 +521,7 @@ bool RenderTextureImplFBO::createFrameBuffer()
     }
 
     {
-        Lock lock(mutex);
+        Lock lock(frameBufferMutex);
 
         // Insert the FBO into our map
         m_frameBuffers.insert(std::make_pair(Context::getActiveContextId(), static_cast<unsigned int>(frameBuffer)));
@@ -445,9 +542,14 @@ bool RenderTextureImplFBO::createFrameBuffer()
         }
         glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, multisampleFrameBuffer));
 
-        // Link the multisample color buffer to the frame buffer
-        glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_colorBuffer));
-        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GLEXT_GL_RENDERBUFFER, m_colorBuffer));
+        // Link the multisample color buffers to the frame buffer
+        for (std::size_t i = 0; i < m_colorBuffers.size(); ++i)
+        {
+            glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_colorBuffers[i]));
+            glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i), GLEXT_GL_RENDERBUFFER, m_colorBuffers[i]));
+        }
+
+        setDrawBuffers();
 
         // Link the depth/stencil renderbuffer to the frame buffer
         if (m_depthStencilBuffer)
@@ -471,7 +573,7 @@ bool RenderTextureImplFBO::createFrameBuffer()
         }
 
         {
-            Lock lock(mutex);
+            Lock lock(frameBufferMutex);
 
             // Insert the FBO into our map
             m_multisampleFrameBuffers.insert(std::make_pair(Context::getActiveContextId(), static_cast<unsigned int>(multisampleFrameBuffer)));
@@ -484,6 +586,27 @@ bool RenderTextureImplFBO::createFrameBuffer()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::setDrawBuffers()
+{
+    // A single attachment is the default draw buffer of a FBO already
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_textureIds.size() > 1)
+    {
+        std::vector<GLenum> drawBuffers(m_textureIds.size());
+        for (std::size_t i = 0; i < drawBuffers.size(); ++i)
+            drawBuffers[i] = GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+
+        glCheck(GLEXT_glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), &drawBuffers[0]));
+    }
+
+#endif
+
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplFBO::activate(bool active)
 {
@@ -519,7 +642,7 @@ bool RenderTextureImplFBO::activate(bool active)
     // If none is found, there is no FBO corresponding to the
     // currently active context so we will have to create a new FBO
     {
-        Lock lock(mutex);
+        Lock lock(frameBufferMutex);
 
         std::map<Uint64, unsigned int>::iterator iter;
         
@@ -552,7 +675,37 @@ bool RenderTextureImplFBO::activate(bool active)
 
 
 ////////////////////////////////////////////////////////////
-void RenderTextureImplFBO::updateTexture(unsigned int)
+bool RenderTextureImplFBO::updateTexture(unsigned int)
+{
+
+#ifndef SFML_OPENGL_ES
+
+    // The depth/stencil content is not needed once the frame is done,
+    // telling the driver saves tiled GPUs from storing it back to memory
+    if (m_depthStencilBuffer && GLEXT_invalidate_framebuffer)
+    {
+        // Keep the frame buffer of the current render target bound
+        GLint frameBuffer = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &frameBuffer));
+
+        if (activate(true))
+        {
+            GLenum attachments[] = {GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_STENCIL_ATTACHMENT};
+            glCheck(GLEXT_glInvalidateFramebuffer(GLEXT_GL_FRAMEBUFFER, m_stencil ? 2 : 1, attachments));
+        }
+
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, static_cast<GLuint>(frameBuffer)));
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // The multisample buffers are only resolved once the textures are actually used
+    return m_multisample && m_width && m_height;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::resolveTexture()
 {
     // If multisampling is enabled, we need to resolve by blitting
     // from our FBO with multisample renderbuffer attachments
@@ -560,13 +713,22 @@ void RenderTextureImplFBO::updateTexture(unsigned int)
 
 #ifndef SFML_OPENGL_ES
 
-    // In case of multisampling, make sure both FBOs
-    // are already available within the current context
-    if (m_multisample && m_width && m_height && activate(true))
+    if (!m_multisample || !m_width || !m_height)
+        return;
+
+    // The resolve may happen in the middle of drawing to another
+    // render target, so its frame buffers must be restored afterwards
+    GLint readFrameBuffer = 0;
+    GLint drawFrameBuffer = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_READ_FRAMEBUFFER_BINDING, &readFrameBuffer));
+    glCheck(glGetIntegerv(GLEXT_GL_DRAW_FRAMEBUFFER_BINDING, &drawFrameBuffer));
+
+    // Make sure both FBOs are already available within the current context
+    if (activate(true))
     {
         Uint64 contextId = Context::getActiveContextId();
 
-        Lock lock(mutex);
+        Lock lock(frameBufferMutex);
 
         std::map<Uint64, unsigned int>::iterator iter = m_frameBuffers.find(contextId);
         std::map<Uint64, unsigned int>::iterator multisampleIter = m_multisampleFrameBuffers.find(contextId);
@@ -575,11 +737,32 @@ void RenderTextureImplFBO::updateTexture(unsigned int)
         {
             // Set up the blit target (draw framebuffer) and blit (from the read framebuffer, our multisample FBO)
             glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, iter->second));
-            glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
-            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, multisampleIter->second));
+
+            if (m_textureIds.size() == 1)
+            {
+                glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+            }
+            else
+            {
+                // A blit only resolves the read buffer, so the attachments are resolved one after the other
+                for (std::size_t i = 0; i < m_textureIds.size(); ++i)
+                {
+                    GLenum attachment = GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+                    glCheck(glReadBuffer(attachment));
+                    glCheck(glDrawBuffer(attachment));
+                    glCheck(GLEXT_glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+                }
+
+                // Restore the draw buffers of the resolve FBO and the read buffer of the multisample FBO
+                setDrawBuffers();
+                glCheck(glReadBuffer(GLEXT_GL_COLOR_ATTACHMENT0));
+            }
         }
     }
 
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFrameBuffer)));
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFrameBuffer)));
+
 #endif // SFML_OPENGL_ES
 
 }
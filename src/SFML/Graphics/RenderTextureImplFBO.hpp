@@ -29,9 +29,11 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTextureImpl.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <map>
+#include <vector>
 
 
 namespace sf
@@ -75,26 +77,58 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumAntialiasingLevel();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a color format can be rendered to
+    ///
+    /// \param format Format of the color attachment
+    ///
+    /// \return True if the format is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatAvailable(RenderTexture::Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments supported by the system
+    ///
+    /// \return The maximum number of color attachments
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAttachmentCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Unbind the currently bound FBO
     ///
     ////////////////////////////////////////////////////////////
     static void unbind();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the target texture to the default frame buffer
+    ///
+    /// The copy is done with a blit in the current context, to
+    /// the default frame buffer of its window. The FBO is bound
+    /// again afterwards.
+    ///
+    /// \return True if the copy was done, false if blits are not
+    ///         supported or the FBO is multisampled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool blitToDefaultFrameBuffer();
+
 private:
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width      Width of the texture to render to
-    /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
-    /// \param settings   Context settings to create render-texture with
+    /// \param width           Width of the textures to render to
+    /// \param height          Height of the textures to render to
+    /// \param textureIds      OpenGL identifiers of the target textures
+    /// \param internalFormats OpenGL internal formats of the target textures (0 for the default RGBA format)
+    /// \param settings        Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings);
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const std::vector<unsigned int>& internalFormats, const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an FBO in the current context
@@ -104,6 +138,12 @@ private:
     ////////////////////////////////////////////////////////////
     bool createFrameBuffer();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Direct the fragment outputs to all the color attachments of the bound FBO
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrawBuffers();
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
     ///
@@ -117,10 +157,21 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Update the pixels of the target texture
     ///
+    /// The depth/stencil content is discarded, and multisampled
+    /// content is only resolved later by resolveTexture.
+    ///
     /// \param textureId OpenGL identifier of the target texture
     ///
+    /// \return True if the multisample buffers still have to be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool updateTexture(unsigned textureId);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve the multisample buffers into the target textures
+    ///
     ////////////////////////////////////////////////////////////
-    virtual void updateTexture(unsigned textureId);
+    virtual void resolveTexture();
 
     ////////////////////////////////////////////////////////////
     // Member data
@@ -128,11 +179,11 @@ private:
     std::map<Uint64, unsigned int> m_frameBuffers;            ///< OpenGL frame buffer objects per context
     std::map<Uint64, unsigned int> m_multisampleFrameBuffers; ///< Optional per-context OpenGL frame buffer objects with multisample attachments
     unsigned int                   m_depthStencilBuffer;      ///< Optional depth/stencil buffer attached to the frame buffer
-    unsigned int                   m_colorBuffer;             ///< Optional multisample color buffer attached to the frame buffer
+    std::vector<unsigned int>      m_colorBuffers;            ///< Optional multisample color buffers attached to the frame buffer
     unsigned int                   m_width;                   ///< Width of the attachments
     unsigned int                   m_height;                  ///< Height of the attachments
     Context*                       m_context;                 ///< Backup OpenGL context, used when none already exist
-    unsigned int                   m_textureId;               ///< The ID of the texture to attach to the FBO
+    std::vector<unsigned int>      m_textureIds;              ///< The IDs of the textures to attach to the FBO
     bool                           m_multisample;             ///< Whether we have to create a multisample frame buffer as well
     bool                           m_stencil;                 ///< Whether we have stencil attachment
 };
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Check whether two sets of settings create the same render-texture
+    bool sameSettings(const sf::ContextSettings& left, const sf::ContextSettings& right)
+    {
+        return (left.depthBits         == right.depthBits)         &&
+               (left.stencilBits       == right.stencilBits)       &&
+               (left.antialiasingLevel == right.antialiasingLevel) &&
+               (left.majorVersion      == right.majorVersion)      &&
+               (left.minorVersion      == right.minorVersion)      &&
+               (left.attributeFlags    == right.attributeFlags)    &&
+               (left.sRgbCapable       == right.sRgbCapable);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_entries()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, const ContextSettings& settings)
+{
+    // Reuse a released render-texture created with the same parameters
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (!it->used && (it->width == width) && (it->height == height) && sameSettings(it->settings, settings))
+        {
+            // Give it the state of a newly created render-texture
+            RenderTexture* renderTexture = it->renderTexture;
+            renderTexture->setView(renderTexture->getDefaultView());
+            renderTexture->setSmooth(false);
+            renderTexture->setRepeated(false);
+
+            it->used = true;
+            return renderTexture;
+        }
+    }
+
+    // None available, create a new one
+    RenderTexture* renderTexture = new RenderTexture;
+    if (!renderTexture->create(width, height, settings))
+    {
+        delete renderTexture;
+        return NULL;
+    }
+
+    Entry entry;
+    entry.renderTexture = renderTexture;
+    entry.width = width;
+    entry.height = height;
+    entry.settings = settings;
+    entry.used = true;
+    m_entries.push_back(entry);
+
+    return renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* renderTexture)
+{
+    if (!renderTexture)
+        return;
+
+    for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->renderTexture == renderTexture)
+        {
+            it->used = false;
+            return;
+        }
+    }
+
+    err() << "Failed to release render-texture: it doesn't belong to the pool" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::clear()
+{
+    std::vector<Entry>::iterator it = m_entries.begin();
+    while (it != m_entries.end())
+    {
+        if (!it->used)
+        {
+            delete it->renderTexture;
+            it = m_entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getCount() const
+{
+    return m_entries.size();
+}
+
+} // namespace sf
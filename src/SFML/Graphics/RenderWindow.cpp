@@ -29,19 +29,52 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Number of displayed frames whose damage is remembered, back buffers are rarely older
+    const std::size_t maxDamageHistory = 4;
+
+    // Get the smallest rectangle containing two rectangles, ignoring empty ones
+    sf::IntRect combineAreas(const sf::IntRect& a, const sf::IntRect& b)
+    {
+        if ((a.width <= 0) || (a.height <= 0))
+            return b;
+
+        if ((b.width <= 0) || (b.height <= 0))
+            return a;
+
+        int left   = std::min(a.left, b.left);
+        int top    = std::min(a.top, b.top);
+        int right  = std::max(a.left + a.width, b.left + b.width);
+        int bottom = std::max(a.top + a.height, b.top + b.height);
+
+        return sf::IntRect(left, top, right - left, bottom - top);
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow()
+RenderWindow::RenderWindow() :
+m_damageHistory (),
+m_captureTexture(NULL),
+m_captureBuffer (NULL)
 {
     // Nothing to do
 }
 
 
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings)
+RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
+m_damageHistory (),
+m_captureTexture(NULL),
+m_captureBuffer (NULL)
 {
     // Don't call the base class constructor because it contains virtual function calls
     create(mode, title, style, settings);
@@ -49,7 +82,10 @@ RenderWindow::RenderWindow(VideoMode mode, const String& title, Uint32 style, co
 
 
 ////////////////////////////////////////////////////////////
-RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings)
+RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings) :
+m_damageHistory (),
+m_captureTexture(NULL),
+m_captureBuffer (NULL)
 {
     // Don't call the base class constructor because it contains virtual function calls
     create(handle, settings);
@@ -59,7 +95,7 @@ RenderWindow::RenderWindow(WindowHandle handle, const ContextSettings& settings)
 ////////////////////////////////////////////////////////////
 RenderWindow::~RenderWindow()
 {
-    // Nothing to do
+    destroyCaptureBuffer();
 }
 
 
@@ -83,6 +119,10 @@ bool RenderWindow::setActive(bool active)
     // try to draw to the default framebuffer of the RenderWindow
     if (result && priv::RenderTextureImplFBO::isAvailable())
     {
+        // Frames being captured are drawn to the capture FBO instead
+        if (active && m_captureBuffer)
+            return static_cast<priv::RenderTextureImpl*>(m_captureBuffer)->activate(true);
+
         priv::RenderTextureImplFBO::unbind();
 
         return true;
@@ -92,9 +132,94 @@ bool RenderWindow::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+IntRect RenderWindow::getRepaintArea() const
+{
+    Vector2u size = getSize();
+    IntRect window(0, 0, static_cast<int>(size.x), static_cast<int>(size.y));
+
+    if (!isDamageTrackingEnabled())
+        return window;
+
+    // The contents of the back buffer are undefined, or older than the damage we know;
+    // the capture buffer always holds the previous frame
+    unsigned int age = m_captureBuffer ? 1 : getBackBufferAge();
+    if ((age == 0) || (age > m_damageHistory.size() + 1))
+        return window;
+
+    IntRect area;
+    const std::vector<IntRect>& damage = getDamage();
+    for (std::vector<IntRect>::const_iterator it = damage.begin(); it != damage.end(); ++it)
+        area = combineAreas(area, *it);
+
+    for (std::size_t i = 0; i + 1 < age; ++i)
+        area = combineAreas(area, m_damageHistory[i]);
+
+    return area;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderWindow::setCaptureEnabled(bool enabled)
+{
+    if (enabled == isCaptureEnabled())
+        return true;
+
+    if (!enabled)
+    {
+        destroyCaptureBuffer();
+
+        // Draw to the back buffer again
+        setActive(true);
+        return true;
+    }
+
+    if (!priv::RenderTextureImplFBO::isAvailable() || !setActive(true))
+    {
+        err() << "Failed to enable frame capture (frame buffer objects are not available)" << std::endl;
+        return false;
+    }
+
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_blit)
+    {
+        err() << "Failed to enable frame capture (frame buffer blits are not available)" << std::endl;
+        return false;
+    }
+
+    // A single-sampled frame buffer can't be blitted to a multisampled one
+    if (getSettings().antialiasingLevel > 0)
+    {
+        err() << "Failed to enable frame capture (the window is multisampled)" << std::endl;
+        return false;
+    }
+
+    return createCaptureBuffer();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderWindow::isCaptureEnabled() const
+{
+    return m_captureBuffer != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* RenderWindow::getCaptureTexture() const
+{
+    return m_captureTexture;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
+    // The captured frame is already in a texture
+    if (m_captureTexture)
+        return m_captureTexture->copyToImage();
+
     Vector2u windowSize = getSize();
 
     Texture texture;
@@ -118,6 +243,113 @@ void RenderWindow::onResize()
 {
     // Update the current view (recompute the viewport, which is stored in relative coordinates)
     setView(getView());
+
+    // The damage of the previous frames refers to buffers of the old size
+    m_damageHistory.clear();
+
+    // The capture buffer follows the size of the window
+    if (m_captureBuffer)
+        createCaptureBuffer();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::onDisplay()
+{
+    // Submit the pending batched geometry before presenting the frame
+    flush();
+
+    // Close the statistics of the frame before it is presented
+    endFrame();
+
+    // Keep the captured frame in the texture and copy it to the back buffer
+    if (m_captureBuffer && setActive(true))
+    {
+        static_cast<priv::RenderTextureImpl*>(m_captureBuffer)->updateTexture(m_captureTexture->m_texture);
+        m_captureTexture->m_pixelsFlipped = true;
+        m_captureTexture->invalidateMipmap();
+
+        m_captureBuffer->blitToDefaultFrameBuffer();
+    }
+
+    if (!isDamageTrackingEnabled())
+    {
+        Window::onDisplay();
+        return;
+    }
+
+    // The window system expects rectangles with their origin at the bottom-left corner
+    const std::vector<IntRect>& damage = getDamage();
+    int height = static_cast<int>(getSize().y);
+    std::vector<int> rects;
+    rects.reserve(damage.size() * 4);
+
+    IntRect bounds;
+    for (std::vector<IntRect>::const_iterator it = damage.begin(); it != damage.end(); ++it)
+    {
+        rects.push_back(it->left);
+        rects.push_back(height - (it->top + it->height));
+        rects.push_back(it->width);
+        rects.push_back(it->height);
+
+        bounds = combineAreas(bounds, *it);
+    }
+
+    Window::displayDamage(rects.empty() ? NULL : &rects[0], damage.size());
+
+    // Remember the damage, the back buffers of the next frames may be older than the last frame
+    m_damageHistory.insert(m_damageHistory.begin(), bounds);
+    if (m_damageHistory.size() > maxDamageHistory)
+        m_damageHistory.pop_back();
+
+    clearDamage();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderWindow::createCaptureBuffer()
+{
+    destroyCaptureBuffer();
+
+    Vector2u size = getSize();
+    ContextSettings windowSettings = getSettings();
+    ContextSettings settings(windowSettings.depthBits, windowSettings.stencilBits);
+
+    m_captureTexture = new Texture;
+    m_captureBuffer = new priv::RenderTextureImplFBO;
+
+    std::vector<unsigned int> textureIds(1, 0);
+    std::vector<unsigned int> internalFormats(1, 0);
+
+    if (size.x && size.y && m_captureTexture->create(size.x, size.y))
+    {
+        m_captureTexture->m_fboAttachment = true;
+        textureIds[0] = m_captureTexture->m_texture;
+
+        if (static_cast<priv::RenderTextureImpl*>(m_captureBuffer)->create(size.x, size.y, textureIds, internalFormats, settings))
+        {
+            // Bind the new frame buffer for the next draws
+            setActive(true);
+            return true;
+        }
+    }
+
+    err() << "Failed to create the frame capture buffer" << std::endl;
+    destroyCaptureBuffer();
+    setActive(true);
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderWindow::destroyCaptureBuffer()
+{
+    delete m_captureBuffer;
+    m_captureBuffer = NULL;
+
+    delete m_captureTexture;
+    m_captureTexture = NULL;
 }
 
 } // namespace sf
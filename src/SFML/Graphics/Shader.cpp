@@ -29,17 +29,42 @@
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/CorePipeline.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 
 
+namespace
+{
+    sf::Mutex shaderIdMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueShaderId()
+    {
+        sf::Lock lock(shaderIdMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no shader"
+
+        return id++;
+    }
+}
+
+
 #ifndef SFML_OPENGL_ES
 
 #if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
@@ -57,7 +82,163 @@
 namespace
 {
     sf::Mutex maxTextureUnitsMutex;
-    sf::Mutex isAvailableMutex;
+    sf::Mutex shaderAvailableMutex;
+    sf::Mutex binaryCacheMutex;
+
+    // Directory of the program binary cache, empty if the cache is disabled
+    std::string binaryCacheDirectory;
+
+    // Signature at the beginning of the program binary cache files
+    const char binaryCacheMagic[8] = {'S', 'F', 'M', 'L', 'P', 'R', 'G', '1'};
+
+    // Mix a string into a FNV-1a hash
+    void hashString(sf::Uint64& hash, const char* string)
+    {
+        for (; string && *string; ++string)
+        {
+            hash ^= static_cast<unsigned char>(*string);
+            hash *= 1099511628211ULL;
+        }
+
+        // Mix a separator too, so that the boundaries between strings matter
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+    }
+
+    // Get the path of the cache file of a program, empty if the program must be compiled from source
+    std::string getBinaryCachePath(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, const char* computeShaderCode)
+    {
+        std::string directory;
+        {
+            sf::Lock lock(binaryCacheMutex);
+            directory = binaryCacheDirectory;
+        }
+
+        if (directory.empty() || !GLEXT_get_program_binary)
+            return "";
+
+        // Some drivers expose the extension without supporting any format
+        GLint formatCount = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+        if (formatCount <= 0)
+            return "";
+
+        // Binaries are only valid for the driver that produced them, so it is part of the key
+        sf::Uint64 hash = 14695981039346656037ULL;
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+        hashString(hash, vertexShaderCode);
+        hashString(hash, geometryShaderCode);
+        hashString(hash, fragmentShaderCode);
+        hashString(hash, computeShaderCode);
+
+        std::ostringstream path;
+        path << directory;
+        if ((*directory.rbegin() != '/') && (*directory.rbegin() != '\\'))
+            path << '/';
+        path << std::hex << std::setfill('0') << std::setw(16) << hash << ".bin";
+
+        return path.str();
+    }
+
+    // Load a program from the binary cache, returns false if it must be compiled from source
+    bool loadProgramBinary(GLuint program, const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        char magic[sizeof(binaryCacheMagic)];
+        sf::Uint32 format = 0;
+        sf::Uint32 length = 0;
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&format), sizeof(format));
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+        if (!file || (std::memcmp(magic, binaryCacheMagic, sizeof(magic)) != 0) || (length == 0))
+            return false;
+
+        std::vector<char> binary(length);
+        file.read(&binary[0], length);
+        if (!file)
+            return false;
+
+        // The driver rejects binaries it can't load anymore (after an update for example)
+        glCheck(GLEXT_glProgramBinary(program, format, &binary[0], static_cast<GLsizei>(length)));
+
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(castToGlHandle(program), GLEXT_GL_OBJECT_LINK_STATUS, &success));
+
+        return success == GL_TRUE;
+    }
+
+    // Store the binary of a linked program in the cache
+    void saveProgramBinary(GLuint program, const std::string& path)
+    {
+        GLint length = 0;
+        glCheck(GLEXT_glGetObjectParameteriv(castToGlHandle(program), GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLsizei written = 0;
+        GLenum format = 0;
+        glCheck(GLEXT_glGetProgramBinary(program, length, &written, &format, &binary[0]));
+        if (written <= 0)
+            return;
+
+        std::ofstream file(path.c_str(), std::ios_base::binary | std::ios_base::out | std::ios_base::trunc);
+        if (!file)
+        {
+            sf::err() << "Failed to write shader binary cache file \"" << path << "\"" << std::endl;
+            return;
+        }
+
+        sf::Uint32 formatValue = static_cast<sf::Uint32>(format);
+        sf::Uint32 lengthValue = static_cast<sf::Uint32>(written);
+        file.write(binaryCacheMagic, sizeof(binaryCacheMagic));
+        file.write(reinterpret_cast<const char*>(&formatValue), sizeof(formatValue));
+        file.write(reinterpret_cast<const char*>(&lengthValue), sizeof(lengthValue));
+        file.write(&binary[0], written);
+    }
+
+    // Create and compile a shader and attach it to a program. If pendingShaders is not NULL,
+    // the shader is added to it instead of checking the result, which would wait for the driver
+    bool attachShader(GLEXT_GLhandle program, GLenum type, const char* typeName, const char* code, std::vector<unsigned int>* pendingShaders)
+    {
+        // Create and compile the shader
+        GLEXT_GLhandle shader;
+        glCheck(shader = GLEXT_glCreateShaderObject(type));
+        glCheck(GLEXT_glShaderSource(shader, 1, &code, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        // Attach the shader to the program
+        glCheck(GLEXT_glAttachObject(program, shader));
+
+        if (pendingShaders)
+        {
+            pendingShaders->push_back(castFromGlHandle(shader));
+            return true;
+        }
+
+        // Check the compile log
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile " << typeName << " shader:" << std::endl
+                      << log << std::endl;
+            glCheck(GLEXT_glDeleteObject(shader));
+            return false;
+        }
+
+        // Delete the shader (not needed anymore)
+        glCheck(GLEXT_glDeleteObject(shader));
+        return true;
+    }
 
     GLint checkMaxTextureUnits()
     {
@@ -78,29 +259,6 @@ namespace
         return maxUnits;
     }
 
-    // Read the contents of a file into an array of char
-    bool getFileContents(const std::string& filename, std::vector<char>& buffer)
-    {
-        std::ifstream file(filename.c_str(), std::ios_base::binary);
-        if (file)
-        {
-            file.seekg(0, std::ios_base::end);
-            std::streamsize size = file.tellg();
-            if (size > 0)
-            {
-                file.seekg(0, std::ios_base::beg);
-                buffer.resize(static_cast<std::size_t>(size));
-                file.read(&buffer[0], size);
-            }
-            buffer.push_back('\0');
-            return true;
-        }
-        else
-        {
-            return false;
-        }
-    }
-
     // Read the contents of a stream into an array of char
     bool getStreamContents(sf::InputStream& stream, std::vector<char>& buffer)
     {
@@ -117,6 +275,17 @@ namespace
         return success;
     }
 
+    // Read the contents of a file into an array of char
+    bool getFileContents(const std::string& filename, std::vector<char>& buffer)
+    {
+        // Go through a file stream so that mounted archives are searched too
+        sf::FileInputStream file;
+        if (!file.open(filename))
+            return false;
+
+        return getStreamContents(file, buffer);
+    }
+
     // Transforms an array of 2D vectors into a contiguous array of scalars
     template <typename T>
     std::vector<T> flatten(const sf::Vector2<T>* vectorArray, std::size_t length)
@@ -183,20 +352,18 @@ struct Shader::UniformBinder : private NonCopyable
     /// \brief Constructor: set up state before uniform is set
     ///
     ////////////////////////////////////////////////////////////
-    UniformBinder(Shader& shader, const std::string& name) :
+    UniformBinder(Shader& shader, const UniformHandle& handle) :
     savedProgram(0),
     currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
+    location(currentProgram ? shader.getLocation(handle) : -1)
     {
-        if (currentProgram)
+        // Nothing to bind if the uniform can't be set
+        if (location != -1)
         {
             // Enable program object
             glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
             if (currentProgram != savedProgram)
                 glCheck(GLEXT_glUseProgramObject(currentProgram));
-
-            // Store uniform location for further use outside constructor
-            location = shader.getUniformLocation(name);
         }
     }
 
@@ -207,7 +374,7 @@ struct Shader::UniformBinder : private NonCopyable
     ~UniformBinder()
     {
         // Disable program object
-        if (currentProgram && (currentProgram != savedProgram))
+        if ((location != -1) && (currentProgram != savedProgram))
             glCheck(GLEXT_glUseProgramObject(savedProgram));
     }
 
@@ -218,12 +385,37 @@ struct Shader::UniformBinder : private NonCopyable
 };
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformValue::UniformValue() :
+type  (Float),
+size  (0),
+count (0),
+floats(),
+ints  (),
+dirty (false)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1),
-m_textures      (),
-m_uniforms      ()
+m_shaderProgram     (0),
+m_currentTexture    (-1),
+m_textures          (),
+m_uniforms          (),
+m_cacheId           (getUniqueShaderId()),
+m_programId         (0),
+m_uniformsDeferred  (false),
+m_uniformValues     (),
+m_dirtyUniforms     (),
+m_uniformBlocks     (),
+m_storageBuffers    (),
+m_images            (),
+m_computeProgram    (false),
+m_asyncCompilation  (false),
+m_compilationPending(false),
+m_pendingShaders    (),
+m_pendingCachePath  ()
 {
 }
 
@@ -233,6 +425,29 @@ Shader::~Shader()
 {
     TransientContextLock lock;
 
+    // Destroy the uniform buffers
+    for (UniformBlockTable::const_iterator it = m_uniformBlocks.begin(); it != m_uniformBlocks.end(); ++it)
+    {
+        if (it->second.buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(it->second.buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+    // Destroy the storage buffers created by the shader
+    for (StorageBufferTable::const_iterator it = m_storageBuffers.begin(); it != m_storageBuffers.end(); ++it)
+    {
+        if (it->second.owned && it->second.buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(it->second.buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+    // Destroy the shaders of a compilation still in progress
+    discardPendingShaders();
+
     // Destroy effect program
     if (m_shaderProgram)
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
@@ -252,11 +467,13 @@ bool Shader::loadFromFile(const std::string& filename, Type type)
 
     // Compile the shader program
     if (type == Vertex)
-        return compile(&shader[0], NULL, NULL);
+        return compile(&shader[0], NULL, NULL, NULL);
     else if (type == Geometry)
-        return compile(NULL, &shader[0], NULL);
+        return compile(NULL, &shader[0], NULL, NULL);
+    else if (type == Fragment)
+        return compile(NULL, NULL, &shader[0], NULL);
     else
-        return compile(NULL, NULL, &shader[0]);
+        return compile(NULL, NULL, NULL, &shader[0]);
 }
 
 
@@ -280,7 +497,7 @@ bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::st
     }
 
     // Compile the shader program
-    return compile(&vertexShader[0], NULL, &fragmentShader[0]);
+    return compile(&vertexShader[0], NULL, &fragmentShader[0], NULL);
 }
 
 
@@ -312,7 +529,7 @@ bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::st
     }
 
     // Compile the shader program
-    return compile(&vertexShader[0], &geometryShader[0], &fragmentShader[0]);
+    return compile(&vertexShader[0], &geometryShader[0], &fragmentShader[0], NULL);
 }
 
 
@@ -321,11 +538,13 @@ bool Shader::loadFromMemory(const std::string& shader, Type type)
 {
     // Compile the shader program
     if (type == Vertex)
-        return compile(shader.c_str(), NULL, NULL);
+        return compile(shader.c_str(), NULL, NULL, NULL);
     else if (type == Geometry)
-        return compile(NULL, shader.c_str(), NULL);
+        return compile(NULL, shader.c_str(), NULL, NULL);
+    else if (type == Fragment)
+        return compile(NULL, NULL, shader.c_str(), NULL);
     else
-        return compile(NULL, NULL, shader.c_str());
+        return compile(NULL, NULL, NULL, shader.c_str());
 }
 
 
@@ -333,7 +552,7 @@ bool Shader::loadFromMemory(const std::string& shader, Type type)
 bool Shader::loadFromMemory(const std::string& vertexShader, const std::string& fragmentShader)
 {
     // Compile the shader program
-    return compile(vertexShader.c_str(), NULL, fragmentShader.c_str());
+    return compile(vertexShader.c_str(), NULL, fragmentShader.c_str(), NULL);
 }
 
 
@@ -341,7 +560,7 @@ bool Shader::loadFromMemory(const std::string& vertexShader, const std::string&
 bool Shader::loadFromMemory(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
 {
     // Compile the shader program
-    return compile(vertexShader.c_str(), geometryShader.c_str(), fragmentShader.c_str());
+    return compile(vertexShader.c_str(), geometryShader.c_str(), fragmentShader.c_str(), NULL);
 }
 
 
@@ -358,11 +577,13 @@ bool Shader::loadFromStream(InputStream& stream, Type type)
 
     // Compile the shader program
     if (type == Vertex)
-        return compile(&shader[0], NULL, NULL);
+        return compile(&shader[0], NULL, NULL, NULL);
     else if (type == Geometry)
-        return compile(NULL, &shader[0], NULL);
+        return compile(NULL, &shader[0], NULL, NULL);
+    else if (type == Fragment)
+        return compile(NULL, NULL, &shader[0], NULL);
     else
-        return compile(NULL, NULL, &shader[0]);
+        return compile(NULL, NULL, NULL, &shader[0]);
 }
 
 
@@ -386,7 +607,7 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& fragme
     }
 
     // Compile the shader program
-    return compile(&vertexShader[0], NULL, &fragmentShader[0]);
+    return compile(&vertexShader[0], NULL, &fragmentShader[0], NULL);
 }
 
 
@@ -418,331 +639,920 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
     }
 
     // Compile the shader program
-    return compile(&vertexShader[0], &geometryShader[0], &fragmentShader[0]);
+    return compile(&vertexShader[0], &geometryShader[0], &fragmentShader[0], NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    finishCompilation();
+
+    if (!m_shaderProgram)
+        return UniformHandle();
+
+    // Only request the location from OpenGL if it's not in cache
+    UniformTable::const_iterator it = m_uniforms.find(name);
+    if (it != m_uniforms.end())
+        return UniformHandle(it->second, m_programId);
+
+    TransientContextLock lock;
+
+    return UniformHandle(getUniformLocation(name), m_programId);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1f(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, int x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1i(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, bool x)
 {
-    setUniform(name, static_cast<int>(x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec2& v)
 {
-    setUniform(name, Glsl::Ivec2(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec3& v)
 {
-    setUniform(name, Glsl::Ivec3(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec4& v)
 {
-    setUniform(name, Glsl::Ivec4(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat3& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat4& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Texture& texture)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
-
-        // Find the location of the variable in the shader
-        int location = getUniformLocation(name);
-        if (location != -1)
-        {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
-            {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
-                {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
-                }
-
-                m_textures[location] = &texture;
-            }
-            else
-            {
-                // Location already used, just replace the texture
-                it->second = &texture;
-            }
-        }
-    }
+    setUniform(getUniformHandle(name), texture);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, CurrentTextureType)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
+    setUniform(getUniformHandle(name), CurrentTexture);
+}
 
-        // Find the location of the variable in the shader
-        m_currentTexture = getUniformLocation(name);
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const std::string& name, const BindlessHandle& bindlessHandle)
+{
+    setUniform(getUniformHandle(name), bindlessHandle);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1fv(binder.location, static_cast<GLsizei>(length), scalarArray));
+    setUniformArray(getUniformHandle(name), scalarArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformArray(getUniformHandle(name), vectorArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformArray(getUniformHandle(name), vectorArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorArray, std::size_t length)
 {
-    std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+    setUniformArray(getUniformHandle(name), vectorArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixArray, std::size_t length)
 {
-    const std::size_t matrixSize = 3 * 3;
-
-    std::vector<float> contiguous(matrixSize * length);
-    for (std::size_t i = 0; i < length; ++i)
-        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+    setUniformArray(getUniformHandle(name), matrixArray, length);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length)
 {
-    const std::size_t matrixSize = 4 * 4;
+    setUniformArray(getUniformHandle(name), matrixArray, length);
+}
 
-    std::vector<float> contiguous(matrixSize * length);
-    for (std::size_t i = 0; i < length; ++i)
-        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, float x)
+{
+    if (deferUniform(handle, UniformValue::Float, 1, 1, &x, NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+        glCheck(GLEXT_glUniform1f(binder.location, x));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Vec2& v)
 {
-    setUniform(name, x);
+    const float values[] = {v.x, v.y};
+    if (deferUniform(handle, UniformValue::Float, 2, 1, values, NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Vec3& v)
 {
-    setUniform(name, Glsl::Vec2(x, y));
+    const float values[] = {v.x, v.y, v.z};
+    if (deferUniform(handle, UniformValue::Float, 3, 1, values, NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y, float z)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Vec4& v)
 {
-    setUniform(name, Glsl::Vec3(x, y, z));
+    const float values[] = {v.x, v.y, v.z, v.w};
+    if (deferUniform(handle, UniformValue::Float, 4, 1, values, NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
+void Shader::setUniform(const UniformHandle& handle, int x)
 {
-    setUniform(name, Glsl::Vec4(x, y, z, w));
+    if (deferUniform(handle, UniformValue::Int, 1, 1, NULL, &x))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform1i(binder.location, x));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Vector2f& v)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Ivec2& v)
 {
-    setUniform(name, v);
+    const int values[] = {v.x, v.y};
+    if (deferUniform(handle, UniformValue::Int, 2, 1, NULL, values))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Vector3f& v)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Ivec3& v)
 {
-    setUniform(name, v);
+    const int values[] = {v.x, v.y, v.z};
+    if (deferUniform(handle, UniformValue::Int, 3, 1, NULL, values))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Color& color)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Ivec4& v)
 {
-    setUniform(name, Glsl::Vec4(color));
+    const int values[] = {v.x, v.y, v.z, v.w};
+    if (deferUniform(handle, UniformValue::Int, 4, 1, NULL, values))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Transform& transform)
+void Shader::setUniform(const UniformHandle& handle, bool x)
 {
-    setUniform(name, Glsl::Mat4(transform));
+    setUniform(handle, static_cast<int>(x));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, const Texture& texture)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Bvec2& v)
 {
-    setUniform(name, texture);
+    setUniform(handle, Glsl::Ivec2(v));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::setParameter(const std::string& name, CurrentTextureType)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Bvec3& v)
 {
-    setUniform(name, CurrentTexture);
+    setUniform(handle, Glsl::Ivec3(v));
 }
 
 
 ////////////////////////////////////////////////////////////
-unsigned int Shader::getNativeHandle() const
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Bvec4& v)
 {
-    return m_shaderProgram;
+    setUniform(handle, Glsl::Ivec4(v));
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shader::bind(const Shader* shader)
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Mat3& matrix)
 {
-    TransientContextLock lock;
+    if (deferUniform(handle, UniformValue::Matrix, 9, 1, matrix.array, NULL))
+        return;
 
-    // Make sure that we can use shaders
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Mat4& matrix)
+{
+    if (deferUniform(handle, UniformValue::Matrix, 16, 1, matrix.array, NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Texture& texture)
+{
+    if (m_shaderProgram)
+    {
+        TransientContextLock lock;
+
+        // Find the location of the variable in the shader
+        int location = getLocation(handle);
+        if (location != -1)
+        {
+            // Store the location -> texture mapping
+            TextureTable::iterator it = m_textures.find(location);
+            if (it == m_textures.end())
+            {
+                // New entry, make sure there are enough texture units
+                GLint maxUnits = getMaxTextureUnits();
+                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+                {
+                    err() << "Impossible to use texture for shader: all available texture units are used" << std::endl;
+                    return;
+                }
+
+                m_textures[location] = &texture;
+            }
+            else
+            {
+                // Location already used, just replace the texture
+                it->second = &texture;
+            }
+
+            // The textures must be bound again
+            m_cacheId = getUniqueShaderId();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, CurrentTextureType)
+{
+    if (m_shaderProgram)
+    {
+        TransientContextLock lock;
+
+        // Find the location of the variable in the shader
+        m_currentTexture = getLocation(handle);
+
+        // The current texture unit must be set again
+        m_cacheId = getUniqueShaderId();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const BindlessHandle& bindlessHandle)
+{
+    UniformBinder binder(*this, handle);
+    if ((binder.location != -1) && GLEXT_bindless_texture)
+        glCheck(GLEXT_glUniformHandleui64(binder.location, bindlessHandle.handle));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const float* scalarArray, std::size_t length)
+{
+    if (deferUniform(handle, UniformValue::Float, 1, length, scalarArray, NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform1fv(binder.location, static_cast<GLsizei>(length), scalarArray));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+
+    if (deferUniform(handle, UniformValue::Float, 2, length, &contiguous[0], NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform2fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+
+    if (deferUniform(handle, UniformValue::Float, 3, length, &contiguous[0], NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform3fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+    std::vector<float> contiguous = flatten(vectorArray, length);
+
+    if (deferUniform(handle, UniformValue::Float, 4, length, &contiguous[0], NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniform4fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+    const std::size_t matrixSize = 3 * 3;
+
+    std::vector<float> contiguous(matrixSize * length);
+    for (std::size_t i = 0; i < length; ++i)
+        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
+
+    if (deferUniform(handle, UniformValue::Matrix, 9, length, &contiguous[0], NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniformMatrix3fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+    const std::size_t matrixSize = 4 * 4;
+
+    std::vector<float> contiguous(matrixSize * length);
+    for (std::size_t i = 0; i < length; ++i)
+        priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
+
+    if (deferUniform(handle, UniformValue::Matrix, 16, length, &contiguous[0], NULL))
+        return;
+
+    UniformBinder binder(*this, handle);
+    if (binder.location != -1)
+        glCheck(GLEXT_glUniformMatrix4fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, const void* data, std::size_t size)
+{
+    finishCompilation();
+
+    if (!m_shaderProgram || !data)
+        return;
+
+    TransientContextLock lock;
+
+    if (!isUniformBlockAvailable())
+    {
+        err() << "Failed to set uniform block \"" << name << "\": your system doesn't support uniform blocks "
+              << "(you should test Shader::isUniformBlockAvailable() before trying to use them)" << std::endl;
+        return;
+    }
+
+    // Create the uniform buffer of the block the first time it is set
+    UniformBlockTable::iterator it = m_uniformBlocks.find(name);
+    if (it == m_uniformBlocks.end())
+    {
+        UniformBlock block;
+        block.buffer = 0;
+        block.binding = static_cast<unsigned int>(m_uniformBlocks.size());
+        block.size = 0;
+
+        GLuint index;
+        glCheck(index = GLEXT_glGetUniformBlockIndex(m_shaderProgram, name.c_str()));
+
+        GLint maxBindings = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxBindings));
+
+        if (index == GLEXT_GL_INVALID_INDEX)
+        {
+            err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+        }
+        else if (block.binding >= static_cast<unsigned int>(maxBindings))
+        {
+            err() << "Impossible to use uniform block \"" << name << "\" for shader: all available binding points are used" << std::endl;
+        }
+        else
+        {
+            GLint blockSize = 0;
+            glCheck(GLEXT_glGetActiveUniformBlockiv(m_shaderProgram, index, GLEXT_GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize));
+            glCheck(GLEXT_glUniformBlockBinding(m_shaderProgram, index, block.binding));
+
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            block.buffer = static_cast<unsigned int>(buffer);
+            block.size = static_cast<std::size_t>(blockSize);
+
+            // The new buffer must be attached the next time the shader is bound
+            m_cacheId = getUniqueShaderId();
+        }
+
+        // Missing blocks are remembered too, so that they are only reported once
+        it = m_uniformBlocks.insert(std::make_pair(name, block)).first;
+    }
+
+    const UniformBlock& block = it->second;
+    if (!block.buffer)
+        return;
+
+    if (size < block.size)
+    {
+        err() << "Failed to set uniform block \"" << name << "\": " << size << " bytes given, "
+              << "the block needs " << block.size << std::endl;
+        return;
+    }
+
+    // Respecifying the whole store lets the driver give us fresh
+    // memory instead of waiting for draws still using the old contents
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, block.buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, static_cast<GLsizeiptrARB>(block.size), data, GLEXT_GL_DYNAMIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setStorageBuffer(const std::string& name, const void* data, std::size_t size)
+{
+    finishCompilation();
+
+    if (!m_shaderProgram || !size)
+        return;
+
+    TransientContextLock lock;
+
+    StorageBuffer* storageBuffer = getStorageBuffer(name);
+    if (!storageBuffer)
+        return;
+
+    // Create our own buffer if the block used none, or one provided by the user
+    if (!storageBuffer->owned || !storageBuffer->buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        storageBuffer->buffer = static_cast<unsigned int>(buffer);
+        storageBuffer->owned = true;
+
+        // The new buffer must be attached the next time the shader is bound
+        m_cacheId = getUniqueShaderId();
+    }
+
+    storageBuffer->size = size;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_SHADER_STORAGE_BUFFER, storageBuffer->buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptrARB>(size), data, GLEXT_GL_DYNAMIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_SHADER_STORAGE_BUFFER, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setStorageBuffer(const std::string& name, const VertexBuffer& vertexBuffer)
+{
+    finishCompilation();
+
+    if (!m_shaderProgram || !vertexBuffer.getNativeHandle())
+        return;
+
+    TransientContextLock lock;
+
+    StorageBuffer* storageBuffer = getStorageBuffer(name);
+    if (!storageBuffer)
+        return;
+
+    // Release the buffer the shader created for the block, if any
+    if (storageBuffer->owned && storageBuffer->buffer)
+    {
+        GLuint buffer = static_cast<GLuint>(storageBuffer->buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+
+    storageBuffer->buffer = vertexBuffer.getNativeHandle();
+    storageBuffer->size = vertexBuffer.getVertexCount() * sizeof(Vertex);
+    storageBuffer->owned = false;
+
+    // The new buffer must be attached the next time the shader is bound
+    m_cacheId = getUniqueShaderId();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::getStorageBufferData(const std::string& name, void* data, std::size_t size) const
+{
+    StorageBufferTable::const_iterator it = m_storageBuffers.find(name);
+    if ((it == m_storageBuffers.end()) || !it->second.buffer || !data)
+    {
+        err() << "Failed to read storage buffer \"" << name << "\": no buffer is attached to it" << std::endl;
+        return false;
+    }
+
+    if (size > it->second.size)
+    {
+        err() << "Failed to read storage buffer \"" << name << "\": " << size << " bytes requested, "
+              << "the buffer contains " << it->second.size << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_SHADER_STORAGE_BUFFER, it->second.buffer));
+    glCheck(GLEXT_glGetBufferSubData(GLEXT_GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptrARB>(size), data));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_SHADER_STORAGE_BUFFER, 0));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setImage(const std::string& name, Texture& texture)
+{
+    finishCompilation();
+
+    if (m_shaderProgram)
+    {
+        TransientContextLock lock;
+
+        if (!isComputeAvailable())
+        {
+            err() << "Failed to set image \"" << name << "\": your system doesn't support image load/store "
+                  << "(you should test Shader::isComputeAvailable() before trying to use images)" << std::endl;
+            return;
+        }
+
+        // Find the location of the variable in the shader
+        int location = getUniformLocation(name);
+        if (location != -1)
+        {
+            // Store the location -> texture mapping
+            TextureTable::iterator it = m_images.find(location);
+            if (it == m_images.end())
+            {
+                // New entry, make sure there are enough image units
+                GLint maxUnits = 0;
+                glCheck(glGetIntegerv(GLEXT_GL_MAX_IMAGE_UNITS, &maxUnits));
+                if (m_images.size() >= static_cast<std::size_t>(maxUnits))
+                {
+                    err() << "Impossible to use image for shader: all available image units are used" << std::endl;
+                    return;
+                }
+
+                m_images[location] = &texture;
+            }
+            else
+            {
+                // Location already used, just replace the texture
+                it->second = &texture;
+            }
+
+            // The images must be bound again
+            m_cacheId = getUniqueShaderId();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ)
+{
+    finishCompilation();
+
+    if (!m_shaderProgram)
+        return;
+
+    TransientContextLock lock;
+
+    if (!m_computeProgram)
+    {
+        err() << "Failed to dispatch shader: it doesn't contain a compute shader" << std::endl;
+        return;
+    }
+
+    // Save the program and the textures of the units we are going to use,
+    // sf::RenderTarget relies on them being unchanged between its draws
+    GLEXT_GLhandle program;
+    glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+
+    std::vector<GLint> textures(m_textures.size());
+    for (std::size_t i = 0; i < textures.size(); ++i)
+    {
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + static_cast<GLenum>(i + 1)));
+        glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &textures[i]));
+    }
+    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+
+    bind(this);
+
+    glCheck(GLEXT_glDispatchCompute(groupsX, groupsY, groupsZ));
+
+    // Make the results visible to whatever reads them next: draws, texture
+    // lookups, buffer reads or another dispatch
+    glCheck(GLEXT_glMemoryBarrier(GLEXT_GL_ALL_BARRIER_BITS));
+
+    // Restore the previous state
+    for (std::size_t i = 0; i < textures.size(); ++i)
+    {
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + static_cast<GLenum>(i + 1)));
+        glCheck(glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(textures[i])));
+    }
+    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+
+    glCheck(GLEXT_glUseProgramObject(program));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformsDeferred(bool deferred)
+{
+    if (deferred == m_uniformsDeferred)
+        return;
+
+    if (deferred)
+    {
+        // Uniforms may have been set directly meanwhile, the stored values are outdated
+        m_uniformValues.clear();
+    }
+    else if (m_shaderProgram && !m_dirtyUniforms.empty())
+    {
+        TransientContextLock lock;
+
+        // Upload the pending values now, as if they had not been deferred
+        GLEXT_GLhandle program = castToGlHandle(m_shaderProgram);
+        GLEXT_GLhandle savedProgram;
+        glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+        if (program != savedProgram)
+            glCheck(GLEXT_glUseProgramObject(program));
+
+        flushUniforms();
+
+        if (program != savedProgram)
+            glCheck(GLEXT_glUseProgramObject(savedProgram));
+    }
+
+    m_uniformsDeferred = deferred;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::areUniformsDeferred() const
+{
+    return m_uniformsDeferred;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setAsyncCompilation(bool enabled)
+{
+    m_asyncCompilation = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isAsyncCompilationEnabled() const
+{
+    return m_asyncCompilation;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    if (!m_compilationPending)
+        return true;
+
+    TransientContextLock lock;
+
+    // Ask the driver without waiting for it
+    GLint completed = GL_FALSE;
+    glCheck(GLEXT_glGetObjectParameteriv(castToGlHandle(m_shaderProgram), GLEXT_GL_COMPLETION_STATUS, &completed));
+    if (completed == GL_FALSE)
+        return false;
+
+    finishCompilation();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x)
+{
+    setUniform(name, x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y)
+{
+    setUniform(name, Glsl::Vec2(x, y));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y, float z)
+{
+    setUniform(name, Glsl::Vec3(x, y, z));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, float x, float y, float z, float w)
+{
+    setUniform(name, Glsl::Vec4(x, y, z, w));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Vector2f& v)
+{
+    setUniform(name, v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Vector3f& v)
+{
+    setUniform(name, v);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Color& color)
+{
+    setUniform(name, Glsl::Vec4(color));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Transform& transform)
+{
+    setUniform(name, Glsl::Mat4(transform));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const Texture& texture)
+{
+    setUniform(name, texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, CurrentTextureType)
+{
+    setUniform(name, CurrentTexture);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Shader::getNativeHandle() const
+{
+    finishCompilation();
+
+    return m_shaderProgram;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bind(const Shader* shader)
+{
+    TransientContextLock lock;
+
+    // Make sure that we can use shaders
     if (!isAvailable())
     {
         err() << "Failed to bind or unbind shader: your system doesn't support shaders "
@@ -750,6 +1560,10 @@ void Shader::bind(const Shader* shader)
         return;
     }
 
+    // Wait for the shader if it is still being compiled
+    if (shader)
+        shader->finishCompilation();
+
     if (shader && shader->m_shaderProgram)
     {
         // Enable the program
@@ -758,6 +1572,14 @@ void Shader::bind(const Shader* shader)
         // Bind the textures
         shader->bindTextures();
 
+        // Attach the uniform buffers and upload the deferred uniforms
+        shader->bindUniformBlocks();
+        shader->flushUniforms();
+
+        // Attach the storage buffers and images
+        shader->bindStorageBuffers();
+        shader->bindImages();
+
         // Bind the current texture
         if (shader->m_currentTexture != -1)
             glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
@@ -773,7 +1595,7 @@ void Shader::bind(const Shader* shader)
 ////////////////////////////////////////////////////////////
 bool Shader::isAvailable()
 {
-    Lock lock(isAvailableMutex);
+    Lock lock(shaderAvailableMutex);
 
     static bool checked = false;
     static bool available = false;
@@ -801,7 +1623,7 @@ bool Shader::isAvailable()
 ////////////////////////////////////////////////////////////
 bool Shader::isGeometryAvailable()
 {
-    Lock lock(isAvailableMutex);
+    Lock lock(shaderAvailableMutex);
 
     static bool checked = false;
     static bool available = false;
@@ -823,7 +1645,68 @@ bool Shader::isGeometryAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+    Lock lock(binaryCacheMutex);
+
+    binaryCacheDirectory = directory;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isUniformBlockAvailable()
+{
+    Lock lock(shaderAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = isAvailable() && GLEXT_vertex_buffer_object && GLEXT_uniform_buffer_object;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isComputeAvailable()
+{
+    Lock lock(shaderAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = isUniformBlockAvailable()               &&
+                    GLEXT_compute_shader                    &&
+                    GLEXT_program_interface_query           &&
+                    GLEXT_shader_storage_buffer_object      &&
+                    GLEXT_shader_image_load_store;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, const char* computeShaderCode)
 {
     TransientContextLock lock;
 
@@ -843,7 +1726,16 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         return false;
     }
 
+    // Make sure we can use compute shaders
+    if (computeShaderCode && !isComputeAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support compute shaders "
+              << "(you should test Shader::isComputeAvailable() before trying to use compute shaders)" << std::endl;
+        return false;
+    }
+
     // Destroy the shader if it was already created
+    discardPendingShaders();
     if (m_shaderProgram)
     {
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
@@ -854,97 +1746,95 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_uniformValues.clear();
+    m_dirtyUniforms.clear();
 
-    // Create the program
-    GLEXT_GLhandle shaderProgram;
-    glCheck(shaderProgram = GLEXT_glCreateProgramObject());
-
-    // Create the vertex shader if needed
-    if (vertexShaderCode)
+    // Uniform blocks belong to the program
+    for (UniformBlockTable::const_iterator it = m_uniformBlocks.begin(); it != m_uniformBlocks.end(); ++it)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle vertexShader;
-        glCheck(vertexShader = GLEXT_glCreateShaderObject(GLEXT_GL_VERTEX_SHADER));
-        glCheck(GLEXT_glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(vertexShader));
-
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(vertexShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        if (it->second.buffer)
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(vertexShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
+            GLuint buffer = static_cast<GLuint>(it->second.buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
         }
-
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, vertexShader));
-        glCheck(GLEXT_glDeleteObject(vertexShader));
     }
+    m_uniformBlocks.clear();
 
-    // Create the geometry shader if needed
-    if (geometryShaderCode)
+    // Storage buffers are attached to blocks of the program too
+    for (StorageBufferTable::const_iterator it = m_storageBuffers.begin(); it != m_storageBuffers.end(); ++it)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle geometryShader = GLEXT_glCreateShaderObject(GLEXT_GL_GEOMETRY_SHADER);
-        glCheck(GLEXT_glShaderSource(geometryShader, 1, &geometryShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(geometryShader));
-
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(geometryShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        if (it->second.owned && it->second.buffer)
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(geometryShader, sizeof(log), 0, log));
-            err() << "Failed to compile geometry shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(geometryShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
+            GLuint buffer = static_cast<GLuint>(it->second.buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
         }
-
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, geometryShader));
-        glCheck(GLEXT_glDeleteObject(geometryShader));
     }
+    m_storageBuffers.clear();
+    m_images.clear();
+    m_computeProgram = (computeShaderCode != NULL);
 
-    // Create the fragment shader if needed
-    if (fragmentShaderCode)
-    {
-        // Create and compile the shader
-        GLEXT_GLhandle fragmentShader;
-        glCheck(fragmentShader = GLEXT_glCreateShaderObject(GLEXT_GL_FRAGMENT_SHADER));
-        glCheck(GLEXT_glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(fragmentShader));
+    // Create the program
+    GLEXT_GLhandle shaderProgram;
+    glCheck(shaderProgram = GLEXT_glCreateProgramObject());
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(fragmentShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+    // Reuse the binary of a previous compilation if the driver still accepts it
+    std::string cachePath = getBinaryCachePath(vertexShaderCode, geometryShaderCode, fragmentShaderCode, computeShaderCode);
+    if (!cachePath.empty())
+    {
+        if (loadProgramBinary(castFromGlHandle(shaderProgram), cachePath))
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(fragmentShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
+            m_shaderProgram = castFromGlHandle(shaderProgram);
+            m_cacheId = getUniqueShaderId();
+            m_programId = m_cacheId;
+
+            return true;
         }
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, fragmentShader));
-        glCheck(GLEXT_glDeleteObject(fragmentShader));
+        // Start over with a fresh program, a rejected binary leaves it unlinked
+        glCheck(GLEXT_glDeleteObject(shaderProgram));
+        glCheck(shaderProgram = GLEXT_glCreateProgramObject());
+
+        // Tell the driver that we'll retrieve the binary
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
+    // Create the shaders, and leave their results to be checked later if the driver compiles in the background
+    bool async = m_asyncCompilation && GLEXT_parallel_shader_compile;
+    std::vector<unsigned int>* pendingShaders = async ? &m_pendingShaders : NULL;
+
+    if ((vertexShaderCode   && !attachShader(shaderProgram, GLEXT_GL_VERTEX_SHADER,   "vertex",   vertexShaderCode,   pendingShaders)) ||
+        (geometryShaderCode && !attachShader(shaderProgram, GLEXT_GL_GEOMETRY_SHADER, "geometry", geometryShaderCode, pendingShaders)) ||
+        (fragmentShaderCode && !attachShader(shaderProgram, GLEXT_GL_FRAGMENT_SHADER, "fragment", fragmentShaderCode, pendingShaders)) ||
+        (computeShaderCode  && !attachShader(shaderProgram, GLEXT_GL_COMPUTE_SHADER,  "compute",  computeShaderCode,  pendingShaders)))
+    {
+        glCheck(GLEXT_glDeleteObject(shaderProgram));
+        return false;
+    }
+
+    if (!computeShaderCode)
+    {
+        // Bind the vertex attributes fed by sf::RenderTarget on core profile contexts
+        priv::CorePipeline::bindAttributeLocations(castFromGlHandle(shaderProgram));
     }
 
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
+    if (async)
+    {
+        // The link status is checked by isReady(), or when the shader is first used
+        m_shaderProgram = castFromGlHandle(shaderProgram);
+        m_cacheId = getUniqueShaderId();
+        m_programId = m_cacheId;
+        m_compilationPending = true;
+        m_pendingCachePath = cachePath;
+
+        // Flush, so that the driver starts compiling right away
+        glCheck(glFlush());
+
+        return true;
+    }
+
     // Check the link log
     GLint success;
     glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
@@ -958,7 +1848,13 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         return false;
     }
 
+    // Save the binary, so that the next compilations of this program are skipped
+    if (!cachePath.empty())
+        saveProgramBinary(castFromGlHandle(shaderProgram), cachePath);
+
     m_shaderProgram = castFromGlHandle(shaderProgram);
+    m_cacheId = getUniqueShaderId();
+    m_programId = m_cacheId;
 
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
@@ -974,39 +1870,289 @@ void Shader::bindTextures() const
     TextureTable::const_iterator it = m_textures.begin();
     for (std::size_t i = 0; i < m_textures.size(); ++i)
     {
-        GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(GLEXT_glUniform1i(it->first, index));
-        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
-        Texture::bind(it->second);
+        GLint index = static_cast<GLsizei>(i + 1);
+        glCheck(GLEXT_glUniform1i(it->first, index));
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
+        Texture::bind(it->second);
+        ++it;
+    }
+
+    // Make sure that the texture unit which is left active is the number 0
+    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+}
+
+
+////////////////////////////////////////////////////////////
+int Shader::getUniformLocation(const std::string& name)
+{
+    // Check the cache
+    UniformTable::const_iterator it = m_uniforms.find(name);
+    if (it != m_uniforms.end())
+    {
+        // Already in cache, return it
+        return it->second;
+    }
+    else
+    {
+        // Not in cache, request the location from OpenGL
+        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
+        m_uniforms.insert(std::make_pair(name, location));
+
+        if (location == -1)
+            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+
+        return location;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+int Shader::getLocation(const UniformHandle& handle) const
+{
+    if (handle.m_location == -1)
+        return -1;
+
+    // Locations are only meaningful for the program they were queried from
+    if (handle.m_programId != m_programId)
+    {
+        err() << "Uniform handle doesn't belong to this shader, or the shader was reloaded since it was created" << std::endl;
+        return -1;
+    }
+
+    return handle.m_location;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::deferUniform(const UniformHandle& handle, UniformValue::Type type, int size, std::size_t count, const float* floats, const int* ints)
+{
+    if (!m_uniformsDeferred || !m_shaderProgram)
+        return false;
+
+    int location = getLocation(handle);
+    std::size_t length = static_cast<std::size_t>(size) * count;
+    if ((location == -1) || (length == 0))
+        return true;
+
+    UniformValue& value = m_uniformValues[location];
+
+    // Nothing to upload if the uniform already has this value
+    if ((value.type == type) && (value.size == size) && (value.count == count))
+    {
+        if (floats ? std::equal(floats, floats + length, value.floats.begin()) : std::equal(ints, ints + length, value.ints.begin()))
+            return true;
+    }
+
+    value.type = type;
+    value.size = size;
+    value.count = count;
+
+    if (floats)
+        value.floats.assign(floats, floats + length);
+    else
+        value.ints.assign(ints, ints + length);
+
+    if (!value.dirty)
+    {
+        value.dirty = true;
+        m_dirtyUniforms.push_back(location);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::flushUniforms() const
+{
+    for (std::vector<int>::const_iterator it = m_dirtyUniforms.begin(); it != m_dirtyUniforms.end(); ++it)
+    {
+        UniformValue& value = m_uniformValues[*it];
+        GLsizei count = static_cast<GLsizei>(value.count);
+
+        switch (value.type)
+        {
+            case UniformValue::Float:
+            {
+                switch (value.size)
+                {
+                    case 1:  glCheck(GLEXT_glUniform1fv(*it, count, &value.floats[0])); break;
+                    case 2:  glCheck(GLEXT_glUniform2fv(*it, count, &value.floats[0])); break;
+                    case 3:  glCheck(GLEXT_glUniform3fv(*it, count, &value.floats[0])); break;
+                    default: glCheck(GLEXT_glUniform4fv(*it, count, &value.floats[0])); break;
+                }
+                break;
+            }
+
+            case UniformValue::Int:
+            {
+                switch (value.size)
+                {
+                    case 1:  glCheck(GLEXT_glUniform1iv(*it, count, &value.ints[0])); break;
+                    case 2:  glCheck(GLEXT_glUniform2iv(*it, count, &value.ints[0])); break;
+                    case 3:  glCheck(GLEXT_glUniform3iv(*it, count, &value.ints[0])); break;
+                    default: glCheck(GLEXT_glUniform4iv(*it, count, &value.ints[0])); break;
+                }
+                break;
+            }
+
+            case UniformValue::Matrix:
+            {
+                if (value.size == 9)
+                    glCheck(GLEXT_glUniformMatrix3fv(*it, count, GL_FALSE, &value.floats[0]));
+                else
+                    glCheck(GLEXT_glUniformMatrix4fv(*it, count, GL_FALSE, &value.floats[0]));
+                break;
+            }
+        }
+
+        value.dirty = false;
+    }
+
+    m_dirtyUniforms.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindUniformBlocks() const
+{
+    for (UniformBlockTable::const_iterator it = m_uniformBlocks.begin(); it != m_uniformBlocks.end(); ++it)
+    {
+        if (it->second.buffer)
+            glCheck(GLEXT_glBindBufferBase(GLEXT_GL_UNIFORM_BUFFER, it->second.binding, it->second.buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::StorageBuffer* Shader::getStorageBuffer(const std::string& name)
+{
+    if (!isComputeAvailable())
+    {
+        err() << "Failed to set storage buffer \"" << name << "\": your system doesn't support storage buffers "
+              << "(you should test Shader::isComputeAvailable() before trying to use them)" << std::endl;
+        return NULL;
+    }
+
+    // Assign a binding point to the block the first time it is set
+    StorageBufferTable::iterator it = m_storageBuffers.find(name);
+    if (it == m_storageBuffers.end())
+    {
+        StorageBuffer storageBuffer;
+        storageBuffer.buffer = 0;
+        storageBuffer.binding = -1;
+        storageBuffer.size = 0;
+        storageBuffer.owned = false;
+
+        GLuint index;
+        glCheck(index = GLEXT_glGetProgramResourceIndex(m_shaderProgram, GLEXT_GL_SHADER_STORAGE_BLOCK, name.c_str()));
+
+        GLint maxBindings = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &maxBindings));
+
+        if (index == GLEXT_GL_INVALID_INDEX)
+        {
+            err() << "Storage block \"" << name << "\" not found in shader" << std::endl;
+        }
+        else if (m_storageBuffers.size() >= static_cast<std::size_t>(maxBindings))
+        {
+            err() << "Impossible to use storage block \"" << name << "\" for shader: all available binding points are used" << std::endl;
+        }
+        else
+        {
+            storageBuffer.binding = static_cast<int>(m_storageBuffers.size());
+            glCheck(GLEXT_glShaderStorageBlockBinding(m_shaderProgram, index, static_cast<GLuint>(storageBuffer.binding)));
+        }
+
+        // Missing blocks are remembered too, so that they are only reported once
+        it = m_storageBuffers.insert(std::make_pair(name, storageBuffer)).first;
+    }
+
+    return (it->second.binding != -1) ? &it->second : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindStorageBuffers() const
+{
+    for (StorageBufferTable::const_iterator it = m_storageBuffers.begin(); it != m_storageBuffers.end(); ++it)
+    {
+        if ((it->second.binding != -1) && it->second.buffer)
+            glCheck(GLEXT_glBindBufferBase(GLEXT_GL_SHADER_STORAGE_BUFFER, static_cast<GLuint>(it->second.binding), it->second.buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindImages() const
+{
+    TextureTable::const_iterator it = m_images.begin();
+    for (std::size_t i = 0; i < m_images.size(); ++i)
+    {
+        GLint unit = static_cast<GLint>(i);
+        glCheck(GLEXT_glUniform1i(it->first, unit));
+        glCheck(GLEXT_glBindImageTexture(static_cast<GLuint>(unit), it->second->getNativeHandle(), 0, GL_FALSE, 0, GLEXT_GL_READ_WRITE, GLEXT_GL_RGBA8));
         ++it;
     }
-
-    // Make sure that the texture unit which is left active is the number 0
-    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
 }
 
 
 ////////////////////////////////////////////////////////////
-int Shader::getUniformLocation(const std::string& name)
+void Shader::finishCompilation() const
 {
-    // Check the cache
-    UniformTable::const_iterator it = m_uniforms.find(name);
-    if (it != m_uniforms.end())
+    if (!m_compilationPending)
+        return;
+
+    TransientContextLock lock;
+
+    // This waits for the driver if it is not done yet
+    GLEXT_GLhandle program = castToGlHandle(m_shaderProgram);
+    GLint success;
+    glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+
+    if (success == GL_FALSE)
     {
-        // Already in cache, return it
-        return it->second;
+        // Report the shaders that failed to compile, they are the usual cause
+        for (std::vector<unsigned int>::const_iterator it = m_pendingShaders.begin(); it != m_pendingShaders.end(); ++it)
+        {
+            GLint compiled;
+            glCheck(GLEXT_glGetObjectParameteriv(castToGlHandle(*it), GLEXT_GL_OBJECT_COMPILE_STATUS, &compiled));
+            if (compiled == GL_FALSE)
+            {
+                char log[1024];
+                glCheck(GLEXT_glGetInfoLog(castToGlHandle(*it), sizeof(log), 0, log));
+                err() << "Failed to compile shader:" << std::endl
+                      << log << std::endl;
+            }
+        }
+
+        char log[1024];
+        glCheck(GLEXT_glGetInfoLog(program, sizeof(log), 0, log));
+        err() << "Failed to link shader:" << std::endl
+              << log << std::endl;
+
+        glCheck(GLEXT_glDeleteObject(program));
+        m_shaderProgram = 0;
     }
-    else
+    else if (!m_pendingCachePath.empty())
     {
-        // Not in cache, request the location from OpenGL
-        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
-        m_uniforms.insert(std::make_pair(name, location));
+        // Save the binary, so that the next compilations of this program are skipped
+        saveProgramBinary(m_shaderProgram, m_pendingCachePath);
+    }
 
-        if (location == -1)
-            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+    discardPendingShaders();
+}
 
-        return location;
-    }
+
+////////////////////////////////////////////////////////////
+void Shader::discardPendingShaders() const
+{
+    for (std::vector<unsigned int>::const_iterator it = m_pendingShaders.begin(); it != m_pendingShaders.end(); ++it)
+        glCheck(GLEXT_glDeleteObject(castToGlHandle(*it)));
+
+    m_pendingShaders.clear();
+    m_pendingCachePath.clear();
+    m_compilationPending = false;
 }
 
 } // namespace sf
@@ -1023,8 +2169,14 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1)
+m_shaderProgram     (0),
+m_currentTexture    (-1),
+m_cacheId           (getUniqueShaderId()),
+m_programId         (0),
+m_uniformsDeferred  (false),
+m_computeProgram    (false),
+m_asyncCompilation  (false),
+m_compilationPending(false)
 {
 }
 
@@ -1194,6 +2346,12 @@ void Shader::setUniform(const std::string& name, CurrentTextureType)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const std::string& name, const BindlessHandle& handle)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
 {
@@ -1230,6 +2388,201 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return UniformHandle();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, float x)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Vec2& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Vec3& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Vec4& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, int x)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Ivec2& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Ivec3& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Ivec4& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, bool x)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Bvec2& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Bvec3& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Bvec4& v)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Mat3& matrix)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Glsl::Mat4& matrix)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const Texture& texture)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, CurrentTextureType)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(const UniformHandle& handle, const BindlessHandle& bindlessHandle)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const float* scalarArray, std::size_t length)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Vec2* vectorArray, std::size_t length)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Vec3* vectorArray, std::size_t length)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Vec4* vectorArray, std::size_t length)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Mat3* matrixArray, std::size_t length)
+{
+}
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformArray(const UniformHandle& handle, const Glsl::Mat4* matrixArray, std::size_t length)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformBlock(const std::string& name, const void* data, std::size_t size)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setStorageBuffer(const std::string& name, const void* data, std::size_t size)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setStorageBuffer(const std::string& name, const VertexBuffer& vertexBuffer)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::getStorageBufferData(const std::string& name, void* data, std::size_t size) const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setImage(const std::string& name, Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniformsDeferred(bool deferred)
+{
+    m_uniformsDeferred = deferred;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::areUniformsDeferred() const
+{
+    return m_uniformsDeferred;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setAsyncCompilation(bool enabled)
+{
+    m_asyncCompilation = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isAsyncCompilationEnabled() const
+{
+    return m_asyncCompilation;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1318,7 +2671,27 @@ bool Shader::isGeometryAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isUniformBlockAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isComputeAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, const char* computeShaderCode)
 {
     return false;
 }
@@ -1329,6 +2702,49 @@ void Shader::bindTextures() const
 {
 }
 
+
+////////////////////////////////////////////////////////////
+void Shader::flushUniforms() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindUniformBlocks() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::StorageBuffer* Shader::getStorageBuffer(const std::string& name)
+{
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindStorageBuffers() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::bindImages() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::finishCompilation() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::discardPendingShaders() const
+{
+}
+
 } // namespace sf
 
 #endif // SFML_OPENGL_ES
@@ -86,7 +86,7 @@ const Texture* Shape::getTexture() const
 void Shape::setTextureRect(const IntRect& rect)
 {
     m_textureRect = rect;
-    updateTexCoords();
+    m_texCoordsNeedUpdate = true;
 }
 
 
@@ -101,7 +101,7 @@ const IntRect& Shape::getTextureRect() const
 void Shape::setFillColor(const Color& color)
 {
     m_fillColor = color;
-    updateFillColors();
+    m_fillColorsNeedUpdate = true;
 }
 
 
@@ -116,7 +116,7 @@ const Color& Shape::getFillColor() const
 void Shape::setOutlineColor(const Color& color)
 {
     m_outlineColor = color;
-    updateOutlineColors();
+    m_outlineColorsNeedUpdate = true;
 }
 
 
@@ -131,7 +131,7 @@ const Color& Shape::getOutlineColor() const
 void Shape::setOutlineThickness(float thickness)
 {
     m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+    m_outlineNeedsUpdate = true; // the fill geometry doesn't depend on the outline
 }
 
 
@@ -145,6 +145,8 @@ float Shape::getOutlineThickness() const
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getLocalBounds() const
 {
+    ensureGeometryUpdate();
+
     return m_bounds;
 }
 
@@ -158,21 +160,104 @@ FloatRect Shape::getGlobalBounds() const
 
 ////////////////////////////////////////////////////////////
 Shape::Shape() :
-m_texture         (NULL),
-m_textureRect     (),
-m_fillColor       (255, 255, 255),
-m_outlineColor    (255, 255, 255),
-m_outlineThickness(0),
-m_vertices        (TriangleFan),
-m_outlineVertices (TriangleStrip),
-m_insideBounds    (),
-m_bounds          ()
+m_texture                (NULL),
+m_textureRect            (),
+m_fillColor              (255, 255, 255),
+m_outlineColor           (255, 255, 255),
+m_outlineThickness       (0),
+m_vertices               (TriangleFan),
+m_outlineVertices        (TriangleStrip),
+m_insideBounds           (),
+m_bounds                 (),
+m_positionsNeedUpdate    (true),
+m_fillColorsNeedUpdate   (true),
+m_texCoordsNeedUpdate    (true),
+m_outlineNeedsUpdate     (true),
+m_outlineColorsNeedUpdate(true)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shape::update()
+{
+    // The new points are fetched when the geometry is needed
+    m_positionsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+
+    // Render the inside
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+
+    // Render the outline
+    if (m_outlineThickness != 0)
+    {
+        states.texture = NULL;
+        target.draw(m_outlineVertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shape::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::ensureGeometryUpdate() const
+{
+    // Each part is only rebuilt if it is outdated, new points invalidate everything
+    if (m_positionsNeedUpdate)
+    {
+        updatePositions();
+
+        m_positionsNeedUpdate  = false;
+        m_fillColorsNeedUpdate = true;
+        m_texCoordsNeedUpdate  = true;
+        m_outlineNeedsUpdate   = true;
+    }
+
+    if (m_fillColorsNeedUpdate)
+    {
+        updateFillColors();
+        m_fillColorsNeedUpdate = false;
+    }
+
+    if (m_texCoordsNeedUpdate)
+    {
+        updateTexCoords();
+        m_texCoordsNeedUpdate = false;
+    }
+
+    if (m_outlineNeedsUpdate)
+    {
+        updateOutline();
+
+        m_outlineNeedsUpdate      = false;
+        m_outlineColorsNeedUpdate = true;
+    }
+
+    if (m_outlineColorsNeedUpdate)
+    {
+        updateOutlineColors();
+        m_outlineColorsNeedUpdate = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updatePositions() const
 {
     // Get the total number of points of the shape
     std::size_t count = getPointCount();
@@ -180,6 +265,7 @@ void Shape::update()
     {
         m_vertices.resize(0);
         m_outlineVertices.resize(0);
+        m_insideBounds = FloatRect();
         return;
     }
 
@@ -197,38 +283,11 @@ void Shape::update()
     // Compute the center and make it the first vertex
     m_vertices[0].position.x = m_insideBounds.left + m_insideBounds.width / 2;
     m_vertices[0].position.y = m_insideBounds.top + m_insideBounds.height / 2;
-
-    // Color
-    updateFillColors();
-
-    // Texture coordinates
-    updateTexCoords();
-
-    // Outline
-    updateOutline();
-}
-
-
-////////////////////////////////////////////////////////////
-void Shape::draw(RenderTarget& target, RenderStates states) const
-{
-    states.transform *= getTransform();
-
-    // Render the inside
-    states.texture = m_texture;
-    target.draw(m_vertices, states);
-
-    // Render the outline
-    if (m_outlineThickness != 0)
-    {
-        states.texture = NULL;
-        target.draw(m_outlineVertices, states);
-    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateFillColors()
+void Shape::updateFillColors() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
         m_vertices[i].color = m_fillColor;
@@ -236,7 +295,7 @@ void Shape::updateFillColors()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateTexCoords()
+void Shape::updateTexCoords() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
     {
@@ -249,10 +308,10 @@ void Shape::updateTexCoords()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutline()
+void Shape::updateOutline() const
 {
     // Return if there is no outline
-    if (m_outlineThickness == 0.f)
+    if ((m_outlineThickness == 0.f) || (m_vertices.getVertexCount() == 0))
     {
         m_outlineVertices.clear();
         m_bounds = m_insideBounds;
@@ -295,16 +354,13 @@ void Shape::updateOutline()
     m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
     m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
 
-    // Update outline colors
-    updateOutlineColors();
-
     // Update the shape's bounds
     m_bounds = m_outlineVertices.getBounds();
 }
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutlineColors()
+void Shape::updateOutlineColors() const
 {
     for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
         m_outlineVertices[i].color = m_outlineColor;
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SKYLINEPACKER_HPP
+#define SFML_SKYLINEPACKER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Find the lowest free position of a rectangle above a skyline
+///
+/// The skyline is the top edge of the rectangles already
+/// packed into an area, made of horizontal segments sorted
+/// from left to right and covering its whole width. Segment
+/// must have the unsigned int members x, y and width and a
+/// matching (x, y, width) constructor.
+///
+/// The rectangle is placed with the bottom-left heuristic:
+/// the lowest position wins, ties are broken by the area
+/// wasted under the rectangle, then by the width of the
+/// segment it starts on. The skyline is updated on success.
+///
+/// \param skyline    Skyline of the area
+/// \param areaWidth  Width of the area
+/// \param areaHeight Height of the area
+/// \param width      Width of the rectangle
+/// \param height     Height of the rectangle
+/// \param rect       Receives the rectangle within the area
+///
+/// \return True if the rectangle fits in the area
+///
+////////////////////////////////////////////////////////////
+template <typename Segment>
+bool packSkyline(std::vector<Segment>& skyline, unsigned int areaWidth, unsigned int areaHeight,
+                 unsigned int width, unsigned int height, IntRect& rect)
+{
+    if ((width > areaWidth) || (height > areaHeight))
+        return false;
+
+    std::size_t best = skyline.size();
+    unsigned int bestY = 0;
+    unsigned long bestWaste = 0;
+    unsigned int bestWidth = 0;
+    for (std::size_t i = 0; (i < skyline.size()) && (skyline[i].x + width <= areaWidth); ++i)
+    {
+        unsigned int left  = skyline[i].x;
+        unsigned int right = left + width;
+
+        // The rectangle rests on the highest segment that it spans
+        unsigned int y = 0;
+        std::size_t end = i;
+        for (; (end < skyline.size()) && (skyline[end].x < right); ++end)
+            y = std::max(y, skyline[end].y);
+
+        if (y + height > areaHeight)
+            continue;
+
+        // The gaps between the rectangle and the lower segments can't be used anymore
+        unsigned long waste = 0;
+        for (std::size_t j = i; j < end; ++j)
+        {
+            unsigned int overlap = std::min(right, skyline[j].x + skyline[j].width) - skyline[j].x;
+            waste += static_cast<unsigned long>(y - skyline[j].y) * overlap;
+        }
+
+        if ((best == skyline.size()) || (y < bestY) ||
+            ((y == bestY) && ((waste < bestWaste) || ((waste == bestWaste) && (skyline[i].width < bestWidth)))))
+        {
+            best = i;
+            bestY = y;
+            bestWaste = waste;
+            bestWidth = skyline[i].width;
+        }
+    }
+
+    if (best == skyline.size())
+        return false;
+
+    unsigned int left  = skyline[best].x;
+    unsigned int right = left + width;
+
+    rect = IntRect(static_cast<int>(left), static_cast<int>(bestY), static_cast<int>(width), static_cast<int>(height));
+
+    // Raise the skyline over the new rectangle
+    skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(best), Segment(left, bestY + height, width));
+
+    std::size_t i = best + 1;
+    while ((i < skyline.size()) && (skyline[i].x < right))
+    {
+        unsigned int segmentRight = skyline[i].x + skyline[i].width;
+
+        if (segmentRight <= right)
+        {
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        else
+        {
+            skyline[i].x = right;
+            skyline[i].width = segmentRight - right;
+            break;
+        }
+    }
+
+    // Merge the neighbour segments that are at the same height
+    for (std::size_t j = 0; j + 1 < skyline.size();)
+    {
+        if (skyline[j].y == skyline[j + 1].y)
+        {
+            skyline[j].width += skyline[j + 1].width;
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(j + 1));
+        }
+        else
+        {
+            ++j;
+        }
+    }
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SKYLINEPACKER_HPP
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <cstdlib>
 
@@ -35,16 +36,18 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Sprite::Sprite() :
-m_texture    (NULL),
-m_textureRect()
+m_texture     (NULL),
+m_textureArray(NULL),
+m_textureRect ()
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 Sprite::Sprite(const Texture& texture) :
-m_texture    (NULL),
-m_textureRect()
+m_texture     (NULL),
+m_textureArray(NULL),
+m_textureRect ()
 {
     setTexture(texture);
 }
@@ -52,8 +55,9 @@ m_textureRect()
 
 ////////////////////////////////////////////////////////////
 Sprite::Sprite(const Texture& texture, const IntRect& rectangle) :
-m_texture    (NULL),
-m_textureRect()
+m_texture     (NULL),
+m_textureArray(NULL),
+m_textureRect ()
 {
     setTexture(texture);
     setTextureRect(rectangle);
@@ -64,11 +68,27 @@ m_textureRect()
 void Sprite::setTexture(const Texture& texture, bool resetRect)
 {
     // Recompute the texture area if requested, or if there was no valid texture & rect before
-    if (resetRect || (!m_texture && (m_textureRect == sf::IntRect())))
+    if (resetRect || (!m_texture && !m_textureArray && (m_textureRect == sf::IntRect())))
         setTextureRect(IntRect(0, 0, texture.getSize().x, texture.getSize().y));
 
     // Assign the new texture
     m_texture = &texture;
+    m_textureArray = NULL;
+    setLayer(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Sprite::setTexture(const TextureArray& textureArray, unsigned int layer, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (resetRect || (!m_texture && !m_textureArray && (m_textureRect == sf::IntRect())))
+        setTextureRect(IntRect(0, 0, textureArray.getSize().x, textureArray.getSize().y));
+
+    // Assign the new texture array
+    m_texture = NULL;
+    m_textureArray = &textureArray;
+    setLayer(layer);
 }
 
 
@@ -102,6 +122,20 @@ const Texture* Sprite::getTexture() const
 }
 
 
+////////////////////////////////////////////////////////////
+const TextureArray* Sprite::getTextureArray() const
+{
+    return m_textureArray;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Sprite::getLayer() const
+{
+    return static_cast<unsigned int>(m_vertices[0].layer);
+}
+
+
 ////////////////////////////////////////////////////////////
 const IntRect& Sprite::getTextureRect() const
 {
@@ -136,15 +170,24 @@ FloatRect Sprite::getGlobalBounds() const
 ////////////////////////////////////////////////////////////
 void Sprite::draw(RenderTarget& target, RenderStates states) const
 {
-    if (m_texture)
+    if (m_texture || m_textureArray)
     {
         states.transform *= getTransform();
         states.texture = m_texture;
+        states.textureArray = m_textureArray;
         target.draw(m_vertices, 4, TriangleStrip, states);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+bool Sprite::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Sprite::updatePositions()
 {
@@ -171,4 +214,16 @@ void Sprite::updateTexCoords()
     m_vertices[3].texCoords = Vector2f(right, bottom);
 }
 
+
+////////////////////////////////////////////////////////////
+void Sprite::setLayer(unsigned int layer)
+{
+    float value = static_cast<float>(layer);
+
+    m_vertices[0].layer = value;
+    m_vertices[1].layer = value;
+    m_vertices[2].layer = value;
+    m_vertices[3].layer = value;
+}
+
 } // namespace sf
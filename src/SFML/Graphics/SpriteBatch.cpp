@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace
+{
+    // Upload the two triangles of each of the first quadCount quads
+    template <typename T>
+    bool fillIndices(sf::IndexBuffer& buffer, std::size_t quadCount)
+    {
+        std::vector<T> indices(quadCount * 6);
+        for (std::size_t i = 0; i < quadCount; ++i)
+        {
+            T first = static_cast<T>(i * 4);
+
+            indices[i * 6 + 0] = static_cast<T>(first + 0);
+            indices[i * 6 + 1] = static_cast<T>(first + 1);
+            indices[i * 6 + 2] = static_cast<T>(first + 2);
+            indices[i * 6 + 3] = static_cast<T>(first + 2);
+            indices[i * 6 + 4] = static_cast<T>(first + 1);
+            indices[i * 6 + 5] = static_cast<T>(first + 3);
+        }
+
+        return buffer.update(&indices[0], indices.size());
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_texture     (NULL),
+m_vertices    (),
+m_boundsMin   (),
+m_boundsMax   (),
+m_buffer      (Triangles, VertexBuffer::Stream),
+m_indices     (IndexBuffer::Static),
+m_indexedQuads(0),
+m_triangles   (),
+m_needsUpload (false),
+m_uploaded    (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* SpriteBatch::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(const IntRect& textureRect, const Transform& transform, const Color& color)
+{
+    float left   = static_cast<float>(textureRect.left);
+    float right  = left + textureRect.width;
+    float top    = static_cast<float>(textureRect.top);
+    float bottom = top + textureRect.height;
+
+    float width  = static_cast<float>(std::abs(textureRect.width));
+    float height = static_cast<float>(std::abs(textureRect.height));
+
+    // Same corner order as sf::Sprite: top-left, bottom-left, top-right, bottom-right
+    Vertex corners[4] =
+    {
+        Vertex(Vector2f(0, 0),          color, Vector2f(left, top)),
+        Vertex(Vector2f(0, height),     color, Vector2f(left, bottom)),
+        Vertex(Vector2f(width, 0),      color, Vector2f(right, top)),
+        Vertex(Vector2f(width, height), color, Vector2f(right, bottom))
+    };
+
+    transform.transformPoints(corners, corners, 4);
+
+    // Grow the bounds of the batch
+    if (m_vertices.empty())
+        m_boundsMin = m_boundsMax = corners[0].position;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        m_boundsMin.x = std::min(m_boundsMin.x, corners[i].position.x);
+        m_boundsMin.y = std::min(m_boundsMin.y, corners[i].position.y);
+        m_boundsMax.x = std::max(m_boundsMax.x, corners[i].position.x);
+        m_boundsMax.y = std::max(m_boundsMax.y, corners[i].position.y);
+    }
+
+    m_vertices.insert(m_vertices.end(), corners, corners + 4);
+    m_needsUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::add(const Sprite& sprite)
+{
+    add(sprite.getTextureRect(), sprite.getTransform(), sprite.getColor());
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::clear()
+{
+    m_vertices.clear();
+    m_needsUpload = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::reserve(std::size_t spriteCount)
+{
+    m_vertices.reserve(spriteCount * 4);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getSpriteCount() const
+{
+    return m_vertices.size() / 4;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SpriteBatch::getBounds() const
+{
+    if (m_vertices.empty())
+        return FloatRect();
+
+    return FloatRect(m_boundsMin, m_boundsMax - m_boundsMin);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_vertices.empty())
+        return;
+
+    states.texture = m_texture;
+
+    if (m_needsUpload)
+    {
+        m_uploaded = upload();
+        m_needsUpload = false;
+
+        // Expand the quads to independent triangles if they can't be drawn indexed
+        if (!m_uploaded)
+        {
+            m_triangles.resize(m_vertices.size() / 4 * 6);
+
+            for (std::size_t i = 0, j = 0; i < m_vertices.size(); i += 4, j += 6)
+            {
+                m_triangles[j + 0] = m_vertices[i + 0];
+                m_triangles[j + 1] = m_vertices[i + 1];
+                m_triangles[j + 2] = m_vertices[i + 2];
+                m_triangles[j + 3] = m_vertices[i + 2];
+                m_triangles[j + 4] = m_vertices[i + 1];
+                m_triangles[j + 5] = m_vertices[i + 3];
+            }
+        }
+    }
+
+    if (m_uploaded)
+        target.draw(m_buffer, m_indices, 0, m_vertices.size() / 4 * 6, states);
+    else
+        target.draw(&m_triangles[0], m_triangles.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::getCullingBounds(FloatRect& bounds) const
+{
+    if (m_vertices.empty())
+        return false;
+
+    bounds = getBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::upload() const
+{
+    if (!VertexBuffer::isAvailable())
+        return false;
+
+    std::size_t quadCount = m_vertices.size() / 4;
+
+    // The indices only depend on the number of quads, regenerate them when the batch outgrows them
+    if (quadCount > m_indexedQuads)
+    {
+        // Prefer 16-bit indices while the vertices can be addressed with them
+        const std::size_t maxShortQuads = 65536 / 4;
+        std::size_t capacity = std::max(quadCount, m_indexedQuads * 2);
+        if ((capacity > maxShortQuads) && (quadCount <= maxShortQuads))
+            capacity = maxShortQuads;
+
+        bool uploaded = false;
+        if (capacity <= maxShortQuads)
+            uploaded = m_indices.create(capacity * 6, IndexBuffer::Index16) && fillIndices<Uint16>(m_indices, capacity);
+        else if (IndexBuffer::isAvailable(IndexBuffer::Index32))
+            uploaded = m_indices.create(capacity * 6, IndexBuffer::Index32) && fillIndices<Uint32>(m_indices, capacity);
+
+        if (!uploaded)
+        {
+            m_indexedQuads = 0;
+            return false;
+        }
+
+        m_indexedQuads = capacity;
+    }
+
+    // VertexBuffer::update() reallocates the storage whenever the batch grows
+    return (m_buffer.getNativeHandle() || m_buffer.create(m_vertices.size())) &&
+           m_buffer.update(&m_vertices[0], m_vertices.size(), 0);
+}
+
+} // namespace sf
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <map>
+
+
+namespace
+{
+    // Number of regions the storage is split into
+    const std::size_t regionCount = 3;
+
+    // Initial size of a region, in vertices
+    const std::size_t initialRegionSize = 16384;
+
+    // Stream buffer of a given context
+    // Mappings and fences are tied to the context
+    // that created them, so every context gets its own
+    struct Stream
+    {
+        GLuint       buffer;     // Buffer object holding the storage
+        std::size_t  regionSize; // Size of a region, in vertices
+        std::size_t  region;     // Index of the region being filled
+        std::size_t  offset;     // Index of the next free vertex in the region
+        sf::Vertex*  mapping;    // Persistent mapping of the storage, NULL if orphaning is used
+#ifndef SFML_OPENGL_ES
+        GLsync       fences[regionCount]; // Fences guarding the regions
+#endif
+    };
+
+    typedef std::map<sf::Uint64, Stream> StreamMap;
+    StreamMap streams;
+
+    // Mutex to protect the streams map
+    sf::Mutex streamBufferMutex;
+
+    // Insert a fence after the commands reading a region
+    void insertFence(Stream& stream, std::size_t region)
+    {
+#ifndef SFML_OPENGL_ES
+        if (!stream.mapping)
+            return;
+
+        if (stream.fences[region])
+            glCheck(GLEXT_glDeleteSync(stream.fences[region]));
+
+        glCheck(stream.fences[region] = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+#else
+        (void)stream;
+        (void)region;
+#endif
+    }
+
+    // Wait until the GPU is done reading a region
+    void waitFence(Stream& stream, std::size_t region)
+    {
+#ifndef SFML_OPENGL_ES
+        if (!stream.fences[region])
+            return;
+
+        // Flush on the first attempt so that the fence is guaranteed to signal
+        GLbitfield flags = GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT;
+
+        for (;;)
+        {
+            GLenum result;
+            glCheck(result = GLEXT_glClientWaitSync(stream.fences[region], flags, 1000000000));
+
+            if ((result == GLEXT_GL_ALREADY_SIGNALED) || (result == GLEXT_GL_CONDITION_SATISFIED) || (result == GLEXT_GL_WAIT_FAILED))
+                break;
+
+            flags = 0;
+        }
+
+        glCheck(GLEXT_glDeleteSync(stream.fences[region]));
+        stream.fences[region] = 0;
+#else
+        (void)stream;
+        (void)region;
+#endif
+    }
+
+    // Destroy the storage of a stream, the owning context must be active
+    void destroyStorage(Stream& stream)
+    {
+#ifndef SFML_OPENGL_ES
+        for (std::size_t i = 0; i < regionCount; ++i)
+        {
+            if (stream.fences[i])
+                glCheck(GLEXT_glDeleteSync(stream.fences[i]));
+
+            stream.fences[i] = 0;
+        }
+#endif
+
+        // Deleting the buffer also releases its mapping
+        if (stream.buffer)
+            glCheck(GLEXT_glDeleteBuffers(1, &stream.buffer));
+
+        stream.buffer = 0;
+        stream.mapping = NULL;
+    }
+
+    // Create the storage of a stream, leaves the buffer bound on success
+    bool createStorage(Stream& stream, std::size_t regionSize)
+    {
+        stream.buffer = 0;
+        stream.regionSize = regionSize;
+        stream.region = 0;
+        stream.offset = 0;
+        stream.mapping = NULL;
+#ifndef SFML_OPENGL_ES
+        for (std::size_t i = 0; i < regionCount; ++i)
+            stream.fences[i] = 0;
+#endif
+
+        std::size_t size = sizeof(sf::Vertex) * regionSize * regionCount;
+
+        glCheck(GLEXT_glGenBuffers(1, &stream.buffer));
+
+        if (!stream.buffer)
+        {
+            sf::err() << "Failed to create the vertex stream buffer" << std::endl;
+            return false;
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, stream.buffer));
+
+#ifndef SFML_OPENGL_ES
+        if (GLEXT_buffer_storage && GLEXT_map_buffer_range && GLEXT_sync)
+        {
+            GLbitfield flags = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_PERSISTENT_BIT | GLEXT_GL_MAP_COHERENT_BIT;
+
+            glCheck(GLEXT_glBufferStorage(GLEXT_GL_ARRAY_BUFFER, size, NULL, flags));
+            glCheck(stream.mapping = static_cast<sf::Vertex*>(GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, 0, size, flags)));
+
+            if (stream.mapping)
+                return true;
+
+            // Immutable storage can't be respecified, start over with a mutable buffer
+            glCheck(GLEXT_glDeleteBuffers(1, &stream.buffer));
+            glCheck(GLEXT_glGenBuffers(1, &stream.buffer));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, stream.buffer));
+        }
+#endif
+
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, size, NULL, GLEXT_GL_STREAM_DRAW));
+
+        return true;
+    }
+
+    // Callback that is called every time a context is destroyed
+    void streamBufferContextDestroyCallback(void* /*arg*/)
+    {
+        sf::Lock lock(streamBufferMutex);
+
+        StreamMap::iterator iter = streams.find(sf::Context::getActiveContextId());
+        if (iter == streams.end())
+            return;
+
+        destroyStorage(iter->second);
+        streams.erase(iter);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool StreamBuffer::isAvailable()
+{
+    Lock lock(streamBufferMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        available = GLEXT_vertex_buffer_object;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int StreamBuffer::upload(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex)
+{
+    Lock lock(streamBufferMutex);
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    StreamMap::iterator iter = streams.find(contextId);
+
+    if (iter == streams.end())
+    {
+        // Register the context destruction callback
+        static bool registered = false;
+        if (!registered)
+        {
+            registerContextDestroyCallback(streamBufferContextDestroyCallback, 0);
+            registered = true;
+        }
+
+        Stream stream;
+        std::size_t regionSize = initialRegionSize;
+        while (regionSize < vertexCount)
+            regionSize *= 2;
+
+        if (!createStorage(stream, regionSize))
+            return 0;
+
+        iter = streams.insert(std::make_pair(contextId, stream)).first;
+    }
+    else
+    {
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, iter->second.buffer));
+    }
+
+    Stream& stream = iter->second;
+
+    // Grow the storage if a region is too small to hold the vertices
+    // Storage that is still read by pending draws is kept alive by the driver
+    if (vertexCount > stream.regionSize)
+    {
+        std::size_t regionSize = stream.regionSize;
+        while (regionSize < vertexCount)
+            regionSize *= 2;
+
+        // Create the new buffer first so that it doesn't recycle the name of the old one
+        Stream oldStream = stream;
+        bool created = createStorage(stream, regionSize);
+        destroyStorage(oldStream);
+
+        if (!created)
+        {
+            streams.erase(iter);
+            return 0;
+        }
+    }
+
+    // Vertices never straddle two regions, move on to the next one if needed
+    if (stream.offset + vertexCount > stream.regionSize)
+    {
+        insertFence(stream, stream.region);
+
+        stream.region = (stream.region + 1) % regionCount;
+        stream.offset = 0;
+
+        if (stream.mapping)
+        {
+            waitFence(stream, stream.region);
+        }
+        else if (stream.region == 0)
+        {
+            // Orphan the storage when wrapping around, pending draws keep reading the old one
+            glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * stream.regionSize * regionCount, NULL, GLEXT_GL_STREAM_DRAW));
+        }
+    }
+
+    std::size_t position = stream.region * stream.regionSize + stream.offset;
+
+    if (stream.mapping)
+        std::memcpy(stream.mapping + position, vertices, sizeof(Vertex) * vertexCount);
+    else
+        glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * position, sizeof(Vertex) * vertexCount, vertices));
+
+    firstVertex = position;
+    stream.offset += vertexCount;
+
+    return stream.buffer;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_STREAMBUFFER_HPP
+#define SFML_STREAMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Ring of vertex buffer storage that immediate-mode
+///        vertex arrays are streamed into
+///
+////////////////////////////////////////////////////////////
+class StreamBuffer : GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the system supports stream buffers
+    ///
+    /// \return True if vertices can be streamed into a buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy vertices into the stream buffer of the current context
+    ///
+    /// The buffer is created the first time this function is
+    /// called within a context, and is left bound to
+    /// GL_ARRAY_BUFFER when the function returns successfully.
+    ///
+    /// The storage is split in three regions that are
+    /// consumed in turn. When persistent mapping is
+    /// supported the vertices are written directly into
+    /// the mapped storage, and a fence guards every region
+    /// against being overwritten while the GPU still reads it.
+    /// Otherwise the storage is orphaned every time the
+    /// ring wraps around.
+    ///
+    /// The vertices must be drawn before the next call
+    /// to this function in the same context.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param firstVertex Receives the index of the first copied vertex in the buffer
+    ///
+    /// \return OpenGL name of the stream buffer, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int upload(const Vertex* vertices, std::size_t vertexCount, std::size_t& firstVertex);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_STREAMBUFFER_HPP
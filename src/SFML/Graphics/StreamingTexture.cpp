@@ -0,0 +1,564 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamingTexture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // Shared state of all the streaming textures, guarded by streamingMutex
+    sf::Mutex                           streamingMutex;
+    std::vector<sf::StreamingTexture*>  streamingTextures;
+    sf::Uint64                          memoryBudget   = 256 * 1024 * 1024;
+    sf::Uint64                          residentMemory = 0;
+    sf::Uint64                          reservedMemory = 0;
+    sf::Uint64                          currentFrame   = 1;
+
+    // Halve an image with a box filter, the result is the next mipmap level
+    void downsample(const sf::Image& source, sf::Image& target)
+    {
+        sf::Vector2u sourceSize = source.getSize();
+        sf::Vector2u targetSize(std::max(sourceSize.x / 2, 1u), std::max(sourceSize.y / 2, 1u));
+
+        const sf::Uint8* input = source.getPixelsPtr();
+        std::vector<sf::Uint8> output(targetSize.x * targetSize.y * 4);
+
+        for (unsigned int y = 0; y < targetSize.y; ++y)
+        {
+            // Odd sizes are rounded down, dimensions of 1 pixel are kept
+            const sf::Uint8* row0 = input + (y * 2) * sourceSize.x * 4;
+            const sf::Uint8* row1 = input + std::min(y * 2 + 1, sourceSize.y - 1) * sourceSize.x * 4;
+
+            for (unsigned int x = 0; x < targetSize.x; ++x)
+            {
+                unsigned int x0 = (x * 2) * 4;
+                unsigned int x1 = std::min(x * 2 + 1, sourceSize.x - 1) * 4;
+
+                sf::Uint8* pixel = &output[(y * targetSize.x + x) * 4];
+                for (unsigned int i = 0; i < 4; ++i)
+                    pixel[i] = static_cast<sf::Uint8>((row0[x0 + i] + row0[x1 + i] + row1[x0 + i] + row1[x1 + i] + 2) / 4);
+            }
+        }
+
+        target.create(targetSize.x, targetSize.y, &output[0]);
+    }
+
+    // Decode the levels [first, first + count) of an image, from the finest
+    void buildLevels(const sf::Image& image, unsigned int first, unsigned int count, std::vector<sf::Image>& levels)
+    {
+        levels.resize(count);
+
+        sf::Image current = image;
+        for (unsigned int level = 0; level < first + count; ++level)
+        {
+            if (level >= first)
+                levels[level - first] = current;
+
+            if (level + 1 < first + count)
+            {
+                sf::Image next;
+                downsample(current, next);
+                current = next;
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct StreamingTexture::Load
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the image file and build the requested levels
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        Image image;
+        succeeded = image.loadFromFile(filename);
+
+        if (succeeded)
+            succeeded = (image.getSize() == size);
+
+        if (succeeded)
+            buildLevels(image, first, count, levels);
+    }
+
+    std::string        filename;  ///< File to decode
+    Vector2u           size;      ///< Expected size of the image
+    unsigned int       first;     ///< Finest level to build
+    unsigned int       count;     ///< Number of levels to build
+    Uint64             memory;    ///< Video memory reserved for the levels
+    std::vector<Image> levels;    ///< Decoded levels, from the finest
+    bool               succeeded; ///< Were the levels built?
+    ThreadPool*        pool;      ///< Pool running the load, or NULL
+    ThreadPool::Task   task;      ///< Task of the pool running the load
+};
+
+
+////////////////////////////////////////////////////////////
+StreamingTexture::StreamingTexture() :
+m_texture       (),
+m_filename      (),
+m_size          (0, 0),
+m_streaming     (false),
+m_levelCount    (0),
+m_residentLevel (0),
+m_pinnedLevel   (0),
+m_requestedLevel(0),
+m_memory        (0),
+m_lastUse       (0),
+m_threadPool    (NULL),
+m_load          (NULL)
+{
+    Lock lock(streamingMutex);
+
+    streamingTextures.push_back(this);
+}
+
+
+////////////////////////////////////////////////////////////
+StreamingTexture::~StreamingTexture()
+{
+    Lock lock(streamingMutex);
+
+    if (m_load)
+    {
+        if (m_load->pool)
+            m_load->pool->wait(m_load->task);
+
+        reservedMemory -= m_load->memory;
+        delete m_load;
+    }
+
+    residentMemory -= m_memory;
+
+    streamingTextures.erase(std::find(streamingTextures.begin(), streamingTextures.end(), this));
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::loadFromFile(const std::string& filename, unsigned int residentSize)
+{
+    Lock lock(streamingMutex);
+
+    // Forget the previous content
+    if (m_load)
+    {
+        if (m_load->pool)
+            m_load->pool->wait(m_load->task);
+
+        reservedMemory -= m_load->memory;
+        delete m_load;
+        m_load = NULL;
+    }
+
+    residentMemory -= m_memory;
+    m_memory = 0;
+
+    Image image;
+    if (!image.loadFromFile(filename))
+        return false;
+
+    m_filename = filename;
+    m_size = image.getSize();
+
+    unsigned int largest = std::max(m_size.x, m_size.y);
+    m_levelCount = 1;
+    while ((largest >> m_levelCount) > 0)
+        ++m_levelCount;
+
+    TransientContextLock contextLock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    bool validSize = (Texture::getValidSize(m_size.x) == m_size.x) && (Texture::getValidSize(m_size.y) == m_size.y);
+    m_streaming = GLEXT_texture_lod && validSize && (largest <= Texture::getMaximumSize());
+
+    if (!m_streaming)
+    {
+        // The levels can't be streamed, load everything
+        if (!m_texture.loadFromImage(image))
+            return false;
+
+        m_residentLevel = 0;
+        m_pinnedLevel = 0;
+        m_requestedLevel = 0;
+        m_memory = m_texture.generateMipmap() ? getLevelMemory(0, m_levelCount) : getLevelMemory(0, 1);
+        residentMemory += m_memory;
+
+        return true;
+    }
+
+    // Find the finest level that always stays resident
+    m_pinnedLevel = 0;
+    while ((m_pinnedLevel + 1 < m_levelCount) && ((largest >> m_pinnedLevel) > residentSize))
+        ++m_pinnedLevel;
+
+    std::vector<Image> levels;
+    buildLevels(image, m_pinnedLevel, m_levelCount - m_pinnedLevel, levels);
+
+    // Create the texture with a placeholder level, then give it the full size
+    if (!m_texture.create(1, 1))
+        return false;
+
+    m_texture.m_size = m_size;
+    m_texture.m_actualSize = m_size;
+    m_texture.m_pixelsFlipped = false;
+    m_texture.m_hasMipmap = true;
+
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        GLint format = m_texture.m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA;
+
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture.m_texture));
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, format, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_levelCount - 1)));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_texture.m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+    }
+
+    m_residentLevel = m_levelCount;
+    uploadLevels(m_pinnedLevel, &levels[0], m_levelCount - m_pinnedLevel);
+    m_requestedLevel = m_pinnedLevel;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::setThreadPool(ThreadPool* pool)
+{
+    m_threadPool = pool;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::requestLevel(unsigned int level)
+{
+    Lock lock(streamingMutex);
+
+    m_requestedLevel = std::min(level, m_levelCount ? m_levelCount - 1 : 0);
+    m_lastUse = currentFrame;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::requestSize(unsigned int size)
+{
+    unsigned int largest = std::max(m_size.x, m_size.y);
+
+    unsigned int level = 0;
+    while ((level + 1 < m_levelCount) && ((largest >> (level + 1)) >= size))
+        ++level;
+
+    requestLevel(level);
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& StreamingTexture::getTexture()
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& StreamingTexture::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+StreamingTexture::Residency StreamingTexture::getResidency() const
+{
+    Lock lock(streamingMutex);
+
+    Residency residency;
+    residency.levelCount     = m_levelCount;
+    residency.residentLevel  = m_residentLevel;
+    residency.pinnedLevel    = m_pinnedLevel;
+    residency.requestedLevel = m_requestedLevel;
+    residency.loading        = (m_load != NULL);
+    residency.memory         = m_memory;
+
+    return residency;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::update()
+{
+    Lock lock(streamingMutex);
+
+    // Upload the levels decoded since the last call
+    for (std::vector<StreamingTexture*>::iterator it = streamingTextures.begin(); it != streamingTextures.end(); ++it)
+        (*it)->finishLoad(false);
+
+    // Start decoding the levels requested in this frame
+    for (std::vector<StreamingTexture*>::iterator it = streamingTextures.begin(); it != streamingTextures.end(); ++it)
+    {
+        StreamingTexture& texture = **it;
+
+        if (!texture.m_streaming || texture.m_load || (texture.m_lastUse != currentFrame) || (texture.m_requestedLevel >= texture.m_residentLevel))
+            continue;
+
+        // Load as many of the requested levels as the budget allows, coarsest first
+        unsigned int first = texture.m_requestedLevel;
+        while ((first < texture.m_residentLevel) && !reserveMemory(texture.getLevelMemory(first, texture.m_residentLevel), &texture))
+            ++first;
+
+        if (first == texture.m_residentLevel)
+            continue;
+
+        Load* load      = new Load;
+        load->filename  = texture.m_filename;
+        load->size      = texture.m_size;
+        load->first     = first;
+        load->count     = texture.m_residentLevel - first;
+        load->memory    = texture.getLevelMemory(first, texture.m_residentLevel);
+        load->succeeded = false;
+        load->pool      = texture.m_threadPool;
+
+        reservedMemory += load->memory;
+        texture.m_load = load;
+
+        if (load->pool)
+        {
+            load->task = load->pool->push(&Load::run, load);
+        }
+        else
+        {
+            load->run();
+            texture.finishLoad(true);
+        }
+    }
+
+    // Stay within the budget if it was lowered
+    reserveMemory(0, NULL);
+
+    ++currentFrame;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::setMemoryBudget(Uint64 bytes)
+{
+    Lock lock(streamingMutex);
+
+    memoryBudget = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 StreamingTexture::getMemoryBudget()
+{
+    Lock lock(streamingMutex);
+
+    return memoryBudget;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 StreamingTexture::getResidentMemory()
+{
+    Lock lock(streamingMutex);
+
+    return residentMemory;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u StreamingTexture::getLevelSize(unsigned int level) const
+{
+    return Vector2u(std::max(m_size.x >> level, 1u), std::max(m_size.y >> level, 1u));
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 StreamingTexture::getLevelMemory(unsigned int first, unsigned int last) const
+{
+    Uint64 memory = 0;
+
+    for (unsigned int level = first; level < last; ++level)
+    {
+        Vector2u size = getLevelSize(level);
+        memory += static_cast<Uint64>(size.x) * size.y * 4;
+    }
+
+    return memory;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::uploadLevels(unsigned int first, const Image* levels, unsigned int count)
+{
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    GLint format = m_texture.m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA;
+
+    // The new levels are not sampled until the base level is lowered
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture.m_texture));
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        Vector2u size = levels[i].getSize();
+        glCheck(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(first + i), format, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, levels[i].getPixelsPtr()));
+    }
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(first)));
+
+    Uint64 memory = getLevelMemory(first, first + count);
+    m_memory += memory;
+    residentMemory += memory;
+    m_residentLevel = first;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::evictLevel()
+{
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    GLint format = m_texture.m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA;
+
+    // Stop sampling the level before releasing its storage
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture.m_texture));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(m_residentLevel + 1)));
+    glCheck(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(m_residentLevel), format, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+    Uint64 memory = getLevelMemory(m_residentLevel, m_residentLevel + 1);
+    m_memory -= memory;
+    residentMemory -= memory;
+    ++m_residentLevel;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::finishLoad(bool block)
+{
+    if (!m_load)
+        return;
+
+    if (m_load->pool)
+    {
+        if (block)
+            m_load->pool->wait(m_load->task);
+        else if (!m_load->task.isDone())
+            return;
+    }
+
+    reservedMemory -= m_load->memory;
+
+    if (m_load->succeeded)
+        uploadLevels(m_load->first, &m_load->levels[0], m_load->count);
+    else
+        err() << "Failed to stream the mipmap levels of \"" << m_filename << "\"" << std::endl;
+
+    delete m_load;
+    m_load = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::reserveMemory(Uint64 bytes, const StreamingTexture* keep)
+{
+    if (residentMemory + reservedMemory + bytes <= memoryBudget)
+        return true;
+
+    // Don't evict anything if it can't free enough memory
+    Uint64 evictable = 0;
+    for (std::vector<StreamingTexture*>::iterator it = streamingTextures.begin(); it != streamingTextures.end(); ++it)
+    {
+        StreamingTexture* texture = *it;
+
+        if ((texture != keep) && texture->m_streaming && !texture->m_load && (texture->m_residentLevel < texture->m_pinnedLevel))
+        {
+            if (texture->m_lastUse < currentFrame)
+                evictable += texture->getLevelMemory(texture->m_residentLevel, texture->m_pinnedLevel);
+            else if (texture->m_residentLevel < texture->m_requestedLevel)
+                evictable += texture->getLevelMemory(texture->m_residentLevel, std::min(texture->m_requestedLevel, texture->m_pinnedLevel));
+        }
+    }
+
+    if ((keep != NULL) && (residentMemory + reservedMemory + bytes > memoryBudget + evictable))
+        return false;
+
+    while (residentMemory + reservedMemory + bytes > memoryBudget)
+    {
+        // Evict the levels that are not requested anymore first,
+        // then the ones of the least recently used textures
+        StreamingTexture* victim = NULL;
+        bool victimUnneeded = false;
+
+        for (std::vector<StreamingTexture*>::iterator it = streamingTextures.begin(); it != streamingTextures.end(); ++it)
+        {
+            StreamingTexture* texture = *it;
+
+            if ((texture == keep) || !texture->m_streaming || texture->m_load || (texture->m_residentLevel >= texture->m_pinnedLevel))
+                continue;
+
+            bool unneeded = (texture->m_residentLevel < texture->m_requestedLevel);
+            if (!unneeded && (texture->m_lastUse >= currentFrame))
+                continue;
+
+            if (!victim || (unneeded && !victimUnneeded) || ((unneeded == victimUnneeded) && (texture->m_lastUse < victim->m_lastUse)))
+            {
+                victim = texture;
+                victimUnneeded = unneeded;
+            }
+        }
+
+        if (!victim)
+            return false;
+
+        victim->evictLevel();
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -28,27 +28,60 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/DistanceFieldShader.hpp>
+#include <SFML/System/Arena.hpp>
+#include <SFML/System/FastLock.hpp>
+#include <SFML/System/FastMutex.hpp>
 #include <cmath>
+#include <cstring>
+#include <list>
+#include <map>
 
 
 namespace
 {
+    // Limits of the layout cache: layouts are evicted when the cached
+    // geometry exceeds the total, layouts larger than an entry aren't cached
+    const std::size_t maxCachedVertices = 65536;
+    const std::size_t maxEntryVertices  = 4096;
+
+    // Temporary geometry built by the layout, allocated from the thread's arena
+    typedef std::vector<sf::Vertex, sf::ArenaAllocator<sf::Vertex> > ScratchVertices;
+    typedef std::vector<unsigned int, sf::ArenaAllocator<unsigned int> > ScratchQuadTextures;
+
+    // Mix a value into a FNV-1a hash
+    void hashCombine(sf::Uint64& hash, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    sf::Uint32 floatBits(float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
     // Add an underline or strikethrough line to the vertex array
-    void addLine(sf::VertexArray& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
+    void addLine(ScratchVertices& vertices, float lineLength, float lineTop, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
     {
         float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
         float bottom = top + std::floor(thickness + 0.5f);
 
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
-        vertices.append(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(-outlineThickness,             top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(-outlineThickness,             bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(lineLength + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
     }
 
     // Add a glyph quad to the vertex array
-    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0)
+    void addGlyphQuad(ScratchVertices& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italicShear, float outlineThickness = 0)
     {
         float left   = glyph.bounds.left;
         float top    = glyph.bounds.top;
@@ -60,18 +93,287 @@ namespace
         float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
         float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
 
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
-        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u1, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left  - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italicShear * top    - outlineThickness, position.y + top    - outlineThickness), color, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - italicShear * bottom - outlineThickness, position.y + bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+    }
+
+    // Compute the offset of the vertices of each font texture, plus the total count;
+    // if the quads of a texture are not contiguous, a reordered copy of the vertices is made
+    void groupByTexture(const sf::VertexArray& vertices, const std::vector<unsigned int>& quadTextures,
+                        unsigned int textureCount, std::vector<std::size_t>& offsets, sf::VertexArray& grouped)
+    {
+        grouped.clear();
+
+        // Most texts only use the first texture, then there's nothing to count
+        if (textureCount <= 1)
+        {
+            offsets.resize(2);
+            offsets[0] = 0;
+            offsets[1] = vertices.getVertexCount();
+            return;
+        }
+
+        offsets.assign(textureCount + 1, 0);
+
+        // Count the quads of each texture
+        bool isGrouped = true;
+        for (std::size_t i = 0; i < quadTextures.size(); ++i)
+        {
+            ++offsets[quadTextures[i] + 1];
+
+            if ((i > 0) && (quadTextures[i] < quadTextures[i - 1]))
+                isGrouped = false;
+        }
+
+        for (std::size_t i = 1; i < offsets.size(); ++i)
+            offsets[i] += offsets[i - 1];
+
+        if (!isGrouped)
+        {
+            grouped.resize(vertices.getVertexCount());
+
+            sf::Arena::Scope scope(sf::Arena::getThreadArena());
+            std::vector<std::size_t, sf::ArenaAllocator<std::size_t> > next(offsets.begin(), offsets.end() - 1);
+            for (std::size_t i = 0; i < quadTextures.size(); ++i)
+            {
+                std::size_t destination = next[quadTextures[i]]++ * 6;
+                for (std::size_t j = 0; j < 6; ++j)
+                    grouped[destination + j] = vertices[i * 6 + j];
+            }
+        }
+
+        for (std::size_t i = 0; i < offsets.size(); ++i)
+            offsets[i] *= 6;
+    }
+
+    // Replace the vertices [begin, end) of an array with the ones of another array
+    void replaceVertices(sf::VertexArray& vertices, std::size_t begin, std::size_t end, const ScratchVertices& replacement)
+    {
+        std::size_t count = replacement.size();
+
+        if (count != end - begin)
+        {
+            // Move the following vertices
+            ScratchVertices tail(vertices.getVertexCount() - end);
+            for (std::size_t i = 0; i < tail.size(); ++i)
+                tail[i] = vertices[end + i];
+
+            vertices.resize(begin + count + tail.size());
+            for (std::size_t i = 0; i < tail.size(); ++i)
+                vertices[begin + count + i] = tail[i];
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+            vertices[begin + i] = replacement[i];
+    }
+
+    // Replace the quad textures matching the vertices [begin, end)
+    void replaceQuadTextures(std::vector<unsigned int>& quadTextures, std::size_t begin, std::size_t end, const ScratchQuadTextures& replacement)
+    {
+        quadTextures.erase(quadTextures.begin() + begin / 6, quadTextures.begin() + end / 6);
+        quadTextures.insert(quadTextures.begin() + begin / 6, replacement.begin(), replacement.end());
+    }
+
+    // Draw the vertices of each font texture
+    void drawByTexture(sf::RenderTarget& target, const sf::VertexArray& vertices, const std::vector<std::size_t>& offsets,
+                       const sf::Font& font, unsigned int characterSize, sf::RenderStates states)
+    {
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            if (offsets[i + 1] == offsets[i])
+                continue;
+
+            states.texture = &font.getTexture(characterSize, static_cast<unsigned int>(i));
+            target.draw(&vertices[offsets[i]], offsets[i + 1] - offsets[i], sf::Triangles, states);
+        }
+    }
+
+    // Draw the vertices of each font texture, stored in a vertex buffer after the given first vertex
+    void drawByTexture(sf::RenderTarget& target, const sf::VertexBuffer& buffer, std::size_t first, const std::vector<std::size_t>& offsets,
+                       const sf::Font& font, unsigned int characterSize, sf::RenderStates states)
+    {
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            if (offsets[i + 1] == offsets[i])
+                continue;
+
+            states.texture = &font.getTexture(characterSize, static_cast<unsigned int>(i));
+            target.draw(buffer, first + offsets[i], offsets[i + 1] - offsets[i], states);
+        }
     }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+/// Layouts shared between the texts displaying the same string
+/// with the same attributes, least recently used ones first
+////////////////////////////////////////////////////////////
+struct Text::LayoutCache
+{
+    struct Entry
+    {
+        Uint64                       hash;
+        Uint64                       fontId;
+        unsigned int                 characterSize;
+        Uint32                       style;
+        float                        letterSpacingFactor;
+        float                        lineSpacingFactor;
+        float                        outlineThickness;
+        String                       string;
+        VertexArray                  vertices;
+        VertexArray                  outlineVertices;
+        std::vector<unsigned int>    quadTextures;
+        std::vector<unsigned int>    outlineQuadTextures;
+        std::vector<CharacterLayout> layout;
+        FloatRect                    bounds;
+    };
+
+    typedef std::list<Entry>                           EntryList;
+    typedef std::multimap<Uint64, EntryList::iterator> EntryTable;
+
+    static Uint64 hash(const Text& text)
+    {
+        Uint64 value = 14695981039346656037ULL;
+
+        hashCombine(value, static_cast<Uint32>(text.m_font->m_cacheId));
+        hashCombine(value, static_cast<Uint32>(text.m_font->m_cacheId >> 32));
+        hashCombine(value, text.m_characterSize);
+        hashCombine(value, text.m_style);
+        hashCombine(value, floatBits(text.m_letterSpacingFactor));
+        hashCombine(value, floatBits(text.m_lineSpacingFactor));
+        hashCombine(value, floatBits(text.m_outlineThickness));
+
+        for (std::size_t i = 0; i < text.m_string.getSize(); ++i)
+            hashCombine(value, text.m_string[i]);
+
+        return value;
+    }
+
+    static EntryList::iterator find(const Text& text, Uint64 textHash)
+    {
+        std::pair<EntryTable::iterator, EntryTable::iterator> range = table.equal_range(textHash);
+        for (EntryTable::iterator it = range.first; it != range.second; ++it)
+        {
+            const Entry& entry = *it->second;
+
+            if ((entry.fontId == text.m_font->m_cacheId) &&
+                (entry.characterSize == text.m_characterSize) &&
+                (entry.style == text.m_style) &&
+                (entry.letterSpacingFactor == text.m_letterSpacingFactor) &&
+                (entry.lineSpacingFactor == text.m_lineSpacingFactor) &&
+                (entry.outlineThickness == text.m_outlineThickness) &&
+                (entry.string == text.m_string))
+                return it->second;
+        }
+
+        return entries.end();
+    }
+
+    static bool load(const Text& text)
+    {
+        if (text.m_string.isEmpty())
+            return false;
+
+        Uint64 textHash = hash(text);
+
+        FastLock lock(mutex);
+
+        EntryList::iterator entry = find(text, textHash);
+        if (entry == entries.end())
+            return false;
+
+        // Mark the entry as the most recently used
+        entries.splice(entries.begin(), entries, entry);
+
+        text.m_vertices            = entry->vertices;
+        text.m_outlineVertices     = entry->outlineVertices;
+        text.m_quadTextures        = entry->quadTextures;
+        text.m_outlineQuadTextures = entry->outlineQuadTextures;
+        text.m_layout              = entry->layout;
+        text.m_bounds              = entry->bounds;
+
+        // The colors are not part of the layout
+        for (std::size_t i = 0; i < text.m_vertices.getVertexCount(); ++i)
+            text.m_vertices[i].color = text.m_fillColor;
+        for (std::size_t i = 0; i < text.m_outlineVertices.getVertexCount(); ++i)
+            text.m_outlineVertices[i].color = text.m_outlineColor;
+
+        return true;
+    }
+
+    static void store(const Text& text)
+    {
+        std::size_t count = text.m_vertices.getVertexCount() + text.m_outlineVertices.getVertexCount();
+        if (text.m_string.isEmpty() || (count > maxEntryVertices))
+            return;
+
+        Uint64 textHash = hash(text);
+
+        FastLock lock(mutex);
+
+        // Another thread may have stored the same layout meanwhile
+        if (find(text, textHash) != entries.end())
+            return;
+
+        entries.push_front(Entry());
+
+        Entry& entry = entries.front();
+        entry.hash                = textHash;
+        entry.fontId              = text.m_font->m_cacheId;
+        entry.characterSize       = text.m_characterSize;
+        entry.style               = text.m_style;
+        entry.letterSpacingFactor = text.m_letterSpacingFactor;
+        entry.lineSpacingFactor   = text.m_lineSpacingFactor;
+        entry.outlineThickness    = text.m_outlineThickness;
+        entry.string              = text.m_string;
+        entry.vertices            = text.m_vertices;
+        entry.outlineVertices     = text.m_outlineVertices;
+        entry.quadTextures        = text.m_quadTextures;
+        entry.outlineQuadTextures = text.m_outlineQuadTextures;
+        entry.layout              = text.m_layout;
+        entry.bounds              = text.m_bounds;
+
+        table.insert(std::make_pair(textHash, entries.begin()));
+        vertexCount += count;
+
+        // Evict the least recently used layouts
+        while (vertexCount > maxCachedVertices)
+        {
+            EntryList::iterator last = --entries.end();
+
+            std::pair<EntryTable::iterator, EntryTable::iterator> range = table.equal_range(last->hash);
+            for (EntryTable::iterator it = range.first; it != range.second; ++it)
+            {
+                if (it->second == last)
+                {
+                    table.erase(it);
+                    break;
+                }
+            }
+
+            vertexCount -= last->vertices.getVertexCount() + last->outlineVertices.getVertexCount();
+            entries.erase(last);
+        }
+    }
+
+    static FastMutex   mutex;       ///< Mutex protecting the cache
+    static EntryList   entries;     ///< Cached layouts, most recently used first
+    static EntryTable  table;       ///< Cached layouts indexed by hash
+    static std::size_t vertexCount; ///< Total number of cached vertices
+};
+
+FastMutex                     Text::LayoutCache::mutex;
+Text::LayoutCache::EntryList  Text::LayoutCache::entries;
+Text::LayoutCache::EntryTable Text::LayoutCache::table;
+std::size_t                   Text::LayoutCache::vertexCount = 0;
+
+
 ////////////////////////////////////////////////////////////
 Text::Text() :
 m_string             (),
@@ -85,9 +387,21 @@ m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
 m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
+m_vertexOffsets      (),
+m_outlineVertexOffsets(),
+m_groupedVertices    (Triangles),
+m_groupedOutlineVertices(Triangles),
+m_quadTextures       (),
+m_outlineQuadTextures(),
+m_layout             (),
+m_vertexBufferEnabled(false),
+m_vertexBuffer       (Triangles, VertexBuffer::Static),
+m_vertexBufferNeedUpdate(false),
 m_bounds             (),
 m_geometryNeedUpdate (false),
-m_fontTextureId      (0)
+m_changeBegin        (String::InvalidPos),
+m_changeEnd          (String::InvalidPos),
+m_fontCacheId        (0)
 {
 
 }
@@ -106,9 +420,21 @@ m_outlineColor       (0, 0, 0),
 m_outlineThickness   (0),
 m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
+m_vertexOffsets      (),
+m_outlineVertexOffsets(),
+m_groupedVertices    (Triangles),
+m_groupedOutlineVertices(Triangles),
+m_quadTextures       (),
+m_outlineQuadTextures(),
+m_layout             (),
+m_vertexBufferEnabled(false),
+m_vertexBuffer       (Triangles, VertexBuffer::Static),
+m_vertexBufferNeedUpdate(false),
 m_bounds             (),
 m_geometryNeedUpdate (true),
-m_fontTextureId      (0)
+m_changeBegin        (String::InvalidPos),
+m_changeEnd          (String::InvalidPos),
+m_fontCacheId        (0)
 {
 
 }
@@ -117,11 +443,64 @@ m_fontTextureId      (0)
 ////////////////////////////////////////////////////////////
 void Text::setString(const String& string)
 {
-    if (m_string != string)
+    // Find the first character that changed
+    std::size_t size = std::min(m_string.getSize(), string.getSize());
+    std::size_t begin = 0;
+    while ((begin < size) && (m_string[begin] == string[begin]))
+        ++begin;
+
+    if ((begin == size) && (m_string.getSize() == string.getSize()))
+        return;
+
+    // If characters were replaced, find the last one that changed:
+    // the geometry of the following ones can be kept if the layout allows it
+    std::size_t end = String::InvalidPos;
+    if (m_string.getSize() == string.getSize())
     {
-        m_string = string;
-        m_geometryNeedUpdate = true;
+        end = string.getSize();
+        while ((end > begin) && (m_string[end - 1] == string[end - 1]))
+            --end;
+    }
+
+    addStringChange(begin, end);
+
+    m_string = string;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setString(const Utf8String& string)
+{
+    // Find the first character that changed, decoding the new ones on the fly
+    Utf8String::ConstIterator it = string.begin();
+    std::size_t begin = 0;
+    while ((it != string.end()) && (begin < m_string.getSize()) && (*it == m_string[begin]))
+    {
+        ++it;
+        ++begin;
+    }
+
+    if ((it == string.end()) && (begin == m_string.getSize()))
+        return;
+
+    // Only the characters following the first change are converted
+    std::basic_string<Uint32> changed;
+    for (; it != string.end(); ++it)
+        changed.push_back(*it);
+
+    // If characters were replaced, find the last one that changed
+    std::size_t end = String::InvalidPos;
+    if (begin + changed.size() == m_string.getSize())
+    {
+        end = m_string.getSize();
+        while ((end > begin) && (m_string[end - 1] == changed[end - 1 - begin]))
+            --end;
     }
+
+    addStringChange(begin, end);
+
+    m_string.erase(begin, String::InvalidPos);
+    m_string += String(changed);
 }
 
 
@@ -200,6 +579,10 @@ void Text::setFillColor(const Color& color)
         {
             for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
                 m_vertices[i].color = m_fillColor;
+            for (std::size_t i = 0; i < m_groupedVertices.getVertexCount(); ++i)
+                m_groupedVertices[i].color = m_fillColor;
+
+            m_vertexBufferNeedUpdate = true;
         }
     }
 }
@@ -218,6 +601,10 @@ void Text::setOutlineColor(const Color& color)
         {
             for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
                 m_outlineVertices[i].color = m_outlineColor;
+            for (std::size_t i = 0; i < m_groupedOutlineVertices.getVertexCount(); ++i)
+                m_groupedOutlineVertices[i].color = m_outlineColor;
+
+            m_vertexBufferNeedUpdate = true;
         }
     }
 }
@@ -234,6 +621,21 @@ void Text::setOutlineThickness(float thickness)
 }
 
 
+////////////////////////////////////////////////////////////
+void Text::setVertexBufferEnabled(bool enabled)
+{
+    if (enabled != m_vertexBufferEnabled)
+    {
+        m_vertexBufferEnabled = enabled;
+        m_vertexBufferNeedUpdate = true;
+
+        // Release the buffer when it is not used anymore
+        if (!enabled)
+            VertexBuffer(Triangles, VertexBuffer::Static).swap(m_vertexBuffer);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 const String& Text::getString() const
 {
@@ -304,6 +706,13 @@ float Text::getOutlineThickness() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Text::isVertexBufferEnabled() const
+{
+    return m_vertexBufferEnabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -311,39 +720,16 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
+    // The positions of the characters are cached with the geometry
+    ensureGeometryUpdate();
+
     // Adjust the index if it's out of range
     if (index > m_string.getSize())
         index = m_string.getSize();
 
-    // Precompute the variables needed by the algorithm
-    bool  isBold          = m_style & Bold;
-    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
-    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
-    whitespaceWidth      += letterSpacing;
-    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-
-    // Compute the position
-    Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
-    {
-        Uint32 curChar = m_string[i];
-
-        // Apply the kerning offset
-        position.x += m_font->getKerning(prevChar, curChar, m_characterSize);
-        prevChar = curChar;
-
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ':  position.x += whitespaceWidth;             continue;
-            case '\t': position.x += whitespaceWidth * 4;         continue;
-            case '\n': position.y += lineSpacing; position.x = 0; continue;
-        }
-
-        // For regular characters, add the advance offset of the glyph
-        position.x += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
-    }
+    // The layout starts on the baseline of the first line
+    Vector2f position = m_layout[index].position;
+    position.y -= static_cast<float>(m_characterSize);
 
     // Transform the position to global coordinates
     position = getTransform().transformPoint(position);
@@ -376,13 +762,78 @@ void Text::draw(RenderTarget& target, RenderStates states) const
         ensureGeometryUpdate();
 
         states.transform *= getTransform();
-        states.texture = &m_font->getTexture(m_characterSize);
 
-        // Only draw the outline if there is something to draw
-        if (m_outlineThickness != 0)
-            target.draw(m_outlineVertices, states);
+        // Distance field glyphs need a shader to turn distances into coverage, unless the user provides their own
+        bool distanceField = m_font->isDistanceFieldEnabled() && !states.shader;
+
+        const VertexArray& outlineVertices = m_groupedOutlineVertices.getVertexCount() ? m_groupedOutlineVertices : m_outlineVertices;
+        const VertexArray& vertices        = m_groupedVertices.getVertexCount() ? m_groupedVertices : m_vertices;
+
+        RenderStates outlineStates = states;
+        if (distanceField)
+        {
+            outlineStates.shader = priv::DistanceFieldShader::get(m_font->getDistanceFieldEdge(m_characterSize, m_outlineThickness));
+            states.shader = priv::DistanceFieldShader::get(m_font->getDistanceFieldEdge(m_characterSize, 0));
+        }
+
+        std::size_t outlineCount = outlineVertices.getVertexCount();
+        std::size_t count        = vertices.getVertexCount();
+
+        if (m_vertexBufferEnabled && VertexBuffer::isAvailable() && (outlineCount + count > 0))
+        {
+            // Upload the geometry again if it changed since the last draw
+            if (m_vertexBufferNeedUpdate)
+            {
+                if (m_vertexBuffer.getVertexCount() != outlineCount + count)
+                    m_vertexBuffer.create(outlineCount + count);
+
+                if (outlineCount > 0)
+                    m_vertexBuffer.update(&outlineVertices[0], outlineCount, 0);
+                if (count > 0)
+                    m_vertexBuffer.update(&vertices[0], count, static_cast<unsigned int>(outlineCount));
+
+                m_vertexBufferNeedUpdate = false;
+            }
+
+            // Only draw the outline if there is something to draw
+            if (m_outlineThickness != 0)
+                drawByTexture(target, m_vertexBuffer, 0, m_outlineVertexOffsets, *m_font, m_characterSize, outlineStates);
+
+            drawByTexture(target, m_vertexBuffer, outlineCount, m_vertexOffsets, *m_font, m_characterSize, states);
+        }
+        else
+        {
+            // Only draw the outline if there is something to draw
+            if (m_outlineThickness != 0)
+                drawByTexture(target, outlineVertices, m_outlineVertexOffsets, *m_font, m_characterSize, outlineStates);
 
-        target.draw(m_vertices, states);
+            drawByTexture(target, vertices, m_vertexOffsets, *m_font, m_characterSize, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Text::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::addStringChange(std::size_t begin, std::size_t end)
+{
+    // Merge with the changes made since the last geometry update
+    if (m_changeBegin == String::InvalidPos)
+    {
+        m_changeBegin = begin;
+        m_changeEnd = end;
+    }
+    else
+    {
+        m_changeBegin = std::min(m_changeBegin, begin);
+        m_changeEnd = ((m_changeEnd == String::InvalidPos) || (end == String::InvalidPos)) ? String::InvalidPos : std::max(m_changeEnd, end);
     }
 }
 
@@ -393,25 +844,66 @@ void Text::ensureGeometryUpdate() const
     if (!m_font)
         return;
 
-    // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    // The whole geometry must be rebuilt when an attribute changed, or when
+    // the font discarded its glyphs since the last update (it may have been reloaded);
+    // the textures are not touched here, so that texts can be laid out from any thread
+    bool rebuild = m_geometryNeedUpdate || m_layout.empty() || (m_font->m_cacheId != m_fontCacheId);
+
+    // Do nothing, if neither the geometry nor the string has changed
+    if (!rebuild && (m_changeBegin == String::InvalidPos))
         return;
 
-    // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    // Only the characters starting from the first changed one are laid out again
+    std::size_t begin = rebuild ? 0 : m_changeBegin;
+    std::size_t end   = rebuild ? String::InvalidPos : m_changeEnd;
 
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
+    m_changeBegin = String::InvalidPos;
+    m_changeEnd = String::InvalidPos;
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
-    m_bounds = FloatRect();
+    if (rebuild)
+    {
+        // Clear the previous geometry
+        m_vertices.clear();
+        m_outlineVertices.clear();
+        m_quadTextures.clear();
+        m_outlineQuadTextures.clear();
+
+        // Start on the baseline of the first line, with empty bounds
+        CharacterLayout first;
+        first.position  = Vector2f(0.f, static_cast<float>(m_characterSize));
+        first.boundsMin = Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize));
+        first.boundsMax = Vector2f(0.f, 0.f);
+        m_layout.assign(1, first);
+    }
+
+    // Lay out the characters, unless another text already did it
+    if (!rebuild || !LayoutCache::load(*this))
+    {
+        updateLayout(begin, end);
+
+        // Share the new layout with the texts displaying the same string
+        if (rebuild)
+            LayoutCache::store(*this);
+    }
+
+    // Group the quads by font texture
+    unsigned int textureCount = m_font->getTextureCount(m_characterSize);
+    groupByTexture(m_vertices, m_quadTextures, textureCount, m_vertexOffsets, m_groupedVertices);
+    groupByTexture(m_outlineVertices, m_outlineQuadTextures, textureCount, m_outlineVertexOffsets, m_groupedOutlineVertices);
+
+    // The vertex buffer, if used, must be uploaded again
+    m_vertexBufferNeedUpdate = true;
+
+    // Save the current glyphs id of the font, now that the new glyphs are loaded
+    m_fontCacheId = m_font->m_cacheId;
+}
 
-    // No text: nothing to draw
-    if (m_string.isEmpty())
-        return;
 
+////////////////////////////////////////////////////////////
+void Text::updateLayout(std::size_t begin, std::size_t end) const
+{
     // Compute values related to the text style
     bool  isBold             = m_style & Bold;
     bool  isUnderlined       = m_style & Underlined;
@@ -431,17 +923,57 @@ void Text::ensureGeometryUpdate() const
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
     float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-    float x               = 0.f;
-    float y               = static_cast<float>(m_characterSize);
+
+    // Resume the layout where the first changed character starts
+    CharacterLayout start = m_layout[begin];
+    float  x        = start.position.x;
+    float  y        = start.position.y;
+    float  minX     = start.boundsMin.x;
+    float  minY     = start.boundsMin.y;
+    float  maxX     = start.boundsMax.x;
+    float  maxY     = start.boundsMax.y;
+    Uint32 prevChar = (begin > 0) ? m_string[begin - 1] : 0;
+
+    // Geometry of the characters laid out again, and the font texture of every
+    // quad (the lines use the white pixel of the first texture); they only live
+    // until the end of the update, so they are taken from the thread's arena
+    Arena::Scope scope(Arena::getThreadArena());
+    ScratchVertices vertices;
+    ScratchVertices outlineVertices;
+    ScratchQuadTextures quadTextures;
+    ScratchQuadTextures outlineQuadTextures;
+
+    // Character from which the previous layout remains valid, if any
+    std::size_t reuse = String::InvalidPos;
 
     // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    for (std::size_t i = begin; i < m_string.getSize(); ++i)
     {
+        // Save the layout state before the character
+        CharacterLayout current;
+        current.position           = Vector2f(x, y);
+        current.boundsMin          = Vector2f(minX, minY);
+        current.boundsMax          = Vector2f(maxX, maxY);
+        current.vertexCount        = start.vertexCount + vertices.size();
+        current.outlineVertexCount = start.outlineVertexCount + outlineVertices.size();
+
+        // When characters were replaced, the previous layout of the following ones
+        // is still valid once an unchanged character (preceded by another unchanged
+        // one, for the kerning) starts in the same state as before
+        if ((end != String::InvalidPos) && (i > end) &&
+            (current.position == m_layout[i].position) &&
+            (current.boundsMin == m_layout[i].boundsMin) &&
+            (current.boundsMax == m_layout[i].boundsMax))
+        {
+            reuse = i;
+            break;
+        }
+
+        if (i < m_layout.size())
+            m_layout[i] = current;
+        else
+            m_layout.push_back(current);
+
         Uint32 curChar = m_string[i];
 
         // Apply the kerning offset
@@ -451,19 +983,19 @@ void Text::ensureGeometryUpdate() const
         // If we're using the underlined style and there's a new line, draw a line
         if (isUnderlined && (curChar == L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+            addLine(vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+                addLine(outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
         }
 
         // If we're using the strike through style and there's a new line, draw a line across all characters
         if (isStrikeThrough && (curChar == L'\n'))
         {
-            addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+            addLine(vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
             if (m_outlineThickness != 0)
-                addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+                addLine(outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
         }
 
         // Handle special characters
@@ -499,7 +1031,9 @@ void Text::ensureGeometryUpdate() const
             float bottom = glyph.bounds.top  + glyph.bounds.height;
 
             // Add the outline glyph to the vertices
-            addGlyphQuad(m_outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
+            addGlyphQuad(outlineVertices, Vector2f(x, y), m_outlineColor, glyph, italicShear, m_outlineThickness);
+            outlineQuadTextures.resize(outlineVertices.size() / 6, 0);
+            outlineQuadTextures.back() = glyph.textureIndex;
 
             // Update the current bounds with the outlined glyph bounds
             minX = std::min(minX, x + left   - italicShear * bottom - m_outlineThickness);
@@ -512,7 +1046,9 @@ void Text::ensureGeometryUpdate() const
         const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
 
         // Add the glyph to the vertices
-        addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
+        addGlyphQuad(vertices, Vector2f(x, y), m_fillColor, glyph, italicShear);
+        quadTextures.resize(vertices.size() / 6, 0);
+        quadTextures.back() = glyph.textureIndex;
 
         // Update the current bounds with the non outlined glyph bounds
         if (m_outlineThickness == 0)
@@ -532,29 +1068,91 @@ void Text::ensureGeometryUpdate() const
         x += glyph.advance + letterSpacing;
     }
 
-    // If we're using the underlined style, add the last line
-    if (isUnderlined && (x > 0))
+    if (reuse == String::InvalidPos)
     {
-        addLine(m_vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
+        // Save the layout state after the last character
+        CharacterLayout last;
+        last.position           = Vector2f(x, y);
+        last.boundsMin          = Vector2f(minX, minY);
+        last.boundsMax          = Vector2f(maxX, maxY);
+        last.vertexCount        = start.vertexCount + vertices.size();
+        last.outlineVertexCount = start.outlineVertexCount + outlineVertices.size();
+        m_layout.resize(m_string.getSize() + 1);
+        m_layout.back() = last;
+
+        // If we're using the underlined style, add the last line
+        if (isUnderlined && (x > 0))
+        {
+            addLine(vertices, x, y, m_fillColor, underlineOffset, underlineThickness);
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
-    }
+            if (m_outlineThickness != 0)
+                addLine(outlineVertices, x, y, m_outlineColor, underlineOffset, underlineThickness, m_outlineThickness);
+        }
+
+        // If we're using the strike through style, add the last line across all characters
+        if (isStrikeThrough && (x > 0))
+        {
+            addLine(vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
 
-    // If we're using the strike through style, add the last line across all characters
-    if (isStrikeThrough && (x > 0))
+            if (m_outlineThickness != 0)
+                addLine(outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+        }
+
+        // Account for the lines added after the last glyph
+        quadTextures.resize(vertices.size() / 6, 0);
+        outlineQuadTextures.resize(outlineVertices.size() / 6, 0);
+
+        // Replace the geometry of the changed characters and everything after them
+        replaceVertices(m_vertices, start.vertexCount, m_vertices.getVertexCount(), vertices);
+        replaceVertices(m_outlineVertices, start.outlineVertexCount, m_outlineVertices.getVertexCount(), outlineVertices);
+        replaceQuadTextures(m_quadTextures, start.vertexCount, m_quadTextures.size() * 6, quadTextures);
+        replaceQuadTextures(m_outlineQuadTextures, start.outlineVertexCount, m_outlineQuadTextures.size() * 6, outlineQuadTextures);
+
+        // Update the bounding rectangle
+        if (m_string.isEmpty())
+            m_bounds = FloatRect();
+        else
+            m_bounds = FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
+    else
     {
-        addLine(m_vertices, x, y, m_fillColor, strikeThroughOffset, underlineThickness);
+        // Account for the lines added after the last glyph
+        quadTextures.resize(vertices.size() / 6, 0);
+        outlineQuadTextures.resize(outlineVertices.size() / 6, 0);
+
+        // Replace the geometry of the changed characters only
+        std::size_t vertexEnd        = m_layout[reuse].vertexCount;
+        std::size_t outlineVertexEnd = m_layout[reuse].outlineVertexCount;
+        replaceVertices(m_vertices, start.vertexCount, vertexEnd, vertices);
+        replaceVertices(m_outlineVertices, start.outlineVertexCount, outlineVertexEnd, outlineVertices);
+        replaceQuadTextures(m_quadTextures, start.vertexCount, vertexEnd, quadTextures);
+        replaceQuadTextures(m_outlineQuadTextures, start.outlineVertexCount, outlineVertexEnd, outlineQuadTextures);
+
+        // Shift the vertices of the following characters if the number of quads changed
+        std::size_t newVertexEnd        = start.vertexCount + vertices.size();
+        std::size_t newOutlineVertexEnd = start.outlineVertexCount + outlineVertices.size();
+        if ((newVertexEnd != vertexEnd) || (newOutlineVertexEnd != outlineVertexEnd))
+        {
+            for (std::size_t i = reuse; i < m_layout.size(); ++i)
+            {
+                m_layout[i].vertexCount        = m_layout[i].vertexCount - vertexEnd + newVertexEnd;
+                m_layout[i].outlineVertexCount = m_layout[i].outlineVertexCount - outlineVertexEnd + newOutlineVertexEnd;
+            }
+        }
 
-        if (m_outlineThickness != 0)
-            addLine(m_outlineVertices, x, y, m_outlineColor, strikeThroughOffset, underlineThickness, m_outlineThickness);
+        // The layout ends in the same state, the bounds are unchanged
     }
+}
 
-    // Update the bounding rectangle
-    m_bounds.left = minX;
-    m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
-    m_bounds.height = maxY - minY;
+
+////////////////////////////////////////////////////////////
+Text::CharacterLayout::CharacterLayout() :
+position          (),
+boundsMin         (),
+boundsMax         (),
+vertexCount       (0),
+outlineVertexCount(0)
+{
 }
 
 } // namespace sf
@@ -27,27 +27,37 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/BufferedInputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 
 namespace
 {
-    sf::Mutex idMutex;
+    sf::Mutex textureIdMutex;
     sf::Mutex maximumSizeMutex;
 
+    // Number of pixel buffers a streamed texture cycles through
+    const std::size_t pixelBufferCount = 3;
+
     // Thread-safe unique identifier generator,
     // is used for states cache (see RenderTarget)
-    sf::Uint64 getUniqueId()
+    sf::Uint64 getUniqueTextureId()
     {
-        sf::Lock lock(idMutex);
+        sf::Lock lock(textureIdMutex);
 
         static sf::Uint64 id = 1; // start at 1, zero is "no texture"
 
@@ -69,7 +79,16 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_immutable    (false),
+m_internalFormat(0),
+m_cacheId      (getUniqueTextureId()),
+m_resolveSource(NULL),
+m_pixelBuffers (),
+m_pixelBufferIndex(0),
+m_updatePixels (),
+m_updateArea   (),
+m_updating     (false),
+m_updateMapped (false)
 {
 }
 
@@ -85,7 +104,16 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_immutable    (false),
+m_internalFormat(0),
+m_cacheId      (getUniqueTextureId()),
+m_resolveSource(NULL),
+m_pixelBuffers (),
+m_pixelBufferIndex(0),
+m_updatePixels (),
+m_updateArea   (),
+m_updating     (false),
+m_updateMapped (false)
 {
     if (copy.m_texture)
     {
@@ -108,19 +136,55 @@ m_cacheId      (getUniqueId())
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
-    // Destroy the OpenGL texture
-    if (m_texture)
+    if (m_texture || !m_pixelBuffers.empty())
     {
         TransientContextLock lock;
 
-        GLuint texture = static_cast<GLuint>(m_texture);
-        glCheck(glDeleteTextures(1, &texture));
+        // Destroy the OpenGL texture
+        if (m_texture)
+        {
+            GLuint texture = static_cast<GLuint>(m_texture);
+            glCheck(glDeleteTextures(1, &texture));
+        }
+
+#ifndef SFML_OPENGL_ES
+
+        // Destroy the streaming pixel buffers
+        for (std::size_t i = 0; i < m_pixelBuffers.size(); ++i)
+        {
+            GLuint buffer = static_cast<GLuint>(m_pixelBuffers[i]);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+
+#endif // SFML_OPENGL_ES
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::create(unsigned int width, unsigned int height)
+{
+    return create(width, height, 0, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::create(unsigned int width, unsigned int height, unsigned int levelCount)
+{
+    // Immutable storage can't grow levels later, 0 asks for the complete chain
+    unsigned int maxLevelCount = 1;
+    for (unsigned int size = std::max(getValidSize(width), getValidSize(height)); size > 1; size /= 2)
+        ++maxLevelCount;
+
+    if ((levelCount == 0) || (levelCount > maxLevelCount))
+        levelCount = maxLevelCount;
+
+    return create(width, height, 0, levelCount);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::create(unsigned int width, unsigned int height, unsigned int internalFormat, unsigned int levelCount)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -149,9 +213,19 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_resolveSource = NULL;
 
     TransientContextLock lock;
 
+    // Immutable storage can't be specified again, start over with a new texture
+    if (m_immutable)
+    {
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+        m_texture = 0;
+        m_immutable = false;
+    }
+
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
     {
@@ -203,16 +277,56 @@ bool Texture::create(unsigned int width, unsigned int height)
         m_sRgb = false;
     }
 
+    // Floating point formats don't take pixels in the default format
+    GLint  format = m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA;
+    GLenum pixelFormat = GL_RGBA;
+    GLenum pixelType = GL_UNSIGNED_BYTE;
+
+#ifndef SFML_OPENGL_ES
+
+    if (internalFormat)
+    {
+        format = static_cast<GLint>(internalFormat);
+        pixelFormat = (internalFormat == GLEXT_GL_R11F_G11F_B10F) ? GL_RGB : GL_RGBA;
+        pixelType = GL_FLOAT;
+    }
+
+#endif
+
     // Initialize the texture
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+#ifndef SFML_OPENGL_ES
+
+    // When the number of levels is known, allocate them all at once as immutable
+    // storage, the driver doesn't have to validate the texture on every use then
+    m_immutable = (levelCount > 1) && GLEXT_texture_storage;
+
+    if (m_immutable)
+    {
+        GLenum storageFormat = internalFormat ? static_cast<GLenum>(internalFormat) : (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GLEXT_GL_RGBA8);
+        glCheck(GLEXT_glTexStorage2D(GL_TEXTURE_2D, static_cast<GLsizei>(levelCount), storageFormat, m_actualSize.x, m_actualSize.y));
+    }
+    else
+
+#endif
+
+    {
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, format, m_actualSize.x, m_actualSize.y, 0, pixelFormat, pixelType, NULL));
+
+        // Keep generateMipmap to the requested number of levels (1000 is the default)
+        if (GLEXT_texture_lod)
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_MAX_LEVEL, (levelCount > 1) ? static_cast<GLint>(levelCount - 1) : 1000));
+    }
+
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-    m_cacheId = getUniqueId();
+    m_cacheId = getUniqueTextureId();
 
     m_hasMipmap = false;
+    m_internalFormat = internalFormat;
 
     return true;
 }
@@ -221,6 +335,21 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
+    // Pre-compressed containers are uploaded as they are, directly from
+    // the mapped file when possible, other files are decoded
+    MappedFileInputStream mapped;
+    if (mapped.open(filename))
+    {
+        if (mapped.getData() && priv::ImageLoader::getInstance().isCompressedImage(mapped.getData(), static_cast<std::size_t>(mapped.getSize())))
+            return loadFromMemory(mapped.getData(), static_cast<std::size_t>(mapped.getSize()), area);
+    }
+    else
+    {
+        BufferedInputStream stream;
+        if (stream.open(filename) && priv::ImageLoader::getInstance().isCompressedImage(stream))
+            return loadFromStream(stream, area);
+    }
+
     Image image;
     return image.loadFromFile(filename) && loadFromImage(image, area);
 }
@@ -229,6 +358,14 @@ bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
+    priv::ImageLoader& loader = priv::ImageLoader::getInstance();
+
+    if (loader.isCompressedImage(data, size))
+    {
+        priv::CompressedImage image;
+        return loader.loadCompressedImageFromMemory(data, size, image) && loadFromCompressedImage(image, area);
+    }
+
     Image image;
     return image.loadFromMemory(data, size) && loadFromImage(image, area);
 }
@@ -237,6 +374,14 @@ bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
+    priv::ImageLoader& loader = priv::ImageLoader::getInstance();
+
+    if (loader.isCompressedImage(stream))
+    {
+        priv::CompressedImage image;
+        return loader.loadCompressedImageFromStream(stream, image) && loadFromCompressedImage(image, area);
+    }
+
     Image image;
     return image.loadFromStream(stream) && loadFromImage(image, area);
 }
@@ -245,67 +390,24 @@ bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromImage(const Image& image, const IntRect& area)
 {
-    // Retrieve the image size
-    int width = static_cast<int>(image.getSize().x);
-    int height = static_cast<int>(image.getSize().y);
+    // An empty area, or one that contains the whole image, loads the entire image
+    return loadFromImage(ImageView(image, area));
+}
 
-    // Load the entire image if the source area is either empty or contains the whole image
-    if (area.width == 0 || (area.height == 0) ||
-       ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImage(const ImageView& image)
+{
+    // Create the texture and upload the pixels, strided rows are uploaded as they are
+    if (create(image.getSize().x, image.getSize().y))
     {
-        // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
-        {
-            update(image);
+        update(image);
 
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return true;
     }
     else
     {
-        // Load a sub-area of the image
-
-        // Adjust the rectangle to the size of the image
-        IntRect rectangle = area;
-        if (rectangle.left   < 0) rectangle.left = 0;
-        if (rectangle.top    < 0) rectangle.top  = 0;
-        if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
-        if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
-
-        // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
-        {
-            TransientContextLock lock;
-
-            // Make sure that the current texture binding will be preserved
-            priv::TextureSaver save;
-
-            // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-            for (int i = 0; i < rectangle.height; ++i)
-            {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
-            }
-
-            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-            m_hasMipmap = false;
-
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
-
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return false;
     }
 }
 
@@ -326,6 +428,8 @@ Image Texture::copyToImage() const
 
     TransientContextLock lock;
 
+    resolveRenderTexture();
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
@@ -410,11 +514,55 @@ void Texture::update(const Uint8* pixels)
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
 {
+    update(ImageView(pixels, Vector2u(width, height)), x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& image)
+{
+    // Update the whole texture
+    update(image, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& image, unsigned int x, unsigned int y)
+{
+    SFML_PROFILE_SCOPE("Texture::update");
+
+    const Uint8* pixels = image.getPixelsPtr();
+    unsigned int width  = image.getSize().x;
+    unsigned int height = image.getSize().y;
+    std::size_t  rowSize = static_cast<std::size_t>(width) * 4;
+
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
     if (pixels && m_texture)
     {
+        // Once the texture streams its updates, keep going through the pixel buffers
+        if (!m_pixelBuffers.empty() && !m_updating)
+        {
+            Uint8* destination = beginUpdate(width, height, x, y);
+
+            if (destination)
+            {
+                if (image.isContiguous())
+                {
+                    std::memcpy(destination, pixels, rowSize * height);
+                }
+                else
+                {
+                    for (unsigned int row = 0; row < height; ++row)
+                        std::memcpy(destination + row * rowSize, pixels + row * image.getStride(), rowSize);
+                }
+
+                endUpdate();
+                return;
+            }
+        }
+
         TransientContextLock lock;
 
         // Make sure that the current texture binding will be preserved
@@ -422,11 +570,35 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 
         // Copy pixels from the given array to the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+        if (image.isContiguous())
+        {
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        }
+        else
+        {
+
+#ifndef SFML_OPENGL_ES
+
+            // The rows of the view are apart in memory, let the driver skip the gaps
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(image.getStride() / 4)));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+
+#else
+
+            // OpenGL ES 2 can't skip the gaps, upload the rows one by one
+            for (unsigned int row = 0; row < height; ++row)
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y + row, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels + row * image.getStride()));
+
+#endif
+
+        }
+
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = false;
-        m_cacheId = getUniqueId();
+        m_cacheId = getUniqueTextureId();
 
         // Force an OpenGL flush, so that the texture data will appear updated
         // in all contexts immediately (solves problems in multi-threaded apps)
@@ -435,6 +607,155 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 }
 
 
+////////////////////////////////////////////////////////////
+Uint8* Texture::beginUpdate()
+{
+    return beginUpdate(m_size.x, m_size.y, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* Texture::beginUpdate(unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+    if (!m_texture || !width || !height)
+        return NULL;
+
+    if (m_updating)
+    {
+        err() << "Failed to begin texture update, another update is already pending" << std::endl;
+        return NULL;
+    }
+
+    m_updateArea = IntRect(static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height));
+
+    std::size_t size = static_cast<std::size_t>(width) * height * 4;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    priv::ensureExtensionsInit();
+
+    if (GLEXT_pixel_buffer_object && GLEXT_vertex_buffer_object)
+    {
+        // Create the ring of pixel buffers the first time the texture streams
+        if (m_pixelBuffers.empty())
+        {
+            for (std::size_t i = 0; i < pixelBufferCount; ++i)
+            {
+                GLuint buffer = 0;
+                glCheck(GLEXT_glGenBuffers(1, &buffer));
+
+                if (!buffer)
+                    break;
+
+                m_pixelBuffers.push_back(static_cast<unsigned int>(buffer));
+            }
+        }
+
+        if (!m_pixelBuffers.empty())
+        {
+            // Cycle through the buffers so that we don't write into one
+            // the driver may still be reading from a previous update
+            m_pixelBufferIndex = (m_pixelBufferIndex + 1) % m_pixelBuffers.size();
+
+            void* mapping = NULL;
+
+            // Orphan the previous storage before mapping, the driver then hands
+            // out fresh memory instead of waiting for pending transfers to complete
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_pixelBuffers[m_pixelBufferIndex]));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptrARB>(size), NULL, GLEXT_GL_STREAM_DRAW));
+            glCheck(mapping = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+            if (mapping)
+            {
+                m_updating = true;
+                m_updateMapped = true;
+
+                return static_cast<Uint8*>(mapping);
+            }
+
+            err() << "Failed to map texture pixel buffer, falling back to client memory" << std::endl;
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Pixel buffers are not available: stage the pixels in client memory
+    m_updatePixels.resize(size);
+    m_updating = true;
+    m_updateMapped = false;
+
+    return &m_updatePixels[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::endUpdate()
+{
+    if (!m_updating)
+        return;
+
+    unsigned int width  = static_cast<unsigned int>(m_updateArea.width);
+    unsigned int height = static_cast<unsigned int>(m_updateArea.height);
+    unsigned int x      = static_cast<unsigned int>(m_updateArea.left);
+    unsigned int y      = static_cast<unsigned int>(m_updateArea.top);
+
+    if (!m_updateMapped)
+    {
+        // update() doesn't go through the pixel buffers while
+        // an update is pending, so this uploads the staging memory directly
+        update(&m_updatePixels[0], width, height, x, y);
+        m_updating = false;
+        return;
+    }
+
+    m_updating = false;
+    m_updateMapped = false;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    GLboolean unmapped = GL_FALSE;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_pixelBuffers[m_pixelBufferIndex]));
+    glCheck(unmapped = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+
+    if (unmapped == GL_TRUE)
+    {
+        // Transfer the pixels from the bound pixel buffer to the texture
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        m_hasMipmap = false;
+        m_pixelsFlipped = false;
+        m_cacheId = getUniqueTextureId();
+    }
+    else
+    {
+        // The buffer contents may be lost when e.g. the display mode changes
+        err() << "Failed to update texture, the contents of its pixel buffer were lost" << std::endl;
+    }
+
+    // Pixel transfers from client memory expect no unpack buffer to be bound
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    // Force an OpenGL flush, so that the texture data will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+#endif // SFML_OPENGL_ES
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::update(const Texture& texture)
 {
@@ -446,25 +767,62 @@ void Texture::update(const Texture& texture)
 ////////////////////////////////////////////////////////////
 void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 {
+    SFML_PROFILE_SCOPE("Texture::update");
+
     assert(x + texture.m_size.x <= m_size.x);
     assert(y + texture.m_size.y <= m_size.y);
 
     if (!m_texture || !texture.m_texture)
         return;
 
+    // Fall back to a copy through system memory if the graphics card can't copy by itself
+    if (!copyFrom(texture, IntRect(0, 0, static_cast<int>(texture.m_size.x), static_cast<int>(texture.m_size.y)), Vector2u(x, y)))
+        update(texture.copyToImage(), x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::copyFrom(const Texture& texture, const IntRect& sourceRect, const Vector2u& destination)
+{
+    SFML_PROFILE_SCOPE("Texture::copyFrom");
+
+    assert((sourceRect.left >= 0) && (sourceRect.top >= 0));
+    assert(static_cast<unsigned int>(sourceRect.left + sourceRect.width) <= texture.m_size.x);
+    assert(static_cast<unsigned int>(sourceRect.top + sourceRect.height) <= texture.m_size.y);
+    assert(destination.x + sourceRect.width <= m_size.x);
+    assert(destination.y + sourceRect.height <= m_size.y);
+
+    if (!m_texture || !texture.m_texture)
+        return false;
+
 #ifndef SFML_OPENGL_ES
 
-    {
-        TransientContextLock lock;
+    TransientContextLock lock;
 
-        // Make sure that extensions are initialized
-        priv::ensureExtensionsInit();
-    }
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
-    {
-        TransientContextLock lock;
+    texture.resolveRenderTexture();
+    resolveRenderTexture();
 
+    if ((sourceRect.width <= 0) || (sourceRect.height <= 0))
+        return true;
+
+    // glCopyImageSubData copies the texels as they are stored, it can't flip them and
+    // requires formats of the same size: only the default formats are known to match
+    // (sRGB and linear RGBA8 are compatible)
+    bool rawCopy = GLEXT_copy_image && !texture.m_pixelsFlipped && !m_pixelsFlipped && (texture.m_internalFormat == m_internalFormat);
+
+    if (rawCopy)
+    {
+        glCheck(GLEXT_glCopyImageSubData(
+            texture.m_texture, GL_TEXTURE_2D, 0, sourceRect.left, sourceRect.top, 0,
+            m_texture, GL_TEXTURE_2D, 0, static_cast<GLint>(destination.x), static_cast<GLint>(destination.y), 0,
+            sourceRect.width, sourceRect.height, 1
+        ));
+    }
+    else if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    {
         // Save the current bindings so we can restore them after we are done
         GLint readFramebuffer = 0;
         GLint drawFramebuffer = 0;
@@ -481,7 +839,7 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         if (!sourceFrameBuffer || !destFrameBuffer)
         {
             err() << "Cannot copy texture, failed to create a frame buffer object" << std::endl;
-            return;
+            return false;
         }
 
         // Link the source texture to the source frame buffer
@@ -499,12 +857,18 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         GLenum destStatus;
         glCheck(destStatus = GLEXT_glCheckFramebufferStatus(GLEXT_GL_DRAW_FRAMEBUFFER));
 
-        if ((sourceStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE) && (destStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE))
+        bool linked = (sourceStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE) && (destStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE);
+
+        if (linked)
         {
+            // Flipped sources are stored upside down within their public size
+            GLint sourceTop    = texture.m_pixelsFlipped ? static_cast<GLint>(texture.m_size.y) - sourceRect.top : sourceRect.top;
+            GLint sourceBottom = texture.m_pixelsFlipped ? sourceTop - sourceRect.height : sourceTop + sourceRect.height;
+
             // Blit the texture contents from the source to the destination texture
             glCheck(GLEXT_glBlitFramebuffer(
-                0, texture.m_pixelsFlipped ? texture.m_size.y : 0, texture.m_size.x, texture.m_pixelsFlipped ? 0 : texture.m_size.y, // Source rectangle, flip y if source is flipped
-                x, y, x + texture.m_size.x, y + texture.m_size.y, // Destination rectangle
+                sourceRect.left, sourceTop, sourceRect.left + sourceRect.width, sourceBottom, // Source rectangle, flip y if source is flipped
+                destination.x, destination.y, destination.x + sourceRect.width, destination.y + sourceRect.height, // Destination rectangle
                 GL_COLOR_BUFFER_BIT, GL_NEAREST
             ));
         }
@@ -521,26 +885,36 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         glCheck(GLEXT_glDeleteFramebuffers(1, &sourceFrameBuffer));
         glCheck(GLEXT_glDeleteFramebuffers(1, &destFrameBuffer));
 
-        // Make sure that the current texture binding will be preserved
-        priv::TextureSaver save;
+        if (!linked)
+            return false;
 
-        // Set the parameters of this texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-        m_hasMipmap = false;
         m_pixelsFlipped = false;
-        m_cacheId = getUniqueId();
+    }
+    else
+    {
+        return false;
+    }
 
-        // Force an OpenGL flush, so that the texture data will appear updated
-        // in all contexts immediately (solves problems in multi-threaded apps)
-        glCheck(glFlush());
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
 
-        return;
-    }
+    // Set the parameters of this texture
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    m_hasMipmap = false;
+    m_cacheId = getUniqueTextureId();
 
-#endif // SFML_OPENGL_ES
+    // Force an OpenGL flush, so that the texture data will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+
+#else
+
+    return false;
 
-    update(texture.copyToImage(), x, y);
+#endif // SFML_OPENGL_ES
 }
 
 
@@ -569,6 +943,8 @@ void Texture::update(const Window& window)
 ////////////////////////////////////////////////////////////
 void Texture::update(const Window& window, unsigned int x, unsigned int y)
 {
+    SFML_PROFILE_SCOPE("Texture::update");
+
     assert(x + window.getSize().x <= m_size.x);
     assert(y + window.getSize().y <= m_size.y);
 
@@ -585,7 +961,7 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = true;
-        m_cacheId = getUniqueId();
+        m_cacheId = getUniqueTextureId();
 
         // Force an OpenGL flush, so that the texture will appear updated
         // in all contexts immediately (solves problems in multi-threaded apps)
@@ -704,6 +1080,8 @@ bool Texture::generateMipmap()
     if (!GLEXT_framebuffer_object)
         return false;
 
+    resolveRenderTexture();
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
@@ -742,6 +1120,8 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 
     if (texture && texture->m_texture)
     {
+        texture->resolveRenderTexture();
+
         // Bind the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
 
@@ -812,6 +1192,127 @@ unsigned int Texture::getMaximumSize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedImage(const priv::CompressedImage& image, const IntRect& area)
+{
+    // Compressed blocks can't be cropped
+    if ((area.width != 0) && (area.height != 0) &&
+        ((area.left > 0) || (area.top > 0) || (area.width < static_cast<int>(image.size.x)) || (area.height < static_cast<int>(image.size.y))))
+    {
+        err() << "Failed to load compressed texture, only the whole image can be loaded" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    bool available = false;
+    const char* extension = "";
+
+    switch (image.family)
+    {
+        case priv::CompressedImage::S3tc: available = GLEXT_texture_compression_s3tc; extension = "EXT_texture_compression_s3tc";     break;
+        case priv::CompressedImage::Bptc: available = GLEXT_texture_compression_bptc; extension = "ARB_texture_compression_bptc";     break;
+        case priv::CompressedImage::Etc2: available = GLEXT_texture_compression_etc2; extension = "ARB_ES3_compatibility";            break;
+        case priv::CompressedImage::Astc: available = GLEXT_texture_compression_astc; extension = "KHR_texture_compression_astc_ldr"; break;
+    }
+
+    if (!GLEXT_texture_compression || !available)
+    {
+        err() << "Failed to load compressed texture, OpenGL extension " << extension << " unavailable" << std::endl;
+        return false;
+    }
+
+    // Compressed textures can't be padded to a valid size
+    if ((getValidSize(image.size.x) != image.size.x) || (getValidSize(image.size.y) != image.size.y))
+    {
+        err() << "Failed to load compressed texture, its size must be a power of two "
+              << "(" << image.size.x << "x" << image.size.y << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int maxSize = getMaximumSize();
+    if ((image.size.x > maxSize) || (image.size.y > maxSize))
+    {
+        err() << "Failed to load compressed texture, its size is too high "
+              << "(" << image.size.x << "x" << image.size.y << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
+    // Only a complete mipmap chain can be sampled, otherwise keep the base level
+    std::size_t levelCount = 1;
+    for (unsigned int size = std::max(image.size.x, image.size.y); size > 1; size /= 2)
+        ++levelCount;
+
+    if (image.levels.size() < levelCount)
+        levelCount = 1;
+
+    // All the validity checks passed, we can store the new texture settings
+    m_size          = image.size;
+    m_actualSize    = image.size;
+    m_pixelsFlipped = false;
+    m_fboAttachment = false;
+
+    // Immutable storage can't be specified again, start over with a new texture
+    if (m_immutable)
+    {
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+        m_texture = 0;
+        m_immutable = false;
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    static bool textureEdgeClamp = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+
+    Vector2u levelSize = image.size;
+    for (std::size_t i = 0; i < levelCount; ++i)
+    {
+        const std::vector<Uint8>& level = image.levels[i];
+        glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), image.format, levelSize.x, levelSize.y, 0, static_cast<GLsizei>(level.size()), &level[0]));
+
+        levelSize.x = std::max(levelSize.x / 2, 1u);
+        levelSize.y = std::max(levelSize.y / 2, 1u);
+    }
+
+    m_hasMipmap = (levelCount > 1);
+    m_internalFormat = image.format;
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    if (m_hasMipmap)
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+    else
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    m_cacheId = getUniqueTextureId();
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture& Texture::operator =(const Texture& right)
 {
@@ -826,6 +1327,10 @@ Texture& Texture::operator =(const Texture& right)
 ////////////////////////////////////////////////////////////
 void Texture::swap(Texture& right)
 {
+    // The render-textures refer to their own textures, the pending content can't follow a swap
+    resolveRenderTexture();
+    right.resolveRenderTexture();
+
     std::swap(m_size,          right.m_size);
     std::swap(m_actualSize,    right.m_actualSize);
     std::swap(m_texture,       right.m_texture);
@@ -835,19 +1340,41 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
-
-    m_cacheId = getUniqueId();
-    right.m_cacheId = getUniqueId();
+    std::swap(m_immutable,     right.m_immutable);
+    std::swap(m_internalFormat, right.m_internalFormat);
+    std::swap(m_pixelBufferIndex, right.m_pixelBufferIndex);
+    std::swap(m_updateArea,    right.m_updateArea);
+    std::swap(m_updating,      right.m_updating);
+    std::swap(m_updateMapped,  right.m_updateMapped);
+    m_pixelBuffers.swap(right.m_pixelBuffers);
+    m_updatePixels.swap(right.m_updatePixels);
+
+    m_cacheId = getUniqueTextureId();
+    right.m_cacheId = getUniqueTextureId();
 }
 
 
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getNativeHandle() const
 {
+    if (m_resolveSource)
+    {
+        TransientContextLock lock;
+        resolveRenderTexture();
+    }
+
     return m_texture;
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::resolveRenderTexture() const
+{
+    if (m_resolveSource)
+        m_resolveSource->resolve();
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getValidSize(unsigned int size)
 {
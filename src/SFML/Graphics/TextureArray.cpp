@@ -0,0 +1,463 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cassert>
+
+
+namespace
+{
+    sf::Mutex textureArrayIdMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueTextureArrayId()
+    {
+        sf::Lock lock(textureArrayIdMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no texture array"
+
+        return id++;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Preserve the texture array binding, like priv::TextureSaver does for 2D textures
+    class ArrayBindingSaver
+    {
+    public:
+
+        ArrayBindingSaver()
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_TEXTURE_BINDING_2D_ARRAY, &m_textureBinding));
+        }
+
+        ~ArrayBindingSaver()
+        {
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_textureBinding));
+        }
+
+    private:
+
+        GLint m_textureBinding; ///< Texture array binding to restore
+    };
+
+#endif // SFML_OPENGL_ES
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_size          (0, 0),
+m_layerCount    (0),
+m_texture       (0),
+m_isSmooth      (false),
+m_isRepeated    (false),
+m_hasMipmap     (false),
+m_bindlessHandle(0),
+m_cacheId       (getUniqueTextureArrayId())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_texture)
+    {
+        TransientContextLock lock;
+
+        if (m_bindlessHandle)
+            glCheck(GLEXT_glMakeTextureHandleNonResident(m_bindlessHandle));
+
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layerCount)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, texture arrays are not supported" << std::endl;
+        return false;
+    }
+
+    // Check if texture array parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (layerCount == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layerCount << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int maxSize = Texture::getMaximumSize();
+    unsigned int maxLayers = getMaximumLayerCount();
+    if ((width > maxSize) || (height > maxSize) || (layerCount > maxLayers))
+    {
+        err() << "Failed to create texture array, its size is too high "
+              << "(" << width << "x" << height << "x" << layerCount << ", "
+              << "maximum is " << maxSize << "x" << maxSize << "x" << maxLayers << ")"
+              << std::endl;
+        return false;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // The storage of a texture can't change while it has a bindless handle
+    if (m_bindlessHandle)
+    {
+        glCheck(GLEXT_glMakeTextureHandleNonResident(m_bindlessHandle));
+        m_bindlessHandle = 0;
+
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+        m_texture = 0;
+    }
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // All the validity checks passed, we can store the new settings
+    m_size.x     = width;
+    m_size.y     = height;
+    m_layerCount = layerCount;
+    m_hasMipmap  = false;
+
+    // Make sure that the current texture array binding will be preserved
+    ArrayBindingSaver save;
+
+    // Initialize the texture array
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(GLEXT_glTexImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, width, height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    applyParameters();
+
+    m_cacheId = getUniqueTextureArrayId();
+
+    return true;
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8* pixels, unsigned int layer)
+{
+    // Update the whole layer
+    update(pixels, m_size.x, m_size.y, 0, 0, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, unsigned int layer)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+
+#ifndef SFML_OPENGL_ES
+
+    if (pixels && m_texture && (layer < m_layerCount))
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture array binding will be preserved
+        ArrayBindingSaver save;
+
+        // Copy pixels from the given array to the layer
+        glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+        glCheck(GLEXT_glTexSubImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+
+        // The mipmap can't be invalidated anymore once the sampling parameters are frozen
+        if (m_hasMipmap && !m_bindlessHandle)
+        {
+            glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            m_hasMipmap = false;
+        }
+
+        m_cacheId = getUniqueTextureArrayId();
+
+        // Force an OpenGL flush, so that the texture data will appear updated
+        // in all contexts immediately (solves problems in multi-threaded apps)
+        glCheck(glFlush());
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Image& image, unsigned int layer)
+{
+    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (m_bindlessHandle)
+    {
+        err() << "Failed to change texture array filter, its bindless handle freezes it" << std::endl;
+        return;
+    }
+
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+#ifndef SFML_OPENGL_ES
+
+        if (m_texture)
+        {
+            TransientContextLock lock;
+
+            // Make sure that the current texture array binding will be preserved
+            ArrayBindingSaver save;
+
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+            applyParameters();
+        }
+
+#endif // SFML_OPENGL_ES
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setRepeated(bool repeated)
+{
+    if (m_bindlessHandle)
+    {
+        err() << "Failed to change texture array repeat mode, its bindless handle freezes it" << std::endl;
+        return;
+    }
+
+    if (repeated != m_isRepeated)
+    {
+        m_isRepeated = repeated;
+
+#ifndef SFML_OPENGL_ES
+
+        if (m_texture)
+        {
+            TransientContextLock lock;
+
+            // Make sure that the current texture array binding will be preserved
+            ArrayBindingSaver save;
+
+            glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+            applyParameters();
+        }
+
+#endif // SFML_OPENGL_ES
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isRepeated() const
+{
+    return m_isRepeated;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::generateMipmap()
+{
+    if (!m_texture || m_bindlessHandle)
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object)
+        return false;
+
+    // Make sure that the current texture array binding will be preserved
+    ArrayBindingSaver save;
+
+    glCheck(glBindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture));
+    glCheck(GLEXT_glGenerateMipmap(GLEXT_GL_TEXTURE_2D_ARRAY));
+
+    m_hasMipmap = true;
+    applyParameters();
+
+    return true;
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureArray::getBindlessHandle() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_bindlessHandle && m_texture)
+    {
+        TransientContextLock lock;
+
+        // Make sure that extensions are initialized
+        priv::ensureExtensionsInit();
+
+        if (GLEXT_bindless_texture)
+        {
+            glCheck(m_bindlessHandle = GLEXT_glGetTextureHandle(m_texture));
+
+            if (m_bindlessHandle)
+                glCheck(GLEXT_glMakeTextureHandleResident(m_bindlessHandle));
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    return m_bindlessHandle;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Texture arrays can only be sampled by shaders
+    return GLEXT_texture_array && GLEXT_shader_objects;
+
+#else
+
+    return false;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable())
+        return 0;
+
+    TransientContextLock lock;
+
+    GLint count = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS, &count));
+
+    return static_cast<unsigned int>(count);
+
+#else
+
+    return 0;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::applyParameters()
+{
+#ifndef SFML_OPENGL_ES
+
+    GLint wrap = m_isRepeated ? GL_REPEAT : GLEXT_GL_CLAMP_TO_EDGE;
+    GLint minFilter = m_hasMipmap ? (m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR) : (m_isSmooth ? GL_LINEAR : GL_NEAREST);
+
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter));
+
+#endif // SFML_OPENGL_ES
+}
+
+} // namespace sf
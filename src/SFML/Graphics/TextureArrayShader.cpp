@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArrayShader.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Compiled shader, created on first use
+    struct ShaderHolder
+    {
+        ShaderHolder() :
+        shader (NULL),
+        created(false)
+        {
+        }
+
+        ~ShaderHolder()
+        {
+            delete shader;
+        }
+
+        sf::Shader* shader;
+        bool        created;
+    };
+
+    // Mutex to protect the shader
+    sf::Mutex textureArrayShaderMutex;
+
+    const char* textureArrayVertexSource =
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "}\n";
+
+    // The layer is carried by the third texture coordinate, which the texture matrix leaves untouched
+    const char* textureArrayFragmentSource =
+        "#extension GL_EXT_texture_array : require\n"
+        "uniform sampler2DArray textureArray;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * texture2DArray(textureArray, gl_TexCoord[0].xyz);\n"
+        "}\n";
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+const Shader* TextureArrayShader::get()
+{
+    Lock lock(textureArrayShaderMutex);
+
+    static ShaderHolder holder;
+
+    // Failures are remembered too, so that they are only reported once
+    if (!holder.created)
+    {
+        holder.created = true;
+
+        if (Shader::isAvailable())
+        {
+            // The sampler keeps its default value, texture arrays are bound to the first unit
+            holder.shader = new Shader;
+            if (!holder.shader->loadFromMemory(textureArrayVertexSource, textureArrayFragmentSource))
+            {
+                err() << "Failed to create the texture array shader" << std::endl;
+                delete holder.shader;
+                holder.shader = NULL;
+            }
+        }
+    }
+
+    return holder.shader;
+}
+
+} // namespace priv
+
+} // namespace sf
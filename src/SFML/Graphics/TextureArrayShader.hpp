@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TEXTUREARRAYSHADER_HPP
+#define SFML_TEXTUREARRAYSHADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/GlResource.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shader drawing sf::TextureArray with the fixed-function pipeline
+///
+////////////////////////////////////////////////////////////
+class TextureArrayShader : GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader that samples the bound texture array
+    ///
+    /// The fixed-function pipeline can't sample texture arrays,
+    /// this shader replaces it when drawing with a texture array
+    /// and no custom shader. The programmable pipeline has its
+    /// own default program for texture arrays.
+    ///
+    /// The shader is compiled on first use.
+    ///
+    /// \return Pointer to the shader, NULL if it can't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    static const Shader* get();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAYSHADER_HPP
@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/SkylinePacker.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Size of the texture when the first image is added to an empty atlas
+    const unsigned int defaultAtlasSize = 256;
+
+    // Order images from the tallest to the shortest, then from the widest to the narrowest
+    struct TallerFirst
+    {
+        TallerFirst(const sf::Image* theImages) : images(theImages) {}
+
+        bool operator ()(std::size_t left, std::size_t right) const
+        {
+            sf::Vector2u leftSize  = images[left].getSize();
+            sf::Vector2u rightSize = images[right].getSize();
+
+            if (leftSize.y != rightSize.y)
+                return leftSize.y > rightSize.y;
+
+            return leftSize.x > rightSize.x;
+        }
+
+        const sf::Image* images;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas() :
+m_texture(),
+m_skyline(),
+m_padding(1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::create(unsigned int width, unsigned int height)
+{
+    if (!width || !height)
+    {
+        err() << "Failed to create texture atlas, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    // Make sure that the padding between the images is transparent
+    Image image;
+    image.create(width, height, Color(0, 0, 0, 0));
+
+    Texture texture;
+    if (!texture.loadFromImage(image))
+    {
+        err() << "Failed to create texture atlas" << std::endl;
+        return false;
+    }
+
+    texture.setSmooth(m_texture.isSmooth());
+    m_texture.swap(texture);
+
+    m_skyline.clear();
+    m_skyline.push_back(Segment(0, 0, width));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::add(const Image& image, IntRect& rect)
+{
+    Vector2u size = image.getSize();
+
+    if (!size.x || !size.y)
+    {
+        rect = IntRect();
+        return true;
+    }
+
+    // The padding is packed to the right and below each image
+    if (!findRect(size.x + m_padding, size.y + m_padding, rect))
+    {
+        err() << "Failed to add image to texture atlas: the maximum texture size has been reached" << std::endl;
+        rect = IntRect();
+        return false;
+    }
+
+    rect.width  = static_cast<int>(size.x);
+    rect.height = static_cast<int>(size.y);
+
+    m_texture.update(image, static_cast<unsigned int>(rect.left), static_cast<unsigned int>(rect.top));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::add(const Image* images, std::size_t count, IntRect* rects)
+{
+    if (!images || !rects)
+        return false;
+
+    std::vector<std::size_t> order(count);
+    for (std::size_t i = 0; i < count; ++i)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), TallerFirst(images));
+
+    bool success = true;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!add(images[order[i]], rects[order[i]]))
+            success = false;
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setPadding(unsigned int padding)
+{
+    m_padding = padding;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureAtlas::getPadding() const
+{
+    return m_padding;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::findRect(unsigned int width, unsigned int height, IntRect& rect)
+{
+    // Create the texture on the first insertion, large enough for the first image
+    if (m_skyline.empty())
+    {
+        unsigned int size = defaultAtlasSize;
+        while (((size < width) || (size < height)) && (size * 2 <= Texture::getMaximumSize()))
+            size *= 2;
+
+        if (!create(size, size))
+            return false;
+    }
+
+    do
+    {
+        if (priv::packSkyline(m_skyline, m_texture.getSize().x, m_texture.getSize().y, width, height, rect))
+            return true;
+    }
+    while (grow());
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::grow()
+{
+    unsigned int width  = m_texture.getSize().x;
+    unsigned int height = m_texture.getSize().y;
+    unsigned int maximumSize = Texture::getMaximumSize();
+
+    if ((width * 2 > maximumSize) || (height * 2 > maximumSize))
+        return false;
+
+    // The new area must be transparent as well, for the padding of the next images
+    Image image;
+    image.create(width * 2, height * 2, Color(0, 0, 0, 0));
+
+    Texture texture;
+    if (!texture.loadFromImage(image))
+        return false;
+
+    texture.setSmooth(m_texture.isSmooth());
+    // Copy the images on the graphics card, only go through system memory if it can't
+    if (!texture.copyFrom(m_texture, IntRect(0, 0, static_cast<int>(width), static_cast<int>(height)), Vector2u(0, 0)))
+        texture.update(m_texture.copyToImage());
+    m_texture.swap(texture);
+
+    // The new right half is entirely free, the bottom half is below the existing segments
+    m_skyline.push_back(Segment(width, 0, width));
+
+    return true;
+}
+
+} // namespace sf
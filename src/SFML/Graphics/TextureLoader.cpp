@@ -0,0 +1,419 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureLoader.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// Thread decoding images for a loader
+////////////////////////////////////////////////////////////
+struct TextureLoader::Worker
+{
+    Worker(TextureLoader& owner) :
+    loader (owner),
+    thread (&TextureLoader::run, this),
+    running(false)
+    {
+    }
+
+    TextureLoader& loader;  ///< Loader owning the worker
+    Thread         thread;  ///< Thread running the run function
+    bool           running; ///< Is the thread running? (protected by the loader's mutex)
+};
+
+
+////////////////////////////////////////////////////////////
+TextureLoader::TextureLoader(unsigned int threadCount, bool uploadInThreads) :
+m_mutex          (),
+m_workers        (),
+m_requests       (),
+m_entries        (),
+m_nextHandle     (1),
+m_uploadInThreads(uploadInThreads),
+m_cancelled      (false)
+{
+    if (threadCount == 0)
+        threadCount = 1;
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_workers.push_back(new Worker(*this));
+}
+
+
+////////////////////////////////////////////////////////////
+TextureLoader::~TextureLoader()
+{
+    {
+        Lock lock(m_mutex);
+        m_cancelled = true;
+    }
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->thread.wait();
+        delete m_workers[i];
+    }
+
+    for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        delete it->second.image;
+        delete it->second.texture;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TextureLoader::Handle TextureLoader::loadFromFile(const std::string& filename, const IntRect& area, bool mipmap)
+{
+    Request request;
+    request.filename = filename;
+    request.area = area;
+    request.mipmap = mipmap;
+
+    return push(request);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureLoader::Handle TextureLoader::loadFromMemory(const void* data, std::size_t size, const IntRect& area, bool mipmap)
+{
+    Request request;
+    if (data && size)
+        request.data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+    request.area = area;
+    request.mipmap = mipmap;
+
+    return push(request);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureLoader::update(unsigned int maxTextures)
+{
+    unsigned int count = 0;
+
+    while (count < maxTextures)
+    {
+        Image*  image = NULL;
+        IntRect area;
+        bool    mipmap = false;
+        Handle  handle = 0;
+
+        {
+            Lock lock(m_mutex);
+
+            // Take the pixels of the next decoded image, workers may keep decoding other ones meanwhile
+            for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                if (it->second.status == Uploading)
+                {
+                    handle = it->first;
+                    image  = it->second.image;
+                    area   = it->second.area;
+                    mipmap = it->second.mipmap;
+
+                    it->second.image = NULL;
+                    break;
+                }
+            }
+        }
+
+        if (!image)
+            break;
+
+        // Create the texture outside of the lock, it is the slow part
+        Texture* texture = createTexture(*image, area, mipmap);
+
+        delete image;
+        ++count;
+
+        Lock lock(m_mutex);
+
+        // The request may have been released meanwhile
+        EntryTable::iterator it = m_entries.find(handle);
+        if (it == m_entries.end())
+        {
+            delete texture;
+            continue;
+        }
+
+        it->second.texture = texture;
+        it->second.status = texture ? Ready : Failed;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureLoader::Status TextureLoader::getStatus(Handle handle) const
+{
+    Lock lock(m_mutex);
+
+    EntryTable::const_iterator it = m_entries.find(handle);
+
+    return (it != m_entries.end()) ? it->second.status : Failed;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureLoader::isIdle() const
+{
+    Lock lock(m_mutex);
+
+    for (EntryTable::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if ((it->second.status == Decoding) || (it->second.status == Uploading))
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureLoader::takeTexture(Handle handle, Texture& texture)
+{
+    Texture* loaded = NULL;
+
+    {
+        Lock lock(m_mutex);
+
+        EntryTable::iterator it = m_entries.find(handle);
+        if ((it == m_entries.end()) || (it->second.status != Ready))
+            return false;
+
+        loaded = it->second.texture;
+        m_entries.erase(it);
+    }
+
+    texture.swap(*loaded);
+    delete loaded;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureLoader::release(Handle handle)
+{
+    Texture* texture = NULL;
+
+    {
+        Lock lock(m_mutex);
+
+        EntryTable::iterator it = m_entries.find(handle);
+        if (it == m_entries.end())
+            return;
+
+        texture = it->second.texture;
+        delete it->second.image;
+        m_entries.erase(it);
+
+        // Don't decode the image if it is still queued
+        for (std::deque<Request>::iterator request = m_requests.begin(); request != m_requests.end(); ++request)
+        {
+            if (request->handle == handle)
+            {
+                m_requests.erase(request);
+                break;
+            }
+        }
+    }
+
+    delete texture;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureLoader::Handle TextureLoader::push(Request& request)
+{
+    Lock lock(m_mutex);
+
+    request.handle = m_nextHandle++;
+
+    Entry entry;
+    entry.status = Decoding;
+    entry.image = NULL;
+    entry.area = request.area;
+    entry.mipmap = request.mipmap;
+    entry.texture = NULL;
+    m_entries.insert(std::make_pair(request.handle, entry));
+
+    m_requests.push_back(request);
+
+    // Start an idle worker, if any
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        if (!m_workers[i]->running)
+        {
+            // The previous run of the thread, if any, has already returned
+            m_workers[i]->running = true;
+            m_workers[i]->thread.launch();
+            break;
+        }
+    }
+
+    return request.handle;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureLoader::run(Worker* worker)
+{
+    worker->loader.decode(*worker);
+}
+
+
+////////////////////////////////////////////////////////////
+Texture* TextureLoader::createTexture(const Image& image, const IntRect& area, bool mipmap)
+{
+    Texture* texture = new Texture;
+
+    bool created;
+    if (mipmap)
+    {
+        // Allocate the complete chain at once, then fill it
+        created = texture->create(image.getSize().x, image.getSize().y, 0);
+        if (created)
+        {
+            texture->update(image);
+            texture->generateMipmap();
+        }
+    }
+    else
+    {
+        created = texture->loadFromImage(image, area);
+    }
+
+    if (!created)
+    {
+        delete texture;
+        texture = NULL;
+    }
+
+    return texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureLoader::decode(Worker& worker)
+{
+    // Textures created in this thread need an active context
+    Context* context = m_uploadInThreads ? new Context : NULL;
+
+    for (;;)
+    {
+        Request request;
+
+        {
+            Lock lock(m_mutex);
+
+            if (m_cancelled || m_requests.empty())
+            {
+                worker.running = false;
+                break;
+            }
+
+            request = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        // Decode the image
+        Image* image = new Image;
+        bool loaded;
+        if (!request.filename.empty())
+            loaded = image->loadFromFile(request.filename);
+        else
+            loaded = !request.data.empty() && image->loadFromMemory(&request.data[0], request.data.size());
+
+        // The texture of a mipmapped image is created with all its levels,
+        // keep only the requested area so that its size is known up front
+        if (loaded && request.mipmap && (request.area.width > 0) && (request.area.height > 0))
+        {
+            int width  = static_cast<int>(image->getSize().x);
+            int height = static_cast<int>(image->getSize().y);
+
+            // Adjust the rectangle to the size of the image, like Texture::loadFromImage
+            IntRect rectangle = request.area;
+            if (rectangle.left < 0) rectangle.left = 0;
+            if (rectangle.top  < 0) rectangle.top  = 0;
+            if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
+            if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
+
+            if ((rectangle.width > 0) && (rectangle.height > 0) && ((rectangle.width < width) || (rectangle.height < height)))
+            {
+                Image* cropped = new Image;
+                cropped->create(static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height));
+                cropped->copy(*image, 0, 0, rectangle);
+
+                delete image;
+                image = cropped;
+            }
+        }
+
+        // Create the texture immediately if this thread can
+        Texture* texture = NULL;
+        if (loaded && context)
+        {
+            texture = createTexture(*image, request.area, request.mipmap);
+            loaded = (texture != NULL);
+        }
+
+        if (!loaded || texture)
+        {
+            delete image;
+            image = NULL;
+        }
+
+        Lock lock(m_mutex);
+
+        // The request may have been released meanwhile
+        EntryTable::iterator it = m_entries.find(request.handle);
+        if (it == m_entries.end())
+        {
+            delete image;
+            delete texture;
+            continue;
+        }
+
+        it->second.image   = image;
+        it->second.texture = texture;
+        it->second.status  = !loaded ? Failed : (texture ? Ready : Uploading);
+    }
+
+    delete context;
+}
+
+} // namespace sf
@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureReader.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Copy rows of RGBA pixels to an image, reversing their order if needed
+    void copyRows(const sf::Uint8* source, int pitch, const sf::Vector2u& size, bool flipped, sf::Image& image)
+    {
+        std::vector<sf::Uint8> pixels(size.x * size.y * 4);
+        sf::Uint8* destination = &pixels[0];
+        int destinationPitch = size.x * 4;
+
+        // Handle the case where source pixels are flipped vertically
+        if (flipped)
+        {
+            source += pitch * (size.y - 1);
+            pitch = -pitch;
+        }
+
+        for (unsigned int i = 0; i < size.y; ++i)
+        {
+            std::memcpy(destination, source, destinationPitch);
+            source += pitch;
+            destination += destinationPitch;
+        }
+
+        image.create(size.x, size.y, &pixels[0]);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct TextureReader::Readback
+{
+    Readback() :
+#ifndef SFML_OPENGL_ES
+    fence  (0),
+#endif // SFML_OPENGL_ES
+    buffer (0),
+    size   (0, 0),
+    pitch  (0),
+    flipped(false),
+    image  (NULL)
+    {
+    }
+
+#ifndef SFML_OPENGL_ES
+    GLsync       fence;   ///< Fence signaled when the pixels have been copied to the buffer
+#endif // SFML_OPENGL_ES
+    unsigned int buffer;  ///< Pixel buffer object receiving the pixels
+    Vector2u     size;    ///< Size of the image to produce
+    int          pitch;   ///< Size of a row of pixels in the buffer, in bytes
+    bool         flipped; ///< Are the rows stored bottom-up in the buffer?
+    Image*       image;   ///< Image read synchronously, when pixel buffers are not available
+};
+
+
+////////////////////////////////////////////////////////////
+TextureReader::TextureReader() :
+m_readbacks (),
+m_nextHandle(1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReader::~TextureReader()
+{
+    for (ReadbackTable::iterator it = m_readbacks.begin(); it != m_readbacks.end(); ++it)
+        destroy(it->second);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReader::Handle TextureReader::read(const Texture& texture)
+{
+    if (!texture.m_texture)
+    {
+        err() << "Failed to read texture, the texture is not created" << std::endl;
+        return push(NULL);
+    }
+
+    TransientContextLock lock;
+
+    texture.resolveRenderTexture();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture.m_texture));
+
+    // The whole texture is transferred, padding included, and cropped once mapped
+    Readback* readback = startTransfer(texture.m_actualSize.x, texture.m_actualSize.y, true);
+
+    if (readback)
+    {
+        readback->size = texture.m_size;
+        readback->pitch = static_cast<int>(texture.m_actualSize.x * 4);
+        readback->flipped = texture.m_pixelsFlipped;
+    }
+    else
+    {
+        readback = new Readback;
+        readback->image = new Image(texture.copyToImage());
+    }
+
+    return push(readback);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReader::Handle TextureReader::read(RenderTarget& target)
+{
+    Vector2u size = target.getSize();
+
+    if (!size.x || !size.y || !target.setActive(true))
+    {
+        err() << "Failed to read render target, it could not be activated" << std::endl;
+        return push(NULL);
+    }
+
+    // Make sure that everything drawn so far reaches the framebuffer
+    target.flush();
+
+    Readback* readback = startTransfer(size.x, size.y, false);
+
+    if (readback)
+    {
+        readback->size = size;
+        readback->pitch = static_cast<int>(size.x * 4);
+        readback->flipped = true;
+    }
+    else
+    {
+        // Pixel buffers are not available: read the pixels synchronously
+        std::vector<Uint8> pixels(size.x * size.y * 4);
+        glCheck(glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+
+        readback = new Readback;
+        readback->image = new Image;
+        copyRows(&pixels[0], static_cast<int>(size.x * 4), size, true, *readback->image);
+    }
+
+    return push(readback);
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReader::Status TextureReader::getStatus(Handle handle) const
+{
+    ReadbackTable::const_iterator it = m_readbacks.find(handle);
+
+    if ((it == m_readbacks.end()) || !it->second)
+        return Failed;
+
+#ifndef SFML_OPENGL_ES
+
+    Readback& readback = *it->second;
+
+    if (readback.fence)
+    {
+        TransientContextLock lock;
+
+        GLenum result = GL_FALSE;
+        glCheck(result = GLEXT_glClientWaitSync(readback.fence, 0, 0));
+
+        if ((result != GLEXT_GL_ALREADY_SIGNALED) && (result != GLEXT_GL_CONDITION_SATISFIED) && (result != GLEXT_GL_WAIT_FAILED))
+            return Pending;
+
+        // If waiting failed, mapping the buffer will synchronize instead
+        glCheck(GLEXT_glDeleteSync(readback.fence));
+        readback.fence = 0;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    return Ready;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureReader::takeImage(Handle handle, Image& image)
+{
+    if (getStatus(handle) != Ready)
+        return false;
+
+    Readback& readback = *m_readbacks[handle];
+
+    if (readback.image)
+    {
+        image = *readback.image;
+    }
+    else
+    {
+
+#ifndef SFML_OPENGL_ES
+
+        TransientContextLock lock;
+
+        void* mapping = NULL;
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, readback.buffer));
+        glCheck(mapping = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY));
+
+        if (mapping)
+        {
+            copyRows(static_cast<const Uint8*>(mapping), readback.pitch, readback.size, readback.flipped, image);
+            glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+        if (!mapping)
+        {
+            err() << "Failed to take image, the pixel buffer could not be mapped" << std::endl;
+            return false;
+        }
+
+#endif // SFML_OPENGL_ES
+
+    }
+
+    release(handle);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureReader::release(Handle handle)
+{
+    ReadbackTable::iterator it = m_readbacks.find(handle);
+
+    if (it != m_readbacks.end())
+    {
+        destroy(it->second);
+        m_readbacks.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReader::Handle TextureReader::push(Readback* readback)
+{
+    Handle handle = m_nextHandle++;
+    m_readbacks[handle] = readback;
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureReader::Readback* TextureReader::startTransfer(unsigned int width, unsigned int height, bool texture)
+{
+
+#ifndef SFML_OPENGL_ES
+
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_pixel_buffer_object || !GLEXT_vertex_buffer_object)
+        return NULL;
+
+    GLuint buffer = 0;
+    glCheck(GLEXT_glGenBuffers(1, &buffer));
+
+    if (!buffer)
+        return NULL;
+
+    // Queue the copy of the pixels into the buffer, the call returns immediately
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptrARB>(width) * height * 4, NULL, GLEXT_GL_STREAM_READ));
+
+    if (texture)
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    else
+        glCheck(glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    Readback* readback = new Readback;
+    readback->buffer = static_cast<unsigned int>(buffer);
+
+    if (GLEXT_sync)
+        glCheck(readback->fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    // Submit the commands now, so that the fence gets signaled
+    // even if nothing else is rendered in this context
+    glCheck(glFlush());
+
+    return readback;
+
+#else
+
+    // OpenGL ES doesn't support pixel buffers
+    (void) width;
+    (void) height;
+    (void) texture;
+
+    return NULL;
+
+#endif // SFML_OPENGL_ES
+
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureReader::destroy(Readback* readback)
+{
+    if (!readback)
+        return;
+
+#ifndef SFML_OPENGL_ES
+
+    if (readback->fence || readback->buffer)
+    {
+        TransientContextLock lock;
+
+        if (readback->fence)
+            glCheck(GLEXT_glDeleteSync(readback->fence));
+
+        if (readback->buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(readback->buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    delete readback->image;
+    delete readback;
+}
+
+} // namespace sf
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TileMap::Chunk::Chunk() :
+buffer     (Triangles, VertexBuffer::Static),
+vertices   (),
+vertexCount(0),
+dirty      (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_mapSize   (0, 0),
+m_tileSize  (0, 0),
+m_chunkSize (0),
+m_chunkCount(0, 0),
+m_texture   (NULL),
+m_tiles     (),
+m_chunks    (),
+m_scratch   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::create(const Vector2u& mapSize, const Vector2u& tileSize, unsigned int chunkSize)
+{
+    if (!mapSize.x || !mapSize.y || !tileSize.x || !tileSize.y || !chunkSize)
+        return false;
+
+    m_mapSize    = mapSize;
+    m_tileSize   = tileSize;
+    m_chunkSize  = chunkSize;
+    m_chunkCount = Vector2u((mapSize.x + chunkSize - 1) / chunkSize, (mapSize.y + chunkSize - 1) / chunkSize);
+
+    m_tiles.assign(mapSize.x * mapSize.y, -1);
+
+    m_chunks.clear();
+    m_chunks.resize(m_chunkCount.x * m_chunkCount.y);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture& texture)
+{
+    if (&texture != m_texture)
+    {
+        m_texture = &texture;
+        invalidateChunks();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, int tile)
+{
+    if ((x >= m_mapSize.x) || (y >= m_mapSize.y))
+        return;
+
+    if (tile < 0)
+        tile = -1;
+
+    int& current = m_tiles[y * m_mapSize.x + x];
+    if (current != tile)
+    {
+        current = tile;
+        m_chunks[(y / m_chunkSize) * m_chunkCount.x + x / m_chunkSize].dirty = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const int* tiles)
+{
+    if (!tiles || m_tiles.empty())
+        return;
+
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+        m_tiles[i] = (tiles[i] < 0) ? -1 : tiles[i];
+
+    invalidateChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+int TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    if ((x >= m_mapSize.x) || (y >= m_mapSize.y))
+        return -1;
+
+    return m_tiles[y * m_mapSize.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getMapSize() const
+{
+    return m_mapSize;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2u& TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_mapSize.x * m_tileSize.x), static_cast<float>(m_mapSize.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_chunks.empty() || !m_texture)
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // Find the area of the map covered by the view, in local coordinates
+    FloatRect visible = target.getView().getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    visible = states.transform.getInverse().transformRect(visible);
+
+    // Convert it to a range of chunks, clamped before the conversion to avoid overflows
+    float chunkWidth  = static_cast<float>(m_chunkSize * m_tileSize.x);
+    float chunkHeight = static_cast<float>(m_chunkSize * m_tileSize.y);
+    float left   = std::max(std::floor(visible.left / chunkWidth), 0.f);
+    float top    = std::max(std::floor(visible.top / chunkHeight), 0.f);
+    float right  = std::min(std::floor((visible.left + visible.width) / chunkWidth), static_cast<float>(m_chunkCount.x) - 1.f);
+    float bottom = std::min(std::floor((visible.top + visible.height) / chunkHeight), static_cast<float>(m_chunkCount.y) - 1.f);
+
+    if ((right < left) || (bottom < top))
+        return;
+
+    for (unsigned int y = static_cast<unsigned int>(top); y <= static_cast<unsigned int>(bottom); ++y)
+    {
+        for (unsigned int x = static_cast<unsigned int>(left); x <= static_cast<unsigned int>(right); ++x)
+        {
+            const Chunk& chunk = m_chunks[y * m_chunkCount.x + x];
+
+            // Rebuild the chunk if its tiles changed since it was last drawn
+            if (chunk.dirty)
+                updateChunk(x, y);
+
+            if (!chunk.vertexCount)
+                continue;
+
+            // Chunks which couldn't be uploaded are drawn from memory
+            if (chunk.vertices.empty())
+                target.draw(chunk.buffer, 0, chunk.vertexCount, states);
+            else
+                target.draw(&chunk.vertices[0], chunk.vertexCount, Triangles, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getGlobalBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateChunk(unsigned int chunkX, unsigned int chunkY) const
+{
+    Chunk& chunk = m_chunks[chunkY * m_chunkCount.x + chunkX];
+
+    m_scratch.clear();
+
+    // The tiles are laid out row by row in the tileset
+    unsigned int tilesPerRow = m_texture ? m_texture->getSize().x / m_tileSize.x : 0;
+    if (tilesPerRow)
+    {
+        unsigned int beginX = chunkX * m_chunkSize;
+        unsigned int beginY = chunkY * m_chunkSize;
+        unsigned int endX   = std::min(beginX + m_chunkSize, m_mapSize.x);
+        unsigned int endY   = std::min(beginY + m_chunkSize, m_mapSize.y);
+
+        Vector2f size(static_cast<float>(m_tileSize.x), static_cast<float>(m_tileSize.y));
+
+        for (unsigned int y = beginY; y < endY; ++y)
+        {
+            for (unsigned int x = beginX; x < endX; ++x)
+            {
+                int tile = m_tiles[y * m_mapSize.x + x];
+                if (tile < 0)
+                    continue;
+
+                Vector2f position(x * size.x, y * size.y);
+                Vector2f texCoords((tile % tilesPerRow) * size.x, (tile / tilesPerRow) * size.y);
+
+                Vertex topLeft    (position,                         texCoords);
+                Vertex topRight   (position + Vector2f(size.x, 0.f), texCoords + Vector2f(size.x, 0.f));
+                Vertex bottomLeft (position + Vector2f(0.f, size.y), texCoords + Vector2f(0.f, size.y));
+                Vertex bottomRight(position + size,                  texCoords + size);
+
+                m_scratch.push_back(topLeft);
+                m_scratch.push_back(topRight);
+                m_scratch.push_back(bottomLeft);
+                m_scratch.push_back(bottomLeft);
+                m_scratch.push_back(topRight);
+                m_scratch.push_back(bottomRight);
+            }
+        }
+    }
+
+    chunk.vertexCount = m_scratch.size();
+    chunk.dirty = false;
+
+    if (!chunk.vertexCount)
+        return;
+
+    // Upload the geometry once, growing the buffer only when needed
+    bool uploaded = VertexBuffer::isAvailable() &&
+                    ((chunk.buffer.getVertexCount() >= chunk.vertexCount) || chunk.buffer.create(chunk.vertexCount)) &&
+                    chunk.buffer.update(&m_scratch[0], chunk.vertexCount, 0);
+
+    if (uploaded)
+        chunk.vertices.clear();
+    else
+        chunk.vertices.swap(m_scratch);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidateChunks()
+{
+    for (std::vector<Chunk>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        it->dirty = true;
+}
+
+} // namespace sf
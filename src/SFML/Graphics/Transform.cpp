@@ -26,43 +26,150 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Cpu.hpp>
+#include <algorithm>
 #include <cmath>
 
 
-namespace sf
+namespace
 {
-////////////////////////////////////////////////////////////
-const Transform Transform::Identity;
-
+#if defined(SFML_CPU_DISPATCH_X86)
 
-////////////////////////////////////////////////////////////
-Transform::Transform()
-{
-    // Identity matrix
-    m_matrix[0] = 1.f; m_matrix[4] = 0.f; m_matrix[8]  = 0.f; m_matrix[12] = 0.f;
-    m_matrix[1] = 0.f; m_matrix[5] = 1.f; m_matrix[9]  = 0.f; m_matrix[13] = 0.f;
-    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
-    m_matrix[3] = 0.f; m_matrix[7] = 0.f; m_matrix[11] = 0.f; m_matrix[15] = 1.f;
-}
+    // Four points are transformed at once, as (x0, y0, x1, y1, x2, y2, x3, y3);
+    // return the number of points transformed, a multiple of 4
+    SFML_CPU_TARGET("avx") std::size_t transformPositionsAvx(const float* matrix, char* data, std::size_t stride, std::size_t count)
+    {
+        const __m256 a = _mm256_setr_ps(matrix[0], matrix[1], matrix[0], matrix[1], matrix[0], matrix[1], matrix[0], matrix[1]);
+        const __m256 b = _mm256_setr_ps(matrix[4], matrix[5], matrix[4], matrix[5], matrix[4], matrix[5], matrix[4], matrix[5]);
+        const __m256 t = _mm256_setr_ps(matrix[12], matrix[13], matrix[12], matrix[13], matrix[12], matrix[13], matrix[12], matrix[13]);
+
+        // Packed points (like an array of sf::Vector2f) are loaded in one go
+        const bool packed = (stride == 2 * sizeof(float));
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m64* p0 = reinterpret_cast<__m64*>(data + i * stride);
+            __m64* p1 = reinterpret_cast<__m64*>(data + (i + 1) * stride);
+            __m64* p2 = reinterpret_cast<__m64*>(data + (i + 2) * stride);
+            __m64* p3 = reinterpret_cast<__m64*>(data + (i + 3) * stride);
+
+            __m256 points;
+            if (packed)
+            {
+                points = _mm256_loadu_ps(reinterpret_cast<float*>(p0));
+            }
+            else
+            {
+                __m128 low  = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), p0), p1);
+                __m128 high = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), p2), p3);
+                points = _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+            }
+
+            __m256 x      = _mm256_moveldup_ps(points);
+            __m256 y      = _mm256_movehdup_ps(points);
+            __m256 result = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x), _mm256_mul_ps(b, y)), t);
+
+            if (packed)
+            {
+                _mm256_storeu_ps(reinterpret_cast<float*>(p0), result);
+            }
+            else
+            {
+                __m128 low  = _mm256_castps256_ps128(result);
+                __m128 high = _mm256_extractf128_ps(result, 1);
+                _mm_storel_pi(p0, low);
+                _mm_storeh_pi(p1, low);
+                _mm_storel_pi(p2, high);
+                _mm_storeh_pi(p3, high);
+            }
+        }
+
+        return i;
+    }
 
+#endif
 
-////////////////////////////////////////////////////////////
-Transform::Transform(float a00, float a01, float a02,
-                     float a10, float a11, float a12,
-                     float a20, float a21, float a22)
-{
-    m_matrix[0] = a00; m_matrix[4] = a01; m_matrix[8]  = 0.f; m_matrix[12] = a02;
-    m_matrix[1] = a10; m_matrix[5] = a11; m_matrix[9]  = 0.f; m_matrix[13] = a12;
-    m_matrix[2] = 0.f; m_matrix[6] = 0.f; m_matrix[10] = 1.f; m_matrix[14] = 0.f;
-    m_matrix[3] = a20; m_matrix[7] = a21; m_matrix[11] = 0.f; m_matrix[15] = a22;
+    // Transform the points stored at the beginning of elements of a given size, in place
+    void transformPositions(const float* matrix, char* data, std::size_t stride, std::size_t count)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_CPU_DISPATCH_X86)
+
+        // The build may not enable AVX, the processor running it is checked instead
+        if (sf::priv::Cpu::hasFeatures(sf::priv::Cpu::Avx))
+            i = transformPositionsAvx(matrix, data, stride, count);
+
+#endif
+
+#if defined(SFML_CPU_SSE2)
+
+        // Two points are transformed at once, as (x0, y0, x1, y1)
+        const __m128 a = _mm_setr_ps(matrix[0], matrix[1], matrix[0], matrix[1]);
+        const __m128 b = _mm_setr_ps(matrix[4], matrix[5], matrix[4], matrix[5]);
+        const __m128 t = _mm_setr_ps(matrix[12], matrix[13], matrix[12], matrix[13]);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            __m64* first  = reinterpret_cast<__m64*>(data + i * stride);
+            __m64* second = reinterpret_cast<__m64*>(data + (i + 1) * stride);
+
+            __m128 points = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), first), second);
+            __m128 x      = _mm_shuffle_ps(points, points, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 y      = _mm_shuffle_ps(points, points, _MM_SHUFFLE(3, 3, 1, 1));
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), t);
+
+            _mm_storel_pi(first, result);
+            _mm_storeh_pi(second, result);
+        }
+
+#elif defined(SFML_CPU_NEON)
+
+        // Two points are transformed at once, as (x0, y0, x1, y1)
+        const float coefficients[3][4] =
+        {
+            {matrix[0],  matrix[1],  matrix[0],  matrix[1]},
+            {matrix[4],  matrix[5],  matrix[4],  matrix[5]},
+            {matrix[12], matrix[13], matrix[12], matrix[13]}
+        };
+        const float32x4_t a = vld1q_f32(coefficients[0]);
+        const float32x4_t b = vld1q_f32(coefficients[1]);
+        const float32x4_t t = vld1q_f32(coefficients[2]);
+
+        for (; i + 2 <= count; i += 2)
+        {
+            float* first  = reinterpret_cast<float*>(data + i * stride);
+            float* second = reinterpret_cast<float*>(data + (i + 1) * stride);
+
+            float32x4_t   points = vcombine_f32(vld1_f32(first), vld1_f32(second));
+            float32x4x2_t xy     = vtrnq_f32(points, points);
+            float32x4_t   result = vaddq_f32(vaddq_f32(vmulq_f32(a, xy.val[0]), vmulq_f32(b, xy.val[1])), t);
+
+            vst1_f32(first, vget_low_f32(result));
+            vst1_f32(second, vget_high_f32(result));
+        }
+
+#endif
+
+        for (; i < count; ++i)
+        {
+            float* point = reinterpret_cast<float*>(data + i * stride);
+            float  x     = point[0];
+            float  y     = point[1];
+
+            point[0] = matrix[0] * x + matrix[4] * y + matrix[12];
+            point[1] = matrix[1] * x + matrix[5] * y + matrix[13];
+        }
+    }
 }
 
 
-////////////////////////////////////////////////////////////
-const float* Transform::getMatrix() const
+namespace sf
 {
-    return m_matrix;
-}
+////////////////////////////////////////////////////////////
+const Transform Transform::Identity;
 
 
 ////////////////////////////////////////////////////////////
@@ -95,77 +202,70 @@ Transform Transform::getInverse() const
 
 
 ////////////////////////////////////////////////////////////
-Vector2f Transform::transformPoint(float x, float y) const
+void Transform::transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const
 {
-    return Vector2f(m_matrix[0] * x + m_matrix[4] * y + m_matrix[12],
-                    m_matrix[1] * x + m_matrix[5] * y + m_matrix[13]);
+    if (!count)
+        return;
+
+    if (output != input)
+        std::copy(input, input + count, output);
+
+    transformPositions(m_matrix, reinterpret_cast<char*>(output), sizeof(Vector2f), count);
 }
 
 
 ////////////////////////////////////////////////////////////
-Vector2f Transform::transformPoint(const Vector2f& point) const
+void Transform::transformPoints(const Vertex* input, Vertex* output, std::size_t count) const
 {
-    return transformPoint(point.x, point.y);
+    if (!count)
+        return;
+
+    if (output != input)
+        std::copy(input, input + count, output);
+
+    // The position is the first member of the vertices
+    transformPositions(m_matrix, reinterpret_cast<char*>(&output->position), sizeof(Vertex), count);
 }
 
 
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
-    // Transform the 4 corners of the rectangle
-    const Vector2f points[] =
+    // Transform the top-left corner and the two edges leaving it, the bounding
+    // rectangle then spans the negative and positive components of the edges
+    float left = m_matrix[0] * rectangle.left + m_matrix[4] * rectangle.top + m_matrix[12];
+    float top  = m_matrix[1] * rectangle.left + m_matrix[5] * rectangle.top + m_matrix[13];
+
+    float edges[] =
     {
-        transformPoint(rectangle.left, rectangle.top),
-        transformPoint(rectangle.left, rectangle.top + rectangle.height),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top),
-        transformPoint(rectangle.left + rectangle.width, rectangle.top + rectangle.height)
+        m_matrix[0] * rectangle.width, m_matrix[4] * rectangle.height,
+        m_matrix[1] * rectangle.width, m_matrix[5] * rectangle.height
     };
 
-    // Compute the bounding rectangle of the transformed points
-    float left = points[0].x;
-    float top = points[0].y;
-    float right = points[0].x;
-    float bottom = points[0].y;
-    for (int i = 1; i < 4; ++i)
+    float width  = 0.f;
+    float height = 0.f;
+    for (int i = 0; i < 2; ++i)
     {
-        if      (points[i].x < left)   left = points[i].x;
-        else if (points[i].x > right)  right = points[i].x;
-        if      (points[i].y < top)    top = points[i].y;
-        else if (points[i].y > bottom) bottom = points[i].y;
-    }
+        if (edges[i] < 0.f) left += edges[i];
+        width += std::abs(edges[i]);
 
-    return FloatRect(left, top, right - left, bottom - top);
-}
-
-
-////////////////////////////////////////////////////////////
-Transform& Transform::combine(const Transform& transform)
-{
-    const float* a = m_matrix;
-    const float* b = transform.m_matrix;
-
-    *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
-                      a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
-                      a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
-                      a[1] * b[0]  + a[5] * b[1]  + a[13] * b[3],
-                      a[1] * b[4]  + a[5] * b[5]  + a[13] * b[7],
-                      a[1] * b[12] + a[5] * b[13] + a[13] * b[15],
-                      a[3] * b[0]  + a[7] * b[1]  + a[15] * b[3],
-                      a[3] * b[4]  + a[7] * b[5]  + a[15] * b[7],
-                      a[3] * b[12] + a[7] * b[13] + a[15] * b[15]);
+        if (edges[i + 2] < 0.f) top += edges[i + 2];
+        height += std::abs(edges[i + 2]);
+    }
 
-    return *this;
+    return FloatRect(left, top, width, height);
 }
 
 
 ////////////////////////////////////////////////////////////
 Transform& Transform::translate(float x, float y)
 {
-    Transform translation(1, 0, x,
-                          0, 1, y,
-                          0, 0, 1);
+    // Only the last column changes, there's no need for a full combine
+    m_matrix[12] += m_matrix[0] * x + m_matrix[4] * y;
+    m_matrix[13] += m_matrix[1] * x + m_matrix[5] * y;
+    m_matrix[15] += m_matrix[3] * x + m_matrix[7] * y;
 
-    return combine(translation);
+    return *this;
 }
 
 
@@ -183,11 +283,18 @@ Transform& Transform::rotate(float angle)
     float cos = std::cos(rad);
     float sin = std::sin(rad);
 
-    Transform rotation(cos, -sin, 0,
-                       sin,  cos, 0,
-                       0,    0,   1);
+    // Only the first two columns change, there's no need for a full combine
+    const int rows[] = {0, 1, 3};
+    for (int i = 0; i < 3; ++i)
+    {
+        float x = m_matrix[rows[i]];
+        float y = m_matrix[rows[i] + 4];
+
+        m_matrix[rows[i]]     = x * cos + y * sin;
+        m_matrix[rows[i] + 4] = y * cos - x * sin;
+    }
 
-    return combine(rotation);
+    return *this;
 }
 
 
@@ -198,11 +305,10 @@ Transform& Transform::rotate(float angle, float centerX, float centerY)
     float cos = std::cos(rad);
     float sin = std::sin(rad);
 
-    Transform rotation(cos, -sin, centerX * (1 - cos) + centerY * sin,
-                       sin,  cos, centerY * (1 - cos) - centerX * sin,
-                       0,    0,   1);
+    // A rotation around a center is a rotation preceded by a translation
+    translate(centerX * (1 - cos) + centerY * sin, centerY * (1 - cos) - centerX * sin);
 
-    return combine(rotation);
+    return rotate(angle);
 }
 
 
@@ -216,22 +322,22 @@ Transform& Transform::rotate(float angle, const Vector2f& center)
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY)
 {
-    Transform scaling(scaleX, 0,      0,
-                      0,      scaleY, 0,
-                      0,      0,      1);
+    // Only the first two columns change, there's no need for a full combine
+    m_matrix[0] *= scaleX; m_matrix[4] *= scaleY;
+    m_matrix[1] *= scaleX; m_matrix[5] *= scaleY;
+    m_matrix[3] *= scaleX; m_matrix[7] *= scaleY;
 
-    return combine(scaling);
+    return *this;
 }
 
 
 ////////////////////////////////////////////////////////////
 Transform& Transform::scale(float scaleX, float scaleY, float centerX, float centerY)
 {
-    Transform scaling(scaleX, 0,      centerX * (1 - scaleX),
-                      0,      scaleY, centerY * (1 - scaleY),
-                      0,      0,      1);
+    // A scaling around a center is a scaling preceded by a translation
+    translate(centerX * (1 - scaleX), centerY * (1 - scaleY));
 
-    return combine(scaling);
+    return scale(scaleX, scaleY);
 }
 
 
@@ -248,44 +354,4 @@ Transform& Transform::scale(const Vector2f& factors, const Vector2f& center)
     return scale(factors.x, factors.y, center.x, center.y);
 }
 
-
-////////////////////////////////////////////////////////////
-Transform operator *(const Transform& left, const Transform& right)
-{
-    return Transform(left).combine(right);
-}
-
-
-////////////////////////////////////////////////////////////
-Transform& operator *=(Transform& left, const Transform& right)
-{
-    return left.combine(right);
-}
-
-
-////////////////////////////////////////////////////////////
-Vector2f operator *(const Transform& left, const Vector2f& right)
-{
-    return left.transformPoint(right);
-}
-
-
-////////////////////////////////////////////////////////////
-bool operator ==(const Transform& left, const Transform& right)
-{
-    const float* a = left.getMatrix();
-    const float* b = right.getMatrix();
-
-    return ((a[0]  == b[0])  && (a[1]  == b[1])  && (a[3]  == b[3]) &&
-            (a[4]  == b[4])  && (a[5]  == b[5])  && (a[7]  == b[7]) &&
-            (a[12] == b[12]) && (a[13] == b[13]) && (a[15] == b[15]));
-}
-
-
-////////////////////////////////////////////////////////////
-bool operator !=(const Transform& left, const Transform& right)
-{
-    return !(left == right);
-}
-
 } // namespace sf
@@ -40,7 +40,8 @@ m_scale                     (1, 1),
 m_transform                 (),
 m_transformNeedUpdate       (true),
 m_inverseTransform          (),
-m_inverseTransformNeedUpdate(true)
+m_inverseTransformNeedUpdate(true),
+m_transformVersion          (0)
 {
 }
 
@@ -58,6 +59,7 @@ void Transformable::setPosition(float x, float y)
     m_position.y = y;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    ++m_transformVersion;
 }
 
 
@@ -77,6 +79,7 @@ void Transformable::setRotation(float angle)
 
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    ++m_transformVersion;
 }
 
 
@@ -87,6 +90,7 @@ void Transformable::setScale(float factorX, float factorY)
     m_scale.y = factorY;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    ++m_transformVersion;
 }
 
 
@@ -104,6 +108,7 @@ void Transformable::setOrigin(float x, float y)
     m_origin.y = y;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+    ++m_transformVersion;
 }
 
 
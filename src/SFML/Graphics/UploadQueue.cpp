@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UploadQueue.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct UploadQueue::Upload
+{
+    Upload() :
+#ifndef SFML_OPENGL_ES
+    fence (0),
+#endif // SFML_OPENGL_ES
+    status(Queued)
+    {
+    }
+
+#ifndef SFML_OPENGL_ES
+    GLsync fence;  ///< Fence signaled when the GPU has executed the commands of the job
+#endif // SFML_OPENGL_ES
+    Status status; ///< Progress of the job, as last observed
+};
+
+
+////////////////////////////////////////////////////////////
+struct UploadQueue::Runner
+{
+    Runner(UploadQueue& owner, priv::ThreadFunc* job, Handle handle) :
+    owner (&owner),
+    job   (job),
+    handle(handle)
+    {
+    }
+
+    void operator()()
+    {
+        owner->execute(job, handle);
+    }
+
+    UploadQueue*      owner;  ///< Queue that submitted the job
+    priv::ThreadFunc* job;    ///< Job to run
+    Handle            handle; ///< Handle of the job
+};
+
+
+////////////////////////////////////////////////////////////
+UploadQueue::UploadQueue(unsigned int threadCount) :
+m_mutex       (),
+m_uploads     (),
+m_contexts    (),
+m_freeContexts(),
+m_nextHandle  (1),
+m_queuedCount (0),
+m_pool        (threadCount)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UploadQueue::~UploadQueue()
+{
+    // Let the worker threads drain the queue, rather than running
+    // the remaining jobs here and switching this thread's context
+    for (;;)
+    {
+        {
+            Lock lock(m_mutex);
+
+            if (m_queuedCount == 0)
+                break;
+        }
+
+        sleep(milliseconds(1));
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    bool hasFences = false;
+
+    for (UploadTable::const_iterator it = m_uploads.begin(); it != m_uploads.end(); ++it)
+        hasFences = hasFences || it->second->fence;
+
+    if (hasFences)
+    {
+        TransientContextLock lock;
+
+        for (UploadTable::iterator it = m_uploads.begin(); it != m_uploads.end(); ++it)
+        {
+            if (it->second->fence)
+                glCheck(GLEXT_glDeleteSync(it->second->fence));
+        }
+    }
+
+#endif // SFML_OPENGL_ES
+
+    for (UploadTable::iterator it = m_uploads.begin(); it != m_uploads.end(); ++it)
+        delete it->second;
+
+    // The contexts are inactive between jobs, they can be destroyed from any thread
+    for (std::vector<Context*>::iterator it = m_contexts.begin(); it != m_contexts.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+UploadQueue::Status UploadQueue::getStatus(Handle handle)
+{
+    Lock lock(m_mutex);
+
+    UploadTable::iterator it = m_uploads.find(handle);
+
+    if (it == m_uploads.end())
+        return Complete;
+
+    Upload& upload = *it->second;
+
+#ifndef SFML_OPENGL_ES
+
+    if (upload.status == Submitted)
+    {
+        TransientContextLock contextLock;
+
+        GLenum result = GL_FALSE;
+        glCheck(result = GLEXT_glClientWaitSync(upload.fence, 0, 0));
+
+        if ((result != GLEXT_GL_ALREADY_SIGNALED) && (result != GLEXT_GL_CONDITION_SATISFIED) && (result != GLEXT_GL_WAIT_FAILED))
+            return Submitted;
+
+        glCheck(GLEXT_glDeleteSync(upload.fence));
+        upload.fence = 0;
+        upload.status = Complete;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    Status status = upload.status;
+
+    // Forget the job once it is complete
+    if (status == Complete)
+    {
+        delete it->second;
+        m_uploads.erase(it);
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UploadQueue::wait(Handle handle, Time timeout)
+{
+    Clock clock;
+
+    while (getStatus(handle) != Complete)
+    {
+        if ((timeout != Time::Zero) && (clock.getElapsedTime() >= timeout))
+            return false;
+
+        sleep(milliseconds(1));
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UploadQueue::isIdle()
+{
+    std::vector<Handle> handles;
+
+    {
+        Lock lock(m_mutex);
+
+        for (UploadTable::const_iterator it = m_uploads.begin(); it != m_uploads.end(); ++it)
+            handles.push_back(it->first);
+    }
+
+    bool idle = true;
+
+    // Check every job, so that the complete ones are released
+    for (std::vector<Handle>::const_iterator it = handles.begin(); it != handles.end(); ++it)
+        idle = (getStatus(*it) == Complete) && idle;
+
+    return idle;
+}
+
+
+////////////////////////////////////////////////////////////
+UploadQueue::Handle UploadQueue::enqueue(priv::ThreadFunc* job)
+{
+    Handle handle = 0;
+
+    {
+        Lock lock(m_mutex);
+
+        handle = m_nextHandle++;
+        m_uploads[handle] = new Upload;
+        ++m_queuedCount;
+    }
+
+    m_pool.push(Runner(*this, job, handle));
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+void UploadQueue::execute(priv::ThreadFunc* job, Handle handle)
+{
+    Context* context = NULL;
+
+    {
+        Lock lock(m_mutex);
+
+        if (!m_freeContexts.empty())
+        {
+            context = m_freeContexts.back();
+            m_freeContexts.pop_back();
+        }
+    }
+
+    // Contexts are pooled rather than bound to a worker thread, so
+    // that the queue never holds more of them than there are jobs
+    // running at the same time
+    if (context)
+    {
+        context->setActive(true);
+    }
+    else
+    {
+        context = new Context;
+
+        Lock lock(m_mutex);
+        m_contexts.push_back(context);
+    }
+
+    priv::ensureExtensionsInit();
+
+    job->run();
+    delete job;
+
+    Upload result;
+    result.status = Complete;
+
+#ifndef SFML_OPENGL_ES
+
+    if (GLEXT_sync)
+    {
+        glCheck(result.fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        result.status = Submitted;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Make sure the commands (and the fence) reach the GPU, other
+    // contexts can only wait for commands that have been flushed
+    if (result.status == Submitted)
+        glCheck(glFlush());
+    else
+        glCheck(glFinish());
+
+    // Deactivate the context so that it can be used by another worker
+    context->setActive(false);
+
+    Lock lock(m_mutex);
+
+    m_freeContexts.push_back(context);
+    *m_uploads[handle] = result;
+    --m_queuedCount;
+}
+
+} // namespace sf
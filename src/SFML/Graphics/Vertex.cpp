@@ -34,7 +34,8 @@ namespace sf
 Vertex::Vertex() :
 position (0, 0),
 color    (255, 255, 255),
-texCoords(0, 0)
+texCoords(0, 0),
+layer    (0)
 {
 }
 
@@ -43,7 +44,8 @@ texCoords(0, 0)
 Vertex::Vertex(const Vector2f& thePosition) :
 position (thePosition),
 color    (255, 255, 255),
-texCoords(0, 0)
+texCoords(0, 0),
+layer    (0)
 {
 }
 
@@ -52,7 +54,8 @@ texCoords(0, 0)
 Vertex::Vertex(const Vector2f& thePosition, const Color& theColor) :
 position (thePosition),
 color    (theColor),
-texCoords(0, 0)
+texCoords(0, 0),
+layer    (0)
 {
 }
 
@@ -61,7 +64,8 @@ texCoords(0, 0)
 Vertex::Vertex(const Vector2f& thePosition, const Vector2f& theTexCoords) :
 position (thePosition),
 color    (255, 255, 255),
-texCoords(theTexCoords)
+texCoords(theTexCoords),
+layer    (0)
 {
 }
 
@@ -70,7 +74,18 @@ texCoords(theTexCoords)
 Vertex::Vertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords) :
 position (thePosition),
 color    (theColor),
-texCoords(theTexCoords)
+texCoords(theTexCoords),
+layer    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Vertex::Vertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords, float theLayer) :
+position (thePosition),
+color    (theColor),
+texCoords(theTexCoords),
+layer    (theLayer)
 {
 }
 
@@ -27,22 +27,27 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray() :
-m_vertices     (),
-m_primitiveType(Points)
+m_vertices        (),
+m_primitiveType   (Points),
+m_bounds          (),
+m_boundsNeedUpdate(false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray(PrimitiveType type, std::size_t vertexCount) :
-m_vertices     (vertexCount),
-m_primitiveType(type)
+m_vertices        (vertexCount),
+m_primitiveType   (type),
+m_bounds          (),
+m_boundsNeedUpdate(vertexCount > 0)
 {
 }
 
@@ -57,6 +62,9 @@ std::size_t VertexArray::getVertexCount() const
 ////////////////////////////////////////////////////////////
 Vertex& VertexArray::operator [](std::size_t index)
 {
+    // The vertex may be modified through the returned reference
+    m_boundsNeedUpdate = true;
+
     return m_vertices[index];
 }
 
@@ -72,13 +80,24 @@ const Vertex& VertexArray::operator [](std::size_t index) const
 void VertexArray::clear()
 {
     m_vertices.clear();
+
+    m_bounds = FloatRect();
+    m_boundsNeedUpdate = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 void VertexArray::resize(std::size_t vertexCount)
 {
+    if (vertexCount == m_vertices.size())
+        return;
+
     m_vertices.resize(vertexCount);
+
+    if (m_vertices.empty())
+        clear();
+    else
+        m_boundsNeedUpdate = true;
 }
 
 
@@ -86,6 +105,46 @@ void VertexArray::resize(std::size_t vertexCount)
 void VertexArray::append(const Vertex& vertex)
 {
     m_vertices.push_back(vertex);
+
+    // Extend the cached bounds with the new vertex instead of dropping them
+    if (!m_boundsNeedUpdate)
+        updateBounds(m_vertices.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::append(const Vertex* vertices, std::size_t vertexCount)
+{
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    std::size_t first = m_vertices.size();
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+
+    if (!m_boundsNeedUpdate)
+        updateBounds(first);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::reserve(std::size_t vertexCount)
+{
+    m_vertices.reserve(vertexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexArray::getCapacity() const
+{
+    return m_vertices.capacity();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::shrinkToFit()
+{
+    if (m_vertices.capacity() > m_vertices.size())
+        std::vector<Vertex>(m_vertices).swap(m_vertices);
 }
 
 
@@ -105,38 +164,29 @@ PrimitiveType VertexArray::getPrimitiveType() const
 
 ////////////////////////////////////////////////////////////
 FloatRect VertexArray::getBounds() const
+{
+    if (m_boundsNeedUpdate)
+        updateBounds(0);
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::invalidateBounds()
 {
     if (!m_vertices.empty())
-    {
-        float left   = m_vertices[0].position.x;
-        float top    = m_vertices[0].position.y;
-        float right  = m_vertices[0].position.x;
-        float bottom = m_vertices[0].position.y;
-
-        for (std::size_t i = 1; i < m_vertices.size(); ++i)
-        {
-            Vector2f position = m_vertices[i].position;
-
-            // Update left and right
-            if (position.x < left)
-                left = position.x;
-            else if (position.x > right)
-                right = position.x;
-
-            // Update top and bottom
-            if (position.y < top)
-                top = position.y;
-            else if (position.y > bottom)
-                bottom = position.y;
-        }
-
-        return FloatRect(left, top, right - left, bottom - top);
-    }
-    else
-    {
-        // Array is empty
-        return FloatRect();
-    }
+        m_boundsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::swap(VertexArray& right)
+{
+    m_vertices.swap(right.m_vertices);
+    std::swap(m_primitiveType, right.m_primitiveType);
+    std::swap(m_bounds, right.m_bounds);
+    std::swap(m_boundsNeedUpdate, right.m_boundsNeedUpdate);
 }
 
 
@@ -147,4 +197,68 @@ void VertexArray::draw(RenderTarget& target, RenderStates states) const
         target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
 }
 
+
+////////////////////////////////////////////////////////////
+bool VertexArray::getCullingBounds(FloatRect& bounds) const
+{
+    bounds = getBounds();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::updateBounds(std::size_t first) const
+{
+    m_boundsNeedUpdate = false;
+
+    if (m_vertices.empty())
+    {
+        // Array is empty
+        m_bounds = FloatRect();
+        return;
+    }
+
+    float left;
+    float top;
+    float right;
+    float bottom;
+
+    if (first == 0)
+    {
+        // Start from scratch
+        left   = m_vertices[0].position.x;
+        top    = m_vertices[0].position.y;
+        right  = m_vertices[0].position.x;
+        bottom = m_vertices[0].position.y;
+        first  = 1;
+    }
+    else
+    {
+        // Extend the current bounds with the vertices added since they were computed
+        left   = m_bounds.left;
+        top    = m_bounds.top;
+        right  = m_bounds.left + m_bounds.width;
+        bottom = m_bounds.top + m_bounds.height;
+    }
+
+    for (std::size_t i = first; i < m_vertices.size(); ++i)
+    {
+        Vector2f position = m_vertices[i].position;
+
+        // Update left and right
+        if (position.x < left)
+            left = position.x;
+        else if (position.x > right)
+            right = position.x;
+
+        // Update top and bottom
+        if (position.y < top)
+            top = position.y;
+        else if (position.y > bottom)
+            bottom = position.y;
+    }
+
+    m_bounds = FloatRect(left, top, right - left, bottom - top);
+}
+
 } // namespace sf
@@ -36,7 +36,7 @@
 
 namespace
 {
-    sf::Mutex isAvailableMutex;
+    sf::Mutex vertexBufferAvailableMutex;
 
     GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
     {
@@ -57,7 +57,9 @@ VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_layout       (),
+m_mapped       (false)
 {
 }
 
@@ -67,7 +69,9 @@ VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_layout       (),
+m_mapped       (false)
 {
 }
 
@@ -77,7 +81,9 @@ VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_layout       (),
+m_mapped       (false)
 {
 }
 
@@ -87,7 +93,9 @@ VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_layout       (),
+m_mapped       (false)
 {
 }
 
@@ -97,7 +105,9 @@ VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_layout       (copy.m_layout),
+m_mapped       (false)
 {
     if (copy.m_buffer && copy.m_size)
     {
@@ -133,6 +143,12 @@ bool VertexBuffer::create(std::size_t vertexCount)
 
     TransientContextLock contextLock;
 
+    if (m_mapped)
+    {
+        err() << "Could not create vertex buffer, it is currently mapped" << std::endl;
+        return false;
+    }
+
     if (!m_buffer)
         glCheck(GLEXT_glGenBuffers(1, &m_buffer));
 
@@ -143,7 +159,7 @@ bool VertexBuffer::create(std::size_t vertexCount)
     }
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, m_layout.getStride() * vertexCount, 0, usageToGlEnum(m_usage)));
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
     m_size = vertexCount;
@@ -152,6 +168,23 @@ bool VertexBuffer::create(std::size_t vertexCount)
 }
 
 
+////////////////////////////////////////////////////////////
+bool VertexBuffer::create(std::size_t vertexCount, const VertexLayout& layout)
+{
+    if (!layout.find(VertexLayout::Position))
+    {
+        err() << "Could not create vertex buffer, the vertex layout has no position" << std::endl;
+        return false;
+    }
+
+    // Keep the layout of a mapped buffer, create reports the error
+    if (!m_mapped)
+        m_layout = layout;
+
+    return create(vertexCount);
+}
+
+
 ////////////////////////////////////////////////////////////
 std::size_t VertexBuffer::getVertexCount() const
 {
@@ -168,9 +201,23 @@ bool VertexBuffer::update(const Vertex* vertices)
 
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    // sf::Vertex instances can only be copied to buffers with their layout
+    if (!m_layout.isDefault())
+    {
+        err() << "Could not update vertex buffer, its layout doesn't match sf::Vertex" << std::endl;
+        return false;
+    }
+
+    return update(static_cast<const void*>(vertices), vertexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const void* vertices, std::size_t vertexCount, unsigned int offset)
 {
     // Sanity checks
-    if (!m_buffer)
+    if (!m_buffer || m_mapped)
         return false;
 
     if (!vertices)
@@ -181,17 +228,19 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
 
     TransientContextLock contextLock;
 
+    std::size_t stride = m_layout.getStride();
+
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
 
     // Check if we need to resize or orphan the buffer
     if (vertexCount >= m_size)
     {
-        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, 0, usageToGlEnum(m_usage)));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, stride * vertexCount, 0, usageToGlEnum(m_usage)));
 
         m_size = vertexCount;
     }
 
-    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * offset, sizeof(Vertex) * vertexCount, vertices));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, stride * offset, stride * vertexCount, vertices));
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
@@ -208,11 +257,19 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 
 #else
 
-    if (!m_buffer || !vertexBuffer.m_buffer)
+    if (!m_buffer || !vertexBuffer.m_buffer || m_mapped || vertexBuffer.m_mapped)
         return false;
 
+    if (m_layout != vertexBuffer.m_layout)
+    {
+        err() << "Could not copy vertex buffer, the vertex layouts differ" << std::endl;
+        return false;
+    }
+
     TransientContextLock contextLock;
 
+    std::size_t size = m_layout.getStride() * vertexBuffer.m_size;
+
     // Make sure that extensions are initialized
     sf::priv::ensureExtensionsInit();
 
@@ -221,7 +278,7 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, vertexBuffer.m_buffer));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, m_buffer));
 
-        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, sizeof(Vertex) * vertexBuffer.m_size));
+        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, size));
 
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
@@ -230,7 +287,7 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     }
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBuffer.m_size, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, size, 0, usageToGlEnum(m_usage)));
 
     void* destination = 0;
     glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
@@ -240,7 +297,7 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     void* source = 0;
     glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
 
-    std::memcpy(destination, source, sizeof(Vertex) * vertexBuffer.m_size);
+    std::memcpy(destination, source, size);
 
     GLboolean sourceResult = GL_FALSE;
     glCheck(sourceResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
@@ -261,6 +318,124 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 }
 
 
+////////////////////////////////////////////////////////////
+void* VertexBuffer::map(std::size_t offset, std::size_t vertexCount, Uint32 flags)
+{
+#ifdef SFML_OPENGL_ES
+
+    err() << "Could not map vertex buffer, mapping is not supported on OpenGL ES" << std::endl;
+    return NULL;
+
+#else
+
+    // Sanity checks
+    if (!m_buffer || m_mapped || !vertexCount)
+        return NULL;
+
+    if (offset + vertexCount > m_size)
+    {
+        err() << "Could not map vertex buffer, range is out of bounds" << std::endl;
+        return NULL;
+    }
+
+    TransientContextLock contextLock;
+
+    // Make sure that extensions are initialized
+    sf::priv::ensureExtensionsInit();
+
+    std::size_t stride = m_layout.getStride();
+    void* pointer = NULL;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    if (GLEXT_map_buffer_range)
+    {
+        GLbitfield access = GLEXT_GL_MAP_WRITE_BIT;
+
+        if (flags & MapInvalidateRange)
+            access |= GLEXT_GL_MAP_INVALIDATE_RANGE_BIT;
+
+        if (flags & MapInvalidateBuffer)
+            access |= GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT;
+
+        if (flags & MapUnsynchronized)
+            access |= GLEXT_GL_MAP_UNSYNCHRONIZED_BIT;
+
+        glCheck(pointer = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, stride * offset, stride * vertexCount, access));
+    }
+    else
+    {
+        // Without range mapping, the whole buffer is mapped and orphaning
+        // is the only way to avoid waiting for the pending draws
+        bool wholeBuffer = (offset == 0) && (vertexCount == m_size);
+
+        if ((flags & MapInvalidateBuffer) || ((flags & MapInvalidateRange) && wholeBuffer))
+            glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, stride * m_size, 0, usageToGlEnum(m_usage)));
+
+        glCheck(pointer = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
+
+        if (pointer)
+            pointer = static_cast<Uint8*>(pointer) + stride * offset;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    if (!pointer)
+    {
+        err() << "Could not map vertex buffer" << std::endl;
+        return NULL;
+    }
+
+    m_mapped = true;
+
+    return pointer;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::unmap()
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_mapped)
+        return false;
+
+    TransientContextLock contextLock;
+
+    GLboolean result = GL_FALSE;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    glCheck(result = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    m_mapped = false;
+
+    return result != GL_FALSE;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::isMapped() const
+{
+    return m_mapped;
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexLayout& VertexBuffer::getLayout() const
+{
+    return m_layout;
+}
+
+
 ////////////////////////////////////////////////////////////
 VertexBuffer& VertexBuffer::operator =(const VertexBuffer& right)
 {
@@ -279,6 +454,8 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_buffer,        right.m_buffer);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_layout,        right.m_layout);
+    std::swap(m_mapped,        right.m_mapped);
 }
 
 
@@ -332,7 +509,7 @@ VertexBuffer::Usage VertexBuffer::getUsage() const
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::isAvailable()
 {
-    Lock lock(isAvailableMutex);
+    Lock lock(vertexBufferAvailableMutex);
 
     static bool checked = false;
     static bool available = false;
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexLayout.hpp>
+#include <SFML/System/Err.hpp>
+#include <cassert>
+#include <cstring>
+
+
+namespace
+{
+    // Size of a single component of the given type
+    std::size_t getComponentSize(sf::VertexLayout::Type type)
+    {
+        switch (type)
+        {
+            case sf::VertexLayout::Float:     return 4;
+            case sf::VertexLayout::HalfFloat: return 2;
+            case sf::VertexLayout::Short:     return 2;
+            default:                          return 1;
+        }
+    }
+
+    // Check an attribute against a description
+    bool matches(const sf::VertexLayout::Attribute& attribute, sf::VertexLayout::Semantic semantic, unsigned int componentCount,
+                 sf::VertexLayout::Type type, bool normalized, std::size_t offset)
+    {
+        return (attribute.semantic == semantic) &&
+               (attribute.componentCount == componentCount) &&
+               (attribute.type == type) &&
+               (attribute.normalized == normalized) &&
+               (attribute.offset == offset);
+    }
+
+    // Keep attributes aligned to 4 bytes, which some drivers require for speed
+    std::size_t align(std::size_t size)
+    {
+        return (size + 3) & ~static_cast<std::size_t>(3);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VertexLayout::VertexLayout() :
+m_attributes(),
+m_stride    (0)
+{
+    add(Position, 2, Float);
+    add(Color, 4, UnsignedByte, true);
+    add(TexCoords, 3, Float);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexLayout::clear()
+{
+    m_attributes.clear();
+    m_stride = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexLayout::add(Semantic semantic, unsigned int componentCount, Type type, bool normalized)
+{
+    if (semantic == Custom)
+    {
+        err() << "Failed to add vertex attribute: custom attributes must be added with addCustom" << std::endl;
+        return false;
+    }
+
+    if (find(semantic))
+    {
+        err() << "Failed to add vertex attribute: the layout already has an attribute with this semantic" << std::endl;
+        return false;
+    }
+
+    bool validCount = (semantic == TexCoords) ? ((componentCount == 2) || (componentCount == 3))
+                                              : (componentCount == ((semantic == Position) ? 2u : 4u));
+    if (!validCount)
+    {
+        err() << "Failed to add vertex attribute: invalid number of components (" << componentCount << ")" << std::endl;
+        return false;
+    }
+
+    if (normalized && ((type == Float) || (type == HalfFloat)))
+    {
+        err() << "Failed to add vertex attribute: only integer components can be normalized" << std::endl;
+        return false;
+    }
+
+    // The fixed-function pipeline always normalizes integer colors
+    if ((semantic == Color) && !normalized && (type != Float) && (type != HalfFloat))
+    {
+        err() << "Failed to add vertex attribute: integer colors must be normalized" << std::endl;
+        return false;
+    }
+
+    Attribute attribute = {semantic, 0, componentCount, type, normalized, 0};
+    append(attribute);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexLayout::addCustom(unsigned int index, unsigned int componentCount, Type type, bool normalized)
+{
+    if (index >= MaxCustomAttributes)
+    {
+        err() << "Failed to add custom vertex attribute: index " << index << " is out of range" << std::endl;
+        return false;
+    }
+
+    for (std::vector<Attribute>::const_iterator it = m_attributes.begin(); it != m_attributes.end(); ++it)
+    {
+        if ((it->semantic == Custom) && (it->index == index))
+        {
+            err() << "Failed to add custom vertex attribute: index " << index << " is already used" << std::endl;
+            return false;
+        }
+    }
+
+    if ((componentCount < 1) || (componentCount > 4))
+    {
+        err() << "Failed to add custom vertex attribute: invalid number of components (" << componentCount << ")" << std::endl;
+        return false;
+    }
+
+    if (normalized && ((type == Float) || (type == HalfFloat)))
+    {
+        err() << "Failed to add custom vertex attribute: only integer components can be normalized" << std::endl;
+        return false;
+    }
+
+    Attribute attribute = {Custom, index, componentCount, type, normalized, 0};
+    append(attribute);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexLayout::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexLayout::getAttributeCount() const
+{
+    return m_attributes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexLayout::Attribute& VertexLayout::getAttribute(std::size_t index) const
+{
+    assert(index < m_attributes.size());
+    return m_attributes[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexLayout::Attribute* VertexLayout::find(Semantic semantic) const
+{
+    for (std::vector<Attribute>::const_iterator it = m_attributes.begin(); it != m_attributes.end(); ++it)
+    {
+        if (it->semantic == semantic)
+            return &*it;
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexLayout::isDefault() const
+{
+    return (m_stride == 24) &&
+           (m_attributes.size() == 3) &&
+           matches(m_attributes[0], Position, 2, Float, false, 0) &&
+           matches(m_attributes[1], Color, 4, UnsignedByte, true, 8) &&
+           matches(m_attributes[2], TexCoords, 3, Float, false, 12);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint16 VertexLayout::toHalfFloat(float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    Uint32 sign = (bits >> 16) & 0x8000;
+    Uint32 mantissa = bits & 0x007FFFFF;
+    int exponent = static_cast<int>((bits >> 23) & 0xFF);
+
+    // Infinity and NaN keep their meaning
+    if (exponent == 0xFF)
+        return static_cast<Uint16>(sign | 0x7C00 | (mantissa ? 0x0200 : 0));
+
+    exponent = exponent - 127 + 15;
+
+    // Too large for a half float
+    if (exponent >= 31)
+        return static_cast<Uint16>(sign | 0x7C00);
+
+    // Too small for a normalized half float, produce a denormal or zero
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+            return static_cast<Uint16>(sign);
+
+        mantissa |= 0x00800000;
+        Uint32 shift = static_cast<Uint32>(14 - exponent);
+        Uint32 half = mantissa >> shift;
+        half += (mantissa >> (shift - 1)) & 1;
+
+        return static_cast<Uint16>(sign | half);
+    }
+
+    // Round to nearest, a carry out of the mantissa correctly bumps the exponent
+    Uint32 half = (static_cast<Uint32>(exponent) << 10) | (mantissa >> 13);
+    half += (mantissa >> 12) & 1;
+
+    return static_cast<Uint16>(sign | half);
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexLayout::append(Attribute attribute)
+{
+    attribute.offset = align(m_stride);
+    m_stride = align(attribute.offset + attribute.componentCount * getComponentSize(attribute.type));
+
+    m_attributes.push_back(attribute);
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator ==(const VertexLayout& left, const VertexLayout& right)
+{
+    if ((left.getStride() != right.getStride()) || (left.getAttributeCount() != right.getAttributeCount()))
+        return false;
+
+    for (std::size_t i = 0; i < left.getAttributeCount(); ++i)
+    {
+        const VertexLayout::Attribute& attribute = left.getAttribute(i);
+
+        if (!matches(right.getAttribute(i), attribute.semantic, attribute.componentCount, attribute.type, attribute.normalized, attribute.offset) ||
+            (right.getAttribute(i).index != attribute.index))
+            return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator !=(const VertexLayout& left, const VertexLayout& right)
+{
+    return !(left == right);
+}
+
+} // namespace sf
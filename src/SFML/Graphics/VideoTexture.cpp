@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VideoTexture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // The U and V samples are read from the red and alpha channels of the
+    // luminance and luminance-alpha textures, which put them in every channel
+    const char* i420FragmentSource =
+        "uniform sampler2D planeY;\n"
+        "uniform sampler2D planeU;\n"
+        "uniform sampler2D planeV;\n"
+        "uniform vec2 chromaScale;\n"
+        "uniform mat3 yuvToRgb;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 coords = gl_TexCoord[0].xy;\n"
+        "    vec3 yuv = vec3(texture2D(planeY, coords).r,\n"
+        "                    texture2D(planeU, coords * chromaScale).r,\n"
+        "                    texture2D(planeV, coords * chromaScale).r);\n"
+        "    vec3 rgb = yuvToRgb * (yuv - vec3(0.0625, 0.5, 0.5));\n"
+        "    gl_FragColor = vec4(clamp(rgb, 0.0, 1.0), 1.0);\n"
+        "}\n";
+
+    const char* nv12FragmentSource =
+        "uniform sampler2D planeY;\n"
+        "uniform sampler2D planeU;\n"
+        "uniform vec2 chromaScale;\n"
+        "uniform mat3 yuvToRgb;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 coords = gl_TexCoord[0].xy;\n"
+        "    vec3 yuv = vec3(texture2D(planeY, coords).r, texture2D(planeU, coords * chromaScale).ra);\n"
+        "    vec3 rgb = yuvToRgb * (yuv - vec3(0.0625, 0.5, 0.5));\n"
+        "    gl_FragColor = vec4(clamp(rgb, 0.0, 1.0), 1.0);\n"
+        "}\n";
+
+    // Limited range conversion matrices, column-major (one column per Y, U, V component)
+    const float rec601Matrix[9] =
+    {
+        1.164f,  1.164f, 1.164f,
+        0.f,    -0.392f, 2.017f,
+        1.596f, -0.813f, 0.f
+    };
+
+    const float rec709Matrix[9] =
+    {
+        1.164f,  1.164f, 1.164f,
+        0.f,    -0.213f, 2.112f,
+        1.793f, -0.533f, 0.f
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VideoTexture::VideoTexture() :
+m_planes(),
+m_output(),
+m_shader(),
+m_format(I420)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool VideoTexture::create(unsigned int width, unsigned int height, PixelFormat format, ColorSpace colorSpace)
+{
+    if (!width || !height)
+    {
+        err() << "Failed to create video texture, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    if (!Shader::isAvailable())
+    {
+        err() << "Failed to create video texture (shaders are not available)" << std::endl;
+        return false;
+    }
+
+    if (!m_shader.loadFromMemory(format == NV12 ? nv12FragmentSource : i420FragmentSource, Shader::Fragment))
+    {
+        err() << "Failed to create video texture (failed to compile the conversion shader)" << std::endl;
+        return false;
+    }
+
+    if (!m_output.create(width, height))
+    {
+        err() << "Failed to create video texture (failed to create the target texture)" << std::endl;
+        return false;
+    }
+
+    m_format = format;
+
+    // Create the planes, then make them single-channel textures
+    Vector2u chromaSize((width + 1) / 2, (height + 1) / 2);
+    unsigned int planeCount = (format == NV12) ? 2 : 3;
+
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        for (unsigned int i = 0; i < planeCount; ++i)
+        {
+            Texture& plane = m_planes[i];
+            Vector2u size = (i == 0) ? Vector2u(width, height) : chromaSize;
+
+            if (!plane.create(size.x, size.y))
+            {
+                err() << "Failed to create video texture (failed to create the texture of plane " << i << ")" << std::endl;
+                return false;
+            }
+
+            GLenum planeFormat = ((format == NV12) && (i == 1)) ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+
+            glCheck(glBindTexture(GL_TEXTURE_2D, plane.m_texture));
+            glCheck(glTexImage2D(GL_TEXTURE_2D, 0, planeFormat, plane.m_actualSize.x, plane.m_actualSize.y, 0, planeFormat, GL_UNSIGNED_BYTE, NULL));
+
+            // Chroma planes are upsampled by the bilinear filter
+            plane.setSmooth(true);
+        }
+    }
+
+    // The planes may be padded differently when the textures are rounded up to powers of two
+    Vector2f lumaRatio(static_cast<float>(width) / m_planes[0].m_actualSize.x,
+                       static_cast<float>(height) / m_planes[0].m_actualSize.y);
+    Vector2f chromaRatio(static_cast<float>(chromaSize.x) / m_planes[1].m_actualSize.x,
+                         static_cast<float>(chromaSize.y) / m_planes[1].m_actualSize.y);
+
+    m_shader.setUniform("planeY", Shader::CurrentTexture);
+    m_shader.setUniform("planeU", m_planes[1]);
+    if (format == I420)
+        m_shader.setUniform("planeV", m_planes[2]);
+    m_shader.setUniform("chromaScale", Glsl::Vec2(chromaRatio.x / lumaRatio.x, chromaRatio.y / lumaRatio.y));
+    m_shader.setUniform("yuvToRgb", Glsl::Mat3(colorSpace == Rec601 ? rec601Matrix : rec709Matrix));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::update(const Uint8* y, std::size_t yStride, const Uint8* u, std::size_t uStride, const Uint8* v, std::size_t vStride)
+{
+    if (!m_planes[0].m_texture || !y || !u || ((m_format == I420) && !v))
+        return;
+
+    {
+        TransientContextLock lock;
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        uploadPlane(m_planes[0], y, yStride, 1);
+        if (m_format == NV12)
+        {
+            uploadPlane(m_planes[1], u, uStride, 2);
+        }
+        else
+        {
+            uploadPlane(m_planes[1], u, uStride, 1);
+            uploadPlane(m_planes[2], v, vStride, 1);
+        }
+    }
+
+    // Convert the planes into the RGB texture
+    Vector2f size(m_output.getSize());
+    Vertex vertices[4] =
+    {
+        Vertex(Vector2f(0, 0),           Vector2f(0, 0)),
+        Vertex(Vector2f(0, size.y),      Vector2f(0, size.y)),
+        Vertex(Vector2f(size.x, 0),      Vector2f(size.x, 0)),
+        Vertex(Vector2f(size.x, size.y), size)
+    };
+
+    RenderStates states(BlendNone);
+    states.texture = &m_planes[0];
+    states.shader  = &m_shader;
+
+    m_output.draw(vertices, 4, TriangleStrip, states);
+    m_output.display();
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::setSmooth(bool smooth)
+{
+    m_output.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u VideoTexture::getSize() const
+{
+    return m_output.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& VideoTexture::getTexture() const
+{
+    return m_output.getTexture();
+}
+
+
+////////////////////////////////////////////////////////////
+void VideoTexture::uploadPlane(Texture& texture, const Uint8* pixels, std::size_t stride, unsigned int channels)
+{
+    GLenum format = (channels == 2) ? GL_LUMINANCE_ALPHA : GL_LUMINANCE;
+    Vector2u size = texture.getSize();
+    std::size_t rowSize = size.x * channels;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture.m_texture));
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    if (stride == rowSize)
+    {
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.x, size.y, format, GL_UNSIGNED_BYTE, pixels));
+    }
+    else
+    {
+
+#ifndef SFML_OPENGL_ES
+
+        // Padded rows are skipped by the driver
+        glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(stride / channels)));
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.x, size.y, format, GL_UNSIGNED_BYTE, pixels));
+        glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+
+#else
+
+        // OpenGL ES 2 can't skip padding, upload the rows one by one
+        for (unsigned int row = 0; row < size.y; ++row)
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row, size.x, 1, format, GL_UNSIGNED_BYTE, pixels + row * stride));
+
+#endif
+
+    }
+
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+}
+
+} // namespace sf
@@ -166,6 +166,14 @@ const FloatRect& View::getViewport() const
 }
 
 
+////////////////////////////////////////////////////////////
+FloatRect View::getBounds() const
+{
+    // Unproject the corners of the clip space, rotation included
+    return getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+}
+
+
 ////////////////////////////////////////////////////////////
 void View::move(float offsetX, float offsetY)
 {
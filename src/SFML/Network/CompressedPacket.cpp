@@ -0,0 +1,384 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/CompressedPacket.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Identifiers of the encodings, stored in the first byte of the data sent
+    const sf::Uint8 rawData        = 0;
+    const sf::Uint8 compressedData = 1;
+
+    // Size of the header of compressed data (encoding, then uncompressed size)
+    const std::size_t encodingHeaderSize = 5;
+
+    // Parameters of the LZ4 block format
+    const std::size_t minMatch     = 4;     // Minimum length of a match
+    const std::size_t lastLiterals = 5;     // The last bytes of a block are always literals
+    const std::size_t matchLimit   = 12;    // No match can start in the last bytes of a block
+    const std::size_t maxOffset    = 65535; // Matches can't reference data further away than this
+    const std::size_t hashLog      = 12;    // Size of the hash table of the compressor, as a power of 2
+
+    // Read 4 bytes at any alignment
+    sf::Uint32 readUnaligned32(const char* data)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    // Hash the 4 bytes starting at a position, to find previous occurrences
+    std::size_t hash(const char* data)
+    {
+        return (readUnaligned32(data) * 2654435761u) >> (32 - hashLog);
+    }
+
+    // Write a length that doesn't fit in a token, as a sequence of 255 bytes
+    char* writeLength(char* output, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            *output++ = static_cast<char>(255);
+        *output++ = static_cast<char>(length);
+
+        return output;
+    }
+
+    // Write one LZ4 sequence (literals followed by a match)
+    char* writeSequence(char* output, const char* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+    {
+        char* token = output++;
+        *token = 0;
+
+        // Length of the literals
+        if (literalLength >= 15)
+        {
+            *token = static_cast<char>(15 << 4);
+            output = writeLength(output, literalLength - 15);
+        }
+        else
+        {
+            *token = static_cast<char>(literalLength << 4);
+        }
+
+        // The literals themselves
+        std::memcpy(output, literals, literalLength);
+        output += literalLength;
+
+        // The last sequence has no match
+        if (matchLength == 0)
+            return output;
+
+        // Offset of the match, in little endian
+        *output++ = static_cast<char>(offset & 0xFF);
+        *output++ = static_cast<char>(offset >> 8);
+
+        // Length of the match
+        matchLength -= minMatch;
+        if (matchLength >= 15)
+        {
+            *token = static_cast<char>(*token | 15);
+            output = writeLength(output, matchLength - 15);
+        }
+        else
+        {
+            *token = static_cast<char>(*token | matchLength);
+        }
+
+        return output;
+    }
+
+    // Maximum size that compressing a given amount of data can produce
+    std::size_t compressBound(std::size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    // Compress the bytes [start, end) of a buffer in the LZ4 block format;
+    // the bytes before start (the dictionary) can be referenced by matches
+    std::size_t compressBlock(const char* base, std::size_t start, std::size_t end, char* output)
+    {
+        char* begin = output;
+        std::size_t anchor = start;
+
+        if (end - start >= matchLimit + 1)
+        {
+            // Positions are stored + 1, 0 means empty
+            sf::Uint32 table[1 << hashLog];
+            std::memset(table, 0, sizeof(table));
+
+            // Register the end of the dictionary, which matches can reach
+            std::size_t dictionaryStart = (start > maxOffset) ? start - maxOffset : 0;
+            for (std::size_t i = dictionaryStart; i + minMatch <= start; ++i)
+                table[hash(base + i)] = static_cast<sf::Uint32>(i + 1);
+
+            std::size_t limit = end - matchLimit;
+            std::size_t position = start;
+            while (position < limit)
+            {
+                std::size_t h = hash(base + position);
+                std::size_t candidate = table[h];
+                table[h] = static_cast<sf::Uint32>(position + 1);
+
+                if ((candidate == 0) || (position - (candidate - 1) > maxOffset) || (readUnaligned32(base + candidate - 1) != readUnaligned32(base + position)))
+                {
+                    // No match: move forward faster and faster through incompressible data
+                    position += 1 + ((position - anchor) >> 6);
+                    continue;
+                }
+
+                // Extend the match as far as possible
+                std::size_t reference = candidate - 1;
+                std::size_t length = minMatch;
+                while ((position + length < end - lastLiterals) && (base[reference + length] == base[position + length]))
+                    ++length;
+
+                output = writeSequence(output, base + anchor, position - anchor, position - reference, length);
+                position += length;
+                anchor = position;
+            }
+        }
+
+        // Write the remaining bytes as literals
+        output = writeSequence(output, base + anchor, end - anchor, 0, 0);
+
+        return static_cast<std::size_t>(output - begin);
+    }
+
+    // Read a length extension; returns false if the input ends too early
+    bool readLength(const unsigned char*& input, const unsigned char* inputEnd, std::size_t& length)
+    {
+        unsigned char byte = 255;
+        while (byte == 255)
+        {
+            if (input >= inputEnd)
+                return false;
+
+            byte = *input++;
+            length += byte;
+        }
+
+        return true;
+    }
+
+    // Decompress an LZ4 block into the bytes [start, end) of a buffer;
+    // the bytes before start (the dictionary) can be referenced by matches
+    bool decompressBlock(const char* data, std::size_t size, char* base, std::size_t start, std::size_t end)
+    {
+        const unsigned char* input = reinterpret_cast<const unsigned char*>(data);
+        const unsigned char* inputEnd = input + size;
+        std::size_t position = start;
+
+        while (input < inputEnd)
+        {
+            unsigned char token = *input++;
+
+            // Copy the literals
+            std::size_t literalLength = token >> 4;
+            if ((literalLength == 15) && !readLength(input, inputEnd, literalLength))
+                return false;
+
+            if ((literalLength > static_cast<std::size_t>(inputEnd - input)) || (literalLength > end - position))
+                return false;
+
+            std::memcpy(base + position, input, literalLength);
+            input += literalLength;
+            position += literalLength;
+
+            // The last sequence has no match
+            if (input == inputEnd)
+                break;
+
+            // Copy the match, byte by byte since it may overlap the output
+            if (inputEnd - input < 2)
+                return false;
+
+            std::size_t offset = input[0] | (input[1] << 8);
+            input += 2;
+            if ((offset == 0) || (offset > position))
+                return false;
+
+            std::size_t matchLength = token & 15;
+            if ((matchLength == 15) && !readLength(input, inputEnd, matchLength))
+                return false;
+
+            matchLength += minMatch;
+            if (matchLength > end - position)
+                return false;
+
+            for (std::size_t i = 0; i < matchLength; ++i, ++position)
+                base[position] = base[position - offset];
+        }
+
+        return position == end;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedPacket::CompressedPacket() :
+m_threshold (128),
+m_dictionary(),
+m_buffer    ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setCompressionThreshold(std::size_t threshold)
+{
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedPacket::getCompressionThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setDictionary(const void* data, std::size_t size)
+{
+    // Only the end of the dictionary can be reached by matches
+    const char* begin = static_cast<const char*>(data);
+    if (size > maxOffset)
+    {
+        begin += size - maxOffset;
+        size = maxOffset;
+    }
+
+    if (begin && (size > 0))
+        m_dictionary.assign(begin, begin + size);
+    else
+        m_dictionary.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const void* CompressedPacket::onSend(std::size_t& size)
+{
+    const char* data = static_cast<const char*>(getData());
+    std::size_t dataSize = getDataSize();
+    std::size_t dictionarySize = m_dictionary.size();
+
+    // Try to compress the data if it is big enough
+    if (dataSize >= std::max<std::size_t>(m_threshold, 1))
+    {
+        m_buffer.resize(dictionarySize + dataSize + encodingHeaderSize + compressBound(dataSize));
+        char* window = &m_buffer[0];
+        char* output = window + dictionarySize + dataSize;
+
+        // The compressor needs the dictionary and the data to be contiguous
+        const char* base = data;
+        if (dictionarySize > 0)
+        {
+            std::memcpy(window, &m_dictionary[0], dictionarySize);
+            std::memcpy(window + dictionarySize, data, dataSize);
+            base = window;
+        }
+
+        std::size_t compressedSize = compressBlock(base, dictionarySize, dictionarySize + dataSize, output + encodingHeaderSize);
+
+        // Only send the compressed data if it's actually smaller
+        if (encodingHeaderSize + compressedSize < 1 + dataSize)
+        {
+            Uint32 originalSize = htonl(static_cast<Uint32>(dataSize));
+            output[0] = static_cast<char>(compressedData);
+            std::memcpy(output + 1, &originalSize, sizeof(originalSize));
+
+            size = encodingHeaderSize + compressedSize;
+            return output;
+        }
+    }
+
+    // Send the data as it is, after its encoding byte
+    m_buffer.resize(1 + dataSize);
+    m_buffer[0] = static_cast<char>(rawData);
+    if (dataSize > 0)
+        std::memcpy(&m_buffer[1], data, dataSize);
+
+    size = m_buffer.size();
+    return &m_buffer[0];
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::onReceive(const void* data, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    Uint8 encoding = static_cast<Uint8>(bytes[0]);
+
+    if (encoding == rawData)
+    {
+        append(bytes + 1, size - 1);
+    }
+    else if ((encoding == compressedData) && (size >= encodingHeaderSize))
+    {
+        Uint32 originalSize = 0;
+        std::memcpy(&originalSize, bytes + 1, sizeof(originalSize));
+        originalSize = ntohl(originalSize);
+
+        // LZ4 can't expand data more than 255 times: anything bigger is corrupted
+        std::size_t compressedSize = size - encodingHeaderSize;
+        if (originalSize / 255 > compressedSize)
+        {
+            err() << "Failed to decompress packet (invalid size)" << std::endl;
+            return;
+        }
+
+        // Decompress after the dictionary, so that matches can reference it
+        std::size_t dictionarySize = m_dictionary.size();
+        m_buffer.resize(dictionarySize + originalSize);
+        if (dictionarySize > 0)
+            std::memcpy(&m_buffer[0], &m_dictionary[0], dictionarySize);
+
+        if ((originalSize > 0) && !decompressBlock(bytes + encodingHeaderSize, compressedSize, &m_buffer[0], dictionarySize, dictionarySize + originalSize))
+        {
+            err() << "Failed to decompress packet (corrupted data or different dictionary)" << std::endl;
+            return;
+        }
+
+        if (originalSize > 0)
+            append(&m_buffer[dictionarySize], originalSize);
+    }
+    else
+    {
+        err() << "Failed to decompress packet (unknown encoding)" << std::endl;
+    }
+}
+
+} // namespace sf
@@ -27,10 +27,10 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <cctype>
-#include <fstream>
 #include <iterator>
 #include <sstream>
 #include <cstdio>
@@ -50,18 +50,22 @@ public:
     Ftp::Response open(Ftp::TransferMode mode);
 
     ////////////////////////////////////////////////////////////
-    void send(std::istream& stream);
+    void receive(std::ostream& stream);
 
     ////////////////////////////////////////////////////////////
-    void receive(std::ostream& stream);
+    void sendFile(std::FILE* file);
+
+    ////////////////////////////////////////////////////////////
+    void receiveFile(std::FILE* file);
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Ftp&      m_ftp;        ///< Reference to the owner Ftp instance
-    TcpSocket m_dataSocket; ///< Socket used for data transfers
+    Ftp&              m_ftp;        ///< Reference to the owner Ftp instance
+    TcpSocket         m_dataSocket; ///< Socket used for data transfers
+    std::vector<char> m_buffer;     ///< Buffer used for data transfers
 };
 
 
@@ -140,6 +144,16 @@ const std::vector<std::string>& Ftp::ListingResponse::getListing() const
 }
 
 
+////////////////////////////////////////////////////////////
+Ftp::Ftp() :
+m_commandSocket     (),
+m_receiveBuffer     (),
+m_transferBufferSize(65536)
+{
+
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::~Ftp()
 {
@@ -298,15 +312,15 @@ Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& lo
                 path += "/";
 
             // Create the file and truncate it if necessary
-            std::ofstream file((path + filename).c_str(), std::ios_base::binary | std::ios_base::trunc);
+            std::FILE* file = std::fopen((path + filename).c_str(), "wb");
             if (!file)
                 return Response(Response::InvalidFile);
 
             // Receive the file data
-            data.receive(file);
+            data.receiveFile(file);
 
             // Close the file
-            file.close();
+            std::fclose(file);
 
             // Get the response from the server
             response = getResponse();
@@ -325,7 +339,7 @@ Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& lo
 Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode, bool append)
 {
     // Get the contents of the file to send
-    std::ifstream file(localFile.c_str(), std::ios_base::binary);
+    std::FILE* file = std::fopen(localFile.c_str(), "rb");
     if (!file)
         return Response(Response::InvalidFile);
 
@@ -350,13 +364,16 @@ Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remot
         if (response.isOk())
         {
             // Send the file data
-            data.send(file);
+            data.sendFile(file);
 
             // Get the response from the server
             response = getResponse();
         }
     }
 
+    // Close the file
+    std::fclose(file);
+
     return response;
 }
 
@@ -380,6 +397,13 @@ Ftp::Response Ftp::sendCommand(const std::string& command, const std::string& pa
 }
 
 
+////////////////////////////////////////////////////////////
+void Ftp::setTransferBufferSize(std::size_t size)
+{
+    m_transferBufferSize = size;
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::Response Ftp::getResponse()
 {
@@ -524,7 +548,9 @@ Ftp::Response Ftp::getResponse()
 
 ////////////////////////////////////////////////////////////
 Ftp::DataChannel::DataChannel(Ftp& owner) :
-m_ftp(owner)
+m_ftp       (owner),
+m_dataSocket(),
+m_buffer    (std::max<std::size_t>(owner.m_transferBufferSize, 1))
 {
 
 }
@@ -595,11 +621,10 @@ Ftp::Response Ftp::DataChannel::open(Ftp::TransferMode mode)
 void Ftp::DataChannel::receive(std::ostream& stream)
 {
     // Receive data
-    char buffer[1024];
     std::size_t received;
-    while (m_dataSocket.receive(buffer, sizeof(buffer), received) == Socket::Done)
+    while (m_dataSocket.receive(&m_buffer[0], m_buffer.size(), received) == Socket::Done)
     {
-        stream.write(buffer, static_cast<std::streamsize>(received));
+        stream.write(&m_buffer[0], static_cast<std::streamsize>(received));
 
         if (!stream.good())
         {
@@ -614,35 +639,48 @@ void Ftp::DataChannel::receive(std::ostream& stream)
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::send(std::istream& stream)
+void Ftp::DataChannel::receiveFile(std::FILE* file)
 {
-    // Send data
-    char buffer[1024];
-    std::size_t count;
-
-    for (;;)
+    // Let the system write the data to the file directly if it can
+    if (!priv::SocketImpl::receiveFile(m_dataSocket.getHandle(), file))
     {
-        // read some data from the stream
-        stream.read(buffer, sizeof(buffer));
-
-        if (!stream.good() && !stream.eof())
+        std::size_t received;
+        while (m_dataSocket.receive(&m_buffer[0], m_buffer.size(), received) == Socket::Done)
         {
-            err() << "FTP Error: Reading from the file has failed" << std::endl;
-            break;
+            if (std::fwrite(&m_buffer[0], 1, received, file) != received)
+            {
+                err() << "FTP Error: Writing to the file has failed" << std::endl;
+                break;
+            }
         }
+    }
+
+    // Close the data socket
+    m_dataSocket.disconnect();
+}
 
-        count = static_cast<std::size_t>(stream.gcount());
 
-        if (count > 0)
+////////////////////////////////////////////////////////////
+void Ftp::DataChannel::sendFile(std::FILE* file)
+{
+    // Let the system read the data from the file directly if it can
+    if (!priv::SocketImpl::sendFile(m_dataSocket.getHandle(), file))
+    {
+        for (;;)
         {
-            // we could read more data from the stream: send them
-            if (m_dataSocket.send(buffer, count) != Socket::Done)
+            std::size_t count = std::fread(&m_buffer[0], 1, m_buffer.size(), file);
+            if (std::ferror(file))
+            {
+                err() << "FTP Error: Reading from the file has failed" << std::endl;
                 break;
-        }
-        else
-        {
+            }
+
             // no more data: exit the loop
-            break;
+            if (count == 0)
+                break;
+
+            if (m_dataSocket.send(&m_buffer[0], count) != Socket::Done)
+                break;
         }
     }
 
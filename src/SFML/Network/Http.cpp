@@ -26,7 +26,11 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/TlsSocket.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
 #include <cctype>
 #include <algorithm>
 #include <iterator>
@@ -43,11 +47,78 @@ namespace
             *i = static_cast<char>(std::tolower(*i));
         return str;
     }
+
+    // Tell whether the server agrees to keep the connection open after a response
+    bool isPersistent(const sf::Http::Response& response)
+    {
+        std::string connection = toLower(response.getField("connection"));
+        if (response.getMajorHttpVersion() * 10 + response.getMinorHttpVersion() >= 11)
+            return connection.find("close") == std::string::npos;
+        else
+            return connection.find("keep-alive") != std::string::npos;
+    }
 }
 
 
 namespace sf
 {
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Response sink storing the body in a string (outside of the
+// anonymous namespace, since Http::AsyncRequest stores one)
+////////////////////////////////////////////////////////////
+class StringSink : public Http::ResponseSink
+{
+public:
+
+    StringSink(std::string& body) : m_body(body) {}
+
+    virtual bool onResponse(const Http::Response& response)
+    {
+        // Allocate the body at once when its size is known (within reason)
+        std::istringstream in(response.getField("content-length"));
+        std::size_t length = 0;
+        if (in >> length)
+            m_body.reserve(std::min<std::size_t>(length, 16 * 1024 * 1024));
+
+        return true;
+    }
+
+    virtual bool onBodyData(const char* data, std::size_t size)
+    {
+        m_body.append(data, size);
+        return true;
+    }
+
+private:
+
+    std::string& m_body;
+};
+
+////////////////////////////////////////////////////////////
+// Response sink writing the body to a stream
+////////////////////////////////////////////////////////////
+class StreamSink : public Http::ResponseSink
+{
+public:
+
+    StreamSink(std::ostream& stream) : m_stream(stream) {}
+
+    virtual bool onBodyData(const char* data, std::size_t size)
+    {
+        m_stream.write(data, static_cast<std::streamsize>(size));
+        return m_stream.good();
+    }
+
+private:
+
+    std::ostream& m_stream;
+};
+
+} // namespace priv
+
+
 ////////////////////////////////////////////////////////////
 Http::Request::Request(const std::string& uri, Method method, const std::string& body)
 {
@@ -297,26 +368,435 @@ void Http::Response::parseFields(std::istream &in)
 }
 
 
+////////////////////////////////////////////////////////////
+/// Incremental parser of HTTP responses: the received bytes are
+/// fed as they arrive, whatever their size, so that it can be
+/// driven by blocking as well as non-blocking connections
+////////////////////////////////////////////////////////////
+class Http::ResponseReader
+{
+public:
+
+    enum Status
+    {
+        NeedMore, ///< The response is not complete yet
+        Complete, ///< The whole response was received
+        Failed    ///< The response is invalid, or the sink aborted it
+    };
+
+    ////////////////////////////////////////////////////////////
+    ResponseReader(bool head, Response& response, ResponseSink& sink) :
+    m_response  (response),
+    m_sink      (sink),
+    m_head      (head),
+    m_state     (Header),
+    m_pending   (),
+    m_position  (0),
+    m_remaining (0),
+    m_untilClose(false),
+    m_received  (false),
+    m_extraData (false)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    Status feed(const char* data, std::size_t size)
+    {
+        if (size > 0)
+            m_received = true;
+
+        if (m_state == Done)
+        {
+            m_extraData = m_extraData || (size > 0);
+            return Complete;
+        }
+
+        // Body data goes straight from the receive buffer to the sink
+        if ((m_state == Body) && m_pending.empty())
+            return deliverBody(data, size);
+
+        m_pending.append(data, size);
+        return process();
+    }
+
+    ////////////////////////////////////////////////////////////
+    Status finish()
+    {
+        // Only bodies without length end with the connection
+        if ((m_state == Body) && m_untilClose)
+        {
+            m_state = Done;
+            return Complete;
+        }
+
+        // Parse what we've got, so that the response status tells what went wrong
+        if ((m_state == Header) && (m_position < m_pending.size()))
+            m_response.parse(m_pending.substr(m_position));
+
+        return Failed;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool hasReceived() const
+    {
+        return m_received;
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool isReusable() const
+    {
+        return (m_state == Done) && !m_extraData && !m_untilClose;
+    }
+
+private:
+
+    enum State {Header, Body, ChunkSize, ChunkData, ChunkEnd, Trailers, Done};
+
+    ////////////////////////////////////////////////////////////
+    Status complete(std::size_t end)
+    {
+        m_extraData = (end < m_pending.size());
+        m_state = Done;
+        m_pending.clear();
+        m_position = 0;
+        return Complete;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Status needMore()
+    {
+        // Drop the consumed data before receiving more
+        m_pending.erase(0, m_position);
+        m_position = 0;
+        return NeedMore;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Status deliverBody(const char* data, std::size_t size)
+    {
+        std::size_t count = m_untilClose ? size : std::min(m_remaining, size);
+        if ((count > 0) && !m_sink.onBodyData(data, count))
+            return Failed;
+
+        if (!m_untilClose)
+        {
+            m_remaining -= count;
+            if (m_remaining == 0)
+            {
+                m_extraData = (count < size);
+                m_state = Done;
+                return Complete;
+            }
+        }
+
+        return NeedMore;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Status process()
+    {
+        for (;;)
+        {
+            switch (m_state)
+            {
+                case Header:
+                {
+                    std::string::size_type headerEnd = m_pending.find("\r\n\r\n", m_position);
+                    if (headerEnd == std::string::npos)
+                        return needMore();
+
+                    headerEnd += 4;
+                    m_response = Response();
+                    m_response.parse(m_pending.substr(m_position, headerEnd - m_position));
+                    m_position = headerEnd;
+
+                    // Skip interim 1xx responses
+                    int status = m_response.getStatus();
+                    if (status / 100 == 1)
+                        break;
+
+                    if ((status == Response::InvalidResponse) || !m_sink.onResponse(m_response))
+                        return Failed;
+
+                    // Responses that never have a body
+                    if (m_head || (status == 204) || (status == 304))
+                        return complete(m_position);
+
+                    // Chunked body: decode the chunks as they arrive
+                    if (toLower(m_response.getField("transfer-encoding")).find("chunked") != std::string::npos)
+                    {
+                        m_state = ChunkSize;
+                        break;
+                    }
+
+                    // Body with a known length, or until the connection is closed
+                    std::istringstream lengthStream(m_response.getField("content-length"));
+                    m_untilClose = !(lengthStream >> m_remaining);
+                    if (!m_untilClose && (m_remaining == 0))
+                        return complete(m_position);
+
+                    // Deliver what was received along with the header
+                    m_state = Body;
+                    std::string rest = m_pending.substr(m_position);
+                    m_pending.clear();
+                    m_position = 0;
+                    return deliverBody(rest.data(), rest.size());
+                }
+
+                case Body:
+                {
+                    std::string rest = m_pending.substr(m_position);
+                    m_pending.clear();
+                    m_position = 0;
+                    return deliverBody(rest.data(), rest.size());
+                }
+
+                case ChunkSize:
+                {
+                    std::string::size_type lineEnd = m_pending.find("\r\n", m_position);
+                    if (lineEnd == std::string::npos)
+                        return needMore();
+
+                    std::istringstream in(m_pending.substr(m_position, lineEnd - m_position));
+                    if (!(in >> std::hex >> m_remaining))
+                        return Failed;
+
+                    m_position = lineEnd + 2;
+                    m_state = (m_remaining > 0) ? ChunkData : Trailers;
+                    break;
+                }
+
+                case ChunkData:
+                {
+                    std::size_t count = std::min(m_remaining, m_pending.size() - m_position);
+                    if ((count > 0) && !m_sink.onBodyData(m_pending.data() + m_position, count))
+                        return Failed;
+
+                    m_position += count;
+                    m_remaining -= count;
+                    if (m_remaining > 0)
+                        return needMore();
+
+                    m_state = ChunkEnd;
+                    break;
+                }
+
+                case ChunkEnd:
+                {
+                    if (m_pending.size() - m_position < 2)
+                        return needMore();
+
+                    m_position += 2;
+                    m_state = ChunkSize;
+                    break;
+                }
+
+                case Trailers:
+                {
+                    // The body ends with an empty line, after the optional trailer fields
+                    std::string::size_type end = (m_pending.compare(m_position, 2, "\r\n") == 0) ? m_position : m_pending.find("\r\n\r\n", m_position);
+                    if (end == std::string::npos)
+                        return needMore();
+
+                    if (end > m_position)
+                    {
+                        std::istringstream in(m_pending.substr(m_position, end + 4 - m_position));
+                        m_response.parseFields(in);
+                        end += 2;
+                    }
+
+                    return complete(end + 2);
+                }
+
+                case Done:
+                {
+                    return Complete;
+                }
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Response&              m_response;   ///< Response to fill with the status and header fields
+    ResponseSink&          m_sink;       ///< Sink receiving the response body
+    bool                   m_head;       ///< Was the request a HEAD one (with no body in the response)?
+    State                  m_state;      ///< Part of the response being parsed
+    std::string            m_pending;    ///< Received bytes not consumed yet
+    std::string::size_type m_position;   ///< Position of the first byte not consumed in m_pending
+    std::size_t            m_remaining;  ///< Bytes left in the body or in the current chunk
+    bool                   m_untilClose; ///< Does the body end when the connection is closed?
+    bool                   m_received;   ///< Was any byte received?
+    bool                   m_extraData;  ///< Were bytes received after the end of the response?
+};
+
+
+////////////////////////////////////////////////////////////
+/// State of an asynchronous request in progress
+////////////////////////////////////////////////////////////
+struct Http::AsyncRequest::State
+{
+    enum Phase {Resolving, Connecting, Handshaking, Sending, Receiving};
+
+    State(ResponseSink* responseSink, Time requestTimeout) :
+    phase     (Resolving),
+    requestStr(),
+    sent      (0),
+    head      (false),
+    idempotent(false),
+    keepAlive (false),
+    host      (),
+    hostName  (),
+    port      (0),
+    secure    (false),
+    connection(NULL),
+    reused    (false),
+    retried   (false),
+    body      (),
+    bodySink  (body),
+    sink      (responseSink ? responseSink : &bodySink),
+    reader    (NULL),
+    clock     (),
+    timeout   (requestTimeout)
+    {
+    }
+
+    Phase            phase;      ///< Current step of the request
+    std::string      requestStr; ///< Request to send, as a string
+    std::size_t      sent;       ///< Number of bytes of the request already sent
+    bool             head;       ///< Is the request a HEAD one?
+    bool             idempotent; ///< Can the request be replayed safely (GET or HEAD)?
+    bool             keepAlive;  ///< Can the connection be kept for another request?
+    IpAddress        host;       ///< Address of the host
+    std::string      hostName;   ///< Name of the host, to check its certificate
+    unsigned short   port;       ///< Port of the host
+    bool             secure;     ///< Is the connection encrypted?
+    TcpSocket*       connection; ///< Connection to the host
+    bool             reused;     ///< Is the connection a kept one?
+    bool             retried;    ///< Was the request sent again after a kept connection was closed?
+    std::string      body;       ///< Body of the response, when there's no sink
+    priv::StringSink bodySink;   ///< Sink storing the body, when there's no sink
+    ResponseSink*    sink;       ///< Sink receiving the response
+    ResponseReader*  reader;     ///< Parser of the response
+    Clock            clock;      ///< Time elapsed since the request was sent
+    Time             timeout;    ///< Maximum duration of the request
+};
+
+
+////////////////////////////////////////////////////////////
+Http::AsyncRequest::AsyncRequest() :
+m_http    (NULL),
+m_state   (NULL),
+m_response(),
+m_done    (false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Http::AsyncRequest::~AsyncRequest()
+{
+    cancel();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::AsyncRequest::isDone() const
+{
+    return m_done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::AsyncRequest::isPending() const
+{
+    return m_http != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Http::Response& Http::AsyncRequest::getResponse() const
+{
+    return m_response;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::AsyncRequest::cancel()
+{
+    if (m_http)
+        m_http->cancelRequest(*this);
+}
+
+
 ////////////////////////////////////////////////////////////
 Http::Http() :
-m_host(),
-m_port(0)
+m_connections   (),
+m_host          (),
+m_hostName      (),
+m_port          (0),
+m_secure        (false),
+m_hostResolved  (false),
+m_keepAlive     (false),
+m_maxConnections(0),
+m_readBufferSize(16384),
+m_mutex         (),
+m_requests      (),
+m_poller        (),
+m_resolution    (),
+m_receiveBuffer ()
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Http(const std::string& host, unsigned short port)
+Http::Http(const std::string& host, unsigned short port) :
+m_connections   (),
+m_host          (),
+m_hostName      (),
+m_port          (0),
+m_secure        (false),
+m_hostResolved  (false),
+m_keepAlive     (false),
+m_maxConnections(0),
+m_readBufferSize(16384),
+m_mutex         (),
+m_requests      (),
+m_poller        (),
+m_resolution    (),
+m_receiveBuffer ()
 {
     setHost(host, port);
 }
 
 
+////////////////////////////////////////////////////////////
+Http::~Http()
+{
+    // Cancel the asynchronous requests in progress
+    while (!m_requests.empty())
+        cancelRequest(*m_requests.back());
+
+    closeConnections();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
 {
+    // The pending resolution is for the previous host
+    m_resolution.cancel();
+
+    Lock lock(m_mutex);
+
+    // The connections kept alive belong to the previous host
+    closeConnections();
+
     // Check the protocol
+    m_secure = false;
     if (toLower(host.substr(0, 7)) == "http://")
     {
         // HTTP protocol
@@ -325,10 +805,19 @@ void Http::setHost(const std::string& host, unsigned short port)
     }
     else if (toLower(host.substr(0, 8)) == "https://")
     {
-        // HTTPS protocol -- unsupported (requires encryption and certificates and stuff...)
-        err() << "HTTPS protocol is not supported by sf::Http" << std::endl;
-        m_hostName = "";
-        m_port     = 0;
+        // HTTPS protocol
+        if (TlsSocket::isAvailable())
+        {
+            m_hostName = host.substr(8);
+            m_port     = (port != 0 ? port : 443);
+            m_secure   = true;
+        }
+        else
+        {
+            err() << "HTTPS protocol is not supported by sf::Http (SFML was built without TLS support)" << std::endl;
+            m_hostName = "";
+            m_port     = 0;
+        }
     }
     else
     {
@@ -341,12 +830,240 @@ void Http::setHost(const std::string& host, unsigned short port)
     if (!m_hostName.empty() && (*m_hostName.rbegin() == '/'))
         m_hostName.erase(m_hostName.size() - 1);
 
-    m_host = IpAddress(m_hostName);
+    // The name is resolved when the first request needs it
+    m_host         = IpAddress::None;
+    m_hostResolved = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setKeepAlive(bool enabled, std::size_t maxConnections)
+{
+    Lock lock(m_mutex);
+
+    m_keepAlive      = enabled;
+    m_maxConnections = enabled ? maxConnections : 0;
+
+    // Drop the connections that we're not allowed to keep anymore
+    while (m_connections.size() > m_maxConnections)
+    {
+        delete m_connections.back();
+        m_connections.pop_back();
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
+{
+    // Receive the body in a string, and move it to the response
+    std::string body;
+    priv::StringSink sink(body);
+
+    Response response = sendRequest(request, sink, timeout);
+    response.m_body.swap(body);
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, std::ostream& body, Time timeout)
+{
+    priv::StreamSink sink(body);
+
+    return sendRequest(request, sink, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, ResponseSink& sink, Time timeout)
+{
+    // Take a snapshot of the settings, the connections are shared with other threads
+    IpAddress host = resolveHost();
+    std::string hostName;
+    unsigned short port;
+    bool secure;
+    bool keepAlive;
+    {
+        Lock lock(m_mutex);
+        hostName  = m_hostName;
+        port      = m_port;
+        secure    = m_secure;
+        keepAlive = m_keepAlive;
+    }
+
+    // Convert the request to string
+    std::string requestStr = prepareRequest(request, keepAlive);
+    bool head = (request.m_method == Request::Head);
+    bool idempotent = head || (request.m_method == Request::Get);
+
+    // Prepare the response
+    Response received;
+
+    // A kept connection may have been closed by the server in the meantime:
+    // in that case, try again once with a new connection
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        // Reuse an idle connection, if any
+        TcpSocket* connection = NULL;
+        if (keepAlive && (attempt == 0))
+        {
+            Lock lock(m_mutex);
+            if (!m_connections.empty())
+            {
+                connection = m_connections.back();
+                m_connections.pop_back();
+            }
+        }
+
+        // Otherwise connect a new socket to the host
+        bool reused = (connection != NULL);
+        bool sentEarly = false;
+        if (!reused)
+        {
+            connection = secure ? new TlsSocket : new TcpSocket;
+            if (connection->connect(host, port, timeout) != Socket::Done)
+            {
+                delete connection;
+                return received;
+            }
+
+            // Secure the connection, sending the request with the handshake if it can be replayed safely
+            if (secure)
+            {
+                TlsSocket& tls = static_cast<TlsSocket&>(*connection);
+                if (idempotent)
+                    tls.setEarlyData(requestStr.c_str(), requestStr.size());
+
+                if (tls.handshake(hostName) != Socket::Done)
+                {
+                    delete connection;
+                    return received;
+                }
+
+                sentEarly = idempotent;
+            }
+        }
+
+        // Send the request and wait for the server's response
+        bool anyReceived = false;
+        bool reusable = false;
+        bool complete = (sentEarly || (connection->send(requestStr.c_str(), requestStr.size()) == Socket::Done)) &&
+                        receiveResponse(*connection, head, received, sink, anyReceived, reusable);
+
+        if (!complete && reused && !anyReceived)
+        {
+            delete connection;
+            continue;
+        }
+
+        // Keep the connection for the next request if the server agrees
+        if (keepAlive && complete && reusable && isPersistent(received))
+        {
+            Lock lock(m_mutex);
+            if ((m_connections.size() < m_maxConnections) && (host == m_host) && (port == m_port))
+            {
+                m_connections.push_back(connection);
+                connection = NULL;
+            }
+        }
+
+        // Close the connection
+        delete connection;
+        break;
+    }
+
+    return received;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::sendRequestAsync(const Request& request, AsyncRequest& handle, Time timeout)
+{
+    startRequest(request, handle, NULL, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::sendRequestAsync(const Request& request, AsyncRequest& handle, ResponseSink& sink, Time timeout)
+{
+    startRequest(request, handle, &sink, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::update(Time timeout)
+{
+    if (m_requests.empty())
+        return;
+
+    // Wait for network activity if requested
+    if (timeout != Time::Zero)
+    {
+        if (m_poller.getSocketCount() > 0)
+            m_poller.wait(timeout);
+        else
+            sleep(timeout);
+    }
+
+    // Then perform all the operations that don't block
+    for (std::size_t i = 0; i < m_requests.size();)
+    {
+        if (processRequest(*m_requests[i]))
+            ++i;
+        else
+            m_requests.erase(m_requests.begin() + i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveResponse(TcpSocket& connection, bool head, Response& response, ResponseSink& sink, bool& received, bool& reusable)
+{
+    std::size_t bufferSize;
+    {
+        Lock lock(m_mutex);
+        bufferSize = std::max<std::size_t>(m_readBufferSize, 1);
+    }
+    std::vector<char> buffer(bufferSize);
+
+    ResponseReader reader(head, response, sink);
+    ResponseReader::Status status = ResponseReader::NeedMore;
+    while (status == ResponseReader::NeedMore)
+    {
+        std::size_t size = 0;
+        if (connection.receive(&buffer[0], buffer.size(), size) == Socket::Done)
+            status = reader.feed(&buffer[0], size);
+        else
+            status = reader.finish();
+    }
+
+    received = reader.hasReceived();
+    reusable = reader.isReusable();
+
+    return status == ResponseReader::Complete;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setReadBufferSize(std::size_t size)
+{
+    Lock lock(m_mutex);
+
+    m_readBufferSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::ResponseSink::onResponse(const Response&)
+{
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Http::prepareRequest(const Request& request, bool keepAlive)
 {
     // First make sure that the request is valid -- add missing mandatory fields
     Request toSend(request);
@@ -360,6 +1077,7 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     }
     if (!toSend.hasField("Host"))
     {
+        Lock lock(m_mutex);
         toSend.setField("Host", m_hostName);
     }
     if (!toSend.hasField("Content-Length"))
@@ -372,44 +1090,346 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     {
         toSend.setField("Content-Type", "application/x-www-form-urlencoded");
     }
-    if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
+    if (keepAlive && !toSend.hasField("Connection"))
+    {
+        toSend.setField("Connection", "keep-alive");
+    }
+    else if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
     {
         toSend.setField("Connection", "close");
     }
 
-    // Prepare the response
-    Response received;
+    // Convert the request to string
+    return toSend.prepare();
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress Http::resolveHost()
+{
+    std::string hostName;
+    {
+        Lock lock(m_mutex);
+        if (m_hostResolved)
+            return m_host;
+
+        hostName = m_hostName;
+    }
+
+    // Don't hold the lock while resolving, it may take a while
+    IpAddress address(hostName);
+
+    Lock lock(m_mutex);
+    if (!m_hostResolved && (hostName == m_hostName))
+    {
+        m_host         = address;
+        m_hostResolved = true;
+    }
+
+    return address;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::startRequest(const Request& request, AsyncRequest& handle, ResponseSink* sink, Time timeout)
+{
+    // A handle tracks a single request
+    handle.cancel();
+
+    AsyncRequest::State* state = new AsyncRequest::State(sink, timeout);
+    {
+        Lock lock(m_mutex);
+        state->hostName  = m_hostName;
+        state->port      = m_port;
+        state->secure    = m_secure;
+        state->keepAlive = m_keepAlive;
+    }
+    state->requestStr = prepareRequest(request, state->keepAlive);
+    state->head       = (request.m_method == Request::Head);
+    state->idempotent = state->head || (request.m_method == Request::Get);
+
+    handle.m_http     = this;
+    handle.m_state    = state;
+    handle.m_response = Response();
+    handle.m_done     = false;
+    m_requests.push_back(&handle);
+
+    // Start right away, in case the request doesn't have to wait
+    // (resolved host and idle connection)
+    if (!processRequest(handle))
+        m_requests.pop_back();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::connectRequest(AsyncRequest& handle)
+{
+    AsyncRequest::State& state = *handle.m_state;
+
+    // Reuse an idle connection, if any
+    state.reused = false;
+    if (state.keepAlive && !state.retried)
+    {
+        Lock lock(m_mutex);
+        if (!m_connections.empty())
+        {
+            state.connection = m_connections.back();
+            state.reused = true;
+            m_connections.pop_back();
+        }
+    }
+
+    if (state.reused)
+    {
+        state.connection->setBlocking(false);
+        state.phase = AsyncRequest::State::Sending;
+    }
+    else
+    {
+        // Otherwise start connecting a new socket to the host
+        state.connection = state.secure ? new TlsSocket : new TcpSocket;
+        state.connection->setBlocking(false);
+
+        // The request goes with the TLS handshake if it can be replayed safely
+        if (state.secure && state.idempotent)
+            static_cast<TlsSocket*>(state.connection)->setEarlyData(state.requestStr.c_str(), state.requestStr.size());
+
+        Socket::Status status = state.connection->connect(state.host, state.port);
+        if (status == Socket::Done)
+            state.phase = state.secure ? AsyncRequest::State::Handshaking : AsyncRequest::State::Sending;
+        else if (status == Socket::NotReady)
+            state.phase = AsyncRequest::State::Connecting;
+        else
+            return false;
+    }
+
+    // Both connecting and sending wait for the socket to be writable
+    m_poller.add(*state.connection, SocketPoller::Send);
+
+    state.sent = 0;
+    delete state.reader;
+    state.reader = new ResponseReader(state.head, handle.m_response, *state.sink);
+
+    return true;
+}
+
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host, m_port, timeout) == Socket::Done)
+////////////////////////////////////////////////////////////
+bool Http::processRequest(AsyncRequest& handle)
+{
+    AsyncRequest::State& state = *handle.m_state;
+
+    // Give up if the request takes too long
+    if ((state.timeout != Time::Zero) && (state.clock.getElapsedTime() >= state.timeout))
+        return finishRequest(handle, false);
+
+    if (state.phase == AsyncRequest::State::Resolving)
     {
-        // Convert the request to string and send it through the connected socket
-        std::string requestStr = toSend.prepare();
+        // The host name is resolved asynchronously, so that we never block
+        bool resolved;
+        std::string hostName;
+        {
+            Lock lock(m_mutex);
+            resolved   = m_hostResolved;
+            state.host = m_host;
+            hostName   = m_hostName;
+        }
 
-        if (!requestStr.empty())
+        if (!resolved)
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done)
+            if (!m_resolution.isDone())
             {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
-                {
-                    receivedStr.append(buffer, buffer + size);
-                }
+                if (!m_resolution.isPending())
+                    IpAddress::resolveAsync(hostName, m_resolution);
 
-                // Build the Response object from the received data
-                received.parse(receivedStr);
+                if (!m_resolution.isDone())
+                    return true;
+            }
+
+            Lock lock(m_mutex);
+            if (!m_hostResolved)
+            {
+                m_host         = m_resolution.getAddress();
+                m_hostResolved = true;
             }
+            state.host = m_host;
         }
 
-        // Close the connection
-        m_connection.disconnect();
+        if ((state.host == IpAddress::None) || !connectRequest(handle))
+            return finishRequest(handle, false);
     }
 
-    return received;
+    if (state.phase == AsyncRequest::State::Connecting)
+    {
+        Socket::Status status = state.connection->finishConnect();
+        if (status == Socket::NotReady)
+            return true;
+
+        if (status != Socket::Done)
+            return finishRequest(handle, false);
+
+        state.phase = state.secure ? AsyncRequest::State::Handshaking : AsyncRequest::State::Sending;
+    }
+
+    if (state.phase == AsyncRequest::State::Handshaking)
+    {
+        // The handshake mostly waits for the answers of the server
+        m_poller.add(*state.connection, SocketPoller::Receive);
+
+        Socket::Status status = static_cast<TlsSocket*>(state.connection)->handshake(state.hostName);
+        if (status == Socket::NotReady)
+            return true;
+
+        if (status != Socket::Done)
+            return finishRequest(handle, false);
+
+        if (state.idempotent)
+            state.sent = state.requestStr.size();
+
+        state.phase = AsyncRequest::State::Sending;
+    }
+
+    if (state.phase == AsyncRequest::State::Sending)
+    {
+        while (state.sent < state.requestStr.size())
+        {
+            std::size_t sent = 0;
+            Socket::Status status = state.connection->send(state.requestStr.c_str() + state.sent, state.requestStr.size() - state.sent, sent);
+            state.sent += sent;
+
+            if ((status == Socket::NotReady) || (status == Socket::Partial))
+                return true;
+
+            if (status != Socket::Done)
+                return retryRequest(handle);
+        }
+
+        // The request is sent, now wait for the response
+        state.phase = AsyncRequest::State::Receiving;
+        m_poller.add(*state.connection, SocketPoller::Receive);
+    }
+
+    // Receive and parse everything that's available
+    std::size_t bufferSize;
+    {
+        Lock lock(m_mutex);
+        bufferSize = std::max<std::size_t>(m_readBufferSize, 1);
+    }
+    if (m_receiveBuffer.size() != bufferSize)
+        m_receiveBuffer.resize(bufferSize);
+
+    for (;;)
+    {
+        std::size_t size = 0;
+        Socket::Status status = state.connection->receive(&m_receiveBuffer[0], m_receiveBuffer.size(), size);
+        if (status == Socket::NotReady)
+            return true;
+
+        ResponseReader::Status result = (status == Socket::Done) ? state.reader->feed(&m_receiveBuffer[0], size) : state.reader->finish();
+        if (result == ResponseReader::Complete)
+            return finishRequest(handle, true);
+
+        if (result == ResponseReader::Failed)
+        {
+            if ((status != Socket::Done) && !state.reader->hasReceived())
+                return retryRequest(handle);
+
+            return finishRequest(handle, false);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::retryRequest(AsyncRequest& handle)
+{
+    AsyncRequest::State& state = *handle.m_state;
+
+    // Only a kept connection that the server closed in the meantime deserves a second chance
+    if (!state.reused || state.retried)
+        return finishRequest(handle, false);
+
+    m_poller.remove(*state.connection);
+    delete state.connection;
+    state.connection = NULL;
+    state.retried = true;
+
+    if (!connectRequest(handle))
+        return finishRequest(handle, false);
+
+    return processRequest(handle);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::finishRequest(AsyncRequest& handle, bool complete)
+{
+    AsyncRequest::State& state = *handle.m_state;
+
+    // Keep the connection for the next request if the server agrees
+    if (complete && state.keepAlive && state.reader->isReusable() && isPersistent(handle.m_response))
+    {
+        m_poller.remove(*state.connection);
+        state.connection->setBlocking(true);
+
+        Lock lock(m_mutex);
+        if ((m_connections.size() < m_maxConnections) && (state.host == m_host) && (state.port == m_port))
+        {
+            m_connections.push_back(state.connection);
+            state.connection = NULL;
+        }
+    }
+
+    // Move the body to the response if it wasn't streamed to a sink
+    if (complete && (state.sink == &state.bodySink))
+        handle.m_response.m_body.swap(state.body);
+
+    releaseRequest(handle);
+    handle.m_done = true;
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::releaseRequest(AsyncRequest& handle)
+{
+    AsyncRequest::State* state = handle.m_state;
+
+    if (state->connection)
+    {
+        m_poller.remove(*state->connection);
+        delete state->connection;
+    }
+
+    delete state->reader;
+    delete state;
+
+    handle.m_http  = NULL;
+    handle.m_state = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::cancelRequest(AsyncRequest& handle)
+{
+    std::vector<AsyncRequest*>::iterator it = std::find(m_requests.begin(), m_requests.end(), &handle);
+    if (it != m_requests.end())
+        m_requests.erase(it);
+
+    releaseRequest(handle);
+    handle.m_response = Response();
+    handle.m_done     = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::closeConnections()
+{
+    for (std::vector<TcpSocket*>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+        delete *it;
+
+    m_connections.clear();
 }
 
 } // namespace sf
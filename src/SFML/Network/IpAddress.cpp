@@ -28,22 +28,324 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Http.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
+#include <deque>
+#include <map>
 #include <utility>
 
 
 namespace sf
 {
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// Resolution shared by an AsyncResolution handle and the
+/// worker threads
 ////////////////////////////////////////////////////////////
+struct ResolveJob
+{
+    std::string host;     ///< Address to resolve
+    IpAddress   address;  ///< Resolved address
+    bool        done;     ///< Is the resolution finished?
+    bool        orphaned; ///< Was the handle cancelled while a worker thread was resolving?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+namespace
+{
+    // Cached resolution of a host name
+    struct CacheEntry
+    {
+        std::vector<sf::IpAddress> addresses;
+        sf::Time                   expiry;
+    };
+
+    sf::Mutex                         cacheMutex;
+    std::map<std::string, CacheEntry> cache;
+    sf::Time                          cacheLifetime = sf::seconds(60);
+    sf::Clock                         cacheClock;
+    const std::size_t                 maxCacheSize = 1024;
+
+    // Convert an address that doesn't need to be looked up, return false for host names
+    bool parseAddress(const std::string& address, sf::IpAddress& result)
+    {
+        if (address == "255.255.255.255")
+        {
+            // The broadcast address needs to be handled explicitly,
+            // because it is also the value returned by inet_addr on error
+            result = sf::IpAddress(255, 255, 255, 255);
+            return true;
+        }
+        else if (address == "0.0.0.0")
+        {
+            result = sf::IpAddress(0, 0, 0, 0);
+            return true;
+        }
+        else if (address.find(':') != std::string::npos)
+        {
+            // IPv6 address, possibly in brackets ("[2001:db8::1]")
+            std::string numeric = address;
+            if ((numeric.size() > 2) && (numeric[0] == '[') && (numeric[numeric.size() - 1] == ']'))
+                numeric = numeric.substr(1, numeric.size() - 2);
+
+            addrinfo hints;
+            std::memset(&hints, 0, sizeof(hints));
+            hints.ai_family = AF_INET6;
+            hints.ai_flags  = AI_NUMERICHOST;
+            addrinfo* info = NULL;
+            if ((getaddrinfo(numeric.c_str(), NULL, &hints, &info) != 0) || !info)
+                return false;
+
+            sf::Uint8 bytes[16];
+            std::memcpy(bytes, &reinterpret_cast<sockaddr_in6*>(info->ai_addr)->sin6_addr, sizeof(bytes));
+            freeaddrinfo(info);
+
+            result = sf::IpAddress(bytes);
+            return true;
+        }
+        else
+        {
+            // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
+            sf::Uint32 ip = inet_addr(address.c_str());
+            if (ip == INADDR_NONE)
+                return false;
+
+            result = sf::IpAddress(ntohl(ip));
+            return true;
+        }
+    }
+
+    // Look for a host name that was resolved recently
+    bool findCached(const std::string& host, std::vector<sf::IpAddress>& addresses)
+    {
+        sf::Lock lock(cacheMutex);
+
+        std::map<std::string, CacheEntry>::iterator it = cache.find(host);
+        if (it == cache.end())
+            return false;
+
+        if (it->second.expiry <= cacheClock.getElapsedTime())
+        {
+            cache.erase(it);
+            return false;
+        }
+
+        addresses = it->second.addresses;
+        return true;
+    }
+
+    // Remember the resolution of a host name
+    void storeCached(const std::string& host, const std::vector<sf::IpAddress>& addresses)
+    {
+        sf::Lock lock(cacheMutex);
+
+        if (cacheLifetime == sf::Time::Zero)
+            return;
+
+        sf::Time now = cacheClock.getElapsedTime();
+
+        // Make room by dropping the expired entries, or everything if needed
+        if (cache.size() >= maxCacheSize)
+        {
+            for (std::map<std::string, CacheEntry>::iterator it = cache.begin(); it != cache.end();)
+            {
+                if (it->second.expiry <= now)
+                    cache.erase(it++);
+                else
+                    ++it;
+            }
+
+            if (cache.size() >= maxCacheSize)
+                cache.clear();
+        }
+
+        // Failures are often temporary: retry them sooner
+        CacheEntry& entry = cache[host];
+        entry.addresses = addresses;
+        entry.expiry    = now + (!addresses.empty() ? cacheLifetime : std::min(cacheLifetime, sf::seconds(5)));
+    }
+
+    // Get all the addresses of a host name, in the order given by the system
+    std::vector<sf::IpAddress> lookup(const std::string& host)
+    {
+        std::vector<sf::IpAddress> addresses;
+        if (findCached(host, addresses))
+            return addresses;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = NULL;
+        if (getaddrinfo(host.c_str(), NULL, &hints, &result) == 0)
+        {
+            for (addrinfo* info = result; info; info = info->ai_next)
+            {
+                sf::IpAddress address;
+                if (info->ai_family == AF_INET)
+                {
+                    address = sf::IpAddress(ntohl(reinterpret_cast<sockaddr_in*>(info->ai_addr)->sin_addr.s_addr));
+                }
+                else if (info->ai_family == AF_INET6)
+                {
+                    sf::Uint8 bytes[16];
+                    std::memcpy(bytes, &reinterpret_cast<sockaddr_in6*>(info->ai_addr)->sin6_addr, sizeof(bytes));
+                    address = sf::IpAddress(bytes);
+                }
+                else
+                {
+                    continue;
+                }
+
+                if (std::find(addresses.begin(), addresses.end(), address) == addresses.end())
+                    addresses.push_back(address);
+            }
+
+            freeaddrinfo(result);
+        }
+
+        storeCached(host, addresses);
+
+        return addresses;
+    }
+
+    // Choose the address to use when only one is wanted: IPv4 if any, for compatibility
+    sf::IpAddress getPreferred(const std::vector<sf::IpAddress>& addresses)
+    {
+        for (std::vector<sf::IpAddress>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+        {
+            if (it->getFamily() == sf::IpAddress::IPv4)
+                return *it;
+        }
+
+        return addresses.empty() ? sf::IpAddress::None : addresses.front();
+    }
+
+    // Worker threads resolving the host names for AsyncResolution;
+    // they exit as soon as there's nothing left to resolve
+    struct Worker
+    {
+        sf::Thread* thread;
+        bool        running;
+    };
+
+    sf::Mutex                          resolverMutex;
+    std::deque<sf::priv::ResolveJob*>  jobs;
+    const std::size_t                  maxWorkers = 4;
+    Worker                             workers[maxWorkers];
+    bool                               shuttingDown = false;
+
+    void work(std::size_t index)
+    {
+        for (;;)
+        {
+            sf::priv::ResolveJob* job;
+            {
+                sf::Lock lock(resolverMutex);
+                if (jobs.empty() || shuttingDown)
+                {
+                    workers[index].running = false;
+                    return;
+                }
+
+                job = jobs.front();
+                jobs.pop_front();
+            }
+
+            sf::IpAddress address(job->host);
+
+            {
+                sf::Lock lock(resolverMutex);
+                if (job->orphaned)
+                {
+                    delete job;
+                }
+                else
+                {
+                    job->address = address;
+                    job->done    = true;
+                }
+            }
+        }
+    }
+
+    void startJob(sf::priv::ResolveJob* job)
+    {
+        sf::Lock lock(resolverMutex);
+
+        jobs.push_back(job);
+
+        // Start a new worker if there's room for one
+        for (std::size_t i = 0; i < maxWorkers; ++i)
+        {
+            if (!workers[i].running)
+            {
+                // A worker that isn't running has nothing left to do but returning
+                if (workers[i].thread)
+                {
+                    workers[i].thread->wait();
+                    delete workers[i].thread;
+                }
+
+                workers[i].running = true;
+                workers[i].thread  = new sf::Thread(&work, i);
+                workers[i].thread->launch();
+                break;
+            }
+        }
+    }
+
+    // Wait for the workers when the program exits
+    struct WorkersCleanup
+    {
+        ~WorkersCleanup()
+        {
+            {
+                sf::Lock lock(resolverMutex);
+                shuttingDown = true;
+            }
+
+            for (std::size_t i = 0; i < maxWorkers; ++i)
+                delete workers[i].thread;
+        }
+    };
+
+    WorkersCleanup workersCleanup;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+namespace
+{
+    const Uint8 anyV6Bytes[16]       = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    const Uint8 localHostV6Bytes[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+}
+
 const IpAddress IpAddress::None;
 const IpAddress IpAddress::Any(0, 0, 0, 0);
 const IpAddress IpAddress::LocalHost(127, 0, 0, 1);
 const IpAddress IpAddress::Broadcast(255, 255, 255, 255);
+const IpAddress IpAddress::AnyV6(anyV6Bytes);
+const IpAddress IpAddress::LocalHostV6(localHostV6Bytes);
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress() :
 m_address(0),
+m_bytes  (),
+m_family (IPv4),
 m_valid  (false)
 {
 }
@@ -52,6 +354,8 @@ m_valid  (false)
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(const std::string& address) :
 m_address(0),
+m_bytes  (),
+m_family (IPv4),
 m_valid  (false)
 {
     resolve(address);
@@ -61,6 +365,8 @@ m_valid  (false)
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(const char* address) :
 m_address(0),
+m_bytes  (),
+m_family (IPv4),
 m_valid  (false)
 {
     resolve(address);
@@ -70,6 +376,8 @@ m_valid  (false)
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(Uint8 byte0, Uint8 byte1, Uint8 byte2, Uint8 byte3) :
 m_address(htonl((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3)),
+m_bytes  (),
+m_family (IPv4),
 m_valid  (true)
 {
 }
@@ -78,25 +386,117 @@ m_valid  (true)
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(Uint32 address) :
 m_address(htonl(address)),
+m_bytes  (),
+m_family (IPv4),
+m_valid  (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::IpAddress(const Uint8 (&bytes)[16]) :
+m_address(0),
+m_bytes  (),
+m_family (IPv6),
 m_valid  (true)
 {
+    // IPv4-mapped addresses are plain IPv4 addresses
+    static const Uint8 mappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    if (std::memcmp(bytes, mappedPrefix, sizeof(mappedPrefix)) == 0)
+    {
+        std::memcpy(&m_address, bytes + 12, 4);
+        m_family = IPv4;
+    }
+    else
+    {
+        std::memcpy(m_bytes, bytes, sizeof(m_bytes));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::Family IpAddress::getFamily() const
+{
+    return m_family;
 }
 
 
 ////////////////////////////////////////////////////////////
 std::string IpAddress::toString() const
 {
-    in_addr address;
-    address.s_addr = m_address;
+    if (m_family == IPv4)
+    {
+        in_addr address;
+        address.s_addr = m_address;
+
+        return inet_ntoa(address);
+    }
+
+    // Find the longest run of zero groups, which is written "::"
+    Uint16 groups[8];
+    for (int i = 0; i < 8; ++i)
+        groups[i] = static_cast<Uint16>((m_bytes[i * 2] << 8) | m_bytes[i * 2 + 1]);
 
-    return inet_ntoa(address);
+    int zerosStart = -1;
+    int zerosLength = 1;
+    for (int i = 0; i < 8;)
+    {
+        int length = 0;
+        while ((i + length < 8) && (groups[i + length] == 0))
+            ++length;
+
+        if (length > zerosLength)
+        {
+            zerosStart  = i;
+            zerosLength = length;
+        }
+
+        i += (length > 0) ? length : 1;
+    }
+
+    std::string result;
+    char group[5];
+    for (int i = 0; i < 8; ++i)
+    {
+        if (i == zerosStart)
+        {
+            result += "::";
+            i += zerosLength - 1;
+            continue;
+        }
+
+        if (!result.empty() && (*result.rbegin() != ':'))
+            result += ':';
+
+        std::sprintf(group, "%x", groups[i]);
+        result += group;
+    }
+
+    return result;
 }
 
 
 ////////////////////////////////////////////////////////////
 Uint32 IpAddress::toInteger() const
 {
-    return ntohl(m_address);
+    return (m_family == IPv4) ? ntohl(m_address) : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::toBytes(Uint8 (&bytes)[16]) const
+{
+    if (m_family == IPv4)
+    {
+        std::memset(bytes, 0, 10);
+        bytes[10] = 0xFF;
+        bytes[11] = 0xFF;
+        std::memcpy(bytes + 12, &m_address, 4);
+    }
+    else
+    {
+        std::memcpy(bytes, m_bytes, sizeof(m_bytes));
+    }
 }
 
 
@@ -161,51 +561,178 @@ IpAddress IpAddress::getPublicAddress(Time timeout)
 
 
 ////////////////////////////////////////////////////////////
-void IpAddress::resolve(const std::string& address)
+void IpAddress::resolveAsync(const std::string& address, AsyncResolution& resolution)
 {
-    m_address = 0;
-    m_valid = false;
+    // A handle tracks a single resolution
+    resolution.cancel();
+
+    priv::ResolveJob* job = new priv::ResolveJob;
+    job->host     = address;
+    job->done     = false;
+    job->orphaned = false;
+    resolution.m_job = job;
+
+    // Don't involve a worker thread if no lookup is needed
+    std::vector<IpAddress> addresses;
+    if (parseAddress(address, job->address))
+    {
+        job->done = true;
+        return;
+    }
+    if (findCached(address, addresses))
+    {
+        job->address = getPreferred(addresses);
+        job->done    = true;
+        return;
+    }
+
+    startJob(job);
+}
 
-    if (address == "255.255.255.255")
+
+////////////////////////////////////////////////////////////
+void IpAddress::setResolverCacheLifetime(Time lifetime)
+{
+    Lock lock(cacheMutex);
+
+    cacheLifetime = lifetime;
+    if (cacheLifetime == Time::Zero)
+        cache.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::clearResolverCache()
+{
+    Lock lock(cacheMutex);
+
+    cache.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<IpAddress> IpAddress::resolveAll(const std::string& address)
+{
+    IpAddress numeric;
+    if (parseAddress(address, numeric))
+        return std::vector<IpAddress>(1, numeric);
+
+    std::vector<IpAddress> addresses = lookup(address);
+
+    // Alternate between the families, starting with the one the system prefers
+    std::vector<IpAddress> first;
+    std::vector<IpAddress> second;
+    for (std::vector<IpAddress>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
     {
-        // The broadcast address needs to be handled explicitly,
-        // because it is also the value returned by inet_addr on error
-        m_address = INADDR_BROADCAST;
-        m_valid = true;
+        if (it->getFamily() == addresses.front().getFamily())
+            first.push_back(*it);
+        else
+            second.push_back(*it);
     }
-    else if (address == "0.0.0.0")
+
+    std::vector<IpAddress> result;
+    result.reserve(addresses.size());
+    for (std::size_t i = 0; (i < first.size()) || (i < second.size()); ++i)
     {
-        m_address = INADDR_ANY;
-        m_valid = true;
+        if (i < first.size())
+            result.push_back(first[i]);
+        if (i < second.size())
+            result.push_back(second[i]);
     }
-    else
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::resolve(const std::string& address)
+{
+    IpAddress result;
+    if (!parseAddress(address, result))
     {
-        // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
-        Uint32 ip = inet_addr(address.c_str());
-        if (ip != INADDR_NONE)
+        // Not a valid address, try to convert it as a host name
+        result = getPreferred(lookup(address));
+    }
+
+    *this = result;
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::AsyncResolution::AsyncResolution() :
+m_job(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::AsyncResolution::~AsyncResolution()
+{
+    cancel();
+}
+
+
+////////////////////////////////////////////////////////////
+bool IpAddress::AsyncResolution::isDone() const
+{
+    if (!m_job)
+        return false;
+
+    Lock lock(resolverMutex);
+    return m_job->done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IpAddress::AsyncResolution::isPending() const
+{
+    if (!m_job)
+        return false;
+
+    Lock lock(resolverMutex);
+    return !m_job->done;
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress IpAddress::AsyncResolution::getAddress() const
+{
+    if (!m_job)
+        return IpAddress::None;
+
+    Lock lock(resolverMutex);
+    return m_job->done ? m_job->address : IpAddress::None;
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::AsyncResolution::cancel()
+{
+    if (!m_job)
+        return;
+
+    {
+        Lock lock(resolverMutex);
+
+        std::deque<priv::ResolveJob*>::iterator it = std::find(jobs.begin(), jobs.end(), m_job);
+        if (it != jobs.end())
         {
-            m_address = ip;
-            m_valid = true;
+            // Not started yet: just forget it
+            jobs.erase(it);
+            delete m_job;
+        }
+        else if (m_job->done)
+        {
+            delete m_job;
         }
         else
         {
-            // Not a valid address, try to convert it as a host name
-            addrinfo hints;
-            std::memset(&hints, 0, sizeof(hints));
-            hints.ai_family = AF_INET;
-            addrinfo* result = NULL;
-            if (getaddrinfo(address.c_str(), NULL, &hints, &result) == 0)
-            {
-                if (result)
-                {
-                    ip = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
-                    freeaddrinfo(result);
-                    m_address = ip;
-                    m_valid = true;
-                }
-            }
+            // A worker is resolving it, let it delete the job once it's done
+            m_job->orphaned = true;
         }
     }
+
+    m_job = NULL;
 }
 
 
@@ -226,7 +753,13 @@ bool operator !=(const IpAddress& left, const IpAddress& right)
 ////////////////////////////////////////////////////////////
 bool operator <(const IpAddress& left, const IpAddress& right)
 {
-    return std::make_pair(left.m_valid, left.m_address) < std::make_pair(right.m_valid, right.m_address);
+    if ((left.m_valid != right.m_valid) || (left.m_family != right.m_family))
+        return std::make_pair(left.m_valid, left.m_family) < std::make_pair(right.m_valid, right.m_family);
+
+    if (left.m_family == IpAddress::IPv4)
+        return left.m_address < right.m_address;
+    else
+        return std::memcmp(left.m_bytes, right.m_bytes, sizeof(left.m_bytes)) < 0;
 }
 
 
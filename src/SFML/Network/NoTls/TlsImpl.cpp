@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TlsImpl.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+TlsImpl::TlsImpl() :
+m_ssl              (NULL),
+m_transport        (),
+m_sessionKey       (),
+m_verify           (true),
+m_established      (false),
+m_earlyData        (),
+m_earlyDataSent    (0),
+m_useEarlyData     (false),
+m_earlyDataAccepted(false),
+m_writeBuffer      ()
+{
+    m_transport.handle = SocketImpl::invalidSocket();
+    m_transport.status = Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+TlsImpl::~TlsImpl()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::handshake(SocketHandle, const std::string&, unsigned short)
+{
+    err() << "TLS is not supported, SFML was built without SFML_NETWORK_TLS" << std::endl;
+    return Socket::Error;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::send(const char*, std::size_t, std::size_t& sent)
+{
+    sent = 0;
+    return Socket::Error;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::send(const char*, std::size_t, const char*, std::size_t, std::size_t& sent)
+{
+    sent = 0;
+    return Socket::Error;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::receive(char*, std::size_t, std::size_t& received)
+{
+    received = 0;
+    return Socket::Error;
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::shutdown()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::setEarlyData(const void*, std::size_t)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::setVerification(bool enabled)
+{
+    m_verify = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::isSessionResumed() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::isEarlyDataAccepted() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::hasPendingData() const
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::addCertificateAuthorities(const std::string&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::clearSessionCache()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::getStatus(int)
+{
+    return Socket::Error;
+}
+
+} // namespace priv
+
+} // namespace sf
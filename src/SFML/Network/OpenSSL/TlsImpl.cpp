@@ -0,0 +1,523 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TlsImpl.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+
+namespace
+{
+    // Define the low-level send/receive flags, which depend on the OS
+    #ifdef SFML_SYSTEM_LINUX
+        const int flags = MSG_NOSIGNAL;
+    #else
+        const int flags = 0;
+    #endif
+
+    // Maximum amount of data in a TLS record
+    const std::size_t maxRecordSize = 16384;
+
+    typedef std::map<std::string, SSL_SESSION*> SessionCache;
+
+    sf::Mutex    mutex;
+    SSL_CTX*     context    = NULL;
+    BIO_METHOD*  bioMethod  = NULL;
+    SessionCache sessions;
+
+    // Free the global state when the program exits
+    struct Cleanup
+    {
+        ~Cleanup()
+        {
+            for (SessionCache::iterator it = sessions.begin(); it != sessions.end(); ++it)
+                SSL_SESSION_free(it->second);
+
+            if (context)
+                SSL_CTX_free(context);
+
+            if (bioMethod)
+                BIO_meth_free(bioMethod);
+        }
+    };
+
+    Cleanup cleanup;
+
+    // Socket I/O for OpenSSL, so that we control the flags and the error reporting
+    int bioWrite(BIO* bio, const char* data, int size)
+    {
+        sf::priv::TlsImpl::Transport& transport = *static_cast<sf::priv::TlsImpl::Transport*>(BIO_get_data(bio));
+        BIO_clear_retry_flags(bio);
+
+        int result = static_cast<int>(::send(transport.handle, data, size, flags));
+        transport.status = (result < 0) ? sf::priv::SocketImpl::getErrorStatus() : sf::Socket::Done;
+        if (transport.status == sf::Socket::NotReady)
+            BIO_set_retry_write(bio);
+
+        return result;
+    }
+
+    int bioRead(BIO* bio, char* data, int size)
+    {
+        sf::priv::TlsImpl::Transport& transport = *static_cast<sf::priv::TlsImpl::Transport*>(BIO_get_data(bio));
+        BIO_clear_retry_flags(bio);
+
+        int result = static_cast<int>(recv(transport.handle, data, size, flags));
+        if (result < 0)
+            transport.status = sf::priv::SocketImpl::getErrorStatus();
+        else
+            transport.status = (result == 0) ? sf::Socket::Disconnected : sf::Socket::Done;
+
+        if (transport.status == sf::Socket::NotReady)
+            BIO_set_retry_read(bio);
+
+        return result;
+    }
+
+    long bioControl(BIO*, int command, long, void*)
+    {
+        return (command == BIO_CTRL_FLUSH) ? 1 : 0;
+    }
+
+    // Keep the sessions sent by the servers, to resume them later
+    int onNewSession(SSL* ssl, SSL_SESSION* session)
+    {
+        const std::string& key = *static_cast<const std::string*>(SSL_get_app_data(ssl));
+        if (key.empty() || !SSL_SESSION_is_resumable(session))
+            return 0;
+
+        sf::Lock lock(mutex);
+
+        SSL_SESSION*& entry = sessions[key];
+        if (entry)
+            SSL_SESSION_free(entry);
+        entry = session;
+
+        // We keep the reference given by OpenSSL
+        return 1;
+    }
+
+    // Get the session to resume with a host, if any
+    SSL_SESSION* takeSession(const std::string& key)
+    {
+        sf::Lock lock(mutex);
+
+        SessionCache::iterator it = sessions.find(key);
+        if (it == sessions.end())
+            return NULL;
+
+        // TLS 1.3 tickets should be used only once, the server sends new ones with each connection
+        SSL_SESSION* session = it->second;
+        if (SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION)
+            sessions.erase(it);
+        else
+            SSL_SESSION_up_ref(session);
+
+        return session;
+    }
+
+    // Get the context shared by all the sessions, creating it on first use
+    SSL_CTX* getContext()
+    {
+        sf::Lock lock(mutex);
+
+        if (!context)
+        {
+            context = SSL_CTX_new(TLS_client_method());
+            if (!context)
+            {
+                sf::err() << "Failed to create the TLS context" << std::endl;
+                return NULL;
+            }
+
+            SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION);
+            SSL_CTX_set_default_verify_paths(context);
+            SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(context, &onNewSession);
+
+            bioMethod = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "sfml socket");
+            BIO_meth_set_write(bioMethod, &bioWrite);
+            BIO_meth_set_read(bioMethod, &bioRead);
+            BIO_meth_set_ctrl(bioMethod, &bioControl);
+        }
+
+        return context;
+    }
+
+    // Log the errors of OpenSSL
+    void logErrors(const char* operation)
+    {
+        sf::err() << "TLS " << operation << " failed";
+
+        unsigned long error;
+        while ((error = ERR_get_error()) != 0)
+        {
+            char description[256];
+            ERR_error_string_n(error, description, sizeof(description));
+            sf::err() << " ; " << description;
+        }
+
+        sf::err() << std::endl;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+TlsImpl::TlsImpl() :
+m_ssl              (NULL),
+m_transport        (),
+m_sessionKey       (),
+m_verify           (true),
+m_established      (false),
+m_earlyData        (),
+m_earlyDataSent    (0),
+m_useEarlyData     (false),
+m_earlyDataAccepted(false),
+m_writeBuffer      ()
+{
+    m_transport.handle = SocketImpl::invalidSocket();
+    m_transport.status = Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+TlsImpl::~TlsImpl()
+{
+    if (m_ssl)
+        SSL_free(m_ssl);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::handshake(SocketHandle handle, const std::string& hostName, unsigned short port)
+{
+    // Start a new session, unless we're continuing a non-blocking handshake
+    if (!m_ssl || (m_transport.handle != handle))
+    {
+        shutdown();
+
+        SSL_CTX* sslContext = getContext();
+        if (!sslContext)
+            return Socket::Error;
+
+        m_ssl = SSL_new(sslContext);
+        if (!m_ssl)
+        {
+            logErrors("session creation");
+            return Socket::Error;
+        }
+
+        // Plug the session on the socket
+        m_transport.handle = handle;
+        m_transport.status = Socket::Done;
+        BIO* bio = BIO_new(bioMethod);
+        BIO_set_data(bio, &m_transport);
+        BIO_set_init(bio, 1);
+        SSL_set_bio(m_ssl, bio, bio);
+
+        // Behave like a TCP socket: partial writes, resumed from the same (possibly moved) data
+        SSL_set_mode(m_ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+        // Check the identity of the host, and tell it which one we want (unless it's an address)
+        ASN1_OCTET_STRING* address = a2i_IPADDRESS(hostName.c_str());
+        if (address)
+        {
+            ASN1_OCTET_STRING_free(address);
+            X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(m_ssl), hostName.c_str());
+        }
+        else
+        {
+            SSL_set_tlsext_host_name(m_ssl, hostName.c_str());
+            SSL_set1_host(m_ssl, hostName.c_str());
+        }
+        SSL_set_verify(m_ssl, m_verify ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, NULL);
+
+        // Resume the previous session with this host, if any
+        std::ostringstream key;
+        key << hostName << ':' << port;
+        m_sessionKey = key.str();
+        SSL_set_app_data(m_ssl, &m_sessionKey);
+
+        m_useEarlyData = false;
+        SSL_SESSION* session = takeSession(m_sessionKey);
+        if (session)
+        {
+            SSL_set_session(m_ssl, session);
+            m_useEarlyData = !m_earlyData.empty() && (SSL_SESSION_get_max_early_data(session) >= m_earlyData.size());
+            SSL_SESSION_free(session);
+        }
+
+        m_earlyDataSent     = 0;
+        m_earlyDataAccepted = false;
+    }
+
+    if (!m_established)
+    {
+        // Send the early data along with the first handshake message
+        while (m_useEarlyData && (m_earlyDataSent < m_earlyData.size()))
+        {
+            ERR_clear_error();
+            std::size_t written = 0;
+            int result = SSL_write_early_data(m_ssl, &m_earlyData[m_earlyDataSent], m_earlyData.size() - m_earlyDataSent, &written);
+            m_earlyDataSent += written;
+
+            if (result != 1)
+            {
+                Socket::Status status = getStatus(result);
+                if (status == Socket::NotReady)
+                    return status;
+
+                logErrors("early data");
+                shutdown();
+                return status;
+            }
+        }
+
+        ERR_clear_error();
+        int result = SSL_connect(m_ssl);
+        if (result != 1)
+        {
+            Socket::Status status = getStatus(result);
+            if (status == Socket::NotReady)
+                return status;
+
+            long verification = SSL_get_verify_result(m_ssl);
+            if (verification != X509_V_OK)
+                err() << "TLS handshake failed: the certificate of " << hostName << " is not trusted ("
+                      << X509_verify_cert_error_string(verification) << ")" << std::endl;
+            else
+                logErrors("handshake");
+
+            shutdown();
+            return (status == Socket::Disconnected) ? Socket::Error : status;
+        }
+
+        m_established = true;
+
+        // If the server rejected the early data, it must be sent again
+        m_earlyDataAccepted = m_useEarlyData && (SSL_get_early_data_status(m_ssl) == SSL_EARLY_DATA_ACCEPTED);
+        if (m_earlyDataAccepted)
+            m_earlyDataSent = m_earlyData.size();
+        else
+            m_earlyDataSent = 0;
+    }
+
+    // Send the early data that didn't go with the handshake
+    while (m_earlyDataSent < m_earlyData.size())
+    {
+        std::size_t sent = 0;
+        Socket::Status status = send(&m_earlyData[m_earlyDataSent], m_earlyData.size() - m_earlyDataSent, sent);
+        m_earlyDataSent += sent;
+
+        if (status != Socket::Done)
+            return status;
+    }
+
+    m_earlyData.clear();
+    m_earlyDataSent = 0;
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::send(const char* data, std::size_t size, std::size_t& sent)
+{
+    sent = 0;
+
+    if (!m_established)
+    {
+        err() << "Cannot send data over a TLS socket which is not secured (call handshake first)" << std::endl;
+        return Socket::Error;
+    }
+
+    ERR_clear_error();
+    int result = SSL_write_ex(m_ssl, data, size, &sent);
+
+    return (result == 1) ? Socket::Done : getStatus(result);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::send(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize, std::size_t& sent)
+{
+    // Join the beginning of both sequences in a single record
+    std::size_t secondPart = std::min(secondSize, maxRecordSize > firstSize ? maxRecordSize - firstSize : 0);
+    m_writeBuffer.resize(firstSize + secondPart);
+    std::copy(first, first + firstSize, m_writeBuffer.begin());
+    std::copy(second, second + secondPart, m_writeBuffer.begin() + firstSize);
+
+    return send(&m_writeBuffer[0], m_writeBuffer.size(), sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::receive(char* data, std::size_t size, std::size_t& received)
+{
+    received = 0;
+
+    if (!m_established)
+    {
+        err() << "Cannot receive data from a TLS socket which is not secured (call handshake first)" << std::endl;
+        return Socket::Error;
+    }
+
+    ERR_clear_error();
+    int result = SSL_read_ex(m_ssl, data, size, &received);
+
+    return (result == 1) ? Socket::Done : getStatus(result);
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::shutdown()
+{
+    if (!m_ssl)
+        return;
+
+    // Tell the server that we're leaving, without waiting for its answer
+    if (m_established)
+    {
+        ERR_clear_error();
+        SSL_shutdown(m_ssl);
+    }
+
+    SSL_free(m_ssl);
+    m_ssl              = NULL;
+    m_transport.handle = SocketImpl::invalidSocket();
+    m_established      = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::setEarlyData(const void* data, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    m_earlyData.assign(bytes, bytes + size);
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::setVerification(bool enabled)
+{
+    m_verify = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::isSessionResumed() const
+{
+    return m_ssl && SSL_session_reused(m_ssl);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::isEarlyDataAccepted() const
+{
+    return m_earlyDataAccepted;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::hasPendingData() const
+{
+    return m_ssl && (SSL_pending(m_ssl) > 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::isAvailable()
+{
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsImpl::addCertificateAuthorities(const std::string& filename)
+{
+    SSL_CTX* sslContext = getContext();
+    if (!sslContext)
+        return false;
+
+    ERR_clear_error();
+    if (SSL_CTX_load_verify_locations(sslContext, filename.c_str(), NULL) != 1)
+    {
+        logErrors("certificate loading");
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsImpl::clearSessionCache()
+{
+    Lock lock(mutex);
+
+    for (SessionCache::iterator it = sessions.begin(); it != sessions.end(); ++it)
+        SSL_SESSION_free(it->second);
+
+    sessions.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsImpl::getStatus(int result)
+{
+    switch (SSL_get_error(m_ssl, result))
+    {
+        case SSL_ERROR_WANT_READ:
+        case SSL_ERROR_WANT_WRITE:
+            return Socket::NotReady;
+
+        case SSL_ERROR_ZERO_RETURN:
+            return Socket::Disconnected;
+
+        case SSL_ERROR_SYSCALL:
+            return (m_transport.status != Socket::Done) ? m_transport.status : Socket::Disconnected;
+
+        default:
+            return Socket::Error;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
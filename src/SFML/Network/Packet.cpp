@@ -28,17 +28,89 @@
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/String.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cwchar>
 
 
+namespace
+{
+    // Check whether the host byte order differs from the network byte order (big endian)
+    bool isLittleEndian()
+    {
+        return htons(1) != 1;
+    }
+
+    // Copy an array of elements while reversing the order of the bytes of each of them
+    void copySwapped(char* destination, const char* source, std::size_t count, std::size_t elementSize)
+    {
+        switch (elementSize)
+        {
+            case 2:
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    sf::Uint16 value;
+                    std::memcpy(&value, source + i * 2, 2);
+                    value = static_cast<sf::Uint16>((value << 8) | (value >> 8));
+                    std::memcpy(destination + i * 2, &value, 2);
+                }
+                break;
+            }
+
+            case 4:
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    sf::Uint32 value;
+                    std::memcpy(&value, source + i * 4, 4);
+                    value = ((value & 0x000000FF) << 24) |
+                            ((value & 0x0000FF00) <<  8) |
+                            ((value & 0x00FF0000) >>  8) |
+                            ((value & 0xFF000000) >> 24);
+                    std::memcpy(destination + i * 4, &value, 4);
+                }
+                break;
+            }
+
+            case 8:
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    sf::Uint32 value[2];
+                    std::memcpy(value, source + i * 8, 8);
+                    sf::Uint32 low  = ((value[0] & 0x000000FF) << 24) | ((value[0] & 0x0000FF00) << 8) |
+                                      ((value[0] & 0x00FF0000) >>  8) | ((value[0] & 0xFF000000) >> 24);
+                    sf::Uint32 high = ((value[1] & 0x000000FF) << 24) | ((value[1] & 0x0000FF00) << 8) |
+                                      ((value[1] & 0x00FF0000) >>  8) | ((value[1] & 0xFF000000) >> 24);
+                    value[0] = high;
+                    value[1] = low;
+                    std::memcpy(destination + i * 8, value, 8);
+                }
+                break;
+            }
+
+            default:
+            {
+                std::memcpy(destination, source, count * elementSize);
+                break;
+            }
+        }
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_sendPos(0),
-m_isValid(true)
+m_heapData   (),
+m_size       (0),
+m_readPos    (0),
+m_sendPos    (0),
+m_writeBitPos(0),
+m_readBitPos (0),
+m_isValid    (true)
 {
 
 }
@@ -56,9 +128,16 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 {
     if (data && (sizeInBytes > 0))
     {
-        std::size_t start = m_data.size();
-        m_data.resize(start + sizeInBytes);
-        std::memcpy(&m_data[start], data, sizeInBytes);
+        // Grow the storage geometrically, so that a sequence of appends stays cheap
+        std::size_t end = m_size + sizeInBytes;
+        if (end > getCapacity())
+            reserve(std::max(end, 2 * getCapacity()));
+
+        std::memcpy(getBuffer() + m_size, data, sizeInBytes);
+        m_size = end;
+
+        // Byte-level data always starts on a new byte
+        m_writeBitPos = 0;
     }
 }
 
@@ -66,30 +145,72 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 ////////////////////////////////////////////////////////////
 void Packet::clear()
 {
-    m_data.clear();
-    m_readPos = 0;
-    m_isValid = true;
+    m_size        = 0;
+    m_readPos     = 0;
+    m_writeBitPos = 0;
+    m_readBitPos  = 0;
+    m_isValid     = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t sizeInBytes)
+{
+    if (sizeInBytes <= getCapacity())
+        return;
+
+    // Move the data out of the inline buffer the first time it overflows
+    if (m_heapData.empty())
+    {
+        m_heapData.resize(sizeInBytes);
+        if (m_size > 0)
+            std::memcpy(&m_heapData[0], m_inlineData, m_size);
+    }
+    else
+    {
+        m_heapData.resize(sizeInBytes);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
-    return !m_data.empty() ? &m_data[0] : NULL;
+    return (m_size > 0) ? getBuffer() : NULL;
 }
 
 
 ////////////////////////////////////////////////////////////
 std::size_t Packet::getDataSize() const
 {
-    return m_data.size();
+    return m_size;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Packet::endOfPacket() const
 {
-    return m_readPos >= m_data.size();
+    // The unused bits of a partly read last byte are padding
+    std::size_t readBytes = m_readPos + (m_readBitPos > 0 ? 1 : 0);
+
+    return readBytes >= m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::swap(Packet& right)
+{
+    // Only the bytes used by the packets stored inline have to be exchanged
+    std::size_t inlineSize = std::max(m_heapData.empty() ? m_size : 0, right.m_heapData.empty() ? right.m_size : 0);
+    std::swap_ranges(m_inlineData, m_inlineData + inlineSize, right.m_inlineData);
+
+    m_heapData.swap(right.m_heapData);
+    std::swap(m_size,        right.m_size);
+    std::swap(m_readPos,     right.m_readPos);
+    std::swap(m_sendPos,     right.m_sendPos);
+    std::swap(m_writeBitPos, right.m_writeBitPos);
+    std::swap(m_readBitPos,  right.m_readBitPos);
+    std::swap(m_isValid,     right.m_isValid);
 }
 
 
@@ -116,7 +237,7 @@ Packet& Packet::operator >>(Int8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const Int8*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const Int8*>(getBuffer() + m_readPos);
         m_readPos += sizeof(data);
     }
 
@@ -129,7 +250,7 @@ Packet& Packet::operator >>(Uint8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const Uint8*>(getBuffer() + m_readPos);
         m_readPos += sizeof(data);
     }
 
@@ -142,7 +263,7 @@ Packet& Packet::operator >>(Int16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohs(*reinterpret_cast<const Int16*>(&m_data[m_readPos]));
+        data = ntohs(*reinterpret_cast<const Int16*>(getBuffer() + m_readPos));
         m_readPos += sizeof(data);
     }
 
@@ -155,7 +276,7 @@ Packet& Packet::operator >>(Uint16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohs(*reinterpret_cast<const Uint16*>(&m_data[m_readPos]));
+        data = ntohs(*reinterpret_cast<const Uint16*>(getBuffer() + m_readPos));
         m_readPos += sizeof(data);
     }
 
@@ -168,7 +289,7 @@ Packet& Packet::operator >>(Int32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohl(*reinterpret_cast<const Int32*>(&m_data[m_readPos]));
+        data = ntohl(*reinterpret_cast<const Int32*>(getBuffer() + m_readPos));
         m_readPos += sizeof(data);
     }
 
@@ -181,7 +302,7 @@ Packet& Packet::operator >>(Uint32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohl(*reinterpret_cast<const Uint32*>(&m_data[m_readPos]));
+        data = ntohl(*reinterpret_cast<const Uint32*>(getBuffer() + m_readPos));
         m_readPos += sizeof(data);
     }
 
@@ -196,7 +317,7 @@ Packet& Packet::operator >>(Int64& data)
     {
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
-        const Uint8* bytes = reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(getBuffer() + m_readPos);
         data = (static_cast<Int64>(bytes[0]) << 56) |
                (static_cast<Int64>(bytes[1]) << 48) |
                (static_cast<Int64>(bytes[2]) << 40) |
@@ -219,7 +340,7 @@ Packet& Packet::operator >>(Uint64& data)
     {
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
-        const Uint8* bytes = reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(getBuffer() + m_readPos);
         data = (static_cast<Uint64>(bytes[0]) << 56) |
                (static_cast<Uint64>(bytes[1]) << 48) |
                (static_cast<Uint64>(bytes[2]) << 40) |
@@ -240,7 +361,7 @@ Packet& Packet::operator >>(float& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const float*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const float*>(getBuffer() + m_readPos);
         m_readPos += sizeof(data);
     }
 
@@ -253,7 +374,7 @@ Packet& Packet::operator >>(double& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const double*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const double*>(getBuffer() + m_readPos);
         m_readPos += sizeof(data);
     }
 
@@ -271,7 +392,7 @@ Packet& Packet::operator >>(char* data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        std::memcpy(data, &m_data[m_readPos], length);
+        std::memcpy(data, getBuffer() + m_readPos, length);
         data[length] = '\0';
 
         // Update reading position
@@ -293,7 +414,7 @@ Packet& Packet::operator >>(std::string& data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        data.assign(&m_data[m_readPos], length);
+        data.assign(getBuffer() + m_readPos, length);
 
         // Update reading position
         m_readPos += length;
@@ -359,13 +480,10 @@ Packet& Packet::operator >>(String& data)
     data.clear();
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
-        // Then extract characters
-        for (Uint32 i = 0; i < length; ++i)
-        {
-            Uint32 character = 0;
-            *this >> character;
-            data += character;
-        }
+        // Then extract all the characters at once
+        std::basic_string<Uint32> characters(length, 0);
+        readArray(&characters[0], length);
+        data = characters;
     }
 
     return *this;
@@ -559,11 +677,432 @@ Packet& Packet::operator <<(const String& data)
     Uint32 length = static_cast<Uint32>(data.getSize());
     *this << length;
 
-    // Then insert characters
+    // Then insert all the characters at once
+    if (length > 0)
+        appendArray(&*data.begin(), length);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int8* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint8* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int16* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint16* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int32* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint32* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Int64* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const Uint64* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const float* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendArray(const double* data, std::size_t count)
+{
+    appendElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int8* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint8* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int16* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint16* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int32* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint32* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int64* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint64* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(float* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(double* data, std::size_t count)
+{
+    readElements(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendUtf8(const String& data)
+{
+    std::basic_string<Uint8> utf8 = data.toUtf8();
+
+    // First insert the encoded length, in bytes
+    Uint32 length = static_cast<Uint32>(utf8.size());
+    *this << length;
+
+    // Then insert the encoded characters
     if (length > 0)
+        append(utf8.data(), length);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readUtf8(String& data)
+{
+    // First extract the encoded length, in bytes
+    Uint32 length = 0;
+    *this >> length;
+
+    data.clear();
+    if ((length > 0) && checkSize(length))
+    {
+        // Then decode the characters
+        const Uint8* begin = reinterpret_cast<const Uint8*>(getBuffer() + m_readPos);
+        data = String::fromUtf8(begin, begin + length);
+        m_readPos += length;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readUtf8(std::wstring& data)
+{
+    String string;
+    readUtf8(string);
+    data = string.toWideString();
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readStringView(StringView& data)
+{
+    // First extract the length, in bytes
+    Uint32 length = 0;
+    *this >> length;
+
+    data.data = NULL;
+    data.length = 0;
+    if ((length > 0) && checkSize(length))
+    {
+        // Then point to the characters, they stay in the packet
+        data.data = getBuffer() + m_readPos;
+        data.length = length;
+        m_readPos += length;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendBits(Uint32 value, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 32u);
+    if (bitCount < 32)
+        value &= (1u << bitCount) - 1;
+
+    while (bitCount > 0)
+    {
+        // Start a new byte if the last one is full
+        if (m_writeBitPos == 0)
+        {
+            if (m_size + 1 > getCapacity())
+                reserve(std::max(m_size + 1, 2 * getCapacity()));
+
+            getBuffer()[m_size++] = 0;
+        }
+
+        // Fill the free bits of the last byte
+        unsigned int count = std::min(8 - m_writeBitPos, bitCount);
+        Uint8& byte = reinterpret_cast<Uint8&>(getBuffer()[m_size - 1]);
+        byte = static_cast<Uint8>(byte | ((value & ((1u << count) - 1)) << m_writeBitPos));
+
+        value >>= count;
+        bitCount -= count;
+        m_writeBitPos = (m_writeBitPos + count) % 8;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readBits(Uint32& value, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 32u);
+
+    // Check that enough bits remain
+    std::size_t available = (m_readPos < m_size) ? (m_size - m_readPos) * 8 - m_readBitPos : 0;
+    m_isValid = m_isValid && (bitCount <= available);
+    if (!m_isValid)
+        return *this;
+
+    Uint32 result = 0;
+    unsigned int shift = 0;
+    while (bitCount > 0)
+    {
+        unsigned int count = std::min(8 - m_readBitPos, bitCount);
+        Uint32 byte = reinterpret_cast<const Uint8&>(getBuffer()[m_readPos]);
+        result |= ((byte >> m_readBitPos) & ((1u << count) - 1)) << shift;
+
+        shift += count;
+        bitCount -= count;
+        m_readBitPos += count;
+        if (m_readBitPos == 8)
+        {
+            m_readBitPos = 0;
+            ++m_readPos;
+        }
+    }
+
+    value = result;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendQuantized(float value, float min, float max, unsigned int bitCount)
+{
+    bitCount = std::max(1u, std::min(bitCount, 32u));
+    double steps = (bitCount < 32) ? static_cast<double>((1u << bitCount) - 1) : 4294967295.0;
+
+    // Map the value to [0, steps]
+    double normalized = (max > min) ? (static_cast<double>(value) - min) / (static_cast<double>(max) - min) : 0.0;
+    normalized = std::max(0.0, std::min(normalized, 1.0));
+
+    return appendBits(static_cast<Uint32>(normalized * steps + 0.5), bitCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readQuantized(float& value, float min, float max, unsigned int bitCount)
+{
+    bitCount = std::max(1u, std::min(bitCount, 32u));
+    double steps = (bitCount < 32) ? static_cast<double>((1u << bitCount) - 1) : 4294967295.0;
+
+    Uint32 quantized = 0;
+    if (readBits(quantized, bitCount))
+        value = static_cast<float>(min + (static_cast<double>(max) - min) * (quantized / steps));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendVarint(Uint64 value)
+{
+    // Write 7 bits at a time, the 8th bit tells whether more bytes follow
+    do
+    {
+        Uint32 byte = static_cast<Uint32>(value & 0x7F);
+        value >>= 7;
+        if (value > 0)
+            byte |= 0x80;
+
+        appendBits(byte, 8);
+    }
+    while (value > 0);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarint(Uint64& value)
+{
+    Uint64 result = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        Uint32 byte = 0;
+        if (!readBits(byte, 8))
+            return *this;
+
+        result |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            value = result;
+            return *this;
+        }
+    }
+
+    // A 64-bit value never takes more than 10 bytes
+    m_isValid = false;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendSignedVarint(Int64 value)
+{
+    // Zigzag encoding: 0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...
+    Uint64 zigzag = (static_cast<Uint64>(value) << 1) ^ static_cast<Uint64>(value >> 63);
+
+    return appendVarint(zigzag);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readSignedVarint(Int64& value)
+{
+    Uint64 zigzag = 0;
+    if (readVarint(zigzag))
+        value = static_cast<Int64>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::appendDelta(const Uint32* values, const Uint32* baseline, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        bool changed = (values[i] != baseline[i]);
+        appendBits(changed ? 1 : 0, 1);
+
+        // The difference is computed modulo 2^32, so that it fits in a signed 32-bit value
+        if (changed)
+            appendSignedVarint(static_cast<Int32>(values[i] - baseline[i]));
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readDelta(Uint32* values, const Uint32* baseline, std::size_t count)
+{
+    for (std::size_t i = 0; (i < count) && m_isValid; ++i)
     {
-        for (String::ConstIterator c = data.begin(); c != data.end(); ++c)
-            *this << *c;
+        Uint32 changed = 0;
+        if (!readBits(changed, 1))
+            break;
+
+        Int64 difference = 0;
+        if (changed && !readSignedVarint(difference))
+            break;
+
+        values[i] = baseline[i] + static_cast<Uint32>(difference);
     }
 
     return *this;
@@ -573,12 +1112,84 @@ Packet& Packet::operator <<(const String& data)
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
-    m_isValid = m_isValid && (m_readPos + size <= m_data.size());
+    // Byte-level data always starts on a new byte
+    if (m_readBitPos > 0)
+    {
+        m_readBitPos = 0;
+        ++m_readPos;
+    }
+
+    m_isValid = m_isValid && (m_readPos + size <= m_size);
 
     return m_isValid;
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::appendElements(const void* data, std::size_t count, std::size_t elementSize, bool swap)
+{
+    if (data && (count > 0))
+    {
+        std::size_t size = count * elementSize;
+        std::size_t end = m_size + size;
+        if (end > getCapacity())
+            reserve(std::max(end, 2 * getCapacity()));
+
+        // Integers are sent in network byte order, like operator << does
+        if (swap && isLittleEndian())
+            copySwapped(getBuffer() + m_size, static_cast<const char*>(data), count, elementSize);
+        else
+            std::memcpy(getBuffer() + m_size, data, size);
+
+        m_size = end;
+        m_writeBitPos = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::readElements(void* data, std::size_t count, std::size_t elementSize, bool swap)
+{
+    // Reject counts that could never fit (this also prevents the size computation from overflowing)
+    if (count > m_size / elementSize)
+    {
+        m_isValid = false;
+        return;
+    }
+
+    if (data && (count > 0) && checkSize(count * elementSize))
+    {
+        if (swap && isLittleEndian())
+            copySwapped(static_cast<char*>(data), getBuffer() + m_readPos, count, elementSize);
+        else
+            std::memcpy(data, getBuffer() + m_readPos, count * elementSize);
+
+        m_readPos += count * elementSize;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+char* Packet::getBuffer()
+{
+    return m_heapData.empty() ? m_inlineData : &m_heapData[0];
+}
+
+
+////////////////////////////////////////////////////////////
+const char* Packet::getBuffer() const
+{
+    return m_heapData.empty() ? m_inlineData : &m_heapData[0];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Packet::getCapacity() const
+{
+    return m_heapData.empty() ? static_cast<std::size_t>(InlineCapacity) : m_heapData.size();
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool(std::size_t maxCount) :
+m_packets (),
+m_maxCount(maxCount),
+m_mutex   ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::~PacketPool()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+Packet* PacketPool::acquire()
+{
+    {
+        Lock lock(m_mutex);
+
+        if (!m_packets.empty())
+        {
+            Packet* packet = m_packets.back();
+            m_packets.pop_back();
+            return packet;
+        }
+    }
+
+    // The pool is empty: create a new packet outside of the lock
+    return new Packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::release(Packet* packet)
+{
+    if (!packet)
+        return;
+
+    packet->clear();
+
+    {
+        Lock lock(m_mutex);
+
+        if (m_packets.size() < m_maxCount)
+        {
+            m_packets.push_back(packet);
+            return;
+        }
+    }
+
+    // The pool is full
+    delete packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::preallocate(std::size_t count, std::size_t sizeInBytes)
+{
+    Lock lock(m_mutex);
+
+    // Never keep more packets than the pool allows
+    count = std::min(count, m_maxCount);
+    m_packets.reserve(m_maxCount);
+
+    while (m_packets.size() < count)
+    {
+        Packet* packet = new Packet;
+        packet->reserve(sizeInBytes);
+        m_packets.push_back(packet);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::clear()
+{
+    Lock lock(m_mutex);
+
+    for (std::vector<Packet*>::iterator it = m_packets.begin(); it != m_packets.end(); ++it)
+        delete *it;
+
+    m_packets.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketPool::getCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_packets.size();
+}
+
+} // namespace sf
@@ -27,18 +27,86 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Atomic.hpp>
 #include <SFML/System/Err.hpp>
 
 
+namespace
+{
+    // Names of the socket options, for error messages
+    const char* optionNames[sf::Socket::OptionCount] =
+    {
+        "SO_SNDBUF",
+        "SO_RCVBUF",
+        "SO_REUSEPORT",
+        "TCP_NODELAY",
+        "TCP_QUICKACK",
+        "TCP_CORK",
+        "SO_BUSY_POLL",
+        "IP_TOS",
+        "IP_MULTICAST_TTL",
+        "IP_MULTICAST_LOOP"
+    };
+
+    // Tell whether a socket option only applies to TCP sockets
+    bool isTcpOption(sf::Socket::Option option)
+    {
+        return (option == sf::Socket::NoDelay) || (option == sf::Socket::QuickAck) || (option == sf::Socket::Cork);
+    }
+
+    // Tell whether a socket option only applies to UDP sockets
+    bool isUdpOption(sf::Socket::Option option)
+    {
+        return (option == sf::Socket::MulticastTtl) || (option == sf::Socket::MulticastLoopback);
+    }
+
+    // Counters of all the sockets of the program, updated atomically as sockets can live in any thread
+    struct GlobalStatistics
+    {
+        sf::Atomic<sf::Uint64> sendCalls;
+        sf::Atomic<sf::Uint64> receiveCalls;
+        sf::Atomic<sf::Uint64> bytesSent;
+        sf::Atomic<sf::Uint64> bytesReceived;
+        sf::Atomic<sf::Uint64> partialSends;
+        sf::Atomic<sf::Uint64> notReady;
+        sf::Atomic<sf::Uint64> selectorWaits;
+        sf::Atomic<sf::Int64>  selectorTime;
+    };
+
+    GlobalStatistics globalStatistics;
+}
+
+
 namespace sf
 {
+////////////////////////////////////////////////////////////
+Socket::Statistics::Statistics() :
+sendCalls    (0),
+receiveCalls (0),
+bytesSent    (0),
+bytesReceived(0),
+partialSends (0),
+notReady     (0),
+selectorWaits(0),
+selectorTime (Time::Zero)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Socket(Type type) :
 m_type      (type),
 m_socket    (priv::SocketImpl::invalidSocket()),
-m_isBlocking(true)
+m_isBlocking(true),
+m_family    (IpAddress::IPv4),
+m_statistics()
 {
+    for (int i = 0; i < OptionCount; ++i)
+        m_options[i] = -1;
 
+    // Disable the Nagle algorithm by default (i.e. removes buffering of TCP packets)
+    if (type == Tcp)
+        m_options[NoDelay] = 1;
 }
 
 
@@ -68,6 +136,98 @@ bool Socket::isBlocking() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Socket::setOption(Option option, int value)
+{
+    // Ignore the options that don't apply to this socket
+    if ((option < 0) || (option >= OptionCount) || !priv::SocketImpl::isOptionSupported(option))
+        return false;
+
+    if (((m_type != Tcp) && isTcpOption(option)) || ((m_type != Udp) && isUdpOption(option)))
+        return false;
+
+    m_options[option] = value;
+
+    // Apply if the socket is already created
+    if (m_socket != priv::SocketImpl::invalidSocket())
+    {
+        if (!priv::SocketImpl::setOption(m_socket, m_family, option, value))
+        {
+            err() << "Failed to set socket option \"" << optionNames[option] << "\"" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+int Socket::getOption(Option option) const
+{
+    if ((option < 0) || (option >= OptionCount) || !priv::SocketImpl::isOptionSupported(option))
+        return -1;
+
+    if (((m_type != Tcp) && isTcpOption(option)) || ((m_type != Udp) && isUdpOption(option)))
+        return -1;
+
+    // Read the actual value from the system if the socket is already created
+    int value = m_options[option];
+    if (m_socket != priv::SocketImpl::invalidSocket())
+    {
+        if (!priv::SocketImpl::getOption(m_socket, m_family, option, value))
+            return -1;
+    }
+
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+const Socket::Statistics& Socket::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Statistics Socket::getGlobalStatistics()
+{
+    Statistics statistics;
+    statistics.sendCalls     = globalStatistics.sendCalls.load(Memory::Relaxed);
+    statistics.receiveCalls  = globalStatistics.receiveCalls.load(Memory::Relaxed);
+    statistics.bytesSent     = globalStatistics.bytesSent.load(Memory::Relaxed);
+    statistics.bytesReceived = globalStatistics.bytesReceived.load(Memory::Relaxed);
+    statistics.partialSends  = globalStatistics.partialSends.load(Memory::Relaxed);
+    statistics.notReady      = globalStatistics.notReady.load(Memory::Relaxed);
+    statistics.selectorWaits = globalStatistics.selectorWaits.load(Memory::Relaxed);
+    statistics.selectorTime  = microseconds(globalStatistics.selectorTime.load(Memory::Relaxed));
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetGlobalStatistics()
+{
+    globalStatistics.sendCalls.store(0, Memory::Relaxed);
+    globalStatistics.receiveCalls.store(0, Memory::Relaxed);
+    globalStatistics.bytesSent.store(0, Memory::Relaxed);
+    globalStatistics.bytesReceived.store(0, Memory::Relaxed);
+    globalStatistics.partialSends.store(0, Memory::Relaxed);
+    globalStatistics.notReady.store(0, Memory::Relaxed);
+    globalStatistics.selectorWaits.store(0, Memory::Relaxed);
+    globalStatistics.selectorTime.store(0, Memory::Relaxed);
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle Socket::getHandle() const
 {
@@ -76,12 +236,40 @@ SocketHandle Socket::getHandle() const
 
 
 ////////////////////////////////////////////////////////////
-void Socket::create()
+IpAddress::Family Socket::getFamily() const
+{
+    return m_family;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::create(IpAddress::Family family)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
     {
-        SocketHandle handle = socket(PF_INET, m_type == Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+        int type = (m_type == Tcp) ? SOCK_STREAM : SOCK_DGRAM;
+        SocketHandle handle = priv::SocketImpl::invalidSocket();
+
+        if (family == IpAddress::IPv6)
+        {
+            handle = socket(PF_INET6, type, 0);
+            if (handle != priv::SocketImpl::invalidSocket())
+            {
+                // Accept IPv4 as well, through IPv4-mapped addresses
+                int no = 0;
+                if (setsockopt(handle, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&no), sizeof(no)) == -1)
+                    err() << "Failed to set socket option \"IPV6_V6ONLY\" ; the socket won't accept IPv4" << std::endl;
+            }
+            else
+            {
+                // No IPv6 on this system
+                family = IpAddress::IPv4;
+            }
+        }
+
+        if (handle == priv::SocketImpl::invalidSocket())
+            handle = socket(PF_INET, type, 0);
 
         if (handle == priv::SocketImpl::invalidSocket())
         {
@@ -89,6 +277,7 @@ void Socket::create()
             return;
         }
 
+        m_family = family;
         create(handle);
     }
 }
@@ -103,21 +292,27 @@ void Socket::create(SocketHandle handle)
         // Assign the new handle
         m_socket = handle;
 
+        // Get the family of the socket (bound sockets only, others are set by create(family))
+        sockaddr_storage address;
+        priv::SocketImpl::AddrLength size = sizeof(address);
+        if (getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &size) != -1)
+            m_family = (address.ss_family == AF_INET6) ? IpAddress::IPv6 : IpAddress::IPv4;
+
         // Set the current blocking state
         setBlocking(m_isBlocking);
 
-        if (m_type == Tcp)
+        // Apply the options that were set before the socket was created
+        for (int i = 0; i < OptionCount; ++i)
         {
-            // Disable the Nagle algorithm (i.e. removes buffering of TCP packets)
-            int yes = 1;
-            if (setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
-            {
-                err() << "Failed to set socket option \"TCP_NODELAY\" ; "
-                      << "all your TCP packets will be buffered" << std::endl;
-            }
+            if ((m_options[i] != -1) && !priv::SocketImpl::setOption(m_socket, m_family, static_cast<Option>(i), m_options[i]))
+                err() << "Failed to set socket option \"" << optionNames[i] << "\"" << std::endl;
+        }
 
+        if (m_type == Tcp)
+        {
             // On Mac OS X, disable the SIGPIPE signal on disconnection
             #ifdef SFML_SYSTEM_MACOS
+                int yes = 1;
                 if (setsockopt(m_socket, SOL_SOCKET, SO_NOSIGPIPE, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
                 {
                     err() << "Failed to set socket option \"SO_NOSIGPIPE\"" << std::endl;
@@ -148,4 +343,52 @@ void Socket::close()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Socket::recordSend(Status status, std::size_t size)
+{
+    m_statistics.sendCalls++;
+    m_statistics.bytesSent += size;
+    globalStatistics.sendCalls.fetchAdd(1, Memory::Relaxed);
+    globalStatistics.bytesSent.fetchAdd(size, Memory::Relaxed);
+
+    if (status == NotReady)
+    {
+        m_statistics.notReady++;
+        globalStatistics.notReady.fetchAdd(1, Memory::Relaxed);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordReceive(Status status, std::size_t size)
+{
+    m_statistics.receiveCalls++;
+    m_statistics.bytesReceived += size;
+    globalStatistics.receiveCalls.fetchAdd(1, Memory::Relaxed);
+    globalStatistics.bytesReceived.fetchAdd(size, Memory::Relaxed);
+
+    if (status == NotReady)
+    {
+        m_statistics.notReady++;
+        globalStatistics.notReady.fetchAdd(1, Memory::Relaxed);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordPartialSend()
+{
+    m_statistics.partialSends++;
+    globalStatistics.partialSends.fetchAdd(1, Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordWait(Time duration)
+{
+    globalStatistics.selectorWaits.fetchAdd(1, Memory::Relaxed);
+    globalStatistics.selectorTime.fetchAdd(duration.asMicroseconds(), Memory::Relaxed);
+}
+
 } // namespace sf
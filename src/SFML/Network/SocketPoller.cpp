@@ -0,0 +1,475 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SocketPoller.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <map>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #define SFML_SOCKETPOLLER_EPOLL
+    #include <sys/epoll.h>
+#elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS) || defined(SFML_SYSTEM_FREEBSD) || defined(SFML_SYSTEM_OPENBSD)
+    #define SFML_SOCKETPOLLER_KQUEUE
+    #include <sys/event.h>
+    #include <sys/time.h>
+#elif !defined(SFML_SYSTEM_WINDOWS)
+    #include <poll.h>
+#endif
+
+
+namespace
+{
+    // Maximum number of events retrieved from the system at once; the
+    // remaining ones are level-triggered and returned by the next wait
+    const std::size_t maxEventCount = 4096;
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    // WSAPoll and its types are only declared when targeting Vista or later,
+    // while the socket implementation targets XP: declare and load them here
+    struct PollFd
+    {
+        SOCKET fd;
+        SHORT  events;
+        SHORT  revents;
+    };
+
+    const SHORT pollIn  = 0x0100; // POLLRDNORM
+    const SHORT pollOut = 0x0010; // POLLWRNORM
+    const SHORT pollErr = 0x0001 | 0x0002 | 0x0004; // POLLERR | POLLHUP | POLLNVAL
+
+    typedef int (WSAAPI* PollFunc)(PollFd*, ULONG, INT);
+
+    int pollSockets(PollFd* fds, std::size_t count, int timeout)
+    {
+        static PollFunc function = reinterpret_cast<PollFunc>(GetProcAddress(GetModuleHandleA("ws2_32.dll"), "WSAPoll"));
+        if (!function)
+        {
+            sf::err() << "Failed to wait on sockets: WSAPoll requires Windows Vista or later" << std::endl;
+            return -1;
+        }
+
+        return function(fds, static_cast<ULONG>(count), timeout);
+    }
+
+#elif !defined(SFML_SOCKETPOLLER_EPOLL) && !defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    typedef pollfd PollFd;
+
+    const short pollIn  = POLLIN;
+    const short pollOut = POLLOUT;
+    const short pollErr = POLLERR | POLLHUP | POLLNVAL;
+
+    int pollSockets(PollFd* fds, std::size_t count, int timeout)
+    {
+        return poll(fds, static_cast<nfds_t>(count), timeout);
+    }
+
+#endif
+
+    // Convert a timeout to milliseconds, rounding up so that short timeouts don't spin
+    int toMilliseconds(sf::Time timeout)
+    {
+        if (timeout == sf::Time::Zero)
+            return -1;
+
+        return static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SocketPoller::SocketPollerImpl
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Socket registered in the poller
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Registration
+    {
+        SocketHandle handle; ///< Handle of the socket when it was added
+        unsigned int events; ///< Events waited for
+        std::size_t  index;  ///< Index in the poll descriptors, for the poll backend
+    };
+
+    typedef std::map<Socket*, Registration> RegistrationMap;
+
+    RegistrationMap registered; ///< Sockets of the poller
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    int                      queue;  ///< epoll descriptor
+    std::vector<epoll_event> events; ///< Events returned by the last wait
+
+#elif defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    int                        queue;  ///< kqueue descriptor
+    std::vector<struct kevent> events; ///< Events returned by the last wait
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add or remove a filter of a socket
+    ///
+    ////////////////////////////////////////////////////////////
+    bool change(SocketHandle handle, short filter, unsigned short flags, Socket* socket)
+    {
+        struct kevent event;
+        EV_SET(&event, handle, filter, flags, 0, 0, socket);
+        return kevent(queue, &event, 1, NULL, 0, NULL) != -1;
+    }
+
+#else
+
+    std::vector<PollFd>  fds;     ///< Descriptors given to poll, one per socket
+    std::vector<Socket*> sockets; ///< Sockets matching the descriptors
+
+#endif
+};
+
+
+////////////////////////////////////////////////////////////
+SocketPoller::SocketPoller() :
+m_impl (new SocketPollerImpl),
+m_ready()
+{
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    m_impl->queue = epoll_create(1);
+    if (m_impl->queue == -1)
+        err() << "Failed to create the socket poller: epoll_create failed (errno " << errno << ")" << std::endl;
+
+#elif defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    m_impl->queue = kqueue();
+    if (m_impl->queue == -1)
+        err() << "Failed to create the socket poller: kqueue failed (errno " << errno << ")" << std::endl;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+SocketPoller::~SocketPoller()
+{
+#if defined(SFML_SOCKETPOLLER_EPOLL) || defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    if (m_impl->queue != -1)
+        ::close(m_impl->queue);
+
+#endif
+
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketPoller::add(Socket& socket, unsigned int events)
+{
+    SocketHandle handle = socket.getHandle();
+    if (handle == priv::SocketImpl::invalidSocket())
+        return false;
+
+    events &= Receive | Send;
+
+    // A socket reconnected since it was added has a new handle: register it again
+    SocketPollerImpl::RegistrationMap::iterator it = m_impl->registered.find(&socket);
+    if ((it != m_impl->registered.end()) && (it->second.handle != handle))
+    {
+        remove(socket);
+        it = m_impl->registered.end();
+    }
+
+    bool existing = it != m_impl->registered.end();
+
+    SocketPollerImpl::Registration registration;
+    registration.handle = handle;
+    registration.events = events;
+    registration.index = existing ? it->second.index : 0;
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    epoll_event event;
+    event.events = 0;
+    if (events & Receive)
+        event.events |= EPOLLIN;
+    if (events & Send)
+        event.events |= EPOLLOUT;
+    event.data.ptr = &socket;
+
+    // The descriptor may have been closed and reused without being removed
+    int result = epoll_ctl(m_impl->queue, existing ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, handle, &event);
+    if ((result == -1) && existing && (errno == ENOENT))
+        result = epoll_ctl(m_impl->queue, EPOLL_CTL_ADD, handle, &event);
+    if ((result == -1) && !existing && (errno == EEXIST))
+        result = epoll_ctl(m_impl->queue, EPOLL_CTL_MOD, handle, &event);
+
+    if (result == -1)
+    {
+        err() << "Failed to add socket to the poller (errno " << errno << ")" << std::endl;
+        return false;
+    }
+
+#elif defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    unsigned int previous = existing ? it->second.events : 0;
+
+    if (((events & Receive) && !m_impl->change(handle, EVFILT_READ, EV_ADD, &socket)) ||
+        ((events & Send) && !m_impl->change(handle, EVFILT_WRITE, EV_ADD, &socket)))
+    {
+        err() << "Failed to add socket to the poller (errno " << errno << ")" << std::endl;
+        return false;
+    }
+
+    // Disable the filters that are not wanted anymore
+    if ((previous & Receive) && !(events & Receive))
+        m_impl->change(handle, EVFILT_READ, EV_DELETE, &socket);
+    if ((previous & Send) && !(events & Send))
+        m_impl->change(handle, EVFILT_WRITE, EV_DELETE, &socket);
+
+#else
+
+    if (!existing)
+    {
+        registration.index = m_impl->fds.size();
+        m_impl->fds.push_back(PollFd());
+        m_impl->sockets.push_back(&socket);
+    }
+
+    PollFd& fd = m_impl->fds[registration.index];
+    fd.fd = handle;
+    fd.events = static_cast<short>(((events & Receive) ? pollIn : 0) | ((events & Send) ? pollOut : 0));
+    fd.revents = 0;
+
+#endif
+
+    m_impl->registered[&socket] = registration;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketPoller::remove(Socket& socket)
+{
+    SocketPollerImpl::RegistrationMap::iterator it = m_impl->registered.find(&socket);
+    if (it == m_impl->registered.end())
+        return;
+
+    const SocketPollerImpl::Registration& registration = it->second;
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    // Errors are expected if the socket was already closed
+    epoll_event event = epoll_event();
+    epoll_ctl(m_impl->queue, EPOLL_CTL_DEL, registration.handle, &event);
+
+#elif defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    if (registration.events & Receive)
+        m_impl->change(registration.handle, EVFILT_READ, EV_DELETE, &socket);
+    if (registration.events & Send)
+        m_impl->change(registration.handle, EVFILT_WRITE, EV_DELETE, &socket);
+
+#else
+
+    // Move the last descriptor in place of the removed one
+    std::size_t index = registration.index;
+    std::size_t last = m_impl->fds.size() - 1;
+    if (index != last)
+    {
+        m_impl->fds[index] = m_impl->fds[last];
+        m_impl->sockets[index] = m_impl->sockets[last];
+        m_impl->registered[m_impl->sockets[index]].index = index;
+    }
+
+    m_impl->fds.pop_back();
+    m_impl->sockets.pop_back();
+
+#endif
+
+    m_impl->registered.erase(it);
+
+    // Don't report the removed socket anymore
+    for (std::size_t i = m_ready.size(); i > 0; --i)
+    {
+        if (m_ready[i - 1].socket == &socket)
+            m_ready.erase(m_ready.begin() + static_cast<std::ptrdiff_t>(i - 1));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketPoller::clear()
+{
+    while (!m_impl->registered.empty())
+        remove(*m_impl->registered.begin()->first);
+
+    m_ready.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketPoller::getSocketCount() const
+{
+    return m_impl->registered.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketPoller::wait(Time timeout)
+{
+    SFML_PROFILE_SCOPE("SocketPoller::wait");
+
+    m_ready.clear();
+
+    // Without sockets, there is nothing that could end an infinite wait
+    if (m_impl->registered.empty())
+    {
+        if (timeout != Time::Zero)
+            sleep(timeout);
+
+        return 0;
+    }
+
+    // Measure the time spent blocked in the system, for the global socket statistics
+    Clock clock;
+
+#if defined(SFML_SOCKETPOLLER_EPOLL)
+
+    m_impl->events.resize(std::min(m_impl->registered.size(), maxEventCount));
+
+    int count = epoll_wait(m_impl->queue, &m_impl->events[0], static_cast<int>(m_impl->events.size()), toMilliseconds(timeout));
+    Socket::recordWait(clock.getElapsedTime());
+
+    for (int i = 0; i < count; ++i)
+    {
+        const epoll_event& event = m_impl->events[i];
+
+        ReadySocket ready;
+        ready.socket = static_cast<Socket*>(event.data.ptr);
+        ready.events = ((event.events & EPOLLIN) ? Receive : 0) | ((event.events & EPOLLOUT) ? Send : 0);
+
+        // Errors are reported through the next operation on the socket
+        if (event.events & (EPOLLERR | EPOLLHUP))
+            ready.events |= m_impl->registered[ready.socket].events;
+
+        m_ready.push_back(ready);
+    }
+
+#elif defined(SFML_SOCKETPOLLER_KQUEUE)
+
+    m_impl->events.resize(std::min(m_impl->registered.size() * 2, maxEventCount));
+
+    timespec time;
+    time.tv_sec  = static_cast<time_t>(timeout.asMicroseconds() / 1000000);
+    time.tv_nsec = static_cast<long>(timeout.asMicroseconds() % 1000000) * 1000;
+
+    int count = kevent(m_impl->queue, NULL, 0, &m_impl->events[0], static_cast<int>(m_impl->events.size()), timeout != Time::Zero ? &time : NULL);
+    Socket::recordWait(clock.getElapsedTime());
+
+    // Each filter is reported separately, merge the events of each socket
+    std::map<Socket*, unsigned int> events;
+    for (int i = 0; i < count; ++i)
+    {
+        const struct kevent& event = m_impl->events[i];
+        Socket* socket = static_cast<Socket*>(event.udata);
+
+        unsigned int& socketEvents = events[socket];
+        socketEvents |= (event.filter == EVFILT_READ) ? Receive : Send;
+
+        // Errors are reported through the next operation on the socket
+        if (event.flags & (EV_EOF | EV_ERROR))
+            socketEvents |= m_impl->registered[socket].events;
+    }
+
+    for (std::map<Socket*, unsigned int>::const_iterator it = events.begin(); it != events.end(); ++it)
+    {
+        ReadySocket ready;
+        ready.socket = it->first;
+        ready.events = it->second;
+        m_ready.push_back(ready);
+    }
+
+#else
+
+    int count = pollSockets(&m_impl->fds[0], m_impl->fds.size(), toMilliseconds(timeout));
+    Socket::recordWait(clock.getElapsedTime());
+
+    // poll reports the ready sockets in place, all of them have to be checked
+    for (std::size_t i = 0; (i < m_impl->fds.size()) && (count > 0); ++i)
+    {
+        const PollFd& fd = m_impl->fds[i];
+        if (fd.revents == 0)
+            continue;
+
+        ReadySocket ready;
+        ready.socket = m_impl->sockets[i];
+        ready.events = ((fd.revents & pollIn) ? Receive : 0) | ((fd.revents & pollOut) ? Send : 0);
+
+        // Errors are reported through the next operation on the socket
+        if (fd.revents & pollErr)
+            ready.events |= m_impl->registered[ready.socket].events;
+
+        m_ready.push_back(ready);
+    }
+
+#endif
+
+    return m_ready.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SocketPoller::getReadyCount() const
+{
+    return m_ready.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket& SocketPoller::getReadySocket(std::size_t index) const
+{
+    return *m_ready[index].socket;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SocketPoller::getReadyEvents(std::size_t index) const
+{
+    return m_ready[index].events;
+}
+
+} // namespace sf
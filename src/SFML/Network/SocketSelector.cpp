@@ -28,7 +28,9 @@
 #include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <algorithm>
 #include <utility>
 
@@ -42,10 +44,12 @@ namespace sf
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
-    fd_set allSockets;   ///< Set containing all the sockets handles
-    fd_set socketsReady; ///< Set containing handles of the sockets that are ready
-    int    maxSocket;    ///< Maximum socket handle
-    int    socketCount;  ///< Number of socket handles
+    fd_set       allSockets;   ///< Set containing all the sockets handles
+    fd_set       socketsReady; ///< Set containing handles of the sockets that are ready
+    int          maxSocket;    ///< Maximum socket handle
+    int          socketCount;  ///< Number of socket handles
+    SocketHandle wakeUpReader; ///< Handle watched by wait, which interrupt makes readable
+    SocketHandle wakeUpWriter; ///< Handle signaled by interrupt
 };
 
 
@@ -54,6 +58,7 @@ SocketSelector::SocketSelector() :
 m_impl(new SocketSelectorImpl)
 {
     clear();
+    createWakeUp();
 }
 
 
@@ -61,13 +66,15 @@ m_impl(new SocketSelectorImpl)
 SocketSelector::SocketSelector(const SocketSelector& copy) :
 m_impl(new SocketSelectorImpl(*copy.m_impl))
 {
-
+    // The copy must be interrupted separately from the original
+    createWakeUp();
 }
 
 
 ////////////////////////////////////////////////////////////
 SocketSelector::~SocketSelector()
 {
+    priv::SocketImpl::closeWakeUp(m_impl->wakeUpReader, m_impl->wakeUpWriter);
     delete m_impl;
 }
 
@@ -81,7 +88,8 @@ void SocketSelector::add(Socket& socket)
 
 #if defined(SFML_SYSTEM_WINDOWS)
 
-        if (m_impl->socketCount >= FD_SETSIZE)
+        // One entry of the set is kept for the wake-up channel
+        if (m_impl->socketCount >= FD_SETSIZE - 1)
         {
             err() << "The socket can't be added to the selector because the "
                   << "selector is full. This is a limitation of your operating "
@@ -155,6 +163,8 @@ void SocketSelector::clear()
 ////////////////////////////////////////////////////////////
 bool SocketSelector::wait(Time timeout)
 {
+    SFML_PROFILE_SCOPE("SocketSelector::wait");
+
     // Setup the timeout
     timeval time;
     time.tv_sec  = static_cast<long>(timeout.asMicroseconds() / 1000000);
@@ -163,14 +173,46 @@ bool SocketSelector::wait(Time timeout)
     // Initialize the set that will contain the sockets that are ready
     m_impl->socketsReady = m_impl->allSockets;
 
+    // Watch the wake-up channel along with the sockets, so that interrupt can end the wait
+    SocketHandle wakeUp = m_impl->wakeUpReader;
+    int maxSocket = m_impl->maxSocket;
+    if (wakeUp != priv::SocketImpl::invalidSocket())
+    {
+        FD_SET(wakeUp, &m_impl->socketsReady);
+
+#if !defined(SFML_SYSTEM_WINDOWS)
+        maxSocket = std::max(maxSocket, wakeUp);
+#endif
+    }
+
     // Wait until one of the sockets is ready for reading, or timeout is reached
     // The first parameter is ignored on Windows
-    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    Clock clock;
+    int count = select(maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+
+    // Account for the time spent blocked in the global socket statistics
+    Socket::recordWait(clock.getElapsedTime());
+
+    // Consume the interruptions, they don't count as ready sockets
+    if ((count > 0) && (wakeUp != priv::SocketImpl::invalidSocket()) && FD_ISSET(wakeUp, &m_impl->socketsReady))
+    {
+        priv::SocketImpl::clearWakeUp(wakeUp);
+        FD_CLR(wakeUp, &m_impl->socketsReady);
+        count--;
+    }
 
     return count > 0;
 }
 
 
+////////////////////////////////////////////////////////////
+void SocketSelector::interrupt()
+{
+    if (m_impl->wakeUpWriter != priv::SocketImpl::invalidSocket())
+        priv::SocketImpl::signalWakeUp(m_impl->wakeUpWriter);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SocketSelector::isReady(Socket& socket) const
 {
@@ -202,4 +244,30 @@ SocketSelector& SocketSelector::operator =(const SocketSelector& right)
     return *this;
 }
 
+
+////////////////////////////////////////////////////////////
+void SocketSelector::createWakeUp()
+{
+    if (!priv::SocketImpl::createWakeUp(m_impl->wakeUpReader, m_impl->wakeUpWriter))
+    {
+        err() << "Failed to create the wake-up channel of the socket selector, interrupt will have no effect" << std::endl;
+        return;
+    }
+
+#if !defined(SFML_SYSTEM_WINDOWS)
+
+    // The channel is watched with the sockets, it must fit in the set as well
+    if ((m_impl->wakeUpReader >= FD_SETSIZE) || (m_impl->wakeUpWriter >= FD_SETSIZE))
+    {
+        err() << "The wake-up channel of the socket selector can't be used because its "
+              << "ID is too high. This is a limitation of your operating "
+              << "system's FD_SETSIZE setting." << std::endl;
+        priv::SocketImpl::closeWakeUp(m_impl->wakeUpReader, m_impl->wakeUpWriter);
+        m_impl->wakeUpReader = priv::SocketImpl::invalidSocket();
+        m_impl->wakeUpWriter = priv::SocketImpl::invalidSocket();
+    }
+
+#endif
+}
+
 } // namespace sf
@@ -47,11 +47,14 @@ unsigned short TcpListener::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress ip;
+            unsigned short port;
+            priv::SocketImpl::extractAddress(address, ip, port);
+            return port;
         }
     }
 
@@ -67,15 +70,16 @@ Socket::Status TcpListener::listen(unsigned short port, const IpAddress& address
     close();
 
     // Create the internal socket if it doesn't exist
-    create();
+    create(address.getFamily());
 
     // Check if the address is valid
     if ((address == IpAddress::None) || (address == IpAddress::Broadcast))
         return Error;
 
     // Bind the socket to the specified port
-    sockaddr_in addr = priv::SocketImpl::createAddress(address.toInteger(), port);
-    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1)
+    sockaddr_storage addr;
+    priv::SocketImpl::AddrLength addrSize = priv::SocketImpl::createAddress(address, port, getFamily(), addr);
+    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&addr), addrSize) == -1)
     {
         // Not likely to happen, but...
         err() << "Failed to bind listener socket to port " << port << std::endl;
@@ -112,17 +116,71 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
         return Error;
     }
 
-    // Accept a new connection
-    sockaddr_in address;
+    return acceptOne(socket);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListener::accept(TcpSocket* const* sockets, std::size_t count, std::size_t& accepted)
+{
+    accepted = 0;
+
+    // Make sure that we're listening
+    if (getHandle() == priv::SocketImpl::invalidSocket())
+    {
+        err() << "Failed to accept new connections, the socket is not listening" << std::endl;
+        return Error;
+    }
+
+    if (count == 0)
+        return Done;
+
+    // Wait for the first connection (in blocking mode)
+    Status status = acceptOne(*sockets[0]);
+    if (status != Done)
+        return status;
+
+    accepted = 1;
+
+    // Then take the other pending connections without waiting
+    bool blocking = isBlocking();
+    if (blocking)
+        priv::SocketImpl::setBlocking(getHandle(), false);
+
+    while ((accepted < count) && (acceptOne(*sockets[accepted]) == Done))
+        ++accepted;
+
+    if (blocking)
+        priv::SocketImpl::setBlocking(getHandle(), true);
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListener::acceptOne(TcpSocket& socket)
+{
+    sockaddr_storage address;
     priv::SocketImpl::AddrLength length = sizeof(address);
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Create the connection directly in the blocking mode of the target socket
+    int flags = socket.isBlocking() ? 0 : SOCK_NONBLOCK;
+    SocketHandle remote = ::accept4(getHandle(), reinterpret_cast<sockaddr*>(&address), &length, flags);
+
+#else
+
     SocketHandle remote = ::accept(getHandle(), reinterpret_cast<sockaddr*>(&address), &length);
 
+#endif
+
     // Check for errors
     if (remote == priv::SocketImpl::invalidSocket())
         return priv::SocketImpl::getErrorStatus();
 
     // Initialize the new connected socket
-    socket.close();
+    socket.disconnect();
     socket.create(remote);
 
     return Done;
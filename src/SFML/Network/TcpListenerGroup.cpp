@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TcpListenerGroup.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/SocketPoller.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct TcpListenerGroup::Worker
+{
+    enum
+    {
+        BatchSize = 16 ///< Maximum number of connections accepted per wake-up
+    };
+
+    Worker(TcpListenerGroup& owner, TcpListener& source, std::size_t workerIndex) :
+    group   (owner),
+    listener(source),
+    index   (workerIndex),
+    thread  (&Worker::run, this)
+    {
+        thread.setName("sfml-listener");
+    }
+
+    void run()
+    {
+        SocketPoller poller;
+        poller.add(listener);
+
+        // Sockets for the next connections
+        TcpSocket* sockets[BatchSize];
+        for (std::size_t i = 0; i < BatchSize; ++i)
+            sockets[i] = new TcpSocket;
+
+        while (group.isRunning())
+        {
+            // Wake up regularly to check whether the group is closed
+            if (poller.wait(milliseconds(100)) == 0)
+                continue;
+
+            // Another thread may have taken the connections first (NotReady)
+            std::size_t accepted = 0;
+            Socket::Status status = listener.accept(sockets, BatchSize, accepted);
+            if (status == Socket::Error)
+            {
+                // Don't spin if the system can't accept (e.g. too many open files)
+                sleep(milliseconds(10));
+                continue;
+            }
+
+            for (std::size_t i = 0; i < accepted; ++i)
+            {
+                group.m_handler->onConnection(sockets[i], index);
+                sockets[i] = new TcpSocket;
+            }
+        }
+
+        for (std::size_t i = 0; i < BatchSize; ++i)
+            delete sockets[i];
+    }
+
+    TcpListenerGroup& group;    ///< Group owning the worker
+    TcpListener&      listener; ///< Listener accepting the connections
+    std::size_t       index;    ///< Index of the worker in the group
+    Thread            thread;   ///< Thread running the worker
+};
+
+
+////////////////////////////////////////////////////////////
+TcpListenerGroup::TcpListenerGroup() :
+m_listeners(),
+m_workers  (),
+m_handler  (NULL),
+m_running  (false),
+m_mutex    ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TcpListenerGroup::~TcpListenerGroup()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpListenerGroup::listen(unsigned short port, std::size_t threadCount, Handler& handler, const IpAddress& address)
+{
+    // Close the group if it was already listening
+    close();
+
+    if (threadCount == 0)
+        threadCount = 1;
+
+    // Open a listener per thread on the same port, or a single one without ReusePort
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        TcpListener* listener = new TcpListener;
+        bool shared = listener->setOption(Socket::ReusePort, 1);
+        listener->setBlocking(false);
+
+        Socket::Status status = listener->listen(port, address);
+        if (status != Socket::Done)
+        {
+            delete listener;
+            close();
+            return status;
+        }
+
+        m_listeners.push_back(listener);
+
+        // The other listeners must use the port picked by the system for the first one
+        port = listener->getLocalPort();
+
+        if (!shared)
+            break;
+    }
+
+    // Start the threads
+    m_handler = &handler;
+    m_running = true;
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        Worker* worker = new Worker(*this, *m_listeners[i % m_listeners.size()], i);
+        m_workers.push_back(worker);
+        worker->thread.launch();
+    }
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpListenerGroup::close()
+{
+    // Stop the threads
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->thread.wait();
+        delete *it;
+    }
+    m_workers.clear();
+
+    // Then close the listeners
+    for (std::vector<TcpListener*>::iterator it = m_listeners.begin(); it != m_listeners.end(); ++it)
+        delete *it;
+    m_listeners.clear();
+
+    m_handler = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short TcpListenerGroup::getLocalPort() const
+{
+    return m_listeners.empty() ? 0 : m_listeners.front()->getLocalPort();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpListenerGroup::getThreadCount() const
+{
+    return m_workers.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpListenerGroup::isSharded() const
+{
+    return m_listeners.size() > 1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpListenerGroup::isRunning()
+{
+    Lock lock(m_mutex);
+    return m_running;
+}
+
+} // namespace sf
@@ -29,9 +29,16 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <algorithm>
 #include <cstring>
+#include <typeinfo>
+
+#if !defined(SFML_SYSTEM_WINDOWS)
+    #include <sys/uio.h>
+#endif
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
@@ -46,13 +53,52 @@ namespace
     #else
         const int flags = 0;
     #endif
+
+    // Send two buffers with a single call, without joining them in a new buffer
+    int sendBuffers(sf::SocketHandle handle, const char* first, std::size_t firstSize, const char* second, std::size_t secondSize)
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+
+        WSABUF buffers[2];
+        buffers[0].buf = const_cast<char*>(first);
+        buffers[0].len = static_cast<ULONG>(firstSize);
+        buffers[1].buf = const_cast<char*>(second);
+        buffers[1].len = static_cast<ULONG>(secondSize);
+
+        DWORD sent = 0;
+        if (WSASend(handle, buffers, 2, &sent, 0, NULL, NULL) == SOCKET_ERROR)
+            return -1;
+
+        return static_cast<int>(sent);
+
+    #else
+
+        iovec buffers[2];
+        buffers[0].iov_base = const_cast<char*>(first);
+        buffers[0].iov_len  = firstSize;
+        buffers[1].iov_base = const_cast<char*>(second);
+        buffers[1].iov_len  = secondSize;
+
+        msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov    = buffers;
+        message.msg_iovlen = 2;
+
+        return static_cast<int>(sendmsg(handle, &message, flags));
+
+    #endif
+    }
 }
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket             (Tcp),
+m_pendingPacket    (),
+m_receiveBuffer    (),
+m_receiveBufferSize(0),
+m_receiveBufferPos (0)
 {
 
 }
@@ -64,11 +110,14 @@ unsigned short TcpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress ip;
+            unsigned short port;
+            priv::SocketImpl::extractAddress(address, ip, port);
+            return port;
         }
     }
 
@@ -83,11 +132,14 @@ IpAddress TcpSocket::getRemoteAddress() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return IpAddress(ntohl(address.sin_addr.s_addr));
+            IpAddress ip;
+            unsigned short port;
+            priv::SocketImpl::extractAddress(address, ip, port);
+            return ip;
         }
     }
 
@@ -102,11 +154,14 @@ unsigned short TcpSocket::getRemotePort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress ip;
+            unsigned short port;
+            priv::SocketImpl::extractAddress(address, ip, port);
+            return port;
         }
     }
 
@@ -122,17 +177,18 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
     disconnect();
 
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress.getFamily());
 
     // Create the remote address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(remoteAddress, remotePort, getFamily(), address);
 
     if (timeout <= Time::Zero)
     {
         // ----- We're not using a timeout: just try to connect -----
 
         // Connect the socket
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), addressSize) == -1)
             return priv::SocketImpl::getErrorStatus();
 
         // Connection succeeded
@@ -150,7 +206,7 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
             setBlocking(false);
 
         // Try to connect to the remote address
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) >= 0)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), addressSize) >= 0)
         {
             // We got instantly connected! (it may no happen a lot...)
             setBlocking(blocking);
@@ -208,14 +264,191 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::connect(const std::string& remoteHost, unsigned short remotePort, Time timeout)
+{
+    std::vector<IpAddress> addresses = IpAddress::resolveAll(remoteHost);
+    if (addresses.empty())
+    {
+        disconnect();
+        return Error;
+    }
+
+    // Nothing to race
+    if ((addresses.size() == 1) || !isBlocking())
+        return connect(addresses.front(), remotePort, timeout);
+
+    // Disconnect the socket if it is already connected
+    disconnect();
+
+    // Start a connection attempt to each address in turn, 250 ms apart (or as soon as
+    // the previous attempts failed), and keep the first one that succeeds
+    const Time attemptDelay = milliseconds(250);
+    std::vector<SocketHandle> attempts;
+    std::size_t next = 0;
+    Time nextAttempt = Time::Zero;
+    SocketHandle connected = priv::SocketImpl::invalidSocket();
+    Status status = Error;
+    Clock clock;
+
+    while (connected == priv::SocketImpl::invalidSocket())
+    {
+        Time now = clock.getElapsedTime();
+        if ((timeout > Time::Zero) && (now >= timeout))
+            break;
+
+        if ((next < addresses.size()) && (attempts.empty() || (now >= nextAttempt)))
+        {
+            const IpAddress& address = addresses[next++];
+            nextAttempt = now + attemptDelay;
+
+            SocketHandle handle = socket((address.getFamily() == IpAddress::IPv6) ? PF_INET6 : PF_INET, SOCK_STREAM, 0);
+            if (handle == priv::SocketImpl::invalidSocket())
+                continue;
+
+            priv::SocketImpl::setBlocking(handle, false);
+
+            // Apply the options now, the buffer sizes must be known before connecting to be effective
+            for (int i = 0; i < OptionCount; ++i)
+            {
+                int value = getOption(static_cast<Option>(i));
+                if (value != -1)
+                    priv::SocketImpl::setOption(handle, address.getFamily(), static_cast<Option>(i), value);
+            }
+
+            sockaddr_storage remote;
+            priv::SocketImpl::AddrLength remoteSize = priv::SocketImpl::createAddress(address, remotePort, address.getFamily(), remote);
+            if (::connect(handle, reinterpret_cast<sockaddr*>(&remote), remoteSize) >= 0)
+            {
+                connected = handle;
+                break;
+            }
+
+            status = priv::SocketImpl::getErrorStatus();
+            if (status == NotReady)
+                attempts.push_back(handle);
+            else
+                priv::SocketImpl::close(handle);
+
+            continue;
+        }
+
+        // All the addresses failed
+        if (attempts.empty())
+            break;
+
+        // Wait until an attempt is over, or it's time to start the next one
+        Time wait = Time::Zero;
+        if (next < addresses.size())
+            wait = nextAttempt - now;
+        if ((timeout > Time::Zero) && ((wait == Time::Zero) || (timeout - now < wait)))
+            wait = timeout - now;
+
+        fd_set writable;
+        fd_set failed;
+        FD_ZERO(&writable);
+        FD_ZERO(&failed);
+        SocketHandle maxHandle = 0;
+        for (std::vector<SocketHandle>::const_iterator it = attempts.begin(); it != attempts.end(); ++it)
+        {
+            FD_SET(*it, &writable);
+            FD_SET(*it, &failed);
+            maxHandle = std::max(maxHandle, *it);
+        }
+
+        timeval time;
+        time.tv_sec  = static_cast<long>(wait.asMicroseconds() / 1000000);
+        time.tv_usec = static_cast<long>(wait.asMicroseconds() % 1000000);
+
+        if (select(static_cast<int>(maxHandle + 1), NULL, &writable, &failed, (wait != Time::Zero) ? &time : NULL) <= 0)
+            continue;
+
+        // Keep the first attempt that succeeded, drop the ones that failed
+        for (std::size_t i = attempts.size(); i-- > 0;)
+        {
+            if (!FD_ISSET(attempts[i], &writable) && !FD_ISSET(attempts[i], &failed))
+                continue;
+
+            int error = 0;
+            priv::SocketImpl::AddrLength size = sizeof(error);
+            if (getsockopt(attempts[i], SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size) == -1)
+                error = -1;
+
+            if ((error == 0) && (connected == priv::SocketImpl::invalidSocket()))
+            {
+                connected = attempts[i];
+                attempts.erase(attempts.begin() + i);
+            }
+            else if (error != 0)
+            {
+                status = (error == -1) ? Error : priv::SocketImpl::getErrorStatus(error);
+                priv::SocketImpl::close(attempts[i]);
+                attempts.erase(attempts.begin() + i);
+            }
+        }
+    }
+
+    // Abort the attempts that lost the race
+    for (std::vector<SocketHandle>::const_iterator it = attempts.begin(); it != attempts.end(); ++it)
+        priv::SocketImpl::close(*it);
+
+    if (connected == priv::SocketImpl::invalidSocket())
+        return (status == NotReady) ? Error : status;
+
+    // Adopt the winner, create() restores the blocking mode
+    create(connected);
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::connect(const char* remoteHost, unsigned short remotePort, Time timeout)
+{
+    return connect(std::string(remoteHost), remotePort, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::finishConnect()
+{
+    if (getHandle() == priv::SocketImpl::invalidSocket())
+        return Disconnected;
+
+    // A peer address means that the connection is established
+    if (getRemoteAddress() != IpAddress::None)
+        return Done;
+
+    // Otherwise, either the connection is still in progress or it failed
+    int error = 0;
+    priv::SocketImpl::AddrLength size = sizeof(error);
+    if (getsockopt(getHandle(), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &size) == -1)
+        return priv::SocketImpl::getErrorStatus();
+
+    if (error == 0)
+        return NotReady;
+
+    Status status = priv::SocketImpl::getErrorStatus(error);
+    return (status == NotReady) ? Error : status;
+}
+
+
 ////////////////////////////////////////////////////////////
 void TcpSocket::disconnect()
 {
+    // Let derived classes end their session first
+    if (getHandle() != priv::SocketImpl::invalidSocket())
+        onDisconnect();
+
     // Close the socket
     close();
 
     // Reset the pending packet data
     m_pendingPacket = PendingPacket();
+
+    // Drop the bytes that were buffered from the previous connection
+    m_receiveBuffer.clear();
+    m_receiveBufferPos = 0;
 }
 
 
@@ -242,19 +475,20 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t&
     }
 
     // Loop until every byte has been sent
-    int result = 0;
-    for (sent = 0; sent < size; sent += result)
+    std::size_t written = 0;
+    for (sent = 0; sent < size; sent += written)
     {
         // Send a chunk of data
-        result = ::send(getHandle(), static_cast<const char*>(data) + sent, size - sent, flags);
+        Status status = writeData(static_cast<const char*>(data) + sent, size - sent, written);
 
         // Check for errors
-        if (result < 0)
+        if (status != Done)
         {
-            Status status = priv::SocketImpl::getErrorStatus();
-
             if ((status == NotReady) && sent)
+            {
+                recordPartialSend();
                 return Partial;
+            }
 
             return status;
         }
@@ -277,79 +511,90 @@ Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& rec
         return Error;
     }
 
-    // Receive a chunk of bytes
-    int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
-
-    // Check the number of bytes received
-    if (sizeReceived > 0)
+    // Deliver the bytes left in the packet buffer first, to preserve the stream order
+    if (m_receiveBufferPos < m_receiveBuffer.size())
     {
-        received = static_cast<std::size_t>(sizeReceived);
+        received = std::min(size, m_receiveBuffer.size() - m_receiveBufferPos);
+        std::memcpy(data, &m_receiveBuffer[m_receiveBufferPos], received);
+        m_receiveBufferPos += received;
         return Done;
     }
-    else if (sizeReceived == 0)
-    {
-        return Socket::Disconnected;
-    }
-    else
-    {
-        return priv::SocketImpl::getErrorStatus();
-    }
+
+    // Receive a chunk of bytes
+    return readData(static_cast<char*>(data), size, received);
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(Packet& packet)
 {
+    SFML_PROFILE_SCOPE("TcpSocket::send");
+
     // TCP is a stream protocol, it doesn't preserve messages boundaries.
     // This means that we have to send the packet size first, so that the
     // receiver knows the actual end of the packet in the data stream.
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
+    // The size is sent together with the data in a single gathering call,
+    // so that no intermediate block has to be allocated and filled. The
+    // position reached by a partial send is recorded in the packet, so that
+    // the next call resumes exactly where the stream stopped.
 
     // Get the data to send from the packet
     std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    const char* data = static_cast<const char*>(packet.onSend(size));
 
     // First convert the packet size to network byte order
     Uint32 packetSize = htonl(static_cast<Uint32>(size));
+    const char* header = reinterpret_cast<const char*>(&packetSize);
+    const std::size_t headerSize = sizeof(packetSize);
+    const std::size_t totalSize = headerSize + size;
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
+    // Loop until every byte has been sent
+    std::size_t sent = 0;
+    while (packet.m_sendPos < totalSize)
+    {
+        std::size_t position = packet.m_sendPos;
 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+        // Send the rest of the header along with the data, or the rest of the data
+        std::size_t written = 0;
+        Status status;
+        if (position < headerSize)
+            status = writeData(header + position, headerSize - position, data, size, written);
+        else
+            status = writeData(data + (position - headerSize), totalSize - position, written);
 
-    // Send the data block
-    std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
+        // Check for errors
+        if (status != Done)
+        {
+            if ((status == NotReady) && sent)
+            {
+                recordPartialSend();
+                return Partial;
+            }
 
-    // In the case of a partial send, record the location to resume from
-    if (status == Partial)
-    {
-        packet.m_sendPos += sent;
-    }
-    else if (status == Done)
-    {
-        packet.m_sendPos = 0;
+            return status;
+        }
+
+        // Record the location to resume from in the case of a partial send
+        packet.m_sendPos += written;
+        sent += written;
     }
 
-    return status;
+    packet.m_sendPos = 0;
+
+    return Done;
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::receive(Packet& packet)
 {
+    SFML_PROFILE_SCOPE("TcpSocket::receive");
+
     // First clear the variables to fill
     packet.clear();
 
     // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
     std::size_t received = 0;
     if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
     {
@@ -358,57 +603,208 @@ Socket::Status TcpSocket::receive(Packet& packet)
         while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
         {
             char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
+            Status status = receiveBuffered(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
             m_pendingPacket.SizeReceived += received;
 
             if (status != Done)
                 return status;
         }
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
+        // The packet size has been fully received: allocate the whole packet data at once
+        m_pendingPacket.Data.resize(ntohl(m_pendingPacket.Size));
+    }
+
+    // Loop until we receive all the packet data, directly in its final storage
+    std::size_t packetSize = m_pendingPacket.Data.size();
+    while (m_pendingPacket.DataReceived < packetSize)
+    {
+        char* data = &m_pendingPacket.Data[0] + m_pendingPacket.DataReceived;
+        Status status = receiveBuffered(data, packetSize - m_pendingPacket.DataReceived, received);
+        m_pendingPacket.DataReceived += received;
+
+        if (status != Done)
+            return status;
+    }
+
+    // We have received all the packet data: we can give it to the user packet.
+    // A plain sf::Packet simply takes the storage if the data doesn't fit in its inline
+    // buffer, custom packets get a chance to transform it
+    if ((typeid(packet) == typeid(Packet)) && (packetSize > Packet::InlineCapacity))
+    {
+        packet.m_heapData.swap(m_pendingPacket.Data);
+        packet.m_size = packetSize;
+    }
+    else if (packetSize > 0)
+        packet.onReceive(&m_pendingPacket.Data[0], packetSize);
+
+    // Clear the pending packet data, keeping the allocated storage for the next packet
+    m_pendingPacket.Size         = 0;
+    m_pendingPacket.SizeReceived = 0;
+    m_pendingPacket.DataReceived = 0;
+    m_pendingPacket.Data.clear();
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::setPacketBufferSize(std::size_t size)
+{
+    m_receiveBufferSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpSocket::getPacketBufferSize() const
+{
+    return m_receiveBufferSize;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpSocket::hasBufferedPacket() const
+{
+    std::size_t available = m_receiveBuffer.size() - m_receiveBufferPos;
+    const char* buffered = available > 0 ? &m_receiveBuffer[m_receiveBufferPos] : NULL;
+
+    // Complete the packet size with the buffered bytes, if needed
+    std::size_t sizeMissing = sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived;
+    std::size_t dataMissing = 0;
+    if (sizeMissing > 0)
+    {
+        if (available < sizeMissing)
+            return false;
+
+        Uint32 size = m_pendingPacket.Size;
+        std::memcpy(reinterpret_cast<char*>(&size) + m_pendingPacket.SizeReceived, buffered, sizeMissing);
+        available -= sizeMissing;
+        dataMissing = ntohl(size);
     }
     else
     {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
+        dataMissing = m_pendingPacket.Data.size() - m_pendingPacket.DataReceived;
     }
 
-    // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
+    return available >= dataMissing;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receiveBuffered(char* data, std::size_t size, std::size_t& received)
+{
+    received = 0;
+
+    // Without batching, or for requests larger than the buffer, read directly from the system
+    bool bufferEmpty = (m_receiveBufferPos >= m_receiveBuffer.size());
+    if (bufferEmpty && (size >= m_receiveBufferSize))
+        return receive(data, size, received);
+
+    // Refill the buffer with as many bytes as the system can give in one call
+    // (the storage is taken out of the member while receiving, so that receive doesn't see it as pending data)
+    if (bufferEmpty)
     {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
+        std::vector<char> buffer;
+        buffer.swap(m_receiveBuffer);
+        buffer.resize(m_receiveBufferSize);
+
+        std::size_t filled = 0;
+        Status status = receive(&buffer[0], buffer.size(), filled);
+        buffer.resize(filled);
+        buffer.swap(m_receiveBuffer);
+        m_receiveBufferPos = 0;
+
         if (status != Done)
             return status;
+    }
 
-        // Append it into the packet
-        if (received > 0)
-        {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
-        }
+    // Hand out the buffered bytes
+    received = std::min(size, m_receiveBuffer.size() - m_receiveBufferPos);
+    std::memcpy(data, &m_receiveBuffer[m_receiveBufferPos], received);
+    m_receiveBufferPos += received;
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::writeData(const char* data, std::size_t size, std::size_t& written)
+{
+    written = 0;
+
+    int result = ::send(getHandle(), data, static_cast<int>(size), flags);
+    if (result < 0)
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordSend(status, 0);
+        return status;
     }
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
+    written = static_cast<std::size_t>(result);
+    recordSend(Done, written);
+    return Done;
+}
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::writeData(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize, std::size_t& written)
+{
+    written = 0;
+
+    int result = sendBuffers(getHandle(), first, firstSize, second, secondSize);
+    if (result < 0)
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordSend(status, 0);
+        return status;
+    }
+
+    written = static_cast<std::size_t>(result);
+    recordSend(Done, written);
     return Done;
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::readData(char* data, std::size_t size, std::size_t& received)
+{
+    received = 0;
+
+    int sizeReceived = recv(getHandle(), data, static_cast<int>(size), flags);
+
+    // Check the number of bytes received
+    if (sizeReceived > 0)
+    {
+        received = static_cast<std::size_t>(sizeReceived);
+        recordReceive(Done, received);
+        return Done;
+    }
+    else if (sizeReceived == 0)
+    {
+        recordReceive(Disconnected, 0);
+        return Disconnected;
+    }
+    else
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordReceive(status, 0);
+        return status;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpSocket::onDisconnect()
+{
+    // Nothing to do by default
+}
+
+
 ////////////////////////////////////////////////////////////
 TcpSocket::PendingPacket::PendingPacket() :
 Size        (0),
 SizeReceived(0),
-Data        ()
+Data        (),
+DataReceived(0)
 {
 
 }
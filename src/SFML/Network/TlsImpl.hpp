@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TLSIMPL_HPP
+#define SFML_TLSIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketHandle.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+struct ssl_st;
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief TLS session of a sf::TlsSocket
+///
+/// The implementation depends on the TLS library SFML is
+/// built with; without one, all the handshakes fail.
+///
+////////////////////////////////////////////////////////////
+class TlsImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the transport, shared with the I/O callbacks
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Transport
+    {
+        SocketHandle   handle; ///< Connected socket carrying the session
+        Socket::Status status; ///< Status of the last socket operation
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TlsImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TlsImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or continue the handshake on a connected socket
+    ///
+    /// \param handle   Connected socket
+    /// \param hostName Name of the remote host, to check its certificate
+    /// \param port     Port of the remote host, to find the session to resume
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status handshake(SocketHandle handle, const std::string& hostName, unsigned short port);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encrypt and send bytes, with a single attempt
+    ///
+    /// \param data Pointer to the bytes to send
+    /// \param size Number of bytes to send
+    /// \param sent Variable to fill with the number of bytes sent
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(const char* data, std::size_t size, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encrypt and send two sequences of bytes, with a single attempt
+    ///
+    /// \param first      Pointer to the first bytes to send
+    /// \param firstSize  Number of bytes in \a first
+    /// \param second     Pointer to the bytes to send after \a first
+    /// \param secondSize Number of bytes in \a second
+    /// \param sent       Variable to fill with the number of bytes sent
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive and decrypt bytes
+    ///
+    /// \param data     Pointer to the array to fill
+    /// \param size     Maximum number of bytes to receive
+    /// \param received Variable to fill with the number of bytes received
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status receive(char* data, std::size_t size, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the remote host and end the session
+    ///
+    ////////////////////////////////////////////////////////////
+    void shutdown();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set data to send with the next handshake
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEarlyData(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the verification of the remote host
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVerification(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last handshake resumed a session
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSessionResumed() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the early data was accepted as 0-RTT data
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEarlyDataAccepted() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether decrypted bytes are waiting to be received
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasPendingData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether TLS is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Trust the certificate authorities of a PEM file
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool addCertificateAuthorities(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the sessions kept for resumption
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearSessionCache();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the result of a TLS operation to a status
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status getStatus(int result);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    ssl_st*           m_ssl;               ///< TLS session
+    Transport         m_transport;         ///< Socket carrying the session
+    std::string       m_sessionKey;        ///< Key of the session in the resumption cache
+    bool              m_verify;            ///< Must the remote host be verified?
+    bool              m_established;       ///< Is the handshake complete?
+    std::vector<char> m_earlyData;         ///< Data to send with the handshake
+    std::size_t       m_earlyDataSent;     ///< Number of bytes of early data already sent
+    bool              m_useEarlyData;      ///< Is the early data sent as 0-RTT data?
+    bool              m_earlyDataAccepted; ///< Did the server accept the early data?
+    std::vector<char> m_writeBuffer;       ///< Buffer joining the two sequences of bytes sent together
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TLSIMPL_HPP
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TlsSocket.hpp>
+#include <SFML/Network/TlsImpl.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TlsSocket::TlsSocket() :
+m_impl(new priv::TlsImpl)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TlsSocket::~TlsSocket()
+{
+    // End the session properly while the socket is still open
+    m_impl->shutdown();
+
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::connect(const std::string& hostName, unsigned short remotePort, Time timeout)
+{
+    Status status = TcpSocket::connect(hostName, remotePort, timeout);
+    if (status != Done)
+        return status;
+
+    return handshake(hostName);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::connect(const char* hostName, unsigned short remotePort, Time timeout)
+{
+    return connect(std::string(hostName), remotePort, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::handshake(const std::string& hostName)
+{
+    if (getHandle() == priv::SocketImpl::invalidSocket())
+        return Disconnected;
+
+    return m_impl->handshake(getHandle(), hostName, getRemotePort());
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsSocket::setEarlyData(const void* data, std::size_t size)
+{
+    m_impl->setEarlyData(data, size);
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsSocket::setVerification(bool enabled)
+{
+    m_impl->setVerification(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::isSessionResumed() const
+{
+    return m_impl->isSessionResumed();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::isEarlyDataAccepted() const
+{
+    return m_impl->isEarlyDataAccepted();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::hasPendingData() const
+{
+    return m_impl->hasPendingData();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::isAvailable()
+{
+    return priv::TlsImpl::isAvailable();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TlsSocket::addCertificateAuthorities(const std::string& filename)
+{
+    return priv::TlsImpl::addCertificateAuthorities(filename);
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsSocket::clearSessionCache()
+{
+    priv::TlsImpl::clearSessionCache();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::writeData(const char* data, std::size_t size, std::size_t& written)
+{
+    // The counters see the plain data, the encryption layer can make several system calls for it
+    Status status = m_impl->send(data, size, written);
+    recordSend(status, written);
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::writeData(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize, std::size_t& written)
+{
+    Status status = m_impl->send(first, firstSize, second, secondSize, written);
+    recordSend(status, written);
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TlsSocket::readData(char* data, std::size_t size, std::size_t& received)
+{
+    Status status = m_impl->receive(data, size, received);
+    recordReceive(status, received);
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void TlsSocket::onDisconnect()
+{
+    m_impl->shutdown();
+}
+
+} // namespace sf
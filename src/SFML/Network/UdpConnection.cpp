@@ -0,0 +1,628 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/UdpConnection.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Layout of the datagrams:
+    // header:  protocol id (16 bits), flags (8 bits), sequence (16 bits), ack (16 bits), ack bits (32 bits)
+    // message: channel (8 bits), id (16 bits, reliable channels only), size (16 bits), data
+    const sf::Uint16  protocolId = 0x5346;
+    const sf::Uint8   hasAckFlag = 1;
+    const std::size_t headerSize = 11;
+
+    // Number of datagrams before the most recent one that an acknowledgement covers
+    const sf::Uint16 ackWindow = 32;
+
+    // Delay after which a datagram that wasn't acknowledged is considered lost
+    const sf::Time lostDelay = sf::seconds(1.f);
+
+    // Weight of new samples in the smoothed packet loss
+    const float lossSmoothing = 0.1f;
+
+    void write16(char* buffer, sf::Uint16 value)
+    {
+        buffer[0] = static_cast<char>(value >> 8);
+        buffer[1] = static_cast<char>(value);
+    }
+
+    void write32(char* buffer, sf::Uint32 value)
+    {
+        write16(buffer, static_cast<sf::Uint16>(value >> 16));
+        write16(buffer + 2, static_cast<sf::Uint16>(value));
+    }
+
+    sf::Uint16 read16(const char* buffer)
+    {
+        return static_cast<sf::Uint16>((static_cast<sf::Uint8>(buffer[0]) << 8) | static_cast<sf::Uint8>(buffer[1]));
+    }
+
+    sf::Uint32 read32(const char* buffer)
+    {
+        return (static_cast<sf::Uint32>(read16(buffer)) << 16) | read16(buffer + 2);
+    }
+
+    // Compare sequence numbers, taking their wrapping into account
+    bool sequenceGreater(sf::Uint16 left, sf::Uint16 right)
+    {
+        return (left != right) && (static_cast<sf::Uint16>(left - right) < 32768);
+    }
+
+    // Key of a reliable message in the outgoing map
+    sf::Uint32 messageKey(sf::Uint8 channel, sf::Uint16 id)
+    {
+        return (static_cast<sf::Uint32>(channel) << 16) | id;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UdpConnection::Statistics::Statistics() :
+roundTripTime    (),
+packetLoss       (0.f),
+datagramsSent    (0),
+datagramsReceived(0),
+bytesSent        (0),
+bytesReceived    (0),
+messagesResent   (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+UdpConnection::UdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort) :
+m_socket            (socket),
+m_remoteAddress     (remoteAddress),
+m_remotePort        (remotePort),
+m_maxDatagramSize   (1200),
+m_clock             (),
+m_statistics        (),
+m_roundTripVariation(),
+m_hasRoundTripTime  (false),
+m_localSequence     (0),
+m_remoteSequence    (0),
+m_receivedBits      (0),
+m_hasReceived       (false),
+m_ackPending        (false),
+m_ackedSequence     (0),
+m_outgoing          (),
+m_unreliable        (),
+m_sentDatagrams     (),
+m_received          (),
+m_datagram          (),
+m_datagramMessages  (),
+m_receiveBuffer     ()
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        m_nextId[i] = 0;
+        m_unackedCount[i] = 0;
+        m_receiveChannels[i].nextId = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const IpAddress& UdpConnection::getRemoteAddress() const
+{
+    return m_remoteAddress;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short UdpConnection::getRemotePort() const
+{
+    return m_remotePort;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::setMaximumDatagramSize(std::size_t size)
+{
+    m_maxDatagramSize = std::min<std::size_t>(size, UdpSocket::MaxDatagramSize);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::send(Packet& packet, Channel channel)
+{
+    // Get the data to send from the packet
+    std::size_t size = 0;
+    const char* data = static_cast<const char*>(packet.onSend(size));
+
+    if (size > MaxMessageSize)
+    {
+        err() << "Cannot send a message over the connection "
+              << "(the number of bytes to send is greater than sf::UdpConnection::MaxMessageSize)" << std::endl;
+        return Socket::Error;
+    }
+
+    if (channel == Unreliable)
+    {
+        m_unreliable.push_back(std::vector<char>(data, data + size));
+        return Socket::Done;
+    }
+
+    // Don't let the identifiers of unacknowledged messages wrap around
+    std::size_t index = channel - ReliableUnordered;
+    if (m_unackedCount[index] >= 32767)
+        return Socket::NotReady;
+
+    Uint16 id = m_nextId[index]++;
+    OutgoingMessage& message = m_outgoing[messageKey(static_cast<Uint8>(channel), id)];
+    message.channel  = static_cast<Uint8>(channel);
+    message.id       = id;
+    message.lastSent = Time::Zero;
+    message.sent     = false;
+    message.data.assign(data, data + size);
+    ++m_unackedCount[index];
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpConnection::receive(Packet& packet)
+{
+    if (m_received.empty())
+        return false;
+
+    const std::vector<char>& message = m_received.front();
+
+    packet.clear();
+    if (!message.empty())
+        packet.onReceive(&message[0], message.size());
+
+    m_received.pop_front();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::update()
+{
+    Time now = m_clock.getElapsedTime();
+
+    // Datagrams that were not acknowledged for too long are lost
+    while (!m_sentDatagrams.empty() && (now - m_sentDatagrams.front().time >= lostDelay))
+    {
+        m_statistics.packetLoss += (1.f - m_statistics.packetLoss) * lossSmoothing;
+        m_sentDatagrams.pop_front();
+    }
+
+    Socket::Status status = Socket::Done;
+
+    // Unreliable messages are sent once, whatever happens
+    for (; !m_unreliable.empty(); m_unreliable.pop_front())
+    {
+        Socket::Status result = appendMessage(Unreliable, 0, m_unreliable.front(), now);
+        if (status == Socket::Done)
+            status = result;
+    }
+
+    // Reliable messages are sent until they are acknowledged
+    Time timeout = getResendTimeout();
+    for (std::map<Uint32, OutgoingMessage>::iterator it = m_outgoing.begin(); it != m_outgoing.end(); ++it)
+    {
+        OutgoingMessage& message = it->second;
+        if (message.sent && (now - message.lastSent < timeout))
+            continue;
+
+        // Don't start more datagrams than a single acknowledgement can cover, the others wait for the next update
+        std::size_t messageSize = 5 + message.data.size();
+        bool newDatagram = (m_datagram.size() <= headerSize) || (m_datagram.size() + messageSize > m_maxDatagramSize);
+        std::size_t inFlight = m_sentDatagrams.size() + ((m_datagram.size() > headerSize) ? 1 : 0);
+        if (newDatagram && (inFlight >= ackWindow))
+            break;
+
+        if (message.sent)
+            ++m_statistics.messagesResent;
+
+        message.sent     = true;
+        message.lastSent = now;
+
+        Socket::Status result = appendMessage(message.channel, message.id, message.data, now);
+        if (status == Socket::Done)
+            status = result;
+
+        m_datagramMessages.push_back(it->first);
+    }
+
+    // Send the last datagram, or a bare acknowledgement if needed
+    Socket::Status result = flushDatagram(now);
+    if (status == Socket::Done)
+        status = result;
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::poll()
+{
+    // Nothing to read if the socket was not used yet
+    if (m_socket.getLocalPort() == 0)
+        return Socket::Done;
+
+    if (m_receiveBuffer.empty())
+        m_receiveBuffer.resize(UdpSocket::MaxDatagramSize);
+
+    bool blocking = m_socket.isBlocking();
+    if (blocking)
+        m_socket.setBlocking(false);
+
+    Socket::Status status;
+    for (;;)
+    {
+        std::size_t    received = 0;
+        IpAddress      remoteAddress;
+        unsigned short remotePort = 0;
+        status = m_socket.receive(&m_receiveBuffer[0], m_receiveBuffer.size(), received, remoteAddress, remotePort);
+        if (status != Socket::Done)
+            break;
+
+        if ((remoteAddress == m_remoteAddress) && (remotePort == m_remotePort))
+            handleDatagram(&m_receiveBuffer[0], received);
+    }
+
+    if (blocking)
+        m_socket.setBlocking(true);
+
+    return (status == Socket::NotReady) ? Socket::Done : status;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpConnection::handleDatagram(const void* data, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+
+    // Check the header
+    if ((size < headerSize) || (read16(bytes) != protocolId))
+        return false;
+
+    Uint8  flags    = static_cast<Uint8>(bytes[2]);
+    Uint16 sequence = read16(bytes + 3);
+    Uint16 ack      = read16(bytes + 5);
+    Uint32 ackBits  = read32(bytes + 7);
+
+    // Check the messages before using any of them
+    for (std::size_t offset = headerSize; offset < size;)
+    {
+        Uint8 channel = static_cast<Uint8>(bytes[offset]);
+        if (channel > ReliableOrdered)
+            return false;
+
+        std::size_t messageHeaderSize = (channel == Unreliable) ? 3 : 5;
+        if (size - offset < messageHeaderSize)
+            return false;
+
+        std::size_t length = read16(bytes + offset + messageHeaderSize - 2);
+        if (size - offset - messageHeaderSize < length)
+            return false;
+
+        offset += messageHeaderSize + length;
+    }
+
+    ++m_statistics.datagramsReceived;
+    m_statistics.bytesReceived += size;
+
+    // Record the sequence number, to acknowledge it and to detect duplicates
+    bool duplicate = false;
+    bool outdated  = false;
+    if (!m_hasReceived)
+    {
+        m_remoteSequence = sequence;
+        m_receivedBits   = 0;
+        m_hasReceived    = true;
+        m_ackedSequence  = static_cast<Uint16>(sequence - 1);
+    }
+    else if (sequenceGreater(sequence, m_remoteSequence))
+    {
+        Uint16 shift = static_cast<Uint16>(sequence - m_remoteSequence);
+        if (shift < 32)
+            m_receivedBits = (m_receivedBits << shift) | (1u << (shift - 1));
+        else
+            m_receivedBits = (shift == 32) ? (1u << 31) : 0;
+        m_remoteSequence = sequence;
+    }
+    else
+    {
+        Uint16 distance = static_cast<Uint16>(m_remoteSequence - sequence);
+        if (distance == 0)
+        {
+            duplicate = true;
+        }
+        else if (distance <= 32)
+        {
+            Uint32 bit = 1u << (distance - 1);
+            duplicate = (m_receivedBits & bit) != 0;
+            m_receivedBits |= bit;
+        }
+        else
+        {
+            // Too old to be acknowledged, only its reliable messages still matter
+            outdated = true;
+        }
+    }
+
+    if (flags & hasAckFlag)
+        processAcks(ack, ackBits, m_clock.getElapsedTime());
+
+    if (duplicate)
+        return true;
+
+    if (size > headerSize)
+    {
+        m_ackPending = true;
+
+        // Acknowledge now if waiting for the next update would leave datagrams out of the window
+        if (static_cast<Uint16>(m_remoteSequence - m_ackedSequence) >= ackWindow)
+            flushDatagram(m_clock.getElapsedTime());
+    }
+
+    // Deliver the messages
+    for (std::size_t offset = headerSize; offset < size;)
+    {
+        Uint8 channel = static_cast<Uint8>(bytes[offset]);
+        Uint16 id = (channel == Unreliable) ? 0 : read16(bytes + offset + 1);
+
+        std::size_t messageHeaderSize = (channel == Unreliable) ? 3 : 5;
+        std::size_t length = read16(bytes + offset + messageHeaderSize - 2);
+        const char* message = bytes + offset + messageHeaderSize;
+
+        if (channel != Unreliable)
+            deliverReliable(channel, id, message, length);
+        else if (!outdated)
+            m_received.push_back(std::vector<char>(message, message + length));
+
+        offset += messageHeaderSize + length;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const UdpConnection::Statistics& UdpConnection::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::appendMessage(Uint8 channel, Uint16 id, const std::vector<char>& data, Time now)
+{
+    std::size_t messageSize = ((channel == Unreliable) ? 3 : 5) + data.size();
+
+    // Send the current datagram first if the message doesn't fit in it
+    Socket::Status status = Socket::Done;
+    if ((m_datagram.size() > headerSize) && (m_datagram.size() + messageSize > m_maxDatagramSize))
+        status = flushDatagram(now);
+
+    if (m_datagram.empty())
+        m_datagram.resize(headerSize);
+
+    std::size_t offset = m_datagram.size();
+    m_datagram.resize(offset + messageSize);
+
+    char* buffer = &m_datagram[offset];
+    *buffer++ = static_cast<char>(channel);
+    if (channel != Unreliable)
+    {
+        write16(buffer, id);
+        buffer += 2;
+    }
+    write16(buffer, static_cast<Uint16>(data.size()));
+    if (!data.empty())
+        std::copy(data.begin(), data.end(), buffer + 2);
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpConnection::flushDatagram(Time now)
+{
+    // Nothing to send, not even an acknowledgement
+    if (m_datagram.empty())
+    {
+        if (!m_ackPending)
+            return Socket::Done;
+
+        m_datagram.resize(headerSize);
+    }
+
+    write16(&m_datagram[0], protocolId);
+    m_datagram[2] = static_cast<char>(m_hasReceived ? hasAckFlag : 0);
+    write16(&m_datagram[3], m_localSequence);
+    write16(&m_datagram[5], m_remoteSequence);
+    write32(&m_datagram[7], m_receivedBits);
+
+    Socket::Status status = m_socket.send(&m_datagram[0], m_datagram.size(), m_remoteAddress, m_remotePort);
+    if (status == Socket::Done)
+    {
+        ++m_statistics.datagramsSent;
+        m_statistics.bytesSent += m_datagram.size();
+        m_ackPending = false;
+        m_ackedSequence = m_remoteSequence;
+
+        // Only datagrams carrying messages are acknowledged by the remote peer
+        if (m_datagram.size() > headerSize)
+        {
+            m_sentDatagrams.push_back(SentDatagram());
+            SentDatagram& datagram = m_sentDatagrams.back();
+            datagram.sequence = m_localSequence;
+            datagram.time     = now;
+            datagram.messages.swap(m_datagramMessages);
+        }
+    }
+
+    ++m_localSequence;
+    m_datagram.clear();
+    m_datagramMessages.clear();
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::processAcks(Uint16 ack, Uint32 ackBits, Time now)
+{
+    for (std::deque<SentDatagram>::iterator it = m_sentDatagrams.begin(); it != m_sentDatagrams.end();)
+    {
+        Uint16 distance = static_cast<Uint16>(ack - it->sequence);
+
+        // Datagrams sent after the acknowledged one are still in flight
+        if (distance >= 32768)
+        {
+            ++it;
+            continue;
+        }
+
+        bool acked = (distance == 0) || ((distance <= 32) && (ackBits & (1u << (distance - 1))));
+        if (acked)
+        {
+            // The most recent datagram gives a sample of the round-trip time (RFC 6298)
+            if (distance == 0)
+            {
+                Time sample = now - it->time;
+                if (!m_hasRoundTripTime)
+                {
+                    m_statistics.roundTripTime = sample;
+                    m_roundTripVariation       = sample / 2.f;
+                    m_hasRoundTripTime         = true;
+                }
+                else
+                {
+                    Time difference = m_statistics.roundTripTime - sample;
+                    if (difference < Time::Zero)
+                        difference = -difference;
+
+                    m_roundTripVariation       = m_roundTripVariation * 0.75f + difference * 0.25f;
+                    m_statistics.roundTripTime = m_statistics.roundTripTime * 0.875f + sample * 0.125f;
+                }
+            }
+
+            // Its reliable messages were received
+            for (std::vector<Uint32>::const_iterator key = it->messages.begin(); key != it->messages.end(); ++key)
+            {
+                std::map<Uint32, OutgoingMessage>::iterator message = m_outgoing.find(*key);
+                if (message != m_outgoing.end())
+                {
+                    --m_unackedCount[message->second.channel - ReliableUnordered];
+                    m_outgoing.erase(message);
+                }
+            }
+
+            m_statistics.packetLoss -= m_statistics.packetLoss * lossSmoothing;
+        }
+        else if (distance > 32)
+        {
+            // The remote peer can't acknowledge it anymore: it is lost, resend its messages now
+            for (std::vector<Uint32>::const_iterator key = it->messages.begin(); key != it->messages.end(); ++key)
+            {
+                std::map<Uint32, OutgoingMessage>::iterator message = m_outgoing.find(*key);
+                if (message != m_outgoing.end())
+                    message->second.lastSent = now - getResendTimeout();
+            }
+
+            m_statistics.packetLoss += (1.f - m_statistics.packetLoss) * lossSmoothing;
+        }
+        else
+        {
+            ++it;
+            continue;
+        }
+
+        it = m_sentDatagrams.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpConnection::deliverReliable(Uint8 channel, Uint16 id, const char* data, std::size_t size)
+{
+    ReceiveChannel& receiveChannel = m_receiveChannels[channel - ReliableUnordered];
+    bool ordered = (channel == ReliableOrdered);
+
+    // Already delivered
+    Uint16 offset = static_cast<Uint16>(id - receiveChannel.nextId);
+    if ((offset >= 32768) || (receiveChannel.pending.find(id) != receiveChannel.pending.end()))
+        return;
+
+    if ((offset == 0) || !ordered)
+        m_received.push_back(std::vector<char>(data, data + size));
+
+    if (offset != 0)
+    {
+        // Keep the message (or just remember it for the unordered channel) until the missing ones arrive
+        std::vector<char>& message = receiveChannel.pending[id];
+        if (ordered)
+            message.assign(data, data + size);
+        return;
+    }
+
+    // Deliver the messages that were waiting for this one
+    ++receiveChannel.nextId;
+    for (std::map<Uint16, std::vector<char> >::iterator it = receiveChannel.pending.find(receiveChannel.nextId);
+         it != receiveChannel.pending.end();
+         it = receiveChannel.pending.find(++receiveChannel.nextId))
+    {
+        if (ordered)
+        {
+            m_received.push_back(std::vector<char>());
+            m_received.back().swap(it->second);
+        }
+
+        receiveChannel.pending.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Time UdpConnection::getResendTimeout() const
+{
+    if (!m_hasRoundTripTime)
+        return milliseconds(250);
+
+    Time timeout = m_statistics.roundTripTime + m_roundTripVariation * 4.f;
+
+    return std::max(milliseconds(20), std::min(timeout, seconds(1.f)));
+}
+
+} // namespace sf
@@ -31,14 +31,80 @@
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_LINUX)
+    #include <netinet/udp.h>
+    #include <cerrno>
+
+    // Some C libraries don't expose the UDP segmentation offload option yet
+    #ifndef UDP_SEGMENT
+        #define UDP_SEGMENT 103
+    #endif
+#endif
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
+#endif
+
+
+namespace
+{
+    // Maximum number of datagrams handed to the system in a single batched call
+    const std::size_t batchSize = 32;
+
+    // Maximum number of datagrams merged into one message by segmentation offload (UDP_MAX_SEGMENTS)
+    const std::size_t maxSegments = 64;
+
+#if !defined(SFML_SYSTEM_LINUX)
+
+    // Check, without blocking, if a datagram is waiting to be received
+    bool hasPendingDatagram(sf::SocketHandle handle)
+    {
+        fd_set selector;
+        FD_ZERO(&selector);
+        FD_SET(handle, &selector);
+
+        timeval time;
+        time.tv_sec  = 0;
+        time.tv_usec = 0;
+
+        return select(static_cast<int>(handle + 1), &selector, NULL, NULL, &time) > 0;
+    }
+
+#endif
+
+    // Tell whether an address belongs to the multicast range (224.0.0.0/4 or ff00::/8)
+    bool isMulticastAddress(const sf::IpAddress& address)
+    {
+        if (address.getFamily() == sf::IpAddress::IPv4)
+            return (address.toInteger() >> 28) == 0xE;
+
+        sf::Uint8 bytes[16];
+        address.toBytes(bytes);
+        return bytes[0] == 0xFF;
+    }
+}
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+UdpSocket::Datagram::Datagram() :
+packet       (),
+remoteAddress(),
+remotePort   (0)
+{
+
+}
+
+
 ////////////////////////////////////////////////////////////
 UdpSocket::UdpSocket() :
-Socket  (Udp),
-m_buffer(MaxDatagramSize)
+Socket               (Udp),
+m_buffer             (MaxDatagramSize),
+m_batchBuffer        (),
+m_segmentationOffload(false)
 {
 
 }
@@ -50,11 +116,14 @@ unsigned short UdpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            IpAddress ip;
+            unsigned short port;
+            priv::SocketImpl::extractAddress(address, ip, port);
+            return port;
         }
     }
 
@@ -70,15 +139,16 @@ Socket::Status UdpSocket::bind(unsigned short port, const IpAddress& address)
     close();
 
     // Create the internal socket if it doesn't exist
-    create();
+    create(address.getFamily());
 
     // Check if the address is valid
     if ((address == IpAddress::None) || (address == IpAddress::Broadcast))
         return Error;
 
     // Bind the socket
-    sockaddr_in addr = priv::SocketImpl::createAddress(address.toInteger(), port);
-    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1)
+    sockaddr_storage addr;
+    priv::SocketImpl::AddrLength addrSize = priv::SocketImpl::createAddress(address, port, getFamily(), addr);
+    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&addr), addrSize) == -1)
     {
         err() << "Failed to bind socket to port " << port << std::endl;
         return Error;
@@ -100,7 +170,7 @@ void UdpSocket::unbind()
 Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort)
 {
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress.getFamily());
 
     // Make sure that all the data will fit in one datagram
     if (size > MaxDatagramSize)
@@ -110,16 +180,29 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
         return Error;
     }
 
+    // An IPv4 socket can't reach an IPv6 peer
+    if ((remoteAddress.getFamily() == IpAddress::IPv6) && (getFamily() == IpAddress::IPv4))
+    {
+        err() << "Cannot send data to the IPv6 address " << remoteAddress << " from an IPv4 socket" << std::endl;
+        return Error;
+    }
+
     // Build the target address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength addressSize = priv::SocketImpl::createAddress(remoteAddress, remotePort, getFamily(), address);
 
     // Send the data (unlike TCP, all the data is always sent in one call)
-    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), addressSize);
 
     // Check for errors
     if (sent < 0)
-        return priv::SocketImpl::getErrorStatus();
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordSend(status, 0);
+        return status;
+    }
 
+    recordSend(Done, static_cast<std::size_t>(sent));
     return Done;
 }
 
@@ -140,7 +223,7 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
     }
 
     // Data that will be filled with the other computer's address
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+    sockaddr_storage address;
 
     // Receive a chunk of bytes
     priv::SocketImpl::AddrLength addressSize = sizeof(address);
@@ -148,12 +231,16 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
     // Check for errors
     if (sizeReceived < 0)
-        return priv::SocketImpl::getErrorStatus();
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordReceive(status, 0);
+        return status;
+    }
 
     // Fill the sender informations
     received      = static_cast<std::size_t>(sizeReceived);
-    remoteAddress = IpAddress(ntohl(address.sin_addr.s_addr));
-    remotePort    = ntohs(address.sin_port);
+    recordReceive(Done, received);
+    priv::SocketImpl::extractAddress(address, remoteAddress, remotePort);
 
     return Done;
 }
@@ -197,4 +284,310 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::sendBatch(Datagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist
+    create(count ? datagrams[0].remoteAddress.getFamily() : IpAddress::IPv4);
+
+    // Make sure that every datagram can be sent, before sending anything
+    std::vector<const void*> data(count);
+    std::vector<std::size_t> sizes(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        data[i] = datagrams[i].packet.onSend(sizes[i]);
+
+        if (sizes[i] > MaxDatagramSize)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Error;
+        }
+
+        if ((datagrams[i].remoteAddress.getFamily() == IpAddress::IPv6) && (getFamily() == IpAddress::IPv4))
+        {
+            err() << "Cannot send data to the IPv6 address " << datagrams[i].remoteAddress << " from an IPv4 socket" << std::endl;
+            return Error;
+        }
+    }
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    while (sent < count)
+    {
+        mmsghdr          messages[batchSize];
+        std::size_t      messageDatagrams[batchSize];
+        iovec            buffers[batchSize * maxSegments];
+        sockaddr_storage addresses[batchSize];
+        char             controls[batchSize][CMSG_SPACE(sizeof(Uint16))];
+
+        // Build the messages, merging runs of equally sized datagrams for the same peer if allowed
+        std::memset(messages, 0, sizeof(messages));
+        std::size_t messageCount = 0;
+        std::size_t bufferCount  = 0;
+        std::size_t next         = sent;
+        bool        segmented    = false;
+        while ((next < count) && (messageCount < batchSize))
+        {
+            const Datagram& first = datagrams[next];
+            std::size_t segmentSize = sizes[next];
+            std::size_t last = next + 1;
+
+            if (m_segmentationOffload && (segmentSize > 0))
+            {
+                std::size_t total = segmentSize;
+                while ((last < count) && (last - next < maxSegments) &&
+                       (datagrams[last].remoteAddress == first.remoteAddress) &&
+                       (datagrams[last].remotePort == first.remotePort) &&
+                       (sizes[last] > 0) && (sizes[last] <= segmentSize) &&
+                       (total + sizes[last] <= MaxDatagramSize))
+                {
+                    total += sizes[last];
+
+                    // Only the last segment may be smaller than the others
+                    if (sizes[last++] < segmentSize)
+                        break;
+                }
+            }
+
+            for (std::size_t i = next; i < last; ++i)
+            {
+                buffers[bufferCount + i - next].iov_base = const_cast<void*>(data[i]);
+                buffers[bufferCount + i - next].iov_len  = sizes[i];
+            }
+
+            msghdr& header = messages[messageCount].msg_hdr;
+            header.msg_name    = &addresses[messageCount];
+            header.msg_namelen = priv::SocketImpl::createAddress(first.remoteAddress, first.remotePort, getFamily(), addresses[messageCount]);
+            header.msg_iov     = &buffers[bufferCount];
+            header.msg_iovlen  = last - next;
+
+            // Tell the kernel how to split the merged datagrams
+            if (last - next > 1)
+            {
+                header.msg_control    = controls[messageCount];
+                header.msg_controllen = sizeof(controls[messageCount]);
+
+                cmsghdr* control = CMSG_FIRSTHDR(&header);
+                control->cmsg_level = IPPROTO_UDP;
+                control->cmsg_type  = UDP_SEGMENT;
+                control->cmsg_len   = CMSG_LEN(sizeof(Uint16));
+
+                Uint16 size = static_cast<Uint16>(segmentSize);
+                std::memcpy(CMSG_DATA(control), &size, sizeof(size));
+                segmented = true;
+            }
+
+            messageDatagrams[messageCount++] = last - next;
+            bufferCount += last - next;
+            next = last;
+        }
+
+        // Send all the messages with a single call
+        int result = sendmmsg(getHandle(), messages, static_cast<unsigned int>(messageCount), MSG_NOSIGNAL);
+
+        if (result < 0)
+        {
+            // The system doesn't support segmentation offload for this socket: fall back to regular datagrams
+            if (segmented && ((errno == EIO) || (errno == EINVAL) || (errno == ENOPROTOOPT)))
+            {
+                m_segmentationOffload = false;
+                continue;
+            }
+
+            Status status = priv::SocketImpl::getErrorStatus();
+            recordSend(status, 0);
+            if ((status == NotReady) && sent)
+            {
+                recordPartialSend();
+                return Partial;
+            }
+
+            return status;
+        }
+
+        std::size_t bytes = 0;
+        for (int i = 0; i < result; ++i)
+        {
+            sent += messageDatagrams[i];
+            bytes += messages[i].msg_len;
+        }
+
+        recordSend(Done, bytes);
+
+        // The socket buffer is full (non-blocking mode)
+        if (static_cast<std::size_t>(result) < messageCount)
+        {
+            recordPartialSend();
+            return Partial;
+        }
+    }
+
+#else
+
+    // No batched system call available: send the datagrams one after the other
+    for (; sent < count; ++sent)
+    {
+        Status status = send(data[sent], sizes[sent], datagrams[sent].remoteAddress, datagrams[sent].remotePort);
+
+        if (status != Done)
+        {
+            if ((status == NotReady) && sent)
+            {
+                recordPartialSend();
+                return Partial;
+            }
+
+            return status;
+        }
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receiveBatch(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    received = 0;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    m_batchBuffer.resize(std::min(count, batchSize) * MaxDatagramSize);
+
+    while (received < count)
+    {
+        mmsghdr          messages[batchSize];
+        iovec            buffers[batchSize];
+        sockaddr_storage addresses[batchSize];
+
+        std::size_t messageCount = std::min(count - received, batchSize);
+        std::memset(messages, 0, sizeof(messages));
+        for (std::size_t i = 0; i < messageCount; ++i)
+        {
+            buffers[i].iov_base = &m_batchBuffer[i * MaxDatagramSize];
+            buffers[i].iov_len  = MaxDatagramSize;
+
+            msghdr& header = messages[i].msg_hdr;
+            header.msg_name    = &addresses[i];
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_iov     = &buffers[i];
+            header.msg_iovlen  = 1;
+        }
+
+        // Wait for the first datagram only, then take whatever is already there
+        int result = recvmmsg(getHandle(), messages, static_cast<unsigned int>(messageCount), received ? MSG_DONTWAIT : MSG_WAITFORONE, NULL);
+
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            recordReceive(status, 0);
+            return received ? Done : status;
+        }
+
+        std::size_t bytes = 0;
+        for (int i = 0; i < result; ++i)
+        {
+            Datagram& datagram = datagrams[received++];
+            bytes += messages[i].msg_len;
+
+            datagram.packet.clear();
+            if (messages[i].msg_len > 0)
+                datagram.packet.onReceive(buffers[i].iov_base, messages[i].msg_len);
+
+            priv::SocketImpl::extractAddress(addresses[i], datagram.remoteAddress, datagram.remotePort);
+        }
+
+        recordReceive(Done, bytes);
+
+        // No more datagrams waiting
+        if (static_cast<std::size_t>(result) < messageCount)
+            break;
+    }
+
+#else
+
+    // No batched system call available: receive the datagrams one after the other,
+    // as long as there are some waiting
+    for (; received < count; ++received)
+    {
+        if (received && !hasPendingDatagram(getHandle()))
+            break;
+
+        Datagram& datagram = datagrams[received];
+        Status status = receive(datagram.packet, datagram.remoteAddress, datagram.remotePort);
+
+        if (status != Done)
+            return received ? Done : status;
+    }
+
+#endif
+
+    return received ? Done : NotReady;
+}
+
+
+////////////////////////////////////////////////////////////
+void UdpSocket::setSegmentationOffloadEnabled(bool enabled)
+{
+    m_segmentationOffload = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UdpSocket::isSegmentationOffloadEnabled() const
+{
+    return m_segmentationOffload;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::joinMulticastGroup(const IpAddress& group, unsigned int interfaceIndex)
+{
+    return setMulticastMembership(group, interfaceIndex, true);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::leaveMulticastGroup(const IpAddress& group, unsigned int interfaceIndex)
+{
+    return setMulticastMembership(group, interfaceIndex, false);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::setMulticastMembership(const IpAddress& group, unsigned int interfaceIndex, bool join)
+{
+    if (!isMulticastAddress(group))
+    {
+        err() << "Failed to " << (join ? "join" : "leave") << " multicast group " << group << " (not a multicast address)" << std::endl;
+        return Error;
+    }
+
+    // Create the internal socket if it doesn't exist
+    create(group.getFamily());
+
+    // The protocol-independent request works for both families, at the level of the group's
+    // protocol; some systems accept IPv4 groups on IPv6 sockets that accept IPv4 as well
+    group_req request;
+    std::memset(&request, 0, sizeof(request));
+    request.gr_interface = interfaceIndex;
+    priv::SocketImpl::createAddress(group, 0, group.getFamily(), request.gr_group);
+
+    int level = (group.getFamily() == IpAddress::IPv6) ? IPPROTO_IPV6 : IPPROTO_IP;
+    int name = join ? MCAST_JOIN_GROUP : MCAST_LEAVE_GROUP;
+
+    if (setsockopt(getHandle(), level, name, reinterpret_cast<const char*>(&request), sizeof(request)) == -1)
+    {
+        err() << "Failed to " << (join ? "join" : "leave") << " multicast group " << group << std::endl;
+        return priv::SocketImpl::getErrorStatus();
+    }
+
+    return Done;
+}
+
 } // namespace sf
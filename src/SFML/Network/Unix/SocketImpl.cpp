@@ -29,7 +29,67 @@
 #include <SFML/System/Err.hpp>
 #include <errno.h>
 #include <fcntl.h>
+#include <algorithm>
 #include <cstring>
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/eventfd.h>
+    #include <sys/sendfile.h>
+#endif
+#include <netinet/ip.h>
+
+
+namespace
+{
+    // Get the level and name of the system option corresponding to a socket option
+    bool getOptionName(sf::Socket::Option option, sf::IpAddress::Family family, int& level, int& name)
+    {
+        switch (option)
+        {
+            case sf::Socket::SendBufferSize:    level = SOL_SOCKET;  name = SO_SNDBUF;    return true;
+            case sf::Socket::ReceiveBufferSize: level = SOL_SOCKET;  name = SO_RCVBUF;    return true;
+            case sf::Socket::NoDelay:           level = IPPROTO_TCP; name = TCP_NODELAY;  return true;
+        #ifdef SO_REUSEPORT
+            case sf::Socket::ReusePort:         level = SOL_SOCKET;  name = SO_REUSEPORT; return true;
+        #endif
+        #ifdef TCP_QUICKACK
+            case sf::Socket::QuickAck:          level = IPPROTO_TCP; name = TCP_QUICKACK; return true;
+        #endif
+        #if defined(TCP_CORK)
+            case sf::Socket::Cork:              level = IPPROTO_TCP; name = TCP_CORK;     return true;
+        #elif defined(TCP_NOPUSH)
+            case sf::Socket::Cork:              level = IPPROTO_TCP; name = TCP_NOPUSH;   return true;
+        #endif
+        #ifdef SO_BUSY_POLL
+            case sf::Socket::BusyPoll:          level = SOL_SOCKET;  name = SO_BUSY_POLL; return true;
+        #endif
+            case sf::Socket::TypeOfService:
+                if (family == sf::IpAddress::IPv6)
+                {
+                    level = IPPROTO_IPV6;
+                    name  = IPV6_TCLASS;
+                }
+                else
+                {
+                    level = IPPROTO_IP;
+                    name  = IP_TOS;
+                }
+                return true;
+
+            case sf::Socket::MulticastTtl:
+                level = (family == sf::IpAddress::IPv6) ? IPPROTO_IPV6 : IPPROTO_IP;
+                name  = (family == sf::IpAddress::IPv6) ? IPV6_MULTICAST_HOPS : IP_MULTICAST_TTL;
+                return true;
+
+            case sf::Socket::MulticastLoopback:
+                level = (family == sf::IpAddress::IPv6) ? IPPROTO_IPV6 : IPPROTO_IP;
+                name  = (family == sf::IpAddress::IPv6) ? IPV6_MULTICAST_LOOP : IP_MULTICAST_LOOP;
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
 
 
 namespace sf
@@ -53,6 +113,53 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, IpAddress::Family family, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    if (family == IpAddress::IPv4)
+    {
+        sockaddr_in& addr = reinterpret_cast<sockaddr_in&>(result);
+        addr = createAddress(address.toInteger(), port);
+        return sizeof(sockaddr_in);
+    }
+
+    sockaddr_in6& addr = reinterpret_cast<sockaddr_in6&>(result);
+    Uint8 bytes[16];
+    address.toBytes(bytes);
+    std::memcpy(&addr.sin6_addr, bytes, sizeof(bytes));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port   = htons(port);
+
+#if defined(SFML_SYSTEM_MACOS)
+    addr.sin6_len = sizeof(addr);
+#endif
+
+    return sizeof(sockaddr_in6);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::extractAddress(const sockaddr_storage& address, IpAddress& ip, unsigned short& port)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        const sockaddr_in6& addr = reinterpret_cast<const sockaddr_in6&>(address);
+        Uint8 bytes[16];
+        std::memcpy(bytes, &addr.sin6_addr, sizeof(bytes));
+        ip   = IpAddress(bytes);
+        port = ntohs(addr.sin6_port);
+    }
+    else
+    {
+        const sockaddr_in& addr = reinterpret_cast<const sockaddr_in&>(address);
+        ip   = IpAddress(ntohl(addr.sin_addr.s_addr));
+        port = ntohs(addr.sin_port);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -85,16 +192,67 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::isOptionSupported(Socket::Option option)
+{
+    int level;
+    int name;
+    return getOptionName(option, IpAddress::IPv4, level, name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::setOption(SocketHandle sock, IpAddress::Family family, Socket::Option option, int value)
+{
+    int level;
+    int name;
+    if (!getOptionName(option, family, level, name))
+        return false;
+
+    if (setsockopt(sock, level, name, &value, sizeof(value)) == -1)
+        return false;
+
+    // IPv6 sockets also send IPv4 packets, which are marked with the IPv4 option
+#ifdef SFML_SYSTEM_LINUX
+    if ((option == Socket::TypeOfService) && (family == IpAddress::IPv6))
+        setsockopt(sock, IPPROTO_IP, IP_TOS, &value, sizeof(value));
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getOption(SocketHandle sock, IpAddress::Family family, Socket::Option option, int& value)
+{
+    int level;
+    int name;
+    if (!getOptionName(option, family, level, name))
+        return false;
+
+    socklen_t size = sizeof(value);
+    value = 0;
+    return getsockopt(sock, level, name, &value, &size) != -1;
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
+{
+    return getErrorStatus(errno);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status SocketImpl::getErrorStatus(int error)
 {
     // The followings are sometimes equal to EWOULDBLOCK,
     // so we have to make a special case for them in order
     // to avoid having double values in the switch case
-    if ((errno == EAGAIN) || (errno == EINPROGRESS))
+    if ((error == EAGAIN) || (error == EINPROGRESS))
         return Socket::NotReady;
 
-    switch (errno)
+    switch (error)
     {
         case EWOULDBLOCK:  return Socket::NotReady;
         case ECONNABORTED: return Socket::Disconnected;
@@ -107,6 +265,208 @@ Socket::Status SocketImpl::getErrorStatus()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::sendFile(SocketHandle sock, std::FILE* file)
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Let the kernel copy the file to the socket directly
+    int fd = fileno(file);
+    bool first = true;
+    for (;;)
+    {
+        ssize_t sent = ::sendfile(sock, fd, NULL, 1 << 30);
+        if (sent > 0)
+        {
+            first = false;
+        }
+        else if (sent == 0)
+        {
+            return true;
+        }
+        else if (errno != EINTR)
+        {
+            // The file may not support it (pipes, some file systems...)
+            return !(first && ((errno == EINVAL) || (errno == ENOSYS)));
+        }
+    }
+
+#else
+
+    // Not available, or with a different interface
+    (void)sock;
+    (void)file;
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::receiveFile(SocketHandle sock, std::FILE* file)
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Move the data from the socket to the file through a pipe, which stays in the kernel
+    int pipes[2];
+    if (pipe(pipes) == -1)
+        return false;
+
+    int fd = fileno(file);
+    bool first = true;
+    bool handled = true;
+    bool spliceToFile = true;
+    char buffer[65536];
+    for (;;)
+    {
+        ssize_t received = ::splice(sock, NULL, pipes[1], NULL, 1 << 20, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (received == 0)
+            break;
+
+        if (received < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            // The socket may not support it
+            handled = !(first && ((errno == EINVAL) || (errno == ENOSYS)));
+            break;
+        }
+
+        first = false;
+        while (received > 0)
+        {
+            ssize_t written;
+            if (spliceToFile)
+            {
+                written = ::splice(pipes[0], NULL, fd, NULL, static_cast<std::size_t>(received), SPLICE_F_MOVE | SPLICE_F_MORE);
+
+                // The file doesn't support it: copy what's in the pipe by hand from now on
+                if ((written < 0) && (errno == EINVAL))
+                {
+                    spliceToFile = false;
+                    continue;
+                }
+            }
+            else
+            {
+                written = ::read(pipes[0], buffer, std::min(sizeof(buffer), static_cast<std::size_t>(received)));
+                ssize_t offset = 0;
+                while (offset < written)
+                {
+                    ssize_t count = ::write(fd, buffer + offset, static_cast<std::size_t>(written - offset));
+                    if (count > 0)
+                        offset += count;
+                    else if (errno != EINTR)
+                        break;
+                }
+
+                if (offset < written)
+                    break;
+            }
+
+            if (written > 0)
+                received -= written;
+            else if ((written < 0) && (errno == EINTR))
+                continue;
+            else
+                break;
+        }
+
+        // Writing to the file failed
+        if (received > 0)
+        {
+            err() << "Failed to write the received data to the file: " << errno << std::endl;
+            break;
+        }
+    }
+
+    ::close(pipes[0]);
+    ::close(pipes[1]);
+
+    return handled;
+
+#else
+
+    // Not available
+    (void)sock;
+    (void)file;
+    return false;
+
+#endif
+}
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::createWakeUp(SocketHandle& reader, SocketHandle& writer)
+{
+#if defined(SFML_SYSTEM_LINUX)
+
+    // An eventfd is a single descriptor holding a counter, cheaper than a pipe
+    reader = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    writer = reader;
+
+    if (reader != -1)
+        return true;
+
+#endif
+
+    int pipes[2];
+    if (pipe(pipes) == -1)
+    {
+        reader = invalidSocket();
+        writer = invalidSocket();
+        return false;
+    }
+
+    // Neither a full pipe nor an empty one must block
+    for (int i = 0; i < 2; ++i)
+    {
+        fcntl(pipes[i], F_SETFL, fcntl(pipes[i], F_GETFL) | O_NONBLOCK);
+        fcntl(pipes[i], F_SETFD, FD_CLOEXEC);
+    }
+
+    reader = pipes[0];
+    writer = pipes[1];
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::signalWakeUp(SocketHandle writer)
+{
+    // The eventfd counter takes exactly 8 bytes, pipes accept them as well;
+    // a full pipe or counter is already readable, so failures can be ignored
+    Uint64 value = 1;
+    while ((::write(writer, &value, sizeof(value)) < 0) && (errno == EINTR))
+    {
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::clearWakeUp(SocketHandle reader)
+{
+    char buffer[64];
+    for (;;)
+    {
+        ssize_t count = ::read(reader, buffer, sizeof(buffer));
+        if ((count <= 0) && ((count == 0) || (errno != EINTR)))
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::closeWakeUp(SocketHandle reader, SocketHandle writer)
+{
+    if (reader != invalidSocket())
+        ::close(reader);
+
+    if ((writer != invalidSocket()) && (writer != reader))
+        ::close(writer);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -28,7 +28,9 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <cstdio>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -67,6 +69,32 @@ public:
     ////////////////////////////////////////////////////////////
     static sockaddr_in createAddress(Uint32 address, unsigned short port);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an internal address of any family
+    ///
+    /// IPv4 addresses are converted to IPv4-mapped IPv6 addresses
+    /// if they are used with an IPv6 socket.
+    ///
+    /// \param address Target address
+    /// \param port    Target port
+    /// \param family  Family of the socket that will use the address
+    /// \param result  Filled with the socket address
+    ///
+    /// \return Size of the socket address, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createAddress(const IpAddress& address, unsigned short port, IpAddress::Family family, sockaddr_storage& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the IP address and port of an internal address
+    ///
+    /// \param address Socket address, as filled by the socket functions
+    /// \param ip      Filled with the IP address (IPv4-mapped addresses are converted to IPv4)
+    /// \param port    Filled with the port
+    ///
+    ////////////////////////////////////////////////////////////
+    static void extractAddress(const sockaddr_storage& address, IpAddress& ip, unsigned short& port);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the value of the invalid socket
     ///
@@ -92,6 +120,42 @@ public:
     ////////////////////////////////////////////////////////////
     static void setBlocking(SocketHandle sock, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system provides a socket option
+    ///
+    /// \param option Option to check
+    ///
+    /// \return True if the option is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isOptionSupported(Socket::Option option);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set an option of a socket
+    ///
+    /// \param sock   Handle of the socket
+    /// \param family Family of the addresses used by the socket
+    /// \param option Option to set
+    /// \param value  New value of the option
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setOption(SocketHandle sock, IpAddress::Family family, Socket::Option option, int value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of an option of a socket
+    ///
+    /// \param sock   Handle of the socket
+    /// \param family Family of the addresses used by the socket
+    /// \param option Option to get
+    /// \param value  Filled with the value of the option
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getOption(SocketHandle sock, IpAddress::Family family, Socket::Option option, int& value);
+
     ////////////////////////////////////////////////////////////
     /// Get the last socket error status
     ///
@@ -99,6 +163,82 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Socket::Status getErrorStatus();
+
+    ////////////////////////////////////////////////////////////
+    /// Get the status corresponding to a socket error code
+    ///
+    /// \param error Error code, as returned by the SO_ERROR socket option
+    ///
+    /// \return Status corresponding to the error
+    ///
+    ////////////////////////////////////////////////////////////
+    static Socket::Status getErrorStatus(int error);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the rest of a file without copying it through user space
+    ///
+    /// The file is sent from its current position to its end.
+    ///
+    /// \param sock Handle of the connected socket
+    /// \param file File to send
+    ///
+    /// \return True if the file was handled (even if the connection broke),
+    ///         false if the system can't do it, in which case nothing was sent
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool sendFile(SocketHandle sock, std::FILE* file);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive data into a file until the connection is closed,
+    ///        without copying it through user space
+    ///
+    /// \param sock Handle of the connected socket
+    /// \param file File to write
+    ///
+    /// \return True if the data was handled (even if an error occurred),
+    ///         false if the system can't do it, in which case nothing was received
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool receiveFile(SocketHandle sock, std::FILE* file);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a channel to wake up a thread blocked in select
+    ///
+    /// The reader becomes readable when the writer is signaled,
+    /// until it is cleared. Both ends may be the same handle.
+    ///
+    /// \param reader Filled with the handle to watch for reading
+    /// \param writer Filled with the handle to signal
+    ///
+    /// \return True on success, false if the channel can't be created
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool createWakeUp(SocketHandle& reader, SocketHandle& writer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the reader of a wake-up channel readable
+    ///
+    /// \param writer Handle to signal
+    ///
+    ////////////////////////////////////////////////////////////
+    static void signalWakeUp(SocketHandle writer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Consume the pending signals of a wake-up channel
+    ///
+    /// \param reader Handle that was watched
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearWakeUp(SocketHandle reader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy a wake-up channel
+    ///
+    /// \param reader Handle that was watched
+    /// \param writer Handle that was signaled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void closeWakeUp(SocketHandle reader, SocketHandle writer);
 };
 
 } // namespace priv
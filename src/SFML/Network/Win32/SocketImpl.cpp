@@ -26,9 +26,41 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Win32/SocketImpl.hpp>
+#include <mswsock.h>
+#include <io.h>
 #include <cstring>
 
 
+namespace
+{
+    // Get the level and name of the system option corresponding to a socket option
+    bool getOptionName(sf::Socket::Option option, sf::IpAddress::Family family, int& level, int& name)
+    {
+        // SO_REUSEADDR would let other processes steal the port, and
+        // IP_TOS is ignored by Windows (QoS goes through the qWAVE API)
+        switch (option)
+        {
+            case sf::Socket::SendBufferSize:    level = SOL_SOCKET;  name = SO_SNDBUF;   return true;
+            case sf::Socket::ReceiveBufferSize: level = SOL_SOCKET;  name = SO_RCVBUF;   return true;
+            case sf::Socket::NoDelay:           level = IPPROTO_TCP; name = TCP_NODELAY; return true;
+
+            case sf::Socket::MulticastTtl:
+                level = (family == sf::IpAddress::IPv6) ? IPPROTO_IPV6 : IPPROTO_IP;
+                name  = (family == sf::IpAddress::IPv6) ? IPV6_MULTICAST_HOPS : IP_MULTICAST_TTL;
+                return true;
+
+            case sf::Socket::MulticastLoopback:
+                level = (family == sf::IpAddress::IPv6) ? IPPROTO_IPV6 : IPPROTO_IP;
+                name  = (family == sf::IpAddress::IPv6) ? IPV6_MULTICAST_LOOP : IP_MULTICAST_LOOP;
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
+
+
 namespace sf
 {
 namespace priv
@@ -46,6 +78,49 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, IpAddress::Family family, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    if (family == IpAddress::IPv4)
+    {
+        sockaddr_in& addr = reinterpret_cast<sockaddr_in&>(result);
+        addr = createAddress(address.toInteger(), port);
+        return sizeof(sockaddr_in);
+    }
+
+    sockaddr_in6& addr = reinterpret_cast<sockaddr_in6&>(result);
+    Uint8 bytes[16];
+    address.toBytes(bytes);
+    std::memcpy(&addr.sin6_addr, bytes, sizeof(bytes));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port   = htons(port);
+
+    return sizeof(sockaddr_in6);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::extractAddress(const sockaddr_storage& address, IpAddress& ip, unsigned short& port)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        const sockaddr_in6& addr = reinterpret_cast<const sockaddr_in6&>(address);
+        Uint8 bytes[16];
+        std::memcpy(bytes, &addr.sin6_addr, sizeof(bytes));
+        ip   = IpAddress(bytes);
+        port = ntohs(addr.sin6_port);
+    }
+    else
+    {
+        const sockaddr_in& addr = reinterpret_cast<const sockaddr_in&>(address);
+        ip   = IpAddress(ntohl(addr.sin_addr.s_addr));
+        port = ntohs(addr.sin_port);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -68,10 +143,52 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::isOptionSupported(Socket::Option option)
+{
+    int level;
+    int name;
+    return getOptionName(option, IpAddress::IPv4, level, name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::setOption(SocketHandle sock, IpAddress::Family family, Socket::Option option, int value)
+{
+    int level;
+    int name;
+    if (!getOptionName(option, family, level, name))
+        return false;
+
+    return setsockopt(sock, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) != SOCKET_ERROR;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getOption(SocketHandle sock, IpAddress::Family family, Socket::Option option, int& value)
+{
+    int level;
+    int name;
+    if (!getOptionName(option, family, level, name))
+        return false;
+
+    int size = sizeof(value);
+    value = 0;
+    return getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &size) != SOCKET_ERROR;
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
-    switch (WSAGetLastError())
+    return getErrorStatus(WSAGetLastError());
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status SocketImpl::getErrorStatus(int error)
+{
+    switch (error)
     {
         case WSAEWOULDBLOCK:  return Socket::NotReady;
         case WSAEALREADY:     return Socket::NotReady;
@@ -86,6 +203,105 @@ Socket::Status SocketImpl::getErrorStatus()
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::sendFile(SocketHandle sock, std::FILE* file)
+{
+    // TransmitFile is an extension of Winsock: get it at runtime so that we don't need mswsock.lib
+    GUID guid = WSAID_TRANSMITFILE;
+    LPFN_TRANSMITFILE transmitFile = NULL;
+    DWORD bytes = 0;
+    if ((WSAIoctl(sock, SIO_GET_EXTENSION_FUNCTION_POINTER, &guid, sizeof(guid), &transmitFile, sizeof(transmitFile), &bytes, NULL, NULL) != 0) || !transmitFile)
+        return false;
+
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    LARGE_INTEGER position;
+    LARGE_INTEGER size;
+    LARGE_INTEGER zero;
+    zero.QuadPart = 0;
+    if ((handle == INVALID_HANDLE_VALUE) || !SetFilePointerEx(handle, zero, &position, FILE_CURRENT) || !GetFileSizeEx(handle, &size))
+        return false;
+
+    // A single call can't send more than 2 GB
+    bool first = true;
+    while (position.QuadPart < size.QuadPart)
+    {
+        LONGLONG remaining = size.QuadPart - position.QuadPart;
+        DWORD count = static_cast<DWORD>(remaining < (1 << 30) ? remaining : (1 << 30));
+        if (!SetFilePointerEx(handle, position, NULL, FILE_BEGIN) || !transmitFile(sock, handle, count, 0, NULL, NULL, 0))
+            return !first;
+
+        position.QuadPart += count;
+        first = false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::receiveFile(SocketHandle, std::FILE*)
+{
+    // Windows has no equivalent of splice for receiving
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::createWakeUp(SocketHandle& reader, SocketHandle& writer)
+{
+    reader = invalidSocket();
+    writer = invalidSocket();
+
+    // Windows can only select sockets: use a loopback UDP socket that sends datagrams to itself
+    SocketHandle sock = socket(PF_INET, SOCK_DGRAM, 0);
+    if (sock == invalidSocket())
+        return false;
+
+    sockaddr_in address = createAddress(INADDR_LOOPBACK, 0);
+    AddrLength size = sizeof(address);
+    if ((bind(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) ||
+        (getsockname(sock, reinterpret_cast<sockaddr*>(&address), &size) == SOCKET_ERROR) ||
+        (connect(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR))
+    {
+        close(sock);
+        return false;
+    }
+
+    setBlocking(sock, false);
+
+    reader = sock;
+    writer = sock;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::signalWakeUp(SocketHandle writer)
+{
+    // A full receive buffer is already readable: failures can be ignored
+    char value = 1;
+    send(writer, &value, sizeof(value), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::clearWakeUp(SocketHandle reader)
+{
+    char buffer[64];
+    while (recv(reader, buffer, sizeof(buffer), 0) > 0)
+    {
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::closeWakeUp(SocketHandle reader, SocketHandle)
+{
+    if (reader != invalidSocket())
+        close(reader);
+}
+
+
 ////////////////////////////////////////////////////////////
 // Windows needs some initialization and cleanup to get
 // sockets working properly... so let's create a class that will
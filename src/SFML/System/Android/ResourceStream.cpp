@@ -41,7 +41,7 @@ ResourceStream::ResourceStream(const std::string& filename) :
 m_file (NULL)
 {
     ActivityStates* states = getActivity(NULL);
-    Lock(states->mutex);
+    Lock lock(states->mutex);
     m_file = AAssetManager_open(states->activity->assetManager, filename.c_str(), AASSET_MODE_UNKNOWN);
 }
 
@@ -112,5 +112,39 @@ Int64 ResourceStream::getSize()
 }
 
 
+////////////////////////////////////////////////////////////
+const void* ResourceStream::getData()
+{
+    if (m_file)
+    {
+        return AAsset_getBuffer(m_file);
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+int ResourceStream::openFileDescriptor(Int64& start, Int64& length)
+{
+    if (m_file)
+    {
+        off64_t assetStart  = 0;
+        off64_t assetLength = 0;
+        int descriptor = AAsset_openFileDescriptor64(m_file, &assetStart, &assetLength);
+
+        start  = assetStart;
+        length = assetLength;
+        return descriptor;
+    }
+    else
+    {
+        return -1;
+    }
+}
+
+
 } // namespace priv
 } // namespace sf
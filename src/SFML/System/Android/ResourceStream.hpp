@@ -97,6 +97,35 @@ public:
     ////////////////////////////////////////////////////////////
     Int64 getSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the contents of the asset file
+    ///
+    /// Uncompressed assets are mapped straight from the APK,
+    /// compressed ones are inflated once into a buffer owned
+    /// by the asset. The pointer stays valid until the stream
+    /// is destroyed. This lets the loaders read the asset
+    /// from memory instead of copying it out.
+    ///
+    /// \return Pointer to the contents, NULL on error
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a file descriptor to the asset file
+    ///
+    /// Only uncompressed assets can be opened this way. The
+    /// descriptor refers to the whole APK, the asset being the
+    /// range [start, start + length). The caller must close it.
+    ///
+    /// \param start  Receives the offset of the asset in the file
+    /// \param length Receives the size of the asset
+    ///
+    /// \return File descriptor, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    int openFileDescriptor(Int64& start, Int64& length);
+
 private:
 
     ////////////////////////////////////////////////////////////
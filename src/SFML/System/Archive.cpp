@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/ArchiveFormat.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/ExclusiveLock.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/FileMappingImpl.hpp>
+#else
+    #include <SFML/System/Unix/FileMappingImpl.hpp>
+#endif
+
+
+namespace
+{
+    // Archives mounted with sf::Archive::mount
+    sf::priv::MountedArchives mountedArchives;
+
+    // Read little endian values from an archive
+    sf::Uint32 readUint32(const char* data)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return static_cast<sf::Uint32>(bytes[0])         |
+               (static_cast<sf::Uint32>(bytes[1]) << 8)  |
+               (static_cast<sf::Uint32>(bytes[2]) << 16) |
+               (static_cast<sf::Uint32>(bytes[3]) << 24);
+    }
+
+    sf::Uint64 readUint64(const char* data)
+    {
+        return static_cast<sf::Uint64>(readUint32(data)) | (static_cast<sf::Uint64>(readUint32(data + 4)) << 32);
+    }
+
+    // Compare an entry with a hash, to search the index
+    template <typename T>
+    bool compareHash(const T& entry, sf::Uint64 hash)
+    {
+        return entry.hash < hash;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+MountedArchives& getMountedArchives()
+{
+    return mountedArchives;
+}
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+Archive::Archive() :
+m_mapping(NULL),
+m_data   (NULL),
+m_entries(),
+m_mounted(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Archive::~Archive()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::openFromFile(const std::string& filename)
+{
+    close();
+
+    priv::FileMappingImpl* mapping = new priv::FileMappingImpl;
+
+    if (!mapping->open(filename))
+    {
+        err() << "Failed to open archive \"" << filename << "\"" << std::endl;
+        delete mapping;
+        return false;
+    }
+
+    const char* data = static_cast<const char*>(mapping->getData());
+    Uint64 size = static_cast<Uint64>(mapping->getSize());
+
+    // Check the header
+    if ((size < priv::archiveHeaderSize) || (std::memcmp(data, priv::archiveMagic, 4) != 0))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (not an archive)" << std::endl;
+        delete mapping;
+        return false;
+    }
+
+    if (readUint32(data + 4) != priv::archiveVersion)
+    {
+        err() << "Failed to open archive \"" << filename << "\" (unsupported version " << readUint32(data + 4) << ")" << std::endl;
+        delete mapping;
+        return false;
+    }
+
+    Uint32 count = readUint32(data + 8);
+    Uint64 indexOffset = readUint64(data + 16);
+    Uint64 indexSize = readUint64(data + 24);
+
+    if ((indexOffset > size) || (indexSize > size - indexOffset))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (corrupted index)" << std::endl;
+        delete mapping;
+        return false;
+    }
+
+    // Read the index, checking every entry against the size of the archive
+    std::vector<Entry> entries;
+    entries.reserve(std::min<Uint64>(count, indexSize / priv::archiveEntrySize));
+
+    const char* index = data + indexOffset;
+    Uint64 position = 0;
+
+    for (Uint32 i = 0; i < count; ++i)
+    {
+        if (indexSize - position < priv::archiveEntrySize)
+            break;
+
+        Entry entry;
+        entry.hash        = readUint64(index + position);
+        entry.offset      = readUint64(index + position + 8);
+        entry.storedSize  = readUint64(index + position + 16);
+        entry.size        = readUint64(index + position + 24);
+        entry.compression = readUint32(index + position + 32);
+        Uint32 pathLength = readUint32(index + position + 36);
+        position += priv::archiveEntrySize;
+
+        if ((pathLength > indexSize - position) ||
+            (entry.offset > size) || (entry.storedSize > size - entry.offset) ||
+            ((entry.compression != priv::archiveStored) && (entry.compression != priv::archiveLz4)) ||
+            ((entry.compression == priv::archiveStored) && (entry.storedSize != entry.size)))
+            break;
+
+        entry.path.assign(index + position, pathLength);
+        position += pathLength;
+
+        if (entry.hash != priv::hashArchivePath(entry.path))
+            break;
+
+        entries.push_back(entry);
+    }
+
+    if (entries.size() != count)
+    {
+        err() << "Failed to open archive \"" << filename << "\" (corrupted index)" << std::endl;
+        delete mapping;
+        return false;
+    }
+
+    // The writer sorts the index, don't trust it anyway since lookups rely on it
+    std::sort(entries.begin(), entries.end(), priv::compareArchiveEntries<Entry>);
+
+    m_mapping = mapping;
+    m_data = data;
+    m_entries.swap(entries);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::close()
+{
+    unmount();
+
+    delete m_mapping;
+    m_mapping = NULL;
+    m_data = NULL;
+    m_entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::contains(const std::string& path) const
+{
+    return find(priv::normalizeArchivePath(path)) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Archive::getFileCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::mount(const std::string& mountPoint)
+{
+    unmount();
+
+    if (!m_mapping)
+    {
+        err() << "Failed to mount archive (archive is not open)" << std::endl;
+        return;
+    }
+
+    // Mount points are matched as a prefix of normalized paths
+    std::string prefix = priv::normalizeArchivePath(mountPoint);
+    if (!prefix.empty() && (prefix[prefix.size() - 1] != '/'))
+        prefix += '/';
+
+    ExclusiveLock lock(mountedArchives.mutex);
+
+    mountedArchives.list.insert(mountedArchives.list.begin(), std::make_pair(this, prefix));
+    mountedArchives.count.store(static_cast<Uint32>(mountedArchives.list.size()));
+    m_mounted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::unmount()
+{
+    if (!m_mounted)
+        return;
+
+    ExclusiveLock lock(mountedArchives.mutex);
+
+    for (priv::MountedArchives::List::iterator it = mountedArchives.list.begin(); it != mountedArchives.list.end(); ++it)
+    {
+        if (it->first == this)
+        {
+            mountedArchives.list.erase(it);
+            break;
+        }
+    }
+
+    mountedArchives.count.store(static_cast<Uint32>(mountedArchives.list.size()));
+    m_mounted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const Archive::Entry* Archive::find(const std::string& path) const
+{
+    Uint64 hash = priv::hashArchivePath(path);
+
+    std::vector<Entry>::const_iterator it = std::lower_bound(m_entries.begin(), m_entries.end(), hash, compareHash<Entry>);
+
+    for (; (it != m_entries.end()) && (it->hash == hash); ++it)
+    {
+        if (it->path == path)
+            return &*it;
+    }
+
+    return NULL;
+}
+
+} // namespace sf
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_ARCHIVEFORMAT_HPP
+#define SFML_ARCHIVEFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/SharedMutex.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+class Archive;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// Layout of an archive: header, contents of the files, index.
+// Header: magic, version, entry count, reserved (4 x Uint32),
+// index offset, index size (2 x Uint64).
+// Index entry: hash, offset, stored size, size (4 x Uint64),
+// compression, path length (2 x Uint32), path.
+////////////////////////////////////////////////////////////
+const char        archiveMagic[4]   = {'S', 'F', 'P', 'K'};
+const Uint32      archiveVersion    = 1;
+const std::size_t archiveHeaderSize = 32;
+const std::size_t archiveEntrySize  = 40;
+const Uint32      archiveStored     = 0;
+const Uint32      archiveLz4        = 1;
+
+////////////////////////////////////////////////////////////
+/// \brief Normalize a path to the form stored in archives
+///
+/// Separators are converted to '/', and leading "./" removed.
+///
+/// \param path Path to normalize
+///
+/// \return Normalized path
+///
+////////////////////////////////////////////////////////////
+inline std::string normalizeArchivePath(const std::string& path)
+{
+    std::string normalized(path);
+
+    for (std::string::iterator it = normalized.begin(); it != normalized.end(); ++it)
+    {
+        if (*it == '\\')
+            *it = '/';
+    }
+
+    std::string::size_type start = 0;
+    while (normalized.compare(start, 2, "./") == 0)
+        start += 2;
+
+    return normalized.substr(start);
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Hash a normalized path (64-bit FNV-1a)
+///
+/// \param path Normalized path
+///
+/// \return Hash of the path
+///
+////////////////////////////////////////////////////////////
+inline Uint64 hashArchivePath(const std::string& path)
+{
+    Uint64 hash = 14695981039346656037ULL;
+
+    for (std::string::const_iterator it = path.begin(); it != path.end(); ++it)
+    {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Order of the entries in the index of an archive
+///
+/// Entries are sorted by hash, then by path so that the order
+/// of colliding hashes is deterministic.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+bool compareArchiveEntries(const T& left, const T& right)
+{
+    if (left.hash != right.hash)
+        return left.hash < right.hash;
+
+    return left.path < right.path;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Archives mounted with Archive::mount
+///
+////////////////////////////////////////////////////////////
+struct MountedArchives
+{
+    typedef std::vector<std::pair<const Archive*, std::string> > List;
+
+    SharedMutex    mutex; ///< Protects the list
+    List           list;  ///< Mounted archives and their normalized mount point, last mounted first
+    Atomic<Uint32> count; ///< Size of the list, to skip locking when nothing is mounted
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Get the archives mounted with Archive::mount
+///
+/// \return Mounted archives
+///
+////////////////////////////////////////////////////////////
+MountedArchives& getMountedArchives();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVEFORMAT_HPP
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ArchiveInputStream.hpp>
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/ArchiveFormat.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lz4.hpp>
+#include <SFML/System/SharedLock.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ArchiveInputStream::ArchiveInputStream() :
+m_data  (NULL),
+m_size  (0),
+m_offset(0),
+m_buffer()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ArchiveInputStream::~ArchiveInputStream()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveInputStream::open(const std::string& filename)
+{
+    m_data = NULL;
+    m_size = 0;
+    m_offset = 0;
+
+    priv::MountedArchives& mounted = priv::getMountedArchives();
+
+    // Don't bother locking in the common case where nothing is mounted
+    if (mounted.count.load(Memory::Acquire) == 0)
+        return false;
+
+    std::string path = priv::normalizeArchivePath(filename);
+
+    SharedLock lock(mounted.mutex);
+
+    for (priv::MountedArchives::List::const_iterator it = mounted.list.begin(); it != mounted.list.end(); ++it)
+    {
+        const std::string& prefix = it->second;
+
+        if ((path.compare(0, prefix.size(), prefix) == 0) && openEntry(*it->first, path.substr(prefix.size())))
+            return true;
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveInputStream::open(const Archive& archive, const std::string& path)
+{
+    m_data = NULL;
+    m_size = 0;
+    m_offset = 0;
+
+    return openEntry(archive, priv::normalizeArchivePath(path));
+}
+
+
+////////////////////////////////////////////////////////////
+const void* ArchiveInputStream::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::read(void* data, Int64 size)
+{
+    if (!m_data)
+        return -1;
+
+    Int64 endPosition = m_offset + size;
+    Int64 count = endPosition <= m_size ? size : m_size - m_offset;
+
+    if (count > 0)
+    {
+        std::memcpy(data, m_data + m_offset, static_cast<std::size_t>(count));
+        m_offset += count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::seek(Int64 position)
+{
+    if (!m_data)
+        return -1;
+
+    m_offset = position < m_size ? position : m_size;
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::tell()
+{
+    if (!m_data)
+        return -1;
+
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 ArchiveInputStream::getSize()
+{
+    if (!m_data)
+        return -1;
+
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveInputStream::openEntry(const Archive& archive, const std::string& path)
+{
+    const Archive::Entry* entry = archive.find(path);
+
+    if (!entry)
+        return false;
+
+    const char* contents = archive.m_data + entry->offset;
+
+    if (entry->compression == priv::archiveStored)
+    {
+        // Read directly from the mapping, stored files are never copied
+        std::vector<char>().swap(m_buffer);
+        m_data = contents;
+    }
+    else
+    {
+        m_buffer.resize(static_cast<std::size_t>(entry->size));
+
+        if (!priv::lz4Decompress(contents, static_cast<std::size_t>(entry->storedSize), m_buffer.empty() ? NULL : &m_buffer[0], m_buffer.size()))
+        {
+            err() << "Failed to decompress file \"" << path << "\" of archive (corrupted data)" << std::endl;
+            std::vector<char>().swap(m_buffer);
+            return false;
+        }
+
+        // An empty buffer has no address, any non-null pointer marks the stream as open
+        m_data = m_buffer.empty() ? contents : &m_buffer[0];
+    }
+
+    m_size = static_cast<Int64>(entry->size);
+    m_offset = 0;
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ArchiveWriter.hpp>
+#include <SFML/System/ArchiveFormat.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lz4.hpp>
+#include <algorithm>
+#include <iterator>
+
+
+namespace
+{
+    // Append little endian values to a buffer
+    void writeUint32(std::vector<char>& buffer, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    void writeUint64(std::vector<char>& buffer, sf::Uint64 value)
+    {
+        writeUint32(buffer, static_cast<sf::Uint32>(value & 0xFFFFFFFF));
+        writeUint32(buffer, static_cast<sf::Uint32>(value >> 32));
+    }
+
+    // Build the header of an archive
+    std::vector<char> makeHeader(sf::Uint32 count, sf::Uint64 indexOffset, sf::Uint64 indexSize)
+    {
+        std::vector<char> header(sf::priv::archiveMagic, sf::priv::archiveMagic + 4);
+        writeUint32(header, sf::priv::archiveVersion);
+        writeUint32(header, count);
+        writeUint32(header, 0);
+        writeUint64(header, indexOffset);
+        writeUint64(header, indexSize);
+
+        return header;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ArchiveWriter::ArchiveWriter() :
+m_file    (),
+m_filename(),
+m_offset  (0),
+m_entries ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ArchiveWriter::~ArchiveWriter()
+{
+    if (m_file.is_open())
+        close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveWriter::open(const std::string& filename)
+{
+    if (m_file.is_open())
+        close();
+
+    m_entries.clear();
+    m_filename = filename;
+    m_file.clear();
+    m_file.open(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+
+    if (!m_file.is_open())
+    {
+        err() << "Failed to create archive \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    // Reserve room for the header, written again once the index is known
+    std::vector<char> header = makeHeader(0, 0, 0);
+    m_file.write(&header[0], static_cast<std::streamsize>(header.size()));
+    m_offset = header.size();
+
+    return m_file.good();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveWriter::add(const std::string& path, const void* data, std::size_t size, bool compress)
+{
+    if (!m_file.is_open())
+    {
+        err() << "Failed to add \"" << path << "\" to archive (archive is not open)" << std::endl;
+        return false;
+    }
+
+    Entry entry;
+    entry.path        = priv::normalizeArchivePath(path);
+    entry.hash        = priv::hashArchivePath(entry.path);
+    entry.offset      = m_offset;
+    entry.storedSize  = size;
+    entry.size        = size;
+    entry.compression = priv::archiveStored;
+
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if ((it->hash == entry.hash) && (it->path == entry.path))
+        {
+            err() << "Failed to add \"" << path << "\" to archive \"" << m_filename << "\" (path already used)" << std::endl;
+            return false;
+        }
+    }
+
+    const char* contents = static_cast<const char*>(data);
+    std::vector<char> compressed;
+
+    // Keep the compressed version only if it saves space
+    if (compress && (size > 0))
+    {
+        priv::lz4Compress(contents, size, compressed);
+
+        if (compressed.size() < size)
+        {
+            contents = &compressed[0];
+            entry.storedSize = compressed.size();
+            entry.compression = priv::archiveLz4;
+        }
+    }
+
+    if (entry.storedSize > 0)
+        m_file.write(contents, static_cast<std::streamsize>(entry.storedSize));
+
+    if (!m_file.good())
+    {
+        err() << "Failed to add \"" << path << "\" to archive \"" << m_filename << "\" (write error)" << std::endl;
+        return false;
+    }
+
+    m_offset += entry.storedSize;
+    m_entries.push_back(entry);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveWriter::addFile(const std::string& path, const std::string& filename, bool compress)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+
+    if (!file)
+    {
+        err() << "Failed to add \"" << filename << "\" to archive (cannot open file)" << std::endl;
+        return false;
+    }
+
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (file.bad())
+    {
+        err() << "Failed to add \"" << filename << "\" to archive (read error)" << std::endl;
+        return false;
+    }
+
+    return add(path, contents.empty() ? NULL : &contents[0], contents.size(), compress);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ArchiveWriter::close()
+{
+    if (!m_file.is_open())
+        return false;
+
+    // The index is sorted so that sf::Archive can search it right away
+    std::sort(m_entries.begin(), m_entries.end(), priv::compareArchiveEntries<Entry>);
+
+    std::vector<char> index;
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        writeUint64(index, it->hash);
+        writeUint64(index, it->offset);
+        writeUint64(index, it->storedSize);
+        writeUint64(index, it->size);
+        writeUint32(index, it->compression);
+        writeUint32(index, static_cast<Uint32>(it->path.size()));
+        index.insert(index.end(), it->path.begin(), it->path.end());
+    }
+
+    if (!index.empty())
+        m_file.write(&index[0], static_cast<std::streamsize>(index.size()));
+
+    std::vector<char> header = makeHeader(static_cast<Uint32>(m_entries.size()), m_offset, index.size());
+    m_file.seekp(0);
+    m_file.write(&header[0], static_cast<std::streamsize>(header.size()));
+
+    bool success = m_file.good();
+    m_file.close();
+    m_entries.clear();
+
+    if (!success)
+        err() << "Failed to write archive \"" << m_filename << "\"" << std::endl;
+
+    return success;
+}
+
+} // namespace sf
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Arena.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <algorithm>
+#include <new>
+
+
+namespace
+{
+    // Arenas of all the threads, destroyed at exit since threads don't notify their end
+    struct ThreadArenas
+    {
+        ~ThreadArenas()
+        {
+            for (std::vector<sf::Arena*>::iterator it = arenas.begin(); it != arenas.end(); ++it)
+                delete *it;
+        }
+
+        sf::Mutex               mutex;
+        std::vector<sf::Arena*> arenas;
+    };
+
+    ThreadArenas threadArenas;
+    sf::ThreadLocalPtr<sf::Arena> currentThreadArena;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Arena::Scope::Scope(Arena& arena) :
+m_arena (arena),
+m_block (arena.m_block),
+m_offset(arena.m_offset)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Arena::Scope::~Scope()
+{
+    m_arena.release(m_block, m_offset);
+}
+
+
+////////////////////////////////////////////////////////////
+Arena::Arena(std::size_t blockSize) :
+m_blocks         (),
+m_block          (0),
+m_offset         (0),
+m_blockSize      (std::max<std::size_t>(blockSize, 64)),
+m_heapAllocations(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Arena::~Arena()
+{
+    for (std::vector<Block>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+        ::operator delete(it->data);
+}
+
+
+////////////////////////////////////////////////////////////
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    // Take the memory from the current block if it fits
+    if (m_block < m_blocks.size())
+    {
+        const Block& block = m_blocks[m_block];
+        std::size_t address = reinterpret_cast<std::size_t>(block.data) + m_offset;
+        std::size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+        if (m_offset + padding + size <= block.size)
+        {
+            m_offset += padding + size;
+            return block.data + m_offset - size;
+        }
+
+        // Otherwise move to the next block, if it is large enough
+        if ((m_block + 1 < m_blocks.size()) && (size + alignment <= m_blocks[m_block + 1].size))
+        {
+            ++m_block;
+            m_offset = 0;
+            return allocate(size, alignment);
+        }
+    }
+
+    // Take a new block from the heap, right after the current one so that scopes release it
+    Block block;
+    block.size = std::max(m_blockSize, size + alignment);
+    block.data = static_cast<char*>(::operator new(block.size));
+    ++m_heapAllocations;
+
+    std::size_t position = m_blocks.empty() ? 0 : m_block + 1;
+    m_blocks.insert(m_blocks.begin() + position, block);
+    m_block = position;
+    m_offset = 0;
+
+    return allocate(size, alignment);
+}
+
+
+////////////////////////////////////////////////////////////
+void Arena::reset()
+{
+    release(0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Arena::getUsedSize() const
+{
+    std::size_t used = m_offset;
+    for (std::size_t i = 0; (i < m_block) && (i < m_blocks.size()); ++i)
+        used += m_blocks[i].size;
+
+    return used;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Arena::getHeapAllocationCount() const
+{
+    return m_heapAllocations;
+}
+
+
+////////////////////////////////////////////////////////////
+Arena& Arena::getThreadArena()
+{
+    if (!currentThreadArena)
+    {
+        Arena* arena = new Arena;
+
+        Lock lock(threadArenas.mutex);
+        threadArenas.arenas.push_back(arena);
+        currentThreadArena = arena;
+    }
+
+    return *currentThreadArena;
+}
+
+
+////////////////////////////////////////////////////////////
+void Arena::release(std::size_t block, std::size_t offset)
+{
+    m_block = block;
+    m_offset = offset;
+
+    // Once everything is released, merge the blocks so that the same work fits in one block next time
+    if ((block == 0) && (offset == 0) && (m_blocks.size() > 1))
+    {
+        Block merged;
+        merged.size = 0;
+
+        for (std::vector<Block>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+        {
+            merged.size += it->size;
+            ::operator delete(it->data);
+        }
+
+        merged.data = static_cast<char*>(::operator new(merged.size));
+        ++m_heapAllocations;
+
+        m_blocks.assign(1, merged);
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,324 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/BufferedInputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BufferedInputStream::BufferedInputStream(std::size_t bufferSize, bool readAhead) :
+m_bufferSize      (std::max<std::size_t>(bufferSize, 1)),
+m_readAheadEnabled(readAhead),
+m_file            (),
+m_source          (NULL),
+m_size            (-1),
+m_current         (),
+m_offset          (0),
+m_next            (),
+m_thread          (&BufferedInputStream::readAhead, this),
+m_mutex           (),
+m_condition       (),
+m_state           (Idle)
+{
+    m_current.start = 0;
+    m_current.size = 0;
+    m_next.start = 0;
+    m_next.size = 0;
+
+    m_thread.setName("sfml-read-ahead");
+}
+
+
+////////////////////////////////////////////////////////////
+BufferedInputStream::~BufferedInputStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool BufferedInputStream::open(const std::string& filename)
+{
+    close();
+
+    return m_file.open(filename) && open(m_file);
+}
+
+
+////////////////////////////////////////////////////////////
+bool BufferedInputStream::open(InputStream& source)
+{
+    close();
+
+    Int64 size = source.getSize();
+    Int64 position = source.tell();
+    if ((size < 0) || (position < 0))
+        return false;
+
+    m_source = &source;
+    m_size = size;
+
+    m_current.data.resize(m_bufferSize);
+    m_current.start = position;
+    m_current.size = 0;
+    m_offset = 0;
+
+    if (m_readAheadEnabled)
+    {
+        m_next.data.resize(m_bufferSize);
+        m_state = Idle;
+        m_thread.launch();
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::read(void* data, Int64 size)
+{
+    if (!m_source)
+        return -1;
+
+    char* output = static_cast<char*>(data);
+    Int64 total = 0;
+
+    while (total < size)
+    {
+        Int64 available = m_current.size - m_offset;
+
+        if (available > 0)
+        {
+            Int64 count = std::min(available, size - total);
+            std::memcpy(output + total, &m_current.data[0] + m_offset, static_cast<std::size_t>(count));
+            m_offset += count;
+            total += count;
+        }
+        else if (tell() >= m_size)
+        {
+            break;
+        }
+        else if (!m_readAheadEnabled && (size - total >= static_cast<Int64>(m_bufferSize)))
+        {
+            // Large reads go straight to the destination
+            Int64 position = tell();
+            if ((m_source->tell() != position) && (m_source->seek(position) != position))
+                break;
+
+            Int64 count = m_source->read(output + total, size - total);
+            if (count <= 0)
+                break;
+
+            total += count;
+            m_current.start = position + count;
+            m_current.size = 0;
+            m_offset = 0;
+        }
+        else
+        {
+            advance();
+
+            if (m_current.size == 0)
+                break;
+        }
+    }
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::seek(Int64 position)
+{
+    if (!m_source || (position < 0))
+        return -1;
+
+    position = std::min(position, m_size);
+
+    // Inside the current block?
+    if ((position >= m_current.start) && (position <= m_current.start + m_current.size))
+    {
+        m_offset = position - m_current.start;
+        return position;
+    }
+
+    // Inside the block read ahead?
+    if (m_readAheadEnabled && waitReadAhead() && (position >= m_next.start) && (position < m_next.start + m_next.size))
+    {
+        m_current.data.swap(m_next.data);
+        m_current.start = m_next.start;
+        m_current.size = m_next.size;
+        m_offset = position - m_current.start;
+        requestReadAhead();
+        return position;
+    }
+
+    // The source is accessed on the next read
+    m_current.start = position;
+    m_current.size = 0;
+    m_offset = 0;
+
+    return position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::tell()
+{
+    return m_source ? m_current.start + m_offset : -1;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::getSize()
+{
+    return m_source ? m_size : -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::close()
+{
+    {
+        Lock lock(m_mutex);
+        m_state = Stopping;
+        m_condition.notifyAll();
+    }
+
+    m_thread.wait();
+
+    m_state = Idle;
+    m_source = NULL;
+    m_size = -1;
+    m_current.start = 0;
+    m_current.size = 0;
+    m_offset = 0;
+    m_next.start = 0;
+    m_next.size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::fill(Block& block, Int64 position)
+{
+    block.start = position;
+    block.size = 0;
+
+    if ((m_source->tell() != position) && (m_source->seek(position) != position))
+        return;
+
+    Int64 count = m_source->read(&block.data[0], std::min(static_cast<Int64>(m_bufferSize), m_size - position));
+    block.size = std::max<Int64>(count, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::advance()
+{
+    Int64 position = tell();
+
+    if (m_readAheadEnabled && waitReadAhead() && (m_next.start == position))
+    {
+        m_current.data.swap(m_next.data);
+        m_current.start = m_next.start;
+        m_current.size = m_next.size;
+    }
+    else
+    {
+        fill(m_current, position);
+    }
+
+    m_offset = 0;
+
+    if (m_readAheadEnabled)
+        requestReadAhead();
+}
+
+
+////////////////////////////////////////////////////////////
+bool BufferedInputStream::waitReadAhead()
+{
+    Lock lock(m_mutex);
+
+    while (m_state == Requested)
+        m_condition.wait(m_mutex);
+
+    bool ready = (m_state == Ready);
+    m_state = Idle;
+
+    return ready;
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::requestReadAhead()
+{
+    Int64 position = m_current.start + m_current.size;
+    if (position >= m_size)
+        return;
+
+    Lock lock(m_mutex);
+
+    m_next.start = position;
+    m_state = Requested;
+    m_condition.notifyAll();
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::readAhead()
+{
+    m_mutex.lock();
+
+    for (;;)
+    {
+        while ((m_state != Requested) && (m_state != Stopping))
+            m_condition.wait(m_mutex);
+
+        if (m_state == Stopping)
+            break;
+
+        // The consumer doesn't touch the source nor the next block while it is requested
+        m_mutex.unlock();
+        fill(m_next, m_next.start);
+        m_mutex.lock();
+
+        if (m_state == Requested)
+            m_state = Ready;
+
+        m_condition.notifyAll();
+    }
+
+    m_mutex.unlock();
+}
+
+} // namespace sf
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Cpu.hpp>
+#include <SFML/System/Atomic.hpp>
+
+#if defined(SFML_CPU_X86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #include <immintrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#elif defined(SFML_CPU_ARM) && !defined(__aarch64__) && !defined(_M_ARM64) && defined(SFML_SYSTEM_LINUX)
+    #include <sys/auxv.h>
+    #define SFML_CPU_ARM_HWCAP
+#endif
+
+
+namespace
+{
+    // Marks the cached features as detected, so that a processor without any extension isn't queried again
+    const unsigned int featuresDetected = 1u << 31;
+
+    // Zero until the first query
+    sf::Atomic<unsigned int> cachedFeatures(0);
+
+#if defined(SFML_CPU_X86)
+
+    // Execute cpuid with a sub-leaf, returns false if the leaf is not supported
+    bool queryCpuid(unsigned int leaf, unsigned int subLeaf, unsigned int registers[4])
+    {
+        #if defined(_MSC_VER)
+
+            int info[4];
+            __cpuid(info, 0);
+            if (static_cast<unsigned int>(info[0]) < leaf)
+                return false;
+
+            __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+            for (int i = 0; i < 4; ++i)
+                registers[i] = static_cast<unsigned int>(info[i]);
+
+        #else
+
+            if (__get_cpuid_max(0, NULL) < leaf)
+                return false;
+
+            __cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+
+        #endif
+
+        return true;
+    }
+
+    // Read the register telling which register states the operating system saves on context switches
+    unsigned int readXcr0()
+    {
+        #if defined(_MSC_VER)
+
+            return static_cast<unsigned int>(_xgetbv(0));
+
+        #else
+
+            // xgetbv, encoded for the assemblers that don't know it
+            unsigned int eax, edx;
+            __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+            return eax;
+
+        #endif
+    }
+
+#endif
+
+    // Query the processor (and operating system) for the supported extensions
+    unsigned int detectFeatures()
+    {
+        unsigned int features = 0;
+
+    #if defined(SFML_CPU_X86)
+
+        unsigned int registers[4];
+        if (!queryCpuid(1, 0, registers))
+            return features;
+
+        const unsigned int ecx = registers[2];
+        const unsigned int edx = registers[3];
+
+        if (edx & (1u << 26)) features |= sf::priv::Cpu::Sse2;
+        if (ecx & (1u << 0))  features |= sf::priv::Cpu::Sse3;
+        if (ecx & (1u << 9))  features |= sf::priv::Cpu::Ssse3;
+        if (ecx & (1u << 19)) features |= sf::priv::Cpu::Sse41;
+        if (ecx & (1u << 20)) features |= sf::priv::Cpu::Sse42;
+        if (ecx & (1u << 23)) features |= sf::priv::Cpu::Popcnt;
+
+        // The AVX registers can only be used if the OS saves both the SSE and AVX states (OSXSAVE, then XCR0 bits 1 and 2)
+        bool avxState = (ecx & (1u << 27)) && ((readXcr0() & 0x6) == 0x6);
+        if (avxState)
+        {
+            if (ecx & (1u << 28)) features |= sf::priv::Cpu::Avx;
+            if (ecx & (1u << 12)) features |= sf::priv::Cpu::Fma;
+            if (ecx & (1u << 29)) features |= sf::priv::Cpu::F16c;
+        }
+
+        if (queryCpuid(7, 0, registers))
+        {
+            const unsigned int ebx = registers[1];
+
+            if (avxState && (ebx & (1u << 5))) features |= sf::priv::Cpu::Avx2;
+            if (ebx & (1u << 3))               features |= sf::priv::Cpu::Bmi1;
+            if (ebx & (1u << 8))               features |= sf::priv::Cpu::Bmi2;
+        }
+
+    #elif defined(SFML_CPU_ARM)
+
+        #if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+            // Guaranteed by the architecture or the build settings
+            features |= sf::priv::Cpu::Neon;
+
+        #elif defined(SFML_CPU_ARM_HWCAP)
+
+            // HWCAP_NEON
+            if (getauxval(AT_HWCAP) & (1ul << 12))
+                features |= sf::priv::Cpu::Neon;
+
+        #endif
+
+    #endif
+
+        return features;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+unsigned int Cpu::getFeatures()
+{
+    // The detection always gives the same result, concurrent first calls simply store it twice
+    unsigned int features = cachedFeatures.load(Memory::Relaxed);
+    if (!features)
+    {
+        features = detectFeatures() | featuresDetected;
+        cachedFeatures.store(features, Memory::Relaxed);
+    }
+
+    return features & ~featuresDetected;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Cpu::hasFeatures(unsigned int features)
+{
+    return (getFeatures() & features) == features;
+}
+
+} // namespace priv
+
+} // namespace sf
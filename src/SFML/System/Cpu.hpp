@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CPU_HPP
+#define SFML_CPU_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+
+
+////////////////////////////////////////////////////////////
+// Identify the architecture of the target
+////////////////////////////////////////////////////////////
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+
+    #define SFML_CPU_X86
+
+#elif defined(__arm__) || defined(__aarch64__) || defined(_M_ARM) || defined(_M_ARM64)
+
+    #define SFML_CPU_ARM
+
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        #define SFML_CPU_ARM64
+    #endif
+
+#endif
+
+////////////////////////////////////////////////////////////
+// Vector instructions enabled by the build settings: SSE2 is
+// part of every x86-64 processor and NEON of every ARM64 one,
+// so the kernels using them are selected when compiling
+////////////////////////////////////////////////////////////
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+
+    #define SFML_CPU_SSE2
+    #include <emmintrin.h>
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+    #define SFML_CPU_NEON
+    #include <arm_neon.h>
+
+#endif
+
+////////////////////////////////////////////////////////////
+// Let a function use instructions that the rest of the
+// build doesn't enable, e.g. SFML_CPU_TARGET("avx2");
+// MSVC accepts any intrinsic without it. SFML_CPU_DISPATCH_X86
+// tells whether the compiler can build such functions
+////////////////////////////////////////////////////////////
+#if defined(SFML_CPU_X86) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__ >= 409)))
+
+    #define SFML_CPU_DISPATCH_X86
+    #define SFML_CPU_TARGET(features) __attribute__((target(features)))
+    #include <immintrin.h>
+
+#elif defined(SFML_CPU_X86) && defined(_MSC_VER) && (_MSC_VER >= 1800)
+
+    #define SFML_CPU_DISPATCH_X86
+    #define SFML_CPU_TARGET(features)
+    #include <immintrin.h>
+
+#else
+
+    #define SFML_CPU_TARGET(features)
+
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Instruction set extensions of the processor,
+///        detected at runtime
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Cpu
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Instruction set extensions
+    ///
+    /// The extensions using the AVX registers are only reported
+    /// if the operating system saves these registers as well.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Feature
+    {
+        Sse2   = 1 << 0,  ///< x86 SSE2, part of every x86-64 processor
+        Sse3   = 1 << 1,  ///< x86 SSE3
+        Ssse3  = 1 << 2,  ///< x86 supplemental SSE3 (byte shuffles)
+        Sse41  = 1 << 3,  ///< x86 SSE4.1
+        Sse42  = 1 << 4,  ///< x86 SSE4.2
+        Popcnt = 1 << 5,  ///< x86 population count
+        Avx    = 1 << 6,  ///< x86 AVX
+        Avx2   = 1 << 7,  ///< x86 AVX2
+        Fma    = 1 << 8,  ///< x86 fused multiply-add (FMA3)
+        F16c   = 1 << 9,  ///< x86 half-precision float conversions
+        Bmi1   = 1 << 10, ///< x86 bit manipulation instructions 1
+        Bmi2   = 1 << 11, ///< x86 bit manipulation instructions 2
+        Neon   = 1 << 12  ///< ARM NEON (Advanced SIMD), part of every ARM64 processor
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get all the extensions supported by the processor
+    ///
+    /// The processor is queried on the first call only, the
+    /// next ones return the cached result. This function can
+    /// be called from any thread, at any time (including the
+    /// initialization of global variables).
+    ///
+    /// \return Combination of Feature flags
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getFeatures();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the processor supports extensions
+    ///
+    /// \param features Combination of Feature flags
+    ///
+    /// \return True if all the extensions are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool hasFeatures(unsigned int features);
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Function pointer selected among several
+///        implementations according to the processor
+///
+////////////////////////////////////////////////////////////
+template <typename Function>
+class CpuDispatch
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start from the portable implementation
+    ///
+    /// \param fallback Implementation that runs on any processor
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CpuDispatch(Function fallback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Propose an implementation requiring extensions
+    ///
+    /// The first implementation proposed whose extensions are
+    /// all supported is selected, so the fastest ones must be
+    /// proposed first.
+    ///
+    /// \param features       Combination of Cpu::Feature flags that the implementation requires
+    /// \param implementation Implementation to select if they are supported
+    ///
+    /// \return Reference to self, to chain the proposals
+    ///
+    ////////////////////////////////////////////////////////////
+    CpuDispatch& add(unsigned int features, Function implementation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the selected implementation
+    ///
+    /// \return Function pointer to call
+    ///
+    ////////////////////////////////////////////////////////////
+    Function get() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Function m_function; ///< Selected implementation
+    bool     m_selected; ///< Was an implementation other than the fallback selected?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+#include <SFML/System/Cpu.inl>
+
+
+#endif // SFML_CPU_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::priv::Cpu
+/// \ingroup system
+///
+/// sf::priv::Cpu tells which instruction set extensions the
+/// processor that runs the program supports. Together with
+/// sf::priv::CpuDispatch, it lets the modules ship kernels
+/// for recent extensions in builds that target the baseline
+/// of an architecture (like the x86-64 packages of Linux
+/// distributions), and pick them only where they run.
+///
+/// The kernels using extensions that the build doesn't enable
+/// are marked with SFML_CPU_TARGET, and selected once:
+/// \code
+/// typedef void (*SwapFunction)(sf::Uint32*, std::size_t);
+///
+/// SFML_CPU_TARGET("avx2") void swapAvx2(sf::Uint32* data, std::size_t count) {...}
+/// SFML_CPU_TARGET("ssse3") void swapSsse3(sf::Uint32* data, std::size_t count) {...}
+/// void swapScalar(sf::Uint32* data, std::size_t count) {...}
+///
+/// const sf::priv::CpuDispatch<SwapFunction> swapBytes =
+///     sf::priv::CpuDispatch<SwapFunction>(swapScalar).add(sf::priv::Cpu::Avx2, swapAvx2)
+///                                                   .add(sf::priv::Cpu::Ssse3, swapSsse3);
+///
+/// swapBytes.get()(data, count);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -26,14 +26,17 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
 #include <streambuf>
+#include <string>
 #include <cstdio>
 
 
 namespace
 {
 // This class will be used as the default streambuf of sf::Err,
-// it outputs to stderr by default (to keep the default behavior)
+// it sends every flushed line to sf::Log, which outputs to stderr
+// by default (to keep the default behavior)
 class DefaultErrStreamBuf : public std::streambuf
 {
 public:
@@ -41,7 +44,7 @@ public:
     DefaultErrStreamBuf()
     {
         // Allocate the write buffer
-        static const int size = 64;
+        static const int size = 256;
         char* buffer = new char[size];
         setp(buffer, buffer + size);
     }
@@ -59,39 +62,38 @@ private:
 
     virtual int overflow(int character)
     {
-        if ((character != EOF) && (pptr() != epptr()))
-        {
-            // Valid character
+        // Not enough space in the buffer: move its contents to the current message
+        m_message.append(pbase(), pptr());
+        setp(pbase(), epptr());
+
+        if (character != EOF)
             return sputc(static_cast<char>(character));
-        }
-        else if (character != EOF)
-        {
-            // Not enough space in the buffer: synchronize output and try again
-            sync();
-            return overflow(character);
-        }
-        else
-        {
-            // Invalid character: synchronize output
-            return sync();
-        }
+
+        return 0;
     }
 
     virtual int sync()
     {
-        // Check if there is something into the write buffer
-        if (pbase() != pptr())
+        m_message.append(pbase(), pptr());
+        setp(pbase(), epptr());
+
+        // The trailing newline is implied by the log
+        std::string::size_type end = m_message.find_last_not_of('\n');
+        if (end != std::string::npos)
         {
-            // Print the contents of the write buffer into the standard error output
-            std::size_t size = static_cast<int>(pptr() - pbase());
-            fwrite(pbase(), 1, size, stderr);
+            m_message.erase(end + 1);
 
-            // Reset the pointer position to the beginning of the write buffer
-            setp(pbase(), epptr());
+            // SFML's warnings all start with "Warning"
+            sf::Log::Level level = (m_message.compare(0, 7, "Warning") == 0) ? sf::Log::Warning : sf::Log::Error;
+            sf::Log::write(level, m_message);
         }
 
+        m_message.clear();
+
         return 0;
     }
+
+    std::string m_message; ///< Message being written, sent to the log on the next synchronization
 };
 }
 
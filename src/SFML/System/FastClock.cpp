@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FastClock.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Sleep.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ClockImpl.hpp>
+#else
+    #include <SFML/System/Unix/ClockImpl.hpp>
+#endif
+
+#if defined(SFML_SYSTEM_LINUX)
+    #include <fstream>
+    #include <string>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    #define SFML_CYCLE_COUNTER_X86
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #include <cpuid.h>
+    #include <x86intrin.h>
+    #define SFML_CYCLE_COUNTER_X86
+#elif defined(__GNUC__) && defined(__aarch64__)
+    #define SFML_CYCLE_COUNTER_ARM64
+#endif
+
+
+namespace
+{
+    // Counter selected on first use, and its calibrated frequency
+    struct Calibration
+    {
+        bool        cycleCounter;        // Is the processor's cycle counter used?
+        bool        serializing;         // Is the serializing variant (rdtscp) available?
+        sf::Uint64  frequency;           // Ticks per second
+        double      microsecondsPerTick; // Conversion factor of ticksToTime
+    };
+
+    Calibration calibration;
+    sf::Atomic<bool> calibrated(false);
+    sf::Mutex calibrationMutex;
+
+#if defined(SFML_CYCLE_COUNTER_X86)
+
+    // Execute cpuid, returns false if the leaf is not supported
+    bool cpuid(unsigned int leaf, unsigned int registers[4])
+    {
+        #if defined(_MSC_VER)
+
+            int info[4];
+            __cpuid(info, static_cast<int>(leaf & 0x80000000));
+            if (static_cast<unsigned int>(info[0]) < leaf)
+                return false;
+
+            __cpuid(info, static_cast<int>(leaf));
+            for (int i = 0; i < 4; ++i)
+                registers[i] = static_cast<unsigned int>(info[i]);
+
+            return true;
+
+        #else
+
+            return __get_cpuid(leaf, &registers[0], &registers[1], &registers[2], &registers[3]) != 0;
+
+        #endif
+    }
+
+    // The invariant TSC runs at a constant rate in all power states
+    bool hasReliableCycleCounter(bool& serializing)
+    {
+        unsigned int registers[4];
+
+        serializing = cpuid(0x80000001, registers) && (registers[3] & (1u << 27));
+
+        if (!cpuid(0x80000007, registers) || !(registers[3] & (1u << 8)))
+            return false;
+
+        #if defined(SFML_SYSTEM_LINUX)
+
+            // The kernel checks that the counters of all the processors are
+            // synchronized; don't use the TSC if it rejected it as a clock source
+            std::ifstream file("/sys/devices/system/clocksource/clocksource0/current_clocksource");
+            std::string source;
+            if ((file >> source) && (source != "tsc"))
+                return false;
+
+        #endif
+
+        return true;
+    }
+
+    sf::Uint64 readCycleCounter(bool serializing)
+    {
+        // rdtscp waits for the previous instructions to complete,
+        // so that they are not measured after the read
+        if (serializing)
+        {
+            unsigned int processor;
+            return __rdtscp(&processor);
+        }
+
+        return __rdtsc();
+    }
+
+#elif defined(SFML_CYCLE_COUNTER_ARM64)
+
+    // The generic timer is architecturally guaranteed to run at a constant frequency
+    bool hasReliableCycleCounter(bool& serializing)
+    {
+        serializing = false;
+        return true;
+    }
+
+    sf::Uint64 readCycleCounter(bool)
+    {
+        sf::Uint64 value;
+        __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(value) : : "memory");
+        return value;
+    }
+
+    sf::Uint64 readCycleCounterFrequency()
+    {
+        sf::Uint64 frequency;
+        __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(frequency));
+        return frequency;
+    }
+
+#else
+
+    bool hasReliableCycleCounter(bool& serializing)
+    {
+        serializing = false;
+        return false;
+    }
+
+    sf::Uint64 readCycleCounter(bool)
+    {
+        return 0;
+    }
+
+#endif
+
+    // Select the counter and measure its frequency
+    void calibrate()
+    {
+        calibration.cycleCounter = hasReliableCycleCounter(calibration.serializing);
+        calibration.frequency = sf::priv::ClockImpl::getTickFrequency();
+
+        #if defined(SFML_CYCLE_COUNTER_ARM64)
+
+            calibration.frequency = readCycleCounterFrequency();
+
+        #else
+
+            if (calibration.cycleCounter)
+            {
+                // Count the cycles during a short period of the system clock; each pair
+                // of counters is read back to back, so that they describe the same instant
+                sf::Uint64 systemStart = sf::priv::ClockImpl::getCurrentTicks();
+                sf::Uint64 cycleStart = readCycleCounter(calibration.serializing);
+
+                sf::sleep(sf::milliseconds(10));
+
+                sf::Uint64 systemEnd = sf::priv::ClockImpl::getCurrentTicks();
+                sf::Uint64 cycleEnd = readCycleCounter(calibration.serializing);
+
+                double systemSeconds = static_cast<double>(systemEnd - systemStart) / static_cast<double>(calibration.frequency);
+                calibration.frequency = static_cast<sf::Uint64>(static_cast<double>(cycleEnd - cycleStart) / systemSeconds);
+
+                // A counter that doesn't move is not usable
+                if (calibration.frequency == 0)
+                {
+                    calibration.cycleCounter = false;
+                    calibration.frequency = sf::priv::ClockImpl::getTickFrequency();
+                }
+            }
+
+        #endif
+
+        calibration.microsecondsPerTick = 1000000.0 / static_cast<double>(calibration.frequency);
+    }
+
+    // Calibrate the clock on first use
+    const Calibration& getCalibration()
+    {
+        if (!calibrated.load(sf::Memory::Acquire))
+        {
+            sf::Lock lock(calibrationMutex);
+
+            if (!calibrated.load(sf::Memory::Relaxed))
+            {
+                calibrate();
+                calibrated.store(true, sf::Memory::Release);
+            }
+        }
+
+        return calibration;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FastClock::FastClock() :
+m_startTicks(getTicks())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Time FastClock::getElapsedTime() const
+{
+    return ticksToTime(getElapsedTicks());
+}
+
+
+////////////////////////////////////////////////////////////
+Time FastClock::restart()
+{
+    Uint64 now = getTicks();
+    Uint64 elapsed = now - m_startTicks;
+    m_startTicks = now;
+
+    return ticksToTime(elapsed);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FastClock::getElapsedTicks() const
+{
+    return getTicks() - m_startTicks;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FastClock::getTicks()
+{
+    const Calibration& current = getCalibration();
+
+    if (current.cycleCounter)
+        return readCycleCounter(current.serializing);
+
+    return priv::ClockImpl::getCurrentTicks();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FastClock::getTickFrequency()
+{
+    return getCalibration().frequency;
+}
+
+
+////////////////////////////////////////////////////////////
+Time FastClock::ticksToTime(Uint64 ticks)
+{
+    return microseconds(static_cast<Int64>(static_cast<double>(ticks) * getCalibration().microsecondsPerTick));
+}
+
+
+////////////////////////////////////////////////////////////
+bool FastClock::isCycleCounter()
+{
+    return getCalibration().cycleCounter;
+}
+
+} // namespace sf
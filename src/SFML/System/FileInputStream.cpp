@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/ArchiveInputStream.hpp>
 #ifdef ANDROID
 #include <SFML/System/Android/ResourceStream.hpp>
 #endif
@@ -35,7 +36,8 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 FileInputStream::FileInputStream()
-: m_file(NULL)
+: m_file(NULL),
+m_entry(NULL)
 {
 
 }
@@ -51,6 +53,7 @@ FileInputStream::~FileInputStream()
     if (m_file)
         std::fclose(m_file);
 #endif
+    delete m_entry;
 }
 
 
@@ -60,12 +63,27 @@ bool FileInputStream::open(const std::string& filename)
 #ifdef ANDROID
     if (m_file)
         delete m_file;
-    m_file = new priv::ResourceStream(filename);
-    return m_file->tell() != -1;
+    m_file = NULL;
 #else
     if (m_file)
         std::fclose(m_file);
+    m_file = NULL;
+#endif
+
+    // Files of mounted archives take precedence over the disk
+    if (!m_entry)
+        m_entry = new ArchiveInputStream;
 
+    if (m_entry->open(filename))
+        return true;
+
+    delete m_entry;
+    m_entry = NULL;
+
+#ifdef ANDROID
+    m_file = new priv::ResourceStream(filename);
+    return m_file->tell() != -1;
+#else
     m_file = std::fopen(filename.c_str(), "rb");
 
     return m_file != NULL;
@@ -76,6 +94,9 @@ bool FileInputStream::open(const std::string& filename)
 ////////////////////////////////////////////////////////////
 Int64 FileInputStream::read(void* data, Int64 size)
 {
+    if (m_entry)
+        return m_entry->read(data, size);
+
 #ifdef ANDROID
     return m_file->read(data, size);
 #else
@@ -90,6 +111,9 @@ Int64 FileInputStream::read(void* data, Int64 size)
 ////////////////////////////////////////////////////////////
 Int64 FileInputStream::seek(Int64 position)
 {
+    if (m_entry)
+        return m_entry->seek(position);
+
 #ifdef ANDROID
     return m_file->seek(position);
 #else
@@ -111,6 +135,9 @@ Int64 FileInputStream::seek(Int64 position)
 ////////////////////////////////////////////////////////////
 Int64 FileInputStream::tell()
 {
+    if (m_entry)
+        return m_entry->tell();
+
 #ifdef ANDROID
     return m_file->tell();
 #else
@@ -125,6 +152,9 @@ Int64 FileInputStream::tell()
 ////////////////////////////////////////////////////////////
 Int64 FileInputStream::getSize()
 {
+    if (m_entry)
+        return m_entry->getSize();
+
 #ifdef ANDROID
     return m_file->getSize();
 #else
@@ -0,0 +1,373 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Log.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/MpmcQueue.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstdio>
+#include <map>
+#include <sstream>
+
+
+namespace
+{
+    // A message waiting for the writer thread
+    struct Message
+    {
+        sf::Log::Level level;
+        std::string    text;
+        sf::Semaphore* flushed; // Posted when reached, NULL for regular messages
+    };
+
+    // Occurrences of an identical message during the current period
+    struct Repetitions
+    {
+        sf::Time       periodStart;
+        unsigned int   written;
+        unsigned int   suppressed;
+        sf::Log::Level level;
+    };
+
+    // The default sink, writing to the standard error output
+    class StandardErrorSink : public sf::Log::Sink
+    {
+    public:
+
+        virtual void write(sf::Log::Level, const std::string& message)
+        {
+            std::string line = message + '\n';
+            std::fwrite(line.data(), 1, line.size(), stderr);
+        }
+    };
+
+    void writeMessages();
+
+    struct LogState
+    {
+        LogState() :
+        queue         (1024),
+        pending       (0),
+        level         (sf::Log::Info),
+        started       (false),
+        stopped       (false),
+        dropped       (0),
+        thread        (&writeMessages),
+        sink          (&standardError),
+        rateCount     (10),
+        ratePeriod    (sf::seconds(1)),
+        lastDropReport(sf::Time::Zero)
+        {
+        }
+
+        sf::MpmcQueue<Message*>            queue;          // Messages waiting for the writer thread
+        sf::Semaphore                      pending;        // Posted for every queued message
+        sf::Atomic<int>                    level;          // Minimum level of the messages to write
+        sf::Atomic<bool>                   started;        // Was the writer thread launched?
+        sf::Atomic<bool>                   stopped;        // Are messages written synchronously, after the writer thread ended?
+        sf::Atomic<sf::Uint32>             dropped;        // Messages which didn't fit in the queue since the last report
+        sf::Thread                         thread;         // Writer thread
+        sf::Mutex                          mutex;          // Protects the launch of the thread, the sink and the repetitions
+        StandardErrorSink                  standardError;  // Default sink
+        sf::Log::Sink*                     sink;           // Current sink
+        unsigned int                       rateCount;      // Identical messages written per period
+        sf::Time                           ratePeriod;     // Duration of a rate limiting period
+        sf::Clock                          clock;          // Time base of the rate limiting periods
+        sf::Time                           lastDropReport; // Time of the last report of dropped messages
+        std::map<std::string, Repetitions> repetitions;    // Occurrences of the messages written recently
+    };
+
+    // The state is never destroyed, so that messages written during
+    // the destruction of other static objects are still handled
+    LogState& getState()
+    {
+        static LogState* state = new LogState;
+        return *state;
+    }
+
+    // Report the identical messages that were suppressed during a period; the mutex must be locked
+    void reportSuppressed(LogState& state, const std::string& text, const Repetitions& repetitions)
+    {
+        if (repetitions.suppressed == 0)
+            return;
+
+        std::ostringstream stream;
+        stream << text << " (repeated " << repetitions.suppressed << " more time" << (repetitions.suppressed > 1 ? "s" : "") << ")";
+        state.sink->write(repetitions.level, stream.str());
+    }
+
+    // Write a message to the sink, unless it is repeated too often
+    void output(LogState& state, sf::Log::Level level, const std::string& text)
+    {
+        sf::Lock lock(state.mutex);
+
+        if (state.rateCount > 0)
+        {
+            sf::Time now = state.clock.getElapsedTime();
+            std::map<std::string, Repetitions>::iterator it = state.repetitions.find(text);
+
+            if (it == state.repetitions.end())
+            {
+                Repetitions repetitions = {now, 1, 0, level};
+                state.repetitions.insert(std::make_pair(text, repetitions));
+            }
+            else if (now - it->second.periodStart >= state.ratePeriod)
+            {
+                reportSuppressed(state, text, it->second);
+                it->second.periodStart = now;
+                it->second.written = 1;
+                it->second.suppressed = 0;
+            }
+            else if (it->second.written < state.rateCount)
+            {
+                ++it->second.written;
+            }
+            else
+            {
+                ++it->second.suppressed;
+                return;
+            }
+        }
+
+        state.sink->write(level, text);
+    }
+
+    // Report and forget the messages whose period ended
+    void expireRepetitions(LogState& state)
+    {
+        sf::Lock lock(state.mutex);
+
+        sf::Time now = state.clock.getElapsedTime();
+        std::map<std::string, Repetitions>::iterator it = state.repetitions.begin();
+        while (it != state.repetitions.end())
+        {
+            if (now - it->second.periodStart >= state.ratePeriod)
+            {
+                reportSuppressed(state, it->first, it->second);
+                state.repetitions.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Write all the queued messages
+    void drain(LogState& state)
+    {
+        Message* message;
+        while (state.queue.pop(message))
+        {
+            if (message->flushed)
+                message->flushed->post();
+            else
+                output(state, message->level, message->text);
+
+            delete message;
+        }
+    }
+
+    // Report the messages which didn't fit in the queue, at most once per rate limiting period
+    void reportDropped(LogState& state, bool force)
+    {
+        sf::Time now = state.clock.getElapsedTime();
+        if (!force && (now - state.lastDropReport < state.ratePeriod))
+            return;
+
+        sf::Uint32 dropped = state.dropped.exchange(0);
+        if (dropped > 0)
+        {
+            std::ostringstream stream;
+            stream << dropped << " log message" << (dropped > 1 ? "s were" : " was") << " dropped because the log queue was full";
+            output(state, sf::Log::Warning, stream.str());
+            state.lastDropReport = now;
+        }
+    }
+
+    // Entry point of the writer thread
+    void writeMessages()
+    {
+        LogState& state = getState();
+
+        while (!state.stopped.load(sf::Memory::Acquire))
+        {
+            // Wake up regularly to report the suppressed messages
+            state.pending.wait(sf::milliseconds(100));
+
+            drain(state);
+            reportDropped(state, false);
+            expireRepetitions(state);
+        }
+    }
+
+    // Launch the writer thread on first use
+    void launchWriter(LogState& state)
+    {
+        if (state.started.load(sf::Memory::Acquire))
+            return;
+
+        sf::Lock lock(state.mutex);
+
+        if (!state.started.load(sf::Memory::Relaxed))
+        {
+            // Mark the thread as launched first: an error reported while
+            // launching it would otherwise try to launch it again
+            state.started.store(true, sf::Memory::Release);
+
+            state.thread.setName("sfml-log");
+            state.thread.setPriority(sf::Thread::Low);
+            state.thread.launch();
+        }
+    }
+
+    // Stops the writer thread when the program exits, after writing the pending messages
+    struct LogShutdown
+    {
+        ~LogShutdown()
+        {
+            LogState& state = getState();
+
+            {
+                sf::Lock lock(state.mutex);
+                state.stopped.store(true, sf::Memory::Release);
+            }
+
+            if (state.started.load(sf::Memory::Acquire))
+            {
+                state.pending.post();
+                state.thread.wait();
+            }
+
+            // Messages queued while the thread was stopping, and the pending repetitions
+            drain(state);
+            reportDropped(state, true);
+            state.ratePeriod = sf::Time::Zero;
+            expireRepetitions(state);
+        }
+    };
+
+    LogShutdown logShutdown;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Log::Sink::~Sink()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::write(Level level, const std::string& message)
+{
+    LogState& state = getState();
+
+    if (level < state.level.load(Memory::Relaxed))
+        return;
+
+    if (state.stopped.load(Memory::Acquire))
+    {
+        output(state, level, message);
+        return;
+    }
+
+    launchWriter(state);
+
+    Message* queued = new Message;
+    queued->level = level;
+    queued->text = message;
+    queued->flushed = NULL;
+
+    if (!state.queue.push(queued))
+    {
+        delete queued;
+        state.dropped.fetchAdd(1);
+        return;
+    }
+
+    state.pending.post();
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::flush()
+{
+    LogState& state = getState();
+
+    if (!state.started.load(Memory::Acquire) || state.stopped.load(Memory::Acquire))
+        return;
+
+    Semaphore flushed;
+    Message* marker = new Message;
+    marker->level = Debug;
+    marker->flushed = &flushed;
+
+    // The marker must not be dropped: wait for room in the queue
+    while (!state.queue.push(marker))
+        sleep(milliseconds(1));
+
+    state.pending.post();
+    flushed.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setSink(Sink* sink)
+{
+    LogState& state = getState();
+    Lock lock(state.mutex);
+
+    state.sink = sink ? sink : &state.standardError;
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setLevel(Level level)
+{
+    getState().level.store(level, Memory::Relaxed);
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setRateLimit(unsigned int count, Time period)
+{
+    LogState& state = getState();
+    Lock lock(state.mutex);
+
+    state.rateCount = count;
+    state.ratePeriod = period;
+}
+
+} // namespace sf
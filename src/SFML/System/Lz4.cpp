@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Lz4.hpp>
+#include <SFML/Config.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Constants of the LZ4 block format
+    const std::size_t minMatch     = 4;  // Shortest match
+    const std::size_t lastLiterals = 5;  // The last bytes of a block are always literals
+    const std::size_t matchLimit   = 12; // The last match must start this far from the end
+    const std::size_t maxOffset    = 65535;
+    const unsigned int hashBits    = 16;
+
+    sf::Uint32 read32(const char* data)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    unsigned int hash(sf::Uint32 sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - hashBits);
+    }
+
+    // Encode a length exceeding the 4 bits of the token
+    void writeLength(std::vector<char>& output, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            output.push_back(static_cast<char>(255));
+
+        output.push_back(static_cast<char>(length));
+    }
+
+    // Append a sequence of literals followed by a match (none if matchLength is 0)
+    void writeSequence(std::vector<char>& output, const char* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+    {
+        std::size_t matchCode = matchLength ? matchLength - minMatch : 0;
+
+        unsigned char token = static_cast<unsigned char>(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+        output.push_back(static_cast<char>(token));
+
+        if (literalLength >= 15)
+            writeLength(output, literalLength - 15);
+
+        output.insert(output.end(), literals, literals + literalLength);
+
+        if (matchLength)
+        {
+            output.push_back(static_cast<char>(offset & 0xFF));
+            output.push_back(static_cast<char>(offset >> 8));
+
+            if (matchCode >= 15)
+                writeLength(output, matchCode - 15);
+        }
+    }
+
+    // Decode a length exceeding the 4 bits of the token
+    bool readLength(const unsigned char*& input, const unsigned char* end, std::size_t& length)
+    {
+        unsigned char byte;
+        do
+        {
+            if (input >= end)
+                return false;
+
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void lz4Compress(const char* input, std::size_t size, std::vector<char>& output)
+{
+    output.clear();
+    output.reserve(size + size / 255 + 16);
+
+    std::size_t anchor = 0;
+
+    if (size > matchLimit)
+    {
+        // Greedy parsing, remembering the last position of every 4-byte sequence
+        std::vector<Uint32> table(1 << hashBits, 0);
+        std::size_t position = 1;
+        table[hash(read32(input))] = 0;
+
+        while (position + matchLimit <= size)
+        {
+            Uint32 sequence = read32(input + position);
+            unsigned int key = hash(sequence);
+            std::size_t candidate = table[key];
+            table[key] = static_cast<Uint32>(position);
+
+            if ((candidate < position) && (position - candidate <= maxOffset) && (read32(input + candidate) == sequence))
+            {
+                // Extend the match, without touching the final literals
+                std::size_t length = minMatch;
+                while ((position + length < size - lastLiterals) && (input[candidate + length] == input[position + length]))
+                    ++length;
+
+                writeSequence(output, input + anchor, position - anchor, position - candidate, length);
+
+                position += length;
+                anchor = position;
+
+                if (position + matchLimit <= size)
+                    table[hash(read32(input + position - 2))] = static_cast<Uint32>(position - 2);
+            }
+            else
+            {
+                ++position;
+            }
+        }
+    }
+
+    writeSequence(output, input + anchor, size - anchor, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool lz4Decompress(const char* input, std::size_t size, char* output, std::size_t outputSize)
+{
+    const unsigned char* current = reinterpret_cast<const unsigned char*>(input);
+    const unsigned char* end = current + size;
+    std::size_t written = 0;
+
+    while (current < end)
+    {
+        unsigned char token = *current++;
+
+        // Literals
+        std::size_t literalLength = token >> 4;
+        if ((literalLength == 15) && !readLength(current, end, literalLength))
+            return false;
+
+        if ((literalLength > static_cast<std::size_t>(end - current)) || (literalLength > outputSize - written))
+            return false;
+
+        std::memcpy(output + written, current, literalLength);
+        current += literalLength;
+        written += literalLength;
+
+        // The last sequence has no match
+        if (current == end)
+            break;
+
+        // Match
+        if (end - current < 2)
+            return false;
+
+        std::size_t offset = current[0] | (current[1] << 8);
+        current += 2;
+
+        if ((offset == 0) || (offset > written))
+            return false;
+
+        std::size_t matchLength = token & 15;
+        if ((matchLength == 15) && !readLength(current, end, matchLength))
+            return false;
+
+        matchLength += minMatch;
+        if (matchLength > outputSize - written)
+            return false;
+
+        // Matches may overlap their own output, which repeats the bytes
+        const char* source = output + written - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(output + written, source, matchLength);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < matchLength; ++i)
+                output[written + i] = source[i];
+        }
+
+        written += matchLength;
+    }
+
+    return written == outputSize;
+}
+
+} // namespace priv
+
+} // namespace sf
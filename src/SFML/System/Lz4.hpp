@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_LZ4_HPP
+#define SFML_LZ4_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compress data to the LZ4 block format
+///
+/// \param input  Data to compress
+/// \param size   Size of the data, in bytes
+/// \param output Vector receiving the compressed block
+///
+////////////////////////////////////////////////////////////
+void lz4Compress(const char* input, std::size_t size, std::vector<char>& output);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a block in the LZ4 block format
+///
+/// The input is validated: a corrupted block makes the
+/// function fail, it never reads or writes out of bounds.
+///
+/// \param input      Compressed block
+/// \param size       Size of the compressed block, in bytes
+/// \param output     Buffer receiving the decompressed data
+/// \param outputSize Exact size of the decompressed data, in bytes
+///
+/// \return True if the block was decompressed to exactly \a outputSize bytes
+///
+////////////////////////////////////////////////////////////
+bool lz4Decompress(const char* input, std::size_t size, char* output, std::size_t outputSize);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_LZ4_HPP
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/ArchiveInputStream.hpp>
+#include <cstring>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/FileMappingImpl.hpp>
+#else
+    #include <SFML/System/Unix/FileMappingImpl.hpp>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MappedFileInputStream::MappedFileInputStream() :
+m_mapping(NULL),
+m_entry  (NULL),
+m_data   (NULL),
+m_size   (0),
+m_offset (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileInputStream::~MappedFileInputStream()
+{
+    delete m_mapping;
+    delete m_entry;
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileInputStream::open(const std::string& filename)
+{
+    delete m_mapping;
+    m_mapping = NULL;
+    m_data = NULL;
+    m_size = 0;
+    m_offset = 0;
+
+    // Files of mounted archives take precedence over the disk
+    if (!m_entry)
+        m_entry = new ArchiveInputStream;
+
+    if (m_entry->open(filename))
+    {
+        m_data = static_cast<const char*>(m_entry->getData());
+        m_size = m_entry->getSize();
+        return true;
+    }
+
+    delete m_entry;
+    m_entry = NULL;
+
+    priv::FileMappingImpl* mapping = new priv::FileMappingImpl;
+
+    if (!mapping->open(filename))
+    {
+        delete mapping;
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_data = static_cast<const char*>(mapping->getData());
+    m_size = mapping->getSize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileInputStream::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::read(void* data, Int64 size)
+{
+    if (!m_mapping && !m_entry)
+        return -1;
+
+    Int64 endPosition = m_offset + size;
+    Int64 count = endPosition <= m_size ? size : m_size - m_offset;
+
+    if (count > 0)
+    {
+        std::memcpy(data, m_data + m_offset, static_cast<std::size_t>(count));
+        m_offset += count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::seek(Int64 position)
+{
+    if (!m_mapping && !m_entry)
+        return -1;
+
+    m_offset = position < m_size ? position : m_size;
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::tell()
+{
+    if (!m_mapping && !m_entry)
+        return -1;
+
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::getSize()
+{
+    if (!m_mapping && !m_entry)
+        return -1;
+
+    return m_size;
+}
+
+} // namespace sf
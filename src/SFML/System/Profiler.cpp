@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/FastClock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/SpscQueue.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <fstream>
+#include <vector>
+
+
+namespace
+{
+    // A recorded zone
+    struct Zone
+    {
+        const char* name;
+        sf::Uint64  start;
+        sf::Uint64  end;
+    };
+
+    // Zones recorded by a single thread
+    struct ThreadZones
+    {
+        explicit ThreadZones(unsigned int threadId) :
+        id     (threadId),
+        pending(4096)
+        {
+        }
+
+        unsigned int          id;       // Thread identifier in the trace
+        sf::SpscQueue<Zone>   pending;  // Zones not collected yet, filled by the thread without locking
+        std::vector<Zone>     recorded; // Zones collected so far, protected by the global mutex
+    };
+
+    // Recording state shared by all threads
+    struct Recording
+    {
+        Recording() :
+        running(false)
+        {
+        }
+
+        ~Recording()
+        {
+            for (std::vector<ThreadZones*>::iterator it = threads.begin(); it != threads.end(); ++it)
+                delete *it;
+        }
+
+        sf::Atomic<bool>          running; // Are zones being recorded?
+        sf::Mutex                 mutex;   // Protects the thread list and the collected zones
+        std::vector<ThreadZones*> threads; // Zones of every thread that recorded one
+    };
+
+    Recording& getRecording()
+    {
+        static Recording recording;
+        return recording;
+    }
+
+    sf::ThreadLocalPtr<ThreadZones> currentThreadZones;
+
+    // Move the pending zones of a thread to its recorded zones; the global mutex must be locked
+    void collect(ThreadZones& zones)
+    {
+        Zone zone;
+        while (zones.pending.pop(zone))
+            zones.recorded.push_back(zone);
+    }
+
+    // Get the zones of the calling thread, create them on its first zone
+    ThreadZones& getThreadZones()
+    {
+        if (!currentThreadZones)
+        {
+            Recording& recording = getRecording();
+            sf::Lock lock(recording.mutex);
+
+            currentThreadZones = new ThreadZones(static_cast<unsigned int>(recording.threads.size()) + 1);
+            recording.threads.push_back(currentThreadZones);
+        }
+
+        return *currentThreadZones;
+    }
+
+    // Write a string as a JSON literal
+    void writeString(std::ostream& stream, const char* string)
+    {
+        stream << '"';
+
+        for (; *string; ++string)
+        {
+            if ((*string == '"') || (*string == '\\'))
+                stream << '\\' << *string;
+            else if (static_cast<unsigned char>(*string) >= 0x20)
+                stream << *string;
+        }
+
+        stream << '"';
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void Profiler::start()
+{
+    // Calibrate the clock now rather than inside the first zone
+    FastClock::getTickFrequency();
+
+    getRecording().running.store(true, Memory::Release);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::stop()
+{
+    getRecording().running.store(false, Memory::Release);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::isRunning()
+{
+    return getRecording().running.load(Memory::Acquire);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::clear()
+{
+    Recording& recording = getRecording();
+    Lock lock(recording.mutex);
+
+    for (std::vector<ThreadZones*>::iterator it = recording.threads.begin(); it != recording.threads.end(); ++it)
+    {
+        collect(**it);
+        (*it)->recorded.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::saveToFile(const std::string& filename)
+{
+    std::ofstream file(filename.c_str());
+    if (!file)
+    {
+        err() << "Failed to save profiler trace to \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    Recording& recording = getRecording();
+    Lock lock(recording.mutex);
+
+    // Times are written in microseconds, relative to the earliest zone
+    bool empty = true;
+    Uint64 origin = 0;
+    for (std::vector<ThreadZones*>::iterator it = recording.threads.begin(); it != recording.threads.end(); ++it)
+    {
+        collect(**it);
+
+        for (std::vector<Zone>::const_iterator zone = (*it)->recorded.begin(); zone != (*it)->recorded.end(); ++zone)
+        {
+            if (empty || (zone->start < origin))
+                origin = zone->start;
+            empty = false;
+        }
+    }
+
+    double microsecondsPerTick = 1000000.0 / static_cast<double>(FastClock::getTickFrequency());
+
+    file.precision(3);
+    file.setf(std::ios::fixed, std::ios::floatfield);
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    const char* separator = "\n";
+    for (std::vector<ThreadZones*>::iterator it = recording.threads.begin(); it != recording.threads.end(); ++it)
+    {
+        for (std::vector<Zone>::const_iterator zone = (*it)->recorded.begin(); zone != (*it)->recorded.end(); ++zone)
+        {
+            file << separator << "{\"name\":";
+            writeString(file, zone->name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << (*it)->id
+                 << ",\"ts\":"  << static_cast<double>(zone->start - origin) * microsecondsPerTick
+                 << ",\"dur\":" << static_cast<double>(zone->end - zone->start) * microsecondsPerTick << "}";
+            separator = ",\n";
+        }
+    }
+
+    file << "\n]}\n";
+
+    if (!file)
+    {
+        err() << "Failed to save profiler trace to \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ProfileScope::ProfileScope(const char* name) :
+m_name (getRecording().running.load(Memory::Relaxed) ? name : NULL),
+m_start(m_name ? FastClock::getTicks() : 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ProfileScope::~ProfileScope()
+{
+    if (!m_name)
+        return;
+
+    Zone zone;
+    zone.name = m_name;
+    zone.start = m_start;
+    zone.end = FastClock::getTicks();
+
+    ThreadZones& zones = getThreadZones();
+
+    // When the buffer is full, this thread becomes its consumer for a while
+    if (!zones.pending.push(zone))
+    {
+        Lock lock(getRecording().mutex);
+        collect(zones);
+        zones.pending.push(zone);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
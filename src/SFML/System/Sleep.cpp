@@ -28,8 +28,10 @@
 #include <SFML/System/Sleep.hpp>
 
 #if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ClockImpl.hpp>
     #include <SFML/System/Win32/SleepImpl.hpp>
 #else
+    #include <SFML/System/Unix/ClockImpl.hpp>
     #include <SFML/System/Unix/SleepImpl.hpp>
 #endif
 
@@ -43,4 +45,16 @@ void sleep(Time duration)
         priv::sleepImpl(duration);
 }
 
+
+////////////////////////////////////////////////////////////
+void sleepUntil(const Clock& clock, Time deadline)
+{
+    // Convert the deadline to the time base of the system clock;
+    // both clocks are read back to back, so the error is negligible
+    Time remaining = deadline - clock.getElapsedTime();
+
+    if (remaining > Time::Zero)
+        priv::sleepUntilImpl(priv::ClockImpl::getCurrentTime() + remaining);
+}
+
 } // namespace sf
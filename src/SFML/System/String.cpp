@@ -27,10 +27,127 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/System/String.hpp>
 #include <SFML/System/Utf.hpp>
+#include <SFML/System/Cpu.hpp>
+#include <algorithm>
 #include <iterator>
 #include <cstring>
 
 
+namespace
+{
+    // Number of characters converted at once by the vectorized paths
+    const std::size_t blockSize = 16;
+
+    // Convert 16 UTF-8 bytes to UTF-32 if they are all ASCII, return false otherwise
+    bool decodeAsciiBlock(const sf::Uint8* input, sf::Uint32* output)
+    {
+    #if defined(SFML_CPU_SSE2)
+
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        if (_mm_movemask_epi8(bytes) != 0)
+            return false;
+
+        const __m128i zero = _mm_setzero_si128();
+        __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output),      _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 4),  _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 8),  _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 12), _mm_unpackhi_epi16(high, zero));
+
+        return true;
+
+    #elif defined(SFML_CPU_NEON) && defined(SFML_CPU_ARM64)
+
+        // The horizontal maximum only exists on ARM64
+        uint8x16_t bytes = vld1q_u8(input);
+        if (vmaxvq_u8(bytes) >= 0x80)
+            return false;
+
+        uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+        uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+        vst1q_u32(output,      vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(output + 4,  vmovl_u16(vget_high_u16(low)));
+        vst1q_u32(output + 8,  vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(output + 12, vmovl_u16(vget_high_u16(high)));
+
+        return true;
+
+    #else
+
+        sf::Uint8 bits = 0;
+        for (std::size_t i = 0; i < blockSize; ++i)
+            bits |= input[i];
+
+        if (bits >= 0x80)
+            return false;
+
+        for (std::size_t i = 0; i < blockSize; ++i)
+            output[i] = input[i];
+
+        return true;
+
+    #endif
+    }
+
+    // Convert 16 UTF-32 characters to single bytes if they are all ASCII, return false otherwise
+    template <typename T>
+    bool encodeAsciiBlock(const sf::Uint32* input, T* output)
+    {
+    #if defined(SFML_CPU_SSE2)
+
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 4));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 8));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 12));
+
+        __m128i bits = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        __m128i nonAscii = _mm_and_si128(bits, _mm_set1_epi32(~0x7F));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, _mm_setzero_si128())) != 0xFFFF)
+            return false;
+
+        // Values are below 0x80, the saturating packs don't alter them
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), bytes);
+
+        return true;
+
+    #elif defined(SFML_CPU_NEON) && defined(SFML_CPU_ARM64)
+
+        uint32x4_t a = vld1q_u32(input);
+        uint32x4_t b = vld1q_u32(input + 4);
+        uint32x4_t c = vld1q_u32(input + 8);
+        uint32x4_t d = vld1q_u32(input + 12);
+
+        uint32x4_t bits = vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d));
+        if (vmaxvq_u32(bits) >= 0x80)
+            return false;
+
+        uint16x8_t low = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+        uint16x8_t high = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+        vst1q_u8(reinterpret_cast<uint8_t*>(output), vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+
+        return true;
+
+    #else
+
+        sf::Uint32 bits = 0;
+        for (std::size_t i = 0; i < blockSize; ++i)
+            bits |= input[i];
+
+        if (bits >= 0x80)
+            return false;
+
+        for (std::size_t i = 0; i < blockSize; ++i)
+            output[i] = static_cast<T>(input[i]);
+
+        return true;
+
+    #endif
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -153,8 +270,26 @@ std::string String::toAnsiString(const std::locale& locale) const
     std::string output;
     output.reserve(m_string.length() + 1);
 
-    // Convert
-    Utf32::toAnsi(m_string.begin(), m_string.end(), std::back_inserter(output), 0, locale);
+    // Convert, copying runs of ASCII characters directly: all the
+    // supported locales are supersets of ASCII
+    const Uint32* begin = m_string.data();
+    const Uint32* end = begin + m_string.length();
+    char block[blockSize];
+
+    while (begin < end)
+    {
+        if ((end - begin >= static_cast<std::ptrdiff_t>(blockSize)) && encodeAsciiBlock(begin, block))
+        {
+            output.append(block, blockSize);
+            begin += blockSize;
+        }
+        else
+        {
+            const Uint32* blockEnd = std::min(begin + blockSize, end);
+            Utf32::toAnsi(begin, blockEnd, std::back_inserter(output), 0, locale);
+            begin = blockEnd;
+        }
+    }
 
     return output;
 }
@@ -181,8 +316,25 @@ std::basic_string<Uint8> String::toUtf8() const
     std::basic_string<Uint8> output;
     output.reserve(m_string.length());
 
-    // Convert
-    Utf32::toUtf8(m_string.begin(), m_string.end(), std::back_inserter(output));
+    // Convert, copying runs of ASCII characters directly
+    const Uint32* begin = m_string.data();
+    const Uint32* end = begin + m_string.length();
+    Uint8 block[blockSize];
+
+    while (begin < end)
+    {
+        if ((end - begin >= static_cast<std::ptrdiff_t>(blockSize)) && encodeAsciiBlock(begin, block))
+        {
+            output.append(block, blockSize);
+            begin += blockSize;
+        }
+        else
+        {
+            const Uint32* blockEnd = std::min(begin + blockSize, end);
+            Utf32::toUtf8(begin, blockEnd, std::back_inserter(output));
+            begin = blockEnd;
+        }
+    }
 
     return output;
 }
@@ -346,6 +498,38 @@ String::ConstIterator String::end() const
 }
 
 
+////////////////////////////////////////////////////////////
+void String::decodeUtf8(const Uint8* begin, const Uint8* end, std::basic_string<Uint32>& output)
+{
+    if (begin >= end)
+        return;
+
+    // The UTF-32 string can't be longer than the UTF-8 one; the leftover is trimmed at the end
+    std::size_t start = output.length();
+    output.resize(start + (end - begin));
+    Uint32* current = &output[0] + start;
+
+    while (begin < end)
+    {
+        if ((end - begin >= static_cast<std::ptrdiff_t>(blockSize)) && decodeAsciiBlock(begin, current))
+        {
+            begin += blockSize;
+            current += blockSize;
+        }
+        else
+        {
+            // Decode the next block character by character; a multi-byte
+            // character may end a few bytes past the end of the block
+            const Uint8* blockEnd = std::min(begin + blockSize, end);
+            while (begin < blockEnd)
+                begin = Utf8::decode(begin, end, *current++);
+        }
+    }
+
+    output.resize(current - &output[0]);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool operator ==(const String& left, const String& right)
 {
@@ -77,6 +77,48 @@ void Thread::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+void Thread::setPriority(Priority priority)
+{
+    m_priority = priority;
+}
+
+
+////////////////////////////////////////////////////////////
+Thread::Priority Thread::getPriority() const
+{
+    return m_priority;
+}
+
+
+////////////////////////////////////////////////////////////
+void Thread::setAffinity(Uint64 processorMask)
+{
+    m_affinity = processorMask;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Thread::getAffinity() const
+{
+    return m_affinity;
+}
+
+
+////////////////////////////////////////////////////////////
+void Thread::setName(const std::string& name)
+{
+    m_name = name;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Thread::getName() const
+{
+    return m_name;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Thread::run()
 {
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/ThreadLocal.hpp>
+#include <SFML/System/Atomic.hpp>
 
 #if defined(SFML_SYSTEM_WINDOWS)
     #include <SFML/System/Win32/ThreadLocalImpl.hpp>
@@ -33,13 +34,47 @@
     #include <SFML/System/Unix/ThreadLocalImpl.hpp>
 #endif
 
+// Compiler supported thread-local storage avoids a call to the OS for every access
+#if defined(_MSC_VER)
+    #define SFML_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) && !defined(SFML_SYSTEM_IOS)
+    #define SFML_THREAD_LOCAL __thread
+#endif
+
+
+namespace
+{
+#if defined(SFML_THREAD_LOCAL)
+
+    // Slots are handed out to the first variables created and never reused,
+    // so that a new variable can't see the values a thread stored in an old one.
+    // The variables created once they are exhausted fall back to the OS storage
+    const sf::Int32 slotCount = 64;
+    SFML_THREAD_LOCAL void* threadLocalSlots[slotCount];
+
+    // Constant-initialized, variables may be constructed before dynamic initialization reaches this file
+    volatile sf::Int32 nextSlot = 0;
+
+#endif
+}
+
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-ThreadLocal::ThreadLocal(void* value)
+ThreadLocal::ThreadLocal(void* value) :
+m_impl(NULL),
+m_slot(-1)
 {
-    m_impl = new priv::ThreadLocalImpl;
+#if defined(SFML_THREAD_LOCAL)
+    Int32 slot = priv::atomicFetchAdd(&nextSlot, 1, Memory::Relaxed);
+    if ((slot >= 0) && (slot < slotCount))
+        m_slot = slot;
+#endif
+
+    if (m_slot < 0)
+        m_impl = new priv::ThreadLocalImpl;
+
     setValue(value);
 }
 
@@ -54,6 +89,14 @@ ThreadLocal::~ThreadLocal()
 ////////////////////////////////////////////////////////////
 void ThreadLocal::setValue(void* value)
 {
+#if defined(SFML_THREAD_LOCAL)
+    if (m_slot >= 0)
+    {
+        threadLocalSlots[m_slot] = value;
+        return;
+    }
+#endif
+
     m_impl->setValue(value);
 }
 
@@ -61,6 +104,11 @@ void ThreadLocal::setValue(void* value)
 ////////////////////////////////////////////////////////////
 void* ThreadLocal::getValue() const
 {
+#if defined(SFML_THREAD_LOCAL)
+    if (m_slot >= 0)
+        return threadLocalSlots[m_slot];
+#endif
+
     return m_impl->getValue();
 }
 
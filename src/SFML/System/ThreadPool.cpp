@@ -0,0 +1,482 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ThreadPool.hpp>
+#include <SFML/System/FastLock.hpp>
+#include <algorithm>
+#include <deque>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/SemaphoreImpl.hpp>
+    #include <SFML/System/Win32/ThreadImpl.hpp>
+#else
+    #include <SFML/System/Unix/SemaphoreImpl.hpp>
+    #include <SFML/System/Unix/ThreadImpl.hpp>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+struct TaskState
+{
+    TaskState(ThreadPool& owner, ThreadFunc* function) :
+    pool        (owner),
+    job         (function),
+    references  (2),
+    dependencies(0),
+    done        (false),
+    dependents  (),
+    waiters     ()
+    {
+    }
+
+    ThreadPool&                 pool;         ///< Pool running the task
+    ThreadFunc*                 job;          ///< Job to run, destroyed once it has run
+    unsigned int                references;   ///< Number of handles to the task, plus one for the pool until the job has run
+    std::size_t                 dependencies; ///< Number of dependencies not finished yet
+    bool                        done;         ///< Has the job run?
+    std::vector<TaskState*>     dependents;   ///< Tasks waiting for this one
+    std::vector<SemaphoreImpl*> waiters;      ///< Semaphores of the threads waiting for this task
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+struct ThreadPool::Worker
+{
+    Worker(ThreadPool& owner, std::size_t workerIndex) :
+    pool  (owner),
+    index (workerIndex),
+    thread(&Worker::run, this),
+    mutex (),
+    tasks ()
+    {
+        thread.setName("sfml-worker");
+    }
+
+    void run()
+    {
+        pool.run(*this);
+    }
+
+    ThreadPool&                  pool;   ///< Pool owning the worker
+    std::size_t                  index;  ///< Index of the worker in the pool
+    Thread                       thread; ///< Thread of the worker
+    FastMutex                    mutex;  ///< Mutex protecting the queue
+    std::deque<priv::TaskState*> tasks;  ///< Tasks ready to run, the owner takes the newest and the others steal the oldest
+};
+
+
+namespace
+{
+    // Drop a reference to a task, the mutex of its pool must be locked
+    void release(priv::TaskState* state)
+    {
+        if (--state->references == 0)
+            delete state;
+    }
+
+    // Remove a semaphore from a list, if it is still there
+    void removeSemaphore(std::vector<priv::SemaphoreImpl*>& semaphores, priv::SemaphoreImpl* semaphore)
+    {
+        semaphores.erase(std::remove(semaphores.begin(), semaphores.end(), semaphore), semaphores.end());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task() :
+m_state(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task(const Task& copy) :
+m_state(copy.m_state)
+{
+    if (m_state)
+    {
+        FastLock lock(m_state->pool.m_mutex);
+        ++m_state->references;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::Task(priv::TaskState* state) :
+m_state(state)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task::~Task()
+{
+    if (m_state)
+    {
+        FastLock lock(m_state->pool.m_mutex);
+        release(m_state);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task& ThreadPool::Task::operator =(const Task& right)
+{
+    Task temp(right);
+    std::swap(m_state, temp.m_state);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::Task::isDone() const
+{
+    if (!m_state)
+        return true;
+
+    FastLock lock(m_state->pool.m_mutex);
+    return m_state->done;
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(unsigned int threadCount) :
+m_workers      (),
+m_currentWorker(),
+m_mutex        (),
+m_jobSemaphore (new priv::SemaphoreImpl),
+m_idleSemaphore(new priv::SemaphoreImpl),
+m_helpers      (),
+m_pendingCount (0),
+m_scheduleCount(0),
+m_waiterCount  (0),
+m_stopping     (false)
+{
+    if (threadCount == 0)
+        threadCount = getProcessorCount();
+
+    // Create all the queues before any worker starts stealing from them
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_workers.push_back(new Worker(*this, i));
+
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_workers[i]->thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        FastLock lock(m_mutex);
+        m_stopping = true;
+    }
+
+    // Wake up every worker so that it notices the pool is stopping
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        m_jobSemaphore->post();
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        m_workers[i]->thread.wait();
+
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+        delete m_workers[i];
+
+    delete m_idleSemaphore;
+    delete m_jobSemaphore;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::wait(const Task& task)
+{
+    priv::TaskState* state = task.m_state;
+    if (!state)
+        return;
+
+    Worker* self = static_cast<Worker*>(m_currentWorker.getValue());
+    priv::SemaphoreImpl semaphore;
+
+    for (;;)
+    {
+        unsigned long scheduleCount;
+        {
+            FastLock lock(m_mutex);
+
+            if (state->done)
+                return;
+
+            scheduleCount = m_scheduleCount;
+        }
+
+        // Help with the queued jobs rather than sitting idle
+        if (priv::TaskState* other = takeTask(self))
+        {
+            execute(other);
+            continue;
+        }
+
+        // Nothing to run: sleep until the task is done, or until a new job can be run,
+        // unless one was queued after we looked (all the workers may be waiting too)
+        {
+            FastLock lock(m_mutex);
+
+            if (state->done)
+                return;
+
+            if (scheduleCount != m_scheduleCount)
+                continue;
+
+            state->waiters.push_back(&semaphore);
+            m_helpers.push_back(&semaphore);
+        }
+
+        semaphore.wait();
+
+        {
+            FastLock lock(m_mutex);
+            removeSemaphore(state->waiters, &semaphore);
+            removeSemaphore(m_helpers, &semaphore);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::wait()
+{
+    // Help with the queued jobs rather than sitting idle
+    Worker* self = static_cast<Worker*>(m_currentWorker.getValue());
+    while (priv::TaskState* state = takeTask(self))
+        execute(state);
+
+    {
+        FastLock lock(m_mutex);
+
+        if (m_pendingCount == 0)
+            return;
+
+        ++m_waiterCount;
+    }
+
+    // The last job to finish posts the semaphore once per waiter
+    m_idleSemaphore->wait();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThreadPool::getThreadCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int ThreadPool::getProcessorCount()
+{
+    return priv::ThreadImpl::getProcessorCount();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::Task ThreadPool::enqueue(priv::ThreadFunc* job, const Task* dependencies, std::size_t count)
+{
+    // One reference for the pool, one for the returned task
+    priv::TaskState* state = new priv::TaskState(*this, job);
+    bool ready;
+    {
+        FastLock lock(m_mutex);
+
+        ++m_pendingCount;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            priv::TaskState* dependency = dependencies[i].m_state;
+            if (dependency && !dependency->done)
+            {
+                dependency->dependents.push_back(state);
+                ++state->dependencies;
+            }
+        }
+
+        // Otherwise the last dependency to finish queues it
+        ready = (state->dependencies == 0);
+        if (ready)
+            schedule(state);
+    }
+
+    if (ready)
+        m_jobSemaphore->post();
+
+    return Task(state);
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::schedule(priv::TaskState* state)
+{
+    // Jobs pushed by a worker stay on its queue, the others are spread among the workers
+    Worker* self = static_cast<Worker*>(m_currentWorker.getValue());
+    Worker& worker = self ? *self : *m_workers[m_scheduleCount % m_workers.size()];
+    {
+        FastLock lock(worker.mutex);
+        worker.tasks.push_back(state);
+    }
+
+    ++m_scheduleCount;
+
+    // Wake up a thread waiting for a task, the workers may all be waiting
+    if (!m_helpers.empty())
+    {
+        m_helpers.back()->post();
+        m_helpers.pop_back();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+priv::TaskState* ThreadPool::takeTask(Worker* self)
+{
+    // Take the newest task of our own queue, its data is most likely still in the cache
+    if (self)
+    {
+        FastLock lock(self->mutex);
+
+        if (!self->tasks.empty())
+        {
+            priv::TaskState* state = self->tasks.back();
+            self->tasks.pop_back();
+            return state;
+        }
+    }
+
+    // Otherwise steal the oldest task of another queue, starting after our own
+    std::size_t first = self ? self->index + 1 : 0;
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        Worker& victim = *m_workers[(first + i) % m_workers.size()];
+        if (&victim == self)
+            continue;
+
+        FastLock lock(victim.mutex);
+
+        if (!victim.tasks.empty())
+        {
+            priv::TaskState* state = victim.tasks.front();
+            victim.tasks.pop_front();
+            return state;
+        }
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::execute(priv::TaskState* state)
+{
+    state->job->run();
+    delete state->job;
+    state->job = NULL;
+
+    std::size_t ready = 0;
+    {
+        FastLock lock(m_mutex);
+
+        state->done = true;
+
+        for (std::vector<priv::SemaphoreImpl*>::iterator it = state->waiters.begin(); it != state->waiters.end(); ++it)
+            (*it)->post();
+        state->waiters.clear();
+
+        // Queue the dependents that were only waiting for this task
+
+        for (std::vector<priv::TaskState*>::iterator it = state->dependents.begin(); it != state->dependents.end(); ++it)
+        {
+            if (--(*it)->dependencies == 0)
+            {
+                schedule(*it);
+                ++ready;
+            }
+        }
+        state->dependents.clear();
+
+        release(state);
+
+        if (--m_pendingCount == 0)
+        {
+            for (; m_waiterCount > 0; --m_waiterCount)
+                m_idleSemaphore->post();
+        }
+    }
+
+    for (std::size_t i = 0; i < ready; ++i)
+        m_jobSemaphore->post();
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::run(Worker& self)
+{
+    m_currentWorker.setValue(&self);
+
+    for (;;)
+    {
+        m_jobSemaphore->wait();
+
+        // The queues may be empty if another thread took the job first
+        priv::TaskState* state = takeTask(&self);
+
+        if (!state)
+        {
+            FastLock lock(m_mutex);
+
+            if (m_stopping)
+                return;
+
+            continue;
+        }
+
+        // Keep running jobs until there is none left anywhere
+        do
+        {
+            execute(state);
+        }
+        while ((state = takeTask(&self)) != NULL);
+    }
+}
+
+} // namespace sf
@@ -59,6 +59,41 @@ Time ClockImpl::getCurrentTime()
 #endif
 }
 
+
+////////////////////////////////////////////////////////////
+Uint64 ClockImpl::getCurrentTicks()
+{
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    return mach_absolute_time();
+
+#else
+
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<Uint64>(time.tv_sec) * 1000000000 + static_cast<Uint64>(time.tv_nsec);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ClockImpl::getTickFrequency()
+{
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    // The timebase converts ticks to nanoseconds
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    return Uint64(1000000000) * timebase.denom / timebase.numer;
+
+#else
+
+    return 1000000000;
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
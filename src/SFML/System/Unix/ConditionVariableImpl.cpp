@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/ConditionVariableImpl.hpp>
+#include <SFML/System/Unix/FastMutexImpl.hpp>
+#include <SFML/System/Unix/MutexImpl.hpp>
+#include <algorithm>
+#include <errno.h>
+#include <time.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::ConditionVariableImpl()
+{
+    #if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+        // Mac OS X has relative timed waits instead of a configurable clock
+        pthread_cond_init(&m_condition, NULL);
+
+    #else
+
+        // Measure the timeouts with the monotonic clock, so that they
+        // are not affected by changes of the system time
+        pthread_condattr_t attributes;
+        pthread_condattr_init(&attributes);
+        pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+        pthread_cond_init(&m_condition, &attributes);
+        pthread_condattr_destroy(&attributes);
+
+    #endif
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::~ConditionVariableImpl()
+{
+    pthread_cond_destroy(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(MutexImpl& mutex)
+{
+    pthread_cond_wait(&m_condition, &mutex.m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(FastMutexImpl& mutex)
+{
+    pthread_cond_wait(&m_condition, &mutex.m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    return timedWait(mutex.m_mutex, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(FastMutexImpl& mutex, Time timeout)
+{
+    return timedWait(mutex.m_mutex, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyOne()
+{
+    pthread_cond_signal(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyAll()
+{
+    pthread_cond_broadcast(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::timedWait(pthread_mutex_t& mutex, Time timeout)
+{
+    Int64 microseconds = std::max(timeout.asMicroseconds(), Int64(0));
+
+    #if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+        timespec delay;
+        delay.tv_sec  = static_cast<time_t>(microseconds / 1000000);
+        delay.tv_nsec = static_cast<long>(microseconds % 1000000) * 1000;
+
+        return pthread_cond_timedwait_relative_np(&m_condition, &mutex, &delay) != ETIMEDOUT;
+
+    #else
+
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec  += static_cast<time_t>(microseconds / 1000000);
+        deadline.tv_nsec += static_cast<long>(microseconds % 1000000) * 1000;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec  += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        return pthread_cond_timedwait(&m_condition, &mutex, &deadline) != ETIMEDOUT;
+
+    #endif
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/FastMutexImpl.hpp>
+#include <SFML/System/Unix/ThreadImpl.hpp>
+
+
+namespace
+{
+    // Number of attempts to take the mutex before sleeping; spinning
+    // is pointless if the holder can't run at the same time
+    const int spinCount = (sf::priv::ThreadImpl::getProcessorCount() > 1) ? 100 : 0;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FastMutexImpl::FastMutexImpl()
+{
+    // The default type is not recursive, which makes it the cheapest one
+    pthread_mutex_init(&m_mutex, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+FastMutexImpl::~FastMutexImpl()
+{
+    pthread_mutex_destroy(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void FastMutexImpl::lock()
+{
+    // Critical sections are short, so the mutex is often released
+    // sooner than a sleeping thread would be woken up
+    for (int i = 0; i < spinCount; ++i)
+    {
+        if (pthread_mutex_trylock(&m_mutex) == 0)
+            return;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void FastMutexImpl::unlock()
+{
+    pthread_mutex_unlock(&m_mutex);
+}
+
+} // namespace priv
+
+} // namespace sf
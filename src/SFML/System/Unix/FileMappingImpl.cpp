@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/FileMappingImpl.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FileMappingImpl::FileMappingImpl() :
+m_data(NULL),
+m_size(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FileMappingImpl::~FileMappingImpl()
+{
+    if (m_data)
+        munmap(m_data, static_cast<std::size_t>(m_size));
+}
+
+
+////////////////////////////////////////////////////////////
+bool FileMappingImpl::open(const std::string& filename)
+{
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file == -1)
+        return false;
+
+    struct stat status;
+    if ((fstat(file, &status) == -1) || !S_ISREG(status.st_mode))
+    {
+        ::close(file);
+        return false;
+    }
+
+    m_size = static_cast<Int64>(status.st_size);
+
+    // Empty files can't be mapped, but they are valid streams
+    if (m_size > 0)
+    {
+        void* data = mmap(NULL, static_cast<std::size_t>(m_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (data == MAP_FAILED)
+        {
+            ::close(file);
+            m_size = 0;
+            return false;
+        }
+
+        m_data = data;
+    }
+
+    // The mapping stays valid once the descriptor is closed
+    ::close(file);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* FileMappingImpl::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 FileMappingImpl::getSize() const
+{
+    return m_size;
+}
+
+} // namespace priv
+
+} // namespace sf
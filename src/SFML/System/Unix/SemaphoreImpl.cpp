@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/SemaphoreImpl.hpp>
+#include <SFML/System/Unix/ClockImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SemaphoreImpl::SemaphoreImpl(unsigned int count) :
+m_mutex    (),
+m_condition(),
+m_count    (count)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::~SemaphoreImpl()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::post()
+{
+    m_mutex.lock();
+    ++m_count;
+    m_condition.notifyOne();
+    m_mutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::wait()
+{
+    m_mutex.lock();
+
+    // Guard against spurious wake-ups
+    while (m_count == 0)
+        m_condition.wait(m_mutex);
+
+    --m_count;
+    m_mutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::wait(Time timeout)
+{
+    Time deadline = ClockImpl::getCurrentTime() + timeout;
+
+    m_mutex.lock();
+
+    // Wake-ups can be spurious, wait again for the remaining time
+    while (m_count == 0)
+    {
+        Time remaining = deadline - ClockImpl::getCurrentTime();
+        if ((remaining <= Time::Zero) || !m_condition.wait(m_mutex, remaining))
+            break;
+    }
+
+    bool acquired = (m_count > 0);
+    if (acquired)
+        --m_count;
+
+    m_mutex.unlock();
+
+    return acquired;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::tryWait()
+{
+    m_mutex.lock();
+
+    bool acquired = (m_count > 0);
+    if (acquired)
+        --m_count;
+
+    m_mutex.unlock();
+
+    return acquired;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SEMAPHOREIMPL_HPP
+#define SFML_SEMAPHOREIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/ConditionVariableImpl.hpp>
+#include <SFML/System/Unix/FastMutexImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of counting semaphores
+///
+/// Unnamed POSIX semaphores are not available on every
+/// Unix flavour (macOS lacks them), so the counter is
+/// built from a pthread mutex and condition variable.
+///
+////////////////////////////////////////////////////////////
+class SemaphoreImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial value of the count
+    ///
+    ////////////////////////////////////////////////////////////
+    SemaphoreImpl(unsigned int count = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SemaphoreImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the count, waking up one waiting thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the count is positive, then decrement it
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the count is positive or the timeout
+    ///        expires, then decrement it if it is positive
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the count was decremented
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the count if it is positive, without blocking
+    ///
+    /// \return True if the count was decremented
+    ///
+    ////////////////////////////////////////////////////////////
+    bool tryWait();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FastMutexImpl         m_mutex;     ///< Mutex protecting the count
+    ConditionVariableImpl m_condition; ///< Condition signaled when the count is incremented
+    unsigned int          m_count;     ///< Current value of the semaphore
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHOREIMPL_HPP
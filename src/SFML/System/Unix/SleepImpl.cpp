@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Unix/SleepImpl.hpp>
+#include <SFML/System/Unix/ClockImpl.hpp>
 #include <errno.h>
 #include <time.h>
 
@@ -37,21 +38,48 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void sleepImpl(Time time)
 {
-    Uint64 usecs = time.asMicroseconds();
+    // Sleeping until an absolute time doesn't accumulate
+    // drift when the sleep is interrupted and resumed
+    sleepUntilImpl(ClockImpl::getCurrentTime() + time);
+}
+
+
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline)
+{
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID) || defined(SFML_SYSTEM_FREEBSD)
+
+    // ClockImpl measures CLOCK_MONOTONIC, which can be waited on directly
+    Uint64 usecs = deadline.asMicroseconds();
 
-    // Construct the time to wait
     timespec ti;
     ti.tv_nsec = (usecs % 1000000) * 1000;
     ti.tv_sec = usecs / 1000000;
 
-    // Wait...
-    // If nanosleep returns -1, we check errno. If it is EINTR
-    // nanosleep was interrupted and has set ti to the remaining
-    // duration. We continue sleeping until the complete duration
-    // has passed. We stop sleeping if it was due to an error.
-    while ((nanosleep(&ti, &ti) == -1) && (errno == EINTR))
+    // clock_nanosleep returns the error instead of setting errno; an
+    // interrupted absolute sleep can be restarted with the same deadline
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ti, NULL) == EINTR)
     {
     }
+
+#else
+
+    // Without clock_nanosleep, sleep for the remaining time until the deadline is reached
+    for (;;)
+    {
+        Int64 usecs = (deadline - ClockImpl::getCurrentTime()).asMicroseconds();
+        if (usecs <= 0)
+            break;
+
+        timespec ti;
+        ti.tv_nsec = (usecs % 1000000) * 1000;
+        ti.tv_sec = usecs / 1000000;
+
+        if ((nanosleep(&ti, NULL) == -1) && (errno != EINTR))
+            break;
+    }
+
+#endif
 }
 
 } // namespace priv
@@ -28,8 +28,151 @@
 #include <SFML/System/Unix/ThreadImpl.hpp>
 #include <SFML/System/Thread.hpp>
 #include <iostream>
+#include <cstring>
+#include <sched.h>
+#include <unistd.h>
 #include <cassert>
 
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+#elif defined(SFML_SYSTEM_FREEBSD)
+    #include <pthread_np.h>
+    #include <sys/cpuset.h>
+#elif defined(SFML_SYSTEM_OPENBSD)
+    #include <pthread_np.h>
+#endif
+
+
+namespace
+{
+    // Switch the calling thread to real-time scheduling; the priority is kept
+    // low within the real-time range, so that system threads still preempt it
+    bool setRealTimeScheduling()
+    {
+        int minimum = sched_get_priority_min(SCHED_FIFO);
+        int maximum = sched_get_priority_max(SCHED_FIFO);
+
+        sched_param parameters;
+        std::memset(&parameters, 0, sizeof(parameters));
+        parameters.sched_priority = minimum + (maximum - minimum) / 4;
+
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0;
+    }
+
+    // Change the priority of the calling thread, as much as it is allowed to
+    void setPriority(sf::Thread::Priority priority)
+    {
+        if (priority == sf::Thread::Normal)
+            return;
+
+        if (priority == sf::Thread::RealTime)
+        {
+            if (setRealTimeScheduling())
+                return;
+
+            priority = sf::Thread::Highest;
+        }
+
+        #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+
+            // The normal policy has no static priorities on Linux, but each
+            // thread has its own nice value, from 19 (lowest) to -20 (highest)
+            static const int niceValues[] = {19, 10, 0, -5, -10};
+            id_t thread = static_cast<id_t>(syscall(SYS_gettid));
+            int target = niceValues[priority];
+            int current = getpriority(PRIO_PROCESS, thread);
+
+            // Unprivileged threads can only go up to their RLIMIT_NICE
+            if (target > current)
+                setpriority(PRIO_PROCESS, thread, target);
+
+            for (int value = target; value < current; ++value)
+            {
+                if (setpriority(PRIO_PROCESS, thread, value) == 0)
+                    break;
+            }
+
+        #else
+
+            // Spread the priorities over the range of the current policy
+            int policy;
+            sched_param parameters;
+            if (pthread_getschedparam(pthread_self(), &policy, &parameters) != 0)
+                return;
+
+            int minimum = sched_get_priority_min(policy);
+            int maximum = sched_get_priority_max(policy);
+            if (maximum <= minimum)
+                return;
+
+            parameters.sched_priority = minimum + (maximum - minimum) * priority / sf::Thread::Highest;
+            pthread_setschedparam(pthread_self(), policy, &parameters);
+
+        #endif
+    }
+
+    // Restrict the calling thread to the processors of the mask
+    void setAffinity(sf::Uint64 mask)
+    {
+        if (mask == 0)
+            return;
+
+        #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int i = 0; (i < 64) && (i < CPU_SETSIZE); ++i)
+            {
+                if (mask & (sf::Uint64(1) << i))
+                    CPU_SET(i, &set);
+            }
+
+            // A pid of zero is the calling thread
+            sched_setaffinity(0, sizeof(set), &set);
+
+        #elif defined(SFML_SYSTEM_FREEBSD)
+
+            cpuset_t set;
+            CPU_ZERO(&set);
+            for (int i = 0; (i < 64) && (i < CPU_SETSIZE); ++i)
+            {
+                if (mask & (sf::Uint64(1) << i))
+                    CPU_SET(i, &set);
+            }
+
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+        #endif
+    }
+
+    // Change the name of the calling thread
+    void setName(const std::string& name)
+    {
+        if (name.empty())
+            return;
+
+        #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+
+            // Longer names are rejected, not truncated
+            char buffer[16];
+            std::strncpy(buffer, name.c_str(), sizeof(buffer) - 1);
+            buffer[sizeof(buffer) - 1] = '\0';
+            pthread_setname_np(pthread_self(), buffer);
+
+        #elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+            // Only the calling thread can be named
+            pthread_setname_np(name.c_str());
+
+        #elif defined(SFML_SYSTEM_FREEBSD) || defined(SFML_SYSTEM_OPENBSD)
+
+            pthread_set_name_np(pthread_self(), name.c_str());
+
+        #endif
+    }
+}
+
 
 namespace sf
 {
@@ -72,6 +215,15 @@ void ThreadImpl::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int ThreadImpl::getProcessorCount()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (count > 0) ? static_cast<unsigned int>(count) : 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void* ThreadImpl::entryPoint(void* userData)
 {
@@ -83,12 +235,24 @@ void* ThreadImpl::entryPoint(void* userData)
         pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
     #endif
 
+    // Apply the settings of the owner before running its function
+    configure(*owner);
+
     // Forward to the owner
     owner->run();
 
     return NULL;
 }
 
+
+////////////////////////////////////////////////////////////
+void ThreadImpl::configure(const Thread& owner)
+{
+    setName(owner.m_name);
+    setAffinity(owner.m_affinity);
+    setPriority(owner.m_priority);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -66,6 +66,14 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of processors available to the process
+    ///
+    /// \return Number of logical processors, at least 1
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getProcessorCount();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -78,6 +86,16 @@ private:
     ////////////////////////////////////////////////////////////
     static void* entryPoint(void* userData);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the priority, affinity and name of a thread
+    ///
+    /// This function is called by the thread itself when it starts.
+    ///
+    /// \param owner The Thread instance being run
+    ///
+    ////////////////////////////////////////////////////////////
+    static void configure(const Thread& owner);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
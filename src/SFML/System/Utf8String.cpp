@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Utf8String.hpp>
+#include <SFML/System/String.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String() :
+m_data    (m_local),
+m_size    (0),
+m_capacity(LocalCapacity)
+{
+    m_local[0] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const char* utf8) :
+m_data    (m_local),
+m_size    (0),
+m_capacity(LocalCapacity)
+{
+    m_local[0] = 0;
+
+    if (utf8)
+        append(utf8, std::strlen(utf8));
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const char* utf8, std::size_t size) :
+m_data    (m_local),
+m_size    (0),
+m_capacity(LocalCapacity)
+{
+    m_local[0] = 0;
+    append(utf8, size);
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const std::string& utf8) :
+m_data    (m_local),
+m_size    (0),
+m_capacity(LocalCapacity)
+{
+    m_local[0] = 0;
+    append(utf8.data(), utf8.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const String& string) :
+m_data    (m_local),
+m_size    (0),
+m_capacity(LocalCapacity)
+{
+    m_local[0] = 0;
+
+    std::basic_string<Uint8> utf8 = string.toUtf8();
+    append(reinterpret_cast<const char*>(utf8.data()), utf8.size());
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::Utf8String(const Utf8String& copy) :
+m_data    (m_local),
+m_size    (0),
+m_capacity(LocalCapacity)
+{
+    m_local[0] = 0;
+    append(copy.getData(), copy.m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::~Utf8String()
+{
+    if (m_data != m_local)
+        delete[] m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String& Utf8String::operator =(const Utf8String& right)
+{
+    if (this != &right)
+    {
+        clear();
+        append(right.getData(), right.m_size);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String& Utf8String::operator +=(const Utf8String& right)
+{
+    // Appending a string to itself must copy its bytes before reallocating
+    if (this == &right)
+    {
+        Utf8String copy(right);
+        append(copy.getData(), copy.m_size);
+    }
+    else
+    {
+        append(right.getData(), right.m_size);
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Utf8String::append(const char* utf8, std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    reserve(m_size + size);
+
+    std::memcpy(m_data + m_size, utf8, size);
+    m_size += size;
+    m_data[m_size] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Utf8String::clear()
+{
+    m_size = 0;
+    m_data[0] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Utf8String::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Utf8String::getLength() const
+{
+    return Utf8::count(m_data, m_data + m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Utf8String::isEmpty() const
+{
+    return m_size == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* Utf8String::getData() const
+{
+    return reinterpret_cast<const char*>(m_data);
+}
+
+
+////////////////////////////////////////////////////////////
+String Utf8String::toString() const
+{
+    return String::fromUtf8(getData(), getData() + m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+std::string Utf8String::toStdString() const
+{
+    return std::string(getData(), m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::ConstIterator Utf8String::begin() const
+{
+    return ConstIterator(m_data, m_data + m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8String::ConstIterator Utf8String::end() const
+{
+    return ConstIterator(m_data + m_size, m_data + m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+void Utf8String::reserve(std::size_t capacity)
+{
+    if (capacity <= m_capacity)
+        return;
+
+    // Grow geometrically so that repeated appends stay linear
+    std::size_t newCapacity = std::max(capacity, m_capacity * 2);
+    Uint8* data = new Uint8[newCapacity + 1];
+    std::memcpy(data, m_data, m_size + 1);
+
+    if (m_data != m_local)
+        delete[] m_data;
+
+    m_data = data;
+    m_capacity = newCapacity;
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator ==(const Utf8String& left, const Utf8String& right)
+{
+    return (left.getSize() == right.getSize()) && (std::memcmp(left.getData(), right.getData(), left.getSize()) == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator !=(const Utf8String& left, const Utf8String& right)
+{
+    return !(left == right);
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator <(const Utf8String& left, const Utf8String& right)
+{
+    // memcmp compares bytes as unsigned char, which keeps the code point order
+    std::size_t size = std::min(left.getSize(), right.getSize());
+    int result = std::memcmp(left.getData(), right.getData(), size);
+
+    return (result < 0) || ((result == 0) && (left.getSize() < right.getSize()));
+}
+
+} // namespace sf
@@ -58,6 +58,14 @@ Time ClockImpl::getCurrentTime()
     // (it is constant across the program lifetime)
     static LARGE_INTEGER frequency = getFrequency();
 
+    // Return the current time as microseconds
+    return sf::microseconds(static_cast<Int64>(1000000 * getCurrentTicks() / frequency.QuadPart));
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ClockImpl::getCurrentTicks()
+{
     // Detect if we are on Windows XP or older
     static bool oldWindows = isWindowsXpOrOlder();
 
@@ -79,8 +87,14 @@ Time ClockImpl::getCurrentTime()
         QueryPerformanceCounter(&time);
     }
 
-    // Return the current time as microseconds
-    return sf::microseconds(1000000 * time.QuadPart / frequency.QuadPart);
+    return static_cast<Uint64>(time.QuadPart);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ClockImpl::getTickFrequency()
+{
+    return static_cast<Uint64>(getFrequency().QuadPart);
 }
 
 } // namespace priv
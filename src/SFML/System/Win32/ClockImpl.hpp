@@ -51,6 +51,22 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Time getCurrentTime();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current value of the raw counter of the clock
+    ///
+    /// \return Current tick count
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getCurrentTicks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of ticks per second of the raw counter
+    ///
+    /// \return Frequency of the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTickFrequency();
 };
 
 } // namespace priv
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/ConditionVariableImpl.hpp>
+#include <SFML/System/Win32/FastMutexImpl.hpp>
+#include <SFML/System/Win32/MutexImpl.hpp>
+
+
+namespace
+{
+    // Round the timeout up to whole milliseconds, so that a wait never ends too early
+    DWORD toMilliseconds(sf::Time timeout)
+    {
+        sf::Int64 microseconds = timeout.asMicroseconds();
+        return (microseconds > 0) ? static_cast<DWORD>((microseconds + 999) / 1000) : 0;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::ConditionVariableImpl()
+{
+    InitializeConditionVariable(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+ConditionVariableImpl::~ConditionVariableImpl()
+{
+    // Nothing to do: condition variables don't own any resource
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(MutexImpl& mutex)
+{
+    SleepConditionVariableCS(&m_condition, &mutex.m_mutex, INFINITE);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::wait(FastMutexImpl& mutex)
+{
+    SleepConditionVariableSRW(&m_condition, &mutex.m_lock, INFINITE, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(MutexImpl& mutex, Time timeout)
+{
+    if (SleepConditionVariableCS(&m_condition, &mutex.m_mutex, toMilliseconds(timeout)))
+        return true;
+
+    return GetLastError() != ERROR_TIMEOUT;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariableImpl::wait(FastMutexImpl& mutex, Time timeout)
+{
+    if (SleepConditionVariableSRW(&m_condition, &mutex.m_lock, toMilliseconds(timeout), 0))
+        return true;
+
+    return GetLastError() != ERROR_TIMEOUT;
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyOne()
+{
+    WakeConditionVariable(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariableImpl::notifyAll()
+{
+    WakeAllConditionVariable(&m_condition);
+}
+
+} // namespace priv
+
+} // namespace sf
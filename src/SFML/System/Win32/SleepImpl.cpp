@@ -26,9 +26,58 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Win32/SleepImpl.hpp>
+#include <SFML/System/Win32/ClockImpl.hpp>
 #include <windows.h>
 
 
+namespace
+{
+    // Not defined by older SDKs, available since Windows 10 1803
+    #ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+        #define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+    #endif
+
+    typedef HANDLE (WINAPI* CreateWaitableTimerExWFuncType)(LPSECURITY_ATTRIBUTES, LPCWSTR, DWORD, DWORD);
+
+    // Sleep using a high-resolution waitable timer, returns false if they are not supported
+    bool highResolutionSleep(sf::Time time)
+    {
+        static bool loaded = false;
+        static CreateWaitableTimerExWFuncType CreateWaitableTimerExWFunc = NULL;
+
+        if (!loaded)
+        {
+            HMODULE kernel32Dll = GetModuleHandleW(L"kernel32.dll");
+
+            if (kernel32Dll)
+                CreateWaitableTimerExWFunc = reinterpret_cast<CreateWaitableTimerExWFuncType>(GetProcAddress(kernel32Dll, "CreateWaitableTimerExW"));
+
+            loaded = true;
+        }
+
+        if (!CreateWaitableTimerExWFunc)
+            return false;
+
+        HANDLE timer = CreateWaitableTimerExWFunc(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+        // Fails on systems that don't support the high-resolution flag
+        if (!timer)
+            return false;
+
+        // Negative values are relative, in 100 nanosecond units
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>(time.asMicroseconds() * 10);
+
+        bool success = SetWaitableTimer(timer, &dueTime, 0, NULL, NULL, FALSE) &&
+                       (WaitForSingleObject(timer, INFINITE) == WAIT_OBJECT_0);
+
+        CloseHandle(timer);
+
+        return success;
+    }
+}
+
+
 namespace sf
 {
 namespace priv
@@ -36,6 +85,11 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void sleepImpl(Time time)
 {
+    // High-resolution timers wait with sub-millisecond precision
+    // without changing the timer resolution of the whole system
+    if (highResolutionSleep(time))
+        return;
+
     // Get the supported timer resolutions on this system
     TIMECAPS tc;
     timeGetDevCaps(&tc, sizeof(TIMECAPS));
@@ -50,6 +104,23 @@ void sleepImpl(Time time)
     timeEndPeriod(tc.wPeriodMin);
 }
 
+
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline)
+{
+    // Waitable timers can't wait until a performance counter value:
+    // sleep for the remaining time, and check again in case the wait
+    // ended early (Sleep truncates to whole milliseconds)
+    for (;;)
+    {
+        Time remaining = deadline - ClockImpl::getCurrentTime();
+        if (remaining <= Time::Zero)
+            break;
+
+        sleepImpl(remaining);
+    }
+}
+
 } // namespace priv
 
 } // namespace sf
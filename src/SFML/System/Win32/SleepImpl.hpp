@@ -44,6 +44,14 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void sleepImpl(Time time);
 
+////////////////////////////////////////////////////////////
+/// \brief Windows implementation of sf::sleepUntil
+///
+/// \param deadline Time at which to wake up, in the time base of ClockImpl::getCurrentTime
+///
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline);
+
 } // namespace priv
 
 } // namespace sf
@@ -30,6 +30,60 @@
 #include <SFML/System/Err.hpp>
 #include <cassert>
 #include <process.h>
+#include <vector>
+
+
+namespace
+{
+    // SetThreadDescription only exists since Windows 10 1607, load it at runtime
+    typedef HRESULT (WINAPI *SetThreadDescriptionFuncType)(HANDLE, PCWSTR);
+
+    // Change the priority of the calling thread
+    void setPriority(sf::Thread::Priority priority)
+    {
+        static const int priorities[] =
+        {
+            THREAD_PRIORITY_LOWEST,
+            THREAD_PRIORITY_BELOW_NORMAL,
+            THREAD_PRIORITY_NORMAL,
+            THREAD_PRIORITY_ABOVE_NORMAL,
+            THREAD_PRIORITY_HIGHEST,
+            THREAD_PRIORITY_TIME_CRITICAL
+        };
+
+        if (priority != sf::Thread::Normal)
+            SetThreadPriority(GetCurrentThread(), priorities[priority]);
+    }
+
+    // Restrict the calling thread to the processors of the mask
+    void setAffinity(sf::Uint64 mask)
+    {
+        // Only the processors of the current group can be selected
+        DWORD_PTR processors = static_cast<DWORD_PTR>(mask);
+
+        if (processors != 0)
+            SetThreadAffinityMask(GetCurrentThread(), processors);
+    }
+
+    // Change the name of the calling thread
+    void setName(const std::string& name)
+    {
+        if (name.empty())
+            return;
+
+        static SetThreadDescriptionFuncType setThreadDescription = reinterpret_cast<SetThreadDescriptionFuncType>(GetProcAddress(GetModuleHandleA("kernel32.dll"), "SetThreadDescription"));
+        if (!setThreadDescription)
+            return;
+
+        int length = MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, NULL, 0);
+        if (length <= 0)
+            return;
+
+        std::vector<WCHAR> wideName(static_cast<std::size_t>(length));
+        MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, &wideName[0], length);
+        setThreadDescription(GetCurrentThread(), &wideName[0]);
+    }
+}
 
 
 namespace sf
@@ -73,12 +127,25 @@ void ThreadImpl::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int ThreadImpl::getProcessorCount()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    return (info.dwNumberOfProcessors > 0) ? static_cast<unsigned int>(info.dwNumberOfProcessors) : 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int __stdcall ThreadImpl::entryPoint(void* userData)
 {
     // The Thread instance is stored in the user data
     Thread* owner = static_cast<Thread*>(userData);
 
+    // Apply the settings of the owner before running its function
+    configure(*owner);
+
     // Forward to the owner
     owner->run();
 
@@ -88,6 +155,15 @@ unsigned int __stdcall ThreadImpl::entryPoint(void* userData)
     return 0;
 }
 
+
+////////////////////////////////////////////////////////////
+void ThreadImpl::configure(const Thread& owner)
+{
+    setName(owner.m_name);
+    setAffinity(owner.m_affinity);
+    setPriority(owner.m_priority);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -60,6 +60,17 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the pending joystick connection notifications
+    ///
+    /// Disconnected joysticks are only checked with isConnected
+    /// when this function reports connection changes.
+    ///
+    /// \return True if joysticks may have been connected since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool pollConnections();
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -28,6 +28,8 @@
 #include <SFML/Window/SensorImpl.hpp>
 #include <SFML/System/Time.hpp>
 #include <android/looper.h>
+#include <algorithm>
+#include <dlfcn.h>
 
 // Define missing constants
 #define ASENSOR_TYPE_GRAVITY             0x00000009
@@ -40,6 +42,29 @@ namespace
     ASensorManager*    sensorManager;
     ASensorEventQueue* sensorEventQueue;
     sf::Vector3f       sensorData[sf::Sensor::Count];
+    std::vector<sf::Sensor::Sample> sensorSamples[sf::Sensor::Count];
+
+    // ASensorEventQueue_registerSensor only exists since API level 26, it is looked up at runtime
+    typedef int (*RegisterSensorFuncType)(ASensorEventQueue* queue, const ASensor* sensor, int32_t samplingPeriodUs, int64_t maxBatchReportLatencyUs);
+
+    RegisterSensorFuncType getRegisterSensorFunction()
+    {
+        // Sensors are only accessed from the thread that processes the window events
+        static bool loaded = false;
+        static RegisterSensorFuncType registerSensorFunc = NULL;
+
+        if (!loaded)
+        {
+            loaded = true;
+
+            // The library stays loaded until the process exits, sfml-window links to it anyway
+            void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+            if (library)
+                registerSensorFunc = reinterpret_cast<RegisterSensorFuncType>(dlsym(library, "ASensorEventQueue_registerSensor"));
+        }
+
+        return registerSensorFunc;
+    }
 }
 
 
@@ -89,15 +114,14 @@ bool SensorImpl::open(Sensor::Type sensor)
     if (!m_sensor)
         return false;
 
-    // Get the minimum delay allowed between events
-    Time minimumDelay = microseconds(ASensor_getMinDelay(m_sensor));
-
-    // Set the event rate (not to consume too much battery)
-    ASensorEventQueue_setEventRate(sensorEventQueue, m_sensor, minimumDelay.asMicroseconds());
-
     // Save the index of the sensor
     m_index = static_cast<unsigned int>(sensor);
 
+    // Use the fastest rate allowed, without batching, until told otherwise
+    m_enabled = false;
+    m_period = Time::Zero;
+    m_maxReportLatency = Time::Zero;
+
     return true;
 }
 
@@ -110,11 +134,15 @@ void SensorImpl::close()
 
 
 ////////////////////////////////////////////////////////////
-Vector3f SensorImpl::update()
+Vector3f SensorImpl::update(std::vector<Sensor::Sample>& samples)
 {
     // Update our sensor data list
     ALooper_pollAll(0, NULL, NULL, NULL);
 
+    // Hand over every reading received, batched ones arrive several at once
+    samples.insert(samples.end(), sensorSamples[m_index].begin(), sensorSamples[m_index].end());
+    sensorSamples[m_index].clear();
+
     return sensorData[m_index];
 }
 
@@ -123,9 +151,41 @@ Vector3f SensorImpl::update()
 void SensorImpl::setEnabled(bool enabled)
 {
     if (enabled)
-        ASensorEventQueue_enableSensor(sensorEventQueue, m_sensor);
+    {
+        // The event rate can't be lower than the minimum delay allowed between events
+        Int64 period = std::max(m_period.asMicroseconds(), static_cast<Int64>(ASensor_getMinDelay(m_sensor)));
+
+        // Let the hardware batch the readings in its FIFO if requested and supported
+        RegisterSensorFuncType registerSensor = (m_maxReportLatency > Time::Zero) ? getRegisterSensorFunction() : NULL;
+
+        if (!registerSensor || (registerSensor(sensorEventQueue, m_sensor, static_cast<int32_t>(period), m_maxReportLatency.asMicroseconds()) < 0))
+        {
+            ASensorEventQueue_enableSensor(sensorEventQueue, m_sensor);
+            ASensorEventQueue_setEventRate(sensorEventQueue, m_sensor, static_cast<int32_t>(period));
+        }
+    }
     else
+    {
+        ASensorEventQueue_disableSensor(sensorEventQueue, m_sensor);
+        sensorSamples[m_index].clear();
+    }
+
+    m_enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setSamplingPeriod(Time period, Time maxReportLatency)
+{
+    m_period = period;
+    m_maxReportLatency = maxReportLatency;
+
+    // The batching latency can only be set when the sensor is registered, so start it again
+    if (m_enabled)
+    {
         ASensorEventQueue_disableSensor(sensorEventQueue, m_sensor);
+        setEnabled(true);
+    }
 }
 
 
@@ -204,6 +264,12 @@ int SensorImpl::processSensorEvents(int fd, int events, void* data)
             continue;
 
         sensorData[type] = data;
+
+        // Keep every reading with the time at which it was measured
+        Sensor::Sample sample;
+        sample.value = data;
+        sample.timestamp = microseconds(event.timestamp / 1000);
+        sensorSamples[type].push_back(sample);
     }
 
     return 1;
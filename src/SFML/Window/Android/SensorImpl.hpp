@@ -29,7 +29,9 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Vector3.hpp>
+#include <SFML/System/Time.hpp>
 #include <android/sensor.h>
+#include <vector>
 
 
 namespace sf
@@ -85,10 +87,12 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Update the sensor and get its new value
     ///
+    /// \param samples Array to which the individual readings received since the last update are appended
+    ///
     /// \return Sensor value
     ///
     ////////////////////////////////////////////////////////////
-    Vector3f update();
+    Vector3f update(std::vector<Sensor::Sample>& samples);
 
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the sensor
@@ -98,6 +102,15 @@ public:
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the rate at which the sensor is sampled
+    ///
+    /// \param period           Requested time between two readings
+    /// \param maxReportLatency Maximum time readings may be batched
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingPeriod(Time period, Time maxReportLatency);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -125,8 +138,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const ASensor* m_sensor; ///< Android sensor structure
-    unsigned int   m_index;  ///< Index of the sensor
+    const ASensor* m_sensor;           ///< Android sensor structure
+    unsigned int   m_index;            ///< Index of the sensor
+    bool           m_enabled;          ///< Enable state of the sensor
+    Time           m_period;           ///< Time between two readings
+    Time           m_maxReportLatency; ///< Maximum time readings may stay in the hardware FIFO
 };
 
 } // namespace priv
@@ -33,7 +33,7 @@
 namespace
 {
     // This per-thread variable holds the current context for each thread
-    sf::ThreadLocalPtr<sf::Context> currentContext(NULL);
+    sf::ThreadLocalPtr<sf::Context> currentSfContext(NULL);
 }
 
 namespace sf
@@ -60,7 +60,7 @@ bool Context::setActive(bool active)
     bool result = m_context->setActive(active);
 
     if (result)
-        currentContext = (active ? this : NULL);
+        currentSfContext = (active ? this : NULL);
 
     return result;
 }
@@ -76,7 +76,7 @@ const ContextSettings& Context::getSettings() const
 ////////////////////////////////////////////////////////////
 const Context* Context::getActiveContext()
 {
-    return currentContext;
+    return currentSfContext;
 }
 
 
@@ -101,6 +101,13 @@ GlFunctionPointer Context::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Context::setHeadless(bool headless)
+{
+    return priv::GlContext::setHeadless(headless);
+}
+
+
 ////////////////////////////////////////////////////////////
 Context::Context(const ContextSettings& settings, unsigned int width, unsigned int height)
 {
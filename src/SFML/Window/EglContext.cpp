@@ -35,13 +35,154 @@
 #include <SFML/System/Lock.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/Activity.hpp>
+    #include <android/looper.h>
+    #include <dlfcn.h>
 #endif
 #ifdef SFML_SYSTEM_LINUX
     #include <X11/Xlib.h>
 #endif
+#include <cstring>
+
+// Buffer age query of EGL_EXT_buffer_age
+#ifndef EGL_BUFFER_AGE_EXT
+    #define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
+#if !defined(SFML_OPENGL_ES)
+
+    // Platforms of EGL_MESA_platform_surfaceless and EGL_EXT_platform_device
+    #ifndef EGL_PLATFORM_SURFACELESS_MESA
+        #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+    #endif
+
+    #ifndef EGL_PLATFORM_DEVICE_EXT
+        #define EGL_PLATFORM_DEVICE_EXT 0x313F
+    #endif
+
+#endif
 
 namespace
 {
+    // Check whether a space-separated extension string contains the given extension
+    bool hasExtension(const char* extensions, const char* name)
+    {
+        std::size_t length = std::strlen(name);
+
+        for (const char* found = std::strstr(extensions, name); found; found = std::strstr(found + length, name))
+        {
+            if (((found == extensions) || (found[-1] == ' ')) && ((found[length] == ' ') || (found[length] == '\0')))
+                return true;
+        }
+
+        return false;
+    }
+
+    typedef EGLBoolean (EGLAPIENTRY *SwapBuffersWithDamageFuncType)(EGLDisplay display, EGLSurface surface, const EGLint* rects, EGLint count);
+
+    // Get the entry point of EGL_KHR_swap_buffers_with_damage or EGL_EXT_swap_buffers_with_damage, NULL if the display supports neither
+    SwapBuffersWithDamageFuncType getSwapBuffersWithDamage(EGLDisplay display)
+    {
+        static bool loaded = false;
+        static SwapBuffersWithDamageFuncType function = NULL;
+
+        if (!loaded)
+        {
+            loaded = true;
+
+            const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+
+            if (extensions && hasExtension(extensions, "EGL_KHR_swap_buffers_with_damage"))
+                function = reinterpret_cast<SwapBuffersWithDamageFuncType>(eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+            else if (extensions && hasExtension(extensions, "EGL_EXT_swap_buffers_with_damage"))
+                function = reinterpret_cast<SwapBuffersWithDamageFuncType>(eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
+        }
+
+        return function;
+    }
+
+    // Check whether the display supports EGL_EXT_buffer_age
+    bool isBufferAgeSupported(EGLDisplay display)
+    {
+        static bool checked = false;
+        static bool supported = false;
+
+        if (!checked)
+        {
+            checked = true;
+
+            const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+            supported = extensions && hasExtension(extensions, "EGL_EXT_buffer_age");
+        }
+
+        return supported;
+    }
+
+#if !defined(SFML_OPENGL_ES)
+
+    typedef EGLDisplay (EGLAPIENTRY *GetPlatformDisplayFuncType)(EGLenum platform, void* nativeDisplay, const EGLint* attributes);
+    typedef EGLBoolean (EGLAPIENTRY *QueryDevicesFuncType)(EGLint maxDevices, void** devices, EGLint* deviceCount);
+
+    // Get a display that doesn't need a display server, the surfaceless
+    // platform is preferred, then the first device EGL can enumerate
+    EGLDisplay getHeadlessDisplay()
+    {
+        // Client extensions are only reported by EGL 1.5 or EGL_EXT_client_extensions
+        const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+        GetPlatformDisplayFuncType getPlatformDisplay = reinterpret_cast<GetPlatformDisplayFuncType>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (clientExtensions && getPlatformDisplay)
+        {
+            if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+            {
+                EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+                if (display != EGL_NO_DISPLAY)
+                    return display;
+            }
+
+            QueryDevicesFuncType queryDevices = reinterpret_cast<QueryDevicesFuncType>(eglGetProcAddress("eglQueryDevicesEXT"));
+
+            if (hasExtension(clientExtensions, "EGL_EXT_platform_device") && queryDevices)
+            {
+                void* device = NULL;
+                EGLint deviceCount = 0;
+
+                if (queryDevices(1, &device, &deviceCount) && (deviceCount > 0))
+                {
+                    EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, NULL);
+
+                    if (display != EGL_NO_DISPLAY)
+                        return display;
+                }
+            }
+        }
+
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+#endif
+
+    // The client API is selected per thread, desktop contexts must bind
+    // the OpenGL API on every thread that creates or activates them
+    void bindClientApi()
+    {
+#if !defined(SFML_OPENGL_ES)
+        eglCheck(eglBindAPI(EGL_OPENGL_API));
+#endif
+    }
+
+    // Pixel depth used by contexts that don't render to a window
+    unsigned int getOffscreenBitsPerPixel()
+    {
+#if defined(SFML_OPENGL_ES)
+        return sf::VideoMode::getDesktopMode().bitsPerPixel;
+#else
+        // Headless contexts can't rely on a desktop to query
+        return 32;
+#endif
+    }
+
     EGLDisplay getInitializedDisplay()
     {
 #if defined(SFML_SYSTEM_LINUX)
@@ -50,7 +191,11 @@ namespace
 
         if (display == EGL_NO_DISPLAY)
         {
+#if defined(SFML_OPENGL_ES)
             display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+#else
+            display = getHeadlessDisplay();
+#endif
             eglCheck(eglInitialize(display, NULL, NULL));
         }
 
@@ -66,6 +211,54 @@ namespace
 
 #endif
     }
+
+#ifdef SFML_SYSTEM_ANDROID
+
+    // AChoreographer only exists since API level 24, its functions are looked up at runtime
+    struct AChoreographer;
+    typedef void (*ChoreographerFrameCallback)(long frameTimeNanos, void* data);
+    typedef AChoreographer* (*ChoreographerGetInstanceFuncType)();
+    typedef void (*ChoreographerPostFrameCallbackFuncType)(AChoreographer* choreographer, ChoreographerFrameCallback callback, void* data);
+
+    sf::Mutex choreographerMutex;
+
+    bool getChoreographerFunctions(ChoreographerGetInstanceFuncType& getInstance, ChoreographerPostFrameCallbackFuncType& postFrameCallback)
+    {
+        static bool loaded = false;
+        static ChoreographerGetInstanceFuncType getInstanceFunc = NULL;
+        static ChoreographerPostFrameCallbackFuncType postFrameCallbackFunc = NULL;
+
+        sf::Lock lock(choreographerMutex);
+
+        if (!loaded)
+        {
+            loaded = true;
+
+            // The library stays loaded until the process exits, sfml-window links to it anyway
+            void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+            if (library)
+            {
+                getInstanceFunc = reinterpret_cast<ChoreographerGetInstanceFuncType>(dlsym(library, "AChoreographer_getInstance"));
+                postFrameCallbackFunc = reinterpret_cast<ChoreographerPostFrameCallbackFuncType>(dlsym(library, "AChoreographer_postFrameCallback"));
+            }
+        }
+
+        getInstance = getInstanceFunc;
+        postFrameCallback = postFrameCallbackFunc;
+
+        return getInstanceFunc && postFrameCallbackFunc;
+    }
+
+    // Frames started so far, the callbacks run in the thread that waits so no synchronization is needed.
+    // A callback may still be pending after a wait timed out, so it can't refer to the waiting function
+    unsigned int choreographerFrames = 0;
+
+    void onChoreographerFrame(long, void*)
+    {
+        ++choreographerFrames;
+    }
+
+#endif
 }
 
 
@@ -84,7 +277,7 @@ m_config  (NULL)
     m_display = getInitializedDisplay();
 
     // Get the best EGL config matching the default video settings
-    m_config = getBestConfig(m_display, VideoMode::getDesktopMode().bitsPerPixel, ContextSettings());
+    m_config = getBestConfig(m_display, getOffscreenBitsPerPixel(), ContextSettings());
     updateSettings();
 
     // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
@@ -144,6 +337,24 @@ m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
 m_config  (NULL)
 {
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+    // Get the best EGL config matching the requested video settings
+    m_config = getBestConfig(m_display, getOffscreenBitsPerPixel(), settings);
+    updateSettings();
+
+    // Create a pbuffer surface of the requested size as the back buffer
+    EGLint attrib_list[] = {
+        EGL_WIDTH, static_cast<EGLint>(width),
+        EGL_HEIGHT,static_cast<EGLint>(height),
+        EGL_NONE
+    };
+
+    m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+
+    // Create EGL context
+    createContext(shared);
 }
 
 
@@ -154,6 +365,7 @@ EglContext::~EglContext()
     cleanupUnsharedResources();
 
     // Deactivate the current context
+    bindClientApi();
     EGLContext currentContext = eglCheck(eglGetCurrentContext());
 
     if (currentContext == m_context)
@@ -178,6 +390,8 @@ EglContext::~EglContext()
 ////////////////////////////////////////////////////////////
 bool EglContext::makeCurrent(bool current)
 {
+    bindClientApi();
+
     if (current)
         return m_surface != EGL_NO_SURFACE && eglCheck(eglMakeCurrent(m_display, m_surface, m_surface, m_context));
 
@@ -193,6 +407,77 @@ void EglContext::display()
 }
 
 
+////////////////////////////////////////////////////////////
+void EglContext::displayDamage(const int* rects, std::size_t count)
+{
+    if (m_surface == EGL_NO_SURFACE)
+        return;
+
+    // EGL rectangles have the same layout as ours, (x, y, width, height) from the bottom-left corner
+    SwapBuffersWithDamageFuncType swapBuffersWithDamage = getSwapBuffersWithDamage(m_display);
+
+    if (swapBuffersWithDamage && count)
+    {
+        eglCheck(swapBuffersWithDamage(m_display, m_surface, rects, static_cast<EGLint>(count)));
+    }
+    else
+    {
+        eglCheck(eglSwapBuffers(m_display, m_surface));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int EglContext::getBackBufferAge()
+{
+    if ((m_surface == EGL_NO_SURFACE) || !isBufferAgeSupported(m_display))
+        return 0;
+
+    EGLint age = 0;
+    eglCheck(eglQuerySurface(m_display, m_surface, EGL_BUFFER_AGE_EXT, &age));
+
+    return age > 0 ? static_cast<unsigned int>(age) : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EglContext::waitForVerticalBlank()
+{
+#ifdef SFML_SYSTEM_ANDROID
+
+    ChoreographerGetInstanceFuncType getInstance = NULL;
+    ChoreographerPostFrameCallbackFuncType postFrameCallback = NULL;
+
+    if ((m_surface == EGL_NO_SURFACE) || !getChoreographerFunctions(getInstance, postFrameCallback))
+        return false;
+
+    // The choreographer calls back through the looper of the calling thread, the main thread has one
+    AChoreographer* choreographer = getInstance();
+    if (!choreographer || !ALooper_forThread())
+        return false;
+
+    unsigned int frame = choreographerFrames;
+    postFrameCallback(choreographer, &onChoreographerFrame, NULL);
+
+    // Dispatch the callbacks of the looper until the frame starts, the
+    // other callbacks already attached (input, sensors) run as usual
+    while (choreographerFrames == frame)
+    {
+        int result = ALooper_pollOnce(100, NULL, NULL, NULL);
+        if ((result == ALOOPER_POLL_TIMEOUT) || (result == ALOOPER_POLL_ERROR))
+            return false;
+    }
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 void EglContext::setVerticalSyncEnabled(bool enabled)
 {
@@ -203,10 +488,19 @@ void EglContext::setVerticalSyncEnabled(bool enabled)
 ////////////////////////////////////////////////////////////
 void EglContext::createContext(EglContext* shared)
 {
+#if defined(SFML_OPENGL_ES)
     const EGLint contextVersion[] = {
         EGL_CONTEXT_CLIENT_VERSION, 1,
         EGL_NONE
     };
+#else
+    // Desktop contexts get the highest compatibility version available
+    const EGLint contextVersion[] = {
+        EGL_NONE
+    };
+#endif
+
+    bindClientApi();
 
     EGLContext toShared;
 
@@ -250,17 +544,26 @@ EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixe
         EGL_DEPTH_SIZE, static_cast<EGLint>(settings.depthBits),
         EGL_STENCIL_SIZE, static_cast<EGLint>(settings.stencilBits),
         EGL_SAMPLE_BUFFERS, static_cast<EGLint>(settings.antialiasingLevel),
+#if defined(SFML_OPENGL_ES)
         EGL_SURFACE_TYPE, EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT,
+#else
+        // Headless contexts only ever render to pbuffers
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+#endif
         EGL_NONE
     };
 
-    EGLint configCount;
-    EGLConfig configs[1];
+    EGLint configCount = 0;
+    EGLConfig configs[1] = {NULL};
 
     // Ask EGL for the best config matching our video settings
     eglCheck(eglChooseConfig(display, attributes, configs, 1, &configCount));
 
+    if (configCount == 0)
+        err() << "No EGL config matches the requested settings. You should check your graphics driver" << std::endl;
+
     // TODO: This should check EGL_CONFORMANT and pick the first conformant configuration.
 
     return configs[0];
@@ -288,7 +591,14 @@ void EglContext::updateSettings()
 }
 
 
-#ifdef SFML_SYSTEM_LINUX
+////////////////////////////////////////////////////////////
+GlFunctionPointer EglContext::getFunction(const char* name)
+{
+    return reinterpret_cast<GlFunctionPointer>(eglGetProcAddress(name));
+}
+
+
+#if defined(SFML_SYSTEM_LINUX) && defined(SFML_OPENGL_ES)
 ////////////////////////////////////////////////////////////
 XVisualInfo EglContext::selectBestVisual(::Display* XDisplay, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
@@ -96,6 +96,33 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void display();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display what has been rendered, telling which areas changed
+    ///
+    /// \param rects Changed areas, as (x, y, width, height) quadruples in pixels from the bottom-left corner
+    /// \param count Number of areas
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void displayDamage(const int* rects, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBackBufferAge();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the display starts showing a new frame
+    ///
+    /// Only supported on Android, through AChoreographer.
+    ///
+    /// \return True if the function waited for a vertical blank
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForVerticalBlank();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable vertical synchronization
     ///
@@ -151,7 +178,17 @@ public:
     ////////////////////////////////////////////////////////////
     static EGLConfig getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings);
 
-#ifdef SFML_SYSTEM_LINUX
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of an OpenGL function
+    ///
+    /// \param name Name of the function to get the address of
+    ///
+    /// \return Address of the OpenGL function, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlFunctionPointer getFunction(const char* name);
+
+#if defined(SFML_SYSTEM_LINUX) && defined(SFML_OPENGL_ES)
     ////////////////////////////////////////////////////////////
     /// \brief Select the best EGL visual for a given set of settings
     ///
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/EventQueue.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Enough for the events of a typical frame without reallocation
+    const std::size_t initialCapacity = 64;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+EventQueue::EventQueue() :
+m_buffer(initialCapacity),
+m_first (0),
+m_count (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool EventQueue::empty() const
+{
+    return m_count == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventQueue::size() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+void EventQueue::push(const Event& event)
+{
+    if (m_count == m_buffer.size())
+        grow();
+
+    m_buffer[(m_first + m_count) & (m_buffer.size() - 1)] = event;
+    ++m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+Event& EventQueue::back()
+{
+    return m_buffer[(m_first + m_count - 1) & (m_buffer.size() - 1)];
+}
+
+
+////////////////////////////////////////////////////////////
+bool EventQueue::pop(Event& event)
+{
+    if (m_count == 0)
+        return false;
+
+    event = m_buffer[m_first];
+    m_first = (m_first + 1) & (m_buffer.size() - 1);
+    --m_count;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventQueue::pop(Event* events, std::size_t maxCount)
+{
+    std::size_t count = std::min(maxCount, m_count);
+
+    // Copy in up to two contiguous parts, before and after the end of the buffer
+    std::size_t firstPart = std::min(count, m_buffer.size() - m_first);
+    std::copy(m_buffer.begin() + m_first, m_buffer.begin() + m_first + firstPart, events);
+    std::copy(m_buffer.begin(), m_buffer.begin() + (count - firstPart), events + firstPart);
+
+    m_first = (m_first + count) & (m_buffer.size() - 1);
+    m_count -= count;
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void EventQueue::grow()
+{
+    std::vector<Event> buffer(m_buffer.size() * 2);
+
+    // Unwrap the events at the start of the new buffer
+    std::size_t count = m_count;
+    pop(&buffer[0], count);
+
+    m_buffer.swap(buffer);
+    m_first = 0;
+    m_count = count;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_EVENTQUEUE_HPP
+#define SFML_EVENTQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Event.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief First-in first-out queue of window events
+///
+/// Events are stored in a ring buffer whose capacity is a
+/// power of two. It only grows (by doubling) when it is
+/// full, so once it has reached the size required by the
+/// input rate of the application, pushing and popping
+/// events never allocates memory.
+///
+////////////////////////////////////////////////////////////
+class EventQueue
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    EventQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the queue is empty
+    ///
+    /// \return True if there's no event in the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    bool empty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events in the queue
+    ///
+    /// \return Number of events
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t size() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an event at the end of the queue
+    ///
+    /// \param event Event to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void push(const Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Access the most recently pushed event
+    ///
+    /// The queue must not be empty.
+    ///
+    /// \return Reference to the last event of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    Event& back();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the oldest event of the queue
+    ///
+    /// \param event Event to fill with the removed event
+    ///
+    /// \return True if an event was removed, false if the queue was empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove several events from the start of the queue
+    ///
+    /// \param events   Array to fill with the removed events
+    /// \param maxCount Maximum number of events to remove
+    ///
+    /// \return Number of events written to \a events
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t pop(Event* events, std::size_t maxCount);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Double the capacity of the ring buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void grow();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Event> m_buffer; ///< Ring buffer storage, its size is a power of two
+    std::size_t        m_first;  ///< Index of the oldest event
+    std::size_t        m_count;  ///< Number of events in the queue
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_EVENTQUEUE_HPP
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/FramePacer.hpp>
+#include <SFML/System/Sleep.hpp>
+
+
+namespace
+{
+    // Bounds of the spinning part of the wait
+    const sf::Time minSleepMargin = sf::microseconds(200);
+    const sf::Time maxSleepMargin = sf::milliseconds(4);
+
+    // Weight of older samples in the smoothed values
+    const sf::Int64 smoothing = 16;
+
+    sf::Time absolute(sf::Time time)
+    {
+        return (time < sf::Time::Zero) ? -time : time;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FramePacer::FramePacer() :
+m_clock      (),
+m_frameTime  (Time::Zero),
+m_deadline   (Time::Zero),
+m_lastFrame  (Time::Zero),
+m_sleepMargin(milliseconds(1)),
+m_jitter     (Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFrameTime(Time frameTime)
+{
+    m_frameTime = frameTime;
+    m_jitter = Time::Zero;
+    reset();
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getFrameTime() const
+{
+    return m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::reset()
+{
+    m_deadline = m_clock.getElapsedTime();
+    m_lastFrame = m_deadline;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::wait()
+{
+    if (m_frameTime == Time::Zero)
+        return;
+
+    Time now = m_clock.getElapsedTime();
+
+    m_deadline += m_frameTime;
+
+    // Don't try to catch up after a long stall, it would
+    // result in a burst of frames with no delay at all
+    if (now - m_deadline > m_frameTime)
+        m_deadline = now;
+
+    // Sleep for the bulk of the remaining time
+    Time sleepTime = m_deadline - now - m_sleepMargin;
+
+    if (sleepTime > Time::Zero)
+    {
+        sleepUntil(m_clock, now + sleepTime);
+
+        // Adapt the margin to how much the OS oversleeps: grow
+        // it immediately, shrink it slowly
+        Time overshoot = m_clock.getElapsedTime() - now - sleepTime;
+
+        if (overshoot > m_sleepMargin)
+            m_sleepMargin = overshoot;
+        else
+            m_sleepMargin -= (m_sleepMargin - overshoot) / smoothing;
+
+        if (m_sleepMargin < minSleepMargin)
+            m_sleepMargin = minSleepMargin;
+        else if (m_sleepMargin > maxSleepMargin)
+            m_sleepMargin = maxSleepMargin;
+    }
+
+    // Spin for the last part to hit the deadline precisely
+    now = m_clock.getElapsedTime();
+
+    while (now < m_deadline)
+        now = m_clock.getElapsedTime();
+
+    // Measure how far the actual frame duration is from the target
+    Time deviation = absolute(now - m_lastFrame - m_frameTime);
+    m_jitter += (deviation - m_jitter) / smoothing;
+    m_lastFrame = now;
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getJitter() const
+{
+    return m_jitter;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FRAMEPACER_HPP
+#define SFML_FRAMEPACER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Keeps a steady interval between frames
+///
+/// Frames are scheduled against absolute deadlines so that
+/// oversleeping in one frame doesn't delay all the following
+/// ones. Most of the wait is spent sleeping, the last part
+/// (whose length adapts to the measured sleep precision)
+/// is spent spinning on the clock.
+///
+////////////////////////////////////////////////////////////
+class FramePacer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the target duration of a frame
+    ///
+    /// \param frameTime Target frame duration, Time::Zero disables pacing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameTime(Time frameTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the target duration of a frame
+    ///
+    /// \return Target frame duration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new frame schedule from the current time
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the deadline of the current frame
+    ///
+    /// If the frame is late by more than one frame duration,
+    /// the schedule is restarted instead of trying to catch up.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the measured frame time jitter
+    ///
+    /// \return Smoothed average deviation of the frame durations from the target
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getJitter() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Clock m_clock;       ///< Time base of the schedule, never restarted to avoid drift
+    Time  m_frameTime;   ///< Target frame duration
+    Time  m_deadline;    ///< End of the current frame
+    Time  m_lastFrame;   ///< Time at which the previous wait ended
+    Time  m_sleepMargin; ///< Part of the wait that is spent spinning instead of sleeping
+    Time  m_jitter;      ///< Smoothed frame time jitter
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPACER_HPP
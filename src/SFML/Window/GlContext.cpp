@@ -54,6 +54,13 @@
         #include <SFML/Window/Unix/GlxContext.hpp>
         typedef sf::priv::GlxContext ContextType;
 
+        #if defined(SFML_HEADLESS_EGL)
+
+            #include <SFML/Window/EglContext.hpp>
+            typedef sf::priv::EglContext HeadlessContextType;
+
+        #endif
+
     #elif defined(SFML_SYSTEM_MACOS)
 
         #include <SFML/Window/OSX/SFContext.hpp>
@@ -145,7 +152,19 @@ namespace
     sf::ThreadLocalPtr<sf::priv::GlContext> currentContext(NULL);
 
     // The hidden, inactive context that will be shared with all other contexts
-    ContextType* sharedContext = NULL;
+    sf::priv::GlContext* sharedContext = NULL;
+
+    // Backend requested with setHeadless(), and the one chosen when
+    // the shared context was created (all contexts must share it)
+    enum HeadlessMode
+    {
+        HeadlessAuto,
+        HeadlessEnabled,
+        HeadlessDisabled
+    };
+
+    HeadlessMode headlessMode = HeadlessAuto;
+    bool headless = false;
 
     // Unique identifier, used for identifying contexts when managing unshareable OpenGL resources
     sf::Uint64 id = 1; // start at 1, zero is "no context"
@@ -171,11 +190,15 @@ namespace
         sharedContextLock(0),
         useSharedContext (false)
         {
+            // Nothing to do if the thread already has an active context
+            if (currentContext)
+                return;
+
             if (resourceCount == 0)
             {
                 context = new sf::Context;
             }
-            else if (!currentContext)
+            else
             {
                 sharedContextLock = new sf::Lock(mutex);
                 useSharedContext = true;
@@ -183,6 +206,15 @@ namespace
             }
         }
 
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether the transient context uses global state
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isShared() const
+        {
+            return context || useSharedContext;
+        }
+
         ////////////////////////////////////////////////////////////
         /// \brief Destructor
         ///
@@ -209,9 +241,15 @@ namespace
     // context is currently being used on the current thread
     sf::ThreadLocalPtr<TransientContext> transientContext(NULL);
 
-    // Supported OpenGL extensions
+    // Supported OpenGL extensions, sorted for binary search
     std::vector<std::string> extensions;
 
+    // Order extension names against the raw name looked up
+    bool extensionLess(const std::string& extension, const char* name)
+    {
+        return std::strcmp(extension.c_str(), name) < 0;
+    }
+
     // Helper to parse OpenGL version strings
     bool parseVersionString(const char* version, const char* prefix, unsigned int &major, unsigned int &minor)
     {
@@ -256,6 +294,22 @@ void GlContext::initResource()
         }
 
         // Create the shared context
+#if defined(SFML_HEADLESS_EGL)
+        if (headlessMode == HeadlessAuto)
+        {
+            // Without a display server, the default backend can't work
+            const char* display = std::getenv("DISPLAY");
+            headless = !display || !*display;
+        }
+        else
+        {
+            headless = (headlessMode == HeadlessEnabled);
+        }
+
+        if (headless)
+            sharedContext = new HeadlessContextType(NULL);
+        else
+#endif
         sharedContext = new ContextType(NULL);
         sharedContext->initialize(ContextSettings());
 
@@ -305,6 +359,10 @@ void GlContext::initResource()
             }
         }
 
+        // Sort the extensions so that isExtensionAvailable doesn't have to scan all of them
+        std::sort(extensions.begin(), extensions.end());
+        extensions.erase(std::unique(extensions.begin(), extensions.end()), extensions.end());
+
         // Deactivate the shared context so that others can activate it when necessary
         sharedContext->setActive(false);
     }
@@ -346,13 +404,24 @@ void GlContext::registerContextDestroyCallback(ContextDestroyCallback callback,
 ////////////////////////////////////////////////////////////
 void GlContext::acquireTransientContext()
 {
-    // Protect from concurrent access
-    Lock lock(mutex);
-
     // If this is the first TransientContextLock on this thread
     // construct the state object
+    // The state is thread-local: the global mutex is only needed when
+    // the thread has no active context and must borrow one
     if (!transientContext)
-        transientContext = new TransientContext;
+    {
+        if (currentContext)
+        {
+            transientContext = new TransientContext;
+        }
+        else
+        {
+            // Protect from concurrent access
+            Lock lock(mutex);
+
+            transientContext = new TransientContext;
+        }
+    }
 
     // Increase the reference count
     transientContext->referenceCount++;
@@ -362,9 +431,6 @@ void GlContext::acquireTransientContext()
 ////////////////////////////////////////////////////////////
 void GlContext::releaseTransientContext()
 {
-    // Protect from concurrent access
-    Lock lock(mutex);
-
     // Make sure a matching acquireTransientContext() was called
     assert(transientContext);
 
@@ -375,7 +441,18 @@ void GlContext::releaseTransientContext()
     // destroy the state object
     if (transientContext->referenceCount == 0)
     {
-        delete transientContext;
+        if (transientContext->isShared())
+        {
+            // Protect from concurrent access
+            Lock lock(mutex);
+
+            delete transientContext;
+        }
+        else
+        {
+            delete transientContext;
+        }
+
         transientContext = NULL;
     }
 }
@@ -398,7 +475,12 @@ GlContext* GlContext::create()
         sharedContext->setActive(true);
 
         // Create the context
-        context = new ContextType(sharedContext);
+#if defined(SFML_HEADLESS_EGL)
+        if (headless)
+            context = new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext));
+        else
+#endif
+        context = new ContextType(static_cast<ContextType*>(sharedContext));
 
         sharedContext->setActive(false);
     }
@@ -426,7 +508,16 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
         sharedContext->setActive(true);
 
         // Create the context
-        context = new ContextType(sharedContext, settings, owner, bitsPerPixel);
+#if defined(SFML_HEADLESS_EGL)
+        if (headless)
+        {
+            // Headless contexts have no window surface, render offscreen instead
+            err() << "Windows cannot be rendered to with the headless context backend" << std::endl;
+            context = new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext), settings, 1, 1);
+        }
+        else
+#endif
+        context = new ContextType(static_cast<ContextType*>(sharedContext), settings, owner, bitsPerPixel);
 
         sharedContext->setActive(false);
     }
@@ -455,7 +546,12 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
         sharedContext->setActive(true);
 
         // Create the context
-        context = new ContextType(sharedContext, settings, width, height);
+#if defined(SFML_HEADLESS_EGL)
+        if (headless)
+            context = new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext), settings, width, height);
+        else
+#endif
+        context = new ContextType(static_cast<ContextType*>(sharedContext), settings, width, height);
 
         sharedContext->setActive(false);
     }
@@ -470,7 +566,9 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
 ////////////////////////////////////////////////////////////
 bool GlContext::isExtensionAvailable(const char* name)
 {
-    return std::find(extensions.begin(), extensions.end(), name) != extensions.end();
+    std::vector<std::string>::const_iterator it = std::lower_bound(extensions.begin(), extensions.end(), name, extensionLess);
+
+    return (it != extensions.end()) && (*it == name);
 }
 
 
@@ -479,9 +577,35 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 {
 #if !defined(SFML_OPENGL_ES)
 
-    Lock lock(mutex);
+    // Function pointers can differ between contexts (e.g. with WGL), so they
+    // are cached in the active context and only resolved once for each of them
+    GlContext* context = currentContext;
+
+    if (context)
+    {
+        FunctionTable::const_iterator it = context->m_functions.find(name);
+
+        if (it != context->m_functions.end())
+            return it->second;
+    }
+
+    GlFunctionPointer function = NULL;
+
+    {
+        Lock lock(mutex);
+
+#if defined(SFML_HEADLESS_EGL)
+        if (headless)
+            function = HeadlessContextType::getFunction(name);
+        else
+#endif
+        function = ContextType::getFunction(name);
+    }
+
+    if (context)
+        context->m_functions.insert(std::make_pair(std::string(name), function));
 
-    return ContextType::getFunction(name);
+    return function;
 
 #else
 
@@ -498,6 +622,34 @@ Uint64 GlContext::getActiveContextId()
 }
 
 
+////////////////////////////////////////////////////////////
+bool GlContext::setHeadless(bool enabled)
+{
+    Lock lock(mutex);
+
+    // The backend can't change while contexts exist
+    if (sharedContext)
+        return headless == enabled;
+
+#if defined(SFML_HEADLESS_EGL)
+
+    headlessMode = enabled ? HeadlessEnabled : HeadlessDisabled;
+
+    return true;
+
+#else
+
+    if (enabled)
+        return false;
+
+    headlessMode = HeadlessDisabled;
+
+    return true;
+
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -517,6 +669,34 @@ const ContextSettings& GlContext::getSettings() const
 }
 
 
+////////////////////////////////////////////////////////////
+void GlContext::setSwapInterval(int interval)
+{
+    setVerticalSyncEnabled(interval != 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::displayDamage(const int*, std::size_t)
+{
+    display();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GlContext::getBackBufferAge()
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::waitForVerticalBlank()
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool GlContext::setActive(bool active)
 {
@@ -572,7 +752,8 @@ bool GlContext::setActive(bool active)
 
 ////////////////////////////////////////////////////////////
 GlContext::GlContext() :
-m_id(id++)
+m_id       (id++),
+m_functions()
 {
     // Nothing to do
 }
@@ -33,6 +33,8 @@
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <string>
 
 
 namespace sf
@@ -168,6 +170,16 @@ public:
     ////////////////////////////////////////////////////////////
     static Uint64 getActiveContextId();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Select the headless context backend
+    ///
+    /// \param headless True to use the headless backend, false to use the default one
+    ///
+    /// \return True if the backend was selected, false if it is unavailable or already chosen
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setHeadless(bool headless);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -221,6 +233,56 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between swaps
+    ///
+    /// A negative interval enables adaptive vertical sync: late
+    /// frames are swapped immediately instead of waiting for the
+    /// next vertical blank. Contexts that don't support intervals
+    /// other than 0 and 1 only enable or disable vertical sync.
+    ///
+    /// \param interval Swap interval, 0 disables vertical sync
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display what has been rendered, telling which areas changed
+    ///
+    /// The areas let the window system update only the parts
+    /// of the screen that changed. The default implementation
+    /// ignores them and displays the whole back buffer.
+    ///
+    /// \param rects Changed areas, as (x, y, width, height) quadruples in pixels from the bottom-left corner
+    /// \param count Number of areas
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void displayDamage(const int* rects, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// The age is the number of frames displayed since the back
+    /// buffer was last displayed: 1 means that it still holds
+    /// the previous frame. The default implementation returns 0,
+    /// which means that the contents are undefined.
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBackBufferAge();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the display starts showing a new frame
+    ///
+    /// The default implementation returns immediately, for
+    /// platforms that can't report the vertical blanks.
+    ///
+    /// \return True if the function waited for a vertical blank
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForVerticalBlank();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -291,10 +353,16 @@ private:
     ////////////////////////////////////////////////////////////
     void checkSettings(const ContextSettings& requestedSettings);
 
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::string, GlFunctionPointer> FunctionTable;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Uint64 m_id; ///< Unique number that identifies the context
+    const Uint64  m_id;        ///< Unique number that identifies the context
+    FunctionTable m_functions; ///< Function pointers already resolved while this context was active
 };
 
 } // namespace priv
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/InputSnapshot.hpp>
+#include <SFML/Window/Event.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+InputSnapshot::InputSnapshot() :
+m_pending              (),
+m_current              (),
+m_previousMousePosition()
+{
+    std::memset(m_previousJoystickButtons, 0, sizeof(m_previousJoystickButtons));
+}
+
+
+////////////////////////////////////////////////////////////
+void InputSnapshot::handleEvent(const Event& event)
+{
+    switch (event.type)
+    {
+        case Event::KeyPressed:
+        {
+            if ((event.key.code > Keyboard::Unknown) && (event.key.code < Keyboard::KeyCount))
+            {
+                // Repeated key presses don't count as new presses
+                if (!m_pending.keys[event.key.code])
+                    m_pending.keysPressed[event.key.code] = true;
+                m_pending.keys[event.key.code] = true;
+            }
+            break;
+        }
+
+        case Event::KeyReleased:
+        {
+            if ((event.key.code > Keyboard::Unknown) && (event.key.code < Keyboard::KeyCount))
+            {
+                m_pending.keys[event.key.code] = false;
+                m_pending.keysReleased[event.key.code] = true;
+            }
+            break;
+        }
+
+        case Event::MouseButtonPressed:
+        {
+            if (event.mouseButton.button < Mouse::ButtonCount)
+            {
+                m_pending.buttons[event.mouseButton.button] = true;
+                m_pending.buttonsPressed[event.mouseButton.button] = true;
+            }
+            m_pending.mousePosition = Vector2i(event.mouseButton.x, event.mouseButton.y);
+            break;
+        }
+
+        case Event::MouseButtonReleased:
+        {
+            if (event.mouseButton.button < Mouse::ButtonCount)
+            {
+                m_pending.buttons[event.mouseButton.button] = false;
+                m_pending.buttonsReleased[event.mouseButton.button] = true;
+            }
+            m_pending.mousePosition = Vector2i(event.mouseButton.x, event.mouseButton.y);
+            break;
+        }
+
+        case Event::MouseMoved:
+        {
+            m_pending.mousePosition = Vector2i(event.mouseMove.x, event.mouseMove.y);
+            m_pending.mouseInside = true;
+            break;
+        }
+
+        case Event::MouseWheelScrolled:
+        {
+            if (event.mouseWheelScroll.wheel == Mouse::VerticalWheel)
+                m_pending.wheelDeltas[0] += event.mouseWheelScroll.delta;
+            else
+                m_pending.wheelDeltas[1] += event.mouseWheelScroll.delta;
+            m_pending.mousePosition = Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+            break;
+        }
+
+        case Event::MouseEntered:
+        {
+            m_pending.mouseInside = true;
+            break;
+        }
+
+        case Event::MouseLeft:
+        {
+            m_pending.mouseInside = false;
+            break;
+        }
+
+        case Event::LostFocus:
+        {
+            // The releases happening while the window doesn't have the focus are not reported
+            reset();
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void InputSnapshot::update()
+{
+    // The joystick manager already caches the state of the joysticks, copy it
+    for (unsigned int i = 0; i < Joystick::Count; ++i)
+    {
+        bool connected = Joystick::isConnected(i);
+        m_pending.joysticks[i] = connected;
+
+        for (unsigned int j = 0; j < Joystick::ButtonCount; ++j)
+            m_pending.joystickButtons[i][j] = connected && Joystick::isButtonPressed(i, j);
+
+        for (unsigned int j = 0; j < Joystick::AxisCount; ++j)
+            m_pending.joystickAxes[i][j] = connected ? Joystick::getAxisPosition(i, static_cast<Joystick::Axis>(j)) : 0.f;
+    }
+
+    m_previousMousePosition = m_current.mousePosition;
+    std::memcpy(m_previousJoystickButtons, m_current.joystickButtons, sizeof(m_previousJoystickButtons));
+
+    m_current = m_pending;
+    clearTransitions();
+}
+
+
+////////////////////////////////////////////////////////////
+void InputSnapshot::reset()
+{
+    // Report the held keys and buttons as released
+    for (int i = 0; i < Keyboard::KeyCount; ++i)
+    {
+        if (m_pending.keys[i])
+            m_pending.keysReleased[i] = true;
+        m_pending.keys[i] = false;
+    }
+
+    for (int i = 0; i < Mouse::ButtonCount; ++i)
+    {
+        if (m_pending.buttons[i])
+            m_pending.buttonsReleased[i] = true;
+        m_pending.buttons[i] = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::isKeyPressed(Keyboard::Key key) const
+{
+    return (key > Keyboard::Unknown) && (key < Keyboard::KeyCount) && m_current.keys[key];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::wasKeyPressed(Keyboard::Key key) const
+{
+    return (key > Keyboard::Unknown) && (key < Keyboard::KeyCount) && m_current.keysPressed[key];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::wasKeyReleased(Keyboard::Key key) const
+{
+    return (key > Keyboard::Unknown) && (key < Keyboard::KeyCount) && m_current.keysReleased[key];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::isMouseButtonPressed(Mouse::Button button) const
+{
+    return (button < Mouse::ButtonCount) && m_current.buttons[button];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::wasMouseButtonPressed(Mouse::Button button) const
+{
+    return (button < Mouse::ButtonCount) && m_current.buttonsPressed[button];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::wasMouseButtonReleased(Mouse::Button button) const
+{
+    return (button < Mouse::ButtonCount) && m_current.buttonsReleased[button];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2i InputSnapshot::getMousePosition() const
+{
+    return m_current.mousePosition;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2i InputSnapshot::getMouseDelta() const
+{
+    return m_current.mousePosition - m_previousMousePosition;
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::isMouseInside() const
+{
+    return m_current.mouseInside;
+}
+
+
+////////////////////////////////////////////////////////////
+float InputSnapshot::getMouseWheelDelta(Mouse::Wheel wheel) const
+{
+    return m_current.wheelDeltas[wheel == Mouse::VerticalWheel ? 0 : 1];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::isJoystickConnected(unsigned int joystick) const
+{
+    return (joystick < Joystick::Count) && m_current.joysticks[joystick];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::isJoystickButtonPressed(unsigned int joystick, unsigned int button) const
+{
+    return (joystick < Joystick::Count) && (button < Joystick::ButtonCount) && m_current.joystickButtons[joystick][button];
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputSnapshot::wasJoystickButtonPressed(unsigned int joystick, unsigned int button) const
+{
+    return (joystick < Joystick::Count) && (button < Joystick::ButtonCount) &&
+           m_current.joystickButtons[joystick][button] && !m_previousJoystickButtons[joystick][button];
+}
+
+
+////////////////////////////////////////////////////////////
+float InputSnapshot::getJoystickAxisPosition(unsigned int joystick, Joystick::Axis axis) const
+{
+    return (joystick < Joystick::Count) ? m_current.joystickAxes[joystick][axis] : 0.f;
+}
+
+
+////////////////////////////////////////////////////////////
+void InputSnapshot::clearTransitions()
+{
+    std::fill(m_pending.keysPressed, m_pending.keysPressed + Keyboard::KeyCount, false);
+    std::fill(m_pending.keysReleased, m_pending.keysReleased + Keyboard::KeyCount, false);
+    std::fill(m_pending.buttonsPressed, m_pending.buttonsPressed + Mouse::ButtonCount, false);
+    std::fill(m_pending.buttonsReleased, m_pending.buttonsReleased + Mouse::ButtonCount, false);
+    m_pending.wheelDeltas[0] = 0.f;
+    m_pending.wheelDeltas[1] = 0.f;
+}
+
+} // namespace sf
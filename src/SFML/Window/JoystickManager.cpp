@@ -64,6 +64,11 @@ const Joystick::Identification& JoystickManager::getIdentification(unsigned int
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
 {
+    // Only look for new joysticks when the platform reported a change
+    // in connections, or when a previous attempt to open one failed
+    bool checkConnections = JoystickImpl::pollConnections() || m_retryConnections;
+    m_retryConnections = false;
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         Item& item = m_joysticks[i];
@@ -82,7 +87,7 @@ void JoystickManager::update()
                 item.identification = Joystick::Identification();
             }
         }
-        else
+        else if (checkConnections)
         {
             // Check if the joystick was connected since last update
             if (JoystickImpl::isConnected(i))
@@ -93,6 +98,11 @@ void JoystickManager::update()
                     item.state          = item.joystick.update();
                     item.identification = item.joystick.getIdentification();
                 }
+                else
+                {
+                    // Try again on the next update
+                    m_retryConnections = true;
+                }
             }
         }
     }
@@ -100,7 +110,8 @@ void JoystickManager::update()
 
 
 ////////////////////////////////////////////////////////////
-JoystickManager::JoystickManager()
+JoystickManager::JoystickManager() :
+m_retryConnections(true)
 {
     JoystickImpl::initialize();
 }
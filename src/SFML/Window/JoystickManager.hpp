@@ -119,6 +119,7 @@ private:
     // Member data
     ////////////////////////////////////////////////////////////
     Item m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    bool m_retryConnections;           ///< Check disconnected slots on the next update even without a connection notification
 };
 
 } // namespace priv
@@ -68,10 +68,22 @@ CFSetRef HIDJoystickManager::copyJoysticks()
 }
 
 
+////////////////////////////////////////////////////////////
+bool HIDJoystickManager::hasConnectionChanges()
+{
+    update();
+
+    bool changed = m_connectionsChanged;
+    m_connectionsChanged = false;
+    return changed;
+}
+
+
 ////////////////////////////////////////////////////////////
 HIDJoystickManager::HIDJoystickManager() :
 m_manager(0),
-m_joystickCount(0)
+m_joystickCount(0),
+m_connectionsChanged(true)
 {
     m_manager = IOHIDManagerCreate(kCFAllocatorDefault, kIOHIDOptionsTypeNone);
 
@@ -135,6 +147,7 @@ void HIDJoystickManager::pluggedIn(void* context, IOReturn, void*, IOHIDDeviceRe
 {
     HIDJoystickManager* manager = static_cast<HIDJoystickManager*>(context);
     manager->m_joystickCount++;
+    manager->m_connectionsChanged = true;
 }
 
 
@@ -143,6 +156,7 @@ void HIDJoystickManager::pluggedOut(void* context, IOReturn, void*, IOHIDDeviceR
 {
     HIDJoystickManager* manager = static_cast<HIDJoystickManager*>(context);
     manager->m_joystickCount--;
+    manager->m_connectionsChanged = true;
 }
 
 
@@ -74,6 +74,16 @@ public:
     ////////////////////////////////////////////////////////////
     CFSetRef copyJoysticks();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether joysticks were plugged in or out
+    ///
+    /// Processes pending run loop events and resets the flag.
+    ///
+    /// \return True if a joystick was connected or disconnected since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasConnectionChanges();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -119,6 +129,7 @@ private:
     ////////////////////////////////////////////////////////////
     IOHIDManagerRef m_manager;      ///< HID Manager
     unsigned int    m_joystickCount;///< Number of joysticks currently connected
+    bool            m_connectionsChanged; ///< Did a joystick get plugged in or out since the last check?
 };
 
 
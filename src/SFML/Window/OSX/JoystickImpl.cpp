@@ -177,6 +177,13 @@ bool JoystickImpl::isConnected(unsigned int index)
 }
 
 
+////////////////////////////////////////////////////////////
+bool JoystickImpl::pollConnections()
+{
+    return HIDJoystickManager::getInstance().hasConnectionChanges();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
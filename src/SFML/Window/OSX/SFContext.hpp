@@ -58,6 +58,8 @@ namespace sf
 {
 namespace priv
 {
+struct SFDisplayLink;
+
 ////////////////////////////////////////////////////////////
 /// \brief OSX (Cocoa) implementation of OpenGL contexts
 ///
@@ -132,6 +134,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the display starts showing a new frame
+    ///
+    /// A CVDisplayLink following the display of the context is
+    /// started the first time this function is called.
+    ///
+    /// \return True if the function waited for a vertical blank
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForVerticalBlank();
+
 protected:
     ////////////////////////////////////////////////////////////
     /// \brief Activate the context as the current target
@@ -164,6 +177,7 @@ private:
     NSOpenGLContextRef    m_context;       ///< OpenGL context.
     NSOpenGLViewRef       m_view;          ///< Only for offscreen context.
     NSWindowRef           m_window;        ///< Only for offscreen context.
+    SFDisplayLink*        m_displayLink;   ///< Source of the vertical blanks, NULL until first needed.
 };
 
 } // namespace priv
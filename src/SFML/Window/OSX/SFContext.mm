@@ -28,7 +28,11 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/OSX/SFContext.hpp>
 #include <SFML/Window/OSX/WindowImplCocoa.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <CoreVideo/CoreVideo.h>
 #include <dlfcn.h>
 #include <stdint.h>
 
@@ -38,12 +42,36 @@ namespace sf
 {
 namespace priv
 {
+////////////////////////////////////////////////////////////
+struct SFDisplayLink
+{
+    CVDisplayLinkRef  link;   ///< Display link calling back before each vertical blank
+    Mutex             mutex;  ///< Protects the frame counter
+    ConditionVariable vblank; ///< Notified by the display link thread
+    Uint64            frames; ///< Number of vertical blanks so far
+};
+
+
+////////////////////////////////////////////////////////////
+static CVReturn displayLinkCallback(CVDisplayLinkRef, const CVTimeStamp*, const CVTimeStamp*,
+                                    CVOptionFlags, CVOptionFlags*, void* userData)
+{
+    // Called in a thread of CoreVideo shortly before the vertical blank
+    SFDisplayLink* displayLink = static_cast<SFDisplayLink*>(userData);
+
+    Lock lock(displayLink->mutex);
+    ++displayLink->frames;
+    displayLink->vblank.notifyAll();
+
+    return kCVReturnSuccess;
+}
 
 
 ////////////////////////////////////////////////////////////
 SFContext::SFContext(SFContext* shared) :
 m_view(0),
-m_window(0)
+m_window(0),
+m_displayLink(NULL)
 {
     // Ask for a pool.
     ensureThreadHasPool();
@@ -59,7 +87,8 @@ m_window(0)
 SFContext::SFContext(SFContext* shared, const ContextSettings& settings,
                      const WindowImpl* owner, unsigned int bitsPerPixel) :
 m_view(0),
-m_window(0)
+m_window(0),
+m_displayLink(NULL)
 {
     // Ask for a pool.
     ensureThreadHasPool();
@@ -77,7 +106,8 @@ m_window(0)
 SFContext::SFContext(SFContext* shared, const ContextSettings& settings,
                      unsigned int width, unsigned int height) :
 m_view(0),
-m_window(0)
+m_window(0),
+m_displayLink(NULL)
 {
     // Ensure the process is setup in order to create a valid window.
     WindowImplCocoa::setUpProcess();
@@ -115,6 +145,14 @@ SFContext::~SFContext()
 
     [m_view release]; // Might be nil but we don't care.
     [m_window release]; // Idem.
+
+    // Stopping the display link waits for a running callback to return
+    if (m_displayLink)
+    {
+        CVDisplayLinkStop(m_displayLink->link);
+        CVDisplayLinkRelease(m_displayLink->link);
+        delete m_displayLink;
+    }
 }
 
 
@@ -162,6 +200,54 @@ void SFContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SFContext::waitForVerticalBlank()
+{
+    // Offscreen contexts are never shown on a display
+    if (m_window)
+        return false;
+
+    if (!m_displayLink)
+    {
+        CVDisplayLinkRef link = NULL;
+        if (CVDisplayLinkCreateWithActiveCGDisplays(&link) != kCVReturnSuccess)
+            return false;
+
+        m_displayLink = new SFDisplayLink;
+        m_displayLink->link = link;
+        m_displayLink->frames = 0;
+
+        CVDisplayLinkSetOutputCallback(link, &displayLinkCallback, m_displayLink);
+
+        if (CVDisplayLinkStart(link) != kCVReturnSuccess)
+        {
+            CVDisplayLinkRelease(link);
+            delete m_displayLink;
+            m_displayLink = NULL;
+
+            return false;
+        }
+    }
+
+    // Follow the window when it moves to another display
+    CVDisplayLinkSetCurrentCGDisplayFromOpenGLContext(m_displayLink->link,
+                                                      static_cast<CGLContextObj>([m_context CGLContextObj]),
+                                                      static_cast<CGLPixelFormatObj>([[m_context pixelFormat] CGLPixelFormatObj]));
+
+    Lock lock(m_displayLink->mutex);
+    Uint64 frame = m_displayLink->frames;
+
+    while (m_displayLink->frames == frame)
+    {
+        // The display link stops calling back while the display sleeps
+        if (!m_displayLink->vblank.wait(m_displayLink->mutex, milliseconds(100)))
+            return false;
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SFContext::createContext(SFContext* shared,
                               unsigned int bitsPerPixel,
@@ -25,6 +25,11 @@
 #ifndef SFML_SENSORIMPLOSX_HPP
 #define SFML_SENSORIMPLOSX_HPP
 
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <vector>
+
 
 namespace sf
 {
@@ -79,10 +84,12 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Update the sensor and get its new value
     ///
+    /// \param samples Array to which the individual readings received since the last update are appended
+    ///
     /// \return Sensor value
     ///
     ////////////////////////////////////////////////////////////
-    Vector3f update();
+    Vector3f update(std::vector<Sensor::Sample>& samples);
 
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable the sensor
@@ -91,6 +98,15 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the rate at which the sensor is sampled
+    ///
+    /// \param period           Requested time between two readings
+    /// \param maxReportLatency Maximum time readings may be batched
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingPeriod(Time period, Time maxReportLatency);
 };
 
 } // namespace priv
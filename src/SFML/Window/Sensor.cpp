@@ -50,4 +50,16 @@ Vector3f Sensor::getValue(Type sensor)
     return priv::SensorManager::getInstance().getValue(sensor);
 }
 
+////////////////////////////////////////////////////////////
+void Sensor::setSamplingPeriod(Type sensor, Time period, Time maxReportLatency)
+{
+    priv::SensorManager::getInstance().setSamplingPeriod(sensor, period, maxReportLatency);
+}
+
+////////////////////////////////////////////////////////////
+std::size_t Sensor::getSamples(Type sensor, Sample* samples, std::size_t maxCount)
+{
+    return priv::SensorManager::getInstance().getSamples(sensor, samples, maxCount);
+}
+
 } // namespace sf
@@ -27,6 +27,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/SensorManager.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Readings buffered per sensor, enough for a couple of frames at high sampling rates
+    const std::size_t maxBufferedSamples = 1024;
+}
 
 
 namespace sf
@@ -55,6 +64,13 @@ void SensorManager::setEnabled(Sensor::Type sensor, bool enabled)
     {
         m_sensors[sensor].enabled = enabled;
         m_sensors[sensor].sensor.setEnabled(enabled);
+
+        // Readings of a disabled sensor are not interesting anymore
+        if (!enabled)
+        {
+            Lock lock(m_samplesMutex);
+            m_sensors[sensor].samples.clear();
+        }
     }
     else
     {
@@ -77,6 +93,29 @@ Vector3f SensorManager::getValue(Sensor::Type sensor) const
 }
 
 
+////////////////////////////////////////////////////////////
+void SensorManager::setSamplingPeriod(Sensor::Type sensor, Time period, Time maxReportLatency)
+{
+    if (m_sensors[sensor].available)
+        m_sensors[sensor].sensor.setSamplingPeriod(period, maxReportLatency);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SensorManager::getSamples(Sensor::Type sensor, Sensor::Sample* samples, std::size_t maxCount)
+{
+    Lock lock(m_samplesMutex);
+
+    std::deque<Sensor::Sample>& buffered = m_sensors[sensor].samples;
+
+    std::size_t count = std::min(maxCount, buffered.size());
+    std::copy(buffered.begin(), buffered.begin() + count, samples);
+    buffered.erase(buffered.begin(), buffered.begin() + count);
+
+    return count;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SensorManager::update()
 {
@@ -84,7 +123,35 @@ void SensorManager::update()
     {
         // Only process available sensors
         if (m_sensors[i].available)
-            m_sensors[i].value = m_sensors[i].sensor.update();
+        {
+            Vector3f previousValue = m_sensors[i].value;
+            m_sensors[i].value = m_sensors[i].sensor.update(m_newSamples);
+
+            if (!m_sensors[i].enabled)
+            {
+                m_newSamples.clear();
+                continue;
+            }
+
+            // Sensors that don't report individual readings only provide their latest value
+            if (m_newSamples.empty() && (m_sensors[i].value != previousValue))
+            {
+                Sensor::Sample sample;
+                sample.value = m_sensors[i].value;
+                sample.timestamp = m_clock.getElapsedTime();
+                m_newSamples.push_back(sample);
+            }
+
+            Lock lock(m_samplesMutex);
+
+            std::deque<Sensor::Sample>& buffered = m_sensors[i].samples;
+            buffered.insert(buffered.end(), m_newSamples.begin(), m_newSamples.end());
+            m_newSamples.clear();
+
+            // Drop the oldest readings if they are not retrieved
+            if (buffered.size() > maxBufferedSamples)
+                buffered.erase(buffered.begin(), buffered.end() - maxBufferedSamples);
+        }
     }
 }
 
@@ -31,6 +31,10 @@
 #include <SFML/Window/Sensor.hpp>
 #include <SFML/Window/SensorImpl.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <deque>
+#include <vector>
 
 
 namespace sf
@@ -92,6 +96,28 @@ public:
     ////////////////////////////////////////////////////////////
     Vector3f getValue(Sensor::Type sensor) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the rate at which a sensor is sampled
+    ///
+    /// \param sensor           Sensor to configure
+    /// \param period           Requested time between two readings
+    /// \param maxReportLatency Maximum time readings may be batched
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingPeriod(Sensor::Type sensor, Time period, Time maxReportLatency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the buffered readings of a sensor
+    ///
+    /// \param sensor   Sensor to read
+    /// \param samples  Array to fill with the readings
+    /// \param maxCount Size of the \a samples array
+    ///
+    /// \return Number of readings written to \a samples
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSamples(Sensor::Type sensor, Sensor::Sample* samples, std::size_t maxCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the state of all the sensors
     ///
@@ -122,12 +148,16 @@ private:
         bool enabled;      ///< Current enable state of the sensor
         SensorImpl sensor; ///< Sensor implementation
         Vector3f value;    ///< The current sensor value
+        std::deque<Sensor::Sample> samples; ///< Readings not retrieved yet
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Item m_sensors[Sensor::Count]; ///< Sensors information and state
+    Item                        m_sensors[Sensor::Count]; ///< Sensors information and state
+    std::vector<Sensor::Sample> m_newSamples;             ///< Readings returned by the last sensor update
+    Clock                       m_clock;                  ///< Timestamps readings of sensors that don't report their own
+    Mutex                       m_samplesMutex;           ///< Protects the buffered readings
 };
 
 } // namespace priv
@@ -40,7 +40,7 @@ namespace
     // The shared display and its reference counter
     Display* sharedDisplay = NULL;
     unsigned int referenceCount = 0;
-    sf::Mutex mutex;
+    sf::Mutex displayMutex;
 
     typedef std::map<std::string, Atom> AtomMap;
     AtomMap atoms;
@@ -53,7 +53,7 @@ namespace priv
 ////////////////////////////////////////////////////////////
 Display* OpenDisplay()
 {
-    Lock lock(mutex);
+    Lock lock(displayMutex);
 
     if (referenceCount == 0)
     {
@@ -76,7 +76,7 @@ Display* OpenDisplay()
 ////////////////////////////////////////////////////////////
 void CloseDisplay(Display* display)
 {
-    Lock lock(mutex);
+    Lock lock(displayMutex);
 
     assert(display == sharedDisplay);
 
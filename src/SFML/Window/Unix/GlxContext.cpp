@@ -31,6 +31,8 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <map>
+#include <string>
 #include <vector>
 
 #if !defined(GLX_DEBUGGING) && defined(SFML_DEBUG)
@@ -72,6 +74,32 @@ namespace
         ::Display* m_display;
         int      (*m_previousHandler)(::Display*, XErrorEvent*);
     };
+
+    // Settings that the choice of a visual depends on
+    struct VisualKey
+    {
+        std::string  display;
+        unsigned int bitsPerPixel;
+        unsigned int depthBits;
+        unsigned int stencilBits;
+        unsigned int antialiasingLevel;
+        bool         sRgbCapable;
+
+        bool operator <(const VisualKey& right) const
+        {
+            if (display != right.display)                     return display < right.display;
+            if (bitsPerPixel != right.bitsPerPixel)           return bitsPerPixel < right.bitsPerPixel;
+            if (depthBits != right.depthBits)                 return depthBits < right.depthBits;
+            if (stencilBits != right.stencilBits)             return stencilBits < right.stencilBits;
+            if (antialiasingLevel != right.antialiasingLevel) return antialiasingLevel < right.antialiasingLevel;
+            return sRgbCapable < right.sRgbCapable;
+        }
+    };
+
+    // Visuals already chosen, scoring every visual of the server takes a noticeable time.
+    // Only the identifier is kept, the Visual structure belongs to the connection it was queried on
+    sf::Mutex visualCacheMutex;
+    std::map<VisualKey, VisualID> visualCache;
 }
 
 
@@ -274,24 +302,36 @@ void GlxContext::display()
 
 ////////////////////////////////////////////////////////////
 void GlxContext::setVerticalSyncEnabled(bool enabled)
+{
+    setSwapInterval(enabled ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlxContext::setSwapInterval(int interval)
 {
     int result = 0;
 
+    // Negative intervals (late swaps tear) are only supported by
+    // GLX_EXT_swap_control_tear, fall back to regular vertical sync
+    if ((interval < 0) && (sfglx_ext_EXT_swap_control_tear != sfglx_LOAD_SUCCEEDED))
+        interval = -interval;
+
     // Prioritize the EXT variant and fall back to MESA or SGI if needed
     // We use the direct pointer to the MESA entry point instead of the alias
     // because glx.h declares the entry point as an external function
     // which would require us to link in an additional library
     if (sfglx_ext_EXT_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        glXSwapIntervalEXT(m_display, m_pbuffer ? m_pbuffer : m_window, enabled ? 1 : 0);
+        glXSwapIntervalEXT(m_display, m_pbuffer ? m_pbuffer : m_window, interval);
     }
     else if (sfglx_ext_MESA_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        result = sf_ptrc_glXSwapIntervalMESA(enabled ? 1 : 0);
+        result = sf_ptrc_glXSwapIntervalMESA(interval < 0 ? -interval : interval);
     }
     else if (sfglx_ext_SGI_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        result = glXSwapIntervalSGI(enabled ? 1 : 0);
+        result = glXSwapIntervalSGI(interval < 0 ? -interval : interval);
     }
     else
     {
@@ -310,12 +350,72 @@ void GlxContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int GlxContext::getBackBufferAge()
+{
+    // Only the back buffers of windows are swapped, and GLX_EXT_buffer_age is needed to know what they hold
+    if (!m_window || m_pbuffer || (sfglx_ext_EXT_buffer_age != sfglx_LOAD_SUCCEEDED))
+        return 0;
+
+    unsigned int age = 0;
+    glXQueryDrawable(m_display, m_window, GLX_BACK_BUFFER_AGE_EXT, &age);
+
+    return age;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlxContext::waitForVerticalBlank()
+{
+    // The media stream counter of GLX_OML_sync_control is incremented at each vertical blank
+    if (!m_window || m_pbuffer || (sfglx_ext_OML_sync_control != sfglx_LOAD_SUCCEEDED))
+        return false;
+
+    int64_t ust = 0;
+    int64_t msc = 0;
+    int64_t sbc = 0;
+
+    if (!glXGetSyncValuesOML(m_display, m_window, &ust, &msc, &sbc))
+        return false;
+
+    return glXWaitForMscOML(m_display, m_window, msc + 1, 0, 0, &ust, &msc, &sbc) == True;
+}
+
+
 ////////////////////////////////////////////////////////////
 XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
     // Make sure that extensions are initialized
     ensureExtensionsInit(display, DefaultScreen(display));
 
+    VisualKey key;
+    key.display           = DisplayString(display);
+    key.bitsPerPixel      = bitsPerPixel;
+    key.depthBits         = settings.depthBits;
+    key.stencilBits       = settings.stencilBits;
+    key.antialiasingLevel = settings.antialiasingLevel;
+    key.sRgbCapable       = settings.sRgbCapable;
+
+    Lock lock(visualCacheMutex);
+
+    // Reuse the visual chosen by a previous context with the same settings, if any
+    std::map<VisualKey, VisualID>::const_iterator cached = visualCache.find(key);
+    if (cached != visualCache.end())
+    {
+        XVisualInfo tpl;
+        tpl.visualid = cached->second;
+
+        int count;
+        XVisualInfo* visual = XGetVisualInfo(display, VisualIDMask, &tpl, &count);
+        if (visual)
+        {
+            XVisualInfo result = *visual;
+            XFree(visual);
+
+            return result;
+        }
+    }
+
     // Retrieve all the visuals
     int count;
     XVisualInfo* visuals = XGetVisualInfo(display, 0, NULL, &count);
@@ -379,6 +479,9 @@ XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPe
         // Free the array of visuals
         XFree(visuals);
 
+        if (bestVisual.visual)
+            visualCache[key] = bestVisual.visualid;
+
         return bestVisual;
     }
     else
@@ -120,6 +120,30 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between swaps
+    ///
+    /// \param interval Swap interval, negative for adaptive vertical sync
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the age of the contents of the back buffer
+    ///
+    /// \return Age of the back buffer, 0 if unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getBackBufferAge();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the display starts showing a new frame
+    ///
+    /// \return True if the function waited for a vertical blank
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForVerticalBlank();
+
     ////////////////////////////////////////////////////////////
     /// \brief Select the best GLX visual for a given set of settings
     ///
@@ -38,6 +38,7 @@ static sf::GlFunctionPointer IntGetProcAddress(const char* name)
 }
 
 int sfglx_ext_EXT_swap_control = sfglx_LOAD_FAILED;
+int sfglx_ext_EXT_swap_control_tear = sfglx_LOAD_FAILED;
 int sfglx_ext_MESA_swap_control = sfglx_LOAD_FAILED;
 int sfglx_ext_SGI_swap_control = sfglx_LOAD_FAILED;
 int sfglx_ext_EXT_framebuffer_sRGB = sfglx_LOAD_FAILED;
@@ -46,6 +47,8 @@ int sfglx_ext_ARB_multisample = sfglx_LOAD_FAILED;
 int sfglx_ext_SGIX_pbuffer = sfglx_LOAD_FAILED;
 int sfglx_ext_ARB_create_context = sfglx_LOAD_FAILED;
 int sfglx_ext_ARB_create_context_profile = sfglx_LOAD_FAILED;
+int sfglx_ext_EXT_buffer_age = sfglx_LOAD_FAILED;
+int sfglx_ext_OML_sync_control = sfglx_LOAD_FAILED;
 
 void (CODEGEN_FUNCPTR *sf_ptrc_glXSwapIntervalEXT)(Display*, GLXDrawable, int) = NULL;
 
@@ -118,6 +121,33 @@ static int Load_ARB_create_context(void)
     return numFailed;
 }
 
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetMscRateOML)(Display*, GLXDrawable, int32_t*, int32_t*) = NULL;
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetSyncValuesOML)(Display*, GLXDrawable, int64_t*, int64_t*, int64_t*) = NULL;
+int64_t (CODEGEN_FUNCPTR *sf_ptrc_glXSwapBuffersMscOML)(Display*, GLXDrawable, int64_t, int64_t, int64_t) = NULL;
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForMscOML)(Display*, GLXDrawable, int64_t, int64_t, int64_t, int64_t*, int64_t*, int64_t*) = NULL;
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForSbcOML)(Display*, GLXDrawable, int64_t, int64_t*, int64_t*, int64_t*) = NULL;
+
+static int Load_OML_sync_control(void)
+{
+    int numFailed = 0;
+    sf_ptrc_glXGetMscRateOML = reinterpret_cast<Bool (CODEGEN_FUNCPTR*)(Display*, GLXDrawable, int32_t*, int32_t*)>(IntGetProcAddress("glXGetMscRateOML"));
+    if (!sf_ptrc_glXGetMscRateOML)
+        numFailed++;
+    sf_ptrc_glXGetSyncValuesOML = reinterpret_cast<Bool (CODEGEN_FUNCPTR*)(Display*, GLXDrawable, int64_t*, int64_t*, int64_t*)>(IntGetProcAddress("glXGetSyncValuesOML"));
+    if (!sf_ptrc_glXGetSyncValuesOML)
+        numFailed++;
+    sf_ptrc_glXSwapBuffersMscOML = reinterpret_cast<int64_t (CODEGEN_FUNCPTR*)(Display*, GLXDrawable, int64_t, int64_t, int64_t)>(IntGetProcAddress("glXSwapBuffersMscOML"));
+    if (!sf_ptrc_glXSwapBuffersMscOML)
+        numFailed++;
+    sf_ptrc_glXWaitForMscOML = reinterpret_cast<Bool (CODEGEN_FUNCPTR*)(Display*, GLXDrawable, int64_t, int64_t, int64_t, int64_t*, int64_t*, int64_t*)>(IntGetProcAddress("glXWaitForMscOML"));
+    if (!sf_ptrc_glXWaitForMscOML)
+        numFailed++;
+    sf_ptrc_glXWaitForSbcOML = reinterpret_cast<Bool (CODEGEN_FUNCPTR*)(Display*, GLXDrawable, int64_t, int64_t*, int64_t*, int64_t*)>(IntGetProcAddress("glXWaitForSbcOML"));
+    if (!sf_ptrc_glXWaitForSbcOML)
+        numFailed++;
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)(void);
 typedef struct sfglx_StrToExtMap_s
 {
@@ -126,8 +156,9 @@ typedef struct sfglx_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfglx_StrToExtMap;
 
-static sfglx_StrToExtMap ExtensionMap[9] = {
+static sfglx_StrToExtMap ExtensionMap[12] = {
     {"GLX_EXT_swap_control", &sfglx_ext_EXT_swap_control, Load_EXT_swap_control},
+    {"GLX_EXT_swap_control_tear", &sfglx_ext_EXT_swap_control_tear, NULL},
     {"GLX_MESA_swap_control", &sfglx_ext_MESA_swap_control, Load_MESA_swap_control},
     {"GLX_SGI_swap_control", &sfglx_ext_SGI_swap_control, Load_SGI_swap_control},
     {"GLX_EXT_framebuffer_sRGB", &sfglx_ext_EXT_framebuffer_sRGB, NULL},
@@ -135,10 +166,12 @@ static sfglx_StrToExtMap ExtensionMap[9] = {
     {"GLX_ARB_multisample", &sfglx_ext_ARB_multisample, NULL},
     {"GLX_SGIX_pbuffer", &sfglx_ext_SGIX_pbuffer, Load_SGIX_pbuffer},
     {"GLX_ARB_create_context", &sfglx_ext_ARB_create_context, Load_ARB_create_context},
-    {"GLX_ARB_create_context_profile", &sfglx_ext_ARB_create_context_profile, NULL}
+    {"GLX_ARB_create_context_profile", &sfglx_ext_ARB_create_context_profile, NULL},
+    {"GLX_EXT_buffer_age", &sfglx_ext_EXT_buffer_age, NULL},
+    {"GLX_OML_sync_control", &sfglx_ext_OML_sync_control, Load_OML_sync_control}
 };
 
-static int g_extensionMapSize = 9;
+static int g_extensionMapSize = 12;
 
 
 static sfglx_StrToExtMap* FindExtEntry(const char* extensionName)
@@ -157,6 +190,7 @@ static sfglx_StrToExtMap* FindExtEntry(const char* extensionName)
 static void ClearExtensionVars(void)
 {
     sfglx_ext_EXT_swap_control = sfglx_LOAD_FAILED;
+    sfglx_ext_EXT_swap_control_tear = sfglx_LOAD_FAILED;
     sfglx_ext_MESA_swap_control = sfglx_LOAD_FAILED;
     sfglx_ext_SGI_swap_control = sfglx_LOAD_FAILED;
     sfglx_ext_EXT_framebuffer_sRGB = sfglx_LOAD_FAILED;
@@ -165,6 +199,8 @@ static void ClearExtensionVars(void)
     sfglx_ext_SGIX_pbuffer = sfglx_LOAD_FAILED;
     sfglx_ext_ARB_create_context = sfglx_LOAD_FAILED;
     sfglx_ext_ARB_create_context_profile = sfglx_LOAD_FAILED;
+    sfglx_ext_EXT_buffer_age = sfglx_LOAD_FAILED;
+    sfglx_ext_OML_sync_control = sfglx_LOAD_FAILED;
 }
 
 
@@ -142,6 +142,7 @@ extern "C" {
 #endif // __cplusplus
 
 extern int sfglx_ext_EXT_swap_control;
+extern int sfglx_ext_EXT_swap_control_tear;
 extern int sfglx_ext_MESA_swap_control;
 extern int sfglx_ext_SGI_swap_control;
 extern int sfglx_ext_EXT_framebuffer_sRGB;
@@ -150,10 +151,16 @@ extern int sfglx_ext_ARB_multisample;
 extern int sfglx_ext_SGIX_pbuffer;
 extern int sfglx_ext_ARB_create_context;
 extern int sfglx_ext_ARB_create_context_profile;
+extern int sfglx_ext_EXT_buffer_age;
+extern int sfglx_ext_OML_sync_control;
 
 #define GLX_MAX_SWAP_INTERVAL_EXT 0x20F2
 #define GLX_SWAP_INTERVAL_EXT 0x20F1
 
+#define GLX_LATE_SWAPS_TEAR_EXT 0x20F3
+
+#define GLX_BACK_BUFFER_AGE_EXT 0x20F4
+
 #define GLX_FRAMEBUFFER_SRGB_CAPABLE_EXT 0x20B2
 
 #define GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB 0x20B2
@@ -233,6 +240,20 @@ extern GLXContext (CODEGEN_FUNCPTR *sf_ptrc_glXCreateContextAttribsARB)(Display*
 #define glXCreateContextAttribsARB sf_ptrc_glXCreateContextAttribsARB
 #endif // GLX_ARB_create_context
 
+#ifndef GLX_OML_sync_control
+#define GLX_OML_sync_control 1
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetMscRateOML)(Display*, GLXDrawable, int32_t*, int32_t*);
+#define glXGetMscRateOML sf_ptrc_glXGetMscRateOML
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetSyncValuesOML)(Display*, GLXDrawable, int64_t*, int64_t*, int64_t*);
+#define glXGetSyncValuesOML sf_ptrc_glXGetSyncValuesOML
+extern int64_t (CODEGEN_FUNCPTR *sf_ptrc_glXSwapBuffersMscOML)(Display*, GLXDrawable, int64_t, int64_t, int64_t);
+#define glXSwapBuffersMscOML sf_ptrc_glXSwapBuffersMscOML
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForMscOML)(Display*, GLXDrawable, int64_t, int64_t, int64_t, int64_t*, int64_t*, int64_t*);
+#define glXWaitForMscOML sf_ptrc_glXWaitForMscOML
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForSbcOML)(Display*, GLXDrawable, int64_t, int64_t*, int64_t*, int64_t*);
+#define glXWaitForSbcOML sf_ptrc_glXWaitForSbcOML
+#endif // GLX_OML_sync_control
+
 
 enum sfglx_LoadStatus
 {
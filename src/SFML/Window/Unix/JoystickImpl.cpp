@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Clock.hpp>
 #include <linux/joystick.h>
 #include <libudev.h>
 #include <unistd.h>
@@ -41,6 +42,10 @@ namespace
     udev* udevContext = 0;
     udev_monitor* udevMonitor = 0;
 
+    // Without udev monitor, the devices are scanned again at this interval
+    sf::Clock scanClock;
+    const sf::Time scanRefreshDelay = sf::milliseconds(500);
+
     struct JoystickRecord
     {
         std::string deviceNode;
@@ -516,15 +521,33 @@ void JoystickImpl::cleanup()
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
-    // See if we can skip scanning if udev monitor is available
+    if (index >= joystickList.size())
+        return false;
+
+    // The list is kept up to date by pollConnections
+    return joystickList[index].plugged;
+}
+
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::pollConnections()
+{
     if (!udevMonitor)
     {
-        // udev monitor is not available, perform a scan every query
+        // udev monitor is not available, scan periodically instead of on every query
+        if (scanClock.getElapsedTime() < scanRefreshDelay)
+            return false;
+
+        scanClock.restart();
         updatePluggedList();
+
+        return true;
     }
-    else if (hasMonitorEvent())
+
+    // Handle all the joysticks added/removed since last poll
+    bool changed = false;
+    while (hasMonitorEvent())
     {
-        // Check if new joysticks were added/removed since last update
         udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
 
         // If we can get the specific device, we check that,
@@ -533,15 +556,20 @@ bool JoystickImpl::isConnected(unsigned int index)
 
         if (udevDevice)
             udev_device_unref(udevDevice);
+
+        changed = true;
     }
 
-    if (index >= joystickList.size())
-        return false;
+    return changed;
+}
 
-    // Then check if the joystick is connected
-    return joystickList[index].plugged;
+////////////////////////////////////////////////////////////
+int JoystickImpl::getConnectionDescriptor()
+{
+    return udevMonitor ? udev_monitor_get_fd(udevMonitor) : -1;
 }
 
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
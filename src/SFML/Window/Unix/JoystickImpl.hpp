@@ -72,6 +72,29 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the pending joystick connection notifications
+    ///
+    /// Disconnected joysticks are only checked with isConnected
+    /// when this function reports connection changes.
+    ///
+    /// \return True if joysticks may have been connected since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool pollConnections();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the file descriptor notifying joystick connections
+    ///
+    /// The descriptor becomes readable when a joystick is
+    /// connected or disconnected, so that event loops can
+    /// wait on it.
+    ///
+    /// \return File descriptor of the udev monitor, -1 if it is unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getConnectionDescriptor();
+
     ////////////////////////////////////////////////////////////
     /// \brief Open the joystick
     ///
@@ -70,7 +70,7 @@ void SensorImpl::close()
 
 
 ////////////////////////////////////////////////////////////
-Vector3f SensorImpl::update()
+Vector3f SensorImpl::update(std::vector<Sensor::Sample>& /*samples*/)
 {
     // To be implemented
     return Vector3f(0, 0, 0);
@@ -83,6 +83,13 @@ void SensorImpl::setEnabled(bool /*enabled*/)
     // To be implemented
 }
 
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setSamplingPeriod(Time /*period*/, Time /*maxReportLatency*/)
+{
+    // To be implemented
+}
+
 } // namespace priv
 
 } // namespace sf
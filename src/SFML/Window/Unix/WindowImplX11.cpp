@@ -38,10 +38,12 @@
 #include <X11/Xatom.h>
 #include <X11/keysym.h>
 #include <X11/extensions/Xrandr.h>
+#include <X11/extensions/XInput2.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
+#include <poll.h>
 #include <fcntl.h>
 #include <algorithm>
 #include <vector>
@@ -65,6 +67,7 @@ namespace
     std::vector<sf::priv::WindowImplX11*> allWindows;
     sf::Mutex                             allWindowsMutex;
     sf::String                            windowManagerName;
+    unsigned int                          rawMouseInputCount = 0;
 
     sf::String                            wmAbsPosGood[] = { "Enlightenment", "FVWM", "i3" };
 
@@ -99,6 +102,14 @@ namespace
         return event->xany.window == reinterpret_cast< ::Window >(userData);
     }
 
+    // Filter the raw motion events of XInput2, they are sent to the root window
+    Bool checkRawEvent(::Display*, XEvent* event, XPointer userData)
+    {
+        return (event->type == GenericEvent) &&
+               (event->xcookie.extension == *reinterpret_cast<int*>(userData)) &&
+               (event->xcookie.evtype == XI_RawMotion);
+    }
+
     // Find the name of the current executable
     std::string findExecutableName()
     {
@@ -496,7 +507,10 @@ m_cursorGrabbed  (false),
 m_windowMapped   (false),
 m_iconPixmap     (0),
 m_iconMaskPixmap (0),
-m_lastInputTime  (0)
+m_lastInputTime  (0),
+m_rawMouseInput  (false),
+m_xinputOpcode   (0),
+m_rawRemainder   (0.f, 0.f)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -544,7 +558,10 @@ m_cursorGrabbed  (m_fullscreen),
 m_windowMapped   (false),
 m_iconPixmap     (0),
 m_iconMaskPixmap (0),
-m_lastInputTime  (0)
+m_lastInputTime  (0),
+m_rawMouseInput  (false),
+m_xinputOpcode   (0),
+m_rawRemainder   (0.f, 0.f)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -736,6 +753,10 @@ WindowImplX11::~WindowImplX11()
     if (m_inputContext)
         XDestroyIC(m_inputContext);
 
+    // Stop receiving raw mouse events
+    if (m_rawMouseInput)
+        setRawMouseInputEnabled(false);
+
     // Destroy the window
     if (m_window && !m_isExternal)
     {
@@ -768,6 +789,40 @@ void WindowImplX11::processEvents()
 {
     XEvent event;
 
+    // Pick out the raw mouse motions, they are not bound to any window
+    if (m_rawMouseInput)
+    {
+        int focus = -1;
+
+        while (XCheckIfEvent(m_display, &event, &checkRawEvent, reinterpret_cast<XPointer>(&m_xinputOpcode)))
+        {
+            if (!XGetEventData(m_display, &event.xcookie))
+                continue;
+
+            // Only the focused window reports raw motions, query it once per batch
+            if (focus < 0)
+                focus = hasFocus() ? 1 : 0;
+
+            if (focus)
+            {
+                // Valuators 0 and 1 are the X and Y axes, only the ones that changed are sent
+                const XIRawEvent* raw = static_cast<const XIRawEvent*>(event.xcookie.data);
+                const double* values = raw->raw_values;
+                double delta[2] = {0.0, 0.0};
+
+                for (int i = 0; (i < 2) && (i < raw->valuators.mask_len * 8); ++i)
+                {
+                    if (XIMaskIsSet(raw->valuators.mask, i))
+                        delta[i] = *values++;
+                }
+
+                processRawMotion(static_cast<float>(delta[0]), static_cast<float>(delta[1]));
+            }
+
+            XFreeEventData(m_display, &event.xcookie);
+        }
+    }
+
     // Pick out the events that are interesting for this window
     while (XCheckIfEvent(m_display, &event, &checkEvent, reinterpret_cast<XPointer>(m_window)))
         m_events.push_back(event);
@@ -782,6 +837,69 @@ void WindowImplX11::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::processRawMotion(float deltaX, float deltaY)
+{
+    // Some drivers report fractional motions, accumulate them
+    // so that slow movements aren't lost to truncation
+    m_rawRemainder.x += deltaX;
+    m_rawRemainder.y += deltaY;
+
+    int x = static_cast<int>(m_rawRemainder.x);
+    int y = static_cast<int>(m_rawRemainder.y);
+
+    if ((x == 0) && (y == 0))
+        return;
+
+    m_rawRemainder.x -= static_cast<float>(x);
+    m_rawRemainder.y -= static_cast<float>(y);
+
+    Event sfEvent;
+    sfEvent.type                = Event::MouseMovedRaw;
+    sfEvent.mouseMoveRaw.deltaX = x;
+    sfEvent.mouseMoveRaw.deltaY = y;
+    pushEvent(sfEvent);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplX11::waitForEvents(Int32 timeout)
+{
+    // processEvents just picked out our events, the ones still
+    // queued by Xlib belong to other windows and won't show up
+    // on the connection: poll instead of spinning on them
+    if (XEventsQueued(m_display, QueuedAfterFlush) > 0)
+    {
+        sleep(milliseconds(((timeout < 0) || (timeout > 10)) ? 10 : timeout));
+        return;
+    }
+
+    pollfd descriptors[2];
+    nfds_t descriptorCount = 1;
+
+    descriptors[0].fd      = ConnectionNumber(m_display);
+    descriptors[0].events  = POLLIN;
+    descriptors[0].revents = 0;
+
+#if defined(SFML_SYSTEM_LINUX)
+
+    // Wake up when a joystick is connected, the udev monitor is only read when polled
+    int joystickDescriptor = JoystickImpl::getConnectionDescriptor();
+    if (joystickDescriptor >= 0)
+    {
+        descriptors[1].fd      = joystickDescriptor;
+        descriptors[1].events  = POLLIN;
+        descriptors[1].revents = 0;
+        ++descriptorCount;
+    }
+
+#endif
+
+    // Interrupted waits return early, which callers handle as spurious wakeups
+    poll(descriptors, descriptorCount, timeout);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplX11::getPosition() const
 {
@@ -1115,6 +1233,67 @@ void WindowImplX11::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::setRawMouseInputEnabled(bool enabled)
+{
+    if (enabled == m_rawMouseInput)
+        return;
+
+    if (enabled)
+    {
+        // Raw events were introduced with XInput 2.0
+        int firstEvent = 0;
+        int firstError = 0;
+
+        if (!XQueryExtension(m_display, "XInputExtension", &m_xinputOpcode, &firstEvent, &firstError))
+        {
+            err() << "Failed to enable raw mouse input, XInput extension not available" << std::endl;
+            return;
+        }
+
+        int major = 2;
+        int minor = 0;
+
+        if (XIQueryVersion(m_display, &major, &minor) != Success)
+        {
+            err() << "Failed to enable raw mouse input, XInput 2 not available" << std::endl;
+            return;
+        }
+    }
+
+    m_rawMouseInput = enabled;
+    m_rawRemainder = Vector2f(0.f, 0.f);
+
+    // The selection is made on the root window and shared by all the
+    // windows of the display, only change it for the first/last window
+    Lock lock(allWindowsMutex);
+
+    if (enabled)
+    {
+        if (rawMouseInputCount++ > 0)
+            return;
+    }
+    else if (--rawMouseInputCount > 0)
+    {
+        return;
+    }
+
+    unsigned char mask[XIMaskLen(XI_RawMotion)];
+    std::memset(mask, 0, sizeof(mask));
+
+    if (enabled)
+        XISetMask(mask, XI_RawMotion);
+
+    XIEventMask eventMask;
+    eventMask.deviceid = XIAllMasterDevices;
+    eventMask.mask_len = sizeof(mask);
+    eventMask.mask     = mask;
+
+    XISelectEvents(m_display, DefaultRootWindow(m_display), &eventMask, 1);
+    XFlush(m_display);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplX11::requestFocus()
 {
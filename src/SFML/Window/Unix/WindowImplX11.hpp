@@ -171,6 +171,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable raw mouse input events
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setRawMouseInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -194,6 +202,14 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the X server has events for the window
+    ///
+    /// \param timeout Maximum time to wait in milliseconds, negative to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Int32 timeout);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -264,6 +280,15 @@ private:
     ////////////////////////////////////////////////////////////
     bool processEvent(XEvent& windowEvent);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate a raw mouse move event from XInput2 data
+    ///
+    /// \param deltaX Horizontal motion, in device units
+    /// \param deltaY Vertical motion, in device units
+    ///
+    ////////////////////////////////////////////////////////////
+    void processRawMotion(float deltaX, float deltaY);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -286,6 +311,9 @@ private:
     Pixmap             m_iconPixmap;     ///< The current icon pixmap if in use
     Pixmap             m_iconMaskPixmap; ///< The current icon mask pixmap if in use
     ::Time             m_lastInputTime;  ///< Last time we received user input
+    bool               m_rawMouseInput;  ///< Are raw mouse motion events (XInput2) selected?
+    int                m_xinputOpcode;   ///< Major opcode of the XInput extension, identifies its generic events
+    Vector2f           m_rawRemainder;   ///< Fractional part of the raw mouse motion, carried over to the next event
 };
 
 } // namespace priv
@@ -31,6 +31,7 @@
 #include <windows.h>
 #include <tchar.h>
 #include <regstr.h>
+#include <cwchar>
 #include <algorithm>
 #include <cmath>
 #include <cstring>
@@ -76,6 +77,7 @@ namespace
         GUID guid;
         unsigned int index;
         bool plugged;
+        int xinputSlot;
     };
 
     typedef std::vector<JoystickRecord> JoystickList;
@@ -83,6 +85,100 @@ namespace
 }
 
 
+////////////////////////////////////////////////////////////
+// XInput
+////////////////////////////////////////////////////////////
+namespace
+{
+    // Declarations of xinput.h, which not all the supported compilers provide
+    struct XInputGamepad
+    {
+        WORD  wButtons;
+        BYTE  bLeftTrigger;
+        BYTE  bRightTrigger;
+        SHORT sThumbLX;
+        SHORT sThumbLY;
+        SHORT sThumbRX;
+        SHORT sThumbRY;
+    };
+
+    struct XInputState
+    {
+        DWORD         dwPacketNumber;
+        XInputGamepad Gamepad;
+    };
+
+    const DWORD xinputMaxCount = 4;
+
+    const WORD xinputDpadUp        = 0x0001;
+    const WORD xinputDpadDown      = 0x0002;
+    const WORD xinputDpadLeft      = 0x0004;
+    const WORD xinputDpadRight     = 0x0008;
+    const WORD xinputStart         = 0x0010;
+    const WORD xinputBack          = 0x0020;
+    const WORD xinputLeftThumb     = 0x0040;
+    const WORD xinputRightThumb    = 0x0080;
+    const WORD xinputLeftShoulder  = 0x0100;
+    const WORD xinputRightShoulder = 0x0200;
+    const WORD xinputA             = 0x1000;
+    const WORD xinputB             = 0x2000;
+    const WORD xinputX             = 0x4000;
+    const WORD xinputY             = 0x8000;
+
+    typedef DWORD (WINAPI *XInputGetStateFunc)(DWORD, XInputState*);
+
+    HMODULE xinputdll = NULL;
+    XInputGetStateFunc xinputGetState = NULL;
+
+    // Vendor and product ids (as in DIDEVICEINSTANCE::guidProduct) of the
+    // connected XInput controllers, which DirectInput must not report again
+    std::vector<DWORD> xinputProducts;
+
+    // Collect the vendor and product ids of the XInput controllers known
+    // to raw input: their device name contains "IG_"
+    void collectXInputProducts()
+    {
+        xinputProducts.clear();
+
+        UINT count = 0;
+        if ((GetRawInputDeviceList(NULL, &count, sizeof(RAWINPUTDEVICELIST)) != 0) || (count == 0))
+            return;
+
+        std::vector<RAWINPUTDEVICELIST> devices(count);
+        count = GetRawInputDeviceList(&devices[0], &count, sizeof(RAWINPUTDEVICELIST));
+        if (count == static_cast<UINT>(-1))
+            return;
+
+        for (UINT i = 0; i < count; ++i)
+        {
+            if (devices[i].dwType != RIM_TYPEHID)
+                continue;
+
+            RID_DEVICE_INFO info;
+            info.cbSize = sizeof(info);
+            UINT size = sizeof(info);
+            if (GetRawInputDeviceInfoW(devices[i].hDevice, RIDI_DEVICEINFO, &info, &size) == static_cast<UINT>(-1))
+                continue;
+
+            WCHAR name[256];
+            size = sizeof(name) / sizeof(name[0]);
+            if (GetRawInputDeviceInfoW(devices[i].hDevice, RIDI_DEVICENAME, name, &size) == static_cast<UINT>(-1))
+                continue;
+
+            name[255] = L'\0';
+            if (std::wcsstr(name, L"IG_"))
+                xinputProducts.push_back(MAKELONG(info.hid.dwVendorId, info.hid.dwProductId));
+        }
+    }
+
+    // Convert a thumb stick axis to the [-100, 100] range
+    float thumbAxis(SHORT value)
+    {
+        return (static_cast<float>(value) + 0.5f) * 100.f / 32767.5f;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 // Legacy joystick API
 ////////////////////////////////////////////////////////////
@@ -101,6 +197,9 @@ namespace
     // If true, will only update when WM_DEVICECHANGE message is received
     bool lazyUpdates = false;
 
+    // Set when the connections are updated, until notified by pollConnections
+    bool connectionsChanged = false;
+
     // Get a system error string from an error code
     std::string getErrorString(DWORD error)
     {
@@ -207,6 +306,8 @@ void JoystickImpl::initialize()
 
     if (!directInput)
         err() << "DirectInput not available, falling back to Windows joystick API" << std::endl;
+    else
+        initializeXInput();
 
     // Perform the initial scan and populate the connection cache
     updateConnections();
@@ -216,7 +317,8 @@ void JoystickImpl::initialize()
 ////////////////////////////////////////////////////////////
 void JoystickImpl::cleanup()
 {
-    // Clean up DirectInput
+    // Clean up XInput and DirectInput
+    cleanupXInput();
     cleanupDInput();
 }
 
@@ -240,6 +342,19 @@ bool JoystickImpl::isConnected(unsigned int index)
     return cache.connected;
 }
 
+////////////////////////////////////////////////////////////
+bool JoystickImpl::pollConnections()
+{
+    // Without lazy updates, the connection cache refreshes itself periodically
+    if (!lazyUpdates)
+        return true;
+
+    bool changed = connectionsChanged;
+    connectionsChanged = false;
+
+    return changed;
+}
+
 ////////////////////////////////////////////////////////////
 void JoystickImpl::setLazyUpdates(bool status)
 {
@@ -249,6 +364,8 @@ void JoystickImpl::setLazyUpdates(bool status)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::updateConnections()
 {
+    connectionsChanged = true;
+
     if (directInput)
         return updateConnectionsDInput();
 
@@ -267,6 +384,8 @@ void JoystickImpl::updateConnections()
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
+    m_xinputSlot = -1;
+
     if (directInput)
         return openDInput(index);
 
@@ -297,6 +416,9 @@ void JoystickImpl::close()
 ////////////////////////////////////////////////////////////
 JoystickCaps JoystickImpl::getCapabilities() const
 {
+    if (m_xinputSlot >= 0)
+        return getCapabilitiesXInput();
+
     if (directInput)
         return getCapabilitiesDInput();
 
@@ -329,6 +451,9 @@ Joystick::Identification JoystickImpl::getIdentification() const
 ////////////////////////////////////////////////////////////
 JoystickState JoystickImpl::update()
 {
+    if (m_xinputSlot >= 0)
+        return updateXInput();
+
     if (directInput)
         return updateDInput();
 
@@ -448,6 +573,9 @@ void JoystickImpl::updateConnectionsDInput()
     for (std::size_t i = 0; i < joystickList.size(); ++i)
         joystickList[i].plugged = false;
 
+    // XInput controllers come first, DirectInput skips them
+    updateConnectionsXInput();
+
     // Enumerate devices
     HRESULT result = directInput->EnumDevices(DI8DEVCLASS_GAMECTRL, &JoystickImpl::deviceEnumerationCallback, NULL, DIEDFL_ATTACHEDONLY);
 
@@ -505,6 +633,18 @@ bool JoystickImpl::openDInput(unsigned int index)
     {
         if (i->index == index)
         {
+            // XInput controllers have nothing to create
+            if (i->xinputSlot >= 0)
+            {
+                std::ostringstream name;
+                name << "XInput Controller #" << i->xinputSlot + 1;
+
+                m_xinputSlot          = i->xinputSlot;
+                m_identification.name = name.str();
+
+                return true;
+            }
+
             // Create device
             HRESULT result = directInput->CreateDevice(i->guid, &m_device, NULL);
 
@@ -815,9 +955,137 @@ JoystickState JoystickImpl::updateDInput()
 }
 
 
+////////////////////////////////////////////////////////////
+void JoystickImpl::initializeXInput()
+{
+    // Try the most recent version of XInput first
+    const char* libraries[] = {"xinput1_4.dll", "xinput1_3.dll", "xinput9_1_0.dll"};
+
+    for (std::size_t i = 0; (i < sizeof(libraries) / sizeof(libraries[0])) && !xinputdll; ++i)
+        xinputdll = LoadLibraryA(libraries[i]);
+
+    if (xinputdll)
+    {
+        xinputGetState = reinterpret_cast<XInputGetStateFunc>(GetProcAddress(xinputdll, "XInputGetState"));
+
+        if (!xinputGetState)
+        {
+            // Unload the library, DirectInput handles all the controllers
+            FreeLibrary(xinputdll);
+            xinputdll = NULL;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::cleanupXInput()
+{
+    xinputGetState = NULL;
+    xinputProducts.clear();
+
+    // Unload the XInput library
+    if (xinputdll)
+    {
+        FreeLibrary(xinputdll);
+        xinputdll = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void JoystickImpl::updateConnectionsXInput()
+{
+    if (!xinputGetState)
+        return;
+
+    // Querying an empty slot is slow, so slots are only checked when connections change
+    for (DWORD slot = 0; slot < xinputMaxCount; ++slot)
+    {
+        XInputState state;
+        if (xinputGetState(slot, &state) != ERROR_SUCCESS)
+            continue;
+
+        JoystickList::iterator record = joystickList.begin();
+        while ((record != joystickList.end()) && (record->xinputSlot != static_cast<int>(slot)))
+            ++record;
+
+        if (record != joystickList.end())
+        {
+            record->plugged = true;
+        }
+        else
+        {
+            JoystickRecord newRecord = { GUID(), sf::Joystick::Count, true, static_cast<int>(slot) };
+            joystickList.push_back(newRecord);
+        }
+    }
+
+    collectXInputProducts();
+}
+
+
+////////////////////////////////////////////////////////////
+JoystickCaps JoystickImpl::getCapabilitiesXInput() const
+{
+    JoystickCaps caps;
+
+    // A, B, X, Y, LB, RB, Back, Start, left and right thumbs
+    caps.buttonCount = 10;
+
+    for (int i = 0; i < Joystick::AxisCount; ++i)
+        caps.axes[i] = true;
+
+    return caps;
+}
+
+
+////////////////////////////////////////////////////////////
+JoystickState JoystickImpl::updateXInput()
+{
+    JoystickState state;
+
+    XInputState xinputState;
+    if (!xinputGetState || (xinputGetState(static_cast<DWORD>(m_xinputSlot), &xinputState) != ERROR_SUCCESS))
+        return state;
+
+    const XInputGamepad& pad = xinputState.Gamepad;
+
+    // Axes are oriented like the DirectInput ones: Y goes down, POV Y goes up
+    state.axes[Joystick::X]    = thumbAxis(pad.sThumbLX);
+    state.axes[Joystick::Y]    = -thumbAxis(pad.sThumbLY);
+    state.axes[Joystick::Z]    = pad.bLeftTrigger * 100.f / 255.f;
+    state.axes[Joystick::R]    = pad.bRightTrigger * 100.f / 255.f;
+    state.axes[Joystick::U]    = thumbAxis(pad.sThumbRX);
+    state.axes[Joystick::V]    = -thumbAxis(pad.sThumbRY);
+    state.axes[Joystick::PovX] = (pad.wButtons & xinputDpadRight) ? 100.f : (pad.wButtons & xinputDpadLeft) ? -100.f : 0.f;
+    state.axes[Joystick::PovY] = (pad.wButtons & xinputDpadUp)    ? 100.f : (pad.wButtons & xinputDpadDown) ? -100.f : 0.f;
+
+    // Buttons, in the order DirectInput reports them for these controllers
+    const WORD buttons[] =
+    {
+        xinputA, xinputB, xinputX, xinputY,
+        xinputLeftShoulder, xinputRightShoulder,
+        xinputBack, xinputStart,
+        xinputLeftThumb, xinputRightThumb
+    };
+
+    for (std::size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); ++i)
+        state.buttons[i] = (pad.wButtons & buttons[i]) != 0;
+
+    state.connected = true;
+
+    return state;
+}
+
+
 ////////////////////////////////////////////////////////////
 BOOL CALLBACK JoystickImpl::deviceEnumerationCallback(const DIDEVICEINSTANCE* deviceInstance, void*)
 {
+    // XInput controllers are handled separately
+    if (std::find(xinputProducts.begin(), xinputProducts.end(), deviceInstance->guidProduct.Data1) != xinputProducts.end())
+        return DIENUM_CONTINUE;
+
     for (std::size_t i = 0; i < joystickList.size(); ++i)
     {
         if (joystickList[i].guid == deviceInstance->guidInstance)
@@ -828,7 +1096,7 @@ BOOL CALLBACK JoystickImpl::deviceEnumerationCallback(const DIDEVICEINSTANCE* de
         }
     }
 
-    JoystickRecord record = { deviceInstance->guidInstance, sf::Joystick::Count, true };
+    JoystickRecord record = { deviceInstance->guidInstance, sf::Joystick::Count, true, -1 };
     joystickList.push_back(record);
 
     return DIENUM_CONTINUE;
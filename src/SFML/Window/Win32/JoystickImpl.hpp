@@ -79,6 +79,17 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isConnected(unsigned int index);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the pending joystick connection notifications
+    ///
+    /// Disconnected joysticks are only checked with isConnected
+    /// when this function reports connection changes.
+    ///
+    /// \return True if joysticks may have been connected since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool pollConnections();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable lazy enumeration updates
     ///
@@ -193,6 +204,43 @@ public:
     ////////////////////////////////////////////////////////////
     JoystickState updateDInput();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Perform the global initialization of the joystick module (XInput)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void initializeXInput();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Perform the global cleanup of the joystick module (XInput)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void cleanupXInput();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the connection status of the XInput controllers
+    ///
+    /// This also collects the XInput controllers seen through
+    /// raw input, so that DirectInput skips them.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateConnectionsXInput();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the joystick capabilities (XInput)
+    ///
+    /// \return Joystick capabilities
+    ///
+    ////////////////////////////////////////////////////////////
+    JoystickCaps getCapabilitiesXInput() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the joystick and get its new state (XInput)
+    ///
+    /// \return Joystick state
+    ///
+    ////////////////////////////////////////////////////////////
+    JoystickState updateXInput();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -223,6 +271,7 @@ private:
     unsigned int             m_index;                          ///< Index of the joystick
     JOYCAPS                  m_caps;                           ///< Joystick capabilities
     IDirectInputDevice8W*    m_device;                         ///< DirectInput 8.x device
+    int                      m_xinputSlot;                     ///< XInput user index of the controller, -1 if not an XInput controller
     DIDEVCAPS                m_deviceCaps;                     ///< DirectInput device capabilities
     int                      m_axes[Joystick::AxisCount];      ///< Offsets to the bytes containing the axes states, -1 if not available
     int                      m_buttons[Joystick::ButtonCount]; ///< Offsets to the bytes containing the button states, -1 if not available
@@ -32,6 +32,7 @@
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Err.hpp>
+#include <map>
 #include <sstream>
 #include <vector>
 
@@ -41,6 +42,57 @@ namespace
     // Some drivers are bugged and don't track the current HDC/HGLRC properly
     // In order to deactivate successfully, we need to track it ourselves as well
     sf::ThreadLocalPtr<sf::priv::WglContext> currentContext(NULL);
+
+    // Settings that the choice of a pixel format depends on
+    struct PixelFormatKey
+    {
+        unsigned int bitsPerPixel;
+        unsigned int depthBits;
+        unsigned int stencilBits;
+        unsigned int antialiasingLevel;
+        bool         sRgbCapable;
+        bool         pbuffer;
+
+        bool operator <(const PixelFormatKey& right) const
+        {
+            if (bitsPerPixel != right.bitsPerPixel)           return bitsPerPixel < right.bitsPerPixel;
+            if (depthBits != right.depthBits)                 return depthBits < right.depthBits;
+            if (stencilBits != right.stencilBits)             return stencilBits < right.stencilBits;
+            if (antialiasingLevel != right.antialiasingLevel) return antialiasingLevel < right.antialiasingLevel;
+            if (sRgbCapable != right.sRgbCapable)             return sRgbCapable < right.sRgbCapable;
+            return pbuffer < right.pbuffer;
+        }
+    };
+
+    // Pixel formats already chosen with wglChoosePixelFormatARB, querying
+    // the attributes of every format takes a noticeable time
+    sf::Mutex pixelFormatCacheMutex;
+    std::map<PixelFormatKey, int> pixelFormatCache;
+
+    // DwmFlush is loaded at runtime, dwmapi.dll doesn't exist before Windows Vista
+    typedef HRESULT (WINAPI* DwmFlushFuncType)(void);
+
+    sf::Mutex dwmFlushMutex;
+
+    DwmFlushFuncType getDwmFlush()
+    {
+        static bool loaded = false;
+        static DwmFlushFuncType dwmFlush = NULL;
+
+        sf::Lock lock(dwmFlushMutex);
+
+        if (!loaded)
+        {
+            loaded = true;
+
+            // The library stays loaded until the process exits
+            HINSTANCE dwmapiDll = LoadLibraryA("dwmapi.dll");
+            if (dwmapiDll)
+                dwmFlush = reinterpret_cast<DwmFlushFuncType>(GetProcAddress(dwmapiDll, "DwmFlush"));
+        }
+
+        return dwmFlush;
+    }
 }
 
 
@@ -243,13 +295,25 @@ void WglContext::display()
 
 ////////////////////////////////////////////////////////////
 void WglContext::setVerticalSyncEnabled(bool enabled)
+{
+    setSwapInterval(enabled ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void WglContext::setSwapInterval(int interval)
 {
     // Make sure that extensions are initialized
     ensureExtensionsInit(m_deviceContext);
 
+    // Negative intervals (late swaps tear) are only supported by
+    // WGL_EXT_swap_control_tear, fall back to regular vertical sync
+    if ((interval < 0) && (sfwgl_ext_EXT_swap_control_tear != sfwgl_LOAD_SUCCEEDED))
+        interval = -interval;
+
     if (sfwgl_ext_EXT_swap_control == sfwgl_LOAD_SUCCEEDED)
     {
-        if (wglSwapIntervalEXT(enabled ? 1 : 0) == FALSE)
+        if (wglSwapIntervalEXT(interval) == FALSE)
             err() << "Setting vertical sync failed: " << getErrorString(GetLastError()).toAnsiString() << std::endl;
     }
     else
@@ -267,9 +331,35 @@ void WglContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+bool WglContext::waitForVerticalBlank()
+{
+    // The desktop compositor presents a frame at each vertical blank, DwmFlush
+    // fails when composition is disabled since there is nothing to wait for then
+    DwmFlushFuncType dwmFlush = getDwmFlush();
+
+    return dwmFlush && SUCCEEDED(dwmFlush());
+}
+
+
 ////////////////////////////////////////////////////////////
 int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings, bool pbuffer)
 {
+    PixelFormatKey key;
+    key.bitsPerPixel      = bitsPerPixel;
+    key.depthBits         = settings.depthBits;
+    key.stencilBits       = settings.stencilBits;
+    key.antialiasingLevel = settings.antialiasingLevel;
+    key.sRgbCapable       = settings.sRgbCapable;
+    key.pbuffer           = pbuffer;
+
+    Lock lock(pixelFormatCacheMutex);
+
+    // Reuse the format chosen by a previous context with the same settings, if any
+    std::map<PixelFormatKey, int>::const_iterator cached = pixelFormatCache.find(key);
+    if (cached != pixelFormatCache.end())
+        return cached->second;
+
     // Let's find a suitable pixel format -- first try with wglChoosePixelFormatARB
     int bestFormat = 0;
     if (sfwgl_ext_ARB_pixel_format == sfwgl_LOAD_SUCCEEDED)
@@ -376,6 +466,10 @@ int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPix
                 }
             }
         }
+
+        // Pixel format indices are shared by all the device contexts of the display device
+        if (bestFormat != 0)
+            pixelFormatCache[key] = bestFormat;
     }
 
     // ChoosePixelFormat doesn't support pbuffers
@@ -119,6 +119,22 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of vertical blanks to wait for between swaps
+    ///
+    /// \param interval Swap interval, negative for adaptive vertical sync
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the display starts showing a new frame
+    ///
+    /// \return True if the function waited for a vertical blank
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForVerticalBlank();
+
     ////////////////////////////////////////////////////////////
     /// \brief Select the best pixel format for a given set of settings
     ///
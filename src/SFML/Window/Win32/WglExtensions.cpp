@@ -38,6 +38,7 @@ static sf::GlFunctionPointer IntGetProcAddress(const char* name)
 }
 
 int sfwgl_ext_EXT_swap_control = sfwgl_LOAD_FAILED;
+int sfwgl_ext_EXT_swap_control_tear = sfwgl_LOAD_FAILED;
 int sfwgl_ext_EXT_framebuffer_sRGB = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_framebuffer_sRGB = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_multisample = sfwgl_LOAD_FAILED;
@@ -129,8 +130,9 @@ typedef struct sfwgl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfwgl_StrToExtMap;
 
-static sfwgl_StrToExtMap ExtensionMap[8] = {
+static sfwgl_StrToExtMap ExtensionMap[9] = {
     {"WGL_EXT_swap_control", &sfwgl_ext_EXT_swap_control, Load_EXT_swap_control},
+    {"WGL_EXT_swap_control_tear", &sfwgl_ext_EXT_swap_control_tear, NULL},
     {"WGL_EXT_framebuffer_sRGB", &sfwgl_ext_EXT_framebuffer_sRGB, NULL},
     {"WGL_ARB_framebuffer_sRGB", &sfwgl_ext_ARB_framebuffer_sRGB, NULL},
     {"WGL_ARB_multisample", &sfwgl_ext_ARB_multisample, NULL},
@@ -140,7 +142,7 @@ static sfwgl_StrToExtMap ExtensionMap[8] = {
     {"WGL_ARB_create_context_profile", &sfwgl_ext_ARB_create_context_profile, NULL}
 };
 
-static int g_extensionMapSize = 8;
+static int g_extensionMapSize = 9;
 
 
 static sfwgl_StrToExtMap* FindExtEntry(const char* extensionName)
@@ -159,6 +161,7 @@ static sfwgl_StrToExtMap* FindExtEntry(const char* extensionName)
 static void ClearExtensionVars(void)
 {
     sfwgl_ext_EXT_swap_control = sfwgl_LOAD_FAILED;
+    sfwgl_ext_EXT_swap_control_tear = sfwgl_LOAD_FAILED;
     sfwgl_ext_EXT_framebuffer_sRGB = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_framebuffer_sRGB = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_multisample = sfwgl_LOAD_FAILED;
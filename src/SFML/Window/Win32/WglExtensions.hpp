@@ -93,6 +93,7 @@ extern "C" {
 #endif // __cplusplus
 
 extern int sfwgl_ext_EXT_swap_control;
+extern int sfwgl_ext_EXT_swap_control_tear;
 extern int sfwgl_ext_EXT_framebuffer_sRGB;
 extern int sfwgl_ext_ARB_framebuffer_sRGB;
 extern int sfwgl_ext_ARB_multisample;
@@ -38,6 +38,7 @@
 #include <SFML/Window/WindowStyle.hpp>
 #include <GL/gl.h>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Utf.hpp>
 // dbt.h is lowercase here, as a cross-compile on linux with mingw-w64
 // expects lowercase, and a native compile on windows, whether via msvc
@@ -69,6 +70,13 @@ namespace
 
     const GUID GUID_DEVINTERFACE_HID = {0x4d1e55b2, 0xf16f, 0x11cf, {0x88, 0xcb, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30}};
 
+    // Events that the event thread can queue before it waits for the window thread to collect them
+    const std::size_t threadEventCapacity = 1024;
+
+    // Private messages asking the event thread to change the cursor, which is a state of the thread owning the window
+    const UINT showCursorMessage = WM_APP + 0;
+    const UINT setCursorMessage  = WM_APP + 1;
+
     void setProcessDpiAware()
     {
         // Try SetProcessDpiAwareness first
@@ -142,7 +150,15 @@ m_resizing        (false),
 m_surrogate       (0),
 m_mouseInside     (false),
 m_fullscreen      (false),
-m_cursorGrabbed   (false)
+m_cursorGrabbed   (false),
+m_rawMouseInput   (false),
+m_eventThread     (NULL),
+m_eventThreadId   (0),
+m_eventThreadRunning(false),
+m_pendingCreation (NULL),
+m_windowCreated   (NULL),
+m_eventsAvailable (NULL),
+m_threadEvents    (threadEventCapacity)
 {
     // Set that this process is DPI aware and can handle DPI scaling
     setProcessDpiAware();
@@ -175,7 +191,15 @@ m_resizing        (false),
 m_surrogate       (0),
 m_mouseInside     (false),
 m_fullscreen      ((style & Style::Fullscreen) != 0),
-m_cursorGrabbed   (m_fullscreen)
+m_cursorGrabbed   (m_fullscreen),
+m_rawMouseInput   (false),
+m_eventThread     (NULL),
+m_eventThreadId   (0),
+m_eventThreadRunning(false),
+m_pendingCreation (NULL),
+m_windowCreated   (NULL),
+m_eventsAvailable (NULL),
+m_threadEvents    (threadEventCapacity)
 {
     // Set that this process is DPI aware and can handle DPI scaling
     setProcessDpiAware();
@@ -194,7 +218,7 @@ m_cursorGrabbed   (m_fullscreen)
 
     // Choose the window style according to the Style parameter
     DWORD win32Style = WS_VISIBLE;
-    if (style == Style::None)
+    if ((style & ~Style::EventThread) == Style::None)
     {
         win32Style |= WS_POPUP;
     }
@@ -214,12 +238,33 @@ m_cursorGrabbed   (m_fullscreen)
         height = rectangle.bottom - rectangle.top;
     }
 
+    CreationParameters parameters;
+    parameters.title  = title.toWideString();
+    parameters.style  = win32Style;
+    parameters.left   = left;
+    parameters.top    = top;
+    parameters.width  = width;
+    parameters.height = height;
+
     // Create the window
-    m_handle = CreateWindowW(className, title.toWideString().c_str(), win32Style, left, top, width, height, NULL, NULL, GetModuleHandle(NULL), this);
+    if (style & Style::EventThread)
+    {
+        // The window belongs to the thread that creates it, so it is created by the event thread
+        m_windowCreated   = CreateEventW(NULL, FALSE, FALSE, NULL);
+        m_eventsAvailable = CreateEventW(NULL, FALSE, FALSE, NULL);
+        m_pendingCreation = &parameters;
 
-    // Register to receive device interface change notifications (used for joystick connection handling)
-    DEV_BROADCAST_DEVICEINTERFACE deviceInterface = {sizeof(DEV_BROADCAST_DEVICEINTERFACE), DBT_DEVTYP_DEVICEINTERFACE, 0, GUID_DEVINTERFACE_HID, 0};
-    RegisterDeviceNotification(m_handle, &deviceInterface, DEVICE_NOTIFY_WINDOW_HANDLE);
+        m_eventThreadRunning.store(true);
+        m_eventThread = new Thread(&WindowImplWin32::runEventThread, this);
+        m_eventThread->launch();
+
+        WaitForSingleObject(m_windowCreated, INFINITE);
+        m_pendingCreation = NULL;
+    }
+    else
+    {
+        createWindow(parameters);
+    }
 
     // If we're the first window handle, we only need to poll for joysticks when WM_DEVICECHANGE message is received
     if (m_handle)
@@ -248,6 +293,10 @@ WindowImplWin32::~WindowImplWin32()
 {
     // TODO should we restore the cursor shape and visibility?
 
+    // Stop receiving raw input before the window handle becomes invalid
+    if (m_rawMouseInput)
+        setRawMouseInputEnabled(false);
+
     // Destroy the custom icon, if any
     if (m_icon)
         DestroyIcon(m_icon);
@@ -261,7 +310,25 @@ WindowImplWin32::~WindowImplWin32()
             JoystickImpl::setLazyUpdates(false);
     }
 
-    if (!m_callback)
+    if (m_eventThread)
+    {
+        // The event thread destroys the window when it leaves its message loop
+        m_eventThreadRunning.store(false);
+        PostThreadMessageW(m_eventThreadId, WM_QUIT, 0, 0);
+        m_eventThread->wait();
+
+        delete m_eventThread;
+        CloseHandle(m_windowCreated);
+        CloseHandle(m_eventsAvailable);
+
+        // Decrement the window count
+        windowCount--;
+
+        // Unregister window class if we were the last window
+        if (windowCount == 0)
+            UnregisterClassW(className, GetModuleHandleW(NULL));
+    }
+    else if (!m_callback)
     {
         // Destroy the window
         if (m_handle)
@@ -292,9 +359,16 @@ WindowHandle WindowImplWin32::getSystemHandle() const
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::processEvents()
 {
-    // We process the window events only if we own it
-    if (!m_callback)
+    if (m_eventThread)
+    {
+        // Collect the events queued by the event thread
+        Event event;
+        while (m_threadEvents.pop(event))
+            pushEvent(event);
+    }
+    else if (!m_callback)
     {
+        // We process the window events only if we own it
         MSG message;
         while (PeekMessageW(&message, NULL, 0, 0, PM_REMOVE))
         {
@@ -305,6 +379,31 @@ void WindowImplWin32::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::waitForEvents(Int32 timeout)
+{
+    // The messages of windows we don't own are pumped by their owner, keep polling
+    if (m_callback)
+    {
+        WindowImpl::waitForEvents(timeout);
+        return;
+    }
+
+    DWORD waitTime = (timeout < 0) ? INFINITE : static_cast<DWORD>(timeout);
+
+    // The event thread signals the events it queues, including those of joystick connections
+    if (m_eventThread)
+    {
+        WaitForSingleObject(m_eventsAvailable, waitTime);
+        return;
+    }
+
+    // Joystick connections are notified by WM_DEVICECHANGE, so they wake up the wait as well;
+    // MWMO_INPUTAVAILABLE also returns for messages that were seen but not removed yet
+    MsgWaitForMultipleObjectsEx(0, NULL, waitTime, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplWin32::getPosition() const
 {
@@ -405,7 +504,16 @@ void WindowImplWin32::setMouseCursorVisible(bool visible)
     if (visible != m_cursorVisible)
     {
         m_cursorVisible = visible;
-        ShowCursor(visible);
+
+        // The display counter of the cursor belongs to the thread of the window
+        if (m_eventThread)
+        {
+            SendMessageW(m_handle, showCursorMessage, visible, 0);
+        }
+        else
+        {
+            ShowCursor(visible);
+        }
     }
 }
 
@@ -422,7 +530,15 @@ void WindowImplWin32::setMouseCursorGrabbed(bool grabbed)
 void WindowImplWin32::setMouseCursor(const CursorImpl& cursor)
 {
     m_lastCursor = cursor.m_cursor;
-    SetCursor(m_lastCursor);
+
+    if (m_eventThread)
+    {
+        SendMessageW(m_handle, setCursorMessage, 0, 0);
+    }
+    else
+    {
+        SetCursor(m_lastCursor);
+    }
 }
 
 
@@ -433,6 +549,29 @@ void WindowImplWin32::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::setRawMouseInputEnabled(bool enabled)
+{
+    if (enabled == m_rawMouseInput)
+        return;
+
+    // Register the window for the WM_INPUT messages of the mice
+    RAWINPUTDEVICE device;
+    device.usUsagePage = 0x01; // Generic desktop controls
+    device.usUsage     = 0x02; // Mouse
+    device.dwFlags     = enabled ? 0 : RIDEV_REMOVE;
+    device.hwndTarget  = enabled ? m_handle : NULL;
+
+    if (!RegisterRawInputDevices(&device, 1, sizeof(device)))
+    {
+        err() << "Failed to " << (enabled ? "enable" : "disable") << " raw mouse input" << std::endl;
+        return;
+    }
+
+    m_rawMouseInput = enabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::requestFocus()
 {
@@ -536,6 +675,67 @@ void WindowImplWin32::cleanup()
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::createWindow(const CreationParameters& parameters)
+{
+    m_handle = CreateWindowW(className, parameters.title.c_str(), parameters.style, parameters.left, parameters.top,
+                             parameters.width, parameters.height, NULL, NULL, GetModuleHandle(NULL), this);
+
+    // Register to receive device interface change notifications (used for joystick connection handling)
+    DEV_BROADCAST_DEVICEINTERFACE deviceInterface = {sizeof(DEV_BROADCAST_DEVICEINTERFACE), DBT_DEVTYP_DEVICEINTERFACE, 0, GUID_DEVINTERFACE_HID, 0};
+    RegisterDeviceNotification(m_handle, &deviceInterface, DEVICE_NOTIFY_WINDOW_HANDLE);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplWin32::runEventThread()
+{
+    // Creating the window also creates the message queue to which the destructor posts WM_QUIT
+    m_eventThreadId = GetCurrentThreadId();
+    createWindow(*m_pendingCreation);
+    SetEvent(m_windowCreated);
+
+    if (!m_handle)
+        return;
+
+    // Moving or resizing the window runs a modal loop inside DispatchMessageW,
+    // it only blocks this thread, the thread of the window keeps rendering
+    MSG message;
+    while (GetMessageW(&message, NULL, 0, 0) > 0)
+    {
+        TranslateMessage(&message);
+        DispatchMessageW(&message);
+    }
+
+    // The window must be destroyed by the thread that created it
+    DestroyWindow(m_handle);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplWin32::queueEvent(const Event& event)
+{
+    if (!m_eventThread)
+    {
+        pushEvent(event);
+        return;
+    }
+
+    // Wait for the thread of the window to make room if it doesn't collect its events,
+    // unless the window is being destroyed
+    while (!m_threadEvents.push(event))
+    {
+        if (!m_eventThreadRunning.load())
+            return;
+
+        SetEvent(m_eventsAvailable);
+        sleep(milliseconds(1));
+    }
+
+    SetEvent(m_eventsAvailable);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::setTracking(bool track)
 {
@@ -582,6 +782,23 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             break;
         }
 
+        // Cursor changes requested by the thread of the window (the messages only have this meaning for our own windows)
+        case showCursorMessage:
+        {
+            if (m_eventThread)
+                ShowCursor(wParam != 0);
+
+            break;
+        }
+
+        case setCursorMessage:
+        {
+            if (m_eventThread)
+                SetCursor(m_lastCursor);
+
+            break;
+        }
+
         // Set cursor event
         case WM_SETCURSOR:
         {
@@ -597,7 +814,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
         {
             Event event;
             event.type = Event::Closed;
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -615,7 +832,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                 event.type        = Event::Resized;
                 event.size.width  = m_lastSize.x;
                 event.size.height = m_lastSize.y;
-                pushEvent(event);
+                queueEvent(event);
 
                 // Restore/update cursor grabbing
                 grabCursor(m_cursorGrabbed);
@@ -647,7 +864,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                 event.type        = Event::Resized;
                 event.size.width  = m_lastSize.x;
                 event.size.height = m_lastSize.y;
-                pushEvent(event);
+                queueEvent(event);
             }
 
             // Restore/update cursor grabbing
@@ -674,7 +891,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
 
             Event event;
             event.type = Event::GainedFocus;
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -686,7 +903,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
 
             Event event;
             event.type = Event::LostFocus;
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -719,7 +936,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                     Event event;
                     event.type = Event::TextEntered;
                     event.text.unicode = character;
-                    pushEvent(event);
+                    queueEvent(event);
                 }
             }
             break;
@@ -738,7 +955,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                 event.key.shift   = HIWORD(GetKeyState(VK_SHIFT))   != 0;
                 event.key.system  = HIWORD(GetKeyState(VK_LWIN)) || HIWORD(GetKeyState(VK_RWIN));
                 event.key.code    = virtualKeyCodeToSF(wParam, lParam);
-                pushEvent(event);
+                queueEvent(event);
             }
             break;
         }
@@ -754,7 +971,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.key.shift   = HIWORD(GetKeyState(VK_SHIFT))   != 0;
             event.key.system  = HIWORD(GetKeyState(VK_LWIN)) || HIWORD(GetKeyState(VK_RWIN));
             event.key.code    = virtualKeyCodeToSF(wParam, lParam);
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -775,14 +992,14 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseWheel.delta = delta / 120;
             event.mouseWheel.x     = position.x;
             event.mouseWheel.y     = position.y;
-            pushEvent(event);
+            queueEvent(event);
 
             event.type                   = Event::MouseWheelScrolled;
             event.mouseWheelScroll.wheel = Mouse::VerticalWheel;
             event.mouseWheelScroll.delta = static_cast<float>(delta) / 120.f;
             event.mouseWheelScroll.x     = position.x;
             event.mouseWheelScroll.y     = position.y;
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -803,7 +1020,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseWheelScroll.delta = -static_cast<float>(delta) / 120.f;
             event.mouseWheelScroll.x     = position.x;
             event.mouseWheelScroll.y     = position.y;
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -815,7 +1032,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = Mouse::Left;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -827,7 +1044,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = Mouse::Left;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -839,7 +1056,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = Mouse::Right;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -851,7 +1068,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = Mouse::Right;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -863,7 +1080,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = Mouse::Middle;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -875,7 +1092,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = Mouse::Middle;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -887,7 +1104,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = HIWORD(wParam) == XBUTTON1 ? Mouse::XButton1 : Mouse::XButton2;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -899,7 +1116,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.mouseButton.button = HIWORD(wParam) == XBUTTON1 ? Mouse::XButton1 : Mouse::XButton2;
             event.mouseButton.x      = static_cast<Int16>(LOWORD(lParam));
             event.mouseButton.y      = static_cast<Int16>(HIWORD(lParam));
-            pushEvent(event);
+            queueEvent(event);
             break;
         }
 
@@ -914,7 +1131,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                 // Generate a MouseLeft event
                 Event event;
                 event.type = Event::MouseLeft;
-                pushEvent(event);
+                queueEvent(event);
             }
             break;
         }
@@ -957,7 +1174,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                     // Generate a MouseLeft event
                     Event event;
                     event.type = Event::MouseLeft;
-                    pushEvent(event);
+                    queueEvent(event);
                 }
             }
             else
@@ -973,7 +1190,7 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
                     // Generate a MouseEntered event
                     Event event;
                     event.type = Event::MouseEntered;
-                    pushEvent(event);
+                    queueEvent(event);
                 }
             }
 
@@ -982,7 +1199,35 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             event.type        = Event::MouseMoved;
             event.mouseMove.x = x;
             event.mouseMove.y = y;
-            pushEvent(event);
+            queueEvent(event);
+            break;
+        }
+
+        // Raw input event
+        case WM_INPUT:
+        {
+            if (!m_rawMouseInput)
+                break;
+
+            RAWINPUT input;
+            UINT size = sizeof(input);
+
+            if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &input, &size, sizeof(RAWINPUTHEADER)) == static_cast<UINT>(-1))
+                break;
+
+            // Absolute devices (tablets, remote desktop sessions) report positions, not motion
+            if ((input.header.dwType == RIM_TYPEMOUSE) && !(input.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE))
+            {
+                if ((input.data.mouse.lLastX != 0) || (input.data.mouse.lLastY != 0))
+                {
+                    Event event;
+                    event.type                = Event::MouseMovedRaw;
+                    event.mouseMoveRaw.deltaX = input.data.mouse.lLastX;
+                    event.mouseMoveRaw.deltaY = input.data.mouse.lLastY;
+                    queueEvent(event);
+                }
+            }
+
             break;
         }
         case WM_DEVICECHANGE:
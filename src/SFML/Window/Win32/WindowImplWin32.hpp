@@ -30,8 +30,12 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/WindowImpl.hpp>
+#include <SFML/System/Atomic.hpp>
+#include <SFML/System/SpscQueue.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Thread.hpp>
 #include <windows.h>
+#include <string>
 
 
 namespace sf
@@ -169,6 +173,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable raw mouse input events
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setRawMouseInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -192,6 +204,14 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the message queue of the thread has messages
+    ///
+    /// \param timeout Maximum time to wait in milliseconds, negative to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Int32 timeout);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -214,6 +234,49 @@ private:
     ////////////////////////////////////////////////////////////
     void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Parameters of the creation of a window
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CreationParameters
+    {
+        std::wstring title;  ///< Title of the window
+        DWORD        style;  ///< Win32 window style
+        int          left;   ///< Left position of the window
+        int          top;    ///< Top position of the window
+        int          width;  ///< Width of the window, borders included
+        int          height; ///< Height of the window, borders included
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the window handle
+    ///
+    /// \param parameters Parameters of the window to create
+    ///
+    ////////////////////////////////////////////////////////////
+    void createWindow(const CreationParameters& parameters);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the window and pump its messages
+    ///
+    /// This function runs in the event thread when the window
+    /// was created with Style::EventThread: a window receives
+    /// its messages in the thread that created it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void runEventThread();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue an event produced by a Win32 message
+    ///
+    /// With an event thread, the event is handed over to the
+    /// thread of the window through a lock-free queue.
+    ///
+    /// \param event Event to queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void queueEvent(const Event& event);
+
     ////////////////////////////////////////////////////////////
     /// \brief Process a Win32 event
     ///
@@ -284,6 +347,14 @@ private:
     bool     m_mouseInside;      ///< Mouse is inside the window?
     bool     m_fullscreen;       ///< Is the window fullscreen?
     bool     m_cursorGrabbed;    ///< Is the mouse cursor trapped?
+    bool     m_rawMouseInput;    ///< Are raw mouse input events (WM_INPUT) enabled?
+    Thread*  m_eventThread;      ///< Thread pumping the messages of the window (NULL if they are pumped by processEvents)
+    DWORD    m_eventThreadId;    ///< Identifier of the event thread
+    Atomic<bool> m_eventThreadRunning; ///< Must the event thread keep pumping messages?
+    const CreationParameters* m_pendingCreation; ///< Parameters of the window to be created by the event thread
+    HANDLE   m_windowCreated;    ///< Signaled by the event thread once it created the window
+    HANDLE   m_eventsAvailable;  ///< Signaled by the event thread when it queues events
+    SpscQueue<Event> m_threadEvents; ///< Events queued by the event thread, waiting to be collected by processEvents
 };
 
 } // namespace priv
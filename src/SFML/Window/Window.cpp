@@ -26,15 +26,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Window.hpp>
+#include <SFML/Window/FramePacer.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
 
 
 namespace
 {
-    const sf::Window* fullscreenWindow = NULL;
+    const sf::Window* currentFullscreenWindow = NULL;
 }
 
 
@@ -44,7 +44,7 @@ namespace sf
 Window::Window() :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
+m_framePacer    (NULL),
 m_size          (0, 0)
 {
 
@@ -55,7 +55,7 @@ m_size          (0, 0)
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
+m_framePacer    (NULL),
 m_size          (0, 0)
 {
     create(mode, title, style, settings);
@@ -66,7 +66,7 @@ m_size          (0, 0)
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
 m_impl          (NULL),
 m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
+m_framePacer    (NULL),
 m_size          (0, 0)
 {
     create(handle, settings);
@@ -77,6 +77,8 @@ m_size          (0, 0)
 Window::~Window()
 {
     close();
+
+    delete m_framePacer;
 }
 
 
@@ -90,7 +92,7 @@ void Window::create(VideoMode mode, const String& title, Uint32 style, const Con
     if (style & Style::Fullscreen)
     {
         // Make sure there's not already a fullscreen window (only one is allowed)
-        if (fullscreenWindow)
+        if (currentFullscreenWindow)
         {
             err() << "Creating two fullscreen windows is not allowed, switching to windowed mode" << std::endl;
             style &= ~Style::Fullscreen;
@@ -105,7 +107,7 @@ void Window::create(VideoMode mode, const String& title, Uint32 style, const Con
             }
 
             // Update the fullscreen window
-            fullscreenWindow = this;
+            currentFullscreenWindow = this;
         }
     }
 
@@ -160,8 +162,8 @@ void Window::close()
     m_impl = NULL;
 
     // Update the fullscreen window
-    if (this == fullscreenWindow)
-        fullscreenWindow = NULL;
+    if (this == currentFullscreenWindow)
+        currentFullscreenWindow = NULL;
 }
 
 
@@ -195,6 +197,21 @@ bool Window::pollEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t Window::pollEvents(Event* events, std::size_t maxCount)
+{
+    if (!m_impl)
+        return 0;
+
+    std::size_t count = m_impl->popEvents(events, maxCount);
+
+    for (std::size_t i = 0; i < count; ++i)
+        filterEvent(events[i]);
+
+    return count;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::waitEvent(Event& event)
 {
@@ -209,6 +226,20 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::waitEvent(Event& event, Time timeout)
+{
+    if (m_impl && m_impl->popEvent(event, timeout > Time::Zero, timeout))
+    {
+        return filterEvent(event);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -280,6 +311,14 @@ void Window::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setSwapInterval(int interval)
+{
+    if (setActive())
+        m_context->setSwapInterval(interval);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setMouseCursorVisible(bool visible)
 {
@@ -304,6 +343,14 @@ void Window::setMouseCursor(const Cursor& cursor)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setRawMouseInputEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setRawMouseInputEnabled(enabled);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setKeyRepeatEnabled(bool enabled)
 {
@@ -316,9 +363,23 @@ void Window::setKeyRepeatEnabled(bool enabled)
 void Window::setFramerateLimit(unsigned int limit)
 {
     if (limit > 0)
-        m_frameTimeLimit = seconds(1.f / limit);
-    else
-        m_frameTimeLimit = Time::Zero;
+    {
+        if (!m_framePacer)
+            m_framePacer = new priv::FramePacer;
+
+        m_framePacer->setFrameTime(seconds(1.f / limit));
+    }
+    else if (m_framePacer)
+    {
+        m_framePacer->setFrameTime(Time::Zero);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Time Window::getFrameTimeJitter() const
+{
+    return m_framePacer ? m_framePacer->getJitter() : Time::Zero;
 }
 
 
@@ -330,6 +391,14 @@ void Window::setJoystickThreshold(float threshold)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setInputThreadRate(unsigned int rate)
+{
+    if (m_impl)
+        m_impl->setInputThreadRate(rate);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::setActive(bool active) const
 {
@@ -370,17 +439,50 @@ bool Window::hasFocus() const
 ////////////////////////////////////////////////////////////
 
 void Window::display()
+{
+    // Derived classes finish their frame before presenting it
+    onDisplay();
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::onDisplay()
 {
     // Display the backbuffer on screen
     if (setActive())
         m_context->display();
 
     // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+    if (m_framePacer)
+        m_framePacer->wait();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Window::getBackBufferAge() const
+{
+    return setActive() ? m_context->getBackBufferAge() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Window::waitForVerticalBlank()
+{
+    // The context doesn't have to be active, only its drawable is needed
+    return m_context && m_context->waitForVerticalBlank();
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::displayDamage(const int* rects, std::size_t count)
+{
+    // Display the backbuffer on screen
+    if (setActive())
+        m_context->displayDamage(rects, count);
+
+    // Limit the framerate if needed
+    if (m_framePacer)
+        m_framePacer->wait();
 }
 
 
@@ -437,7 +539,8 @@ void Window::initialize()
     m_size = m_impl->getSize();
 
     // Reset frame time
-    m_clock.restart();
+    if (m_framePacer)
+        m_framePacer->reset();
 
     // Activate the window
     setActive();
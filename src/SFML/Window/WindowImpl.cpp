@@ -30,6 +30,10 @@
 #include <SFML/Window/JoystickManager.hpp>
 #include <SFML/Window/SensorManager.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <algorithm>
 #include <cmath>
 
@@ -61,6 +65,22 @@
 #endif
 
 
+namespace
+{
+    // Interval at which joysticks and sensors are polled by blocking waits, in milliseconds
+    const sf::Int32 pollingInterval = 10;
+
+    // Number of sampled events the input thread can hand over before the window thread queues them
+    const std::size_t inputEventCapacity = 1024;
+
+    // Clock giving the timestamps of the events
+    const sf::Clock eventClock;
+
+    // Joystick and sensor managers are shared by the windows and their input threads
+    sf::Mutex inputMutex;
+}
+
+
 namespace sf
 {
 namespace priv
@@ -81,8 +101,15 @@ WindowImpl* WindowImpl::create(WindowHandle handle)
 
 ////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl() :
-m_joystickThreshold(0.1f)
+m_joystickThreshold (0.1f),
+m_sampledEvents     (),
+m_inputThread       (NULL),
+m_inputThreadRunning(false),
+m_inputInterval     (),
+m_inputEvents       (inputEventCapacity)
 {
+    Lock lock(inputMutex);
+
     // Get the initial joystick states
     JoystickManager::getInstance().update();
     for (unsigned int i = 0; i < Joystick::Count; ++i)
@@ -100,7 +127,7 @@ m_joystickThreshold(0.1f)
 ////////////////////////////////////////////////////////////
 WindowImpl::~WindowImpl()
 {
-    // Nothing to do
+    stopInputThread();
 }
 
 
@@ -112,39 +139,136 @@ void WindowImpl::setJoystickThreshold(float threshold)
 
 
 ////////////////////////////////////////////////////////////
-bool WindowImpl::popEvent(Event& event, bool block)
+void WindowImpl::setInputThreadRate(unsigned int rate)
+{
+    stopInputThread();
+
+    if (rate > 0)
+    {
+        m_inputInterval = microseconds(std::max(1000000 / static_cast<Int64>(rate), static_cast<Int64>(1)));
+        m_inputThreadRunning.store(true);
+
+        m_inputThread = new Thread(&WindowImpl::sampleInput, this);
+        m_inputThread->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setRawMouseInputEnabled(bool enabled)
+{
+    if (enabled)
+        err() << "Raw mouse input is not supported on this platform" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::popEvent(Event& event, bool block, Time timeout)
 {
     // If the event queue is empty, let's first check if new events are available from the OS
     if (m_events.empty())
     {
         // Get events from the system
-        processJoystickEvents();
-        processSensorEvents();
+        processInputEvents();
         processEvents();
 
         // In blocking mode, we must process events until one is triggered
         if (block)
         {
-            // Here we use a manual wait loop instead of the optimized
-            // wait-event provided by the OS, so that we don't skip joystick
-            // events (which require polling)
+            Clock clock;
+
             while (m_events.empty())
             {
-                sleep(milliseconds(10));
-                processJoystickEvents();
-                processSensorEvents();
+                Int32 wait = -1;
+
+                if (timeout != Time::Zero)
+                {
+                    Time remaining = timeout - clock.getElapsedTime();
+                    if (remaining <= Time::Zero)
+                        break;
+
+                    // Round up, so that we don't spin with zero timeouts at the end
+                    wait = static_cast<Int32>((remaining.asMicroseconds() + 999) / 1000);
+                }
+
+                // Joysticks and sensors require polling, wake up regularly while any is in use
+                if (needsPolling() && ((wait < 0) || (wait > pollingInterval)))
+                    wait = pollingInterval;
+
+                waitForEvents(wait);
+
+                processInputEvents();
                 processEvents();
             }
         }
     }
 
     // Pop the first event of the queue, if it is not empty
-    if (!m_events.empty())
+    return m_events.pop(event);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t WindowImpl::popEvents(Event* events, std::size_t maxCount)
+{
+    // If the event queue is empty, let's first check if new events are available from the OS
+    if (m_events.empty())
     {
-        event = m_events.front();
-        m_events.pop();
+        processInputEvents();
+        processEvents();
+    }
+
+    return m_events.pop(events, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::pushEvent(const Event& event)
+{
+    Event stamped = event;
+    stamped.timestamp = eventClock.getElapsedTime();
+
+    // High-rate mice can report thousands of raw motions per second,
+    // merge consecutive ones into a single event to keep the queue short
+    if ((event.type == Event::MouseMovedRaw) && !m_events.empty() && (m_events.back().type == Event::MouseMovedRaw))
+    {
+        m_events.back().mouseMoveRaw.deltaX += event.mouseMoveRaw.deltaX;
+        m_events.back().mouseMoveRaw.deltaY += event.mouseMoveRaw.deltaY;
+        return;
+    }
 
+    m_events.push(stamped);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::waitForEvents(Int32 timeout)
+{
+    // Without a way to wait for the system events, poll them
+    if ((timeout < 0) || (timeout > pollingInterval))
+        timeout = pollingInterval;
+
+    sleep(milliseconds(timeout));
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::needsPolling() const
+{
+    // The events of the input thread must be collected regularly
+    if (m_inputThread)
         return true;
+
+    for (unsigned int i = 0; i < Joystick::Count; ++i)
+    {
+        if (m_joystickStates[i].connected)
+            return true;
+    }
+
+    for (unsigned int i = 0; i < Sensor::Count; ++i)
+    {
+        if (SensorManager::getInstance().isEnabled(static_cast<Sensor::Type>(i)))
+            return true;
     }
 
     return false;
@@ -152,15 +276,33 @@ bool WindowImpl::popEvent(Event& event, bool block)
 
 
 ////////////////////////////////////////////////////////////
-void WindowImpl::pushEvent(const Event& event)
+void WindowImpl::processInputEvents()
 {
-    m_events.push(event);
+    if (m_inputThread)
+    {
+        // Queue the events sampled by the input thread, they already have their timestamp
+        Event event;
+        while (m_inputEvents.pop(event))
+            m_events.push(event);
+    }
+    else
+    {
+        processJoystickEvents(m_sampledEvents);
+        processSensorEvents(m_sampledEvents);
+
+        for (std::size_t i = 0; i < m_sampledEvents.size(); ++i)
+            pushEvent(m_sampledEvents[i]);
+
+        m_sampledEvents.clear();
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-void WindowImpl::processJoystickEvents()
+void WindowImpl::processJoystickEvents(std::vector<Event>& events)
 {
+    Lock lock(inputMutex);
+
     // First update the global joystick states
     JoystickManager::getInstance().update();
 
@@ -178,7 +320,7 @@ void WindowImpl::processJoystickEvents()
             Event event;
             event.type = connected ? Event::JoystickConnected : Event::JoystickDisconnected;
             event.joystickButton.joystickId = i;
-            pushEvent(event);
+            events.push_back(event);
 
             // Clear previous axes positions
             if (connected)
@@ -202,7 +344,7 @@ void WindowImpl::processJoystickEvents()
                         event.joystickMove.joystickId = i;
                         event.joystickMove.axis = axis;
                         event.joystickMove.position = currPos;
-                        pushEvent(event);
+                        events.push_back(event);
 
                         m_previousAxes[i][axis] = currPos;
                     }
@@ -221,7 +363,7 @@ void WindowImpl::processJoystickEvents()
                     event.type = currPressed ? Event::JoystickButtonPressed : Event::JoystickButtonReleased;
                     event.joystickButton.joystickId = i;
                     event.joystickButton.button = j;
-                    pushEvent(event);
+                    events.push_back(event);
                 }
             }
         }
@@ -230,8 +372,10 @@ void WindowImpl::processJoystickEvents()
 
 
 ////////////////////////////////////////////////////////////
-void WindowImpl::processSensorEvents()
+void WindowImpl::processSensorEvents(std::vector<Event>& events)
 {
+    Lock lock(inputMutex);
+
     // First update the sensor states
     SensorManager::getInstance().update();
 
@@ -255,12 +399,60 @@ void WindowImpl::processSensorEvents()
                 event.sensor.x = m_sensorValue[i].x;
                 event.sensor.y = m_sensorValue[i].y;
                 event.sensor.z = m_sensorValue[i].z;
-                pushEvent(event);
+                events.push_back(event);
             }
         }
     }
 }
 
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::stopInputThread()
+{
+    if (!m_inputThread)
+        return;
+
+    m_inputThreadRunning.store(false);
+    m_inputThread->wait();
+
+    delete m_inputThread;
+    m_inputThread = NULL;
+
+    // Keep the events that were sampled but not queued yet
+    Event event;
+    while (m_inputEvents.pop(event))
+        m_events.push(event);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::sampleInput()
+{
+    std::vector<Event> pending;
+
+    while (m_inputThreadRunning.load())
+    {
+        std::size_t first = pending.size();
+
+        processJoystickEvents(pending);
+        processSensorEvents(pending);
+
+        Time timestamp = eventClock.getElapsedTime();
+        for (std::size_t i = first; i < pending.size(); ++i)
+            pending[i].timestamp = timestamp;
+
+        // Hand the events over, those that don't fit wait for the next sample
+        std::size_t count = 0;
+        while ((count < pending.size()) && m_inputEvents.push(pending[count]))
+            ++count;
+
+        pending.erase(pending.begin(), pending.begin() + count);
+
+        sleep(m_inputInterval);
+    }
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -29,11 +29,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/System/Atomic.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/SpscQueue.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/CursorImpl.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/EventQueue.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/Window/Sensor.hpp>
@@ -41,8 +46,8 @@
 #include <SFML/Window/VideoMode.hpp>
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/Window.hpp>
-#include <queue>
 #include <set>
+#include <vector>
 
 namespace sf
 {
@@ -98,6 +103,14 @@ public:
     ////////////////////////////////////////////////////////////
     void setJoystickThreshold(float threshold);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start, stop or change the rate of the input thread
+    ///
+    /// \param rate Number of joysticks and sensors samples per second, 0 to stop the thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInputThreadRate(unsigned int rate);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the next window event available
     ///
@@ -105,14 +118,31 @@ public:
     /// window's internal event processing function.
     /// The \a block parameter controls the behavior of the function
     /// if no event is available: if it is true then the function
-    /// doesn't return until a new event is triggered; otherwise it
-    /// returns false to indicate that no event is available.
+    /// doesn't return until a new event is triggered or \a timeout
+    /// elapses; otherwise it returns false to indicate that no
+    /// event is available.
+    ///
+    /// \param event   Event to be returned
+    /// \param block   Use true to block the thread until an event arrives
+    /// \param timeout Maximum time to block, Time::Zero to block until an event arrives
+    ///
+    ////////////////////////////////////////////////////////////
+    bool popEvent(Event& event, bool block, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return several of the available window events
+    ///
+    /// If there's no event available, this function calls the
+    /// window's internal event processing function once. It
+    /// never blocks.
     ///
-    /// \param event Event to be returned
-    /// \param block Use true to block the thread until an event arrives
+    /// \param events   Array to fill with the events
+    /// \param maxCount Maximum number of events to return
+    ///
+    /// \return Number of events written to \a events
     ///
     ////////////////////////////////////////////////////////////
-    bool popEvent(Event& event, bool block);
+    std::size_t popEvents(Event* events, std::size_t maxCount);
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
@@ -212,6 +242,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setKeyRepeatEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable raw mouse input events
+    ///
+    /// The default implementation reports that raw mouse
+    /// input is not supported.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setRawMouseInputEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Request the current window to be made the active
     ///        foreground window
@@ -253,28 +294,83 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Block until the operating system has events for the window
+    ///
+    /// The function may return early, spuriously or when events
+    /// are available for other windows. The default implementation
+    /// sleeps for the polling interval of the joysticks, for the
+    /// platforms that don't override it.
+    ///
+    /// \param timeout Maximum time to wait in milliseconds, negative to wait without limit
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void waitForEvents(Int32 timeout);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether joysticks or sensors need to be polled
+    ///
+    /// Their state isn't reported by the operating system,
+    /// so blocking waits wake up periodically while any of
+    /// them is in use.
+    ///
+    /// \return True if a joystick is connected or a sensor enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool needsPolling() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the joysticks and sensors events
+    ///
+    /// They are either read from the input thread, or
+    /// sampled on the spot if it isn't running.
+    ///
+    ////////////////////////////////////////////////////////////
+    void processInputEvents();
+
     ////////////////////////////////////////////////////////////
     /// \brief Read the joysticks state and generate the appropriate events
     ///
+    /// \param events Array to append the events to
+    ///
     ////////////////////////////////////////////////////////////
-    void processJoystickEvents();
+    void processJoystickEvents(std::vector<Event>& events);
 
     ////////////////////////////////////////////////////////////
     /// \brief Read the sensors state and generate the appropriate events
     ///
+    /// \param events Array to append the events to
+    ///
+    ////////////////////////////////////////////////////////////
+    void processSensorEvents(std::vector<Event>& events);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the input thread, keeping the events it sampled
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopInputThread();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry point of the input thread
+    ///
     ////////////////////////////////////////////////////////////
-    void processSensorEvents();
+    void sampleInput();
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::queue<Event> m_events;                                              ///< Queue of available events
-    JoystickState     m_joystickStates[Joystick::Count];                     ///< Previous state of the joysticks
-    Vector3f          m_sensorValue[Sensor::Count];                          ///< Previous value of the sensors
-    float             m_joystickThreshold;                                   ///< Joystick threshold (minimum motion for "move" event to be generated)
-    float             m_previousAxes[Joystick::Count][Joystick::AxisCount];  ///< Position of each axis last time a move event triggered, in range [-100, 100]
+    EventQueue    m_events;                                              ///< Queue of available events
+    JoystickState m_joystickStates[Joystick::Count];                     ///< Previous state of the joysticks
+    Vector3f      m_sensorValue[Sensor::Count];                          ///< Previous value of the sensors
+    float         m_joystickThreshold;                                   ///< Joystick threshold (minimum motion for "move" event to be generated)
+    float         m_previousAxes[Joystick::Count][Joystick::AxisCount];  ///< Position of each axis last time a move event triggered, in range [-100, 100]
+    std::vector<Event> m_sampledEvents;                                  ///< Joysticks and sensors events sampled by the window thread, before they are queued
+    Thread*       m_inputThread;                                         ///< Thread sampling the joysticks and sensors (NULL if not running)
+    Atomic<bool>  m_inputThreadRunning;                                  ///< Must the input thread keep sampling?
+    Time          m_inputInterval;                                       ///< Time between two samples of the input thread
+    SpscQueue<Event> m_inputEvents;                                      ///< Events sampled by the input thread, waiting to be queued by the window thread
 };
 
 } // namespace priv
@@ -92,31 +92,8 @@ bool SensorImpl::open(Sensor::Type sensor)
     // The sensor is disabled by default
     m_enabled = false;
 
-    // Set the refresh rate (use the maximum allowed)
-    static const NSTimeInterval updateInterval = 1. / 60.;
-    switch (sensor)
-    {
-        case Sensor::Accelerometer:
-            [SFAppDelegate getInstance].motionManager.accelerometerUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Gyroscope:
-            [SFAppDelegate getInstance].motionManager.gyroUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Magnetometer:
-            [SFAppDelegate getInstance].motionManager.magnetometerUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Gravity:
-        case Sensor::UserAcceleration:
-        case Sensor::Orientation:
-            [SFAppDelegate getInstance].motionManager.deviceMotionUpdateInterval = updateInterval;
-            break;
-
-        default:
-            break;
-    }
+    // Set the refresh rate
+    setSamplingPeriod(seconds(1.f / 60.f), Time::Zero);
 
     return true;
 }
@@ -130,7 +107,7 @@ void SensorImpl::close()
 
 
 ////////////////////////////////////////////////////////////
-Vector3f SensorImpl::update()
+Vector3f SensorImpl::update(std::vector<Sensor::Sample>& /*samples*/)
 {
     Vector3f value;
     CMMotionManager* manager = [SFAppDelegate getInstance].motionManager;
@@ -237,6 +214,38 @@ void SensorImpl::setEnabled(bool enabled)
     m_enabled = enabled;
 }
 
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setSamplingPeriod(Time period, Time /*maxReportLatency*/)
+{
+    // Core Motion clamps the interval to what the hardware supports, batching is not available
+    NSTimeInterval updateInterval = period.asSeconds();
+
+    switch (m_sensor)
+    {
+        case Sensor::Accelerometer:
+            [SFAppDelegate getInstance].motionManager.accelerometerUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Gyroscope:
+            [SFAppDelegate getInstance].motionManager.gyroUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Magnetometer:
+            [SFAppDelegate getInstance].motionManager.magnetometerUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Gravity:
+        case Sensor::UserAcceleration:
+        case Sensor::Orientation:
+            [SFAppDelegate getInstance].motionManager.deviceMotionUpdateInterval = updateInterval;
+            break;
+
+        default:
+            break;
+    }
+}
+
 } // namespace priv
 
 } // namespace sf